@@ -0,0 +1,238 @@
+#include <stdio.h>
+#include <string.h>
+#include "watch.h"
+#include "lis2dw.h"
+#include "sunriset.h"
+#include "sha1.h"
+#include "sha256.h"
+#include "sha512.h"
+
+/*
+MICROBENCHMARK
+
+Times the watch library's primitives on the real thing, so that work on the display or storage paths can be measured
+rather than guessed at. Plug the watch into USB, open its serial port (i.e. screen /dev/ttyACM0), and press ALARM;
+each primitive runs MICROBENCH_ITERATIONS times, and the minimum, median and maximum number of CPU cycles each call
+took come back over the serial port. Press ALARM again for another run.
+
+The cycles come from watch_get_cycle_counter, which is SysTick at the CPU clock: 8 MHz while USB is connected. It only
+counts while the CPU is awake, so the storage primitives spin on watch_storage_is_busy rather than sleeping in
+watch_storage_sync, and their figures include the time the flash controller takes. The storage benchmarks use the last
+row of the storage area, and put its contents back when they're done, so Movement's filesystem survives. Without a
+motion sensor board, lis2dw_read_fifo times the bus NAKing the accelerometer's address.
+
+The SHA benchmarks each time one call to the compression function: one block, which is most of what a TOTP code
+costs (see sha_thumb1.h for the two versions of each; build with SHA_THUMB1_KERNELS=0 in CFLAGS to time mbed TLS's
+own). Before timing them, the run checks each hash against the FIPS 180 test vector for "abc" and reports any that
+don't match.
+*/
+
+#define MICROBENCH_ITERATIONS 101
+#define MICROBENCH_ROW (NVMCTRL_RWWEE_PAGES * NVMCTRL_PAGE_SIZE / NVMCTRL_ROW_SIZE - 1)
+
+typedef void (*microbench_setup_t)(void);
+typedef void (*microbench_body_t)(uint16_t iteration);
+
+typedef struct {
+    const char *name;
+    // runs before each iteration, outside the timing.
+    microbench_setup_t setup;
+    microbench_body_t body;
+} microbench_t;
+
+static volatile bool run_requested;
+static uint32_t samples[MICROBENCH_ITERATIONS];
+static uint8_t saved_row[NVMCTRL_ROW_SIZE];
+static uint8_t page[NVMCTRL_PAGE_SIZE];
+static lis2dw_fifo_t fifo;
+static uint8_t sha_block[SHA512_BLOCK_LENGTH];
+static mbedtls_sha1_context sha1_ctx;
+static mbedtls_sha256_context sha256_ctx;
+static mbedtls_sha512_context sha512_ctx;
+// keeps the compiler from dropping a result nobody reads.
+static volatile uint32_t sink;
+
+static void cb_alarm_pressed(void) {
+    run_requested = true;
+}
+
+static void _microbench_storage_wait(void) {
+    while (watch_storage_is_busy());
+}
+
+static void bench_display_string(uint16_t iteration) {
+    char buf[11];
+    // a different string each time, so that the display driver can't skip it as unchanged.
+    sprintf(buf, "MB  %06d", iteration);
+    watch_display_string(buf, 0);
+}
+
+static void bench_rtc_get_date_time(uint16_t iteration) {
+    (void) iteration;
+    sink = watch_rtc_get_date_time().reg;
+}
+
+static void setup_storage_write(void) {
+    watch_storage_erase(MICROBENCH_ROW);
+    _microbench_storage_wait();
+}
+
+static void bench_storage_write(uint16_t iteration) {
+    page[0] = iteration;
+    watch_storage_write(MICROBENCH_ROW, 0, page, sizeof(page));
+    _microbench_storage_wait();
+}
+
+static void bench_storage_erase(uint16_t iteration) {
+    (void) iteration;
+    watch_storage_erase(MICROBENCH_ROW);
+    _microbench_storage_wait();
+}
+
+static void bench_i2c_read8(uint16_t iteration) {
+    (void) iteration;
+    sink = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_WHO_AM_I);
+}
+
+static void bench_lis2dw_read_fifo(uint16_t iteration) {
+    (void) iteration;
+    sink = lis2dw_read_fifo(&fifo);
+}
+
+static void bench_sun_rise_set(uint16_t iteration) {
+    double rise, set;
+    // a day further into the year each time, so that no two calls are the same sum.
+    sink = sun_rise_set(2024, 1, 1 + iteration % 28, SUNRISET_REAL(-73.97), SUNRISET_REAL(40.78), &rise, &set);
+}
+
+static void bench_sha1_process(uint16_t iteration) {
+    sha_block[0] = iteration;
+    mbedtls_sha1_process(&sha1_ctx, sha_block);
+    sink = sha1_ctx.state[0];
+}
+
+static void bench_sha256_process(uint16_t iteration) {
+    sha_block[0] = iteration;
+    mbedtls_sha256_process(&sha256_ctx, sha_block);
+    sink = sha256_ctx.state[0];
+}
+
+static void bench_sha512_process(uint16_t iteration) {
+    sha_block[0] = iteration;
+    mbedtls_sha512_process(&sha512_ctx, sha_block);
+    sink = (uint32_t)sha512_ctx.state[0];
+}
+
+static const microbench_t benchmarks[] = {
+    { "watch_display_string", NULL, bench_display_string },
+    { "watch_rtc_get_date_time", NULL, bench_rtc_get_date_time },
+    { "watch_storage_write", setup_storage_write, bench_storage_write },
+    { "watch_storage_erase", NULL, bench_storage_erase },
+    { "watch_i2c_read8", NULL, bench_i2c_read8 },
+    { "lis2dw_read_fifo", NULL, bench_lis2dw_read_fifo },
+    { "sun_rise_set", NULL, bench_sun_rise_set },
+    { "sha1_process", NULL, bench_sha1_process },
+    { "sha256_process", NULL, bench_sha256_process },
+    { "sha512_process", NULL, bench_sha512_process },
+};
+
+// the first bytes of each hash of "abc", from FIPS 180-2's examples.
+static const uint8_t sha1_abc[] = { 0xa9, 0x99, 0x3e, 0x36 };
+static const uint8_t sha256_abc[] = { 0xba, 0x78, 0x16, 0xbf };
+static const uint8_t sha512_abc[] = { 0xdd, 0xaf, 0x35, 0xa1 };
+
+static void _microbench_check_sha(void) {
+    uint8_t digest[SHA512_DIGEST_LENGTH];
+    const uint8_t *abc = (const uint8_t *)"abc";
+
+    mbedtls_sha1(abc, 3, digest);
+    if (memcmp(digest, sha1_abc, sizeof(sha1_abc))) printf("sha1 gets the test vector wrong!\r\n");
+    mbedtls_sha256(abc, 3, digest, 0);
+    if (memcmp(digest, sha256_abc, sizeof(sha256_abc))) printf("sha256 gets the test vector wrong!\r\n");
+    mbedtls_sha512(abc, 3, digest, 0);
+    if (memcmp(digest, sha512_abc, sizeof(sha512_abc))) printf("sha512 gets the test vector wrong!\r\n");
+
+    mbedtls_sha1_starts(&sha1_ctx);
+    mbedtls_sha256_starts(&sha256_ctx, 0);
+    mbedtls_sha512_starts(&sha512_ctx, 0);
+}
+
+static void _microbench_sort(uint32_t *values, uint16_t count) {
+    for (uint16_t i = 1; i < count; i++) {
+        uint32_t value = values[i];
+        uint16_t j = i;
+        while (j > 0 && values[j - 1] > value) {
+            values[j] = values[j - 1];
+            j--;
+        }
+        values[j] = value;
+    }
+}
+
+static void _microbench_run(const microbench_t *benchmark) {
+    for (uint16_t i = 0; i < MICROBENCH_ITERATIONS; i++) {
+        if (benchmark->setup) benchmark->setup();
+        uint32_t start = watch_get_cycle_counter();
+        benchmark->body(i);
+        samples[i] = (watch_get_cycle_counter() - start) & WATCH_CYCLE_COUNTER_MASK;
+    }
+    _microbench_sort(samples, MICROBENCH_ITERATIONS);
+    printf("%-24s %10lu %10lu %10lu\r\n", benchmark->name, (unsigned long)samples[0],
+           (unsigned long)samples[MICROBENCH_ITERATIONS / 2], (unsigned long)samples[MICROBENCH_ITERATIONS - 1]);
+}
+
+static void _microbench_run_all(void) {
+    // the cost of reading the counter twice, which every figure below includes.
+    for (uint16_t i = 0; i < MICROBENCH_ITERATIONS; i++) {
+        uint32_t start = watch_get_cycle_counter();
+        samples[i] = (watch_get_cycle_counter() - start) & WATCH_CYCLE_COUNTER_MASK;
+    }
+    _microbench_sort(samples, MICROBENCH_ITERATIONS);
+    printf("\r\n%u iterations each, in CPU cycles; reading the counter costs %lu.\r\n", MICROBENCH_ITERATIONS,
+           (unsigned long)samples[0]);
+    printf("%-24s %10s %10s %10s\r\n", "primitive", "min", "median", "max");
+
+    watch_storage_read(MICROBENCH_ROW, 0, saved_row, sizeof(saved_row));
+    memset(page, 0x55, sizeof(page));
+    watch_enable_i2c();
+    if (!lis2dw_begin()) printf("(no accelerometer answered; the I2C figures are for a NAK)\r\n");
+    else lis2dw_enable_fifo();
+    _microbench_check_sha();
+
+    for (uint8_t i = 0; i < sizeof(benchmarks) / sizeof(benchmarks[0]); i++) _microbench_run(&benchmarks[i]);
+
+    watch_disable_i2c();
+    watch_storage_erase(MICROBENCH_ROW);
+    watch_storage_write(MICROBENCH_ROW, 0, saved_row, sizeof(saved_row));
+    watch_storage_sync();
+}
+
+void app_init(void) {
+}
+
+void app_wake_from_backup(void) {
+}
+
+void app_setup(void) {
+    watch_enable_display();
+    watch_display_string("MB  ALArM ", 0);
+    watch_enable_external_interrupts();
+    watch_register_interrupt_callback(BTN_ALARM, cb_alarm_pressed, INTERRUPT_TRIGGER_RISING);
+}
+
+void app_prepare_for_standby(void) {
+}
+
+void app_wake_from_standby(void) {
+}
+
+bool app_loop(void) {
+    if (run_requested) {
+        run_requested = false;
+        watch_display_string("MB  run   ", 0);
+        _microbench_run_all();
+        watch_display_string("MB  done  ", 0);
+    }
+
+    return true;
+}
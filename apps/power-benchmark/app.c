@@ -0,0 +1,263 @@
+#include <stdio.h>
+#include <string.h>
+#include "watch.h"
+
+/*
+POWER BENCHMARK
+
+Steps the watch through the power states that matter for battery life, holding each one for a fixed time, so that a
+power analyzer can measure what each costs on a given board. Build it for the board you're measuring (make BOARD=...
+COLOR=...), flash it, and record the whole run. It makes BENCHMARK_ROUNDS passes through these states, in this order:
+
+     1  standby with the LCD on     watch_enter_sleep_mode, as Movement's low energy mode uses
+     2  standby with the LCD off    watch_enter_deep_sleep_mode
+     3  1 Hz tick                   standby, waking every second to redraw the seconds
+     4  128 Hz tick                 standby, waking 128 times a second
+     5  LED                         the red LED at full brightness, in standby
+     6  buzzer                      the buzzer on at BENCHMARK_BUZZER_NOTE, awake
+     7  I2C                         reading a register at address BENCHMARK_I2C_ADDRESS over and over, awake
+     8  ADC                         sampling VCC over and over, awake
+     9  flash erase                 erasing the last row of the storage area over and over, awake
+    10  backup                      watch_enter_backup_mode, woken by the RTC
+
+and then sleeps for good with "done" on the display. Each state is held for BENCHMARK_STATE_SECONDS, bar the flash
+erase, which is held for BENCHMARK_ERASE_SECONDS to spare the row; the row's contents are put back afterwards, so
+Movement's filesystem survives.
+
+The number of the state the watch is in goes out on the sensor board pins A0-A3, as a binary number with A0 as bit 0,
+so wire those to the analyzer's digital inputs D0-D3. The sleep states turn the pins off, so they read as 0 there (tie
+them to ground through 100k if the analyzer's inputs float): a 0 means the watch is still in the last state it
+showed. Export the recording as CSV and run
+
+    utils/power_trace_energy.py --benchmark --ppk2 recording.csv
+
+for the time and mean current in each state (see that script for analyzers other than the Power Profiler Kit II).
+The figures are what the board's energy_costs.h estimates.
+*/
+
+#define BENCHMARK_ROUNDS 3
+#define BENCHMARK_STATE_SECONDS 10
+#define BENCHMARK_ERASE_SECONDS 1
+#define BENCHMARK_BUZZER_NOTE BUZZER_NOTE_E7
+// the accelerometer on the motion sensor board; with nothing there, the bus still runs, and each byte comes back NAKed.
+#define BENCHMARK_I2C_ADDRESS 0x18
+#define BENCHMARK_I2C_REGISTER 0x0F
+// the backup register that remembers which round we're on through BACKUP mode, which resets the watch.
+#define BENCHMARK_BACKUP_REGISTER 0
+#define BENCHMARK_ERASE_ROW (NVMCTRL_RWWEE_PAGES * NVMCTRL_PAGE_SIZE / NVMCTRL_ROW_SIZE - 1)
+
+typedef enum {
+    BENCHMARK_NONE = 0,
+    BENCHMARK_STANDBY_LCD_ON,
+    BENCHMARK_STANDBY_LCD_OFF,
+    BENCHMARK_TICK_1HZ,
+    BENCHMARK_TICK_128HZ,
+    BENCHMARK_LED,
+    BENCHMARK_BUZZER,
+    BENCHMARK_I2C,
+    BENCHMARK_ADC,
+    BENCHMARK_FLASH_ERASE,
+    BENCHMARK_BACKUP,
+    BENCHMARK_NUM_STATES,
+    // all four pins high: the run is over.
+    BENCHMARK_DONE = 15,
+} benchmark_state_t;
+
+// what the display shows in positions 4-9 for each state.
+static const char *const benchmark_labels[BENCHMARK_NUM_STATES] = {
+    "      ", "Sb  On", "Sb  OF", "  1 Hz", "128 Hz", "LEd   ", "beep  ", " I2C  ", " AdC  ", "ErASE ", "bAcKUP",
+};
+
+static const uint8_t benchmark_pins[4] = { A0, A1, A2, A3 };
+
+static benchmark_state_t state;
+static uint8_t round_number;
+static volatile bool state_done;
+static uint8_t saved_row[NVMCTRL_ROW_SIZE];
+
+static void cb_state_done(void) {
+    state_done = true;
+}
+
+static void cb_tick(void) {
+    // waking up is the work being measured.
+}
+
+static void _benchmark_set_marker(benchmark_state_t marker) {
+    for (uint8_t i = 0; i < 4; i++) watch_set_pin_level(benchmark_pins[i], (marker >> i) & 1);
+}
+
+// has the RTC wake us, and set state_done, once the state has been held for this many seconds (under a minute).
+static void _benchmark_schedule_end(uint8_t seconds) {
+    watch_date_time end = watch_rtc_get_date_time();
+    end.unit.second = (end.unit.second + seconds) % 60;
+    state_done = false;
+    watch_rtc_register_alarm_callback(cb_state_done, end, ALARM_MATCH_SS);
+}
+
+static void _benchmark_show(void) {
+    char buf[11];
+    sprintf(buf, "PB%2d%s", state, benchmark_labels[state]);
+    watch_display_string(buf, 0);
+}
+
+// sets up the state we've moved on to, and has the RTC end it.
+static void _benchmark_enter(benchmark_state_t next) {
+    state = next;
+    _benchmark_set_marker(state);
+    _benchmark_show();
+
+    switch (state) {
+        case BENCHMARK_TICK_1HZ:
+            watch_rtc_register_tick_callback(cb_tick);
+            break;
+        case BENCHMARK_TICK_128HZ:
+            watch_rtc_register_periodic_callback(cb_tick, 128);
+            break;
+        case BENCHMARK_LED:
+            watch_enable_leds();
+            watch_set_led_color(255, 0);
+            break;
+        case BENCHMARK_BUZZER:
+            watch_enable_buzzer();
+            watch_set_buzzer_period(NotePeriods[BENCHMARK_BUZZER_NOTE]);
+            watch_set_buzzer_on();
+            break;
+        case BENCHMARK_I2C:
+            watch_enable_i2c();
+            break;
+        case BENCHMARK_ADC:
+            watch_enable_adc();
+            break;
+        case BENCHMARK_FLASH_ERASE:
+            watch_storage_read(BENCHMARK_ERASE_ROW, 0, saved_row, sizeof(saved_row));
+            break;
+        default:
+            break;
+    }
+
+    _benchmark_schedule_end(state == BENCHMARK_FLASH_ERASE ? BENCHMARK_ERASE_SECONDS : BENCHMARK_STATE_SECONDS);
+}
+
+static void _benchmark_leave(void) {
+    switch (state) {
+        case BENCHMARK_TICK_1HZ:
+            watch_rtc_disable_tick_callback();
+            break;
+        case BENCHMARK_TICK_128HZ:
+            watch_rtc_disable_periodic_callback(128);
+            break;
+        case BENCHMARK_LED:
+            watch_set_led_off();
+            watch_disable_leds();
+            break;
+        case BENCHMARK_BUZZER:
+            watch_set_buzzer_off();
+            watch_disable_buzzer();
+            break;
+        case BENCHMARK_I2C:
+            watch_disable_i2c();
+            break;
+        case BENCHMARK_ADC:
+            watch_disable_adc();
+            break;
+        case BENCHMARK_FLASH_ERASE:
+            // the row was erased last thing, so it's ready to take its old contents back.
+            watch_storage_write(BENCHMARK_ERASE_ROW, 0, saved_row, sizeof(saved_row));
+            watch_storage_sync();
+            break;
+        default:
+            break;
+    }
+    watch_rtc_disable_alarm_callback();
+}
+
+static void _benchmark_finish(void) {
+    state = BENCHMARK_DONE;
+    _benchmark_set_marker(state);
+    watch_display_string("PB  done  ", 0);
+}
+
+void app_init(void) {
+    round_number = 0;
+    state = BENCHMARK_NONE;
+}
+
+void app_wake_from_backup(void) {
+    // BACKUP mode is the last state in each round; waking from it is the start of the next.
+    round_number = watch_get_backup_data(BENCHMARK_BACKUP_REGISTER) + 1;
+}
+
+void app_setup(void) {
+    // the sleep modes turn the pins and the display off, and call this again when they wake.
+    for (uint8_t i = 0; i < 4; i++) watch_enable_digital_output(benchmark_pins[i]);
+    _benchmark_set_marker(state);
+    watch_enable_display();
+    if (state == BENCHMARK_DONE) _benchmark_finish();
+    else if (state != BENCHMARK_NONE) _benchmark_show();
+}
+
+void app_prepare_for_standby(void) {
+}
+
+void app_wake_from_standby(void) {
+}
+
+bool app_loop(void) {
+    if (state == BENCHMARK_DONE) {
+        // nothing's left to wake us, so this is where the run ends.
+        watch_enter_sleep_mode();
+        return true;
+    }
+
+    if (state == BENCHMARK_NONE) {
+        if (round_number >= BENCHMARK_ROUNDS) {
+            _benchmark_finish();
+            return false;
+        }
+        _benchmark_enter(BENCHMARK_STANDBY_LCD_ON);
+    }
+
+    if (state_done) {
+        _benchmark_leave();
+        if (state + 1 == BENCHMARK_NUM_STATES) {
+            // the backup state's alarm wakes the watch from reset, so it never gets here.
+            state = BENCHMARK_NONE;
+            return false;
+        }
+        _benchmark_enter(state + 1);
+    }
+
+    switch (state) {
+        case BENCHMARK_STANDBY_LCD_ON:
+            // any wake but the alarm's (a button, say) goes back to sleep.
+            if (!state_done) watch_enter_sleep_mode();
+            return !state_done;
+        case BENCHMARK_STANDBY_LCD_OFF:
+            if (!state_done) watch_enter_deep_sleep_mode();
+            return !state_done;
+        case BENCHMARK_TICK_1HZ:
+            // the RTC counts in binary, so this is the same work as a clock face drawing its seconds.
+            watch_display_2d(watch_rtc_get_date_time().unit.second, 8, '0');
+            return true;
+        case BENCHMARK_BUZZER:
+            // the buzzer's TCC stops in standby, so stay awake.
+            return false;
+        case BENCHMARK_I2C:
+            watch_i2c_read8(BENCHMARK_I2C_ADDRESS, BENCHMARK_I2C_REGISTER);
+            return false;
+        case BENCHMARK_ADC:
+            watch_get_vcc_voltage();
+            return false;
+        case BENCHMARK_FLASH_ERASE:
+            watch_storage_erase(BENCHMARK_ERASE_ROW);
+            watch_storage_sync();
+            return false;
+        case BENCHMARK_BACKUP:
+            watch_store_backup_data(round_number, BENCHMARK_BACKUP_REGISTER);
+            watch_enter_backup_mode();
+            return false;
+        default:
+            return true;
+    }
+}
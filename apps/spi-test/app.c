@@ -87,85 +87,37 @@ static void write_buffer_to_page(uint8_t *buf, uint16_t page) {
 }
 
 static void print_records_at_page(uint16_t page) {
+    static const char hex_digits[] = "0123456789abcdef";
     accelerometer_data_acquisition_record_t records[32];
-    static uint64_t timestamp = 0;
-    // static uint16_t temperature = 0;
-    static lis2dw_range_t range = LIS2DW_RANGE_2_G;
-    static double lsb_value = 1;
-    static bool printing_header = false;
-
-    wait_for_flash_ready();
-    spi_flash_read_data(page * 256, (void *)records, 256);
-    for(int i = 0; i < 32; i++) {
-        switch (records[i].header.info.record_type) {
-            case ACCELEROMETER_DATA_ACQUISITION_HEADER:
-                printing_header = true;
-                timestamp = records[i].header.timestamp;
-                // temperature = records[i].header.info.temperature;
-                printf("%c%c.%lld.", records[i].header.char1, records[i].header.char2, timestamp);
-                range = records[i].header.info.range;
-                break;
-            case ACCELEROMETER_DATA_ACQUISITION_DATA:
-                if (printing_header) {
-                    printing_header = false;
-                    uint8_t filter = 0;
-                    switch (records[i].data.z.filter) {
-                        case LIS2DW_BANDWIDTH_FILTER_DIV2:
-                            filter = 2;
-                            break;
-                        case LIS2DW_BANDWIDTH_FILTER_DIV4:
-                            filter = 4;
-                            break;
-                        case LIS2DW_BANDWIDTH_FILTER_DIV10:
-                            filter = 10;
-                            break;
-                        case LIS2DW_BANDWIDTH_FILTER_DIV20:
-                            filter = 20;
-                            break;
-                    }
-                    switch (range) {
-                        case LIS2DW_RANGE_16_G:
-                            lsb_value = (records[i].data.y.lpmode == LIS2DW_LP_MODE_1) ? 7.808 : 1.952;
-                            range = 16;
-                            break;
-                        case LIS2DW_RANGE_8_G:
-                            lsb_value = (records[i].data.y.lpmode == LIS2DW_LP_MODE_1) ? 3.904 : 0.976;
-                            range = 8;
-                            break;
-                        case LIS2DW_RANGE_4_G:
-                            lsb_value = (records[i].data.y.lpmode == LIS2DW_LP_MODE_1) ? 1.952 : 0.488;
-                            range = 4;
-                            break;
-                        case LIS2DW_RANGE_2_G:
-                            lsb_value = (records[i].data.y.lpmode == LIS2DW_LP_MODE_1) ? 0.976 : 0.244;
-                            range = 2;
-                            break;
-                    }
-                    printf("RANGE%d_LP%d_FILT%d.CSV\n", range, records[i].data.y.lpmode + 1, filter);
-                    printf("timestamp,accX,accY,accZ\n");
-                }
-                printf("%lld,%f,%f,%f\n",
-                        (timestamp * 100 + records[i].data.counter) * 10,
-                        9.80665 * ((double)(records[i].data.x.accel - 8192)) * lsb_value / 1000,
-                        9.80665 * ((double)(records[i].data.y.accel - 8192)) * lsb_value / 1000,
-                        9.80665 * ((double)(records[i].data.z.accel - 8192)) * lsb_value / 1000);
-                break;
-            case ACCELEROMETER_DATA_ACQUISITION_INVALID:
-            case ACCELEROMETER_DATA_ACQUISITION_DELETED:
-                // don't print anything
-                break;
-        }
-        records[i].header.info.record_type = ACCELEROMETER_DATA_ACQUISITION_DELETED;
+    char line[3 + 512 + 2];
+
+    // pages go out in order, so the read-ahead block serves most of them without a command to the chip.
+    spi_flash_read_cached(page * 256, (void *)records, 256);
+
+    // dump the page as it is and let utils/motion_express_utilities decode it: formatting every sample here took
+    // far longer than sending the raw bytes. version 2 pages are delta-compressed; version 1 pages are 32 records.
+    uint8_t *bytes = (uint8_t *)records;
+    bool version_2 = bytes[0] == 0xFC && bytes[1] == 'V' && bytes[2] == '2';
+    memcpy(line, version_2 ? "V2 " : "V1 ", 3);
+    for(int i = 0; i < 256; i++) {
+        line[3 + i * 2] = hex_digits[bytes[i] >> 4];
+        line[4 + i * 2] = hex_digits[bytes[i] & 0xF];
     }
+    line[515] = '\n';
+    line[516] = '\0';
+    printf("%s", line);
 
     // uncomment this to mark all pages deleted
-    // write_buffer_to_page((uint8_t *)records, page);
+    // if (!version_2) {
+    //     for(int i = 0; i < 32; i++) records[i].header.info.record_type = ACCELEROMETER_DATA_ACQUISITION_DELETED;
+    //     write_buffer_to_page((uint8_t *)records, page);
+    // }
 }
 
 static void print_records() {
     uint8_t buf[256];
+    wait_for_flash_ready();
     for(int16_t i = 0; i < 4; i++) {
-        wait_for_flash_ready();
         spi_flash_read_data(i * 256, buf, 256);
         for(int16_t j = 0; j < 256; j++) {
             uint8_t pages_written = buf[j];
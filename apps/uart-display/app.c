@@ -79,8 +79,8 @@ bool app_loop(void) {
         watch_uart_puts(buf);
         button_pressed = 0;
     }
-    char char_received = watch_uart_getc();
-    if (char_received) {
+    char char_received;
+    while (watch_uart_read(&char_received, 1)) {
         switch (char_received) {
             case 'R':
                 watch_set_led_red();
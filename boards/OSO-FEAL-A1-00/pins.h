@@ -12,12 +12,20 @@
 #define BTN_MODE GPIO(GPIO_PORTA, 7)
 #define WATCH_BTN_MODE_EIC_CHANNEL 7
 
+// Wake sources. Every button has an EIC channel, which can wake the watch from STANDBY and Sleep Mode. A pin on one
+// of the RTC's tamper inputs (RTC/IN[n]) can wake it with the EIC switched off (@see watch_register_extwake_callback).
+#define WATCH_BTN_ALARM_RTC_IN 2
+#define WATCH_BTN_ALARM_RTC_PINMUX PINMUX_PA02G_RTC_IN2
+#define WATCH_BOARD_EXTWAKE_PINS (WATCH_EXTWAKE_A4 | WATCH_EXTWAKE_A2 | WATCH_EXTWAKE_BTN_ALARM)
+
 // Buzzer
+#define WATCH_BOARD_HAS_BUZZER 1
 #define BUZZER GPIO(GPIO_PORTA, 27)
 #define WATCH_BUZZER_TCC_PINMUX PINMUX_PA27F_TCC0_WO5
 #define WATCH_BUZZER_TCC_CHANNEL 1
 
 // LEDs
+#define WATCH_BOARD_LED_CHANNELS 2
 #define WATCH_INVERT_LED_POLARITY
 #define RED GPIO(GPIO_PORTA, 4)
 #define WATCH_RED_TCC_CHANNEL 0
@@ -34,6 +42,13 @@
 #endif
 
 
+// Crystal: the RTC frequency correction the board starts with (@see watch_rtc_freqcorr_write).
+#ifdef WATCH_IS_BLUE_BOARD
+    #define WATCH_BOARD_FREQCORR_DEFAULT 11
+#else
+    #define WATCH_BOARD_FREQCORR_DEFAULT 22
+#endif
+
 // Segment LCD
 // The LCD in this board can run comfortably at a lower voltage.
 #define CONF_SLCD_CONTRAST_ADJUST 7
@@ -103,6 +118,7 @@
 
 
 // 9-pin connector
+#define WATCH_BOARD_SENSOR_CONNECTOR WATCH_SENSOR_CONNECTOR_FLEX_9PIN
 #define A0 GPIO(GPIO_PORTB, 4)
 #define WATCH_A0_EIC_CHANNEL 4
 #define A1 GPIO(GPIO_PORTB, 1)
@@ -113,6 +129,8 @@
 #define WATCH_A3_EIC_CHANNEL 3
 #define A4 GPIO(GPIO_PORTB, 0)
 #define WATCH_A4_EIC_CHANNEL 0
+#define WATCH_A2_RTC_IN 1
+#define WATCH_A4_RTC_IN 0
 #define SDA GPIO(GPIO_PORTB, 30)
 #define SCL GPIO(GPIO_PORTB, 31)
 
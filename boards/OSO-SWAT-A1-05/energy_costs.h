@@ -0,0 +1,34 @@
+#ifndef ENERGY_COSTS_H_INCLUDED
+#define ENERGY_COSTS_H_INCLUDED
+
+// What the simulator's energy model (watch_sim_energy.h) charges for each thing the watch does on this board, and what
+// Movement's battery life estimate (movement_battery_life.h) charges on the watch itself. The figures are estimates
+// from the SAM L22 datasheet and the board's parts, not measurements; they're good for comparing one face with
+// another, and for a rough idea of a battery life rather than a promise of one.
+
+// Current in standby with the LCD and RTC running, in µA.
+#define WATCH_ENERGY_STANDBY_UA 6.0
+
+// Current with the CPU running at 4 MHz, and with USB connected and the main clock at 8 MHz, in µA.
+#define WATCH_ENERGY_ACTIVE_UA 250
+#define WATCH_ENERGY_USB_UA 2500
+
+// Charge for each of these, in µA·s.
+#define WATCH_ENERGY_WAKE_UAS 0.25              // waking from standby, plus a short pass through the app loop at 4 MHz
+#define WATCH_ENERGY_PIXEL_UAS 0.0005           // one segment set or cleared
+#define WATCH_ENERGY_I2C_BYTE_UAS 0.05          // one byte at 100 kHz, with the pull-ups and a waiting CPU
+#define WATCH_ENERGY_SPI_BYTE_UAS 0.002         // one byte at 1 MHz
+#define WATCH_ENERGY_ADC_CONVERSION_UAS 0.01    // one sample, including starting up the reference
+#define WATCH_ENERGY_PAGE_WRITE_UAS 3.75        // programming one flash page: 2.5 ms at 1.5 mA
+#define WATCH_ENERGY_ROW_ERASE_UAS 9.0          // erasing one flash row: 6 ms at 1.5 mA
+
+// Current while these are on, in µA. The LED figures are for full brightness; less is charged pro rata.
+#define WATCH_ENERGY_BUZZER_UA 1500
+#define WATCH_ENERGY_LED_RED_UA 2500
+#ifdef WATCH_IS_BLUE_BOARD
+#define WATCH_ENERGY_LED_GREEN_UA 2500
+#else
+#define WATCH_ENERGY_LED_GREEN_UA 2000
+#endif
+
+#endif
@@ -1,5 +1,7 @@
 ##############################################################################
-ifndef EMSCRIPTEN
+ifdef HEADLESS
+BUILD = ./build-headless
+else ifndef EMSCRIPTEN
 BUILD = ./build
 else
 BUILD = ./build-sim
@@ -11,7 +13,7 @@ override BOARD = OSO-SWAT-A1-05
 endif
 
 ##############################################################################
-.PHONY: all directory clean size
+.PHONY: all directory clean size profile-report face-report power-budget power-regression
 
 # OS detection, adapted from https://gist.github.com/sighingnow/deee806603ec9274fd47
 DETECTED_OS :=
@@ -45,14 +47,40 @@ ifeq ($(DETECTED_OS), WINDOWS)
   MAKEFLAGS += -j $(NUMBER_OF_PROCESSORS)
 endif
 
-ifndef EMSCRIPTEN
+# Set PROFILE to choose how the firmware trades flash for speed:
+#   size      -Os throughout, as the firmware has always been built (the default)
+#   balanced  -Os with link time optimization, and -O2 for the hot code listed in HOT_SRCS
+#   speed     -O2 throughout, with link time optimization
+# make profile-report builds all three and prints their sizes side by side; the shell's stats command on each shows
+# what it costs in cycles.
+ifndef PROFILE
+override PROFILE = size
+endif
+
+ifeq ($(PROFILE), size)
+PROFILE_CFLAGS = -Os
+else ifeq ($(PROFILE), balanced)
+PROFILE_CFLAGS = -Os -flto
+HOT_CFLAGS = -O2
+else ifeq ($(PROFILE), speed)
+PROFILE_CFLAGS = -O2 -flto
+else
+$(error Set PROFILE to size, balanced or speed.)
+endif
+
+# Code that runs often enough, or long enough, to be worth building for speed in the balanced profile. Projects add
+# their own after including this file.
+HOT_SRCS += \
+  $(TOP)/watch-library/shared/watch/watch_private_display.c \
+
+ifeq ($(EMSCRIPTEN)$(HEADLESS),)
 CC = arm-none-eabi-gcc
 OBJCOPY = arm-none-eabi-objcopy
 SIZE = arm-none-eabi-size
 UF2 = python3 $(TOP)/utils/uf2conv.py
 
 CFLAGS += -W -Wall -Wextra -Wmissing-prototypes -Wmissing-declarations
-CFLAGS += --std=gnu99 -Os
+CFLAGS += --std=gnu99 $(PROFILE_CFLAGS)
 CFLAGS += -fno-diagnostics-show-caret
 CFLAGS += -fdata-sections -ffunction-sections
 CFLAGS += -funsigned-char -funsigned-bitfields
@@ -60,9 +88,11 @@ CFLAGS += -mcpu=cortex-m0plus -mthumb
 CFLAGS += -MD -MP -MT $(BUILD)/$(*F).o -MF $(BUILD)/$(@F).d
 
 LDFLAGS += -mcpu=cortex-m0plus -mthumb
+LDFLAGS += $(PROFILE_CFLAGS)
 LDFLAGS += -Wl,--gc-sections
 LDFLAGS += -Wl,--script=$(TOP)/watch-library/hardware/linker/saml22j18.ld
 LDFLAGS += -Wl,--print-memory-usage
+LDFLAGS += -Wl,-Map=$(BUILD)/$(BIN).map
 
 LIBS += -lm
 
@@ -119,9 +149,18 @@ SRCS += \
   $(TOP)/watch-library/hardware/watch/watch_spi.c \
   $(TOP)/watch-library/hardware/watch/watch_uart.c \
   $(TOP)/watch-library/hardware/watch/watch_storage.c \
+  $(TOP)/watch-library/hardware/watch/watch_firmware.c \
   $(TOP)/watch-library/hardware/watch/watch_deepsleep.c \
+  $(TOP)/watch-library/hardware/watch/watch_regulator.c \
+  $(TOP)/watch-library/hardware/watch/watch_clocks.c \
+  $(TOP)/watch-library/hardware/watch/watch_memory.c \
   $(TOP)/watch-library/hardware/watch/watch_private.c \
   $(TOP)/watch-library/hardware/watch/watch_private_cdc.c \
+  $(TOP)/watch-library/hardware/watch/watch_private_dma.c \
+  $(TOP)/watch-library/hardware/watch/watch_private_aes.c \
+  $(TOP)/watch-library/hardware/watch/watch_input_trace.c \
+  $(TOP)/watch-library/hardware/watch/watch_profiler.c \
+  $(TOP)/watch-library/hardware/watch/watch_log.c \
   $(TOP)/watch-library/hardware/watch/watch.c \
   $(TOP)/watch-library/hardware/hal/src/hal_atomic.c \
   $(TOP)/watch-library/hardware/hal/src/hal_delay.c \
@@ -156,6 +195,14 @@ SRCS += \
   $(TOP)/watch-library/shared/driver/spiflash.c \
   $(TOP)/watch-library/shared/watch/watch_private_buzzer.c \
   $(TOP)/watch-library/shared/watch/watch_private_display.c \
+  $(TOP)/watch-library/shared/watch/watch_power.c \
+  $(TOP)/watch-library/shared/watch/watch_power_trace.c \
+  $(TOP)/watch-library/shared/watch/watch_random.c \
+  $(TOP)/watch-library/shared/watch/watch_crc.c \
+  $(TOP)/watch-library/shared/watch/watch_battery.c \
+  $(TOP)/watch-library/shared/watch/watch_aes.c \
+  $(TOP)/watch-library/shared/watch/watch_fmt.c \
+  $(TOP)/watch-library/shared/watch/watch_math.c \
   $(TOP)/watch-library/shared/watch/watch_utility.c \
 
 DEFINES += \
@@ -168,6 +215,31 @@ CFLAGS += -W -Wall -Wextra -Wmissing-prototypes -Wmissing-declarations
 CFLAGS += -Wno-format -Wno-unused-parameter
 CFLAGS += -MD -MP -MT $(BUILD)/$(*F).o -MF $(BUILD)/$(@F).d
 
+# Set HEADLESS=1 to build the simulator with the host's compiler as a command line program that runs a script against
+# the watch on a virtual clock (see watch-library/simulator/headless/headless_main.c). It defines __EMSCRIPTEN__ so that
+# the watch library and faces take their simulator paths, and stands in for the Emscripten API.
+ifdef HEADLESS
+CC = cc
+CFLAGS += -D__EMSCRIPTEN__=1 -DWATCH_SIMULATOR_HEADLESS
+CFLAGS += -g -O1
+LIBS += -lm
+
+INCLUDES += \
+  -I$(TOP)/watch-library/simulator/headless/ \
+
+SRCS += \
+  $(TOP)/watch-library/simulator/headless/headless_main.c \
+  $(TOP)/watch-library/simulator/headless/headless_runtime.c \
+
+# Set SIM_RELEASE=1 for the browser simulator we host: -Oz, with the JavaScript minified by the Closure Compiler (which
+# has to be told what the page shares with the program; see sim_externs.js) and a gzipped copy of the .wasm alongside,
+# for a server that can send it precompressed. Emscripten already compiles the .wasm as it downloads, as long as it's
+# served as application/wasm.
+else ifdef SIM_RELEASE
+CFLAGS += -Oz
+LDFLAGS += -Oz --closure 1 --closure-args=--externs=$(abspath $(TOP)/watch-library/simulator/sim_externs.js)
+endif
+
 INCLUDES += \
   -I$(TOP)/boards/$(BOARD) \
   -I$(TOP)/watch-library/shared/driver/ \
@@ -183,6 +255,8 @@ INCLUDES += \
 
 SRCS += \
   $(TOP)/watch-library/simulator/main.c \
+  $(TOP)/watch-library/simulator/watch/watch_sim_clock.c \
+  $(TOP)/watch-library/simulator/watch/watch_sim_energy.c \
   $(TOP)/watch-library/simulator/watch/watch_rtc.c \
   $(TOP)/watch-library/simulator/watch/watch_slcd.c \
   $(TOP)/watch-library/simulator/watch/watch_extint.c \
@@ -194,17 +268,40 @@ SRCS += \
   $(TOP)/watch-library/simulator/watch/watch_spi.c \
   $(TOP)/watch-library/simulator/watch/watch_uart.c \
   $(TOP)/watch-library/simulator/watch/watch_storage.c \
+  $(TOP)/watch-library/simulator/watch/watch_firmware.c \
   $(TOP)/watch-library/simulator/watch/watch_deepsleep.c \
+  $(TOP)/watch-library/simulator/watch/watch_regulator.c \
+  $(TOP)/watch-library/simulator/watch/watch_clocks.c \
+  $(TOP)/watch-library/simulator/watch/watch_memory.c \
   $(TOP)/watch-library/simulator/watch/watch_private.c \
+  $(TOP)/watch-library/simulator/watch/watch_private_aes.c \
+  $(TOP)/watch-library/simulator/watch/watch_input_trace.c \
   $(TOP)/watch-library/simulator/watch/watch.c \
   $(TOP)/watch-library/shared/driver/thermistor_driver.c \
+  $(TOP)/watch-library/shared/driver/lis2dw.c \
   $(TOP)/watch-library/shared/driver/opt3001.c \
+  $(TOP)/watch-library/shared/driver/spiflash.c \
   $(TOP)/watch-library/shared/watch/watch_private_buzzer.c \
   $(TOP)/watch-library/shared/watch/watch_private_display.c \
+  $(TOP)/watch-library/shared/watch/watch_power.c \
+  $(TOP)/watch-library/shared/watch/watch_power_trace.c \
+  $(TOP)/watch-library/shared/watch/watch_random.c \
+  $(TOP)/watch-library/shared/watch/watch_crc.c \
+  $(TOP)/watch-library/shared/watch/watch_battery.c \
+  $(TOP)/watch-library/shared/watch/watch_aes.c \
+  $(TOP)/watch-library/shared/watch/watch_fmt.c \
+  $(TOP)/watch-library/shared/watch/watch_math.c \
   $(TOP)/watch-library/shared/watch/watch_utility.c \
 
 endif
 
+# Headers generated at build time (i.e. the display glyph tables) are written to the build directory.
+INCLUDES += \
+  -I$(BUILD) \
+
+GENERATED_HEADERS += \
+  $(BUILD)/watch_display_glyphs.h \
+
 ifeq ($(LED), BLUE)
 CFLAGS += -DWATCH_IS_BLUE_BOARD
 endif
@@ -227,6 +324,44 @@ CFLAGS += -DMOVEMENT_FIRMWARE_$(FIRMWARE)=1
 CFLAGS += -DMOVEMENT_FIRMWARE=MOVEMENT_FIRMWARE_$(FIRMWARE)
 endif
 
+# Set MOVEMENT_CONFIG to the path of a header laid out like movement_config.h to build with that instead. Give each
+# one its own BUILD directory, since make won't rebuild everything when only this changes.
+ifdef MOVEMENT_CONFIG
+CFLAGS += -DMOVEMENT_CONFIG_FILE='"$(abspath $(MOVEMENT_CONFIG))"'
+endif
+
+ifdef FILESYSTEM_PROFILE
+CFLAGS += -DFILESYSTEM_PROFILE_$(FILESYSTEM_PROFILE)=1
+endif
+
+ifdef FILESYSTEM_RAW_ROWS
+CFLAGS += -DFILESYSTEM_RAW_ROWS=$(FILESYSTEM_RAW_ROWS)
+endif
+
+# Set MODULE_SLOTS to the number of faces, up to 4, that run modules installed with the shell's module command (see
+# movement_modules.h). Each slot takes 2 KB of the raw partition, which has to be in main flash, so this needs
+# FILESYSTEM_RAW_ROWS and FILESYSTEM_MAIN_FLASH_KB too, and module_slot_0_face and so on in movement_config.h.
+ifdef MODULE_SLOTS
+CFLAGS += -DMOVEMENT_NUM_MODULE_SLOTS=$(MODULE_SLOTS)
+endif
+
+# Set FILESYSTEM_MAIN_FLASH_KB to give the filesystem that many kilobytes of main flash after the 8 KB RWWEE area, for
+# logs and the like. It comes off the top of the firmware's space, and the link fails if the firmware doesn't fit in
+# what's left. Writes to those rows stall the CPU while they're under way. Changing it reformats the filesystem, and
+# FILESYSTEM_WEAR_STATS can only keep count for up to 6 KB of it.
+ifdef FILESYSTEM_MAIN_FLASH_KB
+CFLAGS += -DWATCH_STORAGE_MAIN_FLASH_KB=$(FILESYSTEM_MAIN_FLASH_KB)
+ifeq ($(EMSCRIPTEN)$(HEADLESS),)
+LDFLAGS += -Wl,--defsym=__main_storage_size__=$(FILESYSTEM_MAIN_FLASH_KB)*1024
+endif
+endif
+
+# Set FILESYSTEM_WEAR_STATS=1 to count the erases of each storage row, kept in a row of their own, and add the
+# shell's wear command. That row comes out of the filesystem, so turning this on or off reformats it.
+ifdef FILESYSTEM_WEAR_STATS
+CFLAGS += -DFILESYSTEM_WEAR_STATS
+endif
+
 ifeq ($(BOARD), OSO-FEAL-A1-00)
 CFLAGS += -DCRYSTALLESS
 endif
@@ -236,3 +371,80 @@ endif
 ifdef CLOCK_FACE_24H_ONLY
 CFLAGS += -DCLOCK_FACE_24H_ONLY
 endif
+
+# Set FAST_MATH=1 to have sunriset and astrolib use watch_math's approximations of sin, cos, acos, atan2 and the rest
+# rather than libm's (see watch_math.h). They're float only, so this builds those libraries in single precision too.
+ifdef FAST_MATH
+SINGLE_PRECISION_ASTRO = 1
+CFLAGS += -DWATCH_FAST_MATH
+endif
+
+# Set SINGLE_PRECISION_ASTRO=1 to build sunriset and astrolib in float rather than double (see their headers).
+ifdef SINGLE_PRECISION_ASTRO
+CFLAGS += -DSUNRISET_SINGLE_PRECISION
+CFLAGS += -DASTROLIB_SINGLE_PRECISION
+endif
+
+# Set EPHEMERIS_ONLY=1 to leave the VSOP87 series out of astrolib and rely on the Chebyshev table in
+# movement/lib/ephemeris, which only covers the years it was generated for (see utils/gen_ephemeris_table.py).
+ifdef EPHEMERIS_ONLY
+CFLAGS += -DASTROLIB_NO_VSOP87
+endif
+
+# Set VSOP87_BODIES to keep the VSOP87 series for only the bodies a build's faces need outside the ephemeris table,
+# e.g. VSOP87_BODIES="EARTH MOON"; the others use the nearest end of the table. Bodies also listed in VSOP87_MICRO use
+# vsop87a_micro, which is a fraction of the size but much rougher; VSOP87_MICRO on its own keeps every
+# body. Bodies are named as in astro_body_t, without ASTRO_BODY_.
+VSOP87_ALL_BODIES = MERCURY VENUS EARTH MARS JUPITER SATURN URANUS NEPTUNE EMB MOON
+ifneq ($(VSOP87_BODIES)$(VSOP87_MICRO),)
+CFLAGS += -DASTROLIB_VSOP87_BODY_LIST
+CFLAGS += $(foreach body,$(or $(VSOP87_BODIES),$(VSOP87_ALL_BODIES)),\
+  -DASTROLIB_VSOP87_$(body)=$(if $(filter $(body),$(VSOP87_MICRO)),micro,milli))
+endif
+
+# Set WAKE_ON_ANY_BUTTON=1 to let LIGHT and MODE wake the watch from low energy mode as well as ALARM. This keeps the
+# external interrupt controller running while asleep, which costs a little more current.
+ifdef WAKE_ON_ANY_BUTTON
+CFLAGS += -DMOVEMENT_WAKE_ON_ANY_BUTTON
+endif
+
+# Set POWER_TRACE=1 to put the code region the watch is in on sensor board pins A0-A2, for lining up a power
+# analyzer's trace with the code (see watch_power_trace.h and utils/power_trace_energy.py).
+ifdef POWER_TRACE
+CFLAGS += -DMOVEMENT_POWER_TRACE
+endif
+
+# Set INPUT_TRACE=1 to let the shell's trace command record button edges, I2C reads and ADC readings, for playing back
+# in the simulator (see watch_input_trace.h and utils/input_trace_record.py).
+ifdef INPUT_TRACE
+CFLAGS += -DMOVEMENT_INPUT_TRACE
+endif
+
+# Set PROFILER=1 to let the shell's prof command sample where the CPU spends its time, and print branch traces from
+# the Micro Trace Buffer (see watch_profiler.h and utils/profile_report.py).
+ifdef PROFILER
+CFLAGS += -DMOVEMENT_PROFILER
+endif
+
+# Set STACK_USAGE=1 to have the compiler write out each function's stack frame and the functions it calls, next to
+# its object file, for make stack-report (see watch_memory.h and utils/stack_report.py).
+ifdef STACK_USAGE
+ifndef EMSCRIPTEN
+CFLAGS += -fstack-usage -fcallgraph-info=su
+endif
+endif
+
+# Set LOG_LEVEL to none, error, warn, info or debug to choose which of the WATCH_LOG_ macros are compiled in; info
+# unless you say otherwise (see watch_log.h and utils/log_decode.py).
+ifdef LOG_LEVEL
+CFLAGS += -DWATCH_LOG_LEVEL=WATCH_LOG_LEVEL_$(shell echo $(LOG_LEVEL) | tr a-z A-Z)
+endif
+
+# Set USB_MSC=1 to add a USB mass storage interface that shows the filesystem, and the accelerometer log in SPI flash,
+# to the host as a read-only drive (see movement_usb_msc.h). littlefs is built with its lock hooks for this.
+ifdef USB_MSC
+CFLAGS += -DMOVEMENT_USB_MSC -DLFS_THREADSAFE
+ifeq ($(EMSCRIPTEN)$(HEADLESS),)
+SRCS += $(TOP)/tinyusb/src/class/msc/msc_device.c
+endif
+endif
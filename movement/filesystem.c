@@ -4,6 +4,7 @@
 #include <peripheral_clk_config.h>
 #include "filesystem.h"
 #include "watch.h"
+#include "watch_utility.h"
 #include "lfs.h"
 #include "hpl_flash.h"
 
@@ -11,20 +12,180 @@ int lfs_storage_read(const struct lfs_config *cfg, lfs_block_t block, lfs_off_t
 int lfs_storage_prog(const struct lfs_config *cfg, lfs_block_t block, lfs_off_t off, const void *buffer, lfs_size_t size);
 int lfs_storage_erase(const struct lfs_config *cfg, lfs_block_t block);
 int lfs_storage_sync(const struct lfs_config *cfg);
+#ifdef LFS_THREADSAFE
+int lfs_storage_lock(const struct lfs_config *cfg);
+int lfs_storage_unlock(const struct lfs_config *cfg);
+#endif
+
+// littlefs geometry. the defaults suit the 8 KB RWWEE area; build with FILESYSTEM_PROFILE=FAST or
+// FILESYSTEM_PROFILE=LOW_WEAR to pick another set, or override any one of these with -D to try it out.
+#if defined(FILESYSTEM_PROFILE_FAST)
+// whole-page reads mean fewer trips through the block device, and relocating metadata less often makes
+// writes cheaper at the cost of less even wear.
+#define FILESYSTEM_DEFAULT_READ_SIZE NVMCTRL_PAGE_SIZE
+#define FILESYSTEM_DEFAULT_BLOCK_CYCLES 500
+#elif defined(FILESYSTEM_PROFILE_LOW_WEAR)
+#define FILESYSTEM_DEFAULT_READ_SIZE 16
+#define FILESYSTEM_DEFAULT_BLOCK_CYCLES 50
+#else
+#define FILESYSTEM_DEFAULT_READ_SIZE 16
+#define FILESYSTEM_DEFAULT_BLOCK_CYCLES 100
+#endif
+
+#ifndef FILESYSTEM_READ_SIZE
+#define FILESYSTEM_READ_SIZE FILESYSTEM_DEFAULT_READ_SIZE
+#endif
+#ifndef FILESYSTEM_CACHE_SIZE
+#define FILESYSTEM_CACHE_SIZE NVMCTRL_PAGE_SIZE
+#endif
+#ifndef FILESYSTEM_BLOCK_CYCLES
+#define FILESYSTEM_BLOCK_CYCLES FILESYSTEM_DEFAULT_BLOCK_CYCLES
+#endif
+#ifndef FILESYSTEM_LOOKAHEAD_SIZE
+// one bit per block, in multiples of 8 bytes; 8 bytes already covers all 32 blocks, so the allocator finds
+// every free block in a single scan and anything larger is wasted RAM.
+#define FILESYSTEM_LOOKAHEAD_SIZE 8
+#endif
+
+// rows at the end of the storage area can be set aside for read-only data that's used in place, rather than read
+// through littlefs into RAM. changing this changes the filesystem's size, which means reformatting it.
+#ifndef FILESYSTEM_RAW_ROWS
+#define FILESYSTEM_RAW_ROWS 0
+#endif
+// with FILESYSTEM_WEAR_STATS, the very last row keeps a count of the erases of every row; like the raw rows, it
+// comes out of littlefs's share, so turning it on or off means reformatting.
+#ifdef FILESYSTEM_WEAR_STATS
+#define FILESYSTEM_WEAR_ROWS 1
+#else
+#define FILESYSTEM_WEAR_ROWS 0
+#endif
+// the RWWEE rows, and any main flash rows the build gives us after them (@see watch_storage.h).
+#define FILESYSTEM_NUM_ROWS WATCH_STORAGE_NUM_ROWS
+#define FILESYSTEM_LFS_ROWS (FILESYSTEM_NUM_ROWS - FILESYSTEM_RAW_ROWS - FILESYSTEM_WEAR_ROWS)
+
+_Static_assert(FILESYSTEM_RAW_ROWS + FILESYSTEM_WEAR_ROWS < FILESYSTEM_NUM_ROWS - 1, "littlefs needs at least two rows");
+_Static_assert(FILESYSTEM_CACHE_SIZE % FILESYSTEM_READ_SIZE == 0, "cache size must be a multiple of the read size");
+_Static_assert(FILESYSTEM_CACHE_SIZE % NVMCTRL_PAGE_SIZE == 0, "cache size must be a multiple of the page size");
+_Static_assert(NVMCTRL_ROW_SIZE % FILESYSTEM_CACHE_SIZE == 0, "cache size must evenly divide the row size");
+_Static_assert(FILESYSTEM_LOOKAHEAD_SIZE % 8 == 0, "lookahead size must be a multiple of 8");
+
+// block device traffic, for measuring how a given geometry performs.
+static uint32_t storage_reads;
+static uint32_t storage_bytes_read;
+// bumped by every program and erase; @see filesystem_get_generation.
+static uint32_t storage_generation;
+
+#ifdef FILESYSTEM_WEAR_STATS
+
+#define FILESYSTEM_WEAR_ROW (FILESYSTEM_NUM_ROWS - 1)
+// the counts are saved once this many erases have gone uncounted, so that keeping them costs the wear row one erase
+// for every 2 * 16 erases elsewhere. a reset loses any that haven't been saved yet.
+#ifndef FILESYSTEM_WEAR_SAVE_ERASES
+#define FILESYSTEM_WEAR_SAVE_ERASES 16
+#endif
+// the erases a row is good for, to project its lifetime against. the RWWEE array is rated for more than this;
+// it's a conservative figure, so that a projection errs towards early.
+#ifndef FILESYSTEM_WEAR_ENDURANCE
+#define FILESYSTEM_WEAR_ENDURANCE 25000
+#endif
+_Static_assert(FILESYSTEM_NUM_ROWS <= (NVMCTRL_ROW_SIZE / 2 - 16) / 2, "FILESYSTEM_WEAR_STATS counts at most 56 rows, which is 6 KB of FILESYSTEM_MAIN_FLASH_KB");
+// changes when the layout below does, or the number of rows, so that a record of some other geometry isn't read.
+#define FILESYSTEM_WEAR_MAGIC (0x57454100 | FILESYSTEM_NUM_ROWS)
+
+// the wear row holds two of these, one in each half; the newer one (by sequence) is current. saving writes the
+// other half, and erases the row first only when that half isn't blank. the sequence is written again at the very
+// end, so a record cut short by a reset doesn't match and the older one stands.
+typedef struct {
+    uint32_t magic;
+    uint32_t sequence;
+    // when counting began, in seconds since 1970 by the watch's clock.
+    uint32_t started;
+    uint16_t erases[FILESYSTEM_NUM_ROWS];
+    uint8_t padding[NVMCTRL_ROW_SIZE / 2 - 16 - 2 * FILESYSTEM_NUM_ROWS];
+    uint32_t sequence_check;
+} filesystem_wear_record_t;
+
+_Static_assert(sizeof(filesystem_wear_record_t) == NVMCTRL_ROW_SIZE / 2, "a wear record fills half a row");
+
+static filesystem_wear_record_t wear;
+static bool wear_loaded;
+static uint8_t wear_unsaved;
+// which half of the wear row the next save goes to.
+static uint8_t wear_next_slot;
+
+static uint32_t _filesystem_wear_now(void) {
+    return watch_utility_date_time_to_unix_time(watch_rtc_get_date_time(), 0);
+}
+
+static void _filesystem_wear_load(void) {
+    if (wear_loaded) return;
+    wear_loaded = true;
+
+    const filesystem_wear_record_t *records = (const filesystem_wear_record_t *)watch_storage_get_address(FILESYSTEM_WEAR_ROW, 0);
+    int8_t current = -1;
+    for (uint8_t i = 0; i < 2; i++) {
+        if (records[i].magic != FILESYSTEM_WEAR_MAGIC || records[i].sequence != records[i].sequence_check) continue;
+        if (current < 0 || records[i].sequence > records[current].sequence) current = i;
+    }
+    if (current < 0) {
+        memset(&wear, 0, sizeof(wear));
+        wear.magic = FILESYSTEM_WEAR_MAGIC;
+        wear.started = _filesystem_wear_now();
+        wear_next_slot = 0;
+        return;
+    }
+    memcpy(&wear, &records[current], sizeof(wear));
+    wear_next_slot = !current;
+}
+
+static void _filesystem_wear_save(void) {
+    const uint32_t *slot = (const uint32_t *)watch_storage_get_address(FILESYSTEM_WEAR_ROW, wear_next_slot * sizeof(wear));
+    bool blank = true;
+    for (uint8_t i = 0; i < sizeof(wear) / sizeof(uint32_t); i++) blank = blank && slot[i] == 0xFFFFFFFF;
+    if (!blank) {
+        // erasing takes the current record with it, so the new one goes straight into the first half; a reset in the
+        // moment between the two loses the counts.
+        wear_next_slot = 0;
+        if (wear.erases[FILESYSTEM_WEAR_ROW] < UINT16_MAX) wear.erases[FILESYSTEM_WEAR_ROW]++;
+        watch_storage_erase(FILESYSTEM_WEAR_ROW);
+    }
+    wear.sequence++;
+    wear.sequence_check = wear.sequence;
+    wear_unsaved = 0;
+    watch_storage_write(FILESYSTEM_WEAR_ROW, wear_next_slot * sizeof(wear), (const uint8_t *)&wear, sizeof(wear));
+    wear_next_slot = !wear_next_slot;
+}
+
+static void _filesystem_count_erase(uint32_t row) {
+    _filesystem_wear_load();
+    // a row past 65535 erases is long past its rating, so the count stops there rather than wrapping.
+    if (wear.erases[row] < UINT16_MAX) wear.erases[row]++;
+    if (++wear_unsaved >= FILESYSTEM_WEAR_SAVE_ERASES) _filesystem_wear_save();
+}
+
+#else
+#define _filesystem_count_erase(row) ((void)(row))
+#endif
 
 int lfs_storage_read(const struct lfs_config *cfg, lfs_block_t block, lfs_off_t off, void *buffer, lfs_size_t size) {
     (void) cfg;
+    storage_reads++;
+    storage_bytes_read += size;
     return !watch_storage_read(block, off, (void *)buffer, size);
 }
 
 int lfs_storage_prog(const struct lfs_config *cfg, lfs_block_t block, lfs_off_t off, const void *buffer, lfs_size_t size) {
     (void) cfg;
+    storage_generation++;
     return !watch_storage_write(block, off, (void *)buffer, size);
 }
 
 int lfs_storage_erase(const struct lfs_config *cfg, lfs_block_t block) {
     (void) cfg;
-    return !watch_storage_erase(block);
+    storage_generation++;
+    if (!watch_storage_erase(block)) return LFS_ERR_IO;
+    _filesystem_count_erase(block);
+    return LFS_ERR_OK;
 }
 
 int lfs_storage_sync(const struct lfs_config *cfg) {
@@ -32,27 +193,169 @@ int lfs_storage_sync(const struct lfs_config *cfg) {
     return !watch_storage_sync();
 }
 
+#ifdef LFS_THREADSAFE
+// set for the length of each littlefs call. only the main loop ever finds it set, and then only if it was
+// interrupted inside one, so there's nothing to wait for; @see filesystem_is_busy.
+static volatile bool storage_locked;
+
+int lfs_storage_lock(const struct lfs_config *cfg) {
+    (void) cfg;
+    storage_locked = true;
+    return LFS_ERR_OK;
+}
+
+int lfs_storage_unlock(const struct lfs_config *cfg) {
+    (void) cfg;
+    storage_locked = false;
+    return LFS_ERR_OK;
+}
+#endif
+
 const struct lfs_config cfg = {
     // block device operations
     .read  = lfs_storage_read,
     .prog  = lfs_storage_prog,
     .erase = lfs_storage_erase,
     .sync  = lfs_storage_sync,
+#ifdef LFS_THREADSAFE
+    .lock = lfs_storage_lock,
+    .unlock = lfs_storage_unlock,
+#endif
 
     // block device configuration
-    .read_size = 16,
+    .read_size = FILESYSTEM_READ_SIZE,
     .prog_size = NVMCTRL_PAGE_SIZE,
     .block_size = NVMCTRL_ROW_SIZE,
-    .block_count = NVMCTRL_RWWEE_PAGES / 4,
-    .cache_size = NVMCTRL_PAGE_SIZE,
-    .lookahead_size = 16,
-    .block_cycles = 100,
+    .block_count = FILESYSTEM_LFS_ROWS,
+    .cache_size = FILESYSTEM_CACHE_SIZE,
+    .lookahead_size = FILESYSTEM_LOOKAHEAD_SIZE,
+    .block_cycles = FILESYSTEM_BLOCK_CYCLES,
 };
 
 static lfs_t lfs;
 static lfs_file_t file;
 static struct lfs_info info;
 
+// a few files stay open for reading between calls, so that reading a file line by line, or reading the same file
+// again, doesn't have to find it in the metadata each time. any change to the filesystem closes them all.
+#define FILESYSTEM_NUM_CACHED_FILES 2
+#define FILESYSTEM_CACHED_NAME_MAX 31
+
+typedef struct {
+    lfs_file_t file;
+    struct lfs_file_config config;
+    uint8_t buffer[FILESYSTEM_CACHE_SIZE];
+    char filename[FILESYSTEM_CACHED_NAME_MAX + 1];
+    uint32_t last_used;
+    bool is_open;
+} filesystem_cached_file_t;
+
+static filesystem_cached_file_t cached_files[FILESYSTEM_NUM_CACHED_FILES];
+static uint32_t cached_file_clock;
+
+// the sizes of a few files, or that they aren't there, so that checking on a file and then reading it doesn't look it
+// up in the metadata each time. every write to storage changes the generation, which leaves them all out of date.
+#define FILESYSTEM_NUM_STAT_ENTRIES 4
+
+typedef struct {
+    char filename[FILESYSTEM_CACHED_NAME_MAX + 1];
+    int32_t size;   // -1 if there's no such file.
+    uint32_t generation;
+    uint32_t last_used;
+} filesystem_stat_entry_t;
+
+static filesystem_stat_entry_t stat_entries[FILESYSTEM_NUM_STAT_ENTRIES];
+
+static filesystem_stat_entry_t *_filesystem_find_stat(const char *filename) {
+    for (uint8_t i = 0; i < FILESYSTEM_NUM_STAT_ENTRIES; i++) {
+        filesystem_stat_entry_t *entry = &stat_entries[i];
+        if (entry->filename[0] && entry->generation == storage_generation && strcmp(entry->filename, filename) == 0) {
+            entry->last_used = ++cached_file_clock;
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+static void _filesystem_note_stat(const char *filename, int32_t size) {
+    if (strlen(filename) > FILESYSTEM_CACHED_NAME_MAX) return;
+    filesystem_stat_entry_t *entry = _filesystem_find_stat(filename);
+
+    if (entry == NULL) {
+        // reuse one that's out of date, or else the least recently used one.
+        entry = &stat_entries[0];
+        for (uint8_t i = 0; i < FILESYSTEM_NUM_STAT_ENTRIES; i++) {
+            if (stat_entries[i].generation != storage_generation) {
+                entry = &stat_entries[i];
+                break;
+            }
+            if (stat_entries[i].last_used < entry->last_used) entry = &stat_entries[i];
+        }
+        strcpy(entry->filename, filename);
+        entry->generation = storage_generation;
+        entry->last_used = ++cached_file_clock;
+    }
+    entry->size = size;
+}
+
+static filesystem_cached_file_t *_filesystem_find_cached_file(char *filename) {
+    for (uint8_t i = 0; i < FILESYSTEM_NUM_CACHED_FILES; i++) {
+        if (cached_files[i].is_open && strcmp(cached_files[i].filename, filename) == 0) {
+            cached_files[i].last_used = ++cached_file_clock;
+            return &cached_files[i];
+        }
+    }
+    return NULL;
+}
+
+static lfs_file_t *_filesystem_open_cached_file(char *filename) {
+    if (strlen(filename) > FILESYSTEM_CACHED_NAME_MAX) return NULL;
+    filesystem_cached_file_t *cached = _filesystem_find_cached_file(filename);
+    if (cached != NULL) return &cached->file;
+
+    // reuse a free slot, or else the least recently used one.
+    cached = &cached_files[0];
+    for (uint8_t i = 0; i < FILESYSTEM_NUM_CACHED_FILES; i++) {
+        if (!cached_files[i].is_open) {
+            cached = &cached_files[i];
+            break;
+        }
+        if (cached_files[i].last_used < cached->last_used) cached = &cached_files[i];
+    }
+    if (cached->is_open) lfs_file_close(&lfs, &cached->file);
+
+    cached->config.buffer = cached->buffer;
+    int err = lfs_file_opencfg(&lfs, &cached->file, filename, LFS_O_RDONLY, &cached->config);
+    cached->is_open = err == LFS_ERR_OK;
+    if (!cached->is_open) {
+        if (err == LFS_ERR_NOENT) _filesystem_note_stat(filename, -1);
+        return NULL;
+    }
+    strcpy(cached->filename, filename);
+    _filesystem_note_stat(filename, lfs_file_size(&lfs, &cached->file));
+    cached->last_used = ++cached_file_clock;
+
+    return &cached->file;
+}
+
+// walking the whole filesystem to count used blocks is slow, so the count is kept until something changes.
+static int32_t used_blocks = -1;
+
+// the filesystem is mounted the first time anything uses it, rather than at boot.
+static bool mounted;
+
+static inline bool _filesystem_mount(void) {
+    return mounted || filesystem_init();
+}
+
+static void _filesystem_close_cached_files(void) {
+    for (uint8_t i = 0; i < FILESYSTEM_NUM_CACHED_FILES; i++) {
+        if (cached_files[i].is_open) lfs_file_close(&lfs, &cached_files[i].file);
+        cached_files[i].is_open = false;
+    }
+    used_blocks = -1;
+}
+
 static int _traverse_df_cb(void *p, lfs_block_t block) {
     (void) block;
 	uint32_t *nb = p;
@@ -63,13 +366,17 @@ static int _traverse_df_cb(void *p, lfs_block_t block) {
 int32_t filesystem_get_free_space(void) {
 	int err;
 
-	uint32_t free_blocks = 0;
-	err = lfs_fs_traverse(&lfs, _traverse_df_cb, &free_blocks);
-	if(err < 0){
-		return err;
+	if (!_filesystem_mount()) return -1;
+	if (used_blocks < 0) {
+		uint32_t blocks = 0;
+		err = lfs_fs_traverse(&lfs, _traverse_df_cb, &blocks);
+		if(err < 0){
+			return err;
+		}
+		used_blocks = blocks;
 	}
 
-	uint32_t available = cfg.block_count * cfg.block_size - free_blocks * cfg.block_size;
+	uint32_t available = cfg.block_count * cfg.block_size - used_blocks * cfg.block_size;
 
 	return (int32_t)available;
 }
@@ -112,30 +419,50 @@ static int filesystem_ls(lfs_t *lfs, const char *path) {
 }
 
 bool filesystem_init(void) {
+    if (mounted) return true;
+    uint32_t start = watch_get_cycle_counter();
     int err = lfs_mount(&lfs, &cfg);
+    uint32_t cycles = (watch_get_cycle_counter() - start) & WATCH_CYCLE_COUNTER_MASK;
+    WATCH_LOG_INFO("Filesystem mount took %lu cycles, %lu reads, %lu bytes.", cycles, storage_reads, storage_bytes_read);
 
     // reformat if we can't mount the filesystem
     // this should only happen on the first boot
     if (err < 0) {
-        printf("Ignore that error! Formatting filesystem...\r\n");
+        WATCH_LOG_WARN("Ignore that error! Formatting filesystem...");
         err = lfs_format(&lfs, &cfg);
         if (err < 0) return false;
-        err = lfs_mount(&lfs, &cfg) == LFS_ERR_OK;
-        printf("Filesystem mounted with %ld bytes free.\r\n", filesystem_get_free_space());
+        err = lfs_mount(&lfs, &cfg);
+        if (err != LFS_ERR_OK) return false;
+        mounted = true;
+        WATCH_LOG_INFO("Filesystem mounted with %ld bytes free.", filesystem_get_free_space());
     }
 
-    return err == LFS_ERR_OK;
+    mounted = err == LFS_ERR_OK;
+    return mounted;
 }
 
-bool filesystem_file_exists(char *filename) {
+// returns the size of a file, or -1 if there's no such file.
+static int32_t _filesystem_stat(char *filename) {
+    filesystem_stat_entry_t *entry = _filesystem_find_stat(filename);
+    if (entry != NULL) return entry->size;
+
+    if (!_filesystem_mount()) return -1;
     info.type = 0;
-    lfs_stat(&lfs, filename, &info);
-    return info.type == LFS_TYPE_REG;
+    int err = lfs_stat(&lfs, filename, &info);
+    int32_t size = info.type == LFS_TYPE_REG ? (int32_t)info.size : -1;
+    // an error reading the metadata may not happen next time, so only a definite answer is kept.
+    if (err == LFS_ERR_OK || err == LFS_ERR_NOENT) _filesystem_note_stat(filename, size);
+
+    return size;
+}
+
+bool filesystem_file_exists(char *filename) {
+    return _filesystem_stat(filename) >= 0;
 }
 
 bool filesystem_rm(char *filename) {
-    info.type = 0;
-    lfs_stat(&lfs, filename, &info);
+    if (!_filesystem_mount()) return false;
+    _filesystem_close_cached_files();
     if (filesystem_file_exists(filename)) {
         return lfs_remove(&lfs, filename) == LFS_ERR_OK;
     } else {
@@ -144,38 +471,66 @@ bool filesystem_rm(char *filename) {
     }
 }
 
+bool filesystem_rename(char *old_filename, char *new_filename) {
+    if (!_filesystem_mount()) return false;
+    _filesystem_close_cached_files();
+    return lfs_rename(&lfs, old_filename, new_filename) == LFS_ERR_OK;
+}
+
 int32_t filesystem_get_file_size(char *filename) {
-    if (filesystem_file_exists(filename)) {
-        return info.size; // info struct was just populated by filesystem_file_exists
+    filesystem_cached_file_t *cached = _filesystem_find_cached_file(filename);
+    if (cached != NULL) return lfs_file_size(&lfs, &cached->file);
+
+    return _filesystem_stat(filename);
+}
+
+// reads from a file, if it's expected_size bytes long or expected_size is -1.
+static bool _filesystem_read_cached_file(char *filename, char *buf, int32_t offset, int32_t length, int32_t expected_size) {
+    if (!_filesystem_mount()) return false;
+    lfs_file_t *cached_file = NULL;
+    lfs_file_t *read_file;
+    if (strlen(filename) <= FILESYSTEM_CACHED_NAME_MAX) {
+        // a file that can't be opened to cache can't be opened at all.
+        cached_file = _filesystem_open_cached_file(filename);
+        if (cached_file == NULL) return false;
+        read_file = cached_file;
+    } else {
+        // the name is too long to cache; open it the old-fashioned way.
+        if (lfs_file_open(&lfs, &file, filename, LFS_O_RDONLY) < 0) return false;
+        read_file = &file;
     }
 
-    return -1;
+    int32_t file_size = lfs_file_size(&lfs, read_file);
+    bool success = file_size > offset && (expected_size < 0 || file_size == expected_size);
+    // seeking within an open file is cheap; it's finding the file in the first place that costs us.
+    if (success && lfs_file_tell(&lfs, read_file) != offset) success = lfs_file_seek(&lfs, read_file, offset, LFS_SEEK_SET) >= 0;
+    if (success) success = lfs_file_read(&lfs, read_file, buf, min(length, file_size - offset)) >= 0;
+
+    if (cached_file == NULL) success = (lfs_file_close(&lfs, &file) == LFS_ERR_OK) && success;
+    return success;
 }
 
 bool filesystem_read_file(char *filename, char *buf, int32_t length) {
     memset(buf, 0, length);
-    int32_t file_size = filesystem_get_file_size(filename);
-    if (file_size > 0) {
-        int err = lfs_file_open(&lfs, &file, filename, LFS_O_RDONLY);
-        if (err < 0) return false;
-        err = lfs_file_read(&lfs, &file, buf, min(length, file_size));
-        if (err < 0) return false;
-        return lfs_file_close(&lfs, &file) == LFS_ERR_OK;
-    }
+    return _filesystem_read_cached_file(filename, buf, 0, length, -1);
+}
 
-    return false;
+bool filesystem_read_file_if_size(char *filename, char *buf, int32_t expected_size) {
+    memset(buf, 0, expected_size);
+    // a file the cache knows is missing, or the wrong size, needn't be looked for at all.
+    filesystem_stat_entry_t *entry = _filesystem_find_stat(filename);
+    if (entry != NULL && entry->size != expected_size) return false;
+    return _filesystem_read_cached_file(filename, buf, 0, expected_size, expected_size);
+}
+
+bool filesystem_read_file_at(char *filename, char *buf, int32_t offset, int32_t length) {
+    memset(buf, 0, length);
+    return _filesystem_read_cached_file(filename, buf, offset, length, -1);
 }
 
 bool filesystem_read_line(char *filename, char *buf, int32_t *offset, int32_t length) {
     memset(buf, 0, length + 1);
-    int32_t file_size = filesystem_get_file_size(filename);
-    if (file_size > 0) {
-        int err = lfs_file_open(&lfs, &file, filename, LFS_O_RDONLY);
-        if (err < 0) return false;
-        err = lfs_file_seek(&lfs, &file, *offset, LFS_SEEK_SET);
-        if (err < 0) return false;
-        err = lfs_file_read(&lfs, &file, buf, min(length - 1, file_size - *offset));
-        if (err < 0) return false;
+    if (_filesystem_read_cached_file(filename, buf, *offset, length - 1, -1)) {
         for(int i = 0; i < length; i++) {
             (*offset)++;
             if (buf[i] == '\n') {
@@ -183,31 +538,74 @@ bool filesystem_read_line(char *filename, char *buf, int32_t *offset, int32_t le
                 break;
             }
         }
-        return lfs_file_close(&lfs, &file) == LFS_ERR_OK;
+        return true;
     }
 
     return false;
 }
 
+bool filesystem_list_files(filesystem_list_callback_t callback, void *context) {
+    lfs_dir_t dir;
+    if (!_filesystem_mount() || lfs_dir_open(&lfs, &dir, "/") < 0) return false;
+
+    // not the shared info struct: this may be interrupting a main loop that's using it.
+    struct lfs_info entry;
+    int res;
+    while ((res = lfs_dir_read(&lfs, &dir, &entry)) > 0) {
+        if (entry.type != LFS_TYPE_REG) continue;
+        if (!callback(entry.name, entry.size, context)) break;
+    }
+
+    return (lfs_dir_close(&lfs, &dir) == LFS_ERR_OK) && res >= 0;
+}
+
+uint32_t filesystem_get_generation(void) {
+    return storage_generation;
+}
+
+#ifdef LFS_THREADSAFE
+// a file, and its buffer, of its own for filesystem_read_file_uncached, so that it never has to allocate one.
+static lfs_file_t uncached_file;
+static uint8_t uncached_file_buffer[FILESYSTEM_CACHE_SIZE];
+
+bool filesystem_is_busy(void) {
+    return storage_locked;
+}
+
+int32_t filesystem_read_file_uncached(const char *filename, void *buf, int32_t offset, int32_t length) {
+    // this runs in an interrupt, where it's no time to be mounting anything; the main loop will have by now.
+    if (!mounted) return -1;
+    struct lfs_file_config config = { .buffer = uncached_file_buffer };
+    if (lfs_file_opencfg(&lfs, &uncached_file, filename, LFS_O_RDONLY, &config) < 0) return -1;
+
+    int32_t result = lfs_file_seek(&lfs, &uncached_file, offset, LFS_SEEK_SET);
+    if (result >= 0) result = lfs_file_read(&lfs, &uncached_file, buf, length);
+
+    if (lfs_file_close(&lfs, &uncached_file) < 0) result = -1;
+    return result;
+}
+#endif
+
 static void filesystem_cat(char *filename) {
-    info.type = 0;
-    lfs_stat(&lfs, filename, &info);
-    if (filesystem_file_exists(filename)) {
-        if (info.size > 0) {
-            char *buf = malloc(info.size + 1);
-            filesystem_read_file(filename, buf, info.size);
-            buf[info.size] = '\0';
-            printf("%s\r\n", buf);
-            free(buf);
-        } else {
-            printf("\r\n");
+    int32_t size = filesystem_get_file_size(filename);
+    if (size >= 0) {
+        // print the file a page at a time, instead of allocating room for all of it.
+        char buf[NVMCTRL_PAGE_SIZE + 1];
+        for (int32_t offset = 0; offset < size; offset += NVMCTRL_PAGE_SIZE) {
+            int32_t length = min(NVMCTRL_PAGE_SIZE, size - offset);
+            if (!filesystem_read_file_at(filename, buf, offset, length)) break;
+            buf[length] = '\0';
+            printf("%s", buf);
         }
+        printf("\r\n");
     } else {
         printf("cat: %s: No such file\r\n", filename);
     }
 }
 
 bool filesystem_write_file(char *filename, char *text, int32_t length) {
+    if (!_filesystem_mount()) return false;
+    _filesystem_close_cached_files();
     int err = lfs_file_open(&lfs, &file, filename, LFS_O_RDWR | LFS_O_CREAT | LFS_O_TRUNC);
     if (err < 0) return false;
     err = lfs_file_write(&lfs, &file, text, length);
@@ -216,6 +614,8 @@ bool filesystem_write_file(char *filename, char *text, int32_t length) {
 }
 
 bool filesystem_append_file(char *filename, char *text, int32_t length) {
+    if (!_filesystem_mount()) return false;
+    _filesystem_close_cached_files();
     int err = lfs_file_open(&lfs, &file, filename, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_APPEND);
     if (err < 0) return false;
     err = lfs_file_write(&lfs, &file, text, length);
@@ -223,7 +623,142 @@ bool filesystem_append_file(char *filename, char *text, int32_t length) {
     return lfs_file_close(&lfs, &file) == LFS_ERR_OK;
 }
 
+// a sealed file is "SEAL", the counter block its encryption starts from, the data encrypted in CTR mode, and a CMAC
+// over all of that. the counter is random each time, so that no two writes share a keystream.
+#define FILESYSTEM_SEAL_HEADER_SIZE (4 + WATCH_AES_BLOCK_SIZE)
+// encrypted in pieces this big, so that only one piece is ever in RAM.
+#define FILESYSTEM_SEAL_CHUNK_SIZE (4 * WATCH_AES_BLOCK_SIZE)
+
+static uint32_t seal_pin;
+
+void filesystem_set_seal_pin(uint32_t pin) {
+    seal_pin = pin;
+}
+
+static void _filesystem_seal_keys(uint8_t *cipher_key, uint8_t *mac_key) {
+    uint8_t serial[WATCH_AES_KEY_SIZE];
+    uint8_t root[WATCH_AES_KEY_SIZE];
+    watch_aes_cmac_t cmac;
+
+    // the serial number isn't random, but no other watch has it; CMAC makes a key of it, and of the PIN.
+    watch_get_serial_number(serial);
+    watch_aes_cmac_start(&cmac, serial);
+    watch_aes_cmac_update(&cmac, "sealed file", 11);
+    watch_aes_cmac_update(&cmac, &seal_pin, sizeof(seal_pin));
+    watch_aes_cmac_finish(&cmac, root);
+    watch_aes_cmac(root, "cipher", 6, cipher_key);
+    watch_aes_cmac(root, "mac", 3, mac_key);
+
+    memset(serial, 0, sizeof(serial));
+    memset(root, 0, sizeof(root));
+}
+
+bool filesystem_write_sealed(char *filename, const void *data, int32_t length) {
+    if (!_filesystem_mount() || length < 0) return false;
+
+    uint8_t cipher_key[WATCH_AES_KEY_SIZE];
+    uint8_t mac_key[WATCH_AES_KEY_SIZE];
+    uint8_t header[FILESYSTEM_SEAL_HEADER_SIZE] = "SEAL";
+    uint8_t counter[WATCH_AES_BLOCK_SIZE];
+    uint8_t chunk[FILESYSTEM_SEAL_CHUNK_SIZE];
+    watch_aes_cmac_t cmac;
+    _filesystem_seal_keys(cipher_key, mac_key);
+    watch_random_bytes(header + 4, WATCH_AES_BLOCK_SIZE);
+    memcpy(counter, header + 4, WATCH_AES_BLOCK_SIZE);
+    watch_aes_cmac_start(&cmac, mac_key);
+    watch_aes_cmac_update(&cmac, header, sizeof(header));
+
+    _filesystem_close_cached_files();
+    bool success = lfs_file_open(&lfs, &file, filename, LFS_O_RDWR | LFS_O_CREAT | LFS_O_TRUNC) >= 0;
+    if (success) {
+        success = lfs_file_write(&lfs, &file, header, sizeof(header)) == sizeof(header);
+        for (int32_t offset = 0; success && offset < length; offset += FILESYSTEM_SEAL_CHUNK_SIZE) {
+            int32_t n = min(FILESYSTEM_SEAL_CHUNK_SIZE, length - offset);
+            watch_aes_ctr(cipher_key, counter, (const uint8_t *)data + offset, chunk, n);
+            watch_aes_cmac_update(&cmac, chunk, n);
+            success = lfs_file_write(&lfs, &file, chunk, n) == n;
+        }
+        watch_aes_cmac_finish(&cmac, chunk);
+        success = success && lfs_file_write(&lfs, &file, chunk, WATCH_AES_BLOCK_SIZE) == WATCH_AES_BLOCK_SIZE;
+        success = lfs_file_close(&lfs, &file) == LFS_ERR_OK && success;
+    }
+
+    memset(cipher_key, 0, sizeof(cipher_key));
+    memset(mac_key, 0, sizeof(mac_key));
+    memset(&cmac, 0, sizeof(cmac));
+    // don't leave half a file behind, or one that won't open.
+    if (!success) filesystem_rm(filename);
+    return success;
+}
+
+int32_t filesystem_read_sealed(char *filename, void *buf, int32_t length) {
+    int32_t size = filesystem_get_file_size(filename) - FILESYSTEM_SEAL_OVERHEAD;
+    if (size < 0 || size > length) return -1;
+
+    uint8_t cipher_key[WATCH_AES_KEY_SIZE];
+    uint8_t mac_key[WATCH_AES_KEY_SIZE];
+    uint8_t header[FILESYSTEM_SEAL_HEADER_SIZE];
+    uint8_t mac[WATCH_AES_BLOCK_SIZE];
+    uint8_t expected[WATCH_AES_BLOCK_SIZE];
+    if (!filesystem_read_file_at(filename, (char *)header, 0, sizeof(header)) || memcmp(header, "SEAL", 4) ||
+        !filesystem_read_file_at(filename, buf, sizeof(header), size) ||
+        !filesystem_read_file_at(filename, (char *)mac, sizeof(header) + size, sizeof(mac))) {
+        memset(buf, 0, length);
+        return -1;
+    }
+
+    _filesystem_seal_keys(cipher_key, mac_key);
+    watch_aes_cmac_t cmac;
+    watch_aes_cmac_start(&cmac, mac_key);
+    watch_aes_cmac_update(&cmac, header, sizeof(header));
+    watch_aes_cmac_update(&cmac, buf, size);
+    watch_aes_cmac_finish(&cmac, expected);
+    // every byte is compared, so how long this takes says nothing about where they differ.
+    uint8_t difference = 0;
+    for (uint8_t i = 0; i < sizeof(mac); i++) difference |= mac[i] ^ expected[i];
+    if (difference) size = -1;
+    else watch_aes_ctr(cipher_key, header + 4, buf, buf, size);
+
+    memset(cipher_key, 0, sizeof(cipher_key));
+    memset(mac_key, 0, sizeof(mac_key));
+    if (size < 0) memset(buf, 0, length);
+    return size;
+}
+
+uint32_t filesystem_get_raw_size(void) {
+    return FILESYSTEM_RAW_ROWS * NVMCTRL_ROW_SIZE;
+}
+
+const uint8_t *filesystem_get_raw_pointer(uint32_t offset) {
+    if (offset >= filesystem_get_raw_size()) return NULL;
+    return watch_storage_get_address(FILESYSTEM_LFS_ROWS + offset / NVMCTRL_ROW_SIZE, offset % NVMCTRL_ROW_SIZE);
+}
+
+bool filesystem_write_raw(uint32_t offset, const void *data, uint32_t length) {
+    if (offset % NVMCTRL_ROW_SIZE || offset + length > filesystem_get_raw_size()) return false;
+
+    uint8_t page[NVMCTRL_PAGE_SIZE];
+    for (uint32_t written = 0; written < length; written += NVMCTRL_PAGE_SIZE) {
+        uint32_t row = FILESYSTEM_LFS_ROWS + (offset + written) / NVMCTRL_ROW_SIZE;
+        uint32_t row_offset = written % NVMCTRL_ROW_SIZE;
+        uint32_t chunk = min(NVMCTRL_PAGE_SIZE, length - written);
+        if (row_offset == 0) {
+            if (!watch_storage_erase(row)) return false;
+            _filesystem_count_erase(row);
+        }
+        // pad the last page with erased bytes, since the controller always programs whole pages.
+        memset(page, 0xFF, NVMCTRL_PAGE_SIZE);
+        memcpy(page, (const uint8_t *)data + written, chunk);
+        if (!watch_storage_write(row, row_offset, page, NVMCTRL_PAGE_SIZE)) return false;
+    }
+    if (!watch_storage_sync()) return false;
+
+    // nothing reads these rows through a checksum, as littlefs does its own, so check what landed.
+    return watch_crc32(filesystem_get_raw_pointer(offset), length) == watch_crc32(data, length);
+}
+
 int filesystem_cmd_ls(int argc, char *argv[]) {
+    if (!_filesystem_mount()) return -1;
     if (argc >= 2) {
         filesystem_ls(&lfs, argv[1]);
     } else {
@@ -251,6 +786,40 @@ int filesystem_cmd_rm(int argc, char *argv[]) {
     return 0;
 }
 
+#ifdef FILESYSTEM_WEAR_STATS
+int filesystem_cmd_wear(int argc, char *argv[]) {
+    (void) argc;
+    (void) argv;
+    _filesystem_wear_load();
+
+    printf("row\terases\tused for\r\n");
+    uint8_t busiest = 0;
+    for (uint8_t row = 0; row < FILESYSTEM_NUM_ROWS; row++) {
+        const char *use = row < FILESYSTEM_LFS_ROWS ? "littlefs" : row == FILESYSTEM_WEAR_ROW ? "wear stats" : "raw";
+        printf("%u\t%u\t%s\r\n", row, wear.erases[row], use);
+        if (wear.erases[row] > wear.erases[busiest]) busiest = row;
+    }
+
+    uint32_t now = _filesystem_wear_now();
+    uint32_t days = now > wear.started ? (now - wear.started) / 86400 : 0;
+    printf("counting for %lu days, %u erases not saved yet\r\n", (unsigned long)days, wear_unsaved);
+    uint16_t most = wear.erases[busiest];
+    if (days == 0 || most == 0) {
+        printf("not enough yet to project a lifetime\r\n");
+    } else if (most >= FILESYSTEM_WEAR_ENDURANCE) {
+        printf("row %u is past the %u erases it's projected against\r\n", busiest, FILESYSTEM_WEAR_ENDURANCE);
+    } else {
+        // at the rate the busiest row has been going, how long until it reaches its rating.
+        uint32_t days_left = (uint32_t)((uint64_t)(FILESYSTEM_WEAR_ENDURANCE - most) * days / most);
+        printf("row %u: %lu erases a day; %lu days (%lu years) to %u erases\r\n", busiest,
+               (unsigned long)((most + days / 2) / days), (unsigned long)days_left, (unsigned long)(days_left / 365),
+               FILESYSTEM_WEAR_ENDURANCE);
+    }
+
+    return 0;
+}
+#endif
+
 int filesystem_cmd_echo(int argc, char *argv[]) {
     (void) argc;
 
@@ -29,7 +29,8 @@
 #include "watch.h"
 
 /** @brief Initializes and mounts the tiny 8kb filesystem, formatting it if need be.
-  * @return true if the filesystem was mounted successfully.
+  * @details There's no need to call this: the filesystem is mounted the first time any of these functions uses it.
+  * @return true if the filesystem was mounted successfully, now or before.
   */
 bool filesystem_init(void);
 
@@ -50,6 +51,14 @@ bool filesystem_file_exists(char *filename);
   */
 bool filesystem_rm(char *filename);
 
+/** @brief Renames a file on the filesystem, replacing any file that already has the new name. The rename is
+  *        atomic, so it's a safe way to swap in a file that was written under a temporary name.
+  * @param old_filename the file you wish to rename
+  * @param new_filename its new name
+  * @return true if the file was renamed successfully; false otherwise
+  */
+bool filesystem_rename(char *old_filename, char *new_filename);
+
 /** @brief Gets the size of a file on the filesystem.
   * @param filename the file whose size you wish to determine
   * @return the file's size in bytes, or -1 if the file does not exist.
@@ -69,6 +78,28 @@ int32_t filesystem_get_file_size(char *filename);
   */
 bool filesystem_read_file(char *filename, char *buf, int32_t length);
 
+/** @brief Reads a file from the filesystem into a buffer, if it's the size you expect.
+  * @details This is filesystem_file_exists, filesystem_get_file_size and filesystem_read_file in one, for reading a
+  *          struct back from a file of its own. It looks the file up in the metadata once, where those would take up
+  *          to three lookups; and not at all if the filesystem already knows the file is missing or the wrong size.
+  * @param filename the file you wish to read
+  * @param buf A buffer of at least expected_size bytes
+  * @param expected_size The size the file has to be
+  * @return true if the file was expected_size bytes long and was read; false otherwise, with buf zeroed.
+  */
+bool filesystem_read_file_if_size(char *filename, char *buf, int32_t expected_size);
+
+/** @brief Reads part of a file from the filesystem into a buffer
+  * @param filename the file you wish to read
+  * @param buf A buffer of at least length bytes
+  * @param offset The offset into the file at which to start reading
+  * @param length The number of bytes to read
+  * @return true if the read was successful; false otherwise
+  * @note Like filesystem_read_file, this sets buf to zero first, so reading past the end of the file
+  *       leaves the remainder of the buffer zeroed.
+  */
+bool filesystem_read_file_at(char *filename, char *buf, int32_t offset, int32_t length);
+
 /** @brief Reads a line from a file into a buffer
   * @param filename the file you wish to read
   * @param buf A buffer of at least length + 1 bytes; the file will be read into this buffer,
@@ -96,10 +127,100 @@ bool filesystem_write_file(char *filename, char *text, int32_t length);
   */
 bool filesystem_append_file(char *filename, char *text, int32_t length);
 
+/// How much bigger a sealed file is than what's in it.
+#define FILESYSTEM_SEAL_OVERHEAD (4 + WATCH_AES_BLOCK_SIZE + WATCH_AES_BLOCK_SIZE)
+
+/** @brief Writes a file encrypted, for secrets that shouldn't be readable off the filesystem.
+  * @details The data is encrypted with AES-128 in CTR mode and authenticated with a CMAC, under keys worked out from
+  *          the microcontroller's serial number (and the PIN, if one has been set with filesystem_set_seal_pin). It's
+  *          for keeping secrets out of what the shell's cat, a filesystem backup or the USB drive shows; anything that
+  *          can run code on the watch can work the keys out too, unless there's a PIN. A sealed file only opens on the
+  *          watch that wrote it.
+  * @param filename the file you wish to write
+  * @param data The contents of the file
+  * @param length The number of bytes to write; the file takes FILESYSTEM_SEAL_OVERHEAD more.
+  * @return true if the write was successful; false otherwise
+  */
+bool filesystem_write_sealed(char *filename, const void *data, int32_t length);
+
+/** @brief Reads a file written with filesystem_write_sealed.
+  * @param filename the file you wish to read
+  * @param buf A buffer for what's in it: the file's size less FILESYSTEM_SEAL_OVERHEAD.
+  * @param length The size of buf.
+  * @return the number of bytes read, or -1 if the file doesn't exist, isn't sealed, doesn't fit in buf, or was
+  *         sealed on another watch, with another PIN, or changed since. buf is zeroed on failure.
+  */
+int32_t filesystem_read_sealed(char *filename, void *buf, int32_t length);
+
+/** @brief Mixes a PIN into the keys for sealed files from now on, until the next reset. Files sealed without it, or
+  *        with another, won't open, so set it before reading them, as well as before writing.
+  * @param pin The PIN, or 0 for none.
+  */
+void filesystem_set_seal_pin(uint32_t pin);
+
+/** @brief Gets the size of the raw partition: rows at the end of the storage area, set aside at build time with
+  *        FILESYSTEM_RAW_ROWS, whose contents can be used in place instead of being read into RAM. This suits
+  *        read-mostly data like lookup tables, tunes or secrets. The partition is empty unless configured.
+  * @return the size of the raw partition in bytes
+  */
+uint32_t filesystem_get_raw_size(void);
+
+/** @brief Gets a pointer to data in the raw partition.
+  * @param offset The offset into the raw partition
+  * @return A pointer into flash, or NULL if offset is out of range. The pointer stays valid until the next write
+  *         to the raw partition.
+  */
+const uint8_t *filesystem_get_raw_pointer(uint32_t offset);
+
+/** @brief Writes data to the raw partition, erasing the rows it covers first.
+  * @param offset The offset into the raw partition. Must be a multiple of NVMCTRL_ROW_SIZE (256).
+  * @param data The data to write
+  * @param length The number of bytes to write. The rest of the last row is left erased (0xFF).
+  * @return true if the write was successful, and the flash reads back as data; false otherwise
+  */
+bool filesystem_write_raw(uint32_t offset, const void *data, uint32_t length);
+
+/** @brief Called by filesystem_list_files with each file's name and size.
+  * @return true to go on to the next file; false to stop.
+  */
+typedef bool (*filesystem_list_callback_t)(const char *filename, int32_t size, void *context);
+
+/** @brief Lists the files in the top directory, in the order littlefs keeps them, which doesn't change until the
+  *        filesystem does (@see filesystem_get_generation).
+  * @param callback Called once for each file; directories are skipped.
+  * @param context Passed through to the callback.
+  * @return true if the directory was read; false otherwise
+  */
+bool filesystem_list_files(filesystem_list_callback_t callback, void *context);
+
+/** @brief Returns a number that changes each time anything is written to, or erased from, the filesystem. */
+uint32_t filesystem_get_generation(void);
+
+#ifdef LFS_THREADSAFE
+/** @brief Returns true while the main loop is in the middle of a littlefs call.
+  * @details Built with LFS_THREADSAFE, littlefs brackets each of its calls with a lock. Code that interrupts the main
+  *          loop, like the USB task, may call filesystem_list_files and filesystem_read_file_uncached whenever this
+  *          is false: it can't be interrupted back, and between two calls the filesystem is consistent.
+  */
+bool filesystem_is_busy(void);
+
+/** @brief Reads part of a file without touching the files the main loop keeps open (@see filesystem_is_busy).
+  * @param filename the file you wish to read
+  * @param buf A buffer of at least length bytes
+  * @param offset The offset into the file at which to start reading
+  * @param length The number of bytes to read
+  * @return the number of bytes read, which is less than length at the end of the file, or -1 if it couldn't be read.
+  */
+int32_t filesystem_read_file_uncached(const char *filename, void *buf, int32_t offset, int32_t length);
+#endif
+
 int filesystem_cmd_ls(int argc, char *argv[]);
 int filesystem_cmd_cat(int argc, char *argv[]);
 int filesystem_cmd_df(int argc, char *argv[]);
 int filesystem_cmd_rm(int argc, char *argv[]);
 int filesystem_cmd_echo(int argc, char *argv[]);
+#ifdef FILESYSTEM_WEAR_STATS
+int filesystem_cmd_wear(int argc, char *argv[]);
+#endif
 
 #endif // FILESYSTEM_H_
@@ -1,69 +1,197 @@
-#include "TOTP.h"
-#include "sha1.h"
-#include "sha256.h"
-#include "sha512.h"
-#include <stdio.h>
-
-uint8_t* _hmacKey;
-uint8_t _keyLength;
-uint8_t _timeZoneOffset;
-uint32_t _timeStep;
-hmac_alg _algorithm;
-
-// Init the library with the private key, its length, the timeStep duration and the algorithm that should be used
-void TOTP(uint8_t* hmacKey, uint8_t keyLength, uint32_t timeStep, hmac_alg algorithm) {
-    _hmacKey = hmacKey;
-    _keyLength = keyLength;
-    _timeStep = timeStep;
-    _algorithm = algorithm;
-}
-
-void setTimezone(uint8_t timezone){
-    _timeZoneOffset = timezone;
-}
-
-static uint32_t TimeStruct2Timestamp(struct tm time){
-    //time.tm_mon -= 1;
-    //time.tm_year -= 1900;
-    return mktime(&(time)) - (_timeZoneOffset * 3600) - 2208988800;
-}
-
-// Generate a code, using the timestamp provided
-uint32_t getCodeFromTimestamp(uint32_t timeStamp) {
-    uint32_t steps = timeStamp / _timeStep;
-    return getCodeFromSteps(steps);
-}
-
-// Generate a code, using the timestamp provided
-uint32_t getCodeFromTimeStruct(struct tm time) {
-    return getCodeFromTimestamp(TimeStruct2Timestamp(time));
-}
-
-// Generate a code, using the number of steps provided
-uint32_t getCodeFromSteps(uint32_t steps) {
-    // STEP 0, map the number of steps in a 8-bytes array (counter value)
-    uint8_t _byteArray[8];
-    _byteArray[0] = 0x00;
-    _byteArray[1] = 0x00;
-    _byteArray[2] = 0x00;
-    _byteArray[3] = 0x00;
-    _byteArray[4] = (uint8_t)((steps >> 24) & 0xFF);
-    _byteArray[5] = (uint8_t)((steps >> 16) & 0xFF);
-    _byteArray[6] = (uint8_t)((steps >> 8) & 0XFF);
-    _byteArray[7] = (uint8_t)((steps & 0XFF));
-
-    switch(_algorithm){
-        case SHA1:
-            return(TOTP_HMAC_SHA1(_hmacKey, _keyLength, _byteArray, 8));
-        case SHA224:
-            return(TOTP_HMAC_SHA256(_hmacKey, _keyLength, _byteArray, 8, 1));
-        case SHA256:
-            return(TOTP_HMAC_SHA256(_hmacKey, _keyLength, _byteArray, 8, 0));
-        case SHA384:
-            return(TOTP_HMAC_SHA512(_hmacKey, _keyLength, _byteArray, 8, 1));
-        case SHA512:
-            return(TOTP_HMAC_SHA512(_hmacKey, _keyLength, _byteArray, 8, 0));
-        default:
-            return(0);
-    }
-}
+#include "TOTP.h"
+#include "sha1.h"
+#include "sha256.h"
+#include "sha512.h"
+#include <stdio.h>
+#include <string.h>
+
+uint8_t _timeZoneOffset;
+uint32_t _timeStep;
+hmac_alg _algorithm;
+
+// HMAC state after absorbing the key XORed with ipad (inner) and opad (outer). Both pads are a single block that
+// only depends on the key, so they are hashed once in TOTP() and each code only costs the compression rounds for
+// the counter and the inner digest.
+typedef union {
+    mbedtls_sha1_context sha1;
+    mbedtls_sha256_context sha256;
+    mbedtls_sha512_context sha512;
+} hmac_context_t;
+
+static hmac_context_t _inner;
+static hmac_context_t _outer;
+
+static void _hash_starts(hmac_context_t *ctx) {
+    switch(_algorithm){
+        case SHA1:
+            mbedtls_sha1_starts(&ctx->sha1);
+            break;
+        case SHA224:
+        case SHA256:
+            mbedtls_sha256_starts(&ctx->sha256, _algorithm == SHA224);
+            break;
+        case SHA384:
+        case SHA512:
+            mbedtls_sha512_starts(&ctx->sha512, _algorithm == SHA384);
+            break;
+    }
+}
+
+static void _hash_update(hmac_context_t *ctx, const uint8_t *in, size_t n) {
+    switch(_algorithm){
+        case SHA1:
+            mbedtls_sha1_update(&ctx->sha1, in, n);
+            break;
+        case SHA224:
+        case SHA256:
+            mbedtls_sha256_update(&ctx->sha256, in, n);
+            break;
+        case SHA384:
+        case SHA512:
+            mbedtls_sha512_update(&ctx->sha512, in, n);
+            break;
+    }
+}
+
+static void _hash_finish(hmac_context_t *ctx, uint8_t *out) {
+    switch(_algorithm){
+        case SHA1:
+            mbedtls_sha1_finish(&ctx->sha1, out);
+            break;
+        case SHA224:
+        case SHA256:
+            mbedtls_sha256_finish(&ctx->sha256, out);
+            break;
+        case SHA384:
+        case SHA512:
+            mbedtls_sha512_finish(&ctx->sha512, out);
+            break;
+    }
+}
+
+static size_t _block_length(void) {
+    switch(_algorithm){
+        case SHA1:
+            return SHA1_BLOCK_LENGTH;
+        case SHA224:
+        case SHA256:
+            return SHA256_BLOCK_LENGTH;
+        default:
+            return SHA512_BLOCK_LENGTH;
+    }
+}
+
+static size_t _digest_length(void) {
+    switch(_algorithm){
+        case SHA1:
+            return SHA1_DIGEST_LENGTH;
+        case SHA224:
+            return SHA224_DIGEST_LENGTH;
+        case SHA256:
+            return SHA256_DIGEST_LENGTH;
+        case SHA384:
+            return SHA384_DIGEST_LENGTH;
+        default:
+            return SHA512_DIGEST_LENGTH;
+    }
+}
+
+// Init the library with the private key, its length, the timeStep duration and the algorithm that should be used
+void TOTP(uint8_t* hmacKey, uint8_t keyLength, uint32_t timeStep, hmac_alg algorithm) {
+    uint8_t k_ipad[SHA512_BLOCK_LENGTH];
+    uint8_t k_opad[SHA512_BLOCK_LENGTH];
+    size_t block_length;
+
+    _timeStep = timeStep;
+    _algorithm = algorithm;
+    if (_algorithm > SHA512) return;
+    block_length = _block_length();
+
+    // keys longer than a block are hashed first, as in HMAC_SHA1 and friends
+    memset(k_ipad, 0, sizeof(k_ipad));
+    if (keyLength <= block_length) {
+        memcpy(k_ipad, hmacKey, keyLength);
+    } else {
+        _hash_starts(&_inner);
+        _hash_update(&_inner, hmacKey, keyLength);
+        _hash_finish(&_inner, k_ipad);
+    }
+    memcpy(k_opad, k_ipad, block_length);
+
+    for (size_t i = 0; i < block_length; i++) {
+        k_ipad[i] ^= HMAC_IPAD;
+        k_opad[i] ^= HMAC_OPAD;
+    }
+
+    _hash_starts(&_inner);
+    _hash_update(&_inner, k_ipad, block_length);
+    _hash_starts(&_outer);
+    _hash_update(&_outer, k_opad, block_length);
+
+    memset(k_ipad, 0, sizeof(k_ipad));
+    memset(k_opad, 0, sizeof(k_opad));
+}
+
+void setTimezone(uint8_t timezone){
+    _timeZoneOffset = timezone;
+}
+
+static uint32_t TimeStruct2Timestamp(struct tm time){
+    //time.tm_mon -= 1;
+    //time.tm_year -= 1900;
+    return mktime(&(time)) - (_timeZoneOffset * 3600) - 2208988800;
+}
+
+// Generate a code, using the timestamp provided
+uint32_t getCodeFromTimestamp(uint32_t timeStamp) {
+    uint32_t steps = timeStamp / _timeStep;
+    return getCodeFromSteps(steps);
+}
+
+// Generate a code, using the timestamp provided
+uint32_t getCodeFromTimeStruct(struct tm time) {
+    return getCodeFromTimestamp(TimeStruct2Timestamp(time));
+}
+
+// Generate a code, using the number of steps provided
+uint32_t getCodeFromSteps(uint32_t steps) {
+    // STEP 0, map the number of steps in a 8-bytes array (counter value)
+    uint8_t _byteArray[8];
+    _byteArray[0] = 0x00;
+    _byteArray[1] = 0x00;
+    _byteArray[2] = 0x00;
+    _byteArray[3] = 0x00;
+    _byteArray[4] = (uint8_t)((steps >> 24) & 0xFF);
+    _byteArray[5] = (uint8_t)((steps >> 16) & 0xFF);
+    _byteArray[6] = (uint8_t)((steps >> 8) & 0XFF);
+    _byteArray[7] = (uint8_t)((steps & 0XFF));
+
+    if (_algorithm > SHA512) return(0);
+
+    // STEP 1, get the HMAC from the counter and the precomputed pad states
+    hmac_context_t ctx;
+    uint8_t hash[SHA512_DIGEST_LENGTH];
+    size_t digest_length = _digest_length();
+
+    memcpy(&ctx, &_inner, sizeof(ctx));
+    _hash_update(&ctx, _byteArray, 8);
+    _hash_finish(&ctx, hash);
+
+    memcpy(&ctx, &_outer, sizeof(ctx));
+    _hash_update(&ctx, hash, digest_length);
+    _hash_finish(&ctx, hash);
+
+    // STEP 2, apply dynamic truncation to obtain a 4-bytes string
+    uint32_t truncated_hash = 0;
+    uint8_t _offset = hash[digest_length - 1] & 0xF;
+    for (uint8_t j = 0; j < 4; ++j) {
+        truncated_hash <<= 8;
+        truncated_hash  |= hash[_offset + j];
+    }
+
+    // STEP 3, compute the OTP value
+    truncated_hash &= 0x7FFFFFFF;
+    truncated_hash %= 1000000;
+
+    return truncated_hash;
+}
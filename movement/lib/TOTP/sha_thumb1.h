@@ -0,0 +1,94 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+/*
+ * Build-time choice of SHA compression functions.
+ *
+ * sha1.c, sha256.c and sha512.c each have mbed TLS's portable compression
+ * function and one restructured for Thumb-1 cores like the watch's Cortex-M0+,
+ * which have eight low registers, no shifted operands and no 64-bit arithmetic
+ * of their own. The restructured ones:
+ *
+ *  - load the block's big-endian words with one ldr and one rev each, instead
+ *    of four byte loads, three shifts and three ORs;
+ *  - work out the message schedule as the rounds use it, in a ring of sixteen
+ *    words, rather than in a pass of its own over an array of 64 or 80 (which
+ *    saves 192 bytes of stack in SHA-256 and 512 in SHA-512), unrolled sixteen
+ *    rounds at a time so that every ring index is a constant;
+ *  - in SHA-512, do the rotations in the Σ and σ functions on the 32-bit
+ *    halves of each word, leaving only the additions to the compiler's 64-bit
+ *    arithmetic.
+ *
+ * They're in C rather than assembly, so the host build checks them against
+ * the same test vectors. SHA_THUMB1_KERNELS is 1 when building for a Thumb-1
+ * core and 0 otherwise; define it either way to choose. The microbench app
+ * (apps/microbench) times a block of each on the watch.
+ */
+
+#ifndef SHA_THUMB1_H
+#define SHA_THUMB1_H
+
+#include <stdint.h>
+#include <string.h>
+
+#ifndef SHA_THUMB1_KERNELS
+#if defined(__thumb__) && !defined(__thumb2__)
+#define SHA_THUMB1_KERNELS 1
+#else
+#define SHA_THUMB1_KERNELS 0
+#endif
+#endif
+
+/*
+ * Loads count big-endian 32-bit words from data. On a little-endian core, a
+ * word-aligned block (the context's own buffer always is) takes the ldr and
+ * rev path; any other falls back to bytes, since the M0+ faults on an
+ * unaligned ldr.
+ */
+static inline void sha_load_be32( uint32_t *words, const unsigned char *data, unsigned int count )
+{
+    unsigned int i;
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+    if( ( (uintptr_t) data & 3 ) == 0 )
+    {
+        const unsigned char *aligned = __builtin_assume_aligned( data, 4 );
+        for( i = 0; i < count; i++ )
+        {
+            uint32_t word;
+            memcpy( &word, aligned + 4 * i, 4 );
+            words[i] = __builtin_bswap32( word );
+        }
+        return;
+    }
+#endif
+
+    for( i = 0; i < count; i++, data += 4 )
+    {
+        words[i] = ( (uint32_t) data[0] << 24 ) | ( (uint32_t) data[1] << 16 )
+                 | ( (uint32_t) data[2] <<  8 ) | ( (uint32_t) data[3]       );
+    }
+}
+
+#endif /* SHA_THUMB1_H */
@@ -16,29 +16,47 @@
  * SOFTWARE.
  */
 
-#include <math.h>
+#include <tgmath.h>
 #include <stdint.h>
 #include <stdbool.h>
 #include <stdio.h>
 #include "astrolib.h"
 #include "vsop87a_milli.h"
+#include "vsop87a_micro.h"
+#include "ephemeris.h"
+
+// FAST_MATH swaps libm's trigonometry for watch_math's approximations, which are float only, and good to a fraction of
+// an arcsecond; the angles and vectors here only need a few arcseconds (see ASTROLIB_SINGLE_PRECISION).
+#if defined(ASTROLIB_SINGLE_PRECISION) && defined(WATCH_FAST_MATH)
+#include "watch_math.h"
+#define astro_sin watch_sinf
+#define astro_cos watch_cosf
+#define astro_asin watch_asinf
+#define astro_acos watch_acosf
+#define astro_atan2 watch_atan2f
+#else
+#define astro_sin sin
+#define astro_cos cos
+#define astro_asin asin
+#define astro_acos acos
+#define astro_atan2 atan2
+#endif
 
 double astro_convert_utc_to_tt(double jd) ;
 double astro_get_GMST(double ut1);
 astro_cartesian_coordinates_t astro_subtract_cartesian(astro_cartesian_coordinates_t a, astro_cartesian_coordinates_t b);
 astro_cartesian_coordinates_t astro_rotate_from_vsop_to_J2000(astro_cartesian_coordinates_t c);
-astro_matrix_t astro_get_x_rotation_matrix(double r);
-astro_matrix_t astro_get_y_rotation_matrix(double r);
-astro_matrix_t astro_get_z_rotation_matrix(double r);
+astro_matrix_t astro_get_x_rotation_matrix(astro_real_t r);
+astro_matrix_t astro_get_y_rotation_matrix(astro_real_t r);
+astro_matrix_t astro_get_z_rotation_matrix(astro_real_t r);
 astro_matrix_t astro_transpose_matrix(astro_matrix_t m);
 astro_matrix_t astro_dot_product(astro_matrix_t a, astro_matrix_t b);
 astro_matrix_t astro_get_precession_matrix(double jd);
 astro_cartesian_coordinates_t astro_matrix_multiply(astro_cartesian_coordinates_t v, astro_matrix_t m);
-astro_cartesian_coordinates_t astro_convert_geodedic_latlon_to_ITRF_XYZ(double lat, double lon, double height);
+astro_cartesian_coordinates_t astro_convert_geodedic_latlon_to_ITRF_XYZ(astro_real_t lat, astro_real_t lon, astro_real_t height);
 astro_cartesian_coordinates_t astro_convert_ITRF_to_GCRS(astro_cartesian_coordinates_t r, double ut1);
 astro_cartesian_coordinates_t astro_convert_coordinates_from_meters_to_AU(astro_cartesian_coordinates_t c);
-astro_cartesian_coordinates_t astro_get_observer_geocentric_coords(double jd, double lat, double lon);
-astro_cartesian_coordinates_t astro_get_body_coordinates(astro_body_t bodyNum, double et);
+astro_cartesian_coordinates_t astro_get_observer_geocentric_coords(double jd, astro_real_t lat, astro_real_t lon);
 astro_cartesian_coordinates_t astro_get_body_coordinates_light_time_adjusted(astro_body_t body, astro_cartesian_coordinates_t origin, double t);
 astro_equatorial_coordinates_t astro_convert_cartesian_to_polar(astro_cartesian_coordinates_t xyz);
 
@@ -73,7 +91,7 @@ double astro_convert_date_to_julian_date(uint16_t year, uint8_t month, uint8_t d
 //Return all values in radians.
 //The positions are adjusted for the parallax of the Earth, and the offset of the observer from the Earth's center
 //All input and output angles are in radians!
-astro_equatorial_coordinates_t astro_get_ra_dec(double jd, astro_body_t body, double lat, double lon, bool calculate_precession) {
+astro_equatorial_coordinates_t astro_get_ra_dec(double jd, astro_body_t body, astro_real_t lat, astro_real_t lon, bool calculate_precession) {
     double jdTT = astro_convert_utc_to_tt(jd);
     double t = astro_convert_jd_to_julian_millenia_since_j2000(jdTT);
     
@@ -108,8 +126,8 @@ astro_equatorial_coordinates_t astro_get_ra_dec(double jd, astro_body_t body, do
     //Convert to topocentric RA DEC by converting from cartesian coordinates to polar coordinates
     astro_equatorial_coordinates_t retval = astro_convert_cartesian_to_polar(body_coords);
     
-    retval.declination = M_PI/2.0 - retval.declination;  //Dec.  Offset to make 0 the equator, and the poles +/-90 deg
-    if(retval.right_ascension < 0) retval.right_ascension += 2*M_PI; //Ensure RA is positive
+    retval.declination = ASTRO_PI/ASTRO_REAL(2.0) - retval.declination;  //Dec.  Offset to make 0 the equator, and the poles +/-90 deg
+    if(retval.right_ascension < 0) retval.right_ascension += 2*ASTRO_PI; //Ensure RA is positive
     
     return retval;
 }
@@ -179,9 +197,9 @@ astro_cartesian_coordinates_t astro_rotate_from_vsop_to_J2000(astro_cartesian_co
         Z FK5     0.000000000000  +0.397776982902  +0.917482137087   Z VSOP87A
     */
     astro_cartesian_coordinates_t t;
-    t.x = c.x + c.y * 0.000000440360 + c.z * -0.000000190919;
-    t.y = c.x * -0.000000479966 + c.y * 0.917482137087 + c.z * -0.397776982902;
-    t.z = c.y * 0.397776982902 + c.z * 0.917482137087;
+    t.x = c.x + c.y * ASTRO_REAL(0.000000440360) + c.z * -ASTRO_REAL(0.000000190919);
+    t.y = c.x * -ASTRO_REAL(0.000000479966) + c.y * ASTRO_REAL(0.917482137087) + c.z * -ASTRO_REAL(0.397776982902);
+    t.z = c.y * ASTRO_REAL(0.397776982902) + c.z * ASTRO_REAL(0.917482137087);
 
     return t;
 }
@@ -209,48 +227,48 @@ static astro_matrix_t _astro_get_empty_matrix() {
 }
 
 //Gets a rotation matrix about the x axis.  Angle R is in radians
-astro_matrix_t astro_get_x_rotation_matrix(double r) {
+astro_matrix_t astro_get_x_rotation_matrix(astro_real_t r) {
     astro_matrix_t t = _astro_get_empty_matrix();
 
     t.elements[0][0]=1;
     t.elements[0][1]=0;
     t.elements[0][2]=0;
     t.elements[1][0]=0;
-    t.elements[1][1]=cos(r);
-    t.elements[1][2]=sin(r);
+    t.elements[1][1]=astro_cos(r);
+    t.elements[1][2]=astro_sin(r);
     t.elements[2][0]=0;
-    t.elements[2][1]=-sin(r);
-    t.elements[2][2]=cos(r);
+    t.elements[2][1]=-astro_sin(r);
+    t.elements[2][2]=astro_cos(r);
 
     return t;
 }
 
 //Gets a rotation matrix about the y axis.  Angle R is in radians
-astro_matrix_t astro_get_y_rotation_matrix(double r) {
+astro_matrix_t astro_get_y_rotation_matrix(astro_real_t r) {
     astro_matrix_t t = _astro_get_empty_matrix();
 
-    t.elements[0][0]=cos(r);
+    t.elements[0][0]=astro_cos(r);
     t.elements[0][1]=0;
-    t.elements[0][2]=-sin(r);
+    t.elements[0][2]=-astro_sin(r);
     t.elements[1][0]=0;
     t.elements[1][1]=1;
     t.elements[1][2]=0;
-    t.elements[2][0]=sin(r);
+    t.elements[2][0]=astro_sin(r);
     t.elements[2][1]=0;
-    t.elements[2][2]=cos(r);
+    t.elements[2][2]=astro_cos(r);
 
     return t;
 }
 
 //Gets a rotation matrix about the z axis.  Angle R is in radians
-astro_matrix_t astro_get_z_rotation_matrix(double r) {
+astro_matrix_t astro_get_z_rotation_matrix(astro_real_t r) {
     astro_matrix_t t = _astro_get_empty_matrix();
 
-    t.elements[0][0]=cos(r);
-    t.elements[0][1]=sin(r);
+    t.elements[0][0]=astro_cos(r);
+    t.elements[0][1]=astro_sin(r);
     t.elements[0][2]=0;
-    t.elements[1][0]=-sin(r);
-    t.elements[1][1]=cos(r);
+    t.elements[1][0]=-astro_sin(r);
+    t.elements[1][1]=astro_cos(r);
     t.elements[1][2]=0;
     t.elements[2][0]=0;
     t.elements[2][1]=0;
@@ -277,7 +295,7 @@ astro_matrix_t astro_dot_product(astro_matrix_t a, astro_matrix_t b) {
 
     for(uint8_t i = 0; i < 3 ; i++) {
         for(uint8_t j = 0 ; j < 3 ; j++) {
-            double temp = 0;
+            astro_real_t temp = 0;
             for(uint8_t k = 0; k < 3 ; k++) {
                 temp += a.elements[i][k] * b.elements[k][j];
             }
@@ -302,13 +320,13 @@ astro_matrix_t astro_get_precession_matrix(double jd) {
     //2006 IAU Precession.  Implemented from IERS Technical Note No 36 ch5.
     //https://www.iers.org/SharedDocs/Publikationen/EN/IERS/Publications/tn/TechnNote36/tn36_043.pdf?__blob=publicationFile&v=1
 
-    double t = (jd - 2451545.0) / 36525.0;  //5.2
-    const double Arcsec2Radians = M_PI/180.0/60.0/60.0; //Converts arc seconds used in equations below to radians
+    astro_real_t t = (jd - 2451545.0) / 36525.0;  //5.2
+    const astro_real_t Arcsec2Radians = ASTRO_PI/ASTRO_REAL(180.0)/ASTRO_REAL(60.0)/ASTRO_REAL(60.0); //Converts arc seconds used in equations below to radians
 
-    double e0 = 84381.406 * Arcsec2Radians; //5.6.4
-    double omegaA = e0 + ((-0.025754 + (0.0512623 +	(-0.00772503 + (-0.000000467 + 0.0000003337*t) * t) * t) * t) * t) * Arcsec2Radians; //5.39
-    double psiA = ((5038.481507 +	(-1.0790069 + (-0.00114045 + (0.000132851 - 0.0000000951*t) * t) * t) * t) * t) * Arcsec2Radians; //5.39
-    double chiA = ((10.556403 + (-2.3814292 + (-0.00121197 + (0.000170663 - 0.0000000560*t) * t) * t) * t) * t) * Arcsec2Radians; //5.40
+    astro_real_t e0 = ASTRO_REAL(84381.406) * Arcsec2Radians; //5.6.4
+    astro_real_t omegaA = e0 + ((-ASTRO_REAL(0.025754) + (ASTRO_REAL(0.0512623) +	(-ASTRO_REAL(0.00772503) + (-ASTRO_REAL(0.000000467) + ASTRO_REAL(0.0000003337)*t) * t) * t) * t) * t) * Arcsec2Radians; //5.39
+    astro_real_t psiA = ((ASTRO_REAL(5038.481507) +	(-ASTRO_REAL(1.0790069) + (-ASTRO_REAL(0.00114045) + (ASTRO_REAL(0.000132851) - ASTRO_REAL(0.0000000951)*t) * t) * t) * t) * t) * Arcsec2Radians; //5.39
+    astro_real_t chiA = ((ASTRO_REAL(10.556403) + (-ASTRO_REAL(2.3814292) + (-ASTRO_REAL(0.00121197) + (ASTRO_REAL(0.000170663) - ASTRO_REAL(0.0000000560)*t) * t) * t) * t) * t) * Arcsec2Radians; //5.40
     //Rotation matrix from 5.4.5
     //(R1(−e0) · R3(psiA) · R1(omegaA) · R3(−chiA))
     //Above eq rotates from "of date" to J2000, so we reverse the signs to go from J2000 to "of date"
@@ -339,33 +357,33 @@ astro_equatorial_coordinates_t astro_convert_cartesian_to_polar(astro_cartesian_
     astro_equatorial_coordinates_t t;
 
     t.distance = sqrt(xyz.x * xyz.x + xyz.y * xyz.y + xyz.z * xyz.z);
-    t.declination = acos(xyz.z / t.distance);
-    t.right_ascension = atan2(xyz.y, xyz.x);
+    t.declination = astro_acos(xyz.z / t.distance);
+    t.right_ascension = astro_atan2(xyz.y, xyz.x);
 
-    if(t.declination < 0) t.declination += 2 * M_PI;
+    if(t.declination < 0) t.declination += 2 * ASTRO_PI;
 
-    if(t.right_ascension < 0) t.right_ascension += 2 * M_PI;
+    if(t.right_ascension < 0) t.right_ascension += 2 * ASTRO_PI;
 
     return t;
 }
 
 //Convert Geodedic Lat Lon to geocentric XYZ position vector
 //All angles are input as radians
-astro_cartesian_coordinates_t astro_convert_geodedic_latlon_to_ITRF_XYZ(double lat, double lon, double height) {
+astro_cartesian_coordinates_t astro_convert_geodedic_latlon_to_ITRF_XYZ(astro_real_t lat, astro_real_t lon, astro_real_t height) {
     //Algorithm from Explanatory Supplement to the Astronomical Almanac 3rd ed. P294
-    const double a = 6378136.6;
-    const double f = 1 / 298.25642;
+    const astro_real_t a = ASTRO_REAL(6378136.6);
+    const astro_real_t f = 1 / ASTRO_REAL(298.25642);
 
-    const double C = sqrt(((cos(lat)*cos(lat)) + (1.0-f)*(1.0-f) * (sin(lat)*sin(lat))));
+    const astro_real_t C = sqrt(((astro_cos(lat)*astro_cos(lat)) + (ASTRO_REAL(1.0)-f)*(ASTRO_REAL(1.0)-f) * (astro_sin(lat)*astro_sin(lat))));
 
-    const double S = (1-f)*(1-f)*C;
+    const astro_real_t S = (1-f)*(1-f)*C;
     
-    double h = height;
+    astro_real_t h = height;
 
     astro_cartesian_coordinates_t r;
-    r.x = (a*C+h) * cos(lat) * cos(lon);
-    r.y = (a*C+h) * cos(lat) * sin(lon);
-    r.z = (a*S+h) * sin(lat);
+    r.x = (a*C+h) * astro_cos(lat) * astro_cos(lon);
+    r.y = (a*C+h) * astro_cos(lat) * astro_sin(lon);
+    r.z = (a*S+h) * astro_sin(lat);
     
     return r;
 }
@@ -377,8 +395,8 @@ astro_cartesian_coordinates_t astro_convert_geodedic_latlon_to_ITRF_XYZ(double l
 astro_cartesian_coordinates_t astro_convert_ITRF_to_GCRS(astro_cartesian_coordinates_t r, double ut1) {
     //This is a simple rotation matrix implemenation about the Z axis, rotation angle is -GMST
 
-    double GMST = astro_get_GMST(ut1);
-    GMST =- GMST * 15.0 * M_PI / 180.0;
+    astro_real_t GMST = astro_get_GMST(ut1);
+    GMST =- GMST * ASTRO_REAL(15.0) * ASTRO_PI / ASTRO_REAL(180.0);
 
     astro_matrix_t m = astro_get_z_rotation_matrix(GMST);
     astro_cartesian_coordinates_t t = astro_matrix_multiply(r, m);
@@ -389,14 +407,14 @@ astro_cartesian_coordinates_t astro_convert_ITRF_to_GCRS(astro_cartesian_coordin
 astro_cartesian_coordinates_t astro_convert_coordinates_from_meters_to_AU(astro_cartesian_coordinates_t c) {
     astro_cartesian_coordinates_t t;
     
-    t.x = c.x / 1.49597870691E+11;
-    t.y = c.y / 1.49597870691E+11;
-    t.z = c.z / 1.49597870691E+11;
+    t.x = c.x / ASTRO_REAL(1.49597870691E+11);
+    t.y = c.y / ASTRO_REAL(1.49597870691E+11);
+    t.z = c.z / ASTRO_REAL(1.49597870691E+11);
     
     return t;
 }
 
-astro_cartesian_coordinates_t astro_get_observer_geocentric_coords(double jd, double lat, double lon) {
+astro_cartesian_coordinates_t astro_get_observer_geocentric_coords(double jd, astro_real_t lat, astro_real_t lon) {
     astro_cartesian_coordinates_t r = astro_convert_geodedic_latlon_to_ITRF_XYZ(lat, lon,0);
     r = astro_convert_ITRF_to_GCRS(r, jd);
     r = astro_convert_coordinates_from_meters_to_AU(r);
@@ -404,51 +422,115 @@ astro_cartesian_coordinates_t astro_get_observer_geocentric_coords(double jd, do
     return r;
 }
 
-//Returns a body's cartesian coordinates centered on the Sun.
-//Requires vsop87a_milli_js, if you wish to use a different version of VSOP87, replace the class name vsop87a_milli below
-astro_cartesian_coordinates_t astro_get_body_coordinates(astro_body_t body, double et) {
-    astro_cartesian_coordinates_t retval = {0};
-    double coords[3];
+//Which bodies have a VSOP87 series to fall back on outside the ephemeris table, and which one: each of
+//ASTROLIB_VSOP87_<BODY> is defined as milli or micro (see VSOP87_BODIES in make.mk). Each axis of every body's series
+//is its own function, so --gc-sections leaves out the ones no case below calls. With no list, every body uses
+//vsop87a_milli.
+#if !defined(ASTROLIB_NO_VSOP87) && !defined(ASTROLIB_VSOP87_BODY_LIST)
+#define ASTROLIB_VSOP87_MERCURY milli
+#define ASTROLIB_VSOP87_VENUS milli
+#define ASTROLIB_VSOP87_EARTH milli
+#define ASTROLIB_VSOP87_MARS milli
+#define ASTROLIB_VSOP87_JUPITER milli
+#define ASTROLIB_VSOP87_SATURN milli
+#define ASTROLIB_VSOP87_URANUS milli
+#define ASTROLIB_VSOP87_NEPTUNE milli
+#define ASTROLIB_VSOP87_EMB milli
+#define ASTROLIB_VSOP87_MOON milli
+#endif
+
+#define ASTROLIB_VSOP87_SERIES_(series, body, axis) vsop87a_##series##_##body##_##axis
+#define ASTROLIB_VSOP87_SERIES(series, body, axis) ASTROLIB_VSOP87_SERIES_(series, body, axis)
+#define ASTROLIB_VSOP87_AXIS(series, body, axis, t) ((axis) == 0 ? ASTROLIB_VSOP87_SERIES(series, body, x)(t) : \
+                                                     (axis) == 1 ? ASTROLIB_VSOP87_SERIES(series, body, y)(t) : \
+                                                                   ASTROLIB_VSOP87_SERIES(series, body, z)(t))
+
+//Works out one of a body's coordinates (0, 1 or 2 for x, y or z) from its VSOP87 series. Returns false if it has none.
+static bool _astro_get_vsop87_coordinate(astro_body_t body, double et, uint8_t axis, double *coord) {
+    (void) et; (void) axis; (void) coord; //with ASTROLIB_NO_VSOP87, there's no series to use them
     switch(body) {
-        case ASTRO_BODY_SUN: 
-            return retval; //Sun is at the center for vsop87a
+#ifdef ASTROLIB_VSOP87_MERCURY
         case ASTRO_BODY_MERCURY:
-             vsop87a_milli_getMercury(et, coords);
-             break;
+            *coord = ASTROLIB_VSOP87_AXIS(ASTROLIB_VSOP87_MERCURY, mercury, axis, et);
+            return true;
+#endif
+#ifdef ASTROLIB_VSOP87_VENUS
         case ASTRO_BODY_VENUS:
-             vsop87a_milli_getVenus(et, coords);
-             break;
+            *coord = ASTROLIB_VSOP87_AXIS(ASTROLIB_VSOP87_VENUS, venus, axis, et);
+            return true;
+#endif
+#ifdef ASTROLIB_VSOP87_EARTH
         case ASTRO_BODY_EARTH:
-             vsop87a_milli_getEarth(et, coords);
-             break;
+            *coord = ASTROLIB_VSOP87_AXIS(ASTROLIB_VSOP87_EARTH, earth, axis, et);
+            return true;
+#endif
+#ifdef ASTROLIB_VSOP87_MARS
         case ASTRO_BODY_MARS:
-             vsop87a_milli_getMars(et, coords);
-             break;
+            *coord = ASTROLIB_VSOP87_AXIS(ASTROLIB_VSOP87_MARS, mars, axis, et);
+            return true;
+#endif
+#ifdef ASTROLIB_VSOP87_JUPITER
         case ASTRO_BODY_JUPITER:
-             vsop87a_milli_getJupiter(et, coords);
-             break;
+            *coord = ASTROLIB_VSOP87_AXIS(ASTROLIB_VSOP87_JUPITER, jupiter, axis, et);
+            return true;
+#endif
+#ifdef ASTROLIB_VSOP87_SATURN
         case ASTRO_BODY_SATURN:
-             vsop87a_milli_getSaturn(et, coords);
-             break;
+            *coord = ASTROLIB_VSOP87_AXIS(ASTROLIB_VSOP87_SATURN, saturn, axis, et);
+            return true;
+#endif
+#ifdef ASTROLIB_VSOP87_URANUS
         case ASTRO_BODY_URANUS:
-             vsop87a_milli_getUranus(et, coords);
-             break;
+            *coord = ASTROLIB_VSOP87_AXIS(ASTROLIB_VSOP87_URANUS, uranus, axis, et);
+            return true;
+#endif
+#ifdef ASTROLIB_VSOP87_NEPTUNE
         case ASTRO_BODY_NEPTUNE:
-             vsop87a_milli_getNeptune(et, coords);
-             break;
+            *coord = ASTROLIB_VSOP87_AXIS(ASTROLIB_VSOP87_NEPTUNE, neptune, axis, et);
+            return true;
+#endif
+#ifdef ASTROLIB_VSOP87_EMB
         case ASTRO_BODY_EMB:
-             vsop87a_milli_getEmb(et, coords);
-             break;
+            *coord = ASTROLIB_VSOP87_AXIS(ASTROLIB_VSOP87_EMB, emb, axis, et);
+            return true;
+#endif
+#ifdef ASTROLIB_VSOP87_MOON
         case ASTRO_BODY_MOON:
             {
-                double earth_coords[3];
-                double emb_coords[3];
-                vsop87a_milli_getEarth(et, earth_coords);
-                vsop87a_milli_getEmb(et, emb_coords);
-                vsop87a_milli_getMoon(earth_coords, emb_coords, coords);
+                //as vsop87a_*_getMoon does, one axis at a time.
+                double earth = ASTROLIB_VSOP87_AXIS(ASTROLIB_VSOP87_MOON, earth, axis, et);
+                double emb = ASTROLIB_VSOP87_AXIS(ASTROLIB_VSOP87_MOON, emb, axis, et);
+                *coord = (emb - earth) * (1 + 1 / 0.01230073677) + earth;
             }
-             break;
+            return true;
+#endif
+        default:
+            return false;
     }
+}
+
+//Works out a body's position as astro_get_body_coordinates does, a step at a time. Inside the ephemeris table that's
+//the one step; outside it, the VSOP87 series take one step per axis.
+bool astro_get_body_coordinates_step(astro_body_t body, double et, uint8_t step, double coords[3]) {
+    if (body == ASTRO_BODY_SUN) { //Sun is at the center for vsop87a
+        coords[0] = coords[1] = coords[2] = 0;
+        return true;
+    }
+
+    if (step == 0 && ephemeris_get_body((ephemeris_body_t)(body - ASTRO_BODY_MERCURY), et, coords)) return true;
+    //without a series, the nearest end of the table that ephemeris_get_body left in coords will have to do.
+    if (!_astro_get_vsop87_coordinate(body, et, step, &coords[step])) return true;
+
+    return step == 2;
+}
+
+//Returns a body's cartesian coordinates centered on the Sun.
+//Uses the Chebyshev ephemeris when et falls inside its table, and the body's VSOP87 series otherwise, if it has one.
+//Without one (or building with ASTROLIB_NO_VSOP87), it uses the nearest end of the table instead.
+astro_cartesian_coordinates_t astro_get_body_coordinates(astro_body_t body, double et) {
+    astro_cartesian_coordinates_t retval;
+    double coords[3];
+    for (uint8_t step = 0; !astro_get_body_coordinates_step(body, et, step, coords); step++);
 
     retval.x = coords[0];
     retval.y = coords[1];
@@ -466,12 +548,12 @@ astro_cartesian_coordinates_t astro_get_body_coordinates_light_time_adjusted(ast
     for(uint8_t i = 0 ; i < 2 ; i++) {
         //Calculate light time to body
         body_coords = astro_subtract_cartesian(body_coords, origin);
-        double distance = sqrt(body_coords.x*body_coords.x + body_coords.y*body_coords.y + body_coords.z*body_coords.z);
-        distance *= 1.496e+11; //Convert from AU to meters
-        double lightTime = distance / 299792458.0;
+        astro_real_t distance = sqrt(body_coords.x*body_coords.x + body_coords.y*body_coords.y + body_coords.z*body_coords.z);
+        distance *= ASTRO_REAL(1.496e+11); //Convert from AU to meters
+        astro_real_t lightTime = distance / ASTRO_REAL(299792458.0);
 
         //Convert light time to Julian Millenia, and subtract it from the original value of t
-        newT -= lightTime / 24.0 / 60.0 / 60.0 / 365250.0;  
+        newT -= lightTime / ASTRO_REAL(24.0) / ASTRO_REAL(60.0) / ASTRO_REAL(60.0) / ASTRO_REAL(365250.0);  
         //Recalculate body position adjusted for light time
         body_coords = astro_get_body_coordinates(body, newT);
     }
@@ -479,17 +561,17 @@ astro_cartesian_coordinates_t astro_get_body_coordinates_light_time_adjusted(ast
     return body_coords;
 }
 
-astro_horizontal_coordinates_t astro_ra_dec_to_alt_az(double jd, double lat, double lon, double ra, double dec) {
-    double GMST = astro_get_GMST(jd) * M_PI/180.0 * 15.0;
-    double h = GMST + lon - ra;
+astro_horizontal_coordinates_t astro_ra_dec_to_alt_az(double jd, astro_real_t lat, astro_real_t lon, astro_real_t ra, astro_real_t dec) {
+    astro_real_t GMST = (astro_real_t)astro_get_GMST(jd) * ASTRO_PI/ASTRO_REAL(180.0) * ASTRO_REAL(15.0);
+    astro_real_t h = GMST + lon - ra;
 
-    double sina = sin(dec)*sin(lat) + cos(dec)*cos(h)*cos(lat);
-    double a = asin(sina);
+    astro_real_t sina = astro_sin(dec)*astro_sin(lat) + astro_cos(dec)*astro_cos(h)*astro_cos(lat);
+    astro_real_t a = astro_asin(sina);
 
-    double cosAz = (sin(dec)*cos(lat) - cos(dec)*cos(h)*sin(lat)) / cos(a);
-    double Az = acos(cosAz);
+    astro_real_t cosAz = (astro_sin(dec)*astro_cos(lat) - astro_cos(dec)*astro_cos(h)*astro_sin(lat)) / astro_cos(a);
+    astro_real_t Az = astro_acos(cosAz);
 
-    if(sin(h) > 0) Az = 2.0*M_PI - Az;
+    if(astro_sin(h) > 0) Az = ASTRO_REAL(2.0)*ASTRO_PI - Az;
 
     astro_horizontal_coordinates_t retval;
     retval.altitude = a;
@@ -498,23 +580,23 @@ astro_horizontal_coordinates_t astro_ra_dec_to_alt_az(double jd, double lat, dou
     return retval;
 }
 
-double astro_degrees_to_radians(double degrees) {
-    return degrees * M_PI / 180;
+astro_real_t astro_degrees_to_radians(astro_real_t degrees) {
+    return degrees * ASTRO_PI / 180;
 }
 
-double astro_radians_to_degrees(double radians) {
-    return radians * 180.0 / M_PI;
+astro_real_t astro_radians_to_degrees(astro_real_t radians) {
+    return radians * ASTRO_REAL(180.0) / ASTRO_PI;
 }
 
-astro_angle_dms_t astro_radians_to_dms(double radians) {
+astro_angle_dms_t astro_radians_to_dms(astro_real_t radians) {
     astro_angle_dms_t retval;
     int8_t sign = (radians < 0) ? -1 : 1;
-    double degrees = fabs(astro_radians_to_degrees(radians));
+    astro_real_t degrees = fabs(astro_radians_to_degrees(radians));
 
     retval.degrees = (uint16_t)degrees;
-    double temp = 60.0 * (degrees - retval.degrees);
+    astro_real_t temp = ASTRO_REAL(60.0) * (degrees - retval.degrees);
     retval.minutes = (uint8_t)temp;
-    retval.seconds = (uint8_t)round(60.0 * (temp - retval.minutes));
+    retval.seconds = (uint8_t)round(ASTRO_REAL(60.0) * (temp - retval.minutes));
 
     if (retval.seconds > 59) {
         retval.seconds = 0.0;
@@ -531,15 +613,15 @@ astro_angle_dms_t astro_radians_to_dms(double radians) {
     return retval;
 }
 
-astro_angle_hms_t astro_radians_to_hms(double radians) {
+astro_angle_hms_t astro_radians_to_hms(astro_real_t radians) {
     astro_angle_hms_t retval;
-    double degrees = astro_radians_to_degrees(radians);
-    double temp = degrees / 15.0;
+    astro_real_t degrees = astro_radians_to_degrees(radians);
+    astro_real_t temp = degrees / ASTRO_REAL(15.0);
 
     retval.hours = (uint8_t)temp;
-    temp = 60.0 * (temp - retval.hours);
+    temp = ASTRO_REAL(60.0) * (temp - retval.hours);
     retval.minutes = (uint8_t)temp;
-    retval.seconds = (uint8_t)round(60.0 * (temp - retval.minutes));
+    retval.seconds = (uint8_t)round(ASTRO_REAL(60.0) * (temp - retval.minutes));
 
     if (retval.seconds > 59) {
         retval.seconds = 0;
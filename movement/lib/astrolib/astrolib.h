@@ -19,6 +19,21 @@
 #ifndef ASTROLIB_H_
 #define ASTROLIB_H_
 
+// Define ASTROLIB_SINGLE_PRECISION to do the angle, vector and matrix math in float rather than double. The Cortex-M0+
+// has no FPU, and float emulation is several times faster and smaller than double emulation. Julian dates, sidereal
+// time and the VSOP87 series stay in double no matter what: a Julian date needs more than float's 24 bits of mantissa
+// to resolve seconds, and the positions are only narrowed once they come out of the series. Over 1900-2100, right
+// ascension and declination stay within a few arcseconds of the double-precision results, well below what the watch
+// can display.
+#ifdef ASTROLIB_SINGLE_PRECISION
+typedef float astro_real_t;
+#define ASTRO_REAL(x) (x##f)
+#else
+typedef double astro_real_t;
+#define ASTRO_REAL(x) (x)
+#endif
+#define ASTRO_PI ASTRO_REAL(3.14159265358979323846)
+
 typedef enum {
     ASTRO_BODY_SUN = 0,
     ASTRO_BODY_MERCURY,
@@ -34,24 +49,24 @@ typedef enum {
 } astro_body_t;
 
 typedef struct {
-    double elements[3][3];
+    astro_real_t elements[3][3];
 } astro_matrix_t;
 
 typedef struct {
-    double x;
-    double y;
-    double z;
+    astro_real_t x;
+    astro_real_t y;
+    astro_real_t z;
 } astro_cartesian_coordinates_t;
 
 typedef struct {
-    double right_ascension;
-    double declination;
-    double distance;
+    astro_real_t right_ascension;
+    astro_real_t declination;
+    astro_real_t distance;
 } astro_equatorial_coordinates_t;
 
 typedef struct {
-    double altitude;
-    double azimuth;
+    astro_real_t altitude;
+    astro_real_t azimuth;
 } astro_horizontal_coordinates_t;
 
 typedef struct {
@@ -72,16 +87,24 @@ double astro_convert_date_to_julian_date(uint16_t year, uint8_t month, uint8_t d
 // Converts a Julan Date to Julian Millenia since J2000, which is what VSOP87 expects as input.
 double astro_convert_jd_to_julian_millenia_since_j2000(double jd);
 
+// Get a body's position in AU relative to the Sun (ecliptic and equinox of J2000), at et Julian millenia since J2000.
+astro_cartesian_coordinates_t astro_get_body_coordinates(astro_body_t body, double et);
+
+// The same, a step at a time, for callers that can't spend long at once: call it with step 0, 1 and so on, and the same
+// coords, until it returns true. coords holds the position then. This takes a single step where the ephemeris table
+// covers et, and three, one per axis, where the VSOP87 series have to be summed.
+bool astro_get_body_coordinates_step(astro_body_t body, double et, uint8_t step, double coords[3]);
+
 // Get right ascension / declination for a given body in the list above.
-astro_equatorial_coordinates_t astro_get_ra_dec(double jd, astro_body_t bodyNum, double lat, double lon, bool calculate_precession);
+astro_equatorial_coordinates_t astro_get_ra_dec(double jd, astro_body_t bodyNum, astro_real_t lat, astro_real_t lon, bool calculate_precession);
 
 // Convert right ascension / declination to altitude/azimuth for a given location.
-astro_horizontal_coordinates_t astro_ra_dec_to_alt_az(double jd, double lat, double lon, double ra, double dec);
+astro_horizontal_coordinates_t astro_ra_dec_to_alt_az(double jd, astro_real_t lat, astro_real_t lon, astro_real_t ra, astro_real_t dec);
 
 // these are self-explanatory
-double astro_degrees_to_radians(double degrees);
-double astro_radians_to_degrees(double radians);
-astro_angle_dms_t astro_radians_to_dms(double radians);
-astro_angle_hms_t astro_radians_to_hms(double radians);
+astro_real_t astro_degrees_to_radians(astro_real_t degrees);
+astro_real_t astro_radians_to_degrees(astro_real_t radians);
+astro_angle_dms_t astro_radians_to_dms(astro_real_t radians);
+astro_angle_hms_t astro_radians_to_hms(astro_real_t radians);
 
 #endif // ASTROLIB_H_
@@ -0,0 +1,292 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Times the compute kernels in movement/lib and watch_utility, one call at a time, and prints the cost of a
+// call in the platform's unit. Each kernel's inputs change from call to call so that no result can be cached,
+// and every result lands in a volatile sink so that no call can be optimised away.
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include "bench.h"
+#include "sunriset.h"
+#include "astrolib.h"
+#include "ephemeris.h"
+#include "vsop87a_milli.h"
+#include "TOTP.h"
+#include "base32.h"
+#include "chirpy_tx.h"
+#include "optical_rx.h"
+#include "watch_utility.h"
+#include "watch_math.h"
+
+#ifndef BENCH_SCALE
+#define BENCH_SCALE 1 // multiplies every kernel's iteration count; the host is a lot faster than the watch
+#endif
+
+typedef struct {
+    const char *name;
+    void (*setup)(void);
+    void (*run)(uint32_t i);
+    uint32_t iterations;
+} bench_kernel_t;
+
+static volatile double bench_sink_real;
+static volatile float bench_sink_float;
+static volatile uint32_t bench_sink;
+
+// 2030 January 1, inside the ephemeris table, plus a few hours per iteration.
+#define BENCH_JD 2462502.5
+#define BENCH_LATITUDE 40.78
+#define BENCH_LONGITUDE -73.97
+
+static void bench_empty(uint32_t i) {
+    bench_sink = i;
+}
+
+static void bench_sunriset(uint32_t i) {
+    double rise, set;
+    sun_rise_set(2024, 1 + i % 12, 1 + i % 28, BENCH_LONGITUDE, BENCH_LATITUDE, &rise, &set);
+    bench_sink_real = rise + set;
+}
+
+static void bench_astro_ra_dec_sun(uint32_t i) {
+    astro_equatorial_coordinates_t coordinates = astro_get_ra_dec(BENCH_JD + i * 0.1, ASTRO_BODY_SUN,
+        astro_degrees_to_radians(BENCH_LATITUDE), astro_degrees_to_radians(BENCH_LONGITUDE), true);
+    bench_sink_real = coordinates.right_ascension;
+}
+
+static void bench_astro_ra_dec_moon(uint32_t i) {
+    astro_equatorial_coordinates_t coordinates = astro_get_ra_dec(BENCH_JD + i * 0.1, ASTRO_BODY_MOON,
+        astro_degrees_to_radians(BENCH_LATITUDE), astro_degrees_to_radians(BENCH_LONGITUDE), true);
+    bench_sink_real = coordinates.right_ascension;
+}
+
+static void bench_astro_alt_az(uint32_t i) {
+    astro_horizontal_coordinates_t coordinates = astro_ra_dec_to_alt_az(BENCH_JD + i * 0.001,
+        astro_degrees_to_radians(BENCH_LATITUDE), astro_degrees_to_radians(BENCH_LONGITUDE), 1.0, 0.3);
+    bench_sink_real = coordinates.altitude;
+}
+
+static void bench_ephemeris_mars(uint32_t i) {
+    double coordinates[3];
+    ephemeris_get_body(EPHEMERIS_BODY_MARS, astro_convert_jd_to_julian_millenia_since_j2000(BENCH_JD + i), coordinates);
+    bench_sink_real = coordinates[0];
+}
+
+static void bench_ephemeris_moon(uint32_t i) {
+    double coordinates[3];
+    ephemeris_get_body(EPHEMERIS_BODY_MOON, astro_convert_jd_to_julian_millenia_since_j2000(BENCH_JD + i), coordinates);
+    bench_sink_real = coordinates[0];
+}
+
+static void bench_vsop87_mars(uint32_t i) {
+    double coordinates[3];
+    vsop87a_milli_getMars(astro_convert_jd_to_julian_millenia_since_j2000(BENCH_JD + i), coordinates);
+    bench_sink_real = coordinates[0];
+}
+
+static void bench_vsop87_moon(uint32_t i) {
+    double earth[3], emb[3], coordinates[3];
+    double t = astro_convert_jd_to_julian_millenia_since_j2000(BENCH_JD + i);
+    vsop87a_milli_getEarth(t, earth);
+    vsop87a_milli_getEmb(t, emb);
+    vsop87a_milli_getMoon(earth, emb, coordinates);
+    bench_sink_real = coordinates[0];
+}
+
+// RFC 6238 test keys.
+static uint8_t bench_totp_key[64] = "1234567890123456789012345678901234567890123456789012345678901234";
+
+static void bench_totp_setup_sha1(void) {
+    TOTP(bench_totp_key, 20, 30, SHA1);
+}
+
+static void bench_totp_setup_sha256(void) {
+    TOTP(bench_totp_key, 32, 30, SHA256);
+}
+
+static void bench_totp_setup_sha512(void) {
+    TOTP(bench_totp_key, 64, 30, SHA512);
+}
+
+static void bench_totp_code(uint32_t i) {
+    bench_sink = getCodeFromSteps(56666666 + i);
+}
+
+static void bench_totp_key_sha1(uint32_t i) {
+    bench_totp_key[0] = '1' + (i & 7);
+    TOTP(bench_totp_key, 20, 30, SHA1);
+    bench_sink = bench_totp_key[0];
+}
+
+static void bench_base32_decode(uint32_t i) {
+    unsigned char plain[20];
+    unsigned char coded[] = "HXDMVJECJJWSRB3HWIZR4IFUGFTMXBOZ";
+    coded[i % 32] = 'A' + i % 26;
+    bench_sink = base32_decode(coded, plain) + plain[0];
+}
+
+static const uint8_t *bench_chirpy_data;
+static uint16_t bench_chirpy_position;
+
+static uint8_t bench_chirpy_get_next_byte(uint8_t *next_byte) {
+    if (bench_chirpy_position == 64) return 0;
+    *next_byte = bench_chirpy_data[bench_chirpy_position++];
+    return 1;
+}
+
+static void bench_chirpy_tx(uint32_t i) {
+    chirpy_encoder_state_t encoder;
+    uint32_t tones = i;
+    bench_chirpy_data = bench_totp_key;
+    bench_chirpy_position = 0;
+    chirpy_init_encoder(&encoder, bench_chirpy_get_next_byte);
+    while (chirpy_get_next_tone(&encoder) != 255) tones++;
+    bench_sink = tones;
+}
+
+static optical_rx_state_t bench_optical_rx_state;
+
+static void bench_optical_rx_setup(void) {
+    optical_rx_init(&bench_optical_rx_state, 4);
+}
+
+// one sample, as the receiver takes 512 times a second: the bits of the TOTP key, four samples each, between levels
+// far enough apart to decode.
+static void bench_optical_rx_sample(uint32_t i) {
+    bool light = (bench_totp_key[(i >> 5) % 64] >> ((i >> 2) & 7)) & 1;
+    bench_sink = optical_rx_add_sample(&bench_optical_rx_state, light ? 40000 + (i & 255) : 20000 + (i & 255));
+}
+
+static void bench_watch_utility_to_unix(uint32_t i) {
+    bench_sink = watch_utility_convert_to_unix_time(2024 + i % 40, 1 + i % 12, 1 + i % 28, i % 24, i % 60, 0, 0);
+}
+
+static void bench_watch_utility_from_unix(uint32_t i) {
+    bench_sink = watch_utility_date_time_from_unix_time(1700000000 + i * 86413, 3600).reg;
+}
+
+static void bench_watch_utility_convert_zone(uint32_t i) {
+    watch_date_time date_time = watch_utility_date_time_from_unix_time(1700000000 + i * 3607, 0);
+    bench_sink = watch_utility_date_time_convert_zone(date_time, 0, -5 * 3600).reg;
+}
+
+// angles over a few turns, and ratios from 0.01 to 100, so that every quadrant and branch gets its share.
+#define BENCH_ANGLE(i) ((float)((int32_t)((i) % 1024) - 512) * 0.0123f)
+#define BENCH_RATIO(i) (0.01f + (float)((i) % 1024) * 0.0977f)
+
+static void bench_libm_sinf(uint32_t i) {
+    bench_sink_float = sinf(BENCH_ANGLE(i));
+}
+
+static void bench_watch_sinf(uint32_t i) {
+    bench_sink_float = watch_sinf(BENCH_ANGLE(i));
+}
+
+static void bench_libm_atan2f(uint32_t i) {
+    bench_sink_float = atan2f(BENCH_ANGLE(i), BENCH_ANGLE(i + 300));
+}
+
+static void bench_watch_atan2f(uint32_t i) {
+    bench_sink_float = watch_atan2f(BENCH_ANGLE(i), BENCH_ANGLE(i + 300));
+}
+
+static void bench_libm_powf(uint32_t i) {
+    bench_sink_float = powf(BENCH_RATIO(i), 2.5f);
+}
+
+static void bench_watch_powf(uint32_t i) {
+    bench_sink_float = watch_powf(BENCH_RATIO(i), 2.5f);
+}
+
+static void bench_watch_sin_q15(uint32_t i) {
+    bench_sink = watch_sin_q15(i * 40503);
+}
+
+static void bench_watch_atan2_q16(uint32_t i) {
+    bench_sink = watch_atan2_q16((int32_t)(i % 2000) - 1000, (int32_t)((i * 7) % 2000) - 1000);
+}
+
+static const bench_kernel_t bench_kernels[] = {
+    { "sunriset", NULL, bench_sunriset, 32 },
+    { "astro_ra_dec_sun", NULL, bench_astro_ra_dec_sun, 16 },
+    { "astro_ra_dec_moon", NULL, bench_astro_ra_dec_moon, 16 },
+    { "astro_alt_az", NULL, bench_astro_alt_az, 64 },
+    { "ephemeris_mars", NULL, bench_ephemeris_mars, 64 },
+    { "ephemeris_moon", NULL, bench_ephemeris_moon, 64 },
+    { "vsop87_mars", NULL, bench_vsop87_mars, 4 },
+    { "vsop87_moon", NULL, bench_vsop87_moon, 4 },
+    { "totp_code_sha1", bench_totp_setup_sha1, bench_totp_code, 64 },
+    { "totp_code_sha256", bench_totp_setup_sha256, bench_totp_code, 64 },
+    { "totp_code_sha512", bench_totp_setup_sha512, bench_totp_code, 32 },
+    { "totp_key_sha1", NULL, bench_totp_key_sha1, 64 },
+    { "base32_decode", NULL, bench_base32_decode, 256 },
+    { "chirpy_tx_64_bytes", NULL, bench_chirpy_tx, 32 },
+    { "optical_rx_sample", bench_optical_rx_setup, bench_optical_rx_sample, 4096 },
+    { "watch_utility_to_unix", NULL, bench_watch_utility_to_unix, 1024 },
+    { "watch_utility_from_unix", NULL, bench_watch_utility_from_unix, 1024 },
+    { "watch_utility_zone", NULL, bench_watch_utility_convert_zone, 1024 },
+    { "libm_sinf", NULL, bench_libm_sinf, 256 },
+    { "watch_sinf", NULL, bench_watch_sinf, 256 },
+    { "libm_atan2f", NULL, bench_libm_atan2f, 256 },
+    { "watch_atan2f", NULL, bench_watch_atan2f, 256 },
+    { "libm_powf", NULL, bench_libm_powf, 256 },
+    { "watch_powf", NULL, bench_watch_powf, 256 },
+    { "watch_sin_q15", NULL, bench_watch_sin_q15, 1024 },
+    { "watch_atan2_q16", NULL, bench_watch_atan2_q16, 1024 },
+};
+
+static uint32_t bench_time(void (*run)(uint32_t i), uint32_t iterations) {
+    uint32_t start = bench_now();
+    for (uint32_t i = 0; i < iterations; i++) run(i);
+    return bench_now() - start;
+}
+
+int main(void) {
+    char line[80];
+
+    bench_platform_init();
+    snprintf(line, sizeof(line), "%-24s %12s %10s\n", "kernel", bench_unit, "calls");
+    bench_print(line);
+
+    for (size_t k = 0; k < sizeof(bench_kernels) / sizeof(bench_kernels[0]); k++) {
+        const bench_kernel_t *kernel = &bench_kernels[k];
+        uint32_t iterations = kernel->iterations * BENCH_SCALE;
+        if (kernel->setup) kernel->setup();
+
+        // one untimed call warms any caches the kernel keeps, then the cost of the loop itself is taken off.
+        kernel->run(0);
+        uint32_t elapsed = bench_time(kernel->run, iterations);
+        uint32_t overhead = bench_time(bench_empty, iterations);
+        elapsed = elapsed > overhead ? elapsed - overhead : 0;
+
+        snprintf(line, sizeof(line), "%-24s %12lu %10lu\n", kernel->name,
+                 (unsigned long)((elapsed + iterations / 2) / iterations), (unsigned long)iterations);
+        bench_print(line);
+    }
+
+    bench_exit(0);
+    return 0;
+}
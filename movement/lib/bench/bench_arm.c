@@ -0,0 +1,112 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Benchmark platform for a bare Cortex-M0+, or QEMU's micro:bit (a Cortex-M0, the same ARMv6-M core). Time comes
+// from SysTick running off the processor clock, extended to 32 bits in its wrap interrupt, and output goes over
+// ARM semihosting, so the same image runs under QEMU or on real hardware with a debug probe attached.
+
+#include <stdint.h>
+#include <string.h>
+#include "bench.h"
+
+#define SYST_CSR (*(volatile uint32_t *)0xE000E010)
+#define SYST_RVR (*(volatile uint32_t *)0xE000E014)
+#define SYST_CVR (*(volatile uint32_t *)0xE000E018)
+#define SYST_CSR_ENABLE_TICKINT_CLKSOURCE 0x7
+#define SYST_MAX 0xFFFFFF
+
+#define SEMIHOSTING_SYS_WRITE0 0x04
+#define SEMIHOSTING_SYS_EXIT 0x18
+#define SEMIHOSTING_APPLICATION_EXIT 0x20026
+#define SEMIHOSTING_RUNTIME_ERROR 0x20023
+
+const char bench_unit[] = "cycles";
+
+static volatile uint32_t bench_systick_wraps;
+
+extern uint32_t _sidata, _sdata, _edata, _sbss, _ebss, _estack;
+int main(void);
+void Reset_Handler(void);
+void Default_Handler(void);
+void SysTick_Handler(void);
+
+__attribute__((section(".vectors"), used))
+static void (* const bench_vectors[16])(void) = {
+    (void (*)(void))&_estack,
+    Reset_Handler,
+    Default_Handler, // NMI
+    Default_Handler, // HardFault
+    0, 0, 0, 0, 0, 0, 0,
+    Default_Handler, // SVCall
+    0, 0,
+    Default_Handler, // PendSV
+    SysTick_Handler,
+};
+
+static int bench_semihost(int operation, void *argument) {
+    register int r0 __asm__("r0") = operation;
+    register void *r1 __asm__("r1") = argument;
+    __asm__ volatile ("bkpt 0xab" : "+r"(r0) : "r"(r1) : "memory");
+    return r0;
+}
+
+void Reset_Handler(void) {
+    memcpy(&_sdata, &_sidata, (uint8_t *)&_edata - (uint8_t *)&_sdata);
+    memset(&_sbss, 0, (uint8_t *)&_ebss - (uint8_t *)&_sbss);
+    bench_exit(main());
+}
+
+void Default_Handler(void) {
+    bench_print("bench: unexpected exception\n");
+    bench_exit(1);
+}
+
+void SysTick_Handler(void) {
+    bench_systick_wraps++;
+}
+
+void bench_platform_init(void) {
+    SYST_RVR = SYST_MAX;
+    SYST_CVR = 0;
+    SYST_CSR = SYST_CSR_ENABLE_TICKINT_CLKSOURCE;
+}
+
+uint32_t bench_now(void) {
+    uint32_t wraps, value;
+    // SysTick counts down; read again if it wrapped between the two loads.
+    do {
+        wraps = bench_systick_wraps;
+        value = SYST_CVR;
+    } while (wraps != bench_systick_wraps);
+    return (wraps << 24) + (SYST_MAX - value);
+}
+
+void bench_print(const char *line) {
+    bench_semihost(SEMIHOSTING_SYS_WRITE0, (void *)line);
+}
+
+void bench_exit(int status) {
+    bench_semihost(SEMIHOSTING_SYS_EXIT, (void *)(status ? SEMIHOSTING_RUNTIME_ERROR : SEMIHOSTING_APPLICATION_EXIT));
+    while (1);
+}
@@ -0,0 +1,726 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "calc_number.h"
+
+// 1 in the 2.29 fixed point the functions work in: two bits for the whole part and the sign, the rest for the fraction.
+#define FRACTION_BITS 29
+#define ONE ((int32_t)1 << FRACTION_BITS)
+#define FIXED_LN2 372130559
+// the inverse of how much the CORDIC rotations stretch a vector: the product of 1 / sqrt(1 + 2^-2i).
+#define CORDIC_GAIN 326016437
+// below about 0.008, two terms of their series give the sine, tangent and arctangent more digits than CORDIC does.
+#define SMALL_ANGLE ((int32_t)1 << 22)
+#define TABLE_SIZE 16
+
+static const uint64_t powers_of_ten[20] = {
+    1ULL, 10ULL, 100ULL, 1000ULL, 10000ULL, 100000ULL, 1000000ULL, 10000000ULL, 100000000ULL, 1000000000ULL,
+    10000000000ULL, 100000000000ULL, 1000000000000ULL, 10000000000000ULL, 100000000000000ULL,
+    1000000000000000ULL, 10000000000000000ULL, 100000000000000000ULL, 1000000000000000000ULL,
+    10000000000000000000ULL,
+};
+
+// atan(2^-i) and ln(1 + 2^-i) in fixed point; past the table, both round to 2^-i.
+static const int32_t atan_table[TABLE_SIZE] = {
+    421657428, 248918915, 131521918, 66762579, 33510843, 16771758, 8387925, 4194219,
+    2097141, 1048575, 524288, 262144, 131072, 65536, 32768, 16384,
+};
+static const int32_t ln_table[TABLE_SIZE] = {
+    372130559, 217682422, 119799282, 63234286, 32547596, 16520408, 8323747, 4178005,
+    2093067, 1047553, 524032, 262080, 131056, 65532, 32767, 16384,
+};
+
+static const calc_number_t one = { 100000000, -8 };
+static const calc_number_t half = { 500000000, -9 };
+static const calc_number_t three = { 300000000, -8 };
+static const calc_number_t five = { 500000000, -8 };
+static const calc_number_t six = { 600000000, -8 };
+static const calc_number_t near_one = { 500000000, -10 };
+static const calc_number_t ninety = { 900000000, -7 };
+static const calc_number_t half_pi = { 157079633, -8 };
+static const calc_number_t ln10 = { 230258509, -8 };
+// what's left of π/2 and ln 10 past these nine digits, for subtract_multiple.
+static const calc_number_t half_pi_high = { 157079632, -8 };
+static const calc_number_t half_pi_low = { 679489665, -17 };
+static const calc_number_t ln10_low = { 299404590, -17 };
+static const calc_number_t degrees_per_radian = { 572957795, -7 };
+static const calc_number_t radians_per_degree = { 174532925, -10 };
+
+static int32_t atan_step(uint8_t i) {
+    return i < TABLE_SIZE ? atan_table[i] : ONE >> i;
+}
+
+static int32_t ln_step(uint8_t i) {
+    return i < TABLE_SIZE ? ln_table[i] : ONE >> i;
+}
+
+// divides, rounding halves away from zero.
+static int64_t divide_rounded(int64_t value, uint64_t divisor) {
+    if (value < 0) return -(int64_t)(((uint64_t)-value + divisor / 2) / divisor);
+    return (int64_t)(((uint64_t)value + divisor / 2) / divisor);
+}
+
+static calc_number_t infinity(bool negative) {
+    return (calc_number_t){ negative ? -1 : 1, CALC_NUMBER_SPECIAL };
+}
+
+static bool is_special(calc_number_t x) {
+    return x.exponent == CALC_NUMBER_SPECIAL;
+}
+
+// rounds any value × 10^exponent to nine digits.
+static calc_number_t normalize(int64_t value, int32_t exponent) {
+    if (value == 0) return CALC_NUMBER_ZERO;
+    bool negative = value < 0;
+    uint64_t magnitude = negative ? -(uint64_t)value : (uint64_t)value;
+
+    uint8_t excess = 0;
+    while (excess + CALC_NUMBER_DIGITS < 20 && magnitude >= powers_of_ten[CALC_NUMBER_DIGITS + excess]) excess++;
+    if (excess) {
+        magnitude = (magnitude + powers_of_ten[excess] / 2) / powers_of_ten[excess];
+        exponent += excess;
+        if (magnitude == powers_of_ten[CALC_NUMBER_DIGITS]) {
+            magnitude /= 10;
+            exponent++;
+        }
+    }
+    while (magnitude < powers_of_ten[CALC_NUMBER_DIGITS - 1]) {
+        magnitude *= 10;
+        exponent--;
+    }
+
+    if (exponent + CALC_NUMBER_DIGITS - 1 > CALC_NUMBER_MAX_EXPONENT) return infinity(negative);
+    if (exponent + CALC_NUMBER_DIGITS - 1 < -CALC_NUMBER_MAX_EXPONENT - 1) return CALC_NUMBER_ZERO;
+    return (calc_number_t){ negative ? -(int32_t)magnitude : (int32_t)magnitude, (int16_t)exponent };
+}
+
+// x, which must be under 4 in magnitude, in fixed point.
+static int32_t to_fixed(calc_number_t x) {
+    if (x.mantissa == 0 || x.exponent < -19) return 0;
+    return (int32_t)divide_rounded((int64_t)x.mantissa * ONE, powers_of_ten[-x.exponent]);
+}
+
+// a fixed point value, which may have more than two bits in its whole part.
+static calc_number_t from_fixed(int64_t value) {
+    return normalize(divide_rounded(value * (int64_t)powers_of_ten[CALC_NUMBER_DIGITS], ONE), -CALC_NUMBER_DIGITS);
+}
+
+// x - k × (high + low), where k × high is worked out exactly, so that taking many of a constant off a number that's
+// nearly a multiple of it still leaves what's left right to nine digits.
+static calc_number_t subtract_multiple(calc_number_t x, int32_t k, calc_number_t high, calc_number_t low) {
+    if (k == 0) return x;
+    int64_t product = (int64_t)k * high.mantissa;
+    int32_t exponent = x.exponent < high.exponent ? x.exponent : high.exponent;
+    int32_t x_shift = x.exponent - exponent;
+    int32_t product_shift = high.exponent - exponent;
+    calc_number_t rest;
+    if (x.mantissa == 0 || x_shift > CALC_NUMBER_DIGITS || product_shift > CALC_NUMBER_DIGITS) {
+        rest = calc_number_subtract(x, calc_number_multiply(normalize(k, 0), high));
+    } else {
+        rest = normalize((int64_t)x.mantissa * (int64_t)powers_of_ten[x_shift] -
+                         product * (int64_t)powers_of_ten[product_shift], exponent);
+    }
+    return calc_number_subtract(rest, calc_number_multiply(normalize(k, 0), low));
+}
+
+// x + x³ / divisor: the first two terms of the series for sin (with -6), atan (with -3) and atanh (with 3).
+static calc_number_t series(calc_number_t x, calc_number_t divisor) {
+    return calc_number_add(x, calc_number_divide(calc_number_multiply(calc_number_multiply(x, x), x), divisor));
+}
+
+calc_number_t calc_number_from_int(int32_t value, int16_t exponent) {
+    return normalize(value, exponent);
+}
+
+bool calc_number_to_int(calc_number_t x, uint8_t decimals, int32_t *value) {
+    if (is_special(x)) return false;
+    int32_t shift = x.exponent + decimals;
+    int64_t result;
+    if (x.mantissa == 0) {
+        result = 0;
+    } else if (shift >= 0) {
+        if (shift > CALC_NUMBER_DIGITS) return false;
+        result = (int64_t)x.mantissa * (int64_t)powers_of_ten[shift];
+    } else {
+        result = shift < -19 ? 0 : divide_rounded(x.mantissa, powers_of_ten[-shift]);
+    }
+    if (result > INT32_MAX || result < INT32_MIN) return false;
+    *value = (int32_t)result;
+    return true;
+}
+
+uint32_t calc_number_digits(calc_number_t x, uint8_t significant, int16_t *magnitude) {
+    *magnitude = 0;
+    if (is_special(x) || x.mantissa == 0) return 0;
+    uint32_t digits = x.mantissa < 0 ? -x.mantissa : x.mantissa;
+    uint32_t divisor = powers_of_ten[CALC_NUMBER_DIGITS - significant];
+    digits = (digits + divisor / 2) / divisor;
+    *magnitude = x.exponent + CALC_NUMBER_DIGITS - 1;
+    if (digits >= powers_of_ten[significant]) {
+        digits /= 10;
+        (*magnitude)++;
+    }
+    return digits;
+}
+
+bool calc_number_parse(const char *str, calc_number_t *x) {
+    const char *c = str;
+    bool negative = false;
+    if (*c == '-' || *c == '+') negative = *c++ == '-';
+
+    // keep a few digits past the ninth, so that rounding them off is right.
+    int64_t mantissa = 0;
+    int32_t exponent = 0;
+    bool any_digits = false;
+    bool point = false;
+    for (;; c++) {
+        if (*c >= '0' && *c <= '9') {
+            any_digits = true;
+            if (mantissa < (int64_t)powers_of_ten[17]) {
+                mantissa = mantissa * 10 + (*c - '0');
+                if (point) exponent--;
+            } else if (!point) {
+                exponent++;
+            }
+        } else if (*c == '.' && !point) {
+            point = true;
+        } else {
+            break;
+        }
+    }
+    if (!any_digits) return false;
+
+    if (*c == 'e' || *c == 'E') {
+        c++;
+        bool negative_exponent = false;
+        if (*c == '-' || *c == '+') negative_exponent = *c++ == '-';
+        if (*c < '0' || *c > '9') return false;
+        int32_t written = 0;
+        for (; *c >= '0' && *c <= '9'; c++) {
+            if (written < 100000) written = written * 10 + (*c - '0');
+        }
+        exponent += negative_exponent ? -written : written;
+    }
+    if (*c != '\0') return false;
+
+    *x = normalize(negative ? -mantissa : mantissa, exponent);
+    return true;
+}
+
+bool calc_number_is_nan(calc_number_t x) {
+    return is_special(x) && x.mantissa == 0;
+}
+
+bool calc_number_is_infinite(calc_number_t x) {
+    return is_special(x) && x.mantissa != 0;
+}
+
+bool calc_number_is_zero(calc_number_t x) {
+    return !is_special(x) && x.mantissa == 0;
+}
+
+bool calc_number_is_negative(calc_number_t x) {
+    return x.mantissa < 0;
+}
+
+bool calc_number_is_integer(calc_number_t x) {
+    if (is_special(x)) return false;
+    if (x.mantissa == 0 || x.exponent >= 0) return true;
+    if (x.exponent < -CALC_NUMBER_DIGITS) return false;
+    return x.mantissa % (int32_t)powers_of_ten[-x.exponent] == 0;
+}
+
+int8_t calc_number_compare(calc_number_t a, calc_number_t b) {
+    if (calc_number_is_nan(a) || calc_number_is_nan(b)) return 0;
+    int8_t sign_a = (a.mantissa > 0) - (a.mantissa < 0);
+    int8_t sign_b = (b.mantissa > 0) - (b.mantissa < 0);
+    if (sign_a != sign_b) return sign_a < sign_b ? -1 : 1;
+    if (sign_a == 0) return 0;
+
+    int8_t order;
+    if (is_special(a) || is_special(b)) {
+        order = is_special(a) - is_special(b);
+    } else if (a.exponent != b.exponent) {
+        order = a.exponent > b.exponent ? 1 : -1;
+    } else {
+        order = (a.mantissa > b.mantissa) - (a.mantissa < b.mantissa);
+        return order;
+    }
+    return sign_a > 0 ? order : -order;
+}
+
+calc_number_t calc_number_negate(calc_number_t x) {
+    x.mantissa = -x.mantissa;
+    return x;
+}
+
+calc_number_t calc_number_abs(calc_number_t x) {
+    if (x.mantissa < 0) x.mantissa = -x.mantissa;
+    return x;
+}
+
+calc_number_t calc_number_add(calc_number_t a, calc_number_t b) {
+    if (is_special(a) || is_special(b)) {
+        if (calc_number_is_nan(a) || calc_number_is_nan(b)) return CALC_NUMBER_NAN;
+        if (is_special(a) && is_special(b)) return a.mantissa == b.mantissa ? a : CALC_NUMBER_NAN;
+        return is_special(a) ? a : b;
+    }
+    if (a.mantissa == 0) return b;
+    if (b.mantissa == 0) return a;
+    if (a.exponent < b.exponent) {
+        calc_number_t swap = a;
+        a = b;
+        b = swap;
+    }
+
+    // line the digits up: scale a up by as much as fits, and b down by the rest.
+    int32_t gap = a.exponent - b.exponent;
+    int32_t up = gap > CALC_NUMBER_DIGITS ? CALC_NUMBER_DIGITS : gap;
+    int32_t down = gap - up;
+    int64_t larger = (int64_t)a.mantissa * (int64_t)powers_of_ten[up];
+    int64_t smaller = down > 19 ? 0 : divide_rounded(b.mantissa, powers_of_ten[down]);
+    return normalize(larger + smaller, a.exponent - up);
+}
+
+calc_number_t calc_number_subtract(calc_number_t a, calc_number_t b) {
+    return calc_number_add(a, calc_number_negate(b));
+}
+
+calc_number_t calc_number_multiply(calc_number_t a, calc_number_t b) {
+    if (calc_number_is_nan(a) || calc_number_is_nan(b)) return CALC_NUMBER_NAN;
+    if (is_special(a) || is_special(b)) {
+        if (a.mantissa == 0 || b.mantissa == 0) return CALC_NUMBER_NAN;
+        return infinity((a.mantissa < 0) != (b.mantissa < 0));
+    }
+    return normalize((int64_t)a.mantissa * b.mantissa, (int32_t)a.exponent + b.exponent);
+}
+
+calc_number_t calc_number_divide(calc_number_t a, calc_number_t b) {
+    if (calc_number_is_nan(a) || calc_number_is_nan(b)) return CALC_NUMBER_NAN;
+    if (is_special(a)) {
+        if (is_special(b)) return CALC_NUMBER_NAN;
+        return infinity((a.mantissa < 0) != (b.mantissa < 0));
+    }
+    if (is_special(b)) return CALC_NUMBER_ZERO;
+    if (b.mantissa == 0) return a.mantissa == 0 ? CALC_NUMBER_NAN : infinity(a.mantissa < 0);
+    if (a.mantissa == 0) return CALC_NUMBER_ZERO;
+
+    int64_t quotient = divide_rounded((int64_t)a.mantissa * (int64_t)powers_of_ten[CALC_NUMBER_DIGITS],
+                                      b.mantissa < 0 ? -b.mantissa : b.mantissa);
+    if (b.mantissa < 0) quotient = -quotient;
+    return normalize(quotient, (int32_t)a.exponent - b.exponent - CALC_NUMBER_DIGITS);
+}
+
+calc_number_t calc_number_floor(calc_number_t x) {
+    if (is_special(x) || x.mantissa == 0 || x.exponent >= 0) return x;
+    if (x.exponent <= -CALC_NUMBER_DIGITS) return x.mantissa < 0 ? calc_number_negate(one) : CALC_NUMBER_ZERO;
+    int32_t divisor = powers_of_ten[-x.exponent];
+    int32_t whole = x.mantissa / divisor;
+    if (x.mantissa < 0 && whole * divisor != x.mantissa) whole--;
+    return normalize(whole, 0);
+}
+
+calc_number_t calc_number_sqrt(calc_number_t x) {
+    if (calc_number_is_nan(x) || x.mantissa < 0) return CALC_NUMBER_NAN;
+    if (is_special(x) || x.mantissa == 0) return x;
+
+    // give the root nine digits to work with: eighteen or so under it, and an even power of ten.
+    int32_t exponent = x.exponent;
+    uint64_t square = x.mantissa;
+    if (exponent & 1) {
+        square *= 10;
+        exponent--;
+    }
+    square *= powers_of_ten[8];
+    exponent -= 8;
+
+    // digit by digit, in binary.
+    uint64_t root = 0;
+    uint64_t bit = 1ULL << 62;
+    while (bit > square) bit >>= 2;
+    while (bit) {
+        if (square >= root + bit) {
+            square -= root + bit;
+            root = (root >> 1) + bit;
+        } else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+    // what's left is the square less root²; round up if it's more than root.
+    if (square > root) root++;
+    return normalize(root, exponent / 2);
+}
+
+// ln f, for f from 1 to 2: how many of each factor 1 + 2^-i it takes to make f, with their logarithms added up.
+static int32_t fixed_ln(int32_t f) {
+    int32_t product = ONE;
+    int32_t result = 0;
+    for (uint8_t i = 1; i <= FRACTION_BITS; i++) {
+        while (product + (product >> i) <= f) {
+            product += product >> i;
+            result += ln_step(i);
+        }
+    }
+    return result;
+}
+
+// ln of the digits of x, as a number from 1 to 10, in fixed point; x must be positive and finite.
+static int32_t fixed_ln_of_digits(calc_number_t x) {
+    uint32_t first = powers_of_ten[CALC_NUMBER_DIGITS - 1];
+    uint8_t halvings = 0;
+    while ((uint32_t)x.mantissa >= first << (halvings + 1)) halvings++;
+    int32_t f = (int64_t)x.mantissa * ONE / (first << halvings);
+    return fixed_ln(f) + halvings * FIXED_LN2;
+}
+
+calc_number_t calc_number_ln(calc_number_t x) {
+    if (calc_number_is_nan(x) || x.mantissa < 0) return CALC_NUMBER_NAN;
+    if (is_special(x)) return x;
+    if (x.mantissa == 0) return infinity(true);
+    calc_number_t difference = calc_number_subtract(x, one);
+    if (calc_number_compare(calc_number_abs(difference), near_one) < 0) {
+        // close to 1, where the logarithm is close to 0, fixed point would lose its digits: ln x is 2 atanh u, with
+        // u = (x - 1) / (x + 1), and atanh u = u + u³/3 + u⁵/5 + ..., of which three terms are enough here.
+        calc_number_t u = calc_number_divide(difference, calc_number_add(x, one));
+        calc_number_t u5 = calc_number_multiply(calc_number_multiply(u, u), calc_number_multiply(u, u));
+        u5 = calc_number_divide(calc_number_multiply(u5, u), five);
+        calc_number_t atanh = calc_number_add(series(u, three), u5);
+        return calc_number_add(atanh, atanh);
+    }
+    int32_t magnitude = x.exponent + CALC_NUMBER_DIGITS - 1;
+    return subtract_multiple(from_fixed(fixed_ln_of_digits(x)), -magnitude, ln10, ln10_low);
+}
+
+calc_number_t calc_number_log10(calc_number_t x) {
+    if (calc_number_is_nan(x) || x.mantissa < 0) return CALC_NUMBER_NAN;
+    if (is_special(x)) return x;
+    if (x.mantissa == 0) return infinity(true);
+    if (calc_number_compare(calc_number_abs(calc_number_subtract(x, one)), near_one) < 0) {
+        return calc_number_divide(calc_number_ln(x), ln10);
+    }
+    int32_t magnitude = x.exponent + CALC_NUMBER_DIGITS - 1;
+    calc_number_t result = calc_number_divide(from_fixed(fixed_ln_of_digits(x)), ln10);
+    return calc_number_add(result, normalize(magnitude, 0));
+}
+
+calc_number_t calc_number_exp(calc_number_t x) {
+    if (calc_number_is_nan(x)) return x;
+    if (is_special(x)) return x.mantissa > 0 ? x : CALC_NUMBER_ZERO;
+    if (x.mantissa == 0) return one;
+
+    // e^x = e^r × 10^k, with k the whole number of ln 10s in x.
+    int32_t k;
+    if (!calc_number_to_int(calc_number_floor(calc_number_divide(x, ln10)), 0, &k) ||
+        k > CALC_NUMBER_MAX_EXPONENT + 1 || k < -CALC_NUMBER_MAX_EXPONENT - 2) {
+        return x.mantissa > 0 ? infinity(false) : CALC_NUMBER_ZERO;
+    }
+    int32_t r = to_fixed(subtract_multiple(x, k, ln10, ln10_low));
+    if (r < 0) r = 0;
+
+    // then e^r = 2^doublings × e^(what's left), and that's a product of factors 1 + 2^-i, whose logarithms add up to it.
+    uint8_t doublings = 0;
+    while (r >= FIXED_LN2) {
+        r -= FIXED_LN2;
+        doublings++;
+    }
+    int64_t result = ONE;
+    for (uint8_t i = 1; i <= FRACTION_BITS; i++) {
+        int32_t step = ln_step(i);
+        while (r >= step) {
+            r -= step;
+            result += result >> i;
+        }
+    }
+    result += (result * r) >> FRACTION_BITS;
+
+    calc_number_t digits = from_fixed(result << doublings);
+    return normalize(digits.mantissa, (int32_t)digits.exponent + k);
+}
+
+// a magnitude with twice the digits, seventeen or eighteen of them, for whole powers to carry from one multiply to the
+// next, so that they're only rounded to nine at the end.
+typedef struct {
+    uint64_t mantissa;      // from 10^17 to 10^18
+    int32_t exponent;
+} wide_number_t;
+
+#define WIDE_DIGITS (2 * CALC_NUMBER_DIGITS)
+
+static wide_number_t wide_multiply(wide_number_t a, wide_number_t b) {
+    // in halves of nine digits each, as the whole product runs to thirty-six, and keep the top eighteen of those.
+    uint64_t a_high = a.mantissa / powers_of_ten[CALC_NUMBER_DIGITS];
+    uint64_t a_low = a.mantissa % powers_of_ten[CALC_NUMBER_DIGITS];
+    uint64_t b_high = b.mantissa / powers_of_ten[CALC_NUMBER_DIGITS];
+    uint64_t b_low = b.mantissa % powers_of_ten[CALC_NUMBER_DIGITS];
+    uint64_t middle = a_high * b_low + a_low * b_high + a_low * b_low / powers_of_ten[CALC_NUMBER_DIGITS];
+    wide_number_t product = {
+        a_high * b_high + (middle + powers_of_ten[CALC_NUMBER_DIGITS] / 2) / powers_of_ten[CALC_NUMBER_DIGITS],
+        a.exponent + b.exponent + WIDE_DIGITS
+    };
+    if (product.mantissa >= powers_of_ten[WIDE_DIGITS]) {
+        product.mantissa = (product.mantissa + 5) / 10;
+        product.exponent++;
+    } else if (product.mantissa < powers_of_ten[WIDE_DIGITS - 1]) {
+        product.mantissa *= 10;
+        product.exponent--;
+    }
+    return product;
+}
+
+static wide_number_t wide_reciprocal(wide_number_t x) {
+    // long division of 10^35 by the mantissa, a digit at a time.
+    uint64_t remainder = powers_of_ten[WIDE_DIGITS];
+    uint64_t quotient = remainder / x.mantissa;
+    remainder %= x.mantissa;
+    for (uint8_t i = 1; i < WIDE_DIGITS; i++) {
+        remainder *= 10;
+        quotient = quotient * 10 + remainder / x.mantissa;
+        remainder %= x.mantissa;
+    }
+    if (remainder * 2 >= x.mantissa) quotient++;
+    return (wide_number_t){ quotient, -x.exponent - 2 * WIDE_DIGITS + 1 };
+}
+
+// a to the power of n, for a finite and not zero, by squaring and multiplying.
+static calc_number_t whole_power(calc_number_t a, int32_t n) {
+    wide_number_t result = { powers_of_ten[WIDE_DIGITS - 1], 1 - WIDE_DIGITS };
+    wide_number_t square = {
+        (uint64_t)(a.mantissa < 0 ? -a.mantissa : a.mantissa) * powers_of_ten[CALC_NUMBER_DIGITS],
+        (int32_t)a.exponent - CALC_NUMBER_DIGITS
+    };
+    uint32_t bits = n < 0 ? -(uint32_t)n : (uint32_t)n;
+    bool negative = a.mantissa < 0 && (bits & 1);
+    while (bits) {
+        if (bits & 1) result = wide_multiply(result, square);
+        bits >>= 1;
+        if (!bits) break;
+        square = wide_multiply(square, square);
+        if (square.exponent > 3 * CALC_NUMBER_MAX_EXPONENT || square.exponent < -3 * CALC_NUMBER_MAX_EXPONENT) {
+            // the result will take in this square or a larger one yet, and be out of range one way or the other.
+            bool large = (square.exponent > 0) == (n > 0);
+            return normalize(negative ? -1 : 1, large ? 3 * CALC_NUMBER_MAX_EXPONENT : -3 * CALC_NUMBER_MAX_EXPONENT);
+        }
+    }
+    if (n < 0) result = wide_reciprocal(result);
+    return normalize(negative ? -(int64_t)result.mantissa : (int64_t)result.mantissa, result.exponent);
+}
+
+calc_number_t calc_number_pow(calc_number_t a, calc_number_t b) {
+    if (calc_number_is_zero(b)) return one;
+    if (calc_number_is_nan(a) || calc_number_is_nan(b)) return CALC_NUMBER_NAN;
+
+    int32_t n;
+    if (calc_number_is_integer(b) && calc_number_to_int(b, 0, &n)) {
+        if (!is_special(a) && a.mantissa != 0) return whole_power(a, n);
+        // zero and the infinities, which multiply out exactly.
+        calc_number_t result = one;
+        calc_number_t square = a;
+        uint32_t bits = n < 0 ? -(uint32_t)n : (uint32_t)n;
+        while (bits) {
+            if (bits & 1) result = calc_number_multiply(result, square);
+            bits >>= 1;
+            if (bits) square = calc_number_multiply(square, square);
+        }
+        return n < 0 ? calc_number_divide(one, result) : result;
+    }
+
+    if (a.mantissa == 0) return b.mantissa < 0 ? infinity(false) : CALC_NUMBER_ZERO;
+    if (a.mantissa < 0) return CALC_NUMBER_NAN;
+    return calc_number_exp(calc_number_multiply(b, calc_number_ln(a)));
+}
+
+// sin and cos of an angle from -π/4 to π/4, by rotating (1, 0) by each of the angles atan(2^-i) in turn, one way or
+// the other, until the angle's used up.
+static void fixed_sin_cos(int32_t angle, int32_t *sin, int32_t *cos) {
+    int32_t x = CORDIC_GAIN;
+    int32_t y = 0;
+    for (uint8_t i = 0; i <= FRACTION_BITS; i++) {
+        int32_t dx = y >> i;
+        int32_t dy = x >> i;
+        if (angle >= 0) {
+            x -= dx;
+            y += dy;
+            angle -= atan_step(i);
+        } else {
+            x += dx;
+            y -= dy;
+            angle += atan_step(i);
+        }
+    }
+    *sin = y;
+    *cos = x;
+}
+
+// atan t, for t from -1 to 1, by rotating (1, t) back to the x axis and adding up the angles it took.
+static int32_t fixed_atan(int32_t t) {
+    int32_t x = ONE;
+    int32_t y = t;
+    int32_t angle = 0;
+    for (uint8_t i = 0; i <= FRACTION_BITS && y != 0; i++) {
+        int32_t dx = y >> i;
+        int32_t dy = x >> i;
+        if (y > 0) {
+            x += dx;
+            y -= dy;
+            angle += atan_step(i);
+        } else {
+            x -= dx;
+            y += dy;
+            angle -= atan_step(i);
+        }
+    }
+    return angle;
+}
+
+typedef struct {
+    uint8_t quadrant;       // the number of quarter turns taken off, mod 4
+    calc_number_t rest;     // and the angle left, from -π/4 to π/4, in radians
+    int32_t fixed;          // which in fixed point is
+} reduced_angle_t;
+
+static bool reduce_angle(calc_number_t x, bool degrees, reduced_angle_t *reduced) {
+    calc_number_t quarter = degrees ? ninety : half_pi;
+    calc_number_t turns = calc_number_floor(calc_number_add(calc_number_divide(x, quarter), half));
+    int32_t quadrant;
+    if (!calc_number_to_int(turns, 0, &quadrant)) return false;
+    calc_number_t rest = subtract_multiple(x, quadrant, degrees ? ninety : half_pi_high,
+                                           degrees ? CALC_NUMBER_ZERO : half_pi_low);
+    if (degrees) rest = calc_number_multiply(rest, radians_per_degree);
+    // an angle so large that the rounding of the quarter turns left more than one behind has no sensible sine.
+    if (calc_number_compare(calc_number_abs(rest), one) > 0) return false;
+    reduced->quadrant = quadrant & 3;
+    reduced->rest = rest;
+    reduced->fixed = to_fixed(rest);
+    return true;
+}
+
+static calc_number_t reduced_sin(reduced_angle_t *reduced, int32_t sin) {
+    if (reduced->fixed > -SMALL_ANGLE && reduced->fixed < SMALL_ANGLE) return series(reduced->rest, calc_number_negate(six));
+    return from_fixed(sin);
+}
+
+static calc_number_t reduced_cos(reduced_angle_t *reduced, int32_t cos) {
+    if (reduced->fixed == 0) return one;
+    return from_fixed(cos);
+}
+
+static calc_number_t sin_or_cos(calc_number_t x, bool degrees, bool cosine) {
+    reduced_angle_t reduced;
+    if (!reduce_angle(x, degrees, &reduced)) return CALC_NUMBER_NAN;
+    int32_t sin, cos;
+    fixed_sin_cos(reduced.fixed, &sin, &cos);
+    // cos x is sin(x + a quarter turn).
+    switch ((reduced.quadrant + cosine) & 3) {
+        case 0: return reduced_sin(&reduced, sin);
+        case 1: return reduced_cos(&reduced, cos);
+        case 2: return calc_number_negate(reduced_sin(&reduced, sin));
+        default: return calc_number_negate(reduced_cos(&reduced, cos));
+    }
+}
+
+calc_number_t calc_number_sin(calc_number_t x, bool degrees) {
+    return sin_or_cos(x, degrees, false);
+}
+
+calc_number_t calc_number_cos(calc_number_t x, bool degrees) {
+    return sin_or_cos(x, degrees, true);
+}
+
+calc_number_t calc_number_tan(calc_number_t x, bool degrees) {
+    reduced_angle_t reduced;
+    if (!reduce_angle(x, degrees, &reduced)) return CALC_NUMBER_NAN;
+    int32_t sin, cos;
+    fixed_sin_cos(reduced.fixed, &sin, &cos);
+    calc_number_t sine = reduced_sin(&reduced, sin);
+    calc_number_t cosine = reduced_cos(&reduced, cos);
+    if (reduced.quadrant & 1) {
+        // tan(x + a quarter turn) is -1 / tan x.
+        if (sine.mantissa == 0) return infinity(false);
+        return calc_number_negate(calc_number_divide(cosine, sine));
+    }
+    return calc_number_divide(sine, cosine);
+}
+
+static calc_number_t atan_radians(calc_number_t x) {
+    if (calc_number_is_nan(x)) return x;
+    if (is_special(x)) return x.mantissa < 0 ? calc_number_negate(half_pi) : half_pi;
+    if (calc_number_compare(calc_number_abs(x), one) > 0) {
+        // atan x is a quarter turn less atan(1 / x).
+        calc_number_t quarter = x.mantissa < 0 ? calc_number_negate(half_pi) : half_pi;
+        return calc_number_subtract(quarter, atan_radians(calc_number_divide(one, x)));
+    }
+    int32_t t = to_fixed(x);
+    if (t > -SMALL_ANGLE && t < SMALL_ANGLE) return series(x, calc_number_negate(three));
+    return from_fixed(fixed_atan(t));
+}
+
+static calc_number_t asin_radians(calc_number_t x) {
+    int8_t order = calc_number_compare(calc_number_abs(x), one);
+    if (calc_number_is_nan(x) || order > 0) return CALC_NUMBER_NAN;
+    if (order == 0) return x.mantissa < 0 ? calc_number_negate(half_pi) : half_pi;
+    // asin x is atan(x / sqrt(1 - x²)).
+    calc_number_t cosine = calc_number_sqrt(calc_number_subtract(one, calc_number_multiply(x, x)));
+    return atan_radians(calc_number_divide(x, cosine));
+}
+
+static calc_number_t in_units(calc_number_t radians, bool degrees) {
+    return degrees ? calc_number_to_degrees(radians) : radians;
+}
+
+calc_number_t calc_number_asin(calc_number_t x, bool degrees) {
+    return in_units(asin_radians(x), degrees);
+}
+
+calc_number_t calc_number_acos(calc_number_t x, bool degrees) {
+    return in_units(calc_number_subtract(half_pi, asin_radians(x)), degrees);
+}
+
+calc_number_t calc_number_atan(calc_number_t x, bool degrees) {
+    return in_units(atan_radians(x), degrees);
+}
+
+calc_number_t calc_number_atan2(calc_number_t y, calc_number_t x, bool degrees) {
+    if (calc_number_is_nan(x) || calc_number_is_nan(y)) return CALC_NUMBER_NAN;
+    calc_number_t result;
+    if (calc_number_is_zero(x)) {
+        if (calc_number_is_zero(y)) result = CALC_NUMBER_ZERO;
+        else result = y.mantissa < 0 ? calc_number_negate(half_pi) : half_pi;
+    } else {
+        result = atan_radians(calc_number_divide(y, x));
+        if (x.mantissa < 0) {
+            result = y.mantissa < 0 ? calc_number_subtract(result, CALC_NUMBER_PI)
+                                    : calc_number_add(result, CALC_NUMBER_PI);
+        }
+    }
+    return in_units(result, degrees);
+}
+
+calc_number_t calc_number_to_radians(calc_number_t degrees) {
+    return calc_number_multiply(degrees, radians_per_degree);
+}
+
+calc_number_t calc_number_to_degrees(calc_number_t radians) {
+    return calc_number_multiply(radians, degrees_per_radian);
+}
@@ -0,0 +1,131 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CALC_NUMBER_H_
+#define CALC_NUMBER_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * The numbers the calculator faces work with: nine significant decimal digits and a power of ten, in integers only.
+ *
+ * The SAM L22 has no floating point unit, so float and double arithmetic is emulated in software, and sinf, powf and
+ * friends pull a good deal of libm into the firmware. A calculator only ever shows a handful of digits, so this keeps
+ * them in decimal instead: arithmetic is a 64-bit multiply or divide and some scaling by powers of ten, numbers go to
+ * and from the display without any conversion error, and 0.1 + 0.2 is 0.3. The functions (sqrt, exp, ln, log10, pow,
+ * and the trigonometric ones) work in 2.29 fixed point, with shift-and-add (CORDIC) loops over two small tables of
+ * arctangents and logarithms. That fixed point leaves an error of a few parts in 10^8 of the whole, not of the result,
+ * so they're good to fewer digits than the numbers hold, and fewer again where the result is small: sqrt to about
+ * eight, exp to seven and a half, ln and log10 to six and a half, the trigonometric functions and their inverses to
+ * five and a half (at their worst, for angles and ratios of about 0.008), and pow to six, or five where the result
+ * runs to hundreds of digits. Whole-number powers are the exception, good to all nine.
+ *
+ * A number is normalized: its mantissa is zero, or has exactly nine digits. NaN and the infinities are kept apart with
+ * an exponent of CALC_NUMBER_SPECIAL, so that they carry through calculations the way IEEE floats' do. Anything with
+ * a magnitude of 1e1000 or more overflows to infinity; anything under 1e-1000 is zero.
+ */
+
+typedef struct {
+    int32_t mantissa;   // zero, or nine digits and a sign
+    int16_t exponent;   // the number is mantissa × 10^exponent
+} calc_number_t;
+
+#define CALC_NUMBER_DIGITS 9
+#define CALC_NUMBER_MAX_EXPONENT 999
+#define CALC_NUMBER_SPECIAL INT16_MAX
+
+#define CALC_NUMBER_ZERO ((calc_number_t){ 0, 0 })
+#define CALC_NUMBER_NAN ((calc_number_t){ 0, CALC_NUMBER_SPECIAL })
+#define CALC_NUMBER_INFINITY ((calc_number_t){ 1, CALC_NUMBER_SPECIAL })
+#define CALC_NUMBER_PI ((calc_number_t){ 314159265, -8 })
+#define CALC_NUMBER_E ((calc_number_t){ 271828183, -8 })
+
+/** @brief Returns value × 10^exponent. */
+calc_number_t calc_number_from_int(int32_t value, int16_t exponent);
+
+/** @brief Rounds x to a number of decimal places, as an integer (so 2.345 to two places is 235).
+  * @return false if x is NaN or infinite, or the result doesn't fit an int32_t.
+  */
+bool calc_number_to_int(calc_number_t x, uint8_t decimals, int32_t *value);
+
+/** @brief Rounds x to a number of significant digits, for display.
+  * @param significant From 1 to 9.
+  * @param magnitude Set to the power of ten of the first digit, after rounding.
+  * @return The digits, as an integer: 4.2e-3 to four digits is 4200, with a magnitude of -3. Zero is 0, with a
+  *         magnitude of 0. The sign is dropped; NaN and the infinities give 0, so check for those first.
+  */
+uint32_t calc_number_digits(calc_number_t x, uint8_t significant, int16_t *magnitude);
+
+/** @brief Reads a number written the usual way, like "42", "-0.5" or "4.2e-3", which has to take up the whole string.
+  * @return false, leaving x alone, if the string isn't a number.
+  */
+bool calc_number_parse(const char *str, calc_number_t *x);
+
+bool calc_number_is_nan(calc_number_t x);
+bool calc_number_is_infinite(calc_number_t x);
+bool calc_number_is_zero(calc_number_t x);
+bool calc_number_is_negative(calc_number_t x);
+/** @brief Whether x is a whole number (NaN and the infinities aren't). */
+bool calc_number_is_integer(calc_number_t x);
+
+/** @brief Returns -1, 0 or 1 as a is less than, equal to or greater than b; NaN is unordered, and compares equal to
+  *        everything.
+  */
+int8_t calc_number_compare(calc_number_t a, calc_number_t b);
+
+calc_number_t calc_number_negate(calc_number_t x);
+calc_number_t calc_number_abs(calc_number_t x);
+calc_number_t calc_number_add(calc_number_t a, calc_number_t b);
+calc_number_t calc_number_subtract(calc_number_t a, calc_number_t b);
+calc_number_t calc_number_multiply(calc_number_t a, calc_number_t b);
+calc_number_t calc_number_divide(calc_number_t a, calc_number_t b);
+/** @brief Returns the largest whole number no greater than x. */
+calc_number_t calc_number_floor(calc_number_t x);
+
+calc_number_t calc_number_sqrt(calc_number_t x);
+calc_number_t calc_number_exp(calc_number_t x);
+calc_number_t calc_number_ln(calc_number_t x);
+calc_number_t calc_number_log10(calc_number_t x);
+/** @brief Returns a to the power of b. When b is a whole number, that's by repeated multiplication with eighteen
+  *        digits, rounded to nine only at the end.
+  */
+calc_number_t calc_number_pow(calc_number_t a, calc_number_t b);
+
+/** @brief The trigonometric functions, in radians, or in degrees if degrees is true. In degrees, angles are reduced
+  *        to a quarter turn exactly, so sin(180°) is 0 and tan(90°) infinite; in radians they're reduced by a
+  *        nine-digit π/2, so precision falls off as angles get larger.
+  */
+calc_number_t calc_number_sin(calc_number_t x, bool degrees);
+calc_number_t calc_number_cos(calc_number_t x, bool degrees);
+calc_number_t calc_number_tan(calc_number_t x, bool degrees);
+calc_number_t calc_number_asin(calc_number_t x, bool degrees);
+calc_number_t calc_number_acos(calc_number_t x, bool degrees);
+calc_number_t calc_number_atan(calc_number_t x, bool degrees);
+/** @brief Returns the angle of the point (x, y) from the x axis, from -π to π. */
+calc_number_t calc_number_atan2(calc_number_t y, calc_number_t x, bool degrees);
+calc_number_t calc_number_to_radians(calc_number_t degrees);
+calc_number_t calc_number_to_degrees(calc_number_t radians);
+
+#endif // CALC_NUMBER_H_
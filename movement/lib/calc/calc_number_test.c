@@ -0,0 +1,63 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+// Checks calc_number's results against ones worked out exactly and rounded to nine digits; make calc-test in
+// movement/make builds and runs it on this machine.
+
+#include <stdio.h>
+#include "calc_number.h"
+
+typedef struct {
+    calc_number_t a;
+    calc_number_t b;
+    calc_number_t expected;
+} calc_number_test_t;
+
+static const calc_number_test_t pow_tests[] = {
+    // 3^30 = 205891132094649.
+    { { 300000000, -8 }, { 300000000, -7 }, { 205891132, 6 } },
+    // 7^40 = 6366805760909027985741435139224001, where rounding each square to nine digits comes to 636680579e25.
+    { { 700000000, -8 }, { 400000000, -7 }, { 636680576, 25 } },
+    { { 110000000, -8 }, { 200000000, -6 }, { 189905276, 0 } },
+    { { 123456789, -8 }, { 100000000, -6 }, { 141741726, 1 } },
+    { { 200000000, -8 }, { -300000000, -7 }, { 931322575, -18 } },
+    { { -200000000, -8 }, { 300000000, -8 }, { -800000000, -8 } },
+    { { 200000000, -8 }, { 100000000, 0 }, { 1, CALC_NUMBER_SPECIAL } },
+    { { 200000000, -8 }, { -100000000, 0 }, { 0, 0 } },
+};
+
+int main(void) {
+    int failures = 0;
+    for (size_t i = 0; i < sizeof(pow_tests) / sizeof(pow_tests[0]); i++) {
+        const calc_number_test_t *test = &pow_tests[i];
+        calc_number_t result = calc_number_pow(test->a, test->b);
+        if (result.mantissa != test->expected.mantissa || result.exponent != test->expected.exponent) {
+            printf("pow(%de%d, %de%d) = %de%d, expected %de%d\n", (int)test->a.mantissa, test->a.exponent,
+                   (int)test->b.mantissa, test->b.exponent, (int)result.mantissa, result.exponent,
+                   (int)test->expected.mantissa, test->expected.exponent);
+            failures++;
+        }
+    }
+    return failures ? 1 : 0;
+}
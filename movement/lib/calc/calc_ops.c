@@ -0,0 +1,99 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "calc_ops.h"
+
+typedef struct {
+    uint8_t inputs;
+    uint8_t outputs;
+} calc_op_arity_t;
+
+// the operations are listed in calc_op_t grouped by how many numbers they take and leave.
+static calc_op_arity_t calc_op_arity(calc_op_t op) {
+    if (op <= CALC_OP_ATAN2_DEGREES) return (calc_op_arity_t){ 2, 1 };
+    if (op <= CALC_OP_TO_DEGREES) return (calc_op_arity_t){ 1, 1 };
+    if (op <= CALC_OP_SIZE) return (calc_op_arity_t){ 0, 1 };
+    switch (op) {
+        case CALC_OP_DROP: return (calc_op_arity_t){ 1, 0 };
+        case CALC_OP_SWAP: return (calc_op_arity_t){ 2, 2 };
+        case CALC_OP_DUPLICATE: return (calc_op_arity_t){ 1, 2 };
+        default: return (calc_op_arity_t){ 0, 0 };
+    }
+}
+
+int8_t calc_op_run(calc_op_t op, calc_number_t *stack, uint8_t *size, uint8_t capacity) {
+    if (op >= CALC_OP_COUNT) return CALC_OP_STACK_ERROR;
+    calc_op_arity_t arity = calc_op_arity(op);
+    if (*size < arity.inputs || *size - arity.inputs + arity.outputs > capacity) return CALC_OP_STACK_ERROR;
+
+    // the operation's inputs, deepest first, and where its outputs go.
+    calc_number_t *x = &stack[*size - arity.inputs];
+    calc_number_t a = arity.inputs > 0 ? x[0] : CALC_NUMBER_ZERO;
+    calc_number_t b = arity.inputs > 1 ? x[1] : CALC_NUMBER_ZERO;
+
+    switch (op) {
+        case CALC_OP_ADD: x[0] = calc_number_add(a, b); break;
+        case CALC_OP_SUBTRACT: x[0] = calc_number_subtract(a, b); break;
+        case CALC_OP_MULTIPLY: x[0] = calc_number_multiply(a, b); break;
+        case CALC_OP_DIVIDE: x[0] = calc_number_divide(a, b); break;
+        case CALC_OP_POW: x[0] = calc_number_pow(a, b); break;
+        case CALC_OP_ATAN2: x[0] = calc_number_atan2(a, b, false); break;
+        case CALC_OP_ATAN2_DEGREES: x[0] = calc_number_atan2(a, b, true); break;
+        case CALC_OP_NEGATE: x[0] = calc_number_negate(a); break;
+        case CALC_OP_INVERT: x[0] = calc_number_divide(calc_number_from_int(1, 0), a); break;
+        case CALC_OP_SQRT: x[0] = calc_number_sqrt(a); break;
+        case CALC_OP_EXP: x[0] = calc_number_exp(a); break;
+        case CALC_OP_LN: x[0] = calc_number_ln(a); break;
+        case CALC_OP_LOG10: x[0] = calc_number_log10(a); break;
+        case CALC_OP_SIN: x[0] = calc_number_sin(a, false); break;
+        case CALC_OP_COS: x[0] = calc_number_cos(a, false); break;
+        case CALC_OP_TAN: x[0] = calc_number_tan(a, false); break;
+        case CALC_OP_ASIN: x[0] = calc_number_asin(a, false); break;
+        case CALC_OP_ACOS: x[0] = calc_number_acos(a, false); break;
+        case CALC_OP_ATAN: x[0] = calc_number_atan(a, false); break;
+        case CALC_OP_SIN_DEGREES: x[0] = calc_number_sin(a, true); break;
+        case CALC_OP_COS_DEGREES: x[0] = calc_number_cos(a, true); break;
+        case CALC_OP_TAN_DEGREES: x[0] = calc_number_tan(a, true); break;
+        case CALC_OP_ASIN_DEGREES: x[0] = calc_number_asin(a, true); break;
+        case CALC_OP_ACOS_DEGREES: x[0] = calc_number_acos(a, true); break;
+        case CALC_OP_ATAN_DEGREES: x[0] = calc_number_atan(a, true); break;
+        case CALC_OP_TO_RADIANS: x[0] = calc_number_to_radians(a); break;
+        case CALC_OP_TO_DEGREES: x[0] = calc_number_to_degrees(a); break;
+        case CALC_OP_PI: x[0] = CALC_NUMBER_PI; break;
+        case CALC_OP_E: x[0] = CALC_NUMBER_E; break;
+        case CALC_OP_SIZE: x[0] = calc_number_from_int(*size, 0); break;
+        case CALC_OP_DROP: break;
+        case CALC_OP_SWAP:
+            x[0] = b;
+            x[1] = a;
+            break;
+        case CALC_OP_DUPLICATE: x[1] = a; break;
+        case CALC_OP_CLEAR:
+            *size = 0;
+            return 0;
+        default: break;
+    }
+    *size = *size - arity.inputs + arity.outputs;
+    return 0;
+}
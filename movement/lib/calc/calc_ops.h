@@ -0,0 +1,89 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef CALC_OPS_H_
+#define CALC_OPS_H_
+
+#include "calc_number.h"
+
+/*
+ * The operations the calculator faces share, on an RPN stack of calc_number_t that each face keeps for itself: an
+ * array, how many numbers are on it, and how many it can hold, with the top of the stack last. Each face decides how
+ * to name them on the display and which to offer.
+ */
+
+typedef enum {
+    // two numbers in, one out: the one under the top of the stack, then the top
+    CALC_OP_ADD = 0,
+    CALC_OP_SUBTRACT,
+    CALC_OP_MULTIPLY,
+    CALC_OP_DIVIDE,
+    CALC_OP_POW,
+    CALC_OP_ATAN2,          // atan2(under the top, top), as atan2(y, x)
+    CALC_OP_ATAN2_DEGREES,
+    // one in, one out
+    CALC_OP_NEGATE,
+    CALC_OP_INVERT,
+    CALC_OP_SQRT,
+    CALC_OP_EXP,
+    CALC_OP_LN,
+    CALC_OP_LOG10,
+    CALC_OP_SIN,
+    CALC_OP_COS,
+    CALC_OP_TAN,
+    CALC_OP_ASIN,
+    CALC_OP_ACOS,
+    CALC_OP_ATAN,
+    CALC_OP_SIN_DEGREES,
+    CALC_OP_COS_DEGREES,
+    CALC_OP_TAN_DEGREES,
+    CALC_OP_ASIN_DEGREES,
+    CALC_OP_ACOS_DEGREES,
+    CALC_OP_ATAN_DEGREES,
+    CALC_OP_TO_RADIANS,
+    CALC_OP_TO_DEGREES,
+    // none in, one out
+    CALC_OP_PI,
+    CALC_OP_E,
+    CALC_OP_SIZE,           // pushes how many numbers were on the stack
+    // stack manipulation
+    CALC_OP_DROP,
+    CALC_OP_SWAP,
+    CALC_OP_DUPLICATE,
+    CALC_OP_CLEAR,
+    CALC_OP_COUNT
+} calc_op_t;
+
+#define CALC_OP_STACK_ERROR -2
+
+/** @brief Runs an operation on a stack.
+  * @param stack The numbers, with the top of the stack last.
+  * @param size How many numbers are on it; updated.
+  * @param capacity How many numbers it can hold.
+  * @return 0, or CALC_OP_STACK_ERROR, leaving the stack alone, if it doesn't have the numbers the operation takes or
+  *         room for the ones it leaves.
+  */
+int8_t calc_op_run(calc_op_t op, calc_number_t *stack, uint8_t *size, uint8_t capacity);
+
+#endif // CALC_OPS_H_
@@ -0,0 +1,114 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdint.h>
+#include "ephemeris.h"
+#include "ephemeris_table.h"
+
+typedef struct {
+    const uint32_t *packed;
+    const int32_t *base;
+    const uint8_t *bits;
+    float quantum;
+    uint16_t segment_bits;
+    uint16_t segment_days;
+    uint16_t num_segments;
+    uint8_t num_coefficients;
+} ephemeris_series_t;
+
+#define EPHEMERIS_SERIES(name, table) { table, &table##_Base[0][0], &table##_Bits[0][0], EPHEMERIS_##name##_QUANTUM, EPHEMERIS_##name##_SEGMENT_BITS, EPHEMERIS_##name##_SEGMENT_DAYS, EPHEMERIS_##name##_NUM_SEGMENTS, EPHEMERIS_##name##_NUM_COEFFICIENTS }
+
+// the Earth and the Moon aren't fitted directly; they're rebuilt from the barycenter and the Moon's geocentric position.
+static const ephemeris_series_t _ephemeris_series[] = {
+    [EPHEMERIS_BODY_MERCURY] = EPHEMERIS_SERIES(MERCURY, Ephemeris_Mercury),
+    [EPHEMERIS_BODY_VENUS] = EPHEMERIS_SERIES(VENUS, Ephemeris_Venus),
+    [EPHEMERIS_BODY_MARS] = EPHEMERIS_SERIES(MARS, Ephemeris_Mars),
+    [EPHEMERIS_BODY_JUPITER] = EPHEMERIS_SERIES(JUPITER, Ephemeris_Jupiter),
+    [EPHEMERIS_BODY_SATURN] = EPHEMERIS_SERIES(SATURN, Ephemeris_Saturn),
+    [EPHEMERIS_BODY_URANUS] = EPHEMERIS_SERIES(URANUS, Ephemeris_Uranus),
+    [EPHEMERIS_BODY_NEPTUNE] = EPHEMERIS_SERIES(NEPTUNE, Ephemeris_Neptune),
+    [EPHEMERIS_BODY_EMB] = EPHEMERIS_SERIES(EMB, Ephemeris_Emb),
+    [EPHEMERIS_BODY_MOON] = EPHEMERIS_SERIES(MOON, Ephemeris_Moon),
+};
+
+// reads width bits (at most 32) starting at bit position, least significant bit first.
+static inline uint32_t _ephemeris_read_bits(const uint32_t *packed, uint32_t position, uint8_t width) {
+    if (width == 0) return 0;
+    const uint32_t *word = packed + position / 32;
+    uint8_t shift = position % 32;
+    uint32_t value = word[0] >> shift;
+    if (shift + width > 32) value |= word[1] << (32 - shift);
+    return width == 32 ? value : value & (((uint32_t)1 << width) - 1);
+}
+
+static void _ephemeris_evaluate(const ephemeris_series_t *series, double days, double coords[3]) {
+    int32_t segment = (int32_t)(days / series->segment_days);
+    if (days < 0) segment = 0;
+    if (segment >= series->num_segments) segment = series->num_segments - 1;
+
+    // position within the segment, from -1 to 1. past either end of the table, clamp to the end.
+    float x = (float)((days - (double)segment * series->segment_days) * 2.0 / series->segment_days - 1.0);
+    if (x < -1.0f) x = -1.0f;
+    if (x > 1.0f) x = 1.0f;
+
+    uint32_t position = (uint32_t)segment * series->segment_bits;
+    const int32_t *base = series->base;
+    const uint8_t *bits = series->bits;
+    for (uint8_t axis = 0; axis < 3; axis++) {
+        // each coefficient is stored as a count of quanta above the smallest it gets in any segment.
+        float c[EPHEMERIS_MAX_COEFFICIENTS];
+        for (uint8_t i = 0; i < series->num_coefficients; i++, base++, bits++) {
+            c[i] = (float)(*base + (int32_t)_ephemeris_read_bits(series->packed, position, *bits)) * series->quantum;
+            position += *bits;
+        }
+        // Clenshaw's recurrence: sum of c[i] * T_i(x) without computing the T_i.
+        float b1 = 0, b2 = 0;
+        for (uint8_t i = series->num_coefficients - 1; i > 0; i--) {
+            float b0 = 2.0f * x * b1 - b2 + c[i];
+            b2 = b1;
+            b1 = b0;
+        }
+        coords[axis] = x * b1 - b2 + c[0];
+    }
+}
+
+bool ephemeris_get_body(ephemeris_body_t body, double t, double coords[3]) {
+    double days = t * 365250.0 + 2451545.0 - EPHEMERIS_FIRST_JD;
+    bool in_range = days >= 0 && days <= EPHEMERIS_LAST_JD - EPHEMERIS_FIRST_JD;
+
+    if (body == EPHEMERIS_BODY_EARTH || body == EPHEMERIS_BODY_MOON) {
+        // the Earth sits opposite the Moon around the barycenter, EARTH_MOON_MASS_RATIO as far away.
+        double emb[3], moon[3];
+        _ephemeris_evaluate(&_ephemeris_series[EPHEMERIS_BODY_EMB], days, emb);
+        _ephemeris_evaluate(&_ephemeris_series[EPHEMERIS_BODY_MOON], days, moon);
+        for (uint8_t i = 0; i < 3; i++) {
+            coords[i] = emb[i] - moon[i] / (1 + 1 / EPHEMERIS_EARTH_MOON_MASS_RATIO);
+            if (body == EPHEMERIS_BODY_MOON) coords[i] += moon[i];
+        }
+    } else {
+        _ephemeris_evaluate(&_ephemeris_series[body], days, coords);
+    }
+
+    return in_range;
+}
@@ -0,0 +1,52 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef EPHEMERIS_H_
+#define EPHEMERIS_H_
+
+#include <stdbool.h>
+
+// Heliocentric positions of the planets and the Moon from a table of Chebyshev polynomials fitted to VSOP87A (milli)
+// by utils/gen_ephemeris_table.py. The results match vsop87a_milli_getX to within about an arcsecond as seen from
+// Earth, for a fraction of the cost, but only between EPHEMERIS_FIRST_YEAR and EPHEMERIS_LAST_YEAR in
+// ephemeris_table.h. Bodies are in the same order as in astrolib's astro_body_t, minus the Sun.
+typedef enum {
+    EPHEMERIS_BODY_MERCURY = 0,
+    EPHEMERIS_BODY_VENUS,
+    EPHEMERIS_BODY_EARTH,
+    EPHEMERIS_BODY_MARS,
+    EPHEMERIS_BODY_JUPITER,
+    EPHEMERIS_BODY_SATURN,
+    EPHEMERIS_BODY_URANUS,
+    EPHEMERIS_BODY_NEPTUNE,
+    EPHEMERIS_BODY_EMB,
+    EPHEMERIS_BODY_MOON
+} ephemeris_body_t;
+
+// Gets a body's position in AU, in the same frame as VSOP87A (heliocentric, ecliptic and equinox of J2000).
+// t is in Julian millennia since J2000 (TT), as for vsop87a_milli_getX. Returns false if t is outside the table;
+// coords then holds the position at the nearest end of the table, which is only good as a last resort.
+bool ephemeris_get_body(ephemeris_body_t body, double t, double coords[3]);
+
+#endif // EPHEMERIS_H_
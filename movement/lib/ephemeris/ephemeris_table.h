@@ -0,0 +1,1120 @@
+// This file is generated by utils/gen_ephemeris_table.py from vsop87a_milli.c. Do not edit.
+#ifndef EPHEMERIS_TABLE_H_
+#define EPHEMERIS_TABLE_H_
+
+#include <stdint.h>
+
+// Valid from 0h TT on January 1, 2024 until 0h TT on January 1, 2044.
+#define EPHEMERIS_FIRST_YEAR 2024
+#define EPHEMERIS_LAST_YEAR 2043
+#define EPHEMERIS_FIRST_JD 2460310.5
+#define EPHEMERIS_LAST_JD 2467615.5
+#define EPHEMERIS_EARTH_MOON_MASS_RATIO 0.01230073677
+#define EPHEMERIS_MAX_COEFFICIENTS 18
+
+// 115 segments of 64 days, 18 coefficients per axis, within 2.5e-06 AU of VSOP87; 12634 bytes packed.
+#define EPHEMERIS_MERCURY_SEGMENT_DAYS 64
+#define EPHEMERIS_MERCURY_NUM_SEGMENTS 115
+#define EPHEMERIS_MERCURY_NUM_COEFFICIENTS 18
+#define EPHEMERIS_MERCURY_SEGMENT_BITS 860
+#define EPHEMERIS_MERCURY_QUANTUM 3.47222233e-08f
+static const int32_t Ephemeris_Mercury_Base[3][18] = {
+    { -1647216, -11192363, -9096884, -3056998, -1612217, -814236, -315654, -114494, -65602, -32732, -19473, -8100, -4913, -1465, -1248, -293, -255, -61 },
+    { -4428104, -11991008, -9316515, -4309838, -1071379, -711438, -350495, -148422, -62575, -35322, -15120, -9972, -3846, -2497, -684, -593, -109, -131 },
+    { -325617, -1497626, -1122917, -569569, -185732, -67338, -43421, -21058, -8508, -3922, -2397, -1173, -422, -212, -103, -41, -14, -6 },
+};
+static const uint8_t Ephemeris_Mercury_Bits[3][18] = {
+    { 21, 25, 25, 23, 22, 21, 20, 19, 18, 16, 16, 14, 14, 12, 12, 10, 10, 7 },
+    { 21, 25, 25, 24, 22, 21, 20, 19, 18, 17, 15, 15, 13, 13, 11, 11, 8, 9 },
+    { 18, 22, 22, 20, 19, 18, 17, 16, 15, 14, 12, 12, 10, 9, 8, 7, 5, 4 },
+};
+static const uint32_t Ephemeris_Mercury[3091] = {
+    0xa1a8decd, 0x3ac4ebd1, 0x8211382b, 0xea25c4df, 0x49384abc, 0xfd2f3c67, 0x31b6131c, 0xd36b7f11,
+    0x6012654f, 0x3d924d22, 0x21635381, 0x3a856126, 0x20e64c94, 0x32cc06c9, 0x1e8fa554, 0x83b3bf65,
+    0x6dc78ae8, 0x4a097ba2, 0xe52a1947, 0xbf4fd414, 0x83014094, 0x8eb5e4e1, 0x8a387498, 0x64e30501,
+    0xee767213, 0xe32e9c12, 0x8263b6f4, 0x985c7768, 0x2ea118b6, 0xf9d96444, 0xb9b50744, 0xeabf84d1,
+    0xd714807e, 0x4a24e652, 0xa55baab7, 0x17d58d05, 0x094328c7, 0x40556d07, 0x5db2e380, 0xca74980c,
+    0xc690e3bc, 0x8fb88c59, 0xd4c31c7b, 0x9a4467a2, 0x5c8e5b82, 0x155c3531, 0xbe3f0d68, 0xc1408343,
+    0x7c632c43, 0x2b800012, 0x606f606a, 0x83c9848c, 0xb1bba487, 0x1a9b913d, 0x070b8fd9, 0x8fd26e83,
+    0x94347c42, 0x3d194b06, 0xa880984a, 0x5e256a5e, 0x38000170, 0x0426967b, 0xe611814e, 0xacf989ed,
+    0x12438eb2, 0xe0b40a9a, 0x27e7e818, 0x68050415, 0x8c000010, 0xf1fa259f, 0xe8020647, 0x85735b63,
+    0x37b80833, 0xdb44e230, 0x00e2d6fa, 0xbe254000, 0x75ad2370, 0xf8506696, 0x5ee8f6c8, 0xdb000630,
+    0x9439014b, 0x35e7ffa5, 0x90a37882, 0x9d681713, 0x0ff2226c, 0x61a6d52b, 0x668f8714, 0x1f0ff5da,
+    0x59013297, 0x4bc62172, 0x9593dfc1, 0x645d2b8b, 0x139c674b, 0xac12aa72, 0xbba01fcb, 0x93d6a90a,
+    0x4c9c414e, 0x7b22e773, 0xe4ea8b16, 0xd5305aad, 0x629ad45d, 0xe8619346, 0x656f5e82, 0x40630eeb,
+    0xa7db538b, 0x854fc975, 0x733f2769, 0x16451741, 0x647413a0, 0x94b9f854, 0x89938485, 0x08d94325,
+    0x4162c7b6, 0xfed8f0f5, 0x798538b1, 0x956e9360, 0x5cbb4115, 0x979222b5, 0x85e90a6a, 0x5eaefe75,
+    0x43864eb3, 0x27714335, 0x2829103c, 0xbb67f9d4, 0x76726887, 0xc257e967, 0xc382a28a, 0xf00e20a7,
+    0x04250303, 0x128f40ba, 0x35bb922b, 0x5246948a, 0x8b12ce73, 0x55e8bb34, 0xc3f75a89, 0xc42ee8d6,
+    0x1e0b6e07, 0x082c4711, 0xa228babb, 0x122b3b35, 0xf929c288, 0x805917f1, 0x8cf18176, 0xba9be000,
+    0x057eff2a, 0xd9f83164, 0xc70bc5c0, 0x5b420cce, 0xa2ac1880, 0x163e630a, 0xead83ee9, 0x4029a72c,
+    0x0c5b00dd, 0x969c7780, 0x9f72be66, 0xf3984057, 0x8c58fe0d, 0xeb1bb50f, 0x0028198d, 0x8f258680,
+    0x38b92f0a, 0x32a91d40, 0xb54b2d40, 0x59d102c5, 0x5cfbf361, 0xff98f436, 0x82000001, 0x07dc1541,
+    0x702d4190, 0x2249c1c6, 0x92143966, 0x4e97ed4b, 0x2941a3d4, 0xe5000000, 0x61649287, 0x4e4067cd,
+    0x00000084, 0x7e00c816, 0x8c4323aa, 0xdc1a4fa2, 0x1e413105, 0x939abaf9, 0xc5e8797f, 0x46f6204a,
+    0x17c9de93, 0x1d987866, 0xdd039754, 0xb4940093, 0x315639d1, 0x2caab611, 0x03dd61a1, 0x16595738,
+    0xaafa6c4f, 0x4e140dfe, 0xfc6137d1, 0x2f57c692, 0xdd2b9859, 0x471c90d2, 0xd6cfa85d, 0xb85e7f03,
+    0xc243a5df, 0xa397346f, 0xe0c246cc, 0x273edd51, 0xc87b7691, 0x9e876f27, 0x13a3064e, 0xb8075f44,
+    0x91b62f40, 0xaf148e1e, 0x1c20291b, 0x4b41464e, 0x47b01fc3, 0xbb08dd30, 0xa8165a86, 0x1b212089,
+    0x92f3582d, 0x4c2d00c3, 0x10538484, 0x46719517, 0x38f338d8, 0x57217865, 0x514d8101, 0x395061cb,
+    0x1888e166, 0x00000027, 0x5956abca, 0xb42d749b, 0x9adcebc3, 0xbab134ce, 0xa1d4ba28, 0xd2060708,
+    0x6a006992, 0x3af9a26c, 0xb473f106, 0x79f74174, 0x123b8f98, 0x113aeab1, 0x3407e74a, 0x1894020b,
+    0x838aaacf, 0x1243f7a3, 0x0000e6b1, 0x3d3b6400, 0xb3b099c2, 0x00005234, 0x98d2e180, 0x063ef83e,
+    0xdfb28000, 0x303a2ec1, 0x68ea4440, 0xd69c4241, 0x02ca874e, 0xe4700000, 0xec1d7478, 0x001f8176,
+    0x9acd5800, 0x2ed1827a, 0xc3c00000, 0x6216adc0, 0x04ee4600, 0xa5a648e9, 0x451a6698, 0xc28ca73e,
+    0x0e3d91b6, 0x7f315008, 0x0109c6c6, 0x65790896, 0x3d5ead00, 0xdd08374c, 0x009ecd96, 0x4bccdb26,
+    0x41247a5b, 0xd4eb856b, 0xa4640c19, 0xe57c9592, 0xf356d6ba, 0x89378ac8, 0x68b9b9c9, 0xa7dac3ea,
+    0x1a305151, 0x82082606, 0x4f935609, 0x4da8f544, 0xa4789360, 0xf280e417, 0x4f0d2aab, 0xc6597124,
+    0x1d4a9479, 0x35f50009, 0x07c456f1, 0xb1590f50, 0xd027e816, 0x4a9c62ca, 0x6b345465, 0x2d7b58a6,
+    0xbee8fa94, 0xaaabb23a, 0x2f342029, 0x2bc9b35c, 0xc5e89415, 0x35cfdd93, 0xf1d31a21, 0x14dd3607,
+    0x11b6192a, 0x74102fe4, 0x1fc22387, 0xc120c85a, 0x94925d14, 0x54c92c7e, 0xe851e622, 0xb288733b,
+    0xbca6e278, 0x54649fb7, 0x9c4bd4a2, 0x0a0e88f1, 0x4e18699a, 0xe98d435c, 0x4fda236a, 0x21294e31,
+    0xbd2f8768, 0x724f31e9, 0x467425bb, 0xcbc08de7, 0xb9c31e89, 0x859a9cf5, 0xbb1dd050, 0x091b0baf,
+    0x522975b9, 0xadd4a756, 0x6c66950a, 0xb06c7619, 0xb3f07bd4, 0x6b7804f7, 0x80c7532f, 0x110c266d,
+    0x4595c91e, 0xe8acf3b3, 0x37ad49c1, 0xb7e1b626, 0x621b688b, 0x0c814d43, 0xb4241a31, 0x3ac415fa,
+    0xe9238cf3, 0xf6bcd003, 0xa0c9f6d3, 0x4917a29b, 0x438adbea, 0xfcb7a9c1, 0xc82d9cf2, 0xc45105c2,
+    0xae2eb34e, 0x36238334, 0x56202c0d, 0x14cfa203, 0x68668016, 0x0c1d0e6d, 0x1c1f01dc, 0xc6b2cf49,
+    0x9ee8b42e, 0x11a14c80, 0x36da86c4, 0x18ef774f, 0x5dd9006a, 0x5a6d1dc5, 0xf7028000, 0x81f78738,
+    0x24047e8b, 0xb0ad644e, 0x012a4dde, 0x6dcc4210, 0x03641d52, 0xc2914605, 0x828de06f, 0x91b9b783,
+    0x5a5a6290, 0xb6a307c6, 0x9b2309ca, 0x36ddac01, 0x63ab01b1, 0xe545bcad, 0xf59f68f4, 0x53728cfd,
+    0x97559953, 0xea20b45e, 0x318719da, 0x73e00953, 0xc8205558, 0xffa3c103, 0x932c47a1, 0x94efdd6e,
+    0x771a89b9, 0xb466d228, 0x72eb5208, 0x0641a2d5, 0x81964385, 0xa7c4d619, 0xe9265457, 0x47d40b90,
+    0x982a8565, 0x5c9614f0, 0x6c17740a, 0x68037751, 0x068a4c72, 0x466bcb99, 0x6b59101c, 0x7c5bcd7c,
+    0x0bf41332, 0x7d60070f, 0x35d79e53, 0xdd585725, 0xe0170bf3, 0xaf9bbd16, 0xa763f890, 0x0115e0ac,
+    0xb337c067, 0x1b527484, 0xff4223d1, 0x7e7b907f, 0x967766a6, 0xa4abc5a0, 0xa671bc2b, 0x74ea00a9,
+    0x139e4fd0, 0xa2e468f4, 0x49035b26, 0xc734a447, 0xb488ab2c, 0xa9165a8a, 0xba2c2557, 0x634ec31d,
+    0x708cfe37, 0x62b06f24, 0xb3478c91, 0x32a41fdc, 0x6f1f9f38, 0xd87a074d, 0x0a07f2fb, 0x076b7dc7,
+    0x959c8ff0, 0x870e657b, 0x28f171af, 0xc8030420, 0x2a3f2c41, 0x5bc13e0a, 0x503ebb64, 0xee52073a,
+    0x98a0b0a6, 0xcc299cd7, 0x047ff715, 0x51dfead8, 0x98e62d8e, 0xa8eef1e1, 0x3c023a66, 0x6882ec39,
+    0xb5035bc3, 0xbcf128ae, 0x307910ad, 0x462089f8, 0xf263d009, 0x2a1bb66e, 0x14ee3015, 0x5833be31,
+    0xa86d0268, 0x15b627de, 0xd5268383, 0x9d3eabba, 0xf2e28173, 0x33963004, 0xa656b33d, 0xc78da3f5,
+    0x8863005a, 0x3961e44a, 0xa82973a6, 0x0d53c275, 0x1c09e715, 0x97b015ac, 0x380c5821, 0x1935c502,
+    0x6a5eaa9e, 0x84620d06, 0x0639b041, 0x911acb46, 0x3b9275b0, 0x198c196b, 0x2b0033d6, 0xc5e5b597,
+    0x2ecac084, 0x15157941, 0x1d2f6a13, 0x8352f77c, 0x162ed279, 0x864f39c5, 0xed3e3a35, 0xb7ec85a6,
+    0x86d57539, 0x7032351e, 0x851ebca4, 0x291983f2, 0xfa7ce7bc, 0x6409f476, 0xb4714223, 0x0bc2c054,
+    0xa1eb88f3, 0x90c8b119, 0x5ef9bc58, 0xfc84b204, 0xd3067b61, 0x685bc08e, 0xa77a8965, 0x8960640f,
+    0x64367afd, 0xc1d8bcc8, 0xd1531b39, 0x9d1866b6, 0xcc134a93, 0xf5158517, 0xdc511887, 0x5663e902,
+    0x2669556c, 0x20300165, 0x3f63d57d, 0xa03ac0e7, 0x4268ae56, 0xda4bd623, 0x6288504b, 0x932cea62,
+    0x068ea216, 0x1e63359a, 0x16342b3d, 0x0687df94, 0x4aebb7ba, 0x73e9945f, 0xa1314036, 0xbcf3a920,
+    0x7e39b6aa, 0x60b233be, 0x4000b9ee, 0xd0a47635, 0xf33e3af5, 0xdc01df54, 0x82236d93, 0x175c563e,
+    0xe342096c, 0x0831c2c3, 0x540d8225, 0x87ed7748, 0x1250abef, 0x4908cc00, 0x6f6e996c, 0x00af29df,
+    0x0225ba13, 0x76427ce8, 0xd1845850, 0x7512a102, 0xa6102e2c, 0x497b0da4, 0xfe984e1b, 0x816fbf0a,
+    0xe069d3c3, 0x746f834c, 0x93a00093, 0x1015bf8a, 0x7269e5eb, 0xe1678e45, 0x3fd00813, 0xa79e2cd6,
+    0xd3b4174f, 0x817d86b4, 0xda01c62a, 0x7bc01851, 0xab8dc966, 0x7ad913f0, 0x35a6901e, 0x01393dac,
+    0x505809b5, 0x75b824fd, 0x644ef936, 0x33dbda58, 0x42f044ae, 0xfaf9292e, 0x11a480d0, 0x4dfb689e,
+    0xb492fa4d, 0x65a45f26, 0x9ae066e5, 0x616d3111, 0xe82c6b7f, 0x2686a545, 0x0a60b2c8, 0xe9a7bbb6,
+    0x13ec0986, 0xf3ff2a3b, 0x15c0eec1, 0x4a50bc54, 0x843c5829, 0x8a1394fe, 0x547f2131, 0x92dd4c53,
+    0x46391462, 0x0e9cc0ce, 0x85df2e23, 0x774b9005, 0xc3c48929, 0x31a544e2, 0xc3bdc51e, 0x978b488a,
+    0xeb7bea6e, 0x62304589, 0x8e620495, 0x2ae0ad83, 0x35a4e98a, 0x34ce9915, 0xe314f9b2, 0x769a11c4,
+    0x109b7302, 0x53a76503, 0x34715ee2, 0x0180c189, 0xc5601435, 0xa1097ac9, 0xb682d1fd, 0x9a10a5b2,
+    0xcd23f8d7, 0x460afcca, 0xe99f8745, 0x0f2d4686, 0x49b84f06, 0xe30a08a8, 0x8e680c18, 0x12e0b4ba,
+    0xc39c582c, 0x2a209fce, 0x855f96d4, 0x838b729c, 0x4c36e214, 0xfb141814, 0x802940c5, 0x333ae541,
+    0x008691f5, 0x6b1d6d58, 0x89eb8ceb, 0xc164a170, 0x8c9634a9, 0xde8fbe39, 0xe77882ad, 0x7558f210,
+    0x70cabe45, 0x01126e33, 0x1a22654a, 0x042929f6, 0xa6f791a8, 0x2ac0599c, 0xefe591f8, 0x4248d4ac,
+    0x0309482c, 0xec991b4e, 0xa4e20f68, 0x0ded8d90, 0xb5961a78, 0x01750651, 0x13b07c90, 0x0978106b,
+    0xec624ff8, 0xd9037ad0, 0x1f00296c, 0x4d2968ca, 0x603c660d, 0x15011131, 0xe86e21dd, 0x2a10eb4b,
+    0x00bda597, 0x95f8c22b, 0x901c7ad0, 0x444f6f22, 0x00d73910, 0x8f127455, 0xcfcb9985, 0x29382734,
+    0xc5a5779a, 0xa764c34a, 0xd53a6da5, 0x04f73055, 0x0de971f7, 0xafa02fb0, 0x1729e2cd, 0x9ad04f5e,
+    0x22276fe8, 0x588bc661, 0x2a532f65, 0xd42c6a7e, 0xa19b9665, 0x1b327590, 0x1c8e3d25, 0xd2557b41,
+    0x4de98ea8, 0x42a46939, 0x5f16417c, 0x18ec005b, 0x392750e5, 0xf744491c, 0xd654d597, 0x01c7d544,
+    0xe4f09c41, 0x41370e01, 0x76135b7a, 0xc43ad569, 0x90ba7184, 0x480b8c0c, 0x67fc76f5, 0xc691375d,
+    0x2223318b, 0x7d1316a7, 0x4806041c, 0x626757b6, 0x5c296a76, 0xc2da1ab5, 0x07942670, 0x610b9600,
+    0x8f4bb9c5, 0xa98a3140, 0x42649605, 0x72ca7342, 0x789b5a8a, 0xa8299975, 0x34e4c4c0, 0x537e44cc,
+    0xcc73005b, 0x89717905, 0xd1fb3310, 0xa003d341, 0x9a95f37a, 0x6dd197c0, 0xdcd14873, 0xcf01bbb4,
+    0x04014fa2, 0x29bf50f3, 0xc9f837f7, 0xdbbe8012, 0xada23532, 0x044cac11, 0xc7a2ebec, 0xe9d4ec40,
+    0x097a9409, 0x6ff8de9d, 0xbbc039d6, 0x98c9de09, 0x208d8d42, 0xa4bf8fcb, 0x5ba0404d, 0xbe3e860e,
+    0x6d435032, 0x4a8b4a32, 0xfc834c2f, 0x03f1e2b6, 0xace9f83d, 0x02cc2179, 0xe85d5c4b, 0x201d75b3,
+    0x8e130747, 0x642a5062, 0x582d581c, 0xef59d384, 0x00a68326, 0x5093ec1f, 0x3e3fad74, 0x0e746d98,
+    0x8208f920, 0x31cb7f6e, 0x306582b2, 0xa000ac9c, 0x9ac8279e, 0x1ebd7665, 0x8c26db05, 0x39e28b71,
+    0x8055d5bc, 0x04193624, 0xc4d03b59, 0x5fb6f1a4, 0xbab1429f, 0xa7d99058, 0x5993e802, 0x1dac6e76,
+    0x9417f4ad, 0xa1295160, 0x87bc92ef, 0x23d80d2f, 0x3c11e301, 0x5dbc6cdc, 0x56182bf0, 0xe390fab8,
+    0x0d7c6ada, 0x22475623, 0x3f7751f8, 0x7c10920d, 0x077127d2, 0xa1662ea0, 0x03904a15, 0xa0323b28,
+    0x0e931ede, 0x68e8fc83, 0x0145901b, 0xbd1fcf4b, 0xe8fd30c7, 0x975383bc, 0x20d5bea8, 0xde98fee4,
+    0x6e93c339, 0xf3b35b4b, 0x670f1347, 0x733abc46, 0x35816930, 0xc07dc159, 0x9005be51, 0xdaa96443,
+    0x309e260e, 0x58f5d900, 0xcf734f03, 0xed7b83a6, 0x2f338122, 0x44c01cc0, 0xf644e86a, 0x3f68faca,
+    0xb19f654a, 0x33aeb61b, 0x04115227, 0xfbaeac82, 0x50daac7b, 0xffe732b9, 0x901a1a83, 0x4cac6f62,
+    0x3bc823bb, 0x72e561c3, 0x88cc002e, 0xaddd6a51, 0x504c38ab, 0xdf79003f, 0x91e8035c, 0x69830584,
+    0x202d9e61, 0x525a4624, 0x56884067, 0xb3699ed8, 0xe002a9f2, 0xb914a81f, 0x9c71bee6, 0x6eb816ef,
+    0x327d9c5c, 0x1b0f3a21, 0x0aac6847, 0x56c861f8, 0xca4be401, 0xaa0e96b7, 0x08b8bec4, 0xbad7f733,
+    0x3858054e, 0x48a7c755, 0xf7e9dc00, 0x4eb40352, 0xf01700bd, 0x66a15614, 0x8def4c80, 0x9cda983d,
+    0x2b129541, 0x61bd15df, 0x8d9dae90, 0x15ebbcc9, 0x46cabcc6, 0x47578d97, 0xdabf3fe9, 0x754ed432,
+    0x9bdc04ec, 0x8b78e642, 0xa1a2c587, 0x1fe31a4d, 0xa5a44bc4, 0xecebb2f2, 0xb2591240, 0xabd54436,
+    0xefc1b941, 0x3495c34d, 0x0924aa05, 0x5802b6f5, 0x125a22bc, 0x14b06bea, 0x0b68a5ab, 0x284ea0d6,
+    0x9ba98ac2, 0x501e562a, 0xc14e5bed, 0x469534ab, 0x8ff313c5, 0x9317213c, 0xb53487f2, 0xc6393194,
+    0x09f74350, 0xaa3e5b0c, 0xe118618b, 0x92bd24b0, 0xd12bf98c, 0x11dfea53, 0x88e53bd2, 0x26ef78b8,
+    0x509db7c0, 0x46d723d4, 0xa8f4dad1, 0xd8db510b, 0x9517584f, 0x5ca32d29, 0x0f4e2f4f, 0x30c76aa1,
+    0x51b029b1, 0xff353979, 0x719046e4, 0x437eb8cc, 0x7cdbb732, 0x21b8a0aa, 0xad6b21c1, 0x6d7d010b,
+    0x64b2b22d, 0x83d3bcb1, 0x6766da6c, 0x70437afc, 0x1b84424f, 0xb4a331d7, 0xcb2ec980, 0x63a13e22,
+    0x8ce52045, 0xad37022b, 0x09da85bf, 0x2787ecb6, 0x714c4377, 0xf4b63175, 0xd81a1fb3, 0x1b19b41e,
+    0xecc80d79, 0xd4568fe6, 0x7670a188, 0x0a54404b, 0x1528c983, 0x2833b8fb, 0x89174470, 0x8aab5c23,
+    0x82ed37a9, 0x87bc1555, 0x77613366, 0xce408510, 0x96766f69, 0x1fd38001, 0x8aceb8b6, 0x70341a3f,
+    0xc8c3908a, 0xfa968d01, 0xc344ccff, 0x61015df0, 0x73186165, 0x91006446, 0x55d73c08, 0xf582a300,
+    0xacb3ba25, 0x45cd420a, 0x4d01d804, 0x5d83d2b1, 0x14f302b5, 0xb7c17058, 0xaec58aa1, 0x5680a18c,
+    0xa25759da, 0xe288f616, 0x074bc1f6, 0x4d06dc57, 0x44d42d82, 0x9140ed37, 0x7430fbb5, 0x91ac13b5,
+    0x44a555d7, 0xab1b1006, 0x264ed418, 0x1e8ad172, 0xc380bb31, 0x2d73ea06, 0xfb3976ad, 0xe0e99e34,
+    0x656a1c76, 0x005948c8, 0x10227ceb, 0xa676e447, 0xeb2219db, 0xbe4f08a6, 0x5418e8de, 0x8a94e568,
+    0x9114c899, 0x08144a30, 0x0820015c, 0x6a5695c0, 0xca538bd1, 0x59e76442, 0x496d4eda, 0xa40cee7e,
+    0x60338f08, 0xb7a99365, 0x54979d35, 0x594c937d, 0x17bd0083, 0x7a7258c2, 0x55cc6997, 0xf74c6b21,
+    0x126fea32, 0x416ed146, 0x7b3480bf, 0xf765266f, 0x2ac5e096, 0x5c2a301e, 0x9d0050e6, 0x9a55d0fd,
+    0x3fe8f5f7, 0xba5a0fa3, 0x34a40349, 0xc8a72c67, 0x185488b6, 0x6beef49a, 0x6ac38042, 0x7c1bb863,
+    0x404baeaf, 0x16a89cc8, 0x271a7e53, 0x7fb2f048, 0x6c0c994f, 0x869abc9a, 0x8f21d11f, 0x593af02f,
+    0x0fffbf94, 0xc473818b, 0x002bdedc, 0xed2f2f40, 0x10fa6e1b, 0x7ebc453b, 0x2a12520e, 0xe891936f,
+    0x6a0527b1, 0xd236e92c, 0xe14c1402, 0xc2c18ac4, 0x080230f0, 0x07da31a9, 0x42defabe, 0x02ebf460,
+    0x59250276, 0x3894a3bb, 0x364cd039, 0xe0d0607e, 0x13a92e4a, 0x9af046c4, 0x77febe16, 0x7d71a156,
+    0x522823b8, 0xcba90254, 0x31b766d5, 0xc25ca1ed, 0xfed0105f, 0x57cb5949, 0x290bd180, 0xe401a5c6,
+    0x69eb8496, 0x2db29736, 0xbfc3570a, 0xd9ecd208, 0x1c0bace2, 0x904be757, 0x386a22a5, 0x58c99e18,
+    0x22898460, 0x315035a2, 0x19cd5402, 0xdd964429, 0x7f296aea, 0x4021da98, 0xf6b59bb2, 0x0ae3a8c7,
+    0x168f41d1, 0x2e7a11fd, 0xd2f77b6d, 0x31d2057d, 0x4fe5b925, 0xbfcfd987, 0x318517a8, 0x84d83865,
+    0x822ca0c6, 0x205e247c, 0x2883fcad, 0x7d57c609, 0x6a0a7722, 0xd17a0a61, 0xd88022d4, 0xf03e533b,
+    0xb930b77d, 0x11b0a68e, 0x84ae5453, 0x127c49fd, 0x23da90d3, 0xda9184f8, 0x7aa80b26, 0x30989196,
+    0x88b1327c, 0x15463ca3, 0x8c664671, 0xd2c563b9, 0x559cd864, 0x711f77c5, 0x1488fedb, 0x585268d6,
+    0x2804ee56, 0x5d85a173, 0x3a45972a, 0xeb2f5204, 0x8c31432d, 0x85184c19, 0x2c6f6630, 0x1aa5868f,
+    0x60409a16, 0x163f3874, 0x08617214, 0xa53fbba7, 0x6715b96a, 0x173fd672, 0xf8c8e322, 0x3db2eacc,
+    0x48333b86, 0x06884e4b, 0xa5baaf00, 0x3bbac1b1, 0x06403494, 0x21ce5906, 0xd83c977e, 0x2222a04a,
+    0x94815ed0, 0x0268261c, 0xed9420b8, 0xe92a7db4, 0xf9a70048, 0xee38544b, 0x3f11af24, 0xadd35602,
+    0x61b047ae, 0x1c881177, 0x2ce064bb, 0x3004ac91, 0x5ba7e4d7, 0xd4473799, 0x767ccc1b, 0x422b9719,
+    0x7943bec0, 0xc01e8184, 0x549f6ca7, 0xaa54e370, 0x5b13376d, 0x5804efb1, 0x6518e7d0, 0xb419b1ab,
+    0x3eacad58, 0xdf861501, 0xd399605b, 0x4b01562b, 0x99c4ecad, 0x0a98a0f6, 0x3a4dab7a, 0x45de84d9,
+    0x382ec3b0, 0x616e38aa, 0x6199d4b4, 0xdc3f7e2f, 0x60ab8f46, 0xe39ccbdb, 0x736d2d10, 0x9535e55a,
+    0xc69ed038, 0x20417d52, 0x71729304, 0xab1180df, 0xfe9dc55b, 0x54afcdc6, 0x73aeb78a, 0xac3987aa,
+    0xc2a939b4, 0xbca901d6, 0x42bbdd85, 0x3c53095c, 0x13f8ffe0, 0x7f29315a, 0x594a933b, 0x310463d3,
+    0x9fc07696, 0x4ea124bd, 0x4a8c1c86, 0x66092ce2, 0xa5352abb, 0xbc9d1dc9, 0x8ba891f3, 0x7c126f67,
+    0x4944c9cb, 0xfb143d7a, 0x10c80a4c, 0x65119138, 0xbe998875, 0xb4f1e230, 0xba1034e2, 0x9a731476,
+    0x87c532f4, 0x6b3ae34b, 0x88ccb7f8, 0x964c3aa6, 0x0be025b1, 0xc9b236c1, 0x90d106ad, 0xe1bd97fd,
+    0xfb29cb8e, 0xacc94931, 0xd20665f1, 0xc1ef0235, 0x30f0b83e, 0x980a0a83, 0xe500ab82, 0x7c538d94,
+    0x24d30de6, 0x58a6d272, 0x9b481ecc, 0x37c2de7a, 0x1a83153c, 0x1b3dd1fb, 0x48c501c5, 0x31516e1b,
+    0xe2702a81, 0x410dac66, 0x64d55d8a, 0x9a2da046, 0x0fa4c28c, 0x8b8259e8, 0x28099202, 0x2a722336,
+    0x9c002a5d, 0x746b9641, 0xdce5a60b, 0xd5a8100d, 0x800131e6, 0x8b2e0145, 0xfde12ce7, 0x080b1dc0,
+    0xc61dcf40, 0xbd4429e0, 0x728ae31c, 0xd690201e, 0x93ca314d, 0xbc95900e, 0xf8004fb3, 0x626e683a,
+    0x431ac533, 0x80636ccf, 0x2bdcd61b, 0x1d05a2b5, 0x09796dd0, 0xe8159b0b, 0x209a8cb8, 0xa3a5198b,
+    0xe63e1fdb, 0x228cf888, 0x6371d120, 0xd8fc9097, 0x91844488, 0xae98a2ce, 0x3ed753cf, 0x1179db55,
+    0x7f85c9f5, 0x486f1dba, 0x57142eb5, 0x9b71da50, 0xa0aff409, 0xabe2e125, 0xd24ffd57, 0x676c1c98,
+    0x8d964da1, 0x49b075d0, 0x7077a025, 0x9e826906, 0x9a67b221, 0x0d9f04c5, 0x579b420f, 0xa9a1a9ca,
+    0x21c8e54a, 0x15408547, 0x6e80ab56, 0x51c3a5b8, 0xc4114938, 0x9115a481, 0xe7f3b2d3, 0xf087409a,
+    0x35b20470, 0x135b7aed, 0x3555217d, 0x577fa0d0, 0x8cb9fb0f, 0xa5785521, 0xd2995c26, 0xa32d3946,
+    0x159526dd, 0x11c4118d, 0x66a7b048, 0xc9767642, 0x29baa25f, 0x09651183, 0x1419f003, 0x7bf98501,
+    0xb236848f, 0x14a10598, 0xc073523e, 0x6b7e8a72, 0xd9a1a518, 0x39acbd2a, 0x8e09cc3b, 0xcaef049b,
+    0x272b03bd, 0x9f2f88aa, 0xc537117f, 0x94003ba0, 0xa1b49101, 0x32a461a9, 0x042daf5d, 0x613b9c63,
+    0x02f10d3e, 0xe34ec746, 0xb2800001, 0x21413309, 0x5ac30dcd, 0x9efaeafc, 0x90f8218a, 0x7aa90888,
+    0x2a92a3a5, 0x8021ea6d, 0x8c821fbc, 0x9d0b1f78, 0x7c910c25, 0xb6c0b3a1, 0x4e02cd7d, 0x98602bc0,
+    0xed157233, 0x83dd98c9, 0xd3a411f7, 0xdf495d06, 0x3260fe46, 0x99770306, 0x7158afed, 0x63887f14,
+    0x2339a252, 0x6d6050bc, 0xa3d2b020, 0x6d9424a7, 0x9554a301, 0xe3ed845d, 0x6457cc3b, 0x29e53029,
+    0x634b9ee7, 0x7bc31421, 0xd07b4c35, 0xd3d2def8, 0x516d133a, 0x2dfa4461, 0xde639b8a, 0x37455bf9,
+    0xfb0c2d18, 0xb00acf01, 0xab3094e5, 0xabfb1568, 0x997f8fb6, 0xe8a8019f, 0x0c913e59, 0x223eaf5f,
+    0x14d170a4, 0xb0d2de61, 0x17a92f67, 0xd2d3411d, 0xb07d575a, 0x956c0981, 0x7b87584c, 0xb465afe3,
+    0x485c2287, 0x22d2151a, 0xb2930840, 0x73a7d77c, 0xe5fea127, 0x2150199f, 0x35432001, 0x479f285a,
+    0xe8d9bb08, 0x44d19aa9, 0x1fe54aca, 0x2131c7cd, 0x4c7fbe69, 0x9098a999, 0xd9d04f00, 0x3fc2d6b8,
+    0xe0af8aba, 0x650f5843, 0x3c66c663, 0x8b652853, 0x7b095a21, 0xe1af922b, 0x755d4d8f, 0x28e4f846,
+    0x35f90071, 0x71fae85b, 0x58c3a492, 0x323f72fc, 0xc22cc60d, 0x80483ad4, 0x690ac2b6, 0xa55e0a6e,
+    0x5b95e459, 0x1130fb33, 0xc3c88a32, 0x26a8437b, 0xb719d166, 0x5227f3fb, 0xad0fb68c, 0x98940b14,
+    0xe4033433, 0xe000b9d8, 0x168265c8, 0x4655bfaa, 0x81408bff, 0x47be92eb, 0x866c030b, 0x8c6062d7,
+    0x66cc7c0d, 0x0e8005aa, 0x4e3eda37, 0x06d2da9c, 0x54d6f940, 0x792edffc, 0xc031ef19, 0x780fddf4,
+    0x20101549, 0x0af5c9b5, 0xc983a603, 0x4f0f003e, 0xf894b902, 0xcae3043d, 0x05b79a2c, 0x87031938,
+    0x89c7b63f, 0x6b1a04e7, 0x3a0840f5, 0xb6b4623e, 0x4f154db5, 0x0d17003a, 0xdad4148f, 0x9633416e,
+    0x6711fd2a, 0x49ce4861, 0xcfbd4d9e, 0xcb089a94, 0x1b499f56, 0xac8269ca, 0x4c5208da, 0xee03d51c,
+    0x9c8c8340, 0x7ec69d1b, 0x42d14198, 0xd49523d3, 0x87b8dacc, 0x510d328c, 0xd608b6eb, 0x310964bb,
+    0x5495adea, 0x3c720319, 0x17a73961, 0x5152a4d8, 0x067429ae, 0x80a4ead5, 0xccada8bb, 0x86aac4e8,
+    0x1c81da8b, 0xe15ba6d8, 0x9653ebba, 0x0903c542, 0x14614250, 0x32f7f2d3, 0x413994a9, 0x3b630fd6,
+    0x59656805, 0x38680e02, 0xca44a0a1, 0xab72cc92, 0xd93252d2, 0x593bc391, 0xfd78bc89, 0x9ba7c126,
+    0xd7a5644c, 0x38c4c340, 0x4b3c0d5f, 0xa7545259, 0x22e9099b, 0x4e254edf, 0xc76ca0f6, 0x2e899d31,
+    0x34377e55, 0x5b068204, 0xd3240d26, 0x9a7cb043, 0xf4a0d233, 0x4a98db24, 0x822c0e82, 0xbf760ae5,
+    0x928bb378, 0x575b14a6, 0x00894468, 0x8398fef0, 0xb9344839, 0x451a8085, 0xc95e8b8a, 0xd813c502,
+    0x13326ed0, 0xfee559ed, 0x876db2a1, 0x6b4b7e34, 0x9e71d9a1, 0x1e9873c5, 0xacf4f6ac, 0x10193712,
+    0xe64cb717, 0x42a658e1, 0xb48a4f75, 0x67d1d2a9, 0x1e5ef988, 0x29239c23, 0x6f68a559, 0x60f6a4ab,
+    0x721e6482, 0x602e16e9, 0xc14c4c4a, 0xc6694b31, 0x2530010f, 0xce3eafa0, 0x8c05697e, 0x6ed07748,
+    0xa545d1f1, 0xdcca9e2e, 0x027a2899, 0x10d16c88, 0x81a43305, 0x1d3a6a1f, 0x83bb8004, 0xed3a27d2,
+    0x8ca6b2ab, 0xc1780869, 0xcd52bc2d, 0xd2011756, 0x9f50ce98, 0xd112c105, 0xc7b287a2, 0xa3369a4a,
+    0x082881a1, 0x79825d7e, 0x0c117733, 0xaccd9be7, 0x24e4ca43, 0x70fa6183, 0xbe942876, 0x9a4c1799,
+    0x9c3e0a74, 0x40d4f1a7, 0xbf13705b, 0x807a481c, 0xb62a0fb0, 0xa17eccae, 0x4979d503, 0x7210a6a1,
+    0x6108ef64, 0x9234430d, 0xa9c887e5, 0x1219dec6, 0x49a66609, 0x29e8d56a, 0xa4558be4, 0x74889a8a,
+    0x94a2088b, 0x75f24bf8, 0x6061be0d, 0xa37e560a, 0xa1c43f6f, 0x0d23f25a, 0x06628029, 0x58cf0944,
+    0xb3d35220, 0x180535d7, 0xcd73354f, 0xc0ea87fa, 0xf3d8d557, 0xb882178f, 0xb46f2b55, 0x6bf032ad,
+    0xc5916b32, 0xd0817740, 0x6326677a, 0x861497e7, 0xd9351929, 0x00185645, 0x45118561, 0x28fa0b96,
+    0x590ba38d, 0x23be4a62, 0xab2ba736, 0x4e84b8e8, 0xb5a99a9b, 0x43e853cb, 0x56b95bd7, 0x2d522e62,
+    0xcaa814b0, 0x1593b2d6, 0xbf505f05, 0x142130db, 0xbe765c13, 0xc5d33585, 0xda30558a, 0xaca1931b,
+    0x7537c811, 0xa75d8c22, 0xb1fee800, 0xc2120bcc, 0x9ae61d90, 0x1f71d26e, 0x837e8fcd, 0x7037a338,
+    0xa6bc05aa, 0xaabc0182, 0xd386a822, 0x228358a1, 0xe9fe7917, 0xd07c0a0e, 0x8c156018, 0x21796702,
+    0x6499f6db, 0xe60042a5, 0xd0651e4b, 0x4ecd9cc0, 0xa081dc0c, 0x3ed71843, 0xd0f45495, 0x1fe8a893,
+    0xee8222e2, 0x25f6d62e, 0x38802524, 0x501dd462, 0xb44560a1, 0x3baa3dd8, 0x03b904d5, 0xf0dea5d7,
+    0xb19b32ea, 0x43186e35, 0xf231072a, 0xd7ad9179, 0x40765685, 0x03a31be4, 0xa59d93bb, 0x1f829a52,
+    0x8fffbf23, 0xcf630028, 0x96cf0008, 0x0a6a92a9, 0x12ea1773, 0x25a1cb40, 0x08acca3f, 0x794277ab,
+    0x3a107d17, 0xf47aa92d, 0x91a576d2, 0x49a13436, 0x5e8d085e, 0x84768541, 0x2a370970, 0x246a0630,
+    0x5e24914a, 0xd407f122, 0x77d02938, 0x18774a7d, 0xc9f45e0a, 0x0006b529, 0xbfb36cbd, 0x70501df4,
+    0xa47c8c6f, 0xab344729, 0x7d59ff54, 0xf2935326, 0xa1a497d3, 0x720704f9, 0x1781a38c, 0xa63d9c2a,
+    0x4e3f6bbc, 0x663f30d5, 0x46d3d26a, 0xa3590a52, 0x25c79dd5, 0x20fe1a79, 0x84c5d585, 0x09769a46,
+    0x05c52150, 0x760714e6, 0xb032583a, 0x91731a3a, 0x624c1e4c, 0xe469ca82, 0xa7f694ab, 0x4a9ac5a6,
+    0xe732ba5c, 0xe545120e, 0xa7bcac48, 0x97086a64, 0x3faf70ce, 0x48a822e0, 0x2f8acefe, 0x42b78c43,
+    0x278e34d8, 0xfe1c0012, 0x7a7cffa6, 0x733436f5, 0x4f148a0b, 0x257e798d, 0x370c83ec, 0xc072bb9a,
+    0x4d6694fb, 0xb3511c00, 0xa90c312d, 0x90009769, 0xc1f34ee3, 0x29806d2d, 0xeac6840e, 0x006750e5,
+    0xab528f81, 0xe00fa364, 0x0b2c9947, 0x36650b80, 0x4099193b, 0xa24d42f4, 0x33694b7c, 0xc4327023,
+    0x926fc47b, 0x8738bb40, 0xe3dbd0c3, 0xa7e768df, 0x028a0d4e, 0xbcf9f6f8, 0x1174af17, 0x7ea54a14,
+    0x86206101, 0xda65ddf7, 0x61430bcf, 0x15f4b508, 0xa078121a, 0xfda9deb6, 0x23c4b0f7, 0x399ef035,
+    0x99bae9a8, 0x1933d471, 0x3b242abe, 0xae114c1e, 0xb6c47bb4, 0x6fbd1102, 0x5c31668a, 0x5e74a797,
+    0x23993ff3, 0xba149380, 0x7b81fc75, 0x98a4cda9, 0xaad3078c, 0xddb88b48, 0x61928b41, 0xa836bdac,
+    0x25c1b971, 0xbb8685b8, 0x58096e40, 0x4d01423c, 0x2d312e14, 0x4b13227f, 0xf56393d9, 0xc036dc30,
+    0x75266fc1, 0x87e086af, 0xc92b1549, 0x2502b2ec, 0xf11d5b25, 0xe89923bb, 0x0a70378b, 0x4509aa7c,
+    0x93e57263, 0xe449cba0, 0x31982820, 0x99e67525, 0xe9fa2c46, 0x0ea4e1f4, 0x332476e2, 0x1572de99,
+    0x00934368, 0xd821d065, 0xac3f8e8c, 0x70759e12, 0xb265280e, 0x001ca569, 0xa9983fc1, 0x3f4c641f,
+    0x8b95200b, 0x46b4f9b4, 0xaefdaed6, 0x2868348f, 0x063ef358, 0xe49d5ac8, 0x4c1e16ec, 0x044d2254,
+    0xe2cfb829, 0x06210b52, 0xd3b2739b, 0x9c182d37, 0x3ae34320, 0xde820f39, 0x90e7c355, 0x72a101fd,
+    0x8e9c62b9, 0x214b0a85, 0x2895caa5, 0x8c997d20, 0x420b36cf, 0x0d932345, 0x226eb6e9, 0x0e21ebea,
+    0x717c6234, 0xa49df986, 0xbdf01d04, 0x48c76632, 0xc60160c0, 0x26ece0b0, 0xe3503fae, 0x20631206,
+    0xe26ac377, 0x8864f495, 0xfef83169, 0x9a30c406, 0xae302962, 0x0534137e, 0x8bc83c80, 0x3ab81d22,
+    0xade4c599, 0xc4e20fc0, 0xc536ad2a, 0xd9ad0008, 0x0bb8d30f, 0x59bd6172, 0xa421bb30, 0xda147d8b,
+    0x4f807c47, 0x74a7f829, 0x6950eacc, 0x043008da, 0x97c34e05, 0x777c8fa1, 0x789c7946, 0xe909646d,
+    0x8c61cd21, 0xf6f5f555, 0x31bd9236, 0x4d9c05d0, 0x5af5f2a1, 0x5068d82d, 0x67f89641, 0x9643a0af,
+    0xb1065090, 0x8529213e, 0xf56c306c, 0x594f619b, 0x13446f06, 0xeb433d0d, 0xadaac059, 0x88874609,
+    0xbe8d4d9f, 0x61061424, 0xf6a6525c, 0xddaa3777, 0xe5af48c3, 0x112ed0f7, 0xae4030e8, 0xa2068cf0,
+    0x5f7b8934, 0x54bd8313, 0x67b8de31, 0xf3efcdfb, 0x79a57a0d, 0x5a5aeb10, 0x285cc712, 0xbba6a2a3,
+    0xf4075917, 0x57a9e81c, 0x89762a66, 0x728c62a9, 0x63a6e381, 0x8e000082, 0x3943611c, 0x3aea8fcd,
+    0xab1588fa, 0x737a39c4, 0x9e8af2b4, 0xa9c4b82b, 0xb8b97e98, 0x50ec41e6, 0xdd25ab9d, 0xc4020106,
+    0x2b184ada, 0xada134d1, 0x217c2c86, 0xcc718a12, 0x0857e515, 0x79699d14, 0x27f83306, 0xe1289de1,
+    0x29376083, 0x0021f1ce, 0x3213359f, 0xec0aa3e0, 0x6de7e268, 0x00a26a1b, 0xbd883741, 0x2eaa6b78,
+    0x0fe56a54, 0x5e358dc0, 0x89255846, 0x91b02ad7, 0xa12f1e5b, 0x80cc8fc9, 0x7025c05e, 0xc231fc24,
+    0x79bac952, 0xa569ec84, 0x37cd0480, 0xa08eaed4, 0x91490a2d, 0x3977eb65, 0x4a120a99, 0x22e18eb0,
+    0x64a31824, 0xd1d23ced, 0x0a226b54, 0xc0180255, 0x559164d6, 0x432f3958, 0xd68050dc, 0x0fef2c6a,
+    0xc3b0127b, 0x69f42891, 0xfb9f4bf0, 0x639feadd, 0xa403b0c1, 0xfbc4aa35, 0x44f7e9d1, 0xd037401d,
+    0x0a42fd5c, 0x7084f6a0, 0x3cb57110, 0x6ed5faa6, 0x8800cba9, 0xb7895a57, 0xbeb1bdec, 0x917db42c,
+    0xd2c760f8, 0x312f07a3, 0xa3951817, 0x8ea31913, 0xc42231c4, 0x81c841f2, 0x60469365, 0xf42206f0,
+    0x12383a49, 0x941640e0, 0xa7d67d54, 0xc0a1d775, 0x551f9eb5, 0x576c000b, 0x9f6ec238, 0xb33f01a5,
+    0x1499e3c8, 0x094a9f44, 0x3327df20, 0x7abfa949, 0xa49a1b47, 0xa108a051, 0x4269d0da, 0x58ca0ff1,
+    0x0b4b640c, 0xd86665fd, 0x0520a73d, 0xd15a0d96, 0x9f928a78, 0x52568ff1, 0xa3d54e49, 0x7100c1a7,
+    0xa06a5d6b, 0x83aca970, 0x0b830987, 0xcccc2e31, 0xe81374c0, 0xaab9a6b7, 0x570a8c69, 0x459cf1b4,
+    0x113ff2f7, 0x74927d81, 0xa468bbcf, 0xffc17ab4, 0x33a3fb06, 0x901288c2, 0xf46ae0ac, 0x93042b58,
+    0x01a264e2, 0xe279f4b0, 0x912ba547, 0x00e58d40, 0x70fef6e4, 0x2401afd7, 0x0fa3f5ca, 0x530402cb,
+    0x0023fe69, 0x76dc3c35, 0x79a2853a, 0x0556900c, 0xbed7ef25, 0x50c2969b, 0xe91f5bd8, 0x240b4071,
+    0x744b8032, 0x55580009, 0x6d01a649, 0x92a9b652, 0xa003d648, 0x37f7a4dd, 0x0170b51f, 0x47a446ca,
+    0x480e8670, 0x102ff14c, 0x67832dc0, 0x948794f6, 0xfe8019f2, 0x0e7d1033, 0xed4093bb, 0x0e3cca10,
+    0xf1786331, 0xbc45ae35, 0xb072d387, 0xfda1678b, 0xe22a424a, 0xcc28da8b, 0x02d56d49, 0xc643f738,
+    0x478be3c0, 0x86198d88, 0xf4039532, 0xbd62f5a4, 0x16246bff, 0xc6f70c59, 0x19867396, 0x6921e450,
+    0x96017993, 0x377dd956, 0x6a89b826, 0x7dc97048, 0xb42a7556, 0xba98ab90, 0x0ac72974, 0xabda7b4b,
+    0x5b5d481a, 0x750bb66e, 0x53c5e497, 0xa146d01f, 0x67f2d311, 0x4194c131, 0xc34ed631, 0x9cdc0200,
+    0x6da5ea74, 0x34905718, 0xea689283, 0x2a51cbaa, 0x3bbcd1d2, 0x78c089cc, 0xa7bf270a, 0x26f45899,
+    0xaf873b56, 0x500f30bc, 0x5052d9b9, 0x9e29a0cb, 0x164e5fa2, 0x6f20dd4e, 0x498732a7, 0xb583592d,
+    0x261dc733, 0xb44ddebf, 0x46eac41b, 0x30fc73d9, 0x15f92786, 0x4d118d0a, 0x41eb0585, 0x7fb41ccd,
+    0x1b64ccd1, 0x79846f48, 0xfc1e6fb2, 0x36bdd102, 0xee803b68, 0x7f108969, 0x9cc47689, 0x42b170cc,
+    0x35070ce0, 0x0dade222, 0x5b7941c7, 0xf23861a2, 0x62d396e2, 0xb5c1fc23, 0x26f50a50, 0x0af73b98,
+    0xaa18f236, 0xc854d422, 0xd2226904, 0xcaf80f76, 0x5a1c1e5d, 0x7442393b, 0x439f9537, 0x285301df,
+    0xf6774444, 0x69085a9e, 0x5b0c8802, 0xe00a8932, 0xde491fd6, 0xf04982cd, 0x30657803, 0xdfa21b38,
+    0xc8148eb2, 0xbc287393, 0x2f733583, 0xbc208b07, 0x343ba283, 0xd4010267, 0x0a29a382, 0x0cdcab11,
+    0x380d944c, 0xd28e2e80, 0x002f5005, 0xb1241cd6, 0x9bc07b7a, 0xc38493da, 0xaa5a37a2, 0x626520eb,
+    0xc2cf4707, 0x47076220, 0x8dafb711, 0xdbac4243, 0xfa217568, 0xd4aa794c, 0x419769cf, 0x6422ac93,
+    0x55bc479d, 0x626e7f56, 0x42071af3, 0x321a7c40, 0x86d5300d, 0x4be50889, 0x05965c89, 0x0927642a,
+    0xfb931169, 0x1f48c0d1, 0x1989b6dc, 0x38251ed6, 0xb8cd5044, 0x85b2443e, 0x349b0ab3, 0x11ea8554,
+    0x2243c915, 0xd28a1377, 0x7098e669, 0xa03c54bb, 0xfbb25b40, 0xb681f8cc, 0x8f0d43ff, 0x53432077,
+    0x553627bd, 0x62fd4818, 0xd5069bce, 0x88e95468, 0xf717a47d, 0x731795a4, 0x85325c00, 0x918b0268,
+    0x82254028, 0x26647a6c, 0x3c994762, 0x3a95a7f6, 0x000a2edb, 0x120c1900, 0x000b9223, 0x18a3cce9,
+    0x794afc58, 0x2ae73923, 0x80bac8b7, 0x6b8b1e49, 0x55e00b79, 0x3a4c3844, 0x176d406e, 0xb3377014,
+    0x26f288d8, 0x7476e211, 0x9113c7c4, 0x2bdd651d, 0xcd4b4562, 0x7078ea71, 0x8791e4cd, 0xd17c136b,
+    0x5c386b76, 0xaba80464, 0x59fa18b4, 0xa6ff5095, 0x299d2e59, 0x6970382e, 0xe7748087, 0x8e62aadd,
+    0x0c0091c6, 0x82026406, 0xd8108387, 0xcda91c82, 0x5d1a1749, 0xf66804c1, 0x1428022b, 0x90716b1e,
+    0x304cbbf0, 0x15d66148, 0x0ce8e9d0, 0xc61005bb, 0x7719e230, 0x6792937e, 0x6d48afd0, 0x8281760f,
+    0x2ad65794, 0x1b3d15fc, 0x2d4d7215, 0xb5776800, 0x801dd96b, 0x94039673, 0x24b4fe06, 0xbbaef6f4,
+    0xb9c44140, 0x370714c1, 0xae27f1f7, 0xd755edb0, 0x439aac35, 0x9c8a3d8d, 0x81224c4b, 0xa1da83ce,
+    0x72019fef, 0x50bd074f, 0x2a331b37, 0x79166804, 0xa996c007, 0x84ccc065, 0x43206b2f, 0x0e71182e,
+    0x79c92b9e, 0x656ed2eb, 0x813f3c51, 0xb5897905, 0xc34542e5, 0x35a47483, 0x8c45d7c8, 0xa4afe21c,
+    0x145924c3, 0xda294a34, 0x776a7d37, 0xe359ea1f, 0x00057231, 0xb39e5d00, 0xe321f90a, 0xe289e9af,
+    0x043b7197, 0x920204a9, 0x95d3407e, 0xc4477c00, 0x034a89a9, 0xddb0908c, 0xe82422fc, 0x4218209b,
+    0x971093cf, 0x43e7c466, 0x99b791d0, 0x477e559a, 0x0099792b, 0xc354b5a9, 0xfe2a33f5, 0xe81f780e,
+    0x36ff1315, 0xf7fc3b45, 0xf30772b0, 0x4bef0cf4, 0x6d22802c, 0x56a22b50, 0x1bd53aa9, 0x2be95753,
+    0xd2101f1b, 0xbd1e896a, 0x4aea29df, 0xbd6f2618, 0x70a38c3f, 0xaac10408, 0x33914a2c, 0x4e1d3952,
+    0x0d40239a, 0x27eba840, 0x93dbbe3a, 0xc50e116f, 0x397472cf, 0x5cc19411, 0x06a62e46, 0xa6716480,
+    0xbd800732, 0x9b512dd4, 0x00fdbb27, 0xd451c4eb, 0x53862d36, 0x2b861869, 0xb6ea2a00, 0x63b8806f,
+    0x038b14c1, 0xac8c6300, 0xe5430031, 0x421919bf, 0x8e73483a, 0x3a5b822a, 0xa6d00d1b, 0x5e747704,
+    0xeccd8154, 0xd4315286, 0x09640fb2, 0xe4714250, 0x0cab0800, 0x36b2b0e1, 0x9cb333fe, 0x4eb0c6d6,
+    0x5be043c6, 0x2d5bb25b, 0xfcc2860d, 0xa84d59f6, 0xa766d2a7, 0x54888245, 0x8c1025ed, 0xbd308845,
+    0x75f47f36, 0xc52600d8, 0xa652b837, 0xbaebf030, 0xce11f1da, 0xc5723a70, 0x1423996c, 0xa52d385e,
+    0x9648400d, 0x82af79fe, 0x444027ad, 0xd7a83096, 0xb98c3ca3, 0x992c1179, 0x32462c81, 0xc19c01a7,
+    0x4f45b37c, 0x49806ebb, 0x02aa3c67, 0x31061489, 0x930a7f2d, 0x61d4554d, 0x0f4c3ce6, 0x28246740,
+    0xb187019a, 0x23fc4882, 0x52aa5a09, 0x1ce9a514, 0xa063bbc5, 0x71178c08, 0x298a7bd2, 0x8d527b46,
+    0x380a53f3, 0x9efa6102, 0x2cb4e515, 0xfa27629a, 0x04e0c4e1, 0x3077020d, 0xbaca9793, 0x943b3855,
+    0xc3b65eb4, 0x43b84ce3, 0xfd8ae06c, 0x89001126, 0x2a9d7112, 0x58622132, 0x0d469dc3, 0x0d108b3f,
+    0x540db6ce, 0xf8721a47, 0x882b2742, 0xc4237f9f, 0x901ee800, 0x1398f4b8, 0x8c77c442, 0xcc1c2d23,
+    0xa3344e4e, 0x866eaab1, 0x1c9eb724, 0xfacf2658, 0x025e5d37, 0x62bb622e, 0xba82e870, 0xb45eae74,
+    0x39aab90f, 0x8ace257f, 0x9d6d2525, 0xc1d92f75, 0x944942c1, 0x6db79b8a, 0x1a29c9cf, 0xeca2d988,
+    0xf1e48d76, 0xb8316467, 0x60650ed2, 0xf77b4130, 0x6cdb8a61, 0x243e59f5, 0x081205d1, 0x6b93cb23,
+    0x1b446c1d, 0x7446a706, 0x901a2765, 0xc851617c, 0x1932f5c5, 0x7816001f, 0xa9ae22a8, 0xb4bc093a,
+    0xedf10108, 0xca05261c, 0xee100004, 0x767b1421, 0xcde20804, 0xb6ac4028, 0x08eb53a2, 0x40702456,
+    0xa59c30c7, 0x713dee77, 0x1756db73, 0xeccd6e04, 0xaf4fa756, 0xdd794ef7, 0x8923c173, 0x69df3f8c,
+    0xb36d61c2, 0xa0df96d8, 0xa0029741, 0x0c00a209, 0x9858ac6b, 0x88931550, 0x44a00663, 0x06ce94b6,
+    0x051eb331, 0x6f50fc93, 0x6b6193dc, 0x4417ea4a, 0x44a98c9c, 0xabae5c67, 0x234009b1, 0x94551e08,
+    0x6b7223bb, 0x66e67961, 0xd0b69a30, 0xb86343ad, 0xa2ce88e5, 0x3fc6082d, 0x0850f106, 0x7c1933ce,
+    0x45875367, 0xc0ee2ed4, 0x718ca7b5, 0xe65a8f39, 0x59b5447a, 0x06875006, 0x266ffb23, 0xfde91990,
+    0xa3a82773, 0x761a6647, 0x7364a9a1, 0x3223d94a, 0xb0000022, 0x00d524f0, 0x80903a79, 0x357a523e,
+    0xaa3584b4, 0x8bf2a873, 0x0477dbb8, 0xb5a2e8b2, 0x8448eaf4, 0xca93ac14, 0x009676ca, 0xce8b8b44,
+    0x30f22325, 0xbc45c831, 0xe22e905f, 0x56205dde, 0xa49c7560, 0xbc4b0897, 0x45189914, 0x877936c1,
+    0x7741b8dd, 0xab5f3780, 0x08369f0b, 0xe2dc76eb, 0x935f9856, 0x88f5ef05, 0xb15974d1, 0xcf67765e,
+    0x4b234003, 0x5677f7e2, 0xba303087, 0xbd9b6691, 0x0b99d8c1, 0x9fbe6e80, 0xf1c6f080, 0x5b08bc6e,
+    0xbe090520, 0x4cfce6e6, 0x2c14c8d2, 0xbc0eb6c0, 0x9fe189aa, 0xfb02ed18, 0x6042f68b, 0x7f742e0c,
+    0xeaf9ad65, 0x203b39d0, 0x20035ca2, 0x9b43982d, 0x0336a115, 0x0084b830, 0x6f4f2bc9, 0x840592cd,
+    0xa40aa684, 0x1f999080, 0x0f2ae6a2, 0x030d915a, 0xecae3dd2, 0x9109bd33, 0x42e80864, 0xbaf65e76,
+    0x6cf7a031, 0xe578e190, 0x3022a009, 0x0033595e, 0x6d5ae29c, 0xb439ace1, 0x8704374a, 0xaaa0d2d1,
+    0x2e579512, 0xf91516ad, 0xa956d443, 0x3a6460a0, 0x48362c94, 0xa5434ee7, 0xa18c485a, 0x61f24c34,
+    0x3441afd2, 0xcd7dee95, 0xa1e776a7, 0x271dc57a, 0xd0004959, 0xb1b23b76, 0x02faa6df, 0x9916e889,
+    0x4a84435a, 0x07f4203b, 0xc0697335, 0x9a9e4274, 0xbd20196b, 0xf3795b70, 0xc96f86c1, 0x2ab43633,
+    0x866e3b07, 0x19833f12, 0x5915a0f9, 0x92db7715, 0x5e50318f, 0xa68c2544, 0x012219e2, 0xde5f9594,
+    0xbe426f40, 0xdb150f83, 0xd2772fe6, 0xf3e4bc64, 0xb046eb07, 0x8a9a6aaa, 0x4571c950, 0x05328165,
+    0x9ae2c0f3, 0xea3bd230, 0xd98e6ea0, 0x73fd56e4, 0x7085623d, 0xdab6ab50, 0xd5231934, 0xe836e10e,
+    0x8e054c02, 0x1b9f74f2, 0x4b643af0, 0x7f018ca1, 0xc083871b, 0x64c08e1c, 0x880009b4, 0xe25e6219,
+    0xde63db00, 0x9a6e3396, 0x1e30139c, 0xce9ae533, 0x2613dd36, 0x20a0a073, 0x033a6b3e, 0x4c774516,
+    0x040187ee, 0x050f47f7, 0x8a4a5600, 0x03732290, 0x4b28f0eb, 0x57322898, 0x204e0e00, 0x1d2560c7,
+    0x20ec0d62, 0x6f1cc51a, 0xc2c8361a, 0x8005a053, 0x24516372, 0x3f05cb47, 0xab89838d, 0xb867370a,
+    0x99bcee17, 0x50521cb9, 0x9b77ccb8, 0x2ab036b1, 0x92da5d93, 0xee9a4743, 0x04be8001, 0x4fbbe55a,
+    0xdd80c4c8, 0x2367f239, 0x3b1f2568, 0x174b56c0, 0xb70d612b, 0xa6cc977e, 0x7dde2109, 0x005c523e,
+    0xc1c97304, 0x6b182df7, 0xa9623faa, 0x79f59c88, 0x98fba0d3, 0xc8e96ec7, 0xd26af812, 0x121818d3,
+    0x2bb3fc5b, 0xc72e989a, 0x4a503613, 0xf2930f21, 0xd4f52ff7, 0x4df60948, 0xa40049e4, 0x523a8ff7,
+    0x7ff8b872, 0x7491e6e4, 0x50bcaa60, 0xbdd1cb0a, 0xc28a413b, 0xbaa71778, 0x747297c7, 0x3435d3a8,
+    0x111cd49b, 0x4e1a2582, 0x89a45f4c, 0x4ddea24c, 0x20c34e00, 0x6b334771, 0x875e2c49, 0xb8974332,
+    0x8e9a8b05, 0x92c45858, 0x28f11816, 0xf7297081, 0x14c10999, 0xce2d867f, 0xb374dbb1, 0x60f5109c,
+    0xc07c39db, 0x072f58d3, 0x36dc826c, 0x7fd69b39, 0x78089db8, 0x43c2719f, 0xf27cc2c3, 0xc76ca042,
+    0xa81a43c4, 0x684ec6d0, 0x90f1f983, 0x73689472, 0x8090287c, 0x87020e36, 0x775a5036, 0xc904e5cb,
+    0x5b5314ac, 0x72484cf8, 0xf6a855d2, 0xb819f2dc, 0xf3494de1, 0x9a4c777e, 0x0ee168df, 0x17973e33,
+    0xc4b91d90, 0xfdc883d6, 0x1dc2f244, 0x831ef880, 0xe48acd9a, 0x550473da, 0x02460900, 0x666ebf4d,
+    0x0050b945, 0x79524521, 0x0f68fb9e, 0x7d0f86a1, 0x8330c529, 0x2b6a7f6b, 0xbfaa1f6a, 0x13c30b74,
+    0x272f3d6c, 0x00493bd2, 0x56a0f100, 0x601f5451, 0x8184e125, 0x3a1d80c4, 0x2ba03103, 0x4c8586a4,
+    0x079326c3, 0xbcff1673, 0xf140962d, 0x21686cd1, 0x377cc8fb, 0x9701ded5, 0x90e49236, 0x785e1e81,
+    0x6c931356, 0x67192916, 0x27344013, 0xa6b1777a, 0x4509718e, 0xa613a914, 0x7264a1fb, 0xd30c70c9,
+    0x49a0d1e2, 0xdb570dd6, 0x242ca218, 0xc6963ec5, 0xdb345778, 0x9b0ac215, 0xd67ef3c6, 0x33997599,
+    0x7c1a20c2, 0x9e4672e4, 0x3972cb62, 0x115bc578, 0x83b74cd6, 0x1433f90e, 0x37e0914f, 0x36b7c593,
+    0xe140588d, 0x179c4f62, 0xfe0604c0, 0x57b81028, 0xdf3591c8, 0xb2032076, 0xa5d26596, 0xc73f9791,
+    0x657a0a82, 0x9af761a6, 0x94265654, 0x0e174640, 0x91b00008, 0xa78df4d2, 0x24000907, 0x4b875736,
+    0x273ca336, 0x3c48c92a, 0x7b21457b, 0xd72b3a31, 0x343404c8, 0x2c17253b, 0x20b00000, 0xf22dd6be,
+    0x8f610d3f, 0xf8c7c28c, 0x9e5f2898, 0x604581df, 0x993621bf, 0x10b47570, 0xfd153bcf, 0xe305784d,
+    0xd00b4ada, 0xe70f3730, 0xdc807471, 0x6fadfb27, 0x906c3df9, 0x25b09b54, 0x4e2b4dd7, 0x00000660,
+    0xdaa55d38, 0x5067fd7c, 0xe918632e, 0xec20b19f, 0x6004b1dd, 0xf909cbc7, 0x2ce91ad2, 0x57787487,
+    0xba766640, 0x304ecf71, 0xde00000c, 0x1b708112, 0x107c3d9b, 0x68d0c000, 0x601df6f1, 0xd64c5a43,
+    0xe5073ec2, 0xc601f27f, 0x8e3cc03e, 0x6859efa9, 0x4270b353, 0xc4180a33, 0x2aa0f52c, 0x02502000,
+    0x0a003f4b, 0xa64dfbe6, 0x5553ccae, 0x21902c12, 0xfac00304, 0x0045cd9a, 0xf3a49380, 0x05178f1d,
+    0x13064f81, 0xcc5a37c9, 0x155e6369, 0x35c00000, 0xcf7bf5b3, 0xc88b581a, 0xc118a043, 0xd529a20b,
+    0x6692dd78, 0x48431145, 0x4a9eb359, 0xb14464bb, 0x361b82fd, 0x857c1c34, 0xd9ba151a, 0xe52796a4,
+    0x495c8421, 0x6a7c67e3, 0x554a1b77, 0x45aab1d8, 0xd0a4400e, 0x29fd1d03, 0x8727af70, 0x2ff98ae2,
+    0x0594a7d4, 0x93607ffa, 0x07140a98, 0x0008b204, 0xbd81b200, 0x941b4de5, 0xa6ac922f, 0x50515b44,
+    0xf9b46744, 0x67d16283, 0x669584da, 0xd87d2fe7, 0x93b61905, 0xb620af81, 0x63281584, 0xe8f9b60a,
+    0x843ca5b6, 0xf5aab1a3, 0x934d5a22, 0x2a7e6e4b, 0xb52ab770, 0x64daa9b6, 0xfb515a1d, 0x0e47c723,
+    0x0649f1e0, 0x49f4d3bd, 0x6d73197f, 0x241a3ff9, 0xa70a083d, 0x94512a2a, 0x0446622f, 0xc03ae22e,
+    0xb2298013, 0x82e6f9c2, 0x50182b83, 0x6ee11069, 0x02c00000, 0x905e5059, 0xb1cb4019, 0xdc181965,
+    0x6aadf83f, 0x7bc0a62b, 0x549c2101, 0xaaec9795, 0x08596928, 0x7bea1354, 0xec400006, 0x72d4ca24,
+    0x6c7d203f, 0x7de08044, 0xe8f74aa5, 0xac243434, 0x8787118f, 0xa000030a, 0xe46b451a, 0xde62624d,
+    0x8201a68e, 0x5f3ea1c4, 0x01360f2f, 0xe3100000, 0xb62b5d1f, 0xa193dfa5, 0x908f9093, 0x62bd46a1,
+    0xbb79dc3b, 0xd5c41d15, 0xc89967f8, 0x15b6ae36, 0x5fe93da4, 0x90184df4, 0x7b305286, 0xa48a053f,
+    0x213b179b, 0x5a9c3585, 0x6c0f333c, 0x93b112af, 0x7d816fde, 0xce9b673d, 0x1aa25dae, 0x20e00001,
+    0xf17e3598, 0xb625a982, 0xa8e696c3, 0x8f329adb, 0x2ce1b2ba, 0x646c998f, 0x7e71262c, 0x65aec601,
+    0x92eebb38, 0x183c8149, 0xe214b904, 0xf47f2530, 0xd4c55192, 0x0050d85e, 0xdaf38000, 0x8744f8a9,
+    0x88477beb, 0xa1ae8917, 0x78a5031a, 0xb3bc191c, 0xe78c28a7, 0x6e7b7a71, 0x12924849, 0x4916733d,
+    0xae3121ca, 0x74a48da5, 0x22129a58, 0xdf34d9ca, 0x77220b64, 0xbe95d338, 0x33088612, 0x7a585bc4,
+    0x22e8ef9a, 0x780a3c47, 0x8513fee1, 0x95ec52a2, 0x6681666a, 0x309c0fd8, 0x03cb2ace, 0x31b3d095,
+    0x783d8853, 0x228e2af2, 0x53a745c0, 0xd557f9a9, 0x9af8fc83, 0xe72c35aa, 0xc131224b, 0x3b4aeac7,
+    0x6bea4ea5, 0x9235b550, 0xb32baa22, 0xb2633519, 0x976db082, 0x83ef0fdf, 0x5acb7678, 0x6adb90ef,
+    0xd0a5ed29, 0x5d2a247e, 0xdc6f5fac, 0x741f417d, 0x783f1615, 0x22397969, 0x238b3c13, 0xccca7bd8,
+    0x4aa030a9, 0x2372e5e4, 0x9482b000, 0xd84201e4, 0x3d019bac, 0xce04d4f4, 0x50f125bc, 0xbc402c6c,
+    0x5df7040a, 0x5297c23c, 0x85c0774f, 0x1227dba0, 0xcf704c00, 0xea22c4d7, 0xb2965a99, 0xb3c173b4,
+    0x951de6f9, 0x3002f45d, 0x0b162230, 0x3aa60014, 0x5c5007ce, 0x29dfa0df, 0x64824dfd, 0x3438f838,
+    0x901f7ac8, 0x56dc0f51, 0x4cce03fa, 0x4fc25625, 0x515807ec, 0x33116b5e, 0xf0cd5049, 0xe56d0ea1,
+    0x4e56b96f, 0x00000184, 0x3422e4c4, 0xd9270323, 0x8f4d5083, 0x9f745ee2, 0x4699e652, 0x1da73067,
+    0x6704a123, 0x61862772, 0xc0c63b0a, 0x560c3c83, 0x905f0946, 0x3869acac, 0x5e1d07bb, 0x3833379a,
+    0x748cc1db, 0x35b8b267, 0xe9838152, 0xcc43a5bf, 0x5c484900, 0xccf18a3f, 0x99333609, 0x89d3717c,
+    0xfe2dd3c5, 0x4b5de7c4, 0xd3108a03, 0x85317c17, 0x478b3458, 0x44931d44, 0x391b17a6, 0xa83143f5,
+    0x2266779d, 0x65a9bd76, 0x84394258, 0x0182e0b4, 0xa52d4080, 0x90bfb8bd, 0x6caa4150, 0x3164bc75,
+    0x529c73ea, 0x4783ce8d, 0x0007b234,
+};
+
+// 40 segments of 183 days, 12 coefficients per axis, within 8e-07 AU of VSOP87; 3468 bytes packed.
+#define EPHEMERIS_VENUS_SEGMENT_DAYS 183
+#define EPHEMERIS_VENUS_NUM_SEGMENTS 40
+#define EPHEMERIS_VENUS_NUM_COEFFICIENTS 12
+#define EPHEMERIS_VENUS_SEGMENT_BITS 657
+#define EPHEMERIS_VENUS_QUANTUM 1.66666663e-08f
+static const int32_t Ephemeris_Venus_Base[3][12] = {
+    { -3029924, -41693257, -39305999, -19585224, -6957279, -1935134, -393779, -71022, -18355, -3758, -653, -158 },
+    { -3689128, -41703310, -39391389, -19663401, -6819357, -1917954, -449108, -73226, -13019, -3781, -799, -159 },
+    { -220161, -2472879, -2331251, -1172528, -402671, -108592, -26754, -5443, -753, -173, -45, -10 },
+};
+static const uint8_t Ephemeris_Venus_Bits[3][12] = {
+    { 23, 27, 27, 26, 24, 22, 20, 18, 15, 13, 11, 9 },
+    { 23, 27, 27, 26, 24, 22, 20, 18, 15, 13, 11, 9 },
+    { 19, 23, 23, 22, 20, 18, 16, 14, 11, 9, 7, 5 },
+};
+static const uint32_t Ephemeris_Venus[822] = {
+    0x7286018c, 0x08e9d3af, 0xbe0d0117, 0xe2ba2e93, 0xecb56242, 0x891eb220, 0xbfc3d6e6, 0x5945eaa5,
+    0x92c7a34a, 0xfd6e52da, 0x78fc2356, 0xd55aa0db, 0x1ce9be8c, 0xc927b445, 0x2dddccf1, 0x3879577c,
+    0x8fc60563, 0x066cab31, 0xe1027248, 0x5304d205, 0x628eb388, 0xf851df6d, 0x144e3654, 0xd7000000,
+    0x3cba62bf, 0xa98311b9, 0xf556b03e, 0x96d14b88, 0x66865f67, 0x05c49233, 0x8777572c, 0xf8000002,
+    0x92e6ded5, 0x28a06fd9, 0x95ecdcc8, 0x2dbfcd95, 0xd38e0125, 0xe375df51, 0x27e5491f, 0x3fb7cec0,
+    0xb0936672, 0xc98c21c4, 0x842687eb, 0x2a0ac913, 0x0c19e865, 0xd94f90e6, 0xe37ab609, 0xc38c12e4,
+    0x771c4006, 0x81ed5e78, 0xb98bab39, 0x4a8927fc, 0x204d344e, 0x3a660854, 0xe58a1091, 0x13555973,
+    0x8f1e6878, 0x2e154f84, 0xb81136c7, 0x022586ed, 0xaa045c23, 0xba1cd300, 0x828c96a5, 0x7cc6b642,
+    0xee0cf91f, 0xe9b48c1e, 0xdaa81e1c, 0xc55862f2, 0x25f2e065, 0xae4337f1, 0xd6eb1aa4, 0xaa450897,
+    0x97079aaf, 0xecf92d43, 0xf90c878c, 0x15e482d6, 0xe1162321, 0x475bb5be, 0x1e6e5c33, 0xbc1b5987,
+    0x208463aa, 0x08976912, 0x09cacf02, 0xbb01dba6, 0xf8865604, 0xc68ba475, 0x341dbe9c, 0x44ce2551,
+    0x023b3af9, 0x881825c0, 0xe2957542, 0xe0721350, 0x098aa59b, 0xab9db1e0, 0xd212082a, 0x4779b055,
+    0xc400a573, 0x570d2ead, 0x12ad9e29, 0x870c0342, 0xe16a9629, 0x1d415642, 0x00079d30, 0x19f8e000,
+    0x00000029, 0x547c9864, 0x48cd22e8, 0x407e41f6, 0xe843370d, 0x2eb159ce, 0x21b5402e, 0x5db67dbf,
+    0x000009b7, 0xb1961700, 0x6bdc7e8a, 0xe839fcf0, 0x2a428108, 0x2fe4038e, 0xd68b51bb, 0xe718b8ce,
+    0x83804c6c, 0x22c1d37b, 0xa8c43355, 0xe810b3e0, 0xda9a034b, 0x9bc17f0f, 0x05d7409e, 0xe6de93b2,
+    0x1d849dcf, 0x6e7bb23e, 0x1bc0ee4a, 0x63564dc5, 0x244b4643, 0x8f2fc24b, 0x9afa0772, 0x43097867,
+    0xd1b732c2, 0x050a3288, 0x42f54bea, 0x8df1a503, 0xfc2c0fc6, 0xac2a8b14, 0xce408139, 0x13916b04,
+    0x32892b6d, 0x09b7310e, 0x8577a888, 0xc04807e4, 0xa12ccc95, 0xd9f81201, 0x8c6370d4, 0x055cd0e0,
+    0x71a16639, 0x19bebfda, 0x3a0cab01, 0x76937224, 0x0e2b6ddd, 0xf2f7e000, 0x2e0963d9, 0x0385cbeb,
+    0x41f5884c, 0xe1962808, 0x88f6582f, 0x10c3439a, 0x620ce47c, 0xc8c45414, 0xdf1209c9, 0x82b3b3b4,
+    0x6958f403, 0x0a2d90bc, 0xb2b80003, 0xb56246d9, 0xbe7cf4fe, 0x2e7d7de0, 0x82442329, 0x401e40a8,
+    0x74798a06, 0x10f6e7ff, 0x2b6c1800, 0x637e020e, 0x806b0657, 0x4f078eee, 0x03cdb38d, 0x889cd800,
+    0x00c029de, 0x00006653, 0xfb975000, 0x96369852, 0x0069f2e9, 0x6ace8000, 0x7eb9f311, 0x38fb0c65,
+    0x28000009, 0x00139577, 0x510a0000, 0x9779325e, 0x00ed6c66, 0x1e816000, 0x7d077c04, 0x26c90a84,
+    0x8b293b5d, 0x825e35bb, 0xcde80ac0, 0x0554bd76, 0xefcc1400, 0x1071582d, 0x12f059ea, 0xa40332d1,
+    0x4f26d1a9, 0x26546795, 0x6ab8126e, 0x31fee26a, 0x34229373, 0x387323db, 0xb27239cc, 0x6062255c,
+    0xd0591289, 0x13a0f378, 0x2f190000, 0x4a4bbad4, 0x044d7136, 0xff787de6, 0x1c0e4ddc, 0x94ee9892,
+    0xb9c2f70d, 0x4c61a100, 0x72e06cec, 0x00e1d0bb, 0x5f0caa14, 0xdad7d4ec, 0xdb99c0ec, 0x7ec6dfb1,
+    0x8d11eb76, 0x55724c59, 0x548a35dc, 0x7b4bf1c1, 0x2c31e282, 0xae2900e4, 0x393a5654, 0x0e9c3df6,
+    0x4be2db55, 0x9931af4b, 0x84ae147f, 0xc0ccac6a, 0xace2cda5, 0x529ae722, 0x384a841d, 0xa6a451ac,
+    0xd4c87fc3, 0x26e01fa9, 0xc1e7f243, 0x2bef0b4f, 0xf7271b00, 0x7bac0814, 0x0994f1a3, 0x1e502c69,
+    0xd8fdad19, 0x86413d2e, 0xcbbc7536, 0x21554243, 0x6cdea6cc, 0xe40ae258, 0xfb016003, 0x791cbdd1,
+    0x80000d75, 0xb2e0337c, 0x29906b3d, 0xedbcb57c, 0x67bdaa1c, 0x5cfa4657, 0x80000004, 0xd1f204b1,
+    0x30321372, 0x493af288, 0x36a83808, 0x34000000, 0xc849f8cf, 0x09c54b34, 0xc0000030, 0xed16f90b,
+    0x0db8d3fc, 0x178bfe90, 0x86b3fd41, 0xb930309e, 0x70a3f972, 0x08c84619, 0x4593de5c, 0x6690e450,
+    0x088530f2, 0xbb654cc5, 0x3511c937, 0x58ccc74f, 0x2547eff8, 0x38586736, 0x555a6c40, 0x80a60abf,
+    0x0174695d, 0x6cf94ac2, 0x02c80aae, 0x2250d022, 0x8cd6d8dc, 0x30004fc7, 0xf2914446, 0x28ce2147,
+    0xc0853e23, 0x827ed1b8, 0x075c4c7f, 0x84b5a6bd, 0x2908cc1d, 0xe96a2500, 0x0146b1a9, 0x2be44c21,
+    0xfe821545, 0x71d98615, 0x135b4ff1, 0x3199f8a2, 0x482c41d2, 0xbd08d270, 0xb726345b, 0x617e956f,
+    0xf4192ac3, 0x9a496a20, 0x14c25775, 0xc789118d, 0xa759c80f, 0x33cd607e, 0x742f25fc, 0x583b194e,
+    0x413f5d17, 0x9abd5382, 0x6066aaa9, 0x1e1a5a9c, 0x13e5e69e, 0x9e119853, 0x07061958, 0xe229ba49,
+    0xbf3211a8, 0xf6c13382, 0x0d354a60, 0xed23d274, 0xdad8dddb, 0xbc43a2d8, 0x2ee5daa7, 0x81822a5e,
+    0x18f946ee, 0x098315c7, 0x09c20000, 0xc2560113, 0xe4071282, 0x0759f692, 0xd22cf71e, 0x47de10b2,
+    0x767f2a00, 0xddb8ddea, 0x10818140, 0xb17ca580, 0x5c103751, 0x960d42b6, 0x1f2ba059, 0xb18a1474,
+    0x07fec805, 0x91d93c05, 0xac0aea9b, 0x4b1d930c, 0x08374207, 0x705f20f4, 0x00b1629a, 0xb9a0869d,
+    0x663626d8, 0xc2248e96, 0x6831ef7b, 0x46264b67, 0xe04abf80, 0x80ac1de1, 0x9dab2ed9, 0x048f41eb,
+    0xa124ff96, 0x6e0995b9, 0x7e950502, 0xc778b5c0, 0x3326c768, 0x5f804b9c, 0xed84a26a, 0xd855a582,
+    0x40d44338, 0xf6a460b1, 0xbc38bc25, 0x868555ae, 0xa424db43, 0x9900230c, 0x0edb9d24, 0xc703e80e,
+    0x1a778698, 0x5351d9e2, 0x6d2e8c2c, 0x1ee1cba3, 0x98d96235, 0x0abe9e75, 0x103fe425, 0x00eca0ef,
+    0xf230e85e, 0xac451519, 0xd115b418, 0xa3b8c128, 0x1d4d3261, 0x50bc7082, 0x74184a6b, 0xf5492a89,
+    0xbaa5c5bb, 0xf1233f41, 0xb2340279, 0x95acea5e, 0x7130fa00, 0x6c9e2302, 0x29b42d09, 0x47b00a0b,
+    0x75f14aa0, 0xb5c16959, 0xf240d2f5, 0x4b6ec5b1, 0x10850024, 0x73bfed0e, 0x83595b0e, 0x5890d207,
+    0x69b03fad, 0x2c5a4800, 0x81096f77, 0x00000240, 0x8e2bf3ea, 0x6c38edec, 0x8f5a3640, 0x200fd844,
+    0x87a16e9e, 0x4db00383, 0x1811c562, 0x01a2cd8d, 0x41ed4000, 0x79faeec8, 0x86dd2029, 0x79b717ab,
+    0x47e9c8a2, 0xd10062ee, 0x84833b85, 0x9ccdddbc, 0x6929f017, 0x532a51ca, 0x10a06e96, 0x488eee0d,
+    0x8d18b2a8, 0xe58edf81, 0x1cd259bf, 0xa3e2d4cc, 0x1d97e5e7, 0x17edd393, 0x416d90f9, 0xa894341a,
+    0x16f6be92, 0xb2722805, 0xe4590e76, 0x68bc5564, 0x3d03d195, 0xf62aa2ab, 0x10705322, 0x7fec108d,
+    0x5252cae9, 0x497ee9dd, 0xd2f095ea, 0x59059dd4, 0xc9566f41, 0xf48de88b, 0x554f5843, 0x2af0d6bd,
+    0x67a5b995, 0x4d2212e5, 0xe6575929, 0xfe4f432a, 0x4d5ebf4b, 0x02da903f, 0xed7508bc, 0xb5c8ea48,
+    0x2188ab75, 0xc4816d62, 0x74eac5a1, 0x5c2e2110, 0x16274d1c, 0x30402c5b, 0x02d8b91c, 0x7dd53ec3,
+    0xcb5c9c02, 0xbcd8a2b0, 0x6c112284, 0x949add3d, 0xba6c71c2, 0xb216e4df, 0x904860fe, 0x2cb746d2,
+    0xe400a562, 0x9a010c34, 0x00526519, 0x3ab94428, 0x3d4ac449, 0x19e02f2f, 0xd3a83c52, 0xf0585254,
+    0xcc005901, 0x2899d5e2, 0x40126c47, 0x00002870, 0x0048e774, 0x4a3d8000, 0x118f0d69, 0xd804fb1a,
+    0xe61e14c3, 0x7a0316f0, 0xf00da29e, 0x201691b2, 0x353d94b5, 0x005df455, 0x1019c669, 0x00045d9a,
+    0x5eba79ea, 0xc90c8010, 0x032bbf4f, 0x72d291f0, 0x4d5e8848, 0x8005b6be, 0xfe0aa8c9, 0x99408402,
+    0x5f80dfbe, 0x28d0411f, 0x17c1a8ae, 0x5d0dba33, 0x600c3403, 0xfc0a7070, 0x28b6233e, 0xbe9cb21b,
+    0xeaf2cb06, 0xe582ae9a, 0x412f1c7a, 0x6acc3c10, 0xc21b161f, 0x12c8b0e2, 0x5e48685f, 0x0518801f,
+    0x3077b0d2, 0x3754b0ba, 0x00ec8f18, 0xdbe1b9ac, 0x0d5131c7, 0x4e1095a5, 0x3a94eccc, 0x50f69989,
+    0x35df76f6, 0xaa800157, 0x3dbd4be5, 0xcf339388, 0xea0b3f27, 0xd37c8c83, 0xb11fff07, 0x62013960,
+    0x1056f6c8, 0xc2d66dde, 0x8c857385, 0x95d0d793, 0x216b75c3, 0x28861d4f, 0x50461e8d, 0x3dc02d0e,
+    0xea624e45, 0xc8bbc40e, 0x2ac0799c, 0xed5e147e, 0x51fd0051, 0x26b7ae90, 0x551b4719, 0xe1dba0d8,
+    0x84a5a798, 0x046bc8ac, 0xfade7a70, 0xd9b7c929, 0xfb815acc, 0x498471a9, 0xf2c83fb4, 0x5c86dbd4,
+    0x94a956bf, 0x28a2957d, 0x2681b1c0, 0x12c1cce5, 0x272038f1, 0x32c89aba, 0x2000000d, 0xdc4268c1,
+    0x2b184f1c, 0x3bbe809d, 0x8f35323f, 0x80cdc688, 0xb1aac08c, 0xaa4e5b8a, 0xc143776e, 0x5e85103c,
+    0x10b1238a, 0x1d92d021, 0x8f003b3c, 0x671ec066, 0xc18b7809, 0xc9ff8dcb, 0xed25e1e6, 0x22b740a6,
+    0x6cf4a85b, 0x02c41a54, 0x6e82ed9b, 0x8481e505, 0x41a5ab80, 0x3276eea4, 0xe1de138d, 0xa6840f62,
+    0xf3d4800f, 0xfd1410a8, 0xd0a4d3c6, 0x65167770, 0x0cb0bc84, 0x97212ad2, 0x8d022c35, 0x1552df3f,
+    0x08f62d7a, 0x0743ef12, 0xf178795d, 0x4b095ebc, 0x05ac5256, 0x2e5efd28, 0xa9f86071, 0x1eafa48a,
+    0x9961f5dd, 0x58b738d4, 0x2c856276, 0x03298e38, 0xcf14905d, 0x13ba594c, 0x5267f0ac, 0x2ca317f4,
+    0x3120e7c8, 0x91249c31, 0x67e17e13, 0x29040194, 0x96da1ae6, 0xb8cc0761, 0x4c1eff84, 0x7b8804c2,
+    0xb48758c4, 0x30022608, 0x65cf9d8b, 0x907bbb80, 0x95284a21, 0x202d0096, 0x4b4b45b1, 0x0e0a30c3,
+    0x4508f8b2, 0x2000432d, 0x3f455e63, 0x60c4a00b, 0x68c4e0a1, 0x9af09874, 0x299d6c06, 0x9b4d5331,
+    0xc59021a1, 0x53e295ad, 0x6e52cbd6, 0xf8940186, 0xe3018970, 0x4027e008, 0x01e81042, 0x221d30be,
+    0x558c4181, 0xa2c6dabf, 0x008e07ce, 0x0ea3a5cc, 0x41d8b016, 0xff3d04e6, 0xde46fe46, 0x8d2acf24,
+    0xb803474f, 0x9a3289b1, 0x15030cb7, 0x458fd0cf, 0xf7722875, 0x3f863b54, 0xb46159d3, 0xa41ba925,
+    0x70289e71, 0x96e92f8a, 0x1b976758, 0x91b4628d, 0x2e49d8a5, 0x8a1814a0, 0xe1228c6b, 0x176cbd87,
+    0x0d098b11, 0x8c58065a, 0x3764def0, 0xaee831b4, 0x2cb3c203, 0x364bb833, 0x4ce20e52, 0x20d59536,
+    0x858d463f, 0x95394363, 0x8961866a, 0x8defd81c, 0xf8484067, 0x84c2b221, 0x7a2de4ac, 0x40801776,
+    0x2623d277, 0x39d27945, 0x703a7d9c, 0xde8bc0bd, 0xf0a1f0cc, 0xdc4ccd06, 0x314c1e83, 0x866d0705,
+    0x8e360285, 0xa5b06162, 0x117c27d8, 0x8c58a643, 0x4054da19, 0xd576c963, 0xdbe7280d, 0xe70f082d,
+    0xddecb94e, 0x52dce7f1, 0xf5284b82, 0xf13bc49f, 0x54602994, 0xf023f95d, 0xf96ae2a9, 0x37bab806,
+    0x5d1c56de, 0x78003c60, 0x8059f454, 0xc2faa595, 0x75c00601, 0x8f3c8db9, 0x89efd4b0, 0xaa0146e3,
+    0xcead4a5a, 0xb8996ed9, 0x0a484505, 0xa76aab80, 0x8001a746, 0xb311aa59, 0xeef174a7, 0x8f0124e7,
+    0xb3d5a4d8, 0x0c3633ea, 0x5b2dca03, 0x79d31e79, 0x68da021a, 0x5cec518e, 0x5500032e, 0xb0e27978,
+    0x01a8205a, 0x11fe0a9a, 0x6641ddfc, 0x579cd14a, 0x0047794f, 0xf5184e8f, 0x169f69be, 0x00220ece,
+    0x308e69fa, 0x2352062a, 0x45456702, 0xcd1c0dfb, 0x9802f6a9, 0x60536d60, 0x6c75228e, 0xec2eac58,
+    0x820f7827, 0x5e83a6b4, 0x3abae7a1, 0xfcf40a4f, 0x03fdc1a2, 0xec89b2c1, 0x3538bca0, 0x231b2286,
+    0x662f5d76, 0x32f210d4, 0x2f0cb34c, 0x733ad465, 0x33239fb0, 0xe074c404, 0x4c17a12a, 0x07601c7e,
+    0x4ec22a30, 0xf1ed71ec, 0xd6a28a76, 0x77b2d8b4, 0x10548a88, 0x161b746b, 0x9861e508, 0xd8ba2f61,
+    0xbb1cf2b0, 0x1df6a35a, 0x8f644931, 0x41720336, 0x1dd072ea, 0x7e982dec, 0x2e240000, 0x443fe93f,
+    0x118851a1, 0x5352f80f, 0x62d5c803, 0x0eb0ded1, 0x78a62316, 0xeaa37654, 0x673220cd, 0x50b2a317,
+    0x3d807e9d, 0xdbc0ceaa, 0xc3723938, 0x6583fc01, 0x92f21098, 0x00000054,
+};
+
+// 28 segments of 264 days, 12 coefficients per axis, within 1e-06 AU of VSOP87; 2084 bytes packed.
+#define EPHEMERIS_EMB_SEGMENT_DAYS 264
+#define EPHEMERIS_EMB_NUM_SEGMENTS 28
+#define EPHEMERIS_EMB_NUM_COEFFICIENTS 12
+#define EPHEMERIS_EMB_SEGMENT_BITS 544
+#define EPHEMERIS_EMB_QUANTUM 2.08333333e-08f
+static const int32_t Ephemeris_Emb_Base[3][12] = {
+    { -3114615, -52110847, -38987143, -16417539, -5194059, -1373539, -255097, -34775, -12722, -3296, -687, -150 },
+    { -4720001, -51826763, -39370556, -16569026, -4821106, -1274660, -309545, -52819, -8636, -2996, -766, -170 },
+    { -193, -4975, -3720, -1576, -497, -110, -17, -6, -1, 0, 0, 0 },
+};
+static const uint8_t Ephemeris_Emb_Bits[3][12] = {
+    { 23, 27, 27, 25, 24, 22, 20, 17, 15, 13, 11, 9 },
+    { 23, 27, 27, 25, 24, 22, 19, 17, 15, 13, 11, 9 },
+    { 10, 14, 13, 12, 10, 8, 6, 4, 2, 0, 0, 0 },
+};
+static const uint32_t Ephemeris_Emb[476] = {
+    0x5e9011a0, 0x7fc2bedd, 0xcc03af46, 0xc8596b86, 0xd648cd75, 0x9813b152, 0x2bade27e, 0x1c76cec5,
+    0x9111ef60, 0x3461166d, 0xdf67671d, 0xa4f90606, 0xd32ef040, 0x70f02568, 0x63526857, 0x06cf30cf,
+    0x5878db55, 0xac13ab19, 0x15e85cfb, 0x06ca6f5b, 0x4642c438, 0x2fb17731, 0xf1230e74, 0xadc7b005,
+    0xbadce6c2, 0x2917337c, 0xb8c47178, 0x66b2699f, 0xa29accc3, 0x94f9317e, 0x80677c53, 0xe1155d41,
+    0xdda97add, 0x4dca7468, 0xdf5f6637, 0x116cc313, 0x08b56132, 0x256aee6f, 0x0003540e, 0xf28b3600,
+    0x2912b4b2, 0xa3b94a0f, 0x45c5a4c4, 0x89096221, 0xfa530704, 0x729b32b6, 0x0410754e, 0x135d28fc,
+    0xd0f26f9a, 0x58e7644d, 0x6562b54a, 0xdec6e594, 0x353304a0, 0xec824609, 0xda239341, 0x98190b54,
+    0x82485e31, 0x61a9ec5b, 0x06f7d2b6, 0x54300838, 0x8fa43776, 0x3253a961, 0xec691c02, 0xc20ce685,
+    0x09ff485c, 0x137cb246, 0xf20c6470, 0x58755bed, 0xb4000000, 0x00e1d661, 0xb8e7527a, 0xc0d88ad8,
+    0xd006b460, 0x5e0a4473, 0x3f754549, 0x5c96c42e, 0x580616e9, 0x375654a6, 0x667bfde4, 0xa0d6a41b,
+    0x4e92ce75, 0xcc0a0001, 0x12a05b9c, 0x9017e2fd, 0x909b594c, 0x003273c5, 0x69280000, 0xee82a970,
+    0x13b60dff, 0x92e00000, 0xed8a4d3b, 0x40a03d71, 0xd13bc34d, 0x030959a9, 0xa1c00000, 0xdc2c3ffd,
+    0xa9d2d74d, 0xba54004c, 0x6e02b39e, 0x10767802, 0x71b092a7, 0x1a57326d, 0x4d684730, 0xbc51c9da,
+    0xd2efe013, 0xa67f6fd9, 0x61c677d1, 0xe021ca0e, 0x79f2c76a, 0x5f73186e, 0x6e2cff79, 0x0b15b9fc,
+    0xee5500a4, 0x7239e59c, 0x6e1ac536, 0xe9280f5e, 0xa9fb0583, 0x991b9630, 0x60b24876, 0x84216413,
+    0xf96f0898, 0x6ae38c41, 0x0e671ac1, 0x60b93c27, 0x48342044, 0x40eaa27b, 0x06b8f6cb, 0xb214f6e3,
+    0x25247082, 0x419d52b2, 0x67ad4081, 0xbba6ef1a, 0x4f263eec, 0xebf09e45, 0x49092eb4, 0x5c57bcbd,
+    0x28077034, 0xf210ced4, 0x589a518c, 0x81ad902e, 0x8d834197, 0x00a77881, 0xa2502000, 0x9f707e32,
+    0x805bf159, 0xb889e21c, 0x991678a9, 0x206decb6, 0xb57c6d38, 0x40d33bad, 0x69873486, 0x7da57102,
+    0x496c45a4, 0xbfd23200, 0x3cc05442, 0x6ffc6377, 0x20f5a878, 0xc8319cee, 0x3efac908, 0x022c17c1,
+    0xbe60e466, 0x5d02416d, 0x31441722, 0x5d751649, 0x50b2d943, 0x06e53d49, 0x96da6000, 0x907a0869,
+    0x33ef105d, 0x65f3331a, 0x8d5872a1, 0xc7beb6f5, 0xb9888315, 0xdfd0c047, 0x09787a91, 0x56375d27,
+    0x724bfc50, 0x1d2c3cc0, 0x552ef332, 0xef20a918, 0x840015ab, 0x4ec7d588, 0xbcc5e1b1, 0x07d137da,
+    0x9b5ac74f, 0x5ece0044, 0x5863bbae, 0x6485e226, 0xca8e60e8, 0xe497312e, 0x442a934d, 0xa0881220,
+    0x18000061, 0x2631aa70, 0x36ff0e8f, 0x40708cc6, 0xb79cc4f4, 0xbac77463, 0xa2d9c60e, 0x0098e8ac,
+    0xf0500e09, 0x4b744375, 0x97cf6efb, 0x944acb6c, 0xa1a0c696, 0x26c41db0, 0x74124cde, 0x8bd7de3d,
+    0xc8a06d92, 0xe370995d, 0x8a21d32c, 0xc9dc0733, 0x79e91a1b, 0xe18168f7, 0xa9585830, 0x458c764a,
+    0x42160dac, 0x2512a6fb, 0x7889160f, 0xf7b1a2d4, 0x1259e220, 0xad665476, 0xda593587, 0xa0470028,
+    0x270a7625, 0x0374d632, 0xd646cb03, 0x5614a092, 0x86bfa01d, 0x06216b78, 0x234ecaaa, 0x1e900078,
+    0xf2fcb5ab, 0x2bd59feb, 0x2e460fea, 0x0956d09f, 0xc0640a24, 0x65111652, 0x0f35ebcc, 0x0e331da9,
+    0x000008d8, 0xd4e1eb00, 0x80d944ae, 0xd4485b39, 0x54897b6a, 0x000000b7, 0xf33c7708, 0x04655fba,
+    0x00003bfc, 0xea51a480, 0xbc85ea3c, 0x2c514af8, 0x6458b143, 0xb4455089, 0x58462da5, 0x9f00a934,
+    0x98d95b2c, 0xad5a1297, 0x00000022, 0xfd553994, 0x7a3c9e7e, 0x6c953721, 0x7c876000, 0x80000000,
+    0xae108a71, 0xa4a07f4c, 0x40000027, 0x8e6aa89c, 0x66790c6b, 0x5a40b5a7, 0x379de11e, 0x88dd47c8,
+    0x08c1822d, 0x1f1010aa, 0x5eeaa68e, 0xda41de7e, 0x36c063a7, 0x1f60a020, 0x0e441ea5, 0xcddbf6fb,
+    0xabfc4273, 0x7cc0d303, 0x89ebabb4, 0xcd542fcb, 0x517f1089, 0xb45e99a6, 0x381e1125, 0xd775ac81,
+    0x2284f121, 0xb9e42ae8, 0xcc3a4010, 0xb27a80f9, 0xe43b0490, 0x13078c43, 0xdc23421a, 0x7f0f8d55,
+    0x3ef188aa, 0xbde2d526, 0xf15b32d0, 0x73bd8734, 0xb0e1d092, 0x9d3ad749, 0x874f1f9c, 0xe2e0f466,
+    0xc8538c1b, 0x5c71ca7a, 0x9892a4a2, 0xfd1ecea4, 0xa0d24ecf, 0x094f9f85, 0x1c28e886, 0x72191750,
+    0x2ecd347f, 0x17f7ceca, 0x41397a01, 0x2be1cee3, 0x9ea263f2, 0x656cef85, 0xcce8f0a9, 0xf0c92a3e,
+    0xdc527352, 0xd506d8e3, 0x58198d74, 0xc4914d7f, 0xcbac6da1, 0x9a2f2fcb, 0x854da0f6, 0x9391bc55,
+    0xa70f4f77, 0xb0092301, 0xb6eeb0a8, 0x60f1d7a4, 0x0cc53d8f, 0x802cecae, 0x221f0941, 0x9ff63abc,
+    0xa00071a1, 0x40e7604d, 0x72eea106, 0x460ca314, 0x625d86da, 0x9c50ade9, 0xce4b2181, 0x24d9a770,
+    0x74e305ac, 0xc49c9600, 0x2051e0b7, 0xa8ef4416, 0x55aaa0d9, 0x60486067, 0x44db8910, 0x32657e39,
+    0x00006bdd, 0xf44030c2, 0x28a25a94, 0xb26e062c, 0x6db0d396, 0x234a2a6c, 0xa7fafaf4, 0xa5e5a57e,
+    0x1b294602, 0xef28f8d6, 0xde468f2f, 0x644a2758, 0x09b2eab7, 0x545eeb54, 0x2223c626, 0xfd4125c9,
+    0x6cd2f702, 0xc26fe5d1, 0xe992467e, 0x9c66b346, 0x3b450c52, 0x58343dc6, 0x178077ef, 0x014deefe,
+    0xc4dcd258, 0x813e9356, 0xf2d6f886, 0x1604f370, 0x3894df51, 0x5608683e, 0x3810a55c, 0xa9577aef,
+    0x0fe77cdb, 0x211d2c19, 0x40aad462, 0x6d01007d, 0xd33a5097, 0x2153a728, 0x8c4d2a80, 0x6a2f6084,
+    0x721c013b, 0xd8810a08, 0x92593bff, 0x7ea000d2, 0xff8beb41, 0x4d400065, 0xd0dcd753, 0x1ad77359,
+    0x56c00e18, 0xc761442e, 0x0915604d, 0xd1ce0000, 0x0c77b4f8, 0xc8009400, 0x4af964b5, 0x16d7f001,
+    0xb9e87eb5, 0x0001b0ca, 0xca4ae000, 0xe6c4b65b, 0x2086370a, 0xce24b60c, 0x76335070, 0x663ef05f,
+    0xae32dc7a, 0x00148f6d, 0x3e770000, 0x126e471f, 0x6304c021, 0xe9d30d90, 0x021b0389, 0x15dcd200,
+    0xa4a00847, 0x7724c07b, 0x5d8b1009, 0xe41d2bb2, 0x8f7c5480, 0x53d94435, 0x1e38cd42, 0x448a4c79,
+    0x047d20c8, 0x5a456443, 0xd164c62b, 0xbcd0cef1, 0x88219d00, 0xba84ee62, 0x2eb4420c, 0x6d06a444,
+    0x464000b6, 0x5c07af05, 0x3905e51b, 0x3b4ce525, 0x782111d0, 0x812ec22c, 0x2df39681, 0x64930782,
+    0x9b315203, 0x99f23021, 0xf8452ff0, 0xec4af247, 0x2763fa68, 0xe03bf7b4, 0xb35577c2, 0x418131bf,
+    0x799d228f, 0x00273932, 0x416eb544, 0x8c4f94ce, 0xc02c457c, 0xb78063f0, 0x5ff68af9, 0xc4315c7b,
+    0x9b0e040b, 0x000ab5bf, 0xc1cc6e7e, 0x9cd9ca79, 0x62c36139, 0x18e2998b, 0x7038bf45, 0x0e7b3472,
+    0x56e56a6c, 0x3002005e, 0x6377b44c, 0x2a7210c6,
+};
+
+// 22 segments of 333 days, 12 coefficients per axis, within 1.5e-06 AU of VSOP87; 1864 bytes packed.
+#define EPHEMERIS_MARS_SEGMENT_DAYS 333
+#define EPHEMERIS_MARS_NUM_SEGMENTS 22
+#define EPHEMERIS_MARS_NUM_COEFFICIENTS 12
+#define EPHEMERIS_MARS_SEGMENT_BITS 612
+#define EPHEMERIS_MARS_QUANTUM 3.12499999e-08f
+static const int32_t Ephemeris_Mars_Base[3][12] = {
+    { -30733961, -53885324, -25202400, -7120739, -1005809, -226960, -114798, -27862, -5594, -1360, -573, -159 },
+    { -21255442, -52162722, -22465410, -7630544, -1748228, -249548, -36800, -29712, -7396, -1612, -409, -163 },
+    { -547973, -1698446, -679533, -186240, -62438, -11291, -1728, -833, -240, -56, -12, -4 },
+};
+static const uint8_t Ephemeris_Mars_Bits[3][12] = {
+    { 26, 27, 26, 24, 22, 20, 18, 16, 14, 12, 10, 9 },
+    { 26, 27, 26, 24, 22, 20, 18, 16, 14, 12, 10, 9 },
+    { 21, 22, 21, 19, 17, 15, 13, 11, 9, 7, 5, 4 },
+};
+static const uint32_t Ephemeris_Mars[421] = {
+    0xcedd07b6, 0x000da325, 0xcb0a8000, 0xb632d736, 0x4e284259, 0x725cff18, 0x9018c001, 0xc5521e6b,
+    0xd2d9b28a, 0x00002ca4, 0xae955100, 0x0001529d, 0x6dc886e8, 0x220018a1, 0x98a22ce0, 0xa0d4dd4e,
+    0x562860eb, 0x6ea59202, 0x77355800, 0x00000000, 0x3aab2bce, 0x115d7792, 0x290d9bea, 0x2945f040,
+    0x76b5a7b3, 0x9cb0b36b, 0x1aa5d1b4, 0xfc000000, 0xe5a23527, 0xf0558de9, 0xbec6a5ba, 0xfd347a10,
+    0x6b64c40d, 0x27600515, 0xb0301939, 0x09bf5f90, 0xc02caba3, 0x3d722f93, 0xd0f3e436, 0x9036c49a,
+    0x67813508, 0x45512933, 0x008df1d6, 0x73591800, 0x000907a6, 0x106fa25f, 0x794c6e45, 0x4ab698ed,
+    0x88fa80e4, 0x015b6d4a, 0xa0000164, 0x28fd48f1, 0x61173600, 0x4664bc07, 0xb11599ac, 0x64bb30f3,
+    0x31e0f193, 0x275851be, 0x86f04141, 0x555792d4, 0x115c3bcf, 0xa65d8c2d, 0x34a1b3bd, 0xc6a9cb4b,
+    0x1db6d50c, 0x0a02085f, 0x99cb3f90, 0x9c65cc0f, 0xe6a7d0f5, 0xb5389316, 0x28c0ee33, 0x70aef59b,
+    0x2ba202b5, 0xba1c6054, 0x2b57a340, 0x6eb163f0, 0x5145373b, 0xaa050eb9, 0x049f6ef2, 0x369c27bd,
+    0xd8d93501, 0x9d7061e6, 0x334587f1, 0xd47b2309, 0x654f1cd1, 0xc017f9b8, 0x2985622b, 0x4541069a,
+    0x6d82ce31, 0x1b2a6a30, 0x5bdd0ad9, 0x2c1a5320, 0xe94fb39f, 0x967022e1, 0x0284a78b, 0xf713dc30,
+    0x23d3432c, 0x28340e65, 0x3c8a2f9d, 0xb6802f39, 0xae34bba6, 0xa12b7333, 0x69256ca0, 0x4e6ba343,
+    0x6792f41a, 0x55a814a9, 0x75a8fb62, 0x889526a6, 0xc6ae62b5, 0x3c2552f0, 0xab611f7a, 0xbef01917,
+    0xa2a455b4, 0xb3b404a9, 0xd247376d, 0x812a9727, 0x10d8d4e2, 0x10d0788a, 0x4b7288ad, 0x615fc114,
+    0xd520e861, 0xe3003019, 0x70b89868, 0x91813706, 0x8d2540c8, 0x7ee351dd, 0x2bde7f13, 0x220eb9b2,
+    0x003bf693, 0x7012e000, 0xe2b6727b, 0xc00002ca, 0x42a5f257, 0x76d20074, 0x6645fc06, 0xd83646af,
+    0xd6d8dce9, 0x802fff6c, 0x365646f0, 0x0bbd3242, 0xa56464a0, 0xec26ede9, 0xab643071, 0x7ce6f10b,
+    0xab0293dd, 0x97174610, 0x6e4b35e1, 0x24e2f0d0, 0x0dcf7c4b, 0x50000035, 0xa66c2f2d, 0xe3fca7d8,
+    0x563470b5, 0x7e6b12a3, 0x6756c973, 0x06451132, 0xcf3af888, 0xb10b369f, 0x9d880002, 0x0a5ef9ec,
+    0x0c66187e, 0x0d353f0b, 0x6c26cf93, 0x810e5a17, 0x584ad0d2, 0x00035a04, 0x75f2c92c, 0x3b2006f5,
+    0xb4a3f2c4, 0x8a3ba7bb, 0x8fb938a0, 0x9862fda8, 0xc974d8f7, 0xa22c964a, 0x3a749cd7, 0x30606522,
+    0x9c06f690, 0xfbb08238, 0xfc48a4eb, 0xa9f8d194, 0xe24bc8ab, 0x70e8b95d, 0x0c2fdd48, 0xa365845b,
+    0xf8369a18, 0xbb14d7ad, 0x6776ca54, 0x0a6c3ebf, 0x7ba94c20, 0xda2647a9, 0x3673b783, 0x36185855,
+    0x584b7b02, 0x2d999d95, 0x84ac0256, 0x053c268b, 0xe0802402, 0x7d542430, 0x3c3b4137, 0x93216454,
+    0x6fd4c97e, 0x00002355, 0xae8993a0, 0x6cde642d, 0xd2c1d83b, 0xe0721f95, 0x69021dcf, 0xb46e8dae,
+    0xb06841a4, 0x0696546b, 0x7268f850, 0x17c1dd4d, 0xdc4202c6, 0x6edd6bc0, 0x66bf7c31, 0x2e4cbbaa,
+    0x54abcc13, 0x431e24b4, 0x6b95bfec, 0x3872c6d2, 0x9315088f, 0xe4dbad18, 0xb81419c6, 0x30dacd6a,
+    0x69fa1513, 0x4948299d, 0x2304403a, 0x2542ad47, 0x72b9139e, 0xfea844bb, 0x597c05f9, 0x22d00539,
+    0xd2800000, 0x273187e4, 0x9b450253, 0x2be60001, 0x46d269fe, 0xc3bd241c, 0xd7f88db0, 0x87afd27c,
+    0x4ae8c02a, 0xce9b7dca, 0x80009ffd, 0x40908d2a, 0x81839101, 0x11b4a441, 0x00331e4d, 0xee2e43c8,
+    0x796618e9, 0xee5211cd, 0xda051608, 0xcdb23a7b, 0x30063485, 0x33bfbee6, 0xb14be72c, 0x18d4fc60,
+    0x03b4edb5, 0x3a53928f, 0x54ba4ff0, 0x23872857, 0xea99e5c4, 0xdcccc13a, 0x6b75731c, 0x50fd9956,
+    0x4b4091af, 0x2db1519c, 0xbb7342a5, 0xdc35c06c, 0xbd8db85a, 0x44ced9e9, 0x80cafd2c, 0x9204c1aa,
+    0x95893b00, 0x560eeada, 0x708366c5, 0xc57807fb, 0x13bc8e40, 0xbbe015d9, 0xa6615390, 0x1a8dda1d,
+    0x42ff8606, 0x86678fe3, 0xfba5426e, 0xc496e840, 0x04bdc588, 0x61219800, 0x94028bf5, 0xc15655ce,
+    0x458200d6, 0xf1f68b66, 0x363bbf35, 0x4472e537, 0x4b7a2ac8, 0x95942aba, 0x0a6e4494, 0x163eb4de,
+    0x5af3d813, 0x333b26cc, 0x1869e384, 0x0bf8bf1d, 0xe54b04e2, 0xeb4d3cfa, 0x311266d8, 0xb4cf952d,
+    0x62b8a688, 0x274064bf, 0x75732caf, 0xfed9f7af, 0x4a9a3580, 0x02592904, 0x98e6d1c0, 0x4623dfe5,
+    0x7b48e2be, 0x8c000000, 0xb48bb23b, 0xb95dd82d, 0xc3308046, 0x9d9604ec, 0x3b15a8e1, 0x408cc8cf,
+    0x47e3f4d4, 0x873dd08b, 0x4df5d10c, 0x0b605186, 0x1c2c344c, 0x1ada5402, 0x10000000, 0xe2c2e92a,
+    0x48e08625, 0x6f83d070, 0x77aad149, 0xbbc8cf0a, 0x6dec7cf5, 0x00dbfd0c, 0xaf300000, 0x4ff7b3e8,
+    0xbf032597, 0x14451114, 0x733ee38b, 0x091ec524, 0xbd3cdfa4, 0x9c8dd6c1, 0xf3a9ebb6, 0xb6624451,
+    0x2d27c538, 0x1985f3ed, 0x77be10dc, 0xca4b89d2, 0xa0a46540, 0x2476554c, 0xb563ea86, 0x0528a65e,
+    0x293316e8, 0xf4557961, 0x637ecfc3, 0x5a000005, 0x1cfb30e0, 0x9bad974a, 0xa5c87d2f, 0x30783682,
+    0x5ded0776, 0xc8d2e7a7, 0x2b034e02, 0x30f91145, 0x06a7db9f, 0xd265b54c, 0x0b5e4749, 0x8200625e,
+    0xae034d87, 0xa4ec4899, 0xb4bbc4f3, 0x0303ad2c, 0xe0046ef1, 0xe11b62ef, 0xc3490964, 0xcc3b8e1f,
+    0xeed28a93, 0xfd17239b, 0x2e64de40, 0x069d1291, 0x2fddb54d, 0x6d47d0fd, 0xc1f749a7, 0x9c7764e8,
+    0xc5a5b338, 0x00109f92, 0x7f3c8000, 0x9fccd48c, 0xa6deb53c, 0xf89f44b2, 0xdc850817, 0xd1422f86,
+    0xbed6cbcc, 0x093a2798, 0x4ab86bd8, 0x6fd5395c, 0xda8737ae, 0x08000007, 0xe30364a5, 0x61c8b475,
+    0x32a70561, 0x44d27549, 0xd64ae32e, 0xe0a7be14, 0xf64d8719, 0x00007c59, 0x824f0d60, 0x0085fc35,
+    0x42e37437, 0x663eaab3, 0x23144928, 0x2acc8398, 0x2f73765b, 0xe584c4e4, 0xa48b2f52, 0x5973c4c8,
+    0xe85a42d9, 0x00038a99, 0x8aaf5a80, 0x46d00038, 0x00681a87,
+};
+
+// 4 segments of 2215 days, 10 coefficients per axis, within 1.9e-05 AU of VSOP87; 382 bytes packed.
+#define EPHEMERIS_JUPITER_SEGMENT_DAYS 2215
+#define EPHEMERIS_JUPITER_NUM_SEGMENTS 4
+#define EPHEMERIS_JUPITER_NUM_COEFFICIENTS 10
+#define EPHEMERIS_JUPITER_SEGMENT_BITS 461
+#define EPHEMERIS_JUPITER_QUANTUM 4.75000007e-07f
+static const int32_t Ephemeris_Jupiter_Base[3][10] = {
+    { -4705831, -8736611, -4765164, -1240722, -258325, -11143, -5767, -3147, -286, 17 },
+    { -3369209, -9946495, -3771016, -1360999, -306873, -41945, 2297, -324, -682, -104 },
+    { -63432, -226078, -87436, -26432, -5251, -1658, -129, 22, -3, -3 },
+};
+static const uint8_t Ephemeris_Jupiter_Bits[3][10] = {
+    { 23, 25, 24, 22, 20, 17, 14, 12, 9, 8 },
+    { 23, 25, 23, 22, 19, 17, 14, 10, 9, 8 },
+    { 18, 19, 18, 16, 14, 12, 8, 6, 4, 2 },
+};
+static const uint32_t Ephemeris_Jupiter[58] = {
+    0x00074878, 0x64030000, 0xe1a81086, 0x00000917, 0x50476078, 0xd21c42e9, 0x02248539, 0x55c00000,
+    0x3883d4d2, 0x60000000, 0x2e88e0de, 0x5bf74232, 0x80000631, 0x010353da, 0xa0d7d106, 0x504ed32e,
+    0x00010a19, 0xbc093800, 0x8ce99a2b, 0x02e80033, 0x26280000, 0xb244cc9b, 0x000b3d7f, 0x392e6800,
+    0x066c2aee, 0x00057020, 0x7a169800, 0x00516e6c, 0x01bb2000, 0x80ca0000, 0x355aa828, 0x007c16f6,
+    0x41411000, 0xb8c3b4f1, 0x5f3ba900, 0x74000000, 0x0e2b893b, 0x33d0ed14, 0xec02c008, 0x924e17da,
+    0x0069c839, 0x381ada00, 0x00cbd252, 0xbd96dc40, 0x003beac3, 0x5ac10000, 0x19095f81, 0x00000243,
+    0x4b108ae0, 0x76968105, 0x0d954f33, 0x28a00000, 0x972b3ea2, 0x1280000b, 0xced00000, 0x96ebf280,
+    0x03100036, 0x0001f3cd,
+};
+
+// 2 segments of 5252 days, 10 coefficients per axis, within 4e-05 AU of VSOP87; 266 bytes packed.
+#define EPHEMERIS_SATURN_SEGMENT_DAYS 5252
+#define EPHEMERIS_SATURN_NUM_SEGMENTS 2
+#define EPHEMERIS_SATURN_NUM_COEFFICIENTS 10
+#define EPHEMERIS_SATURN_SEGMENT_BITS 453
+#define EPHEMERIS_SATURN_QUANTUM 9.99999997e-07f
+static const int32_t Ephemeris_Saturn_Base[3][10] = {
+    { -1842541, -10257944, -1637059, -1032251, -45297, -56037, -7760, 234, 84, -84 },
+    { -5136532, -4040674, -4532299, -512012, -179312, 86, -10434, -1889, 1, 41 },
+    { -122026, -318499, -134004, -42722, -10317, -815, 56, -46, -25, 0 },
+};
+static const uint8_t Ephemeris_Saturn_Bits[3][10] = {
+    { 22, 25, 22, 22, 18, 17, 13, 11, 9, 7 },
+    { 24, 23, 24, 20, 19, 15, 14, 11, 9, 6 },
+    { 19, 20, 19, 17, 14, 12, 9, 6, 5, 1 },
+};
+static const uint32_t Ephemeris_Saturn[29] = {
+    0x0032ddad, 0x00000000, 0xfc704ce0, 0x000015ac, 0x57f60800, 0xe15ace40, 0x001cf602, 0x00000000,
+    0xd89e47f6, 0x70000007, 0xc0000798, 0xf8b28997, 0x00000010, 0x01b59c30, 0x98000010, 0x0be98af8,
+    0x00000315, 0xaff00000, 0x0000b92c, 0x000005c0, 0xe4000000, 0x6b0e0c71, 0x00000035, 0x65ac9d00,
+    0x56990001, 0x00000004, 0xa4bb4c00, 0x800001dc, 0x0000014a,
+};
+
+// 2 segments of 6667 days, 10 coefficients per axis, within 8e-05 AU of VSOP87; 242 bytes packed.
+#define EPHEMERIS_URANUS_SEGMENT_DAYS 6667
+#define EPHEMERIS_URANUS_NUM_SEGMENTS 2
+#define EPHEMERIS_URANUS_NUM_COEFFICIENTS 10
+#define EPHEMERIS_URANUS_SEGMENT_BITS 361
+#define EPHEMERIS_URANUS_QUANTUM 1.99999999e-06f
+static const int32_t Ephemeris_Uranus_Base[3][10] = {
+    { -7904974, -6219046, 8554, 16484, -16581, -668, -499, -177, -57, 30 },
+    { 880144, -6375207, -1094527, -11581, 2323, -2449, -250, -166, -79, -1 },
+    { 30755, -14340, -15528, -1676, -24, -8, -12, -3, -1, 0 },
+};
+static const uint8_t Ephemeris_Uranus_Bits[3][10] = {
+    { 23, 23, 21, 17, 15, 10, 11, 8, 7, 5 },
+    { 23, 23, 20, 18, 13, 12, 10, 9, 7, 4 },
+    { 17, 17, 14, 11, 8, 5, 5, 3, 2, 0 },
+};
+static const uint32_t Ephemeris_Uranus[23] = {
+    0x007917ca, 0x00000000, 0x17ed7e38, 0x0000137d, 0x2bf58ef2, 0x02e2b887, 0x00000000, 0x7dde7ea7,
+    0x00600004, 0xd56e3200, 0x80000058, 0x0000007a, 0x8e53d496, 0x000008ce, 0x1cc00000, 0x000001f1,
+    0x00000000, 0x2675c3b8, 0x00000137, 0x09f67000, 0x00012465, 0xffd00000, 0x000200a7,
+};
+
+// 2 segments of 7279 days, 10 coefficients per axis, within 0.00014 AU of VSOP87; 230 bytes packed.
+#define EPHEMERIS_NEPTUNE_SEGMENT_DAYS 7279
+#define EPHEMERIS_NEPTUNE_NUM_SEGMENTS 2
+#define EPHEMERIS_NEPTUNE_NUM_COEFFICIENTS 10
+#define EPHEMERIS_NEPTUNE_SEGMENT_BITS 312
+#define EPHEMERIS_NEPTUNE_QUANTUM 3.50000005e-06f
+static const int32_t Ephemeris_Neptune_Base[3][10] = {
+    { 3734382, -2872408, -294222, 6292, -240, 173, -433, -143, -46, -13 },
+    { 2623354, 1480772, -276957, -19835, -13, -513, 105, -201, -44, -14 },
+    { -236539, -38792, 8834, -208, -51, -12, -8, 2, -2, 0 },
+};
+static const uint8_t Ephemeris_Neptune_Bits[3][10] = {
+    { 22, 21, 18, 14, 12, 9, 10, 7, 7, 6 },
+    { 23, 21, 18, 14, 7, 11, 9, 9, 5, 6 },
+    { 12, 17, 8, 9, 6, 3, 5, 1, 2, 0 },
+};
+static const uint32_t Ephemeris_Neptune[20] = {
+    0x56fdb869, 0x000006f7, 0x00460800, 0x2afd5400, 0x51200000, 0x0acc7700, 0x0a7d8000, 0x5bf40000,
+    0x80000019, 0x00118071, 0x00000000, 0x54f28d48, 0xd7e48005, 0xcb800002, 0x000011dd, 0xb7500000,
+    0x30000002, 0x80000029, 0x00276460, 0x0000e014,
+};
+
+// 111 segments of 66 days, 18 coefficients per axis, within 1.2e-08 AU of VSOP87; 10262 bytes packed.
+#define EPHEMERIS_MOON_SEGMENT_DAYS 66
+#define EPHEMERIS_MOON_NUM_SEGMENTS 111
+#define EPHEMERIS_MOON_NUM_COEFFICIENTS 18
+#define EPHEMERIS_MOON_SEGMENT_BITS 720
+#define EPHEMERIS_MOON_QUANTUM 1.66666667e-10f
+static const int32_t Ephemeris_Moon_Base[3][18] = {
+    { -3889123, -4814628, -6513940, -8242725, -5726, -8236739, -10860746, -8938161, -5624453, -2919144, -1301751, -511206, -179783, -57350, -16774, -4533, -1136, -279 },
+    { -3885144, -4811578, -6514504, -8246122, -5724, -8240064, -10859197, -8935404, -5624721, -2920322, -1301565, -511048, -179791, -57374, -16772, -4532, -1136, -279 },
+    { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+};
+static const uint8_t Ephemeris_Moon_Bits[3][18] = {
+    { 23, 24, 24, 24, 14, 24, 25, 25, 24, 23, 22, 20, 19, 17, 16, 14, 12, 10 },
+    { 23, 24, 24, 24, 14, 24, 25, 25, 24, 23, 22, 20, 19, 17, 16, 14, 12, 10 },
+    { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 },
+};
+static const uint32_t Ephemeris_Moon[2498] = {
+    0x4d15a3c5, 0x15bc4117, 0xef703b92, 0xd6e0b24e, 0x21e514bb, 0xf307c8d0, 0x77368f9d, 0x88200aa7,
+    0xff961c7e, 0xb36c67d8, 0xc67840b6, 0x8d68077b, 0x530d5f75, 0xe56e0b5a, 0x4ad3cf96, 0xb3f8e5b8,
+    0x37c5b264, 0xcf89cc20, 0xcc5f081b, 0x57cc25f8, 0x928c88a0, 0x0dcf7741, 0x2d321944, 0x1813ea73,
+    0x2c605a58, 0xe0af2938, 0xbdca4c20, 0xd6c28142, 0x5333472d, 0x5dce9908, 0xa7c9d04d, 0x96b551a4,
+    0x7ce03fd4, 0x492de269, 0x364acfc6, 0xc2d0f4c7, 0x5479fb29, 0xde791667, 0x0e0d936e, 0xb1338213,
+    0xab32fcb9, 0x97e3411e, 0x53b02e07, 0x42af1d94, 0x8757dc11, 0x0300eab0, 0xc9079e31, 0x33ba6d80,
+    0xec2eb633, 0x291bdaec, 0x642824d9, 0x51c000ad, 0x59dabe52, 0x0b1692f1, 0x2085c228, 0x40494d98,
+    0xc5ec7f39, 0x330092d3, 0xfe3c3a83, 0x81c93380, 0x0975c03f, 0x43a478d1, 0x0732864b, 0x1583c05a,
+    0xe0f79914, 0x401c533a, 0xe632135e, 0x5bad0114, 0x3c9a86e8, 0x04d77317, 0x42ad67d0, 0xdaf9ef26,
+    0xeadbc4f9, 0xcb81940b, 0x5d64c3cc, 0x2b9f6131, 0x8e84d3b9, 0x6300fbdb, 0xed735f3c, 0x93ba94b9,
+    0x115f2e40, 0x76eeb389, 0x7ba7aa12, 0x106230f5, 0xffc48830, 0xe734480e, 0xf878323a, 0xd8f5791d,
+    0x16c27c52, 0x7ac63444, 0x3ea7dda4, 0x77f0020a, 0x836b81a1, 0xdac14ed5, 0x5b7bb7c0, 0x1cc252db,
+    0x361c9ce5, 0x46969441, 0xd8e4f2c5, 0x6ee06179, 0xcbf62725, 0xf35dcf03, 0x8c98b116, 0x5d25e0ad,
+    0x4560992a, 0x20672a95, 0xad38eb01, 0xb8537958, 0x45228f00, 0x1ea58810, 0x04b75556, 0x8977d039,
+    0xb87f2f22, 0xc8c56c2f, 0xb6a7f5f6, 0x4d60fc95, 0x509f1fa3, 0xa8ebd8c6, 0xa2811b80, 0x5bec1f17,
+    0x026a55f0, 0xde8234b1, 0x0584e5dd, 0xaf8a4e44, 0x84f980f9, 0x80f81c9d, 0x26329663, 0x0ca33876,
+    0xf529086b, 0xd49a28c3, 0x91ea5100, 0x37b9d615, 0xb00d9795, 0xc81cb5a1, 0x38005952, 0x20e2e5f3,
+    0xba4a894e, 0x8fe125d2, 0xf79323c0, 0x06f11383, 0x703b9249, 0x9fb3c76f, 0x01a9fec5, 0x9119da0e,
+    0x5f51c48c, 0x9d8def01, 0x67a18f11, 0xc2bd250e, 0xbb7456d5, 0xf802d0e8, 0x3aeb3a29, 0x8b6c1705,
+    0x2ecaf9ca, 0x40f62517, 0x0a29cf51, 0xbba8c4cb, 0x045ef108, 0xed81745f, 0x300c6402, 0xa1026c3a,
+    0x35d5d24f, 0xd5f4900e, 0x91e6a86c, 0x0217d917, 0xc9dd2670, 0x564679b0, 0x29c02242, 0xc3e7fde9,
+    0x995b40e0, 0xcceca909, 0xa25b0101, 0xa4031195, 0x00c442ae, 0x7c1b1c0e, 0xaa2e4284, 0x8116391d,
+    0x7af67fa5, 0x79e57df3, 0xc55c0057, 0x034c4628, 0x10f54cb3, 0x3e442c94, 0xcc5fe962, 0x1466403f,
+    0x80798e73, 0xeb1ac980, 0x0c3ad4d3, 0x301d23db, 0x6c47620d, 0x18088095, 0xe318de90, 0x2ea85254,
+    0x4948910d, 0x5e24a70b, 0xafcd967c, 0x27857f11, 0x80c803d9, 0x50a1b6c1, 0x07a92c0b, 0xc102dc26,
+    0x1dd85227, 0xf00684f9, 0xa24b8a0d, 0x8bcf658f, 0x180d3306, 0x13659430, 0x4a650b1a, 0x3c9363ef,
+    0x0b647c39, 0x3947264b, 0xd182389d, 0x3f50ba73, 0xdb971aa2, 0xfc1644b9, 0xb5dde398, 0x536e3109,
+    0x9590b40a, 0x642c3183, 0xf7c6a62b, 0x0985bb20, 0xc5ea4b48, 0x6f419809, 0x0c9af2d8, 0x515081dc,
+    0x129dcdeb, 0xcccc8ee1, 0x25db47e4, 0x7b1621c0, 0xbfcf47ed, 0xceb0e07e, 0x1b8178cd, 0x973eb763,
+    0x43858bab, 0x8a750563, 0xe78db3cb, 0x96e80c42, 0x82663088, 0x032f5f46, 0x344e8227, 0x4015e251,
+    0x8a147449, 0x982c54e8, 0x0f81da3d, 0xb7cc5cc2, 0x51587bb9, 0xb90a381e, 0xc4c8e803, 0x38235a00,
+    0x010ab749, 0x8abd4345, 0xe89501b2, 0x5c806c99, 0x41d14fe4, 0xb4e653c3, 0x410099f4, 0xf62ff3cf,
+    0x306361bf, 0x2ee32440, 0xc201d5e2, 0x462cf4f7, 0x620a1ead, 0x4a4d8e9a, 0x73600560, 0x48808f2d,
+    0xa6199a26, 0x9b776e54, 0xb7b02252, 0x4d69595f, 0x501c58a2, 0x562304d9, 0xd012523d, 0x4828bf38,
+    0xec48850f, 0x0d12d2f0, 0x2310241b, 0x9d097e98, 0x59218d32, 0xf867bb26, 0xd7fe22c0, 0xee8c0de8,
+    0x45744ee6, 0x107a1578, 0x6b0b4faf, 0x59618dd7, 0x74534193, 0xa9ea84d5, 0xb9b1c923, 0x3d8bf31c,
+    0x8c97c6da, 0x91d32f38, 0xf22770c3, 0xf1df770c, 0x7cef1544, 0x9ab1a9f4, 0x37618380, 0x006aadbc,
+    0x2aeb6ce9, 0x644b40c7, 0xd43330ab, 0xbe90326a, 0x9ed4c02f, 0x17656201, 0x68902765, 0x1032e2d5,
+    0x0bd84b94, 0xbf3f1e48, 0x22fb726f, 0xbed6d188, 0xb84f1028, 0x9cbd8147, 0xebb7dcb6, 0xaf939c62,
+    0x137dc604, 0xa2fa6dbe, 0x8916980a, 0x0101c9ad, 0x97cc9b7f, 0x2f174c81, 0xc3a0b603, 0xe8c60cab,
+    0x172aa82c, 0xad59015f, 0x29c62c90, 0x16729c24, 0x0f853e08, 0x40916278, 0xca433134, 0x4f81241b,
+    0x02db3e2d, 0x97485f82, 0x827c8080, 0xc317484f, 0x4b35aff9, 0xb7cac0b6, 0xa3f59443, 0xf039536e,
+    0x362d8310, 0x50550216, 0xbeaad765, 0x88d4e79b, 0xe3406b4c, 0x819ace23, 0x071e0609, 0xc94f010a,
+    0x7be5ffea, 0x24b4b172, 0xf1e4afc2, 0x5351318b, 0xb9771e54, 0xb20d1156, 0x8e9f24be, 0x13eb7abd,
+    0x3ad99db3, 0x0d6356f2, 0x9ef009ef, 0x26102f0c, 0x5c9878b4, 0x00ce8d24, 0x96fc9bf7, 0x77453852,
+    0x602c3d23, 0x0d8e013f, 0x020a2325, 0x827d2e08, 0xd9fcba40, 0x42c31255, 0xb8fc1ffe, 0x363ac500,
+    0x0b99f582, 0x23303a22, 0x4d3e2d55, 0x749fec02, 0x211b5e53, 0xe7e7e1c5, 0xc520592e, 0xac08cbb7,
+    0xaac2ba40, 0x89d46a56, 0x293d509c, 0x869c8550, 0x0538c565, 0xed635022, 0x709e3422, 0xc81bcf2b,
+    0xe5a44f79, 0x4e347b7a, 0x999ed8f8, 0x42391a4b, 0x9f5aec01, 0xad6bbae9, 0x049b864d, 0xbf020127,
+    0x0a7532dd, 0xe5890cf8, 0xd8ea8213, 0x01d6e99a, 0xf4adf859, 0x2b7bf255, 0x81a8ab40, 0x958bab44,
+    0x1047ba81, 0x6059bfc0, 0x1819ed9e, 0x980a451e, 0x3300a967, 0x1c661bf1, 0x6f340b32, 0x132abcd5,
+    0xc9cb2324, 0x05d04444, 0x8bb9ca40, 0xc9b649c5, 0xc164c346, 0xb756d388, 0x2632223c, 0x5e85e031,
+    0xe49f9d15, 0x053f2335, 0x285f543c, 0x0823686c, 0x50117b05, 0x0990de46, 0xbb48bbd5, 0x8366264d,
+    0x582303d1, 0x8c0a5ca6, 0x144f813f, 0x9c8f781e, 0xad606581, 0x5781678b, 0x560ecdbe, 0xf5136bf1,
+    0x0b97a8d9, 0x0135dd1a, 0xf25b8855, 0x5f5609ca, 0xa79013cf, 0xd8781378, 0x46564080, 0x045cad5e,
+    0xa5f67181, 0xd481c65c, 0x00717dad, 0x0a199af0, 0xc7bc4338, 0xc0a0e320, 0x0c262353, 0x9a1879f6,
+    0x950fe032, 0x01cd922e, 0x8cf41dd4, 0x4de02f48, 0x50f83ee1, 0x3a49a075, 0xc0de0d34, 0xcc984bf5,
+    0xacd9d403, 0x80353adc, 0x5ef958ef, 0x2be9038d, 0xe2c0c9e0, 0xaa3e4159, 0xdbc7da8b, 0x2d13236a,
+    0x75ee65fb, 0xaafabec5, 0x816d5fda, 0x411e945a, 0x648a6b9f, 0x75053976, 0xbdb659f4, 0xa80be545,
+    0xd79988cc, 0x89df6d92, 0x248fd830, 0x32ce10d3, 0xbde4340b, 0x0f1be2d4, 0x0dada03b, 0x7dc5f56c,
+    0xd82de859, 0xdf80dfdb, 0xeac6e2c1, 0x821285a9, 0xae08e6af, 0x5617230b, 0xfb140de1, 0xe5028202,
+    0x0c458aa3, 0x54b1b950, 0x471a1c4a, 0xc9715412, 0x8cc07cd1, 0x4118723b, 0x165ec1dc, 0xdc48526f,
+    0x845ec898, 0x7c4b55bc, 0x0d0d88c0, 0xd033fc1f, 0x6e80d13c, 0x04bf3441, 0xf3e2576c, 0x573502fd,
+    0x340dd63b, 0x159c06d3, 0x8143c08a, 0xb62cb89d, 0x9cdb0132, 0xa0b6194c, 0xefea9323, 0x1aa94c28,
+    0xd0810758, 0xd035db21, 0xd6619749, 0xd8876010, 0x6cdd9817, 0x91f05500, 0x81c2e8cd, 0xe7c0df6f,
+    0xa7c582f9, 0xde40be5b, 0x90758e62, 0x3804a8c2, 0xd8410ddb, 0xf3a6c372, 0x54d394c9, 0x2922d810,
+    0xf503572e, 0xf409f3d9, 0x61069f2f, 0x86522103, 0x14846b40, 0xf940faf7, 0xc6e097ab, 0x1d15f0d3,
+    0xa5e03c29, 0x9d5b1356, 0xb031a924, 0x5b22a8c4, 0x5e0f243b, 0xadc73d35, 0xe8de9e0c, 0x32bd5385,
+    0xe42649fa, 0x960b583b, 0x239d8af2, 0xa8aa6865, 0xb32b2986, 0x258baca0, 0x44885e47, 0x93c4f874,
+    0x05095dbd, 0x0ced1089, 0x7a52a790, 0x8a116402, 0x3b7b76e2, 0x280e473a, 0x479745af, 0xacd9ba88,
+    0x11c970e9, 0xe9ee46d4, 0x743311c5, 0x9d653f75, 0x28e2672f, 0x20363259, 0xa72c93f0, 0xe4478068,
+    0x54f6eca8, 0x1651d4a7, 0x95ae0019, 0x9add6e84, 0x53c014b5, 0xbd37e325, 0xac5bc731, 0x3b9a9348,
+    0xf47c9180, 0x7f1e8208, 0x3390951e, 0x773a80ac, 0x6c1d7db3, 0x7653f9a0, 0x0b4a4702, 0xa3474dde,
+    0x8a554805, 0xe3031071, 0xabd618de, 0xaa8b2282, 0xa0d335c4, 0xa853020a, 0x55ad1f06, 0x1119024d,
+    0x59aa98cf, 0x25ada529, 0xf8d4bc70, 0x40f576f7, 0xce75192f, 0xe101ef1f, 0x602941c5, 0xd9a78f03,
+    0x031880d7, 0x4259fcce, 0xfe38c9f4, 0x5be30131, 0x65f2df63, 0x206033a1, 0x7e2762c5, 0x1dc603d7,
+    0xc091e262, 0x5d5227df, 0xa3dfee88, 0x8d1b9cf5, 0x4674c72e, 0xc6f02088, 0xbb67251b, 0x1e4a61b8,
+    0x4e0c88f6, 0x44c16b7c, 0x6a7add58, 0xb1008e3c, 0x0c11bc3c, 0xa66800e7, 0x19fb5733, 0x3e24679d,
+    0x6a428bd1, 0x24d5148a, 0x4198ba11, 0xf8aa732b, 0x37327b93, 0x73845062, 0xdfb0b146, 0xb5a880a0,
+    0x81018ea8, 0x4060ed36, 0x58760dc0, 0x52c3a1c0, 0x5b43a327, 0x25dd1e80, 0x3f52f78f, 0xd5f01cb2,
+    0x0e8e3204, 0xf5a75a01, 0x961e18c5, 0x8a006295, 0x19002b33, 0x54e00ce0, 0x283fe4c0, 0x9e551ed7,
+    0x14589240, 0x11935440, 0xc5bcd571, 0x354e7010, 0x28cb3923, 0x473be627, 0xcda0bd7c, 0x4f027a07,
+    0xc07e7c3d, 0x0b631bc8, 0x9c459482, 0x0bab3774, 0x077bd6a9, 0x95b1ceb1, 0x11057e2d, 0xc2878bb0,
+    0x3463838a, 0x02fb1498, 0xb4a97318, 0x0a5ad775, 0xac2830ff, 0x92ba2db7, 0x8eade382, 0x5809a271,
+    0x482a1ca7, 0xe7f2149d, 0x2e01117b, 0x5d690178, 0xf0cd0d40, 0x16b3fb57, 0xabee8292, 0x44c52d25,
+    0xac37dfae, 0x0a4a4bee, 0x1124bc88, 0xdab2cc85, 0xf1628704, 0x1f69d040, 0x61505c19, 0xac40f57a,
+    0x536b5170, 0x9ee40a6f, 0x7a349bcf, 0x87d96287, 0xecc65268, 0xcade276c, 0xe01cbb21, 0x7c64a47e,
+    0x1841417a, 0xa7927b9d, 0x2aaecb80, 0x4e80a8eb, 0xb638c917, 0xbaf2426b, 0x9104a929, 0x0090a89c,
+    0x11d9e28f, 0x689089de, 0x23000940, 0xed682348, 0x9a51003c, 0x722331af, 0x29a40000, 0xff00d438,
+    0x4034fbac, 0x4d1812b0, 0xf40f43bb, 0x804b1c23, 0xeca5c54c, 0xa24c68f7, 0xd4c25017, 0x00cee232,
+    0x82f2b4ee, 0x170b31ee, 0xd5763660, 0x599780bb, 0x415f79d5, 0xc515dcb3, 0x4423d2f7, 0x2054415e,
+    0x4dd65006, 0x4579838d, 0xe250b5a0, 0xa5ea2a5e, 0x5fc6f823, 0xa4129fdf, 0x4acf30f9, 0x25c1be63,
+    0x024255dc, 0x171b83ee, 0xbf572b14, 0x4f0844f6, 0x9d8a99c2, 0x6012d590, 0x54f9870b, 0x88105596,
+    0x6a12ae23, 0xf22c0db9, 0x9e436dc1, 0xbd4221a5, 0x1021603c, 0xd404dc54, 0xde546810, 0x872107fd,
+    0xf8b6a6e1, 0x020f46ad, 0xce8be99c, 0x588a240d, 0x6d97a622, 0x05e86da2, 0x46048539, 0x7212b75d,
+    0xc8600ccc, 0xa7c11567, 0xfce318ca, 0x10e4c2a1, 0x1a5fa1cc, 0x8043f557, 0xd3b24912, 0xfd271f38,
+    0x43efc995, 0x11bdab3f, 0x22805a2d, 0x528d3112, 0x2440b6ec, 0x2316014a, 0x81ddeeb3, 0x144c02f3,
+    0x808aaf8b, 0x38aa0236, 0xf17e0084, 0x045641c7, 0x384631f9, 0x9d3115e9, 0x7f80717e, 0xe18e597a,
+    0x416ada79, 0x28025007, 0x30f29826, 0xb88d4fc0, 0x82af2a51, 0x92c46688, 0x06f98498, 0x99a125ee,
+    0xafc6ccea, 0xbb0fe341, 0xa5c1a0ae, 0xf0705318, 0x82fbc69a, 0x21d28db0, 0x0b051872, 0x8a38f266,
+    0x5fbe4e32, 0xd1569784, 0x35a1d1c0, 0xd8018383, 0xac189540, 0x9eaa87d2, 0xcba05ce4, 0xc548ff4d,
+    0xa04ca9a3, 0x602230b0, 0x500c2f99, 0x49a6bb15, 0x65376d0a, 0x491e740e, 0x2525f0f9, 0x258d5309,
+    0xd86e88e1, 0xc8e7b123, 0x915230c5, 0x581b4488, 0x43ac6eb7, 0x97319270, 0xfa879190, 0x04ce136b,
+    0x9092010d, 0x56110340, 0xbd202061, 0x4290c514, 0xfdc2049c, 0x73dfbe47, 0x21730912, 0xf1fbf697,
+    0x29700e46, 0x202865f6, 0x4fe30316, 0x0012b708, 0xbc4dbf88, 0x5a5c8027, 0xd57d5d26, 0x86937d5c,
+    0x8c631009, 0x205d771c, 0x3eb007d6, 0x9a3d235d, 0x1dfc42ad, 0x37e84d49, 0xc7fd56a0, 0x3f4fbf89,
+    0x62122019, 0x45400041, 0x2c634b30, 0xef54584f, 0xfb15fc00, 0x23955df3, 0x8b13f802, 0x1a84c00a,
+    0x0371164d, 0xa61ca984, 0x856dd578, 0x67c362a9, 0xc4af85ce, 0x7f5a0376, 0xa9882b0d, 0x38b1adf3,
+    0xdc643e28, 0x41718ae7, 0x5295132a, 0x9882f394, 0x1426c546, 0xc9c6c405, 0x8d788144, 0xc16daa0c,
+    0x6d3bcfb5, 0x025281cc, 0xdcef7e53, 0x5090c3d2, 0xbe1fb27b, 0xb3430598, 0xc248fcde, 0xda4f38ce,
+    0x248a717e, 0x525c5a6e, 0xab6e4867, 0xc4686606, 0xb56831b4, 0x1869e203, 0xa27c5f8d, 0x3771a95c,
+    0xb07e1c4c, 0x8d2a0b7c, 0x09ba1e3a, 0x2e644b2b, 0xb90e1a94, 0xe3e56168, 0x64f30dd3, 0x6384c488,
+    0x9d68f5f2, 0x40896132, 0xf763db2a, 0x6f437872, 0xbcb51e9a, 0x6bd08033, 0x805336ac, 0x14ccac60,
+    0xd6e9eb80, 0xb1440049, 0x1d7ca65b, 0x357e28c0, 0x73c4f8e9, 0x87a00942, 0x4fde3514, 0xf664bf00,
+    0x5420d63e, 0x3cc3e31e, 0x91000e38, 0x1b6bee0c, 0xa5b41340, 0x91d595d2, 0x0692d3ea, 0xac8a0260,
+    0x7642b578, 0x69395005, 0xeafc3e63, 0xc62e5222, 0x711d4508, 0x4fc8f83e, 0x99be09f9, 0x03445d3b,
+    0x99459303, 0xf1aa9578, 0x0b072701, 0x62c99d98, 0x1905c77d, 0x46858a74, 0x9c570543, 0x04640295,
+    0x64250d34, 0xa9418d35, 0xe2a79a59, 0xcab4b019, 0xcd1f2003, 0x11a97e54, 0xf03e0eb0, 0xb7d4541f,
+    0x2901918f, 0xfe6baa65, 0x3a678f77, 0x1a77b25a, 0x9cb3a20d, 0xc3d153a6, 0xabb5d55e, 0x5f9c4de7,
+    0x40ea4809, 0xfafbc50d, 0xc132f24c, 0x6039bf50, 0x5db1821d, 0x18c2a055, 0x37e04e78, 0x94e4b472,
+    0xb7a21c88, 0x06482448, 0x2143c109, 0x16f5a873, 0xd916fe72, 0x3cb71454, 0x083431b9, 0x208d7edc,
+    0xa7f5f100, 0x608030b9, 0xf6544461, 0xb311152e, 0x1e80e95b, 0x80292c9f, 0x0c583784, 0x71e899ea,
+    0x9cc002a2, 0x02982d27, 0x234bc011, 0x1c00b60a, 0xad5d8200, 0x27003c77, 0xa00f14ac, 0x8616858a,
+    0x2a86c40d, 0x80156127, 0x19956618, 0xba80fcf9, 0x8473d006, 0x00503635, 0x467109fb, 0x9bf8347b,
+    0xd9d35b5e, 0x70ad0112, 0x01fd1776, 0x5b137f46, 0xcfc651b1, 0x007a09df, 0x38f8475e, 0x64a9ffed,
+    0xe1cca200, 0x21c96263, 0x0445e823, 0xc5699c6d, 0xbd8ff777, 0x95b27deb, 0x8345af1d, 0x9c1889f2,
+    0x178aaa6a, 0x990bfa47, 0x5d555191, 0x281b35d9, 0xfc36850a, 0x86649519, 0x6e15b1cf, 0x517f0ae7,
+    0xa582b95f, 0x44936063, 0x12bc293e, 0xa543dc9c, 0xe3ecc7c3, 0x36c1329d, 0x05666731, 0xcd0c07c2,
+    0x0cddec5a, 0x5ac39b90, 0xee9b77aa, 0xc6dca501, 0x7c439767, 0x5e94354b, 0x89ba41ce, 0x1480dc65,
+    0xd50294c3, 0xe0b5c30e, 0x1ea06dba, 0xb2bf72db, 0x19b0c957, 0xfda825b5, 0x64260a6b, 0x134bb01f,
+    0xdc80144c, 0x80372dd9, 0x54a0206c, 0xee64004a, 0xd08dfd0a, 0x92f800a3, 0x00257e8b, 0x7f273cbc,
+    0x3911801d, 0x1e365a43, 0x62bdf0cb, 0x1fc001a9, 0x8500198c, 0xebbc57ce, 0xa27437b9, 0x977bc801,
+    0x0d07d82e, 0xb5a94a80, 0x83d3ee55, 0x1bc7d2bf, 0xe632868c, 0xb2e1a2b9, 0xa10d4b7d, 0xbe039340,
+    0x2cc25198, 0xec9162c1, 0xba93f6e9, 0x19024590, 0x8b0759aa, 0x099df08a, 0xde33dfb5, 0x29daeb8a,
+    0xd6b69921, 0x6ac2280a, 0x575d92e8, 0xa032e5d1, 0x35d08455, 0x1d333745, 0x206d2a1f, 0x64e1a49d,
+    0xf8099109, 0x1e3ab8d9, 0xe1584c08, 0x518af48a, 0xa60da438, 0x4f0f6c1c, 0x79760701, 0xa91f3be2,
+    0x72a53873, 0x85ead630, 0x02e88027, 0x1ac0eb6c, 0xd505f4ff, 0x4555167b, 0xd1b14e8a, 0x0faa4290,
+    0xbe9d60a0, 0x1e936909, 0xaf8383a3, 0xaae531d7, 0xa124b13d, 0x0a085656, 0xa0740b48, 0xa2efcaf6,
+    0xf1e3561b, 0x00013bc2, 0xc8eeedfc, 0xca3d4004, 0x55c5bea3, 0x25d52a20, 0x83016001, 0xa7257bbd,
+    0x296000f6, 0xe742637d, 0x61823e26, 0xb42ca249, 0x9e7dc0aa, 0x3f6a422a, 0xdf93aed9, 0x0b770007,
+    0x6c88e02d, 0x1cd4b7e5, 0xcae13200, 0x43e43dff, 0x8b92a000, 0x0606c1b1, 0x9d8793c9, 0xa1d26605,
+    0x730dd51d, 0xa7180028, 0xb231d904, 0xfa6404d9, 0x595f158b, 0x4f62b676, 0xba83c3e0, 0x82059e37,
+    0x56abe625, 0xba8429f9, 0x1c6cc8a9, 0xc8e60187, 0x23bd21c6, 0xc053a88b, 0xb63ebcd5, 0xab9c0284,
+    0xc0eb7612, 0xc0cab402, 0xf6169233, 0xffcd07d9, 0xc3d141da, 0xa0cc1f9e, 0x253d742b, 0x093d0579,
+    0x386149b2, 0x41bb8205, 0xfc69242e, 0x131bb252, 0xeeb433c4, 0x2b61eabc, 0x5d811b30, 0x4327090f,
+    0x079c3938, 0xa9e05f0a, 0xf8134154, 0x106642e8, 0x91f38ff4, 0xe2212906, 0x65492c00, 0x786b863a,
+    0x97907aba, 0x6b02b884, 0x00398071, 0x2a890000, 0x00000030, 0x00000b87, 0x955a94e0, 0xb2442d68,
+    0x00002996, 0x551e6e40, 0xa8a2f98e, 0x38b00002, 0x11363684, 0x76bdf200, 0xa4a39346, 0xf957635f,
+    0x7740003c, 0x00000f3b, 0x2322fc00, 0xf755ce9c, 0x00001597, 0x4d809d30, 0x06c9b57c, 0x7d240000,
+    0xd4d743a3, 0x44f7421e, 0x6199ea2f, 0x1088f621, 0x08dd82d3, 0x2873dea2, 0x165f4784, 0xdde9d5e1,
+    0x0f385757, 0x26896e24, 0x22960e5d, 0xf8830940, 0x1b810731, 0x86100713, 0x02a0ccfd, 0xc831ad95,
+    0xaba6e82b, 0x3bb4b267, 0x4b9db605, 0x8089539e, 0xc855a5b8, 0xe7b113a6, 0x24422da2, 0x976e24df,
+    0x47e991d0, 0x1e70775c, 0x9abb8197, 0xc2f61b07, 0xaa33ae4a, 0xc7bacfad, 0x10b5bb0a, 0x1801bd2c,
+    0x95e3637d, 0xe0f5ad70, 0x59d9d821, 0xe04426b0, 0xd1754b55, 0xdca56774, 0x068b1d2e, 0x04df6cca,
+    0xda410b75, 0x673e695e, 0x8211d612, 0x6d012c28, 0xe82881fb, 0x0000819a, 0x2532c780, 0x85000000,
+    0x1660bfa3, 0x94efe5f2, 0xb054296f, 0x00000021, 0xd09689a4, 0x7b5079ee, 0x15a00000, 0x17f83117,
+    0x4a468001, 0x00003a7f, 0x311c8800, 0x4e800000, 0xc000000b, 0x3d14f5c1, 0x6674c42e, 0xc000002a,
+    0x91550642, 0x02b5eaf9, 0x9424d000, 0x00118a36, 0x626f066c, 0xdfe036ea, 0xde09545c, 0x7df38177,
+    0x02b60097, 0x6b113720, 0x4d815032, 0xd0a65d61, 0x207d3f03, 0x893a77ed, 0x612c8f10, 0x9de47168,
+    0xb4c4a4af, 0x93ec9918, 0x7c30b8f5, 0xf8b49d5f, 0x0475f1de, 0xc815aabf, 0x6ca4a9a3, 0x991053f7,
+    0x8d16d162, 0xf825161f, 0xbb2d8288, 0x84e5009d, 0x3718df5b, 0x10c70861, 0xa8e217ea, 0xa2d4df10,
+    0x157a2e3f, 0x6282f7b9, 0xe8eed772, 0xeed15f7e, 0x10c62430, 0x430948e6, 0x61ec6ed2, 0xdcc13892,
+    0x7d9f7cf5, 0xa7ddc461, 0xb302c28a, 0x1768331d, 0xcb26c250, 0x1ac0a95e, 0x651ec3bb, 0xc08bb381,
+    0x22e121a8, 0x313adfb9, 0x5b2d496e, 0x7dcd97b1, 0x6d814b42, 0x14dbc6bf, 0x4d800000, 0x8d7aaa9d,
+    0x050008ac, 0xb96c0000, 0x1fae0132, 0x91a00004, 0x0000008b, 0x0024706a, 0x7a678000, 0xa63660be,
+    0x6f13cf9b, 0x225254e9, 0x51000000, 0xeeb15620, 0x007da169, 0x06f48800, 0x011d3831, 0x9c3e4540,
+    0x852e5259, 0xaecb1e09, 0x857408d1, 0x3e023409, 0x65d2ca1e, 0x40db6bbf, 0xecc31f97, 0xe80f826c,
+    0xfb5c2571, 0x0ed20010, 0x4509dad6, 0x75ecee4e, 0xdc696537, 0x8fdf16ae, 0x37c12de1, 0x1d02e79e,
+    0xcaa010a6, 0x21accf4f, 0xf100b242, 0xe519da3c, 0x60930a95, 0x69a1008a, 0x6c875318, 0x2e62367f,
+    0xdd46f886, 0x4d6b74fb, 0x26dc1237, 0xce11a068, 0x08b48555, 0x3950b821, 0x57514085, 0xaeba6248,
+    0x82349277, 0x9e860c67, 0x16048c61, 0xd27e19b3, 0x3dd09407, 0xb8b901f4, 0x3ff10c1e, 0x27162f40,
+    0x5d4e02c5, 0x11ea0d27, 0xd0def16b, 0x2e135612, 0xc5760889, 0xa5b28df6, 0x3be36097, 0x40004082,
+    0x00101d93, 0x37a5c000, 0xd5cfa7a1, 0x0016d880, 0x7996b000, 0x2e6d7c5f, 0x14000007, 0x8f47a381,
+    0x70e339b4, 0xb06c5149, 0x76fdcf19, 0x1f6de34b, 0x00153f19, 0xce920000, 0xac8e0529, 0x000517d7,
+    0x6aac3400, 0x04335e01, 0x8b914c00, 0x6788fba0, 0x78bb9159, 0x1db28e87, 0x6b4314b3, 0xa651d407,
+    0x19341545, 0x846f0674, 0x092f944a, 0x699ebea5, 0x93534e58, 0x02adb0c7, 0x5aa92a21, 0xc88589c7,
+    0x761d4bea, 0x19454789, 0xc7f5a25d, 0xbf0d9389, 0xcd418d10, 0x583d8359, 0xcbe6cc82, 0x010dac30,
+    0x1e0bf1ef, 0x089d0a9b, 0xc52fe557, 0xb0c8e0d5, 0x85f6f68a, 0xcffd9d1d, 0xef6acb0c, 0xbeed5b03,
+    0x1d29fb26, 0x0e6792a6, 0x324405db, 0x20b22f4d, 0xd7839a08, 0xd64086de, 0x85bc3535, 0x16dc423b,
+    0x370c3975, 0xaae70ad5, 0xf3ec122e, 0xa0ac4804, 0x8de95bed, 0x40510e42, 0x27b7fa45, 0x66420c97,
+    0x24bde71d, 0xeb650009, 0x80085833, 0x02198aad, 0xd3ca5020, 0xa14428da, 0x02fa2cd3, 0xa4be7ac0,
+    0xdda0f97d, 0xe99000ea, 0x128e3663, 0x76a7af00, 0x9da65298, 0xb8bc6359, 0x124000c1, 0x02c4906b,
+    0x20905cc0, 0x5cd5c8e1, 0x00a9d746, 0xef773260, 0x9750fd7b, 0x7d0ea000, 0xffa548e3, 0xc393bb9a,
+    0xc516b100, 0x5142f3b3, 0x035ce78f, 0x79461ffa, 0x1396eb85, 0x52e8f9c6, 0x140947aa, 0xe159409a,
+    0x2d86525c, 0x1580881c, 0xbb408964, 0x07fc0390, 0x921cb892, 0xe72cc4d4, 0xaba61b78, 0xe39fb49d,
+    0x8a2bd786, 0x9849228c, 0x8070bfc0, 0x4788a332, 0x1fc2d9b5, 0x8bf066e2, 0x169a943f, 0x229899de,
+    0xa493e130, 0x8234c2c8, 0x11b16d95, 0x4099513e, 0x1087620c, 0x319ab4ed, 0x6fa3d9f5, 0x619d9ab0,
+    0xd5e74926, 0x8ac5846c, 0x1c66c80d, 0x83a62477, 0x6507bdc1, 0x03a1494b, 0xbfbe359f, 0xbb42ea2e,
+    0x1b0d4992, 0xbd4283fa, 0xbc1e3240, 0x2d618459, 0xa2680500, 0xa9001813, 0xf65cbae4, 0x434eb66e,
+    0x42bf6965, 0x00155ea4, 0x5754db60, 0x84ba89ec, 0x8e60015e, 0x2d582f06, 0xff414009, 0x16f83f0c,
+    0xb4db6b80, 0x78001f44, 0x8007d3ca, 0x4293659c, 0xa322441d, 0x000b18ad, 0x5334a657, 0x82eae4f9,
+    0x03d5b003, 0x0012e236, 0x5eec9eb8, 0xe5e7b93e, 0xe211e8da, 0x7fe261e8, 0xc3892778, 0x228f0794,
+    0xbb284e7d, 0xb0d8fb22, 0x04893703, 0xb2faeadd, 0xe0787ce0, 0x1a2c776c, 0x2b432b58, 0x12db95e8,
+    0x535171f3, 0x4cc2dcbf, 0x05d162a0, 0xbc12ea83, 0xbe28e8c0, 0x93154bc7, 0xbccf7135, 0xd4306662,
+    0x98ec7fc7, 0x839a3821, 0x5b1c319d, 0xd006062a, 0x96618a4d, 0xd6085dae, 0x18577140, 0x82022ef9,
+    0xed53571d, 0xafb18e5f, 0x1ac5de30, 0x0106ca12, 0xce07f0e9, 0x5e810094, 0x18a3b01b, 0x28ea5501,
+    0x178207d8, 0x9a0bb0d7, 0x8ca37bd1, 0xc6307c9d, 0x15377ab2, 0xe066c3f9, 0x27a1c195, 0x37365ba4,
+    0x9c8cc955, 0x7d9740ad, 0x5ff40c19, 0x166ba7ff, 0x2d001d66, 0x7a44a761, 0xa55fe46c, 0x847b006b,
+    0x6ebdfb2a, 0x904c00f4, 0x801c988b, 0xd0a1a8be, 0xbc51002b, 0x56d655b9, 0x5d35ee6c, 0xa4e45029,
+    0x56802500, 0xea691472, 0x5d8709e9, 0x766d6002, 0x1132982d, 0x6f334000, 0x86b561dd, 0x14ce433b,
+    0xe4bf8b66, 0x3b42d908, 0xffe388ce, 0xc393473d, 0x6084097e, 0xe2f1521c, 0x44dc51ed, 0x0331bda1,
+    0x1c0c9bf6, 0xce27ebcc, 0xda607a39, 0x03e312d3, 0xf8c00b82, 0x3943c125, 0x08220e7d, 0x63161cce,
+    0x0930e667, 0x7cfd0d35, 0x70be0b07, 0x6e204878, 0xdb856741, 0x7db23403, 0xd9097284, 0x3e3b155e,
+    0xe7900e16, 0x1213ecb4, 0x884303e1, 0xa97bdd1f, 0x3f7d48ee, 0xd249e970, 0xc19ca597, 0xa28d3962,
+    0x4c035481, 0xafeb9d0c, 0xb92fd385, 0x5330e16b, 0x4119339d, 0x9f1913ad, 0x07994203, 0x67ee4927,
+    0x20a2199a, 0x621cf5cc, 0x80a9064a, 0x286f3776, 0x3963237c, 0x600e453f, 0x68714c93, 0xa6568019,
+    0x559b091e, 0x1758860b, 0x7030b006, 0xb5757902, 0xfeb00507, 0x6b4ce368, 0x450c3554, 0xacad3049,
+    0x50fd81f0, 0xdf5a9dac, 0xced6ce91, 0x934a0029, 0x6c72b326, 0x9905779a, 0xd2775100, 0x64824df8,
+    0x8b4ff401, 0x348b687b, 0x92708f09, 0x99c30c09, 0x6f8e1438, 0x2571ff26, 0xa3b6374f, 0x1f9b8843,
+    0xb8f9ec49, 0x8740c673, 0x6712de28, 0x836dc287, 0x5e6e021c, 0x1607105b, 0x1dcdcf06, 0xe024950c,
+    0x7c1cc306, 0xbd9d4608, 0x7ac43c4c, 0x08b1044a, 0xbbe18862, 0x7159545c, 0x3a0001ad, 0xe9490d5c,
+    0xc6669852, 0x88c58040, 0x26b87898, 0xad1e207e, 0xd26a4c75, 0xbc020782, 0x9e6ab564, 0x0a5452fc,
+    0x6cd3d614, 0x1772769d, 0xd185d8d4, 0x507404e1, 0x841d5533, 0x7357faa6, 0xf5fa8215, 0x7327b809,
+    0x8d391480, 0xdf284183, 0x0b698572, 0x483a204b, 0x67da39cb, 0x618178aa, 0xd24260b7, 0xa80d804a,
+    0x006c42b7, 0x1b15c9d6, 0x523b6460, 0xc543f2a7, 0x2665b00d, 0x445eda00, 0x1271f8b7, 0x9ab00c13,
+    0x93e234a3, 0xf6309900, 0xa9a91646, 0x73f1e30b, 0xa78010c6, 0x23b55199, 0x9dfff540, 0x4fd584a9,
+    0x088f58f3, 0x936dcfa0, 0x17d7d577, 0x60f95007, 0x6c7c4e23, 0xc1fe7497, 0x3e139e60, 0x71f5f0f9,
+    0x93fc3910, 0xf3d02141, 0x90f08d86, 0xd8e80267, 0x1972d7f8, 0x9399153c, 0x39c6931c, 0x287d4704,
+    0x7db70bef, 0x0a241c8e, 0x1518d5e9, 0x86344f54, 0xa965356b, 0xc00c36b8, 0xc8cb9f08, 0x4d38eb66,
+    0xc88f34c8, 0xb75b22c3, 0x1b83a1c6, 0x6f7254d7, 0xa4e196bf, 0xa6ea11df, 0xb8b940d7, 0x818e64e9,
+    0x9aaf1687, 0xc811d296, 0x505f808d, 0x47a0ac5c, 0x4ec45505, 0x62298740, 0x51e5ef2b, 0x9c46b05a,
+    0x1575c4a3, 0xb446ea79, 0xd118de3f, 0x028f898c, 0xa3bb43a9, 0x1288aae1, 0xe8095f83, 0xbd7ac3c9,
+    0x84155288, 0x986b8658, 0x1f9f7680, 0xa300797f, 0x3645b62b, 0xcd2d8860, 0xd203293c, 0x006929a6,
+    0xa4532f2c, 0x8e1909e2, 0x07c806b9, 0x42982706, 0x423c002d, 0x5c09c399, 0x38958980, 0xa2809a27,
+    0x00268469, 0xaed1d762, 0xdbd743da, 0xc0369a30, 0x5f8446e0, 0x331f9df8, 0xe386f011, 0x00943633,
+    0x8d69e12f, 0xb07b3b7a, 0xe5e72058, 0x7501c266, 0xc4755899, 0xff0cf3d3, 0x16a5cc93, 0x411199a4,
+    0xe5442f69, 0xe1ab5814, 0x1fac6ba0, 0x96902b71, 0x05418174, 0x45d312e1, 0x2c5220f0, 0x8fed5c0c,
+    0x075606a1, 0xc4104d41, 0x0ba0e7c2, 0xca1ada58, 0x9c7fa10a, 0xc03d06a2, 0xa8f27c86, 0x82860da5,
+    0x159fa2ab, 0xaf3e8446, 0x72411158, 0xdc6ddc3f, 0x9b4fc541, 0x7f818380, 0xf113d6c5, 0x79c9befa,
+    0x234595a0, 0x3504cb4e, 0x5518729c, 0x60006497, 0xc0a80ae2, 0x4a00cf60, 0xfac16860, 0xe44bae7a,
+    0x4e2e4252, 0x22f05663, 0x2d4c97aa, 0x40474475, 0x2c624982, 0x23b1f797, 0xe2d2c906, 0xfd058829,
+    0x3b91ecf0, 0x97f90cdf, 0x32806c53, 0x46b0a42a, 0x95bf276c, 0x4fde018c, 0xbd4deaf2, 0xcef40384,
+    0x0091fe8a, 0xb61eecdb, 0x05ac809f, 0xea163a35, 0x2d3e6d3e, 0xa7723469, 0x08008856, 0xdee952c7,
+    0xb7906369, 0xf5e71008, 0x3947d823, 0x189a3ac0, 0x88613e61, 0x9ed13e72, 0xa4158e45, 0x942390c7,
+    0x7148878f, 0xc627303c, 0xfd850df9, 0xdd3e51cf, 0x96c47c1d, 0xf6417ea1, 0xcd0fdd05, 0x0a0c691a,
+    0x581b453c, 0x86e6da3b, 0x19b1be82, 0xe5c4b365, 0x12740c70, 0x646cbfcc, 0x89f12079, 0x2cdcfb2d,
+    0x60edfb73, 0x721f7867, 0xe503b823, 0x0fa9316c, 0x54a5e183, 0x258535b1, 0xa8289175, 0x39964da9,
+    0xfa5202a5, 0xa9a06c9d, 0x2b4c51a3, 0xf0696c58, 0x0118b957, 0x26c9c85e, 0xe00247fb, 0xe0d4a082,
+    0x0a8f0d83, 0xe11b40f8, 0x4214279b, 0xa09c1219, 0xaee2015f, 0x66f1dfc6, 0x006e89cb, 0x9e251583,
+    0xce63044b, 0xab291f75, 0xe7e29f4d, 0xa02ac9f2, 0xdd527942, 0x1a0d4050, 0xd528301c, 0x629a304c,
+    0x66dd1013, 0x3b7571aa, 0xe9800ff8, 0x0a522338, 0xdd09b0f4, 0xa8f5c3c8, 0x27fcd9a3, 0xdf308d4d,
+    0x0ed85afc, 0x5e550085, 0x6c3711a3, 0xe715d6a1, 0x1242d501, 0x54d0ade6, 0x8a8ea004, 0xfb0e197d,
+    0xe6b38cdf, 0x96098c0b, 0x815d93b0, 0xa479c7e5, 0xae383c05, 0xcdf20a45, 0x18be6c07, 0xa81dcdd7,
+    0x36027408, 0x8441d347, 0x61e6cb18, 0xb508c1a3, 0x0f88d1f7, 0x25e3ea8f, 0x421643c3, 0x3c04d8c7,
+    0x6146c6a0, 0xbd6a0555, 0x4edbb161, 0x51ad3c86, 0x49f2c16f, 0xbd67109d, 0x476fc8ce, 0x374201e1,
+    0xa781fa52, 0x927e8edb, 0xe2ff4dea, 0xb8fdc901, 0x022b51d9, 0x06e80356, 0x9dfba4b6, 0x0fb2c04d,
+    0x1287d794, 0xbbd20328, 0x02c16ab0, 0xbfd38e72, 0xd4dfaa35, 0x0828498a, 0x5fe516e6, 0xdd974a82,
+    0xd159a853, 0x4026dc53, 0x57f6f94d, 0x5cc0fcbe, 0x43c6e429, 0x5b2b00bd, 0x812b473b, 0x4ad08902,
+    0xd0b01720, 0x6a438b1c, 0x6a0f3340, 0x44001780, 0x46c7f73c, 0x4c902153, 0x55363143, 0x75726001,
+    0x2a2bd987, 0x2414e275, 0x7de031cb, 0x62a252c5, 0x9b758280, 0x5dd50258, 0x17a51a9c, 0x3e6482c0,
+    0x885d6d6f, 0x28e43013, 0x08d55363, 0x40374d94, 0xd010b7cd, 0xd29e6df5, 0xdd5b7854, 0x95ea6276,
+    0x8e700a88, 0xfce6f12e, 0x1f6d4842, 0x3db8ec49, 0x4756d03c, 0xb37a05f8, 0x5f208ed7, 0x8c84d50c,
+    0x8d152ac4, 0xe549b713, 0x93a43752, 0xce4438b5, 0x877f0e0a, 0x9408ae7d, 0x40b0d8cf, 0x4728e25b,
+    0x178479d7, 0xf4f3da75, 0xf1381951, 0xab5e8060, 0xd599408c, 0x0103f3aa, 0x4f2cac8a, 0x5be9d3b5,
+    0x403e50cf, 0x59f4a386, 0x3364d3f5, 0x22a17330, 0xcdc98f30, 0xd347a397, 0xb9d5411d, 0xb687b6fa,
+    0x48ac1ea8, 0x81abbcce, 0x80b839dd, 0x6c90eb76, 0x2f061db3, 0xfda98b98, 0x400de2d2, 0x49848857,
+    0x1ce41a81, 0x3d812352, 0x161e317f, 0x6dcc5d7e, 0x5a6468f6, 0x00fae6a9, 0xc5918778, 0x975e69d1,
+    0x8298100a, 0x57a81925, 0xf9370069, 0xd17a4805, 0xbc467380, 0xce016feb, 0xc05be528, 0xe3504d56,
+    0x0be1c366, 0x408245b4, 0xb7a3e86b, 0xfb53c8f6, 0x13391028, 0x01958a30, 0x2e66eade, 0x41c13d9c,
+    0xe98362d6, 0x5bec62f1, 0x45793b7a, 0xc98afee4, 0x5e004a79, 0xa14fe625, 0xc2db283f, 0x150bbefc,
+    0x1ed05b61, 0x13131775, 0xbf3fb0df, 0x30cd9007, 0x0c72c3ed, 0xc05d5b47, 0x8901a7e2, 0x510dd6c8,
+    0x549b66ab, 0x7c20f7a8, 0xcc27c8e2, 0xb84ae6de, 0xf1747945, 0x01a390a9, 0x3ea32cfe, 0x2e7382b7,
+    0x5380adbb, 0xb4875ac5, 0x1e5ed5c2, 0xdb40f649, 0xf42ad66a, 0x4d69f10a, 0x2a454ae0, 0x67030c92,
+    0xf706f3ff, 0xe13c4699, 0x782c86e4, 0x6b1f9da0, 0xcd40e50b, 0xf4462c0c, 0xcfc4d753, 0x3d8036e7,
+    0xfd5dfaa1, 0x102d54f4, 0x3162b96e, 0x69adab24, 0x340f487b, 0xfc195726, 0x00900dc6, 0x5981b23f,
+    0x0d80ec55, 0xf30a20fd, 0x161d472b, 0x1be20361, 0x0aedd0aa, 0xcda407b5, 0x0173d489, 0x2b1c3c57,
+    0x5d68815a, 0x17561030, 0xdf72ec15, 0xa9f848a8, 0xd4812972, 0xcc435120, 0x0499a049, 0x95625813,
+    0x7d5cc814, 0x7a793580, 0x0a30e964, 0x17540c62, 0xe374116c, 0x19645a39, 0xbc474664, 0x489364ba,
+    0x33462b8d, 0xd6feb188, 0xf084a3c3, 0xe8114371, 0x63135e05, 0x1f0d6639, 0x559d4b3e, 0x186a677e,
+    0x9a94e683, 0x1e85bcfa, 0xec720a84, 0xa5aec549, 0x7e316023, 0x64b9d226, 0x61227bd8, 0x761e9457,
+    0x88824238, 0xe69d2ec5, 0x50229101, 0x04e2d5f3, 0x68a4be14, 0x1198bfce, 0x612581a4, 0x99be30dc,
+    0x1adb5a97, 0x08f8ebb8, 0x00b0cda8, 0xab1d2159, 0xcf816691, 0x67e22412, 0xdace4102, 0x64936099,
+    0xc2e07a1a, 0x1b9f2627, 0x53a9c0da, 0xc7f4cba6, 0xc04491fd, 0xe62bc537, 0xc345028c, 0xade0f2f4,
+    0x5de1d3f7, 0xc0574e96, 0x0db3a1ea, 0x9680c0a6, 0x5477c499, 0xce5bd4d9, 0x5da97027, 0xbfa56663,
+    0xd4a020d8, 0x175762f0, 0x3f422c8a, 0x254c21c8, 0xfa7bd714, 0x9eefef8d, 0x3b99e218, 0x345f0111,
+    0xebdb7820, 0xe8263462, 0x4a0f0e03, 0xe51dfdc9, 0x898d5408, 0x9391213c, 0x712b0add, 0x128b880e,
+    0xa20cf31e, 0xa36a9804, 0x4aba2077, 0x915e8c77, 0x687d6a06, 0xcc04d4c4, 0x00621080, 0x8529e307,
+    0x65199e14, 0xe28aa1d2, 0x46edd4ba, 0xd8234a12, 0x1babe490, 0xba469f46, 0xfac92857, 0x76d68678,
+    0x48d55001, 0x2208e4ad, 0x45e44135, 0x8a6b145e, 0xc842844a, 0x533e6ad4, 0x0851fbb5, 0x60dee795,
+    0x22864f69, 0xb5e50481, 0xc62bcfa0, 0x042773b1, 0xc58b7208, 0x09730bfd, 0x3f89564c, 0x1bef81cd,
+    0x81a95e2e, 0xfe4f0411, 0xd3bd4e35, 0xeb68be83, 0x6da6995b, 0x5bfbac01, 0xd2f9c45e, 0xd817605c,
+    0xc80e18cb, 0x57c098d2, 0xda4b53d5, 0x0054815c, 0x824459bf, 0x91042831, 0x0f2aa8c0, 0xe7c2f2d2,
+    0xcd943666, 0xd3a2bd00, 0x7a55f50e, 0xff90409b, 0x96822c52, 0xf4782302, 0x8d2e9181, 0xc2686196,
+    0xe08064cf, 0xbf2fd3ec, 0x98f4b840, 0x1cd442ac, 0x2dd49c3f, 0xfd5b5930, 0xd8e11562, 0xd8cf6025,
+    0xc6d158a2, 0xbe45cb10, 0xcd8e024c, 0x5339eaad, 0x1c7aa675, 0x5d336398, 0x8c19070a, 0x5365c7a9,
+    0x25efc888, 0xe030c5fe, 0x5627096b, 0xd0768500, 0x5d029208, 0x8f1b6a8a, 0xf991bc91, 0x446e5212,
+    0x846322a1, 0x0b483a91, 0x8648090d, 0x62286c29, 0x80d57ad6, 0xb6f231f9, 0x138565e6, 0x7d74fcaf,
+    0xf96c1bfa, 0xafef4e61, 0xf994a04f, 0x0096390b, 0x8d2a3322, 0xf9d55498, 0xb02402d0, 0x687b9a77,
+    0x1db55615, 0x62fd5ea0, 0x49800e35, 0x58485ee1, 0x07183d82, 0xf168877c, 0xc99dfefb, 0x80f72f0f,
+    0x7db51cab, 0xc8d7ebec, 0x380388d3, 0x0dcea365, 0xf808131f, 0x58868995, 0x1a3b0282, 0x44821387,
+    0xf5e72ce6, 0x8b8b377b, 0xd831a892, 0x01c9c12b, 0xd40fe6ad, 0xa07cf9b9, 0xff901d44, 0x6c580564,
+    0x0631c0bd, 0x7dfacc49, 0x3fe8f001, 0xfb029f41, 0x20a7a847, 0x88cec9b9, 0x2e9c42c2, 0x40edacb7,
+    0x5e138b80, 0xbb8719f4, 0xc2ec704a, 0x02d6d62a, 0xf0e3cde7, 0x9caebf99, 0x6ce182d3, 0x3351c38b,
+    0x0693557b, 0x92892ba0, 0x8f59c831, 0x41938626, 0x9d822191, 0x4ccc1efc, 0xdddc4c31, 0x8fcf5278,
+    0x9b3dc052, 0xd83b0d5f, 0x12d35b69, 0xdc56da71, 0x8ad1d723, 0xfb0b8ab0, 0x98ae257b, 0xe4279ab8,
+    0xfbc870bc, 0xc859f716, 0x5f007584, 0x80edb8ae, 0x3226cbfb, 0x6da48180, 0x61206006, 0x5d199942,
+    0xa1802d43, 0x19408820, 0xf693d60e, 0x2aca2444, 0x2fc4fe60, 0xf5018dde, 0xac147525, 0xe231f09c,
+    0x41311da7, 0xec451da0, 0x1a007e98, 0xc86fa990, 0x1164e9d4, 0x22f01e59, 0xc56b8a98, 0x60190577,
+    0x36a31159, 0xb429639c, 0x96afc7b6, 0xfad402a2, 0xaf442e97, 0x1b035bde, 0x5e819cb1, 0x7fcb1dde,
+    0xa679ba2b, 0xe8d305e6, 0x572dac71, 0x4c5c0d65, 0x82bddb88, 0x401993bb, 0xca68025a, 0x90b5d82b,
+    0x74450af0, 0xac72df28, 0x23820768, 0xb2920f82, 0x34a2b329, 0x64e00021, 0xd97167ff, 0x880a3080,
+    0x0c28cfe7, 0xced6a94a, 0x02dc94d4, 0x7f65343a, 0xe35c854d, 0x4ad45c38, 0x6a476098, 0xd03ba145,
+    0x51acc8a6, 0xd8b10c62, 0x2c171ef5, 0x07cee314, 0x52eb3240, 0xb4edb576, 0x5b683883, 0xb1c6dc63,
+    0x993d08b9, 0x26da57c7, 0xf031a509, 0x9493c51f, 0x815b4c36, 0x79dd9c48, 0xb98119f9, 0x0377ac16,
+    0xcb860401, 0xddf8d624, 0x2903ded2, 0x101b3f93, 0xbf1200df, 0x69d4fe9a, 0x0e4363bd, 0x1bc86850,
+    0xc05ce278, 0xaf6fc653, 0xa500b6fb, 0x4725a7b7, 0xb32d6e81, 0xdfc3e051, 0xc37d0158, 0xd1a24b5b,
+    0xf6758073, 0x41f708a5, 0xe0246a31, 0x3230d4ea, 0x7822014e, 0x308ff573, 0xe1e0c1a4, 0x8094d322,
+    0x7d74c4db, 0x1f5ac118, 0xd38ac697, 0x3d1d714a, 0x54a33043, 0x414d573c, 0xc0203779, 0x635c6290,
+    0x7381a826, 0xa1b53ac7, 0xc7fa7ba2, 0xfe99228e, 0x881b61aa, 0x1a0481cd, 0xab606b1d, 0x99669055,
+    0x99dc4506, 0x0569cda2, 0x880c080f, 0x7f947ca2, 0x2e1408fd, 0x8f4e3111, 0xd2e17281, 0x6245fac3,
+    0x473be1e3, 0x6bae8ed5, 0x68374505, 0xf2c2db31, 0xc691b430, 0x0625f196, 0x681aed11, 0x850cae91,
+    0xbf4a574a, 0xcb22b595, 0x0a8ac56e, 0x386523c5, 0x9e4b5dfa, 0x355d47b3, 0x71ce6d91, 0x226bccd1,
+    0x2dd4a0ff, 0x0000181f,
+};
+
+#endif // EPHEMERIS_TABLE_H_
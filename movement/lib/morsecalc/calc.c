@@ -29,18 +29,42 @@
 #include "calc.h"
 #include "calc_fns.h"
 
-#define CALC_NAN (0.0/0.0)
-
 /* calc_init 
  * Initialize calculator
  */
 int calc_init(calc_state_t *cs) {    
-    memset(cs->stack, CALC_NAN, N_STACK*sizeof(cs->stack[0]));
+    memset(cs->stack, 0, N_STACK*sizeof(cs->stack[0]));
     cs->s = 0; 
-    cs->mem = 0.0;
+    cs->mem = CALC_NUMBER_ZERO;
     return 0;
 }
 
+/* calc_run
+ * Run a calculator operation from the dictionary
+ */
+static int calc_run(calc_state_t *cs, uint8_t op) {
+    switch(op) {
+        case CALC_MEM_CLEAR:
+            cs->mem = CALC_NUMBER_ZERO;
+            return 0;
+        case CALC_MEM_RECALL:
+            if(cs->s >= N_STACK) return -2;
+            cs->stack[cs->s++] = cs->mem;
+            return 0;
+        case CALC_MEM_ADD:
+        case CALC_MEM_SUBTRACT:
+            if(cs->s < 1) return -2;
+            cs->s--;
+            if(CALC_MEM_ADD == op) cs->mem = calc_number_add(cs->mem, cs->stack[cs->s]);
+            else cs->mem = calc_number_subtract(cs->mem, cs->stack[cs->s]);
+            return 0;
+        case CALC_RESET:
+            return calc_init(cs);
+        default:
+            return calc_op_run(op, cs->stack, &cs->s, N_STACK);
+    }
+}
+
 /* calc_input_function
  * Try to execute the token as a calculator function
  */
@@ -48,7 +72,7 @@ int calc_input_function(calc_state_t *cs, char *token) {
     for(uint8_t idx=0; idx<sizeof(calc_dict)/sizeof(calc_dict[0]); idx++) {
         for(uint8_t idxn=0; idxn<calc_dict[idx].n_names; idxn++) {
             if(0 == strcmp(calc_dict[idx].names[idxn], token)) { // Found a match
-                return (*calc_dict[idx].fn)(cs); // Run calculator function
+                return calc_run(cs, calc_dict[idx].op); // Run calculator function
             }
         }
     }
@@ -87,11 +111,10 @@ int calc_input_float(calc_state_t *cs, char *token) {
     REPCHAR('C', '-');
     REPCHAR('p', 'E');
     
-    char *endptr;
-    double d = calc_strtof(token, &endptr);
-    if(!endptr || (uint8_t)(endptr-token)<strlen(token)) return -1; // Bad format
+    calc_number_t number;
+    if(!calc_number_parse(token, &number)) return -1; // Bad format
     if(cs->s >= N_STACK) return -2; // Stack full
-    cs->stack[cs->s++] = d;
+    cs->stack[cs->s++] = number;
     return 0;
 }
 
@@ -26,12 +26,13 @@
 #define CALC_H_INCLUDED 
 
 #include <stdint.h>
+#include "calc_number.h"
 
 #define N_STACK 10 
 
 typedef struct {
-    double stack[N_STACK];
-    double mem;
+    calc_number_t stack[N_STACK];
+    calc_number_t mem;
     uint8_t s; // # of items in stack 
 } calc_state_t;
  
@@ -39,6 +40,5 @@ int calc_init(calc_state_t *cs);
 int calc_input(calc_state_t *cs, char *token);
 int calc_input_function(calc_state_t *cs, char *token);
 int calc_input_float(calc_state_t *cs, char *token);
-double calc_strtof(const char *str, char **endptr);
 
 #endif
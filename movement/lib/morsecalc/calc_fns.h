@@ -23,106 +23,69 @@
  */
 
 #include "calc.h"
+#include "calc_ops.h"
 
-// Stack and register control
-int calc_delete(calc_state_t *cs);
-int calc_clear_stack(calc_state_t *cs);
-int calc_flip(calc_state_t *cs);
-int calc_mem_clear(calc_state_t *cs);
-int calc_mem_recall(calc_state_t *cs);
-int calc_mem_add(calc_state_t *cs);
-int calc_mem_subtract(calc_state_t *cs);
-
-// Basic operations
-int calc_add(calc_state_t *cs);
-int calc_subtract(calc_state_t *cs);
-int calc_negate(calc_state_t *cs);
-int calc_multiply(calc_state_t *cs);
-int calc_divide(calc_state_t *cs);
-int calc_invert(calc_state_t *cs);
-
-// Constants
-int calc_e(calc_state_t *cs);
-int calc_pi(calc_state_t *cs);
-
-// Exponential/logarithmic
-int calc_exp(calc_state_t *cs);
-int calc_pow(calc_state_t *cs);
-int calc_ln(calc_state_t *cs);
-int calc_log(calc_state_t *cs);
-int calc_sqrt(calc_state_t *cs);
-
-// Trigonometric
-int calc_sin(calc_state_t *cs);
-int calc_cos(calc_state_t *cs);
-int calc_tan(calc_state_t *cs);
-int calc_asin(calc_state_t *cs);
-int calc_acos(calc_state_t *cs);
-int calc_atan(calc_state_t *cs);
-int calc_atan2(calc_state_t *cs);
-int calc_sind(calc_state_t *cs);
-int calc_cosd(calc_state_t *cs);
-int calc_tand(calc_state_t *cs);
-int calc_asind(calc_state_t *cs);
-int calc_acosd(calc_state_t *cs);
-int calc_atand(calc_state_t *cs);
-int calc_atan2d(calc_state_t *cs);
-int calc_torad(calc_state_t *cs);
-int calc_todeg(calc_state_t *cs);
+// Operations on the memory register and the whole calculator, which aren't stack operations and so aren't in calc_ops
+enum {
+    CALC_MEM_CLEAR = CALC_OP_COUNT,
+    CALC_MEM_RECALL,
+    CALC_MEM_ADD,
+    CALC_MEM_SUBTRACT,
+    CALC_RESET,
+};
 
 // Dictionary definition
-typedef int (*calc_fn_t)(calc_state_t *cs);
 typedef struct {
     uint8_t n_names; // Number of aliases
     const char ** names; // Token to use to run this function
-    calc_fn_t fn; // Pointer to function 
+    uint8_t op; // A calc_op_t, or one of the operations above
 } calc_dict_entry_t;
 
 static const calc_dict_entry_t calc_dict[] = {
     // Stack and register control
-    {1, (const char*[]){"x"}, &calc_delete},
-    {1, (const char*[]){"xx"}, &calc_clear_stack},
-    {1, (const char*[]){"xxx"}, &calc_init},
-    {1, (const char*[]){"f"}, &calc_flip},
-    {1, (const char*[]){"mc"}, &calc_mem_clear},
-    {1, (const char*[]){"mr"}, &calc_mem_recall},
-    {1, (const char*[]){"ma"}, &calc_mem_add},
-    {1, (const char*[]){"ms"}, &calc_mem_subtract},
+    {1, (const char*[]){"x"}, CALC_OP_DROP},
+    {1, (const char*[]){"xx"}, CALC_OP_CLEAR},
+    {1, (const char*[]){"xxx"}, CALC_RESET},
+    {1, (const char*[]){"f"}, CALC_OP_SWAP},
+    {1, (const char*[]){"mc"}, CALC_MEM_CLEAR},
+    {1, (const char*[]){"mr"}, CALC_MEM_RECALL},
+    {1, (const char*[]){"ma"}, CALC_MEM_ADD},
+    {1, (const char*[]){"ms"}, CALC_MEM_SUBTRACT},
 
     // Basic operations
-    {1, (const char*[]){"a"}, &calc_add}, 
-    {1, (const char*[]){"s"}, &calc_subtract},
-    {1, (const char*[]){"n"}, &calc_negate},
-    {1, (const char*[]){"m"}, &calc_multiply},
-    {1, (const char*[]){"d"}, &calc_divide},
-    {1, (const char*[]){"i"}, &calc_invert},
+    {1, (const char*[]){"a"}, CALC_OP_ADD}, 
+    {1, (const char*[]){"s"}, CALC_OP_SUBTRACT},
+    {1, (const char*[]){"n"}, CALC_OP_NEGATE},
+    {1, (const char*[]){"m"}, CALC_OP_MULTIPLY},
+    {1, (const char*[]){"d"}, CALC_OP_DIVIDE},
+    {1, (const char*[]){"i"}, CALC_OP_INVERT},
     
     // Constants
-    {1, (const char*[]){"e"}, &calc_e}, 
-    {1, (const char*[]){"pi"}, &calc_pi}, 
+    {1, (const char*[]){"e"}, CALC_OP_E}, 
+    {1, (const char*[]){"pi"}, CALC_OP_PI}, 
     
     // Exponential/logarithmic
-    {1, (const char*[]){"exp"}, &calc_exp},
-    {1, (const char*[]){"pow"}, &calc_pow}, 
-    {1, (const char*[]){"ln"}, &calc_ln}, 
-    {1, (const char*[]){"log"}, &calc_log},
-    {1, (const char*[]){"sqrt"}, &calc_sqrt},
+    {1, (const char*[]){"exp"}, CALC_OP_EXP},
+    {1, (const char*[]){"pow"}, CALC_OP_POW}, 
+    {1, (const char*[]){"ln"}, CALC_OP_LN}, 
+    {1, (const char*[]){"log"}, CALC_OP_LOG10},
+    {1, (const char*[]){"sqrt"}, CALC_OP_SQRT},
     
     // Trigonometric 
-    {2, (const char*[]){"sin", "sn"}, &calc_sin},
-    {1, (const char*[]){"cos"}, &calc_cos},
-    {1, (const char*[]){"tan"}, &calc_tan},
-    {1, (const char*[]){"asin"}, &calc_asin},
-    {1, (const char*[]){"acos"}, &calc_acos},
-    {1, (const char*[]){"atan"}, &calc_atan}, 
-    {1, (const char*[]){"atan2"}, &calc_atan2},
-    {1, (const char*[]){"sind"}, &calc_sind},
-    {1, (const char*[]){"cosd"}, &calc_cosd},
-    {1, (const char*[]){"tand"}, &calc_tand},
-    {1, (const char*[]){"asind"}, &calc_asind},
-    {1, (const char*[]){"acosd"}, &calc_acosd},
-    {1, (const char*[]){"atand"}, &calc_atand}, 
-    {1, (const char*[]){"atan2d"}, &calc_atan2d}, 
-    {1, (const char*[]){"tor"}, &calc_torad}, 
-    {1, (const char*[]){"tod"}, &calc_todeg}, 
+    {2, (const char*[]){"sin", "sn"}, CALC_OP_SIN},
+    {1, (const char*[]){"cos"}, CALC_OP_COS},
+    {1, (const char*[]){"tan"}, CALC_OP_TAN},
+    {1, (const char*[]){"asin"}, CALC_OP_ASIN},
+    {1, (const char*[]){"acos"}, CALC_OP_ACOS},
+    {1, (const char*[]){"atan"}, CALC_OP_ATAN}, 
+    {1, (const char*[]){"atan2"}, CALC_OP_ATAN2},
+    {1, (const char*[]){"sind"}, CALC_OP_SIN_DEGREES},
+    {1, (const char*[]){"cosd"}, CALC_OP_COS_DEGREES},
+    {1, (const char*[]){"tand"}, CALC_OP_TAN_DEGREES},
+    {1, (const char*[]){"asind"}, CALC_OP_ASIN_DEGREES},
+    {1, (const char*[]){"acosd"}, CALC_OP_ACOS_DEGREES},
+    {1, (const char*[]){"atand"}, CALC_OP_ATAN_DEGREES}, 
+    {1, (const char*[]){"atan2d"}, CALC_OP_ATAN2_DEGREES}, 
+    {1, (const char*[]){"tor"}, CALC_OP_TO_RADIANS}, 
+    {1, (const char*[]){"tod"}, CALC_OP_TO_DEGREES}, 
 }; 
@@ -23,49 +23,36 @@
  */
 
 #include <string.h>
-#include <math.h>
 
 #include "watch_private_display.h"
 #include "morsecalc_display.h"
 
-// Display float on screen
-void morsecalc_display_float(double d) { 
+// Display number on screen
+void morsecalc_display_number(calc_number_t x) { 
     // Special cases 
-    if(d == 0) {
+    if(calc_number_is_zero(x)) {
         watch_display_string("     0", 4); 
         return;
     }
-    else if(isnan(d)) {
+    else if(calc_number_is_nan(x)) {
         watch_display_string("   nan", 4);
         return;
     }
-    else if(d == (1.0)/(0.0)) {
-        watch_display_string("   inf", 4);
-        return;
-    }
-    else if(d == (-1.0)/(0.0)) {
-        watch_display_character('X', 1);
+    else if(calc_number_is_infinite(x)) {
+        if(calc_number_is_negative(x)) watch_display_character('X', 1);
         watch_display_string("   inf", 4);
         return;
     }
 
     // Record number properties
     // Sign
-    int is_negative = d<0;
-    if(is_negative) d = -d; 
+    int is_negative = calc_number_is_negative(x);
 
-    // Order of magnitude
-    int om = (int) floor(log(d)/log(10));
+    // First 4 significant figures, and order of magnitude
+    int16_t om;
+    int digits = calc_number_digits(x, 4, &om);
     int om_is_negative = (om<0);
 
-    // Get the first 4 significant figures
-    int digits;
-    digits = round(d*pow(10.0, 3-om));
-    if(digits>9999) {
-        digits = 1000;
-        om++;
-    }
-
     // Print signs
     if(is_negative) {
 		// Xi; see https://joeycastillo.github.io/Sensor-Watch-Documentation/segmap
@@ -92,7 +79,7 @@ void morsecalc_display_float(double d) {
         if(om_is_negative) watch_display_string("    uf", 4);
         else watch_display_string("    of", 4);
         if(om<9999) { // Use main display to show order of magnitude
-            // (Should always succeed; max double is <2e308)
+            // (Should always succeed; calc_number_t tops out at 1e999)
             watch_display_character('0'+(om/1000)%10, 4);
             watch_display_character('0'+(om/100 )%10, 5);
             watch_display_character('0'+(om/10  )%10, 6);
@@ -128,7 +115,7 @@ void morsecalc_display_stack(morsecalc_state_t * mcs) {
 
     char c = MORSECODE_TREE[mcs->mc]; 
     if('m' == c) { // Display memory 
-        morsecalc_display_float(mcs->cs->mem);
+        morsecalc_display_number(mcs->cs->mem);
         watch_display_character(c, 0);
     } 
     else {
@@ -137,7 +124,7 @@ void morsecalc_display_stack(morsecalc_state_t * mcs) {
         uint8_t idx = 0;
         if(c >= '0' && c <= '9') idx = c - '0';
         if(idx >= mcs->cs->s) watch_display_string(" empty", 4); // Stack empty
-        else morsecalc_display_float(mcs->cs->stack[mcs->cs->s-1-idx]); // Print stack item
+        else morsecalc_display_number(mcs->cs->stack[mcs->cs->s-1-idx]); // Print stack item
 
         watch_display_character('0'+idx, 0); // Print which stack item this is top center
     }
@@ -24,8 +24,8 @@
 
 #include "morsecalc_face.h"
 
-// Display float on screen
-void morsecalc_display_float(double d);
+// Display number on screen
+void morsecalc_display_number(calc_number_t x);
 
 // Print current input token
 void morsecalc_display_token(morsecalc_state_t *mcs);
@@ -23,7 +23,7 @@
  */
 
 // Computer console interface to calc and morsecode for testing without involving watch stuff.
-// cc calc_strtof.c calc.c calc_fns.c test_morsecalc.c -lm
+// cc -I../calc ../calc/calc_number.c ../calc/calc_ops.c calc.c test_morsecalc.c
 
 #include <stdio.h>
 #include <stdlib.h>
@@ -56,7 +56,7 @@ int main(void) {
                 case -2: printf("Stack over/underflow.\n"); break;
                 case -3: printf("Error.\n"); break;
             }
-            if(cs.s > 0) printf("[%i]: %.4f\n", cs.s, cs.stack[cs.s-1]);
+            if(cs.s > 0) printf("[%i]: %de%d\n", cs.s, (int)cs.stack[cs.s-1].mantissa, cs.stack[cs.s-1].exponent);
             else printf("[%i]\n", cs.s);
         }
     }
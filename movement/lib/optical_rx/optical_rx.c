@@ -0,0 +1,142 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include "optical_rx.h"
+#include "chirpy_tx.h"
+
+// where a byte is while it's coming in.
+#define OPTICAL_RX_IDLE (-1)
+#define OPTICAL_RX_START_BIT 0
+#define OPTICAL_RX_STOP_BIT 9
+
+// where a frame is while it's coming in; after the type come the payload bytes, and then the CRC.
+#define OPTICAL_RX_FRAME_SYNC 0
+#define OPTICAL_RX_FRAME_LENGTH 1
+#define OPTICAL_RX_FRAME_TYPE 2
+#define OPTICAL_RX_FRAME_PAYLOAD 3
+
+void optical_rx_init(optical_rx_state_t *ors, uint8_t samples_per_bit) {
+    memset(ors, 0, sizeof(optical_rx_state_t));
+    ors->low = UINT16_MAX;
+    ors->high = 0;
+    ors->level = true;
+    ors->samples_per_bit = samples_per_bit < 3 ? 3 : samples_per_bit;
+    ors->bit_index = OPTICAL_RX_IDLE;
+}
+
+static void optical_rx_track_levels(optical_rx_state_t *ors, uint16_t sample) {
+    // the levels jump out to a new extreme at once, and drift back in towards the samples over a second or so
+    // at 512 samples a second, so a long run of the same bit doesn't close them up.
+    if (sample > ors->high) ors->high = sample;
+    else ors->high -= (ors->high - sample) >> 9;
+    if (sample < ors->low) ors->low = sample;
+    else ors->low += (sample - ors->low) >> 9;
+}
+
+static bool optical_rx_add_byte(optical_rx_state_t *ors, uint8_t byte) {
+    switch (ors->frame_pos) {
+        case OPTICAL_RX_FRAME_SYNC:
+            if (byte == OPTICAL_RX_SYNC) {
+                ors->crc = 0;
+                ors->frame_pos = OPTICAL_RX_FRAME_LENGTH;
+            }
+            return false;
+        case OPTICAL_RX_FRAME_LENGTH:
+            if (byte > OPTICAL_RX_MAX_PAYLOAD) {
+                ors->bad_frames++;
+                ors->frame_pos = OPTICAL_RX_FRAME_SYNC;
+                return false;
+            }
+            ors->frame.length = byte;
+            break;
+        case OPTICAL_RX_FRAME_TYPE:
+            ors->frame.type = byte;
+            break;
+        default:
+            if (ors->frame_pos < OPTICAL_RX_FRAME_PAYLOAD + ors->frame.length) {
+                ors->frame.payload[ors->frame_pos - OPTICAL_RX_FRAME_PAYLOAD] = byte;
+                break;
+            }
+            // that was the CRC.
+            ors->frame_pos = OPTICAL_RX_FRAME_SYNC;
+            if (byte == ors->crc) return true;
+            ors->bad_frames++;
+            return false;
+    }
+    ors->crc = chirpy_update_crc8(byte, ors->crc);
+    ors->frame_pos++;
+    return false;
+}
+
+bool optical_rx_add_sample(optical_rx_state_t *ors, uint16_t sample) {
+    optical_rx_track_levels(ors, sample);
+    uint16_t swing = ors->high - ors->low;
+    if (ors->high < ors->low || swing < OPTICAL_RX_MIN_SWING) {
+        // nothing that looks like a signal yet; wait for the line to rest light.
+        ors->level = true;
+        ors->bit_index = OPTICAL_RX_IDLE;
+        return false;
+    }
+
+    // decide light or dark, with a little hysteresis so that a level near the middle doesn't flicker.
+    bool previous = ors->level;
+    uint16_t middle = ors->low + swing / 2;
+    if (ors->level && sample < middle - swing / 8) ors->level = false;
+    else if (!ors->level && sample > middle + swing / 8) ors->level = true;
+
+    if (ors->bit_index == OPTICAL_RX_IDLE) {
+        if (previous && !ors->level) {
+            // the start bit's leading edge: check it again halfway through, then take each bit in its middle.
+            ors->bit_index = OPTICAL_RX_START_BIT;
+            ors->countdown = (ors->samples_per_bit - 1) / 2;
+        }
+        return false;
+    }
+    if (--ors->countdown) return false;
+    ors->countdown = ors->samples_per_bit;
+
+    if (ors->bit_index == OPTICAL_RX_START_BIT) {
+        // a glitch, not a start bit.
+        if (ors->level) ors->bit_index = OPTICAL_RX_IDLE;
+        else ors->bit_index++;
+        return false;
+    }
+    if (ors->bit_index < OPTICAL_RX_STOP_BIT) {
+        ors->shift = (ors->shift >> 1) | (ors->level ? 0x80 : 0);
+        ors->bit_index++;
+        return false;
+    }
+
+    ors->bit_index = OPTICAL_RX_IDLE;
+    if (!ors->level) {
+        // the stop bit should have been light; we've lost our place, so wait for the next frame.
+        ors->framing_errors++;
+        ors->frame_pos = OPTICAL_RX_FRAME_SYNC;
+        return false;
+    }
+    return optical_rx_add_byte(ors, ors->shift);
+}
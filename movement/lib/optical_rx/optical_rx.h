@@ -0,0 +1,89 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef OPTICAL_RX_H
+#define OPTICAL_RX_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Decodes data sent as flashes of light, sampled as levels from a light sensor at a steady rate.
+ *
+ * Each byte goes out like a serial port's: a dark start bit, eight data bits, least significant first, with light
+ * for 1, and a light stop bit. The line rests light between bytes. Bytes are gathered into frames:
+ *
+ *     OPTICAL_RX_SYNC, length, type, length bytes of payload, CRC
+ *
+ * where the CRC is chirpy's CRC-8 (@see chirpy_update_crc8) of the length, type and payload. A frame with a bad CRC
+ * is dropped whole; there's no way to ask for it again, so a sender should repeat the whole transmission until the
+ * receiver has it. The decoder finds the levels of light and dark for itself, from the highest and lowest samples
+ * it has seen lately, so it works at any brightness once it has seen a few bytes.
+ */
+
+/// The byte that starts each frame.
+#define OPTICAL_RX_SYNC 0x7E
+
+/// Most bytes of payload in a frame.
+#define OPTICAL_RX_MAX_PAYLOAD 64
+
+/// The least difference between light and dark, in 16-bit ADC counts, for the decoder to take it as a signal.
+#define OPTICAL_RX_MIN_SWING 4096
+
+typedef struct {
+    uint8_t type;
+    uint8_t length;
+    uint8_t payload[OPTICAL_RX_MAX_PAYLOAD];
+} optical_rx_frame_t;
+
+// Holds state used by the decoder. Do not manipulate directly.
+typedef struct {
+    uint16_t low;
+    uint16_t high;
+    bool level;
+    uint8_t samples_per_bit;
+    uint8_t countdown;
+    int8_t bit_index;
+    uint8_t shift;
+    uint8_t frame_pos;
+    uint8_t crc;
+    optical_rx_frame_t frame;
+    uint16_t framing_errors;
+    uint16_t bad_frames;
+} optical_rx_state_t;
+
+/** @brief Initializes the decoder state to be used during the reception.
+ * @param ors Pointer to decoder state object to be initialized.
+ * @param samples_per_bit How many samples the sender holds each bit for, at least 3.
+ */
+void optical_rx_init(optical_rx_state_t *ors, uint8_t samples_per_bit);
+
+/** @brief Feeds the decoder the next sample.
+ * @param ors Pointer to the decoder state object.
+ * @param sample The light level, as a 16-bit ADC reading; higher is brighter.
+ * @return true if the sample completed a frame with a good CRC, which is in ors->frame until the next sample.
+ */
+bool optical_rx_add_sample(optical_rx_state_t *ors, uint16_t sample);
+
+#endif
@@ -14,10 +14,10 @@ Released to the public domain by Paul Schlyter, December 1992
 */
 
 #include <stdio.h>
-#include <math.h>
+#include <tgmath.h>
 #include "sunriset.h"
 
-static void sunpos( double d, double *lon, double *r );
+static void sunpos( sunriset_real d, sunriset_real *lon, sunriset_real *r );
 
 /* A macro to compute the number of days elapsed since 2000 Jan 0.0 */
 /* (which is equal to 1999 Dec 31, 0h UT)                           */
@@ -28,27 +28,37 @@ static void sunpos( double d, double *lon, double *r );
 /* Some conversion factors between radians and degrees */
 
 #ifndef PI
- #define PI        3.1415926535897932384
+ #define PI        SUNRISET_REAL(3.1415926535897932384)
 #endif
 
-#define RADEG     ( 180.0 / PI )
-#define DEGRAD    ( PI / 180.0 )
+#define RADEG     ( SUNRISET_REAL(180.0) / PI )
+#define DEGRAD    ( PI / SUNRISET_REAL(180.0) )
 
-/* The trigonometric functions in degrees */
+/* The trigonometric functions in degrees. With FAST_MATH, the ones */
+/* used here come from watch_math, whose approximations are float   */
+/* only and good to well under a second of rise or set time.        */
 
+#if defined(SUNRISET_SINGLE_PRECISION) && defined(WATCH_FAST_MATH)
+#include "watch_math.h"
+#define sind(x)  watch_sinf((x)*DEGRAD)
+#define cosd(x)  watch_cosf((x)*DEGRAD)
+#define acosd(x)    (RADEG*watch_acosf(x))
+#define atan2d(y,x) (RADEG*watch_atan2f(y,x))
+#else
 #define sind(x)  sin((x)*DEGRAD)
 #define cosd(x)  cos((x)*DEGRAD)
+#define acosd(x)    (RADEG*acos(x))
+#define atan2d(y,x) (RADEG*atan2(y,x))
+#endif
 #define tand(x)  tan((x)*DEGRAD)
 
 #define atand(x)    (RADEG*atan(x))
 #define asind(x)    (RADEG*asin(x))
-#define acosd(x)    (RADEG*acos(x))
-#define atan2d(y,x) (RADEG*atan2(y,x))
 
 /* The "workhorse" function for sun rise/set times */
 
-int __sunriset__( int year, int month, int day, double lon, double lat,
-                  double altit, int upper_limb, double *trise, double *tset )
+int __sunriset__( int year, int month, int day, sunriset_real lon, sunriset_real lat,
+                  sunriset_real altit, int upper_limb, double *trise, double *tset )
 /***************************************************************************/
 /* Note: year,month,date = calendar date, 1801-2099 only.             */
 /*       Eastern longitude positive, Western longitude negative       */
@@ -79,7 +89,7 @@ int __sunriset__( int year, int month, int day, double lon, double lat,
 /*                                                                    */
 /**********************************************************************/
 {
-      double  d,  /* Days since 2000 Jan 0.0 (negative before) */
+      sunriset_real  d,  /* Days since 2000 Jan 0.0 (negative before) */
       sr,         /* Solar distance, astronomical units */
       sRA,        /* Sun's Right Ascension */
       sdec,       /* Sun's declination */
@@ -91,19 +101,19 @@ int __sunriset__( int year, int month, int day, double lon, double lat,
       int rc = 0; /* Return cde from function - usually 0 */
 
       /* Compute d of 12h local mean solar time */
-      d = days_since_2000_Jan_0(year,month,day) + 0.5 - lon/360.0;
+      d = days_since_2000_Jan_0(year,month,day) + SUNRISET_REAL(0.5) - lon/SUNRISET_REAL(360.0);
 
       /* Compute the local sidereal time of this moment */
-      sidtime = revolution( GMST0(d) + 180.0 + lon );
+      sidtime = revolution( GMST0(d) + SUNRISET_REAL(180.0) + lon );
 
       /* Compute Sun's RA, Decl and distance at this moment */
       sun_RA_dec( d, &sRA, &sdec, &sr );
 
       /* Compute time when Sun is at south - in hours UT */
-      tsouth = 12.0 - rev180(sidtime - sRA)/15.0;
+      tsouth = SUNRISET_REAL(12.0) - rev180(sidtime - sRA)/SUNRISET_REAL(15.0);
 
       /* Compute the Sun's apparent radius in degrees */
-      sradius = 0.2666 / sr;
+      sradius = SUNRISET_REAL(0.2666) / sr;
 
       /* Do correction to upper limb, if necessary */
       if ( upper_limb )
@@ -112,15 +122,15 @@ int __sunriset__( int year, int month, int day, double lon, double lat,
       /* Compute the diurnal arc that the Sun traverses to reach */
       /* the specified altitude altit: */
       {
-            double cost;
+            sunriset_real cost;
             cost = ( sind(altit) - sind(lat) * sind(sdec) ) /
                   ( cosd(lat) * cosd(sdec) );
-            if ( cost >= 1.0 )
-                  rc = -1, t = 0.0;       /* Sun always below altit */
-            else if ( cost <= -1.0 )
-                  rc = +1, t = 12.0;      /* Sun always above altit */
+            if ( cost >= SUNRISET_REAL(1.0) )
+                  rc = -1, t = SUNRISET_REAL(0.0);       /* Sun always below altit */
+            else if ( cost <= -SUNRISET_REAL(1.0) )
+                  rc = +1, t = SUNRISET_REAL(12.0);      /* Sun always above altit */
             else
-                  t = acosd(cost)/15.0;   /* The diurnal arc, hours */
+                  t = acosd(cost)/SUNRISET_REAL(15.0);   /* The diurnal arc, hours */
       }
 
       /* Store rise and set times - in hours UT */
@@ -135,8 +145,8 @@ int __sunriset__( int year, int month, int day, double lon, double lat,
 /* The "workhorse" function */
 
 
-double __daylen__( int year, int month, int day, double lon, double lat,
-                   double altit, int upper_limb )
+sunriset_real __daylen__( int year, int month, int day, sunriset_real lon, sunriset_real lat,
+                   sunriset_real altit, int upper_limb )
 /**********************************************************************/
 /* Note: year,month,date = calendar date, 1801-2099 only.             */
 /*       Eastern longitude positive, Western longitude negative       */
@@ -153,7 +163,7 @@ double __daylen__( int year, int month, int day, double lon, double lat,
 /*               and to zero when computing day+twilight length.      */
 /**********************************************************************/
 {
-      double  d,  /* Days since 2000 Jan 0.0 (negative before) */
+      sunriset_real  d,  /* Days since 2000 Jan 0.0 (negative before) */
       obl_ecl,    /* Obliquity (inclination) of Earth's axis */
       sr,         /* Solar distance, astronomical units */
       slon,       /* True solar longitude */
@@ -163,20 +173,20 @@ double __daylen__( int year, int month, int day, double lon, double lat,
       t;          /* Diurnal arc */
 
       /* Compute d of 12h local mean solar time */
-      d = days_since_2000_Jan_0(year,month,day) + 0.5 - lon/360.0;
+      d = days_since_2000_Jan_0(year,month,day) + SUNRISET_REAL(0.5) - lon/SUNRISET_REAL(360.0);
 
       /* Compute obliquity of ecliptic (inclination of Earth's axis) */
-      obl_ecl = 23.4393 - 3.563E-7 * d;
+      obl_ecl = SUNRISET_REAL(23.4393) - SUNRISET_REAL(3.563E-7) * d;
 
       /* Compute Sun's ecliptic longitude and distance */
       sunpos( d, &slon, &sr );
 
       /* Compute sine and cosine of Sun's declination */
       sin_sdecl = sind(obl_ecl) * sind(slon);
-      cos_sdecl = sqrt( 1.0 - sin_sdecl * sin_sdecl );
+      cos_sdecl = sqrt( SUNRISET_REAL(1.0) - sin_sdecl * sin_sdecl );
 
       /* Compute the Sun's apparent radius, degrees */
-      sradius = 0.2666 / sr;
+      sradius = SUNRISET_REAL(0.2666) / sr;
 
       /* Do correction to upper limb, if necessary */
       if ( upper_limb )
@@ -185,14 +195,14 @@ double __daylen__( int year, int month, int day, double lon, double lat,
       /* Compute the diurnal arc that the Sun traverses to reach */
       /* the specified altitude altit: */
       {
-            double cost;
+            sunriset_real cost;
             cost = ( sind(altit) - sind(lat) * sin_sdecl ) /
                   ( cosd(lat) * cos_sdecl );
-            if ( cost >= 1.0 )
-                  t = 0.0;                      /* Sun always below altit */
-            else if ( cost <= -1.0 )
-                  t = 24.0;                     /* Sun always above altit */
-            else  t = (2.0/15.0) * acosd(cost); /* The diurnal arc, hours */
+            if ( cost >= SUNRISET_REAL(1.0) )
+                  t = SUNRISET_REAL(0.0);                      /* Sun always below altit */
+            else if ( cost <= -SUNRISET_REAL(1.0) )
+                  t = SUNRISET_REAL(24.0);                     /* Sun always above altit */
+            else  t = (SUNRISET_REAL(2.0)/SUNRISET_REAL(15.0)) * acosd(cost); /* The diurnal arc, hours */
       }
       return t;
 }  /* __daylen__ */
@@ -200,7 +210,7 @@ double __daylen__( int year, int month, int day, double lon, double lat,
 
 /* This function computes the Sun's position at any instant */
 
-static void sunpos( double d, double *lon, double *r )
+static void sunpos( sunriset_real d, sunriset_real *lon, sunriset_real *r )
 /******************************************************/
 /* Computes the Sun's ecliptic longitude and distance */
 /* at an instant given in d, number of days since     */
@@ -208,7 +218,7 @@ static void sunpos( double d, double *lon, double *r )
 /* computed, since it's always very near 0.           */
 /******************************************************/
 {
-      double M,         /* Mean anomaly of the Sun */
+      sunriset_real M,         /* Mean anomaly of the Sun */
              w,         /* Mean longitude of perihelion */
                         /* Note: Sun's mean longitude = M + w */
              e,         /* Eccentricity of Earth's orbit */
@@ -217,29 +227,29 @@ static void sunpos( double d, double *lon, double *r )
              v;         /* True anomaly */
 
       /* Compute mean elements */
-      M = revolution( 356.0470 + 0.9856002585 * d );
-      w = 282.9404 + 4.70935E-5 * d;
-      e = 0.016709 - 1.151E-9 * d;
+      M = revolution( SUNRISET_REAL(356.0470) + SUNRISET_REAL(0.9856002585) * d );
+      w = SUNRISET_REAL(282.9404) + SUNRISET_REAL(4.70935E-5) * d;
+      e = SUNRISET_REAL(0.016709) - SUNRISET_REAL(1.151E-9) * d;
 
       /* Compute true longitude and radius vector */
-      E = M + e * RADEG * sind(M) * ( 1.0 + e * cosd(M) );
+      E = M + e * RADEG * sind(M) * ( SUNRISET_REAL(1.0) + e * cosd(M) );
             x = cosd(E) - e;
-      y = sqrt( 1.0 - e*e ) * sind(E);
+      y = sqrt( SUNRISET_REAL(1.0) - e*e ) * sind(E);
       *r = sqrt( x*x + y*y );              /* Solar distance */
       v = atan2d( y, x );                  /* True anomaly */
       *lon = v + w;                        /* True solar longitude */
-      if ( *lon >= 360.0 )
-            *lon -= 360.0;                   /* Make it 0..360 degrees */
+      if ( *lon >= SUNRISET_REAL(360.0) )
+            *lon -= SUNRISET_REAL(360.0);                   /* Make it 0..360 degrees */
 }
 
-void sun_RA_dec( double d, double *RA, double *dec, double *r )
+void sun_RA_dec( sunriset_real d, sunriset_real *RA, sunriset_real *dec, sunriset_real *r )
 /******************************************************/
 /* Computes the Sun's equatorial coordinates RA, Decl */
 /* and also its distance, at an instant given in d,   */
 /* the number of days since 2000 Jan 0.0.             */
 /******************************************************/
 {
-      double lon, obl_ecl, x, y, z;
+      sunriset_real lon, obl_ecl, x, y, z;
 
       /* Compute Sun's ecliptical coordinates */
       sunpos( d, &lon, r );
@@ -249,7 +259,7 @@ void sun_RA_dec( double d, double *RA, double *dec, double *r )
       y = *r * sind(lon);
 
       /* Compute obliquity of ecliptic (inclination of Earth's axis) */
-      obl_ecl = 23.4393 - 3.563E-7 * d;
+      obl_ecl = SUNRISET_REAL(23.4393) - SUNRISET_REAL(3.563E-7) * d;
 
       /* Convert to equatorial rectangular coordinates - x is unchanged */
       z = y * sind(obl_ecl);
@@ -268,22 +278,22 @@ void sun_RA_dec( double d, double *RA, double *dec, double *r )
 /* result is >= 0.0 and < 360.0                                   */
 /******************************************************************/
 
-#define INV360    ( 1.0 / 360.0 )
+#define INV360    ( SUNRISET_REAL(1.0) / SUNRISET_REAL(360.0) )
 
-double revolution( double x )
+sunriset_real revolution( sunriset_real x )
 /*****************************************/
 /* Reduce angle to within 0..360 degrees */
 /*****************************************/
 {
-      return( x - 360.0 * floor( x * INV360 ) );
+      return( x - SUNRISET_REAL(360.0) * floor( x * INV360 ) );
 }  /* revolution */
 
-double rev180( double x )
+sunriset_real rev180( sunriset_real x )
 /*********************************************/
 /* Reduce angle to within +180..+180 degrees */
 /*********************************************/
 {
-      return( x - 360.0 * floor( x * INV360 + 0.5 ) );
+      return( x - SUNRISET_REAL(360.0) * floor( x * INV360 + SUNRISET_REAL(0.5) ) );
 }  /* revolution */
 
 
@@ -313,15 +323,15 @@ double rev180( double x )
 /*                                                                 */
 /*******************************************************************/
 
-double GMST0( double d )
+sunriset_real GMST0( sunriset_real d )
 {
-      double sidtim0;
+      sunriset_real sidtim0;
       /* Sidtime at 0h UT = L (Sun's mean longitude) + 180.0 degr  */
       /* L = M + w, as defined in sunpos().  Since I'm too lazy to */
       /* add these numbers, I'll let the C compiler do it for me.  */
       /* Any decent C compiler will add the constants at compile   */
       /* time, imposing no runtime or code overhead.               */
-      sidtim0 = revolution( ( 180.0 + 356.0470 + 282.9404 ) +
-                          ( 0.9856002585 + 4.70935E-5 ) * d );
+      sidtim0 = revolution( ( SUNRISET_REAL(180.0) + SUNRISET_REAL(356.0470) + SUNRISET_REAL(282.9404) ) +
+                          ( SUNRISET_REAL(0.9856002585) + SUNRISET_REAL(4.70935E-5) ) * d );
       return sidtim0;
 }  /* GMST0 */
\ No newline at end of file
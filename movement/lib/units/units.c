@@ -0,0 +1,146 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include "units.h"
+
+typedef struct {
+    uint8_t dimension;
+    // a value in this unit is (value × numerator + offset) / denominator of its dimension's base unit.
+    uint32_t numerator;
+    uint32_t denominator;
+    int32_t offset;
+} units_definition_t;
+
+// the imperial units are the UK's, from the 4.54609 litre gallon, and the US customary ones, from the 231 cubic inch
+// gallon (3785.411784 ml); the avoirdupois pound is 453.59237 g.
+static const units_definition_t _units_definitions[UNITS_NUM_UNITS] = {
+    [UNITS_GRAM] = { UNITS_MASS, 1, 1, 0 },
+    [UNITS_KILOGRAM] = { UNITS_MASS, 1000, 1, 0 },
+    [UNITS_OUNCE] = { UNITS_MASS, 45359237, 1600000, 0 },
+    [UNITS_POUND] = { UNITS_MASS, 45359237, 100000, 0 },
+
+    [UNITS_CELSIUS] = { UNITS_TEMPERATURE, 9, 5, 160 },
+    [UNITS_FAHRENHEIT] = { UNITS_TEMPERATURE, 1, 1, 0 },
+    // each mark is 25 °F from 250 °F at mark 0, which holds from mark 1 up.
+    [UNITS_GAS_MARK] = { UNITS_TEMPERATURE, 25, 1, 250 },
+
+    [UNITS_MILLILITRE] = { UNITS_VOLUME, 1, 1, 0 },
+    [UNITS_LITRE] = { UNITS_VOLUME, 1000, 1, 0 },
+    [UNITS_UK_FLUID_OUNCE] = { UNITS_VOLUME, 454609, 16000, 0 },     // 1/160 gallon
+    [UNITS_UK_TABLESPOON] = { UNITS_VOLUME, 454609, 25600, 0 },      // 5/8 fluid ounce
+    [UNITS_UK_TEASPOON] = { UNITS_VOLUME, 454609, 76800, 0 },        // 1/3 tablespoon
+    [UNITS_UK_CUP] = { UNITS_VOLUME, 454609, 1600, 0 },              // half a pint
+    [UNITS_UK_PINT] = { UNITS_VOLUME, 454609, 800, 0 },
+    [UNITS_UK_QUART] = { UNITS_VOLUME, 454609, 400, 0 },
+    [UNITS_UK_GALLON] = { UNITS_VOLUME, 454609, 100, 0 },
+    [UNITS_US_FLUID_OUNCE] = { UNITS_VOLUME, 473176473, 16000000, 0 },  // 1/128 gallon
+    [UNITS_US_TABLESPOON] = { UNITS_VOLUME, 473176473, 32000000, 0 },   // half a fluid ounce
+    [UNITS_US_TEASPOON] = { UNITS_VOLUME, 473176473, 96000000, 0 },     // 1/3 tablespoon
+    [UNITS_US_CUP] = { UNITS_VOLUME, 473176473, 2000000, 0 },           // half a pint
+    [UNITS_US_PINT] = { UNITS_VOLUME, 473176473, 1000000, 0 },
+    [UNITS_US_QUART] = { UNITS_VOLUME, 473176473, 500000, 0 },
+    [UNITS_US_GALLON] = { UNITS_VOLUME, 473176473, 125000, 0 },
+
+    [UNITS_METRES_PER_SECOND] = { UNITS_SPEED, 1, 1, 0 },
+    [UNITS_KILOMETRES_PER_HOUR] = { UNITS_SPEED, 5, 18, 0 },
+    [UNITS_MILES_PER_HOUR] = { UNITS_SPEED, 1397, 3125, 0 },        // 1609.344 m an hour
+    [UNITS_KNOTS] = { UNITS_SPEED, 463, 900, 0 },                   // 1852 m an hour
+};
+
+static uint64_t _units_gcd(uint64_t a, uint64_t b) {
+    while (b) {
+        uint64_t t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+static int64_t _units_pow_10(uint8_t n) {
+    int64_t result = 1;
+    while (n--) result *= 10;
+    return result;
+}
+
+units_dimension_t units_dimension(units_unit_t unit) {
+    return (units_dimension_t)_units_definitions[unit].dimension;
+}
+
+bool units_convert(int32_t value, uint8_t value_decimals, units_unit_t from, units_unit_t to, uint8_t result_decimals,
+                   int32_t *result) {
+    const units_definition_t *a = &_units_definitions[from];
+    const units_definition_t *b = &_units_definitions[to];
+    if (a->dimension != b->dimension) return false;
+
+    // from's base value is (x × na + oa) / da, and x in to is that × db, less ob, over nb; so, all over da × nb,
+    // x × na × db + oa × db - ob × da, with the common factors taken out.
+    uint64_t scale = (uint64_t)a->numerator * b->denominator;
+    uint64_t divisor = (uint64_t)a->denominator * b->numerator;
+    int64_t offset = (int64_t)a->offset * b->denominator - (int64_t)b->offset * a->denominator;
+    uint64_t common = _units_gcd(scale, divisor);
+    if (offset) common = _units_gcd(common, llabs(offset));
+    scale /= common;
+    divisor /= common;
+    offset /= (int64_t)common;
+    if (scale > INT64_MAX || divisor > INT64_MAX) return false;
+
+    // then the decimal places: more in the result scale the value up, fewer scale the divisor up.
+    int64_t up = result_decimals > value_decimals ? _units_pow_10(result_decimals - value_decimals) : 1;
+    int64_t down = value_decimals > result_decimals ? _units_pow_10(value_decimals - result_decimals) : 1;
+    int64_t numerator, term, denominator;
+    if (__builtin_mul_overflow((int64_t)scale, up, &numerator) ||
+        __builtin_mul_overflow(numerator, (int64_t)value, &numerator) ||
+        __builtin_mul_overflow(offset, _units_pow_10(result_decimals) * down, &term) ||
+        __builtin_add_overflow(numerator, term, &numerator) ||
+        __builtin_mul_overflow((int64_t)divisor, down, &denominator)) return false;
+
+    int64_t quotient = numerator / denominator;
+    int64_t remainder = llabs(numerator % denominator);
+    if (remainder >= denominator - remainder) quotient += numerator < 0 ? -1 : 1;
+    if (quotient > INT32_MAX || quotient < INT32_MIN) return false;
+    *result = (int32_t)quotient;
+
+    return true;
+}
+
+bool units_format(char *buf, uint8_t width, int32_t value, uint8_t decimals, char point) {
+    uint32_t magnitude = value < 0 ? -(uint32_t)value : (uint32_t)value;
+    uint8_t digits = 1;
+    for (uint32_t rest = magnitude / 10; rest; rest /= 10) digits++;
+    if (digits < decimals + 1) digits = decimals + 1;
+    if (digits + (point && decimals ? 1 : 0) + (value < 0 ? 1 : 0) > width) return false;
+
+    char *c = buf + width;
+    *c = 0;
+    for (uint8_t i = 0; i < digits; i++) {
+        if (point && decimals && i == decimals) *--c = point;
+        *--c = '0' + magnitude % 10;
+        magnitude /= 10;
+    }
+    if (value < 0) *--c = '-';
+    while (c > buf) *--c = ' ';
+
+    return true;
+}
@@ -0,0 +1,100 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef UNITS_H_
+#define UNITS_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+ * Conversions between units of measure, in integers only. Each unit is defined exactly, as a ratio of two integers to
+ * its dimension's base unit, plus an offset for the temperature scales, so a conversion is one 64-bit multiply and
+ * divide, rounded once at the end: no floating point (which the SAM L22 only has in software), and nothing like the
+ * 28.34952 that a float of the ounce has to settle for. Values go in and out as fixed point integers, with however many
+ * decimal places the face works in, and units_format lays them out for the display without going through printf.
+ */
+
+typedef enum {
+    UNITS_MASS = 0,         // base: grams
+    UNITS_TEMPERATURE,      // base: degrees Fahrenheit
+    UNITS_VOLUME,           // base: millilitres
+    UNITS_SPEED,            // base: metres per second
+} units_dimension_t;
+
+typedef enum {
+    UNITS_GRAM = 0,
+    UNITS_KILOGRAM,
+    UNITS_OUNCE,
+    UNITS_POUND,
+
+    UNITS_CELSIUS,
+    UNITS_FAHRENHEIT,
+    UNITS_GAS_MARK,
+
+    UNITS_MILLILITRE,
+    UNITS_LITRE,
+    UNITS_UK_FLUID_OUNCE,
+    UNITS_UK_TABLESPOON,
+    UNITS_UK_TEASPOON,
+    UNITS_UK_CUP,
+    UNITS_UK_PINT,
+    UNITS_UK_QUART,
+    UNITS_UK_GALLON,
+    UNITS_US_FLUID_OUNCE,
+    UNITS_US_TABLESPOON,
+    UNITS_US_TEASPOON,
+    UNITS_US_CUP,
+    UNITS_US_PINT,
+    UNITS_US_QUART,
+    UNITS_US_GALLON,
+
+    UNITS_METRES_PER_SECOND,
+    UNITS_KILOMETRES_PER_HOUR,
+    UNITS_MILES_PER_HOUR,
+    UNITS_KNOTS,
+
+    UNITS_NUM_UNITS
+} units_unit_t;
+
+units_dimension_t units_dimension(units_unit_t unit);
+
+/** @brief Converts a value from one unit to another of the same dimension.
+  * @param value The value in from, as a fixed point integer with value_decimals decimal places (so 2.5 to two places
+  *              is 250).
+  * @param result Set to the value in to, with result_decimals decimal places, rounded half away from zero.
+  * @return false, leaving result alone, if the units measure different things or the result doesn't fit an int32_t.
+  */
+bool units_convert(int32_t value, uint8_t value_decimals, units_unit_t from, units_unit_t to, uint8_t result_decimals,
+                   int32_t *result);
+
+/** @brief Writes a fixed point value into width characters of buf, right-aligned and padded with spaces, with a zero
+  *        before the decimals if there's no whole part and a minus sign if it's negative, then a terminating NUL.
+  * @param point The character to put between the whole part and the decimals, which takes up a place of its own; or 0
+  *              to run them together, as on the LCD's seconds digits, where the last two digits read as hundredths.
+  * @return false, leaving buf alone, if the value doesn't fit.
+  */
+bool units_format(char *buf, uint8_t width, int32_t value, uint8_t decimals, char point);
+
+#endif // UNITS_H_
@@ -1,17 +1,46 @@
-//VSOP87-Multilang http://www.astrogreg.com/vsop87-multilang/index.html
-//Greg Miller (gmiller@gregmiller.net) 2019.  Released as Public Domain
-
-#ifndef VSOP87A_MICRO
-#define VSOP87A_MICRO
-
-   void vsop87a_micro_getEarth(double t,double temp[]);
-   void vsop87a_micro_getEmb(double t,double temp[]);
-   void vsop87a_micro_getJupiter(double t,double temp[]);
-   void vsop87a_micro_getMars(double t,double temp[]);
-   void vsop87a_micro_getMercury(double t,double temp[]);
-   void vsop87a_micro_getNeptune(double t,double temp[]);
-   void vsop87a_micro_getSaturn(double t,double temp[]);
-   void vsop87a_micro_getUranus(double t,double temp[]);
-   void vsop87a_micro_getVenus(double t,double temp[]);
-   void vsop87a_micro_getMoon(double earth[], double emb[],double temp[]);
-#endif
+//VSOP87-Multilang http://www.astrogreg.com/vsop87-multilang/index.html
+//Greg Miller (gmiller@gregmiller.net) 2019.  Released as Public Domain
+
+#ifndef VSOP87A_MICRO
+#define VSOP87A_MICRO
+
+   void vsop87a_micro_getEarth(double t,double temp[]);
+   void vsop87a_micro_getEmb(double t,double temp[]);
+   void vsop87a_micro_getJupiter(double t,double temp[]);
+   void vsop87a_micro_getMars(double t,double temp[]);
+   void vsop87a_micro_getMercury(double t,double temp[]);
+   void vsop87a_micro_getNeptune(double t,double temp[]);
+   void vsop87a_micro_getSaturn(double t,double temp[]);
+   void vsop87a_micro_getUranus(double t,double temp[]);
+   void vsop87a_micro_getVenus(double t,double temp[]);
+   void vsop87a_micro_getMoon(double earth[], double emb[],double temp[]);
+
+   // one coordinate at a time, for callers that spread the work out.
+   double vsop87a_micro_earth_x(double t);
+   double vsop87a_micro_earth_y(double t);
+   double vsop87a_micro_earth_z(double t);
+   double vsop87a_micro_emb_x(double t);
+   double vsop87a_micro_emb_y(double t);
+   double vsop87a_micro_emb_z(double t);
+   double vsop87a_micro_jupiter_x(double t);
+   double vsop87a_micro_jupiter_y(double t);
+   double vsop87a_micro_jupiter_z(double t);
+   double vsop87a_micro_mars_x(double t);
+   double vsop87a_micro_mars_y(double t);
+   double vsop87a_micro_mars_z(double t);
+   double vsop87a_micro_mercury_x(double t);
+   double vsop87a_micro_mercury_y(double t);
+   double vsop87a_micro_mercury_z(double t);
+   double vsop87a_micro_neptune_x(double t);
+   double vsop87a_micro_neptune_y(double t);
+   double vsop87a_micro_neptune_z(double t);
+   double vsop87a_micro_saturn_x(double t);
+   double vsop87a_micro_saturn_y(double t);
+   double vsop87a_micro_saturn_z(double t);
+   double vsop87a_micro_uranus_x(double t);
+   double vsop87a_micro_uranus_y(double t);
+   double vsop87a_micro_uranus_z(double t);
+   double vsop87a_micro_venus_x(double t);
+   double vsop87a_micro_venus_y(double t);
+   double vsop87a_micro_venus_z(double t);
+#endif
@@ -1,17 +1,46 @@
-//VSOP87-Multilang http://www.astrogreg.com/vsop87-multilang/index.html
-//Greg Miller (gmiller@gregmiller.net) 2019.  Released as Public Domain
-
-#ifndef VSOP87A_MILLI
-#define VSOP87A_MILLI
-
-   void vsop87a_milli_getEarth(double t,double temp[]);
-   void vsop87a_milli_getEmb(double t,double temp[]);
-   void vsop87a_milli_getJupiter(double t,double temp[]);
-   void vsop87a_milli_getMars(double t,double temp[]);
-   void vsop87a_milli_getMercury(double t,double temp[]);
-   void vsop87a_milli_getNeptune(double t,double temp[]);
-   void vsop87a_milli_getSaturn(double t,double temp[]);
-   void vsop87a_milli_getUranus(double t,double temp[]);
-   void vsop87a_milli_getVenus(double t,double temp[]);
-   void vsop87a_milli_getMoon(double earth[], double emb[],double temp[]);
-#endif
+//VSOP87-Multilang http://www.astrogreg.com/vsop87-multilang/index.html
+//Greg Miller (gmiller@gregmiller.net) 2019.  Released as Public Domain
+
+#ifndef VSOP87A_MILLI
+#define VSOP87A_MILLI
+
+   void vsop87a_milli_getEarth(double t,double temp[]);
+   void vsop87a_milli_getEmb(double t,double temp[]);
+   void vsop87a_milli_getJupiter(double t,double temp[]);
+   void vsop87a_milli_getMars(double t,double temp[]);
+   void vsop87a_milli_getMercury(double t,double temp[]);
+   void vsop87a_milli_getNeptune(double t,double temp[]);
+   void vsop87a_milli_getSaturn(double t,double temp[]);
+   void vsop87a_milli_getUranus(double t,double temp[]);
+   void vsop87a_milli_getVenus(double t,double temp[]);
+   void vsop87a_milli_getMoon(double earth[], double emb[],double temp[]);
+
+   // one coordinate at a time, for callers that spread the work out.
+   double vsop87a_milli_earth_x(double t);
+   double vsop87a_milli_earth_y(double t);
+   double vsop87a_milli_earth_z(double t);
+   double vsop87a_milli_emb_x(double t);
+   double vsop87a_milli_emb_y(double t);
+   double vsop87a_milli_emb_z(double t);
+   double vsop87a_milli_jupiter_x(double t);
+   double vsop87a_milli_jupiter_y(double t);
+   double vsop87a_milli_jupiter_z(double t);
+   double vsop87a_milli_mars_x(double t);
+   double vsop87a_milli_mars_y(double t);
+   double vsop87a_milli_mars_z(double t);
+   double vsop87a_milli_mercury_x(double t);
+   double vsop87a_milli_mercury_y(double t);
+   double vsop87a_milli_mercury_z(double t);
+   double vsop87a_milli_neptune_x(double t);
+   double vsop87a_milli_neptune_y(double t);
+   double vsop87a_milli_neptune_z(double t);
+   double vsop87a_milli_saturn_x(double t);
+   double vsop87a_milli_saturn_y(double t);
+   double vsop87a_milli_saturn_z(double t);
+   double vsop87a_milli_uranus_x(double t);
+   double vsop87a_milli_uranus_y(double t);
+   double vsop87a_milli_uranus_z(double t);
+   double vsop87a_milli_venus_x(double t);
+   double vsop87a_milli_venus_y(double t);
+   double vsop87a_milli_venus_z(double t);
+#endif
@@ -0,0 +1,80 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "movement_modules.h"
+
+// an example module: counts presses of the alarm button, and shows the time at the top of the display while it does.
+
+typedef struct {
+    uint16_t presses;
+} hello_module_state_t;
+
+static void _hello_module_draw(const movement_module_api_t *api, hello_module_state_t *state) {
+    char buf[11];
+    watch_date_time date_time = api->get_local_date_time();
+    api->snprintf(buf, sizeof(buf), "HI%2d%6d", date_time.unit.day, state->presses);
+    api->display_string(buf, 0);
+}
+
+static void hello_module_setup(const movement_module_api_t *api, movement_settings_t *settings, void *context) {
+    (void) api;
+    (void) settings;
+    (void) context;
+}
+
+static void hello_module_activate(const movement_module_api_t *api, movement_settings_t *settings, void *context) {
+    (void) api;
+    (void) settings;
+    (void) context;
+}
+
+static bool hello_module_loop(const movement_module_api_t *api, movement_event_t event, movement_settings_t *settings, void *context) {
+    hello_module_state_t *state = (hello_module_state_t *)context;
+
+    switch (event.event_type) {
+        case EVENT_ACTIVATE:
+            _hello_module_draw(api, state);
+            break;
+        case EVENT_ALARM_BUTTON_UP:
+            state->presses++;
+            _hello_module_draw(api, state);
+            break;
+        case EVENT_ALARM_LONG_PRESS:
+            state->presses = 0;
+            _hello_module_draw(api, state);
+            break;
+        default:
+            return api->default_loop_handler(event, settings);
+    }
+
+    return true;
+}
+
+static void hello_module_resign(const movement_module_api_t *api, movement_settings_t *settings, void *context) {
+    (void) api;
+    (void) settings;
+    (void) context;
+}
+
+MOVEMENT_MODULE("hello", hello_module_state_t, hello_module_setup, hello_module_activate, hello_module_loop, hello_module_resign, NULL);
@@ -23,6 +23,7 @@
  */
 
 #define MOVEMENT_LONG_PRESS_TICKS 64
+#define MOVEMENT_TUNE_QUEUE_LENGTH 4
 
 #include <stdio.h>
 #include <string.h>
@@ -31,11 +32,29 @@
 #include <stdlib.h>
 #include <stdio.h>
 #include "watch.h"
+#include "watch_utility.h"
+#include "watch_private_display.h"
 #include "filesystem.h"
 #include "movement.h"
+#include "movement_kv.h"
+#include "movement_backup.h"
+#include "movement_accelerometer.h"
+#include "movement_sleep.h"
+#include "movement_activity.h"
+#include "movement_battery_life.h"
+#include "movement_timer.h"
+#include "movement_chirpy.h"
+#include "movement_optical_rx.h"
+#include "movement_sensors.h"
+#include "movement_freqcorr.h"
+#include "movement_display_drive.h"
+#include "movement_usb_msc.h"
+#include "movement_tz.h"
 #include "shell.h"
 
-#ifndef MOVEMENT_FIRMWARE
+#if defined(MOVEMENT_CONFIG_FILE)
+#include MOVEMENT_CONFIG_FILE
+#elif !defined(MOVEMENT_FIRMWARE)
 #include "movement_config.h"
 #elif MOVEMENT_FIRMWARE == MOVEMENT_FIRMWARE_STANDARD
 #include "movement_config.h"
@@ -55,7 +74,28 @@
 #include "alt_fw/deep_space_now.h"
 #endif
 
-#include "movement_custom_signal_tunes.h"
+// the signal tunes in movement_custom_signal_tunes.h, compiled by utils/gen_signal_tunes.py.
+#include "movement_signal_tunes.h"
+
+// Room for the faces' contexts (@see movement_claim_face_context). Faces whose contexts don't fit use the heap.
+#ifndef MOVEMENT_CONTEXT_ARENA_SIZE
+#define MOVEMENT_CONTEXT_ARENA_SIZE 512
+#endif
+
+// jobs that faces have posted to run in slices (@see movement_post_job).
+#ifndef MOVEMENT_NUM_JOB_SLOTS
+#define MOVEMENT_NUM_JOB_SLOTS 4
+#endif
+
+// how long each pass through the loop spends on jobs before it looks at the buttons again: 20 ms at 4 MHz.
+#ifndef MOVEMENT_JOB_SLICE_CYCLES
+#define MOVEMENT_JOB_SLICE_CYCLES 80000
+#endif
+
+// how many minutes of low energy mode a face with draw_low_energy draws at a time (@see watch_face_draw_low_energy).
+#ifndef MOVEMENT_LOW_ENERGY_FRAMES
+#define MOVEMENT_LOW_ENERGY_FRAMES 15
+#endif
 
 // Default to no secondary face behaviour.
 #ifndef MOVEMENT_SECONDARY_FACE_INDEX
@@ -95,17 +135,156 @@
 #define MOVEMENT_DEFAULT_LED_DURATION 1
 #endif
 
+// Below this voltage (in millivolts), the battery is low: faces get EVENT_LOW_BATTERY, low battery indicators go on,
+// and Movement saves power (@see movement_power_level_t).
+#ifndef MOVEMENT_LOW_BATTERY_VOLTAGE
+#define MOVEMENT_LOW_BATTERY_VOLTAGE 2200
+#endif
+
+// Below this voltage, the battery is nearly gone, and Movement keeps to the time.
+#ifndef MOVEMENT_CRITICAL_BATTERY_VOLTAGE
+#define MOVEMENT_CRITICAL_BATTERY_VOLTAGE 2000
+#endif
+
 #if __EMSCRIPTEN__
 #include <emscripten.h>
+#include "watch_sim_energy.h"
 #endif
 
 movement_state_t movement_state;
 void * watch_face_contexts[MOVEMENT_NUM_FACES];
+// faces whose setup has been called since the last wake, one bit per face. most wait until they're needed.
+uint32_t set_up_faces[(MOVEMENT_NUM_FACES + 31) / 32];
+// faces to set up at every wake rather than when first needed, read off the face table at first launch and whenever
+// the face order changes.
+uint32_t eager_setup_faces[(MOVEMENT_NUM_FACES + 31) / 32];
+// the faces in the order MODE steps through them, as indexes into watch_faces, and each face's place in that order
+// (MOVEMENT_FACE_NOT_IN_ORDER if it's been left out), so that finding the next face is a lookup either way.
+#define MOVEMENT_FACE_NOT_IN_ORDER 0xFF
+#define MOVEMENT_FACE_ORDER_KEY "faces"
+static uint8_t face_order[MOVEMENT_NUM_FACES];
+static uint8_t face_positions[MOVEMENT_NUM_FACES];
+static uint8_t num_ordered_faces;
+// where the secondary faces start in the order, or 0 if there aren't any.
+static uint8_t secondary_face_position;
+// the face whose setup is running, which is the one that gets any backup register claimed; -1 outside of setup.
+static int16_t face_in_setup = -1;
 watch_date_time scheduled_tasks[MOVEMENT_NUM_FACES];
+// faces to poll with wants_background_task at the top of the minute, one bit per face.
+uint32_t background_task_faces[(MOVEMENT_NUM_FACES + 31) / 32];
+// faces subscribed to ticks while off screen, one bit per face, with the rate each asked for and where it got its last.
+uint32_t background_tick_faces[(MOVEMENT_NUM_FACES + 31) / 32];
+uint8_t background_tick_frequencies[MOVEMENT_NUM_FACES];
+uint16_t background_tick_positions[MOVEMENT_NUM_FACES];
+// faces with a scheduled task, as a min-heap ordered by scheduled_tasks[face], so the next task is always first.
+uint8_t scheduled_task_heap[MOVEMENT_NUM_FACES];
+uint8_t scheduled_task_heap_size;
+// how many seconds past its time each face's task may run, so that it can wait for a wake that's coming anyway.
+uint8_t scheduled_task_slack[MOVEMENT_NUM_FACES];
+
+typedef struct {
+    movement_job_step_t step;       // NULL if the slot is free
+    void *context;
+    uint8_t watch_face_index;
+} movement_job_t;
+
+static movement_job_t jobs[MOVEMENT_NUM_JOB_SLOTS];
+static uint8_t num_jobs;
+// the slot that gets the next step, so that jobs take turns.
+static uint8_t next_job;
+
+// the RTC alarm is shared by everything that needs to wake us at a given second.
+static watch_rtc_timer_t minute_timer;
+static watch_rtc_timer_t scheduled_task_timer;
+static watch_rtc_timer_t next_wake_timer;
+static watch_rtc_timer_t light_timer;
+// the minutes of low energy mode the face on screen drew ahead of time: frames[i] goes up at first_minute + 60 * i
+// (the RTC's time, as a timestamp), from the minute timer. the loop only fills them in while count is 0.
+static struct {
+    watch_display_frame_t frames[MOVEMENT_LOW_ENERGY_FRAMES];
+    uint32_t first_minute;
+    volatile uint8_t count;
+    volatile uint8_t next;
+} low_energy_frames;
+// what each face last showed as it resigned, put up the moment MODE brings it back so that the glass isn't blank while
+// it activates. the display stays held, showing that, until the face has drawn its first frame.
+static watch_display_frame_t face_previews[MOVEMENT_NUM_FACES];
+static uint32_t faces_with_preview[(MOVEMENT_NUM_FACES + 31) / 32];
+static bool preview_showing;
+// the gestures the face on screen asked for, which it gives up when it resigns.
+static uint8_t face_gestures;
+// the offset from UTC the clock is keeping, worked out from the local time for the time zone and daylight saving
+// settings it was read with, and the UTC timestamp at which it next changes. setting the clock forgets it.
+static struct {
+    uint32_t until;
+    int16_t offset;
+    uint8_t zone;
+    bool daylight_saving;
+    bool valid;
+} clock_zone;
+movement_face_stats_t face_stats[MOVEMENT_NUM_FACES];
+
+// the faces' contexts, carved out at boot in the order of watch_faces, each aligned for any type.
+#define MOVEMENT_CONTEXT_ALIGNMENT 8
+static uint8_t context_arena[MOVEMENT_CONTEXT_ARENA_SIZE] __attribute__((aligned(MOVEMENT_CONTEXT_ALIGNMENT)));
+// each face's part of the arena until its setup claims it; NULL if it has none, or has claimed it.
+static void *reserved_contexts[MOVEMENT_NUM_FACES];
+static movement_context_stats_t context_stats;
+// the faces with MOVEMENT_FACE_HIBERNATE share one slot at the start of the arena, as big as the biggest of their
+// contexts. whichever face's context is in it is the slot's owner; the rest are in their files until they're needed.
+static uint32_t hibernating_faces[(MOVEMENT_NUM_FACES + 31) / 32];
+static int16_t hibernation_owner = -1;
+// a hash of the owner's context as it came out of its file, so that one that hasn't changed isn't written back. 0 if
+// it has never been written, so that it always is.
+static uint32_t hibernation_hash;
+// when each step of starting up finished, on the boot clock, and how many have (@see movement_get_boot_times).
+static uint32_t boot_times[MOVEMENT_NUM_BOOT_PHASES];
+static uint8_t boot_phases_done;
+// the eager faces' setup, and at first launch the rest of the boot, wait until the face on screen has drawn itself.
+static bool eager_setup_pending;
+static bool boot_setup_pending;
+// how hard Movement is trying to save the battery; set from the battery monitor once a minute.
+static movement_power_level_t power_level;
 const int32_t movement_le_inactivity_deadlines[8] = {INT_MAX, 600, 3600, 7200, 21600, 43200, 86400, 604800};
 const int16_t movement_timeout_inactivity_deadlines[4] = {60, 120, 300, 1800};
+const uint8_t movement_night_hours[8][2] = {{0, 0}, {0, 0}, {22, 6}, {23, 6}, {23, 7}, {0, 6}, {0, 7}, {1, 8}};
+// set while night mode has the display off in low energy mode.
+static bool display_dark;
+// with the le_motion preference, how long the watch has to lie still (after the sensor notices, 10 seconds in) before
+// low energy mode comes on, if the le_interval countdown isn't sooner.
+#ifndef MOVEMENT_STILL_LE_DEADLINE
+#define MOVEMENT_STILL_LE_DEADLINE 300
+#endif
+// how many seconds late the resign timeout and low energy countdowns may run out, while tickless, so that they can go
+// with the next minute's wake instead of one of their own.
+#ifndef MOVEMENT_COUNTDOWN_SLACK
+#define MOVEMENT_COUNTDOWN_SLACK 15
+#endif
+// the loop's own event for the current face, i.e. EVENT_ACTIVATE. events from interrupts go in the queue below.
 movement_event_t event;
 
+// button and tick events wait here for the loop, oldest first. the interrupts that queue them all run at the same
+// priority, so they never interrupt one another: there is one producer, the interrupts, and one consumer, the loop,
+// and neither needs a lock. the size must be a power of two.
+#define MOVEMENT_EVENT_QUEUE_SIZE 16
+static volatile movement_event_t event_queue[MOVEMENT_EVENT_QUEUE_SIZE];
+static volatile uint8_t event_queue_head;   // only the interrupts move this
+static volatile uint8_t event_queue_tail;   // only the loop moves this
+// a face only needs to hear about one tick at a time, so ticks don't pile up behind a slow face.
+static volatile bool event_queue_has_tick;
+// the same goes for UART data, which the face reads all of at once.
+static volatile bool event_queue_has_uart_data;
+static volatile bool event_queue_has_resume;
+static uint32_t event_queue_overflows;
+
+const uint16_t movement_latency_limits[MOVEMENT_LATENCY_BUCKETS - 1] = {1, 2, 5, 10, 20, 50, 100};
+static movement_latency_stats_t latency_stats[MOVEMENT_NUM_FACES];
+// when the press being timed came in, on the cycle counter. a button interrupt sets input_pending, and the loop moves
+// it to input_in_flight when it hands the press to the face, so that later presses don't restart the clock.
+static volatile uint32_t input_cycles;
+static volatile bool input_pending;
+static bool input_in_flight;
+
 const int16_t movement_timezone_offsets[] = {
     0,      //  0 :   0:00:00 (UTC)
     60,     //  1 :   1:00:00 (Central European Time)
@@ -157,93 +336,900 @@ void cb_mode_btn_interrupt(void);
 void cb_light_btn_interrupt(void);
 void cb_alarm_btn_interrupt(void);
 void cb_alarm_btn_extwake(void);
-void cb_alarm_fired(void);
+void cb_minute_timer(void);
+void cb_scheduled_task_timer(void);
+void cb_next_wake_timer(void);
+void cb_light_timer(void);
+static void _movement_schedule_minute_timer(void);
+static void _movement_end_high_performance(void);
+static void _movement_draw_low_energy_frames(void);
+static void _movement_update_tickless_countdowns(uint32_t now);
 void cb_fast_tick(void);
+void cb_long_press(void);
 void cb_tick(void);
+void cb_second(void);
+
+// every interrupt with something for the loop comes through here, so it runs from RAM, like the tick and button
+// callbacks that call it.
+static WATCH_RAMFUNC void _movement_queue_event(movement_event_type_t event_type) {
+    if (event_type == EVENT_TICK) {
+        if (event_queue_has_tick) return;
+        event_queue_has_tick = true;
+    }
+    if (event_type == EVENT_UART_DATA) {
+        if (event_queue_has_uart_data) return;
+        event_queue_has_uart_data = true;
+    }
+    if (event_type == EVENT_RESUME) {
+        if (event_queue_has_resume) return;
+        event_queue_has_resume = true;
+    }
+    uint8_t head = event_queue_head;
+    if ((uint8_t)(head - event_queue_tail) >= MOVEMENT_EVENT_QUEUE_SIZE) {
+        event_queue_overflows++;
+        return;
+    }
+    event_queue[head & (MOVEMENT_EVENT_QUEUE_SIZE - 1)].event_type = event_type;
+    event_queue[head & (MOVEMENT_EVENT_QUEUE_SIZE - 1)].subsecond = movement_state.subsecond;
+    event_queue_head = head + 1;
+}
+
+static bool _movement_dequeue_event(movement_event_t *next) {
+    uint8_t tail = event_queue_tail;
+    if (tail == event_queue_head) return false;
+    next->event_type = event_queue[tail & (MOVEMENT_EVENT_QUEUE_SIZE - 1)].event_type;
+    next->subsecond = event_queue[tail & (MOVEMENT_EVENT_QUEUE_SIZE - 1)].subsecond;
+    // a tick stands for every tick since it was queued, so it goes out with the latest subsecond.
+    if (next->event_type == EVENT_TICK) {
+        next->subsecond = movement_state.subsecond;
+        event_queue_has_tick = false;
+    }
+    if (next->event_type == EVENT_UART_DATA) event_queue_has_uart_data = false;
+    if (next->event_type == EVENT_RESUME) event_queue_has_resume = false;
+    event_queue_tail = tail + 1;
+    return true;
+}
+
+static inline bool _movement_event_queue_is_empty(void) {
+    return event_queue_tail == event_queue_head;
+}
+
+static void _movement_clear_event_queue(void) {
+    event_queue_tail = event_queue_head;
+    event_queue_has_tick = false;
+    event_queue_has_uart_data = false;
+    event_queue_has_resume = false;
+    input_pending = false;
+}
+
+static inline void _movement_stamp_input(void) {
+    if (input_pending || input_in_flight) return;
+    input_cycles = watch_get_cycle_counter();
+    input_pending = true;
+}
+
+// called after each call to the face's loop: if it handled the press being timed, and didn't leave for another face
+// that has yet to draw, the press is on screen now.
+static void _movement_record_latency(void) {
+    if (!input_in_flight || movement_state.watch_face_changed) return;
+    input_in_flight = false;
+    uint32_t cycles = (watch_get_cycle_counter() - input_cycles) & WATCH_CYCLE_COUNTER_MASK;
+    uint32_t tenths = (uint32_t)((uint64_t)cycles * 10000 / watch_get_cycle_counter_frequency());
+    movement_latency_stats_t *stats = &latency_stats[movement_state.current_face_idx];
+    uint8_t bucket = 0;
+    while (bucket < MOVEMENT_LATENCY_BUCKETS - 1 && tenths >= movement_latency_limits[bucket] * 10u) bucket++;
+    if (stats->counts[bucket] < UINT16_MAX) stats->counts[bucket]++;
+    if (tenths > stats->worst) stats->worst = tenths > UINT16_MAX ? UINT16_MAX : tenths;
+}
+
+// with the battery low, low energy mode comes on sooner, if it's on at all.
+static inline int32_t _movement_le_deadline(void) {
+    int32_t deadline = movement_le_inactivity_deadlines[movement_state.settings.bit.le_interval];
+    if (power_level != MOVEMENT_POWER_NORMAL && deadline > MOVEMENT_STILL_LE_DEADLINE) deadline = MOVEMENT_STILL_LE_DEADLINE;
+    return deadline;
+}
 
 static inline void _movement_reset_inactivity_countdown(void) {
-    movement_state.le_mode_ticks = movement_le_inactivity_deadlines[movement_state.settings.bit.le_interval];
+    movement_state.le_mode_ticks = _movement_le_deadline();
     movement_state.timeout_ticks = movement_timeout_inactivity_deadlines[movement_state.settings.bit.to_interval];
+    // in tickless mode, the countdowns restart from the next time we look at the clock.
+    movement_state.countdown_timestamp = 0;
+    movement_state.needs_next_wake_scheduled = true;
 }
 
-static inline void _movement_enable_fast_tick_if_needed(void) {
-    if (!movement_state.fast_tick_enabled) {
+// in the same order as the button events: light, mode, alarm.
+static uint16_t *const movement_button_down_timestamps[3] = {
+    &movement_state.light_down_timestamp,
+    &movement_state.mode_down_timestamp,
+    &movement_state.alarm_down_timestamp,
+};
+
+// presses are timed in 1/128 second: by the button timer, which counts in hardware at 512 Hz and only interrupts for
+// a long press, or failing that (i.e. on USB, where the USB task has the timer) by counting 128 Hz fast ticks.
+static inline void _movement_start_button_timing(void) {
+    if (movement_state.button_timer_running || movement_state.fast_tick_enabled) return;
+    if (watch_button_timer_start()) {
+        movement_state.button_timer_running = true;
+    } else {
         movement_state.fast_ticks = 0;
         watch_rtc_register_periodic_callback(cb_fast_tick, 128);
         movement_state.fast_tick_enabled = true;
     }
 }
 
-static inline void _movement_disable_fast_tick_if_possible(void) {
-    if ((movement_state.light_ticks == -1) &&
-        (movement_state.alarm_ticks == -1) &&
-        ((movement_state.light_down_timestamp + movement_state.mode_down_timestamp + movement_state.alarm_down_timestamp) == 0)) {
+static inline void _movement_stop_button_timing_if_possible(void) {
+    if ((movement_state.light_down_timestamp + movement_state.mode_down_timestamp + movement_state.alarm_down_timestamp) == 0) {
+        if (movement_state.button_timer_running) {
+            watch_button_timer_stop();
+            movement_state.button_timer_running = false;
+        }
         movement_state.fast_tick_enabled = false;
         watch_rtc_disable_periodic_callback(128);
     }
 }
 
-static void _movement_handle_background_tasks(void) {
-    for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
-        // For each face, if the watch face wants a background task...
-        if (watch_faces[i].wants_background_task != NULL && watch_faces[i].wants_background_task(&movement_state.settings, watch_face_contexts[i])) {
-            // ...we give it one. pretty straightforward!
-            movement_event_t background_event = { EVENT_BACKGROUND_TASK, 0 };
-            watch_faces[i].loop(background_event, &movement_state.settings, watch_face_contexts[i]);
+static inline uint16_t _movement_button_ticks(void) {
+    if (movement_state.button_timer_running) return watch_button_timer_get_count() >> 2;
+    return movement_state.fast_ticks;
+}
+
+static void _movement_arm_long_press(void) {
+    // the earliest long press still to come, among the buttons being held.
+    uint32_t earliest = UINT32_MAX;
+    for(uint8_t i = 0; i < 3; i++) {
+        if (!(movement_state.long_press_pending & (1 << i))) continue;
+        uint32_t due = *movement_button_down_timestamps[i] + MOVEMENT_LONG_PRESS_TICKS + 1;
+        if (due < earliest) earliest = due;
+    }
+    // beyond the end of the count, the press will be a long one when it's released anyway.
+    if (earliest <= (UINT16_MAX >> 2)) watch_button_timer_set_compare(earliest << 2, cb_long_press);
+}
+
+static inline void _movement_forget_date_time(void) {
+    movement_state.has_date_time = false;
+    movement_state.has_utc_date_time = false;
+}
+
+watch_date_time movement_get_local_date_time(void) {
+    if (!movement_state.has_date_time) {
+        movement_state.date_time = watch_rtc_get_date_time();
+        movement_state.has_date_time = true;
+    }
+    return movement_state.date_time;
+}
+
+void movement_set_local_date_time(watch_date_time date_time) {
+    watch_rtc_set_date_time(date_time);
+    _movement_forget_date_time();
+    clock_zone.valid = false;
+    // any minutes low energy mode drew ahead of time were drawn for the old time.
+    low_energy_frames.count = 0;
+    low_energy_frames.next = 0;
+    // the top of the minute moves with the clock. scheduled tasks name absolute times, and any the clock has now
+    // passed fire straight away; the tickless countdowns start over from the new time.
+    _movement_schedule_minute_timer();
+    movement_state.countdown_timestamp = 0;
+    movement_state.needs_next_wake_scheduled = true;
+    movement_timer_clock_changed();
+}
+
+watch_date_time movement_get_utc_date_time(void) {
+    if (!movement_state.has_utc_date_time) {
+        movement_state.utc_date_time = watch_utility_date_time_convert_zone(movement_get_local_date_time(), movement_get_current_timezone_offset() * 60, 0);
+        movement_state.has_utc_date_time = true;
+    }
+    return movement_state.utc_date_time;
+}
+
+int16_t movement_get_current_timezone_offset(void) {
+    if (!clock_zone.valid || clock_zone.zone != movement_state.settings.bit.time_zone ||
+        clock_zone.daylight_saving != movement_state.settings.bit.daylight_saving) {
+        // a new time zone or daylight saving setting applies to the time the clock shows now.
+        clock_zone.zone = movement_state.settings.bit.time_zone;
+        clock_zone.daylight_saving = movement_state.settings.bit.daylight_saving;
+        uint32_t local_timestamp = watch_utility_date_time_to_unix_time(movement_get_local_date_time(), 0);
+        clock_zone.offset = movement_tz_get_local_offset(clock_zone.zone, clock_zone.daylight_saving, local_timestamp, &clock_zone.until);
+        clock_zone.valid = true;
+    }
+    return clock_zone.offset;
+}
+
+int16_t movement_get_timezone_offset(uint8_t zone, bool daylight_saving) {
+    int16_t offset = movement_get_current_timezone_offset();
+    if (zone == clock_zone.zone && daylight_saving == clock_zone.daylight_saving) return offset;
+    uint32_t utc_timestamp = watch_utility_date_time_to_unix_time(movement_get_local_date_time(), offset * 60);
+    return movement_tz_get_offset(zone, daylight_saving, utc_timestamp, NULL);
+}
+
+watch_date_time movement_get_date_time_in_zone(uint8_t zone, bool daylight_saving) {
+    int16_t offset = movement_get_current_timezone_offset();
+    watch_date_time local = movement_get_local_date_time();
+    if (zone == clock_zone.zone && daylight_saving == clock_zone.daylight_saving) return local;
+    uint32_t utc_timestamp = watch_utility_date_time_to_unix_time(local, offset * 60);
+    return watch_utility_date_time_from_unix_time(utc_timestamp, movement_tz_get_offset(zone, daylight_saving, utc_timestamp, NULL) * 60);
+}
+
+// the local date the calendar was worked out for, as the day, month and year bits of its watch_date_time; days start
+// at 1, so 0 is no date at all.
+static uint32_t calendar_date;
+static movement_calendar_t calendar;
+
+const movement_calendar_t *movement_get_calendar(void) {
+    watch_date_time now = movement_get_local_date_time();
+    uint32_t date = now.reg >> 17;
+    if (date == calendar_date) return &calendar;
+
+    static const uint8_t days_in_month[12] = { 31, 28, 31, 30, 31, 30, 31, 31, 30, 31, 30, 31 };
+    uint16_t year = now.unit.year + WATCH_RTC_REFERENCE_YEAR;
+    uint8_t month = now.unit.month;
+    uint8_t day = now.unit.day;
+    // https://en.wikipedia.org/wiki/Julian_day#Julian_day_number_calculation, with the months from March.
+    uint16_t a = (14 - month) / 12;
+    uint32_t y = year + 4800 - a;
+    uint32_t m = month + 12 * a - 3;
+    calendar.julian_day = day + (153 * m + 2) / 5 + 365 * y + y / 4 - y / 100 + y / 400 - 32045;
+    // Julian day 0 was a Monday.
+    calendar.weekday = calendar.julian_day % 7 + 1;
+    calendar.week_number = watch_utility_get_weeknumber(year, month, day);
+    calendar.day_of_year = watch_utility_days_since_new_year(year, month, day);
+    calendar.leap_year = is_leap(year);
+    calendar.days_in_month = days_in_month[month - 1] + (month == 2 && calendar.leap_year);
+    calendar_date = date;
+    return &calendar;
+}
+
+// with the daylight saving setting on, puts the clock forward or back once the change it was waiting for has come.
+static void _movement_follow_daylight_saving(void) {
+    int16_t offset = movement_get_current_timezone_offset();
+    if (!clock_zone.daylight_saving) return;
+    uint32_t utc_timestamp = watch_utility_date_time_to_unix_time(watch_rtc_get_date_time(), offset * 60);
+    if (utc_timestamp < clock_zone.until) return;
+
+    uint32_t until;
+    offset = movement_tz_get_offset(clock_zone.zone, true, utc_timestamp, &until);
+    movement_set_local_date_time(watch_utility_date_time_from_unix_time(utc_timestamp, offset * 60));
+    // the hour after the clocks go back comes twice, so the offset is kept rather than worked out again.
+    clock_zone.offset = offset;
+    clock_zone.until = until;
+    clock_zone.valid = true;
+}
+
+static bool _movement_apply_face_order(const uint8_t *watch_face_indexes, uint8_t count) {
+    uint8_t positions[MOVEMENT_NUM_FACES];
+    memset(positions, MOVEMENT_FACE_NOT_IN_ORDER, sizeof(positions));
+    if (count == 0) return false;
+    for(uint8_t i = 0; i < count; i++) {
+        uint8_t face = watch_face_indexes[i];
+        if (face >= MOVEMENT_NUM_FACES || positions[face] != MOVEMENT_FACE_NOT_IN_ORDER) return false;
+        positions[face] = i;
+    }
+    memmove(face_order, watch_face_indexes, count);
+    memcpy(face_positions, positions, sizeof(positions));
+    num_ordered_faces = count;
+    uint8_t secondary = face_positions[MOVEMENT_SECONDARY_FACE_INDEX];
+    secondary_face_position = (MOVEMENT_SECONDARY_FACE_INDEX && secondary != MOVEMENT_FACE_NOT_IN_ORDER) ? secondary : 0;
+    return true;
+}
+
+// module slots with nothing that will run in them stay out of the order until a module is installed and the watch
+// restarts; faces that aren't in this firmware are left for _movement_apply_face_order to turn down.
+static uint8_t _movement_skip_empty_modules(uint8_t *watch_face_indexes, uint8_t count) {
+#if MOVEMENT_NUM_MODULE_SLOTS > 0
+    uint8_t kept = 0;
+    for(uint8_t i = 0; i < count; i++) {
+        uint8_t face = watch_face_indexes[i];
+        if (face < MOVEMENT_NUM_FACES) {
+            int8_t slot = movement_module_slot_for_face(&watch_faces[face]);
+            if (slot >= 0 && movement_module_get(slot) == NULL) continue;
         }
+        watch_face_indexes[kept++] = face;
     }
-    movement_state.needs_background_tasks_handled = false;
+    return kept;
+#else
+    (void) watch_face_indexes;
+    return count;
+#endif
 }
 
-static void _movement_handle_scheduled_tasks(void) {
-    watch_date_time date_time = watch_rtc_get_date_time();
-    uint8_t num_active_tasks = 0;
+static void _movement_load_face_order(void) {
+    uint8_t order[MOVEMENT_NUM_FACES];
+    int32_t count = movement_kv_get(MOVEMENT_FACE_ORDER_KEY, order, sizeof(order));
+    // an order that doesn't fit the faces compiled in was stored by some other firmware, and is no use to this one.
+    if (count > 0 && count <= (int32_t)MOVEMENT_NUM_FACES && _movement_apply_face_order(order, _movement_skip_empty_modules(order, count))) return;
+    for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) order[i] = i;
+    _movement_apply_face_order(order, _movement_skip_empty_modules(order, MOVEMENT_NUM_FACES));
+}
 
+static void _movement_read_face_table(void) {
+    memset(eager_setup_faces, 0, sizeof(eager_setup_faces));
     for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
-        if (scheduled_tasks[i].reg) {
-            if (scheduled_tasks[i].reg == date_time.reg) {
-                scheduled_tasks[i].reg = 0;
+        // a face that's been left out of the order doesn't run at all.
+        if (face_positions[i] == MOVEMENT_FACE_NOT_IN_ORDER) continue;
+        if (watch_faces[i].wants_background_task != NULL || (watch_faces[i].flags & MOVEMENT_FACE_EAGER_SETUP)) {
+            eager_setup_faces[i / 32] |= (uint32_t)1 << (i % 32);
+        }
+    }
+}
+
+static inline bool _movement_face_hibernates(uint8_t watch_face_index) {
+    return hibernating_faces[watch_face_index / 32] & ((uint32_t)1 << (watch_face_index % 32));
+}
+
+static void _movement_context_filename(char *filename, uint8_t watch_face_index) {
+    watch_fmt_str(watch_fmt_u32(watch_fmt_str(filename, "face"), watch_face_index, 3, '0'), ".ctx");
+}
+
+static uint32_t _movement_context_hash(const uint8_t *context, size_t size) {
+    // FNV-1a: it only has to notice that something changed.
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < size; i++) hash = (hash ^ context[i]) * 16777619u;
+    return hash;
+}
+
+// writes the slot's owner out to its file, if its context changed while it was in the slot, and leaves the slot free.
+static void _movement_hibernate_slot_owner(void) {
+    if (hibernation_owner < 0) return;
+    uint8_t face = hibernation_owner;
+    size_t size = watch_faces[face].context_size;
+    uint8_t *context = watch_face_contexts[face];
+    hibernation_owner = -1;
+    if (hibernation_hash != 0 && _movement_context_hash(context, size) == hibernation_hash) return;
+
+    char filename[12];
+    _movement_context_filename(filename, face);
+    if (filesystem_write_file(filename, (char *)context, size)) return;
+
+    // with the filesystem full, the face stops hibernating, and keeps its context on the heap from here on.
+    hibernating_faces[face / 32] &= ~((uint32_t)1 << (face % 32));
+    void *moved = malloc(size);
+    if (moved != NULL) {
+        memcpy(moved, context, size);
+        context_stats.heap_contexts++;
+        context_stats.heap_context_bytes += size;
+    } else {
+        // nowhere to keep it: the face will be set up again, from scratch.
+        set_up_faces[face / 32] &= ~((uint32_t)1 << (face % 32));
+    }
+    watch_face_contexts[face] = moved;
+}
+
+// makes sure a hibernating face's context is in the slot before Movement calls into the face.
+static void _movement_wake_face_context(uint8_t watch_face_index) {
+    if (!_movement_face_hibernates(watch_face_index) || hibernation_owner == watch_face_index) return;
+    // a face that hasn't claimed its context yet has nothing to bring back.
+    if (watch_face_contexts[watch_face_index] == NULL) return;
+
+    _movement_hibernate_slot_owner();
+    // the write may have failed, and taken the face it was for out of the slot; this one still has it.
+    uint8_t *context = watch_face_contexts[watch_face_index];
+    size_t size = watch_faces[watch_face_index].context_size;
+    char filename[12];
+    _movement_context_filename(filename, watch_face_index);
+    // a context that can't be read back starts over from zero, as a newly claimed one does.
+    if (filesystem_read_file(filename, (char *)context, size)) hibernation_hash = _movement_context_hash(context, size);
+    else {
+        memset(context, 0, size);
+        hibernation_hash = 0;
+    }
+    hibernation_owner = watch_face_index;
+}
+
+static inline void *_movement_face_context(uint8_t watch_face_index) {
+    _movement_wake_face_context(watch_face_index);
+    return watch_face_contexts[watch_face_index];
+}
+
+static void _movement_set_up_face(uint8_t watch_face_index) {
+    uint32_t bit = (uint32_t)1 << (watch_face_index % 32);
+    if (set_up_faces[watch_face_index / 32] & bit) return;
+    set_up_faces[watch_face_index / 32] |= bit;
+    // after a wake, setup is handed the context it claimed before.
+    _movement_wake_face_context(watch_face_index);
+    face_in_setup = watch_face_index;
+    watch_faces[watch_face_index].setup(&movement_state.settings, watch_face_index, &watch_face_contexts[watch_face_index]);
+    face_in_setup = -1;
+}
+
+// the steps come in order, once each; the same point in the code coming around again later isn't a step.
+static void _movement_mark_boot(movement_boot_phase_t phase) {
+    if (phase != boot_phases_done) return;
+    boot_times[phase] = watch_get_boot_ticks();
+    boot_phases_done++;
+    // that's the boot timed, and the buzzer can have its timer back.
+    if (boot_phases_done == MOVEMENT_NUM_BOOT_PHASES) watch_boot_clock_stop();
+}
+
+static void _movement_set_up_eager_faces(void) {
+    for(uint8_t word = 0; word < sizeof(eager_setup_faces) / sizeof(eager_setup_faces[0]); word++) {
+        uint32_t faces = eager_setup_faces[word];
+        while (faces) {
+            _movement_set_up_face(word * 32 + __builtin_ctz(faces));
+            faces &= faces - 1;
+        }
+    }
+}
+
+static void _movement_cb_low_battery(void) {
+    _movement_queue_event(EVENT_LOW_BATTERY);
+}
+
+// the setup that app_setup leaves until the first screen is up; anything that needs it done first calls this.
+static void _movement_finish_setup(void) {
+    if (boot_setup_pending) {
+        boot_setup_pending = false;
+        movement_freqcorr_init();
+        // the display's drive follows the temperature, where there's a thermistor to tell it.
+        movement_display_drive_enable();
+        watch_register_battery_threshold(MOVEMENT_LOW_BATTERY_VOLTAGE, _movement_cb_low_battery);
+        // nothing to call here: the power policy catches up at the next background task.
+        watch_register_battery_threshold(MOVEMENT_CRITICAL_BATTERY_VOLTAGE, NULL);
+        #if defined(MOVEMENT_USB_MSC) && !__EMSCRIPTEN__
+        if (watch_is_usb_enabled()) movement_usb_msc_init();
+        #endif
+    }
+    if (eager_setup_pending) {
+        eager_setup_pending = false;
+        _movement_set_up_eager_faces();
+    }
+    _movement_mark_boot(MOVEMENT_BOOT_READY);
+}
+
+static bool _movement_face_loop(uint8_t watch_face_index, movement_event_t event) {
+    // every call into a face goes through here, so that we can tally what it costs.
+    watch_power_trace_region_t trace = watch_power_trace_set(event.event_type == EVENT_BACKGROUND_TASK ? WATCH_POWER_TRACE_BACKGROUND : WATCH_POWER_TRACE_FACE);
+#if __EMSCRIPTEN__
+    uint8_t account = sim_energy_set_account(watch_face_index);
+#endif
+    // a face can be handed an event without coming on screen, i.e. a scheduled task after a wake.
+    _movement_set_up_face(watch_face_index);
+    uint32_t start = watch_get_cycle_counter();
+    bool can_sleep = watch_faces[watch_face_index].loop(event, &movement_state.settings, _movement_face_context(watch_face_index));
+    uint32_t cycles = (watch_get_cycle_counter() - start) & WATCH_CYCLE_COUNTER_MASK;
+#if __EMSCRIPTEN__
+    sim_energy_set_account(account);
+#endif
+    watch_power_trace_set(trace);
+    _movement_end_high_performance();
+
+    face_stats[watch_face_index].loop_calls++;
+    face_stats[watch_face_index].active_cycles += cycles;
+    if (event.event_type == EVENT_BACKGROUND_TASK) face_stats[watch_face_index].background_cycles += cycles;
+
+    return can_sleep;
+}
+
+bool movement_post_job(uint8_t watch_face_index, movement_job_step_t step, void *context) {
+    if (step == NULL) return false;
+    for(uint8_t i = 0; i < MOVEMENT_NUM_JOB_SLOTS; i++) {
+        if (jobs[i].step != NULL) continue;
+        jobs[i].step = step;
+        jobs[i].context = context;
+        jobs[i].watch_face_index = watch_face_index;
+        num_jobs++;
+        return true;
+    }
+    return false;
+}
+
+void movement_cancel_jobs_for_face(uint8_t watch_face_index) {
+    for(uint8_t i = 0; i < MOVEMENT_NUM_JOB_SLOTS; i++) {
+        if (jobs[i].step == NULL || jobs[i].watch_face_index != watch_face_index) continue;
+        jobs[i].step = NULL;
+        num_jobs--;
+    }
+}
+
+static void _movement_run_jobs(void) {
+    uint32_t start = watch_get_cycle_counter();
+    // a slice ends when its time is up, when the jobs are all done, or when something comes in that needs handling.
+    while (num_jobs && _movement_event_queue_is_empty() && !movement_state.watch_face_changed) {
+        while (jobs[next_job].step == NULL) next_job = (next_job + 1) % MOVEMENT_NUM_JOB_SLOTS;
+        movement_job_t *job = &jobs[next_job];
+        next_job = (next_job + 1) % MOVEMENT_NUM_JOB_SLOTS;
+
+        watch_power_trace_region_t trace = watch_power_trace_set(WATCH_POWER_TRACE_FACE);
+#if __EMSCRIPTEN__
+        uint8_t account = sim_energy_set_account(job->watch_face_index);
+#endif
+        uint32_t step_start = watch_get_cycle_counter();
+        uint8_t watch_face_index = job->watch_face_index;
+        movement_job_step_t step = job->step;
+        // the job's context is most likely the face's own.
+        _movement_wake_face_context(watch_face_index);
+        bool done = step(job->context);
+        face_stats[watch_face_index].active_cycles += (watch_get_cycle_counter() - step_start) & WATCH_CYCLE_COUNTER_MASK;
+#if __EMSCRIPTEN__
+        sim_energy_set_account(account);
+#endif
+        watch_power_trace_set(trace);
+
+        // the step may have cancelled its own job, or posted a new one in its place.
+        if (done && job->step == step) {
+            job->step = NULL;
+            num_jobs--;
+        }
+        if (((watch_get_cycle_counter() - start) & WATCH_CYCLE_COUNTER_MASK) >= MOVEMENT_JOB_SLICE_CYCLES) break;
+    }
+    _movement_end_high_performance();
+}
+
+// reads the battery once a day; the brownout detector looks after it in between, and faces use what this read.
+static void _movement_check_battery(void) {
+    static uint8_t last_check_day = 0xFF;
+    uint8_t today = watch_rtc_get_date_time().unit.day;
+    if (today == last_check_day) return;
+    last_check_day = today;
+    watch_claim_peripheral(WATCH_PERIPHERAL_ADC);
+    watch_get_vcc_voltage();
+    watch_release_peripheral(WATCH_PERIPHERAL_ADC);
+}
+
+// moves to the power level for the battery as it stands.
+static void _movement_update_power_level(void) {
+    uint16_t voltage = watch_get_battery_voltage();
+    movement_power_level_t level = MOVEMENT_POWER_NORMAL;
+
+    if (voltage && voltage < MOVEMENT_CRITICAL_BATTERY_VOLTAGE) level = MOVEMENT_POWER_CRITICAL;
+    else if (voltage && voltage < MOVEMENT_LOW_BATTERY_VOLTAGE) level = MOVEMENT_POWER_SAVING;
+    if (level == power_level) return;
+
+    power_level = level;
+    // the rest takes effect as it comes up: the next tick request, LED, chime or face change. a face that asked for
+    // faster ticks gets them back when it asks again.
+    if (level != MOVEMENT_POWER_NORMAL) {
+        if (!movement_state.tickless && movement_state.face_tick_frequency > 1) movement_request_tick_frequency(1);
+        if (movement_state.tickless) {
+            _movement_update_tickless_countdowns(watch_utility_date_time_to_unix_time(watch_rtc_get_date_time(), 0));
+        }
+        if (movement_state.le_mode_ticks > _movement_le_deadline()) movement_state.le_mode_ticks = _movement_le_deadline();
+        movement_state.needs_next_wake_scheduled = true;
+    }
+    if (level == MOVEMENT_POWER_CRITICAL) movement_move_to_face(0);
+}
+
+static void _movement_handle_background_tasks(void) {
+    // background tasks come at the top of the minute, which is when the clocks change.
+    _movement_follow_daylight_saving();
+    _movement_check_battery();
+    _movement_update_power_level();
+    // the battery life estimate counts by the minute, and takes the day's reading when there's a new one.
+    movement_battery_life_minute();
+    // the sleep tracker counts by the minute.
+    movement_sleep_minute();
+    // asking a face whether it wants a background task takes its context.
+    _movement_finish_setup();
+    for(uint8_t word = 0; word < sizeof(background_task_faces) / sizeof(background_task_faces[0]); word++) {
+        uint32_t faces = background_task_faces[word];
+        while (faces) {
+            // For each face that registered interest, if the watch face wants a background task...
+            uint8_t i = word * 32 + __builtin_ctz(faces);
+            faces &= faces - 1;
+            if (watch_faces[i].wants_background_task(&movement_state.settings, watch_face_contexts[i])) {
+                // ...we give it one. pretty straightforward!
                 movement_event_t background_event = { EVENT_BACKGROUND_TASK, 0 };
-                watch_faces[i].loop(background_event, &movement_state.settings, watch_face_contexts[i]);
-                // check if loop scheduled a new task
-                if (scheduled_tasks[i].reg) {
-                    num_active_tasks++;
-                }
-            } else {
-                num_active_tasks++;
+                _movement_face_loop(i, background_event);
             }
         }
     }
+    movement_state.needs_background_tasks_handled = false;
+}
 
-    if (num_active_tasks == 0) {
-        movement_state.has_scheduled_background_task = false;
-    } else {
-        _movement_reset_inactivity_countdown();
+static inline bool _movement_scheduled_task_before(uint8_t a, uint8_t b) {
+    return scheduled_tasks[scheduled_task_heap[a]].reg < scheduled_tasks[scheduled_task_heap[b]].reg;
+}
+
+static inline void _movement_scheduled_task_swap(uint8_t a, uint8_t b) {
+    uint8_t face = scheduled_task_heap[a];
+    scheduled_task_heap[a] = scheduled_task_heap[b];
+    scheduled_task_heap[b] = face;
+}
+
+static void _movement_scheduled_task_sift(uint8_t i) {
+    // move the entry up while it's earlier than its parent...
+    while (i > 0 && _movement_scheduled_task_before(i, (i - 1) / 2)) {
+        _movement_scheduled_task_swap(i, (i - 1) / 2);
+        i = (i - 1) / 2;
+    }
+    // ...or down while either child is earlier than it.
+    while (true) {
+        uint8_t earliest = i;
+        uint8_t left = i * 2 + 1;
+        uint8_t right = i * 2 + 2;
+        if (left < scheduled_task_heap_size && _movement_scheduled_task_before(left, earliest)) earliest = left;
+        if (right < scheduled_task_heap_size && _movement_scheduled_task_before(right, earliest)) earliest = right;
+        if (earliest == i) break;
+        _movement_scheduled_task_swap(i, earliest);
+        i = earliest;
     }
 }
 
-void movement_request_tick_frequency(uint8_t freq) {
-    // Movement uses the 128 Hz tick internally
-    if (freq == 128) return;
+static void _movement_scheduled_task_remove(uint8_t watch_face_index) {
+    for(uint8_t i = 0; i < scheduled_task_heap_size; i++) {
+        if (scheduled_task_heap[i] == watch_face_index) {
+            scheduled_task_heap[i] = scheduled_task_heap[--scheduled_task_heap_size];
+            if (i < scheduled_task_heap_size) _movement_scheduled_task_sift(i);
+            break;
+        }
+    }
+    movement_state.has_scheduled_background_task = scheduled_task_heap_size > 0;
+}
+
+static void _movement_scheduled_task_insert(uint8_t watch_face_index) {
+    _movement_scheduled_task_remove(watch_face_index);
+    scheduled_task_heap[scheduled_task_heap_size] = watch_face_index;
+    _movement_scheduled_task_sift(scheduled_task_heap_size++);
+    movement_state.has_scheduled_background_task = true;
+}
+
+static void _movement_arm_scheduled_task_timer(void) {
+    if (!scheduled_task_heap_size) {
+        watch_rtc_cancel_timer(&scheduled_task_timer);
+        return;
+    }
+
+    // the timer may wait as long as every task in the heap can: a later task with less slack can cut the first's short.
+    watch_date_time first = scheduled_tasks[scheduled_task_heap[0]];
+    uint32_t first_ts = watch_utility_date_time_to_unix_time(first, 0);
+    uint32_t latest_ts = UINT32_MAX;
+    for (uint8_t i = 0; i < scheduled_task_heap_size; i++) {
+        uint8_t face = scheduled_task_heap[i];
+        uint32_t task_ts = (i == 0) ? first_ts : watch_utility_date_time_to_unix_time(scheduled_tasks[face], 0);
+        if (task_ts + scheduled_task_slack[face] < latest_ts) latest_ts = task_ts + scheduled_task_slack[face];
+    }
+    watch_rtc_schedule_timer_with_slack(&scheduled_task_timer, first, latest_ts - first_ts, cb_scheduled_task_timer);
+}
+
+static void _movement_handle_scheduled_tasks(void) {
+    watch_date_time date_time = movement_get_local_date_time();
+    movement_state.needs_scheduled_tasks_handled = false;
+
+    // only the faces whose time has come; the rest of the heap is later than its first entry.
+    while (scheduled_task_heap_size && scheduled_tasks[scheduled_task_heap[0]].reg <= date_time.reg) {
+        uint8_t i = scheduled_task_heap[0];
+        _movement_scheduled_task_remove(i);
+        scheduled_tasks[i].reg = 0;
+        // the loop may schedule a new task, which puts the face back in the heap.
+        movement_event_t background_event = { EVENT_BACKGROUND_TASK, 0 };
+        _movement_face_loop(i, background_event);
+    }
+
+    // if the timer fired after we read the clock, this arms it in the past and the RTC calls it right back.
+    _movement_arm_scheduled_task_timer();
+}
+
+static void _movement_schedule_minute_timer(void) {
+    // background tasks and low power updates run at the top of every minute, as the clock sees it right now.
+    watch_date_time now = watch_rtc_get_date_time();
+    uint32_t next_minute = watch_utility_date_time_to_unix_time(now, 0) - now.unit.second + 60;
+    watch_rtc_schedule_timer(&minute_timer, watch_utility_date_time_from_unix_time(next_minute, 0), cb_minute_timer);
+}
+
+static void _movement_update_tickless_countdowns(uint32_t now) {
+    if (movement_state.countdown_timestamp == 0) movement_state.countdown_timestamp = now;
+    int32_t elapsed = now - movement_state.countdown_timestamp;
+    movement_state.countdown_timestamp = now;
+    if (elapsed <= 0) return;
+
+    // same as cb_tick, but for all the seconds we slept through at once.
+    if (movement_state.settings.bit.le_interval && movement_state.le_mode_ticks > 0) {
+        movement_state.le_mode_ticks = (movement_state.le_mode_ticks > elapsed) ? movement_state.le_mode_ticks - elapsed : 0;
+    }
+    if (movement_state.timeout_ticks > 0) {
+        movement_state.timeout_ticks = (movement_state.timeout_ticks > elapsed) ? movement_state.timeout_ticks - elapsed : 0;
+    }
+}
+
+static void _movement_schedule_next_wake(void) {
+    // not the cached time: the countdowns are kept against the clock as it is now.
+    watch_date_time now = watch_rtc_get_date_time();
+    uint32_t now_ts = watch_utility_date_time_to_unix_time(now, 0);
+    movement_state.needs_next_wake_scheduled = false;
+    _movement_update_tickless_countdowns(now_ts);
+
+    // the minute and scheduled task timers take care of themselves; this one is for the face's tick and the countdowns.
+    // the face's tick is due when it asked for it, but nobody is watching the countdowns to the second, so they can
+    // wait a little for a wake that's coming anyway, like the top of the minute.
+    uint32_t wake_ts = UINT32_MAX;
+    uint32_t latest_ts = UINT32_MAX;
+    if (movement_state.next_tick.reg) wake_ts = latest_ts = watch_utility_date_time_to_unix_time(movement_state.next_tick, 0);
+    if (movement_state.timeout_ticks > 0) {
+        uint32_t timeout_ts = now_ts + movement_state.timeout_ticks;
+        if (timeout_ts < wake_ts) wake_ts = timeout_ts;
+        if (timeout_ts + MOVEMENT_COUNTDOWN_SLACK < latest_ts) latest_ts = timeout_ts + MOVEMENT_COUNTDOWN_SLACK;
+    }
+    if (movement_state.settings.bit.le_interval && movement_state.le_mode_ticks > 0) {
+        uint32_t le_mode_ts = now_ts + movement_state.le_mode_ticks;
+        if (le_mode_ts < wake_ts) wake_ts = le_mode_ts;
+        if (le_mode_ts + MOVEMENT_COUNTDOWN_SLACK < latest_ts) latest_ts = le_mode_ts + MOVEMENT_COUNTDOWN_SLACK;
+    }
+
+    // a deadline that is already here or passed fires right away.
+    if (wake_ts == UINT32_MAX) watch_rtc_cancel_timer(&next_wake_timer);
+    else watch_rtc_schedule_timer_with_slack(&next_wake_timer, watch_utility_date_time_from_unix_time(wake_ts, 0), latest_ts - wake_ts, cb_next_wake_timer);
+}
+
+static void _movement_handle_tickless_wake(void) {
+    watch_date_time now = movement_get_local_date_time();
+    uint32_t now_ts = watch_utility_date_time_to_unix_time(now, 0);
+    movement_state.needs_tickless_wake_handled = false;
+    _movement_update_tickless_countdowns(now_ts);
+
+    // deliver the face's tick, unless the face is about to be activated; in that case we'll catch it next time around.
+    if (movement_state.next_tick.reg && movement_state.next_tick.reg <= now.reg && event.event_type == EVENT_NONE) {
+        movement_state.next_tick.reg = 0;
+        movement_state.subsecond = 0;
+        event.event_type = EVENT_TICK;
+    }
+
+    movement_state.needs_next_wake_scheduled = true;
+}
 
-    // Movement requires at least a 1 Hz tick.
-    // If we are asked for an invalid frequency, default back to 1 Hz.
-    if (freq == 0 || __builtin_popcount(freq) != 1) freq = 1;
+static void _movement_end_tickless(void) {
+    _movement_update_tickless_countdowns(watch_utility_date_time_to_unix_time(watch_rtc_get_date_time(), 0));
+    movement_state.tickless = false;
+    movement_state.next_tick.reg = 0;
+    watch_rtc_cancel_timer(&next_wake_timer);
+}
+
+// a count of the ticks at freq, so far as it has to go: it changes at each one, and at nothing in between. freq must
+// divide the rate the RTC is ticking at.
+static inline uint16_t _movement_tick_position(uint8_t freq) {
+    return movement_state.tick_seconds * freq + movement_state.subsecond / (movement_state.tick_frequency / freq);
+}
+
+// the face on screen counts its subseconds at the rate it asked for, not the rate the RTC happens to be ticking at.
+static inline uint8_t _movement_face_subsecond(uint8_t subsecond) {
+    if (movement_state.tickless || movement_state.tick_frequency < movement_state.face_tick_frequency) return 0;
+    return subsecond / (movement_state.tick_frequency / movement_state.face_tick_frequency);
+}
+
+// runs the RTC at the fastest rate anyone wants: the face on screen, unless it's tickless, and every subscriber off
+// screen. they're all powers of two, so the fastest is a multiple of the rest.
+static void _movement_update_tick_frequency(void) {
+    uint8_t freq = movement_state.tickless ? 0 : movement_state.face_tick_frequency;
+    for(uint8_t word = 0; word < sizeof(background_tick_faces) / sizeof(background_tick_faces[0]); word++) {
+        uint32_t faces = background_tick_faces[word];
+        while (faces) {
+            uint8_t i = word * 32 + __builtin_ctz(faces);
+            faces &= faces - 1;
+            if (i != movement_state.current_face_idx && background_tick_frequencies[i] > freq) freq = background_tick_frequencies[i];
+        }
+    }
+    if (freq == movement_state.tick_frequency) return;
 
     // disable all callbacks except the 128 Hz one
     watch_rtc_disable_matching_periodic_callbacks(0xFE);
 
     movement_state.subsecond = 0;
     movement_state.tick_frequency = freq;
+    if (freq == 0) return;
+    // faster ticks learn about second boundaries from the 1 Hz periodic interrupt, which the RTC handles first.
+    if (freq > 1) watch_rtc_register_periodic_callback(cb_second, 1);
     watch_rtc_register_periodic_callback(cb_tick, freq);
 }
 
+// Movement keeps the 128 Hz tick for itself, and anything but a power of two below it gets 1 Hz.
+static inline uint8_t _movement_valid_tick_frequency(uint8_t freq) {
+    if (freq == 0 || freq >= 128 || __builtin_popcount(freq) != 1) return 1;
+    return freq;
+}
+
+void movement_request_next_tick(watch_date_time date_time) {
+    if (!movement_state.tickless) {
+        movement_state.tickless = true;
+        movement_state.countdown_timestamp = 0;
+        // the face's periodic tick stops; any subscriber's carries on.
+        _movement_update_tick_frequency();
+    }
+    movement_state.next_tick = date_time;
+    _movement_schedule_next_wake();
+}
+
+static void cb_animation_done(void) {
+    _movement_queue_event(EVENT_ANIMATION_DONE);
+}
+
+void movement_play_animation(const watch_display_frame_t *frames, uint8_t num_frames, const uint32_t mask[3],
+                             uint32_t frame_duration, uint8_t loops) {
+    watch_start_display_animation(frames, num_frames, mask, frame_duration, loops, cb_animation_done);
+}
+
+void movement_play_frames(const watch_display_frame_t *frames, uint8_t num_frames, uint32_t frame_duration) {
+    watch_start_display_playback(frames, num_frames, frame_duration, cb_animation_done);
+}
+
+static void cb_uart_data(void) {
+    _movement_queue_event(EVENT_UART_DATA);
+}
+
+void movement_enable_uart(uint8_t tx_pin, uint8_t rx_pin, uint32_t baud) {
+    watch_enable_uart(tx_pin, rx_pin, baud);
+    watch_uart_set_rx_callback(cb_uart_data);
+}
+
+void movement_disable_uart(void) {
+    watch_uart_set_rx_callback(NULL);
+    watch_disable_uart();
+}
+
+void movement_request_tick_frequency(uint8_t freq) {
+    // Movement uses the 128 Hz tick internally
+    if (freq == 128) return;
+
+    if (movement_state.tickless) _movement_end_tickless();
+    // with the battery low, faces get a tick a second at most.
+    if (power_level != MOVEMENT_POWER_NORMAL) freq = 1;
+
+    movement_state.face_tick_frequency = _movement_valid_tick_frequency(freq);
+    _movement_update_tick_frequency();
+    // the face's next tick is the next one at its own rate.
+    movement_state.face_tick_position = _movement_tick_position(movement_state.face_tick_frequency);
+}
+
+void movement_subscribe_ticks(uint8_t watch_face_index, uint8_t freq) {
+    if (watch_face_index >= MOVEMENT_NUM_FACES || freq == 128) return;
+
+    uint32_t bit = (uint32_t)1 << (watch_face_index % 32);
+    if (freq == 0) {
+        background_tick_faces[watch_face_index / 32] &= ~bit;
+        background_tick_frequencies[watch_face_index] = 0;
+    } else {
+        background_tick_faces[watch_face_index / 32] |= bit;
+        background_tick_frequencies[watch_face_index] = _movement_valid_tick_frequency(freq);
+    }
+    _movement_update_tick_frequency();
+    if (freq) background_tick_positions[watch_face_index] = _movement_tick_position(background_tick_frequencies[watch_face_index]);
+}
+
+// the face on screen gets a tick only when one at its own rate has come around since the last.
+static bool _movement_face_tick_is_due(void) {
+    if (movement_state.tickless || movement_state.tick_frequency < movement_state.face_tick_frequency) return false;
+    uint16_t position = _movement_tick_position(movement_state.face_tick_frequency);
+    if (position == movement_state.face_tick_position) return false;
+    movement_state.face_tick_position = position;
+    return true;
+}
+
+static void _movement_handle_background_ticks(void) {
+    for(uint8_t word = 0; word < sizeof(background_tick_faces) / sizeof(background_tick_faces[0]); word++) {
+        uint32_t faces = background_tick_faces[word];
+        while (faces) {
+            uint8_t i = word * 32 + __builtin_ctz(faces);
+            faces &= faces - 1;
+            uint8_t freq = background_tick_frequencies[i];
+            // the face on screen has its own ticks; and until the rate catches up with a new subscriber, it waits.
+            if (i == movement_state.current_face_idx || movement_state.tick_frequency < freq) continue;
+            uint16_t position = _movement_tick_position(freq);
+            if (position == background_tick_positions[i]) continue;
+            background_tick_positions[i] = position;
+            movement_event_t tick_event = { EVENT_BACKGROUND_TASK, movement_state.subsecond / (movement_state.tick_frequency / freq) };
+            _movement_face_loop(i, tick_event);
+        }
+    }
+}
+
+bool movement_request_performance(movement_performance_t level) {
+    if (!watch_set_performance_level(level == MOVEMENT_PERFORMANCE_HIGH ? WATCH_PERFORMANCE_HIGH : WATCH_PERFORMANCE_NORMAL)) return false;
+    movement_state.high_performance = level == MOVEMENT_PERFORMANCE_HIGH;
+    return true;
+}
+
+static void _movement_end_high_performance(void) {
+    if (movement_state.high_performance) movement_request_performance(MOVEMENT_PERFORMANCE_NORMAL);
+}
+
 void movement_illuminate_led(void) {
-    if (movement_state.settings.bit.led_duration) {
+    // the LED takes more than anything else; with the battery nearly gone, it stays off.
+    if (movement_state.settings.bit.led_duration && power_level != MOVEMENT_POWER_CRITICAL) {
         watch_set_led_color(movement_state.settings.bit.led_red_color ? (0xF | movement_state.settings.bit.led_red_color << 4) : 0,
                             movement_state.settings.bit.led_green_color ? (0xF | movement_state.settings.bit.led_green_color << 4) : 0);
-        movement_state.light_ticks = (movement_state.settings.bit.led_duration * 2 - 1) * 128;
-        _movement_enable_fast_tick_if_needed();
+        uint32_t now_ts = watch_utility_date_time_to_unix_time(watch_rtc_get_date_time(), 0);
+        if (movement_state.light_ticks == -1) movement_state.light_on_timestamp = now_ts;
+        movement_state.light_ticks = 1;
+        // the TCC keeps the LED lit while we sleep, and an RTC timer wakes us to turn it off. the timer only counts
+        // whole seconds, so round the duration up rather than cut it short.
+        uint32_t off_ts = now_ts + (power_level == MOVEMENT_POWER_NORMAL ? movement_state.settings.bit.led_duration * 2 : 1);
+        watch_rtc_schedule_timer(&light_timer, watch_utility_date_time_from_unix_time(off_ts, 0), cb_light_timer);
     }
 }
 
@@ -258,7 +1244,7 @@ bool movement_default_loop_handler(movement_event_t event, movement_settings_t *
             movement_illuminate_led();
             break;
         case EVENT_MODE_LONG_PRESS:
-            if (MOVEMENT_SECONDARY_FACE_INDEX && movement_state.current_face_idx == 0) {
+            if (secondary_face_position && movement_state.current_face_idx == face_order[0]) {
                 movement_move_to_face(MOVEMENT_SECONDARY_FACE_INDEX);
             } else {
                 movement_move_to_face(0);
@@ -272,18 +1258,62 @@ bool movement_default_loop_handler(movement_event_t event, movement_settings_t *
 }
 
 void movement_move_to_face(uint8_t watch_face_index) {
+    // faces move to 0 to go home, which is wherever the order starts; with the battery nearly gone, home is all there is.
+    if (watch_face_index == 0 || power_level == MOVEMENT_POWER_CRITICAL || watch_face_index >= MOVEMENT_NUM_FACES || face_positions[watch_face_index] == MOVEMENT_FACE_NOT_IN_ORDER) {
+        watch_face_index = face_order[0];
+    }
     movement_state.watch_face_changed = true;
     movement_state.next_face_idx = watch_face_index;
 }
 
 void movement_move_to_next_face(void) {
-    uint16_t face_max;
-    if (MOVEMENT_SECONDARY_FACE_INDEX) {
-        face_max = (movement_state.current_face_idx < (int16_t)MOVEMENT_SECONDARY_FACE_INDEX) ? MOVEMENT_SECONDARY_FACE_INDEX : MOVEMENT_NUM_FACES;
+    if (power_level == MOVEMENT_POWER_CRITICAL) {
+        if (movement_state.current_face_idx != face_order[0]) movement_move_to_face(0);
+        return;
+    }
+    uint8_t position = face_positions[movement_state.current_face_idx];
+    // the primary faces wrap around to the first, and the secondary ones back to it too.
+    uint8_t end = (secondary_face_position && position < secondary_face_position) ? secondary_face_position : num_ordered_faces;
+    movement_state.watch_face_changed = true;
+    movement_state.next_face_idx = face_order[(position + 1) % end];
+}
+
+bool movement_set_face_order(const uint8_t *watch_face_indexes, uint8_t count) {
+    bool was_in_order[MOVEMENT_NUM_FACES];
+    for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) was_in_order[i] = face_positions[i] != MOVEMENT_FACE_NOT_IN_ORDER;
+
+    bool stored;
+    if (count) {
+        if (!_movement_apply_face_order(watch_face_indexes, count)) return false;
+        stored = movement_kv_set(MOVEMENT_FACE_ORDER_KEY, face_order, count);
     } else {
-        face_max = MOVEMENT_NUM_FACES;
+        movement_kv_delete(MOVEMENT_FACE_ORDER_KEY);
+        _movement_load_face_order();
+        stored = true;
     }
-    movement_move_to_face((movement_state.current_face_idx + 1) % face_max);
+    stored = movement_kv_flush() && stored;
+
+    // faces that have come back run again from now on, and faces that have been left out stop running.
+    _movement_read_face_table();
+    for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
+        bool in_order = face_positions[i] != MOVEMENT_FACE_NOT_IN_ORDER;
+        if (in_order == was_in_order[i]) continue;
+        movement_set_background_task_interest_for_face(i, in_order);
+        if (!in_order) {
+            movement_cancel_background_task_for_face(i);
+            movement_subscribe_ticks(i, 0);
+            movement_cancel_jobs_for_face(i);
+        }
+    }
+    _movement_set_up_eager_faces();
+    if (face_positions[movement_state.current_face_idx] == MOVEMENT_FACE_NOT_IN_ORDER) movement_move_to_face(0);
+
+    return stored;
+}
+
+const uint8_t *movement_get_face_order(uint8_t *count) {
+    *count = num_ordered_faces;
+    return face_order;
 }
 
 void movement_schedule_background_task(watch_date_time date_time) {
@@ -295,23 +1325,32 @@ void movement_cancel_background_task(void) {
 }
 
 void movement_schedule_background_task_for_face(uint8_t watch_face_index, watch_date_time date_time) {
-    watch_date_time now = watch_rtc_get_date_time();
+    movement_schedule_background_task_for_face_with_slack(watch_face_index, date_time, 0);
+}
+
+void movement_schedule_background_task_for_face_with_slack(uint8_t watch_face_index, watch_date_time date_time, uint8_t slack) {
+    watch_date_time now = movement_get_local_date_time();
     if (date_time.reg > now.reg) {
-        movement_state.has_scheduled_background_task = true;
         scheduled_tasks[watch_face_index].reg = date_time.reg;
+        scheduled_task_slack[watch_face_index] = slack;
+        _movement_scheduled_task_insert(watch_face_index);
+        _movement_arm_scheduled_task_timer();
     }
 }
 
 void movement_cancel_background_task_for_face(uint8_t watch_face_index) {
     scheduled_tasks[watch_face_index].reg = 0;
-    bool other_tasks_scheduled = false;
-    for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
-        if (scheduled_tasks[i].reg != 0) {
-            other_tasks_scheduled = true;
-            break;
-        }
+    _movement_scheduled_task_remove(watch_face_index);
+    _movement_arm_scheduled_task_timer();
+}
+
+void movement_set_background_task_interest_for_face(uint8_t watch_face_index, bool interested) {
+    // a face without a wants_background_task callback has nothing to poll.
+    if (interested && watch_faces[watch_face_index].wants_background_task != NULL) {
+        background_task_faces[watch_face_index / 32] |= (uint32_t)1 << (watch_face_index % 32);
+    } else {
+        background_task_faces[watch_face_index / 32] &= ~((uint32_t)1 << (watch_face_index % 32));
     }
-    movement_state.has_scheduled_background_task = other_tasks_scheduled;
 }
 
 void movement_request_wake() {
@@ -319,32 +1358,167 @@ void movement_request_wake() {
     _movement_reset_inactivity_countdown();
 }
 
-static void end_buzzing() {
+static void _movement_cb_motion(bool moving) {
+    if (movement_state.le_mode_ticks == -1) {
+        // picked up: wake at once, without waiting for a button.
+        if (moving) movement_request_wake();
+        return;
+    }
+    // the countdowns are kept against the clock in tickless mode; bring them up to now before changing one.
+    if (movement_state.tickless) {
+        _movement_update_tickless_countdowns(watch_utility_date_time_to_unix_time(watch_rtc_get_date_time(), 0));
+    }
+    if (moving) {
+        // the watch was set down, and it's being used again: the usual countdown applies.
+        movement_state.le_mode_ticks = _movement_le_deadline();
+    } else if (movement_state.le_mode_ticks > MOVEMENT_STILL_LE_DEADLINE) {
+        movement_state.le_mode_ticks = MOVEMENT_STILL_LE_DEADLINE;
+    }
+    movement_state.needs_next_wake_scheduled = true;
+}
+
+static void _movement_cb_gesture(movement_accelerometer_gesture_t gesture) {
+    switch (gesture) {
+        case MOVEMENT_GESTURE_TAP: _movement_queue_event(EVENT_TAP); break;
+        case MOVEMENT_GESTURE_DOUBLE_TAP: _movement_queue_event(EVENT_DOUBLE_TAP); break;
+        case MOVEMENT_GESTURE_ORIENTATION: _movement_queue_event(EVENT_ORIENTATION); break;
+        case MOVEMENT_GESTURE_FREE_FALL: _movement_queue_event(EVENT_FREE_FALL); break;
+    }
+}
+
+bool movement_request_gestures(uint8_t gestures) {
+    if (!movement_accelerometer_detect_gestures(gestures, gestures ? _movement_cb_gesture : NULL)) return false;
+    face_gestures = gestures;
+    return true;
+}
+
+static void _movement_update_motion_detection(void) {
+    // only if there's a low energy mode to follow, and no face is driving the accelerometer itself.
+    bool wanted = movement_state.settings.bit.le_motion && movement_state.settings.bit.le_interval &&
+                  (movement_sensors_get_devices() & (1 << MOVEMENT_SENSOR_DEVICE_LIS2DW)) &&
+                  !movement_sensors_is_held(MOVEMENT_SENSOR_DEVICE_LIS2DW);
+    if (wanted == movement_accelerometer_is_detecting_motion()) return;
+    movement_accelerometer_detect_motion(wanted ? _movement_cb_motion : NULL);
+}
+
+void movement_queue_tick(void) {
+    _movement_queue_event(EVENT_TICK);
+}
+
+void movement_queue_resume(void) {
+    _movement_queue_event(EVENT_RESUME);
+}
+
+uint8_t movement_get_tick_frequency(void) {
+    return movement_state.face_tick_frequency;
+}
+
+// tunes waiting for the buzzer, played in order by the TC3 sequencer. a tune is a note & duration sequence, or one
+// that's been compiled into periods and ticks (@see watch_buzzer_play_notes).
+typedef struct {
+    int8_t *sequence;
+    const watch_buzzer_note_t *notes;
+    watch_buzzer_next_notes_t next_notes;
+} movement_tune_t;
+
+static movement_tune_t tune_queue[MOVEMENT_TUNE_QUEUE_LENGTH];
+static uint8_t tune_queue_head;
+static uint8_t tune_queue_count;
+static bool buzzer_enabled_for_tune;
+
+static void _movement_play_sequence(movement_tune_t tune);
+
+static void _movement_sequence_finished(void) {
+    // runs in the TC3 interrupt when a sequence ends, or from _movement_stop_alarm.
+    movement_state.is_playing_alarm = false;
+    if (tune_queue_count) {
+        movement_tune_t next = tune_queue[tune_queue_head];
+        tune_queue_head = (tune_queue_head + 1) % MOVEMENT_TUNE_QUEUE_LENGTH;
+        tune_queue_count--;
+        _movement_play_sequence(next);
+        return;
+    }
     movement_state.is_buzzing = false;
+    if (buzzer_enabled_for_tune) {
+        buzzer_enabled_for_tune = false;
+        watch_disable_buzzer();
+    }
 }
 
-static void end_buzzing_and_disable_buzzer(void) {
-    end_buzzing();
-    watch_disable_buzzer();
+static uint16_t _movement_tune_ticks(movement_tune_t tune) {
+    uint16_t ticks = 0;
+    if (tune.notes) {
+        for(const watch_buzzer_note_t *note = tune.notes; note->ticks; note++) ticks += note->ticks;
+        return ticks;
+    }
+    // each note lasts one tick longer than its duration, and a negative note repeats the notes before it.
+    int8_t *sequence = tune.sequence;
+    for(int16_t i = 0; sequence[i] && sequence[i + 1]; i += 2) {
+        if (sequence[i] > 0) {
+            ticks += sequence[i + 1] + 1;
+        } else {
+            uint16_t repeated = 0;
+            for(int16_t j = (i + sequence[i] * 2 > 0) ? i + sequence[i] * 2 : 0; j < i; j += 2) {
+                if (sequence[j] > 0) repeated += sequence[j + 1] + 1;
+            }
+            ticks += repeated * sequence[i + 1];
+        }
+    }
+    return ticks;
 }
 
-void movement_play_signal(void) {
-    void *maybe_disable_buzzer = end_buzzing_and_disable_buzzer;
-    if (watch_is_buzzer_or_led_enabled()) {
-        maybe_disable_buzzer = end_buzzing;
-    } else {
-        watch_enable_buzzer();
+static void _movement_play_sequence(movement_tune_t tune) {
+    face_stats[movement_state.current_face_idx].buzzer_ticks += _movement_tune_ticks(tune);
+    if (!movement_state.is_buzzing) {
+        // if somebody else turned the TCC on (the LED, say), leave it on when we're done.
+        buzzer_enabled_for_tune = !watch_is_buzzer_or_led_enabled();
+        if (buzzer_enabled_for_tune) watch_enable_buzzer();
     }
     movement_state.is_buzzing = true;
-    watch_buzzer_play_sequence(signal_tune, maybe_disable_buzzer);
+    if (tune.notes) watch_buzzer_stream_notes(tune.notes, tune.next_notes, _movement_sequence_finished);
+    else watch_buzzer_play_sequence(tune.sequence, _movement_sequence_finished);
+}
+
+static void _movement_stop_alarm(void) {
+    watch_buzzer_abort_sequence();
+    // aborting doesn't call the sequence's end callback, so we do it ourselves.
+    _movement_sequence_finished();
+}
+
+static bool _movement_queue_tune(movement_tune_t tune) {
+    if (!movement_state.is_buzzing) {
+        _movement_play_sequence(tune);
+    } else if (tune_queue_count < MOVEMENT_TUNE_QUEUE_LENGTH) {
+        tune_queue[(tune_queue_head + tune_queue_count) % MOVEMENT_TUNE_QUEUE_LENGTH] = tune;
+        tune_queue_count++;
+    } else {
+        return false;
+    }
     if (movement_state.le_mode_ticks == -1) {
-        // the watch is asleep. wake it up for "1" round through the main loop.
-        // the sleep_mode_app_loop will notice the is_buzzing and note that it
-        // only woke up to beep and then it will spinlock until the callback
-        // turns off the is_buzzing flag.
+        // the watch is asleep, and sleep mode turns off the buzzer. wake it up for "1" round through the main loop;
+        // app_loop won't go back to sleep mode until the queue has drained, and it can stand by between notes.
         movement_state.needs_wake = true;
         movement_state.le_mode_ticks = 1;
     }
+    return true;
+}
+
+void movement_play_tune(int8_t *tune) {
+    _movement_queue_tune((movement_tune_t){ .sequence = tune });
+}
+
+bool movement_play_notes(const watch_buzzer_note_t *notes, watch_buzzer_next_notes_t next_notes) {
+    return _movement_queue_tune((movement_tune_t){ .notes = notes, .next_notes = next_notes });
+}
+
+void movement_stop_tune(void) {
+    if (movement_state.is_buzzing) _movement_stop_alarm();
+}
+
+void movement_play_signal(void) {
+    // chimes are a nicety; with the battery low, they go.
+    if (power_level != MOVEMENT_POWER_NORMAL) return;
+    _movement_queue_tune((movement_tune_t){ .notes = signal_tune_notes });
 }
 
 void movement_play_alarm(void) {
@@ -352,28 +1526,87 @@ void movement_play_alarm(void) {
 }
 
 void movement_play_alarm_beeps(uint8_t rounds, BuzzerNote alarm_note) {
+    // our tone is 0.375 seconds of beep and 0.625 of silence, repeated as given.
+    // the sequencer runs at 64 Hz and holds each note for one tick more than its duration, so 2 is about 50 ms,
+    // 4 is about 75 ms and the whole round adds up to 64 ticks. the last pair rewinds for the remaining rounds.
+    static int8_t alarm_tune[] = {
+        BUZZER_NOTE_C8, 2,
+        BUZZER_NOTE_REST, 2,
+        BUZZER_NOTE_C8, 2,
+        BUZZER_NOTE_REST, 2,
+        BUZZER_NOTE_C8, 2,
+        BUZZER_NOTE_REST, 2,
+        BUZZER_NOTE_C8, 4,
+        BUZZER_NOTE_REST, 40,
+        -8, 0,
+        0
+    };
+
     if (rounds == 0) rounds = 1;
     if (rounds > 20) rounds = 20;
     movement_request_wake();
-    movement_state.alarm_note = alarm_note;
-    // our tone is 0.375 seconds of beep and 0.625 of silence, repeated as given.
-    movement_state.alarm_ticks = 128 * rounds - 75;
-    _movement_enable_fast_tick_if_needed();
+    for(uint8_t i = 0; i < 7; i++) {
+        if (alarm_tune[i * 2] != BUZZER_NOTE_REST) alarm_tune[i * 2] = alarm_note;
+    }
+    alarm_tune[17] = rounds - 1;
+    _movement_play_sequence((movement_tune_t){ .sequence = alarm_tune });
+    movement_state.is_playing_alarm = true;
+}
+
+const movement_face_stats_t *movement_get_face_stats(uint8_t watch_face_index) {
+    if (watch_face_index >= MOVEMENT_NUM_FACES) return NULL;
+    return &face_stats[watch_face_index];
+}
+
+const movement_latency_stats_t *movement_get_latency_stats(uint8_t watch_face_index) {
+    if (watch_face_index >= MOVEMENT_NUM_FACES) return NULL;
+    return &latency_stats[watch_face_index];
+}
+
+void movement_reset_face_stats(void) {
+    memset(face_stats, 0, sizeof(face_stats));
+    memset(latency_stats, 0, sizeof(latency_stats));
+    event_queue_overflows = 0;
+}
+
+uint32_t movement_get_event_queue_overflows(void) {
+    return event_queue_overflows;
+}
+
+uint16_t movement_get_battery_voltage(void) {
+    return watch_get_battery_voltage();
+}
+
+bool movement_battery_is_low(void) {
+    uint16_t voltage = watch_get_battery_voltage();
+    return voltage && voltage < MOVEMENT_LOW_BATTERY_VOLTAGE;
+}
+
+movement_power_level_t movement_get_power_level(void) {
+    return power_level;
 }
 
 uint8_t movement_claim_backup_register(void) {
-    if (movement_state.next_available_backup_register >= 8) return 0;
-    return movement_state.next_available_backup_register++;
+    return movement_backup_claim_register(face_in_setup >= 0 ? face_in_setup : movement_state.current_face_idx);
+}
+
+void movement_enter_backup_mode(void) {
+    watch_faces[movement_state.current_face_idx].resign(&movement_state.settings, _movement_face_context(movement_state.current_face_idx));
+    movement_kv_flush();
+    movement_snapshot_write();
+    watch_store_backup_data(movement_state.settings.reg, 0);
+    watch_enter_backup_mode();
+
+    // only the simulator gets here, since it can't go into BACKUP mode; carry on as if the watch had woken from it.
+    movement_backup_wake();
+    watch_faces[movement_state.current_face_idx].activate(&movement_state.settings, _movement_face_context(movement_state.current_face_idx));
+    event.subsecond = 0;
+    event.event_type = EVENT_ACTIVATE;
 }
 
 void app_init(void) {
-#if defined(NO_FREQCORR)
-    watch_rtc_freqcorr_write(0, 0);
-#elif defined(WATCH_IS_BLUE_BOARD)
-    watch_rtc_freqcorr_write(11, 0);
-#else
-    watch_rtc_freqcorr_write(22, 0);
-#endif
+    _movement_mark_boot(MOVEMENT_BOOT_APP_INIT);
+    watch_rtc_freqcorr_write(WATCH_BOARD_FREQCORR_DEFAULT, 0);
 
     memset(&movement_state, 0, sizeof(movement_state));
 
@@ -385,11 +1618,16 @@ void app_init(void) {
     movement_state.settings.bit.le_interval = MOVEMENT_DEFAULT_LOW_ENERGY_INTERVAL;
     movement_state.settings.bit.led_duration = MOVEMENT_DEFAULT_LED_DURATION;
     movement_state.light_ticks = -1;
-    movement_state.alarm_ticks = -1;
-    movement_state.next_available_backup_register = 4;
     _movement_reset_inactivity_countdown();
 
-    filesystem_init();
+    // a watch whose user row doesn't give the storage area its full size gets it fixed, and resets, before the
+    // filesystem is mounted for the first time.
+    watch_storage_provision();
+    // the filesystem is mounted when it's first used, which is here: the face order is needed for the first screen.
+    movement_kv_init();
+    _movement_load_face_order();
+    movement_state.current_face_idx = face_order[0];
+    _movement_mark_boot(MOVEMENT_BOOT_STORAGE);
 
 #if __EMSCRIPTEN__
     int32_t time_zone_offset = EM_ASM_INT({
@@ -406,6 +1644,67 @@ void app_init(void) {
 
 void app_wake_from_backup(void) {
     movement_state.settings.reg = watch_get_backup_data(0);
+    // the snapshot is read in when a face first asks for its state.
+    movement_backup_wake();
+}
+
+static void _movement_reserve_face_contexts(void) {
+    uint32_t used = 0;
+    // the hibernating faces' slot goes first. a face with a background task can be called at any time, so it can't.
+    for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
+        if (!(watch_faces[i].flags & MOVEMENT_FACE_HIBERNATE) || watch_faces[i].wants_background_task != NULL) continue;
+        uint32_t size = (watch_faces[i].context_size + MOVEMENT_CONTEXT_ALIGNMENT - 1) & ~(MOVEMENT_CONTEXT_ALIGNMENT - 1);
+        if (size == 0 || size > MOVEMENT_CONTEXT_ARENA_SIZE) continue;
+        hibernating_faces[i / 32] |= (uint32_t)1 << (i % 32);
+        reserved_contexts[i] = context_arena;
+        context_stats.hibernating_faces++;
+        if (size > used) used = size;
+    }
+    context_stats.hibernation_slot_size = used;
+    for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
+        uint32_t size = (watch_faces[i].context_size + MOVEMENT_CONTEXT_ALIGNMENT - 1) & ~(MOVEMENT_CONTEXT_ALIGNMENT - 1);
+        if (size == 0 || _movement_face_hibernates(i) || used + size > MOVEMENT_CONTEXT_ARENA_SIZE) continue;
+        reserved_contexts[i] = context_arena + used;
+        used += size;
+    }
+    context_stats.arena_size = MOVEMENT_CONTEXT_ARENA_SIZE;
+    context_stats.arena_used = used;
+}
+
+void *movement_claim_face_context(uint8_t watch_face_index, size_t size) {
+    void *context = NULL;
+    if (watch_face_index < MOVEMENT_NUM_FACES && size <= watch_faces[watch_face_index].context_size) {
+        context = reserved_contexts[watch_face_index];
+        reserved_contexts[watch_face_index] = NULL;
+        // a hibernating face gets the shared slot, once whoever has it is written out, and it's new, so it's dirty.
+        if (context != NULL && _movement_face_hibernates(watch_face_index)) {
+            _movement_hibernate_slot_owner();
+            hibernation_owner = watch_face_index;
+            hibernation_hash = 0;
+        }
+    }
+    if (context == NULL) {
+        context = malloc(size);
+        if (context == NULL) return NULL;
+        context_stats.heap_contexts++;
+        context_stats.heap_context_bytes += size;
+    }
+    memset(context, 0, size);
+
+    return context;
+}
+
+const movement_context_stats_t *movement_get_context_stats(void) {
+    return &context_stats;
+}
+
+const uint32_t *movement_get_boot_times(uint8_t *count) {
+    *count = boot_phases_done;
+    return boot_times;
+}
+
+movement_settings_t *movement_get_settings(void) {
+    return &movement_state.settings;
 }
 
 void app_setup(void) {
@@ -414,24 +1713,34 @@ void app_setup(void) {
     static bool is_first_launch = true;
 
     if (is_first_launch) {
+        _movement_mark_boot(MOVEMENT_BOOT_APP_SETUP);
         #ifdef MOVEMENT_CUSTOM_BOOT_COMMANDS
         MOVEMENT_CUSTOM_BOOT_COMMANDS()
         #endif
 
+        _movement_read_face_table();
+        _movement_reserve_face_contexts();
+        // the sensors are probed when a face first asks what's there, and the RTC correction and USB storage wait for
+        // the first screen.
+        boot_setup_pending = true;
         for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
             watch_face_contexts[i] = NULL;
             scheduled_tasks[i].reg = 0;
+            scheduled_task_slack[i] = 0;
+            // every face that can want a background task is polled until it says otherwise.
+            movement_set_background_task_interest_for_face(i, face_positions[i] != MOVEMENT_FACE_NOT_IN_ORDER);
             is_first_launch = false;
         }
+        scheduled_task_heap_size = 0;
 
-        // set up the 1 minute alarm (for background tasks and low power updates)
-        watch_date_time alarm_time;
-        alarm_time.reg = 0;
-        alarm_time.unit.second = 59; // after a match, the alarm fires at the next rising edge of CLK_RTC_CNT, so 59 seconds lets us update at :00
-        watch_rtc_register_alarm_callback(cb_alarm_fired, alarm_time, ALARM_MATCH_SS);
+        _movement_schedule_minute_timer();
     }
     if (movement_state.le_mode_ticks != -1) {
+        #ifdef MOVEMENT_WAKE_ON_ANY_BUTTON
+        watch_disable_button_wake();
+        #else
         watch_disable_extwake_interrupt(BTN_ALARM);
+        #endif
 
         watch_enable_external_interrupts();
         watch_register_interrupt_callback(BTN_MODE, cb_mode_btn_interrupt, INTERRUPT_TRIGGER_BOTH);
@@ -442,13 +1751,22 @@ void app_setup(void) {
         watch_enable_leds();
         watch_enable_display();
 
+        // sleep mode stopped every periodic tick, so whatever rate we had is gone.
+        movement_state.tick_frequency = 0;
         movement_request_tick_frequency(1);
 
-        for(uint8_t i = 0; i < MOVEMENT_NUM_FACES; i++) {
-            watch_faces[i].setup(&movement_state.settings, i, &watch_face_contexts[i]);
-        }
-
-        watch_faces[movement_state.current_face_idx].activate(&movement_state.settings, watch_face_contexts[movement_state.current_face_idx]);
+        // the faces that run in the background, or ask to, are set up once the face on screen has drawn itself, and
+        // the rest when they're first needed. they're set up in order, so if the face on screen is one of them, it
+        // can't go first.
+        memset(set_up_faces, 0, sizeof(set_up_faces));
+        eager_setup_pending = true;
+        uint8_t face = movement_state.current_face_idx;
+        if (eager_setup_faces[face / 32] & ((uint32_t)1 << (face % 32))) _movement_finish_setup();
+
+        _movement_set_up_face(face);
+        watch_faces[face].activate(&movement_state.settings, _movement_face_context(face));
+        _movement_end_high_performance();
+        _movement_mark_boot(MOVEMENT_BOOT_FACE_ACTIVATED);
         event.subsecond = 0;
         event.event_type = EVENT_ACTIVATE;
     }
@@ -460,90 +1778,282 @@ void app_prepare_for_standby(void) {
 void app_wake_from_standby(void) {
 }
 
-static void _sleep_mode_app_loop(void) {
-    movement_state.needs_wake = false;
+// set while the simulator sleeps in low energy mode, so that the next trip through the loop picks up where it left off.
+static bool sleep_mode_waiting;
+
+static bool _movement_night_wanted(void) {
+    uint8_t mode = movement_state.settings.bit.night_mode;
+    if (mode == 0) return false;
+    // nobody is looking at a watch on the nightstand, or on a sleeper's wrist.
+    movement_activity_t activity = movement_activity_get();
+    if (activity == MOVEMENT_ACTIVITY_OFF_WRIST || activity == MOVEMENT_ACTIVITY_SLEEPING) return true;
+
+    uint8_t start = movement_night_hours[mode][0];
+    uint8_t end = movement_night_hours[mode][1];
+    if (start == end) return false;
+    uint8_t hour = movement_get_local_date_time().unit.hour;
+    if (start < end) return hour >= start && hour < end;
+    return hour >= start || hour < end;
+}
+
+// turns the display off for the night, or back on in the morning; in low energy mode only.
+static void _movement_update_night(void) {
+    bool dark = _movement_night_wanted();
+    if (dark == display_dark) return;
+    display_dark = dark;
+    watch_display_set_off(dark);
+    // faces weren't asked to draw while it was dark, so what's on the display is hours old; have the face draw now.
+    if (!dark) {
+        low_energy_frames.count = 0;
+        low_energy_frames.next = 0;
+    }
+}
+
+// returns true once it's time to wake up for real, which on the watch is the only way it ever returns. the simulator
+// can't wait for an interrupt in here, so it returns false each time it goes back to sleep, and comes back on the wake.
+static bool _sleep_mode_app_loop(void) {
     // as long as le_mode_ticks is -1 (i.e. we are in low energy mode), we wake up here, update the screen, and go right back to sleep.
     while (movement_state.le_mode_ticks == -1) {
+        // every wake from sleep mode is a new moment in time.
+        _movement_forget_date_time();
+
         // we also have to handle background tasks here in the mini-runloop
         if (movement_state.needs_background_tasks_handled) _movement_handle_background_tasks();
+        if (movement_state.needs_scheduled_tasks_handled) _movement_handle_scheduled_tasks();
+
+        // and the sensors: the accelerometer's watermark, which can wake us on its own, and any samples due.
+        if (movement_sensors_needs_service()) movement_sensors_service();
 
-        event.event_type = EVENT_LOW_ENERGY_UPDATE;
-        watch_faces[movement_state.current_face_idx].loop(event, &movement_state.settings, watch_face_contexts[movement_state.current_face_idx]);
+        // encode the next tones for a transmission over the buzzer, as the ones before them finish playing.
+        if (movement_chirpy_needs_service()) movement_chirpy_service();
+
+        // hand the face whatever has come in over the light sensor.
+        if (movement_optical_rx_needs_service()) movement_optical_rx_service();
+
+        // a face that drew its minutes ahead of time has them put up by the minute timer; the rest are woken for each.
+        // with the display off for the night, there's nothing to draw for.
+        _movement_update_night();
+        if (!display_dark) {
+            if (low_energy_frames.count == 0) {
+                event.event_type = EVENT_LOW_ENERGY_UPDATE;
+                _movement_face_loop(movement_state.current_face_idx, event);
+            }
+            if (low_energy_frames.next == low_energy_frames.count) _movement_draw_low_energy_frames();
+        }
 
         // if we need to wake immediately, do it!
-        if (movement_state.needs_wake) return;
+        if (movement_state.needs_wake) return true;
         // otherwise enter sleep mode, and when the extwake handler is called, it will reset le_mode_ticks and force us out at the next loop.
-        else watch_enter_sleep_mode();
+        // these wakes only need the RTC and the display, so skip app_setup until we wake for real.
+        else watch_enter_sleep_mode_minimal_resume();
+#if __EMSCRIPTEN__
+        return false;
+#endif
     }
+
+    return true;
 }
 
-bool app_loop(void) {
+// has the face on screen draw the next few minutes of low energy mode, if it can.
+static void _movement_draw_low_energy_frames(void) {
+    const watch_face_t *wf = &watch_faces[movement_state.current_face_idx];
+    low_energy_frames.count = 0;
+    low_energy_frames.next = 0;
+    if (wf->draw_low_energy == NULL) return;
+
+    watch_date_time now = watch_rtc_get_date_time();
+    uint32_t first_minute = watch_utility_date_time_to_unix_time(now, 0) - now.unit.second + 60;
+    uint32_t shown[WATCH_DISPLAY_NUM_COMS];
+    memcpy(shown, watch_display_framebuffer, sizeof(shown));
+    watch_display_set_held(true);
+    uint8_t count = 0;
+    while (count < MOVEMENT_LOW_ENERGY_FRAMES) {
+        watch_date_time date_time = watch_utility_date_time_from_unix_time(first_minute + 60 * count, 0);
+        if (!wf->draw_low_energy(&movement_state.settings, _movement_face_context(movement_state.current_face_idx), date_time)) break;
+        memcpy(low_energy_frames.frames[count].segments, watch_display_framebuffer, sizeof(shown));
+        count++;
+    }
+    memcpy(watch_display_framebuffer, shown, sizeof(shown));
+    watch_display_set_held(false);
+
+    low_energy_frames.first_minute = first_minute;
+    low_energy_frames.count = count;
+}
+
+static void _movement_wake_from_sleep_mode(void) {
+    // le_mode_ticks has been reset by now, so this is the one place where app_setup brings back the buttons, buzzer
+    // and faces after low energy mode.
+    sleep_mode_waiting = false;
+    if (display_dark) {
+        display_dark = false;
+        watch_display_set_off(false);
+    }
+    event.event_type = EVENT_ACTIVATE;
+    app_setup();
+}
+
+// puts up the face's last frame, if it has been on screen before, and holds it there while the face activates from a
+// clear framebuffer, as it always has. faces that haven't been shown yet start from a blank display.
+static void _movement_show_preview(uint8_t face_idx) {
+    if (faces_with_preview[face_idx / 32] & (1u << (face_idx % 32))) {
+        memcpy(watch_display_framebuffer, face_previews[face_idx].segments, sizeof(watch_display_framebuffer));
+        // the face before may not have drawn yet either.
+        watch_display_set_held(false);
+        watch_display_commit();
+        watch_display_set_held(true);
+        preview_showing = true;
+    }
+    watch_clear_display();
+}
+
+// lets go of the preview, putting up what the face has drawn in its place.
+static void _movement_end_preview(void) {
+    if (!preview_showing) return;
+    preview_showing = false;
+    watch_display_set_held(false);
+    watch_display_commit();
+}
+
+static bool _movement_app_loop(void) {
+    if (sleep_mode_waiting) {
+        if (!_sleep_mode_app_loop()) return true;
+        _movement_wake_from_sleep_mode();
+    }
+
     const watch_face_t *wf = &watch_faces[movement_state.current_face_idx];
-    bool woke_up_for_buzzer = false;
+    // read the clock at most once per trip through the loop.
+    _movement_forget_date_time();
     if (movement_state.watch_face_changed) {
         if (movement_state.settings.bit.button_should_sound) {
-            // low note for nonzero case, high note for return to watch_face 0
-            watch_buzzer_play_note(movement_state.next_face_idx ? BUZZER_NOTE_C7 : BUZZER_NOTE_C8, 50);
+            // low note for any other face, high note for the return to the first
+            watch_buzzer_play_note(movement_state.next_face_idx != face_order[0] ? BUZZER_NOTE_C7 : BUZZER_NOTE_C8, 50);
         }
-        wf->resign(&movement_state.settings, watch_face_contexts[movement_state.current_face_idx]);
+        memcpy(face_previews[movement_state.current_face_idx].segments, watch_display_framebuffer,
+               sizeof(watch_display_framebuffer));
+        faces_with_preview[movement_state.current_face_idx / 32] |= 1u << (movement_state.current_face_idx % 32);
+        wf->resign(&movement_state.settings, _movement_face_context(movement_state.current_face_idx));
+        // faces save their settings on resign; write them all out together.
+        movement_kv_flush();
         movement_state.current_face_idx = movement_state.next_face_idx;
         // we have just updated the face idx, so we must recache the watch face pointer.
         wf = &watch_faces[movement_state.current_face_idx];
-        watch_clear_display();
+        watch_stop_segment_blink();
+        watch_stop_display_animation();
+        watch_stop_display_playback();
+        _movement_show_preview(movement_state.current_face_idx);
         movement_request_tick_frequency(1);
-        wf->activate(&movement_state.settings, watch_face_contexts[movement_state.current_face_idx]);
+        if (face_gestures) movement_request_gestures(0);
+        _movement_set_up_face(movement_state.current_face_idx);
+        wf->activate(&movement_state.settings, _movement_face_context(movement_state.current_face_idx));
+        _movement_end_high_performance();
         event.subsecond = 0;
         event.event_type = EVENT_ACTIVATE;
         movement_state.watch_face_changed = false;
     }
 
+    // in tickless mode, the alarm woke us for some deadline; figure out which.
+    if (movement_state.needs_tickless_wake_handled) _movement_handle_tickless_wake();
+
     // if the LED should be off, turn it off
     if (movement_state.light_ticks == 0) {
+        uint32_t now_ts = watch_utility_date_time_to_unix_time(watch_rtc_get_date_time(), 0);
         // unless the user is holding down the LIGHT button, in which case, give them more time.
         if (watch_get_pin_level(BTN_LIGHT)) {
             movement_state.light_ticks = 1;
+            watch_rtc_schedule_timer(&light_timer, watch_utility_date_time_from_unix_time(now_ts + 1, 0), cb_light_timer);
         } else {
             watch_set_led_off();
             movement_state.light_ticks = -1;
-            _movement_disable_fast_tick_if_possible();
+            face_stats[movement_state.current_face_idx].led_ticks += (now_ts - movement_state.light_on_timestamp) * 128;
         }
     }
 
     // handle background tasks, if the alarm handler told us we need to
     if (movement_state.needs_background_tasks_handled) _movement_handle_background_tasks();
 
-    // if we have a scheduled background task, handle that here:
-    if (event.event_type == EVENT_TICK && movement_state.has_scheduled_background_task) _movement_handle_scheduled_tasks();
+    // hand any full watermark of accelerometer samples, and any sensor samples that are due, to whoever is listening.
+    // they share one trip to the I2C bus.
+    if (movement_sensors_needs_service()) movement_sensors_service();
+
+    // encode the next tones for a transmission over the buzzer, as the ones before them finish playing.
+    if (movement_chirpy_needs_service()) movement_chirpy_service();
+
+    // hand the face whatever has come in over the light sensor.
+    if (movement_optical_rx_needs_service()) movement_optical_rx_service();
+
+    // and any scheduled background task whose time has come.
+    if (movement_state.needs_scheduled_tasks_handled) _movement_handle_scheduled_tasks();
+
+    // the le_motion preference may have changed, or a face may have taken the accelerometer or given it back. that
+    // can wait for the first screen, since it probes the sensors.
+    if (!boot_setup_pending) _movement_update_motion_detection();
 
     // if we have timed out of our low energy mode countdown, enter low energy mode.
-    if (movement_state.le_mode_ticks == 0) {
+    // sleep mode turns off the buzzer, so let any tune finish first, and any job a face has posted.
+    if (movement_state.le_mode_ticks == 0 && !movement_state.is_buzzing && num_jobs == 0) {
+        _movement_end_preview();
+        // low energy mode only wakes for the minute and for scheduled tasks.
+        if (movement_state.tickless) _movement_end_tickless();
+        movement_kv_flush();
         movement_state.le_mode_ticks = -1;
+        low_energy_frames.count = 0;
+        low_energy_frames.next = 0;
+        #ifdef MOVEMENT_WAKE_ON_ANY_BUTTON
+        // any button wakes us at once, with the EIC's filter so that a knock against the case doesn't.
+        watch_register_button_wake_callback(cb_alarm_btn_extwake, true);
+        #else
         watch_register_extwake_callback(BTN_ALARM, cb_alarm_btn_extwake, true);
+        #endif
         event.event_type = EVENT_NONE;
         event.subsecond = 0;
+        _movement_clear_event_queue();
+        movement_state.needs_wake = false;
 
         // _sleep_mode_app_loop takes over at this point and loops until le_mode_ticks is reset by the extwake handler,
         // or wake is requested using the movement_request_wake function.
-        _sleep_mode_app_loop();
-        // as soon as _sleep_mode_app_loop returns, we prepare to reactivate
-        // ourselves, but first, we check to see if we woke up for the buzzer:
-        if (movement_state.is_buzzing) {
-            woke_up_for_buzzer = true;
+        if (!_sleep_mode_app_loop()) {
+            sleep_mode_waiting = true;
+            return true;
         }
-        event.event_type = EVENT_ACTIVATE;
-        // this is a hack tho: waking from sleep mode, app_setup does get called, but it happens before we have reset our ticks.
-        // need to figure out if there's a better heuristic for determining how we woke up.
-        app_setup();
+        // as soon as _sleep_mode_app_loop returns, we prepare to reactivate ourselves.
+        _movement_wake_from_sleep_mode();
     }
 
     // default to being allowed to sleep by the face.
     bool can_sleep = true;
 
     if (event.event_type) {
-        event.subsecond = movement_state.subsecond;
+        event.subsecond = _movement_face_subsecond(movement_state.subsecond);
         // the first trip through the loop overrides the can_sleep state
-        can_sleep = wf->loop(event, &movement_state.settings, watch_face_contexts[movement_state.current_face_idx]);
+        can_sleep = _movement_face_loop(movement_state.current_face_idx, event);
         event.event_type = EVENT_NONE;
+        _movement_end_preview();
+        _movement_record_latency();
+        _movement_mark_boot(MOVEMENT_BOOT_FIRST_SCREEN);
+    }
+
+    // with the face on screen drawn, set up whatever was left for after it.
+    _movement_finish_setup();
+
+    // then everything the interrupts have queued since last time. an event that changes the face leaves the rest
+    // waiting for the new face, once it has been activated. any face that can't sleep keeps us awake.
+    movement_event_t queued_event;
+    while (!movement_state.watch_face_changed && _movement_dequeue_event(&queued_event)) {
+        // a tick goes to everyone subscribed whose tick is due, and to the face on screen if its own is.
+        if (queued_event.event_type == EVENT_TICK) {
+            _movement_handle_background_ticks();
+            if (!_movement_face_tick_is_due()) continue;
+        }
+        // a press is timed from its first event the face sees; long presses come from a timer, not the button.
+        if (input_pending && queued_event.event_type >= EVENT_LIGHT_BUTTON_DOWN &&
+            queued_event.event_type <= EVENT_ALARM_LONG_UP && (queued_event.event_type - EVENT_LIGHT_BUTTON_DOWN) % 4 != 2) {
+            input_pending = false;
+            input_in_flight = true;
+        }
+        queued_event.subsecond = _movement_face_subsecond(queued_event.subsecond);
+        bool face_can_sleep = _movement_face_loop(movement_state.current_face_idx, queued_event);
+        can_sleep = can_sleep && face_can_sleep;
+        _movement_record_latency();
     }
 
     // if we have timed out of our timeout countdown, give the app a hint that they can resign.
@@ -553,7 +2063,7 @@ bool app_loop(void) {
             // if "timeout always" is false, give the current watch face a chance to exit gracefully...
             event.event_type = EVENT_TIMEOUT;
         }
-        event.subsecond = movement_state.subsecond;
+        event.subsecond = _movement_face_subsecond(movement_state.subsecond);
         // if we run through the loop again to time out, we need to reconsider whether or not we can sleep.
         // if the first trip said true, but this trip said false, we need the false to override, thus
         // we will be using boolean AND:
@@ -561,95 +2071,105 @@ bool app_loop(void) {
         // first trip  | can sleep | cannot sleep | can sleep    | cannot sleep
         // second trip | can sleep | cannot sleep | cannot sleep | can sleep
         //          && | can sleep | cannot sleep | cannot sleep | cannot sleep
-        bool can_sleep2 = wf->loop(event, &movement_state.settings, watch_face_contexts[movement_state.current_face_idx]);
+        bool can_sleep2 = _movement_face_loop(movement_state.current_face_idx, event);
         can_sleep = can_sleep && can_sleep2;
         event.event_type = EVENT_NONE;
-        if (movement_state.settings.bit.to_always && movement_state.current_face_idx != 0) {
+        if (movement_state.settings.bit.to_always && movement_state.current_face_idx != face_order[0]) {
             // ...but if the user has "timeout always" set, give it the boot.
             movement_move_to_face(0);
         }
     }
 
-    // Now that we've handled all display update tasks, handle the alarm.
-    if (movement_state.alarm_ticks >= 0) {
-        uint8_t buzzer_phase = (movement_state.alarm_ticks + 80) % 128;
-        if(buzzer_phase == 127) {
-            // failsafe: buzzer could have been disabled in the meantime
-            if (!watch_is_buzzer_or_led_enabled()) watch_enable_buzzer();
-            // play 4 beeps plus pause
-            for(uint8_t i = 0; i < 4; i++) {
-                // TODO: This method of playing the buzzer blocks the UI while it's beeping.
-                // It might be better to time it with the fast tick.
-                watch_buzzer_play_note(movement_state.alarm_note, (i != 3) ? 50 : 75);
-                if (i != 3) watch_buzzer_play_note(BUZZER_NOTE_REST, 50);
-            }
-        }
-        if (movement_state.alarm_ticks == 0) {
-            movement_state.alarm_ticks = -1;
-            _movement_disable_fast_tick_if_possible();
-        }
-    }
-
     // if we are plugged into USB, handle the serial shell
     if (watch_is_usb_enabled()) {
         shell_task();
+        watch_log_drain();
+        movement_freqcorr_usb_task();
+    }
+
+    // settings a face saved as it went only wait so long for it to resign.
+    movement_kv_flush_if_due();
+
+    // with the events handled, get on with any long computation, and keep at it until it's done.
+    if (num_jobs) {
+        _movement_run_jobs();
+        if (num_jobs) can_sleep = false;
     }
 
     event.subsecond = 0;
 
     // if the watch face changed, we can't sleep because we need to update the display.
     if (movement_state.watch_face_changed) can_sleep = false;
+    // nor if an interrupt queued something while we were busy, since it won't wake us again.
+    if (!_movement_event_queue_is_empty()) can_sleep = false;
 
-    // if we woke up for the buzzer, stay awake until it's finished.
-    if (woke_up_for_buzzer) {
-        while(watch_is_buzzer_or_led_enabled());
-    }
+    // in tickless mode, program the alarm for whatever deadline is now the nearest.
+    if (movement_state.tickless && movement_state.needs_next_wake_scheduled) _movement_schedule_next_wake();
+
+    // on the way to sleep, top up the entropy pool, so that a face drawing random numbers never waits on the TRNG.
+    if (can_sleep && watch_random_needs_refill()) watch_random_refill();
 
-    // if the LED is on, we need to stay awake to keep the TCC running.
-    if (movement_state.light_ticks != -1) can_sleep = false;
+    return can_sleep;
+}
+
+bool app_loop(void) {
+    watch_power_trace_region_t trace = watch_power_trace_set(WATCH_POWER_TRACE_APP_LOOP);
+#if __EMSCRIPTEN__
+    // outside of a face's own loop, the simulator's energy estimate charges whatever happens to the face on screen.
+    sim_energy_set_account(movement_state.current_face_idx);
+#endif
+    bool can_sleep = _movement_app_loop();
+    watch_power_trace_set(trace);
 
     return can_sleep;
 }
 
 static movement_event_type_t _figure_out_button_event(bool pin_level, movement_event_type_t button_down_event_type, uint16_t *down_timestamp) {
     // force alarm off if the user pressed a button.
-    if (movement_state.alarm_ticks) movement_state.alarm_ticks = 0;
+    if (movement_state.is_playing_alarm) _movement_stop_alarm();
 
+    uint8_t button = (button_down_event_type - EVENT_LIGHT_BUTTON_DOWN) / 4;
     if (pin_level) {
         // handle rising edge
-        _movement_enable_fast_tick_if_needed();
-        *down_timestamp = movement_state.fast_ticks + 1;
+        _movement_start_button_timing();
+        *down_timestamp = _movement_button_ticks() + 1;
+        if (movement_state.button_timer_running) {
+            movement_state.long_press_pending |= 1 << button;
+            _movement_arm_long_press();
+        }
         return button_down_event_type;
     } else {
-        // this line is hack but it handles the situation where the light button was held for more than 20 seconds.
-        // fast tick is disabled by then, and the LED would get stuck on since there's no one left decrementing light_ticks.
-        if (movement_state.light_ticks == 1) movement_state.light_ticks = 0;
-        // now that that's out of the way, handle falling edge
-        uint16_t diff = movement_state.fast_ticks - *down_timestamp;
+        // handle falling edge
+        uint16_t diff = _movement_button_ticks() - *down_timestamp;
         *down_timestamp = 0;
-        _movement_disable_fast_tick_if_possible();
+        movement_state.long_press_pending &= ~(1 << button);
+        _movement_stop_button_timing_if_possible();
+        if (movement_state.button_timer_running) _movement_arm_long_press();
         // any press over a half second is considered a long press. Fire the long-up event
         if (diff > MOVEMENT_LONG_PRESS_TICKS) return button_down_event_type + 3;
         else return button_down_event_type + 1;
     }
 }
 
-void cb_light_btn_interrupt(void) {
+WATCH_RAMFUNC void cb_light_btn_interrupt(void) {
+    _movement_stamp_input();
     bool pin_level = watch_get_pin_level(BTN_LIGHT);
     _movement_reset_inactivity_countdown();
-    event.event_type = _figure_out_button_event(pin_level, EVENT_LIGHT_BUTTON_DOWN, &movement_state.light_down_timestamp);
+    _movement_queue_event(_figure_out_button_event(pin_level, EVENT_LIGHT_BUTTON_DOWN, &movement_state.light_down_timestamp));
 }
 
-void cb_mode_btn_interrupt(void) {
+WATCH_RAMFUNC void cb_mode_btn_interrupt(void) {
+    _movement_stamp_input();
     bool pin_level = watch_get_pin_level(BTN_MODE);
     _movement_reset_inactivity_countdown();
-    event.event_type = _figure_out_button_event(pin_level, EVENT_MODE_BUTTON_DOWN, &movement_state.mode_down_timestamp);
+    _movement_queue_event(_figure_out_button_event(pin_level, EVENT_MODE_BUTTON_DOWN, &movement_state.mode_down_timestamp));
 }
 
-void cb_alarm_btn_interrupt(void) {
+WATCH_RAMFUNC void cb_alarm_btn_interrupt(void) {
+    _movement_stamp_input();
     bool pin_level = watch_get_pin_level(BTN_ALARM);
     _movement_reset_inactivity_countdown();
-    event.event_type = _figure_out_button_event(pin_level, EVENT_ALARM_BUTTON_DOWN, &movement_state.alarm_down_timestamp);
+    _movement_queue_event(_figure_out_button_event(pin_level, EVENT_ALARM_BUTTON_DOWN, &movement_state.alarm_down_timestamp));
 }
 
 void cb_alarm_btn_extwake(void) {
@@ -657,27 +2177,61 @@ void cb_alarm_btn_extwake(void) {
     _movement_reset_inactivity_countdown();
 }
 
-void cb_alarm_fired(void) {
+void cb_minute_timer(void) {
+    // in low energy mode, put the face's next minute up if it drew one, so that the loop needn't wake the face.
+    uint8_t next = low_energy_frames.next;
+    if (movement_state.le_mode_ticks == -1 && next < low_energy_frames.count) {
+        if (watch_utility_date_time_to_unix_time(minute_timer.deadline, 0) == low_energy_frames.first_minute + 60 * next) {
+            memcpy(watch_display_framebuffer, low_energy_frames.frames[next].segments, sizeof(watch_display_framebuffer));
+            watch_display_commit();
+            low_energy_frames.next = next + 1;
+        } else {
+            // the clock was set; the face will have to draw what's on now.
+            low_energy_frames.count = 0;
+            low_energy_frames.next = 0;
+        }
+    }
     movement_state.needs_background_tasks_handled = true;
+    _movement_schedule_minute_timer();
+}
+
+void cb_scheduled_task_timer(void) {
+    movement_state.needs_scheduled_tasks_handled = true;
 }
 
-void cb_fast_tick(void) {
+void cb_next_wake_timer(void) {
+    movement_state.needs_tickless_wake_handled = true;
+}
+
+void cb_light_timer(void) {
+    movement_state.light_ticks = 0;
+}
+
+void cb_long_press(void) {
+    uint16_t now = _movement_button_ticks();
+    for(uint8_t i = 0; i < 3; i++) {
+        if ((movement_state.long_press_pending & (1 << i)) &&
+            (uint16_t)(now - *movement_button_down_timestamps[i]) >= MOVEMENT_LONG_PRESS_TICKS + 1) {
+            movement_state.long_press_pending &= ~(1 << i);
+            _movement_queue_event(EVENT_LIGHT_LONG_PRESS + 4 * i);
+        }
+    }
+    _movement_arm_long_press();
+}
+
+WATCH_RAMFUNC void cb_fast_tick(void) {
     movement_state.fast_ticks++;
-    if (movement_state.light_ticks > 0) movement_state.light_ticks--;
-    if (movement_state.alarm_ticks > 0) movement_state.alarm_ticks--;
-    // check timestamps and auto-fire the long-press events
-    // Notice: is it possible that two or more buttons have an identical timestamp? In this case
-    // only one of these buttons would receive the long press event. Don't bother for now...
+    // check timestamps and auto-fire the long-press events; buttons held down together each get their own.
     if (movement_state.light_down_timestamp > 0)
         if (movement_state.fast_ticks - movement_state.light_down_timestamp == MOVEMENT_LONG_PRESS_TICKS + 1)
-            event.event_type = EVENT_LIGHT_LONG_PRESS;
+            _movement_queue_event(EVENT_LIGHT_LONG_PRESS);
     if (movement_state.mode_down_timestamp > 0)
         if (movement_state.fast_ticks - movement_state.mode_down_timestamp == MOVEMENT_LONG_PRESS_TICKS + 1)
-            event.event_type = EVENT_MODE_LONG_PRESS;
+            _movement_queue_event(EVENT_MODE_LONG_PRESS);
     if (movement_state.alarm_down_timestamp > 0)
         if (movement_state.fast_ticks - movement_state.alarm_down_timestamp == MOVEMENT_LONG_PRESS_TICKS + 1)
-            event.event_type = EVENT_ALARM_LONG_PRESS;
-    // this is just a fail-safe; fast tick should be disabled as soon as the button is up, the LED times out, and/or the alarm finishes.
+            _movement_queue_event(EVENT_ALARM_LONG_PRESS);
+    // this is just a fail-safe; fast tick should be disabled as soon as the buttons are up.
     // but if for whatever reason it isn't, this forces the fast tick off after 20 seconds.
     if (movement_state.fast_ticks >= 128 * 20) {
         watch_rtc_disable_periodic_callback(128);
@@ -685,17 +2239,28 @@ void cb_fast_tick(void) {
     }
 }
 
-void cb_tick(void) {
-    event.event_type = EVENT_TICK;
-    watch_date_time date_time = watch_rtc_get_date_time();
-    if (date_time.unit.second != movement_state.last_second) {
-        // TODO: can we consolidate these two ticks?
+WATCH_RAMFUNC void cb_second(void) {
+    // both countdowns are in seconds, so this is the one place they tick down; in tickless mode a subscriber can keep
+    // us ticking, but the countdowns are kept against the clock (@see _movement_update_tickless_countdowns).
+    if (!movement_state.tickless) {
         if (movement_state.settings.bit.le_interval && movement_state.le_mode_ticks > 0) movement_state.le_mode_ticks--;
         if (movement_state.timeout_ticks > 0) movement_state.timeout_ticks--;
+    }
+
+    movement_state.is_second_boundary = true;
+}
 
-        movement_state.last_second = date_time.unit.second;
+WATCH_RAMFUNC void cb_tick(void) {
+    // at 1 Hz every tick is a second boundary; otherwise cb_second has flagged it for us. no need to read the RTC.
+    if (movement_state.tick_frequency == 1) cb_second();
+    if (movement_state.is_second_boundary) {
+        movement_state.is_second_boundary = false;
         movement_state.subsecond = 0;
-    } else {
-        movement_state.subsecond++;
+        movement_state.tick_seconds++;
+    } else if (++movement_state.subsecond >= movement_state.tick_frequency) {
+        // in case the two interrupts ever drift apart, never count past a full second.
+        movement_state.subsecond = 0;
+        movement_state.tick_seconds++;
     }
+    _movement_queue_event(EVENT_TICK);
 }
@@ -36,8 +36,8 @@
 //   RTC's first backup register (BKUP[0]).
 // * The movement_location_t and movement_birthdate_t types are defined here, and are tentatively meant to be
 //   stored in BKUP[1] and BKUP[2], respectively.
-// * The movement_reserved_t type is here as a placeholder, because I sense there's some other generally useful
-//   stuff we'll want to make available to all watch faces and stash in the BKUP[3] register.
+// * BKUP[3] records which face owns each of BKUP[4] to BKUP[7] (@see movement_claim_backup_register), and which of
+//   them hold the state snapshot (@see movement_backup.h).
 // This allows these preferences to be stored before entering BACKUP mode and and restored after waking from reset.
 
 // movement_settings_t contains global settings that cover watch behavior, including preferences around clock and unit
@@ -62,7 +62,10 @@ typedef union {
         bool clock_mode_24h : 1;            // indicates whether clock should use 12 or 24 hour mode.
         bool use_imperial_units : 1;        // indicates whether to use metric units (the default) or imperial.
         bool alarm_enabled : 1;             // indicates whether there is at least one alarm enabled.
-        uint8_t reserved : 6;               // room for more preferences if needed.
+        bool le_motion : 1;                 // if true, low energy mode also follows the accelerometer: it comes on soon after the watch is set down, and ends when it's picked up.
+        bool daylight_saving : 1;           // if true, time zones follow daylight saving time where it's kept, and the clock changes itself.
+        uint8_t night_mode : 3;             // 0 to keep the display on in low energy mode, or a choice of quiet hours for turning it off (@see movement_night_hours).
+        uint8_t reserved : 1;               // room for more preferences if needed.
     } bit;
     uint32_t reg;
 } movement_settings_t;
@@ -93,14 +96,6 @@ typedef union {
     uint32_t reg;
 } movement_birthdate_t;
 
-// movement_reserved_t is a placeholder for future use of the BKUP[3] register.
-typedef union {
-    struct {
-        uint32_t reserved : 32;
-    } bit;
-    uint32_t reg;
-} movement_reserved_t;
-
 typedef enum {
     EVENT_NONE = 0,             // There is no event to report.
     EVENT_ACTIVATE,             // Your watch face is entering the foreground.
@@ -120,6 +115,14 @@ typedef enum {
     EVENT_ALARM_BUTTON_UP,      // The alarm button was pressed for less than half a second, and released.
     EVENT_ALARM_LONG_PRESS,     // The alarm button was held for over half a second, but not yet released.
     EVENT_ALARM_LONG_UP,        // The alarm button was held for over half a second, and released.
+    EVENT_ANIMATION_DONE,       // An animation your watch face started with movement_play_animation or movement_play_frames has finished.
+    EVENT_UART_DATA,            // Bytes have arrived on the UART your watch face opened with movement_enable_uart; read them with watch_uart_read.
+    EVENT_LOW_BATTERY,          // The battery has fallen below MOVEMENT_LOW_BATTERY_VOLTAGE. Your watch face gets this only if it's on screen at the time.
+    EVENT_RESUME,               // Something a coroutine was waiting on has happened (@see movement_coroutine.h); run it again.
+    EVENT_TAP,                  // The case was tapped. Your watch face gets this, and the three below, only if it asked for them with movement_request_gestures.
+    EVENT_DOUBLE_TAP,           // The case was tapped twice in quick succession.
+    EVENT_ORIENTATION,          // A different side of the watch now faces up; movement_accelerometer_get_orientation says which.
+    EVENT_FREE_FALL,            // The watch is falling.
 } movement_event_type_t;
 
 typedef struct {
@@ -138,7 +141,9 @@ extern const char movement_valid_position_1_chars[];
   *          need to keep track of any state in your watch face. If your watch face requires any other setup,
   *          like configuring a pin mode or a peripheral, you may want to do that here too.
   *          This function will be called again after waking from sleep mode, since sleep mode disables all
-  *          of the device's pins and peripherals.
+  *          of the device's pins and peripherals. Unless your face has a background task or sets
+  *          MOVEMENT_FACE_EAGER_SETUP, Movement waits to call it until the face is about to be activated or
+  *          handed an event, both at boot and after each wake.
   * @param settings A pointer to the global Movement settings. You can use this to inform how you present your
   *                 display to the user (i.e. taking into account whether they have silenced the buttons, or if
   *                 they prefer 12 or 24-hour mode). You can also change these settings if you like.
@@ -148,7 +153,8 @@ extern const char movement_valid_position_1_chars[];
   * @param context_ptr A pointer to a pointer; at first invocation, this value will be NULL, and you can set it
   *                    to any value you like. Subsequent invocations will pass in whatever value you previously
   *                    set. You may want to check if this is NULL and if so, allocate some space to store any
-  *                    data required for your watch face.
+  *                    data required for your watch face: give its size as the context_size in your watch_face_t,
+  *                    and claim it here with movement_claim_face_context.
   *
   */
 typedef void (*watch_face_setup)(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
@@ -159,6 +165,10 @@ typedef void (*watch_face_setup)(movement_settings_t *settings, uint8_t watch_fa
   *          watch face depends on data from a peripheral (like an I2C sensor), you will likely want to enable
   *          that peripheral here. In addition, if your watch face requires an update frequncy other than 1 Hz,
   *          you may want to request that here using the movement_request_tick_frequency function.
+  *
+  *          You start from a clear display. If your face has been on screen before, though, the glass goes on
+  *          showing what it showed when it last resigned until your loop has handled EVENT_ACTIVATE, and only
+  *          then shows what you've drawn; so the switch looks instant even if activating takes a while.
   * @param settings A pointer to the global Movement settings. @see watch_face_setup.
   * @param context A pointer to your watch face's context. @see watch_face_setup.
   *
@@ -231,14 +241,94 @@ typedef void (*watch_face_resign)(movement_settings_t *settings, void *context);
   */
 typedef bool (*watch_face_wants_background_task)(movement_settings_t *settings, void *context);
 
+/** @brief OPTIONAL. Draw the display for a minute ahead of time, for low energy mode.
+  * @details In low energy mode, Movement usually wakes your face at the top of every minute with
+  *          EVENT_LOW_ENERGY_UPDATE. If what your face shows then depends only on the time, give this function
+  *          as well, and Movement will have it draw the next MOVEMENT_LOW_ENERGY_FRAMES minutes in one go, right
+  *          after the first EVENT_LOW_ENERGY_UPDATE and again as they run out. It puts each one up from the minute
+  *          interrupt, without calling your face at all.
+  *
+  *          Draw with the usual display functions; Movement holds the display while you do, and keeps what you
+  *          draw for later. Each minute starts from what you drew for the one before, just as each
+  *          EVENT_LOW_ENERGY_UPDATE does. Only draw: don't start or stop animations or blinks, read sensors, or
+  *          rely on movement_get_local_date_time, which is still the time now.
+  * @param settings A pointer to the global Movement settings. @see watch_face_setup.
+  * @param context A pointer to your application's context. @see watch_face_setup.
+  * @param date_time The minute to draw, in local time, with its seconds at 0.
+  * @return true if you drew it; false if that minute needs EVENT_LOW_ENERGY_UPDATE after all, in which case
+  *         Movement stops there and goes back to waking your face.
+  */
+typedef bool (*watch_face_draw_low_energy)(movement_settings_t *settings, void *context, watch_date_time date_time);
+
 typedef struct {
     watch_face_setup setup;
     watch_face_activate activate;
     watch_face_loop loop;
     watch_face_resign resign;
     watch_face_wants_background_task wants_background_task;
+    // OPTIONAL. the size of the face's context, which Movement sets aside for it at boot (@see movement_claim_face_context).
+    size_t context_size;
+    // OPTIONAL. any of the MOVEMENT_FACE_ flags below.
+    uint8_t flags;
+    // OPTIONAL. draws low energy mode's minutes ahead of time (@see watch_face_draw_low_energy).
+    watch_face_draw_low_energy draw_low_energy;
 } watch_face_t;
 
+/// @brief Have Movement call the face's setup at boot and on every wake, as if it had a background task, as soon as
+///        the face on screen has drawn itself. Other faces are set up only when they're first activated or handed an
+///        event, so that boot and wake take time in proportion to the faces in use. A face needs this if its setup
+///        does anything beyond preparing its own context and peripherals; claiming a backup register, say, which has
+///        to happen in the same order every boot.
+#define MOVEMENT_FACE_EAGER_SETUP   (1 << 0)
+/// @brief Let Movement keep the face's context in a file while the face isn't in use, so that all the faces with this
+///        flag share one piece of RAM, the size of the biggest of their contexts. Movement brings the context back
+///        before it calls the face (or runs a job it posted), and writes it out, if it changed, when another
+///        hibernating face needs the RAM: a file read each time you come back to the face after visiting another
+///        one like it. For faces with a context_size and no background task, whose context is plain data that only
+///        the face itself looks at, through the pointer Movement hands it: no pointers into it kept anywhere else,
+///        and nothing in it that has to survive a reset any more than the context itself does.
+#define MOVEMENT_FACE_HIBERNATE     (1 << 1)
+
+// where the faces' contexts came from, for the shell's mem command.
+typedef struct {
+    uint16_t arena_size;            // bytes in the context arena (@see MOVEMENT_CONTEXT_ARENA_SIZE)
+    uint16_t arena_used;            // bytes set aside in it at boot, for the faces that gave a context_size
+    uint16_t heap_contexts;         // contexts that had to come from the heap instead
+    uint16_t heap_context_bytes;    // and the bytes they take up there
+    uint16_t hibernating_faces;     // faces with MOVEMENT_FACE_HIBERNATE, whose contexts share one slot in the arena
+    uint16_t hibernation_slot_size; // and the bytes of the arena that slot takes up
+} movement_context_stats_t;
+
+// the steps of starting up, in order, for the shell's boot command.
+typedef enum {
+    MOVEMENT_BOOT_APP_INIT = 0,     // app_init begins
+    MOVEMENT_BOOT_STORAGE,          // the filesystem is mounted and the key-value store read, for the face order
+    MOVEMENT_BOOT_APP_SETUP,        // app_setup begins, once the watch library has set up the RTC
+    MOVEMENT_BOOT_FACE_ACTIVATED,   // the face on screen has been set up and activated
+    MOVEMENT_BOOT_FIRST_SCREEN,     // and has handled its EVENT_ACTIVATE, drawing the first screen
+    MOVEMENT_BOOT_READY,            // the setup left until after the first screen is done
+    MOVEMENT_NUM_BOOT_PHASES
+} movement_boot_phase_t;
+
+// what each watch face costs, for the shell's stats command.
+typedef struct {
+    uint32_t loop_calls;            // number of calls to the face's loop, foreground or background
+    uint32_t active_cycles;         // CPU cycles spent in those calls (@see watch_get_cycle_counter)
+    uint32_t background_cycles;     // the part of active_cycles spent on background tasks
+    uint32_t led_ticks;             // time the LED was on while the face was active, in 1/128 second
+    uint32_t buzzer_ticks;          // length of the tunes played while the face was active, in 1/64 second
+} movement_face_stats_t;
+
+// how long button presses took to reach the display on each watch face, for the shell's latency command.
+#define MOVEMENT_LATENCY_BUCKETS 8
+typedef struct {
+    uint16_t counts[MOVEMENT_LATENCY_BUCKETS];  // presses under each of movement_latency_limits, and the rest in the last
+    uint16_t worst;                             // the longest, in 1/10 ms
+} movement_latency_stats_t;
+
+// the upper bound of each latency bucket but the last, in milliseconds.
+extern const uint16_t movement_latency_limits[MOVEMENT_LATENCY_BUCKETS - 1];
+
 typedef struct {
     // properties stored in BACKUP register
     movement_settings_t settings;
@@ -251,20 +341,23 @@ typedef struct {
     int16_t fast_ticks;
 
     // LED stuff
-    int16_t light_ticks;
+    int16_t light_ticks;                // 1 while the LED is lit, 0 when its time is up, -1 once it's off
+    uint32_t light_on_timestamp;        // unix time the LED came on, for the face stats
 
     // alarm stuff
-    int16_t alarm_ticks;
     bool is_buzzing;
-    BuzzerNote alarm_note;
+    bool is_playing_alarm;
 
     // button tracking for long press
     uint16_t light_down_timestamp;
     uint16_t mode_down_timestamp;
     uint16_t alarm_down_timestamp;
+    bool button_timer_running;          // presses are timed by the watch library's button timer, not the fast tick
+    uint8_t long_press_pending;         // buttons held that haven't had their long press yet, by bit: light, mode, alarm
 
     // background task handling
     bool needs_background_tasks_handled;
+    bool needs_scheduled_tasks_handled;
     bool has_scheduled_background_task;
     bool needs_wake;
 
@@ -275,23 +368,180 @@ typedef struct {
     int16_t timeout_ticks;
 
     // stuff for subsecond tracking
-    uint8_t tick_frequency;
-    uint8_t last_second;
-    uint8_t subsecond;
-
-    // backup register stuff
-    uint8_t next_available_backup_register;
+    uint8_t tick_frequency;             // the rate the RTC ticks at: the fastest any face asked for (0 if none did)
+    uint8_t face_tick_frequency;        // the rate the face on screen asked for, which tick_frequency is a multiple of
+    bool is_second_boundary;
+    uint8_t subsecond;                  // ticks into this second, at tick_frequency
+    uint16_t tick_seconds;              // seconds ticked through, so that each face can tell when its next tick is due
+    uint16_t face_tick_position;        // where the face on screen last got a tick (@see _movement_tick_position)
+
+    // tickless operation: instead of a periodic tick, an RTC timer is set for the next real deadline
+    bool tickless;
+    bool needs_tickless_wake_handled;
+    bool needs_next_wake_scheduled;
+    watch_date_time next_tick;          // when the active face wants its next EVENT_TICK (0 if it has been delivered)
+    uint32_t countdown_timestamp;       // unix time the LE and timeout countdowns were last brought up to date (0 to restart)
+
+    // the date and time as of this wake (@see movement_get_local_date_time)
+    watch_date_time date_time;
+    watch_date_time utc_date_time;
+    bool has_date_time;
+    bool has_utc_date_time;
+
+    // whether a face asked for the fast clock (@see movement_request_performance)
+    bool high_performance;
 } movement_state_t;
 
+/** @brief Returns the settings, for code that isn't a watch face (faces are handed them in each call). After changing
+  *        them, store them with `watch_store_backup_data(settings->reg, 0)`, as a face would.
+  */
+movement_settings_t *movement_get_settings(void);
+
+/** @brief Switches to a face. Face 0 means the first face in the order MODE steps through, wherever face 0 of
+  *        watch_faces is; so does a face that's been left out of the order (@see movement_set_face_order).
+  */
 void movement_move_to_face(uint8_t watch_face_index);
 void movement_move_to_next_face(void);
 
+/** @brief Sets which of the faces compiled into watch_faces are used, and the order MODE steps through them in.
+  * @details The order is kept in the key/value store under "faces" and read back at boot, so a watch can be given a
+  *          different set of faces without reflashing it. Faces keep their index in watch_faces, and with it their
+  *          settings, whatever their place in the order. A face that's left out is never shown, isn't set up or
+  *          polled for background tasks, and has its scheduled task and tick subscription cancelled. The first face
+  *          in the order is the one the watch starts on and returns to. MOVEMENT_SECONDARY_FACE_INDEX still names a
+  *          face in watch_faces; the faces from its place in the order onward are the secondary ones.
+  * @param watch_face_indexes Indexes into watch_faces, in the order to show them. Each may appear only once.
+  * @param count How many there are, or 0 to go back to the order of watch_faces.
+  * @return true if the order was applied and stored; false if it named a face that doesn't exist, or one twice.
+  */
+bool movement_set_face_order(const uint8_t *watch_face_indexes, uint8_t count);
+
+/** @brief Returns the faces in the order MODE steps through them, as indexes into watch_faces.
+  * @param count Set to how many faces are in the order.
+  */
+const uint8_t *movement_get_face_order(uint8_t *count);
+
 bool movement_default_loop_handler(movement_event_t event, movement_settings_t *settings);
 
 void movement_illuminate_led(void);
 
+/** @brief Asks for an EVENT_TICK this many times a second while your face is on screen.
+  * @details The rate must be a power of two from 1 to 64 Hz; anything else gets 1 Hz. The RTC ticks at the fastest
+  *          rate that the face on screen or any subscriber (@see movement_subscribe_ticks) has asked for, and each of
+  *          them gets only the ticks that fall at its own rate, with event.subsecond counted at that rate. Movement
+  *          goes back to 1 Hz whenever a new face comes on screen, so there's no need to do it in your resign.
+  * @param freq The number of ticks per second.
+  */
 void movement_request_tick_frequency(uint8_t freq);
 
+/** @brief Subscribes a face to ticks while it's off screen, for timing that has to carry on behind another face.
+  * @details Movement calls the face's loop with EVENT_BACKGROUND_TASK at the rate asked for, whichever face is on
+  *          screen, and the tick runs at least that fast until the subscription ends. While the subscribed face is on
+  *          screen itself, it gets EVENT_TICK at the rate it asked for with movement_request_tick_frequency instead.
+  *          Subscriptions last until the face ends them, but not through low energy mode, which stops every tick.
+  * @param watch_face_index The face to deliver the ticks to.
+  * @param freq The number of ticks per second, a power of two from 1 to 64 Hz; 0 ends the subscription, and the tick
+  *             drops back to whatever the rest still need.
+  */
+void movement_subscribe_ticks(uint8_t watch_face_index, uint8_t freq);
+
+/** @brief Stops the periodic tick and asks Movement for a single EVENT_TICK at the given time.
+  * @details Watch faces that only change their display occasionally (once a minute, once an hour) can call this
+  *          instead of movement_request_tick_frequency. Until the requested time, Movement disables the 1 Hz tick
+  *          and sleeps until the earliest deadline it knows about: this tick, the top of the minute, a scheduled
+  *          background task, or the timeout and low energy countdowns. Each call replaces the previous request, so
+  *          call it again from your EVENT_TICK handler to schedule the tick after that. Calling
+  *          movement_request_tick_frequency returns to periodic ticks; Movement does this when your face resigns.
+  * @param date_time The time of the next tick, in the same local time as watch_rtc_get_date_time, or a date_time
+  *        with a reg of 0 for no tick at all until the face asks for one again.
+  */
+void movement_request_next_tick(watch_date_time date_time);
+
+/** @brief Plays a sequence of frames on some of the display's segments, with the display doing the work.
+  * @details For short animations that would otherwise need a fast tick to draw each frame. The SLCD steps through
+  *          the frames by itself (@see watch_start_display_animation), and your face gets EVENT_ANIMATION_DONE when
+  *          the last one has had its turn, with that frame left showing. Movement stops the animation, without the
+  *          event, when your face resigns.
+  * @param frames The frames, which must stay put while they play; a const array is best.
+  * @param num_frames How many frames there are.
+  * @param mask For each COM line, the segments the animation owns; the rest of the display is yours as usual.
+  * @param frame_duration How long each frame shows, in milliseconds.
+  * @param loops How many times to play the frames, or 0 to keep going (with no EVENT_ANIMATION_DONE).
+  */
+void movement_play_animation(const watch_display_frame_t *frames, uint8_t num_frames, const uint32_t mask[3],
+                             uint32_t frame_duration, uint8_t loops);
+
+/** @brief Puts a batch of whole-display frames up one after another, waking your face once per batch.
+  * @details For faces that redraw the whole display many times a second. Rather than asking for a fast tick, work
+  *          out the next WATCH_DISPLAY_PLAYBACK_MAX_FRAMES frames at once and hand them over; the DMA controller
+  *          copies each into the display in turn (@see watch_start_display_playback), and your face gets
+  *          EVENT_ANIMATION_DONE as the last one goes up. Call this again from there with the next batch, and it
+  *          follows on a frame later. Movement stops the playback, without the event, when your face resigns.
+  * @param frames The frames, which must stay put while they play; your face's context is a good place for them.
+  * @param num_frames How many frames there are, up to WATCH_DISPLAY_PLAYBACK_MAX_FRAMES.
+  * @param frame_duration How long each frame shows, in milliseconds.
+  */
+void movement_play_frames(const watch_display_frame_t *frames, uint8_t num_frames, uint32_t frame_duration);
+
+/** @brief Opens the UART, and has your face hear about incoming bytes as events.
+  * @details Bytes that arrive are kept in the UART's receive buffer, and your face gets an EVENT_UART_DATA when there
+  *          are some to read; however many come in before it gets to them, there's only ever one of these waiting, so
+  *          read everything watch_uart_available says is there. Write with watch_uart_write or watch_uart_puts, which
+  *          return without waiting for the bytes to go out. The watch sleeps as usual in between.
+  * @param tx_pin The pin to transmit on, A2 or A4, or 0 for none.
+  * @param rx_pin The pin to receive on, A1 to A4, or 0 for none.
+  * @param baud The baud rate, like 19200.
+  * @note The UART shares its SERCOM with SPI, so don't use them both at once; and its baud rate comes from the
+  *       core clock, so stay out of MOVEMENT_PERFORMANCE_HIGH while it's open. Call movement_disable_uart when your
+  *       face resigns.
+  */
+void movement_enable_uart(uint8_t tx_pin, uint8_t rx_pin, uint32_t baud);
+
+/** @brief Closes the UART opened with movement_enable_uart, once it's finished sending. */
+void movement_disable_uart(void);
+
+typedef enum {
+    MOVEMENT_PERFORMANCE_NORMAL = 0,
+    MOVEMENT_PERFORMANCE_HIGH,
+} movement_performance_t;
+
+/** @brief Speeds up the CPU for a burst of heavy computation, like an ephemeris or an HMAC.
+  * @details Call this with MOVEMENT_PERFORMANCE_HIGH just before the computation. Movement drops the clock back to
+  *          normal when your loop (or setup, or activate) function returns, so you don't have to, though you can
+  *          do it sooner with MOVEMENT_PERFORMANCE_NORMAL. While the clock is fast, I2C, SPI and the ADC run at the
+  *          wrong rates, so don't use them until you drop back. @see watch_set_performance_level
+  * @param level The performance level you need.
+  * @return true if the clock is now at the requested level. The faster clock isn't available while the LED or
+  *         buzzer is on; the computation still works, only slower.
+  */
+bool movement_request_performance(movement_performance_t level);
+
+/** @brief One step of a job posted with movement_post_job.
+  * @param context Whatever was posted with the job; keep the job's progress in here.
+  * @return true once the job is done, false to be called again.
+  */
+typedef bool (*movement_job_step_t)(void *context);
+
+/** @brief Hands Movement a long computation to run in slices, so that it doesn't hold up the buttons.
+  * @details Movement calls step over and over, after the events it has on hand and before it sleeps, until step
+  *          returns true. Each pass through its loop spends up to MOVEMENT_JOB_SLICE_CYCLES on jobs; any button press
+  *          or tick that came in meanwhile is handled before the next slice. The watch stays awake, and out of low
+  *          energy mode, until every job is done, so the work still finishes in the one wake. Keep each step short,
+  *          a few milliseconds at most, since a step is never cut off. It may call movement_request_performance;
+  *          Movement drops the clock back after each slice. A step runs outside your loop function, so if it draws,
+  *          it should check that your face is still the one on screen.
+  * @param watch_face_index The face the job is for, as passed to your setup function.
+  * @param step The function to call for each step.
+  * @param context Passed to each call of step.
+  * @return true if the job was posted; false if all MOVEMENT_NUM_JOB_SLOTS job slots are in use.
+  */
+bool movement_post_job(uint8_t watch_face_index, movement_job_step_t step, void *context);
+
+/** @brief Cancels the jobs a face has posted that haven't finished, e.g. in its resign function.
+  * @param watch_face_index The face whose jobs to cancel.
+  */
+void movement_cancel_jobs_for_face(uint8_t watch_face_index);
+
 // note: watch faces can only schedule a background task when in the foreground, since
 // movement will associate the scheduled task with the currently active face.
 void movement_schedule_background_task(watch_date_time date_time);
@@ -304,12 +554,235 @@ void movement_cancel_background_task(void);
 void movement_schedule_background_task_for_face(uint8_t watch_face_index, watch_date_time date_time);
 void movement_cancel_background_task_for_face(uint8_t watch_face_index);
 
+/** @brief Schedules a background task that doesn't have to run right on time.
+  * @details The task runs at date_time if the watch is awake then for something else, and otherwise as late as slack
+  *          seconds after it, or sooner if some other wake comes first. Waking the watch costs more than whatever a
+  *          task does once it's up, so a face that logs or polls something every few minutes should give what slack
+  *          it can, and its task will usually ride along on the minute tick instead of waking the watch on its own.
+  * @param watch_face_index The face the task is for.
+  * @param date_time When the task may run, in local time.
+  * @param slack How many seconds later than that it may run instead.
+  */
+void movement_schedule_background_task_for_face_with_slack(uint8_t watch_face_index, watch_date_time date_time, uint8_t slack);
+
+/** @brief Tells Movement whether to ask a watch face if it wants a background task at the top of each minute.
+  * @details Movement calls wants_background_task only for faces that are interested, which saves a function call
+  *          per face on every minute wake. All faces with a wants_background_task callback start out interested. If
+  *          your face knows it won't want a task for a while (say, its chime is turned off), it can opt out here,
+  *          and opt back in when that changes. Faces are set up again after waking from low energy mode, so your
+  *          setup function is a good place to restore this from your saved state.
+  * @param watch_face_index The index of the face, as passed to your setup function.
+  * @param interested true to be polled every minute; false to stop being polled.
+  */
+void movement_set_background_task_interest_for_face(uint8_t watch_face_index, bool interested);
+
 void movement_request_wake(void);
 
+/** @brief Queues a tick for the face on screen, from anywhere, including an interrupt handler.
+  * @details For a face that's waiting on a sensor with an interrupt line: its extint callback can call this to have
+  *          the face's loop run as soon as the interrupt fires, rather than at the next scheduled tick. If a tick is
+  *          already waiting to be handled, this one is folded into it.
+  */
+void movement_queue_tick(void);
+
+/** @brief Queues EVENT_RESUME for the face on screen, from anywhere, including an interrupt handler.
+  * @details For whatever finishes a wait a coroutine is in (@see movement_coroutine.h). If one is already waiting to
+  *          be handled, this one is folded into it.
+  */
+void movement_queue_resume(void);
+
+/** @brief Asks for EVENT_TAP, EVENT_DOUBLE_TAP, EVENT_ORIENTATION or EVENT_FREE_FALL while your face is on screen.
+  * @details The accelerometer's own gesture engines watch for these, so the MCU sleeps until one happens (@see
+  *          movement_accelerometer_detect_gestures). Call this from your activate function; Movement stops them when
+  *          your face resigns. The sensor draws more while it watches for taps, which need it to sample at 200 Hz.
+  * @param gestures Any of the MOVEMENT_GESTURE_ bits from movement_accelerometer.h, or 0 to stop.
+  * @return false if this watch's accelerometer can't raise its gesture interrupts, in which case no events come.
+  */
+bool movement_request_gestures(uint8_t gestures);
+
+/** @brief Returns the rate the face on screen gets EVENT_TICK at, as it asked with movement_request_tick_frequency,
+  *        or 0 if it's asked for its ticks one at a time.
+  */
+uint8_t movement_get_tick_frequency(void);
+
+/** @brief Returns the local date and time as of this wake of the watch.
+  * @details Movement reads the RTC once, the first time this is called after it wakes up, and hands out the same
+  *          value to every face and background task until the next wake. Use this instead of watch_rtc_get_date_time
+  *          in your loop and wants_background_task functions to avoid a synchronized register read per call. If your
+  *          face sets the time, or busy-waits and needs to know how long that took, read the RTC directly instead.
+  */
+watch_date_time movement_get_local_date_time(void);
+
+/** @brief Sets the local date and time.
+  * @details Use this rather than watch_rtc_set_date_time, so that Movement can move its once-a-minute wake to the
+  *          top of the new minute and stop handing out the time it read before the change.
+  * @param date_time The new local date and time.
+  */
+void movement_set_local_date_time(watch_date_time date_time);
+
+/** @brief Returns the same moment as movement_get_local_date_time, converted to UTC with the time zone setting.
+  * @details The conversion is done once per wake, however many faces ask for it.
+  */
+watch_date_time movement_get_utc_date_time(void);
+
+/** @brief Returns the offset from UTC that the clock is keeping, in minutes east. With the daylight_saving setting
+  *        off, this is movement_timezone_offsets[settings->bit.time_zone]; with it on, it's an hour more (or half
+  *        an hour, on Lord Howe Island) while daylight saving time is in effect. Use this rather than the table for
+  *        anything that converts the local time to UTC or back.
+  * @details With the setting on, Movement puts the clock forward and back itself, at the top of the minute the
+  *          change comes, so the time on the watch stays local time.
+  */
+int16_t movement_get_current_timezone_offset(void);
+
+/** @brief Returns the offset from UTC in effect right now in a time zone, in minutes east.
+  * @param zone An index into movement_timezone_offsets.
+  * @param daylight_saving Whether the zone follows daylight saving time where it's kept (@see movement_tz_get_offset).
+  *                        This is the caller's to choose: the wearer's own setting is only for the clock's zone.
+  */
+int16_t movement_get_timezone_offset(uint8_t zone, bool daylight_saving);
+
+/** @brief Returns the same moment as movement_get_local_date_time, in another time zone.
+  * @param zone An index into movement_timezone_offsets, as for movement_get_timezone_offset.
+  * @param daylight_saving As for movement_get_timezone_offset.
+  */
+watch_date_time movement_get_date_time_in_zone(uint8_t zone, bool daylight_saving);
+
+typedef struct {
+    uint32_t julian_day;    // the Julian day number, for counting the days between two dates
+    uint16_t day_of_year;   // 1 for January 1
+    uint8_t weekday;        // 1 for Monday to 7 for Sunday, as ISO 8601 numbers them
+    uint8_t week_number;    // 1 to 53, as watch_utility_get_weeknumber counts them
+    uint8_t days_in_month;
+    bool leap_year;
+} movement_calendar_t;
+
+/** @brief Returns what the calendar says about today's local date.
+  * @details Movement works these out the first time they're asked for after the local date changes, whether at
+  *          midnight or because the time or time zone was set, and hands the same ones to every face and background
+  *          task until it changes again, so checking the weekday every minute costs a comparison rather than a
+  *          calendar calculation. The pointer stays valid, but what it points to changes with the date, so read
+  *          what you need from it rather than keeping it.
+  */
+const movement_calendar_t *movement_get_calendar(void);
+
+/** @brief Plays a tune on the buzzer without blocking, waiting for any tune that is already playing.
+  * @details The tune is played by the buzzer sequencer (@see watch_buzzer_play_sequence), so the watch can stand
+  *          by between notes, and Movement will not return to low energy mode until it has finished. Up to four
+  *          tunes can wait their turn; beyond that, new tunes are dropped.
+  * @param tune A sequence of note and duration pairs, ending with a zero. It must stay in memory until it has been
+  *             played, so don't pass in a buffer on the stack.
+  */
+void movement_play_tune(int8_t *tune);
+
+/** @brief Plays a tune that's been compiled into periods and durations, waiting its turn like movement_play_tune.
+  * @details With next_notes, the tune is streamed a block at a time (@see watch_buzzer_stream_notes); the
+  *          data-over-sound service in movement_chirpy.h sends its tones this way.
+  * @param notes The notes, ending with a note of 0 ticks. Like a tune, they must stay in memory until played.
+  * @param next_notes Where the next block comes from when these notes run out, or NULL if they're the whole tune.
+  * @return true if the tune is playing or waiting its turn; false if too many tunes were waiting already.
+  */
+bool movement_play_notes(const watch_buzzer_note_t *notes, watch_buzzer_next_notes_t next_notes);
+
+/** @brief Cuts short the tune that's playing. Any tunes waiting their turn start playing.
+  */
+void movement_stop_tune(void);
+
 void movement_play_signal(void);
 void movement_play_alarm(void);
 void movement_play_alarm_beeps(uint8_t rounds, BuzzerNote alarm_note);
 
+/** @brief Claims one of the backup registers BKUP[4] to BKUP[7] for your face, to keep something in across a reset.
+  * @details Call this from your setup function. Your face gets the same register back after a reset or BACKUP mode,
+  *          whenever it's set up (@see movement_backup_claim_register). For state that's only needed across BACKUP
+  *          mode, movement_snapshot_save packs several faces' state into the registers nobody has claimed.
+  * @return A register from 4 to 7, or 0 if they're all taken.
+  */
 uint8_t movement_claim_backup_register(void);
 
+/** @brief Puts the watch in BACKUP mode, its lowest power mode, where only the RTC keeps running.
+  * @details The face on screen resigns first, so it can save what it needs to; then settings go to flash, and the
+  *          state snapshot (@see movement_snapshot_save) goes to the backup registers. Waking from BACKUP mode is a
+  *          reset, after which the watch starts on its first face, and faces get their snapshots back from their
+  *          setup. Only an external wake on A2 or A4 can wake the watch (@see watch_enter_backup_mode), so this
+  *          is for watches with a sensor board that can give one.
+  */
+void movement_enter_backup_mode(void);
+
+/** @brief Returns the energy accounting Movement keeps for a watch face, or NULL past the last face.
+  * @details Counts accumulate from boot or from the last call to movement_reset_face_stats. Cycle counts are
+  *          approximate: they cover only time spent in the face's loop, and undercount loops that call delay_ms.
+  */
+const movement_face_stats_t *movement_get_face_stats(uint8_t watch_face_index);
+/** @brief Returns a zeroed context for a watch face; call this from the face's setup, in place of malloc.
+  * @details At boot, Movement sets aside context_size bytes for each face that gives one in its watch_face_t,
+  *          aligned for any type, in a static arena of MOVEMENT_CONTEXT_ARENA_SIZE bytes (which a movement config
+  *          can set). That memory is counted against RAM when the firmware is linked, and doesn't fragment the
+  *          heap. A face whose context didn't fit, or that asks for more than it said, gets it from the heap.
+  * @param watch_face_index The index passed to the face's setup.
+  * @param size The size of the context.
+  * @return The context, or NULL if it came from the heap and the heap is full.
+  */
+void *movement_claim_face_context(uint8_t watch_face_index, size_t size);
+const movement_context_stats_t *movement_get_context_stats(void);
+
+/** @brief Returns when each step of starting up finished, in 1/WATCH_BOOT_TICKS_PER_SECOND second since the watch
+  *        began to start, indexed by movement_boot_phase_t; count is set to how many of the steps have finished.
+  * @details Faces with MOVEMENT_FACE_EAGER_SETUP, the RTC correction and the sensor probe all wait until after the
+  *          first screen, so that it comes up as soon as it can.
+  */
+const uint32_t *movement_get_boot_times(uint8_t *count);
+
+/** @brief Returns how long button presses took to show on a watch face, or NULL past the last face.
+  * @details Each press is timed from its interrupt to the end of the face's loop call that handled it, or, for a
+  *          press that changed faces, to the end of the new face's EVENT_ACTIVATE: faces draw straight to the
+  *          display, so that's when the press is on screen. Presses and releases are timed one at a time; long
+  *          presses, which come from a timer rather than the button, aren't. The time comes from
+  *          watch_get_cycle_counter, so a press that arrives while the watch is in standby is timed from when it woke.
+  */
+const movement_latency_stats_t *movement_get_latency_stats(uint8_t watch_face_index);
+
+/// @brief Starts the face stats over, along with the latency stats and the event queue's overflow count.
+void movement_reset_face_stats(void);
+
+/** @brief Returns how many button or tick events were dropped because the loop fell too far behind to queue them,
+  *        since boot or the last call to movement_reset_face_stats.
+  */
+uint32_t movement_get_event_queue_overflows(void);
+
+/** @brief Returns the battery voltage in millivolts, as of the last time anything read it (Movement reads it once a
+  *        day), or 0 if nothing has yet.
+  * @details Watch faces that show a low battery indicator should use this, or movement_battery_is_low, rather than
+  *          reading the ADC themselves: the brownout detector watches the battery between readings.
+  */
+uint16_t movement_get_battery_voltage(void);
+
+/// @brief Returns true if the battery has fallen below MOVEMENT_LOW_BATTERY_VOLTAGE.
+bool movement_battery_is_low(void);
+
+/** @brief How hard Movement is working to make a low battery last.
+  * @details Movement checks the battery at the top of each minute, and as it falls it gives up what it can:
+  *          - MOVEMENT_POWER_SAVING, below MOVEMENT_LOW_BATTERY_VOLTAGE: the LED shines for a second at most, hourly
+  *            chimes (movement_play_signal) are skipped, faces get one EVENT_TICK a second at most, and low energy
+  *            mode comes on after five minutes without a button press, if it's on at all.
+  *          - MOVEMENT_POWER_CRITICAL, below MOVEMENT_CRITICAL_BATTERY_VOLTAGE: all that, and the LED stays off, and
+  *            the watch stays on the first face (the clock) so that it keeps the time for as long as it can.
+  *          The clock faces show the LAP indicator at either level.
+  */
+typedef enum {
+    MOVEMENT_POWER_NORMAL = 0,
+    MOVEMENT_POWER_SAVING,
+    MOVEMENT_POWER_CRITICAL,
+} movement_power_level_t;
+
+movement_power_level_t movement_get_power_level(void);
+
+/** @brief The quiet hours for each night_mode setting, in local time: from the top of the first hour to the top of the
+  *        second, the display goes dark whenever the watch is in low energy mode.
+  * @details In any mode but 0, the display also goes dark while the activity classifier, if some face has it running,
+  *          says the watch is off the wrist or its wearer asleep (@see movement_activity_get); mode 1 has no hours,
+  *          and goes by that alone. The watch still wakes at the top of each minute for background tasks, but faces
+  *          aren't asked to draw, and the ALARM button or picking the watch up (with le_motion) wakes it as ever.
+  */
+extern const uint8_t movement_night_hours[8][2];
+
 #endif // MOVEMENT_H_
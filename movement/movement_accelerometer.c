@@ -0,0 +1,452 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stddef.h>
+#include "movement_accelerometer.h"
+#include "movement_sensors.h"
+#include "movement.h"
+#include "watch.h"
+#include "watch_utility.h"
+
+#if MOVEMENT_ACCELEROMETER_WATERMARK < 1 || MOVEMENT_ACCELEROMETER_WATERMARK > 31
+#error "MOVEMENT_ACCELEROMETER_WATERMARK must fit in the LIS2DW's five-bit FIFO threshold"
+#endif
+
+typedef struct {
+    movement_accelerometer_consumer_t callback;
+    void *context;
+    lis2dw_data_rate_t data_rate;
+} movement_accelerometer_consumer_slot_t;
+
+static movement_accelerometer_consumer_slot_t _consumers[MOVEMENT_ACCELEROMETER_MAX_CONSUMERS];
+static uint8_t _num_consumers;
+
+// the rate the sensor is running at; POWERDOWN when nobody is listening.
+static lis2dw_data_rate_t _data_rate = LIS2DW_DATA_RATE_POWERDOWN;
+static uint32_t _next_sample;
+static uint32_t _start_timestamp;
+static lis2dw_reading_t _readings[MOVEMENT_ACCELEROMETER_WATERMARK];
+
+// set from the extwake interrupt, cleared by the main loop.
+static volatile bool _needs_service;
+// the monotonic count at the last watermark interrupt, until a batch takes it. the counter runs while we stream.
+static volatile uint32_t _watermark_ticks;
+static bool _holds_monotonic;
+
+// whether the sensor is on and we hold the bus for it: while it streams, or watches for motion, or both.
+static bool _powered;
+static movement_accelerometer_motion_callback_t _motion_callback;
+static bool _stationary;
+// times the watch has started moving since movement_accelerometer_take_motion_count last looked, while counting.
+static bool _counting_motion;
+static uint16_t _motion_count;
+// the gestures the sensor's own engines are watching for, and which way up it was at the last orientation change.
+static uint8_t _gestures;
+static movement_accelerometer_gesture_callback_t _gesture_callback;
+static uint8_t _orientation;
+
+static void _movement_accelerometer_cb_interrupt(void) {
+    // read the count here rather than in the main loop, which may be a while getting to it.
+    if (_holds_monotonic) _watermark_ticks = watch_get_monotonic_ticks();
+    _needs_service = true;
+}
+
+// stationary detection runs for whoever wants to hear about motion, or count it.
+static bool _movement_accelerometer_watching(void) {
+    return _motion_callback != NULL || _counting_motion;
+}
+
+// the sensor's interrupt goes somewhere while anyone is watching for motion or for gestures.
+static bool _movement_accelerometer_listening(void) {
+    return _movement_accelerometer_watching() || _gestures;
+}
+
+// taps need 200 Hz or so to tell one from a bump; orientation and free fall are happy with 50.
+static lis2dw_data_rate_t _movement_accelerometer_gesture_rate(void) {
+    if (_gestures & (MOVEMENT_GESTURE_TAP | MOVEMENT_GESTURE_DOUBLE_TAP)) return LIS2DW_DATA_RATE_200_HZ;
+    if (_gestures) return LIS2DW_DATA_RATE_50_HZ;
+    return LIS2DW_DATA_RATE_POWERDOWN;
+}
+
+// roughly, in low power mode; close enough for counting samples.
+static uint16_t _movement_accelerometer_rate_hz(lis2dw_data_rate_t data_rate) {
+    static const uint16_t hz[] = { 0, 2, 12, 25, 50, 100, 200, 400, 800, 1600 };
+    return data_rate < sizeof(hz) / sizeof(hz[0]) ? hz[data_rate] : 1600;
+}
+
+static uint32_t _movement_accelerometer_now(void) {
+    return watch_utility_date_time_to_unix_time(movement_get_utc_date_time(), 0);
+}
+
+static void _movement_accelerometer_power_up(void) {
+    if (_powered) return;
+    // hold the bus for as long as the sensor runs, so that faces releasing it don't turn it off under us.
+    watch_claim_peripheral(WATCH_PERIPHERAL_I2C);
+    lis2dw_begin();
+    _powered = true;
+}
+
+static void _movement_accelerometer_power_down(void) {
+    watch_disable_extwake_interrupt(MOVEMENT_ACCELEROMETER_INT_PIN);
+    // a face that holds the sensor has set it up its own way by now; leave that alone.
+    if (!movement_sensors_is_held(MOVEMENT_SENSOR_DEVICE_LIS2DW)) {
+        lis2dw_begin_config();
+        lis2dw_set_data_rate(LIS2DW_DATA_RATE_POWERDOWN);
+        lis2dw_disable_interrupts();
+#if MOVEMENT_ACCELEROMETER_INT == 1
+        lis2dw_configure_int1(0);
+#else
+        lis2dw_configure_int2(0);
+#endif
+        lis2dw_disable_fifo();
+        lis2dw_disable_stationary_detection();
+        lis2dw_end_config();
+    }
+    _needs_service = false;
+    _powered = false;
+    // the claim _movement_accelerometer_power_up took.
+    watch_release_peripheral(WATCH_PERIPHERAL_I2C);
+}
+
+// points the sensor's interrupt at the pin: the watermark while it streams, or else the sleep change; and on INT1, any
+// gestures.
+static void _movement_accelerometer_route_interrupts(bool streaming) {
+#if MOVEMENT_ACCELEROMETER_INT == 1
+    uint8_t sources = streaming ? LIS2DW_CTRL4_INT1_FTH : 0;
+    if (_gestures & MOVEMENT_GESTURE_TAP) sources |= LIS2DW_CTRL4_INT1_SINGLE_TAP;
+    if (_gestures & MOVEMENT_GESTURE_DOUBLE_TAP) sources |= LIS2DW_CTRL4_INT1_TAP;
+    if (_gestures & MOVEMENT_GESTURE_ORIENTATION) sources |= LIS2DW_CTRL4_INT1_6D;
+    if (_gestures & MOVEMENT_GESTURE_FREE_FALL) sources |= LIS2DW_CTRL4_INT1_FF;
+    lis2dw_configure_int1(sources);
+#else
+    // the watermark gets the pin to itself; the batches come often enough to look for motion after each one.
+    lis2dw_configure_int2(streaming ? LIS2DW_CTRL5_INT2_FTH : LIS2DW_CTRL5_INT2_SLEEP_CHG);
+#endif
+}
+
+// sets up the gesture engines for what's wanted of them, at the rate the sensor is about to run at.
+static void _movement_accelerometer_set_up_gestures(lis2dw_data_rate_t data_rate) {
+    // at 200 Hz: a tap is a spike of up to 80 ms, followed by 20 ms of quiet, and a second within 800 ms of the first
+    // makes a double tap.
+    if (_gestures & (MOVEMENT_GESTURE_TAP | MOVEMENT_GESTURE_DOUBLE_TAP)) {
+        lis2dw_configure_tap(MOVEMENT_ACCELEROMETER_TAP_THRESHOLD, 0b01010110, _gestures & MOVEMENT_GESTURE_DOUBLE_TAP);
+    } else {
+        lis2dw_disable_tap();
+    }
+    if (_gestures & MOVEMENT_GESTURE_ORIENTATION) lis2dw_configure_6d(LIS2DW_6D_THRESHOLD_60_DEG, false);
+    else lis2dw_disable_6d();
+    if (_gestures & MOVEMENT_GESTURE_FREE_FALL) {
+        uint32_t samples = (uint32_t)MOVEMENT_ACCELEROMETER_FREE_FALL_MS * _movement_accelerometer_rate_hz(data_rate) / 1000;
+        lis2dw_configure_free_fall(LIS2DW_FREE_FALL_THRESHOLD_312_MG, samples < 1 ? 1 : samples > 63 ? 63 : samples);
+    } else {
+        lis2dw_disable_free_fall();
+    }
+    // each gesture raises the pin once, and it stays up until the service has read which one it was.
+    if (_gestures) lis2dw_set_interrupt_latch(true);
+}
+
+static void _movement_accelerometer_start_stream(void) {
+    lis2dw_set_range(LIS2DW_RANGE_4_G);
+    lis2dw_set_low_power_mode(LIS2DW_LP_MODE_2);
+    lis2dw_set_low_noise_mode(true);
+
+    // continuous mode overwrites the oldest samples if we fall behind, rather than stopping, so the stream survives a
+    // missed wake; the overrun flag tells us it happened.
+    lis2dw_set_fifo_mode(LIS2DW_FIFO_MODE_COLLECT_CONTINUOUS, MOVEMENT_ACCELEROMETER_WATERMARK);
+    lis2dw_enable_interrupts();
+
+    // the threshold interrupt is a level that stays high until the FIFO drops below the watermark, so the rising edge
+    // marks each new watermark.
+    watch_register_extwake_callback(MOVEMENT_ACCELEROMETER_INT_PIN, _movement_accelerometer_cb_interrupt, true);
+}
+
+static void _movement_accelerometer_start_motion_only(lis2dw_data_rate_t data_rate) {
+    // the lowest power the sensor has: 12-bit samples at 1.6 Hz, or as fast as the gestures need, with nothing in the
+    // FIFO.
+    lis2dw_disable_fifo();
+    lis2dw_set_range(LIS2DW_RANGE_2_G);
+    lis2dw_set_low_power_mode(LIS2DW_LP_MODE_1);
+    lis2dw_set_low_noise_mode(false);
+    lis2dw_set_mode(LIS2DW_MODE_LOW_POWER);
+    lis2dw_set_data_rate(data_rate);
+    lis2dw_enable_interrupts();
+    // the sleep change is latched, so the pin rises once per change and stays up until the service reads it; clear
+    // anything left over from before, or there would be no rising edge for the next one.
+    lis2dw_get_interrupt_source();
+    watch_register_extwake_callback(MOVEMENT_ACCELEROMETER_INT_PIN, _movement_accelerometer_cb_interrupt, true);
+}
+
+// sets the sensor up for whatever is wanted of it now: the fastest rate any consumer asked for, and motion detection
+// if someone is watching for it.
+static void _movement_accelerometer_configure(lis2dw_data_rate_t data_rate) {
+    // sleep may have turned the bus off since the sensor started; claiming it turns it back on.
+    watch_claim_peripheral(WATCH_PERIPHERAL_I2C);
+
+    if (data_rate == LIS2DW_DATA_RATE_POWERDOWN && !_movement_accelerometer_listening()) {
+        if (_powered) _movement_accelerometer_power_down();
+    } else {
+        bool was_powered = _powered;
+        _movement_accelerometer_power_up();
+        // the registers all change together, in a burst or two rather than a write apiece.
+        lis2dw_begin_config();
+        if (_movement_accelerometer_watching()) {
+            // the shortest sleep duration, 16 samples, is 10 seconds at 1.6 Hz; Movement times longer stillness itself.
+            lis2dw_configure_stationary_detection(MOVEMENT_ACCELEROMETER_MOTION_THRESHOLD, 0, true);
+        } else if (was_powered) {
+            lis2dw_disable_stationary_detection();
+        }
+        lis2dw_data_rate_t idle_rate = _gestures ? _movement_accelerometer_gesture_rate() : LIS2DW_DATA_RATE_LOWEST;
+        _movement_accelerometer_set_up_gestures(data_rate == LIS2DW_DATA_RATE_POWERDOWN ? idle_rate : data_rate);
+        _movement_accelerometer_route_interrupts(data_rate != LIS2DW_DATA_RATE_POWERDOWN);
+        if (data_rate == LIS2DW_DATA_RATE_POWERDOWN) {
+            _movement_accelerometer_start_motion_only(idle_rate);
+        } else {
+            if (_data_rate == LIS2DW_DATA_RATE_POWERDOWN) {
+                _movement_accelerometer_start_stream();
+            } else if (data_rate != _data_rate) {
+                // samples already in the FIFO were taken at the old rate; toss them so every batch has one rate.
+                // passing through bypass mode empties the FIFO.
+                lis2dw_set_fifo_mode(LIS2DW_FIFO_MODE_OFF, 0);
+                lis2dw_set_fifo_mode(LIS2DW_FIFO_MODE_COLLECT_CONTINUOUS, MOVEMENT_ACCELEROMETER_WATERMARK);
+            }
+            // turning motion detection on or off leaves the stream as it was.
+            if (data_rate != _data_rate) {
+                lis2dw_set_data_rate(data_rate);
+                _next_sample = 0;
+                _start_timestamp = _movement_accelerometer_now();
+            }
+        }
+        lis2dw_end_config();
+    }
+    _data_rate = data_rate;
+
+    // the monotonic counter times the watermarks, for as long as there are any.
+    bool streaming = data_rate != LIS2DW_DATA_RATE_POWERDOWN;
+    if (streaming != _holds_monotonic) {
+        if (streaming) watch_monotonic_start();
+        else watch_monotonic_stop();
+        _holds_monotonic = streaming;
+    }
+    _watermark_ticks = 0;
+    watch_release_peripheral(WATCH_PERIPHERAL_I2C);
+}
+
+// the rate to stream at: the fastest any consumer asked for, and no slower than the gestures need; or POWERDOWN.
+static lis2dw_data_rate_t _movement_accelerometer_stream_rate(void) {
+    lis2dw_data_rate_t data_rate = LIS2DW_DATA_RATE_POWERDOWN;
+    for (uint8_t i = 0; i < _num_consumers; i++) {
+        if (_consumers[i].data_rate > data_rate) data_rate = _consumers[i].data_rate;
+    }
+    if (data_rate != LIS2DW_DATA_RATE_POWERDOWN && data_rate < _movement_accelerometer_gesture_rate()) {
+        data_rate = _movement_accelerometer_gesture_rate();
+    }
+    return data_rate;
+}
+
+static void _movement_accelerometer_update_data_rate(void) {
+    lis2dw_data_rate_t data_rate = _movement_accelerometer_stream_rate();
+    if (data_rate == _data_rate) return;
+    _movement_accelerometer_configure(data_rate);
+}
+
+bool movement_accelerometer_subscribe(lis2dw_data_rate_t data_rate, movement_accelerometer_consumer_t consumer, void *context) {
+#if !WATCH_BOARD_HAS_SENSOR_CONNECTOR
+    // there's nowhere for an accelerometer to be.
+    return false;
+#endif
+    if (_num_consumers >= MOVEMENT_ACCELEROMETER_MAX_CONSUMERS || consumer == NULL) return false;
+
+    _consumers[_num_consumers].callback = consumer;
+    _consumers[_num_consumers].context = context;
+    _consumers[_num_consumers].data_rate = data_rate;
+    _num_consumers++;
+    // the bus may have been turned off since the sensor started. while the sensor runs, it stays on afterwards, since
+    // callers tend to adjust its settings right after this.
+    watch_claim_peripheral(WATCH_PERIPHERAL_I2C);
+    _movement_accelerometer_update_data_rate();
+    watch_release_peripheral(WATCH_PERIPHERAL_I2C);
+
+    return true;
+}
+
+void movement_accelerometer_unsubscribe(movement_accelerometer_consumer_t consumer, void *context) {
+    for (uint8_t i = 0; i < _num_consumers; i++) {
+        if (_consumers[i].callback == consumer && _consumers[i].context == context) {
+            _num_consumers--;
+            _consumers[i] = _consumers[_num_consumers];
+            break;
+        }
+    }
+    _movement_accelerometer_update_data_rate();
+}
+
+bool movement_accelerometer_is_streaming(void) {
+    return _data_rate != LIS2DW_DATA_RATE_POWERDOWN;
+}
+
+bool movement_accelerometer_get_latest(lis2dw_reading_t *reading) {
+    if (_data_rate == LIS2DW_DATA_RATE_POWERDOWN || _next_sample == 0) return false;
+    *reading = _readings[MOVEMENT_ACCELEROMETER_WATERMARK - 1];
+    return true;
+}
+
+bool movement_accelerometer_detect_motion(movement_accelerometer_motion_callback_t callback) {
+#if !WATCH_BOARD_HAS_SENSOR_CONNECTOR
+    if (callback != NULL) return false;
+#elif MOVEMENT_ACCELEROMETER_INT != 2
+    // the sleep change interrupt only goes to INT2.
+    if (callback != NULL) return false;
+#endif
+    if (callback == _motion_callback) return true;
+    bool was_watching = _movement_accelerometer_watching();
+    _motion_callback = callback;
+    if (!was_watching) _stationary = false;
+    // changing callbacks, or keeping on for the counter, needs nothing from the sensor.
+    if (was_watching == _movement_accelerometer_watching()) return true;
+    _movement_accelerometer_configure(_data_rate);
+    return true;
+}
+
+bool movement_accelerometer_count_motion(bool count) {
+#if !WATCH_BOARD_HAS_SENSOR_CONNECTOR
+    if (count) return false;
+#elif MOVEMENT_ACCELEROMETER_INT != 2
+    if (count) return false;
+#endif
+    if (count == _counting_motion) return true;
+    bool was_watching = _movement_accelerometer_watching();
+    _counting_motion = count;
+    _motion_count = 0;
+    if (!was_watching) _stationary = false;
+    if (was_watching == _movement_accelerometer_watching()) return true;
+    _movement_accelerometer_configure(_data_rate);
+    return true;
+}
+
+uint16_t movement_accelerometer_take_motion_count(void) {
+    uint16_t count = _motion_count;
+    _motion_count = 0;
+    return count;
+}
+
+bool movement_accelerometer_detect_gestures(uint8_t gestures, movement_accelerometer_gesture_callback_t callback) {
+#if !WATCH_BOARD_HAS_SENSOR_CONNECTOR
+    if (gestures) return false;
+#elif MOVEMENT_ACCELEROMETER_INT != 1
+    // the gesture interrupts only go to INT1.
+    if (gestures) return false;
+#endif
+    _gesture_callback = callback;
+    if (gestures == _gestures) return true;
+    _gestures = gestures;
+    _movement_accelerometer_configure(_movement_accelerometer_stream_rate());
+    return true;
+}
+
+uint8_t movement_accelerometer_get_orientation(void) {
+    return _orientation;
+}
+
+bool movement_accelerometer_is_detecting_motion(void) {
+    return _motion_callback != NULL;
+}
+
+bool movement_accelerometer_needs_service(void) {
+    return _needs_service;
+}
+
+static void _movement_accelerometer_report_gestures(uint8_t source) {
+    // callbacks may stop the gestures, so each is looked at as it comes.
+    if ((source & LIS2DW_INTERRUPT_SRC_FF) && (_gestures & MOVEMENT_GESTURE_FREE_FALL)) {
+        if (_gesture_callback != NULL) _gesture_callback(MOVEMENT_GESTURE_FREE_FALL);
+    }
+    if ((source & LIS2DW_INTERRUPT_SRC_6D) && (_gestures & MOVEMENT_GESTURE_ORIENTATION)) {
+        _orientation = lis2dw_get_orientation();
+        if (_gesture_callback != NULL) _gesture_callback(MOVEMENT_GESTURE_ORIENTATION);
+    }
+    if ((source & LIS2DW_INTERRUPT_SRC_SINGLE_TAP) && (_gestures & MOVEMENT_GESTURE_TAP)) {
+        if (_gesture_callback != NULL) _gesture_callback(MOVEMENT_GESTURE_TAP);
+    }
+    if ((source & LIS2DW_INTERRUPT_SRC_DOUBLE_TAP) && (_gestures & MOVEMENT_GESTURE_DOUBLE_TAP)) {
+        if (_gesture_callback != NULL) _gesture_callback(MOVEMENT_GESTURE_DOUBLE_TAP);
+    }
+}
+
+static void _movement_accelerometer_check_interrupts(void) {
+    // reading the source clears the latch, which brings the pin back down for the next change or gesture.
+    uint8_t source = lis2dw_get_interrupt_source();
+    if (_gestures) _movement_accelerometer_report_gestures(source);
+    if (!_movement_accelerometer_watching() || !_powered) return;
+    bool stationary = lis2dw_is_stationary();
+    if (stationary == _stationary) return;
+    _stationary = stationary;
+    if (!stationary && _counting_motion && _motion_count < UINT16_MAX) _motion_count++;
+    if (_motion_callback != NULL) _motion_callback(!stationary);
+}
+
+void movement_accelerometer_service(void) {
+    _needs_service = false;
+    if (!_powered) return;
+
+    // low energy mode turns the bus off while we sleep, so make sure it's on.
+    watch_claim_peripheral(WATCH_PERIPHERAL_I2C);
+
+    if (_data_rate == LIS2DW_DATA_RATE_POWERDOWN) {
+        if (_movement_accelerometer_listening()) _movement_accelerometer_check_interrupts();
+        watch_release_peripheral(WATCH_PERIPHERAL_I2C);
+        return;
+    }
+
+    movement_accelerometer_batch_t batch;
+    batch.readings = _readings;
+    batch.count = MOVEMENT_ACCELEROMETER_WATERMARK;
+    batch.data_rate = _data_rate;
+    batch.start_timestamp = _start_timestamp;
+    batch.timestamp = _movement_accelerometer_now();
+
+    // take exactly one watermark at a time, and keep going while there's a full one left: if we woke late, the
+    // interrupt line is still high, and it won't give us another rising edge until we've brought it back down.
+    uint8_t status;
+    while (((status = lis2dw_get_fifo_status()) & LIS2DW_FIFO_SAMPLE_COUNT) >= MOVEMENT_ACCELEROMETER_WATERMARK) {
+        lis2dw_read_fifo_samples(_readings, MOVEMENT_ACCELEROMETER_WATERMARK);
+        batch.first_sample = _next_sample;
+        batch.overrun = !!(status & LIS2DW_FIFO_SAMPLE_OVERRUN);
+        // only the first watermark read after the interrupt is the one it timed; the line stays high until the FIFO
+        // drops below the watermark, so any more that were waiting didn't interrupt.
+        batch.ticks = _watermark_ticks;
+        _watermark_ticks = 0;
+        _next_sample += MOVEMENT_ACCELEROMETER_WATERMARK;
+
+        // consumers may unsubscribe from their callbacks, which moves the last slot into theirs; walk backwards so
+        // that nobody is skipped or called twice.
+        for (uint8_t i = _num_consumers; i > 0; i--) {
+            if (i > _num_consumers) continue;
+            _consumers[i - 1].callback(&batch, _consumers[i - 1].context);
+        }
+        // a consumer that changed the rate (or turned the sensor off) also emptied the FIFO.
+        if (_data_rate != batch.data_rate) break;
+    }
+    if (_movement_accelerometer_listening() && _powered) _movement_accelerometer_check_interrupts();
+    watch_release_peripheral(WATCH_PERIPHERAL_I2C);
+}
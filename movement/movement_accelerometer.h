@@ -0,0 +1,189 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MOVEMENT_ACCELEROMETER_H_
+#define MOVEMENT_ACCELEROMETER_H_
+#include <stdint.h>
+#include <stdbool.h>
+#include "lis2dw.h"
+
+/** @brief The pin the LIS2DW's FIFO threshold and sleep change interrupts are wired to. It has to be an extwake pin
+  *        (A2 or A4), so that a watermark or a wrist raise can wake the watch from low energy mode.
+  */
+#ifndef MOVEMENT_ACCELEROMETER_INT_PIN
+#define MOVEMENT_ACCELEROMETER_INT_PIN A4
+#endif
+
+/** @brief Which of the LIS2DW's interrupt pins (1 or 2) is wired to MOVEMENT_ACCELEROMETER_INT_PIN. */
+#ifndef MOVEMENT_ACCELEROMETER_INT
+#define MOVEMENT_ACCELEROMETER_INT 2
+#endif
+
+/** @brief Samples per batch. The FIFO holds 32, so this leaves a few samples of slack for a late wake. */
+#ifndef MOVEMENT_ACCELEROMETER_WATERMARK
+#define MOVEMENT_ACCELEROMETER_WATERMARK 25
+#endif
+
+/** @brief How hard the watch has to move to count as moving, for movement_accelerometer_detect_motion: in 1/64ths of
+  *        the sensor's range, so 31 mg a count while it's only watching for motion (at ±2g), and 62 mg while it
+  *        streams at ±4g.
+  */
+#ifndef MOVEMENT_ACCELEROMETER_MOTION_THRESHOLD
+#define MOVEMENT_ACCELEROMETER_MOTION_THRESHOLD 3
+#endif
+
+/** @brief How hard a tap has to be, for movement_accelerometer_detect_gestures: in 1/32nds of the sensor's range, so
+  *        562 mg at ±2g.
+  */
+#ifndef MOVEMENT_ACCELEROMETER_TAP_THRESHOLD
+#define MOVEMENT_ACCELEROMETER_TAP_THRESHOLD 9
+#endif
+
+/** @brief How long every axis has to read under 312 mg to count as falling: about 20 cm of drop. */
+#ifndef MOVEMENT_ACCELEROMETER_FREE_FALL_MS
+#define MOVEMENT_ACCELEROMETER_FREE_FALL_MS 200
+#endif
+
+/** @brief Most consumers that can listen to the accelerometer at once. */
+#define MOVEMENT_ACCELEROMETER_MAX_CONSUMERS 4
+
+typedef struct {
+    const lis2dw_reading_t *readings;   // MOVEMENT_ACCELEROMETER_WATERMARK raw samples, oldest first
+    uint8_t count;                      // number of readings (always MOVEMENT_ACCELEROMETER_WATERMARK for now)
+    lis2dw_data_rate_t data_rate;       // the rate the samples were taken at
+    uint32_t first_sample;              // index of readings[0], counted from when the sensor started at this rate
+    uint32_t timestamp;                 // UTC unix time when the batch was read; the last sample is from this second
+    uint32_t start_timestamp;           // UTC unix time when sample 0 was taken, to within a second
+    uint32_t ticks;                     // monotonic count when the FIFO reached this batch's watermark, which is when its
+                                        // last sample was taken (@see watch_get_monotonic_ticks); 0 if not known
+    bool overrun;                       // the FIFO overflowed before this batch, so samples are missing before it
+} movement_accelerometer_batch_t;
+
+typedef void (*movement_accelerometer_consumer_t)(const movement_accelerometer_batch_t *batch, void *context);
+
+typedef void (*movement_accelerometer_motion_callback_t)(bool moving);
+
+/// The gestures the LIS2DW can pick out on its own, as bits for movement_accelerometer_detect_gestures.
+typedef enum {
+    MOVEMENT_GESTURE_TAP = 1 << 0,          // a single tap on the case
+    MOVEMENT_GESTURE_DOUBLE_TAP = 1 << 1,   // two taps in quick succession
+    MOVEMENT_GESTURE_ORIENTATION = 1 << 2,  // a different side of the watch now faces up (@see movement_accelerometer_get_orientation)
+    MOVEMENT_GESTURE_FREE_FALL = 1 << 3,    // the watch is falling
+} movement_accelerometer_gesture_t;
+
+typedef void (*movement_accelerometer_gesture_callback_t)(movement_accelerometer_gesture_t gesture);
+
+/** @brief Starts delivering accelerometer samples to a consumer, turning the sensor on if nobody else is using it.
+  * @details The LIS2DW fills its FIFO on its own clock and raises its threshold interrupt once per watermark, which
+  *          wakes the watch through an extwake pin (even from low energy mode). Movement then drains exactly one
+  *          watermark per batch and hands it to every consumer from its main loop, so samples are never dropped or
+  *          duplicated and the MCU sleeps in between. The sensor runs at the fastest rate any consumer asked for;
+  *          consumers that wanted less can decimate. The sensor starts at ±4g, in low power mode 2 with low noise.
+  *          The sensor's clock drifts from the RTC's by a percent or so; to measure it, compare each batch's
+  *          monotonic count with its samples' indexes, since the monotonic counter runs off the RTC's crystal.
+  *          If your face needs something else, change it after subscribing.
+  * @param data_rate The sample rate this consumer needs.
+  * @param consumer The function to call with each batch. It runs in the main loop, not in an interrupt.
+  * @param context Passed through to consumer.
+  * @return true if the consumer was added; false if there was no room for it.
+  */
+bool movement_accelerometer_subscribe(lis2dw_data_rate_t data_rate, movement_accelerometer_consumer_t consumer, void *context);
+
+/** @brief Stops delivering samples to a consumer. When the last one unsubscribes, the sensor is powered down. */
+void movement_accelerometer_unsubscribe(movement_accelerometer_consumer_t consumer, void *context);
+
+/** @brief Returns true while someone is subscribed and the sensor is streaming into its FIFO. Don't reconfigure the
+  *        LIS2DW while it is.
+  */
+bool movement_accelerometer_is_streaming(void);
+
+/** @brief Gets the newest sample from the last batch, for code that wants to know which way the watch is facing without
+  *        reading the sensor while it streams (reading its output registers would take a sample out of the FIFO).
+  * @param reading Set to the sample, raw, at ±4g unless a consumer changed the range.
+  * @return true if the sensor is running and has delivered a batch at its current rate.
+  */
+bool movement_accelerometer_get_latest(lis2dw_reading_t *reading);
+
+/** @brief Watches for the watch being set down and picked up again, with the LIS2DW's stationary detection.
+  * @details Once the sensor has seen nothing over MOVEMENT_ACCELEROMETER_MOTION_THRESHOLD for 16 samples it calls
+  *          the watch still, and the first sample over it after that is motion. With nobody streaming, the sensor
+  *          runs at 1.6 Hz in its lowest power mode just for this, and its sleep change interrupt wakes the watch
+  *          through MOVEMENT_ACCELEROMETER_INT_PIN, even from low energy mode; so stillness takes 10 seconds to
+  *          notice, and motion at most one sample. While it streams, the same detection runs at the stream's rate,
+  *          and is looked at after every batch. Movement uses this for the low energy mode preference that follows
+  *          motion. It needs the sleep change interrupt, which the LIS2DW only has on INT2.
+  * @param callback Called from the main loop each time the watch starts or stops moving, or NULL to stop watching.
+  *                 There is one of these; a second call replaces the first.
+  * @return false if the sensor's INT2 isn't wired to MOVEMENT_ACCELEROMETER_INT_PIN.
+  */
+bool movement_accelerometer_detect_motion(movement_accelerometer_motion_callback_t callback);
+
+/** @brief Returns true while the sensor is watching for motion. It samples continuously then, so its output
+  *        registers always hold a recent reading.
+  */
+bool movement_accelerometer_is_detecting_motion(void);
+
+/** @brief Counts the times the watch starts moving, with the same stationary detection as
+  *        movement_accelerometer_detect_motion, and alongside it if that's on too.
+  * @details Each count is one wake from the sensor's sleep change interrupt, and no samples reach the MCU; with nobody
+  *          streaming, the sensor runs at 1.6 Hz in its lowest power mode. Since the sensor has to see ten seconds of
+  *          stillness before it can notice motion again, a minute holds at most six.
+  * @param count true to start counting from zero, false to stop.
+  * @return false if the sensor's INT2 isn't wired to MOVEMENT_ACCELEROMETER_INT_PIN.
+  */
+bool movement_accelerometer_count_motion(bool count);
+
+/** @brief Returns the number of times the watch has started moving since the last call, and starts over. */
+uint16_t movement_accelerometer_take_motion_count(void);
+
+/** @brief Has the LIS2DW watch for taps, double taps, turns of the wrist or drops with its own gesture engines, which
+  *        look at every sample so that the MCU doesn't have to.
+  * @details The sensor raises its interrupt for each gesture, and Movement reads which one it was and calls back from
+  *          its main loop; nothing else reaches the MCU. With nobody streaming, the sensor runs at 200 Hz in its lowest
+  *          power mode for taps, which need it, and at 50 Hz for the others; with somebody streaming, at least that.
+  *          Movement turns these into events for the face on screen (@see movement_request_gestures), which is the
+  *          way faces should use them. The gesture interrupts only go to the sensor's INT1.
+  * @param gestures Any of the MOVEMENT_GESTURE_ bits, or 0 to stop.
+  * @param callback Called with each gesture; there is one of these, and a second call replaces the first.
+  * @return false if the sensor's INT1 isn't wired to MOVEMENT_ACCELEROMETER_INT_PIN.
+  */
+bool movement_accelerometer_detect_gestures(uint8_t gestures, movement_accelerometer_gesture_callback_t callback);
+
+/** @brief Returns the side of the watch that faced up or down at the last MOVEMENT_GESTURE_ORIENTATION, as the
+  *        sensor's XL-ZH bits (LIS2DW_WAKE_UP_SRC_VAL_ZH for face up, for instance); 0 before the first.
+  */
+uint8_t movement_accelerometer_get_orientation(void);
+
+/** @brief Returns true if a watermark or motion interrupt has come in since the last call to
+  *        movement_accelerometer_service.
+  */
+bool movement_accelerometer_needs_service(void);
+
+/** @brief Drains the FIFO a watermark at a time and hands each batch to the consumers, then checks for a change in
+  *        motion if anyone is watching for one. Movement calls this from its main loop after an interrupt, in the
+  *        same bus window as any sensor reads that are due (@see movement_sensors_service); faces don't need to.
+  */
+void movement_accelerometer_service(void);
+
+#endif // MOVEMENT_ACCELEROMETER_H_
@@ -0,0 +1,216 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "movement_activity.h"
+#include "movement_accelerometer.h"
+
+// everything below is tuned for 12.5 Hz, with the sensor at ±4g (8192 raw counts per g).
+#define ACTIVITY_DATA_RATE LIS2DW_DATA_RATE_12_5_HZ
+// the L1 norm is shifted down to 512 counts per g, so that a window's sum of squares fits in 32 bits.
+#define ACTIVITY_INPUT_SHIFT 4
+// how far past the last window's mean the signal has to swing to count as crossing it, about 16 mg.
+#define ACTIVITY_CROSSING_BAND 8
+// windows the tree has to give the same answer for before it's reported.
+#define ACTIVITY_CONFIRM_WINDOWS 2
+
+// variance below which a window is still (about 16 mg RMS), and below which it's only the sensor's noise (4 mg RMS).
+#define ACTIVITY_STILL_VARIANCE 64
+#define ACTIVITY_NOISE_VARIANCE 4
+// variance a rhythm needs to be walking rather than fidgeting (about 64 mg RMS), and the crossings it takes: a step
+// is a swing up and back down, and walking is somewhere from 1.5 to 3 steps a second.
+#define ACTIVITY_WALKING_VARIANCE 1024
+#define ACTIVITY_WALKING_MIN_CROSSINGS 10
+#define ACTIVITY_WALKING_MAX_CROSSINGS 26
+// still windows in a row before still on the wrist is sleeping: 15 minutes, at 12.5 samples a second.
+#define ACTIVITY_SLEEP_WINDOWS (15 * 60 * 25 / 2 / MOVEMENT_ACTIVITY_WINDOW)
+
+typedef enum {
+    ACTIVITY_FEATURE_MEAN,
+    ACTIVITY_FEATURE_VARIANCE,
+    ACTIVITY_FEATURE_CROSSINGS,
+    ACTIVITY_FEATURE_STILL_WINDOWS,
+} activity_feature_t;
+
+// a child at or above this is a leaf, and the rest of it is the activity.
+#define ACTIVITY_LEAF 0x80
+
+typedef struct {
+    uint8_t feature;        // activity_feature_t
+    uint8_t below;          // where to go if the feature is under the threshold: a node's index, or a leaf
+    uint8_t above;          // and if it's at or over it
+    uint32_t threshold;
+} activity_node_t;
+
+// the tree starts at node 0. a trained tree can replace this one as long as it tests the same features.
+static const activity_node_t _activity_tree[] = {
+    // 0: still, or moving?
+    { ACTIVITY_FEATURE_VARIANCE, 1, 2, ACTIVITY_STILL_VARIANCE },
+    // 1: still. a wrist always moves a little; a watch on a table doesn't.
+    { ACTIVITY_FEATURE_VARIANCE, ACTIVITY_LEAF | MOVEMENT_ACTIVITY_OFF_WRIST, 3, ACTIVITY_NOISE_VARIANCE },
+    // 2: moving. walking has a rhythm, fidgeting doesn't.
+    { ACTIVITY_FEATURE_CROSSINGS, ACTIVITY_LEAF | MOVEMENT_ACTIVITY_IDLE, 4, ACTIVITY_WALKING_MIN_CROSSINGS },
+    // 3: still on the wrist: for long enough to be asleep?
+    { ACTIVITY_FEATURE_STILL_WINDOWS, ACTIVITY_LEAF | MOVEMENT_ACTIVITY_IDLE, ACTIVITY_LEAF | MOVEMENT_ACTIVITY_SLEEPING, ACTIVITY_SLEEP_WINDOWS },
+    // 4: a rhythm, but faster than anyone walks or runs: shaking, scrubbing, washing hands.
+    { ACTIVITY_FEATURE_CROSSINGS, 5, ACTIVITY_LEAF | MOVEMENT_ACTIVITY_IDLE, ACTIVITY_WALKING_MAX_CROSSINGS + 1 },
+    // 5: and hard enough to be steps.
+    { ACTIVITY_FEATURE_VARIANCE, ACTIVITY_LEAF | MOVEMENT_ACTIVITY_IDLE, ACTIVITY_LEAF | MOVEMENT_ACTIVITY_WALKING, ACTIVITY_WALKING_VARIANCE },
+};
+
+static struct {
+    bool enabled;
+    bool has_features;
+    movement_activity_t activity;
+    movement_activity_t candidate;  // what the tree said last
+    uint8_t agreeing;               // windows in a row it's said so
+    movement_activity_features_t features;
+
+    // the window being filled
+    uint8_t count;
+    uint32_t sum;
+    uint32_t sum_of_squares;
+    uint8_t crossings;
+    int8_t side;                    // which side of the reference the signal was last seen on: -1, 1, or 0 if neither
+    uint16_t reference;             // the last window's mean, which crossings are counted against
+    bool has_reference;
+} _activity;
+
+static uint32_t _movement_activity_feature(const movement_activity_features_t *features, uint8_t feature) {
+    switch (feature) {
+        case ACTIVITY_FEATURE_MEAN: return features->mean;
+        case ACTIVITY_FEATURE_VARIANCE: return features->variance;
+        case ACTIVITY_FEATURE_CROSSINGS: return features->crossings;
+        case ACTIVITY_FEATURE_STILL_WINDOWS: return features->still_windows;
+        default: return 0;
+    }
+}
+
+static movement_activity_t _movement_activity_classify(const movement_activity_features_t *features) {
+    uint8_t node = 0;
+    while (!(node & ACTIVITY_LEAF)) {
+        const activity_node_t *test = &_activity_tree[node];
+        node = _movement_activity_feature(features, test->feature) < test->threshold ? test->below : test->above;
+    }
+    return (movement_activity_t)(node & ~ACTIVITY_LEAF);
+}
+
+static void _movement_activity_finish_window(void) {
+    movement_activity_features_t *features = &_activity.features;
+    uint32_t mean = _activity.sum / MOVEMENT_ACTIVITY_WINDOW;
+    features->mean = mean;
+    // in 64 bits, once a window: the mean squared is hundreds of thousands, so rounding it first would swamp a
+    // variance of a few counts.
+    uint64_t spread = (uint64_t)_activity.sum_of_squares * MOVEMENT_ACTIVITY_WINDOW - (uint64_t)_activity.sum * _activity.sum;
+    features->variance = spread / (MOVEMENT_ACTIVITY_WINDOW * MOVEMENT_ACTIVITY_WINDOW);
+    features->crossings = _activity.crossings;
+    if (features->variance >= ACTIVITY_STILL_VARIANCE) features->still_windows = 0;
+    else if (features->still_windows < UINT16_MAX) features->still_windows++;
+    _activity.has_features = true;
+
+    movement_activity_t activity = _movement_activity_classify(features);
+    if (activity != _activity.candidate) {
+        _activity.candidate = activity;
+        _activity.agreeing = 0;
+    }
+    if (_activity.agreeing < ACTIVITY_CONFIRM_WINDOWS) _activity.agreeing++;
+    if (_activity.agreeing == ACTIVITY_CONFIRM_WINDOWS) _activity.activity = activity;
+
+    _activity.reference = mean;
+    _activity.has_reference = true;
+    _activity.count = 0;
+    _activity.sum = 0;
+    _activity.sum_of_squares = 0;
+    _activity.crossings = 0;
+}
+
+static void _movement_activity_process_sample(const lis2dw_reading_t *reading) {
+    uint32_t magnitude = (abs(reading->x) + abs(reading->y) + abs(reading->z)) >> ACTIVITY_INPUT_SHIFT;
+
+    _activity.sum += magnitude;
+    _activity.sum_of_squares += magnitude * magnitude;
+
+    // count the swings through the mean, with a band around it so that noise sitting on the mean isn't a swing.
+    if (_activity.has_reference) {
+        int8_t side = 0;
+        if (magnitude > (uint32_t)_activity.reference + ACTIVITY_CROSSING_BAND) side = 1;
+        else if (magnitude + ACTIVITY_CROSSING_BAND < _activity.reference) side = -1;
+        if (side) {
+            if (_activity.side && side != _activity.side && _activity.crossings < UINT8_MAX) _activity.crossings++;
+            _activity.side = side;
+        }
+    }
+
+    if (++_activity.count == MOVEMENT_ACTIVITY_WINDOW) _movement_activity_finish_window();
+}
+
+static void _movement_activity_consume(const movement_accelerometer_batch_t *batch, void *context) {
+    (void) context;
+
+    // the rate codes go up by one each time the rate doubles.
+    uint8_t stride = 1;
+    if (batch->data_rate > ACTIVITY_DATA_RATE) stride = 1 << (batch->data_rate - ACTIVITY_DATA_RATE);
+
+    // samples are missing before this batch, so the window they'd have been in is no good.
+    if (batch->overrun) {
+        _activity.count = 0;
+        _activity.sum = 0;
+        _activity.sum_of_squares = 0;
+        _activity.crossings = 0;
+    }
+
+    for (uint8_t i = 0; i < batch->count; i++) {
+        if ((batch->first_sample + i) % stride) continue;
+        _movement_activity_process_sample(&batch->readings[i]);
+    }
+}
+
+void movement_activity_enable(void) {
+    if (_activity.enabled) return;
+
+    memset(&_activity, 0, sizeof(_activity));
+    _activity.enabled = movement_accelerometer_subscribe(ACTIVITY_DATA_RATE, _movement_activity_consume, NULL);
+}
+
+void movement_activity_disable(void) {
+    if (!_activity.enabled) return;
+
+    movement_accelerometer_unsubscribe(_movement_activity_consume, NULL);
+    memset(&_activity, 0, sizeof(_activity));
+}
+
+bool movement_activity_is_enabled(void) {
+    return _activity.enabled;
+}
+
+movement_activity_t movement_activity_get(void) {
+    return _activity.activity;
+}
+
+bool movement_activity_get_features(movement_activity_features_t *features) {
+    if (!_activity.has_features) return false;
+    *features = _activity.features;
+    return true;
+}
@@ -0,0 +1,77 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MOVEMENT_ACTIVITY_H_
+#define MOVEMENT_ACTIVITY_H_
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Samples in each window the classifier looks at: four seconds at 12.5 Hz. */
+#define MOVEMENT_ACTIVITY_WINDOW 50
+
+typedef enum {
+    MOVEMENT_ACTIVITY_UNKNOWN = 0,  // not running, or hasn't seen enough windows yet
+    MOVEMENT_ACTIVITY_IDLE,         // on the wrist, moving a little: sitting, typing, standing around
+    MOVEMENT_ACTIVITY_WALKING,      // moving in a rhythm, at walking or running cadence
+    MOVEMENT_ACTIVITY_SLEEPING,     // on the wrist, and barely moving for a good while
+    MOVEMENT_ACTIVITY_OFF_WRIST,    // perfectly still: nothing but the sensor's own noise
+    MOVEMENT_NUM_ACTIVITIES
+} movement_activity_t;
+
+typedef struct {
+    uint16_t mean;                  // mean L1 norm of the acceleration, at 512 counts per g
+    uint32_t variance;              // variance of the L1 norm, in counts squared
+    uint8_t crossings;              // times the L1 norm crossed the last window's mean, by more than a little
+    uint16_t still_windows;         // windows in a row (up to 65535) that have been still, this one included
+} movement_activity_features_t;
+
+/** @brief Starts classifying what the wearer is doing, in the background. Does nothing if it's already running.
+  * @details The classifier listens to the accelerometer engine (@see movement_accelerometer_subscribe) at 12.5 Hz,
+  *          keeping every nth sample if something else has the sensor running faster. For each window of
+  *          MOVEMENT_ACTIVITY_WINDOW samples it works out a few features in integer arithmetic, in one pass and
+  *          without keeping the samples (@see movement_activity_features_t), and runs them through a small decision
+  *          tree. An answer has to come out of the tree for two windows in a row before it's reported, so a single
+  *          odd window doesn't flip it. It costs a few dozen cycles a sample, a few microseconds a batch.
+  *          The tree's thresholds are a starting point, set by hand; the labelled sessions that the accelerometer
+  *          data acquisition face records are what to tune them against.
+  */
+void movement_activity_enable(void);
+
+/** @brief Stops classifying, and forgets what it was seeing. */
+void movement_activity_disable(void);
+
+/** @brief Returns true if the classifier is running. */
+bool movement_activity_is_enabled(void);
+
+/** @brief Returns what the wearer is doing, as of the last window; MOVEMENT_ACTIVITY_UNKNOWN if the classifier isn't
+  *        running or hasn't settled on an answer yet.
+  */
+movement_activity_t movement_activity_get(void);
+
+/** @brief Gets the features of the last complete window, for tuning the tree or for a face that wants more detail.
+  * @return false if no window has completed since the classifier started.
+  */
+bool movement_activity_get_features(movement_activity_features_t *features);
+
+#endif // MOVEMENT_ACTIVITY_H_
@@ -0,0 +1,299 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "movement_backup.h"
+#include "filesystem.h"
+#include "watch.h"
+
+// BKUP[3] says who owns each of the registers after it. Registers 0 to 2 hold Movement's settings, location and
+// birth date.
+#define MOVEMENT_BACKUP_OWNERS_REGISTER 3
+#define MOVEMENT_BACKUP_FIRST_REGISTER 4
+#define MOVEMENT_BACKUP_NUM_REGISTERS 4
+// a face is recorded as its index plus one, so that a register cleared at power-on is free.
+#define MOVEMENT_BACKUP_OWNER_FREE 0
+#define MOVEMENT_BACKUP_OWNER_SNAPSHOT 0xFF
+#define MOVEMENT_BACKUP_OWNER_JOURNAL 0xFE
+#define MOVEMENT_SNAPSHOT_FILENAME "snapshot.u8"
+#define MOVEMENT_SNAPSHOT_MAGIC 0xB5
+#define MOVEMENT_JOURNAL_MAGIC 0xB6
+
+typedef union {
+    uint8_t owner[MOVEMENT_BACKUP_NUM_REGISTERS];
+    uint32_t reg;
+} movement_backup_owners_t;
+
+// the first register the snapshot or the journal gets holds this. the rest of its registers hold the start of the snapshot, and the
+// file holds whatever didn't fit; the CRC is over all of it, so a file left from an older snapshot is caught.
+typedef union {
+    struct {
+        uint8_t magic;
+        uint8_t length;
+        uint16_t crc;
+    } bit;
+    uint32_t reg;
+} movement_snapshot_header_t;
+
+// in the snapshot, each piece of state is one of these followed by the state itself.
+typedef struct {
+    uint8_t watch_face_index;
+    uint8_t tag;
+    uint8_t length;
+} movement_snapshot_record_t;
+
+static uint8_t snapshot[MOVEMENT_SNAPSHOT_SIZE];
+static uint8_t snapshot_length;
+// set on a wake while the registers may still hold a snapshot, until it's been read in.
+static bool snapshot_in_registers;
+// the registers handed out since boot, one bit each, so a face that claims two gets its second one next.
+static uint8_t claimed_registers;
+
+static uint16_t _movement_snapshot_crc(const uint8_t *data, uint8_t length) {
+    // CRC-16/CCITT, which is plenty for 64 bytes.
+    uint16_t crc = 0xFFFF;
+    for (uint8_t i = 0; i < length; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
+
+static void _movement_snapshot_read_in(void) {
+    if (!snapshot_in_registers) return;
+    snapshot_in_registers = false;
+
+    movement_backup_owners_t owners = { .reg = watch_get_backup_data(MOVEMENT_BACKUP_OWNERS_REGISTER) };
+    uint8_t registers[MOVEMENT_BACKUP_NUM_REGISTERS];
+    uint8_t num_registers = 0;
+    for (uint8_t i = 0; i < MOVEMENT_BACKUP_NUM_REGISTERS; i++) {
+        if (owners.owner[i] != MOVEMENT_BACKUP_OWNER_SNAPSHOT) continue;
+        registers[num_registers++] = MOVEMENT_BACKUP_FIRST_REGISTER + i;
+        owners.owner[i] = MOVEMENT_BACKUP_OWNER_FREE;
+    }
+    if (num_registers == 0) return;
+
+    movement_snapshot_header_t header = { .reg = watch_get_backup_data(registers[0]) };
+    uint8_t buffer[MOVEMENT_SNAPSHOT_SIZE];
+    uint8_t in_registers = 0;
+    for (uint8_t i = 1; i < num_registers; i++, in_registers += sizeof(uint32_t)) {
+        uint32_t data = watch_get_backup_data(registers[i]);
+        memcpy(buffer + in_registers, &data, sizeof(data));
+    }
+    // the registers are free again, and cleared like they are at power-on for whichever face claims them next.
+    for (uint8_t i = 0; i < num_registers; i++) watch_store_backup_data(0, registers[i]);
+    watch_store_backup_data(owners.reg, MOVEMENT_BACKUP_OWNERS_REGISTER);
+
+    uint8_t length = header.bit.length;
+    if (header.bit.magic != MOVEMENT_SNAPSHOT_MAGIC || length > MOVEMENT_SNAPSHOT_SIZE) return;
+    if (length > in_registers &&
+        !filesystem_read_file(MOVEMENT_SNAPSHOT_FILENAME, (char *)buffer + in_registers, length - in_registers)) return;
+    if (_movement_snapshot_crc(buffer, length) != header.bit.crc) return;
+    memcpy(snapshot, buffer, length);
+    snapshot_length = length;
+}
+
+// gives back the journal's registers, cleared, for the caller to store along with whatever else it changes.
+static bool _movement_backup_free_journal(movement_backup_owners_t *owners) {
+    bool freed = false;
+    for (uint8_t i = 0; i < MOVEMENT_BACKUP_NUM_REGISTERS; i++) {
+        if (owners->owner[i] != MOVEMENT_BACKUP_OWNER_JOURNAL) continue;
+        watch_store_backup_data(0, MOVEMENT_BACKUP_FIRST_REGISTER + i);
+        owners->owner[i] = MOVEMENT_BACKUP_OWNER_FREE;
+        freed = true;
+    }
+    return freed;
+}
+
+static int16_t _movement_snapshot_find(uint8_t watch_face_index, uint8_t tag) {
+    uint8_t offset = 0;
+    while (offset < snapshot_length) {
+        movement_snapshot_record_t *record = (movement_snapshot_record_t *)(snapshot + offset);
+        if (record->watch_face_index == watch_face_index && record->tag == tag) return offset;
+        offset += sizeof(movement_snapshot_record_t) + record->length;
+    }
+    return -1;
+}
+
+uint8_t movement_backup_claim_register(uint8_t watch_face_index) {
+    _movement_snapshot_read_in();
+
+    movement_backup_owners_t owners = { .reg = watch_get_backup_data(MOVEMENT_BACKUP_OWNERS_REGISTER) };
+    uint8_t owner = watch_face_index + 1;
+    // a register the face had before the wake comes first, then a free one.
+    const uint8_t wanted[2] = { owner, MOVEMENT_BACKUP_OWNER_FREE };
+    for (uint8_t pass = 0; pass < 2; pass++) {
+        for (uint8_t i = 0; i < MOVEMENT_BACKUP_NUM_REGISTERS; i++) {
+            if ((claimed_registers & (1 << i)) || owners.owner[i] != wanted[pass]) continue;
+            claimed_registers |= 1 << i;
+            owners.owner[i] = owner;
+            watch_store_backup_data(owners.reg, MOVEMENT_BACKUP_OWNERS_REGISTER);
+            return MOVEMENT_BACKUP_FIRST_REGISTER + i;
+        }
+    }
+    // a face's register matters more than the journal, which is written again with the next change anyway.
+    if (_movement_backup_free_journal(&owners)) {
+        watch_store_backup_data(owners.reg, MOVEMENT_BACKUP_OWNERS_REGISTER);
+        return movement_backup_claim_register(watch_face_index);
+    }
+    return 0;
+}
+
+bool movement_snapshot_save(uint8_t watch_face_index, uint8_t tag, const void *data, uint8_t length) {
+    _movement_snapshot_read_in();
+
+    if (data == NULL) length = 0;
+    int16_t offset = _movement_snapshot_find(watch_face_index, tag);
+    uint8_t old_size = offset < 0 ? 0 : sizeof(movement_snapshot_record_t) + snapshot[offset + offsetof(movement_snapshot_record_t, length)];
+    uint8_t new_size = length ? sizeof(movement_snapshot_record_t) + length : 0;
+    if (snapshot_length - old_size + new_size > MOVEMENT_SNAPSHOT_SIZE) return false;
+
+    if (offset >= 0) {
+        memmove(snapshot + offset, snapshot + offset + old_size, snapshot_length - offset - old_size);
+        snapshot_length -= old_size;
+    }
+    if (length) {
+        movement_snapshot_record_t record = { watch_face_index, tag, length };
+        memcpy(snapshot + snapshot_length, &record, sizeof(record));
+        memcpy(snapshot + snapshot_length + sizeof(record), data, length);
+        snapshot_length += new_size;
+    }
+    return true;
+}
+
+bool movement_snapshot_restore(uint8_t watch_face_index, uint8_t tag, void *data, uint8_t length) {
+    _movement_snapshot_read_in();
+
+    int16_t offset = _movement_snapshot_find(watch_face_index, tag);
+    if (offset < 0) return false;
+    movement_snapshot_record_t *record = (movement_snapshot_record_t *)(snapshot + offset);
+    if (record->length != length) return false;
+    memcpy(data, snapshot + offset + sizeof(movement_snapshot_record_t), length);
+    return true;
+}
+
+void movement_backup_wake(void) {
+    snapshot_in_registers = true;
+}
+
+bool movement_snapshot_write(void) {
+    _movement_snapshot_read_in();
+    if (snapshot_length == 0) return true;
+
+    // the header, and as much of the snapshot as will fit, go in the free registers.
+    movement_backup_owners_t owners = { .reg = watch_get_backup_data(MOVEMENT_BACKUP_OWNERS_REGISTER) };
+    uint8_t registers[MOVEMENT_BACKUP_NUM_REGISTERS];
+    uint8_t num_registers = 0;
+    uint8_t needed = 1 + (snapshot_length + sizeof(uint32_t) - 1) / sizeof(uint32_t);
+    for (uint8_t i = 0; i < MOVEMENT_BACKUP_NUM_REGISTERS && num_registers < needed; i++) {
+        if (owners.owner[i] != MOVEMENT_BACKUP_OWNER_FREE) continue;
+        registers[num_registers++] = MOVEMENT_BACKUP_FIRST_REGISTER + i;
+        owners.owner[i] = MOVEMENT_BACKUP_OWNER_SNAPSHOT;
+    }
+    // without a register for the header, there would be no telling a fresh file from a stale one.
+    if (num_registers == 0) return false;
+
+    movement_snapshot_header_t header = { .bit = { MOVEMENT_SNAPSHOT_MAGIC, snapshot_length, _movement_snapshot_crc(snapshot, snapshot_length) } };
+    watch_store_backup_data(header.reg, registers[0]);
+    uint8_t in_registers = 0;
+    for (uint8_t i = 1; i < num_registers; i++, in_registers += sizeof(uint32_t)) {
+        uint32_t data = 0;
+        uint8_t left = snapshot_length - in_registers;
+        memcpy(&data, snapshot + in_registers, left < sizeof(data) ? left : sizeof(data));
+        watch_store_backup_data(data, registers[i]);
+    }
+    bool written = true;
+    if (snapshot_length > in_registers) {
+        written = filesystem_write_file(MOVEMENT_SNAPSHOT_FILENAME, (char *)snapshot + in_registers, snapshot_length - in_registers);
+    }
+    watch_store_backup_data(owners.reg, MOVEMENT_BACKUP_OWNERS_REGISTER);
+
+    return written;
+}
+
+uint8_t movement_backup_journal_write(const void *data, uint8_t length) {
+    movement_backup_owners_t owners = { .reg = watch_get_backup_data(MOVEMENT_BACKUP_OWNERS_REGISTER) };
+    if (data == NULL) length = 0;
+    if (length > MOVEMENT_BACKUP_JOURNAL_SIZE) length = MOVEMENT_BACKUP_JOURNAL_SIZE;
+
+    // the journal's own registers and the free ones are all the same to it, since it's rewritten whole each time.
+    uint8_t registers[MOVEMENT_BACKUP_NUM_REGISTERS];
+    uint8_t num_registers = 0;
+    uint8_t needed = length ? 1 + (length + sizeof(uint32_t) - 1) / sizeof(uint32_t) : 0;
+    for (uint8_t i = 0; i < MOVEMENT_BACKUP_NUM_REGISTERS; i++) {
+        if (owners.owner[i] != MOVEMENT_BACKUP_OWNER_JOURNAL && owners.owner[i] != MOVEMENT_BACKUP_OWNER_FREE) continue;
+        if (num_registers < needed) {
+            registers[num_registers++] = MOVEMENT_BACKUP_FIRST_REGISTER + i;
+            owners.owner[i] = MOVEMENT_BACKUP_OWNER_JOURNAL;
+        } else if (owners.owner[i] == MOVEMENT_BACKUP_OWNER_JOURNAL) {
+            watch_store_backup_data(0, MOVEMENT_BACKUP_FIRST_REGISTER + i);
+            owners.owner[i] = MOVEMENT_BACKUP_OWNER_FREE;
+        }
+    }
+    if (num_registers == 0) {
+        watch_store_backup_data(owners.reg, MOVEMENT_BACKUP_OWNERS_REGISTER);
+        return 0;
+    }
+
+    // whatever doesn't fit is left off the end; the header goes last, so that a reset part way through leaves a
+    // journal whose CRC doesn't check out rather than a mix of old and new.
+    uint8_t in_registers = 0;
+    for (uint8_t i = 1; i < num_registers; i++, in_registers += sizeof(uint32_t)) {
+        uint32_t value = 0;
+        uint8_t left = length - in_registers;
+        memcpy(&value, (const uint8_t *)data + in_registers, left < sizeof(value) ? left : sizeof(value));
+        watch_store_backup_data(value, registers[i]);
+    }
+    if (length > in_registers) length = in_registers;
+    movement_snapshot_header_t header = { .bit = { MOVEMENT_JOURNAL_MAGIC, length, _movement_snapshot_crc(data, length) } };
+    watch_store_backup_data(header.reg, registers[0]);
+    watch_store_backup_data(owners.reg, MOVEMENT_BACKUP_OWNERS_REGISTER);
+
+    return length;
+}
+
+uint8_t movement_backup_journal_read(void *data, uint8_t length) {
+    movement_backup_owners_t owners = { .reg = watch_get_backup_data(MOVEMENT_BACKUP_OWNERS_REGISTER) };
+    uint8_t buffer[MOVEMENT_BACKUP_JOURNAL_SIZE];
+    movement_snapshot_header_t header = { .reg = 0 };
+    uint8_t in_registers = 0;
+    for (uint8_t i = 0; i < MOVEMENT_BACKUP_NUM_REGISTERS; i++) {
+        if (owners.owner[i] != MOVEMENT_BACKUP_OWNER_JOURNAL) continue;
+        uint32_t value = watch_get_backup_data(MOVEMENT_BACKUP_FIRST_REGISTER + i);
+        if (header.reg == 0) {
+            header.reg = value;
+        } else if (in_registers < sizeof(buffer)) {
+            memcpy(buffer + in_registers, &value, sizeof(value));
+            in_registers += sizeof(value);
+        }
+    }
+    if (_movement_backup_free_journal(&owners)) watch_store_backup_data(owners.reg, MOVEMENT_BACKUP_OWNERS_REGISTER);
+
+    uint8_t journal_length = header.bit.length;
+    if (header.bit.magic != MOVEMENT_JOURNAL_MAGIC || journal_length > in_registers || journal_length > length) return 0;
+    if (_movement_snapshot_crc(buffer, journal_length) != header.bit.crc) return 0;
+    memcpy(data, buffer, journal_length);
+    return journal_length;
+}
@@ -0,0 +1,102 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MOVEMENT_BACKUP_H_
+#define MOVEMENT_BACKUP_H_
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Most bytes the state snapshot holds, counting three bytes of bookkeeping for each piece of state. */
+#define MOVEMENT_SNAPSHOT_SIZE (64)
+
+/** @brief Most bytes the journal holds: three backup registers, when no face has claimed any. */
+#define MOVEMENT_BACKUP_JOURNAL_SIZE (12)
+
+/** @brief Claims one of the backup registers BKUP[4] to BKUP[7] for a face, the same one each time it asks.
+  * @details Which face owns each register is kept in BKUP[3], which lives through BACKUP mode and resets along with
+  *          the registers themselves, so a face gets its own register back after a wake however late it's set up.
+  *          A face that claims more than one gets them back in the order it claimed them.
+  * @param watch_face_index The face making the claim.
+  *          If the journal has the last of the free ones, the journal is dropped to make room.
+  * @return A register from 4 to 7, or 0 if they're all taken.
+  */
+uint8_t movement_backup_claim_register(uint8_t watch_face_index);
+
+/** @brief Keeps a small piece of a face's state, to be restored after BACKUP mode.
+  * @details The snapshot collects these in RAM, and movement_enter_backup_mode writes them out: into whatever
+  *          backup registers no face has claimed, and into a file for whatever doesn't fit there. Saving is cheap,
+  *          then, and nothing goes to flash at all unless the registers run out. Save state that means the same
+  *          thing after a reset, like an alarm time, a count, or a deadline as a date and time, and save it again
+  *          whenever it changes.
+  * @param watch_face_index The face the state belongs to.
+  * @param tag The face's own number for this piece of state. Give it a new one if the state's layout changes, so
+  *            that a snapshot from older firmware isn't read as the new layout.
+  * @param data The state, or NULL to forget it.
+  * @param length Its size in bytes, or 0 to forget it.
+  * @return true if the state was kept; false if the snapshot is full.
+  */
+bool movement_snapshot_save(uint8_t watch_face_index, uint8_t tag, const void *data, uint8_t length);
+
+/** @brief Reads back a piece of state kept with movement_snapshot_save, from before BACKUP mode or since.
+  * @details The snapshot left in the registers is read in the first time anything asks for it after a wake, so
+  *          restoring costs nothing until a face needs it; the face's setup is the place to ask. The state stays in
+  *          the snapshot until the face saves it again or forgets it.
+  * @param watch_face_index The face the state belongs to.
+  * @param tag The number it was saved with.
+  * @param data A buffer for the state.
+  * @param length The size it was saved with.
+  * @return true if the state was found, with the same tag and length, and copied into data.
+  */
+bool movement_snapshot_restore(uint8_t watch_face_index, uint8_t tag, void *data, uint8_t length);
+
+/** @brief Tells the snapshot that the backup registers have kept their contents from before, after BACKUP mode or
+  *        a reset. Movement calls this from app_wake_from_backup.
+  */
+void movement_backup_wake(void);
+
+/** @brief Writes the snapshot out to the backup registers no face has claimed, and to a file for the rest.
+  *        Movement calls this on its way into BACKUP mode (@see movement_enter_backup_mode).
+  * @return true if all of it was written.
+  */
+bool movement_snapshot_write(void);
+
+/** @brief Keeps a few bytes in the backup registers no face has claimed, right away, so that they live through a
+  *        reset. Movement's key/value store keeps the changes it hasn't written to flash yet here.
+  * @details Each call replaces what was there before. There are at most MOVEMENT_BACKUP_JOURNAL_SIZE bytes to go
+  *          round, and fewer for every register a face has claimed; whatever doesn't fit is left off the end. Clear
+  *          the journal before BACKUP mode, since the snapshot only gets the registers the journal isn't using.
+  * @param data The bytes to keep, or NULL to clear the journal and give its registers back.
+  * @param length How many bytes, or 0 to clear the journal.
+  * @return How many of the bytes were kept.
+  */
+uint8_t movement_backup_journal_write(const void *data, uint8_t length);
+
+/** @brief Reads back the journal left in the backup registers from before a reset, and clears it.
+  * @param data A buffer for the journal.
+  * @param length The size of the buffer.
+  * @return The journal's length, or 0 if there wasn't one, it didn't pass its CRC, or it didn't fit in data.
+  */
+uint8_t movement_backup_journal_read(void *data, uint8_t length);
+
+#endif // MOVEMENT_BACKUP_H_
@@ -0,0 +1,208 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "movement_battery_life.h"
+#include "movement_accelerometer.h"
+#include "movement.h"
+#include "watch_utility.h"
+#include "energy_costs.h"
+
+// a day's figures count for this fraction of the average (1 / 2^DAY_WEIGHT_SHIFT), so it follows a change of faces
+// within a week or so without swinging with every busy day.
+#define DAY_WEIGHT_SHIFT 2
+#define SECONDS_PER_DAY 86400UL
+// a gap longer than this between updates means the clock was set or the watch was off, not a long day.
+#define MAX_DAY_SECONDS (2 * SECONDS_PER_DAY)
+// 1 mAh is 1000 µA for 3600 s.
+#define UAS_PER_MAH 3600000UL
+// the LED's color isn't counted, so it's charged between the two.
+#define LED_UA ((WATCH_ENERGY_LED_RED_UA + WATCH_ENERGY_LED_GREEN_UA) / 2)
+
+// a lithium coin cell's voltage against the share of its capacity left, under the watch's light load.
+static const struct {
+    uint16_t millivolts;
+    uint8_t percent;
+} _curve[] = {
+    {3000, 100}, {2900, 90}, {2800, 70}, {2700, 45}, {2600, 25}, {2400, 10}, {2200, 3}, {2000, 0},
+};
+
+// what each face had used as of the last update, to take the day's use from, and its average day since.
+typedef struct {
+    uint32_t loop_calls;
+    uint32_t active_cycles;
+    uint32_t daily_use;
+} battery_life_face_t;
+
+static struct {
+    movement_battery_life_t estimate;
+    uint32_t last_update;           // UTC timestamp of the last update; 0 before the first
+    uint8_t last_day;
+    uint16_t streaming_minutes;     // since the last update
+    uint16_t motion_minutes;
+    uint16_t usb_minutes;
+    uint32_t led_ticks;             // all the faces' together, as of the last update
+    uint32_t buzzer_ticks;
+    uint16_t voltages[MOVEMENT_BATTERY_TREND_DAYS];     // a reading a day, oldest first
+    uint8_t num_voltages;
+    uint8_t num_faces;
+    battery_life_face_t *faces;     // from the heap, at the first update
+} _battery;
+
+static uint8_t _movement_battery_life_percent(uint16_t millivolts) {
+    if (millivolts >= _curve[0].millivolts) return 100;
+    for (uint8_t i = 1; i < sizeof(_curve) / sizeof(_curve[0]); i++) {
+        if (millivolts >= _curve[i].millivolts) {
+            // straight lines between the points.
+            uint16_t span = _curve[i - 1].millivolts - _curve[i].millivolts;
+            return _curve[i].percent + (uint32_t)(_curve[i - 1].percent - _curve[i].percent) * (millivolts - _curve[i].millivolts) / span;
+        }
+    }
+    return 0;
+}
+
+static void _movement_battery_life_average(uint32_t *average, uint32_t day) {
+    if (_battery.estimate.days == 0) *average = day;
+    else *average = *average - (*average >> DAY_WEIGHT_SHIFT) + (day >> DAY_WEIGHT_SHIFT);
+}
+
+// fills in what the faces, the LED and the buzzer used since the last update, scaled by scale; the first time, it only
+// takes note of where the stats stand.
+static void _movement_battery_life_take_face_stats(uint32_t *day, float scale, bool first) {
+    const movement_face_stats_t *stats;
+    float faces = 0;
+    uint32_t led_ticks = 0;
+    uint32_t buzzer_ticks = 0;
+    float seconds_per_cycle = 1.0f / watch_get_cycle_counter_frequency();
+
+    if (_battery.faces == NULL) {
+        while (movement_get_face_stats(_battery.num_faces) != NULL) _battery.num_faces++;
+        _battery.faces = calloc(_battery.num_faces, sizeof(battery_life_face_t));
+        // without the room, there's no telling the faces apart, but what they use together still counts.
+        if (_battery.faces == NULL) _battery.num_faces = 0;
+    }
+
+    for (uint8_t i = 0; (stats = movement_get_face_stats(i)) != NULL; i++) {
+        led_ticks += stats->led_ticks;
+        buzzer_ticks += stats->buzzer_ticks;
+        if (i >= _battery.num_faces) continue;
+        battery_life_face_t *face = &_battery.faces[i];
+        // fewer calls than last time means the stats were reset, and everything in them is new. the cycle count can
+        // wrap, but not twice in a day.
+        bool reset = stats->loop_calls < face->loop_calls;
+        uint32_t calls = reset ? stats->loop_calls : stats->loop_calls - face->loop_calls;
+        uint32_t cycles = reset ? stats->active_cycles : stats->active_cycles - face->active_cycles;
+        face->loop_calls = stats->loop_calls;
+        face->active_cycles = stats->active_cycles;
+        if (first) continue;
+        float charge = (calls * WATCH_ENERGY_WAKE_UAS + cycles * seconds_per_cycle * WATCH_ENERGY_ACTIVE_UA) * scale;
+        _movement_battery_life_average(&face->daily_use, charge);
+        faces += charge;
+    }
+
+    uint32_t new_led_ticks = led_ticks < _battery.led_ticks ? led_ticks : led_ticks - _battery.led_ticks;
+    uint32_t new_buzzer_ticks = buzzer_ticks < _battery.buzzer_ticks ? buzzer_ticks : buzzer_ticks - _battery.buzzer_ticks;
+    _battery.led_ticks = led_ticks;
+    _battery.buzzer_ticks = buzzer_ticks;
+    day[MOVEMENT_BATTERY_USE_FACES] = faces;
+    day[MOVEMENT_BATTERY_USE_LED] = new_led_ticks / 128.0f * LED_UA * scale;
+    day[MOVEMENT_BATTERY_USE_BUZZER] = new_buzzer_ticks / 64.0f * WATCH_ENERGY_BUZZER_UA * scale;
+}
+
+static void _movement_battery_life_update(uint32_t now) {
+    bool first = _battery.last_update == 0 || now <= _battery.last_update || now - _battery.last_update > MAX_DAY_SECONDS;
+    uint32_t seconds = now - _battery.last_update;
+    // a day that wasn't quite a day (the first, say, which began at boot) is scaled to one, so that the average is of
+    // days.
+    float scale = first ? 0 : (float)SECONDS_PER_DAY / seconds;
+    movement_battery_life_t *estimate = &_battery.estimate;
+    uint32_t day[MOVEMENT_BATTERY_NUM_USES];
+
+    _movement_battery_life_take_face_stats(day, scale, first);
+    day[MOVEMENT_BATTERY_USE_STANDBY] = SECONDS_PER_DAY * WATCH_ENERGY_STANDBY_UA;
+    day[MOVEMENT_BATTERY_USE_SENSORS] = 60 * scale * (_battery.streaming_minutes * MOVEMENT_BATTERY_ACCELEROMETER_STREAMING_UA +
+                                                      _battery.motion_minutes * MOVEMENT_BATTERY_ACCELEROMETER_MOTION_UA);
+    day[MOVEMENT_BATTERY_USE_USB] = 60 * scale * _battery.usb_minutes * WATCH_ENERGY_USB_UA;
+    _battery.streaming_minutes = 0;
+    _battery.motion_minutes = 0;
+    _battery.usb_minutes = 0;
+    _battery.last_update = now;
+
+    estimate->voltage = movement_get_battery_voltage();
+    if (estimate->voltage) {
+        if (_battery.num_voltages == MOVEMENT_BATTERY_TREND_DAYS) {
+            memmove(_battery.voltages, _battery.voltages + 1, sizeof(_battery.voltages) - sizeof(_battery.voltages[0]));
+            _battery.num_voltages--;
+        }
+        _battery.voltages[_battery.num_voltages++] = estimate->voltage;
+        estimate->percent_left = _movement_battery_life_percent(estimate->voltage);
+    }
+    if (first) return;
+
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < MOVEMENT_BATTERY_NUM_USES; i++) {
+        _movement_battery_life_average(&estimate->daily_use[i], day[i]);
+        total += estimate->daily_use[i];
+    }
+    if (estimate->days < UINT8_MAX) estimate->days++;
+
+    uint32_t days_left = (uint64_t)MOVEMENT_BATTERY_CAPACITY_MAH * UAS_PER_MAH * estimate->percent_left / 100 / (total ? total : 1);
+    estimate->days_left = days_left > UINT16_MAX - 1 ? UINT16_MAX - 1 : days_left;
+
+    estimate->trend_days_left = UINT16_MAX;
+    estimate->mv_per_week = 0;
+    if (_battery.num_voltages > 1) {
+        int32_t fall = (int32_t)_battery.voltages[0] - _battery.voltages[_battery.num_voltages - 1];
+        uint8_t span = _battery.num_voltages - 1;
+        estimate->mv_per_week = fall * 7 / span;
+        // the ADC wobbles by a few millivolts from one day to the next, so a fall smaller than that isn't one.
+        if (fall > 10) {
+            int32_t left = (int32_t)estimate->voltage - _curve[sizeof(_curve) / sizeof(_curve[0]) - 1].millivolts;
+            uint32_t trend_days = left > 0 ? (uint32_t)left * span / fall : 0;
+            estimate->trend_days_left = trend_days > UINT16_MAX - 1 ? UINT16_MAX - 1 : trend_days;
+        }
+    }
+}
+
+const movement_battery_life_t *movement_battery_life_get(void) {
+    return &_battery.estimate;
+}
+
+uint32_t movement_battery_life_get_face_use(uint8_t watch_face_index) {
+    if (watch_face_index >= _battery.num_faces) return 0;
+    return _battery.faces[watch_face_index].daily_use;
+}
+
+void movement_battery_life_minute(void) {
+    if (movement_accelerometer_is_streaming()) _battery.streaming_minutes++;
+    else if (movement_accelerometer_is_detecting_motion()) _battery.motion_minutes++;
+    if (watch_is_usb_enabled()) _battery.usb_minutes++;
+
+    watch_date_time date_time = watch_rtc_get_date_time();
+    if (date_time.unit.day == _battery.last_day && _battery.last_update) return;
+    _battery.last_day = date_time.unit.day;
+    // local time as if it were UTC: only the time between updates counts.
+    _movement_battery_life_update(watch_utility_date_time_to_unix_time(date_time, 0));
+}
@@ -0,0 +1,91 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MOVEMENT_BATTERY_LIFE_H_
+#define MOVEMENT_BATTERY_LIFE_H_
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief What the battery holds new, in mAh: a CR2016. */
+#ifndef MOVEMENT_BATTERY_CAPACITY_MAH
+#define MOVEMENT_BATTERY_CAPACITY_MAH 90
+#endif
+
+/** @brief What the accelerometer draws, in µA, while it streams samples and while it only watches for motion. The
+  *        sensor board isn't in the board's energy_costs.h, so these are here.
+  */
+#ifndef MOVEMENT_BATTERY_ACCELEROMETER_STREAMING_UA
+#define MOVEMENT_BATTERY_ACCELEROMETER_STREAMING_UA 20
+#endif
+#ifndef MOVEMENT_BATTERY_ACCELEROMETER_MOTION_UA
+#define MOVEMENT_BATTERY_ACCELEROMETER_MOTION_UA 1
+#endif
+
+/** @brief Days of battery readings the voltage trend looks back over. */
+#define MOVEMENT_BATTERY_TREND_DAYS 8
+
+/** @brief Where the battery goes. */
+typedef enum {
+    MOVEMENT_BATTERY_USE_STANDBY = 0,   // the LCD and RTC, which run whatever else is going on
+    MOVEMENT_BATTERY_USE_FACES,         // waking up for the faces, and the time the CPU spends in their loops
+    MOVEMENT_BATTERY_USE_LED,
+    MOVEMENT_BATTERY_USE_BUZZER,
+    MOVEMENT_BATTERY_USE_SENSORS,       // the accelerometer, while anything has it running
+    MOVEMENT_BATTERY_USE_USB,           // the time spent plugged in, as if it came from the battery
+    MOVEMENT_BATTERY_NUM_USES
+} movement_battery_use_t;
+
+/** @brief What the estimator makes of the battery, as of the last day it finished. */
+typedef struct {
+    uint8_t days;               // days of accounting behind the figures below; 0 until the first day is over
+    uint8_t percent_left;       // of MOVEMENT_BATTERY_CAPACITY_MAH, going by the voltage
+    uint16_t voltage;           // the day's battery reading, in millivolts
+    int16_t mv_per_week;        // how fast the voltage has been falling, over up to MOVEMENT_BATTERY_TREND_DAYS
+    uint16_t days_left;         // at the rate of use below, from what the voltage says is left
+    uint16_t trend_days_left;   // at the rate the voltage is falling; UINT16_MAX if it hasn't fallen measurably
+    uint32_t daily_use[MOVEMENT_BATTERY_NUM_USES];  // a day's use of each, in µA·s, averaged over recent days
+} movement_battery_life_t;
+
+/** @brief Returns the estimate, which Movement brings up to date once a day.
+  * @details Each day Movement charges what the watch did at the rates in the board's energy_costs.h: standby for
+  *          the whole day, a wake for each call to a face's loop plus the cycles it took (@see movement_face_stats_t),
+  *          the LED and buzzer for the time they were on, and the accelerometer and USB for the minutes they were in
+  *          use, checked at the top of each minute. The day's figures go into a running average that favours
+  *          recent days. days_left divides what's left of the battery, judged from its voltage on a lithium coin
+  *          cell's curve, by the average day's use; trend_days_left is how long until the curve runs out, at 2.0 V,
+  *          at the rate the voltage has fallen. A coin cell's voltage hardly moves for most of its life, so the first
+  *          is the one to go by until the last few weeks, when the second catches up. Neither is better than the
+  *          current figures it's built on: good for seeing which faces cost the most, and for a rough answer.
+  */
+const movement_battery_life_t *movement_battery_life_get(void);
+
+/** @brief Returns a face's share of MOVEMENT_BATTERY_USE_FACES: its average day's use, in µA·s. */
+uint32_t movement_battery_life_get_face_use(uint8_t watch_face_index);
+
+/** @brief Counts the minute for the accelerometer and USB, and at the start of a new day, brings the estimate up to
+  *        date. Movement calls this at the top of every minute, after it reads the battery; faces don't need to.
+  */
+void movement_battery_life_minute(void);
+
+#endif // MOVEMENT_BATTERY_LIFE_H_
@@ -0,0 +1,330 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "movement_chirpy.h"
+#include "movement.h"
+
+#define MOVEMENT_CHIRPY_NO_BLOCK 0xFF
+
+// the ticks each tone lasts, for each movement_chirpy_rate_t.
+static const uint8_t _ticks_per_tone[] = {3, 2};
+
+// the sequencer asks for the first block as soon as the transmission gets its turn, and a tick of silence fills in for
+// a block that isn't ready yet.
+static const watch_buzzer_note_t _no_notes[] = {{0, 0}};
+static const watch_buzzer_note_t _silence[] = {{0, 1}, {0, 0}};
+
+static chirpy_encoder_state_t _encoder;
+static chirpy_get_next_byte_t _get_next_byte;
+static void (*_on_done)(void);
+static uint8_t _tone_ticks;
+
+// two blocks of notes, each with room for its end marker: one playing while the main loop fills the other.
+static watch_buzzer_note_t (*_blocks)[MOVEMENT_CHIRPY_BLOCK_NOTES + 1];
+static volatile bool _block_ready[2];
+// the block the sequencer is playing, and the one it plays next; the main loop fills them in the same order.
+static volatile uint8_t _playing_block;
+static volatile uint8_t _next_block;
+static uint8_t _fill_block;
+static volatile bool _encoded_all;
+
+// from movement_chirpy_start until the sequencer has asked for a block and been told there are no more.
+static volatile bool _sending;
+static volatile bool _started;
+static volatile bool _finished;
+static volatile bool _stopped;
+static volatile bool _needs_service;
+
+static movement_chirpy_report_t _report;
+static uint8_t _block_crc;
+static uint8_t _block_bytes;
+
+// where a log being sent has got to (@see movement_chirpy_send_log); allocated along with the blocks.
+typedef struct {
+    movement_log_t *log;
+    bool compressed;
+    uint8_t header[7 + MOVEMENT_LOG_NAME_MAX];
+    uint8_t header_length;
+    uint8_t header_pos;
+    uint32_t count;             // records in the log when we started
+    uint32_t next_record;       // records read so far, oldest first
+    uint8_t record[MOVEMENT_LOG_BUFFER_SIZE];
+    uint8_t previous[MOVEMENT_LOG_BUFFER_SIZE];
+    uint8_t record_pos;
+    int16_t queued;             // a byte to send before reading on (the length of a zero run), or -1
+    bool lookahead_valid;       // set if reading to the end of a zero run read one byte too many
+    uint8_t lookahead;
+} movement_chirpy_log_state_t;
+
+static movement_chirpy_log_state_t *_log_state;
+
+static uint8_t _movement_chirpy_next_byte(uint8_t *next_byte) {
+    // the encoder sends a CRC after every block_size bytes and after the last; keep count of them for the report.
+    if (!_get_next_byte(next_byte)) {
+        if (_block_bytes) {
+            _report.blocks++;
+            _report.last_block_crc = _block_crc;
+            _block_bytes = 0;
+        }
+        return 0;
+    }
+    _report.bytes++;
+    if (_log_state == NULL) _report.raw_bytes++;
+    _block_crc = chirpy_update_crc8(*next_byte, _block_crc);
+    if (++_block_bytes == _encoder.block_size) {
+        _report.blocks++;
+        _report.last_block_crc = _block_crc;
+        _block_crc = 0;
+        _block_bytes = 0;
+    }
+    return 1;
+}
+
+static void _movement_chirpy_fill_blocks(void) {
+    while (!_encoded_all && !_block_ready[_fill_block]) {
+        watch_buzzer_note_t *notes = _blocks[_fill_block];
+        uint8_t count = 0;
+        while (count < MOVEMENT_CHIRPY_BLOCK_NOTES) {
+            uint8_t tone = chirpy_get_next_tone(&_encoder);
+            if (tone == 255) {
+                _encoded_all = true;
+                break;
+            }
+            uint16_t period = chirpy_get_tone_period(tone);
+            // the same tone again is the same sound carrying on, so it can share a note.
+            if (count && notes[count - 1].period == period) {
+                notes[count - 1].ticks += _tone_ticks;
+            } else {
+                notes[count].period = period;
+                notes[count].ticks = _tone_ticks;
+                count++;
+            }
+            _report.ticks += _tone_ticks;
+        }
+        notes[count].period = 0;
+        notes[count].ticks = 0;
+        if (count == 0) break;
+        // the block has to be marked ready before the sequencer can see that everything's been encoded.
+        _block_ready[_fill_block] = true;
+        _fill_block ^= 1;
+    }
+}
+
+static const watch_buzzer_note_t *_movement_chirpy_next_notes(void) {
+    // runs in the sequencer's interrupt, so it only hands over blocks; the main loop encodes them.
+    _started = true;
+    if (_playing_block != MOVEMENT_CHIRPY_NO_BLOCK) {
+        _block_ready[_playing_block] = false;
+        _playing_block = MOVEMENT_CHIRPY_NO_BLOCK;
+        _needs_service = true;
+    }
+    if (_stopped) {
+        _sending = false;
+        _needs_service = true;
+        return NULL;
+    }
+    if (_block_ready[_next_block]) {
+        _playing_block = _next_block;
+        _next_block ^= 1;
+        return _blocks[_playing_block];
+    }
+    if (_encoded_all) {
+        _sending = false;
+        _finished = true;
+        _needs_service = true;
+        return NULL;
+    }
+    _report.underruns++;
+    _report.ticks++;
+    return _silence;
+}
+
+static void _movement_chirpy_free(void) {
+    free(_blocks);
+    _blocks = NULL;
+    free(_log_state);
+    _log_state = NULL;
+}
+
+static bool _movement_chirpy_next_record_byte(uint8_t *byte) {
+    movement_chirpy_log_state_t *state = _log_state;
+    uint8_t record_size = state->log->record_size;
+    if (state->record_pos == record_size) {
+        if (state->next_record == state->count) return false;
+        // records appended since we started move the ones we're after further from the newest.
+        uint32_t count = movement_log_count(state->log);
+        uint32_t appended = count > state->count ? count - state->count : 0;
+        memcpy(state->previous, state->record, record_size);
+        if (!movement_log_read(state->log, state->count - 1 - state->next_record + appended, state->record)) return false;
+        state->next_record++;
+        state->record_pos = 0;
+    }
+    uint8_t value = state->record[state->record_pos];
+    *byte = state->compressed ? (uint8_t)(value - state->previous[state->record_pos]) : value;
+    state->record_pos++;
+    _report.raw_bytes++;
+    return true;
+}
+
+static uint8_t _movement_chirpy_next_log_byte(uint8_t *next_byte) {
+    movement_chirpy_log_state_t *state = _log_state;
+    if (state->header_pos < state->header_length) {
+        *next_byte = state->header[state->header_pos++];
+        _report.raw_bytes++;
+        return 1;
+    }
+    if (state->queued >= 0) {
+        *next_byte = state->queued;
+        state->queued = -1;
+        return 1;
+    }
+
+    uint8_t value;
+    if (state->lookahead_valid) {
+        value = state->lookahead;
+        state->lookahead_valid = false;
+    } else if (!_movement_chirpy_next_record_byte(&value)) {
+        return 0;
+    }
+    if (!state->compressed || value != 0) {
+        *next_byte = value;
+        return 1;
+    }
+
+    // a run of zeros goes out as a zero and the length of the run.
+    uint8_t run = 1;
+    while (run < 255 && _movement_chirpy_next_record_byte(&value)) {
+        if (value) {
+            state->lookahead = value;
+            state->lookahead_valid = true;
+            break;
+        }
+        run++;
+    }
+    *next_byte = 0;
+    state->queued = run;
+    return 1;
+}
+
+bool movement_chirpy_start(chirpy_get_next_byte_t get_next_byte, movement_chirpy_rate_t rate, void (*on_done)(void)) {
+    // a stopped transmission that was still waiting its turn hasn't let go of the sequencer yet.
+    if (_sending || _blocks) return false;
+    _blocks = malloc(2 * sizeof(*_blocks));
+    if (_blocks == NULL) return false;
+
+    memset(&_report, 0, sizeof(_report));
+    _block_crc = 0;
+    _block_bytes = 0;
+    _get_next_byte = get_next_byte;
+    _on_done = on_done;
+    _tone_ticks = _ticks_per_tone[rate <= MOVEMENT_CHIRPY_RATE_FAST ? rate : MOVEMENT_CHIRPY_RATE_NORMAL];
+    chirpy_init_encoder(&_encoder, _movement_chirpy_next_byte);
+    _block_ready[0] = _block_ready[1] = false;
+    _playing_block = MOVEMENT_CHIRPY_NO_BLOCK;
+    _next_block = 0;
+    _fill_block = 0;
+    _encoded_all = false;
+    _started = _finished = _stopped = _needs_service = false;
+
+    _movement_chirpy_fill_blocks();
+    _sending = true;
+    if (!movement_play_notes(_no_notes, _movement_chirpy_next_notes)) {
+        _sending = false;
+        _movement_chirpy_free();
+        return false;
+    }
+    return true;
+}
+
+bool movement_chirpy_send_log(movement_log_t *log, bool compress, movement_chirpy_rate_t rate, void (*on_done)(void)) {
+    if (_sending || _blocks) return false;
+    movement_chirpy_log_state_t *state = malloc(sizeof(movement_chirpy_log_state_t));
+    if (state == NULL) return false;
+
+    memset(state, 0, sizeof(movement_chirpy_log_state_t));
+    state->log = log;
+    state->compressed = compress;
+    state->count = movement_log_count(log);
+    if (state->count > 0xFFFF) state->count = 0xFFFF;
+    // the first read loads the oldest record, with nothing before it to take the difference from.
+    state->record_pos = log->record_size;
+    state->queued = -1;
+    uint8_t name_length = strlen(log->name);
+    uint8_t *header = state->header;
+    header[0] = MOVEMENT_CHIRPY_LOG_PREFIX;
+    header[1] = MOVEMENT_CHIRPY_LOG_VERSION;
+    header[2] = compress ? 1 : 0;
+    header[3] = log->record_size;
+    header[4] = state->count >> 8;
+    header[5] = state->count & 0xFF;
+    header[6] = name_length;
+    memcpy(header + 7, log->name, name_length);
+    state->header_length = 7 + name_length;
+
+    _log_state = state;
+    if (!movement_chirpy_start(_movement_chirpy_next_log_byte, rate, on_done)) {
+        free(_log_state);
+        _log_state = NULL;
+        return false;
+    }
+    return true;
+}
+
+void movement_chirpy_stop(void) {
+    if (!_sending) return;
+    _stopped = true;
+    if (_started) {
+        // it's playing, so cut it off; if it's still waiting its turn, it'll end as soon as it gets it.
+        _sending = false;
+        movement_stop_tune();
+    }
+    // the blocks stay until we know the sequencer is done with them.
+    _needs_service = true;
+}
+
+bool movement_chirpy_is_sending(void) {
+    return _sending && !_stopped;
+}
+
+void movement_chirpy_get_report(movement_chirpy_report_t *report) {
+    *report = _report;
+    report->bytes_per_second = _report.ticks ? (uint32_t)_report.bytes * 64 / _report.ticks : 0;
+}
+
+bool movement_chirpy_needs_service(void) {
+    return _needs_service;
+}
+
+void movement_chirpy_service(void) {
+    _needs_service = false;
+    if (_blocks == NULL) return;
+    if (_sending) {
+        if (!_stopped) _movement_chirpy_fill_blocks();
+        return;
+    }
+    _movement_chirpy_free();
+    if (_finished && _on_done) _on_done();
+}
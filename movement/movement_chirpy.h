@@ -0,0 +1,106 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MOVEMENT_CHIRPY_H_
+#define MOVEMENT_CHIRPY_H_
+#include <stdint.h>
+#include <stdbool.h>
+#include "chirpy_tx.h"
+#include "movement_log.h"
+
+/** @brief Most notes in each of the two blocks of tones the service keeps ready. A run of the same tone takes one. */
+#ifndef MOVEMENT_CHIRPY_BLOCK_NOTES
+#define MOVEMENT_CHIRPY_BLOCK_NOTES 32
+#endif
+
+typedef enum {
+    MOVEMENT_CHIRPY_RATE_NORMAL = 0,    ///< A tone every 3 ticks of 64 Hz, about 21 a second: what Chirpy RX listens for.
+    MOVEMENT_CHIRPY_RATE_FAST,          ///< A tone every 2 ticks, 32 a second. The receiver has to be listening for it.
+} movement_chirpy_rate_t;
+
+typedef struct {
+    uint16_t bytes;             // data bytes sent so far
+    uint16_t raw_bytes;         // what they came to before compression; the same as bytes, unless a log was compressed
+    uint16_t blocks;            // blocks of data sent, each of which is followed by its CRC
+    uint8_t last_block_crc;     // the CRC sent after the last block, for comparing with what the receiver got
+    uint16_t underruns;         // times the next tones weren't ready in time, and a tick of silence went in
+    uint32_t ticks;             // 64 Hz ticks of tones sent so far, the silence included
+    uint16_t bytes_per_second;  // bytes divided by the time they took to send
+} movement_chirpy_report_t;
+
+/** @brief Sends data over the buzzer, as the tones Chirpy RX decodes, without the face having to time them.
+  * @details The service encodes a block of tones ahead, from the main loop, and hands it to the buzzer sequencer
+  *          (@see movement_play_notes), which plays it from its timer with one interrupt per change of tone, and
+  *          picks up the next block without a gap. The face can stand by and tick at any rate meanwhile. The
+  *          transmission waits for any tune that is already playing, and a tune that comes up while it's sending
+  *          waits for it to finish.
+  * @param get_next_byte Called from the main loop for each byte to send, a block or so before it's heard.
+  * @param rate How fast to send the tones.
+  * @param on_done Called from the main loop once the last tone has played; not called if the face stops it.
+  * @return true if the transmission has started; false if one is already going, or there was no room for it.
+  */
+bool movement_chirpy_start(chirpy_get_next_byte_t get_next_byte, movement_chirpy_rate_t rate, void (*on_done)(void));
+
+/** @brief The first byte of a log sent with movement_chirpy_send_log; the second is MOVEMENT_CHIRPY_LOG_VERSION.
+  * @details Then come a byte of flags (bit 0: compressed), the record size, the number of records (two bytes, high
+  *          byte first), the length of the log's name and the name itself. The records follow, oldest first. If they
+  *          are compressed, each byte is sent as its difference (mod 256) from the same byte of the record before,
+  *          the first record's from zero, and a run of zero differences is sent as a zero and the length of the run,
+  *          up to 255.
+  */
+#define MOVEMENT_CHIRPY_LOG_PREFIX 0x4C
+#define MOVEMENT_CHIRPY_LOG_VERSION 0x01
+
+/** @brief Sends every record in a log over the buzzer, like movement_chirpy_start does with a face's data.
+  * @details Records that change little from one to the next (timestamps an hour apart, a slowly drifting reading)
+  *          mostly come to runs of zeros once they're compressed, and the transfer takes that much less time; the
+  *          report's raw_bytes says how much. Records appended while the log is being sent aren't included.
+  * @param log The log to send. It must stay in memory until the transmission is over.
+  * @param compress true to send each record as its difference from the one before (@see MOVEMENT_CHIRPY_LOG_PREFIX).
+  * @param rate How fast to send the tones.
+  * @param on_done Called from the main loop once the last tone has played; not called if the face stops it.
+  * @return true if the transmission has started; false if one is already going, or there was no room for it.
+  */
+bool movement_chirpy_send_log(movement_log_t *log, bool compress, movement_chirpy_rate_t rate, void (*on_done)(void));
+
+/** @brief Stops sending, at once. Call it from your resign function if you started a transmission. */
+void movement_chirpy_stop(void);
+
+/** @brief Returns true from movement_chirpy_start until the last tone has played or it's been stopped. */
+bool movement_chirpy_is_sending(void);
+
+/** @brief Reports how the transmission is going, or how the last one went once it's over.
+  * @param report Filled in with the counts so far.
+  */
+void movement_chirpy_get_report(movement_chirpy_report_t *report);
+
+/** @brief Returns true if a block of tones has been played and the next one needs encoding. */
+bool movement_chirpy_needs_service(void);
+
+/** @brief Encodes the blocks that have been played with the next tones, and finishes off a transmission that's over.
+  * @details Movement calls this from its main loop.
+  */
+void movement_chirpy_service(void);
+
+#endif // MOVEMENT_CHIRPY_H_
@@ -0,0 +1,112 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "movement_clock.h"
+#include "watch_utility.h"
+
+// the fields of a watch_date_time's reg, from the seconds up.
+#define MOVEMENT_CLOCK_MINUTE_SHIFT 6
+#define MOVEMENT_CLOCK_HOUR_SHIFT 12
+#define MOVEMENT_CLOCK_DAY_SHIFT 17
+
+// where each field starts on the display.
+static const uint8_t movement_clock_positions[] = {
+    [MOVEMENT_CLOCK_CHANGED_SECOND] = 8,
+    [MOVEMENT_CLOCK_CHANGED_MINUTE] = 6,
+    [MOVEMENT_CLOCK_CHANGED_HOUR] = 4,
+    [MOVEMENT_CLOCK_CHANGED_DAY] = 0,
+};
+
+void movement_clock_activate(movement_clock_t *clock, movement_settings_t *settings) {
+    if (watch_tick_animation_is_running()) watch_stop_tick_animation();
+    if (settings->bit.clock_mode_24h) watch_set_indicator(WATCH_INDICATOR_24H);
+    else watch_clear_indicator(WATCH_INDICATOR_24H);
+    watch_set_colon();
+    movement_clock_invalidate(clock);
+}
+
+void movement_clock_invalidate(movement_clock_t *clock) {
+    // no date and time has every bit set, so nothing will match it.
+    clock->previous = 0xFFFFFFFF;
+}
+
+movement_clock_change_t movement_clock_update(movement_clock_t *clock, watch_date_time date_time) {
+    uint32_t previous = clock->previous;
+    clock->previous = date_time.reg;
+
+    if ((date_time.reg >> MOVEMENT_CLOCK_DAY_SHIFT) != (previous >> MOVEMENT_CLOCK_DAY_SHIFT)) return MOVEMENT_CLOCK_CHANGED_DAY;
+    if ((date_time.reg >> MOVEMENT_CLOCK_HOUR_SHIFT) != (previous >> MOVEMENT_CLOCK_HOUR_SHIFT)) return MOVEMENT_CLOCK_CHANGED_HOUR;
+    if ((date_time.reg >> MOVEMENT_CLOCK_MINUTE_SHIFT) != (previous >> MOVEMENT_CLOCK_MINUTE_SHIFT)) return MOVEMENT_CLOCK_CHANGED_MINUTE;
+    if (date_time.reg != previous) return MOVEMENT_CLOCK_CHANGED_SECOND;
+    return MOVEMENT_CLOCK_CHANGED_NOTHING;
+}
+
+uint8_t movement_clock_display_hour(movement_settings_t *settings, uint8_t hour) {
+    if (settings->bit.clock_mode_24h) return hour;
+    if (hour < 12) watch_clear_indicator(WATCH_INDICATOR_PM);
+    else watch_set_indicator(WATCH_INDICATOR_PM);
+    hour %= 12;
+    return hour ? hour : 12;
+}
+
+void movement_clock_draw_fields(movement_clock_change_t change, movement_settings_t *settings, watch_date_time date_time, const char *label, const char *after) {
+    char buf[11];
+    char *p = buf;
+    if (change >= MOVEMENT_CLOCK_CHANGED_DAY) {
+        p = watch_fmt_str(p, label ? label : watch_utility_get_weekday(date_time));
+        p = watch_fmt_2d(p, date_time.unit.day, ' ');
+    }
+    if (change >= MOVEMENT_CLOCK_CHANGED_HOUR) p = watch_fmt_2d(p, movement_clock_display_hour(settings, date_time.unit.hour), ' ');
+    p = watch_fmt_2d(p, date_time.unit.minute, '0');
+    watch_fmt_str(p, after);
+    watch_display_string(buf, movement_clock_positions[change]);
+}
+
+void movement_clock_draw(movement_clock_t *clock, movement_settings_t *settings, watch_date_time date_time, const char *label) {
+    movement_clock_change_t change = movement_clock_update(clock, date_time);
+
+    if (change == MOVEMENT_CLOCK_CHANGED_NOTHING) return;
+    if (change == MOVEMENT_CLOCK_CHANGED_SECOND) {
+        watch_display_2d(date_time.unit.second, 8, '0');
+        return;
+    }
+    char seconds[3];
+    watch_fmt_2d(seconds, date_time.unit.second, '0');
+    movement_clock_draw_fields(change, settings, date_time, label, seconds);
+}
+
+void movement_clock_draw_low_energy(movement_clock_t *clock, movement_settings_t *settings, watch_date_time date_time, const char *label) {
+    if (!watch_tick_animation_is_running()) watch_start_tick_animation(500);
+    movement_clock_draw_fields(MOVEMENT_CLOCK_CHANGED_DAY, settings, date_time, label, "  ");
+    // the seconds are blank now, so the next tick can't assume any field is still on screen.
+    movement_clock_invalidate(clock);
+}
+
+bool movement_clock_draw_next_minute(movement_settings_t *settings, watch_date_time date_time, const char *label) {
+    // the minute before this one is on screen, so only a new hour or day needs more than the minutes.
+    movement_clock_change_t change = MOVEMENT_CLOCK_CHANGED_MINUTE;
+    if (date_time.unit.minute == 0) change = date_time.unit.hour == 0 ? MOVEMENT_CLOCK_CHANGED_DAY : MOVEMENT_CLOCK_CHANGED_HOUR;
+    movement_clock_draw_fields(change, settings, date_time, label, "");
+    return true;
+}
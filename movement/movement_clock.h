@@ -0,0 +1,92 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MOVEMENT_CLOCK_H_
+#define MOVEMENT_CLOCK_H_
+#include "movement.h"
+
+/*
+ * The clock that most clock faces show: two characters of label (the weekday, unless the face has its own) in
+ * positions 0-1, the day in 2-3, and the time in 4-9, in 12 or 24 hour time as the settings say. It only redraws
+ * the fields that have changed since it last drew, and keeps the PM and 24H indicators and the colon.
+ *
+ * A face keeps a movement_clock_t in its context, calls movement_clock_activate from its activate, and hands
+ * EVENT_ACTIVATE and EVENT_TICK to movement_clock_draw and EVENT_LOW_ENERGY_UPDATE to movement_clock_draw_low_energy.
+ * Give movement_clock_draw_next_minute as (or from) the face's draw_low_energy, and Movement puts low energy mode's
+ * minutes up without waking the face at all.
+ */
+
+// the most significant field that has changed since the clock last drew; each one means the ones after it changed too.
+typedef enum {
+    MOVEMENT_CLOCK_CHANGED_NOTHING = 0,
+    MOVEMENT_CLOCK_CHANGED_SECOND,
+    MOVEMENT_CLOCK_CHANGED_MINUTE,
+    MOVEMENT_CLOCK_CHANGED_HOUR,
+    MOVEMENT_CLOCK_CHANGED_DAY,     // or the month or year: everything needs drawing
+} movement_clock_change_t;
+
+typedef struct {
+    uint32_t previous;  // the date and time on screen, as a watch_date_time's reg; 0xFFFFFFFF for nothing yet
+} movement_clock_t;
+
+/// @brief Sets up the indicators and colon, and has the next draw start from scratch. Call from the face's activate.
+void movement_clock_activate(movement_clock_t *clock, movement_settings_t *settings);
+
+/// @brief Has the next draw start from scratch, as after the face has drawn something else over the clock.
+void movement_clock_invalidate(movement_clock_t *clock);
+
+/** @brief Remembers date_time as what's on screen, and returns what has changed since the last time. For faces that
+  *        show something other than movement_clock_draw's layout, but still want to draw only what changed.
+  */
+movement_clock_change_t movement_clock_update(movement_clock_t *clock, watch_date_time date_time);
+
+/** @brief Returns an hour to show: the hour itself in 24 hour mode, or 1 to 12 in 12 hour mode, in which case it
+  *        also sets or clears the PM indicator.
+  */
+uint8_t movement_clock_display_hour(movement_settings_t *settings, uint8_t hour);
+
+/** @brief Draws the fields of date_time from change down to the minutes, in movement_clock_draw's layout, followed by
+  *        after in positions 8-9 (which may be empty, to leave them be). For faces that show something of their own
+  *        in place of the seconds; change is what movement_clock_update returned, and must be
+  *        MOVEMENT_CLOCK_CHANGED_MINUTE or more.
+  */
+void movement_clock_draw_fields(movement_clock_change_t change, movement_settings_t *settings, watch_date_time date_time, const char *label, const char *after);
+
+/** @brief Draws date_time, redrawing only the fields that have changed since the last draw.
+  * @param label Two characters for positions 0-1, or NULL for the weekday. Invalidate the clock if it changes.
+  */
+void movement_clock_draw(movement_clock_t *clock, movement_settings_t *settings, watch_date_time date_time, const char *label);
+
+/** @brief Draws date_time without the seconds, and starts the tick animation in their place, for
+  *        EVENT_LOW_ENERGY_UPDATE. The next movement_clock_draw starts from scratch.
+  */
+void movement_clock_draw_low_energy(movement_clock_t *clock, movement_settings_t *settings, watch_date_time date_time, const char *label);
+
+/** @brief Draws the minute date_time over the minute before it as movement_clock_draw_low_energy left it, redrawing
+  *        only what changed: for a face's draw_low_energy (@see watch_face_draw_low_energy).
+  * @return true, as draw_low_energy returns.
+  */
+bool movement_clock_draw_next_minute(movement_settings_t *settings, watch_date_time date_time, const char *label);
+
+#endif // MOVEMENT_CLOCK_H_
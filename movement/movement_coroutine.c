@@ -0,0 +1,60 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "movement_coroutine.h"
+#include "watch.h"
+
+// only one async transfer is in flight at a time, so one coroutine at most is waiting on the bus.
+static movement_coroutine_t *_i2c_waiter;
+
+static void _movement_co_i2c_done(bool success) {
+    movement_coroutine_t *co = _i2c_waiter;
+    _i2c_waiter = NULL;
+    if (co == NULL) return;
+    co->i2c_ok = success;
+    co->i2c_state = MOVEMENT_CO_I2C_DONE;
+    movement_queue_resume();
+}
+
+void movement_co_feed(movement_coroutine_t *co, movement_event_t event) {
+    co->event = event;
+    if (event.event_type != EVENT_TICK || co->timer_ms == 0) return;
+    // a face that asks for its ticks one at a time gets them no faster than once a second.
+    uint8_t frequency = movement_get_tick_frequency();
+    uint32_t elapsed = frequency ? 1000 / frequency : 1000;
+    co->timer_ms = co->timer_ms > elapsed ? co->timer_ms - elapsed : 0;
+}
+
+bool movement_co_start_i2c(movement_coroutine_t *co, int16_t addr, uint8_t *tx_buf, uint16_t tx_length,
+                           uint8_t *rx_buf, uint16_t rx_length) {
+    if (_i2c_waiter != NULL || watch_i2c_is_busy()) return false;
+    // claim the callback first: a short transfer can end before watch_i2c_transfer_async returns.
+    co->i2c_state = MOVEMENT_CO_I2C_BUSY;
+    _i2c_waiter = co;
+    if (watch_i2c_transfer_async(addr, tx_buf, tx_length, rx_buf, rx_length, _movement_co_i2c_done)) return true;
+    _i2c_waiter = NULL;
+    co->i2c_state = MOVEMENT_CO_I2C_IDLE;
+    return false;
+}
@@ -0,0 +1,149 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef MOVEMENT_COROUTINE_H_
+#define MOVEMENT_COROUTINE_H_
+#include <stdint.h>
+#include <stdbool.h>
+#include "movement.h"
+
+/* Coroutines for watch faces: a way to write a sequence of steps that each wait on something (a button, a stretch of
+ * time, an I2C transfer) as straight-line code, instead of a state machine over the events the face's loop gets.
+ *
+ * They're stackless, like protothreads: a coroutine is a function whose body sits between MOVEMENT_CO_BEGIN and
+ * MOVEMENT_CO_END, and each MOVEMENT_CO_AWAIT_ returns from it, leaving a note in its movement_coroutine_t of where
+ * to carry on. The face calls the function from its loop with every event it gets, and the function picks up at the
+ * wait it left off at, checks whether what it was waiting for has happened, and goes on or returns again. So a
+ * coroutine costs the few bytes of its movement_coroutine_t, which lives in the face's context, and no stack of its
+ * own. Anything that has to last across a wait, loop counters included, must live in the context too: locals lose
+ * their values at every wait. A wait can't sit inside a switch statement of the coroutine's own.
+ *
+ *     static bool _my_face_run(my_face_state_t *state) {
+ *         MOVEMENT_CO_BEGIN(&state->co);
+ *         watch_display_text(WATCH_POSITION_BOTTOM, "PrESS");
+ *         MOVEMENT_CO_AWAIT_BUTTON(&state->co, EVENT_ALARM_BUTTON_UP);
+ *         MOVEMENT_CO_AWAIT_I2C(&state->co, MY_ADDRESS, state->tx, 1, state->rx, 2);
+ *         if (!state->co.i2c_ok) MOVEMENT_CO_EXIT(&state->co);
+ *         ...
+ *         MOVEMENT_CO_AWAIT_TIMER(&state->co, 500);
+ *         ...
+ *         MOVEMENT_CO_END(&state->co);
+ *     }
+ *
+ *     bool my_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
+ *         my_face_state_t *state = (my_face_state_t *)context;
+ *         if (event.event_type == EVENT_ACTIVATE) movement_co_reset(&state->co);
+ *         movement_co_feed(&state->co, event);
+ *         _my_face_run(state);
+ *         ...
+ *         return movement_default_loop_handler(event, settings);
+ *     }
+ *
+ * The coroutine sees the events the face hands it, and the face still does what it likes with them afterwards,
+ * MODE included. A coroutine that returns from a wait has nothing to do until its next event; Movement queues
+ * EVENT_RESUME for the face on screen when an I2C transfer ends, and a timer counts down on the face's ticks.
+ */
+
+/// Where a coroutine that has run to its end, or was exited, stays; it does nothing more until it's reset.
+#define MOVEMENT_CO_DONE 0xFFFF
+
+typedef struct {
+    uint16_t line;                  // where to carry on: 0 at the start, or the line of the wait it's in
+    volatile uint8_t i2c_state;     // the transfer MOVEMENT_CO_AWAIT_I2C is waiting on, as set from its interrupt
+    bool i2c_ok;                    // whether the last transfer was acknowledged all the way through
+    uint32_t timer_ms;              // what's left of MOVEMENT_CO_AWAIT_TIMER's wait
+    movement_event_t event;         // the event it's being run for, from movement_co_feed
+} movement_coroutine_t;
+
+/** @brief Starts a coroutine over from the top, e.g. when the face activates. */
+static inline void movement_co_reset(movement_coroutine_t *co) {
+    co->line = 0;
+}
+
+/** @brief Whether the coroutine has run to its end, or exited. */
+static inline bool movement_co_is_done(const movement_coroutine_t *co) {
+    return co->line == MOVEMENT_CO_DONE;
+}
+
+/** @brief Hands the coroutine the event the face is handling; call it before running the coroutine with that event.
+  * @details Also counts an EVENT_TICK against any timer the coroutine is waiting on, at the face's tick rate.
+  */
+void movement_co_feed(movement_coroutine_t *co, movement_event_t event);
+
+/** @brief Starts the transfer for MOVEMENT_CO_AWAIT_I2C; faces don't need to call this themselves.
+  * @return false if another async transfer is in flight, in which case the wait tries again at the next event.
+  */
+bool movement_co_start_i2c(movement_coroutine_t *co, int16_t addr, uint8_t *tx_buf, uint16_t tx_length,
+                           uint8_t *rx_buf, uint16_t rx_length);
+
+// the states of i2c_state.
+#define MOVEMENT_CO_I2C_IDLE 0
+#define MOVEMENT_CO_I2C_BUSY 1
+#define MOVEMENT_CO_I2C_DONE 2
+
+/// Opens a coroutine's body, in a function that returns bool: true while it's waiting, false once it's done.
+#define MOVEMENT_CO_BEGIN(co) switch ((co)->line) { case 0:
+
+/// Closes a coroutine's body; getting here finishes it.
+#define MOVEMENT_CO_END(co) } (co)->line = MOVEMENT_CO_DONE; return false
+
+/// Finishes the coroutine early, from anywhere in its body.
+#define MOVEMENT_CO_EXIT(co) do { (co)->line = MOVEMENT_CO_DONE; return false; } while (0)
+
+/// Returns until condition is true, checking it again each time the coroutine runs.
+#define MOVEMENT_CO_AWAIT(co, condition) do { \
+    (co)->line = __LINE__; __attribute__((fallthrough)); case __LINE__: \
+    if (!(condition)) return true; \
+} while (0)
+
+/// Returns, and carries on from here the next time the coroutine runs, whatever the event.
+#define MOVEMENT_CO_YIELD(co) do { \
+    (co)->line = __LINE__; return true; case __LINE__:; \
+} while (0)
+
+/// Waits for an event of the given type, e.g. EVENT_ALARM_BUTTON_UP; the event that ended the wait is (co)->event.
+#define MOVEMENT_CO_AWAIT_BUTTON(co, type) do { \
+    MOVEMENT_CO_YIELD(co); \
+    if ((co)->event.event_type != (type)) return true; \
+} while (0)
+
+/** Waits at least ms milliseconds, counted in the EVENT_TICKs the face gets, so it's only as fine as the face's tick
+  * rate: ask for a faster tick (@see movement_request_tick_frequency) for shorter waits. */
+#define MOVEMENT_CO_AWAIT_TIMER(co, ms) do { \
+    (co)->timer_ms = (ms); \
+    MOVEMENT_CO_AWAIT(co, (co)->timer_ms == 0); \
+} while (0)
+
+/** Runs an I2C transfer (@see watch_i2c_transfer_async) and waits for it to end, leaving the result in
+  * (co)->i2c_ok. The buffers have to live in the face's context, or be static, since the wait outlasts any locals. */
+#define MOVEMENT_CO_AWAIT_I2C(co, addr, tx_buf, tx_length, rx_buf, rx_length) do { \
+    (co)->i2c_state = MOVEMENT_CO_I2C_IDLE; \
+    (co)->line = __LINE__; __attribute__((fallthrough)); case __LINE__: \
+    if ((co)->i2c_state == MOVEMENT_CO_I2C_IDLE && \
+        !movement_co_start_i2c(co, addr, tx_buf, tx_length, rx_buf, rx_length)) return true; \
+    if ((co)->i2c_state != MOVEMENT_CO_I2C_DONE) return true; \
+} while (0)
+
+#endif // MOVEMENT_COROUTINE_H_
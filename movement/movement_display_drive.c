@@ -0,0 +1,112 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdint.h>
+#include "movement_display_drive.h"
+#include "movement_sensors.h"
+#include "movement.h"
+#include "watch.h"
+
+typedef enum {
+    DRIVE_BAND_COLD = 0,
+    DRIVE_BAND_COOL,
+    DRIVE_BAND_WARM,
+    DRIVE_BAND_HOT,
+    DRIVE_NUM_BANDS
+} movement_display_drive_band_t;
+
+// where each band starts, in hundredths of a degree Celsius.
+static const int16_t _band_floors[DRIVE_NUM_BANDS] = { INT16_MIN, 0, 1500, 3500 };
+
+static bool _enabled;
+static movement_display_drive_band_t _band = DRIVE_BAND_COOL;
+// the build's settings, which the bands are steps from.
+static watch_display_drive_t _base;
+
+static movement_display_drive_band_t _movement_display_drive_band(int16_t temperature) {
+    movement_display_drive_band_t band = _band;
+    // past the next band's edge by the hysteresis to move up, or short of this one's by as much to move down.
+    while (band < DRIVE_NUM_BANDS - 1 && temperature >= _band_floors[band + 1] + MOVEMENT_DISPLAY_DRIVE_HYSTERESIS / 2) band++;
+    while (band > 0 && temperature < _band_floors[band] - MOVEMENT_DISPLAY_DRIVE_HYSTERESIS / 2) band--;
+    return band;
+}
+
+static void _movement_display_drive_apply(movement_display_drive_band_t band, uint16_t vcc) {
+    watch_display_drive_t drive = _base;
+    switch (band) {
+        case DRIVE_BAND_COLD:
+            if (drive.contrast < 15) drive.contrast++;
+            drive.bias_buffer = drive.bias_buffer ? drive.bias_buffer * 2 : 2;
+            break;
+        case DRIVE_BAND_COOL:
+            break;
+        case DRIVE_BAND_WARM:
+        case DRIVE_BAND_HOT: {
+            // the warmer it is, the less VLCD it takes; hot enough, and segments that are off show at the usual one.
+            uint8_t steps = (band == DRIVE_BAND_HOT) ? 2 : 1;
+            drive.contrast = drive.contrast > steps ? drive.contrast - steps : 0;
+            if (drive.bias_buffer > 1) drive.bias_buffer = 1;
+            drive.frame_divider += 2;
+            break;
+        }
+        case DRIVE_NUM_BANDS:
+            break;
+    }
+    // with the battery low, the charge pump has less to work with, so the bias buffer keeps the build's length.
+    if (vcc && vcc < MOVEMENT_DISPLAY_DRIVE_LOW_VCC && drive.bias_buffer < _base.bias_buffer) drive.bias_buffer = _base.bias_buffer;
+    watch_display_set_drive(drive);
+}
+
+static void _movement_display_drive_sample(const movement_sensor_sample_t *sample, void *context) {
+    (void) context;
+    // without a thermistor, there's nothing to go on, and the build's settings stay.
+    if (!(sample->channels & MOVEMENT_SENSOR_CHANNEL(MOVEMENT_SENSOR_TEMPERATURE))) return;
+    uint16_t vcc = movement_get_battery_voltage();
+    if (sample->channels & MOVEMENT_SENSOR_CHANNEL(MOVEMENT_SENSOR_SUPPLY_VOLTAGE)) {
+        vcc = sample->values[MOVEMENT_SENSOR_SUPPLY_VOLTAGE];
+    }
+
+    _band = _movement_display_drive_band(sample->values[MOVEMENT_SENSOR_TEMPERATURE]);
+    _movement_display_drive_apply(_band, vcc);
+}
+
+void movement_display_drive_enable(void) {
+    if (_enabled) return;
+    _base = watch_display_get_drive();
+    _band = DRIVE_BAND_COOL;
+    _enabled = movement_sensors_subscribe(MOVEMENT_SENSOR_CHANNEL(MOVEMENT_SENSOR_TEMPERATURE) |
+                                          MOVEMENT_SENSOR_CHANNEL(MOVEMENT_SENSOR_SUPPLY_VOLTAGE),
+                                          MOVEMENT_DISPLAY_DRIVE_PERIOD, _movement_display_drive_sample, NULL);
+}
+
+void movement_display_drive_disable(void) {
+    if (!_enabled) return;
+    movement_sensors_unsubscribe(_movement_display_drive_sample, NULL);
+    _enabled = false;
+    watch_display_set_drive(_base);
+}
+
+bool movement_display_drive_is_enabled(void) {
+    return _enabled;
+}
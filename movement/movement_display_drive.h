@@ -0,0 +1,57 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MOVEMENT_DISPLAY_DRIVE_H_
+#define MOVEMENT_DISPLAY_DRIVE_H_
+#include <stdbool.h>
+
+/** @brief Seconds between looks at the temperature; it divides the hour, so the samples share their wakes. */
+#define MOVEMENT_DISPLAY_DRIVE_PERIOD 600
+
+/** @brief A supply voltage, in millivolts, below which the bias buffer is never cut short. */
+#define MOVEMENT_DISPLAY_DRIVE_LOW_VCC 2500
+
+/** @brief How far, in hundredths of a degree, the temperature has to go past a band's edge to move to the next band;
+  *        a watch that sits at an edge shouldn't flip back and forth.
+  */
+#define MOVEMENT_DISPLAY_DRIVE_HYSTERESIS 100
+
+/** @brief Starts fitting the display's drive to the temperature. Does nothing if it's already running.
+  * @details Every MOVEMENT_DISPLAY_DRIVE_PERIOD seconds, this takes the thermistor's reading and the supply voltage
+  *          from the sensor registry (@see movement_sensors_subscribe), and sets the cheapest drive that keeps the
+  *          display legible at that temperature (@see watch_display_set_drive). Around room temperature and on the
+  *          wrist, the liquid crystal turns easily, so VLCD comes down a step, the bias buffer runs for a single
+  *          cycle and the frame rate drops to about 32 Hz; in the cold, where it's slow, VLCD goes up a step and the
+  *          bias buffer runs twice as long. Each band is relative to the build's settings in hpl_slcd_config.h,
+  *          which is what the display keeps between 0 and 15 °C, and without a thermistor.
+  */
+void movement_display_drive_enable(void);
+
+/** @brief Stops following the temperature, and puts the build's settings back. */
+void movement_display_drive_disable(void);
+
+/** @brief Returns true if the drive is following the temperature. */
+bool movement_display_drive_is_enabled(void);
+
+#endif // MOVEMENT_DISPLAY_DRIVE_H_
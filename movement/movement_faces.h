@@ -39,6 +39,7 @@
 #include "beats_face.h"
 #include "day_one_face.h"
 #include "voltage_face.h"
+#include "battery_life_face.h"
 #include "stopwatch_face.h"
 #include "totp_face.h"
 #include "totp_face_lfs.h"
@@ -52,6 +53,8 @@
 #include "blinky_face.h"
 #include "moon_phase_face.h"
 #include "accelerometer_data_acquisition_face.h"
+#include "step_counter_face.h"
+#include "sleep_tracker_face.h"
 #include "mars_time_face.h"
 #include "orrery_face.h"
 #include "astronomy_face.h"
@@ -104,6 +107,8 @@
 #include "minute_repeater_decimal_face.h"
 #include "tuning_tones_face.h"
 #include "kitchen_conversions_face.h"
+#include "light_uplink_face.h"
+#include "movement_modules.h"
 // New includes go above this line.
 
 #endif // MOVEMENT_FACES_H_
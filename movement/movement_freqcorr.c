@@ -0,0 +1,312 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stddef.h>
+#include "movement_freqcorr.h"
+#include "movement_sensors.h"
+#include "movement_kv.h"
+#include "movement.h"
+#include "watch.h"
+#include "watch_utility.h"
+
+// one FREQCORR step is 0.95367 ppm, or 95367 hundred-thousandths of a ppb.
+#define FREQCORR_STEP_PPB_X100 95367
+// no correction beyond the register's range is any use, and clamping here keeps the math in 32 bits.
+#define FREQCORR_MAX_PPB 125000
+
+// the intervals the correction runs at, shortest first; they divide the hour, so samples land on the same windows
+// as other consumers of the temperature.
+static const uint16_t _intervals[] = {60, 300, 600, 1200, 3600};
+#define NUM_INTERVALS (sizeof(_intervals) / sizeof(_intervals[0]))
+
+static movement_freqcorr_settings_t _settings;
+static bool _loaded;                // whether _settings has been read in; a face can ask before Movement starts us
+static bool _configured;
+static bool _subscribed;
+static uint8_t _interval;           // index into _intervals of the one subscribed at
+static int16_t _residual;           // the part of the last correction that dithering hasn't applied yet
+static int16_t _previous = -30000;  // the last value written, so that the same one isn't written twice
+static int16_t _last_temperature = INT16_MIN;
+static movement_freqcorr_report_t _report = { .temperature = INT16_MIN };
+
+static uint32_t _movement_freqcorr_now(void) {
+    return watch_utility_date_time_to_unix_time(movement_get_local_date_time(), 0);
+}
+
+// the longest interval, which is the cadence in the settings.
+static uint8_t _movement_freqcorr_max_interval(void) {
+    uint8_t i = NUM_INTERVALS - 1;
+    while (i > 0 && _intervals[i] > _settings.correction_cadence * 60) i--;
+    return i;
+}
+
+static void _movement_freqcorr_write(int16_t value, int16_t sign) {
+    int16_t signed_value = sign ? -value : value;
+    if (signed_value == _previous) return; // Do not write same correction value twice
+    _previous = signed_value;
+    _report.freqcorr = signed_value;
+
+    watch_rtc_freqcorr_write(value, sign);
+}
+
+// Receives clock correction, already corrected for temperature and battery voltage, multiplied by the dithering.
+static void _movement_freqcorr_apply(int32_t correction) {
+    correction += _residual;
+    int32_t correction_lr = correction * 2 / MOVEMENT_FREQCORR_DITHERING; // int division
+    if (correction_lr & 1) {
+        if (correction_lr > 0) {
+            correction_lr++;
+        } else {
+            correction_lr--;
+        }
+    }
+    correction_lr >>= 1;
+    _residual = correction - correction_lr * MOVEMENT_FREQCORR_DITHERING;
+
+    // Warning! Freqcorr is not signed int8!!
+    // First we clamp it to 8-bit range
+    if (correction_lr > 127) {
+        _movement_freqcorr_write(127, 0);
+    } else if (correction_lr < -127) {
+        _movement_freqcorr_write(127, 1);
+    } else if (correction_lr < 0) {
+        _movement_freqcorr_write(-correction_lr, 1);
+    } else {
+        _movement_freqcorr_write(correction_lr, 0);
+    }
+}
+
+// how fast the settings say the crystal runs, in parts per billion. a crystal that's off its turnover temperature runs
+// slow.
+static int64_t _movement_freqcorr_model(int16_t temperature, uint16_t vcc) {
+    // the settings are scaled so that, in hundredths of a degree and parts per billion, each term is one division.
+    int64_t ppb = (int64_t)_settings.freq_correction * 10;
+    if (temperature != INT16_MIN) {
+        int64_t dt = temperature - _settings.center_temperature;
+        ppb -= (int64_t)_settings.quadratic_tempco * dt * dt / 1000000;
+        ppb += (int64_t)_settings.cubic_tempco * dt * dt * dt / 10000000000LL;
+    }
+    // 0.2417 ppm per volt away from the 3 V the crystal was characterized at.
+    ppb += ((int32_t)vcc - 3000) * 29 / 120;
+    ppb += movement_freqcorr_get_aging_ppb();
+    return ppb;
+}
+
+// the correction, in 31sts of a FREQCORR step; a negative correction speeds the clock up.
+static int32_t _movement_freqcorr_compute(int16_t temperature, uint16_t vcc) {
+    int64_t ppb = _movement_freqcorr_model(temperature, vcc);
+    if (ppb > FREQCORR_MAX_PPB) ppb = FREQCORR_MAX_PPB;
+    if (ppb < -FREQCORR_MAX_PPB) ppb = -FREQCORR_MAX_PPB;
+    int32_t scaled = (int32_t)ppb * MOVEMENT_FREQCORR_DITHERING * 100;
+    return (scaled + (scaled < 0 ? -FREQCORR_STEP_PPB_X100 / 2 : FREQCORR_STEP_PPB_X100 / 2)) / FREQCORR_STEP_PPB_X100;
+}
+
+static void _movement_freqcorr_sample(const movement_sensor_sample_t *sample, void *context);
+
+static void _movement_freqcorr_subscribe(void) {
+    _subscribed = movement_sensors_subscribe(MOVEMENT_SENSOR_CHANNEL(MOVEMENT_SENSOR_TEMPERATURE) |
+                                             MOVEMENT_SENSOR_CHANNEL(MOVEMENT_SENSOR_SUPPLY_VOLTAGE),
+                                             _intervals[_interval], _movement_freqcorr_sample, NULL);
+    _report.interval = _intervals[_interval];
+}
+
+static void _movement_freqcorr_sample(const movement_sensor_sample_t *sample, void *context) {
+    (void) context;
+    int16_t temperature = INT16_MIN;
+    uint16_t vcc = 3000;
+    if (sample->channels & MOVEMENT_SENSOR_CHANNEL(MOVEMENT_SENSOR_TEMPERATURE)) {
+        temperature = sample->values[MOVEMENT_SENSOR_TEMPERATURE];
+    }
+    if (sample->channels & MOVEMENT_SENSOR_CHANNEL(MOVEMENT_SENSOR_SUPPLY_VOLTAGE)) {
+        vcc = sample->values[MOVEMENT_SENSOR_SUPPLY_VOLTAGE];
+    }
+
+    _movement_freqcorr_apply(_movement_freqcorr_compute(temperature, vcc));
+    _report.temperature = temperature;
+    _report.vcc = vcc;
+    _report.corrections++;
+
+    // the correction follows the temperature, so sample more often while it's moving and less while it isn't.
+    uint8_t interval = _interval;
+    if (temperature != INT16_MIN && _last_temperature != INT16_MIN) {
+        int16_t delta = temperature > _last_temperature ? temperature - _last_temperature : _last_temperature - temperature;
+        if (delta >= MOVEMENT_FREQCORR_FAST_DELTA && interval > 0) interval--;
+        else if (delta < MOVEMENT_FREQCORR_SLOW_DELTA && interval < _movement_freqcorr_max_interval()) interval++;
+    }
+    _last_temperature = temperature;
+    if (interval != _interval) {
+        _interval = interval;
+        movement_sensors_unsubscribe(_movement_freqcorr_sample, NULL);
+        _movement_freqcorr_subscribe();
+    }
+}
+
+static void _movement_freqcorr_restart(void) {
+    if (_subscribed) movement_sensors_unsubscribe(_movement_freqcorr_sample, NULL);
+    _subscribed = false;
+    _residual = 0;
+    _last_temperature = INT16_MIN;
+    if (!_configured) return;
+
+    if (_settings.correction_profile == 0) {
+        // a static correction needs no samples; without dithering its resolution is a mere 1 ppm.
+        _movement_freqcorr_apply(_settings.freq_correction * MOVEMENT_FREQCORR_DITHERING / 100);
+        return;
+    }
+    _interval = _movement_freqcorr_max_interval();
+    _movement_freqcorr_subscribe();
+}
+
+static void _movement_freqcorr_load(void) {
+    if (_loaded) return;
+    _loaded = true;
+    movement_kv_import_file(MOVEMENT_FREQCORR_KV_KEY, "nanosec.ini", sizeof(_settings));
+    _configured = movement_kv_get(MOVEMENT_FREQCORR_KV_KEY, &_settings, sizeof(_settings)) == sizeof(_settings);
+}
+
+void movement_freqcorr_init(void) {
+    _movement_freqcorr_load();
+    _movement_freqcorr_restart();
+}
+
+bool movement_freqcorr_is_configured(void) {
+    _movement_freqcorr_load();
+    return _configured;
+}
+
+movement_freqcorr_settings_t *movement_freqcorr_get_settings(void) {
+    _movement_freqcorr_load();
+    return &_settings;
+}
+
+void movement_freqcorr_set_profile(int8_t profile) {
+    _movement_freqcorr_load();
+    _settings.correction_profile = profile;
+    _settings.correction_cadence = 10;
+    _settings.last_correction_time = _movement_freqcorr_now();
+    _settings.center_temperature = 2500;
+    _settings.freq_correction = 0;
+    _settings.aging_ppm_pa = 0;
+
+    switch (profile) {
+        case 0: // No tempco, no dithering
+        case 1: // No tempco, with dithering
+            _settings.quadratic_tempco = 0;
+            _settings.cubic_tempco = 0;
+            break;
+        case 2: // Datasheet correction
+            _settings.quadratic_tempco = 3400;
+            _settings.cubic_tempco = 0;
+            break;
+        case 3: // Datasheet correction + cubic coefficient
+            _settings.quadratic_tempco = 3400;
+            _settings.cubic_tempco = 1360;
+            break;
+        case 4: // Full custom
+            _settings.freq_correction = 1768;
+            _settings.center_temperature = 2653;
+            _settings.quadratic_tempco = 4091;
+            _settings.cubic_tempco = 1359;
+            break;
+    }
+}
+
+void movement_freqcorr_save(void) {
+    movement_kv_set(MOVEMENT_FREQCORR_KV_KEY, &_settings, sizeof(_settings));
+    _configured = true;
+    _movement_freqcorr_restart();
+}
+
+int32_t movement_freqcorr_get_aging_ppb(void) {
+    _movement_freqcorr_load();
+    // Years passed since finetune, times the aging per year.
+    int64_t seconds = (int64_t)_movement_freqcorr_now() - _settings.last_correction_time;
+    return (int32_t)(seconds * _settings.aging_ppm_pa * 10 / 31536000);
+}
+
+void movement_freqcorr_get_report(movement_freqcorr_report_t *report) {
+    *report = _report;
+}
+
+// calibration against USB: the sum of the measurements so far, and the temperature and voltage they were taken at.
+static bool _calibrated;
+static bool _calibration_subscribed;
+static int64_t _calibration_sum;
+static int16_t _calibration_temperature = INT16_MIN;
+static uint16_t _calibration_vcc = 3000;
+
+static void _movement_freqcorr_calibration_sample(const movement_sensor_sample_t *sample, void *context) {
+    (void) context;
+    if (sample->channels & MOVEMENT_SENSOR_CHANNEL(MOVEMENT_SENSOR_TEMPERATURE)) {
+        _calibration_temperature = sample->values[MOVEMENT_SENSOR_TEMPERATURE];
+    }
+    if (sample->channels & MOVEMENT_SENSOR_CHANNEL(MOVEMENT_SENSOR_SUPPLY_VOLTAGE)) {
+        _calibration_vcc = sample->values[MOVEMENT_SENSOR_SUPPLY_VOLTAGE];
+    }
+}
+
+static void _movement_freqcorr_finish_calibration(void) {
+    _calibrated = true;
+    watch_rtc_stop_crystal_measurements();
+    if (_calibration_subscribed) movement_sensors_unsubscribe(_movement_freqcorr_calibration_sample, NULL);
+    _calibration_subscribed = false;
+    int32_t ppb = _report.calibration_ppb;
+
+    _movement_freqcorr_load();
+    if (!_configured) {
+        movement_freqcorr_set_profile(_calibration_temperature == INT16_MIN ? 1 : 2);
+    } else {
+        // the measurement takes in any aging so far.
+        _settings.last_correction_time = _movement_freqcorr_now();
+    }
+    // the static correction is whatever the rest of the model leaves of the offset we measured.
+    _settings.freq_correction = 0;
+    int64_t correction = (ppb - _movement_freqcorr_model(_calibration_temperature, _calibration_vcc)) / 10;
+    if (correction > INT16_MAX) correction = INT16_MAX;
+    if (correction < -INT16_MAX) correction = -INT16_MAX;
+    _settings.freq_correction = (int16_t)correction;
+    movement_freqcorr_save();
+}
+
+void movement_freqcorr_usb_task(void) {
+    if (_calibrated) return;
+
+    int32_t ppb;
+    if (watch_rtc_read_crystal_measurement(&ppb) && ppb < MOVEMENT_FREQCORR_CALIBRATION_MAX_PPB &&
+        ppb > -MOVEMENT_FREQCORR_CALIBRATION_MAX_PPB) {
+        _calibration_sum += ppb;
+        _report.calibration_samples++;
+        _report.calibration_ppb = (int32_t)(_calibration_sum / _report.calibration_samples);
+        if (_report.calibration_samples >= MOVEMENT_FREQCORR_CALIBRATION_SAMPLES) {
+            _movement_freqcorr_finish_calibration();
+            return;
+        }
+    }
+    // until a host has configured the watch there's nothing to measure against, so this keeps trying.
+    if (watch_rtc_start_crystal_measurement() && !_calibration_subscribed) {
+        _calibration_subscribed = movement_sensors_subscribe(MOVEMENT_SENSOR_CHANNEL(MOVEMENT_SENSOR_TEMPERATURE) |
+                                                             MOVEMENT_SENSOR_CHANNEL(MOVEMENT_SENSOR_SUPPLY_VOLTAGE),
+                                                             60, _movement_freqcorr_calibration_sample, NULL);
+    }
+}
@@ -0,0 +1,127 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MOVEMENT_FREQCORR_H_
+#define MOVEMENT_FREQCORR_H_
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Key the settings are kept under in the key/value store. It's the one nanosec_face always used, so
+  *        settings made before there was a service carry over.
+  */
+#define MOVEMENT_FREQCORR_KV_KEY "nanosec"
+
+/** @brief The correction is dithered over this many intervals, for a resolution of a 31st of the RTC's ~0.95 ppm
+  *        FREQCORR step.
+  */
+#define MOVEMENT_FREQCORR_DITHERING 31
+
+/** @brief Number of correction profiles; @see movement_freqcorr_set_profile. */
+#define MOVEMENT_FREQCORR_NUM_PROFILES 5
+
+/** @brief A change in temperature, in hundredths of a degree, between two samples that's big enough to sample more
+  *        often, and one that's small enough to sample less often.
+  */
+#define MOVEMENT_FREQCORR_FAST_DELTA 100
+#define MOVEMENT_FREQCORR_SLOW_DELTA 25
+
+/** @brief How many quarter-second measurements of the crystal against USB make a calibration
+  *        (@see movement_freqcorr_usb_task): about five minutes' worth.
+  */
+#define MOVEMENT_FREQCORR_CALIBRATION_SAMPLES 1200
+
+/** @brief A measurement further off than this, in parts per billion, is the USB clock still finding the host's frames
+  *        rather than anything a crystal does, and is thrown away.
+  */
+#define MOVEMENT_FREQCORR_CALIBRATION_MAX_PPB 200000
+
+typedef struct {
+    // Correction profiles:
+    // 0 - static hardware correction.
+    // 1 - static correction with dithering.
+    // 2 - datasheet quadratic correction (universal).
+    // 3 - cubic correction conservative (likely universal).
+    // 4 - cubic correction finetuned (sample-specific).
+    int8_t correction_profile;
+    int16_t freq_correction; // Static correction - multiplied by 100
+    int16_t center_temperature; // Multiplied by 100, +25.0 -> +2500
+    int16_t quadratic_tempco; // 0.034 -> 3400, multiplied by 100000. Stored positive, used as negative.
+    int16_t cubic_tempco; // default 0, 0.000136 -> 1360, multiplied by 10000000. Stored positive, used positive.
+    int8_t correction_cadence; // Longest time between corrections, in minutes: 1, 5, 10, 20 or 60.
+    uint32_t last_correction_time; // When the watch was last finetuned; aging is counted from here.
+    int16_t aging_ppm_pa; // multiplied by 100. Aging per year.
+} movement_freqcorr_settings_t;
+
+typedef struct {
+    int16_t temperature;        // hundredths of a degree at the last correction, or INT16_MIN without a thermistor
+    uint16_t vcc;               // millivolts at the last correction
+    int16_t freqcorr;           // the value last written to FREQCORR, -127 to 127; negative speeds the clock up
+    uint16_t interval;          // seconds between corrections, for as fast as the temperature has been changing
+    uint32_t corrections;       // corrections computed since boot
+    uint16_t calibration_samples;   // measurements against USB so far, up to MOVEMENT_FREQCORR_CALIBRATION_SAMPLES
+    int32_t calibration_ppb;    // how fast they found the crystal ran, in parts per billion, on average
+} movement_freqcorr_report_t;
+
+/** @brief Corrects the RTC for the crystal's temperature, the supply voltage and aging, if it has been set up.
+  * @details The correction takes the temperature and VCC from the sensor registry (@see movement_sensors_subscribe),
+  *          so it shares its ADC sample with any face logging the temperature at a related interval, and computes in
+  *          fixed point. It runs at the cadence in the settings while the temperature is steady, and down to once a
+  *          minute while it changes by MOVEMENT_FREQCORR_FAST_DELTA or more between corrections. Movement calls this
+  *          once at boot, after the first screen; until settings have been saved (nanosec_face does that), it leaves
+  *          the RTC alone.
+  */
+void movement_freqcorr_init(void);
+
+/** @brief Returns true once there are settings, and the service is correcting. */
+bool movement_freqcorr_is_configured(void);
+
+/** @brief Returns the settings, for a face to edit; call movement_freqcorr_save when done. */
+movement_freqcorr_settings_t *movement_freqcorr_get_settings(void);
+
+/** @brief Resets the settings to one of the profiles and restarts the aging clock; it doesn't save them.
+  * @param profile 0 to MOVEMENT_FREQCORR_NUM_PROFILES - 1.
+  */
+void movement_freqcorr_set_profile(int8_t profile);
+
+/** @brief Stores the settings and starts correcting with them. */
+void movement_freqcorr_save(void);
+
+/** @brief Returns the correction for the crystal's aging since last_correction_time, in parts per billion. */
+int32_t movement_freqcorr_get_aging_ppb(void);
+
+/** @brief Reports the last correction. */
+void movement_freqcorr_get_report(movement_freqcorr_report_t *report);
+
+/** @brief Calibrates the crystal against USB while the watch is plugged into a computer.
+  * @details Movement calls this from its loop while USB is enabled. Once a host has configured the watch, it measures
+  *          the crystal against the host's clock (@see watch_rtc_start_crystal_measurement) until it has
+  *          MOVEMENT_FREQCORR_CALIBRATION_SAMPLES, then takes their average as the crystal's offset at the current
+  *          temperature and voltage. It sets the static correction so that the temperature model gives that offset
+  *          here, restarts the aging clock, and saves the settings, which puts the new correction into FREQCORR. A watch
+  *          with no settings yet gets the datasheet temperature curve, or a static correction without a thermistor.
+  *          It calibrates once per boot.
+  */
+void movement_freqcorr_usb_task(void);
+
+#endif // MOVEMENT_FREQCORR_H_
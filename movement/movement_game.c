@@ -0,0 +1,100 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include "movement_game.h"
+#include "watch.h"
+
+#define SECONDS_PER_HOUR 3600
+
+
+void movement_game_start(movement_game_t *game, uint8_t frequency, uint8_t max_steps) {
+    memset(game, 0, sizeof(movement_game_t));
+    game->frequency = frequency;
+    game->max_steps = max_steps;
+    movement_game_set_pace(game, MOVEMENT_GAME_WAITING);
+}
+
+void movement_game_set_pace(movement_game_t *game, movement_game_pace_t pace) {
+    // coming back from waiting, the game picks up from its next tick; between the other two, its steps carry on.
+    if (game->pace == MOVEMENT_GAME_WAITING) game->anchored = false;
+    game->pace = pace;
+
+    switch (pace) {
+        case MOVEMENT_GAME_RUNNING:
+            movement_request_tick_frequency(game->frequency);
+            break;
+        case MOVEMENT_GAME_SLOW:
+            movement_request_tick_frequency(1);
+            break;
+        case MOVEMENT_GAME_WAITING:
+            // no time at all is no tick at all; the timeout and low energy countdowns carry on.
+            movement_request_next_tick((watch_date_time){ .reg = 0 });
+            break;
+    }
+}
+
+uint8_t movement_game_steps(movement_game_t *game, movement_event_t event) {
+    if (event.event_type != EVENT_TICK || game->pace == MOVEMENT_GAME_WAITING) return 0;
+
+    // the step due as of this tick, counted from the top of the hour; the subsecond is at the rate the face ticks at,
+    // which a low battery can hold to 1 Hz whatever the pace.
+    watch_date_time now = movement_get_local_date_time();
+    uint8_t rate = movement_get_tick_frequency();
+    if (rate == 0) rate = 1;
+    uint32_t position = ((uint32_t)now.unit.minute * 60 + now.unit.second) * game->frequency;
+    position += (uint32_t)event.subsecond * game->frequency / rate;
+
+    uint32_t steps;
+    if (game->anchored) {
+        uint32_t steps_per_hour = (uint32_t)SECONDS_PER_HOUR * game->frequency;
+        steps = (position + steps_per_hour - game->position) % steps_per_hour;
+    } else {
+        // there's nothing finer than the second to say when the game stopped waiting, so the first tick since counts
+        // as one tick's worth of steps.
+        game->anchored = true;
+        steps = rate < game->frequency ? game->frequency / rate : 1;
+    }
+    game->position = position;
+    if (steps > game->max_steps) {
+        game->dropped_steps += steps - game->max_steps;
+        steps = game->max_steps;
+    }
+    return steps;
+}
+
+void movement_game_begin_frame(movement_game_t *game) {
+    memcpy(game->frame_start, watch_display_framebuffer, sizeof(game->frame_start));
+    watch_display_set_held(true);
+}
+
+bool movement_game_end_frame(movement_game_t *game) {
+    watch_display_set_held(false);
+    if (!memcmp(game->frame_start, watch_display_framebuffer, sizeof(game->frame_start))) {
+        game->unchanged_frames++;
+        return false;
+    }
+    watch_display_commit();
+    return true;
+}
@@ -0,0 +1,108 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MOVEMENT_GAME_H_
+#define MOVEMENT_GAME_H_
+#include <stdint.h>
+#include <stdbool.h>
+#include "movement.h"
+#include "watch_private_display.h"
+
+/* A game loop for watch faces: the game's logic moves in fixed steps, a set number a second, however often the watch
+ * actually wakes up to run them, and each frame is drawn in one go.
+ *
+ * The game says how fast the watch needs to wake with its pace. While it's running, the watch ticks at the game's
+ * rate. While nothing moves quickly (a pause between waves, a countdown), it can go SLOW: the watch wakes once a
+ * second and runs the second's steps together, so the game's timing holds without waking the CPU for each one. While
+ * it's WAITING (for a button to start, say, or on a game over screen), there are no ticks at all. A tick that comes
+ * late, or a low battery holding faces to a tick a second, gets the steps it missed too, up to max_steps; past that,
+ * the game slows down rather than lurching ahead.
+ *
+ *     case EVENT_TICK:
+ *         movement_game_begin_frame(&game);
+ *         for (uint8_t steps = movement_game_steps(&game, event); steps; steps--) _my_game_step(state);
+ *         movement_game_end_frame(&game);
+ *         break;
+ *
+ * Between movement_game_begin_frame and movement_game_end_frame the display is held, so the game can draw with the
+ * usual display functions and movement_game_draw_sprite as often as it likes, and the glass is written once at the
+ * end, and only if something changed. Do the same around drawing in response to a button.
+ *
+ * A movement_game_t takes a couple of dozen bytes, and can live in the face's context or with the rest of the game's
+ * state.
+ */
+
+typedef enum {
+    MOVEMENT_GAME_RUNNING = 0,  // the watch ticks at the game's rate
+    MOVEMENT_GAME_SLOW,         // the watch ticks once a second, and runs the second's steps at once
+    MOVEMENT_GAME_WAITING,      // no ticks and no steps, until the game sets another pace
+} movement_game_pace_t;
+
+typedef struct {
+    uint8_t frequency;              // steps a second, a power of two from 1 to 64
+    uint8_t max_steps;              // the most steps one tick runs; keep it at least frequency to go SLOW
+    uint8_t pace;                   // a movement_game_pace_t
+    bool anchored;                  // whether position is from a tick since the game last waited
+    uint32_t position;              // the step the game is up to, counted from the top of the hour
+    uint16_t dropped_steps;         // steps that weren't run because the watch fell more than max_steps behind
+    uint16_t unchanged_frames;      // frames that drew nothing new, and so weren't written to the display
+    uint32_t frame_start[WATCH_DISPLAY_NUM_COMS]; // the framebuffer as the frame began
+} movement_game_t;
+
+/** @brief Sets a game up to run at a number of steps a second, and sets its pace to MOVEMENT_GAME_WAITING. Call it
+  *        when the face activates.
+  */
+void movement_game_start(movement_game_t *game, uint8_t frequency, uint8_t max_steps);
+
+/** @brief Sets how often the watch wakes to run the game's steps; @see movement_game_pace_t. */
+void movement_game_set_pace(movement_game_t *game, movement_game_pace_t pace);
+
+/** @brief Returns how many steps the game should run for an event: 0 unless it's EVENT_TICK, and otherwise as many
+  *        as have come due since the last, up to max_steps.
+  * @details If a step changes the pace, the rest of the steps are stale; stop at that point.
+  */
+uint8_t movement_game_steps(movement_game_t *game, movement_event_t event);
+
+/** @brief Holds the display for drawing a frame. */
+void movement_game_begin_frame(movement_game_t *game);
+
+/** @brief Writes the frame out to the display, if it changed anything, and lets go of the display.
+  * @return true if the frame was written; false if it drew nothing new.
+  */
+bool movement_game_end_frame(movement_game_t *game);
+
+/** @brief Turns a sprite's segments on. A sprite is a watch_display_frame_t with a bit set for each segment it
+  *        covers, bit n of segments[com] for watch_set_pixel(com, n); drawing it is an OR for each COM line.
+  *        Outside of a frame, it shows at the next write to the display.
+  */
+static inline void movement_game_draw_sprite(const watch_display_frame_t *sprite) {
+    for (uint8_t com = 0; com < WATCH_DISPLAY_NUM_COMS; com++) watch_display_framebuffer[com] |= sprite->segments[com];
+}
+
+/** @brief Turns a sprite's segments off; @see movement_game_draw_sprite. */
+static inline void movement_game_erase_sprite(const watch_display_frame_t *sprite) {
+    for (uint8_t com = 0; com < WATCH_DISPLAY_NUM_COMS; com++) watch_display_framebuffer[com] &= ~sprite->segments[com];
+}
+
+#endif // MOVEMENT_GAME_H_
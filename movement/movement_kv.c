@@ -0,0 +1,315 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include "movement_kv.h"
+#include "movement.h"
+#include "movement_backup.h"
+#include "filesystem.h"
+#include "watch.h"
+#include "watch_utility.h"
+
+#define MOVEMENT_KV_FILENAME "settings.kv"
+#define MOVEMENT_KV_TEMP_FILENAME "settings.tmp"
+// changes are collected here and appended in one go, so a flush costs one metadata commit no matter how many
+// settings changed.
+#define MOVEMENT_KV_BUFFER_SIZE (256)
+// how long changes may wait in the buffer, in seconds, before movement_kv_flush_if_due writes them out.
+#define MOVEMENT_KV_FLUSH_DELAY (60)
+// the file is rewritten once superseded records take up more than this much of it.
+#define MOVEMENT_KV_COMPACT_SLACK (512)
+
+// on flash, each record is a header, the key and then the value. a record with no value removes the key.
+typedef struct {
+    uint8_t key_length;
+    uint8_t value_length;
+} movement_kv_header_t;
+
+#define MOVEMENT_KV_RECORD_MAX (sizeof(movement_kv_header_t) + MOVEMENT_KV_KEY_MAX + MOVEMENT_KV_VALUE_MAX)
+
+typedef struct {
+    char key[MOVEMENT_KV_KEY_MAX + 1];
+    uint16_t offset;    // where the value starts: in the file, or in the buffer if pending
+    uint8_t length;
+    bool pending;
+} movement_kv_entry_t;
+
+static movement_kv_entry_t entries[MOVEMENT_KV_MAX_KEYS];
+static uint8_t num_entries;
+static uint8_t buffer[MOVEMENT_KV_BUFFER_SIZE];
+static uint16_t buffered;
+static int32_t file_size;
+static bool needs_compaction;
+// when movement_kv_flush_if_due first saw changes waiting, as a UNIX timestamp; 0 if it hasn't.
+static uint32_t pending_since;
+
+static int8_t _movement_kv_find(const char *key) {
+    for (uint8_t i = 0; i < num_entries; i++) {
+        if (strcmp(entries[i].key, key) == 0) return i;
+    }
+    return -1;
+}
+
+static void _movement_kv_remove_entry(int8_t index) {
+    entries[index] = entries[--num_entries];
+}
+
+static uint16_t _movement_kv_write_record(uint8_t *dest, const char *key, const void *value, uint8_t length) {
+    movement_kv_header_t header = { .key_length = strlen(key), .value_length = length };
+    memcpy(dest, &header, sizeof(header));
+    memcpy(dest + sizeof(header), key, header.key_length);
+    if (length) memcpy(dest + sizeof(header) + header.key_length, value, length);
+    return sizeof(header) + header.key_length + length;
+}
+
+static bool _movement_kv_read_value(movement_kv_entry_t *entry, void *value, uint8_t length) {
+    if (length > entry->length) length = entry->length;
+    if (entry->pending) {
+        memcpy(value, buffer + entry->offset, length);
+        return true;
+    }
+    return filesystem_read_file_at(MOVEMENT_KV_FILENAME, value, entry->offset, length);
+}
+
+static void _movement_kv_load(void) {
+    num_entries = 0;
+    buffered = 0;
+    needs_compaction = false;
+    file_size = filesystem_get_file_size(MOVEMENT_KV_FILENAME);
+    if (file_size < 0) {
+        file_size = 0;
+        return;
+    }
+
+    // replay the records in order; later ones supersede earlier ones.
+    int32_t offset = 0;
+    while (offset + (int32_t)sizeof(movement_kv_header_t) <= file_size) {
+        movement_kv_header_t header;
+        char key[MOVEMENT_KV_KEY_MAX + 1] = {0};
+        if (!filesystem_read_file_at(MOVEMENT_KV_FILENAME, (char *)&header, offset, sizeof(header))) break;
+        int32_t value_offset = offset + sizeof(header) + header.key_length;
+        if (header.key_length == 0 || header.key_length > MOVEMENT_KV_KEY_MAX || header.value_length > MOVEMENT_KV_VALUE_MAX) break;
+        if (value_offset + header.value_length > file_size) break;
+        if (!filesystem_read_file_at(MOVEMENT_KV_FILENAME, key, offset + sizeof(header), header.key_length)) break;
+
+        int8_t index = _movement_kv_find(key);
+        if (header.value_length == 0) {
+            if (index >= 0) _movement_kv_remove_entry(index);
+        } else {
+            if (index < 0 && num_entries < MOVEMENT_KV_MAX_KEYS) {
+                index = num_entries++;
+                strcpy(entries[index].key, key);
+            }
+            if (index >= 0) {
+                entries[index].offset = value_offset;
+                entries[index].length = header.value_length;
+                entries[index].pending = false;
+            }
+        }
+        offset = value_offset + header.value_length;
+    }
+
+    // anything we couldn't make sense of would hide whatever gets appended after it, so start the file over.
+    if (offset != file_size) needs_compaction = true;
+}
+
+static bool _movement_kv_compact(void) {
+    uint8_t chunk[MOVEMENT_KV_BUFFER_SIZE];
+    uint16_t chunk_length = 0;
+
+    // build the new file alongside the old one, then swap it in, so that losing power part way through loses nothing.
+    if (!filesystem_write_file(MOVEMENT_KV_TEMP_FILENAME, "", 0)) return false;
+    for (uint8_t i = 0; i < num_entries; i++) {
+        uint8_t record[MOVEMENT_KV_RECORD_MAX];
+        uint16_t length = _movement_kv_write_record(record, entries[i].key, NULL, 0);
+        ((movement_kv_header_t *)record)->value_length = entries[i].length;
+        if (!_movement_kv_read_value(&entries[i], record + length, entries[i].length)) return false;
+        length += entries[i].length;
+        if (chunk_length + length > sizeof(chunk)) {
+            if (!filesystem_append_file(MOVEMENT_KV_TEMP_FILENAME, (char *)chunk, chunk_length)) return false;
+            chunk_length = 0;
+        }
+        memcpy(chunk + chunk_length, record, length);
+        chunk_length += length;
+    }
+    if (chunk_length && !filesystem_append_file(MOVEMENT_KV_TEMP_FILENAME, (char *)chunk, chunk_length)) return false;
+    if (!filesystem_rename(MOVEMENT_KV_TEMP_FILENAME, MOVEMENT_KV_FILENAME)) return false;
+
+    _movement_kv_load();
+    pending_since = 0;
+    movement_backup_journal_write(NULL, 0);
+    return true;
+}
+
+// keeps the pending values that fit in the backup registers, so a reset before the next flush loses as little as
+// possible. it's the same record format as the file, so counters and small settings with short keys are what fit.
+static void _movement_kv_journal(void) {
+    uint8_t journal[MOVEMENT_BACKUP_JOURNAL_SIZE];
+    uint8_t length = 0;
+    for (uint8_t i = 0; i < num_entries; i++) {
+        if (!entries[i].pending) continue;
+        uint16_t record_length = sizeof(movement_kv_header_t) + strlen(entries[i].key) + entries[i].length;
+        if (length + record_length > sizeof(journal)) continue;
+        length += _movement_kv_write_record(journal + length, entries[i].key, buffer + entries[i].offset, entries[i].length);
+    }
+    movement_backup_journal_write(length ? journal : NULL, length);
+}
+
+// puts back whatever was journaled when the watch reset, and writes it out.
+static void _movement_kv_replay_journal(void) {
+    uint8_t journal[MOVEMENT_BACKUP_JOURNAL_SIZE];
+    uint8_t length = movement_backup_journal_read(journal, sizeof(journal));
+    uint8_t offset = 0;
+    while (offset + sizeof(movement_kv_header_t) <= length) {
+        movement_kv_header_t header;
+        char key[MOVEMENT_KV_KEY_MAX + 1] = {0};
+        memcpy(&header, journal + offset, sizeof(header));
+        uint8_t value_offset = offset + sizeof(header) + header.key_length;
+        if (header.key_length == 0 || header.key_length > MOVEMENT_KV_KEY_MAX || header.value_length == 0) break;
+        if (value_offset + header.value_length > length) break;
+        memcpy(key, journal + offset + sizeof(header), header.key_length);
+        movement_kv_set(key, journal + value_offset, header.value_length);
+        offset = value_offset + header.value_length;
+    }
+    if (offset) movement_kv_flush();
+}
+
+void movement_kv_init(void) {
+    _movement_kv_load();
+    _movement_kv_replay_journal();
+}
+
+int32_t movement_kv_get(const char *key, void *value, uint8_t length) {
+    int8_t index = _movement_kv_find(key);
+    if (index < 0) return -1;
+    if (length && !_movement_kv_read_value(&entries[index], value, length)) return -1;
+    return entries[index].length;
+}
+
+void movement_kv_import_file(const char *key, char *filename, uint8_t length) {
+    uint8_t value[MOVEMENT_KV_VALUE_MAX];
+    if (_movement_kv_find(key) >= 0 || length > sizeof(value)) return;
+    if (!filesystem_read_file_if_size(filename, (char *)value, length)) return;
+    // only let go of the old file once its contents are safely on flash.
+    if (movement_kv_set(key, value, length) && movement_kv_flush()) filesystem_rm(filename);
+}
+
+bool movement_kv_flush_if_due(void) {
+    if (buffered == 0) return true;
+
+    uint32_t now = watch_utility_date_time_to_unix_time(watch_rtc_get_date_time(), 0);
+    if (pending_since == 0) {
+        pending_since = now;
+        // with the battery low, changes are written out as soon as Movement gets to them: the next reset could be the
+        // battery giving out.
+        if (movement_battery_is_low()) return movement_kv_flush();
+    }
+    if (now - pending_since < MOVEMENT_KV_FLUSH_DELAY) return true;
+
+    // if it fails, try again after another delay rather than on every trip through the loop.
+    pending_since = now;
+    return movement_kv_flush();
+}
+
+bool movement_kv_flush(void) {
+    if (buffered == 0 && !needs_compaction) return true;
+
+    int32_t live_size = 0;
+    for (uint8_t i = 0; i < num_entries; i++) {
+        live_size += sizeof(movement_kv_header_t) + strlen(entries[i].key) + entries[i].length;
+    }
+    if (needs_compaction || file_size + buffered > live_size + MOVEMENT_KV_COMPACT_SLACK) return _movement_kv_compact();
+
+    if (!filesystem_append_file(MOVEMENT_KV_FILENAME, (char *)buffer, buffered)) return false;
+    for (uint8_t i = 0; i < num_entries; i++) {
+        if (entries[i].pending) {
+            entries[i].offset += file_size;
+            entries[i].pending = false;
+        }
+    }
+    file_size += buffered;
+    buffered = 0;
+    pending_since = 0;
+    movement_backup_journal_write(NULL, 0);
+
+    return true;
+}
+
+static bool _movement_kv_make_room(const char *key, uint8_t length) {
+    uint16_t record_length = sizeof(movement_kv_header_t) + strlen(key) + length;
+    // flushing can rewrite the index, so this has to happen before looking anything up in it.
+    if (buffered + record_length > MOVEMENT_KV_BUFFER_SIZE) return movement_kv_flush();
+    return true;
+}
+
+bool movement_kv_set(const char *key, const void *value, uint8_t length) {
+    size_t key_length = strlen(key);
+    if (key_length == 0 || key_length > MOVEMENT_KV_KEY_MAX || length == 0 || length > MOVEMENT_KV_VALUE_MAX) return false;
+
+    int8_t index = _movement_kv_find(key);
+    if (index >= 0 && entries[index].length == length) {
+        if (entries[index].pending) {
+            // not written yet; just change it in place.
+            memcpy(buffer + entries[index].offset, value, length);
+            _movement_kv_journal();
+            return true;
+        }
+        // faces tend to save on resign whether or not anything changed; don't wear the flash for nothing.
+        uint8_t current[MOVEMENT_KV_VALUE_MAX];
+        if (_movement_kv_read_value(&entries[index], current, length) && memcmp(current, value, length) == 0) return true;
+    }
+    if (index < 0 && num_entries >= MOVEMENT_KV_MAX_KEYS) return false;
+
+    if (!_movement_kv_make_room(key, length)) return false;
+    index = _movement_kv_find(key);
+    if (index < 0) {
+        if (num_entries >= MOVEMENT_KV_MAX_KEYS) return false;
+        index = num_entries++;
+        strcpy(entries[index].key, key);
+    }
+
+    uint16_t record_length = _movement_kv_write_record(buffer + buffered, key, value, length);
+    entries[index].offset = buffered + record_length - length;
+    entries[index].length = length;
+    entries[index].pending = true;
+    buffered += record_length;
+    _movement_kv_journal();
+
+    return true;
+}
+
+bool movement_kv_delete(const char *key) {
+    if (_movement_kv_find(key) < 0) return true;
+
+    if (!_movement_kv_make_room(key, 0)) return false;
+    int8_t index = _movement_kv_find(key);
+    if (index < 0) return true;
+
+    buffered += _movement_kv_write_record(buffer + buffered, key, NULL, 0);
+    _movement_kv_remove_entry(index);
+    // removals aren't journaled, but the value it had mustn't come back from the journal either.
+    _movement_kv_journal();
+
+    return true;
+}
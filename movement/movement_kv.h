@@ -0,0 +1,92 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MOVEMENT_KV_H_
+#define MOVEMENT_KV_H_
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Longest key the store accepts. Keys are short strings like "nanosec" or "save_load.2". */
+#define MOVEMENT_KV_KEY_MAX (11)
+
+/** @brief Largest value the store accepts, in bytes. */
+#define MOVEMENT_KV_VALUE_MAX (128)
+
+/** @brief Most keys the store keeps track of at once. */
+#define MOVEMENT_KV_MAX_KEYS (16)
+
+/** @brief Loads the key/value store's index. Movement calls this at boot, after mounting the filesystem and before
+  *        setting up any faces, so faces can read their settings from their setup functions.
+  * @details The store is a single file of records, each one a key and its latest value. Setting a key appends a
+  *          new record in RAM; records are written out together when the current face resigns, before the watch
+  *          enters low energy mode, when the buffer fills, or a minute after the first of them (@see
+  *          movement_kv_flush_if_due). When the file grows too large, it is rewritten with only the live values.
+  *          Meanwhile, the waiting values that fit are journaled in the free backup registers; if the watch resets
+  *          before they're written, this puts them back and writes them out.
+  */
+void movement_kv_init(void);
+
+/** @brief Reads a value from the store.
+  * @param key The key to read.
+  * @param value A buffer of at least length bytes.
+  * @param length The size of the buffer. Pass 0 (and NULL for value) to find out how long the value is.
+  * @return The length of the stored value, which may be more than length (in which case the value was truncated),
+  *         or -1 if there is no such key.
+  */
+int32_t movement_kv_get(const char *key, void *value, uint8_t length);
+
+/** @brief Stores a value. The write is deferred; call movement_kv_flush if it has to hit flash right away.
+  * @param key The key to set, at most MOVEMENT_KV_KEY_MAX characters.
+  * @param value The value to store.
+  * @param length The length of the value, from 1 to MOVEMENT_KV_VALUE_MAX bytes.
+  * @return true if the value was stored; false if the key or value was too long, or the store is full.
+  */
+bool movement_kv_set(const char *key, const void *value, uint8_t length);
+
+/** @brief Removes a key from the store. Like movement_kv_set, the removal is deferred.
+  * @return true if the key was removed, or didn't exist.
+  */
+bool movement_kv_delete(const char *key);
+
+/** @brief Moves a setting that a face used to keep in a file of its own into the store, then removes the file.
+  *        Does nothing if the key is already set, or if the file is missing or isn't the expected size.
+  * @param key The key to store the file's contents under.
+  * @param filename The old file.
+  * @param length The size the file should be.
+  */
+void movement_kv_import_file(const char *key, char *filename, uint8_t length);
+
+/** @brief Writes out deferred changes once they've waited a minute, or right away if the battery is low. Movement
+  *        calls this on each trip through its loop, so a face that saves a count on every button press costs one
+  *        write to flash for the whole session instead of one for each press.
+  * @return false if the changes were due and couldn't be written; true otherwise.
+  */
+bool movement_kv_flush_if_due(void);
+
+/** @brief Writes any deferred changes to flash. Does nothing if there aren't any.
+  * @return true if the changes were written; false otherwise.
+  */
+bool movement_kv_flush(void);
+
+#endif // MOVEMENT_KV_H_
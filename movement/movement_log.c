@@ -0,0 +1,299 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "movement_log.h"
+#include "filesystem.h"
+#include "movement_scratch.h"
+
+// how much of a file a scan reads at once.
+#define MOVEMENT_LOG_SCAN_SIZE (256)
+
+static void _movement_log_filename(movement_log_t *log, uint8_t file_index, char *filename) {
+    sprintf(filename, "%s.%u", log->name, file_index);
+}
+
+static uint8_t _movement_log_pending_capacity(movement_log_t *log) {
+    return MOVEMENT_LOG_BUFFER_SIZE / log->record_size;
+}
+
+static bool _movement_log_start_file(movement_log_t *log, uint8_t file_index) {
+    char filename[MOVEMENT_LOG_NAME_MAX + 3];
+    _movement_log_filename(log, file_index, filename);
+    log->current_file = file_index;
+    log->file_records[file_index] = 0;
+    log->rotations++;
+    // writing zero bytes truncates the file, leaving it in place as the marker for where the log resumes.
+    return filesystem_write_file(filename, "", 0);
+}
+
+bool movement_log_init(movement_log_t *log, const char *name, uint8_t record_size, uint16_t records_per_file, uint8_t num_files) {
+    if (strlen(name) > MOVEMENT_LOG_NAME_MAX || record_size == 0 || record_size > MOVEMENT_LOG_BUFFER_SIZE) return false;
+    if (records_per_file == 0 || num_files < 2 || num_files > MOVEMENT_LOG_MAX_FILES) return false;
+
+    memset(log, 0, sizeof(movement_log_t));
+    strcpy(log->name, name);
+    log->record_size = record_size;
+    log->records_per_file = records_per_file;
+    log->num_files = num_files;
+
+    // the log resumes in its one partially filled file. files are truncated as soon as the log rotates into
+    // them, so the first such file that exists is the current one; failing that, the first that doesn't.
+    int8_t first_partial = -1;
+    int8_t first_missing = -1;
+    for (uint8_t i = 0; i < num_files; i++) {
+        char filename[MOVEMENT_LOG_NAME_MAX + 3];
+        _movement_log_filename(log, i, filename);
+        int32_t size = filesystem_get_file_size(filename);
+        if (size < 0) {
+            if (first_missing < 0) first_missing = i;
+            continue;
+        }
+        uint32_t records = size / record_size;
+        log->file_records[i] = records > records_per_file ? records_per_file : records;
+        if (first_partial < 0 && log->file_records[i] < records_per_file) first_partial = i;
+    }
+
+    if (first_partial >= 0) {
+        log->current_file = first_partial;
+    } else if (first_missing >= 0) {
+        log->current_file = first_missing;
+    } else {
+        // every file is full, which only happens if we lost power mid-rotation. the oldest file is unknowable
+        // at this point, so sacrifice the first one.
+        return _movement_log_start_file(log, 0);
+    }
+
+    return true;
+}
+
+bool movement_log_flush(movement_log_t *log) {
+    if (log->num_pending == 0) return true;
+
+    char filename[MOVEMENT_LOG_NAME_MAX + 3];
+    _movement_log_filename(log, log->current_file, filename);
+    if (!filesystem_append_file(filename, (char *)log->pending, log->num_pending * log->record_size)) return false;
+
+    log->file_records[log->current_file] += log->num_pending;
+    log->num_pending = 0;
+
+    // rotate eagerly, so that the partially filled file always tells us where to pick up after a reset.
+    if (log->file_records[log->current_file] >= log->records_per_file) {
+        return _movement_log_start_file(log, (log->current_file + 1) % log->num_files);
+    }
+
+    return true;
+}
+
+bool movement_log_append(movement_log_t *log, const void *record) {
+    memcpy(log->pending + log->num_pending * log->record_size, record, log->record_size);
+    log->num_pending++;
+
+    // flush once the page is full, or once the buffer holds exactly enough to fill the current file; that
+    // way a batch never straddles two files.
+    if (log->num_pending >= _movement_log_pending_capacity(log) ||
+        log->file_records[log->current_file] + log->num_pending >= log->records_per_file) {
+        if (!movement_log_flush(log)) {
+            // hang on to what we can for the next attempt; if the buffer is full, the oldest record makes room.
+            if (log->num_pending >= _movement_log_pending_capacity(log)) {
+                log->num_pending--;
+                memmove(log->pending, log->pending + log->record_size, log->num_pending * log->record_size);
+            }
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void movement_log_erase(movement_log_t *log) {
+    for (uint8_t i = 0; i < log->num_files; i++) {
+        char filename[MOVEMENT_LOG_NAME_MAX + 3];
+        _movement_log_filename(log, i, filename);
+        if (filesystem_file_exists(filename)) filesystem_rm(filename);
+        log->file_records[i] = 0;
+    }
+    log->current_file = 0;
+    log->num_pending = 0;
+    // as far as summaries can tell, every file has started over.
+    log->rotations += log->num_files;
+}
+
+uint32_t movement_log_count(movement_log_t *log) {
+    uint32_t count = log->num_pending;
+    for (uint8_t i = 0; i < log->num_files; i++) count += log->file_records[i];
+    return count;
+}
+
+bool movement_log_read(movement_log_t *log, uint32_t index, void *record) {
+    if (index < log->num_pending) {
+        memcpy(record, log->pending + (log->num_pending - 1 - index) * log->record_size, log->record_size);
+        return true;
+    }
+    index -= log->num_pending;
+
+    // walk backwards from the current file, which holds the newest records.
+    uint8_t file_index = log->current_file;
+    for (uint8_t i = 0; i < log->num_files; i++) {
+        uint16_t records = log->file_records[file_index];
+        if (index < records) {
+            char filename[MOVEMENT_LOG_NAME_MAX + 3];
+            _movement_log_filename(log, file_index, filename);
+            return filesystem_read_file_at(filename, record, (records - 1 - index) * log->record_size, log->record_size);
+        }
+        index -= records;
+        file_index = (file_index + log->num_files - 1) % log->num_files;
+    }
+
+    return false;
+}
+
+void movement_log_cursor_init(movement_log_cursor_t *cursor, movement_log_t *log) {
+    cursor->log = log;
+    cursor->index = 0;
+}
+
+bool movement_log_cursor_next(movement_log_cursor_t *cursor, void *record) {
+    if (!movement_log_read(cursor->log, cursor->index, record)) return false;
+    cursor->index++;
+    return true;
+}
+
+static void _movement_log_aggregate_clear(movement_log_aggregate_t *aggregate) {
+    aggregate->count = 0;
+    aggregate->min = INT32_MAX;
+    aggregate->max = INT32_MIN;
+    aggregate->sum = 0;
+}
+
+static void _movement_log_aggregate_add(movement_log_aggregate_t *aggregate, int32_t value) {
+    aggregate->count++;
+    if (value < aggregate->min) aggregate->min = value;
+    if (value > aggregate->max) aggregate->max = value;
+    aggregate->sum += value;
+}
+
+static void _movement_log_aggregate_merge(movement_log_aggregate_t *aggregate, const movement_log_aggregate_t *other) {
+    aggregate->count += other->count;
+    if (other->min < aggregate->min) aggregate->min = other->min;
+    if (other->max > aggregate->max) aggregate->max = other->max;
+    aggregate->sum += other->sum;
+}
+
+// adds the records of a file from first, counting from its oldest, to the aggregate, reading as many at once as fit.
+static bool _movement_log_scan(movement_log_summary_t *summary, uint8_t file_index, uint16_t first, uint16_t count, movement_log_aggregate_t *aggregate) {
+    movement_log_t *log = summary->log;
+    uint16_t per_read = MOVEMENT_LOG_SCAN_SIZE / log->record_size;
+    uint8_t *buffer = movement_scratch_borrow(MOVEMENT_LOG_SCAN_SIZE);
+    if (buffer == NULL) return false;
+
+    char filename[MOVEMENT_LOG_NAME_MAX + 3];
+    _movement_log_filename(log, file_index, filename);
+    bool success = true;
+    while (count && success) {
+        uint16_t records = count < per_read ? count : per_read;
+        success = filesystem_read_file_at(filename, (char *)buffer, first * log->record_size, records * log->record_size);
+        for (uint16_t i = 0; success && i < records; i++) {
+            _movement_log_aggregate_add(aggregate, summary->value(buffer + i * log->record_size));
+        }
+        first += records;
+        count -= records;
+    }
+    movement_scratch_release(buffer);
+
+    return success;
+}
+
+void movement_log_summary_init(movement_log_summary_t *summary, movement_log_t *log, movement_log_value_t value) {
+    summary->log = log;
+    summary->value = value;
+    summary->rotations = log->rotations;
+    for (uint8_t i = 0; i < MOVEMENT_LOG_MAX_FILES; i++) {
+        summary->summarized[i] = 0;
+        _movement_log_aggregate_clear(&summary->files[i]);
+    }
+}
+
+// brings a file's summary up to date: from scratch if the log has started it over since, or else with what's new.
+static bool _movement_log_summarize_file(movement_log_summary_t *summary, uint8_t file_index) {
+    movement_log_t *log = summary->log;
+
+    // each rotation started one file over, walking back from the current one.
+    uint16_t rotated = log->rotations - summary->rotations;
+    for (uint16_t i = 0; i < rotated && i < log->num_files; i++) {
+        uint8_t started = (log->current_file + log->num_files - i) % log->num_files;
+        summary->summarized[started] = 0;
+        _movement_log_aggregate_clear(&summary->files[started]);
+    }
+    summary->rotations = log->rotations;
+
+    uint16_t records = log->file_records[file_index];
+    if (summary->summarized[file_index] == records) return true;
+    if (!_movement_log_scan(summary, file_index, summary->summarized[file_index], records - summary->summarized[file_index], &summary->files[file_index])) {
+        // what was read may have been counted, so the summary starts over next time.
+        summary->summarized[file_index] = 0;
+        _movement_log_aggregate_clear(&summary->files[file_index]);
+        return false;
+    }
+    summary->summarized[file_index] = records;
+
+    return true;
+}
+
+bool movement_log_aggregate(movement_log_summary_t *summary, uint32_t index, uint32_t count, movement_log_aggregate_t *result) {
+    movement_log_t *log = summary->log;
+    _movement_log_aggregate_clear(result);
+
+    // the records still in RAM come first, newest last in the buffer.
+    while (count && index < log->num_pending) {
+        _movement_log_aggregate_add(result, summary->value(log->pending + (log->num_pending - 1 - index) * log->record_size));
+        index++;
+        count--;
+    }
+    if (count == 0) return true;
+    index -= log->num_pending;
+
+    // then the files, walking backwards from the current one; index counts back from the newest record of each.
+    uint8_t file_index = log->current_file;
+    for (uint8_t i = 0; i < log->num_files && count; i++) {
+        uint16_t records = log->file_records[file_index];
+        if (index < records) {
+            uint16_t in_file = count < (uint32_t)(records - index) ? count : records - index;
+            if (index == 0 && in_file == records) {
+                if (!_movement_log_summarize_file(summary, file_index)) return false;
+                _movement_log_aggregate_merge(result, &summary->files[file_index]);
+            } else if (!_movement_log_scan(summary, file_index, records - index - in_file, in_file, result)) {
+                return false;
+            }
+            count -= in_file;
+            index = 0;
+        } else {
+            index -= records;
+        }
+        file_index = (file_index + log->num_files - 1) % log->num_files;
+    }
+
+    return true;
+}
@@ -0,0 +1,158 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MOVEMENT_LOG_H_
+#define MOVEMENT_LOG_H_
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Size of the RAM buffer that batches records before they are appended to flash. This matches the
+  *        NVM row page size, so each flush programs one full page instead of a few bytes at a time.
+  */
+#define MOVEMENT_LOG_BUFFER_SIZE (64)
+
+/** @brief Maximum number of rotating files backing a single log. */
+#define MOVEMENT_LOG_MAX_FILES (4)
+
+/** @brief Maximum length of a log's name; files are stored as "<name>.0" through "<name>.N". */
+#define MOVEMENT_LOG_NAME_MAX (8)
+
+/** @brief An append-only ring log of fixed-size binary records, stored in a set of rotating files on the
+  *        filesystem. Records are batched in RAM and written a page at a time; when the current file is full,
+  *        the oldest file is truncated and reused. Faces keep one of these in their context and should treat
+  *        its fields as private.
+  */
+typedef struct {
+    char name[MOVEMENT_LOG_NAME_MAX + 1];
+    uint8_t record_size;
+    uint8_t num_files;
+    uint16_t records_per_file;
+    uint8_t current_file;
+    uint16_t rotations;     // files started over since init, for summaries to tell what changed
+    uint16_t file_records[MOVEMENT_LOG_MAX_FILES];
+    uint8_t num_pending;
+    uint8_t pending[MOVEMENT_LOG_BUFFER_SIZE];
+} movement_log_t;
+
+/** @brief A read cursor over a log, walking from the newest record to the oldest. */
+typedef struct {
+    movement_log_t *log;
+    uint32_t index;
+} movement_log_cursor_t;
+
+/** @brief The count, minimum, maximum and sum of a value over a run of records. */
+typedef struct {
+    uint32_t count;
+    int32_t min;    // INT32_MAX if count is 0
+    int32_t max;    // INT32_MIN if count is 0
+    int32_t sum;
+} movement_log_aggregate_t;
+
+/** @brief Returns the value in a record that a summary aggregates. */
+typedef int32_t (*movement_log_value_t)(const void *record);
+
+/** @brief Summaries of each of a log's files, for answering movement_log_aggregate without reading every record.
+  *        The face that keeps the log keeps this alongside it, and should treat its fields as private.
+  */
+typedef struct {
+    movement_log_t *log;
+    movement_log_value_t value;
+    uint16_t rotations;                                     // the log's rotations when the summaries were checked
+    uint16_t summarized[MOVEMENT_LOG_MAX_FILES];            // records of each file its summary covers
+    movement_log_aggregate_t files[MOVEMENT_LOG_MAX_FILES];
+} movement_log_summary_t;
+
+/** @brief Sets up a log and picks up any records already stored under its name.
+  * @param log The log to initialize.
+  * @param name A short name for the log, at most MOVEMENT_LOG_NAME_MAX characters.
+  * @param record_size The size of each record in bytes, at most MOVEMENT_LOG_BUFFER_SIZE.
+  * @param records_per_file The number of records each file holds before the log rotates to the next one.
+  * @param num_files The number of rotating files, from 2 to MOVEMENT_LOG_MAX_FILES. The log always retains at
+  *                  least (num_files - 1) * records_per_file records.
+  * @return true if the log was set up; false if the parameters were out of range.
+  * @note The layout (record size, records per file) of an existing log must not change between firmware
+  *       versions; if it does, call movement_log_erase to start over.
+  */
+bool movement_log_init(movement_log_t *log, const char *name, uint8_t record_size, uint16_t records_per_file, uint8_t num_files);
+
+/** @brief Appends a record to the log. The record is buffered in RAM and written out once a page's worth
+  *        of records has accumulated.
+  * @param log The log to append to.
+  * @param record A pointer to record_size bytes.
+  * @return true if the record was accepted; false if a flush was needed and failed.
+  */
+bool movement_log_append(movement_log_t *log, const void *record);
+
+/** @brief Writes any buffered records to the filesystem. Records still in RAM are lost if the watch resets,
+  *        so call this before anything that might cause one (i.e. entering the bootloader).
+  * @return true if the buffered records were written (or there were none); false otherwise.
+  */
+bool movement_log_flush(movement_log_t *log);
+
+/** @brief Removes every record in the log, including those still buffered in RAM. */
+void movement_log_erase(movement_log_t *log);
+
+/** @brief Returns the number of records currently available to read, including buffered ones. */
+uint32_t movement_log_count(movement_log_t *log);
+
+/** @brief Reads a record by its age.
+  * @param log The log to read from.
+  * @param index 0 for the most recent record, 1 for the one before it, and so on.
+  * @param record A buffer of at least record_size bytes.
+  * @return true if the record was read; false if there is no record at that index.
+  */
+bool movement_log_read(movement_log_t *log, uint32_t index, void *record);
+
+/** @brief Positions a cursor at the most recent record in a log. */
+void movement_log_cursor_init(movement_log_cursor_t *cursor, movement_log_t *log);
+
+/** @brief Reads the record under the cursor and moves it one record older.
+  * @return true if a record was read; false once the cursor has passed the oldest record.
+  */
+bool movement_log_cursor_next(movement_log_cursor_t *cursor, void *record);
+
+/** @brief Sets up summaries for a log, after movement_log_init.
+  * @details Nothing is read until the first movement_log_aggregate. That reads each file once, as a whole, to
+  *          summarize it; after that, a file that's full never changes until the log rotates back into it, and the
+  *          current file's summary only has to take in the records appended since. A file is a row of flash at most,
+  *          so even the first query over weeks of records is a few reads.
+  * @param summary The summaries to set up.
+  * @param log The log they summarize.
+  * @param value Returns the value to aggregate from a record, i.e. a reading or a count.
+  */
+void movement_log_summary_init(movement_log_summary_t *summary, movement_log_t *log, movement_log_value_t value);
+
+/** @brief Aggregates the value over a range of a log's records, for charting or scrolling its history.
+  * @details Records in files the range covers completely come from the files' summaries; only the files at either
+  *          end of the range, and records still in RAM, are read record by record. Sums are 32 bits, so the values
+  *          must be small enough that a range's sum fits.
+  * @param summary Summaries set up with movement_log_summary_init.
+  * @param index The newest record in the range: 0 for the most recent record, as movement_log_read counts.
+  * @param count How many records the range reaches back from there. It ends early at the oldest record.
+  * @param result On return, the aggregate of the records in the range.
+  * @return true if the range was aggregated, which may have been no records at all; false if a read failed.
+  */
+bool movement_log_aggregate(movement_log_summary_t *summary, uint32_t index, uint32_t count, movement_log_aggregate_t *result);
+
+#endif // MOVEMENT_LOG_H_
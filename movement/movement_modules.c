@@ -0,0 +1,239 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "movement_modules.h"
+#include "filesystem.h"
+#include "movement_scratch.h"
+#include "watch.h"
+
+// without slots, nothing calls any of this.
+#if MOVEMENT_NUM_MODULE_SLOTS > 0
+
+_Static_assert(MOVEMENT_NUM_MODULE_SLOTS <= 4, "only slots 0 to 3 have faces");
+_Static_assert(MOVEMENT_MODULE_SLOT_SIZE % NVMCTRL_ROW_SIZE == 0, "slots have to start on a row");
+
+typedef enum {
+    MODULE_UNCHECKED = 0,
+    MODULE_VALID,
+    MODULE_INVALID,
+} movement_module_state_t;
+
+static movement_module_state_t _module_states[MOVEMENT_NUM_MODULE_SLOTS];
+static bool _module_active[MOVEMENT_NUM_MODULE_SLOTS];
+
+static const movement_module_api_t _api = {
+    .version = MOVEMENT_MODULE_ABI_VERSION,
+    .size = sizeof(movement_module_api_t),
+    .display_string = watch_display_string,
+    .set_indicator = watch_set_indicator,
+    .clear_indicator = watch_clear_indicator,
+    .set_colon = watch_set_colon,
+    .clear_colon = watch_clear_colon,
+    .clear_display = watch_clear_display,
+    .move_to_face = movement_move_to_face,
+    .move_to_next_face = movement_move_to_next_face,
+    .default_loop_handler = movement_default_loop_handler,
+    .request_tick_frequency = movement_request_tick_frequency,
+    .illuminate_led = movement_illuminate_led,
+    .play_signal = movement_play_signal,
+    .play_alarm = movement_play_alarm,
+    .get_local_date_time = movement_get_local_date_time,
+    .snprintf = snprintf,
+};
+
+const void *movement_module_slot_address(uint8_t slot) {
+#if __EMSCRIPTEN__
+    (void) slot;
+    return NULL;
+#else
+    if (slot >= MOVEMENT_NUM_MODULE_SLOTS || (uint32_t)(slot + 1) * MOVEMENT_MODULE_SLOT_SIZE > filesystem_get_raw_size()) return NULL;
+    const uint8_t *address = filesystem_get_raw_pointer(slot * MOVEMENT_MODULE_SLOT_SIZE);
+    // the RWWEE array isn't somewhere the CPU can run code from, so the slot has to be in main flash; an address
+    // below it wraps around to fail the same test.
+    if (address == NULL || (uint32_t)address - FLASH_ADDR + MOVEMENT_MODULE_SLOT_SIZE > FLASH_SIZE) return NULL;
+    return address;
+#endif
+}
+
+// checks what the header says against the slot it's for, before any of the rest is trusted.
+static bool _movement_module_header_fits(const movement_module_header_t *header, uint8_t slot) {
+    return header->magic == MOVEMENT_MODULE_MAGIC &&
+           header->abi_version == MOVEMENT_MODULE_ABI_VERSION &&
+           header->address == movement_module_slot_address(slot) &&
+           header->size >= sizeof(movement_module_header_t) &&
+           header->size <= MOVEMENT_MODULE_SLOT_SIZE &&
+           header->setup && header->activate && header->loop && header->resign;
+}
+
+static bool _movement_module_check(uint8_t slot) {
+    const movement_module_header_t *header = movement_module_slot_address(slot);
+    if (header == NULL || !_movement_module_header_fits(header, slot)) return false;
+
+    // the CRC is over the module as it was packed, with its own field zeroed.
+    static const uint32_t zero = 0;
+    const uint8_t *module = (const uint8_t *)header;
+    size_t crc_offset = offsetof(movement_module_header_t, crc);
+    uint32_t crc = watch_crc32_update(0, module, crc_offset);
+    crc = watch_crc32_update(crc, &zero, sizeof(zero));
+    crc = watch_crc32_update(crc, module + crc_offset + sizeof(zero), header->size - crc_offset - sizeof(zero));
+    return crc == header->crc;
+}
+
+const movement_module_header_t *movement_module_get(uint8_t slot) {
+    if (slot >= MOVEMENT_NUM_MODULE_SLOTS) return NULL;
+    if (_module_states[slot] == MODULE_UNCHECKED) {
+        _module_states[slot] = _movement_module_check(slot) ? MODULE_VALID : MODULE_INVALID;
+    }
+    return _module_states[slot] == MODULE_VALID ? movement_module_slot_address(slot) : NULL;
+}
+
+int movement_module_install(uint8_t slot, const char *filename) {
+    const uint8_t *address = movement_module_slot_address(slot);
+    if (address == NULL || _module_active[slot]) return -1;
+    int32_t size = filesystem_get_file_size((char *)filename);
+    if (size < (int32_t)sizeof(movement_module_header_t) || size > MOVEMENT_MODULE_SLOT_SIZE) return -2;
+
+    uint8_t *row = movement_scratch_borrow(NVMCTRL_ROW_SIZE);
+    if (row == NULL) return -3;
+
+    int result = 0;
+    if (!filesystem_read_file_at((char *)filename, (char *)row, 0, sizeof(movement_module_header_t)) ||
+        !_movement_module_header_fits((const movement_module_header_t *)row, slot) ||
+        ((const movement_module_header_t *)row)->size != (uint32_t)size) {
+        result = -2;
+    } else {
+        // whatever was in the slot stops running here, since it's about to be overwritten.
+        _module_states[slot] = MODULE_INVALID;
+        uint32_t offset = slot * MOVEMENT_MODULE_SLOT_SIZE;
+        for (int32_t copied = 0; copied < size; copied += NVMCTRL_ROW_SIZE) {
+            int32_t length = min(NVMCTRL_ROW_SIZE, size - copied);
+            if (!filesystem_read_file_at((char *)filename, (char *)row, copied, length) ||
+                !filesystem_write_raw(offset + copied, row, length)) {
+                result = -3;
+                break;
+            }
+        }
+        if (result == 0 && !_movement_module_check(slot)) result = -3;
+    }
+
+    movement_scratch_release(row);
+    return result;
+}
+
+bool movement_module_remove(uint8_t slot) {
+    if (movement_module_slot_address(slot) == NULL || _module_active[slot]) return false;
+    _module_states[slot] = MODULE_INVALID;
+    // an erased first row is enough to make the slot empty.
+    static const uint32_t erased = 0xFFFFFFFF;
+    return filesystem_write_raw(slot * MOVEMENT_MODULE_SLOT_SIZE, &erased, sizeof(erased));
+}
+
+static void _movement_module_setup(uint8_t slot, movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
+    (void) watch_face_index;
+    const movement_module_header_t *module = movement_module_get(slot);
+    if (module == NULL) return;
+    if (*context_ptr == NULL) {
+        *context_ptr = calloc(1, module->context_size ? module->context_size : 1);
+        if (*context_ptr == NULL) return;
+    }
+    module->setup(&_api, settings, *context_ptr);
+}
+
+static void _movement_module_activate(uint8_t slot, movement_settings_t *settings, void *context) {
+    const movement_module_header_t *module = movement_module_get(slot);
+    _module_active[slot] = true;
+    if (module && context) module->activate(&_api, settings, context);
+}
+
+static bool _movement_module_loop(uint8_t slot, movement_event_t event, movement_settings_t *settings, void *context) {
+    const movement_module_header_t *module = movement_module_get(slot);
+    if (module && context) return module->loop(&_api, event, settings, context);
+
+    if (event.event_type == EVENT_ACTIVATE) {
+        char buf[11];
+        sprintf(buf, "MD%2d  none", slot);
+        watch_display_string(buf, 0);
+    }
+    return movement_default_loop_handler(event, settings);
+}
+
+static void _movement_module_resign(uint8_t slot, movement_settings_t *settings, void *context) {
+    const movement_module_header_t *module = movement_module_get(slot);
+    if (module && context) module->resign(&_api, settings, context);
+    _module_active[slot] = false;
+}
+
+static bool _movement_module_wants_background_task(uint8_t slot, movement_settings_t *settings, void *context) {
+    const movement_module_header_t *module = movement_module_get(slot);
+    if (module == NULL || context == NULL || module->wants_background_task == NULL) return false;
+    return module->wants_background_task(&_api, settings, context);
+}
+
+int8_t movement_module_slot_for_face(const watch_face_t *face) {
+    if (face->setup == module_slot_0_face_setup) return 0;
+#if MOVEMENT_NUM_MODULE_SLOTS > 1
+    if (face->setup == module_slot_1_face_setup) return 1;
+#endif
+#if MOVEMENT_NUM_MODULE_SLOTS > 2
+    if (face->setup == module_slot_2_face_setup) return 2;
+#endif
+#if MOVEMENT_NUM_MODULE_SLOTS > 3
+    if (face->setup == module_slot_3_face_setup) return 3;
+#endif
+    return -1;
+}
+
+// each slot's face is a set of functions that pass the slot's number on to the ones above.
+#define _MOVEMENT_MODULE_SLOT_FUNCTIONS(n) \
+    void module_slot_##n##_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) { \
+        _movement_module_setup(n, settings, watch_face_index, context_ptr); \
+    } \
+    void module_slot_##n##_face_activate(movement_settings_t *settings, void *context) { \
+        _movement_module_activate(n, settings, context); \
+    } \
+    bool module_slot_##n##_face_loop(movement_event_t event, movement_settings_t *settings, void *context) { \
+        return _movement_module_loop(n, event, settings, context); \
+    } \
+    void module_slot_##n##_face_resign(movement_settings_t *settings, void *context) { \
+        _movement_module_resign(n, settings, context); \
+    } \
+    bool module_slot_##n##_face_wants_background_task(movement_settings_t *settings, void *context) { \
+        return _movement_module_wants_background_task(n, settings, context); \
+    }
+
+_MOVEMENT_MODULE_SLOT_FUNCTIONS(0)
+#if MOVEMENT_NUM_MODULE_SLOTS > 1
+_MOVEMENT_MODULE_SLOT_FUNCTIONS(1)
+#endif
+#if MOVEMENT_NUM_MODULE_SLOTS > 2
+_MOVEMENT_MODULE_SLOT_FUNCTIONS(2)
+#endif
+#if MOVEMENT_NUM_MODULE_SLOTS > 3
+_MOVEMENT_MODULE_SLOT_FUNCTIONS(3)
+#endif
+
+#endif // MOVEMENT_NUM_MODULE_SLOTS > 0
@@ -0,0 +1,167 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MOVEMENT_MODULES_H_
+#define MOVEMENT_MODULES_H_
+#include <stddef.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "movement.h"
+
+/** @file movement_modules.h
+  * @brief Faces installed over USB serial, without rebuilding the firmware.
+  * @details A module is a face built on its own (see movement/modules) and copied into a slot: a fixed stretch of the
+  *          filesystem's raw partition, which has to sit in main flash (FILESYSTEM_MAIN_FLASH_KB) so that the module
+  *          can run in place. The Cortex-M0+ has no MMU and GCC's position-independent code needs a GOT set up at
+  *          run time, so rather than being position-independent, a module is linked at the address of the slot it's
+  *          meant for, which the shell's module command lists. It calls Movement and the watch library only through
+  *          the table of functions it's handed (movement_module_api_t), never directly, so one build of a module
+  *          works with any firmware that has the same MOVEMENT_MODULE_ABI_VERSION and slot addresses.
+  *
+  *          Each slot is a face in watch_faces: add module_slot_0_face and so on to movement_config.h, and build with
+  *          MODULE_SLOTS set to how many. A slot with nothing valid in it is left out of the face order at boot. The
+  *          module in a slot is checked (its magic, ABI version, address and CRC) the first time the slot is used,
+  *          and a new one installed with the shell's module command takes over when the watch restarts.
+  *
+  *          A module has no .data or .bss of its own; it keeps its state in the context Movement sets aside for it,
+  *          context_size bytes zeroed when the slot is first set up.
+  */
+
+#ifndef MOVEMENT_NUM_MODULE_SLOTS
+#define MOVEMENT_NUM_MODULE_SLOTS 0
+#endif
+
+/** @brief Bytes in each slot; slot n starts n slots into the raw partition. A multiple of the 256-byte row. */
+#ifndef MOVEMENT_MODULE_SLOT_SIZE
+#define MOVEMENT_MODULE_SLOT_SIZE 2048
+#endif
+
+#define MOVEMENT_MODULE_MAGIC 0x444D564D    // "MVMD"
+/// Changes whenever the table below or the header changes in a way older modules can't cope with. Functions are only
+/// ever added to the end of the table, and a module can check the table's size for those it needs.
+#define MOVEMENT_MODULE_ABI_VERSION 1
+
+/** @brief What Movement and the watch library offer a module, as of MOVEMENT_MODULE_ABI_VERSION. */
+typedef struct {
+    uint16_t version;
+    uint16_t size;
+    void (*display_string)(char *string, uint8_t position);
+    void (*set_indicator)(WatchIndicatorSegment indicator);
+    void (*clear_indicator)(WatchIndicatorSegment indicator);
+    void (*set_colon)(void);
+    void (*clear_colon)(void);
+    void (*clear_display)(void);
+    void (*move_to_face)(uint8_t watch_face_index);
+    void (*move_to_next_face)(void);
+    bool (*default_loop_handler)(movement_event_t event, movement_settings_t *settings);
+    void (*request_tick_frequency)(uint8_t freq);
+    void (*illuminate_led)(void);
+    void (*play_signal)(void);
+    void (*play_alarm)(void);
+    watch_date_time (*get_local_date_time)(void);
+    int (*snprintf)(char *buffer, size_t size, const char *format, ...);
+} movement_module_api_t;
+
+/** @brief The start of every module, at its slot's address. Its functions are a face's, with the table first. */
+typedef struct {
+    uint32_t magic;
+    uint16_t abi_version;
+    uint16_t context_size;
+    // the whole module, header and all, and its CRC-32 taken with this field zeroed; utils/module_pack.py fills
+    // both in after linking.
+    uint32_t size;
+    uint32_t crc;
+    // where the module was linked to run, which has to be the slot it's in.
+    const void *address;
+    char name[8];
+    void (*setup)(const movement_module_api_t *api, movement_settings_t *settings, void *context);
+    void (*activate)(const movement_module_api_t *api, movement_settings_t *settings, void *context);
+    bool (*loop)(const movement_module_api_t *api, movement_event_t event, movement_settings_t *settings, void *context);
+    void (*resign)(const movement_module_api_t *api, movement_settings_t *settings, void *context);
+    // OPTIONAL, as it is for a face.
+    bool (*wants_background_task)(const movement_module_api_t *api, movement_settings_t *settings, void *context);
+} movement_module_header_t;
+
+/// Declares a module's header; in a module's source, not the firmware's.
+#define MOVEMENT_MODULE(name_, context_type, setup_, activate_, loop_, resign_, wants_background_task_) \
+    __attribute__((section(".module_header"), used)) const movement_module_header_t movement_module_header = { \
+        .magic = MOVEMENT_MODULE_MAGIC, \
+        .abi_version = MOVEMENT_MODULE_ABI_VERSION, \
+        .context_size = sizeof(context_type), \
+        .address = &movement_module_header, \
+        .name = name_, \
+        .setup = setup_, \
+        .activate = activate_, \
+        .loop = loop_, \
+        .resign = resign_, \
+        .wants_background_task = wants_background_task_, \
+    }
+
+/** @brief Returns the module installed in a slot, checked; or NULL if the slot is empty or what's in it won't run. */
+const movement_module_header_t *movement_module_get(uint8_t slot);
+
+/** @brief Returns the address a module for a slot has to be linked at, or NULL if there's no such slot or it isn't in
+  *        main flash.
+  */
+const void *movement_module_slot_address(uint8_t slot);
+
+/** @brief Returns the slot a face in watch_faces runs, or -1 if it isn't a module slot. */
+int8_t movement_module_slot_for_face(const watch_face_t *face);
+
+/** @brief Copies a module out of a file into a slot, and reads it back to check it. The slot is empty from the start
+  *        of the copy until the watch restarts, when the new module is checked and takes over.
+  * @return 0 on success, or a negative number if the slot's face is on screen, the file doesn't fit or isn't a
+  *         module for this slot, or the flash couldn't be written.
+  */
+int movement_module_install(uint8_t slot, const char *filename);
+
+/** @brief Erases the module in a slot. As with an install, the face stops running it when the watch restarts. */
+bool movement_module_remove(uint8_t slot);
+
+#define _MOVEMENT_MODULE_SLOT_DECLARATIONS(n) \
+    void module_slot_##n##_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr); \
+    void module_slot_##n##_face_activate(movement_settings_t *settings, void *context); \
+    bool module_slot_##n##_face_loop(movement_event_t event, movement_settings_t *settings, void *context); \
+    void module_slot_##n##_face_resign(movement_settings_t *settings, void *context); \
+    bool module_slot_##n##_face_wants_background_task(movement_settings_t *settings, void *context);
+
+#define _MOVEMENT_MODULE_SLOT_FACE(n) ((const watch_face_t){ \
+    module_slot_##n##_face_setup, \
+    module_slot_##n##_face_activate, \
+    module_slot_##n##_face_loop, \
+    module_slot_##n##_face_resign, \
+    module_slot_##n##_face_wants_background_task, \
+})
+
+_MOVEMENT_MODULE_SLOT_DECLARATIONS(0)
+_MOVEMENT_MODULE_SLOT_DECLARATIONS(1)
+_MOVEMENT_MODULE_SLOT_DECLARATIONS(2)
+_MOVEMENT_MODULE_SLOT_DECLARATIONS(3)
+
+#define module_slot_0_face _MOVEMENT_MODULE_SLOT_FACE(0)
+#define module_slot_1_face _MOVEMENT_MODULE_SLOT_FACE(1)
+#define module_slot_2_face _MOVEMENT_MODULE_SLOT_FACE(2)
+#define module_slot_3_face _MOVEMENT_MODULE_SLOT_FACE(3)
+
+#endif // MOVEMENT_MODULES_H_
@@ -0,0 +1,108 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "movement_moon.h"
+#include "movement_moon_table.h"
+
+#define MOVEMENT_MOON_MEAN_LUNATION 2551443     // 29.530589 days, in seconds
+#define MOVEMENT_MOON_PHASE_WINDOW 86400        // new, quarter and full phases last a day either side of the moment
+
+static uint32_t moon_cached_start;
+static uint32_t moon_cached_end;
+
+static void _movement_moon_find_lunation(uint32_t utc_timestamp, uint32_t *start, uint32_t *end) {
+    if (moon_cached_end != 0 && utc_timestamp >= moon_cached_start && utc_timestamp < moon_cached_end) {
+        *start = moon_cached_start;
+        *end = moon_cached_end;
+        return;
+    }
+
+    const uint32_t first = Moon_New_Moons[0];
+    const uint32_t last = Moon_New_Moons[MOON_TABLE_NUM_NEW_MOONS - 1];
+    if (utc_timestamp < first) {
+        // count whole mean lunations back from the start of the table.
+        int64_t lunations = (first - utc_timestamp + MOVEMENT_MOON_MEAN_LUNATION - 1) / MOVEMENT_MOON_MEAN_LUNATION;
+        int64_t new_moon = (int64_t)first - lunations * MOVEMENT_MOON_MEAN_LUNATION;
+        if (new_moon < 0) new_moon = 0;
+        *start = (uint32_t)new_moon;
+        *end = *start + MOVEMENT_MOON_MEAN_LUNATION;
+    } else if (utc_timestamp >= last) {
+        // and forward from its end.
+        *start = last + ((utc_timestamp - last) / MOVEMENT_MOON_MEAN_LUNATION) * MOVEMENT_MOON_MEAN_LUNATION;
+        *end = *start + MOVEMENT_MOON_MEAN_LUNATION;
+    } else {
+        // binary search for the last new moon at or before the timestamp.
+        uint16_t low = 0;
+        uint16_t high = MOON_TABLE_NUM_NEW_MOONS - 1;
+        while (high - low > 1) {
+            uint16_t mid = (low + high) / 2;
+            if (Moon_New_Moons[mid] <= utc_timestamp) low = mid;
+            else high = mid;
+        }
+        *start = Moon_New_Moons[low];
+        *end = Moon_New_Moons[low + 1];
+    }
+
+    moon_cached_start = *start;
+    moon_cached_end = *end;
+}
+
+static uint16_t _movement_moon_illumination(uint16_t fraction) {
+    // the table covers new to full; the waning half mirrors it.
+    uint32_t x = fraction <= 32768 ? fraction : 65536 - (uint32_t)fraction;
+    uint32_t index = x >> MOON_TABLE_ILLUMINATION_SHIFT;
+    uint32_t remainder = x & ((1 << MOON_TABLE_ILLUMINATION_SHIFT) - 1);
+    if (index >= MOON_TABLE_ILLUMINATION_STEPS) return Moon_Illumination[MOON_TABLE_ILLUMINATION_STEPS];
+
+    uint32_t a = Moon_Illumination[index];
+    uint32_t b = Moon_Illumination[index + 1];
+    return (uint16_t)(a + (((b - a) * remainder) >> MOON_TABLE_ILLUMINATION_SHIFT));
+}
+
+movement_moon_phase_t movement_moon_get_phase(uint32_t utc_timestamp) {
+    movement_moon_phase_t result;
+    uint32_t end;
+    _movement_moon_find_lunation(utc_timestamp, &result.new_moon, &end);
+    result.age = utc_timestamp - result.new_moon;
+    result.length = end - result.new_moon;
+    result.fraction = (uint16_t)(((uint64_t)result.age << 16) / result.length);
+    result.illumination = _movement_moon_illumination(result.fraction);
+
+    if (result.age < MOVEMENT_MOON_PHASE_WINDOW || result.age >= result.length - MOVEMENT_MOON_PHASE_WINDOW) {
+        result.phase = MOVEMENT_MOON_NEW;
+        return result;
+    }
+    uint32_t quarter = result.length / 4;
+    for (uint8_t i = 1; i < 4; i++) {
+        if (result.age + MOVEMENT_MOON_PHASE_WINDOW > i * quarter && result.age <= i * quarter + MOVEMENT_MOON_PHASE_WINDOW) {
+            // first quarter, full, third quarter
+            result.phase = (movement_moon_phase_name_t)(i * 2);
+            return result;
+        }
+    }
+    // otherwise a crescent or gibbous phase, waxing or waning depending on the quarter it's in.
+    result.phase = (movement_moon_phase_name_t)((result.age / quarter) * 2 + 1);
+
+    return result;
+}
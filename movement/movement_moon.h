@@ -0,0 +1,62 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MOVEMENT_MOON_H_
+#define MOVEMENT_MOON_H_
+#include <stdint.h>
+
+/** @brief The eight traditional phases. New, first quarter, full and third quarter each last from a day before the
+  *        exact moment to a day after; the crescents and gibbous phases fill the time in between.
+  */
+typedef enum {
+    MOVEMENT_MOON_NEW = 0,
+    MOVEMENT_MOON_WAXING_CRESCENT,
+    MOVEMENT_MOON_FIRST_QUARTER,
+    MOVEMENT_MOON_WAXING_GIBBOUS,
+    MOVEMENT_MOON_FULL,
+    MOVEMENT_MOON_WANING_GIBBOUS,
+    MOVEMENT_MOON_THIRD_QUARTER,
+    MOVEMENT_MOON_WANING_CRESCENT,
+} movement_moon_phase_name_t;
+
+typedef struct {
+    uint32_t new_moon;      // UTC timestamp of the new moon that began this lunation
+    uint32_t age;           // seconds since that new moon
+    uint32_t length;        // seconds from that new moon to the next one
+    uint16_t fraction;      // age / length, in 65536ths of the lunation
+    uint16_t illumination;  // lit fraction of the disc, in thousandths
+    movement_moon_phase_name_t phase;
+} movement_moon_phase_t;
+
+/** @brief Returns the phase of the Moon at a moment in time.
+  * @param utc_timestamp The moment, as a UNIX timestamp.
+  * @details New moons between 2020 and 2060 come from a precomputed table (see utils/gen_moon_table.py), so each
+  *          lunation has its true length, and everything else is integer math. The lunation found last is
+  *          remembered, so asking again anywhere inside it (as a face does every hour, or every day it steps
+  *          forward) doesn't even search the table. Outside the table, lunations are counted at their mean length
+  *          of 29.53 days from the nearest end, which drifts by up to half a day.
+  */
+movement_moon_phase_t movement_moon_get_phase(uint32_t utc_timestamp);
+
+#endif // MOVEMENT_MOON_H_
@@ -0,0 +1,108 @@
+// This file is generated by utils/gen_moon_table.py. Do not edit.
+#ifndef MOVEMENT_MOON_TABLE_H_
+#define MOVEMENT_MOON_TABLE_H_
+
+#include <stdint.h>
+
+// UTC timestamps of every new moon from the last one of 2019 to the first one of 2061.
+#define MOON_TABLE_NUM_NEW_MOONS 509
+static const uint32_t Moon_New_Moons[MOON_TABLE_NUM_NEW_MOONS] = {
+    1577337193, 1579902120, 1582471916, 1585042084, 1587608741, 1590169123,
+    1592721678, 1595266366, 1597804889, 1600340398, 1602876652, 1605416830,
+    1607962594, 1610514008, 1613070341, 1615630866, 1618194645, 1620759588,
+    1623322357, 1625879791, 1628430604, 1630975901, 1633518315, 1636060473,
+    1638603780, 1641148408, 1643694360, 1646242482, 1648794256, 1651350477,
+    1653910206, 1656471123, 1659030889, 1661588216, 1664142864, 1666694913,
+    1669244226, 1671790607, 1674334390, 1676876744, 1679419382, 1681963946,
+    1684511589, 1687063022, 1689618702, 1692178683, 1694741986, 1697306108,
+    1699867638, 1702423916, 1704974238, 1707519542, 1710061219, 1712600448,
+    1715138511, 1717677456, 1720220237, 1722769976, 1725328529, 1727894958,
+    1730465235, 1733034088, 1735597606, 1738154154, 1740703480, 1743245859,
+    1745782265, 1748314936, 1750847487, 1753384263, 1755929183, 1758484436,
+    1761049504, 1763621235, 1766195002, 1768765921, 1771329669, 1773883404,
+    1776426702, 1778961656, 1781492043, 1784022209, 1786556195, 1789097210,
+    1791647396, 1794207717, 1796777506, 1799353463, 1801929363, 1804498167,
+    1807055467, 1809601109, 1812138012, 1814670116, 1817201100, 1819734059,
+    1822271760, 1824816986, 1827372255, 1829938337, 1832512347, 1835087842,
+    1837657883, 1840218413, 1842768972, 1845311249, 1847847690, 1850381014,
+    1852914215, 1855450600, 1857993473, 1860545172, 1863105864, 1865673086,
+    1868242754, 1870810810, 1873374129, 1875930632, 1878479460, 1881021345,
+    1883558658, 1886094863, 1888633441, 1891176723, 1893725365, 1896278848,
+    1898836480, 1901397746, 1903961523, 1906525274, 1909085656, 1911640252,
+    1914188840, 1916733274, 1919276211, 1921819582, 1924363923, 1926909053,
+    1929455328, 1932004141, 1934557022, 1937114230, 1939674274, 1942234807,
+    1944793936, 1947350815, 1949905246, 1952456974, 1955005540, 1957550793,
+    1960093446, 1962635072, 1965177563, 1967722536, 1970271120, 1972824088,
+    1975381889, 1977944198, 1980509189, 1983073501, 1985633572, 1988187419,
+    1990735184, 1993278200, 1995817891, 1998355565, 2000892983, 2003432815,
+    2005978350, 2008532382, 2011095583, 2013665308, 2016236351, 2018803593,
+    2021364096, 2023917012, 2026462463, 2029001143, 2031534748, 2034066347,
+    2036600106, 2039140376, 2041690419, 2044251151, 2046820571, 2049394464,
+    2051967785, 2054535723, 2057094555, 2059642651, 2062181020, 2064712832,
+    2067242348, 2069773897, 2072311162, 2074856802, 2077412316, 2079977850,
+    2082551459, 2085128235, 2087701158, 2090264204, 2092815185, 2095355807,
+    2097889769, 2100421006, 2102952901, 2105488281, 2108029790, 2110580058,
+    2113140862, 2115711262, 2118286438, 2120859372, 2123424459, 2125979649,
+    2128525807, 2131065098, 2133600076, 2136133510, 2138668456, 2141208172,
+    2143755492, 2146311681, 2148875532, 2151443699, 2154012173, 2156577569,
+    2159137442, 2161690314, 2164236005, 2166775953, 2169313037, 2171850753,
+    2174391993, 2176938110, 2179488962, 2182043853, 2184602368, 2187164080,
+    2189727477, 2192289673, 2194847626, 2197399820, 2199946970, 2202491326,
+    2205035153, 2207579509, 2210124301, 2212669456, 2215215957, 2217765603,
+    2220319669, 2222877779, 2225438074, 2227998372, 2230557209, 2233113944,
+    2235668151, 2238219180, 2240766455, 2243310161, 2245851545, 2248392556,
+    2250935171, 2253480949, 2256031006, 2258586128, 2261146554, 2263711263,
+    2266277406, 2268840988, 2271398770, 2273949714, 2276494720, 2279035368,
+    2281573150, 2284109680, 2286647278, 2289189102, 2291738465, 2294297396,
+    2296864977, 2299436896, 2302007366, 2304571980, 2307128846, 2309677740,
+    2312219181, 2314754465, 2317286094, 2319817842, 2322354151, 2324899029,
+    2327454720, 2330020641, 2332593412, 2335168075, 2337739459, 2340303128,
+    2342856345, 2345398913, 2347933164, 2350463046, 2352993013, 2355527143,
+    2358068595, 2360619374, 2363180254, 2365750378, 2368326318, 2370901854,
+    2373470083, 2376026792, 2378571983, 2381108677, 2383640889, 2386172336,
+    2388706047, 2391244600, 2393790520, 2396346069, 2398911839, 2401484977,
+    2404059313, 2406628294, 2409188149, 2411738529, 2414281119, 2416818310,
+    2419352705, 2421887114, 2424424605, 2426968189, 2429519923, 2432079820,
+    2434645549, 2437213447, 2439779981, 2442342442, 2444898934, 2447448541,
+    2449991761, 2452530672, 2455068459, 2457608320, 2460152278, 2462700726,
+    2465253078, 2467808852, 2470367974, 2472929887, 2475492590, 2478053037,
+    2480608723, 2483159067, 2485705503, 2488250293, 2490794998, 2493339852,
+    2495884533, 2498429475, 2500976335, 2503527049, 2506082398, 2508641405,
+    2511202019, 2513762304, 2516321088, 2518877690, 2521431325, 2523981088,
+    2526526599, 2529068589, 2531608833, 2534149525, 2536692641, 2539239693,
+    2541791796, 2544349632, 2546912943, 2549479705, 2552046070, 2554607870,
+    2557162675, 2559710478, 2562252732, 2564791137, 2567327333, 2569863371,
+    2572402137, 2574947086, 2577501184, 2580065201, 2582636351, 2585209005,
+    2587777521, 2590338606, 2592891335, 2595436009, 2597973632, 2600506199,
+    2603036979, 2605570240, 2608110394, 2610660749, 2613222187, 2615792535,
+    2618367292, 2620941127, 2623509079, 2626067474, 2628614887, 2631152566,
+    2633683870, 2636213175, 2638744854, 2641282555, 2643828808, 2646384916,
+    2648950820, 2651524431, 2654100832, 2656673137, 2659235540, 2661786028,
+    2664326404, 2666860425, 2669392065, 2671924681, 2674460952, 2677003278,
+    2679554012, 2682114706, 2684684355, 2687258340, 2689830040, 2692394222,
+    2694949022, 2697495331, 2700035264, 2702571276, 2705105967, 2707642164,
+    2710182841, 2712730520, 2715286233, 2717848778, 2720415136, 2722981827,
+    2725545970, 2728105432, 2730658788, 2733205677, 2735747234, 2738286021,
+    2740825237, 2743367461, 2745913753, 2748463821, 2751017080, 2753573479,
+    2756133119, 2758695058, 2761256838, 2763815505, 2766369269, 2768918406,
+    2771464740, 2774010144, 2776555343, 2779100049, 2781644200, 2784188982,
+    2786736538, 2789288595, 2791845294, 2794405181, 2796966190, 2799526647,
+    2802085487, 2804641756, 2807194301, 2809742222, 2812285633, 2814825927,
+    2817365318, 2819906109, 2822450218, 2824999111, 2827553856, 2830114843,
+    2832680987, 2835249082, 2837814551, 2840373611, 2842924949, 2845469491,
+    2848009053, 2850545449, 2853080603, 2855617070, 2858158173, 2860707366,
+    2863266802, 2865835536, 2868408952, 2870980775, 2873546174,
+};
+
+// Illuminated fraction of the disc, in thousandths, at each 1/64 of the way from new moon to full moon.
+#define MOON_TABLE_ILLUMINATION_STEPS 64
+#define MOON_TABLE_ILLUMINATION_SHIFT 9 // entries are (1 << SHIFT) apart, of the 65536 steps in a lunation
+static const uint16_t Moon_Illumination[MOON_TABLE_ILLUMINATION_STEPS + 1] = {
+    0, 1, 2, 5, 10, 15, 22, 29, 38, 48, 59, 71, 84,
+    98, 113, 130, 146, 164, 183, 202, 222, 243, 264, 286, 309, 332,
+    355, 379, 402, 427, 451, 475, 500, 525, 549, 573, 598, 621, 645,
+    668, 691, 714, 736, 757, 778, 798, 817, 836, 854, 870, 887, 902,
+    916, 929, 941, 952, 962, 971, 978, 985, 990, 995, 998, 999, 1000,
+};
+
+#endif // MOVEMENT_MOON_TABLE_H_
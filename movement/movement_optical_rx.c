@@ -0,0 +1,148 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "movement_optical_rx.h"
+#include "movement.h"
+#include "watch.h"
+
+// each reading accumulates this many conversions; 4 keeps the sampling interrupt short, and gives 14 bits.
+#define MOVEMENT_OPTICAL_RX_ADC_SAMPLES 4
+#define MOVEMENT_OPTICAL_RX_ADC_SHIFT 2
+// what the rest of the firmware expects to find the ADC set to (@see watch_set_analog_num_samples).
+#define MOVEMENT_OPTICAL_RX_ADC_DEFAULT_SAMPLES 16
+
+#if MOVEMENT_OPTICAL_RX_QUEUE_FRAMES & (MOVEMENT_OPTICAL_RX_QUEUE_FRAMES - 1) || MOVEMENT_OPTICAL_RX_QUEUE_FRAMES > 128
+#error "MOVEMENT_OPTICAL_RX_QUEUE_FRAMES must be a power of 2, so that the queue's 8-bit counts wrap around it evenly"
+#endif
+
+// the decoder and the queue, allocated while receiving. The interrupt only writes frames and advances written; the
+// main loop only reads them and advances read, so neither has to hold the other off.
+typedef struct {
+    optical_rx_state_t decoder;
+    optical_rx_frame_t frames[MOVEMENT_OPTICAL_RX_QUEUE_FRAMES];
+    volatile uint8_t written;
+    uint8_t read;
+} movement_optical_rx_buffer_t;
+
+static movement_optical_rx_buffer_t *_rx;
+static uint8_t _pin;
+static uint16_t _next_count;
+static movement_optical_rx_frame_cb_t _on_frame;
+static void *_context;
+static movement_optical_rx_report_t _report;
+
+// set from the sampling interrupt, cleared by the main loop.
+static volatile bool _needs_service;
+
+static void _movement_optical_rx_cb_sample(void) {
+    movement_optical_rx_buffer_t *rx = _rx;
+    uint16_t sample = watch_get_analog_pin_level(_pin) << MOVEMENT_OPTICAL_RX_ADC_SHIFT;
+    _report.samples++;
+    if (optical_rx_add_sample(&rx->decoder, sample)) {
+        if ((uint8_t)(rx->written - rx->read) < MOVEMENT_OPTICAL_RX_QUEUE_FRAMES) {
+            optical_rx_frame_t *frame = &rx->frames[rx->written % MOVEMENT_OPTICAL_RX_QUEUE_FRAMES];
+            frame->type = rx->decoder.frame.type;
+            frame->length = rx->decoder.frame.length;
+            memcpy(frame->payload, rx->decoder.frame.payload, frame->length);
+            rx->written++;
+            _needs_service = true;
+        } else {
+            _report.dropped++;
+        }
+    }
+
+    // counting on from the last sample rather than from now keeps the rate steady if an interrupt runs late.
+    _next_count++;
+    watch_monotonic_set_compare(_next_count, _movement_optical_rx_cb_sample);
+}
+
+bool movement_optical_rx_start(uint8_t pin, uint8_t samples_per_bit, movement_optical_rx_frame_cb_t on_frame, void *context) {
+    if (_rx != NULL) return false;
+    _rx = malloc(sizeof(movement_optical_rx_buffer_t));
+    if (_rx == NULL) return false;
+
+    optical_rx_init(&_rx->decoder, samples_per_bit);
+    _rx->written = 0;
+    _rx->read = 0;
+    _pin = pin;
+    _on_frame = on_frame;
+    _context = context;
+    memset(&_report, 0, sizeof(_report));
+    _needs_service = false;
+
+    watch_claim_peripheral(WATCH_PERIPHERAL_ADC);
+    watch_enable_analog_input(pin);
+    watch_set_analog_num_samples(MOVEMENT_OPTICAL_RX_ADC_SAMPLES);
+    watch_monotonic_start();
+    _next_count = watch_get_monotonic_ticks() + 1;
+    watch_monotonic_set_compare(_next_count, _movement_optical_rx_cb_sample);
+
+    return true;
+}
+
+void movement_optical_rx_stop(void) {
+    if (_rx == NULL) return;
+
+    // once the callback is cancelled, the interrupt won't touch the buffer again.
+    watch_monotonic_set_compare(0, NULL);
+    watch_monotonic_stop();
+    watch_set_analog_num_samples(MOVEMENT_OPTICAL_RX_ADC_DEFAULT_SAMPLES);
+    watch_disable_analog_input(_pin);
+    watch_release_peripheral(WATCH_PERIPHERAL_ADC);
+
+    _report.bad_frames = _rx->decoder.bad_frames;
+    _report.framing_errors = _rx->decoder.framing_errors;
+    free(_rx);
+    _rx = NULL;
+    _needs_service = false;
+}
+
+bool movement_optical_rx_is_receiving(void) {
+    return _rx != NULL;
+}
+
+void movement_optical_rx_get_report(movement_optical_rx_report_t *report) {
+    *report = _report;
+    if (_rx != NULL) {
+        report->bad_frames = _rx->decoder.bad_frames;
+        report->framing_errors = _rx->decoder.framing_errors;
+    }
+}
+
+bool movement_optical_rx_needs_service(void) {
+    return _needs_service;
+}
+
+void movement_optical_rx_service(void) {
+    _needs_service = false;
+    // the face may stop the receiver from its callback, which frees the queue.
+    while (_rx != NULL && _rx->read != _rx->written) {
+        optical_rx_frame_t *frame = &_rx->frames[_rx->read % MOVEMENT_OPTICAL_RX_QUEUE_FRAMES];
+        _report.frames++;
+        if (_on_frame != NULL) _on_frame(frame, _context);
+        if (_rx != NULL) _rx->read++;
+    }
+}
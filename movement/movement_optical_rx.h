@@ -0,0 +1,89 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MOVEMENT_OPTICAL_RX_H_
+#define MOVEMENT_OPTICAL_RX_H_
+#include <stdint.h>
+#include <stdbool.h>
+#include "optical_rx.h"
+#include "watch.h"
+
+/** @brief How many frames can be waiting for the main loop to hand them to the face; a power of 2. */
+#ifndef MOVEMENT_OPTICAL_RX_QUEUE_FRAMES
+#define MOVEMENT_OPTICAL_RX_QUEUE_FRAMES 4
+#endif
+
+/** @brief Samples a second; one for each count of the monotonic counter. */
+#define MOVEMENT_OPTICAL_RX_SAMPLE_RATE WATCH_MONOTONIC_TICKS_PER_SECOND
+
+/** @brief Called from the main loop with each frame that arrives with a good CRC.
+  * @param frame The frame; it's only good until the callback returns.
+  * @param context Whatever was passed to movement_optical_rx_start.
+  */
+typedef void (*movement_optical_rx_frame_cb_t)(const optical_rx_frame_t *frame, void *context);
+
+typedef struct {
+    uint32_t samples;           // light levels read so far
+    uint16_t frames;            // frames that arrived with a good CRC
+    uint16_t bad_frames;        // frames dropped for a bad CRC or length
+    uint16_t framing_errors;    // bytes whose stop bit was dark, which means the bits got out of step
+    uint16_t dropped;           // good frames that came in while the queue was full
+} movement_optical_rx_report_t;
+
+/** @brief Receives data sent as flashes of light, read from a light sensor on one of the analog pins.
+  * @details The sensor is sampled MOVEMENT_OPTICAL_RX_SAMPLE_RATE times a second from the monotonic counter's
+  *          interrupt, and the samples are decoded there (@see optical_rx.h for the framing); each frame that
+  *          arrives whole is queued and handed to on_frame from the main loop, so the face can stand by meanwhile.
+  *          The sensor circuit has to be powered by the face, if it needs powering. The sender holds each bit for
+  *          samples_per_bit samples, and its clock has to be within 2% of the watch's at 4 samples a bit; at 4,
+  *          that's 128 bits a second. A phone's screen only changes 60 times a second, so a screen can only send at
+  *          16 samples a bit (32 bits a second) or slower; an LED, or a phone's torch, can go faster.
+  * @param pin The analog pin the sensor is on, A0 to A4. Brighter has to read higher.
+  * @param samples_per_bit How many samples each bit lasts for, at least 3.
+  * @param on_frame Called with each frame that arrives.
+  * @param context Passed to on_frame.
+  * @return true if the receiver has started; false if it's already running, or there was no room for it.
+  */
+bool movement_optical_rx_start(uint8_t pin, uint8_t samples_per_bit, movement_optical_rx_frame_cb_t on_frame, void *context);
+
+/** @brief Stops receiving; frames still in the queue are dropped. Call it from your resign function if you started it. */
+void movement_optical_rx_stop(void);
+
+/** @brief Returns true from movement_optical_rx_start until movement_optical_rx_stop. */
+bool movement_optical_rx_is_receiving(void);
+
+/** @brief Reports how the reception is going, or how the last one went once it's over.
+  * @param report Filled in with the counts so far.
+  */
+void movement_optical_rx_get_report(movement_optical_rx_report_t *report);
+
+/** @brief Returns true if frames have come in and need handing to the face. */
+bool movement_optical_rx_needs_service(void);
+
+/** @brief Hands the frames that have come in to the face.
+  * @details Movement calls this from its main loop.
+  */
+void movement_optical_rx_service(void);
+
+#endif // MOVEMENT_OPTICAL_RX_H_
@@ -0,0 +1,56 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "movement_scratch.h"
+#include "watch.h"
+
+#define SCRATCH_ALIGNMENT 8
+
+static uint8_t _arena[MOVEMENT_SCRATCH_SIZE] __attribute__((aligned(SCRATCH_ALIGNMENT)));
+static size_t _top;
+static size_t _high_water;
+
+void *movement_scratch_borrow(size_t size) {
+    size = (size + SCRATCH_ALIGNMENT - 1) & ~(size_t)(SCRATCH_ALIGNMENT - 1);
+    if (size > MOVEMENT_SCRATCH_SIZE - _top) {
+        WATCH_LOG_WARN("scratch: %u bytes wanted, %u free", (unsigned)size, (unsigned)(MOVEMENT_SCRATCH_SIZE - _top));
+        return NULL;
+    }
+    void *buffer = _arena + _top;
+    _top += size;
+    if (_top > _high_water) _high_water = _top;
+
+    return buffer;
+}
+
+void movement_scratch_release(void *buffer) {
+    if (buffer == NULL) return;
+    size_t offset = (uint8_t *)buffer - _arena;
+    // releasing something already given back, with what was borrowed after it, changes nothing.
+    if (offset < _top) _top = offset;
+}
+
+size_t movement_scratch_get_high_water(void) {
+    return _high_water;
+}
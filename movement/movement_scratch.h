@@ -0,0 +1,59 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MOVEMENT_SCRATCH_H_
+#define MOVEMENT_SCRATCH_H_
+#include <stddef.h>
+#include <stdint.h>
+
+/** @brief Bytes in the scratch arena; a movement config can set its own. */
+#ifndef MOVEMENT_SCRATCH_SIZE
+#define MOVEMENT_SCRATCH_SIZE 512
+#endif
+
+/** @brief Borrows a buffer from the scratch arena, for the length of one operation.
+  * @details The arena is for big buffers that are only needed while one function runs: a flash page being scanned,
+  *          a line of a file being parsed. Kept on the stack, each one adds to how deep the stack gets when it's
+  *          called deep in some other work, and kept in a face's context, it takes RAM all the time. Borrows stack
+  *          up, so a function that borrows can call one that borrows too, and each release gives back its buffer
+  *          and anything borrowed after it. A borrow made outside any other always gets up to
+  *          MOVEMENT_SCRATCH_SIZE bytes; inside one, it gets what's left.
+  *
+  *          The buffer has to be released before the function that borrowed it returns to Movement: nothing in
+  *          it survives to the next event. Something that has to last longer, like a page filled over a whole
+  *          recording, belongs on the heap. Only call this from the main loop, not from interrupts.
+  * @param size How many bytes to borrow.
+  * @return A buffer of at least size bytes, aligned for any type and not zeroed; or NULL if there isn't room.
+  */
+void *movement_scratch_borrow(size_t size);
+
+/** @brief Gives back a buffer from movement_scratch_borrow, along with anything borrowed after it.
+  * @param buffer The buffer, or NULL, which does nothing.
+  */
+void movement_scratch_release(void *buffer);
+
+/** @brief Returns the most of the arena that has been borrowed at once since boot. */
+size_t movement_scratch_get_high_water(void);
+
+#endif // MOVEMENT_SCRATCH_H_
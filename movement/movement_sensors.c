@@ -0,0 +1,357 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include "movement_sensors.h"
+#include "movement_accelerometer.h"
+#include "movement.h"
+#include "lis2dw.h"
+#include "opt3001.h"
+#include "thermistor_driver.h"
+#include "watch.h"
+#include "watch_utility.h"
+
+#define DEVICE_BIT(device) (1 << (device))
+// the most seconds a window may wait past its time for some other wake to go with.
+#define MOVEMENT_SENSORS_MAX_SLACK 30
+// the devices whose reads and conversions need the I2C bus.
+#define I2C_DEVICES (DEVICE_BIT(MOVEMENT_SENSOR_DEVICE_LIS2DW) | DEVICE_BIT(MOVEMENT_SENSOR_DEVICE_OPT3001))
+
+typedef struct {
+    movement_sensors_consumer_t callback;
+    void *context;
+    uint32_t next_due;      // local time, in seconds since the epoch, of the consumer's next sample
+    uint16_t period;
+    uint8_t channels;
+} movement_sensors_consumer_slot_t;
+
+static const uint8_t _device_channels[MOVEMENT_NUM_SENSOR_DEVICES] = {
+    [MOVEMENT_SENSOR_DEVICE_LIS2DW] = MOVEMENT_SENSOR_ACCELERATION,
+    [MOVEMENT_SENSOR_DEVICE_OPT3001] = MOVEMENT_SENSOR_CHANNEL(MOVEMENT_SENSOR_ILLUMINANCE),
+    [MOVEMENT_SENSOR_DEVICE_THERMISTOR] = MOVEMENT_SENSOR_CHANNEL(MOVEMENT_SENSOR_TEMPERATURE),
+    [MOVEMENT_SENSOR_DEVICE_SUPPLY] = MOVEMENT_SENSOR_CHANNEL(MOVEMENT_SENSOR_SUPPLY_VOLTAGE),
+};
+
+static movement_sensors_consumer_slot_t _consumers[MOVEMENT_SENSORS_MAX_CONSUMERS];
+static uint8_t _num_consumers;
+
+// devices that answered the probe, devices faces are driving themselves, and devices that were set converting in an
+// earlier window and haven't been read since; one bit per movement_sensor_device_t.
+static uint8_t _devices;
+static uint8_t _held;
+static uint8_t _converting;
+// the first probe waits until something asks what's there, so that it isn't on the way to the first screen.
+static bool _probed;
+
+static movement_sensors_report_t _report;
+static watch_rtc_timer_t _timer;
+
+// set from the RTC interrupt when the next window comes around, cleared by the main loop.
+static volatile bool _needs_service;
+
+static void _movement_sensors_cb_timer(void) {
+    _needs_service = true;
+}
+
+static uint32_t _movement_sensors_now(void) {
+    return watch_utility_date_time_to_unix_time(movement_get_local_date_time(), 0);
+}
+
+static uint32_t _movement_sensors_next_boundary(uint32_t now, uint16_t period) {
+    return (now / period + 1) * period;
+}
+
+static uint8_t _movement_sensors_devices_for(uint8_t channels) {
+    uint8_t devices = 0;
+    for (uint8_t i = 0; i < MOVEMENT_NUM_SENSOR_DEVICES; i++) {
+        if (channels & _device_channels[i]) devices |= DEVICE_BIT(i);
+    }
+    return devices;
+}
+
+// every channel some consumer still wants.
+static uint8_t _movement_sensors_wanted_channels(void) {
+    uint8_t channels = 0;
+    for (uint8_t i = 0; i < _num_consumers; i++) channels |= _consumers[i].channels;
+    return channels;
+}
+
+// sets the timer for the next consumer's sample, if there's anyone left to sample for.
+static void _movement_sensors_arm_timer(void) {
+    uint32_t next_window = UINT32_MAX;
+    for (uint8_t i = 0; i < _num_consumers; i++) {
+        if (_consumers[i].next_due < next_window) next_window = _consumers[i].next_due;
+    }
+    if (next_window == UINT32_MAX) {
+        watch_rtc_cancel_timer(&_timer);
+        return;
+    }
+
+    // a sample a little late is as good as one on time, so the window can wait for another wake: up to a quarter of
+    // the shortest period due in it.
+    uint16_t slack = MOVEMENT_SENSORS_MAX_SLACK;
+    for (uint8_t i = 0; i < _num_consumers; i++) {
+        if (_consumers[i].next_due == next_window && _consumers[i].period / 4 < slack) slack = _consumers[i].period / 4;
+    }
+    watch_rtc_schedule_timer_with_slack(&_timer, watch_utility_date_time_from_unix_time(next_window, 0), slack, _movement_sensors_cb_timer);
+}
+
+static void _movement_sensors_start_conversions(uint8_t devices) {
+    if (devices & DEVICE_BIT(MOVEMENT_SENSOR_DEVICE_LIS2DW)) {
+        // on demand, the sensor takes one sample per trigger and powers down again; the rate only sets the filter.
+        lis2dw_set_mode(LIS2DW_MODE_ON_DEMAND);
+        lis2dw_set_data_rate(LIS2DW_DATA_RATE_LOWEST);
+        lis2dw_start_single_conversion();
+    }
+    if (devices & DEVICE_BIT(MOVEMENT_SENSOR_DEVICE_OPT3001)) {
+        // it shuts itself down once the 100 ms conversion is done.
+        opt3001_startSingleShot(MOVEMENT_SENSORS_OPT3001_ADDRESS, false);
+    }
+    _converting |= devices;
+}
+
+static void _movement_sensors_read(uint8_t devices, bool streaming, movement_sensor_sample_t *sample) {
+    if (devices & DEVICE_BIT(MOVEMENT_SENSOR_DEVICE_LIS2DW)) {
+        lis2dw_reading_t reading;
+        bool have_reading = false;
+        if (streaming) {
+            have_reading = movement_accelerometer_get_latest(&reading);
+        } else if (_converting & DEVICE_BIT(MOVEMENT_SENSOR_DEVICE_LIS2DW)) {
+            reading = lis2dw_get_raw_reading();
+            have_reading = true;
+        }
+        if (have_reading) {
+            lis2dw_acceleration_mg_t mg = lis2dw_reading_to_mg(reading);
+            sample->values[MOVEMENT_SENSOR_ACCELERATION_X] = mg.x;
+            sample->values[MOVEMENT_SENSOR_ACCELERATION_Y] = mg.y;
+            sample->values[MOVEMENT_SENSOR_ACCELERATION_Z] = mg.z;
+            sample->channels |= MOVEMENT_SENSOR_ACCELERATION;
+        }
+    }
+    if ((devices & _converting) & DEVICE_BIT(MOVEMENT_SENSOR_DEVICE_OPT3001)) {
+        // lux is 0.01 * 2^exponent * mantissa, so hundredths of a lux are a shift, with no floating point.
+        opt3001_ER_t result = opt3001_readResult(MOVEMENT_SENSORS_OPT3001_ADDRESS).raw;
+        sample->values[MOVEMENT_SENSOR_ILLUMINANCE] = (int32_t)result.Result << result.Exponent;
+        sample->channels |= MOVEMENT_SENSOR_CHANNEL(MOVEMENT_SENSOR_ILLUMINANCE);
+    }
+    // the ADC needs no warning; it's claimed and released around one batch of readings.
+    if (devices & DEVICE_BIT(MOVEMENT_SENSOR_DEVICE_THERMISTOR)) {
+        int16_t temperature;
+        uint16_t vcc;
+        bool wants_vcc = devices & DEVICE_BIT(MOVEMENT_SENSOR_DEVICE_SUPPLY);
+        thermistor_driver_enable();
+        thermistor_driver_get_temperature_and_vcc(&temperature, wants_vcc ? &vcc : NULL);
+        thermistor_driver_disable();
+        sample->values[MOVEMENT_SENSOR_TEMPERATURE] = temperature;
+        sample->channels |= MOVEMENT_SENSOR_CHANNEL(MOVEMENT_SENSOR_TEMPERATURE);
+        if (wants_vcc) {
+            sample->values[MOVEMENT_SENSOR_SUPPLY_VOLTAGE] = vcc;
+            sample->channels |= MOVEMENT_SENSOR_CHANNEL(MOVEMENT_SENSOR_SUPPLY_VOLTAGE);
+        }
+    } else if (devices & DEVICE_BIT(MOVEMENT_SENSOR_DEVICE_SUPPLY)) {
+        watch_claim_peripheral(WATCH_PERIPHERAL_ADC);
+        sample->values[MOVEMENT_SENSOR_SUPPLY_VOLTAGE] = watch_get_vcc_voltage();
+        watch_release_peripheral(WATCH_PERIPHERAL_ADC);
+        sample->channels |= MOVEMENT_SENSOR_CHANNEL(MOVEMENT_SENSOR_SUPPLY_VOLTAGE);
+    }
+    _converting &= ~devices;
+}
+
+void movement_sensors_probe(void) {
+    // a device a face is driving is left alone, and so is the accelerometer while it streams or watches for motion;
+    // they're all there.
+    bool running = movement_accelerometer_is_streaming() || movement_accelerometer_is_detecting_motion();
+    uint8_t keep = _held | (running ? DEVICE_BIT(MOVEMENT_SENSOR_DEVICE_LIS2DW) : 0);
+    uint8_t devices = (_devices & keep) | DEVICE_BIT(MOVEMENT_SENSOR_DEVICE_SUPPLY);
+
+    watch_claim_peripheral(WATCH_PERIPHERAL_I2C);
+    if (!(keep & DEVICE_BIT(MOVEMENT_SENSOR_DEVICE_LIS2DW)) && lis2dw_get_device_id() == LIS2DW_WHO_AM_I_VAL) {
+        devices |= DEVICE_BIT(MOVEMENT_SENSOR_DEVICE_LIS2DW);
+    }
+    if (!(keep & DEVICE_BIT(MOVEMENT_SENSOR_DEVICE_OPT3001)) &&
+        opt3001_readDeviceID(MOVEMENT_SENSORS_OPT3001_ADDRESS) == OPT3001_DEVICE_ID_VALUE) {
+        devices |= DEVICE_BIT(MOVEMENT_SENSOR_DEVICE_OPT3001);
+    }
+    watch_release_peripheral(WATCH_PERIPHERAL_I2C);
+
+    if (!(keep & DEVICE_BIT(MOVEMENT_SENSOR_DEVICE_THERMISTOR))) {
+        thermistor_driver_enable();
+        if (thermistor_driver_is_connected()) devices |= DEVICE_BIT(MOVEMENT_SENSOR_DEVICE_THERMISTOR);
+        thermistor_driver_disable();
+    }
+
+    // conversions started on a device that has gone away will never be read.
+    _converting &= devices;
+    _devices = devices;
+    _probed = true;
+}
+
+static uint8_t _movement_sensors_devices(void) {
+    if (!_probed) movement_sensors_probe();
+    return _devices;
+}
+
+uint8_t movement_sensors_get_devices(void) {
+    return _movement_sensors_devices();
+}
+
+uint8_t movement_sensors_get_channels(void) {
+    uint8_t devices = _movement_sensors_devices();
+    uint8_t channels = 0;
+    for (uint8_t i = 0; i < MOVEMENT_NUM_SENSOR_DEVICES; i++) {
+        if (devices & DEVICE_BIT(i)) channels |= _device_channels[i];
+    }
+    return channels;
+}
+
+bool movement_sensors_subscribe(uint8_t channels, uint16_t period, movement_sensors_consumer_t consumer, void *context) {
+    if (_num_consumers >= MOVEMENT_SENSORS_MAX_CONSUMERS || consumer == NULL || period == 0) return false;
+    channels &= (1 << MOVEMENT_NUM_SENSOR_CHANNELS) - 1;
+    if (channels == 0) return false;
+
+    _consumers[_num_consumers].callback = consumer;
+    _consumers[_num_consumers].context = context;
+    _consumers[_num_consumers].period = period;
+    _consumers[_num_consumers].channels = channels;
+    _consumers[_num_consumers].next_due = _movement_sensors_next_boundary(_movement_sensors_now(), period);
+    _num_consumers++;
+    // nothing is due yet, but this sets the new consumer's sensors converting if its first sample is the next one,
+    // and moves the timer up if it is sooner than the one already set.
+    _needs_service = true;
+    movement_sensors_service();
+
+    return true;
+}
+
+void movement_sensors_unsubscribe(movement_sensors_consumer_t consumer, void *context) {
+    for (uint8_t i = 0; i < _num_consumers; i++) {
+        if (_consumers[i].callback == consumer && _consumers[i].context == context) {
+            _num_consumers--;
+            _consumers[i] = _consumers[_num_consumers];
+            break;
+        }
+    }
+    // a conversion nobody wants any more would be stale by the time somebody did.
+    _converting &= _movement_sensors_devices_for(_movement_sensors_wanted_channels());
+    _movement_sensors_arm_timer();
+}
+
+void movement_sensors_hold_device(movement_sensor_device_t device, bool hold) {
+    if (device >= MOVEMENT_NUM_SENSOR_DEVICES) return;
+    // a held device isn't probed, so find out whether it's there while it's still ours to ask.
+    if (hold && !_probed) movement_sensors_probe();
+    if (hold) _held |= DEVICE_BIT(device);
+    else _held &= ~DEVICE_BIT(device);
+    // either way, the face has set the device up differently from how we left it.
+    _converting &= ~DEVICE_BIT(device);
+}
+
+bool movement_sensors_is_held(movement_sensor_device_t device) {
+    return device < MOVEMENT_NUM_SENSOR_DEVICES && (_held & DEVICE_BIT(device));
+}
+
+void movement_sensors_get_report(movement_sensors_report_t *report) {
+    *report = _report;
+}
+
+bool movement_sensors_needs_service(void) {
+    return _needs_service || movement_accelerometer_needs_service();
+}
+
+void movement_sensors_service(void) {
+    bool window = _needs_service;
+    _needs_service = false;
+    bool streaming = movement_accelerometer_is_streaming();
+    // the stream started the sensor over, so anything we set converting there is gone.
+    if (streaming) _converting &= ~DEVICE_BIT(MOVEMENT_SENSOR_DEVICE_LIS2DW);
+    // while it watches for motion it samples on its own, so there's always a reading waiting and nothing to start.
+    bool detecting = !streaming && movement_accelerometer_is_detecting_motion();
+    if (detecting) _converting |= DEVICE_BIT(MOVEMENT_SENSOR_DEVICE_LIS2DW);
+
+    uint8_t available = _movement_sensors_devices() & ~_held;
+    uint32_t due_consumers = 0;
+    uint8_t read_devices = 0;
+    uint8_t start_devices = 0;
+    uint32_t next_window = UINT32_MAX;
+
+    if (window) {
+        uint32_t now = _movement_sensors_now();
+        uint8_t due_channels = 0;
+        for (uint8_t i = 0; i < _num_consumers; i++) {
+            movement_sensors_consumer_slot_t *slot = &_consumers[i];
+            // the clock was set back; start over from the new time.
+            if (slot->next_due > now + slot->period) slot->next_due = _movement_sensors_next_boundary(now, slot->period);
+            if (slot->next_due <= now) {
+                due_consumers |= 1 << i;
+                due_channels |= slot->channels;
+                slot->next_due = _movement_sensors_next_boundary(now, slot->period);
+            }
+            if (slot->next_due < next_window) next_window = slot->next_due;
+        }
+        read_devices = _movement_sensors_devices_for(due_channels) & available;
+
+        // whatever the next window reads over I2C gets set converting now, so that it's ready by then.
+        uint8_t next_channels = 0;
+        for (uint8_t i = 0; i < _num_consumers; i++) {
+            if (_consumers[i].next_due == next_window) next_channels |= _consumers[i].channels;
+        }
+        start_devices = _movement_sensors_devices_for(next_channels) & available & I2C_DEVICES & ~_converting;
+        if (streaming || detecting) start_devices &= ~DEVICE_BIT(MOVEMENT_SENSOR_DEVICE_LIS2DW);
+    }
+
+    // everything this wake does on the bus goes into one claim, so the bus is powered up once.
+    uint8_t bus_devices = ((read_devices & _converting) | start_devices) & I2C_DEVICES;
+    bool bus = bus_devices || movement_accelerometer_needs_service();
+    if (bus || read_devices) _report.windows++;
+    if (bus) {
+        _report.bus_windows++;
+        watch_claim_peripheral(WATCH_PERIPHERAL_I2C);
+    }
+
+    // the accelerometer's batches first, so that a stream's newest sample is the one we hand on.
+    if (movement_accelerometer_needs_service()) movement_accelerometer_service();
+
+    movement_sensor_sample_t sample;
+    memset(&sample, 0, sizeof(sample));
+    if (read_devices) _movement_sensors_read(read_devices, streaming, &sample);
+    if (start_devices) _movement_sensors_start_conversions(start_devices);
+
+    if (bus) watch_release_peripheral(WATCH_PERIPHERAL_I2C);
+    if (!window) return;
+
+    // consumers may unsubscribe from their callbacks, which moves the last slot into theirs; walk backwards so that
+    // nobody is skipped or called twice.
+    if (due_consumers) sample.timestamp = watch_utility_date_time_to_unix_time(movement_get_utc_date_time(), 0);
+    for (uint8_t i = _num_consumers; i > 0; i--) {
+        if (i > _num_consumers || !(due_consumers & (1 << (i - 1)))) continue;
+        movement_sensor_sample_t delivered = sample;
+        delivered.channels &= _consumers[i - 1].channels;
+        _report.samples++;
+        _consumers[i - 1].callback(&delivered, _consumers[i - 1].context);
+    }
+
+    // after the callbacks, which may have changed the consumers.
+    _movement_sensors_arm_timer();
+}
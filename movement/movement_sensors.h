@@ -0,0 +1,138 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MOVEMENT_SENSORS_H_
+#define MOVEMENT_SENSORS_H_
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief The OPT3001's I2C address: 0x44 with its ADDR pin tied to ground, as on the lightmeter board. */
+#ifndef MOVEMENT_SENSORS_OPT3001_ADDRESS
+#define MOVEMENT_SENSORS_OPT3001_ADDRESS 0x44
+#endif
+
+/** @brief Most consumers that can be subscribed to the sensors at once. */
+#define MOVEMENT_SENSORS_MAX_CONSUMERS 6
+
+typedef enum {
+    MOVEMENT_SENSOR_DEVICE_LIS2DW = 0,      // accelerometer, on I2C
+    MOVEMENT_SENSOR_DEVICE_OPT3001,         // ambient light sensor, on I2C
+    MOVEMENT_SENSOR_DEVICE_THERMISTOR,      // thermistor divider, on the ADC
+    MOVEMENT_SENSOR_DEVICE_SUPPLY,          // the supply voltage, on the ADC; always there
+    MOVEMENT_NUM_SENSOR_DEVICES
+} movement_sensor_device_t;
+
+typedef enum {
+    MOVEMENT_SENSOR_ACCELERATION_X = 0,     // milli-g
+    MOVEMENT_SENSOR_ACCELERATION_Y,         // milli-g
+    MOVEMENT_SENSOR_ACCELERATION_Z,         // milli-g
+    MOVEMENT_SENSOR_ILLUMINANCE,            // hundredths of a lux
+    MOVEMENT_SENSOR_TEMPERATURE,            // hundredths of a degree Celsius
+    MOVEMENT_SENSOR_SUPPLY_VOLTAGE,         // millivolts
+    MOVEMENT_NUM_SENSOR_CHANNELS
+} movement_sensor_channel_t;
+
+/// A channel as a bit, for the channel masks below.
+#define MOVEMENT_SENSOR_CHANNEL(channel) (1 << (channel))
+/// All three axes of the accelerometer.
+#define MOVEMENT_SENSOR_ACCELERATION (MOVEMENT_SENSOR_CHANNEL(MOVEMENT_SENSOR_ACCELERATION_X) | \
+                                      MOVEMENT_SENSOR_CHANNEL(MOVEMENT_SENSOR_ACCELERATION_Y) | \
+                                      MOVEMENT_SENSOR_CHANNEL(MOVEMENT_SENSOR_ACCELERATION_Z))
+
+typedef struct {
+    uint8_t channels;                               // the channels in values that were read, as a mask
+    uint32_t timestamp;                             // UTC unix time of the bus window that delivered the sample
+    int32_t values[MOVEMENT_NUM_SENSOR_CHANNELS];   // indexed by movement_sensor_channel_t
+} movement_sensor_sample_t;
+
+typedef void (*movement_sensors_consumer_t)(const movement_sensor_sample_t *sample, void *context);
+
+typedef struct {
+    uint32_t windows;           // wakes that read or started a sensor
+    uint32_t bus_windows;       // of those, the ones that had I2C powered up; never more than one per wake
+    uint32_t samples;           // samples handed to consumers
+} movement_sensors_report_t;
+
+/** @brief Looks for each sensor the registry knows about. This happens by itself the first time anyone asks what's
+  *        there, which Movement leaves until after the first screen at boot.
+  * @details The LIS2DW and OPT3001 are found by reading their device ID registers. The thermistor has nothing to ask,
+  *          so it's taken to be there if its divider reads off the rails with the power to it on; and the supply is
+  *          always there. Call this again
+  *          after changing the sensor board; a device that is being held (@see movement_sensors_hold_device) keeps
+  *          whatever state it had.
+  */
+void movement_sensors_probe(void);
+
+/** @brief Returns the devices that were found, as a mask of (1 << movement_sensor_device_t). */
+uint8_t movement_sensors_get_devices(void);
+
+/** @brief Returns the channels that the devices which were found can measure, as a mask of MOVEMENT_SENSOR_CHANNEL. */
+uint8_t movement_sensors_get_channels(void);
+
+/** @brief Samples sensor channels on a schedule, and hands them to a consumer.
+  * @details Each consumer's samples fall on the seconds that are a multiple of its period, so consumers with the same
+  *          or related periods share their wakes. Every read that falls due on a given wake happens in one window,
+  *          with the I2C bus powered up at most once; and since the OPT3001 takes 100 ms to convert, each I2C sensor
+  *          is set converting in the window before the one that reads it, so nobody waits on a conversion. A new
+  *          consumer's first sample comes at its first period boundary after that. A window may run up to a quarter
+  *          period late (30 seconds at most) so that it can go along with some other wake. While the accelerometer is
+  *          streaming for movement_accelerometer_subscribe, its channels come from the latest batch instead of the
+  *          bus, and while it watches for motion, from its output registers without a conversion. The temperature and supply voltage, due together, come from one ADC batch. A channel that can't be
+  *          read on a wake (its device isn't there, or is held) is left out of the
+  *          sample's channels.
+  * @param channels The channels wanted, as a mask of MOVEMENT_SENSOR_CHANNEL.
+  * @param period Seconds between samples, from 1 to 65535.
+  * @param consumer Called with each sample, from the main loop; in low energy mode too.
+  * @param context Passed through to consumer.
+  * @return true if the consumer was added; false if there was no room for it, or the arguments are no good.
+  */
+bool movement_sensors_subscribe(uint8_t channels, uint16_t period, movement_sensors_consumer_t consumer, void *context);
+
+/** @brief Stops delivering samples to a consumer. */
+void movement_sensors_unsubscribe(movement_sensors_consumer_t consumer, void *context);
+
+/** @brief Keeps the registry off a device while a face drives it directly.
+  * @details A face that sets a sensor up its own way (say, the OPT3001's window interrupt) holds it for as long as
+  *          it does, so that the registry doesn't reconfigure it out from under the face. Channels from a held device
+  *          are left out of samples. Holds don't nest.
+  * @param device The device to hold or let go.
+  * @param hold true to hold it, false to let it go.
+  */
+void movement_sensors_hold_device(movement_sensor_device_t device, bool hold);
+
+/** @brief Returns true if a face is holding a device. */
+bool movement_sensors_is_held(movement_sensor_device_t device);
+
+/** @brief Reports the windows and samples so far. */
+void movement_sensors_get_report(movement_sensors_report_t *report);
+
+/** @brief Returns true if sensor reads or the accelerometer's watermark are waiting for movement_sensors_service. */
+bool movement_sensors_needs_service(void);
+
+/** @brief Opens one bus window for everything that's due: the accelerometer's batches, and the reads, conversions
+  *        and deliveries for the consumers whose time has come. Movement calls this from its main loop.
+  */
+void movement_sensors_service(void);
+
+#endif // MOVEMENT_SENSORS_H_
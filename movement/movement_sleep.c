@@ -0,0 +1,227 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include "movement_sleep.h"
+#include "movement_accelerometer.h"
+#include "movement_kv.h"
+#include "movement.h"
+#include "watch_utility.h"
+
+#define SLEEP_LOG_NAME "sleep"
+// 16 records to a 256-byte row, six and a half hours; the log keeps at least four nights.
+#define SLEEP_LOG_RECORDS_PER_FILE 16
+#define SLEEP_LOG_FILES 4
+// the highest count a nibble holds; MOVEMENT_SLEEP_NO_DATA is the one above it.
+#define SLEEP_MAX_COUNT 14
+// a minute is asleep if the minutes this far either side of it, and it, saw this many movements or fewer.
+#define SLEEP_WINDOW_RADIUS 2
+#define SLEEP_WINDOW (2 * SLEEP_WINDOW_RADIUS + 1)
+#define SLEEP_THRESHOLD 1
+// asleep minutes in a row that it takes to fall asleep.
+#define SLEEP_ONSET_MINUTES 10
+
+static struct {
+    bool enabled;
+    bool tracking;
+    bool has_summary;
+    movement_log_t log;
+    movement_sleep_record_t record;     // the record being filled
+    uint8_t filled;                     // minutes in record so far
+
+    // scoring
+    movement_sleep_summary_t summary;   // the night underway while tracking, and the last one finished otherwise
+    uint8_t recent[SLEEP_WINDOW];       // the last few minutes' counts, by minute % SLEEP_WINDOW
+    uint16_t run;                       // asleep minutes in a row
+    uint16_t run_restless;              // of those, the ones with movement
+    uint16_t restless;                  // restless minutes since onset, whether or not sleep came back after them
+    uint8_t awakenings;                 // and awakenings
+    bool was_asleep;
+} _sleep;
+
+static bool _movement_sleep_in_window(uint8_t hour) {
+    if (MOVEMENT_SLEEP_START_HOUR > MOVEMENT_SLEEP_END_HOUR) {
+        return hour >= MOVEMENT_SLEEP_START_HOUR || hour < MOVEMENT_SLEEP_END_HOUR;
+    }
+    return hour >= MOVEMENT_SLEEP_START_HOUR && hour < MOVEMENT_SLEEP_END_HOUR;
+}
+
+static void _movement_sleep_close_record(void) {
+    if (_sleep.filled == 0) return;
+    movement_log_append(&_sleep.log, &_sleep.record);
+    _sleep.filled = 0;
+}
+
+static void _movement_sleep_log_minute(uint32_t minute_start, uint8_t count) {
+    // a gap (the clock was set, or the watch was reset) starts a new record at the right time.
+    if (_sleep.filled && minute_start != _sleep.record.start + 60 * _sleep.filled) _movement_sleep_close_record();
+    if (_sleep.filled == 0) {
+        _sleep.record.start = minute_start;
+        memset(_sleep.record.counts, 0xFF, sizeof(_sleep.record.counts));
+    }
+    uint8_t *byte = &_sleep.record.counts[_sleep.filled / 2];
+    if (_sleep.filled % 2) *byte = (*byte & 0x0F) | (count << 4);
+    else *byte = (*byte & 0xF0) | count;
+    if (++_sleep.filled == MOVEMENT_SLEEP_RECORD_MINUTES) _movement_sleep_close_record();
+}
+
+static void _movement_sleep_score(uint16_t minute, uint8_t window_sum) {
+    movement_sleep_summary_t *summary = &_sleep.summary;
+    bool restless = _sleep.recent[minute % SLEEP_WINDOW] > 0;
+    bool asleep = window_sum <= SLEEP_THRESHOLD;
+    bool slept = summary->onset != UINT16_MAX;
+
+    if (asleep) {
+        _sleep.run++;
+        if (restless) _sleep.run_restless++;
+        if (!slept && _sleep.run == SLEEP_ONSET_MINUTES) {
+            summary->onset = minute + 1 - SLEEP_ONSET_MINUTES;
+            summary->asleep = SLEEP_ONSET_MINUTES - 1;
+            _sleep.restless = _sleep.run_restless - restless;
+            slept = true;
+        }
+        if (slept) {
+            summary->asleep++;
+            if (restless) _sleep.restless++;
+            // waking up for the day doesn't count; only what came before the last minute of sleep does.
+            summary->wake = minute + 1;
+            summary->restless = _sleep.restless;
+            summary->awakenings = _sleep.awakenings;
+        }
+    } else {
+        _sleep.run = 0;
+        _sleep.run_restless = 0;
+        if (slept) {
+            if (restless) _sleep.restless++;
+            if (_sleep.was_asleep && _sleep.awakenings < UINT8_MAX) _sleep.awakenings++;
+        }
+    }
+    _sleep.was_asleep = asleep;
+}
+
+static void _movement_sleep_start_night(uint32_t now) {
+    if (!movement_accelerometer_count_motion(true)) return;
+    memset(&_sleep.summary, 0, sizeof(_sleep.summary));
+    _sleep.summary.start = now;
+    _sleep.summary.onset = UINT16_MAX;
+    memset(_sleep.recent, 0, sizeof(_sleep.recent));
+    _sleep.run = 0;
+    _sleep.run_restless = 0;
+    _sleep.restless = 0;
+    _sleep.awakenings = 0;
+    _sleep.was_asleep = false;
+    _sleep.filled = 0;
+    _sleep.tracking = true;
+}
+
+static void _movement_sleep_end_night(void) {
+    movement_accelerometer_count_motion(false);
+    _sleep.tracking = false;
+
+    uint16_t minutes = _sleep.summary.minutes;
+    if (minutes) {
+        // the last minutes still wait on the ones after them, which aren't coming.
+        uint16_t newest = minutes - 1;
+        for (uint16_t minute = newest >= SLEEP_WINDOW_RADIUS ? newest + 1 - SLEEP_WINDOW_RADIUS : 0; minute <= newest; minute++) {
+            uint8_t sum = 0;
+            uint16_t first = minute >= SLEEP_WINDOW_RADIUS ? minute - SLEEP_WINDOW_RADIUS : 0;
+            for (uint16_t other = first; other <= newest; other++) sum += _sleep.recent[other % SLEEP_WINDOW];
+            _movement_sleep_score(minute, sum);
+        }
+    }
+    _movement_sleep_close_record();
+    movement_log_flush(&_sleep.log);
+    if (_sleep.summary.onset == UINT16_MAX) _sleep.summary.wake = 0;
+    movement_kv_set(MOVEMENT_SLEEP_KV_KEY, &_sleep.summary, sizeof(_sleep.summary));
+    _sleep.has_summary = true;
+}
+
+void movement_sleep_minute(void) {
+    if (!_sleep.enabled) return;
+
+    watch_date_time date_time = movement_get_local_date_time();
+    uint32_t now = watch_utility_date_time_to_unix_time(date_time, 0) - date_time.unit.second;
+    bool night = _movement_sleep_in_window(date_time.unit.hour);
+
+    if (_sleep.tracking) {
+        uint16_t count = movement_accelerometer_take_motion_count();
+        if (count > SLEEP_MAX_COUNT) count = SLEEP_MAX_COUNT;
+        _movement_sleep_log_minute(now - 60, count);
+
+        uint16_t minute = _sleep.summary.minutes;
+        _sleep.recent[minute % SLEEP_WINDOW] = count;
+        if (_sleep.summary.minutes < UINT16_MAX) _sleep.summary.minutes++;
+        if (minute >= SLEEP_WINDOW_RADIUS) {
+            uint8_t sum = 0;
+            for (uint8_t i = 0; i < SLEEP_WINDOW; i++) {
+                // before the window has filled, the slots past the newest minute are still zero.
+                sum += _sleep.recent[i];
+            }
+            _movement_sleep_score(minute - SLEEP_WINDOW_RADIUS, sum);
+        }
+        if (!night) _movement_sleep_end_night();
+    } else if (night) {
+        _movement_sleep_start_night(now);
+    }
+}
+
+void movement_sleep_enable(void) {
+    if (_sleep.enabled) return;
+
+    memset(&_sleep, 0, sizeof(_sleep));
+    movement_log_init(&_sleep.log, SLEEP_LOG_NAME, sizeof(movement_sleep_record_t), SLEEP_LOG_RECORDS_PER_FILE, SLEEP_LOG_FILES);
+    _sleep.has_summary = movement_kv_get(MOVEMENT_SLEEP_KV_KEY, &_sleep.summary, sizeof(_sleep.summary)) == sizeof(_sleep.summary);
+    _sleep.enabled = true;
+    // the night may already be underway; it starts from the next minute.
+    movement_sleep_minute();
+}
+
+void movement_sleep_disable(void) {
+    if (!_sleep.enabled) return;
+
+    if (_sleep.tracking) _movement_sleep_end_night();
+    _sleep.enabled = false;
+}
+
+bool movement_sleep_is_enabled(void) {
+    return _sleep.enabled;
+}
+
+bool movement_sleep_is_tracking(void) {
+    return _sleep.tracking;
+}
+
+bool movement_sleep_get_last_night(movement_sleep_summary_t *summary) {
+    if (_sleep.tracking) {
+        // the summary being filled is tonight's; the last finished one is in the store.
+        return movement_kv_get(MOVEMENT_SLEEP_KV_KEY, summary, sizeof(*summary)) == sizeof(*summary);
+    }
+    if (!_sleep.has_summary) return false;
+    *summary = _sleep.summary;
+    return true;
+}
+
+movement_log_t *movement_sleep_get_log(void) {
+    return &_sleep.log;
+}
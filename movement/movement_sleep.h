@@ -0,0 +1,101 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MOVEMENT_SLEEP_H_
+#define MOVEMENT_SLEEP_H_
+#include <stdint.h>
+#include <stdbool.h>
+#include "movement_log.h"
+
+/** @brief The local hours the tracker watches: from the top of the first to the top of the second. */
+#ifndef MOVEMENT_SLEEP_START_HOUR
+#define MOVEMENT_SLEEP_START_HOUR 21
+#endif
+#ifndef MOVEMENT_SLEEP_END_HOUR
+#define MOVEMENT_SLEEP_END_HOUR 9
+#endif
+
+/** @brief Key the last night's summary lives under in the key/value store. */
+#define MOVEMENT_SLEEP_KV_KEY "sleep"
+
+/** @brief Minutes in each record of the sleep log. */
+#define MOVEMENT_SLEEP_RECORD_MINUTES 24
+
+/** @brief A minute's nibble in a record of the sleep log when the tracker wasn't counting. */
+#define MOVEMENT_SLEEP_NO_DATA 0xF
+
+/** @brief A record of the sleep log: how many times the watch started moving in each minute of the night. */
+typedef struct {
+    uint32_t start;             // local time the record's first minute began, in seconds since the epoch
+    uint8_t counts[MOVEMENT_SLEEP_RECORD_MINUTES / 2];  // a nibble a minute, low nibble first, up to 14
+} movement_sleep_record_t;
+
+/** @brief What the tracker made of a night. Times are minutes after start. */
+typedef struct {
+    uint32_t start;             // local time tracking began, in seconds since the epoch; 0 for no night yet
+    uint16_t minutes;           // minutes tracked
+    uint16_t onset;             // when sleep began; UINT16_MAX if it never did
+    uint16_t wake;              // when the last stretch of sleep ended
+    uint16_t asleep;            // minutes asleep between onset and wake
+    uint16_t restless;          // of those, minutes with some movement in them
+    uint8_t awakenings;         // times the wearer woke up between onset and wake
+} movement_sleep_summary_t;
+
+/** @brief Starts tracking sleep every night. Does nothing if the tracker is already running.
+  * @details Between MOVEMENT_SLEEP_START_HOUR and MOVEMENT_SLEEP_END_HOUR, the tracker has the accelerometer engine
+  *          count the times the watch starts moving (@see movement_accelerometer_count_motion). The sensor runs at
+  *          1.6 Hz in its lowest power mode and only wakes the watch when it stops and starts moving, so a night costs
+  *          a few µAh. At the top of each minute, the minute's count goes into the sleep log, and into the scoring:
+  *          a minute is asleep if the five minutes around it saw at most one movement between them, and sleep
+  *          begins with the first ten asleep minutes in a row. At the end of the night the summary is saved to the
+  *          key/value store. Out of the window, the tracker costs nothing. A watch left on the nightstand reads as
+  *          a very still sleeper; off-wrist detection needs more than this counts.
+  */
+void movement_sleep_enable(void);
+
+/** @brief Stops tracking sleep, finishing tonight's summary if the night was underway. */
+void movement_sleep_disable(void);
+
+/** @brief Returns true if the tracker is running. */
+bool movement_sleep_is_enabled(void);
+
+/** @brief Returns true while the tracker is counting tonight's movements. */
+bool movement_sleep_is_tracking(void);
+
+/** @brief Gets the summary of the last night the tracker finished.
+  * @return false if there isn't one.
+  */
+bool movement_sleep_get_last_night(movement_sleep_summary_t *summary);
+
+/** @brief Returns the sleep log, whose records are movement_sleep_record_t, for reading it back or sending it
+  *        elsewhere (@see movement_chirpy_send_log).
+  */
+movement_log_t *movement_sleep_get_log(void);
+
+/** @brief Takes the last minute's count and starts or ends the night. Movement calls this at the top of every minute;
+  *        faces don't need to.
+  */
+void movement_sleep_minute(void);
+
+#endif // MOVEMENT_SLEEP_H_
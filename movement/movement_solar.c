@@ -0,0 +1,77 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "movement_solar.h"
+#include "movement.h"
+#include "sunriset.h"
+
+typedef struct {
+    uint32_t day;               // the UTC date (a watch_date_time register with the time zeroed), or 0 if unused
+    uint32_t location;          // the movement_location_t it was computed for
+    double rise;
+    double set;
+    int8_t result;
+} movement_solar_entry_t;
+
+static movement_solar_entry_t solar_cache[MOVEMENT_SOLAR_CACHE_SIZE];
+static uint8_t solar_next_slot;
+
+static movement_solar_entry_t *_movement_solar_lookup(watch_date_time utc_date) {
+    movement_location_t location = (movement_location_t) watch_get_backup_data(1);
+    utc_date.unit.hour = utc_date.unit.minute = utc_date.unit.second = 0;
+
+    for (uint8_t i = 0; i < MOVEMENT_SOLAR_CACHE_SIZE; i++) {
+        if (solar_cache[i].day == utc_date.reg && solar_cache[i].location == location.reg) return &solar_cache[i];
+    }
+
+    movement_solar_entry_t *entry = &solar_cache[solar_next_slot];
+    solar_next_slot = (solar_next_slot + 1) % MOVEMENT_SOLAR_CACHE_SIZE;
+
+    // extract to int16's first; casting the bit fields straight to double has misbehaved before.
+    int16_t lat_centi = (int16_t)location.bit.latitude;
+    int16_t lon_centi = (int16_t)location.bit.longitude;
+    double lat = (double)lat_centi / 100.0;
+    double lon = (double)lon_centi / 100.0;
+
+    entry->result = sun_rise_set(utc_date.unit.year + WATCH_RTC_REFERENCE_YEAR, utc_date.unit.month, utc_date.unit.day, lon, lat, &entry->rise, &entry->set);
+    entry->day = utc_date.reg;
+    entry->location = location.reg;
+
+    return entry;
+}
+
+int movement_solar_get_rise_set(watch_date_time utc_date, double *rise, double *set) {
+    movement_solar_entry_t *entry = _movement_solar_lookup(utc_date);
+    *rise = entry->rise;
+    *set = entry->set;
+
+    return entry->result;
+}
+
+double movement_solar_get_day_length(watch_date_time utc_date) {
+    movement_solar_entry_t *entry = _movement_solar_lookup(utc_date);
+
+    // sun_rise_set already puts rise and set 24 hours apart under the midnight sun, and together in the polar night.
+    return entry->set - entry->rise;
+}
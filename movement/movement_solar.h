@@ -0,0 +1,56 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MOVEMENT_SOLAR_H_
+#define MOVEMENT_SOLAR_H_
+#include <stdint.h>
+#include "watch.h"
+
+/** @brief Number of days of sunrise and sunset times kept at once. Enough for yesterday, today and tomorrow, plus one
+  *        spare for a face that looks further ahead.
+  */
+#define MOVEMENT_SOLAR_CACHE_SIZE 4
+
+/** @brief Returns sunrise and sunset for a UTC date at the wearer's location (BKUP[1]), computing them only the first
+  *        time any face asks for that date and location.
+  * @param utc_date The date to look up, in UTC. The time of day is ignored.
+  * @param rise On return, the time of sunrise in decimal hours after midnight UTC. May be below 0 or above 24.
+  * @param set On return, the time of sunset, the same way.
+  * @return The same as sun_rise_set: 0 if the sun rises and sets, +1 if it stays above the horizon all day and -1 if
+  *         it stays below. Under the midnight sun, rise and set are twelve hours either side of solar noon; in the
+  *         polar night they are both at solar noon.
+  * @details sun_rise_set is a few thousand cycles of soft-float double math, and several faces ask for the same
+  *          handful of days. Results are cached by date and location, so a new day or a new location simply misses
+  *          the cache, and the oldest entry makes way for it.
+  */
+int movement_solar_get_rise_set(watch_date_time utc_date, double *rise, double *set);
+
+/** @brief Returns the length of the day in hours at the wearer's location, from the same cache.
+  * @param utc_date The date to look up, in UTC. The time of day is ignored.
+  * @details This measures from sunrise to sunset, which is what day_length computes too, without a second trip
+  *          through the solar model: 24 under the midnight sun, and 0 in the polar night.
+  */
+double movement_solar_get_day_length(watch_date_time utc_date);
+
+#endif // MOVEMENT_SOLAR_H_
@@ -0,0 +1,204 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "movement_steps.h"
+#include "movement_accelerometer.h"
+#include "movement_kv.h"
+#include "movement.h"
+#include "watch_utility.h"
+
+// everything below is tuned for 12.5 Hz, with the sensor at ±4g (8192 raw counts per g).
+#define STEPS_DATA_RATE LIS2DW_DATA_RATE_12_5_HZ
+// the signal is the L1 norm shifted down to 512 counts per g, summed over three samples, so 1536 counts per g.
+#define STEPS_INPUT_SHIFT 4
+// the DC tracker's time constant, as a power of two: 16 samples is about 1.3 seconds.
+#define STEPS_DC_SHIFT 4
+// smallest threshold the peak detector will use, about 0.08 g.
+#define STEPS_MIN_THRESHOLD 120
+// steps closer together than this (0.24 s) are bounces of the same step.
+#define STEPS_MIN_INTERVAL 3
+// steps further apart than this (2 s) are not part of the same walk.
+#define STEPS_MAX_INTERVAL 25
+// steps in a row it takes before we believe someone is walking.
+#define STEPS_REGULATION 4
+// how often a changing count is written out, in seconds.
+#define STEPS_SAVE_INTERVAL 600
+
+typedef struct {
+    uint32_t day;           // local date the steps were counted on (a watch_date_time register with the time zeroed)
+    uint32_t steps;
+    uint32_t yesterday;
+} movement_steps_record_t;
+
+static struct {
+    bool enabled;
+    movement_steps_record_t record;
+    uint32_t last_save;         // unix time of the last write to the store
+    bool dirty;
+
+    // filter state
+    int32_t dc;                 // running mean of the input, times 1 << STEPS_DC_SHIFT
+    int32_t history[2];         // the last two high-passed samples, for the box filter
+    bool primed;                // false until dc has been seeded with a real sample
+
+    // peak detector state
+    bool above;                 // the signal has crossed the threshold upward, and not yet come back below -threshold
+    int32_t peak;               // highest point of the current swing
+    int32_t amplitude;          // smoothed height of recent peaks
+    uint16_t since_last_step;   // samples since the last step
+    uint8_t streak;             // steps in the current rhythm, up to STEPS_REGULATION
+} _steps;
+
+static uint32_t _movement_steps_today(void) {
+    watch_date_time date_time = movement_get_local_date_time();
+    date_time.unit.hour = 0;
+    date_time.unit.minute = 0;
+    date_time.unit.second = 0;
+    return date_time.reg;
+}
+
+static void _movement_steps_save(void) {
+    movement_kv_set(MOVEMENT_STEPS_KV_KEY, &_steps.record, sizeof(_steps.record));
+    _steps.last_save = watch_utility_date_time_to_unix_time(movement_get_utc_date_time(), 0);
+    _steps.dirty = false;
+}
+
+static void _movement_steps_check_day(void) {
+    uint32_t today = _movement_steps_today();
+    if (_steps.record.day == today) return;
+
+    // a day with no steps in it (off the wrist, or the counter was off) doesn't leave a total behind.
+    watch_date_time then, now;
+    then.reg = _steps.record.day;
+    now.reg = today;
+    bool was_yesterday = watch_utility_date_time_to_unix_time(now, 0) - watch_utility_date_time_to_unix_time(then, 0) == 86400;
+    _steps.record.yesterday = was_yesterday ? _steps.record.steps : 0;
+    _steps.record.steps = 0;
+    _steps.record.day = today;
+    _movement_steps_save();
+}
+
+static void _movement_steps_count(void) {
+    if (_steps.since_last_step > STEPS_MAX_INTERVAL) _steps.streak = 0;
+    _steps.since_last_step = 0;
+
+    if (_steps.streak < STEPS_REGULATION) {
+        _steps.streak++;
+        // the steps that built the rhythm count too, once it's established.
+        if (_steps.streak == STEPS_REGULATION) _steps.record.steps += STEPS_REGULATION;
+    } else {
+        _steps.record.steps++;
+    }
+    _steps.dirty = true;
+}
+
+static void _movement_steps_process_sample(const lis2dw_reading_t *reading) {
+    int32_t magnitude = (abs(reading->x) + abs(reading->y) + abs(reading->z)) >> STEPS_INPUT_SHIFT;
+
+    if (!_steps.primed) {
+        _steps.dc = magnitude << STEPS_DC_SHIFT;
+        _steps.primed = true;
+    }
+
+    // band-pass: a slow running mean takes out gravity and posture, and a three-sample box filter (its first null
+    // is at 4.2 Hz) takes out the jitter above walking and running cadences.
+    _steps.dc += magnitude - (_steps.dc >> STEPS_DC_SHIFT);
+    int32_t high_passed = magnitude - (_steps.dc >> STEPS_DC_SHIFT);
+    int32_t signal = high_passed + _steps.history[0] + _steps.history[1];
+    _steps.history[1] = _steps.history[0];
+    _steps.history[0] = high_passed;
+
+    if (_steps.since_last_step < UINT16_MAX) _steps.since_last_step++;
+
+    // peak detector with hysteresis: a step is a swing up through +threshold after the signal has been below
+    // -threshold. the threshold follows a quarter of recent peak heights, so a light stroll and a hard run both work.
+    int32_t threshold = _steps.amplitude >> 2;
+    if (threshold < STEPS_MIN_THRESHOLD) threshold = STEPS_MIN_THRESHOLD;
+
+    if (_steps.above) {
+        if (signal > _steps.peak) _steps.peak = signal;
+        if (signal < -threshold) {
+            _steps.above = false;
+            _steps.amplitude += (_steps.peak - _steps.amplitude) >> 2;
+        }
+    } else if (signal > threshold) {
+        _steps.above = true;
+        _steps.peak = signal;
+        if (_steps.since_last_step >= STEPS_MIN_INTERVAL) _movement_steps_count();
+    }
+}
+
+static void _movement_steps_consume(const movement_accelerometer_batch_t *batch, void *context) {
+    (void) context;
+
+    _movement_steps_check_day();
+
+    // the rate codes go up by one each time the rate doubles.
+    uint8_t stride = 1;
+    if (batch->data_rate > STEPS_DATA_RATE) stride = 1 << (batch->data_rate - STEPS_DATA_RATE);
+
+    for (uint8_t i = 0; i < batch->count; i++) {
+        if ((batch->first_sample + i) % stride) continue;
+        _movement_steps_process_sample(&batch->readings[i]);
+    }
+
+    // if the clock was set back, start the save interval over rather than saving on every batch.
+    if (batch->timestamp < _steps.last_save) _steps.last_save = batch->timestamp;
+    if (_steps.dirty && batch->timestamp - _steps.last_save >= STEPS_SAVE_INTERVAL) _movement_steps_save();
+}
+
+void movement_steps_enable(void) {
+    if (_steps.enabled) return;
+
+    memset(&_steps, 0, sizeof(_steps));
+    movement_kv_get(MOVEMENT_STEPS_KV_KEY, &_steps.record, sizeof(_steps.record));
+    _steps.last_save = watch_utility_date_time_to_unix_time(movement_get_utc_date_time(), 0);
+    _movement_steps_check_day();
+
+    _steps.enabled = movement_accelerometer_subscribe(STEPS_DATA_RATE, _movement_steps_consume, NULL);
+}
+
+void movement_steps_disable(void) {
+    if (!_steps.enabled) return;
+
+    movement_accelerometer_unsubscribe(_movement_steps_consume, NULL);
+    if (_steps.dirty) _movement_steps_save();
+    _steps.enabled = false;
+}
+
+bool movement_steps_is_enabled(void) {
+    return _steps.enabled;
+}
+
+uint32_t movement_steps_get_today(void) {
+    if (_steps.enabled) _movement_steps_check_day();
+    return _steps.record.steps;
+}
+
+uint32_t movement_steps_get_yesterday(void) {
+    if (_steps.enabled) _movement_steps_check_day();
+    return _steps.record.yesterday;
+}
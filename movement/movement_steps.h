@@ -0,0 +1,55 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MOVEMENT_STEPS_H_
+#define MOVEMENT_STEPS_H_
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Key the step count lives under in the key/value store. */
+#define MOVEMENT_STEPS_KV_KEY "steps"
+
+/** @brief Starts counting steps in the background. Does nothing if the counter is already running.
+  * @details The counter listens to the accelerometer engine (@see movement_accelerometer_subscribe) at 12.5 Hz; if
+  *          something else has the sensor running faster, it keeps every nth sample. Each sample goes through an
+  *          integer band-pass filter on the L1 norm of the acceleration and a peak detector with an adaptive
+  *          threshold. Steps only count once four of them arrive in a steady rhythm, which ignores most arm
+  *          movements that aren't walking. The day's total is saved to the key/value store every ten minutes while
+  *          it is changing, and starts over at local midnight.
+  */
+void movement_steps_enable(void);
+
+/** @brief Stops counting steps, saving the total so far. */
+void movement_steps_disable(void);
+
+/** @brief Returns true if the step counter is running. */
+bool movement_steps_is_enabled(void);
+
+/** @brief Returns the number of steps counted since local midnight. */
+uint32_t movement_steps_get_today(void);
+
+/** @brief Returns yesterday's total, or 0 if the counter wasn't running yesterday. */
+uint32_t movement_steps_get_yesterday(void);
+
+#endif // MOVEMENT_STEPS_H_
@@ -0,0 +1,317 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include "movement_temperature.h"
+#include "movement_sensors.h"
+#include "movement.h"
+#include "watch_utility.h"
+
+// seconds between readings; the registry lines them up with the top of the minute.
+#define TEMPERATURE_SAMPLE_PERIOD 60
+// a block's header is its start time and its first reading.
+#define TEMPERATURE_HEADER_SIZE 6
+#define TEMPERATURE_MAX_DATA 54
+
+typedef struct {
+    const char *name;
+    uint32_t period;            // seconds in each of the periods a block holds
+    uint8_t periods;            // periods in a block
+    uint8_t bits;               // width of each packed field: 8 or 12
+    uint8_t fields;             // 1 for the reading alone; 3 for the average, and its distance to the minimum and maximum
+    uint8_t records_per_file;   // blocks to a 256-byte row
+    uint8_t num_files;
+} movement_temperature_tier_t;
+
+static const movement_temperature_tier_t _tiers[MOVEMENT_TEMPERATURE_NUM_RESOLUTIONS] = {
+    [MOVEMENT_TEMPERATURE_MINUTES] = {"tmin", 60, 30, 8, 1, 7, 3},      // half an hour in 36 bytes
+    [MOVEMENT_TEMPERATURE_HOURS] = {"thour", 3600, 12, 12, 3, 4, 4},    // half a day in 60 bytes
+    [MOVEMENT_TEMPERATURE_DAYS] = {"tday", 86400, 8, 12, 3, 6, 3},      // eight days in 42 bytes
+};
+
+// a block as it's stored: the first record_size bytes of this.
+typedef struct {
+    uint32_t start;             // local time the block's first period began; 0 for no block
+    int16_t base;               // tenths of a degree the first difference is taken from
+    uint8_t data[TEMPERATURE_MAX_DATA];
+} movement_temperature_block_t;
+
+typedef struct {
+    movement_log_t log;
+    movement_temperature_block_t block;     // the block being filled
+    uint8_t next;                           // the first period in block that can still be written
+    int16_t last;                           // the last average written to block, as it will read back
+    // the hour or day being rolled up
+    uint32_t since;
+    int16_t min;
+    int16_t max;
+    int32_t sum;
+    uint16_t count;
+} movement_temperature_state_t;
+
+static bool _enabled;
+static movement_temperature_state_t _state[MOVEMENT_TEMPERATURE_NUM_RESOLUTIONS];
+// the block read last from a log, since a chart reads its neighbours next.
+static movement_temperature_block_t _cache;
+static int8_t _cache_resolution = -1;
+
+static uint8_t _movement_temperature_record_size(const movement_temperature_tier_t *tier) {
+    return TEMPERATURE_HEADER_SIZE + (tier->periods * tier->fields * tier->bits + 7) / 8;
+}
+
+static uint16_t _movement_temperature_get_field(const uint8_t *data, uint8_t bits, uint16_t index) {
+    if (bits == 8) return data[index];
+    uint16_t bit = index * 12;
+    uint16_t word = data[bit / 8] | (data[bit / 8 + 1] << 8);
+    return (bit % 8) ? word >> 4 : word & 0xFFF;
+}
+
+static void _movement_temperature_set_field(uint8_t *data, uint8_t bits, uint16_t index, uint16_t value) {
+    if (bits == 8) {
+        data[index] = value;
+        return;
+    }
+    uint16_t bit = index * 12;
+    uint8_t *p = data + bit / 8;
+    if (bit % 8) {
+        p[0] = (p[0] & 0x0F) | (value << 4);
+        p[1] = value >> 4;
+    } else {
+        p[0] = value;
+        p[1] = (p[1] & 0xF0) | ((value >> 8) & 0x0F);
+    }
+}
+
+// the most negative difference marks a period with no reading.
+static uint16_t _movement_temperature_missing(uint8_t bits) {
+    return 1 << (bits - 1);
+}
+
+static int16_t _movement_temperature_to_decidegrees(int32_t centidegrees) {
+    return (centidegrees + (centidegrees < 0 ? -5 : 5)) / 10;
+}
+
+static uint32_t _movement_temperature_now(void) {
+    return watch_utility_date_time_to_unix_time(movement_get_local_date_time(), 0);
+}
+
+static void _movement_temperature_close_block(movement_temperature_resolution_t resolution) {
+    movement_temperature_state_t *state = &_state[resolution];
+    if (state->block.start != 0 && state->next > 0) movement_log_append(&state->log, &state->block);
+    state->block.start = 0;
+}
+
+static void _movement_temperature_open_block(movement_temperature_resolution_t resolution, uint32_t start, int16_t base) {
+    const movement_temperature_tier_t *tier = &_tiers[resolution];
+    movement_temperature_state_t *state = &_state[resolution];
+    memset(&state->block, 0, sizeof(state->block));
+    state->block.start = start;
+    state->block.base = base;
+    for (uint8_t i = 0; i < tier->periods; i++) {
+        _movement_temperature_set_field(state->block.data, tier->bits, i * tier->fields, _movement_temperature_missing(tier->bits));
+    }
+    state->last = base;
+    state->next = 0;
+}
+
+// stores one period's readings, in tenths of a degree.
+static void _movement_temperature_put(movement_temperature_resolution_t resolution, uint32_t since, int16_t avg, int16_t min, int16_t max) {
+    const movement_temperature_tier_t *tier = &_tiers[resolution];
+    movement_temperature_state_t *state = &_state[resolution];
+    uint32_t span = tier->period * tier->periods;
+    uint32_t start = since - since % span;
+
+    if (state->block.start != start) {
+        // blocks go out as soon as the clock leaves them, even backward; reads take the newest block for a time.
+        _movement_temperature_close_block(resolution);
+        _movement_temperature_open_block(resolution, start, avg);
+    }
+    uint8_t index = (since - start) / tier->period;
+    if (index < state->next) return;
+
+    // a difference that doesn't fit is clamped, and the next one makes up for it, so errors don't pile up.
+    int16_t limit = (1 << (tier->bits - 1)) - 1;
+    int16_t mask = (1 << tier->bits) - 1;
+    int32_t delta = avg - state->last;
+    if (delta > limit) delta = limit;
+    if (delta < -limit) delta = -limit;
+    state->last += delta;
+    _movement_temperature_set_field(state->block.data, tier->bits, index * tier->fields, delta & mask);
+    if (tier->fields == 3) {
+        int32_t below = state->last - min;
+        int32_t above = max - state->last;
+        _movement_temperature_set_field(state->block.data, tier->bits, index * 3 + 1, below < 0 ? 0 : below > mask ? mask : below);
+        _movement_temperature_set_field(state->block.data, tier->bits, index * 3 + 2, above < 0 ? 0 : above > mask ? mask : above);
+    }
+    state->next = index + 1;
+}
+
+// rolls a reading into the hour or day it falls in, and stores the one before once it's over.
+static void _movement_temperature_roll_up(movement_temperature_resolution_t resolution, uint32_t now, int16_t value) {
+    movement_temperature_state_t *state = &_state[resolution];
+    uint32_t since = now - now % _tiers[resolution].period;
+
+    if (state->count && state->since != since) {
+        _movement_temperature_put(resolution, state->since, state->sum / state->count, state->min, state->max);
+        state->count = 0;
+    }
+    if (state->count == 0) {
+        state->since = since;
+        state->min = value;
+        state->max = value;
+        state->sum = 0;
+    }
+    if (value < state->min) state->min = value;
+    if (value > state->max) state->max = value;
+    state->sum += value;
+    state->count++;
+}
+
+static void _movement_temperature_sample(const movement_sensor_sample_t *sample, void *context) {
+    (void) context;
+    if (!(sample->channels & MOVEMENT_SENSOR_CHANNEL(MOVEMENT_SENSOR_TEMPERATURE))) return;
+
+    uint32_t now = _movement_temperature_now();
+    now -= now % TEMPERATURE_SAMPLE_PERIOD;
+    int16_t value = _movement_temperature_to_decidegrees(sample->values[MOVEMENT_SENSOR_TEMPERATURE]);
+
+    _movement_temperature_put(MOVEMENT_TEMPERATURE_MINUTES, now, value, value, value);
+    _movement_temperature_roll_up(MOVEMENT_TEMPERATURE_HOURS, now, value);
+    _movement_temperature_roll_up(MOVEMENT_TEMPERATURE_DAYS, now, value);
+}
+
+// finds the stored block that starts at start: first where it would be if no blocks were skipped, then anywhere.
+static const movement_temperature_block_t *_movement_temperature_find_block(movement_temperature_resolution_t resolution, uint32_t start) {
+    const movement_temperature_tier_t *tier = &_tiers[resolution];
+    movement_temperature_state_t *state = &_state[resolution];
+    uint32_t span = tier->period * tier->periods;
+
+    if (state->block.start == start) return &state->block;
+    if (_cache_resolution == (int8_t)resolution && _cache.start == start) return &_cache;
+
+    _cache_resolution = -1;
+    uint32_t newest = state->block.start ? state->block.start : _movement_temperature_now();
+    if (newest > start) {
+        uint32_t guess = (newest - start) / span - (state->block.start ? 1 : 0);
+        if (movement_log_read(&state->log, guess, &_cache) && _cache.start == start) {
+            _cache_resolution = resolution;
+            return &_cache;
+        }
+    }
+
+    movement_log_cursor_t cursor;
+    movement_log_cursor_init(&cursor, &state->log);
+    while (movement_log_cursor_next(&cursor, &_cache)) {
+        if (_cache.start == start) {
+            _cache_resolution = resolution;
+            return &_cache;
+        }
+    }
+
+    return NULL;
+}
+
+void movement_temperature_enable(void) {
+    if (_enabled) return;
+
+    for (uint8_t i = 0; i < MOVEMENT_TEMPERATURE_NUM_RESOLUTIONS; i++) {
+        const movement_temperature_tier_t *tier = &_tiers[i];
+        memset(&_state[i], 0, sizeof(_state[i]));
+        movement_log_init(&_state[i].log, tier->name, _movement_temperature_record_size(tier), tier->records_per_file, tier->num_files);
+    }
+    _enabled = movement_sensors_subscribe(MOVEMENT_SENSOR_CHANNEL(MOVEMENT_SENSOR_TEMPERATURE), TEMPERATURE_SAMPLE_PERIOD,
+                                          _movement_temperature_sample, NULL);
+}
+
+bool movement_temperature_is_enabled(void) {
+    return _enabled;
+}
+
+uint32_t movement_temperature_count(movement_temperature_resolution_t resolution) {
+    if (!_enabled) return 0;
+    const movement_temperature_tier_t *tier = &_tiers[resolution];
+    movement_temperature_state_t *state = &_state[resolution];
+
+    uint32_t oldest = state->count ? state->since : 0;
+    if (state->block.start && (!oldest || state->block.start < oldest)) oldest = state->block.start;
+    uint32_t stored = movement_log_count(&state->log);
+    movement_temperature_block_t block;
+    if (stored && movement_log_read(&state->log, stored - 1, &block) && (!oldest || block.start < oldest)) oldest = block.start;
+    if (!oldest) return 0;
+
+    uint32_t now = _movement_temperature_now();
+    if (now < oldest) return 0;
+    return (now - oldest) / tier->period + 1;
+}
+
+bool movement_temperature_read(movement_temperature_resolution_t resolution, uint32_t index, movement_temperature_point_t *point) {
+    if (!_enabled || resolution >= MOVEMENT_TEMPERATURE_NUM_RESOLUTIONS) return false;
+    const movement_temperature_tier_t *tier = &_tiers[resolution];
+    movement_temperature_state_t *state = &_state[resolution];
+
+    uint32_t now = _movement_temperature_now();
+    uint32_t current = now - now % tier->period;
+    if ((uint64_t)index * tier->period > current) return false;
+    uint32_t since = current - index * tier->period;
+    point->timestamp = since;
+
+    // the hour or day that's still going is only in the roll-up.
+    if (state->count && state->since == since) {
+        point->avg = state->sum / state->count * 10;
+        point->min = state->min * 10;
+        point->max = state->max * 10;
+        return true;
+    }
+
+    uint32_t span = tier->period * tier->periods;
+    uint32_t start = since - since % span;
+    const movement_temperature_block_t *block = _movement_temperature_find_block(resolution, start);
+    if (block == NULL) return false;
+
+    uint8_t target = (since - start) / tier->period;
+    uint16_t missing = _movement_temperature_missing(tier->bits);
+    int16_t value = block->base;
+    for (uint8_t i = 0; i <= target; i++) {
+        uint16_t raw = _movement_temperature_get_field(block->data, tier->bits, i * tier->fields);
+        if (raw == missing) {
+            if (i == target) return false;
+            continue;
+        }
+        value += (raw & missing) ? (int16_t)raw - (1 << tier->bits) : (int16_t)raw;
+    }
+
+    point->avg = value * 10;
+    point->min = point->avg;
+    point->max = point->avg;
+    if (tier->fields == 3) {
+        point->min -= _movement_temperature_get_field(block->data, tier->bits, target * 3 + 1) * 10;
+        point->max += _movement_temperature_get_field(block->data, tier->bits, target * 3 + 2) * 10;
+    }
+
+    return true;
+}
+
+movement_log_t *movement_temperature_get_log(movement_temperature_resolution_t resolution) {
+    return &_state[resolution].log;
+}
@@ -0,0 +1,81 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MOVEMENT_TEMPERATURE_H_
+#define MOVEMENT_TEMPERATURE_H_
+#include <stdint.h>
+#include <stdbool.h>
+#include "movement_log.h"
+
+typedef enum {
+    MOVEMENT_TEMPERATURE_MINUTES = 0,   // one reading a minute, for the last 7 hours or more
+    MOVEMENT_TEMPERATURE_HOURS,         // each hour's minimum, average and maximum, for the last 6 days or more
+    MOVEMENT_TEMPERATURE_DAYS,          // each day's minimum, average and maximum, for the last 96 days or more
+    MOVEMENT_TEMPERATURE_NUM_RESOLUTIONS
+} movement_temperature_resolution_t;
+
+typedef struct {
+    uint32_t timestamp;     // local time, in seconds since the epoch, that the minute, hour or day began
+    int16_t min;            // hundredths of a degree Celsius, to the nearest tenth of a degree
+    int16_t avg;
+    int16_t max;
+} movement_temperature_point_t;
+
+/** @brief Starts keeping the temperature history. Does nothing if it's already running.
+  * @details The history takes the thermistor's reading from the sensor registry (@see movement_sensors_subscribe)
+  *          once a minute, and rolls the readings up into hours and days. Each resolution is kept in its own
+  *          movement_log, as blocks of consecutive periods: a block starts with a timestamp and a reading, and each
+  *          period after that is stored as the difference from the one before, in tenths of a degree. Minutes take
+  *          8 bits each, and hours and days 12 bits for each of their average and its distance to the minimum and
+  *          maximum. The whole history fits in ten rows of the filesystem. The block being filled is kept in RAM,
+  *          so up to half an hour of minutes, half a day of hours and a week of days are lost if the watch resets.
+  */
+void movement_temperature_enable(void);
+
+/** @brief Returns true if the history is being kept. */
+bool movement_temperature_is_enabled(void);
+
+/** @brief Returns the number of periods the history reaches back at a resolution, counting the current one. Some of
+  *        them may have no reading, if the watch wasn't recording then.
+  */
+uint32_t movement_temperature_count(movement_temperature_resolution_t resolution);
+
+/** @brief Reads one period of the history.
+  * @details The block that holds the period is one read from its log, at an index worked out from the time (the
+  *          log is only searched if the watch skipped whole blocks), and the periods around one that was just read
+  *          come from a cached block; nothing is recomputed from minutes.
+  * @param resolution Minutes, hours or days.
+  * @param index 0 for the current period (so far, for hours and days), 1 for the one before, and so on.
+  * @param point On return, the readings for the period.
+  * @return true if there are readings for the period; false if there aren't, or it's older than the history.
+  */
+bool movement_temperature_read(movement_temperature_resolution_t resolution, uint32_t index, movement_temperature_point_t *point);
+
+/** @brief Returns the log behind one resolution, for sending it elsewhere (@see movement_chirpy_send_log). Its
+  *        records are the completed blocks: a uint32_t local timestamp, an int16_t reading in tenths of a degree, and
+  *        the packed differences.
+  */
+movement_log_t *movement_temperature_get_log(movement_temperature_resolution_t resolution);
+
+#endif // MOVEMENT_TEMPERATURE_H_
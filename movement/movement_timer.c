@@ -0,0 +1,181 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "movement_timer.h"
+#include "movement.h"
+#include "watch_utility.h"
+
+typedef struct {
+    bool taken;
+    uint8_t face;
+    uint8_t slot : 4;
+    uint8_t state : 2;      // movement_timer_state_t
+    uint8_t sound : 2;      // movement_timer_sound_t
+    // running: the deadline, in UTC seconds since the epoch. paused: the seconds left. idle: the deadline it had
+    // when it ran out, for movement_timer_chain, or 0.
+    uint32_t value;
+} movement_timer_t;
+
+static movement_timer_t _timers[MOVEMENT_TIMER_MAX_TIMERS];
+
+static uint32_t _movement_timer_now(void) {
+    return watch_utility_date_time_to_unix_time(movement_get_utc_date_time(), 0);
+}
+
+static movement_timer_t *_movement_timer_find(uint8_t watch_face_index, uint8_t slot) {
+    for (uint8_t i = 0; i < MOVEMENT_TIMER_MAX_TIMERS; i++) {
+        if (_timers[i].taken && _timers[i].face == watch_face_index && _timers[i].slot == slot) return &_timers[i];
+    }
+    return NULL;
+}
+
+// the slot's own timer if it has one; otherwise a free one, or failing that one that's run out.
+static movement_timer_t *_movement_timer_claim(uint8_t watch_face_index, uint8_t slot) {
+    movement_timer_t *timer = _movement_timer_find(watch_face_index, slot);
+    if (timer != NULL) return timer;
+    movement_timer_t *idle = NULL;
+    for (uint8_t i = 0; i < MOVEMENT_TIMER_MAX_TIMERS && timer == NULL; i++) {
+        if (!_timers[i].taken) timer = &_timers[i];
+        else if (idle == NULL && _timers[i].state == MOVEMENT_TIMER_IDLE) idle = &_timers[i];
+    }
+    if (timer == NULL) timer = idle;
+    if (timer != NULL) {
+        timer->taken = true;
+        timer->face = watch_face_index;
+        timer->slot = slot;
+        timer->state = MOVEMENT_TIMER_IDLE;
+        timer->value = 0;
+    }
+    return timer;
+}
+
+// points the face's background task at its earliest running deadline, or cancels it if nothing's running.
+static void _movement_timer_reschedule(uint8_t watch_face_index) {
+    uint32_t deadline = UINT32_MAX;
+    for (uint8_t i = 0; i < MOVEMENT_TIMER_MAX_TIMERS; i++) {
+        if (_timers[i].taken && _timers[i].face == watch_face_index && _timers[i].state == MOVEMENT_TIMER_RUNNING &&
+            _timers[i].value < deadline) {
+            deadline = _timers[i].value;
+        }
+    }
+    if (deadline == UINT32_MAX) {
+        movement_cancel_background_task_for_face(watch_face_index);
+        return;
+    }
+    // a task in the past is never run, so one that's already due goes off at the next second.
+    uint32_t now = _movement_timer_now();
+    if (deadline <= now) deadline = now + 1;
+    int32_t offset = movement_get_current_timezone_offset() * 60;
+    movement_schedule_background_task_for_face(watch_face_index, watch_utility_date_time_from_unix_time(deadline, offset));
+}
+
+static bool _movement_timer_run(uint8_t watch_face_index, uint8_t slot, uint32_t seconds, movement_timer_sound_t sound, bool chain) {
+    movement_timer_t *timer = _movement_timer_claim(watch_face_index, slot);
+    if (timer == NULL) return false;
+    uint32_t from = _movement_timer_now();
+    if (chain && timer->state == MOVEMENT_TIMER_IDLE && timer->value) from = timer->value;
+    timer->state = MOVEMENT_TIMER_RUNNING;
+    timer->sound = sound;
+    timer->value = from + seconds;
+    _movement_timer_reschedule(watch_face_index);
+    return true;
+}
+
+bool movement_timer_start(uint8_t watch_face_index, uint8_t slot, uint32_t seconds, movement_timer_sound_t sound) {
+    return _movement_timer_run(watch_face_index, slot, seconds, sound, false);
+}
+
+bool movement_timer_chain(uint8_t watch_face_index, uint8_t slot, uint32_t seconds, movement_timer_sound_t sound) {
+    return _movement_timer_run(watch_face_index, slot, seconds, sound, true);
+}
+
+void movement_timer_pause(uint8_t watch_face_index, uint8_t slot) {
+    movement_timer_t *timer = _movement_timer_find(watch_face_index, slot);
+    if (timer == NULL || timer->state != MOVEMENT_TIMER_RUNNING) return;
+    timer->value = movement_timer_get_remaining(watch_face_index, slot);
+    timer->state = MOVEMENT_TIMER_PAUSED;
+    _movement_timer_reschedule(watch_face_index);
+}
+
+void movement_timer_resume(uint8_t watch_face_index, uint8_t slot) {
+    movement_timer_t *timer = _movement_timer_find(watch_face_index, slot);
+    if (timer == NULL || timer->state != MOVEMENT_TIMER_PAUSED) return;
+    timer->value += _movement_timer_now();
+    timer->state = MOVEMENT_TIMER_RUNNING;
+    _movement_timer_reschedule(watch_face_index);
+}
+
+void movement_timer_cancel(uint8_t watch_face_index, uint8_t slot) {
+    movement_timer_t *timer = _movement_timer_find(watch_face_index, slot);
+    if (timer == NULL) return;
+    bool was_running = timer->state == MOVEMENT_TIMER_RUNNING;
+    timer->taken = false;
+    timer->state = MOVEMENT_TIMER_IDLE;
+    if (was_running) _movement_timer_reschedule(watch_face_index);
+}
+
+movement_timer_state_t movement_timer_get_state(uint8_t watch_face_index, uint8_t slot) {
+    movement_timer_t *timer = _movement_timer_find(watch_face_index, slot);
+    return timer == NULL ? MOVEMENT_TIMER_IDLE : timer->state;
+}
+
+uint32_t movement_timer_get_remaining(uint8_t watch_face_index, uint8_t slot) {
+    movement_timer_t *timer = _movement_timer_find(watch_face_index, slot);
+    if (timer == NULL) return 0;
+    switch (timer->state) {
+        case MOVEMENT_TIMER_RUNNING: {
+            uint32_t now = _movement_timer_now();
+            return timer->value > now ? timer->value - now : 0;
+        }
+        case MOVEMENT_TIMER_PAUSED:
+            return timer->value;
+        default:
+            return 0;
+    }
+}
+
+uint8_t movement_timer_take_expired(uint8_t watch_face_index) {
+    uint32_t now = _movement_timer_now();
+    uint8_t expired = 0;
+    movement_timer_sound_t sound = MOVEMENT_TIMER_SOUND_NONE;
+    for (uint8_t i = 0; i < MOVEMENT_TIMER_MAX_TIMERS; i++) {
+        movement_timer_t *timer = &_timers[i];
+        if (!timer->taken || timer->face != watch_face_index || timer->state != MOVEMENT_TIMER_RUNNING || timer->value > now) continue;
+        // the deadline stays behind, for movement_timer_chain.
+        timer->state = MOVEMENT_TIMER_IDLE;
+        expired |= 1 << timer->slot;
+        // if several ran out together, the alarm drowns out the signal.
+        if (timer->sound > sound) sound = timer->sound;
+    }
+    if (sound == MOVEMENT_TIMER_SOUND_ALARM) movement_play_alarm();
+    else if (sound == MOVEMENT_TIMER_SOUND_SIGNAL) movement_play_signal();
+    _movement_timer_reschedule(watch_face_index);
+    return expired;
+}
+
+void movement_timer_clock_changed(void) {
+    for (uint8_t i = 0; i < MOVEMENT_TIMER_MAX_TIMERS; i++) {
+        if (_timers[i].taken && _timers[i].state == MOVEMENT_TIMER_RUNNING) _movement_timer_reschedule(_timers[i].face);
+    }
+}
@@ -0,0 +1,101 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MOVEMENT_TIMER_H_
+#define MOVEMENT_TIMER_H_
+#include <stdint.h>
+#include <stdbool.h>
+
+/** @brief Timers the service can hold at once, across all faces. */
+#ifndef MOVEMENT_TIMER_MAX_TIMERS
+#define MOVEMENT_TIMER_MAX_TIMERS 8
+#endif
+
+/** @brief Timers each face can have, numbered from 0; one bit each in what movement_timer_take_expired returns. */
+#define MOVEMENT_TIMER_SLOTS_PER_FACE 8
+
+typedef enum {
+    MOVEMENT_TIMER_IDLE = 0,    // never started, cancelled, or run out
+    MOVEMENT_TIMER_RUNNING,
+    MOVEMENT_TIMER_PAUSED,
+} movement_timer_state_t;
+
+typedef enum {
+    MOVEMENT_TIMER_SOUND_NONE = 0,  // the face plays its own sound, if any
+    MOVEMENT_TIMER_SOUND_SIGNAL,    // movement_play_signal
+    MOVEMENT_TIMER_SOUND_ALARM,     // movement_play_alarm
+} movement_timer_sound_t;
+
+/** @brief Starts a countdown of the given number of seconds for a face, replacing any it had in that slot.
+  * @details The service keeps the deadline, in UTC seconds since the epoch, rather than counting the time down, so a
+  *          running timer costs nothing until it's due: it schedules the face's background task (@see
+  *          movement_schedule_background_task_for_face) for the earliest of the face's running deadlines, and the
+  *          face calls movement_timer_take_expired when it gets the EVENT_BACKGROUND_TASK. A face that uses timers
+  *          hands its scheduled task over to the service, and shouldn't schedule or cancel one itself. To draw the
+  *          time left, call movement_timer_get_remaining from the face's tick, while it's on screen.
+  * @param watch_face_index The face the timer belongs to, and that gets the EVENT_BACKGROUND_TASK.
+  * @param slot Which of the face's timers, below MOVEMENT_TIMER_SLOTS_PER_FACE.
+  * @param seconds How long the timer runs; 0 runs out at the next second.
+  * @param sound What to play when the timer runs out.
+  * @return false if all MOVEMENT_TIMER_MAX_TIMERS timers are taken.
+  */
+bool movement_timer_start(uint8_t watch_face_index, uint8_t slot, uint32_t seconds, movement_timer_sound_t sound);
+
+/** @brief Starts the next of a run of back-to-back timers: like movement_timer_start, but if the slot's last timer
+  *        ran out, this one counts from its deadline rather than from now. However late the face hears about the
+  *        last one, the run doesn't drift.
+  */
+bool movement_timer_chain(uint8_t watch_face_index, uint8_t slot, uint32_t seconds, movement_timer_sound_t sound);
+
+/** @brief Stops a running timer, keeping the time it had left. */
+void movement_timer_pause(uint8_t watch_face_index, uint8_t slot);
+
+/** @brief Carries on with a paused timer from where it left off. */
+void movement_timer_resume(uint8_t watch_face_index, uint8_t slot);
+
+/** @brief Stops a timer for good, without a sound, and frees its place. */
+void movement_timer_cancel(uint8_t watch_face_index, uint8_t slot);
+
+/** @brief Returns what a timer is doing. */
+movement_timer_state_t movement_timer_get_state(uint8_t watch_face_index, uint8_t slot);
+
+/** @brief Returns a timer's seconds left: counted from the clock if it's running, as it stopped if it's paused, and 0
+  *        if it's idle.
+  */
+uint32_t movement_timer_get_remaining(uint8_t watch_face_index, uint8_t slot);
+
+/** @brief Finds the face's running timers whose deadlines have passed, plays their sounds, and makes them idle.
+  * @details Call this on EVENT_BACKGROUND_TASK. The face's background task is scheduled again for whatever's left, so
+  *          a face can chain the next timer (@see movement_timer_chain) as soon as this returns.
+  * @return The slots that ran out, one bit each: bit 0 for slot 0. 0 if nothing was due.
+  */
+uint8_t movement_timer_take_expired(uint8_t watch_face_index);
+
+/** @brief Schedules the faces' background tasks again after the clock has been set; Movement calls this.
+  * @details Background tasks are scheduled in local time, which moves when daylight saving starts or ends; the
+  *          deadlines don't, so the tasks are moved to match.
+  */
+void movement_timer_clock_changed(void);
+
+#endif // MOVEMENT_TIMER_H_
@@ -0,0 +1,96 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "movement_tz.h"
+#include "movement_tz_table.h"
+#include "movement.h"
+
+typedef struct {
+    uint32_t from;          // UTC timestamp at which the offset took effect
+    uint32_t until;         // and at which it next changes
+    int16_t offset;
+    uint8_t zone;
+    bool daylight_saving;
+} movement_tz_span_t;
+
+static movement_tz_span_t tz_cache[MOVEMENT_TZ_CACHE_SIZE];
+static uint8_t tz_cache_next;
+
+static uint32_t _movement_tz_transition(uint8_t rule, uint16_t i, int16_t standard_offset) {
+    const tz_table_rule_t *r = &Tz_Rules[rule];
+    uint32_t timestamp = Tz_Transition_Days[rule][i] * 86400UL + ((i & 1) ? r->end_minute : r->start_minute) * 60UL;
+    // the table runs past 2038, so this stays unsigned; a zone west of UTC changes later than its standard time says.
+    return r->utc ? timestamp : timestamp - (uint32_t)(standard_offset * 60);
+}
+
+static movement_tz_span_t _movement_tz_find_span(uint8_t zone, bool daylight_saving, uint32_t utc_timestamp) {
+    for (uint8_t i = 0; i < MOVEMENT_TZ_CACHE_SIZE; i++) {
+        const movement_tz_span_t *span = &tz_cache[i];
+        if (span->zone == zone && span->daylight_saving == daylight_saving &&
+            utc_timestamp >= span->from && utc_timestamp < span->until) return *span;
+    }
+
+    movement_tz_span_t span = { 0, UINT32_MAX, movement_timezone_offsets[zone], zone, daylight_saving };
+    uint8_t rule = Tz_Zone_Rules[zone];
+    if (daylight_saving && rule != TZ_TABLE_NO_RULE) {
+        // binary search for how many of the rule's starts and ends have come; after an odd number, the clocks are forward.
+        uint16_t low = 0;
+        uint16_t high = TZ_TABLE_NUM_TRANSITIONS;
+        while (low < high) {
+            uint16_t mid = (low + high) / 2;
+            if (_movement_tz_transition(rule, mid, span.offset) <= utc_timestamp) low = mid + 1;
+            else high = mid;
+        }
+        if (low > 0) span.from = _movement_tz_transition(rule, low - 1, span.offset);
+        if (low < TZ_TABLE_NUM_TRANSITIONS) span.until = _movement_tz_transition(rule, low, span.offset);
+        if (low & 1) span.offset += Tz_Rules[rule].save;
+    }
+
+    tz_cache[tz_cache_next] = span;
+    tz_cache_next = (tz_cache_next + 1) % MOVEMENT_TZ_CACHE_SIZE;
+    return span;
+}
+
+int16_t movement_tz_get_offset(uint8_t zone, bool daylight_saving, uint32_t utc_timestamp, uint32_t *until) {
+    movement_tz_span_t span = _movement_tz_find_span(zone, daylight_saving, utc_timestamp);
+    if (until != NULL) *until = span.until;
+    return span.offset;
+}
+
+int16_t movement_tz_get_local_offset(uint8_t zone, bool daylight_saving, uint32_t local_timestamp, uint32_t *until) {
+    int16_t standard_offset = movement_timezone_offsets[zone];
+    movement_tz_span_t span = _movement_tz_find_span(zone, daylight_saving, local_timestamp - standard_offset * 60);
+    if (span.offset != standard_offset) {
+        // read as standard time, it's after the clocks went forward; read as daylight time, it may be before.
+        movement_tz_span_t saving = _movement_tz_find_span(zone, daylight_saving, local_timestamp - span.offset * 60);
+        if (saving.offset != span.offset) {
+            // the hour that was skipped.
+            span.until = span.from;
+            span.offset = standard_offset;
+        }
+    }
+    if (until != NULL) *until = span.until;
+    return span.offset;
+}
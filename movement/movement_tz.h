@@ -0,0 +1,58 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef MOVEMENT_TZ_H_
+#define MOVEMENT_TZ_H_
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @brief Number of zones whose offsets were asked for last that are remembered, along with how long they hold. */
+#ifndef MOVEMENT_TZ_CACHE_SIZE
+#define MOVEMENT_TZ_CACHE_SIZE 4
+#endif
+
+/** @brief Returns the offset from UTC in effect in a time zone at a moment in time.
+  * @param zone An index into movement_timezone_offsets.
+  * @param daylight_saving false for the zone's standard offset all year; true to follow the daylight saving rule of the
+  *                        places that keep that offset, if there is one.
+  * @param utc_timestamp The moment, as a UNIX timestamp.
+  * @param until If not NULL, set to the UTC timestamp at which the offset next changes, or UINT32_MAX if it doesn't.
+  * @return The offset, in minutes east of UTC.
+  * @details The start and end of daylight saving time from 2025 to 2054 come from a precomputed table (see
+  *          utils/gen_tz_table.py), which is searched in O(log n). Each answer is remembered with the span it holds
+  *          for, so asking again before the zone's next change (as a world clock does every second) doesn't even
+  *          search the table. Before the table, a zone keeps the offset it starts with; after, the one it ends with.
+  */
+int16_t movement_tz_get_offset(uint8_t zone, bool daylight_saving, uint32_t utc_timestamp, uint32_t *until);
+
+/** @brief Returns the offset from UTC in effect in a time zone at a local time there.
+  * @param local_timestamp The local time, as if it were a UNIX timestamp in UTC.
+  * @details Otherwise as movement_tz_get_offset. In the hour the clocks go back, which comes twice, this picks the
+  *          standard offset. In the hour they skip, which never comes, it also picks the standard offset, with until
+  *          set to the moment it already ended, so that whoever keeps the clock knows to put it forward.
+  */
+int16_t movement_tz_get_local_offset(uint8_t zone, bool daylight_saving, uint32_t local_timestamp, uint32_t *until);
+
+#endif // MOVEMENT_TZ_H_
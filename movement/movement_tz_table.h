@@ -0,0 +1,89 @@
+// This file is generated by utils/gen_tz_table.py. Do not edit.
+#ifndef MOVEMENT_TZ_TABLE_H_
+#define MOVEMENT_TZ_TABLE_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+typedef struct {
+    uint8_t save;           // minutes the clocks go forward
+    bool utc;               // whether start_minute and end_minute are UTC, or the zone's standard time
+    uint16_t start_minute;  // minute of the day the season starts
+    uint16_t end_minute;    // and ends
+} tz_table_rule_t;
+
+#define TZ_TABLE_NUM_RULES 6
+static const tz_table_rule_t Tz_Rules[TZ_TABLE_NUM_RULES] = {
+    { 60, true, 60, 60 }, // EU
+    { 60, false, 120, 60 }, // US
+    { 60, false, 120, 120 }, // AU
+    { 30, false, 120, 90 }, // Lord Howe
+    { 60, false, 120, 120 }, // NZ
+    { 60, false, 165, 165 }, // Chatham
+};
+
+// the rule each zone in movement_timezone_offsets follows, if any.
+#define TZ_TABLE_NO_RULE 0xFF
+#define TZ_TABLE_NUM_ZONES 41
+static const uint8_t Tz_Zone_Rules[TZ_TABLE_NUM_ZONES] = {
+    0xFF, 0, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 2, 2, 3, 0xFF, 4, 5, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 1, 1, 1, 1, 1, 0xFF, 1,
+    1, 0xFF, 0xFF, 0xFF, 0,
+};
+
+// days since 1970 on which each rule's seasons start and end, in turn, from the one under way at the start
+// of 2025 to the last to start by the end of 2054 (in the south, by the end of 2053).
+#define TZ_TABLE_NUM_TRANSITIONS 60
+static const uint16_t Tz_Transition_Days[TZ_TABLE_NUM_RULES][TZ_TABLE_NUM_TRANSITIONS] = {
+    { // EU
+        20177, 20387, 20541, 20751, 20905, 21122, 21269, 21486, 21633, 21850,
+        22004, 22214, 22368, 22578, 22732, 22949, 23096, 23313, 23460, 23677,
+        23824, 24041, 24195, 24405, 24559, 24769, 24923, 25140, 25287, 25504,
+        25651, 25868, 26022, 26232, 26386, 26596, 26750, 26960, 27114, 27331,
+        27478, 27695, 27842, 28059, 28213, 28423, 28577, 28787, 28941, 29158,
+        29305, 29522, 29669, 29886, 30040, 30250, 30404, 30614, 30768, 30978,
+    },
+    { // US
+        20156, 20394, 20520, 20758, 20891, 21129, 21255, 21493, 21619, 21857,
+        21983, 22221, 22347, 22585, 22718, 22956, 23082, 23320, 23446, 23684,
+        23810, 24048, 24174, 24412, 24538, 24776, 24909, 25147, 25273, 25511,
+        25637, 25875, 26001, 26239, 26365, 26603, 26729, 26967, 27100, 27338,
+        27464, 27702, 27828, 28066, 28192, 28430, 28556, 28794, 28927, 29165,
+        29291, 29529, 29655, 29893, 30019, 30257, 30383, 30621, 30747, 30985,
+    },
+    { // AU
+        20002, 20184, 20366, 20548, 20730, 20912, 21094, 21276, 21458, 21640,
+        21829, 22011, 22193, 22375, 22557, 22739, 22921, 23103, 23285, 23467,
+        23649, 23831, 24020, 24202, 24384, 24566, 24748, 24930, 25112, 25294,
+        25476, 25658, 25847, 26029, 26211, 26393, 26575, 26757, 26939, 27121,
+        27303, 27485, 27667, 27849, 28038, 28220, 28402, 28584, 28766, 28948,
+        29130, 29312, 29494, 29676, 29858, 30047, 30229, 30411, 30593, 30775,
+    },
+    { // Lord Howe
+        20002, 20184, 20366, 20548, 20730, 20912, 21094, 21276, 21458, 21640,
+        21829, 22011, 22193, 22375, 22557, 22739, 22921, 23103, 23285, 23467,
+        23649, 23831, 24020, 24202, 24384, 24566, 24748, 24930, 25112, 25294,
+        25476, 25658, 25847, 26029, 26211, 26393, 26575, 26757, 26939, 27121,
+        27303, 27485, 27667, 27849, 28038, 28220, 28402, 28584, 28766, 28948,
+        29130, 29312, 29494, 29676, 29858, 30047, 30229, 30411, 30593, 30775,
+    },
+    { // NZ
+        19995, 20184, 20359, 20548, 20723, 20912, 21087, 21276, 21451, 21640,
+        21822, 22011, 22186, 22375, 22550, 22739, 22914, 23103, 23278, 23467,
+        23642, 23831, 24013, 24202, 24377, 24566, 24741, 24930, 25105, 25294,
+        25469, 25658, 25840, 26029, 26204, 26393, 26568, 26757, 26932, 27121,
+        27296, 27485, 27660, 27849, 28031, 28220, 28395, 28584, 28759, 28948,
+        29123, 29312, 29487, 29676, 29851, 30047, 30222, 30411, 30586, 30775,
+    },
+    { // Chatham
+        19995, 20184, 20359, 20548, 20723, 20912, 21087, 21276, 21451, 21640,
+        21822, 22011, 22186, 22375, 22550, 22739, 22914, 23103, 23278, 23467,
+        23642, 23831, 24013, 24202, 24377, 24566, 24741, 24930, 25105, 25294,
+        25469, 25658, 25840, 26029, 26204, 26393, 26568, 26757, 26932, 27121,
+        27296, 27485, 27660, 27849, 28031, 28220, 28395, 28584, 28759, 28948,
+        29123, 29312, 29487, 29676, 29851, 30047, 30222, 30411, 30586, 30775,
+    },
+};
+
+#endif // MOVEMENT_TZ_TABLE_H_
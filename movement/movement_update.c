@@ -0,0 +1,211 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include <stdlib.h>
+#include <string.h>
+#include "movement_update.h"
+#include "movement_kv.h"
+#include "watch.h"
+
+// each op is a byte: the top two bits say what it is, and the rest its length. a length of 63 or more doesn't fit, so
+// 63 there means 64 plus a varint (seven bits a byte, low bits first) to follow. copies then take one more varint.
+#define UPDATE_OP_LITERAL 0         // that many bytes follow
+#define UPDATE_OP_COPY_BASE 1       // from the old image, at this position plus a signed (zigzag) distance
+#define UPDATE_OP_COPY_IMAGE 2      // from the new image, this far back
+#define UPDATE_LENGTH_FOLLOWS 63
+
+typedef enum {
+    UPDATE_STEP_OP = 0,
+    UPDATE_STEP_LENGTH,
+    UPDATE_STEP_DISTANCE,
+    UPDATE_STEP_LITERAL,
+} movement_update_step_t;
+
+typedef struct {
+    const uint8_t *base;
+    uint32_t base_size;
+    uint32_t size;                  // of the new image
+    uint32_t crc;                   // the new image's CRC-32
+    uint32_t staging;               // where the new image is built, from the start of the running one
+    uint32_t position;              // how much of the new image has been built
+    uint32_t received;              // how much of the delta has been taken
+    movement_update_step_t step;
+    uint8_t op;
+    uint8_t shift;
+    uint32_t length;
+    uint32_t distance;
+    bool finished;
+    uint8_t row[NVMCTRL_ROW_SIZE];  // the row being built, until it's full
+} movement_update_state_t;
+
+static movement_update_state_t *_state = NULL;
+
+static void _movement_update_abort(void) {
+    free(_state);
+    _state = NULL;
+}
+
+static bool _movement_update_write_row(void) {
+    uint32_t start = (_state->position - 1) / NVMCTRL_ROW_SIZE * NVMCTRL_ROW_SIZE;
+    return watch_firmware_erase(_state->staging + start) &&
+           watch_firmware_write(_state->staging + start, _state->row, _state->position - start);
+}
+
+static bool _movement_update_emit(uint8_t byte) {
+    if (_state->position >= _state->size) return false;
+    _state->row[_state->position % NVMCTRL_ROW_SIZE] = byte;
+    _state->position++;
+    if (_state->position % NVMCTRL_ROW_SIZE == 0) return _movement_update_write_row();
+    return true;
+}
+
+static bool _movement_update_copy(void) {
+    uint32_t length = _state->length;
+    if (_state->op == UPDATE_OP_COPY_BASE) {
+        // zigzag: even distances are forward, odd ones back.
+        int32_t distance = (_state->distance >> 1) ^ -(int32_t)(_state->distance & 1);
+        uint32_t from = _state->position + distance;
+        if (from > _state->base_size || length > _state->base_size - from) return false;
+        for (uint32_t i = 0; i < length; i++) {
+            if (!_movement_update_emit(_state->base[from + i])) return false;
+        }
+    } else {
+        if (_state->distance == 0 || _state->distance > _state->position) return false;
+        const uint8_t *image = _state->base + _state->staging;
+        for (uint32_t i = 0; i < length; i++) {
+            // bytes from rows already written are read back from flash; the rest are still in the row buffer.
+            uint32_t from = _state->position - _state->distance;
+            uint32_t row_start = _state->position / NVMCTRL_ROW_SIZE * NVMCTRL_ROW_SIZE;
+            uint8_t byte = from >= row_start ? _state->row[from % NVMCTRL_ROW_SIZE] : image[from];
+            if (!_movement_update_emit(byte)) return false;
+        }
+    }
+    return true;
+}
+
+// having the op's length, moves on to what the op needs next.
+static bool _movement_update_start_op(void) {
+    if (_state->op == UPDATE_OP_LITERAL) {
+        _state->step = UPDATE_STEP_LITERAL;
+    } else {
+        _state->step = UPDATE_STEP_DISTANCE;
+        _state->distance = 0;
+        _state->shift = 0;
+    }
+    return true;
+}
+
+static bool _movement_update_take(uint8_t byte) {
+    switch (_state->step) {
+        case UPDATE_STEP_OP:
+            _state->op = byte >> 6;
+            if (_state->op > UPDATE_OP_COPY_IMAGE) return false;
+            if ((byte & 0x3F) == UPDATE_LENGTH_FOLLOWS) {
+                _state->step = UPDATE_STEP_LENGTH;
+                _state->length = 0;
+                _state->shift = 0;
+                return true;
+            }
+            _state->length = (byte & 0x3F) + 1;
+            return _movement_update_start_op();
+        case UPDATE_STEP_LENGTH:
+        case UPDATE_STEP_DISTANCE:
+        {
+            if (_state->shift > 28) return false;
+            uint32_t *value = _state->step == UPDATE_STEP_LENGTH ? &_state->length : &_state->distance;
+            *value |= (uint32_t)(byte & 0x7F) << _state->shift;
+            _state->shift += 7;
+            if (byte & 0x80) return true;
+            if (_state->step == UPDATE_STEP_LENGTH) {
+                _state->length += UPDATE_LENGTH_FOLLOWS + 1;
+                return _movement_update_start_op();
+            }
+            _state->step = UPDATE_STEP_OP;
+            return _movement_update_copy();
+        }
+        case UPDATE_STEP_LITERAL:
+            if (--_state->length == 0) _state->step = UPDATE_STEP_OP;
+            return _movement_update_emit(byte);
+    }
+    return false;
+}
+
+bool movement_update_begin(uint32_t base_size, uint32_t base_crc, uint32_t size, uint32_t crc) {
+    _movement_update_abort();
+
+    uint32_t running_size;
+    const uint8_t *running = watch_firmware_get_image(&running_size);
+    if (running == NULL || running_size != base_size || watch_crc32(running, running_size) != base_crc) {
+        return false;
+    }
+    // build the new image as high as it goes, clear of the running one.
+    uint32_t capacity = watch_firmware_get_capacity();
+    if (size == 0 || size > capacity) return false;
+    uint32_t staging = (capacity - size) / NVMCTRL_ROW_SIZE * NVMCTRL_ROW_SIZE;
+    if (staging < (running_size + NVMCTRL_ROW_SIZE - 1) / NVMCTRL_ROW_SIZE * NVMCTRL_ROW_SIZE) return false;
+
+    _state = calloc(1, sizeof(movement_update_state_t));
+    if (_state == NULL) return false;
+    _state->base = running;
+    _state->base_size = base_size;
+    _state->size = size;
+    _state->crc = crc;
+    _state->staging = staging;
+    return true;
+}
+
+bool movement_update_receive(uint32_t offset, const uint8_t *data, uint16_t length) {
+    if (_state == NULL || _state->finished) return false;
+    if (offset + length <= _state->received) return true;
+    if (offset != _state->received) return false;
+
+    for (uint16_t i = 0; i < length; i++) {
+        if (!_movement_update_take(data[i])) {
+            _movement_update_abort();
+            return false;
+        }
+    }
+    _state->received += length;
+    return true;
+}
+
+bool movement_update_finish(void) {
+    if (_state == NULL) return false;
+    if (_state->finished) return true;
+
+    bool success = _state->step == UPDATE_STEP_OP && _state->position == _state->size;
+    if (success && _state->position % NVMCTRL_ROW_SIZE) success = _movement_update_write_row();
+    if (success) success = watch_crc32(_state->base + _state->staging, _state->size) == _state->crc;
+    if (!success) {
+        _movement_update_abort();
+        return false;
+    }
+    _state->finished = true;
+    return true;
+}
+
+void movement_update_install(void) {
+    if (_state == NULL || !_state->finished) return;
+    movement_kv_flush();
+    watch_firmware_install(_state->staging, _state->size);
+}
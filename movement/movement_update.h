@@ -0,0 +1,71 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef MOVEMENT_UPDATE_H_
+#define MOVEMENT_UPDATE_H_
+#include <stdint.h>
+#include <stdbool.h>
+
+/*
+ * Firmware updates as deltas against the firmware the watch is running, for host tools (@see shell_rpc.h).
+ *
+ * utils/firmware_delta.py makes a delta from the .bin of the running release and the .bin of the new one: the new
+ * image as a run of pieces copied from the old image, pieces copied from earlier in the new image, and literal bytes.
+ * Changing one face leaves most of the image the same but shifted, which costs a few bytes per run; the rest of the
+ * transfer is the new code itself.
+ *
+ * The watch builds the new image in the free flash above the running one (@see watch_firmware.h) as the delta
+ * arrives, then checks it against the CRC-32 it should have, and only then copies it over the running image and
+ * resets. Nothing is changed until then, so an update that's interrupted, or a delta made against some other
+ * release, leaves the watch as it was.
+ */
+
+/** @brief Starts an update, after checking the delta was made against the running image.
+  * @param base_size The size of the image the delta was made against.
+  * @param base_crc Its CRC-32 (as zlib's crc32).
+  * @param size The size of the new image.
+  * @param crc The new image's CRC-32.
+  * @return false if the running image isn't the base, or there's no room for the new one.
+  */
+bool movement_update_begin(uint32_t base_size, uint32_t base_crc, uint32_t size, uint32_t crc);
+
+/** @brief Takes the next piece of the delta, and builds that much of the new image.
+  * @param offset Where in the delta the piece starts. Pieces have to come in order; one that's already been taken
+  *               (because its answer went astray and the host sent it again) is ignored.
+  * @param data The piece.
+  * @param length Its length.
+  * @return false if the piece is out of order, or the delta doesn't make sense; the update is over.
+  */
+bool movement_update_receive(uint32_t offset, const uint8_t *data, uint16_t length);
+
+/** @brief Finishes building the new image, and checks it.
+  * @return true if the image is complete and its CRC-32 matches, and it's ready for movement_update_install.
+  */
+bool movement_update_finish(void);
+
+/** @brief Writes out anything Movement has yet to store, then installs the image movement_update_finish checked, and
+  *        resets into it. Returns, having done nothing, if there isn't one.
+  */
+void movement_update_install(void);
+
+#endif // MOVEMENT_UPDATE_H_
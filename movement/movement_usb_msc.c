@@ -0,0 +1,431 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#if defined(MOVEMENT_USB_MSC) && !__EMSCRIPTEN__
+
+#include <string.h>
+#include "movement_usb_msc.h"
+#include "movement.h"
+#include "filesystem.h"
+#include "spiflash.h"
+#include "watch.h"
+#include "tusb.h"
+
+#ifndef LFS_THREADSAFE
+#error "The USB mass storage view needs littlefs built with LFS_THREADSAFE."
+#endif
+
+// the drive's geometry. 4 KB clusters keep the cluster count low enough for FAT12, whose tables are small enough
+// to make up on the fly, while still covering the accelerometer log and all of the filesystem.
+#define MSC_SECTOR_SIZE 512
+#define MSC_SECTORS_PER_CLUSTER 8
+#define MSC_CLUSTER_SIZE (MSC_SECTOR_SIZE * MSC_SECTORS_PER_CLUSTER)
+#define MSC_NUM_CLUSTERS 1024
+#define MSC_FAT_SECTORS (((MSC_NUM_CLUSTERS + 2) * 3 / 2 + MSC_SECTOR_SIZE) / MSC_SECTOR_SIZE)
+#define MSC_ROOT_ENTRIES 128
+#define MSC_ROOT_SECTORS (MSC_ROOT_ENTRIES * 32 / MSC_SECTOR_SIZE)
+#define MSC_FAT_START 1
+#define MSC_ROOT_START (MSC_FAT_START + 2 * MSC_FAT_SECTORS)
+#define MSC_DATA_START (MSC_ROOT_START + MSC_ROOT_SECTORS)
+#define MSC_TOTAL_SECTORS (MSC_DATA_START + MSC_NUM_CLUSTERS * MSC_SECTORS_PER_CLUSTER)
+
+#define MSC_ATTR_READ_ONLY 0x01
+#define MSC_ATTR_VOLUME_ID 0x08
+#define MSC_ATTR_LONG_NAME 0x0F
+#define MSC_NT_LOWER_BASE 0x08
+#define MSC_NT_LOWER_EXT 0x10
+#define MSC_LFN_CHARS 13
+
+#define MSC_VOLUME_LABEL "SENSORWATCH"
+
+_Static_assert(MSC_NUM_CLUSTERS < 4085, "too many clusters for FAT12");
+_Static_assert(MSC_TOTAL_SECTORS <= 0xFFFF, "the sector count must fit the boot sector's 16-bit field");
+_Static_assert(CFG_TUD_MSC_EP_BUFSIZE == MSC_SECTOR_SIZE, "each read callback is expected to cover one sector");
+// the volume label, plus a short entry and the long name entries for each file.
+_Static_assert(1 + (MOVEMENT_USB_MSC_MAX_FILES + 1) * (1 + (MOVEMENT_USB_MSC_NAME_MAX + MSC_LFN_CHARS - 1) / MSC_LFN_CHARS) <= MSC_ROOT_ENTRIES,
+               "the root directory is too small for the files");
+_Static_assert(MOVEMENT_USB_MSC_ACCEL_LOG_SIZE / MSC_CLUSTER_SIZE + MOVEMENT_USB_MSC_MAX_FILES <= MSC_NUM_CLUSTERS,
+               "the data area is too small for the accelerometer log");
+
+typedef struct {
+    char name[MOVEMENT_USB_MSC_NAME_MAX + 1];
+    uint32_t size;
+    uint16_t first_cluster;     // 0 for an empty file
+    uint16_t num_clusters;
+    bool is_accel_log;
+} movement_usb_msc_file_t;
+
+// the files as of the last snapshot. the accelerometer log goes first, so that it stays in the same clusters when
+// the files after it come and go.
+static movement_usb_msc_file_t _files[MOVEMENT_USB_MSC_MAX_FILES + 1];
+static uint8_t _num_files;
+static uint16_t _next_cluster;
+static uint32_t _accel_log_size;
+static uint32_t _generation;
+static bool _has_snapshot;
+static uint16_t _fat_date;
+static uint16_t _fat_time;
+
+static void _movement_usb_msc_put16(uint8_t *p, uint16_t value) {
+    p[0] = value & 0xFF;
+    p[1] = value >> 8;
+}
+
+static void _movement_usb_msc_put32(uint8_t *p, uint32_t value) {
+    _movement_usb_msc_put16(p, value & 0xFFFF);
+    _movement_usb_msc_put16(p + 2, value >> 16);
+}
+
+static void _movement_usb_msc_add_file(const char *filename, uint32_t size, bool is_accel_log) {
+    movement_usb_msc_file_t *file = &_files[_num_files++];
+    strcpy(file->name, filename);
+    file->size = size;
+    file->is_accel_log = is_accel_log;
+    file->num_clusters = (size + MSC_CLUSTER_SIZE - 1) / MSC_CLUSTER_SIZE;
+    file->first_cluster = file->num_clusters ? _next_cluster : 0;
+    _next_cluster += file->num_clusters;
+}
+
+static bool _movement_usb_msc_list_file(const char *filename, int32_t size, void *context) {
+    (void) context;
+    if (strlen(filename) > MOVEMENT_USB_MSC_NAME_MAX) return true;
+    if (_next_cluster + (size + MSC_CLUSTER_SIZE - 1) / MSC_CLUSTER_SIZE > MSC_NUM_CLUSTERS + 2) return true;
+    _movement_usb_msc_add_file(filename, size, false);
+    return _num_files < MOVEMENT_USB_MSC_MAX_FILES + (_accel_log_size ? 1 : 0);
+}
+
+static bool _movement_usb_msc_take_snapshot(void) {
+    uint32_t generation = filesystem_get_generation();
+    _num_files = 0;
+    _next_cluster = 2;
+    if (_accel_log_size) _movement_usb_msc_add_file("ACCEL.BIN", _accel_log_size, true);
+    if (!filesystem_list_files(_movement_usb_msc_list_file, NULL)) return false;
+
+    watch_date_time now = movement_get_local_date_time();
+    _fat_date = ((now.unit.year + WATCH_RTC_REFERENCE_YEAR - 1980) << 9) | (now.unit.month << 5) | now.unit.day;
+    _fat_time = (now.unit.hour << 11) | (now.unit.minute << 5) | (now.unit.second / 2);
+    _generation = generation;
+    _has_snapshot = true;
+
+    return true;
+}
+
+static bool _movement_usb_msc_is_short_char(char c) {
+    return (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z') || (c >= '0' && c <= '9') || (c && strchr("!#$%&'()-@^_`{}~", c));
+}
+
+// fills in the 8.3 name for a file, and returns true if that's its whole name, lower case flags and all; otherwise
+// it makes up a unique one to go with the long name.
+static bool _movement_usb_msc_short_name(const movement_usb_msc_file_t *file, uint8_t index, uint8_t *short_name, uint8_t *nt_flags) {
+    memset(short_name, ' ', 11);
+    *nt_flags = 0;
+    const char *dot = strrchr(file->name, '.');
+    size_t base_length = dot ? (size_t)(dot - file->name) : strlen(file->name);
+    size_t ext_length = dot ? strlen(dot + 1) : 0;
+
+    bool fits = base_length >= 1 && base_length <= 8 && ext_length <= 3 && (!dot || ext_length);
+    uint8_t upper[2] = {0}, lower[2] = {0};
+    for (size_t i = 0; fits && file->name[i]; i++) {
+        char c = file->name[i];
+        uint8_t part = (dot && &file->name[i] > dot) ? 1 : 0;
+        if (&file->name[i] == dot) continue;
+        if (!_movement_usb_msc_is_short_char(c)) fits = false;
+        if (c >= 'A' && c <= 'Z') upper[part] = 1;
+        if (c >= 'a' && c <= 'z') lower[part] = 1;
+    }
+    fits = fits && !(upper[0] && lower[0]) && !(upper[1] && lower[1]);
+    if (lower[0]) *nt_flags |= MSC_NT_LOWER_BASE;
+    if (lower[1]) *nt_flags |= MSC_NT_LOWER_EXT;
+
+    // the base, cut short to make room for a ~ and the file's index when it doesn't fit.
+    size_t base_max = fits ? 8 : 5;
+    size_t j = 0;
+    for (size_t i = 0; i < base_length && j < base_max; i++) {
+        char c = file->name[i];
+        if (!_movement_usb_msc_is_short_char(c)) continue;
+        short_name[j++] = (c >= 'a' && c <= 'z') ? c - 'a' + 'A' : c;
+    }
+    if (!fits) {
+        short_name[j++] = '~';
+        short_name[j++] = '0' + index / 10;
+        short_name[j++] = '0' + index % 10;
+        *nt_flags = 0;
+    }
+    j = 8;
+    for (size_t i = 0; dot && dot[1 + i] && j < 11; i++) {
+        char c = dot[1 + i];
+        if (!_movement_usb_msc_is_short_char(c)) continue;
+        short_name[j++] = (c >= 'a' && c <= 'z') ? c - 'a' + 'A' : c;
+    }
+
+    return fits;
+}
+
+// copies a directory entry into the sector being read, if it falls within it.
+static void _movement_usb_msc_emit(uint8_t *sector, uint32_t first_entry, uint32_t *entry_index, const uint8_t *entry) {
+    if (*entry_index >= first_entry && *entry_index < first_entry + MSC_SECTOR_SIZE / 32) {
+        memcpy(sector + (*entry_index - first_entry) * 32, entry, 32);
+    }
+    (*entry_index)++;
+}
+
+static void _movement_usb_msc_read_root(uint32_t sector_index, uint8_t *sector) {
+    uint32_t first_entry = sector_index * MSC_SECTOR_SIZE / 32;
+    uint32_t entry_index = 0;
+    uint8_t entry[32];
+
+    memset(entry, 0, sizeof(entry));
+    memcpy(entry, MSC_VOLUME_LABEL, 11);
+    entry[11] = MSC_ATTR_VOLUME_ID;
+    _movement_usb_msc_put16(entry + 22, _fat_time);
+    _movement_usb_msc_put16(entry + 24, _fat_date);
+    _movement_usb_msc_emit(sector, first_entry, &entry_index, entry);
+
+    for (uint8_t i = 0; i < _num_files; i++) {
+        movement_usb_msc_file_t *file = &_files[i];
+        uint8_t short_name[11];
+        uint8_t nt_flags;
+
+        if (!_movement_usb_msc_short_name(file, i + 1, short_name, &nt_flags)) {
+            uint8_t checksum = 0;
+            for (uint8_t j = 0; j < 11; j++) checksum = ((checksum & 1) << 7) + (checksum >> 1) + short_name[j];
+
+            // long name entries go last part first, each holding 13 UCS-2 characters; the name ends with a 0, and
+            // 0xFFFF fills the rest.
+            size_t length = strlen(file->name);
+            uint8_t num_parts = (length + MSC_LFN_CHARS - 1) / MSC_LFN_CHARS;
+            static const uint8_t offsets[MSC_LFN_CHARS] = {1, 3, 5, 7, 9, 14, 16, 18, 20, 22, 24, 28, 30};
+            for (uint8_t part = num_parts; part > 0; part--) {
+                memset(entry, 0, sizeof(entry));
+                entry[0] = part | (part == num_parts ? 0x40 : 0);
+                entry[11] = MSC_ATTR_LONG_NAME;
+                entry[13] = checksum;
+                for (uint8_t j = 0; j < MSC_LFN_CHARS; j++) {
+                    size_t c = (part - 1) * MSC_LFN_CHARS + j;
+                    uint16_t value = c < length ? (uint8_t)file->name[c] : c == length ? 0 : 0xFFFF;
+                    _movement_usb_msc_put16(entry + offsets[j], value);
+                }
+                _movement_usb_msc_emit(sector, first_entry, &entry_index, entry);
+            }
+        }
+
+        memset(entry, 0, sizeof(entry));
+        memcpy(entry, short_name, 11);
+        entry[11] = MSC_ATTR_READ_ONLY;
+        entry[12] = nt_flags;
+        _movement_usb_msc_put16(entry + 14, _fat_time);
+        _movement_usb_msc_put16(entry + 16, _fat_date);
+        _movement_usb_msc_put16(entry + 18, _fat_date);
+        _movement_usb_msc_put16(entry + 22, _fat_time);
+        _movement_usb_msc_put16(entry + 24, _fat_date);
+        _movement_usb_msc_put16(entry + 26, file->first_cluster);
+        _movement_usb_msc_put32(entry + 28, file->size);
+        _movement_usb_msc_emit(sector, first_entry, &entry_index, entry);
+    }
+}
+
+static movement_usb_msc_file_t *_movement_usb_msc_file_at_cluster(uint16_t cluster) {
+    for (uint8_t i = 0; i < _num_files; i++) {
+        movement_usb_msc_file_t *file = &_files[i];
+        if (file->num_clusters && cluster >= file->first_cluster && cluster < file->first_cluster + file->num_clusters) return file;
+    }
+    return NULL;
+}
+
+// each file's clusters are consecutive, so its chain just counts up to the last one.
+static uint16_t _movement_usb_msc_fat_entry(uint16_t cluster) {
+    if (cluster == 0) return 0xFF8;
+    if (cluster == 1) return 0xFFF;
+    movement_usb_msc_file_t *file = _movement_usb_msc_file_at_cluster(cluster);
+    if (file == NULL) return 0;
+    if (cluster + 1 == file->first_cluster + file->num_clusters) return 0xFFF;
+    return cluster + 1;
+}
+
+static void _movement_usb_msc_read_fat(uint32_t sector_index, uint8_t *sector) {
+    // FAT12 packs two 12-bit entries into every three bytes.
+    for (uint32_t i = 0; i < MSC_SECTOR_SIZE; i++) {
+        uint32_t offset = sector_index * MSC_SECTOR_SIZE + i;
+        uint16_t cluster = offset / 3 * 2;
+        switch (offset % 3) {
+            case 0:
+                sector[i] = _movement_usb_msc_fat_entry(cluster) & 0xFF;
+                break;
+            case 1:
+                sector[i] = (_movement_usb_msc_fat_entry(cluster) >> 8) | ((_movement_usb_msc_fat_entry(cluster + 1) & 0x0F) << 4);
+                break;
+            default:
+                sector[i] = _movement_usb_msc_fat_entry(cluster + 1) >> 4;
+                break;
+        }
+    }
+}
+
+static void _movement_usb_msc_read_boot_sector(uint8_t *sector) {
+    static const uint8_t jump[] = {0xEB, 0x3C, 0x90};
+    memcpy(sector, jump, sizeof(jump));
+    memcpy(sector + 3, "MSWIN4.1", 8);
+    _movement_usb_msc_put16(sector + 11, MSC_SECTOR_SIZE);
+    sector[13] = MSC_SECTORS_PER_CLUSTER;
+    _movement_usb_msc_put16(sector + 14, MSC_FAT_START);
+    sector[16] = 2;
+    _movement_usb_msc_put16(sector + 17, MSC_ROOT_ENTRIES);
+    _movement_usb_msc_put16(sector + 19, MSC_TOTAL_SECTORS);
+    sector[21] = 0xF8;
+    _movement_usb_msc_put16(sector + 22, MSC_FAT_SECTORS);
+    _movement_usb_msc_put16(sector + 24, 1);
+    _movement_usb_msc_put16(sector + 26, 1);
+    sector[36] = 0x80;
+    sector[38] = 0x29;
+    _movement_usb_msc_put32(sector + 39, 0x53574D53);
+    memcpy(sector + 43, MSC_VOLUME_LABEL, 11);
+    memcpy(sector + 54, "FAT12   ", 8);
+    sector[510] = 0x55;
+    sector[511] = 0xAA;
+}
+
+// returns false if the data couldn't be read without getting in the main loop's way.
+static bool _movement_usb_msc_read_data(uint32_t sector_index, uint8_t *sector) {
+    uint16_t cluster = 2 + sector_index / MSC_SECTORS_PER_CLUSTER;
+    movement_usb_msc_file_t *file = _movement_usb_msc_file_at_cluster(cluster);
+    if (file == NULL) return true;
+
+    uint32_t offset = (uint32_t)(cluster - file->first_cluster) * MSC_CLUSTER_SIZE + (sector_index % MSC_SECTORS_PER_CLUSTER) * MSC_SECTOR_SIZE;
+    if (offset >= file->size) return true;
+    uint32_t length = file->size - offset;
+    if (length > MSC_SECTOR_SIZE) length = MSC_SECTOR_SIZE;
+
+    if (file->is_accel_log) return spi_flash_read_data_if_idle(offset, sector, length);
+
+    if (filesystem_is_busy()) return false;
+    // a file that's gone since the snapshot reads as zeroes until the host catches up.
+    filesystem_read_file_uncached(file->name, sector, offset, length);
+    return true;
+}
+
+void movement_usb_msc_init(void) {
+    spi_flash_init();
+    // the third byte of the JEDEC ID is log2 of the chip's capacity in bytes.
+    uint8_t jedec_id[3] = {0};
+    if (spi_flash_read_command(CMD_READ_JEDEC_ID, jedec_id, 3) && jedec_id[2] >= 16 && jedec_id[2] <= 24) {
+        _accel_log_size = 1UL << jedec_id[2];
+        if (_accel_log_size > MOVEMENT_USB_MSC_ACCEL_LOG_SIZE) _accel_log_size = MOVEMENT_USB_MSC_ACCEL_LOG_SIZE;
+    }
+    watch_release_peripheral(WATCH_PERIPHERAL_SPI);
+}
+
+// TinyUSB callbacks follow; they run in the USB task's interrupt.
+
+void tud_msc_inquiry_cb(uint8_t lun, uint8_t vendor_id[8], uint8_t product_id[16], uint8_t product_rev[4]) {
+    (void) lun;
+    memcpy(vendor_id, "Oddly   ", 8);
+    memcpy(product_id, "Sensor Watch    ", 16);
+    memcpy(product_rev, "1.0 ", 4);
+}
+
+bool tud_msc_test_unit_ready_cb(uint8_t lun) {
+    if (_has_snapshot && _generation == filesystem_get_generation()) return true;
+
+    if (filesystem_is_busy() || !_movement_usb_msc_take_snapshot()) {
+        // becoming ready; the host will ask again.
+        tud_msc_set_sense(lun, SCSI_SENSE_NOT_READY, 0x04, 0x01);
+        _has_snapshot = false;
+        return false;
+    }
+
+    // the files have changed since the host last looked, so it should read the tables again.
+    tud_msc_set_sense(lun, SCSI_SENSE_UNIT_ATTENTION, 0x28, 0x00);
+    return false;
+}
+
+void tud_msc_capacity_cb(uint8_t lun, uint32_t *block_count, uint16_t *block_size) {
+    (void) lun;
+    *block_count = MSC_TOTAL_SECTORS;
+    *block_size = MSC_SECTOR_SIZE;
+}
+
+bool tud_msc_start_stop_cb(uint8_t lun, uint8_t power_condition, bool start, bool load_eject) {
+    (void) lun;
+    (void) power_condition;
+    (void) start;
+    (void) load_eject;
+    return true;
+}
+
+bool tud_msc_is_writable_cb(uint8_t lun) {
+    (void) lun;
+    return false;
+}
+
+int32_t tud_msc_read10_cb(uint8_t lun, uint32_t lba, uint32_t offset, void *buffer, uint32_t bufsize) {
+    uint8_t *sector = buffer;
+    if (offset != 0 || bufsize != MSC_SECTOR_SIZE || lba >= MSC_TOTAL_SECTORS) {
+        tud_msc_set_sense(lun, SCSI_SENSE_ILLEGAL_REQUEST, 0x21, 0x00);
+        return -1;
+    }
+    if (!_has_snapshot && (filesystem_is_busy() || !_movement_usb_msc_take_snapshot())) {
+        tud_msc_set_sense(lun, SCSI_SENSE_NOT_READY, 0x04, 0x01);
+        return -1;
+    }
+
+    memset(sector, 0, MSC_SECTOR_SIZE);
+    if (lba == 0) {
+        _movement_usb_msc_read_boot_sector(sector);
+    } else if (lba < MSC_ROOT_START) {
+        _movement_usb_msc_read_fat((lba - MSC_FAT_START) % MSC_FAT_SECTORS, sector);
+    } else if (lba < MSC_DATA_START) {
+        _movement_usb_msc_read_root(lba - MSC_ROOT_START, sector);
+    } else if (!_movement_usb_msc_read_data(lba - MSC_DATA_START, sector)) {
+        tud_msc_set_sense(lun, SCSI_SENSE_NOT_READY, 0x04, 0x01);
+        return -1;
+    }
+
+    return MSC_SECTOR_SIZE;
+}
+
+int32_t tud_msc_write10_cb(uint8_t lun, uint32_t lba, uint32_t offset, uint8_t *buffer, uint32_t bufsize) {
+    (void) lba;
+    (void) offset;
+    (void) buffer;
+    (void) bufsize;
+    // write protected.
+    tud_msc_set_sense(lun, SCSI_SENSE_DATA_PROTECT, 0x27, 0x00);
+    return -1;
+}
+
+int32_t tud_msc_scsi_cb(uint8_t lun, uint8_t const scsi_cmd[16], void *buffer, uint16_t bufsize) {
+    (void) buffer;
+    (void) bufsize;
+
+    switch (scsi_cmd[0]) {
+        case SCSI_CMD_PREVENT_ALLOW_MEDIUM_REMOVAL:
+            // nothing to lock; the drive can go whenever the cable does.
+            return 0;
+        default:
+            tud_msc_set_sense(lun, SCSI_SENSE_ILLEGAL_REQUEST, 0x20, 0x00);
+            return -1;
+    }
+}
+
+#endif // MOVEMENT_USB_MSC
@@ -0,0 +1,56 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef MOVEMENT_USB_MSC_H_
+#define MOVEMENT_USB_MSC_H_
+
+/*
+ * USB mass storage view of the watch's files, for builds made with USB_MSC=1.
+ *
+ * The host sees a small read-only FAT12 drive. Nothing is stored in FAT form: the boot sector, the tables and the
+ * root directory are made up from a list of the files, sector by sector as the host reads them, and the files'
+ * clusters are read straight out of littlefs. If the board has SPI flash, its first 2 MB (where
+ * accelerometer_data_acquisition_face keeps its log) shows up first, as ACCEL.BIN, a raw image of the chip.
+ *
+ * TinyUSB calls in from the USB task's interrupt, which can land while the main loop is partway through a filesystem
+ * call or an SPI flash command. Rather than wait, which it can't do there, a read that would collide fails with a
+ * NOT READY sense, and the host retries it. The list of files is taken again, and the host told the medium changed,
+ * when it polls the drive after the filesystem has been written to.
+ */
+
+#include <stdint.h>
+
+/** @brief The most files from the filesystem that show up on the drive; any more are left off. */
+#define MOVEMENT_USB_MSC_MAX_FILES 24
+
+/** @brief The longest filename that shows up on the drive; files with longer names are left off. */
+#define MOVEMENT_USB_MSC_NAME_MAX 31
+
+/** @brief How much of the SPI flash shows up as ACCEL.BIN: the 8192 pages accelerometer_data_acquisition_face uses. */
+#define MOVEMENT_USB_MSC_ACCEL_LOG_SIZE (2UL * 1024 * 1024)
+
+/** @brief Looks for the SPI flash, while nothing else is using it. Movement calls this at boot when on USB. */
+void movement_usb_msc_init(void);
+
+#endif // MOVEMENT_USB_MSC_H_
@@ -37,7 +37,9 @@
 #endif
 
 #include "watch.h"
+#include "filesystem.h"
 #include "shell_cmd_list.h"
+#include "shell_rpc.h"
 
 extern shell_command_t g_shell_commands[];
 extern const size_t g_num_shell_commands;
@@ -52,6 +54,26 @@ static char s_buf[SHELL_BUF_SZ] = {0};
 static size_t s_buf_len = 0;
 // Pointer to the first invalid byte after the end of input.
 static char *const s_buf_end = s_buf + SHELL_BUF_SZ;
+// If set, lines go here instead of to the command parser.
+static bool (*s_line_handler)(char *line) = NULL;
+
+void shell_set_line_handler(bool (*handler)(char *line)) {
+    s_line_handler = handler;
+}
+
+// Passes a line to the line handler, returning true while it wants more.
+static bool prv_handle_line(void) {
+    s_buf[strcspn(s_buf, "\r\n")] = '\0';
+    // a CR LF line ending shows up as an extra, empty line; skip it.
+    if (s_buf[0] == '\0') {
+        return true;
+    }
+    if (!s_line_handler(s_buf)) {
+        s_line_handler = NULL;
+        return false;
+    }
+    return true;
+}
 
 static char *prv_skip_whitespace(char *c) {
     while (c >= s_buf && c < s_buf_end) {
@@ -92,6 +114,48 @@ static char *prv_skip_non_whitespace(char *c) {
     return NULL;
 }
 
+static int prv_compare_commands(const shell_command_t *a, const shell_command_t *b) {
+    return strcasecmp(a->name, b->name);
+}
+
+// Sorts the command table by name, the first time it's needed, so commands can be found by binary search. An
+// insertion sort is plenty for a table this size, and smaller than pulling in qsort.
+static void prv_sort_commands(void) {
+    static bool sorted = false;
+    if (sorted) {
+        return;
+    }
+    for (size_t i = 1; i < g_num_shell_commands; i++) {
+        shell_command_t command = g_shell_commands[i];
+        size_t j = i;
+        while (j > 0 && prv_compare_commands(&g_shell_commands[j - 1], &command) > 0) {
+            g_shell_commands[j] = g_shell_commands[j - 1];
+            j--;
+        }
+        g_shell_commands[j] = command;
+    }
+    sorted = true;
+}
+
+static const shell_command_t *prv_find_command(const char *name) {
+    prv_sort_commands();
+    size_t low = 0;
+    size_t high = g_num_shell_commands;
+    while (low < high) {
+        size_t mid = (low + high) / 2;
+        int order = strcasecmp(g_shell_commands[mid].name, name);
+        if (order == 0) {
+            return &g_shell_commands[mid];
+        }
+        if (order < 0) {
+            low = mid + 1;
+        } else {
+            high = mid;
+        }
+    }
+    return NULL;
+}
+
 static int prv_handle_command() {
     char *argv[SHELL_MAX_ARGS] = {0};
     int argc = 0;
@@ -125,32 +189,123 @@ static int prv_handle_command() {
         return -1;
     }
 
-    // Match against the command list
-    for (size_t i = 0; i < g_num_shell_commands; i++) {
-        if (!strcasecmp(g_shell_commands[i].name, argv[0])) {
-            // If argc isn't valid for this command, display its help instead.
-            if (((argc - 1) < g_shell_commands[i].min_args) ||
-                ((argc - 1) > g_shell_commands[i].max_args)) {
-                if (g_shell_commands[i].help != NULL) {
-                    printf(NEWLINE "%s" NEWLINE, g_shell_commands[i].help);
-                }
-                return -2;
-            }
-            // Call the command's callback
-            if (g_shell_commands[i].cb != NULL) {
-                printf(NEWLINE);
-                int ret = g_shell_commands[i].cb(argc, argv);
-                if (ret == -2) {
-                    printf(NEWLINE "%s" NEWLINE, g_shell_commands[i].help);
-                }
-                return ret;
-            }
+    const shell_command_t *command = prv_find_command(argv[0]);
+    if (command == NULL) {
+        return -1;
+    }
+    // If argc isn't valid for this command, display its help instead.
+    if (((argc - 1) < command->min_args) ||
+        ((argc - 1) > command->max_args)) {
+        if (command->help != NULL) {
+            printf(NEWLINE "%s" NEWLINE, command->help);
         }
+        return -2;
+    }
+    // Call the command's callback
+    if (command->cb != NULL) {
+        printf(NEWLINE);
+        int ret = command->cb(argc, argv);
+        if (ret == -2) {
+            printf(NEWLINE "%s" NEWLINE, command->help);
+        }
+        return ret;
     }
 
     return -1;
 }
 
+#if !__EMSCRIPTEN__
+typedef struct {
+    const char *prefix;
+    size_t prefix_len;
+    char match[SHELL_BUF_SZ];   // the longest common prefix of the matches so far
+    size_t match_len;
+    uint16_t count;
+    bool list;                  // print each match, rather than collect them
+} shell_completion_t;
+
+static void prv_add_completion(shell_completion_t *completion, const char *candidate) {
+    if (strncasecmp(candidate, completion->prefix, completion->prefix_len) != 0) {
+        return;
+    }
+    if (completion->list) {
+        printf("%s  ", candidate);
+        return;
+    }
+    if (completion->count++ == 0) {
+        completion->match_len = strlen(candidate);
+        if (completion->match_len >= SHELL_BUF_SZ) {
+            completion->match_len = SHELL_BUF_SZ - 1;
+        }
+        memcpy(completion->match, candidate, completion->match_len);
+        return;
+    }
+    size_t i = 0;
+    while (i < completion->match_len && tolower((int) candidate[i]) == tolower((int) completion->match[i])) {
+        i++;
+    }
+    completion->match_len = i;
+}
+
+static bool prv_add_file_completion(const char *filename, int32_t size, void *context) {
+    (void) size;
+    prv_add_completion((shell_completion_t *) context, filename);
+    return true;
+}
+
+static void prv_gather_completions(shell_completion_t *completion, bool is_command) {
+    if (is_command) {
+        for (size_t i = 0; i < g_num_shell_commands; i++) {
+            prv_add_completion(completion, g_shell_commands[i].name);
+        }
+    } else {
+        filesystem_list_files(prv_add_file_completion, completion);
+    }
+}
+
+// Completes the word before the cursor: the first is a command, the rest are filenames. Fills in as much as all the
+// matches have in common; if that's nothing, lists them.
+static void prv_complete(void) {
+    size_t start = s_buf_len;
+    while (start > 0 && !isspace((int) s_buf[start - 1])) {
+        start--;
+    }
+    bool is_command = true;
+    for (size_t i = 0; i < start; i++) {
+        if (!isspace((int) s_buf[i])) {
+            is_command = false;
+            break;
+        }
+    }
+
+    s_buf[s_buf_len] = '\0';
+    shell_completion_t completion = {
+        .prefix = &s_buf[start],
+        .prefix_len = s_buf_len - start,
+    };
+    prv_gather_completions(&completion, is_command);
+    if (completion.count == 0) {
+        return;
+    }
+
+    if (completion.match_len > completion.prefix_len) {
+        for (size_t i = completion.prefix_len; i < completion.match_len && s_buf_len < SHELL_BUF_SZ - 2; i++) {
+            s_buf[s_buf_len++] = completion.match[i];
+            putchar(completion.match[i]);
+        }
+        if (completion.count == 1 && s_buf_len < SHELL_BUF_SZ - 2) {
+            s_buf[s_buf_len++] = ' ';
+            putchar(' ');
+        }
+    } else if (completion.count > 1) {
+        printf(NEWLINE);
+        completion.list = true;
+        prv_gather_completions(&completion, is_command);
+        printf(NEWLINE SHELL_PROMPT "%.*s", (int) s_buf_len, s_buf);
+    }
+}
+#endif
+
 void shell_task(void) {
 #if __EMSCRIPTEN__
     // This is a terrible hack; ideally this should be handled deeper in the watch library.
@@ -169,7 +324,11 @@ void shell_task(void) {
     free(received_data);
     s_buf[s_buf_len++] = '\n';
     s_buf[s_buf_len++] = '\0';
-    prv_handle_command();
+    if (s_line_handler != NULL) {
+        (void) prv_handle_line();
+    } else {
+        prv_handle_command();
+    }
     EM_ASM({
         tx = "";
     });
@@ -190,6 +349,17 @@ void shell_task(void) {
             break;
         }
 
+        if (c == 0 || shell_rpc_is_receiving()) {
+            // No one types a NUL; it starts a binary request from a host tool (@see shell_rpc.h).
+            shell_rpc_receive(c);
+            continue;
+        }
+
+        if (c == '\t' && s_line_handler == NULL) {
+            prv_complete();
+            continue;
+        }
+
         if (c == '\b') {
             // Handle backspace character.
             // We need to emit a backspace, overwrite the character on the
@@ -199,7 +369,7 @@ void shell_task(void) {
                 s_buf_len--;
             }
             continue;
-        } else if (c != '\n' && c != '\r') {
+        } else if (c != '\n' && c != '\r' && s_line_handler == NULL) {
             // Print regular characters to the screen.
             putchar(c);
         }
@@ -207,11 +377,21 @@ void shell_task(void) {
         s_buf[s_buf_len] = c;
 
         if (c == '\n' || c == '\r') {
-            // Newline! Handle the command.
             s_buf[s_buf_len+1] = '\0';
-            (void) prv_handle_command();
             s_buf_len = 0;
-            printf(NEWLINE SHELL_PROMPT);
+            if (s_line_handler != NULL) {
+                // Data for a command in progress; only prompt again once it's done.
+                if (!prv_handle_line()) {
+                    printf(NEWLINE SHELL_PROMPT);
+                }
+                continue;
+            }
+            // Newline! Handle the command.
+            (void) prv_handle_command();
+            // A command that reads further input shows a prompt of its own.
+            if (s_line_handler == NULL) {
+                printf(NEWLINE SHELL_PROMPT);
+            }
             break;
         } else {
             s_buf_len++;
@@ -25,10 +25,20 @@
 #ifndef SHELL_H_
 #define SHELL_H_
 
+#include <stdbool.h>
+
 /** @brief Called periodically from the app loop to handle shell commands.
  *         When a full command is complete, parses and executes its matching
  *         callback.
  */
 void shell_task(void);
 
+/** @brief Sends the following lines of input to a handler instead of the command parser, and stops echoing them,
+ *         until the handler returns false. This lets a command (i.e. a file upload) read data that wouldn't fit
+ *         on one command line, one line at a time.
+ * @param handler Called with each line of input, without its line ending. Return true to keep receiving lines,
+ *                or false to go back to the command prompt.
+ */
+void shell_set_line_handler(bool (*handler)(char *line));
+
 #endif
@@ -27,14 +27,90 @@
 #include <stddef.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #include "filesystem.h"
+#include "movement.h"
+#include "movement_kv.h"
+#include "movement_sensors.h"
+#include "movement_freqcorr.h"
+#include "movement_activity.h"
+#include "movement_battery_life.h"
+#include "movement_modules.h"
+#include "movement_scratch.h"
+#include "shell.h"
+#include "spiflash.h"
+#include "accelerometer_data_acquisition_face.h"
 #include "watch.h"
+#if !__EMSCRIPTEN__
+#include <malloc.h>
+#endif
 
 static int help_cmd(int argc, char *argv[]);
 static int flash_cmd(int argc, char *argv[]);
 static int stress_cmd(int argc, char *argv[]);
+static int stats_cmd(int argc, char *argv[]);
+static int latency_cmd(int argc, char *argv[]);
+static int power_cmd(int argc, char *argv[]);
+static int clocks_cmd(int argc, char *argv[]);
+static int battery_cmd(int argc, char *argv[]);
+static int mem_cmd(int argc, char *argv[]);
+static int boot_cmd(int argc, char *argv[]);
+static int faces_cmd(int argc, char *argv[]);
+static int sensors_cmd(int argc, char *argv[]);
+static int rtc_cmd(int argc, char *argv[]);
+static int activity_cmd(int argc, char *argv[]);
+static int get_cmd(int argc, char *argv[]);
+static int put_cmd(int argc, char *argv[]);
+static int accel_cmd(int argc, char *argv[]);
+#if MOVEMENT_NUM_MODULE_SLOTS > 0
+static int module_cmd(int argc, char *argv[]);
+#endif
+static int clocks_cmd(int argc, char *argv[]) {
+    (void) argc;
+    (void) argv;
+
+    watch_clock_tree_t tree;
+    watch_get_clock_tree(&tree);
+    printf("profile %s\r\n", watch_get_clock_profile_name(watch_get_clock_profile()));
+    printf("osc16m %u MHz%s%s, dfll %s, xosc32k %s\r\n", tree.osc16m_mhz,
+            tree.osc16m_on_demand ? " on demand" : "", tree.osc16m_run_in_standby ? " in standby" : "",
+            tree.dfll_enabled ? "on" : "off", tree.xosc32k_enabled ? "on" : "off");
+    printf("gclk\tsource\tHz\tstandby\tchannels\r\n");
+    for (uint8_t i = 0; i < WATCH_CLOCK_NUM_GENERATORS; i++) {
+        if (!tree.generators[i].enabled) continue;
+        printf("%u\t%s\t%lu\t%s\t", i, watch_get_clock_source_name(tree.generators[i].source),
+                (unsigned long)tree.generators[i].frequency, tree.generators[i].run_in_standby ? "yes" : "no");
+        bool first = true;
+        for (uint8_t j = 0; j < WATCH_CLOCK_NUM_CHANNELS; j++) {
+            if (tree.channels[j] != i) continue;
+            const char *name = watch_get_clock_channel_name(j);
+            if (name) printf("%s%s", first ? "" : ", ", name);
+            else printf("%s%u", first ? "" : ", ", j);
+            first = false;
+        }
+        printf("\r\n");
+    }
+    // a channel on a generator that's off gets no clock, but still holds a claim someone forgot to let go of.
+    for (uint8_t j = 0; j < WATCH_CLOCK_NUM_CHANNELS; j++) {
+        uint8_t generator = tree.channels[j];
+        if (generator == WATCH_CLOCK_CHANNEL_OFF || generator >= WATCH_CLOCK_NUM_GENERATORS) continue;
+        if (tree.generators[generator].enabled) continue;
+        const char *name = watch_get_clock_channel_name(j);
+        printf("channel %s on gclk%u, which is off\r\n", name ? name : "?", generator);
+    }
+
+    return 0;
+}
 
+#if defined(MOVEMENT_INPUT_TRACE) && !__EMSCRIPTEN__
+static int trace_cmd(int argc, char *argv[]);
+#endif
+#if defined(MOVEMENT_PROFILER) && !__EMSCRIPTEN__
+static int prof_cmd(int argc, char *argv[]);
+#endif
+
+// in no particular order; the shell sorts this by name before its first lookup, and help lists it that way.
 shell_command_t g_shell_commands[] = {
     {
         .name = "?",
@@ -78,6 +154,15 @@ shell_command_t g_shell_commands[] = {
         .max_args = 0,
         .cb = filesystem_cmd_df,
     },
+#ifdef FILESYSTEM_WEAR_STATS
+    {
+        .name = "wear",
+        .help = "print how many times each storage row has been erased, and a projected lifetime",
+        .min_args = 0,
+        .max_args = 0,
+        .cb = filesystem_cmd_wear,
+    },
+#endif
     {
         .name = "rm",
         .help = "usage: rm [PATH]",
@@ -92,6 +177,36 @@ shell_command_t g_shell_commands[] = {
         .max_args = 3,
         .cb = filesystem_cmd_echo,
     },
+    {
+        .name = "get",
+        .help = "send a file as base64 lines; usage: get <PATH>",
+        .min_args = 1,
+        .max_args = 1,
+        .cb = get_cmd,
+    },
+    {
+        .name = "put",
+        .help = "receive a file as base64 lines; usage: put <PATH> <SIZE> <CRC32>",
+        .min_args = 3,
+        .max_args = 3,
+        .cb = put_cmd,
+    },
+    {
+        .name = "accel",
+        .help = "list the accelerometer log's sessions, or send one's pages raw; usage: accel [SESSION | all]",
+        .min_args = 0,
+        .max_args = 1,
+        .cb = accel_cmd,
+    },
+#if MOVEMENT_NUM_MODULE_SLOTS > 0
+    {
+        .name = "module",
+        .help = "list the module slots, or install or erase one's module; usage: module [install SLOT FILE | rm SLOT]",
+        .min_args = 0,
+        .max_args = 3,
+        .cb = module_cmd,
+    },
+#endif
     {
         .name = "stress",
         .help = "test CDC write; usage: stress [LEN] [DELAY_MS]",
@@ -99,6 +214,101 @@ shell_command_t g_shell_commands[] = {
         .max_args = 2,
         .cb = stress_cmd,
     },
+    {
+        .name = "stats",
+        .help = "print per-face energy use; usage: stats [reset]",
+        .min_args = 0,
+        .max_args = 1,
+        .cb = stats_cmd,
+    },
+    {
+        .name = "latency",
+        .help = "print per-face button-to-display latency, worst first; usage: latency [reset]",
+        .min_args = 0,
+        .max_args = 1,
+        .cb = latency_cmd,
+    },
+    {
+        .name = "power",
+        .help = "print claimed peripherals, the regulator mode and the RTC correction",
+        .min_args = 0,
+        .max_args = 0,
+        .cb = power_cmd,
+    },
+    {
+        .name = "clocks",
+        .help = "print the clock profile, and which oscillators and generators are running for what",
+        .min_args = 0,
+        .max_args = 0,
+        .cb = clocks_cmd,
+    },
+    {
+        .name = "battery",
+        .help = "print how long the battery should last, and where it goes",
+        .min_args = 0,
+        .max_args = 0,
+        .cb = battery_cmd,
+    },
+    {
+        .name = "mem",
+        .help = "print where the faces' contexts are kept, and stack and heap use",
+        .min_args = 0,
+        .max_args = 0,
+        .cb = mem_cmd,
+    },
+    {
+        .name = "boot",
+        .help = "print how long each step of starting up took",
+        .min_args = 0,
+        .max_args = 0,
+        .cb = boot_cmd,
+    },
+    {
+        .name = "faces",
+        .help = "print or set the faces MODE steps through; usage: faces [INDEX[,INDEX...]... | reset]",
+        .min_args = 0,
+        .max_args = 15,
+        .cb = faces_cmd,
+    },
+    {
+        .name = "sensors",
+        .help = "print the sensors found and the bus windows; usage: sensors [probe]",
+        .min_args = 0,
+        .max_args = 1,
+        .cb = sensors_cmd,
+    },
+    {
+        .name = "activity",
+        .help = "print what the activity classifier sees, or start or stop it; usage: activity [on | off]",
+        .min_args = 0,
+        .max_args = 1,
+        .cb = activity_cmd,
+    },
+    {
+        .name = "rtc",
+        .help = "print or set the local time; usage: rtc [YYYY-MM-DD HH:MM:SS]",
+        .min_args = 0,
+        .max_args = 2,
+        .cb = rtc_cmd,
+    },
+#if defined(MOVEMENT_INPUT_TRACE) && !__EMSCRIPTEN__
+    {
+        .name = "trace",
+        .help = "record inputs for the simulator; usage: trace {start,stop,dump}",
+        .min_args = 1,
+        .max_args = 1,
+        .cb = trace_cmd,
+    },
+#endif
+#if defined(MOVEMENT_PROFILER) && !__EMSCRIPTEN__
+    {
+        .name = "prof",
+        .help = "sample where the CPU's time goes; usage: prof [start [CYCLES] | stop | clear | trace]",
+        .min_args = 0,
+        .max_args = 2,
+        .cb = prof_cmd,
+    },
+#endif
 };
 
 const size_t g_num_shell_commands = sizeof(g_shell_commands) / sizeof(shell_command_t);
@@ -122,6 +332,9 @@ static int flash_cmd(int argc, char *argv[]) {
     (void) argc;
     (void) argv;
 
+    movement_kv_flush();
+    // let the prompt's last words reach the host before USB goes away.
+    cdc_flush(100);
     watch_reset_to_bootloader();
     return 0;
 }
@@ -146,6 +359,7 @@ static int stress_cmd(int argc, char *argv[]) {
         delay = atoi(argv[2]);
     }
 
+    cdc_reset_write_stats();
     for (int i = 0; i < max_len; i++) {
         snprintf(&test_str[i], 2, "%u", (i+1)%10);
         printf("%u:\t%s\r\n", (i+1), test_str);
@@ -153,7 +367,654 @@ static int stress_cmd(int argc, char *argv[]) {
             delay_ms(delay);
         }
     }
+    printf("high water %u bytes, dropped %lu bytes\r\n", (unsigned)cdc_get_write_buffer_high_water_mark(), (unsigned long)cdc_get_dropped_byte_count());
+
+    return 0;
+}
+
+static int stats_cmd(int argc, char *argv[]) {
+    if (argc == 2) {
+        if (strcmp(argv[1], "reset") != 0) return -2;
+        movement_reset_face_stats();
+        return 0;
+    }
+
+    printf("face\tloops\tcycles\tbg cycles\tled ms\tbuzzer ms\r\n");
+    const movement_face_stats_t *stats;
+    for (uint8_t i = 0; (stats = movement_get_face_stats(i)) != NULL; i++) {
+        printf("%u\t%lu\t%lu\t%lu\t%lu\t%lu\r\n", i,
+                (unsigned long)stats->loop_calls,
+                (unsigned long)stats->active_cycles,
+                (unsigned long)stats->background_cycles,
+                (unsigned long)stats->led_ticks * 1000 / 128,
+                (unsigned long)stats->buzzer_ticks * 1000 / 64
+        );
+    }
+    printf("event queue overflows: %lu\r\n", (unsigned long)movement_get_event_queue_overflows());
+
+    return 0;
+}
+
+static int latency_cmd(int argc, char *argv[]) {
+    if (argc == 2) {
+        if (strcmp(argv[1], "reset") != 0) return -2;
+        movement_reset_face_stats();
+        return 0;
+    }
+
+    printf("face\tworst ms");
+    for (uint8_t b = 0; b < MOVEMENT_LATENCY_BUCKETS - 1; b++) printf("\t<%u", movement_latency_limits[b]);
+    printf("\tmore\r\n");
+
+    // the faces that have timed a press, worst first: each pass finds the worst that hasn't been printed yet.
+    int32_t last_worst = INT32_MAX;
+    int16_t last_face = -1;
+    while (true) {
+        const movement_latency_stats_t *stats, *next = NULL;
+        int16_t next_face = -1;
+        for (uint8_t i = 0; (stats = movement_get_latency_stats(i)) != NULL; i++) {
+            if (stats->worst > last_worst || (stats->worst == last_worst && i <= last_face)) continue;
+            if (next != NULL && stats->worst <= next->worst) continue;
+            uint32_t presses = 0;
+            for (uint8_t b = 0; b < MOVEMENT_LATENCY_BUCKETS; b++) presses += stats->counts[b];
+            if (!presses) continue;
+            next = stats;
+            next_face = i;
+        }
+        if (next == NULL) break;
+        printf("%d\t%u.%u", next_face, next->worst / 10, next->worst % 10);
+        for (uint8_t b = 0; b < MOVEMENT_LATENCY_BUCKETS; b++) printf("\t%u", next->counts[b]);
+        printf("\r\n");
+        last_worst = next->worst;
+        last_face = next_face;
+    }
+
+    return 0;
+}
+
+// prints a day's use in µA·s as the average current it comes to, and its share of total.
+static void _battery_print_use(const char *name, uint8_t index, uint32_t use, uint32_t total) {
+    uint32_t tenths = (uint64_t)use * 10 / 86400;
+    printf("%s", name);
+    if (index != UINT8_MAX) printf(" %u", index);
+    printf("\t%lu.%lu\t%lu\r\n", (unsigned long)tenths / 10, (unsigned long)tenths % 10,
+           (unsigned long)(total ? (uint64_t)use * 100 / total : 0));
+}
+
+static int battery_cmd(int argc, char *argv[]) {
+    (void) argc;
+    (void) argv;
+    static const char *const uses[MOVEMENT_BATTERY_NUM_USES] = { "standby", "faces", "led", "buzzer", "sensors", "usb" };
+    const movement_battery_life_t *estimate = movement_battery_life_get();
+
+    if (estimate->days == 0) {
+        printf("no estimate until the first day is over\r\n");
+        return 0;
+    }
+    printf("%u mV, %u%% left, falling %d mV a week\r\n", estimate->voltage, estimate->percent_left, estimate->mv_per_week);
+    printf("%u days left at the rate of use", estimate->days_left);
+    if (estimate->trend_days_left != UINT16_MAX) printf(", %u at the rate the voltage falls", estimate->trend_days_left);
+    printf(" (%u days of accounting)\r\n", estimate->days);
+
+    uint32_t total = 0;
+    for (uint8_t i = 0; i < MOVEMENT_BATTERY_NUM_USES; i++) total += estimate->daily_use[i];
+    printf("use\tuA\t%%\r\n");
+    for (uint8_t i = 0; i < MOVEMENT_BATTERY_NUM_USES; i++) _battery_print_use(uses[i], UINT8_MAX, estimate->daily_use[i], total);
+    for (uint8_t i = 0; movement_get_face_stats(i) != NULL; i++) {
+        uint32_t use = movement_battery_life_get_face_use(i);
+        if (use) _battery_print_use("face", i, use, total);
+    }
+
+    return 0;
+}
+
+static int mem_cmd(int argc, char *argv[]) {
+    (void) argc;
+    (void) argv;
+
+    const movement_context_stats_t *stats = movement_get_context_stats();
+    printf("context arena: %u of %u bytes\r\n", stats->arena_used, stats->arena_size);
+    printf("contexts on the heap: %u, %u bytes\r\n", stats->heap_contexts, stats->heap_context_bytes);
+    printf("hibernating faces: %u, sharing %u bytes\r\n", stats->hibernating_faces, stats->hibernation_slot_size);
+    printf("scratch: high water %u of %u bytes\r\n", (unsigned)movement_scratch_get_high_water(), MOVEMENT_SCRATCH_SIZE);
+#if !__EMSCRIPTEN__
+    struct mallinfo info = mallinfo();
+    printf("heap: %u bytes in use, high water %u of %u bytes\r\n", (unsigned)info.uordblks,
+           (unsigned)watch_get_heap_high_water(), (unsigned)watch_get_heap_size());
+    printf("stack: high water %u of %u bytes\r\n", (unsigned)watch_get_stack_high_water(),
+           (unsigned)watch_get_stack_size());
+#endif
+
+    return 0;
+}
+
+static int boot_cmd(int argc, char *argv[]) {
+    (void) argc;
+    (void) argv;
+
+    static const char *const phases[MOVEMENT_NUM_BOOT_PHASES] = {
+        "app_init", "storage", "app_setup", "face activated", "first screen", "ready",
+    };
+    uint8_t count;
+    const uint32_t *times = movement_get_boot_times(&count);
+    uint32_t previous = 0;
+    printf("step\t\tat ms\ttook ms\r\n");
+    for (uint8_t i = 0; i < count; i++) {
+        // in hundredths of a millisecond, which is about all the resolution there is.
+        uint32_t at = (uint32_t)((uint64_t)times[i] * 100000 / WATCH_BOOT_TICKS_PER_SECOND);
+        uint32_t took = at - previous;
+        printf("%-15s\t%lu.%02lu\t%lu.%02lu\r\n", phases[i], (unsigned long)(at / 100), (unsigned long)(at % 100),
+                (unsigned long)(took / 100), (unsigned long)(took % 100));
+        previous = at;
+    }
+
+    return 0;
+}
+
+static int faces_cmd(int argc, char *argv[]) {
+    uint8_t count;
+    const uint8_t *order;
+
+    if (argc == 2 && strcmp(argv[1], "reset") == 0) {
+        movement_set_face_order(NULL, 0);
+    } else if (argc > 1) {
+        // indexes may be given as separate arguments or as one list separated by commas, for sets of many faces.
+        uint8_t faces[MOVEMENT_KV_VALUE_MAX];
+        count = 0;
+        for (int i = 1; i < argc; i++) {
+            for (char *index = strtok(argv[i], ","); index != NULL; index = strtok(NULL, ",")) {
+                char *end;
+                long face = strtol(index, &end, 10);
+                if (*end != '\0' || face < 0 || face > 255 || count == sizeof(faces)) return -2;
+                faces[count++] = face;
+            }
+        }
+        if (!movement_set_face_order(faces, count)) {
+            printf("no such face, or one given twice\r\n");
+            return -1;
+        }
+    }
+
+    order = movement_get_face_order(&count);
+    printf("order:");
+    for (uint8_t i = 0; i < count; i++) printf(" %u", order[i]);
+    printf("\r\nleft out:");
+    for (uint8_t face = 0; movement_get_face_stats(face) != NULL; face++) {
+        bool in_order = false;
+        for (uint8_t i = 0; i < count; i++) in_order = in_order || order[i] == face;
+        if (!in_order) printf(" %u", face);
+    }
+    printf("\r\n");
+
+    return 0;
+}
+
+static int sensors_cmd(int argc, char *argv[]) {
+    static const char *names[MOVEMENT_NUM_SENSOR_DEVICES] = {"lis2dw", "opt3001", "thermistor", "vcc"};
+
+    if (argc == 2) {
+        if (strcmp(argv[1], "probe") != 0) return -2;
+        movement_sensors_probe();
+    }
+
+    uint8_t devices = movement_sensors_get_devices();
+    printf("found:");
+    for (uint8_t i = 0; i < MOVEMENT_NUM_SENSOR_DEVICES; i++) {
+        if (devices & (1 << i)) printf(" %s", names[i]);
+    }
+    movement_sensors_report_t report;
+    movement_sensors_get_report(&report);
+    printf("\r\nwindows: %lu, with the bus on: %lu, samples: %lu\r\n", (unsigned long)report.windows,
+            (unsigned long)report.bus_windows, (unsigned long)report.samples);
+
+    return 0;
+}
+
+static int activity_cmd(int argc, char *argv[]) {
+    static const char *names[MOVEMENT_NUM_ACTIVITIES] = {"unknown", "idle", "walking", "sleeping", "off wrist"};
+
+    if (argc == 2) {
+        if (strcmp(argv[1], "on") == 0) movement_activity_enable();
+        else if (strcmp(argv[1], "off") == 0) movement_activity_disable();
+        else return -2;
+    }
+
+    if (!movement_activity_is_enabled()) {
+        printf("off\r\n");
+        return 0;
+    }
+    printf("%s\r\n", names[movement_activity_get()]);
+    movement_activity_features_t features;
+    if (movement_activity_get_features(&features)) {
+        printf("mean %u, variance %lu, crossings %u, still for %u windows\r\n", features.mean,
+                (unsigned long)features.variance, features.crossings, features.still_windows);
+    }
+
+    return 0;
+}
+
+static int rtc_cmd(int argc, char *argv[]) {
+    if (argc == 3) {
+        unsigned int year, month, day, hour, minute, second;
+        if (sscanf(argv[1], "%u-%u-%u", &year, &month, &day) != 3 ||
+            sscanf(argv[2], "%u:%u:%u", &hour, &minute, &second) != 3) return -2;
+        if (year < WATCH_RTC_REFERENCE_YEAR || year > WATCH_RTC_REFERENCE_YEAR + 63 || month < 1 || month > 12 ||
+            day < 1 || day > 31 || hour > 23 || minute > 59 || second > 59) return -2;
+        watch_date_time date_time = {0};
+        date_time.unit.year = year - WATCH_RTC_REFERENCE_YEAR;
+        date_time.unit.month = month;
+        date_time.unit.day = day;
+        date_time.unit.hour = hour;
+        date_time.unit.minute = minute;
+        date_time.unit.second = second;
+        // stopping the RTC while setting it starts the second over as the command arrives, as set_time_hackwatch_face
+        // does at the press of a button; for better than that, see SHELL_RPC_RTC_SET.
+        watch_rtc_enable(false);
+        movement_set_local_date_time(date_time);
+        watch_rtc_enable(true);
+    } else if (argc != 1) {
+        return -2;
+    }
+
+    watch_date_time now = watch_rtc_get_date_time();
+    printf("%04u-%02u-%02u %02u:%02u:%02u\r\n", now.unit.year + WATCH_RTC_REFERENCE_YEAR, now.unit.month, now.unit.day,
+            now.unit.hour, now.unit.minute, now.unit.second);
+
+    return 0;
+}
+
+static int power_cmd(int argc, char *argv[]) {
+    (void) argc;
+    (void) argv;
+
+    printf("periph\tclaims\tpowered\r\n");
+    for (uint8_t i = 0; i < WATCH_NUM_PERIPHERALS; i++) {
+        printf("%s\t%u\t%s\r\n", watch_get_peripheral_name((watch_peripheral_t)i),
+                watch_get_peripheral_claims((watch_peripheral_t)i),
+                watch_is_peripheral_powered((watch_peripheral_t)i) ? "yes" : "no");
+    }
+    printf("regulator %s, PL%u, vcc %u mV\r\n", watch_get_regulator() == WATCH_REGULATOR_BUCK ? "buck" : "ldo",
+            watch_get_performance_level_number(), watch_get_regulator_vcc());
+    if (movement_freqcorr_is_configured()) {
+        movement_freqcorr_report_t report;
+        movement_freqcorr_get_report(&report);
+        printf("freqcorr %d, every %u s, %lu corrections\r\n", report.freqcorr, report.interval,
+                (unsigned long)report.corrections);
+    }
+
+    return 0;
+}
+
+#if defined(MOVEMENT_INPUT_TRACE) && !__EMSCRIPTEN__
+static int trace_cmd(int argc, char *argv[]) {
+    (void) argc;
+
+    if (strcmp(argv[1], "start") == 0) {
+        watch_input_trace_start();
+    } else if (strcmp(argv[1], "stop") == 0) {
+        watch_input_trace_stop();
+    } else if (strcmp(argv[1], "dump") == 0) {
+        watch_input_trace_print();
+    } else {
+        return -2;
+    }
+
+    return 0;
+}
+#endif
+
+#if defined(MOVEMENT_PROFILER) && !__EMSCRIPTEN__
+static int prof_cmd(int argc, char *argv[]) {
+    if (argc == 1) {
+        watch_profiler_print();
+    } else if (strcmp(argv[1], "start") == 0) {
+        uint32_t period = WATCH_PROFILER_DEFAULT_PERIOD;
+        if (argc == 3) {
+            char *end;
+            period = strtoul(argv[2], &end, 10);
+            if (*end != '\0' || period < 256 || period > 0xFFFFFF) return -2;
+        }
+        watch_profiler_start(period);
+    } else if (argc == 3) {
+        return -2;
+    } else if (strcmp(argv[1], "stop") == 0) {
+        watch_profiler_stop();
+    } else if (strcmp(argv[1], "clear") == 0) {
+        watch_profiler_clear();
+    } else if (strcmp(argv[1], "trace") == 0) {
+        watch_profiler_trace_print();
+    } else {
+        return -2;
+    }
 
     return 0;
 }
+#endif
+
+// File transfers move a file as lines of base64, TRANSFER_CHUNK_SIZE bytes to a line, with a CRC-32 (the same one
+// zlib and Python's binascii use) over the whole file. get streams them out as fast as the host reads them; put sends
+// "OK" after each line so that the host never has more than one line in flight. utils/sensorwatch_transfer.py is the
+// other end of this.
+#define TRANSFER_CHUNK_SIZE (48)
+#define TRANSFER_LINE_SIZE (TRANSFER_CHUNK_SIZE / 3 * 4)
+#define TRANSFER_WRITE_BUF_SIZE (TRANSFER_CHUNK_SIZE * 4)
+#define TRANSFER_PATH_MAX (31)
+#define TRANSFER_TIMEOUT_MS (2000)
+
+typedef struct {
+    char path[TRANSFER_PATH_MAX + 1];
+    int32_t remaining;
+    uint32_t expected_crc;
+    uint32_t crc;
+    uint16_t buffered;
+    uint8_t buffer[TRANSFER_WRITE_BUF_SIZE];
+} transfer_put_state_t;
+
+static transfer_put_state_t *put_state = NULL;
+
+static const char base64_chars[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+
+static void _base64_encode(const uint8_t *data, size_t length, char *out) {
+    for (size_t i = 0; i < length; i += 3) {
+        uint32_t triple = (uint32_t)data[i] << 16;
+        if (i + 1 < length) triple |= (uint32_t)data[i + 1] << 8;
+        if (i + 2 < length) triple |= data[i + 2];
+        *out++ = base64_chars[(triple >> 18) & 0x3F];
+        *out++ = base64_chars[(triple >> 12) & 0x3F];
+        *out++ = (i + 1 < length) ? base64_chars[(triple >> 6) & 0x3F] : '=';
+        *out++ = (i + 2 < length) ? base64_chars[triple & 0x3F] : '=';
+    }
+    *out = '\0';
+}
+
+static int8_t _base64_value(char c) {
+    const char *found = (c == '\0') ? NULL : strchr(base64_chars, c);
+    return (found == NULL) ? -1 : (int8_t)(found - base64_chars);
+}
+
+// returns the number of bytes decoded, or -1 if the line isn't valid base64 or won't fit.
+static int32_t _base64_decode(const char *in, uint8_t *out, size_t max_length) {
+    size_t length = strlen(in);
+    if (length % 4) return -1;
+
+    uint8_t padding = 0;
+    if (length && in[length - 1] == '=') padding++;
+    if (length > 1 && in[length - 2] == '=') padding++;
+
+    size_t decoded = 0;
+    for (size_t i = 0; i < length; i += 4) {
+        bool is_last = (i + 4 == length);
+        uint32_t triple = 0;
+        for (uint8_t j = 0; j < 4; j++) {
+            int8_t value = (is_last && j >= 4 - padding) ? 0 : _base64_value(in[i + j]);
+            if (value < 0) return -1;
+            triple = (triple << 6) | value;
+        }
+        uint8_t bytes = is_last ? 3 - padding : 3;
+        if (decoded + bytes > max_length) return -1;
+        out[decoded++] = triple >> 16;
+        if (bytes > 1) out[decoded++] = triple >> 8;
+        if (bytes > 2) out[decoded++] = triple;
+    }
 
+    return decoded;
+}
+
+// get prints faster than USB can carry it, so wait for room rather than overwrite output the host hasn't read yet.
+static bool _transfer_wait_for_write_space(size_t length) {
+    for (uint16_t waited = 0; cdc_get_write_buffer_space() < length; waited++) {
+        if (waited >= TRANSFER_TIMEOUT_MS) return false;
+        delay_ms(1);
+    }
+    return true;
+}
+
+static int get_cmd(int argc, char *argv[]) {
+    (void) argc;
+
+    int32_t size = filesystem_get_file_size(argv[1]);
+    if (size < 0) {
+        printf("ERROR no such file\r\n");
+        return -1;
+    }
+
+    printf("BEGIN %ld\r\n", size);
+    uint8_t chunk[TRANSFER_CHUNK_SIZE];
+    char line[TRANSFER_LINE_SIZE + 1];
+    uint32_t crc = 0;
+    for (int32_t offset = 0; offset < size; offset += TRANSFER_CHUNK_SIZE) {
+        int32_t length = min(TRANSFER_CHUNK_SIZE, size - offset);
+        if (!filesystem_read_file_at(argv[1], (char *)chunk, offset, length)) {
+            printf("ERROR read failed\r\n");
+            return -1;
+        }
+        crc = watch_crc32_update(crc, chunk, length);
+        _base64_encode(chunk, length, line);
+        // if the host has stopped reading, there's no one to tell.
+        if (!_transfer_wait_for_write_space(TRANSFER_LINE_SIZE + 2)) return -1;
+        printf("%s\r\n", line);
+    }
+    printf("END %08lx\r\n", (unsigned long)crc);
+
+    return 0;
+}
+
+static bool _put_flush(void) {
+    if (put_state->buffered == 0) return true;
+    bool success = filesystem_append_file(put_state->path, (char *)put_state->buffer, put_state->buffered);
+    put_state->buffered = 0;
+    return success;
+}
+
+static bool _put_finish(const char *error) {
+    if (error == NULL && !_put_flush()) error = "write failed";
+    if (error == NULL && put_state->crc != put_state->expected_crc) error = "crc mismatch";
+
+    if (error == NULL) {
+        printf("DONE\r\n");
+    } else {
+        // don't leave half a file (or a corrupt one) behind.
+        filesystem_rm(put_state->path);
+        printf("ERROR %s\r\n", error);
+    }
+
+    free(put_state);
+    put_state = NULL;
+    return false;
+}
+
+static bool _put_line(char *line) {
+    if (strcmp(line, "abort") == 0) return _put_finish("aborted");
+
+    uint8_t chunk[TRANSFER_CHUNK_SIZE];
+    int32_t length = _base64_decode(line, chunk, sizeof(chunk));
+    if (length < 0 || length > put_state->remaining) return _put_finish("bad data");
+
+    put_state->crc = watch_crc32_update(put_state->crc, chunk, length);
+    memcpy(put_state->buffer + put_state->buffered, chunk, length);
+    put_state->buffered += length;
+    put_state->remaining -= length;
+
+    // batch lines up into larger appends; each one is a metadata commit on the filesystem.
+    if (put_state->buffered > TRANSFER_WRITE_BUF_SIZE - TRANSFER_CHUNK_SIZE && !_put_flush()) {
+        return _put_finish("write failed");
+    }
+
+    if (put_state->remaining == 0) return _put_finish(NULL);
+
+    printf("OK\r\n");
+    return true;
+}
+
+static int put_cmd(int argc, char *argv[]) {
+    (void) argc;
+
+    int32_t size = atoi(argv[2]);
+    if (size < 0) return -2;
+    if (strlen(argv[1]) > TRANSFER_PATH_MAX) {
+        printf("ERROR path too long\r\n");
+        return -1;
+    }
+    if (size > filesystem_get_free_space()) {
+        printf("ERROR not enough space\r\n");
+        return -1;
+    }
+
+    if (put_state == NULL) put_state = malloc(sizeof(transfer_put_state_t));
+    if (put_state == NULL) {
+        printf("ERROR out of memory\r\n");
+        return -1;
+    }
+    memset(put_state, 0, sizeof(transfer_put_state_t));
+    strcpy(put_state->path, argv[1]);
+    put_state->remaining = size;
+    put_state->expected_crc = strtoul(argv[3], NULL, 16);
+
+    if (!filesystem_write_file(put_state->path, "", 0)) {
+        (void) _put_finish("write failed");
+        return -1;
+    }
+
+    if (size == 0) {
+        (void) _put_finish(NULL);
+        return 0;
+    }
+
+    shell_set_line_handler(_put_line);
+    printf("READY\r\n");
+
+    return 0;
+}
+
+// accel sends the accelerometer log (@see accelerometer_data_acquisition_face.h) as it lies in flash. The chip starts
+// with a bitmap in which a page's bit is cleared once the page is written; pages are written in order, so a session is
+// the run of pages from one that starts a session to the next. Pages go out as they are, with no base64 or hex:
+// "BEGIN <SIZE>", that many bytes, then "END <CRC32>" like get's, so a dump moves as fast as USB takes it.
+#define ACCEL_LOG_PAGES (8192)
+#define ACCEL_LOG_BITMAP_PAGES (4)
+
+// the number of pages written so far, bitmap included.
+static uint16_t _accel_pages_written(void) {
+    uint16_t page = 0;
+    uint8_t used_byte = 0;
+    while (page < ACCEL_LOG_PAGES) {
+        if (!spi_flash_read_cached(page / 8, &used_byte, 1)) return 0;
+        if (used_byte) return page + __builtin_clz((uint32_t)used_byte << 24);
+        page += 8;
+    }
+    return page;
+}
+
+static bool _accel_page_starts_session(uint16_t page) {
+    uint8_t header[sizeof(accelerometer_data_acquisition_page_header_t)];
+    if (!spi_flash_read_cached(page * SPI_FLASH_PAGE_SIZE, header, sizeof(header))) return false;
+    if (header[0] == ACCELEROMETER_DATA_ACQUISITION_V2_MAGIC_0 && header[1] == ACCELEROMETER_DATA_ACQUISITION_V2_MAGIC_1 &&
+        header[2] == ACCELEROMETER_DATA_ACQUISITION_V2_MAGIC_2) {
+        return ((accelerometer_data_acquisition_page_header_t *)header)->flags & ACCELEROMETER_DATA_ACQUISITION_V2_FLAG_SESSION_START;
+    }
+    // a version 1 page is 32 records, the record type in the low bits of each.
+    return (header[0] & 0b11) == ACCELEROMETER_DATA_ACQUISITION_HEADER;
+}
+
+static int _accel_send_pages(uint16_t first, uint16_t count) {
+    uint8_t *page = movement_scratch_borrow(SPI_FLASH_PAGE_SIZE);
+    if (page == NULL) {
+        printf("ERROR no scratch\r\n");
+        return -1;
+    }
+    uint32_t crc = 0;
+    int result = 0;
+
+    printf("BEGIN %lu\r\n", (unsigned long)count * SPI_FLASH_PAGE_SIZE);
+    for (uint16_t i = first; i < first + count; i++) {
+        if (!spi_flash_read_cached(i * SPI_FLASH_PAGE_SIZE, page, SPI_FLASH_PAGE_SIZE)) {
+            printf("\r\nERROR read failed\r\n");
+            result = -1;
+            break;
+        }
+        crc = watch_crc32_update(crc, page, SPI_FLASH_PAGE_SIZE);
+        if (!_transfer_wait_for_write_space(SPI_FLASH_PAGE_SIZE)) {
+            result = -1;
+            break;
+        }
+        // flushed page by page, so that stdio never hands the CDC buffer more than there was room for.
+        fwrite(page, 1, SPI_FLASH_PAGE_SIZE, stdout);
+        fflush(stdout);
+    }
+    movement_scratch_release(page);
+    if (result == 0) printf("END %08lx\r\n", (unsigned long)crc);
+
+    return result;
+}
+
+static int accel_cmd(int argc, char *argv[]) {
+    int result = 0;
+
+    spi_flash_init();
+    spi_flash_wait_until_ready();
+    uint16_t written = _accel_pages_written();
+
+    if (argc == 2 && !strcmp(argv[1], "all")) {
+        // the whole log, bitmap and unwritten pages too: the same image as ACCEL.BIN over USB mass storage.
+        result = _accel_send_pages(0, ACCEL_LOG_PAGES);
+    } else {
+        int32_t wanted = argc == 2 ? atoi(argv[1]) : -1;
+        bool found = false;
+        if (argc == 1) printf("session first_page pages\r\n");
+        uint16_t first = ACCEL_LOG_BITMAP_PAGES;
+        for (int32_t session = 0; first < written; session++) {
+            uint16_t end = first + 1;
+            while (end < written && !_accel_page_starts_session(end)) end++;
+            if (argc == 1) {
+                printf("%ld %u %u\r\n", session, first, end - first);
+            } else if (session == wanted) {
+                result = _accel_send_pages(first, end - first);
+                found = true;
+                break;
+            }
+            first = end;
+        }
+        if (argc == 1) {
+            printf("%u of %u pages free\r\n", ACCEL_LOG_PAGES - written, ACCEL_LOG_PAGES);
+        } else if (!found) {
+            printf("ERROR no such session\r\n");
+            result = -1;
+        }
+    }
+
+    watch_release_peripheral(WATCH_PERIPHERAL_SPI);
+    return result;
+}
+
+#if MOVEMENT_NUM_MODULE_SLOTS > 0
+static int module_cmd(int argc, char *argv[]) {
+    if (argc == 1) {
+        printf("slot address module\r\n");
+        for (uint8_t slot = 0; slot < MOVEMENT_NUM_MODULE_SLOTS; slot++) {
+            const void *address = movement_module_slot_address(slot);
+            const movement_module_header_t *module = movement_module_get(slot);
+            if (address == NULL) printf("%u - not in main flash\r\n", slot);
+            else if (module == NULL) printf("%u 0x%08lx -\r\n", slot, (unsigned long)address);
+            else printf("%u 0x%08lx %.8s, %lu bytes\r\n", slot, (unsigned long)address, module->name, (unsigned long)module->size);
+        }
+        return 0;
+    }
+
+    uint8_t slot = argc >= 3 ? atoi(argv[2]) : 0;
+    if (argc == 4 && !strcmp(argv[1], "install")) {
+        int result = movement_module_install(slot, argv[3]);
+        if (result == -1) printf("ERROR slot %u isn't there, or its face is on screen\r\n", slot);
+        else if (result == -2) printf("ERROR %s isn't a module built for slot %u\r\n", argv[3], slot);
+        else if (result < 0) printf("ERROR couldn't write slot %u\r\n", slot);
+        else printf("installed; it runs once the watch restarts\r\n");
+        return result;
+    }
+    if (argc == 3 && !strcmp(argv[1], "rm")) {
+        if (movement_module_remove(slot)) return 0;
+        printf("ERROR slot %u isn't there, or its face is on screen\r\n", slot);
+        return -1;
+    }
+    printf("usage: module [install SLOT FILE | rm SLOT]\r\n");
+    return -1;
+}
+#endif
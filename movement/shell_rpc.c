@@ -0,0 +1,383 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "shell_rpc.h"
+#include "filesystem.h"
+#include "movement.h"
+#include "movement_kv.h"
+#include "movement_update.h"
+#include "watch.h"
+
+#define SHELL_RPC_PATH_MAX (31)
+// sequence number and opcode, the longest arguments (a write's), and the CRC.
+#define SHELL_RPC_MAX_PAYLOAD (2 + 5 + SHELL_RPC_PATH_MAX + SHELL_RPC_MAX_DATA + 2)
+// COBS adds a byte per 254, and one more.
+#define SHELL_RPC_MAX_FRAME (SHELL_RPC_MAX_PAYLOAD + SHELL_RPC_MAX_PAYLOAD / 254 + 1)
+
+typedef struct {
+    uint16_t length;
+    bool overflow;
+    uint8_t frame[SHELL_RPC_MAX_FRAME];
+    uint8_t response[SHELL_RPC_MAX_PAYLOAD];
+    uint8_t encoded[SHELL_RPC_MAX_FRAME + 2];
+} shell_rpc_state_t;
+
+static shell_rpc_state_t *_state = NULL;
+static bool _receiving = false;
+// set by a request to start the RTC once its response is away (@see SHELL_RPC_RTC_SET).
+static bool _start_rtc_on_trigger = false;
+// set by a request to install a firmware update once its response is away.
+static bool _install_update = false;
+
+static uint16_t _shell_rpc_crc(const uint8_t *data, uint16_t length) {
+    // CRC-16/CCITT, like the snapshot's in movement_backup.c.
+    uint16_t crc = 0xFFFF;
+    for (uint16_t i = 0; i < length; i++) {
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t bit = 0; bit < 8; bit++) crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+    }
+    return crc;
+}
+
+// decodes in place, which works because the output never gets ahead of the input. returns -1 for a bad frame.
+static int32_t _shell_rpc_cobs_decode(uint8_t *data, uint16_t length) {
+    uint16_t read = 0;
+    uint16_t write = 0;
+    while (read < length) {
+        uint8_t code = data[read++];
+        if (code == 0 || read + code - 1 > length) return -1;
+        for (uint8_t i = 1; i < code; i++) data[write++] = data[read++];
+        // each block but a full one stood for a 0, except at the very end.
+        if (code < 0xFF && read < length) data[write++] = 0;
+    }
+    return write;
+}
+
+static uint16_t _shell_rpc_cobs_encode(const uint8_t *data, uint16_t length, uint8_t *out) {
+    uint16_t code_index = 0;
+    uint16_t write = 1;
+    uint8_t code = 1;
+    for (uint16_t i = 0; i < length; i++) {
+        if (data[i] != 0) {
+            out[write++] = data[i];
+            code++;
+        }
+        if (data[i] == 0 || code == 0xFF) {
+            out[code_index] = code;
+            code = 1;
+            code_index = write++;
+        }
+    }
+    out[code_index] = code;
+    return write;
+}
+
+static uint32_t _shell_rpc_get32(const uint8_t *p) {
+    return p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void _shell_rpc_put32(uint8_t *p, uint32_t value) {
+    p[0] = value;
+    p[1] = value >> 8;
+    p[2] = value >> 16;
+    p[3] = value >> 24;
+}
+
+// copies a path or key at the end of a request into a string, if it fits.
+static bool _shell_rpc_get_string(const uint8_t *data, uint16_t length, char *out, uint8_t max_length) {
+    if (length == 0 || length > max_length) return false;
+    memcpy(out, data, length);
+    out[length] = '\0';
+    return true;
+}
+
+typedef struct {
+    uint8_t *data;
+    uint16_t length;
+    uint16_t skip;
+} shell_rpc_list_t;
+
+static bool _shell_rpc_list_file(const char *filename, int32_t size, void *context) {
+    shell_rpc_list_t *list = (shell_rpc_list_t *)context;
+    if (list->skip) {
+        list->skip--;
+        return true;
+    }
+    uint8_t name_length = strlen(filename);
+    if (list->length + 5 + name_length > SHELL_RPC_MAX_DATA) return false;
+    _shell_rpc_put32(list->data + list->length, size);
+    list->data[list->length + 4] = name_length;
+    memcpy(list->data + list->length + 5, filename, name_length);
+    list->length += 5 + name_length;
+    return true;
+}
+
+// carries out a request, leaving any data in out; returns the status.
+static shell_rpc_status_t _shell_rpc_handle(uint8_t opcode, const uint8_t *args, uint16_t length, uint8_t *out, uint16_t *out_length) {
+    char path[SHELL_RPC_PATH_MAX + 1];
+    *out_length = 0;
+
+    switch (opcode) {
+        case SHELL_RPC_PING:
+            out[0] = SHELL_RPC_VERSION;
+            out[1] = SHELL_RPC_MAX_DATA & 0xFF;
+            out[2] = SHELL_RPC_MAX_DATA >> 8;
+            *out_length = 3;
+            return SHELL_RPC_OK;
+        case SHELL_RPC_FILE_LIST:
+        {
+            if (length != 2) return SHELL_RPC_BAD_REQUEST;
+            shell_rpc_list_t list = { .data = out, .length = 0, .skip = args[0] | (args[1] << 8) };
+            if (!filesystem_list_files(_shell_rpc_list_file, &list)) return SHELL_RPC_FAILED;
+            *out_length = list.length;
+            return SHELL_RPC_OK;
+        }
+        case SHELL_RPC_FILE_STAT:
+        {
+            if (!_shell_rpc_get_string(args, length, path, SHELL_RPC_PATH_MAX)) return SHELL_RPC_BAD_REQUEST;
+            int32_t size = filesystem_get_file_size(path);
+            if (size < 0) return SHELL_RPC_NOT_FOUND;
+            _shell_rpc_put32(out, size);
+            *out_length = 4;
+            return SHELL_RPC_OK;
+        }
+        case SHELL_RPC_FILE_READ:
+        {
+            if (length < 6 || !_shell_rpc_get_string(args + 6, length - 6, path, SHELL_RPC_PATH_MAX)) return SHELL_RPC_BAD_REQUEST;
+            int32_t offset = _shell_rpc_get32(args);
+            int32_t count = args[4] | (args[5] << 8);
+            if (count > SHELL_RPC_MAX_DATA) count = SHELL_RPC_MAX_DATA;
+            int32_t size = filesystem_get_file_size(path);
+            if (size < 0) return SHELL_RPC_NOT_FOUND;
+            if (offset < 0 || offset >= size) return SHELL_RPC_OK;
+            if (count > size - offset) count = size - offset;
+            if (!filesystem_read_file_at(path, (char *)out, offset, count)) return SHELL_RPC_FAILED;
+            *out_length = count;
+            return SHELL_RPC_OK;
+        }
+        case SHELL_RPC_FILE_WRITE:
+        {
+            if (length < 5 || length < 5 + args[4] || !_shell_rpc_get_string(args + 5, args[4], path, SHELL_RPC_PATH_MAX)) return SHELL_RPC_BAD_REQUEST;
+            int32_t offset = _shell_rpc_get32(args);
+            char *data = (char *)args + 5 + args[4];
+            int32_t count = length - 5 - args[4];
+            // littlefs writes files from the start or appends to them; anything else would mean copying the file.
+            bool success;
+            if (offset == 0) {
+                success = filesystem_write_file(path, data, count);
+            } else if (offset == filesystem_get_file_size(path)) {
+                success = count == 0 || filesystem_append_file(path, data, count);
+            } else {
+                return SHELL_RPC_BAD_REQUEST;
+            }
+            if (!success) return SHELL_RPC_FAILED;
+            _shell_rpc_put32(out, offset + count);
+            *out_length = 4;
+            return SHELL_RPC_OK;
+        }
+        case SHELL_RPC_FILE_REMOVE:
+            if (!_shell_rpc_get_string(args, length, path, SHELL_RPC_PATH_MAX)) return SHELL_RPC_BAD_REQUEST;
+            if (!filesystem_file_exists(path)) return SHELL_RPC_NOT_FOUND;
+            return filesystem_rm(path) ? SHELL_RPC_OK : SHELL_RPC_FAILED;
+        case SHELL_RPC_KV_GET:
+        {
+            if (!_shell_rpc_get_string(args, length, path, MOVEMENT_KV_KEY_MAX)) return SHELL_RPC_BAD_REQUEST;
+            int32_t count = movement_kv_get(path, out, MOVEMENT_KV_VALUE_MAX);
+            if (count < 0) return SHELL_RPC_NOT_FOUND;
+            *out_length = count > MOVEMENT_KV_VALUE_MAX ? MOVEMENT_KV_VALUE_MAX : count;
+            return SHELL_RPC_OK;
+        }
+        case SHELL_RPC_KV_SET:
+            if (length < 1 || length < 1 + args[0] || !_shell_rpc_get_string(args + 1, args[0], path, MOVEMENT_KV_KEY_MAX)) return SHELL_RPC_BAD_REQUEST;
+            if (length == 1 + args[0]) return movement_kv_delete(path) ? SHELL_RPC_OK : SHELL_RPC_FAILED;
+            if (length - 1 - args[0] > MOVEMENT_KV_VALUE_MAX) return SHELL_RPC_BAD_REQUEST;
+            return movement_kv_set(path, args + 1 + args[0], length - 1 - args[0]) ? SHELL_RPC_OK : SHELL_RPC_FAILED;
+        case SHELL_RPC_SETTINGS_GET:
+            _shell_rpc_put32(out, movement_get_settings()->reg);
+            *out_length = 4;
+            return SHELL_RPC_OK;
+        case SHELL_RPC_SETTINGS_SET:
+        {
+            if (length != 4) return SHELL_RPC_BAD_REQUEST;
+            movement_settings_t *settings = movement_get_settings();
+            settings->reg = _shell_rpc_get32(args);
+            watch_store_backup_data(settings->reg, 0);
+            return SHELL_RPC_OK;
+        }
+        case SHELL_RPC_RTC_GET:
+            _shell_rpc_put32(out, movement_get_local_date_time().reg);
+            *out_length = 4;
+            return SHELL_RPC_OK;
+        case SHELL_RPC_RTC_SET:
+        {
+            if (length != 4 && length != 5) return SHELL_RPC_BAD_REQUEST;
+            watch_date_time date_time;
+            date_time.reg = _shell_rpc_get32(args);
+            _start_rtc_on_trigger = length == 5 && (args[4] & 1);
+            if (_start_rtc_on_trigger) watch_rtc_enable(false);
+            movement_set_local_date_time(date_time);
+            return SHELL_RPC_OK;
+        }
+        case SHELL_RPC_RTC_EDGE:
+        {
+            // the RTC can't be read any finer than the second, so watch for the second to change.
+            watch_date_time start = watch_rtc_get_date_time();
+            watch_date_time now = start;
+            for (uint16_t waited = 0; now.reg == start.reg; waited++) {
+                if (waited >= SHELL_RPC_TIMEOUT_MS) return SHELL_RPC_FAILED;
+                delay_ms(1);
+                now = watch_rtc_get_date_time();
+            }
+            _shell_rpc_put32(out, now.reg);
+            *out_length = 4;
+            return SHELL_RPC_OK;
+        }
+        case SHELL_RPC_FACES_GET:
+        {
+            uint8_t count;
+            const uint8_t *order = movement_get_face_order(&count);
+            out[0] = 0;
+            while (movement_get_face_stats(out[0]) != NULL) out[0]++;
+            memcpy(out + 1, order, count);
+            *out_length = 1 + count;
+            return SHELL_RPC_OK;
+        }
+        case SHELL_RPC_FACES_SET:
+            if (length > 255) return SHELL_RPC_BAD_REQUEST;
+            return movement_set_face_order(args, length) ? SHELL_RPC_OK : SHELL_RPC_BAD_REQUEST;
+        case SHELL_RPC_STATS_GET:
+        {
+            if (length != 1) return SHELL_RPC_BAD_REQUEST;
+            _shell_rpc_put32(out, movement_get_event_queue_overflows());
+            *out_length = 4;
+            const movement_face_stats_t *stats;
+            for (uint8_t face = args[0]; (stats = movement_get_face_stats(face)) != NULL; face++) {
+                if (*out_length + 20 > SHELL_RPC_MAX_DATA) break;
+                _shell_rpc_put32(out + *out_length, stats->loop_calls);
+                _shell_rpc_put32(out + *out_length + 4, stats->active_cycles);
+                _shell_rpc_put32(out + *out_length + 8, stats->background_cycles);
+                _shell_rpc_put32(out + *out_length + 12, stats->led_ticks);
+                _shell_rpc_put32(out + *out_length + 16, stats->buzzer_ticks);
+                *out_length += 20;
+            }
+            return SHELL_RPC_OK;
+        }
+        case SHELL_RPC_STATS_RESET:
+            movement_reset_face_stats();
+            return SHELL_RPC_OK;
+        case SHELL_RPC_UPDATE_BEGIN:
+            if (length != 16) return SHELL_RPC_BAD_REQUEST;
+            return movement_update_begin(_shell_rpc_get32(args), _shell_rpc_get32(args + 4), _shell_rpc_get32(args + 8),
+                                         _shell_rpc_get32(args + 12)) ? SHELL_RPC_OK : SHELL_RPC_FAILED;
+        case SHELL_RPC_UPDATE_DATA:
+            if (length < 4) return SHELL_RPC_BAD_REQUEST;
+            return movement_update_receive(_shell_rpc_get32(args), args + 4, length - 4) ? SHELL_RPC_OK : SHELL_RPC_FAILED;
+        case SHELL_RPC_UPDATE_FINISH:
+            if (!movement_update_finish()) return SHELL_RPC_FAILED;
+            _install_update = true;
+            return SHELL_RPC_OK;
+        default:
+            return SHELL_RPC_UNKNOWN_OPCODE;
+    }
+}
+
+static void _shell_rpc_handle_frame(void) {
+    int32_t length = _shell_rpc_cobs_decode(_state->frame, _state->length);
+    if (length < 4) return;
+    uint16_t crc = _state->frame[length - 2] | (_state->frame[length - 1] << 8);
+    if (_shell_rpc_crc(_state->frame, length - 2) != crc) return;
+
+    uint8_t *response = _state->response;
+    uint16_t data_length;
+    response[0] = _state->frame[0];
+    response[1] = _state->frame[1] | 0x80;
+    response[2] = _shell_rpc_handle(_state->frame[1], _state->frame + 2, length - 4, response + 3, &data_length);
+    uint16_t response_length = 3 + data_length;
+    crc = _shell_rpc_crc(response, response_length);
+    response[response_length++] = crc & 0xFF;
+    response[response_length++] = crc >> 8;
+
+    uint8_t *encoded = _state->encoded;
+    encoded[0] = 0;
+    uint16_t encoded_length = 1 + _shell_rpc_cobs_encode(response, response_length, encoded + 1);
+    encoded[encoded_length++] = 0;
+
+    // a batch of requests makes responses faster than USB carries them; wait for room rather than drop one. if the
+    // host has stopped reading, there's no one to tell.
+    for (uint16_t waited = 0; cdc_get_write_buffer_space() < encoded_length; waited++) {
+        if (waited >= SHELL_RPC_TIMEOUT_MS) return;
+        delay_ms(1);
+    }
+    fwrite(encoded, 1, encoded_length, stdout);
+    fflush(stdout);
+}
+
+static void _shell_rpc_start_rtc_on_trigger(void) {
+    _start_rtc_on_trigger = false;
+    for (uint16_t waited = 0; waited < SHELL_RPC_TIMEOUT_MS; waited++) {
+        if (getchar() >= 0) break;
+        delay_ms(1);
+    }
+    watch_rtc_enable(true);
+}
+
+bool shell_rpc_is_receiving(void) {
+    return _receiving;
+}
+
+void shell_rpc_receive(uint8_t byte) {
+    if (!_receiving) {
+        if (byte != 0) return;
+        if (_state == NULL) _state = malloc(sizeof(shell_rpc_state_t));
+        if (_state == NULL) return;
+        _state->length = 0;
+        _state->overflow = false;
+        _receiving = true;
+        return;
+    }
+
+    if (byte == 0) {
+        // back-to-back delimiters are just an empty frame; keep waiting for the one after.
+        if (_state->length == 0) return;
+        if (!_state->overflow) _shell_rpc_handle_frame();
+        if (_start_rtc_on_trigger) _shell_rpc_start_rtc_on_trigger();
+        if (_install_update) {
+            _install_update = false;
+            // give the USB task time to send the response; the host doesn't hear from this firmware again.
+            delay_ms(100);
+            movement_update_install();
+        }
+        _receiving = false;
+        return;
+    }
+
+    if (_state->length < SHELL_RPC_MAX_FRAME) {
+        _state->frame[_state->length++] = byte;
+    } else {
+        _state->overflow = true;
+    }
+}
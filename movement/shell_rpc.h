@@ -0,0 +1,104 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef SHELL_RPC_H_
+#define SHELL_RPC_H_
+
+/*
+ * A binary request/response protocol for host tools, on the same USB serial port as the shell.
+ *
+ * Each request and response is a frame: a 0 byte, the payload in COBS (which leaves it free of 0 bytes), and another
+ * 0 byte. Nobody types a 0, so the shell hands everything from one to the end of the frame over to this; text
+ * commands and frames can be mixed freely. The payload is a sequence number, an opcode and its arguments, then a
+ * CRC-16/CCITT (0xFFFF to start, as binascii.crc_hqx in Python) over all of that, low byte first. The response
+ * echoes the sequence number, sets the top bit of the opcode, and adds a status byte before any data. Numbers are
+ * little-endian. A frame that's damaged in transit gets no response at all, so the host should time out and resend.
+ *
+ * Requests are handled in the order they arrive, without waiting for the host to read responses, so a host can
+ * send a batch of them and match up the responses by sequence number. utils/sensorwatch_rpc.py is the other end.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#define SHELL_RPC_VERSION 1
+
+/// The most data a read or write carries in one request.
+#define SHELL_RPC_MAX_DATA 256
+
+typedef enum {
+    SHELL_RPC_PING = 0x00,          // -> version u8, max data u16
+    SHELL_RPC_FILE_LIST = 0x01,     // first u16 -> {size u32, name length u8, name} for as many files as fit; none past the end
+    SHELL_RPC_FILE_STAT = 0x02,     // path -> size u32
+    SHELL_RPC_FILE_READ = 0x03,     // offset u32, length u16, path -> up to length bytes; fewer at the end of the file
+    SHELL_RPC_FILE_WRITE = 0x04,    // offset u32, path length u8, path, data -> size u32; 0 starts the file over, its size appends
+    SHELL_RPC_FILE_REMOVE = 0x05,   // path
+    SHELL_RPC_KV_GET = 0x10,        // key -> value
+    SHELL_RPC_KV_SET = 0x11,        // key length u8, key, value; no value deletes the key
+    SHELL_RPC_SETTINGS_GET = 0x12,  // -> movement_settings_t u32
+    SHELL_RPC_SETTINGS_SET = 0x13,  // movement_settings_t u32
+    SHELL_RPC_RTC_GET = 0x20,       // -> local watch_date_time u32
+    SHELL_RPC_RTC_SET = 0x21,       // local watch_date_time u32, then optionally a u8: 1 to start the second on a trigger
+    SHELL_RPC_RTC_EDGE = 0x22,      // -> local watch_date_time u32, sent as soon as that second begins
+    SHELL_RPC_FACES_GET = 0x30,     // -> number of faces u8, then the order MODE steps through, a u8 per face
+    SHELL_RPC_FACES_SET = 0x31,     // a u8 per face in the new order; none goes back to the built-in order
+    SHELL_RPC_STATS_GET = 0x40,     // first face u8 -> event queue overflows u32, then movement_face_stats_t for as many faces as fit
+    SHELL_RPC_STATS_RESET = 0x41,
+    SHELL_RPC_UPDATE_BEGIN = 0x50,  // base size u32, base CRC-32 u32, size u32, CRC-32 u32 (@see movement_update.h)
+    SHELL_RPC_UPDATE_DATA = 0x51,   // offset u32, the next piece of the delta
+    SHELL_RPC_UPDATE_FINISH = 0x52, // checks the new image; once the response is away, installs it and resets
+} shell_rpc_opcode_t;
+
+typedef enum {
+    SHELL_RPC_OK = 0,
+    SHELL_RPC_UNKNOWN_OPCODE,
+    SHELL_RPC_BAD_REQUEST,          // arguments missing, or too long
+    SHELL_RPC_NOT_FOUND,
+    SHELL_RPC_FAILED,               // the request made sense, but couldn't be carried out
+} shell_rpc_status_t;
+
+/*
+ * Setting the clock to better than USB's latency: RTC_SET with the trigger flag stops the RTC, sets it, and answers;
+ * then the next byte from the host (send a 0) starts it, with the new second beginning there and then. The host sends
+ * the request a little ahead of time, and the trigger on its own second boundary. If no byte comes within
+ * SHELL_RPC_TIMEOUT_MS the RTC starts anyway, so the clock is never left stopped; a host can tell it was late by
+ * checking against RTC_EDGE afterwards.
+ *
+ * RTC_EDGE measures the clock: it waits for the next second to begin, to within a millisecond, then answers. Timing a
+ * series of them against the host's clock for a few minutes shows how far the crystal runs fast or slow.
+ */
+
+/** @brief How long a request waits on the host or the RTC, at most. */
+#define SHELL_RPC_TIMEOUT_MS 2000
+
+/** @brief Returns true from the first 0 byte of a frame until the last; the shell passes all input here meanwhile. */
+bool shell_rpc_is_receiving(void);
+
+/** @brief Takes a byte of input. A 0 starts a frame, and the next 0 ends it, at which point the request is carried
+  *        out and the response sent. The buffers are allocated on the first frame, so only hosts that use this pay
+  *        for them.
+  */
+void shell_rpc_receive(uint8_t byte);
+
+#endif // SHELL_RPC_H_
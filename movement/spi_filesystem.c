@@ -0,0 +1,196 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "spi_filesystem.h"
+#include "spiflash.h"
+#include "watch.h"
+#include "lfs.h"
+
+// the chip is read a byte at a time if need be, programmed a page at a time and erased a sector at a time. littlefs
+// batches writes in its caches, so each program is a full page wherever possible.
+#define SPI_FILESYSTEM_CACHE_SIZE SPI_FLASH_PAGE_SIZE
+#define SPI_FILESYSTEM_LOOKAHEAD_SIZE 16
+
+int spi_storage_read(const struct lfs_config *cfg, lfs_block_t block, lfs_off_t off, void *buffer, lfs_size_t size);
+int spi_storage_prog(const struct lfs_config *cfg, lfs_block_t block, lfs_off_t off, const void *buffer, lfs_size_t size);
+int spi_storage_erase(const struct lfs_config *cfg, lfs_block_t block);
+int spi_storage_sync(const struct lfs_config *cfg);
+
+int spi_storage_read(const struct lfs_config *cfg, lfs_block_t block, lfs_off_t off, void *buffer, lfs_size_t size) {
+    (void) cfg;
+    if (!spi_flash_wait_until_ready()) return LFS_ERR_IO;
+    return spi_flash_read_data(block * SPI_FLASH_SECTOR_SIZE + off, buffer, size) ? LFS_ERR_OK : LFS_ERR_IO;
+}
+
+int spi_storage_prog(const struct lfs_config *cfg, lfs_block_t block, lfs_off_t off, const void *buffer, lfs_size_t size) {
+    (void) cfg;
+    return spi_flash_program(block * SPI_FLASH_SECTOR_SIZE + off, buffer, size) ? LFS_ERR_OK : LFS_ERR_IO;
+}
+
+int spi_storage_erase(const struct lfs_config *cfg, lfs_block_t block) {
+    (void) cfg;
+    return spi_flash_erase_sector(block * SPI_FLASH_SECTOR_SIZE) ? LFS_ERR_OK : LFS_ERR_IO;
+}
+
+int spi_storage_sync(const struct lfs_config *cfg) {
+    (void) cfg;
+    // programs and erases wait for the chip to finish, so there's never anything left to sync.
+    return LFS_ERR_OK;
+}
+
+#ifdef LFS_THREADSAFE
+// littlefs calls these around everything once it's built with lock hooks (for the internal filesystem's sake); this
+// one is only ever used from the main loop, so there's nothing to lock.
+static int spi_storage_lock(const struct lfs_config *cfg) {
+    (void) cfg;
+    return LFS_ERR_OK;
+}
+
+static int spi_storage_unlock(const struct lfs_config *cfg) {
+    (void) cfg;
+    return LFS_ERR_OK;
+}
+#endif
+
+static uint8_t read_buffer[SPI_FILESYSTEM_CACHE_SIZE];
+static uint8_t prog_buffer[SPI_FILESYSTEM_CACHE_SIZE];
+static uint32_t lookahead_buffer[SPI_FILESYSTEM_LOOKAHEAD_SIZE / 4];
+static uint8_t file_buffer[SPI_FILESYSTEM_CACHE_SIZE];
+
+// block_count depends on the chip, so it's filled in at mount time.
+static struct lfs_config spi_cfg = {
+    .read  = spi_storage_read,
+    .prog  = spi_storage_prog,
+    .erase = spi_storage_erase,
+    .sync  = spi_storage_sync,
+#ifdef LFS_THREADSAFE
+    .lock = spi_storage_lock,
+    .unlock = spi_storage_unlock,
+#endif
+
+    .read_size = 1,
+    .prog_size = SPI_FLASH_PAGE_SIZE,
+    .block_size = SPI_FLASH_SECTOR_SIZE,
+    .cache_size = SPI_FILESYSTEM_CACHE_SIZE,
+    .lookahead_size = SPI_FILESYSTEM_LOOKAHEAD_SIZE,
+    .block_cycles = 500,
+    .read_buffer = read_buffer,
+    .prog_buffer = prog_buffer,
+    .lookahead_buffer = lookahead_buffer,
+};
+
+static lfs_t spi_lfs;
+static lfs_file_t spi_file;
+static struct lfs_file_config spi_file_cfg = {
+    .buffer = file_buffer,
+};
+static bool mounted;
+
+static int _spi_filesystem_open(char *filename, int flags) {
+    if (!mounted) return LFS_ERR_INVAL;
+    return lfs_file_opencfg(&spi_lfs, &spi_file, filename, flags, &spi_file_cfg);
+}
+
+static int _traverse_df_cb(void *p, lfs_block_t block) {
+    (void) block;
+    uint32_t *nb = p;
+    *nb += 1;
+    return 0;
+}
+
+bool spi_filesystem_init(bool format_if_needed) {
+    if (mounted) return true;
+
+    spi_flash_init();
+
+    // the third byte of the JEDEC ID is log2 of the chip's capacity in bytes.
+    uint8_t jedec_id[3] = {0};
+    if (!spi_flash_read_command(CMD_READ_JEDEC_ID, jedec_id, 3)) return false;
+    if (jedec_id[2] < 16 || jedec_id[2] > 24) {
+        WATCH_LOG_WARN("No SPI flash found.");
+        return false;
+    }
+    spi_cfg.block_count = (1UL << jedec_id[2]) / SPI_FLASH_SECTOR_SIZE;
+
+    int err = lfs_mount(&spi_lfs, &spi_cfg);
+    if (err < 0 && format_if_needed) {
+        WATCH_LOG_WARN("Formatting SPI flash...");
+        err = lfs_format(&spi_lfs, &spi_cfg);
+        if (err == LFS_ERR_OK) err = lfs_mount(&spi_lfs, &spi_cfg);
+    }
+
+    mounted = (err == LFS_ERR_OK);
+    if (mounted) WATCH_LOG_INFO("SPI flash mounted with %ld bytes free.", spi_filesystem_get_free_space());
+
+    return mounted;
+}
+
+bool spi_filesystem_is_mounted(void) {
+    return mounted;
+}
+
+int32_t spi_filesystem_get_free_space(void) {
+    if (!mounted) return LFS_ERR_INVAL;
+
+    uint32_t used_blocks = 0;
+    int err = lfs_fs_traverse(&spi_lfs, _traverse_df_cb, &used_blocks);
+    if (err < 0) return err;
+
+    return (int32_t)((spi_cfg.block_count - used_blocks) * spi_cfg.block_size);
+}
+
+int32_t spi_filesystem_get_file_size(char *filename) {
+    struct lfs_info info;
+    if (!mounted || lfs_stat(&spi_lfs, filename, &info) < 0 || info.type != LFS_TYPE_REG) return -1;
+    return info.size;
+}
+
+bool spi_filesystem_read_file_at(char *filename, char *buf, int32_t offset, int32_t length) {
+    memset(buf, 0, length);
+    if (_spi_filesystem_open(filename, LFS_O_RDONLY) < 0) return false;
+
+    bool success = lfs_file_seek(&spi_lfs, &spi_file, offset, LFS_SEEK_SET) >= 0;
+    if (success) success = lfs_file_read(&spi_lfs, &spi_file, buf, length) >= 0;
+
+    return (lfs_file_close(&spi_lfs, &spi_file) == LFS_ERR_OK) && success;
+}
+
+bool spi_filesystem_write_file(char *filename, char *data, int32_t length) {
+    if (_spi_filesystem_open(filename, LFS_O_RDWR | LFS_O_CREAT | LFS_O_TRUNC) < 0) return false;
+    bool success = lfs_file_write(&spi_lfs, &spi_file, data, length) == length;
+    return (lfs_file_close(&spi_lfs, &spi_file) == LFS_ERR_OK) && success;
+}
+
+bool spi_filesystem_append_file(char *filename, char *data, int32_t length) {
+    if (_spi_filesystem_open(filename, LFS_O_WRONLY | LFS_O_CREAT | LFS_O_APPEND) < 0) return false;
+    bool success = lfs_file_write(&spi_lfs, &spi_file, data, length) == length;
+    return (lfs_file_close(&spi_lfs, &spi_file) == LFS_ERR_OK) && success;
+}
+
+bool spi_filesystem_rm(char *filename) {
+    if (!mounted) return false;
+    return lfs_remove(&spi_lfs, filename) == LFS_ERR_OK;
+}
@@ -0,0 +1,83 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef SPI_FILESYSTEM_H_
+#define SPI_FILESYSTEM_H_
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @brief Mounts a second littlefs filesystem on the SPI flash chip found on some sensor boards. This gives faces
+  *        megabytes of storage, organized into files, instead of the 8 KB internal filesystem or raw pages.
+  * @param format_if_needed If true, formats the chip when no filesystem is found on it. This erases whatever is
+  *                         there, so only pass true once you know the chip isn't holding anything else.
+  * @return true if the filesystem was mounted; false if there's no flash chip, or no filesystem on it.
+  */
+bool spi_filesystem_init(bool format_if_needed);
+
+/** @brief Returns true if spi_filesystem_init mounted the filesystem. */
+bool spi_filesystem_is_mounted(void);
+
+/** @brief Gets the space available on the SPI flash filesystem.
+  * @return the free space in bytes, or a negative number on error.
+  */
+int32_t spi_filesystem_get_free_space(void);
+
+/** @brief Gets the size of a file on the SPI flash filesystem.
+  * @param filename the file whose size you wish to determine
+  * @return the file's size in bytes, or -1 if the file does not exist.
+  */
+int32_t spi_filesystem_get_file_size(char *filename);
+
+/** @brief Reads part of a file from the SPI flash filesystem into a buffer
+  * @param filename the file you wish to read
+  * @param buf A buffer of at least length bytes; it is zeroed first, so a short read leaves the rest zeroed.
+  * @param offset The offset into the file at which to start reading
+  * @param length The number of bytes to read
+  * @return true if the read was successful; false otherwise
+  */
+bool spi_filesystem_read_file_at(char *filename, char *buf, int32_t offset, int32_t length);
+
+/** @brief Writes a file to the SPI flash filesystem, replacing it if it exists.
+  * @param filename the file you wish to write
+  * @param data The contents of the file
+  * @param length The number of bytes to write
+  * @return true if the write was successful; false otherwise
+  */
+bool spi_filesystem_write_file(char *filename, char *data, int32_t length);
+
+/** @brief Appends data to a file on the SPI flash filesystem, creating it if need be.
+  * @param filename the file you wish to write
+  * @param data The contents to write
+  * @param length The number of bytes to write
+  * @return true if the write was successful; false otherwise
+  */
+bool spi_filesystem_append_file(char *filename, char *data, int32_t length);
+
+/** @brief Removes a file from the SPI flash filesystem.
+  * @param filename the file you wish to remove
+  * @return true if the file was deleted successfully; false otherwise
+  */
+bool spi_filesystem_rm(char *filename);
+
+#endif // SPI_FILESYSTEM_H_
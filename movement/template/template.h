@@ -50,6 +50,9 @@ void <#watch_face_name#>_face_resign(movement_settings_t *settings, void *contex
     <#watch_face_name#>_face_loop, \
     <#watch_face_name#>_face_resign, \
     NULL, \
+    sizeof(<#watch_face_name#>_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // <#WATCH_FACE_NAME#>_FACE_H_
@@ -55,6 +55,9 @@ void beats_face_resign(movement_settings_t *settings, void *context);
     beats_face_loop, \
     beats_face_resign, \
     NULL, \
+    sizeof(beats_face_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // BEATS_FACE_H_
\ No newline at end of file
@@ -34,7 +34,7 @@
 #include "clock_face.h"
 #include "watch.h"
 #include "watch_utility.h"
-#include "watch_private_display.h"
+#include "movement_clock.h"
 
 // 2.2 volts will happen when the battery has maybe 5-10% remaining?
 // we can refine this later.
@@ -47,18 +47,17 @@
 #endif
 
 typedef struct {
-    struct {
-        watch_date_time previous;
-    } date_time;
-    uint8_t last_battery_check;
+    movement_clock_t clock;
     uint8_t watch_face_index;
     bool time_signal_enabled;
     bool battery_low;
 } clock_state_t;
 
-static bool clock_is_in_24h_mode(movement_settings_t *settings) {
-    if (CLOCK_FACE_24H_ONLY) { return true; }
-    return settings->bit.clock_mode_24h;
+// the settings the clock is drawn with, which are 24 hour mode's if this face is built for nothing else.
+static movement_settings_t clock_settings(movement_settings_t *settings) {
+    movement_settings_t clock_settings = *settings;
+    if (CLOCK_FACE_24H_ONLY) { clock_settings.bit.clock_mode_24h = true; }
+    return clock_settings;
 }
 
 static void clock_indicate(WatchIndicatorSegment indicator, bool on) {
@@ -77,45 +76,16 @@ static void clock_indicate_time_signal(clock_state_t *clock) {
     clock_indicate(WATCH_INDICATOR_SIGNAL, clock->time_signal_enabled);
 }
 
-static void clock_indicate_24h(movement_settings_t *settings) {
-    clock_indicate(WATCH_INDICATOR_24H, clock_is_in_24h_mode(settings));
-}
-
-static bool clock_is_pm(watch_date_time date_time) {
-    return date_time.unit.hour >= 12;
-}
-
-static void clock_indicate_pm(movement_settings_t *settings, watch_date_time date_time) {
-    if (settings->bit.clock_mode_24h) { return; }
-    clock_indicate(WATCH_INDICATOR_PM, clock_is_pm(date_time));
-}
-
 static void clock_indicate_low_available_power(clock_state_t *clock) {
     // Set the LAP indicator if battery power is low
     clock_indicate(WATCH_INDICATOR_LAP, clock->battery_low);
 }
 
-static watch_date_time clock_24h_to_12h(watch_date_time date_time) {
-    date_time.unit.hour %= 12;
-
-    if (date_time.unit.hour == 0) {
-        date_time.unit.hour = 12;
-    }
-
-    return date_time;
-}
-
-static void clock_check_battery_periodically(clock_state_t *clock, watch_date_time date_time) {
-    // check the battery voltage once a day
-    if (date_time.unit.day == clock->last_battery_check) { return; }
-
-    clock->last_battery_check = date_time.unit.day;
-
-    watch_enable_adc();
-    uint16_t voltage = watch_get_vcc_voltage();
-    watch_disable_adc();
+static void clock_check_battery(clock_state_t *clock) {
+    // Movement reads the battery once a day, and the brownout detector watches it in between.
+    uint16_t voltage = movement_get_battery_voltage();
 
-    clock->battery_low = voltage < CLOCK_FACE_LOW_BATTERY_VOLTAGE_THRESHOLD;
+    clock->battery_low = voltage && voltage < CLOCK_FACE_LOW_BATTERY_VOLTAGE_THRESHOLD;
 
     clock_indicate_low_available_power(clock);
 }
@@ -125,94 +95,6 @@ static void clock_toggle_time_signal(clock_state_t *clock) {
     clock_indicate_time_signal(clock);
 }
 
-static void clock_display_all(watch_date_time date_time) {
-    char buf[10 + 1];
-
-    snprintf(
-        buf,
-        sizeof(buf),
-        "%s%2d%2d%02d%02d",
-        watch_utility_get_weekday(date_time),
-        date_time.unit.day,
-        date_time.unit.hour,
-        date_time.unit.minute,
-        date_time.unit.second
-    );
-
-    watch_display_string(buf, 0);
-}
-
-static bool clock_display_some(watch_date_time current, watch_date_time previous) {
-    if ((current.reg >> 6) == (previous.reg >> 6)) {
-        // everything before seconds is the same, don't waste cycles setting those segments.
-
-        watch_display_character_lp_seconds('0' + current.unit.second / 10, 8);
-        watch_display_character_lp_seconds('0' + current.unit.second % 10, 9);
-
-        return true;
-
-    } else if ((current.reg >> 12) == (previous.reg >> 12)) {
-        // everything before minutes is the same.
-
-        char buf[4 + 1];
-
-        snprintf(
-            buf,
-            sizeof(buf),
-            "%02d%02d",
-            current.unit.minute,
-            current.unit.second
-        );
-
-        watch_display_string(buf, 6);
-
-        return true;
-
-    } else {
-        // other stuff changed; let's do it all.
-        return false;
-    }
-}
-
-static void clock_display_clock(movement_settings_t *settings, clock_state_t *clock, watch_date_time current) {
-    if (!clock_display_some(current, clock->date_time.previous)) {
-        if (!clock_is_in_24h_mode(settings)) {
-            // if we are in 12 hour mode, do some cleanup.
-            clock_indicate_pm(settings, current);
-            current = clock_24h_to_12h(current);
-        }
-        clock_display_all(current);
-    }
-}
-
-static void clock_display_low_energy(watch_date_time date_time) {
-    char buf[10 + 1];
-
-    snprintf(
-        buf,
-        sizeof(buf),
-        "%s%2d%2d%02d  ",
-        watch_utility_get_weekday(date_time),
-        date_time.unit.day,
-        date_time.unit.hour,
-        date_time.unit.minute
-    );
-
-    watch_display_string(buf, 0);
-}
-
-static void clock_start_tick_tock_animation(void) {
-    if (!watch_tick_animation_is_running()) {
-        watch_start_tick_animation(500);
-    }
-}
-
-static void clock_stop_tick_tock_animation(void) {
-    if (watch_tick_animation_is_running()) {
-        watch_stop_tick_animation();
-    }
-}
-
 void clock_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
     (void) settings;
     (void) watch_face_index;
@@ -227,37 +109,27 @@ void clock_face_setup(movement_settings_t *settings, uint8_t watch_face_index, v
 
 void clock_face_activate(movement_settings_t *settings, void *context) {
     clock_state_t *clock = (clock_state_t *) context;
+    movement_settings_t settings_for_clock = clock_settings(settings);
 
-    clock_stop_tick_tock_animation();
+    movement_clock_activate(&clock->clock, &settings_for_clock);
 
     clock_indicate_time_signal(clock);
     clock_indicate_alarm(settings);
-    clock_indicate_24h(settings);
-
-    watch_set_colon();
-
-    // this ensures that none of the timestamp fields will match, so we can re-render them all.
-    clock->date_time.previous.reg = 0xFFFFFFFF;
 }
 
 bool clock_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
     clock_state_t *state = (clock_state_t *) context;
-    watch_date_time current;
+    movement_settings_t settings_for_clock = clock_settings(settings);
 
     switch (event.event_type) {
         case EVENT_LOW_ENERGY_UPDATE:
-            clock_start_tick_tock_animation();
-            clock_display_low_energy(watch_rtc_get_date_time());
+            movement_clock_draw_low_energy(&state->clock, &settings_for_clock, watch_rtc_get_date_time(), NULL);
             break;
         case EVENT_TICK:
         case EVENT_ACTIVATE:
-            current = watch_rtc_get_date_time();
+            movement_clock_draw(&state->clock, &settings_for_clock, watch_rtc_get_date_time(), NULL);
 
-            clock_display_clock(settings, state, current);
-
-            clock_check_battery_periodically(state, current);
-
-            state->date_time.previous = current;
+            clock_check_battery(state);
 
             break;
         case EVENT_ALARM_LONG_PRESS:
@@ -280,6 +152,13 @@ void clock_face_resign(movement_settings_t *settings, void *context) {
     (void) context;
 }
 
+bool clock_face_draw_low_energy(movement_settings_t *settings, void *context, watch_date_time date_time) {
+    (void) context;
+    movement_settings_t settings_for_clock = clock_settings(settings);
+
+    return movement_clock_draw_next_minute(&settings_for_clock, date_time, NULL);
+}
+
 bool clock_face_wants_background_task(movement_settings_t *settings, void *context) {
     (void) settings;
     clock_state_t *state = (clock_state_t *) context;
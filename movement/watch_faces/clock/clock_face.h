@@ -48,6 +48,7 @@ void clock_face_activate(movement_settings_t *settings, void *context);
 bool clock_face_loop(movement_event_t event, movement_settings_t *settings, void *context);
 void clock_face_resign(movement_settings_t *settings, void *context);
 bool clock_face_wants_background_task(movement_settings_t *settings, void *context);
+bool clock_face_draw_low_energy(movement_settings_t *settings, void *context, watch_date_time date_time);
 
 #define clock_face ((const watch_face_t) { \
     clock_face_setup, \
@@ -55,6 +56,9 @@ bool clock_face_wants_background_task(movement_settings_t *settings, void *conte
     clock_face_loop, \
     clock_face_resign, \
     clock_face_wants_background_task, \
+    0, \
+    0, \
+    clock_face_draw_low_energy, \
 })
 
 #endif // CLOCK_FACE_H_
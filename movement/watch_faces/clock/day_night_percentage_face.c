@@ -27,7 +27,7 @@
 #include <math.h>
 #include "day_night_percentage_face.h"
 #include "watch_utility.h"
-#include "sunriset.h"
+#include "movement_solar.h"
 
 // fmod but handle negatives right
 static double better_fmod(double x, double y) {
@@ -42,17 +42,9 @@ static void recalculate(watch_date_time utc_now, day_night_percentage_state_t *s
         return;
     }
 
-    // Weird quirky unsigned things were happening when I tried to cast these directly to doubles below.
-    // it looks redundant, but extracting them to local int16's seemed to fix it.
-    int16_t lat_centi = (int16_t)movement_location.bit.latitude;
-    int16_t lon_centi = (int16_t)movement_location.bit.longitude;
+    state->daylen = movement_solar_get_day_length(utc_now);
 
-    double lat = (double)lat_centi / 100.0;
-    double lon = (double)lon_centi / 100.0;
-
-    state->daylen = day_length(utc_now.unit.year + WATCH_RTC_REFERENCE_YEAR, utc_now.unit.month, utc_now.unit.day, lon, lat);
-
-    state->result = sun_rise_set(utc_now.unit.year + WATCH_RTC_REFERENCE_YEAR, utc_now.unit.month, utc_now.unit.day, lon, lat, &state->rise, &state->set);
+    state->result = movement_solar_get_rise_set(utc_now, &state->rise, &state->set);
 }
 
 void day_night_percentage_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
@@ -60,9 +52,9 @@ void day_night_percentage_face_setup(movement_settings_t *settings, uint8_t watc
     (void) watch_face_index;
 
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(day_night_percentage_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(day_night_percentage_state_t));
         day_night_percentage_state_t *state = (day_night_percentage_state_t *)*context_ptr;
-        watch_date_time utc_now = watch_utility_date_time_convert_zone(watch_rtc_get_date_time(), movement_timezone_offsets[settings->bit.time_zone] * 60, 0);
+        watch_date_time utc_now = movement_get_utc_date_time();
         recalculate(utc_now, state);
     }
 }
@@ -76,8 +68,8 @@ bool day_night_percentage_face_loop(movement_event_t event, movement_settings_t
     day_night_percentage_state_t *state = (day_night_percentage_state_t *)context;
 
     char buf[12];
-    watch_date_time date_time = watch_rtc_get_date_time();
-    watch_date_time utc_now = watch_utility_date_time_convert_zone(date_time, movement_timezone_offsets[settings->bit.time_zone] * 60, 0);
+    watch_date_time date_time = movement_get_local_date_time();
+    watch_date_time utc_now = movement_get_utc_date_time();
 
     switch (event.event_type) {
         case EVENT_ACTIVATE:
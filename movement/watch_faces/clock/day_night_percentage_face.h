@@ -60,6 +60,9 @@ void day_night_percentage_face_resign(movement_settings_t *settings, void *conte
     day_night_percentage_face_loop, \
     day_night_percentage_face_resign, \
     NULL, \
+    sizeof(day_night_percentage_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // DAY_NIGHT_PERCENTAGE_FACE_H_
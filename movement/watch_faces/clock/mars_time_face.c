@@ -68,9 +68,10 @@ static void _h_to_hms(mars_clock_hms_t *date_time, double h) {
 }
 
 static void _update(movement_settings_t *settings, mars_time_state_t *state) {
+    (void) settings;
     char buf[11];
     watch_date_time date_time = watch_rtc_get_date_time();
-    uint32_t now = watch_utility_date_time_to_unix_time(date_time, movement_timezone_offsets[settings->bit.time_zone] * 60);
+    uint32_t now = watch_utility_date_time_to_unix_time(date_time, movement_get_current_timezone_offset() * 60);
     // TODO: I'm skipping over some steps here.
     // https://www.giss.nasa.gov/tools/mars24/help/algorithm.html
     double jdut = 2440587.5 + ((double)now / 86400.0);
@@ -110,7 +111,7 @@ void mars_time_face_setup(movement_settings_t *settings, uint8_t watch_face_inde
     (void) settings;
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(mars_time_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(mars_time_state_t));
         memset(*context_ptr, 0, sizeof(mars_time_state_t));
     }
 }
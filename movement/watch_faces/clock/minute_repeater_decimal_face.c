@@ -41,7 +41,6 @@
 #include "minute_repeater_decimal_face.h"
 #include "watch.h"
 #include "watch_utility.h"
-#include "watch_private_display.h"
 
 void mrd_play_hour_chime(void) {
         watch_buzzer_play_note(BUZZER_NOTE_C6, 75);
@@ -71,7 +70,7 @@ void minute_repeater_decimal_face_setup(movement_settings_t *settings, uint8_t w
     (void) watch_face_index;
 
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(minute_repeater_decimal_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(minute_repeater_decimal_state_t));
         minute_repeater_decimal_state_t *state = (minute_repeater_decimal_state_t *)*context_ptr;
         state->signal_enabled = false;
         state->watch_face_index = watch_face_index;
@@ -81,9 +80,7 @@ void minute_repeater_decimal_face_setup(movement_settings_t *settings, uint8_t w
 void minute_repeater_decimal_face_activate(movement_settings_t *settings, void *context) {
     minute_repeater_decimal_state_t *state = (minute_repeater_decimal_state_t *)context;
 
-    if (watch_tick_animation_is_running()) watch_stop_tick_animation();
-
-    if (settings->bit.clock_mode_24h) watch_set_indicator(WATCH_INDICATOR_24H);
+    movement_clock_activate(&state->clock, settings);
 
     // handle chime indicator
     if (state->signal_enabled) watch_set_indicator(WATCH_INDICATOR_BELL);
@@ -91,72 +88,25 @@ void minute_repeater_decimal_face_activate(movement_settings_t *settings, void *
 
     // show alarm indicator if there is an active alarm
     _update_alarm_indicator(settings->bit.alarm_enabled, state);
-
-    watch_set_colon();
-
-    // this ensures that none of the timestamp fields will match, so we can re-render them all.
-    state->previous_date_time = 0xFFFFFFFF;
 }
 
 bool minute_repeater_decimal_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
     minute_repeater_decimal_state_t *state = (minute_repeater_decimal_state_t *)context;
-    char buf[11];
-    uint8_t pos;
 
     watch_date_time date_time;
-    uint32_t previous_date_time;
     switch (event.event_type) {
         case EVENT_ACTIVATE:
         case EVENT_TICK:
         case EVENT_LOW_ENERGY_UPDATE:
             date_time = watch_rtc_get_date_time();
-            previous_date_time = state->previous_date_time;
-            state->previous_date_time = date_time.reg;
-
-            // check the battery voltage once a day...
-            if (date_time.unit.day != state->last_battery_check) {
-                state->last_battery_check = date_time.unit.day;
-                watch_enable_adc();
-                uint16_t voltage = watch_get_vcc_voltage();
-                watch_disable_adc();
-                // 2.2 volts will happen when the battery has maybe 5-10% remaining?
-                // we can refine this later.
-                state->battery_low = (voltage < 2200);
-            }
+            // set the LAP indicator if the battery is low.
+            if (movement_battery_is_low()) watch_set_indicator(WATCH_INDICATOR_LAP);
 
-            // ...and set the LAP indicator if low.
-            if (state->battery_low) watch_set_indicator(WATCH_INDICATOR_LAP);
-
-            if ((date_time.reg >> 6) == (previous_date_time >> 6) && event.event_type != EVENT_LOW_ENERGY_UPDATE) {
-                // everything before seconds is the same, don't waste cycles setting those segments.
-                watch_display_character_lp_seconds('0' + date_time.unit.second / 10, 8);
-                watch_display_character_lp_seconds('0' + date_time.unit.second % 10, 9);
-                break;
-            } else if ((date_time.reg >> 12) == (previous_date_time >> 12) && event.event_type != EVENT_LOW_ENERGY_UPDATE) {
-                // everything before minutes is the same.
-                pos = 6;
-                sprintf(buf, "%02d%02d", date_time.unit.minute, date_time.unit.second);
+            if (event.event_type == EVENT_LOW_ENERGY_UPDATE) {
+                movement_clock_draw_low_energy(&state->clock, settings, date_time, NULL);
             } else {
-                // other stuff changed; let's do it all.
-                if (!settings->bit.clock_mode_24h) {
-                    // if we are in 12 hour mode, do some cleanup.
-                    if (date_time.unit.hour < 12) {
-                        watch_clear_indicator(WATCH_INDICATOR_PM);
-                    } else {
-                        watch_set_indicator(WATCH_INDICATOR_PM);
-                    }
-                    date_time.unit.hour %= 12;
-                    if (date_time.unit.hour == 0) date_time.unit.hour = 12;
-                }
-                pos = 0;
-                if (event.event_type == EVENT_LOW_ENERGY_UPDATE) {
-                    if (!watch_tick_animation_is_running()) watch_start_tick_animation(500);
-                    sprintf(buf, "%s%2d%2d%02d  ", watch_utility_get_weekday(date_time), date_time.unit.day, date_time.unit.hour, date_time.unit.minute);
-                } else {
-                    sprintf(buf, "%s%2d%2d%02d%02d", watch_utility_get_weekday(date_time), date_time.unit.day, date_time.unit.hour, date_time.unit.minute, date_time.unit.second);
-                }
+                movement_clock_draw(&state->clock, settings, date_time, NULL);
             }
-            watch_display_string(buf, pos);
             // handle alarm indicator
             if (state->alarm_enabled != settings->bit.alarm_enabled) _update_alarm_indicator(settings->bit.alarm_enabled, state);
             break;
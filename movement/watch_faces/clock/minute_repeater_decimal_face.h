@@ -27,6 +27,7 @@
 #define MINUTE_REPEATER_DECIMAL_FACE_H_
 
 #include "movement.h"
+#include "movement_clock.h"
 
 /*
  * A hopefully useful complication for friendly neighbors in the dark
@@ -56,11 +57,9 @@
  */
 
 typedef struct {
-    uint32_t previous_date_time;
-    uint8_t last_battery_check;
+    movement_clock_t clock;
     uint8_t watch_face_index;
     bool signal_enabled;
-    bool battery_low;
     bool alarm_enabled;
 } minute_repeater_decimal_state_t;
 
@@ -79,6 +78,9 @@ bool minute_repeater_decimal_face_wants_background_task(movement_settings_t *set
     minute_repeater_decimal_face_loop, \
     minute_repeater_decimal_face_resign, \
     minute_repeater_decimal_face_wants_background_task, \
+    sizeof(minute_repeater_decimal_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // MINUTE_REPEATER_DECIMAL_FACE_H_
@@ -23,26 +23,29 @@
  */
 
 #include <stdlib.h>
+#include <string.h>
 #include "repetition_minute_face.h"
 #include "watch.h"
 #include "watch_utility.h"
-#include "watch_private_display.h"
 
-void play_hour_chime(void) {
-        watch_buzzer_play_note(BUZZER_NOTE_C6, 75);
-        watch_buzzer_play_note(BUZZER_NOTE_REST, 500);
-}
-
-void play_quarter_chime(void) {
-        watch_buzzer_play_note(BUZZER_NOTE_E6, 75);
-        watch_buzzer_play_note(BUZZER_NOTE_REST, 150);
-        watch_buzzer_play_note(BUZZER_NOTE_C6, 75);
-        watch_buzzer_play_note(BUZZER_NOTE_REST, 750);
-}
-
-void play_minute_chime(void) {
-        watch_buzzer_play_note(BUZZER_NOTE_E6, 75);
-        watch_buzzer_play_note(BUZZER_NOTE_REST, 500);
+// the chimes as sequencer tunes, with durations in 64 Hz ticks (@see watch_buzzer_play_sequence).
+static const int8_t _hour_chime[] = {BUZZER_NOTE_C6, 4, BUZZER_NOTE_REST, 31};
+static const int8_t _quarter_chime[] = {BUZZER_NOTE_E6, 4, BUZZER_NOTE_REST, 9, BUZZER_NOTE_C6, 4, BUZZER_NOTE_REST, 47};
+static const int8_t _minute_chime[] = {BUZZER_NOTE_E6, 4, BUZZER_NOTE_REST, 31};
+
+// hours, quarters and minutes, each with a repeat marker, plus the terminating zero.
+static int8_t _repetition_tune[sizeof(_hour_chime) + sizeof(_quarter_chime) + sizeof(_minute_chime) + 7];
+
+static uint8_t _append_chime(uint8_t pos, const int8_t *chime, uint8_t length, int count) {
+    if (count <= 0) return pos;
+    memcpy(_repetition_tune + pos, chime, length);
+    pos += length;
+    if (count > 1) {
+        // rewind over the chime's notes and play them count - 1 more times
+        _repetition_tune[pos++] = -(length / 2);
+        _repetition_tune[pos++] = count - 1;
+    }
+    return pos;
 }
 
 static void _update_alarm_indicator(bool settings_alarm_enabled, repetition_minute_state_t *state) {
@@ -56,19 +59,19 @@ void repetition_minute_face_setup(movement_settings_t *settings, uint8_t watch_f
     (void) watch_face_index;
 
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(repetition_minute_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(repetition_minute_state_t));
         repetition_minute_state_t *state = (repetition_minute_state_t *)*context_ptr;
         state->signal_enabled = false;
         state->watch_face_index = watch_face_index;
     }
+    // we only need to be asked about the hourly signal while it's turned on.
+    movement_set_background_task_interest_for_face(watch_face_index, ((repetition_minute_state_t *)*context_ptr)->signal_enabled);
 }
 
 void repetition_minute_face_activate(movement_settings_t *settings, void *context) {
     repetition_minute_state_t *state = (repetition_minute_state_t *)context;
 
-    if (watch_tick_animation_is_running()) watch_stop_tick_animation();
-
-    if (settings->bit.clock_mode_24h) watch_set_indicator(WATCH_INDICATOR_24H);
+    movement_clock_activate(&state->clock, settings);
 
     // handle chime indicator
     if (state->signal_enabled) watch_set_indicator(WATCH_INDICATOR_BELL);
@@ -76,72 +79,25 @@ void repetition_minute_face_activate(movement_settings_t *settings, void *contex
 
     // show alarm indicator if there is an active alarm
     _update_alarm_indicator(settings->bit.alarm_enabled, state);
-
-    watch_set_colon();
-
-    // this ensures that none of the timestamp fields will match, so we can re-render them all.
-    state->previous_date_time = 0xFFFFFFFF;
 }
 
 bool repetition_minute_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
     repetition_minute_state_t *state = (repetition_minute_state_t *)context;
-    char buf[11];
-    uint8_t pos;
 
     watch_date_time date_time;
-    uint32_t previous_date_time;
     switch (event.event_type) {
         case EVENT_ACTIVATE:
         case EVENT_TICK:
         case EVENT_LOW_ENERGY_UPDATE:
             date_time = watch_rtc_get_date_time();
-            previous_date_time = state->previous_date_time;
-            state->previous_date_time = date_time.reg;
-
-            // check the battery voltage once a day...
-            if (date_time.unit.day != state->last_battery_check) {
-                state->last_battery_check = date_time.unit.day;
-                watch_enable_adc();
-                uint16_t voltage = watch_get_vcc_voltage();
-                watch_disable_adc();
-                // 2.2 volts will happen when the battery has maybe 5-10% remaining?
-                // we can refine this later.
-                state->battery_low = (voltage < 2200);
-            }
+            // set the LAP indicator if the battery is low.
+            if (movement_battery_is_low()) watch_set_indicator(WATCH_INDICATOR_LAP);
 
-            // ...and set the LAP indicator if low.
-            if (state->battery_low) watch_set_indicator(WATCH_INDICATOR_LAP);
-
-            if ((date_time.reg >> 6) == (previous_date_time >> 6) && event.event_type != EVENT_LOW_ENERGY_UPDATE) {
-                // everything before seconds is the same, don't waste cycles setting those segments.
-                watch_display_character_lp_seconds('0' + date_time.unit.second / 10, 8);
-                watch_display_character_lp_seconds('0' + date_time.unit.second % 10, 9);
-                break;
-            } else if ((date_time.reg >> 12) == (previous_date_time >> 12) && event.event_type != EVENT_LOW_ENERGY_UPDATE) {
-                // everything before minutes is the same.
-                pos = 6;
-                sprintf(buf, "%02d%02d", date_time.unit.minute, date_time.unit.second);
+            if (event.event_type == EVENT_LOW_ENERGY_UPDATE) {
+                movement_clock_draw_low_energy(&state->clock, settings, date_time, NULL);
             } else {
-                // other stuff changed; let's do it all.
-                if (!settings->bit.clock_mode_24h) {
-                    // if we are in 12 hour mode, do some cleanup.
-                    if (date_time.unit.hour < 12) {
-                        watch_clear_indicator(WATCH_INDICATOR_PM);
-                    } else {
-                        watch_set_indicator(WATCH_INDICATOR_PM);
-                    }
-                    date_time.unit.hour %= 12;
-                    if (date_time.unit.hour == 0) date_time.unit.hour = 12;
-                }
-                pos = 0;
-                if (event.event_type == EVENT_LOW_ENERGY_UPDATE) {
-                    if (!watch_tick_animation_is_running()) watch_start_tick_animation(500);
-                    sprintf(buf, "%s%2d%2d%02d  ", watch_utility_get_weekday(date_time), date_time.unit.day, date_time.unit.hour, date_time.unit.minute);
-                } else {
-                    sprintf(buf, "%s%2d%2d%02d%02d", watch_utility_get_weekday(date_time), date_time.unit.day, date_time.unit.hour, date_time.unit.minute, date_time.unit.second);
-                }
+                movement_clock_draw(&state->clock, settings, date_time, NULL);
             }
-            watch_display_string(buf, pos);
             // handle alarm indicator
             if (state->alarm_enabled != settings->bit.alarm_enabled) _update_alarm_indicator(settings->bit.alarm_enabled, state);
             break;
@@ -149,6 +105,7 @@ bool repetition_minute_face_loop(movement_event_t event, movement_settings_t *se
             state->signal_enabled = !state->signal_enabled;
             if (state->signal_enabled) watch_set_indicator(WATCH_INDICATOR_BELL);
             else watch_clear_indicator(WATCH_INDICATOR_BELL);
+            movement_set_background_task_interest_for_face(state->watch_face_index, state->signal_enabled);
             break;
         case EVENT_BACKGROUND_TASK:
             // uncomment this line to snap back to the clock face when the hour signal sounds:
@@ -174,28 +131,17 @@ bool repetition_minute_face_loop(movement_event_t event, movement_settings_t *se
                 hours = date_time.unit.hour % 12;                
                 if (hours == 0) hours = 12;
             }
-            if (hours > 0) {
-                int count = 0;
-                for(count = hours; count > 0; --count) {          
-                    play_hour_chime();
-                }
-            }
+            uint8_t pos = _append_chime(0, _hour_chime, sizeof(_hour_chime), hours);
 
             // chiming quarters (if needed)
-            if (quarters > 0) {
-                int count = 0;
-                for(count = quarters; count > 0; --count) {          
-                    play_quarter_chime();
-                }
-            }
+            pos = _append_chime(pos, _quarter_chime, sizeof(_quarter_chime), quarters);
 
             // chiming minutes (if needed)
-            if (minutes > 0) {
-                int count = 0;
-                for(count = minutes; count > 0; --count) {          
-                    play_minute_chime();
-                }
-            }
+            pos = _append_chime(pos, _minute_chime, sizeof(_minute_chime), minutes);
+
+            // played by the buzzer sequencer, so the watch can stand by between notes.
+            _repetition_tune[pos] = 0;
+            if (pos) movement_play_tune(_repetition_tune);
            
             break; 
         default:
@@ -215,7 +161,7 @@ bool repetition_minute_face_wants_background_task(movement_settings_t *settings,
     repetition_minute_state_t *state = (repetition_minute_state_t *)context;
     if (!state->signal_enabled) return false;
 
-    watch_date_time date_time = watch_rtc_get_date_time();
+    watch_date_time date_time = movement_get_local_date_time();
 
     return date_time.unit.minute == 0;
 }
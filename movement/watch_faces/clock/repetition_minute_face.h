@@ -53,19 +53,15 @@
  */
 
 #include "movement.h"
+#include "movement_clock.h"
 
 typedef struct {
-    uint32_t previous_date_time;
-    uint8_t last_battery_check;
+    movement_clock_t clock;
     uint8_t watch_face_index;
     bool signal_enabled;
-    bool battery_low;
     bool alarm_enabled;
 } repetition_minute_state_t;
 
-void play_hour_chime(void);
-void play_quarter_chime(void);
-void play_minute_chime(void);
 void repetition_minute_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
 void repetition_minute_face_activate(movement_settings_t *settings, void *context);
 bool repetition_minute_face_loop(movement_event_t event, movement_settings_t *settings, void *context);
@@ -78,6 +74,9 @@ bool repetition_minute_face_wants_background_task(movement_settings_t *settings,
     repetition_minute_face_loop, \
     repetition_minute_face_resign, \
     repetition_minute_face_wants_background_task, \
+    sizeof(repetition_minute_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // REPETITION_MINUTE_FACE_H_
@@ -48,7 +48,7 @@ static void _display_left_aligned(uint8_t value) {
 void simple_clock_bin_led_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
     (void) settings;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(simple_clock_bin_led_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(simple_clock_bin_led_state_t));
         memset(*context_ptr, 0, sizeof(simple_clock_bin_led_state_t));
         simple_clock_bin_led_state_t *state = (simple_clock_bin_led_state_t *)*context_ptr;
         state->watch_face_index = watch_face_index;
@@ -58,9 +58,7 @@ void simple_clock_bin_led_face_setup(movement_settings_t *settings, uint8_t watc
 void simple_clock_bin_led_face_activate(movement_settings_t *settings, void *context) {
     simple_clock_bin_led_state_t *state = (simple_clock_bin_led_state_t *)context;
 
-    if (watch_tick_animation_is_running()) watch_stop_tick_animation();
-
-    if (settings->bit.clock_mode_24h) watch_set_indicator(WATCH_INDICATOR_24H);
+    movement_clock_activate(&state->clock, settings);
 
     // handle chime indicator
     if (state->signal_enabled) watch_set_indicator(WATCH_INDICATOR_BELL);
@@ -68,20 +66,12 @@ void simple_clock_bin_led_face_activate(movement_settings_t *settings, void *con
 
     // show alarm indicator if there is an active alarm
     _update_alarm_indicator(settings->bit.alarm_enabled, state);
-
-    watch_set_colon();
-
-    // this ensures that none of the timestamp fields will match, so we can re-render them all.
-    state->previous_date_time = 0xFFFFFFFF;
 }
 
 bool simple_clock_bin_led_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
     simple_clock_bin_led_state_t *state = (simple_clock_bin_led_state_t *)context;
-    char buf[11];
-    uint8_t pos;
 
     watch_date_time date_time;
-    uint32_t previous_date_time;
     switch (event.event_type) {
         case EVENT_ACTIVATE:
         case EVENT_TICK:
@@ -114,60 +104,21 @@ bool simple_clock_bin_led_face_loop(movement_event_t event, movement_settings_t
                         } else {
                             // end flashing
                             state->flashing_state = 0;
-                            state->previous_date_time = 0xFFFFFFFF;
+                            movement_clock_invalidate(&state->clock);
                             movement_request_tick_frequency(1);
                             watch_set_colon();
                         }
                     }
                 }
             } else {
-                previous_date_time = state->previous_date_time;
-                state->previous_date_time = date_time.reg;
-
-                // check the battery voltage once a day...
-                if (date_time.unit.day != state->last_battery_check) {
-                    state->last_battery_check = date_time.unit.day;
-                    watch_enable_adc();
-                    uint16_t voltage = watch_get_vcc_voltage();
-                    watch_disable_adc();
-                    // 2.2 volts will happen when the battery has maybe 5-10% remaining?
-                    // we can refine this later.
-                    state->battery_low = (voltage < 2200);
-                }
+                // set the LAP indicator if the battery is low.
+                if (movement_battery_is_low()) watch_set_indicator(WATCH_INDICATOR_LAP);
 
-                // ...and set the LAP indicator if low.
-                if (state->battery_low) watch_set_indicator(WATCH_INDICATOR_LAP);
-
-                if ((date_time.reg >> 6) == (previous_date_time >> 6) && event.event_type != EVENT_LOW_ENERGY_UPDATE) {
-                    // everything before seconds is the same, don't waste cycles setting those segments.
-                    watch_display_character_lp_seconds('0' + date_time.unit.second / 10, 8);
-                    watch_display_character_lp_seconds('0' + date_time.unit.second % 10, 9);
-                    break;
-                } else if ((date_time.reg >> 12) == (previous_date_time >> 12) && event.event_type != EVENT_LOW_ENERGY_UPDATE) {
-                    // everything before minutes is the same.
-                    pos = 6;
-                    sprintf(buf, "%02d%02d", date_time.unit.minute, date_time.unit.second);
+                if (event.event_type == EVENT_LOW_ENERGY_UPDATE) {
+                    movement_clock_draw_low_energy(&state->clock, settings, date_time, NULL);
                 } else {
-                    // other stuff changed; let's do it all.
-                    if (!settings->bit.clock_mode_24h) {
-                        // if we are in 12 hour mode, do some cleanup.
-                        if (date_time.unit.hour < 12) {
-                            watch_clear_indicator(WATCH_INDICATOR_PM);
-                        } else {
-                            watch_set_indicator(WATCH_INDICATOR_PM);
-                        }
-                        date_time.unit.hour %= 12;
-                        if (date_time.unit.hour == 0) date_time.unit.hour = 12;
-                    }
-                    pos = 0;
-                    if (event.event_type == EVENT_LOW_ENERGY_UPDATE) {
-                        if (!watch_tick_animation_is_running()) watch_start_tick_animation(500);
-                        sprintf(buf, "%s%2d%2d%02d  ", watch_utility_get_weekday(date_time), date_time.unit.day, date_time.unit.hour, date_time.unit.minute);
-                    } else {
-                        sprintf(buf, "%s%2d%2d%02d%02d", watch_utility_get_weekday(date_time), date_time.unit.day, date_time.unit.hour, date_time.unit.minute, date_time.unit.second);
-                    }
+                    movement_clock_draw(&state->clock, settings, date_time, NULL);
                 }
-                watch_display_string(buf, pos);
                 // handle alarm indicator
                 if (state->alarm_enabled != settings->bit.alarm_enabled) _update_alarm_indicator(settings->bit.alarm_enabled, state);
             }
@@ -50,13 +50,12 @@
  */
 
 #include "movement.h"
+#include "movement_clock.h"
 
 typedef struct {
-    uint32_t previous_date_time;
-    uint8_t last_battery_check;
+    movement_clock_t clock;
     uint8_t watch_face_index;
     bool signal_enabled;
-    bool battery_low;
     bool alarm_enabled;
     uint8_t flashing_state; // bitmap representing the flashing state. Bit 0 = hours showing, bit 1 = minutes showing,
                             // bit 6 = short break between flashing bits, bit 7 = long break between hours and minutes
@@ -76,6 +75,9 @@ bool simple_clock_bin_led_face_wants_background_task(movement_settings_t *settin
     simple_clock_bin_led_face_loop, \
     simple_clock_bin_led_face_resign, \
     simple_clock_bin_led_face_wants_background_task, \
+    sizeof(simple_clock_bin_led_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // SIIMPLE_CLOCK_BIN_LED_FACE_H_
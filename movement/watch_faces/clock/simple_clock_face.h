@@ -35,13 +35,12 @@
  */
 
 #include "movement.h"
+#include "movement_clock.h"
 
 typedef struct {
-    uint32_t previous_date_time;
-    uint8_t last_battery_check;
+    movement_clock_t clock;
     uint8_t watch_face_index;
     bool signal_enabled;
-    bool battery_low;
     bool alarm_enabled;
 } simple_clock_state_t;
 
@@ -50,6 +49,7 @@ void simple_clock_face_activate(movement_settings_t *settings, void *context);
 bool simple_clock_face_loop(movement_event_t event, movement_settings_t *settings, void *context);
 void simple_clock_face_resign(movement_settings_t *settings, void *context);
 bool simple_clock_face_wants_background_task(movement_settings_t *settings, void *context);
+bool simple_clock_face_draw_low_energy(movement_settings_t *settings, void *context, watch_date_time date_time);
 
 #define simple_clock_face ((const watch_face_t){ \
     simple_clock_face_setup, \
@@ -57,6 +57,9 @@ bool simple_clock_face_wants_background_task(movement_settings_t *settings, void
     simple_clock_face_loop, \
     simple_clock_face_resign, \
     simple_clock_face_wants_background_task, \
+    sizeof(simple_clock_state_t), \
+    0, \
+    simple_clock_face_draw_low_energy, \
 })
 
 #endif // SIMPLE_CLOCK_FACE_H_
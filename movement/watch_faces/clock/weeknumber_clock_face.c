@@ -38,7 +38,7 @@ void weeknumber_clock_face_setup(movement_settings_t *settings, uint8_t watch_fa
     (void) watch_face_index;
 
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(weeknumber_clock_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(weeknumber_clock_state_t));
         weeknumber_clock_state_t *state = (weeknumber_clock_state_t *)*context_ptr;
         state->signal_enabled = false;
         state->watch_face_index = watch_face_index;
@@ -48,9 +48,7 @@ void weeknumber_clock_face_setup(movement_settings_t *settings, uint8_t watch_fa
 void weeknumber_clock_face_activate(movement_settings_t *settings, void *context) {
     weeknumber_clock_state_t *state = (weeknumber_clock_state_t *)context;
 
-    if (watch_tick_animation_is_running()) watch_stop_tick_animation();
-
-    if (settings->bit.clock_mode_24h) watch_set_indicator(WATCH_INDICATOR_24H);
+    movement_clock_activate(&state->clock, settings);
 
     // handle chime indicator
     if (state->signal_enabled) watch_set_indicator(WATCH_INDICATOR_BELL);
@@ -58,67 +56,35 @@ void weeknumber_clock_face_activate(movement_settings_t *settings, void *context
 
     // show alarm indicator if there is an active alarm
     _update_alarm_indicator(settings->bit.alarm_enabled, state);
-
-    watch_set_colon();
-
-    // this ensures that none of the timestamp fields will match, so we can re-render them all.
-    state->previous_date_time = 0xFFFFFFFF;
 }
 
 bool weeknumber_clock_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
     weeknumber_clock_state_t *state = (weeknumber_clock_state_t *)context;
-    char buf[11];
-    uint8_t pos;
+    char buf[3];
 
     watch_date_time date_time;
-    uint32_t previous_date_time;
+    movement_clock_change_t change;
     switch (event.event_type) {
         case EVENT_ACTIVATE:
         case EVENT_TICK:
         case EVENT_LOW_ENERGY_UPDATE:
             date_time = watch_rtc_get_date_time();
-            previous_date_time = state->previous_date_time;
-            state->previous_date_time = date_time.reg;
-
-            // check the battery voltage once a day...
-            if (date_time.unit.day != state->last_battery_check) {
-                state->last_battery_check = date_time.unit.day;
-                watch_enable_adc();
-                uint16_t voltage = watch_get_vcc_voltage();
-                watch_disable_adc();
-                // 2.2 volts will happen when the battery has maybe 5-10% remaining?
-                // we can refine this later.
-                state->battery_low = (voltage < 2200);
-            }
 
-            // ...and set the LAP indicator if low.
-            if (state->battery_low) watch_set_indicator(WATCH_INDICATOR_LAP);
+            // set the LAP indicator if the battery is low.
+            if (movement_battery_is_low()) watch_set_indicator(WATCH_INDICATOR_LAP);
 
-            if ((date_time.reg >> 12) == (previous_date_time >> 12) && event.event_type != EVENT_LOW_ENERGY_UPDATE) {
-                // everything before minutes is the same.
-                pos = 6;
-                sprintf(buf, "%02d%02d", date_time.unit.minute, watch_utility_get_weeknumber(date_time.unit.year, date_time.unit.month, date_time.unit.day));
+            if (event.event_type == EVENT_LOW_ENERGY_UPDATE) {
+                movement_clock_draw_low_energy(&state->clock, settings, date_time, NULL);
             } else {
-                // other stuff changed; let's do it all.
-                if (!settings->bit.clock_mode_24h) {
-                    // if we are in 12 hour mode, do some cleanup.
-                    if (date_time.unit.hour < 12) {
-                        watch_clear_indicator(WATCH_INDICATOR_PM);
-                    } else {
-                        watch_set_indicator(WATCH_INDICATOR_PM);
-                    }
-                    date_time.unit.hour %= 12;
-                    if (date_time.unit.hour == 0) date_time.unit.hour = 12;
-                }
-                pos = 0;
-                if (event.event_type == EVENT_LOW_ENERGY_UPDATE) {
-                    if (!watch_tick_animation_is_running()) watch_start_tick_animation(500);
-                    sprintf(buf, "%s%2d%2d%02d  ", watch_utility_get_weekday(date_time), date_time.unit.day, date_time.unit.hour, date_time.unit.minute);
-                } else {
-                    sprintf(buf, "%s%2d%2d%02d%02d", watch_utility_get_weekday(date_time), date_time.unit.day, date_time.unit.hour, date_time.unit.minute, watch_utility_get_weeknumber(date_time.unit.year, date_time.unit.month, date_time.unit.day));
+                // the week number stands in for the seconds, so only a new minute needs drawing, and only a new day
+                // a new week number.
+                change = movement_clock_update(&state->clock, date_time);
+                if (change >= MOVEMENT_CLOCK_CHANGED_MINUTE) {
+                    buf[0] = '\0';
+                    if (change == MOVEMENT_CLOCK_CHANGED_DAY) watch_fmt_2d(buf, movement_get_calendar()->week_number, '0');
+                    movement_clock_draw_fields(change, settings, date_time, NULL, buf);
                 }
             }
-            watch_display_string(buf, pos);
             // handle alarm indicator
             if (state->alarm_enabled != settings->bit.alarm_enabled) _update_alarm_indicator(settings->bit.alarm_enabled, state);
             break;
@@ -34,13 +34,12 @@
  */
 
 #include "movement.h"
+#include "movement_clock.h"
 
 typedef struct {
-    uint32_t previous_date_time;
-    uint8_t last_battery_check;
+    movement_clock_t clock;
     uint8_t watch_face_index;
     bool signal_enabled;
-    bool battery_low;
     bool alarm_enabled;
 } weeknumber_clock_state_t;
 
@@ -56,6 +55,9 @@ bool weeknumber_clock_face_wants_background_task(movement_settings_t *settings,
     weeknumber_clock_face_loop, \
     weeknumber_clock_face_resign, \
     weeknumber_clock_face_wants_background_task, \
+    sizeof(weeknumber_clock_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // SIMPLE_CLOCK_FACE_H_
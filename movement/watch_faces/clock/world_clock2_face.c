@@ -28,7 +28,7 @@
 #include "world_clock2_face.h"
 #include "watch.h"
 #include "watch_utility.h"
-#include "watch_utility.h"
+#include "movement_tz.h"
 
 static bool refresh_face;
 
@@ -39,6 +39,9 @@ static bool refresh_face;
 /* Activate refresh of time */
 #define REFRESH_TIME        0xffffffff
 
+/* Seconds each zone is shown for while scanning */
+#define SCAN_SECONDS        3
+
 /* List of all time zone names */
 const char *zone_names[] = {
     "UTC",	//  0 :   0:00:00 (UTC)
@@ -107,6 +110,35 @@ static inline uint8_t find_selected_zone(world_clock2_state_t *state, int direct
     return i;
 }
 
+/* Work out the offsets of the selected zones and the current one, if one of them has changed */
+static void update_offsets(world_clock2_state_t *state, bool daylight_saving, uint32_t utc)
+{
+    uint32_t until;
+
+    if (state->offsets_valid && state->offsets_daylight_saving == daylight_saving && utc < state->offsets_until)
+	return;
+
+    state->offsets_until = UINT32_MAX;
+    for (uint8_t i = 0; i < NUM_TIME_ZONES; i++) {
+	if (!state->zones[i].selected && i != state->current_zone)
+	    continue;
+	state->offsets[i] = movement_tz_get_offset(i, daylight_saving, utc, &until);
+	if (until < state->offsets_until)
+	    state->offsets_until = until;
+    }
+    state->offsets_daylight_saving = daylight_saving;
+    state->offsets_valid = true;
+}
+
+/* Move on to another zone; its offset may not have been worked out */
+static void change_zone(world_clock2_state_t *state, uint8_t zone)
+{
+    if (!state->zones[zone].selected)
+	state->offsets_valid = false;
+    state->current_zone = zone;
+    state->previous_date_time = REFRESH_TIME;
+}
+
 /* Beep when zone is enabled. An octave up */
 static void beep_enable() {
     watch_buzzer_play_note(BUZZER_NOTE_G7, 50);
@@ -127,7 +159,7 @@ void world_clock2_face_setup(movement_settings_t *settings, uint8_t watch_face_i
     (void) watch_face_index;
 
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(world_clock2_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(world_clock2_state_t));
         memset(*context_ptr, 0, sizeof(world_clock2_state_t));
 
         /* Start in settings mode */
@@ -162,9 +194,9 @@ static bool mode_display(movement_event_t event, movement_settings_t *settings,
     char buf[11];
     uint8_t pos;
 
-    uint32_t timestamp;
     uint32_t previous_date_time;
     watch_date_time date_time;
+    uint32_t utc;
 
     switch (event.event_type) {
 	case EVENT_ACTIVATE:
@@ -176,23 +208,40 @@ static bool mode_display(movement_event_t event, movement_settings_t *settings,
 		watch_set_colon();
                 if (settings->bit.clock_mode_24h)
                     watch_set_indicator(WATCH_INDICATOR_24H);
+		if (state->scanning)
+		    watch_set_indicator(WATCH_INDICATOR_LAP);
 
                 state->previous_date_time = REFRESH_TIME;
+                state->scan_countdown = SCAN_SECONDS;
                 refresh_face = false;
             }
 
-            /* Determine current time at time zone and store date/time */
-	    date_time = watch_rtc_get_date_time();
-	    timestamp = watch_utility_date_time_to_unix_time(date_time, movement_timezone_offsets[settings->bit.time_zone] * 60);
-	    date_time = watch_utility_date_time_from_unix_time(timestamp, movement_timezone_offsets[state->current_zone] * 60);
+	    /* Scan on to the next selected zone every few seconds, or every minute in low energy mode */
+	    if (state->scanning && (event.event_type == EVENT_LOW_ENERGY_UPDATE ||
+				    (event.event_type == EVENT_TICK && --state->scan_countdown == 0))) {
+		change_zone(state, find_selected_zone(state, FORWARD));
+		state->scan_countdown = SCAN_SECONDS;
+	    }
+
+	    /* One UTC time for all the zones */
+	    utc = watch_utility_date_time_to_unix_time(movement_get_local_date_time(), movement_get_current_timezone_offset() * 60);
 	    previous_date_time = state->previous_date_time;
-	    state->previous_date_time = date_time.reg;
 
-	    if ((date_time.reg >> 6) == (previous_date_time >> 6) && event.event_type != EVENT_LOW_ENERGY_UPDATE) {
-                /* Everything before seconds is the same, don't waste cycles setting those segments. */
+	    if (previous_date_time != REFRESH_TIME && utc / 60 == state->previous_minute && event.event_type != EVENT_LOW_ENERGY_UPDATE) {
+                /* Only the seconds have changed, and they're the same in every zone. */
 		pos = 8;
-		sprintf(buf, "%02d", date_time.unit.second);
-	    } else if ((date_time.reg >> 12) == (previous_date_time >> 12) && event.event_type != EVENT_LOW_ENERGY_UPDATE) {
+		sprintf(buf, "%02d", (int) (utc % 60));
+		watch_display_string(buf, pos);
+		break;
+	    }
+
+            /* Determine current time at time zone and store date/time */
+	    update_offsets(state, settings->bit.daylight_saving, utc);
+	    date_time = watch_utility_date_time_from_unix_time(utc + state->offsets[state->current_zone] * 60, 0);
+	    state->previous_date_time = date_time.reg;
+	    state->previous_minute = utc / 60;
+
+	    if ((date_time.reg >> 12) == (previous_date_time >> 12) && event.event_type != EVENT_LOW_ENERGY_UPDATE) {
 		/* Everything before minutes is the same. */
 		pos = 6;
 		sprintf(buf, "%02d%02d", date_time.unit.minute, date_time.unit.second);
@@ -232,22 +281,29 @@ static bool mode_display(movement_event_t event, movement_settings_t *settings,
 	    watch_display_string(buf, pos);
 	    break;
 	case EVENT_ALARM_BUTTON_UP:
-	    state->current_zone = find_selected_zone(state, FORWARD);
-            state->previous_date_time = REFRESH_TIME;
+	    change_zone(state, find_selected_zone(state, FORWARD));
+            state->scan_countdown = SCAN_SECONDS;
 	    break;
 	case EVENT_LIGHT_BUTTON_DOWN:
 	    /* Do nothing. */
 	    break;
 	case EVENT_LIGHT_BUTTON_UP:
-	    state->current_zone = find_selected_zone(state, BACKWARD);
-            state->previous_date_time = REFRESH_TIME;
+	    change_zone(state, find_selected_zone(state, BACKWARD));
+            state->scan_countdown = SCAN_SECONDS;
 	    break;
 	case EVENT_LIGHT_LONG_PRESS:
-	    movement_illuminate_led();
+	    /* Start or stop scanning */
+	    state->scanning = !state->scanning;
+	    state->scan_countdown = SCAN_SECONDS;
+	    if (state->scanning)
+		watch_set_indicator(WATCH_INDICATOR_LAP);
+	    else
+		watch_clear_indicator(WATCH_INDICATOR_LAP);
 	    break;
 	case EVENT_ALARM_LONG_PRESS:
 	    /* Switch to settings mode */
 	    state->current_mode = WORLD_CLOCK2_MODE_SETTINGS;
+	    watch_clear_indicator(WATCH_INDICATOR_LAP);
 	    refresh_face = true;
             movement_request_tick_frequency(1);
 
@@ -325,8 +381,9 @@ static bool mode_settings(movement_event_t event, movement_settings_t *settings,
 	    if (!state->zones[state->current_zone].selected)
 		state->current_zone = find_selected_zone(state, FORWARD);
 
-	    /* Switch to display mode */
+	    /* Switch to display mode; the selection may have changed */
 	    state->current_mode = WORLD_CLOCK2_MODE_DISPLAY;
+	    state->offsets_valid = false;
 	    refresh_face = true;
             movement_request_tick_frequency(1);
 
@@ -81,8 +81,17 @@
  *    face simply shows UTC.
  *  * A long press on the ALARM button enters settings mode and enables the
  *    user to re-configure the selected time zones.
- *  * A long press on the LIGHT button activates the LED illumination of the
- *    watch.
+ *  * A long press on the LIGHT button starts or stops scanning: the face
+ *    moves on to the next selected time zone by itself every few seconds
+ *    (every minute in low energy mode), and the LAP indicator is shown.
+ *    Scanning takes the LIGHT button's long press, so the LED isn't
+ *    available in display mode.
+ *
+ * The offsets of all the selected time zones are worked out together, and
+ * only again when one of them changes, as they do with daylight saving time
+ * on. Each second, the face works out UTC once and adds the zone's offset to
+ * it, and the date only when the minute changes, so twenty selected zones
+ * cost what one does.
  */
 
 /* Number of zones. See movement_timezone_offsets. */
@@ -104,6 +113,13 @@ typedef struct {
     world_clock2_mode_t current_mode;
     uint8_t current_zone;
     uint32_t previous_date_time;
+    uint32_t previous_minute;           // UTC minute of previous_date_time
+    int16_t offsets[NUM_TIME_ZONES];    // of the selected zones and the current one, in minutes
+    uint32_t offsets_until;             // UTC timestamp at which one of them changes
+    bool offsets_valid;
+    bool offsets_daylight_saving;       // the daylight saving setting they were worked out with
+    bool scanning;
+    uint8_t scan_countdown;
 } world_clock2_state_t;
 
 void world_clock2_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void **context_ptr);
@@ -117,6 +133,9 @@ void world_clock2_face_resign(movement_settings_t *settings, void *context);
     world_clock2_face_loop, \
     world_clock2_face_resign, \
     NULL, \
+    sizeof(world_clock2_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif /* WORLD_CLOCK2_FACE_H_ */
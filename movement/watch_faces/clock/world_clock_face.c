@@ -32,7 +32,7 @@ void world_clock_face_setup(movement_settings_t *settings, uint8_t watch_face_in
     (void) settings;
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(world_clock_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(world_clock_state_t));
         memset(*context_ptr, 0, sizeof(world_clock_state_t));
         uint8_t backup_register = movement_claim_backup_register();
         if (backup_register) {
@@ -52,66 +52,25 @@ void world_clock_face_activate(movement_settings_t *settings, void *context) {
 }
 
 static bool world_clock_face_do_display_mode(movement_event_t event, movement_settings_t *settings, world_clock_state_t *state) {
-    char buf[11];
-    uint8_t pos;
+    char label[3];
 
-    uint32_t timestamp;
-    uint32_t previous_date_time;
     watch_date_time date_time;
     switch (event.event_type) {
         case EVENT_ACTIVATE:
-            if (settings->bit.clock_mode_24h) watch_set_indicator(WATCH_INDICATOR_24H);
-            watch_set_colon();
-            state->previous_date_time = 0xFFFFFFFF;
+            movement_clock_activate(&state->clock, settings);
             // fall through
         case EVENT_TICK:
         case EVENT_LOW_ENERGY_UPDATE:
-            date_time = watch_rtc_get_date_time();
-            timestamp = watch_utility_date_time_to_unix_time(date_time, movement_timezone_offsets[settings->bit.time_zone] * 60);
-            date_time = watch_utility_date_time_from_unix_time(timestamp, movement_timezone_offsets[state->settings.bit.timezone_index] * 60);
-            previous_date_time = state->previous_date_time;
-            state->previous_date_time = date_time.reg;
-
-            if ((date_time.reg >> 6) == (previous_date_time >> 6) && event.event_type != EVENT_LOW_ENERGY_UPDATE) {
-                // everything before seconds is the same, don't waste cycles setting those segments.
-                pos = 8;
-                sprintf(buf, "%02d", date_time.unit.second);
-            } else if ((date_time.reg >> 12) == (previous_date_time >> 12) && event.event_type != EVENT_LOW_ENERGY_UPDATE) {
-                // everything before minutes is the same.
-                pos = 6;
-                sprintf(buf, "%02d%02d", date_time.unit.minute, date_time.unit.second);
+            date_time = movement_get_date_time_in_zone(state->settings.bit.timezone_index, state->settings.bit.daylight_saving);
+            label[0] = movement_valid_position_0_chars[state->settings.bit.char_0];
+            label[1] = movement_valid_position_1_chars[state->settings.bit.char_1];
+            label[2] = '\0';
+
+            if (event.event_type == EVENT_LOW_ENERGY_UPDATE) {
+                movement_clock_draw_low_energy(&state->clock, settings, date_time, label);
             } else {
-                // other stuff changed; let's do it all.
-                if (!settings->bit.clock_mode_24h) {
-                    // if we are in 12 hour mode, do some cleanup.
-                    if (date_time.unit.hour < 12) {
-                        watch_clear_indicator(WATCH_INDICATOR_PM);
-                    } else {
-                        watch_set_indicator(WATCH_INDICATOR_PM);
-                    }
-                    date_time.unit.hour %= 12;
-                    if (date_time.unit.hour == 0) date_time.unit.hour = 12;
-                }
-                pos = 0;
-                if (event.event_type == EVENT_LOW_ENERGY_UPDATE) {
-                    if (!watch_tick_animation_is_running()) watch_start_tick_animation(500);
-                    sprintf(buf, "%c%c%2d%2d%02d  ",
-                        movement_valid_position_0_chars[state->settings.bit.char_0],
-                        movement_valid_position_1_chars[state->settings.bit.char_1],
-                        date_time.unit.day,
-                        date_time.unit.hour,
-                        date_time.unit.minute);
-                } else {
-                    sprintf(buf, "%c%c%2d%2d%02d%02d",
-                        movement_valid_position_0_chars[state->settings.bit.char_0],
-                        movement_valid_position_1_chars[state->settings.bit.char_1],
-                        date_time.unit.day,
-                        date_time.unit.hour,
-                        date_time.unit.minute,
-                        date_time.unit.second);
-                }
+                movement_clock_draw(&state->clock, settings, date_time, label);
             }
-            watch_display_string(buf, pos);
             break;
         case EVENT_ALARM_LONG_PRESS:
             movement_request_tick_frequency(4);
@@ -132,7 +91,7 @@ static bool _world_clock_face_do_settings_mode(movement_event_t event, movement_
             return false;
         case EVENT_LIGHT_BUTTON_DOWN:
             state->current_screen++;
-            if (state->current_screen > 3) {
+            if (state->current_screen > 4) {
                 movement_request_tick_frequency(1);
                 state->current_screen = 0;
                 if (state->backup_register) watch_store_backup_data(state->settings.reg, state->backup_register);
@@ -158,6 +117,9 @@ static bool _world_clock_face_do_settings_mode(movement_event_t event, movement_
                     state->settings.bit.timezone_index++;
                     if (state->settings.bit.timezone_index > 40) state->settings.bit.timezone_index = 0;
                     break;
+                case 4:
+                    state->settings.bit.daylight_saving = !state->settings.bit.daylight_saving;
+                    break;
             }
             break;
         case EVENT_TIMEOUT:
@@ -168,12 +130,20 @@ static bool _world_clock_face_do_settings_mode(movement_event_t event, movement_
     }
 
     char buf[13];
-    sprintf(buf, "%c%c %3d%02d  ",
-        movement_valid_position_0_chars[state->settings.bit.char_0],
-        movement_valid_position_1_chars[state->settings.bit.char_1],
-        (int8_t) (movement_timezone_offsets[state->settings.bit.timezone_index] / 60),
-        (int8_t) (movement_timezone_offsets[state->settings.bit.timezone_index] % 60) * (movement_timezone_offsets[state->settings.bit.timezone_index] < 0 ? -1 : 1));
-    watch_set_colon();
+    if (state->current_screen < 4) {
+        sprintf(buf, "%c%c %3d%02d  ",
+            movement_valid_position_0_chars[state->settings.bit.char_0],
+            movement_valid_position_1_chars[state->settings.bit.char_1],
+            (int8_t) (movement_timezone_offsets[state->settings.bit.timezone_index] / 60),
+            (int8_t) (movement_timezone_offsets[state->settings.bit.timezone_index] % 60) * (movement_timezone_offsets[state->settings.bit.timezone_index] < 0 ? -1 : 1));
+        watch_set_colon();
+    } else {
+        sprintf(buf, "%c%c   dS  %c",
+            movement_valid_position_0_chars[state->settings.bit.char_0],
+            movement_valid_position_1_chars[state->settings.bit.char_1],
+            state->settings.bit.daylight_saving ? 'y' : 'n');
+        watch_clear_colon();
+    }
     watch_clear_indicator(WATCH_INDICATOR_PM);
 
     // blink up the parameter we're setting
@@ -187,6 +157,9 @@ static bool _world_clock_face_do_settings_mode(movement_event_t event, movement_
                 watch_clear_colon();
                 sprintf(buf + 3, "       ");
                 break;
+            case 4:
+                buf[9] = ' ';
+                break;
         }
     }
 
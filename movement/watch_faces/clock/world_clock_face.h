@@ -39,20 +39,25 @@
  * to advance through the available letters in the first slot, then press the
  * LIGHT button to move to the second letter. Finally, press LIGHT again to move
  * to the time zone setting, and press ALARM to cycle through the available time
- * zones. Press LIGHT one last time to return to the world clock display.
+ * zones. Press LIGHT again to move to the daylight saving setting (dS), and
+ * press ALARM to turn it on (y) or off (n). Press LIGHT one last time to return
+ * to the world clock display.
  *
- * Note that the second slot cannot display all letters or numbers. Also note
- * that at this time, time zones do not automatically update for daylight saving
- * time; you will need to manually adjust this field each spring and fall.
+ * Note that the second slot cannot display all letters or numbers. With the
+ * daylight saving setting on, the time zone follows daylight saving time where
+ * the watch knows its rule; this is separate from the setting for the watch's
+ * own time zone.
  */
 
 #include "movement.h"
+#include "movement_clock.h"
 
 typedef union {
     struct {
         uint8_t char_0;
         uint8_t char_1;
         uint8_t timezone_index;
+        bool daylight_saving;
     } bit;
     uint32_t reg;
 } world_clock_settings_t;
@@ -61,7 +66,7 @@ typedef struct {
     world_clock_settings_t settings;
     uint8_t backup_register;
     uint8_t current_screen;
-    uint32_t previous_date_time;
+    movement_clock_t clock;
 } world_clock_state_t;
 
 void world_clock_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
@@ -77,6 +82,9 @@ uint8_t world_clock_face_get_weekday(uint16_t day, uint16_t month, uint16_t year
     world_clock_face_loop, \
     world_clock_face_resign, \
     NULL, \
+    sizeof(world_clock_state_t), \
+    MOVEMENT_FACE_EAGER_SETUP, \
+    NULL, \
 })
 
 #endif // WORLD_CLOCK_FACE_H_
@@ -94,7 +94,7 @@ void wyoscan_face_setup(movement_settings_t *settings, uint8_t watch_face_index,
     (void) settings;
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(wyoscan_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(wyoscan_state_t));
         memset(*context_ptr, 0, sizeof(wyoscan_state_t));
         // Do any one-time tasks in here; the inside of this conditional happens only at boot.
     }
@@ -104,89 +104,114 @@ void wyoscan_face_setup(movement_settings_t *settings, uint8_t watch_face_index,
 void wyoscan_face_activate(movement_settings_t *settings, void *context) {
     (void) settings;
     wyoscan_state_t *state = (wyoscan_state_t *)context;
-    movement_request_tick_frequency(32);
     state->total_frames = 64;
+    // Movement has just cleared the display, so start the scan over on a blank one.
+    state->animate = false;
+    memset(state->framebuffer, 0, sizeof(state->framebuffer));
+}
+
+static inline void _wyoscan_set_pixel(wyoscan_state_t *state, uint8_t com, uint8_t seg) {
+    state->framebuffer[com] |= (uint32_t)1 << seg;
+}
+
+static inline void _wyoscan_clear_pixel(wyoscan_state_t *state, uint8_t com, uint8_t seg) {
+    state->framebuffer[com] &= ~((uint32_t)1 << seg);
+}
+
+// advances the scan by one frame, drawing into the state's framebuffer rather than the display's.
+static void _wyoscan_step(wyoscan_state_t *state) {
+    watch_date_time date_time;
+    if (!state->animate) {
+        date_time = watch_rtc_get_date_time();
+        state->start = 0; 
+        state->end = 0;
+        state->animation = 0;
+        state->animate = true;
+        state->time_digits[0] = date_time.unit.hour / 10;
+        state->time_digits[1] = date_time.unit.hour % 10;
+        state->time_digits[2] = date_time.unit.minute / 10;
+        state->time_digits[3] = date_time.unit.minute % 10;
+        state->time_digits[4] = date_time.unit.second / 10;
+        state->time_digits[5] = date_time.unit.second % 10;
+    }
+    // if we have reached the max number of illuminated segments, we clear the oldest one
+    if ((state->end + 1) % MAX_ILLUMINATED_SEGMENTS == state->start) {
+        // clear the oldest pixel if it's not 'X'
+        if (state->illuminated_segments[state->start][0] != 99 && state->illuminated_segments[state->start][1] != 99) {
+            _wyoscan_clear_pixel(state, state->illuminated_segments[state->start][0], state->illuminated_segments[state->start][1]);
+        }
+        // increment the start index to point to the next oldest pixel
+        state->start = (state->start + 1) % MAX_ILLUMINATED_SEGMENTS;
+    }
+    if (state->animation < state->total_frames - MAX_ILLUMINATED_SEGMENTS) {
+        if (state->animation % 32 == 0) {
+            // the colon
+            if (state->colon) {
+                _wyoscan_set_pixel(state, 1, 16);
+            } else {
+                _wyoscan_clear_pixel(state, 1, 16);
+            }
+            state->colon = !state->colon;
+        }
+        
+        // calculate the start position for the current frame
+        state->position = (state->animation / 8) % 6;
+        // calculate the current segment for the current digit
+        state->segment = state->animation % strlen(segment_map[state->time_digits[state->position]]);
+        // get the segments for the current digit
+        state->segments = segment_map[state->time_digits[state->position]];
+        
+        if (state->segments[state->segment] == 'X') {
+            // if 'X', skip this frame
+            state->illuminated_segments[state->end][0] = 99;
+            state->illuminated_segments[state->end][1] = 99;
+            state->end = (state->end + 1) % MAX_ILLUMINATED_SEGMENTS;
+            state->animation = (state->animation + 1);
+            return;
+        }
+
+        // calculate the animation frame
+        state->x = clock_mapping[state->position][state->segments[state->segment]-'A'][0];
+        state->y = clock_mapping[state->position][state->segments[state->segment]-'A'][1];
+        
+        // set the new pixel
+        _wyoscan_set_pixel(state, state->x, state->y);
+        
+        // store this pixel in the buffer
+        state->illuminated_segments[state->end][0] = state->x;
+        state->illuminated_segments[state->end][1] = state->y;
+        // increment the end index to the next position
+        state->end = (state->end + 1) % MAX_ILLUMINATED_SEGMENTS;
+    } 
+    else if (state->animation >= state->total_frames - MAX_ILLUMINATED_SEGMENTS && state->animation < state->total_frames) {
+        state->end = (state->end + 1) % MAX_ILLUMINATED_SEGMENTS;
+    }
+    else {
+        // reset the animation state
+        state->animate = false;
+    }
+    state->animation = (state->animation + 1);
+}
+
+// works out the next batch of frames, and hands them to the display to put up at 32 frames per second; we hear
+// back with EVENT_ANIMATION_DONE as the last one goes up, rather than waking for every frame.
+static void _wyoscan_play_next_frames(wyoscan_state_t *state) {
+    for (uint8_t i = 0; i < WATCH_DISPLAY_PLAYBACK_MAX_FRAMES; i++) {
+        _wyoscan_step(state);
+        memcpy(state->frames[i].segments, state->framebuffer, sizeof(state->framebuffer));
+    }
+    movement_play_frames(state->frames, WATCH_DISPLAY_PLAYBACK_MAX_FRAMES, 1000 / 32);
 }
 
 bool wyoscan_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
     wyoscan_state_t *state = (wyoscan_state_t *)context;
 
-    watch_date_time date_time;
     switch (event.event_type) {
         case EVENT_ACTIVATE:
+        case EVENT_ANIMATION_DONE:
+            _wyoscan_play_next_frames(state);
             break;
-        case EVENT_TICK:            
-            if (!state->animate) {
-                date_time = watch_rtc_get_date_time();
-                state->start = 0; 
-                state->end = 0;
-                state->animation = 0;
-                state->animate = true;
-                state->time_digits[0] = date_time.unit.hour / 10;
-                state->time_digits[1] = date_time.unit.hour % 10;
-                state->time_digits[2] = date_time.unit.minute / 10;
-                state->time_digits[3] = date_time.unit.minute % 10;
-                state->time_digits[4] = date_time.unit.second / 10;
-                state->time_digits[5] = date_time.unit.second % 10;
-            }
-            if ( state->animate ) {
-                // if we have reached the max number of illuminated segments, we clear the oldest one
-                if ((state->end + 1) % MAX_ILLUMINATED_SEGMENTS == state->start) {
-                    // clear the oldest pixel if it's not 'X'
-                    if (state->illuminated_segments[state->start][0] != 99 && state->illuminated_segments[state->start][1] != 99) {
-                        watch_clear_pixel(state->illuminated_segments[state->start][0], state->illuminated_segments[state->start][1]);
-                    }
-                    // increment the start index to point to the next oldest pixel
-                    state->start = (state->start + 1) % MAX_ILLUMINATED_SEGMENTS;
-                }
-                if (state->animation < state->total_frames - MAX_ILLUMINATED_SEGMENTS) {
-                    if (state->animation % 32 == 0) {
-                        if (state->colon) {
-                            watch_set_colon();
-                        } else {
-                            watch_clear_colon();
-                        }
-                        state->colon = !state->colon;
-                    }
-                    
-                    // calculate the start position for the current frame
-                    state->position = (state->animation / 8) % 6;
-                    // calculate the current segment for the current digit
-                    state->segment = state->animation % strlen(segment_map[state->time_digits[state->position]]);
-                    // get the segments for the current digit
-                    state->segments = segment_map[state->time_digits[state->position]];
-                    
-                    if (state->segments[state->segment] == 'X') {
-                        // if 'X', skip this frame
-                        state->illuminated_segments[state->end][0] = 99;
-                        state->illuminated_segments[state->end][1] = 99;
-                        state->end = (state->end + 1) % MAX_ILLUMINATED_SEGMENTS;
-                        state->animation = (state->animation + 1);
-                        break;
-                    }
-
-                    // calculate the animation frame
-                    state->x = clock_mapping[state->position][state->segments[state->segment]-'A'][0];
-                    state->y = clock_mapping[state->position][state->segments[state->segment]-'A'][1];
-                    
-                    // set the new pixel
-                    watch_set_pixel(state->x, state->y);
-                    
-                    // store this pixel in the buffer
-                    state->illuminated_segments[state->end][0] = state->x;
-                    state->illuminated_segments[state->end][1] = state->y;
-                    // increment the end index to the next position
-                    state->end = (state->end + 1) % MAX_ILLUMINATED_SEGMENTS;
-                } 
-                else if (state->animation >= state->total_frames - MAX_ILLUMINATED_SEGMENTS && state->animation < state->total_frames) {
-                    state->end = (state->end + 1) % MAX_ILLUMINATED_SEGMENTS;
-                }
-                else {
-                    // reset the animation state
-                    state->animate = false;
-                }
-                state->animation = (state->animation + 1);
-            } 
+        case EVENT_TICK:
             break;
         case EVENT_LOW_ENERGY_UPDATE:
             break;
@@ -41,6 +41,10 @@
  * It is giving me a stack overflow after about 2.5 cycles of the time display
  * in the emulator, but it works fine on the watch.
  *
+ * The frames are worked out 16 at a time and handed to the display, which puts
+ * them up by itself (see movement_play_frames), so the watch wakes twice a
+ * second rather than 32 times.
+ *
  * I'd like to make something for the low energy mode, but I haven't thought
  * about how that might work, right now it just freezes in low energy mode
  * until you press the 12-24HR button.
@@ -71,6 +75,8 @@ typedef struct {
     uint8_t x, y;
     uint32_t time_digits[6];
     uint32_t illuminated_segments[MAX_ILLUMINATED_SEGMENTS][2]; 
+    uint32_t framebuffer[3];
+    watch_display_frame_t frames[WATCH_DISPLAY_PLAYBACK_MAX_FRAMES];
 } wyoscan_state_t;
 
 void wyoscan_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
@@ -85,6 +91,9 @@ bool wyoscan_face_wants_background_task(movement_settings_t *settings, void *con
     wyoscan_face_loop, \
     wyoscan_face_resign, \
     NULL, \
+    sizeof(wyoscan_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // WYOSCAN_FACE_H_
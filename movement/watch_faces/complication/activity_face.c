@@ -31,6 +31,8 @@
 #include <string.h>
 #include "activity_face.h"
 #include "chirpy_tx.h"
+#include "movement_chirpy.h"
+#include "movement_log.h"
 #include "watch.h"
 #include "watch_utility.h"
 
@@ -41,7 +43,7 @@
 // You can also add new items to activity_names, but don't redefine or remove existing ones.
 
 // If a logged activity is shorter than this, then it won't be added to log when it ends.
-// This way scarce log slots are not taken up by aborted events that weren't real activities.
+// This way the log isn't cluttered with aborted events that weren't real activities.
 static const uint16_t activity_min_length_sec = 60;
 
 // Supported activities. ID of activity is index in this buffer
@@ -72,36 +74,34 @@ static const uint8_t num_enabled_activities = sizeof(enabled_activities) / sizeo
 // End configurable section
 // ===========================================================================
 
-// One logged activity
-typedef struct __attribute__((__packed__)) {
-    // Activity's start time
-    watch_date_time start_time;
-
-    // Total duration of activity, including time spend in paus
-    uint16_t total_sec;
-
-    // Number of seconds the activity was paused
-    uint16_t pause_sec;
+// One logged activity, as it's stored in the log. Multi-byte fields go high byte first, which is also how they're
+// chirped: from one activity to the next, the high bytes of the start time barely change, so the chirped log
+// (sent as each byte's difference from the record before) is mostly runs of zeros.
+typedef struct {
+    // Activity's start time, in minutes since the start of 2020 (local time)
+    uint8_t start_minute[3];
 
     // Type of activity (index in activity_names)
     uint8_t activity_type;
 
-} activity_item_t;
+    // Total duration of activity, including time spend in paus
+    uint8_t total_sec[2];
 
-#define MAX_ACTIVITY_SECONDS 28800 // 8 hours = 28800 sec
+    // Number of seconds the activity was paused
+    uint8_t pause_sec[2];
 
-// Size of (fixed) buffer to log activites. Takes up x9 bytes in SRAM if face is installed.
-#define ACTIVITY_LOG_SZ 99
+} activity_record_t;
 
-// Number of activities in buffer.
-static uint8_t activity_log_count = 0;
+#define MAX_ACTIVITY_SECONDS 28800 // 8 hours = 28800 sec
 
-// Buffer with all logged activities.
-static activity_item_t activity_log_buffer[ACTIVITY_LOG_SZ];
+// The log keeps activities in flash, in ACTIVITY_LOG_FILES files of ACTIVITY_LOG_RECORDS_PER_FILE each. Once they're
+// all full, the oldest file is reused, so the log always holds at least the last (files - 1) * records activities.
+#define ACTIVITY_LOG_NAME "activity"
+#define ACTIVITY_LOG_RECORDS_PER_FILE 64
+#define ACTIVITY_LOG_FILES 4
 
-#define CHIRPY_PREFIX_LEN 2
-// First two bytes chirped out, to identify transmission as from the activity face
-static const uint8_t activity_chirpy_prefix[CHIRPY_PREFIX_LEN] = {0x27, 0x00};
+// Minutes from the Unix epoch to the start of 2020, where activity_record_t's start times count from.
+#define ACTIVITY_EPOCH_MINUTES 26297280
 
 // The face's different UI modes (views).
 typedef enum {
@@ -140,17 +140,17 @@ typedef struct {
     // Total paused seconds in current log
     uint16_t curr_pause_sec;
 
-    // Helps us handle 1/64 ticks during transmission; including countdown timer
+    // Helps us handle 1/64 ticks during the countdown; tick_fun is NULL once the transmission has started
     chirpy_tick_state_t chirpy_tick_state;
 
-    // Used by chirpy encoder during transmission
-    chirpy_encoder_state_t chirpy_encoder_state;
-
     // 0: Running normally
     // 1: In LE mode
     // 2: Just woke up from LE mode. Will go to 0 after ignoring ALARM_BUTTON_UP.
     uint8_t le_state;
 
+    // Logged activities
+    movement_log_t log;
+
 } activity_state_t;
 
 #define ACTIVITY_BUF_SZ 14
@@ -158,19 +158,8 @@ typedef struct {
 // Temp buffer used for sprintf'ing content for the display.
 char activity_buf[ACTIVITY_BUF_SZ];
 
-// Needed by _activity_get_next_byte to keep track of where we are in transmission
-uint16_t *activity_seq_pos;
-
-static void _activity_clear_buffers() {
-    // Clear activity buffer; 0xcd is good for diagnostics
-    memset(activity_log_buffer, 0xcd, ACTIVITY_LOG_SZ * sizeof(activity_item_t));
-    // Clear display buffer
-    memset(activity_buf, 0, ACTIVITY_BUF_SZ);
-}
-
 static void _activity_display_choice(activity_state_t *state);
 static void _activity_update_logging_screen(movement_settings_t *settings, activity_state_t *state);
-static uint8_t _activity_get_next_byte(uint8_t *next_byte);
 
 void activity_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void **context_ptr) {
     (void)settings;
@@ -178,8 +167,9 @@ void activity_face_setup(movement_settings_t *settings, uint8_t watch_face_index
     if (*context_ptr == NULL) {
         *context_ptr = malloc(sizeof(activity_state_t));
         memset(*context_ptr, 0, sizeof(activity_state_t));
-        // This happens only at boot
-        _activity_clear_buffers();
+        // This happens only at boot: pick up the activities logged before
+        activity_state_t *state = (activity_state_t *)*context_ptr;
+        movement_log_init(&state->log, ACTIVITY_LOG_NAME, sizeof(activity_record_t), ACTIVITY_LOG_RECORDS_PER_FILE, ACTIVITY_LOG_FILES);
     }
     // Do any pin or peripheral setup here; this will be called whenever the watch wakes from deep sleep.
 }
@@ -217,16 +207,10 @@ static void _activity_activate(movement_settings_t *settings, activity_state_t *
 
 static void _activity_display_choice(activity_state_t *state) {
     watch_display_string("AC", 0);
-    // If buffer is full: We say "FULL"
-    if (activity_log_count >= ACTIVITY_LOG_SZ) {
-        watch_display_string(" FULL ", 4);
-    }
-    // Otherwise, we show currently activity
-    else {
-        uint8_t activity_ix = enabled_activities[state->type_ix];
-        const char *name = activity_names[activity_ix];
-        watch_display_string((char *)name, 4);
-    }
+    // Show currently selected activity
+    uint8_t activity_ix = enabled_activities[state->type_ix];
+    const char *name = activity_names[activity_ix];
+    watch_display_string((char *)name, 4);
 }
 
 const uint8_t activity_anim_pixels[][2] = {
@@ -318,35 +302,26 @@ static void _activity_update_logging_screen(movement_settings_t *settings, activ
 static void _activity_quit_chirping() {
     watch_clear_indicator(WATCH_INDICATOR_BELL);
     watch_set_buzzer_off();
+    movement_chirpy_stop();
     movement_request_tick_frequency(1);
 }
 
-static void _activity_chirp_tick_transmit(void *context) {
-    activity_state_t *state = (activity_state_t *)context;
-
-    uint8_t tone = chirpy_get_next_tone(&state->chirpy_encoder_state);
-    // Transmission over?
-    if (tone == 255) {
-        _activity_quit_chirping();
-        state->mode = ACTM_CHIRP;
-        state->counter = 0;
-        watch_display_string("AC  CHIRP ", 0);
-        return;
-    }
-    uint16_t period = chirpy_get_tone_period(tone);
-    watch_set_buzzer_period(period);
-    watch_set_buzzer_on();
-}
-
 static void _activity_chirp_tick_countdown(void *context) {
     activity_state_t *state = (activity_state_t *)context;
 
-    // Countdown over: start actual broadcast
+    // Countdown over: start actual broadcast. Movement times the tones, so we only need to look in once a second.
     if (state->chirpy_tick_state.seq_pos == 8 * 3) {
-        state->chirpy_tick_state.tick_compare = 3;
-        state->chirpy_tick_state.tick_count = 2;  // tick_compare - 1, so it starts immediately
         state->chirpy_tick_state.seq_pos = 0;
-        state->chirpy_tick_state.tick_fun = _activity_chirp_tick_transmit;
+        state->chirpy_tick_state.tick_fun = NULL;
+        movement_request_tick_frequency(1);
+        sprintf(activity_buf, "%3lu", movement_log_count(&state->log));
+        watch_display_string(activity_buf, 5);
+        if (!movement_chirpy_send_log(&state->log, true, MOVEMENT_CHIRPY_RATE_NORMAL, NULL)) {
+            _activity_quit_chirping();
+            state->mode = ACTM_CHIRP;
+            state->counter = 0;
+            watch_display_string("AC  CHIRP ", 0);
+        }
         return;
     }
     // Sound or turn off buzzer
@@ -366,78 +341,23 @@ static void _activity_chirp_tick_countdown(void *context) {
     ++state->chirpy_tick_state.seq_pos;
 }
 
-static uint8_t _activity_get_next_byte(uint8_t *next_byte) {
-    uint16_t num_bytes = 2 + activity_log_count * sizeof(activity_item_t);
-    uint16_t pos = *activity_seq_pos;
-
-    // Init counter
-    if (pos == 0) {
-        sprintf(activity_buf, "%3d", activity_log_count);
-        watch_display_string(activity_buf, 5);
-    }
-
-    if (pos == num_bytes) {
-        return 0;
-    }
-    // Two-byte prefix
-    if (pos < 2) {
-        (*next_byte) = activity_chirpy_prefix[pos];
-    }
-    // Data
-    else {
-        pos -= 2;
-        uint16_t ix = pos / sizeof(activity_item_t);
-        const activity_item_t *itm = &activity_log_buffer[ix];
-        uint16_t ofs = pos % sizeof(activity_item_t);
-
-        // Update counter when starting new item
-        if (ofs == 0) {
-            sprintf(activity_buf, "%3d", activity_log_count - ix);
-            watch_display_string(activity_buf, 5);
-        }
-
-        // Do this the hard way, byte by byte, to avoid high/low endedness issues
-        // Higher order bytes first, is our serialization format
-        uint8_t val;
-        // watch_date_time start_time;
-        // uint16_t total_sec;
-        // uint16_t pause_sec;
-        // uint8_t activity_type;
-        if (ofs == 0)
-            val = (itm->start_time.reg & 0xff000000) >> 24;
-        else if (ofs == 1)
-            val = (itm->start_time.reg & 0x00ff0000) >> 16;
-        else if (ofs == 2)
-            val = (itm->start_time.reg & 0x0000ff00) >> 8;
-        else if (ofs == 3)
-            val = (itm->start_time.reg & 0x000000ff);
-        else if (ofs == 4)
-            val = (itm->total_sec & 0xff00) >> 8;
-        else if (ofs == 5)
-            val = (itm->total_sec & 0x00ff);
-        else if (ofs == 6)
-            val = (itm->pause_sec & 0xff00) >> 8;
-        else if (ofs == 7)
-            val = (itm->pause_sec & 0x00ff);
-        else
-            val = itm->activity_type;
-        (*next_byte) = val;
-    }
-    ++(*activity_seq_pos);
-    return 1;
-}
-
 static void _activity_finish_logging(activity_state_t *state) {
     // Save this activity
     // If shorter than minimum for log: don't save
-    // Sanity check about buffer length. This should never happen, but also we never want to overrun by error
-    if (state->curr_total_sec >= activity_min_length_sec && activity_log_count + 1 < ACTIVITY_LOG_SZ) {
-        activity_item_t *itm = &activity_log_buffer[activity_log_count];
-        itm->start_time = state->start_time;
-        itm->total_sec = state->curr_total_sec;
-        itm->pause_sec = state->curr_pause_sec;
-        itm->activity_type = state->type_ix;
-        ++activity_log_count;
+    if (state->curr_total_sec >= activity_min_length_sec) {
+        activity_record_t record;
+        uint32_t start_minute = watch_utility_date_time_to_unix_time(state->start_time, 0) / 60 - ACTIVITY_EPOCH_MINUTES;
+        record.start_minute[0] = start_minute >> 16;
+        record.start_minute[1] = start_minute >> 8;
+        record.start_minute[2] = start_minute;
+        record.activity_type = state->type_ix;
+        record.total_sec[0] = state->curr_total_sec >> 8;
+        record.total_sec[1] = state->curr_total_sec;
+        record.pause_sec[0] = state->curr_pause_sec >> 8;
+        record.pause_sec[1] = state->curr_pause_sec;
+        // Activities are few and far between, so write each one out now rather than leave it to a reset
+        movement_log_append(&state->log, &record);
+        movement_log_flush(&state->log);
     }
 
     // Go to DONE animation
@@ -494,8 +414,17 @@ static void _activity_handle_tick(movement_settings_t *settings, activity_state_
             _activity_display_choice(state);
         }
     }
-    // Chirping
+    // Chirping: count down, then wait for the transmission to finish
     else if (state->mode == ACTM_CHIRPING) {
+        if (state->chirpy_tick_state.tick_fun == NULL) {
+            if (!movement_chirpy_is_sending()) {
+                _activity_quit_chirping();
+                state->mode = ACTM_CHIRP;
+                state->counter = 0;
+                watch_display_string("AC  CHIRP ", 0);
+            }
+            return;
+        }
         ++state->chirpy_tick_state.tick_count;
         if (state->chirpy_tick_state.tick_count == state->chirpy_tick_state.tick_compare) {
             state->chirpy_tick_state.tick_count = 0;
@@ -539,9 +468,6 @@ static void _activity_handle_tick(movement_settings_t *settings, activity_state_
 static void _activity_alarm_long(movement_settings_t *settings, activity_state_t *state) {
     // On choose face: start logging activity
     if (state->mode == ACTM_CHOOSE) {
-        // If buffer is full: Ignore this long press
-        if (activity_log_count >= ACTIVITY_LOG_SZ)
-            return;
         // OK, we go ahead and start logging
         state->start_time = watch_rtc_get_date_time();
         state->curr_total_sec = 0;
@@ -558,13 +484,10 @@ static void _activity_alarm_long(movement_settings_t *settings, activity_state_t
     // If chirp: kick off chirping
     else if (state->mode == ACTM_CHIRP) {
         // Set up our tick handling for countdown beeps
-        activity_seq_pos = &state->chirpy_tick_state.seq_pos;
         state->chirpy_tick_state.tick_compare = 8;
         state->chirpy_tick_state.tick_count = 7;  // tick_compare - 1, so it starts immediately
         state->chirpy_tick_state.seq_pos = 0;
         state->chirpy_tick_state.tick_fun = _activity_chirp_tick_countdown;
-        // Set up chirpy encoder
-        chirpy_init_encoder(&state->chirpy_encoder_state, _activity_get_next_byte);
         // Show bell; switch to 64/sec ticks
         watch_set_indicator(WATCH_INDICATOR_BELL);
         movement_request_tick_frequency(64);
@@ -572,7 +495,7 @@ static void _activity_alarm_long(movement_settings_t *settings, activity_state_t
     }
     // If clear: confirm (unless empty)
     else if (state->mode == ACTM_CLEAR) {
-        if (activity_log_count == 0)
+        if (movement_log_count(&state->log) == 0)
             return;
         state->mode = ACTM_CLEAR_CONFIRM;
         state->counter = -1;
@@ -580,8 +503,7 @@ static void _activity_alarm_long(movement_settings_t *settings, activity_state_t
     }
     // If clear confirm: do clear.
     else if (state->mode == ACTM_CLEAR_CONFIRM) {
-        _activity_clear_buffers();
-        activity_log_count = 0;
+        movement_log_erase(&state->log);
         state->mode = ACTM_CLEAR_DONE;
         state->counter = -1;
         watch_display_string("0     ", 4);
@@ -621,7 +543,7 @@ static void _activity_light_short(activity_state_t *state) {
     if (state->mode == ACTM_CHOOSE) {
         state->mode = ACTM_LOGSIZE;
         state->counter = 0;
-        sprintf(activity_buf, "AC  L#g%3d", activity_log_count);
+        sprintf(activity_buf, "AC  L#g%3lu", movement_log_count(&state->log));
         watch_display_string(activity_buf, 0);
     }
     // If log size face: move to chirp
@@ -707,8 +629,8 @@ bool activity_face_loop(movement_event_t event, movement_settings_t *settings, v
             break;
     }
 
-    // Return true if the watch can enter standby mode. False needed when chirping.
-    if (state->mode == ACTM_CHIRPING)
+    // Return true if the watch can enter standby mode. False needed during the countdown, which drives the buzzer itself.
+    if (state->mode == ACTM_CHIRPING && state->chirpy_tick_state.tick_fun != NULL)
         return false;
     else
         return true;
@@ -716,7 +638,13 @@ bool activity_face_loop(movement_event_t event, movement_settings_t *settings, v
 
 void activity_face_resign(movement_settings_t *settings, void *context) {
     (void)settings;
-    (void)context;
+    activity_state_t *state = (activity_state_t *)context;
+
+    // The transmission would carry on without us, and its byte callback draws on the display.
+    if (state->mode == ACTM_CHIRPING) {
+        _activity_quit_chirping();
+        state->mode = ACTM_CHIRP;
+    }
 
     // Face should only ever temporarily request a higher frequency, so by the time we're resigning,
     // this should not be needed. But we don't want an error to create a situation that drains the battery.
@@ -32,7 +32,7 @@
  * It supports different activities like running, biking, rowing etc., and for each recorded activity
  * it stores when it started and how long it was.
  * 
- * You can save up to 99 activities this way. Every once in a while you can chirp them out
+ * The log keeps at least the last 192 activities this way. Every once in a while you can chirp them out
  * using the watch's piezo buzzer as a modem, then clear the log in the watch.
  * To record and decode a chirpy transmission on your computer, you can use the web app here:
  * https://jealousmarkup.xyz/off/chirpy/rx/
@@ -55,15 +55,19 @@
  * Quirky details
  * 
  * The face will discard short activities (less than a minute) when you press LONG ALARM to finish logging.
- * These were probably logged by mistake, and it's better to save slots and chirping battery power for
+ * These were probably logged by mistake, and it's better to save chirping battery power for
  * stuff that really matters.
  * 
  * The face will continue to record an activity past the normal one-hour mark, when the watch
  * enters low energy mode. However, it will always stop at 8 hours. If an activity takes that long,
  * you probably just forgot to stop logging.
  * 
- * The log is stored in regular memory. It will be lost when you remove the battery, so make
- * sure you chirp it out before taking the watch apart.
+ * The log is stored in the watch's flash (as activity.0 to activity.3), so it survives a reset or a battery
+ * change. Once it's full, each new activity pushes out the oldest.
+ *
+ * The chirped data is the log in Movement's usual format (see MOVEMENT_CHIRPY_LOG_PREFIX in movement_chirpy.h),
+ * compressed, with 8-byte records, oldest first: the start time in minutes since the start of 2020 (3 bytes),
+ * the activity type (1 byte), then the total and paused seconds (2 bytes each), all high byte first.
  * 
  * See the top of activity_face.c for some customization options. What you most likely want to do
  * is reduce the list of activities shown on the first screen to the ones you are regularly doing.
@@ -82,6 +86,9 @@ void activity_face_resign(movement_settings_t *settings, void *context);
     activity_face_loop, \
     activity_face_resign, \
     NULL, \
+    0, \
+    0, \
+    NULL, \
 })
 
 #endif // ACTIVITY_FACE_H_
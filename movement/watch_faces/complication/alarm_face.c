@@ -47,15 +47,6 @@ static const uint8_t _buzzer_segdata[3][2] = {{0, 3}, {1, 3}, {2, 2}};
 
 static int8_t _wait_ticks;
 
-static uint8_t _get_weekday_idx(watch_date_time date_time) {
-    date_time.unit.year += 20;
-    if (date_time.unit.month <= 2) {
-        date_time.unit.month += 12;
-        date_time.unit.year--;
-    }
-    return (date_time.unit.day + 13 * (date_time.unit.month + 1) / 5 + date_time.unit.year + date_time.unit.year / 4 + 525 - 2) % 7;
-}
-
 static void _alarm_set_signal(alarm_state_t *state) {
     if (state->alarm[state->alarm_idx].enabled)
         watch_set_indicator(WATCH_INDICATOR_SIGNAL);
@@ -129,44 +120,55 @@ static void _alarm_resume_setting(movement_settings_t *settings, alarm_state_t *
     _alarm_face_draw(settings, state, subsecond);
 }
 
-static void _alarm_update_alarm_enabled(movement_settings_t *settings, alarm_state_t *state) {
-    // save indication for active alarms to movement settings
-    bool active_alarms = false;
-    watch_date_time now;
-    bool now_init = false;
-    uint8_t weekday_idx;
-    uint16_t now_minutes_of_day;
-    uint16_t alarm_minutes_of_day;
+static bool _alarm_rings_on(uint8_t day, uint8_t weekday_idx) {
+    switch (day) {
+    case ALARM_DAY_EACH_DAY:
+    case ALARM_DAY_ONE_TIME:
+        return true;
+    case ALARM_DAY_WORKDAY:
+        return weekday_idx < 5;
+    case ALARM_DAY_WEEKEND:
+        return weekday_idx >= 5;
+    default:
+        return day == weekday_idx;
+    }
+}
+
+static void _alarm_schedule_next(movement_settings_t *settings, alarm_state_t *state) {
+    // find the first alarm to go off after this minute; of two at the same time, the first slot plays.
+    watch_date_time now = movement_get_local_date_time();
+    // 0 for Monday.
+    uint8_t weekday_idx = movement_get_calendar()->weekday - 1;
+    uint16_t now_minutes_of_day = now.unit.hour * 60 + now.unit.minute;
+    uint32_t soonest = UINT32_MAX;
     for (uint8_t i = 0; i < ALARM_ALARMS; i++) {
-        if (state->alarm[i].enabled) {
-            // figure out if alarm is to go off in the next 24 h
-            if (state->alarm[i].day == ALARM_DAY_EACH_DAY || state->alarm[i].day == ALARM_DAY_ONE_TIME) {
-            active_alarms = true;
-            break;
-            } else {
-                if (!now_init) {
-                    now = watch_rtc_get_date_time();
-                    now_init = true;
-                    weekday_idx = _get_weekday_idx(now);
-                    now_minutes_of_day = now.unit.hour * 60 + now.unit.minute;
-                }
-                alarm_minutes_of_day = state->alarm[i].hour * 60 + state->alarm[i].minute;
-                // no more shortcuts: check days and times for all possible cases...
-                if ((state->alarm[i].day == weekday_idx && alarm_minutes_of_day >= now_minutes_of_day)
-                    || ((weekday_idx + 1) % 7 == state->alarm[i].day && alarm_minutes_of_day <= now_minutes_of_day) 
-                    || (state->alarm[i].day == ALARM_DAY_WORKDAY && (weekday_idx < 4
-                        || (weekday_idx == 4 && alarm_minutes_of_day >= now_minutes_of_day)
-                        || (weekday_idx == 6 && alarm_minutes_of_day <= now_minutes_of_day)))
-                    || (state->alarm[i].day == ALARM_DAY_WEEKEND && (weekday_idx == 5
-                        || (weekday_idx == 6 && alarm_minutes_of_day >= now_minutes_of_day)
-                        || (weekday_idx == 4 && alarm_minutes_of_day <= now_minutes_of_day)))) {
-                    active_alarms = true;
-                    break;
-                }
+        if (!state->alarm[i].enabled) continue;
+        uint16_t alarm_minutes_of_day = state->alarm[i].hour * 60 + state->alarm[i].minute;
+        // every day mode rings at least once a week, so the next time is within the next seven days.
+        for (uint8_t days = alarm_minutes_of_day > now_minutes_of_day ? 0 : 1; days <= 7; days++) {
+            if (!_alarm_rings_on(state->alarm[i].day, (weekday_idx + days) % 7)) continue;
+            uint32_t minutes = days * 24 * 60 + alarm_minutes_of_day - now_minutes_of_day;
+            if (minutes < soonest) {
+                soonest = minutes;
+                state->alarm_playing_idx = i;
             }
+            break;
         }
     }
-    settings->bit.alarm_enabled = active_alarms;
+
+    if (soonest == UINT32_MAX) {
+        state->next_alarm.reg = 0;
+        settings->bit.alarm_enabled = false;
+        movement_cancel_background_task_for_face(state->watch_face_index);
+        return;
+    }
+    uint32_t timestamp = watch_utility_date_time_to_unix_time(now, 0) - now.unit.second + soonest * 60;
+    state->next_alarm = watch_utility_date_time_from_unix_time(timestamp, 0);
+    // the signal indicator shows that an alarm will go off within 24 hours, so an alarm further off than that
+    // gets a wake a day ahead of it, to turn the indicator on.
+    settings->bit.alarm_enabled = soonest <= 24 * 60;
+    if (!settings->bit.alarm_enabled) timestamp -= 24 * 60 * 60;
+    movement_schedule_background_task_for_face(state->watch_face_index, watch_utility_date_time_from_unix_time(timestamp, 0));
 }
 
 static void _alarm_play_short_beep(uint8_t pitch_idx) {
@@ -201,7 +203,7 @@ void alarm_face_setup(movement_settings_t *settings, uint8_t watch_face_index, v
     (void) watch_face_index;
 
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(alarm_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(alarm_state_t));
         alarm_state_t *state = (alarm_state_t *)*context_ptr;
         memset(*context_ptr, 0, sizeof(alarm_state_t));
         // initialize the default alarm values
@@ -210,7 +212,7 @@ void alarm_face_setup(movement_settings_t *settings, uint8_t watch_face_index, v
             state->alarm[i].beeps = 5;
             state->alarm[i].pitch = 1;
         }
-        state->alarm_handled_minute = -1;
+        state->watch_face_index = watch_face_index;
         _wait_ticks = -1;
     }
 }
@@ -224,41 +226,13 @@ void alarm_face_activate(movement_settings_t *settings, void *context) {
 void alarm_face_resign(movement_settings_t *settings, void *context) {
     alarm_state_t *state = (alarm_state_t *)context;
     state->is_setting = false;
-    _alarm_update_alarm_enabled(settings, state);
+    _alarm_schedule_next(settings, state);
     watch_set_led_off();
     state->alarm_quick_ticks = false;
     _wait_ticks = -1;
     movement_request_tick_frequency(1);
 }
 
-bool alarm_face_wants_background_task(movement_settings_t *settings, void *context) {
-    (void) settings;
-    alarm_state_t *state = (alarm_state_t *)context;
-    watch_date_time now = watch_rtc_get_date_time();
-    // just a failsafe: never fire more than one alarm within a minute
-    if (state->alarm_handled_minute == now.unit.minute) return false;
-    state->alarm_handled_minute = now.unit.minute;
-    // check the rest
-    for (uint8_t i = 0; i < ALARM_ALARMS; i++) {
-        if (state->alarm[i].enabled) {
-            if (state->alarm[i].minute == now.unit.minute) {
-                if (state->alarm[i].hour == now.unit.hour) {
-                    state->alarm_playing_idx = i;
-                    if (state->alarm[i].day == ALARM_DAY_EACH_DAY || state->alarm[i].day == ALARM_DAY_ONE_TIME) return true;
-                    uint8_t weekday_idx = _get_weekday_idx(now);
-                    if (state->alarm[i].day == weekday_idx) return true;
-                    if (state->alarm[i].day == ALARM_DAY_WORKDAY && weekday_idx < 5) return true;
-                    if (state->alarm[i].day == ALARM_DAY_WEEKEND && weekday_idx >= 5) return true;
-                }
-            }
-        }
-    }
-    state->alarm_handled_minute = -1;
-    // update the movement's alarm indicator five times an hour
-    if (now.unit.minute % 12 == 0) _alarm_update_alarm_enabled(settings, state);
-    return false;
-}
-
 bool alarm_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
     (void) settings;
     alarm_state_t *state = (alarm_state_t *)context;
@@ -283,6 +257,7 @@ bool alarm_face_loop(movement_event_t event, movement_settings_t *settings, void
                     _alarm_set_signal(state);
                     delay_ms(275);
                     state->alarm_idx = 0;
+                    _alarm_schedule_next(settings, state);
                 }
             } else break; // no need to do anything when we are not in settings mode and no quick ticks are running
         }
@@ -353,6 +328,7 @@ bool alarm_face_loop(movement_event_t event, movement_settings_t *settings, void
             }
             // auto enable an alarm if user sets anything
             if (state->setting_state > alarm_setting_idx_alarm) state->alarm[state->alarm_idx].enabled = true;
+            _alarm_schedule_next(settings, state);
         }
         _alarm_face_draw(settings, state, event.subsecond);
         break;
@@ -362,6 +338,7 @@ bool alarm_face_loop(movement_event_t event, movement_settings_t *settings, void
             state->alarm[state->alarm_idx].enabled ^= 1;
             // start wait ticks counter
             _wait_ticks = 0;
+            _alarm_schedule_next(settings, state);
         } else {
             // handle the long press settings behaviour
             switch (state->setting_state) {
@@ -385,9 +362,15 @@ bool alarm_face_loop(movement_event_t event, movement_settings_t *settings, void
         if (state->is_setting) {
             if (state->setting_state == alarm_setting_idx_hour || state->setting_state == alarm_setting_idx_minute)
                 _abort_quick_ticks(state);
+            _alarm_schedule_next(settings, state);
         } else _wait_ticks = -1;
         break;
     case EVENT_BACKGROUND_TASK:
+        // the task is the alarm, or the wake a day ahead of it; after a change of time it may be neither.
+        if ((movement_get_local_date_time().reg >> 6) != (state->next_alarm.reg >> 6)) {
+            _alarm_schedule_next(settings, state);
+            break;
+        }
         // play alarm
         if (state->alarm[state->alarm_playing_idx].beeps == 0) {
             // short beep
@@ -411,8 +394,8 @@ bool alarm_face_loop(movement_event_t event, movement_settings_t *settings, void
             state->alarm[state->alarm_playing_idx].beeps = 5;
             state->alarm[state->alarm_playing_idx].pitch = 1;
             state->alarm[state->alarm_playing_idx].enabled = false;
-            _alarm_update_alarm_enabled(settings, state);
         }
+        _alarm_schedule_next(settings, state);
         break;
     case EVENT_TIMEOUT:
         movement_move_to_face(0);
@@ -35,6 +35,11 @@
 
 #define NUM_AVAILABLE_BODIES 9
 
+// RA/Dec drift slowly enough that alt/az can be derived from a cached position for a while. The Moon moves about
+// half a degree an hour though, so it needs refreshing more often to keep alt/az right to a hundredth of a degree.
+#define ASTRONOMY_RECALCULATION_INTERVAL 3600
+#define ASTRONOMY_MOON_RECALCULATION_INTERVAL 60
+
 static const char astronomy_available_celestial_bodies[NUM_AVAILABLE_BODIES] = {
     ASTRO_BODY_SUN,
     ASTRO_BODY_MERCURY,
@@ -59,6 +64,30 @@ static const char astronomy_celestial_body_names[NUM_AVAILABLE_BODIES][3] = {
     "NE"    // Neptune
 };
 
+static uint32_t _astronomy_face_get_utc_timestamp(movement_settings_t *settings) {
+    (void) settings;
+    watch_date_time date_time = watch_rtc_get_date_time();
+    return watch_utility_date_time_to_unix_time(date_time, movement_get_current_timezone_offset() * 60);
+}
+
+static double _astronomy_face_get_julian_date(uint32_t timestamp) {
+    watch_date_time date_time = watch_utility_date_time_from_unix_time(timestamp, 0);
+    return astro_convert_date_to_julian_date(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR, date_time.unit.month, date_time.unit.day, date_time.unit.hour, date_time.unit.minute, date_time.unit.second);
+}
+
+static bool _astronomy_face_calculation_is_current(astronomy_state_t *state, uint32_t timestamp) {
+    if (state->calculated_at == 0 || state->calculated_body_index != state->active_body_index) return false;
+    uint32_t interval = astronomy_available_celestial_bodies[state->active_body_index] == ASTRO_BODY_MOON ? ASTRONOMY_MOON_RECALCULATION_INTERVAL : ASTRONOMY_RECALCULATION_INTERVAL;
+    return timestamp >= state->calculated_at && timestamp - state->calculated_at < interval;
+}
+
+static void _astronomy_face_update_horizontal(astronomy_state_t *state, double jd) {
+    // only the sidereal time changes here, which is cheap next to finding the body's position.
+    astro_horizontal_coordinates_t horiz = astro_ra_dec_to_alt_az(jd, state->latitude_radians, state->longitude_radians, state->apparent_right_ascension, state->apparent_declination);
+    state->altitude = astro_radians_to_degrees(horiz.altitude);
+    state->azimuth = astro_radians_to_degrees(horiz.azimuth);
+}
+
 static void _astronomy_face_recalculate(movement_settings_t *settings, astronomy_state_t *state) {
 #if __EMSCRIPTEN__
     int16_t browser_lat = EM_ASM_INT({
@@ -79,10 +108,8 @@ static void _astronomy_face_recalculate(movement_settings_t *settings, astronomy
     }
 #endif
 
-    watch_date_time date_time = watch_rtc_get_date_time();
-    uint32_t timestamp = watch_utility_date_time_to_unix_time(date_time, movement_timezone_offsets[settings->bit.time_zone] * 60);
-    date_time = watch_utility_date_time_from_unix_time(timestamp, 0);
-    double jd = astro_convert_date_to_julian_date(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR, date_time.unit.month, date_time.unit.day, date_time.unit.hour, date_time.unit.minute, date_time.unit.second);
+    uint32_t timestamp = _astronomy_face_get_utc_timestamp(settings);
+    double jd = _astronomy_face_get_julian_date(timestamp);
 
     astro_equatorial_coordinates_t radec_precession = astro_get_ra_dec(jd, astronomy_available_celestial_bodies[state->active_body_index], state->latitude_radians, state->longitude_radians, true);
     printf("\nParams to convert: %f %f %f %f %f\n",
@@ -92,10 +119,13 @@ static void _astronomy_face_recalculate(movement_settings_t *settings, astronomy
             astro_radians_to_degrees(radec_precession.right_ascension),
             astro_radians_to_degrees(radec_precession.declination));
 
-    astro_horizontal_coordinates_t horiz = astro_ra_dec_to_alt_az(jd, state->latitude_radians, state->longitude_radians, radec_precession.right_ascension, radec_precession.declination);
+    state->apparent_right_ascension = radec_precession.right_ascension;
+    state->apparent_declination = radec_precession.declination;
+    state->calculated_at = timestamp;
+    state->calculated_body_index = state->active_body_index;
+    _astronomy_face_update_horizontal(state, jd);
+
     astro_equatorial_coordinates_t radec = astro_get_ra_dec(jd, astronomy_available_celestial_bodies[state->active_body_index], state->latitude_radians, state->longitude_radians, false);
-    state->altitude = astro_radians_to_degrees(horiz.altitude);
-    state->azimuth = astro_radians_to_degrees(horiz.azimuth);
     state->right_ascension = astro_radians_to_hms(radec.right_ascension);
     state->declination = astro_radians_to_dms(radec.declination);
     state->distance = radec.distance;
@@ -116,8 +146,21 @@ static void _astronomy_face_recalculate(movement_settings_t *settings, astronomy
             state->distance);
 }
 
+// keeps alt/az current while they're on screen, redoing the full calculation only once the cached position is stale.
+static void _astronomy_face_track(movement_settings_t *settings, astronomy_state_t *state) {
+    uint32_t timestamp = _astronomy_face_get_utc_timestamp(settings);
+    if (_astronomy_face_calculation_is_current(state, timestamp)) {
+        _astronomy_face_update_horizontal(state, _astronomy_face_get_julian_date(timestamp));
+    } else {
+        _astronomy_face_recalculate(settings, state);
+    }
+}
+
 static void _astronomy_face_update(movement_event_t event, movement_settings_t *settings, astronomy_state_t *state) {
     char buf[16];
+    if (event.event_type == EVENT_TICK && (state->mode == ASTRONOMY_MODE_DISPLAYING_ALT || state->mode == ASTRONOMY_MODE_DISPLAYING_AZI)) {
+        _astronomy_face_track(settings, state);
+    }
     switch (state->mode) {
         case ASTRONOMY_MODE_SELECTING_BODY:
             watch_clear_colon();
@@ -147,11 +190,16 @@ static void _astronomy_face_update(movement_event_t event, movement_settings_t *
             }
             break;
         case ASTRONOMY_MODE_CALCULATING:
-            watch_clear_display();
-             // this takes a moment and locks the UI, flash C for "Calculating"
-            watch_start_character_blink('C', 100);
-            _astronomy_face_recalculate(settings, state);
-            watch_stop_blink();
+            if (_astronomy_face_calculation_is_current(state, _astronomy_face_get_utc_timestamp(settings))) {
+                // same body as last time, and recently enough that only alt/az need updating.
+                _astronomy_face_track(settings, state);
+            } else {
+                watch_clear_display();
+                // this takes a moment and locks the UI, flash C for "Calculating"
+                watch_start_character_blink('C', 100);
+                _astronomy_face_recalculate(settings, state);
+                watch_stop_blink();
+            }
             state->mode = ASTRONOMY_MODE_DISPLAYING_ALT;
             // fall through
         case ASTRONOMY_MODE_DISPLAYING_ALT:
@@ -192,7 +240,7 @@ void astronomy_face_setup(movement_settings_t *settings, uint8_t watch_face_inde
     (void) settings;
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(astronomy_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(astronomy_state_t));
         memset(*context_ptr, 0, sizeof(astronomy_state_t));
     }
 }
@@ -205,8 +253,12 @@ void astronomy_face_activate(movement_settings_t *settings, void *context) {
     int16_t lon_centi = (int16_t)movement_location.bit.longitude;
     double lat = (double)lat_centi / 100.0;
     double lon = (double)lon_centi / 100.0;
-    state->latitude_radians = astro_degrees_to_radians(lat);
-    state->longitude_radians = astro_degrees_to_radians(lon);
+    double latitude_radians = astro_degrees_to_radians(lat);
+    double longitude_radians = astro_degrees_to_radians(lon);
+    // RA/Dec are topocentric, so a cached calculation only holds for the location it was made at.
+    if (latitude_radians != state->latitude_radians || longitude_radians != state->longitude_radians) state->calculated_at = 0;
+    state->latitude_radians = latitude_radians;
+    state->longitude_radians = longitude_radians;
 
     movement_request_tick_frequency(4);
 }
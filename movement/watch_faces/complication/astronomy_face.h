@@ -63,6 +63,11 @@
  *     dE - Declination (in degrees/minutes/seconds)
  *     di - Distance (the digits in the top right will display either aU for astronomical units, or K for kilometers)
  * 
+ * While altitude or azimuth is displayed, they follow the body across the
+ * sky once a second. The full calculation is repeated every hour (every
+ * minute for the Moon, which moves faster), and selecting the same body again
+ * within that time shows the results without recalculating.
+ *
  * Long press on the Alarm button to select another celestial body.
  */
 
@@ -91,6 +96,10 @@ typedef struct {
     double altitude;    // in decimal degrees
     double azimuth;     // in decimal degrees
     double distance;    // in AU
+    double apparent_right_ascension;    // precessed, topocentric, in radians; alt/az are derived from these
+    double apparent_declination;        // between full calculations, using only the sidereal time
+    uint32_t calculated_at;             // UTC timestamp of the last full calculation, or 0 if there isn't one
+    uint8_t calculated_body_index;
 } astronomy_state_t;
 
 void astronomy_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
@@ -104,6 +113,9 @@ void astronomy_face_resign(movement_settings_t *settings, void *context);
     astronomy_face_loop, \
     astronomy_face_resign, \
     NULL, \
+    sizeof(astronomy_state_t), \
+    MOVEMENT_FACE_HIBERNATE, \
+    NULL, \
 })
 
 #endif // ASTRONOMY_FACE_H_
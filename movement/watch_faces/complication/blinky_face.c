@@ -31,7 +31,7 @@ void blinky_face_setup(movement_settings_t *settings, uint8_t watch_face_index,
     (void) settings;
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(blinky_face_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(blinky_face_state_t));
         memset(*context_ptr, 0, sizeof(blinky_face_state_t));
     }
 }
@@ -42,6 +42,13 @@ void blinky_face_activate(movement_settings_t *settings, void *context) {
     state->active = false;
 }
 
+static void _blinky_face_start(blinky_face_state_t *state) {
+    const watch_led_step_t colors[] = { { 255, 0 }, { 0, 255 }, { 255, 255 } };
+    // on, then off: the LED's own timer plays it, so the watch can sleep in between.
+    watch_led_step_t steps[2] = { colors[state->color], { 0, 0 } };
+    watch_led_play_pattern(steps, 2, state->fast ? 125 : 500, 0, NULL);
+}
+
 static void _blinky_face_update_lcd(blinky_face_state_t *state) {
     char buf[11];
     const char colors[][7] = {" red  ", " Green", " Yello"};
@@ -67,7 +74,7 @@ bool blinky_face_loop(movement_event_t event, movement_settings_t *settings, voi
             if (!state->active) {
                 state->active = true;
                 watch_clear_display();
-                movement_request_tick_frequency(state->fast ? 8 : 2);            
+                _blinky_face_start(state);
             } else {
                 state->active = false;
                 watch_set_led_off();
@@ -80,14 +87,6 @@ bool blinky_face_loop(movement_event_t event, movement_settings_t *settings, voi
                 _blinky_face_update_lcd(state);
             }
             break;
-        case EVENT_TICK:
-            if (state->active) {
-                if (event.subsecond % 2 == 0) watch_set_led_off();
-                else if (state->color == 0) watch_set_led_red();
-                else if (state->color == 1) watch_set_led_green();
-                else watch_set_led_yellow();
-            }
-            break;
         case EVENT_TIMEOUT:
             if (!state->active) movement_move_to_face(0);
             break;
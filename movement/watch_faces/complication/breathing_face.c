@@ -30,6 +30,7 @@
 typedef struct {
     uint8_t current_stage;
     bool sound_on;
+    bool led_on;
 } breathing_state_t;
 
 static void beep_in (void);
@@ -57,6 +58,20 @@ void breathing_face_activate(movement_settings_t *settings, void *context) {
     // ...and set the initial state of our watch face.
     state->current_stage = 0;
     state->sound_on = true;
+    state->led_on = false;
+}
+
+// one round of the box, in half seconds: four seconds each of breathing in, holding, breathing out and holding.
+static void _breathing_face_start_led(void) {
+    watch_led_step_t steps[32];
+    for (uint8_t i = 0; i < 8; i++) {
+        steps[i] = (watch_led_step_t){ 0, (i + 1) * 255 / 8 };
+        steps[i + 8] = (watch_led_step_t){ 0, 255 };
+        steps[i + 16] = (watch_led_step_t){ 0, (7 - i) * 255 / 8 };
+        steps[i + 24] = (watch_led_step_t){ 0, 0 };
+    }
+    // the LED's timer plays it while the watch sleeps between ticks; each round starts it over, in step with the display.
+    watch_led_play_pattern(steps, 32, 500, 0, NULL);
 }
 
 const int NOTE_LENGTH = 80;
@@ -141,7 +156,11 @@ bool breathing_face_loop(movement_event_t event, movement_settings_t *settings,
 
             switch (state->current_stage)
             {
-            case 0: { watch_display_string("Breath", 4); if (state->sound_on) beep_in(); } break;
+            case 0: {
+                watch_display_string("Breath", 4);
+                if (state->sound_on) beep_in();
+                if (state->led_on) _breathing_face_start_led();
+            } break;
             case 1: watch_display_string("In   3", 4); break;
             case 2: watch_display_string("In   2", 4); break;
             case 3: watch_display_string("In   1", 4); break;
@@ -176,6 +195,11 @@ bool breathing_face_loop(movement_event_t event, movement_settings_t *settings,
                 watch_clear_indicator(WATCH_INDICATOR_BELL); 
             }
             break;
+        case EVENT_LIGHT_BUTTON_DOWN:
+            // the glow starts with the next round.
+            state->led_on = !state->led_on;
+            if (!state->led_on) watch_set_led_off();
+            break;
         case EVENT_LOW_ENERGY_UPDATE:
             // This low energy mode update occurs once a minute, if the watch face is in the
             // foreground when Movement enters low energy mode. We have the option of supporting
@@ -201,8 +225,8 @@ bool breathing_face_loop(movement_event_t event, movement_settings_t *settings,
 }
 
 void breathing_face_resign(movement_settings_t *settings, void *context) {
-    // our watch face, like most watch faces, has nothing special to do when resigning.
-    // watch faces that enable a peripheral or interact with a sensor may want to turn it off here.
+    // the LED's pattern would carry on without us, so stop it here.
     (void) settings;
-    (void) context;
+    breathing_state_t *state = (breathing_state_t *)context;
+    if (state->led_on) watch_set_led_off();
 }
@@ -33,7 +33,8 @@
  * concentration in stressful situations.
  *
  * Usage: Timed messages will cycle as long as this face is active.
- * Press ALARM to toggle sound.
+ * Press ALARM to toggle sound. Press LIGHT to have the green LED glow
+ * along: brightening as you breathe in, and fading as you breathe out.
  */
 
 #include "movement.h"
@@ -49,6 +50,9 @@ void breathing_face_resign(movement_settings_t *settings, void *context);
     breathing_face_loop, \
     breathing_face_resign, \
     NULL, \
+    0, \
+    0, \
+    NULL, \
 })
 
 #endif // BREATHING_FACE_H_
@@ -25,6 +25,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "couch_to_5k_face.h"
+#include "movement_timer.h"
 
 // They go: Warmup, Run, Walk, Run, Walk, Run, Walk ... , End (0)
 // Time is defined in seconds
@@ -55,6 +56,9 @@ uint16_t *C25K_SESSIONS[C25K_SESSIONS_LENGTH];
 static inline bool _finished(couch_to_5k_state_t *state){
     return state->exercise_type == C25K_FINISHED;
 }
+static inline bool _running(couch_to_5k_state_t *state){
+    return movement_timer_get_state(state->watch_face_index, 0) == MOVEMENT_TIMER_RUNNING;
+}
 static inline bool _cleared(couch_to_5k_state_t *state){
     return state->timer == C25K_SESSIONS[state->session][0]
         && state->exercise == 0;
@@ -86,9 +90,28 @@ static void _next_exercise(couch_to_5k_state_t *state){
     }
     movement_play_alarm_beeps(4, BUZZER_NOTE_A7);
     _assign_exercise_type(state);
+    // Count from when the last exercise ended, however late we heard of it
+    movement_timer_chain(state->watch_face_index, 0, state->timer, MOVEMENT_TIMER_SOUND_NONE);
+}
+
+static void _toggle_pause(couch_to_5k_state_t *state){
+    switch (movement_timer_get_state(state->watch_face_index, 0)){
+        case MOVEMENT_TIMER_RUNNING:
+            movement_timer_pause(state->watch_face_index, 0);
+            break;
+        case MOVEMENT_TIMER_PAUSED:
+            movement_timer_resume(state->watch_face_index, 0);
+            break;
+        default:
+            if (!_finished(state)){
+                movement_timer_start(state->watch_face_index, 0, state->timer, MOVEMENT_TIMER_SOUND_NONE);
+            }
+            break;
+    }
 }
 
 static void _init_session(couch_to_5k_state_t *state){
+    movement_timer_cancel(state->watch_face_index, 0);
     state->exercise = 0; // Restart exercise counter
     state->timer = C25K_SESSIONS[state->session][state->exercise];
     _assign_exercise_type(state);
@@ -124,10 +147,11 @@ static void _display(couch_to_5k_state_t *state, char *buf){
 void couch_to_5k_face_setup(movement_settings_t *settings, uint8_t
                           watch_face_index, void ** context_ptr) {
     (void) settings;
-    (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(couch_to_5k_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(couch_to_5k_state_t));
         memset(*context_ptr, 0, sizeof(couch_to_5k_state_t));
+        couch_to_5k_state_t *state = (couch_to_5k_state_t *)*context_ptr;
+        state->watch_face_index = watch_face_index;
         // Do any one-time tasks in here; the inside of this conditional
         // happens only at boot.
         // C25K_SESSIONS[0]  = C25K_WEEK_TEST;
@@ -158,6 +182,7 @@ void couch_to_5k_face_setup(movement_settings_t *settings, uint8_t
         C25K_SESSIONS[24] = C25K_WEEK_9;
         C25K_SESSIONS[25] = C25K_WEEK_9;
         C25K_SESSIONS[26] = C25K_WEEK_9;
+        _init_session(state);
     }
     // Do any pin or peripheral setup here; this will be called whenever the
     // watch wakes from deep sleep.
@@ -175,26 +200,22 @@ bool couch_to_5k_face_loop(movement_event_t event, movement_settings_t *settings
                          void *context) {
     couch_to_5k_state_t *state = (couch_to_5k_state_t *)context;
     static char buf[11];
-    static bool paused = true;
 
     switch (event.event_type) {
         case EVENT_ACTIVATE:
-            // Show your initial UI here.
-            movement_request_tick_frequency(1);
-            _init_session(state);
-            paused = true;
-            _display(state, buf);
-            break;
         case EVENT_TICK:
-            if ( !paused && !_finished(state) ) {
-                if (state->timer == 0){
-                    _next_exercise(state);
-                } else {
-                    state->timer--;
-                }
+            // The session carries on while we're away; the timer knows where
+            // it's got to
+            if (movement_timer_get_state(state->watch_face_index, 0) != MOVEMENT_TIMER_IDLE){
+                state->timer = movement_timer_get_remaining(state->watch_face_index, 0);
             }
             _display(state, buf);
             break;
+        case EVENT_BACKGROUND_TASK:
+            if (movement_timer_take_expired(state->watch_face_index)){
+                _next_exercise(state);
+            }
+            break;
         case EVENT_LIGHT_BUTTON_UP:
             // This is the next-exercise / reset button.
 
@@ -202,11 +223,10 @@ bool couch_to_5k_face_loop(movement_event_t event, movement_settings_t *settings
             if ( _finished(state) ){
                 _next_session(state);
                 _init_session(state);
-                paused = true;
                 break;
             }
             // When paused and cleared move to next, when only paused, clear
-            if ( paused ) {
+            if ( !_running(state) ) {
                 if ( _cleared(state) ){
                     _next_session(state);
                 }
@@ -217,7 +237,7 @@ bool couch_to_5k_face_loop(movement_event_t event, movement_settings_t *settings
             if (settings->bit.button_should_sound) {
                 watch_buzzer_play_note(BUZZER_NOTE_C8, 50);
             }
-            paused = !paused;
+            _toggle_pause(state);
             break;
         case EVENT_TIMEOUT:
             // Your watch face will receive this event after a period of
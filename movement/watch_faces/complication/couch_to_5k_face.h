@@ -47,7 +47,8 @@
  * alarm. When the whole session finishes, a different tone is played for a
  * longer period.
  *
- * Pressing the ALARM button pauses/resumes the clock.
+ * Pressing the ALARM button pauses/resumes the clock. The session keeps
+ * running when you leave the face, and the alarms still sound.
  *
  * Pressing the LIGHT button does nothing if the timer is not paused. When it
  * is paused it clears the current session (it restarts it to the beginning)
@@ -64,6 +65,7 @@ typedef enum {
 
 typedef struct {
     // Anything you need to keep track of, put it here!
+    uint8_t watch_face_index;
     uint8_t session;
     uint8_t exercise;
     exercise_type_t exercise_type;
@@ -81,6 +83,9 @@ void couch_to_5k_face_resign(movement_settings_t *settings, void *context);
     couch_to_5k_face_loop, \
     couch_to_5k_face_resign, \
     NULL, \
+    sizeof(couch_to_5k_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // COUCHTO5K_FACE_H_
@@ -28,6 +28,7 @@
 #include "countdown_face.h"
 #include "watch.h"
 #include "watch_utility.h"
+#include "movement_timer.h"
 
 #define CD_SELECTIONS 3
 #define DEFAULT_MINUTES 3
@@ -44,10 +45,6 @@ static void abort_quick_ticks(countdown_state_t *state) {
     }
 }
 
-static inline int32_t get_tz_offset(movement_settings_t *settings) {
-    return movement_timezone_offsets[settings->bit.time_zone] * 60;
-}
-
 static inline void store_countdown(countdown_state_t *state) {
     /* Store set countdown time */
     state->set_hours = state->hours;
@@ -68,31 +65,26 @@ static inline void button_beep(movement_settings_t *settings) {
         watch_buzzer_play_note(BUZZER_NOTE_C7, 50);
 }
 
-static void start(countdown_state_t *state, movement_settings_t *settings) {
-    watch_date_time now = watch_rtc_get_date_time();
+static void show_remaining(countdown_state_t *state) {
+    div_t result = div(movement_timer_get_remaining(state->watch_face_index, 0), 60);
+    state->seconds = result.rem;
+    result = div(result.quot, 60);
+    state->hours = result.quot;
+    state->minutes = result.rem;
+}
 
+static void start(countdown_state_t *state) {
     state->mode = cd_running;
-    state->now_ts = watch_utility_date_time_to_unix_time(now, get_tz_offset(settings));
-    state->target_ts = watch_utility_offset_timestamp(state->now_ts, state->hours, state->minutes, state->seconds);
-    watch_date_time target_dt = watch_utility_date_time_from_unix_time(state->target_ts, get_tz_offset(settings));
-    movement_schedule_background_task(target_dt);
+    movement_timer_start(state->watch_face_index, 0, state->hours * 3600 + state->minutes * 60 + state->seconds, MOVEMENT_TIMER_SOUND_ALARM);
     watch_set_indicator(WATCH_INDICATOR_BELL);
 }
 
 static void draw(countdown_state_t *state, uint8_t subsecond) {
     char buf[16];
 
-    uint32_t delta;
-    div_t result;
-
     switch (state->mode) {
         case cd_running:
-            delta = state->target_ts - state->now_ts;
-            result = div(delta, 60);
-            state->seconds = result.rem;
-            result = div(result.quot, 60);
-            state->hours = result.quot;
-            state->minutes = result.rem;
+            show_remaining(state);
             sprintf(buf, "CD  %2d%02d%02d", state->hours, state->minutes, state->seconds);
             break;
         case cd_reset:
@@ -122,21 +114,23 @@ static void draw(countdown_state_t *state, uint8_t subsecond) {
 }
 
 static void pause(countdown_state_t *state) {
+    // keep what's left as the time to start from again.
+    show_remaining(state);
     state->mode = cd_paused;
-    movement_cancel_background_task();
+    movement_timer_cancel(state->watch_face_index, 0);
     watch_clear_indicator(WATCH_INDICATOR_BELL);
 }
 
 static void reset(countdown_state_t *state) {
     state->mode = cd_reset;
-    movement_cancel_background_task();
+    movement_timer_cancel(state->watch_face_index, 0);
     watch_clear_indicator(WATCH_INDICATOR_BELL);
     load_countdown(state);
 }
 
 static void ring(countdown_state_t *state) {
-    movement_play_alarm();
-    reset(state);
+    // the timer plays the alarm as it hands the expiry over.
+    if (movement_timer_take_expired(state->watch_face_index)) reset(state);
 }
 
 static void settings_increment(countdown_state_t *state) {
@@ -159,12 +153,12 @@ static void settings_increment(countdown_state_t *state) {
 
 void countdown_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
     (void) settings;
-    (void) watch_face_index;
 
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(countdown_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(countdown_state_t));
         countdown_state_t *state = (countdown_state_t *)*context_ptr;
         memset(*context_ptr, 0, sizeof(countdown_state_t));
+        state->watch_face_index = watch_face_index;
         state->minutes = DEFAULT_MINUTES;
         state->mode = cd_reset;
         store_countdown(state);
@@ -175,8 +169,6 @@ void countdown_face_activate(movement_settings_t *settings, void *context) {
     (void) settings;
     countdown_state_t *state = (countdown_state_t *)context;
     if(state->mode == cd_running) {
-        watch_date_time now = watch_rtc_get_date_time();
-        state->now_ts = watch_utility_date_time_to_unix_time(now, get_tz_offset(settings));
         watch_set_indicator(WATCH_INDICATOR_BELL);
     }
     watch_set_colon();
@@ -200,10 +192,6 @@ bool countdown_face_loop(movement_event_t event, movement_settings_t *settings,
                 else
                     abort_quick_ticks(state);
             }
-
-            if (state->mode == cd_running) {
-                state->now_ts++;
-            }
             draw(state, event.subsecond);
             break;
         case EVENT_MODE_BUTTON_UP:
@@ -247,7 +235,7 @@ bool countdown_face_loop(movement_event_t event, movement_settings_t *settings,
                 case cd_paused:
                     if (!(state->hours == 0 && state->minutes == 0 && state->seconds == 0)) {
                         // Only start the timer if we have a valid time.
-                        start(state, settings);
+                        start(state);
                         button_beep(settings);
                     }
                     break;
@@ -38,8 +38,8 @@
  *
  * Max countdown is 23 hours, 59 minutes and 59 seconds.
  *
- * Note: we have to prevent the watch from going to deep sleep using
- * movement_schedule_background_task() while the timer is running.
+ * The countdown runs on Movement's timer service (see movement_timer.h), so
+ * the watch doesn't wake for it until it's done.
  */
 
 #include "movement.h"
@@ -52,8 +52,7 @@ typedef enum {
 } countdown_mode_t;
 
 typedef struct {
-    uint32_t target_ts;
-    uint32_t now_ts;
+    uint8_t watch_face_index;
     uint8_t hours;
     uint8_t minutes;
     uint8_t seconds;
@@ -76,6 +75,9 @@ void countdown_face_resign(movement_settings_t *settings, void *context);
     countdown_face_loop, \
     countdown_face_resign, \
     NULL, \
+    sizeof(countdown_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // COUNTDOWN_FACE_H_
@@ -26,15 +26,26 @@
 #include <string.h>
 #include "counter_face.h"
 #include "watch.h"
+#include "movement_kv.h"
+
+#define COUNTER_FACE_KV_KEY "counter"
+
+// saved on every press; Movement keeps the writes in RAM until the session's over.
+static void _counter_face_save(counter_state_t *state) {
+    movement_kv_set(COUNTER_FACE_KV_KEY, state, sizeof(counter_state_t));
+}
 
 void counter_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
     (void) settings;
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(counter_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(counter_state_t));
         memset(*context_ptr, 0, sizeof(counter_state_t));
         counter_state_t *state = (counter_state_t *)*context_ptr;
-        state->beep_on = true;
+        if (movement_kv_get(COUNTER_FACE_KV_KEY, state, sizeof(counter_state_t)) != sizeof(counter_state_t)) {
+            state->counter_idx = 0;
+            state->beep_on = true;
+        }
     }
 }
 
@@ -59,6 +70,7 @@ bool counter_face_loop(movement_event_t event, movement_settings_t *settings, vo
                 state->counter_idx=0;//reset counter index
             }
             print_counter(state);
+            _counter_face_save(state);
             if (state->beep_on) {
                 beep_counter(state);
             }
@@ -71,10 +83,12 @@ bool counter_face_loop(movement_event_t event, movement_settings_t *settings, vo
             } else {
                 watch_clear_indicator(WATCH_INDICATOR_SIGNAL);
             }
+            _counter_face_save(state);
             break;
         case EVENT_ALARM_LONG_PRESS:
             state->counter_idx=0; // reset counter index
             print_counter(state);
+            _counter_face_save(state);
             break;
         case EVENT_ACTIVATE:
             print_counter(state);
@@ -34,6 +34,7 @@
  * Short-press ALARM to increment the counter (loops at 99)
  * Long-press ALARM to reset the counter.
  * Long-press LIGHT to toggle sound.
+ * The count and the sound setting are kept on flash, so they survive a reset or a battery change.
  */
 
 #include "movement.h"
@@ -58,6 +59,9 @@ void beep_counter(counter_state_t *state);
     counter_face_loop, \
     counter_face_resign, \
     NULL, \
+    sizeof(counter_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // COUNTER_FACE_H_
@@ -36,8 +36,7 @@ static uint32_t _day_one_face_juliandaynum(uint16_t year, uint16_t month, uint16
 
 static void _day_one_face_update(day_one_state_t *state) {
     char buf[15];
-    watch_date_time date_time = watch_rtc_get_date_time();
-    uint32_t julian_date = _day_one_face_juliandaynum(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR, date_time.unit.month, date_time.unit.day);
+    uint32_t julian_date = movement_get_calendar()->julian_day;
     uint32_t julian_birthdate = _day_one_face_juliandaynum(state->birth_year, state->birth_month, state->birth_day);
     if (julian_date < julian_birthdate) {
         sprintf(buf, "DA  %6lu", julian_birthdate - julian_date);
@@ -79,7 +78,7 @@ void day_one_face_setup(movement_settings_t *settings, uint8_t watch_face_index,
     (void) settings;
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(day_one_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(day_one_state_t));
         memset(*context_ptr, 0, sizeof(day_one_state_t));
         movement_birthdate_t movement_birthdate = (movement_birthdate_t) watch_get_backup_data(2);
         if (movement_birthdate.reg == 0) {
@@ -78,6 +78,9 @@ void day_one_face_resign(movement_settings_t *settings, void *context);
     day_one_face_loop, \
     day_one_face_resign, \
     NULL, \
+    sizeof(day_one_state_t), \
+    MOVEMENT_FACE_HIBERNATE, \
+    NULL, \
 })
 
 #endif // DAY_ONE_FACE_H_
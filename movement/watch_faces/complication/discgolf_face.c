@@ -151,7 +151,7 @@ void discgolf_face_setup(movement_settings_t *settings, uint8_t watch_face_index
     (void) watch_face_index;
 
     if (*context_ptr == NULL) {
-       *context_ptr = malloc(sizeof(discgolf_state_t));
+       *context_ptr = movement_claim_face_context(watch_face_index, sizeof(discgolf_state_t));
        discgolf_state_t *state = (discgolf_state_t *)*context_ptr;
        memset(*context_ptr, 0, sizeof(discgolf_state_t));
        state->hole = 1;
@@ -89,6 +89,9 @@ void discgolf_face_resign(movement_settings_t *settings, void *context);
     discgolf_face_loop, \
     discgolf_face_resign, \
     NULL, \
+    sizeof(discgolf_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // DISCGOLF_FACE_H_
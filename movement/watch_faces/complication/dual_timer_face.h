@@ -60,11 +60,8 @@
  * the timers. In this case LONG PRESSING MODE will move to the next face instead of moving
  * back to the default watch face.
  *
- * IMPORTANT: This watch face uses the same TC2 callback counter as the Stock Stopwatch
- * watch-face. It works through calling a global handler function. The two watch-faces
- * therefore can't coexist within the same firmware. If you want to compile this watch-face
- * then you need to remove the line <../watch_faces/complication/stock_stopwatch_face.c \>
- * from the Makefile.
+ * The timers are counted by the watch's monotonic counter (see watch_monotonic_start), which
+ * the Stock Stopwatch face shares, so the two can be in the same firmware.
  */
 
 #include "movement.h"
@@ -90,18 +87,15 @@ void dual_timer_face_activate(movement_settings_t *settings, void *context);
 bool dual_timer_face_loop(movement_event_t event, movement_settings_t *settings, void *context);
 void dual_timer_face_resign(movement_settings_t *settings, void *context);
 
-#if __EMSCRIPTEN__
-void em_dual_timer_cb_handler(void *userData);
-#else
-void TC2_Handler(void);
-#endif
-
 #define dual_timer_face ((const watch_face_t){ \
     dual_timer_face_setup, \
     dual_timer_face_activate, \
     dual_timer_face_loop, \
     dual_timer_face_resign, \
     NULL, \
+    sizeof(dual_timer_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // DUAL_TIMER_FACE_H_
@@ -53,6 +53,9 @@ void flashlight_face_resign(movement_settings_t *settings, void *context);
     flashlight_face_loop, \
     flashlight_face_resign, \
     NULL, \
+    sizeof(flashlight_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // FLASHLIGHT_FACE_H_
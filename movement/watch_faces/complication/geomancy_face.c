@@ -75,7 +75,7 @@ void geomancy_face_setup(movement_settings_t *settings, uint8_t watch_face_index
     (void) watch_face_index;
     (void) settings;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(geomancy_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(geomancy_state_t));
         memset(*context_ptr, 0, sizeof(geomancy_state_t));
     }
 }
@@ -93,6 +93,9 @@ void geomancy_face_resign(movement_settings_t *settings, void *context);
     geomancy_face_loop, \
     geomancy_face_resign, \
     NULL, \
+    sizeof(geomancy_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // GEOMANCY_FACE_H_
@@ -23,6 +23,7 @@
  */
 
 #include "habit_face.h"
+#include "movement_kv.h"
 #include "watch_private_display.h"
 #include "watch_rtc.h"
 #include "watch_slcd.h"
@@ -48,6 +49,13 @@ typedef struct {
   bool display_total;
 } habit_state_t;
 
+#define HABIT_FACE_KV_KEY "habit"
+
+// saved whenever it changes; Movement keeps the writes in RAM until the session's over.
+static inline void save_state(habit_state_t *state) {
+  movement_kv_set(HABIT_FACE_KV_KEY, state, sizeof(habit_state_t));
+}
+
 void habit_face_setup(movement_settings_t *settings, uint8_t watch_face_index,
                       void **context_ptr) {
   (void)settings;
@@ -56,9 +64,13 @@ void habit_face_setup(movement_settings_t *settings, uint8_t watch_face_index,
     *context_ptr = malloc(sizeof(habit_state_t));
     memset(*context_ptr, 0, sizeof(habit_state_t));
     habit_state_t *state = (habit_state_t *)*context_ptr;
-    state->lookback = 0;
-    state->last_update = watch_utility_offset_timestamp(
-        today_unix(settings->bit.time_zone), -24, 0, 0);
+    if (movement_kv_get(HABIT_FACE_KV_KEY, state, sizeof(habit_state_t)) !=
+        sizeof(habit_state_t)) {
+      memset(state, 0, sizeof(habit_state_t));
+      state->lookback = 0;
+      state->last_update = watch_utility_offset_timestamp(
+          today_unix(settings->bit.time_zone), -24, 0, 0);
+    }
   }
 }
 
@@ -124,12 +136,14 @@ bool habit_face_loop(movement_event_t event, movement_settings_t *settings,
         num_shifts = 7;
       state->lookback <<= num_shifts;
       state->last_update = today_now_unix;
+      save_state(state);
     }
     break;
   }
   case EVENT_LIGHT_BUTTON_UP: {
     state->display_total = !state->display_total;
     display_state(state);
+    save_state(state);
     break;
   }
   case EVENT_ALARM_BUTTON_UP: {
@@ -138,6 +152,7 @@ bool habit_face_loop(movement_event_t event, movement_settings_t *settings,
       state->total_count++;
       state->last_update = today_now_unix;
       display_state(state);
+      save_state(state);
     };
     break;
   }
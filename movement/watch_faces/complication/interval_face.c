@@ -30,6 +30,7 @@
 #include "watch_utility.h"
 #include "watch_private_display.h"
 #include "watch_buzzer.h"
+#include "movement_timer.h"
 
 typedef enum {
     interval_setting_0_timer_idx,
@@ -79,9 +80,6 @@ static const int8_t _sound_seq_finish[] = {BUZZER_NOTE_C7, 6, BUZZER_NOTE_E7, 6,
 static interval_setting_idx_t _setting_idx;
 static int8_t _ticks;
 static bool _erase_timer_flag;
-static uint32_t _target_ts;
-static uint32_t _now_ts;
-static uint32_t _paused_ts;
 static uint8_t _timer_work_round;
 static uint8_t _timer_full_round;
 static uint8_t _timer_run_state;
@@ -91,12 +89,6 @@ static inline void _inc_uint8(uint8_t *value, uint8_t step, uint8_t max) {
     if (*value >= max) *value = 0;
 }
 
-static uint32_t _get_now_ts() {
-    // returns the current date time as unix timestamp
-    watch_date_time now = watch_rtc_get_date_time();
-    return watch_utility_date_time_to_unix_time(now, 0);
-}
-
 static inline void _button_beep(movement_settings_t *settings) {
     // play a beep as confirmation for a button press (if applicable)
     if (settings->bit.button_should_sound) watch_buzzer_play_note(BUZZER_NOTE_C7, 50);
@@ -205,17 +197,13 @@ static void _face_draw(interval_face_state_t *state, uint8_t subsecond) {
         default:
             break;
         }
-        div_t delta;
-        
+        div_t delta = div(movement_timer_get_remaining(state->face_idx, 0), 60);
+
         if (state->face_state == interval_state_pausing) {
-            // pausing
-            delta = div(_target_ts - _paused_ts, 60);
             // blink the bell icon
-            if (_now_ts % 2) watch_set_indicator(WATCH_INDICATOR_BELL);
+            if (movement_get_local_date_time().unit.second % 2) watch_set_indicator(WATCH_INDICATOR_BELL);
             else watch_clear_indicator(WATCH_INDICATOR_BELL);
-        } else
-            // running
-            delta = div(_target_ts - _now_ts, 60);
+        }
         sprintf(&buf[2], " %1d%02d%02d%2d", state->timer_idx + 1, delta.quot, delta.rem, tmp + 1);
     }
     // write out to lcd
@@ -301,7 +289,7 @@ static void _handle_alarm_button(interval_face_state_t *state) {
     }
 }
 
-static void _set_next_timestamp(interval_face_state_t *state) {
+static void _set_next_timestamp(interval_face_state_t *state, bool chain) {
     // set next timestamp for the running timer, set background task and pay sound sequence
     uint16_t delta = 0;
     int8_t *sound_seq;
@@ -329,10 +317,9 @@ static void _set_next_timestamp(interval_face_state_t *state) {
     }
     // failsafe
     if (delta <= 0) delta = 1;
-    _target_ts += delta;
-    // schedule next background task
-    watch_date_time target_dt = watch_utility_date_time_from_unix_time(_target_ts, 0);
-    movement_schedule_background_task_for_face(state->face_idx, target_dt);
+    // each phase after the first starts when the last one ran out, so the session doesn't drift
+    if (chain) movement_timer_chain(state->face_idx, 0, delta, MOVEMENT_TIMER_SOUND_NONE);
+    else movement_timer_start(state->face_idx, 0, delta, MOVEMENT_TIMER_SOUND_NONE);
     // play sound
     watch_buzzer_play_sequence(sound_seq, NULL);
 }
@@ -351,20 +338,17 @@ static void _init_timer_info(interval_face_state_t *state) {
     if (state->is_active) movement_request_tick_frequency(2);
 }
 
-static void _abort_running_timer() {
+static void _abort_running_timer(interval_face_state_t *state) {
     _timer_work_round = _timer_full_round = 0;
     _timer_run_state = 0;
-    movement_cancel_background_task();
+    movement_timer_cancel(state->face_idx, 0);
     watch_clear_indicator(WATCH_INDICATOR_BELL);
     watch_buzzer_play_note(BUZZER_NOTE_C8, 100);
 }
 
 static void _resume_paused_timer(interval_face_state_t *state) {
     // resume paused timer
-    _now_ts = _get_now_ts();
-    _target_ts += _now_ts - _paused_ts;
-    watch_date_time target_dt = watch_utility_date_time_from_unix_time(_target_ts, 0);
-    movement_schedule_background_task_for_face(state->face_idx, target_dt);
+    movement_timer_resume(state->face_idx, 0);
     state->face_state = interval_state_running;
     watch_set_indicator(WATCH_INDICATOR_BELL);
 }
@@ -373,7 +357,7 @@ void interval_face_setup(movement_settings_t *settings, uint8_t watch_face_index
     (void) settings;
 
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(interval_face_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(interval_face_state_t));
         interval_face_state_t *state = (interval_face_state_t *)*context_ptr;
         memset(*context_ptr, 0, sizeof(interval_face_state_t));
         state->face_idx = watch_face_index;
@@ -446,7 +430,6 @@ bool interval_face_loop(movement_event_t event, movement_settings_t *settings, v
             }
             _face_draw(state, event.subsecond);
         } else if (state->face_state == interval_state_running || state->face_state == interval_state_pausing) {
-            _now_ts = _get_now_ts();
             _face_draw(state, event.subsecond);
         }
         break;
@@ -486,7 +469,7 @@ bool interval_face_loop(movement_event_t event, movement_settings_t *settings, v
         if (state->face_state == interval_state_setting) {
             _resume_setting(state, event.subsecond);
         } else {
-            if (state->face_state >= interval_state_running ) _abort_running_timer();
+            if (state->face_state >= interval_state_running ) _abort_running_timer(state);
             _initiate_setting(state, event.subsecond);
         }
         break;
@@ -506,9 +489,8 @@ bool interval_face_loop(movement_event_t event, movement_settings_t *settings, v
         case interval_state_running:
             // pause timer
             _button_beep(settings);
-            _paused_ts = _get_now_ts();
+            movement_timer_pause(state->face_idx, 0);
             state->face_state = interval_state_pausing;
-            movement_cancel_background_task();
             _face_draw(state, event.subsecond);
             break;
         case interval_state_pausing:
@@ -541,16 +523,14 @@ bool interval_face_loop(movement_event_t event, movement_settings_t *settings, v
                 else if (timer->break_minutes + timer->break_seconds) _timer_run_state = 2;
                 else if (timer->cooldown_minutes + timer->cooldown_seconds) _timer_run_state = 3;
                 movement_request_tick_frequency(1);
-                _now_ts = _get_now_ts();
-                _target_ts = _now_ts;
-                _set_next_timestamp(state);
+                _set_next_timestamp(state, false);
                 state->face_state = interval_state_running;
                 watch_set_indicator(WATCH_INDICATOR_BELL);
                 watch_set_colon();
             }
         } else if (state->face_state == interval_state_running) {
             // stop the timer
-            _abort_running_timer();
+            _abort_running_timer(state);
             _init_timer_info(state);
         } else if (state->face_state == interval_state_pausing) {
             // resume paused timer
@@ -563,6 +543,7 @@ bool interval_face_loop(movement_event_t event, movement_settings_t *settings, v
         _abort_quick_ticks();
         break;
     case EVENT_BACKGROUND_TASK:
+        if (!movement_timer_take_expired(state->face_idx)) break;
         // find the next timestamp or end the timer
         if (_timer_run_state == 0) {
             // warmup finished
@@ -602,7 +583,7 @@ bool interval_face_loop(movement_event_t event, movement_settings_t *settings, v
         // set next timestamp or play final sound sequence
         if (_timer_run_state < 4) {
             // transition to next timer phase
-            _set_next_timestamp(state);
+            _set_next_timestamp(state, true);
         } else {
             // timer has finished
             state->face_state = interval_state_waiting;
@@ -22,21 +22,19 @@
  * SOFTWARE.
  */
 
-// Emulator only: need time() to seed the random number generator
-#if __EMSCRIPTEN__
-#include <time.h>
-#endif
-
 #include <stdlib.h>
 #include <string.h>
 #include "watch_private_display.h"
+#include "movement_game.h"
 #include "invaders_face.h"
 
 #define INVADERS_FACE_WAVES_PER_STAGE 9 // number of waves per stage (there are two stages)
 #define INVADERS_FACE_WAVE_INVADERS 16  // number of invaders attacking per wave
+#define INVADERS_FACE_STEPS_PER_SECOND 4 // the game moves in quarter seconds
 
-static const uint8_t _defense_lines_segdata[3][2] = {{2, 12}, {2, 11}, {0, 11}};
-static const uint8_t _bonus_points_segdata[4][2] = {{2, 7}, {2, 8}, {2, 9}, {0, 10}};
+// one segment each, on COM 0 to 2
+static const watch_display_frame_t _defense_line_sprites[3] = {{{0, 0, 1 << 12}}, {{0, 0, 1 << 11}}, {{1 << 11, 0, 0}}};
+static const watch_display_frame_t _bonus_points_sprites[4] = {{{0, 0, 1 << 7}}, {{0, 0, 1 << 8}}, {{0, 0, 1 << 9}}, {{1 << 10, 0, 0}}};
 static const uint8_t _bonus_points_helper[] = {1, 5, 9, 11, 15, 19, 21, 25, 29};
 
 static const int8_t _sound_seq_game_start[] = {BUZZER_NOTE_A6, 1, BUZZER_NOTE_A7, 3, -2, 1, BUZZER_NOTE_REST, 10, BUZZER_NOTE_A6, 1, BUZZER_NOTE_A7, 3, -2, 1, 0};
@@ -72,23 +70,20 @@ static uint8_t _defense_lines;          // number of defense lines which have be
 static uint8_t _aim;                    // current "aim" digit
 static uint8_t _invader_idx;            // index of next invader attacking in current wave (0 to 15)
 static uint8_t _wave_position;          // current position of first invader. When > 6 the defense is broken
-static uint8_t _wave_tick_freq;         // number of ticks passing until the next invader is inserted
-static uint8_t _ticks;                  // counts the ticks
-static uint8_t _bonus_countdown;        // ticks countdown until the bonus point indicator is cleared
+static uint8_t _wave_tick_freq;         // number of steps passing until the next invader is inserted
+static uint8_t _ticks;                  // counts the steps
+static uint8_t _bonus_countdown;        // steps countdown until the bonus point indicator is cleared
 static uint8_t _waves;                  // counts the waves (_wave_tick_freq decreases slowly depending on _wave value)
 static uint8_t _shots_in_wave;          // number of shots in current wave. If 30 is reached, the game is over
 static uint8_t _invaders_shot;          // number of sucessfully shot invaders in current wave
 static uint8_t _invaders_shot_sum;      // current sum of invader digits shot (needed to determine if a ufo is coming)
 static invaders_signals_t _signals;     // holds severals flags
 static uint16_t _score;                 // score of the current game
+static movement_game_t _game;           // runs the steps, and only ticks while something is moving
 
 /// @brief return a random number. 0 <= return_value < num_values
 static inline uint8_t _get_rand_num(uint8_t num_values) {
-#if __EMSCRIPTEN__
-    return rand() % num_values;
-#else
-    return arc4random_uniform(num_values);
-#endif
+    return watch_random_uniform(num_values);
 }
 
 /// @brief callback function to re-enable light and alarm buttons after playing a sound sequence
@@ -104,7 +99,7 @@ static inline void _play_sequence(invaders_state_t *state, int8_t *sequence) {
 /// @brief draw the remaining defense lines
 static void _display_defense_lines() {
     watch_display_character(' ', 1);
-    for (uint8_t i = 0; i < 3 - _defense_lines; i++) watch_set_pixel(_defense_lines_segdata[i][0], _defense_lines_segdata[i][1]);
+    for (uint8_t i = 0; i < 3 - _defense_lines; i++) movement_game_draw_sprite(&_defense_line_sprites[i]);
 }
 
 /** @brief draw label followed by the given score value 
@@ -138,7 +133,7 @@ static inline void _display_invader(int8_t invader, uint8_t position) {
 static void _game_over(invaders_state_t *state) {
     _display_score("GO", _score);
     _current_state = invaders_state_game_over;
-    movement_request_tick_frequency(1);
+    movement_game_set_pace(&_game, MOVEMENT_GAME_WAITING);
     _signals.suspend_buttons = true;
     if (state->sound_on) watch_buzzer_play_sequence((int8_t *)_sound_seq_game_over, _resume_buttons);
     // save current score to highscore, if applicable
@@ -203,21 +198,78 @@ static bool _move_invaders() {
     return false;
 }
 
+/// @brief advance the game by one step
+static void _step(invaders_state_t *state) {
+    _ticks++;
+    switch (_current_state) {
+        case invaders_state_in_wave_break:
+        case invaders_state_pre_game:
+        case invaders_state_next_wave:
+            // wait 2 secs to start the first round
+            if (_ticks >= 2 * INVADERS_FACE_STEPS_PER_SECOND) {
+                _ticks = 0;
+                _init_wave();
+                _current_state = invaders_state_playing;
+                movement_game_set_pace(&_game, MOVEMENT_GAME_RUNNING);
+            }
+            break;
+        case invaders_state_playing:
+            // game is playing
+            if (_ticks >= _wave_tick_freq) {
+                _ticks = 0;
+                if (_move_invaders()) {
+                    // invaders broke through
+                    if (_defense_lines < 2) {
+                        // start current wave over
+                        _defense_lines++;
+                        _display_defense_lines();
+                        _display_score("GA", _score);
+                        _current_state = invaders_state_in_wave_break;
+                        movement_game_set_pace(&_game, MOVEMENT_GAME_SLOW);
+                        _play_sequence(state, (int8_t *)_sound_seq_def_gone);
+                    } else {
+                        // game over
+                        _game_over(state);
+                    }
+                }
+            }
+            // handle bonus points indicators
+            if (_bonus_countdown) {
+                _bonus_countdown--;
+                if (!_bonus_countdown) {
+                    watch_display_character(' ', 2);
+                    watch_display_character(' ', 3);
+                }
+            }
+            break;
+        case invaders_state_pre_next_wave:
+            if (_ticks >= 3) {
+                // switch to next wave
+                _ticks = 0;
+                movement_game_set_pace(&_game, MOVEMENT_GAME_SLOW);
+                _display_score("GA", _score);
+                watch_set_pixel(1, 9);
+                watch_display_character((_waves % INVADERS_FACE_WAVES_PER_STAGE) + 49, 3);
+                _current_state = invaders_state_next_wave;
+                _waves++;
+                if (_waves == INVADERS_FACE_WAVES_PER_STAGE * 2) _waves = 0;
+                _play_sequence(state, (int8_t *)_sound_seq_next_wave);
+            }
+        default:
+            break;
+    }
+}
+
 void invaders_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
     (void) settings;
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(invaders_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(invaders_state_t));
         memset(*context_ptr, 0, sizeof(invaders_state_t));
         invaders_state_t *state = (invaders_state_t *)*context_ptr;
         // default: sound on
         state->sound_on = true;
     }
-#if __EMSCRIPTEN__
-    // simulator only: seed the randon number generator
-    time_t t;
-    srand((unsigned) time(&t));
-#endif
 }
 
 void invaders_face_activate(movement_settings_t *settings, void *context) {
@@ -225,6 +277,8 @@ void invaders_face_activate(movement_settings_t *settings, void *context) {
     (void) context;
     _current_state = invaders_state_activated;
     _signals.suspend_buttons = false;
+    // nothing moves until the alarm button starts a game.
+    movement_game_start(&_game, INVADERS_FACE_STEPS_PER_SECOND, INVADERS_FACE_STEPS_PER_SECOND);
 }
 
 bool invaders_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
@@ -235,66 +289,13 @@ bool invaders_face_loop(movement_event_t event, movement_settings_t *settings, v
             // show highscore
             _display_score("GA", state->highscore);
             break;
-        case EVENT_TICK:
-            _ticks++;
-            switch (_current_state) {
-                case invaders_state_in_wave_break:
-                case invaders_state_pre_game:
-                case invaders_state_next_wave:
-                    // wait 2 secs to start the first round
-                    if (_ticks >= 2) {
-                        _ticks = 0;
-                        _init_wave();
-                        _current_state = invaders_state_playing;
-                        movement_request_tick_frequency(4);
-                    }
-                    break;
-                case invaders_state_playing:
-                    // game is playing
-                    if (_ticks >= _wave_tick_freq) {
-                        _ticks = 0;
-                        if (_move_invaders()) {
-                            // invaders broke through
-                            if (_defense_lines < 2) {
-                                // start current wave over
-                                _defense_lines++;
-                                _display_defense_lines();
-                                _display_score("GA", _score);
-                                _current_state = invaders_state_in_wave_break;
-                                movement_request_tick_frequency(1);
-                                _play_sequence(state, (int8_t *)_sound_seq_def_gone);
-                            } else {
-                                // game over
-                                _game_over(state);
-                            }
-                        }
-                    }
-                    // handle bonus points indicators
-                    if (_bonus_countdown) {
-                        _bonus_countdown--;
-                        if (!_bonus_countdown) {
-                            watch_display_character(' ', 2);
-                            watch_display_character(' ', 3);
-                        }
-                    }
-                    break;
-                case invaders_state_pre_next_wave:
-                    if (_ticks >= 3) {
-                        // switch to next wave
-                        _ticks = 0;
-                        movement_request_tick_frequency(1);
-                        _display_score("GA", _score);
-                        watch_set_pixel(1, 9);
-                        watch_display_character((_waves % INVADERS_FACE_WAVES_PER_STAGE) + 49, 3);
-                        _current_state = invaders_state_next_wave;
-                        _waves++;
-                        if (_waves == INVADERS_FACE_WAVES_PER_STAGE * 2) _waves = 0;
-                        _play_sequence(state, (int8_t *)_sound_seq_next_wave);
-                    }
-                default:
-                    break;
-            }
+        case EVENT_TICK: {
+            movement_game_begin_frame(&_game);
+            uint8_t pace = _game.pace;
+            for (uint8_t steps = movement_game_steps(&_game, event); steps && _game.pace == pace; steps--) _step(state);
+            movement_game_end_frame(&_game);
             break;
+        }
         case EVENT_LIGHT_BUTTON_DOWN:
             if (!_signals.suspend_buttons) {
                 if (_current_state == invaders_state_playing) {
@@ -315,6 +316,8 @@ bool invaders_face_loop(movement_event_t event, movement_settings_t *settings, v
             }
             break;
         case EVENT_ALARM_BUTTON_DOWN:
+            // a shot redraws several invaders and the bonus bars; they go out together.
+            movement_game_begin_frame(&_game);
             if (!_signals.suspend_buttons) {
                 switch (_current_state) {
                     case invaders_state_game_over:
@@ -322,7 +325,7 @@ bool invaders_face_loop(movement_event_t event, movement_settings_t *settings, v
                         // initialize the game
                         _waves = 0;
                         _score = 0;
-                        movement_request_tick_frequency(1);
+                        movement_game_set_pace(&_game, MOVEMENT_GAME_SLOW);
                         _ticks = 0;
                         _current_state = invaders_state_pre_game;
                         _play_sequence(state, (int8_t *)_sound_seq_game_start);
@@ -386,7 +389,7 @@ bool invaders_face_loop(movement_event_t event, movement_settings_t *settings, v
                                             if ((_waves >= INVADERS_FACE_WAVES_PER_STAGE) && i) bonus_points += (6 - i);
                                             _score += bonus_points;
                                             // represent bonus points by bars
-                                            for (j = 0; j < (bonus_points / 10); j++) watch_set_pixel(_bonus_points_segdata[j][0], _bonus_points_segdata[j][1]);
+                                            for (j = 0; j < (bonus_points / 10); j++) movement_game_draw_sprite(&_bonus_points_sprites[j]);
                                             _bonus_countdown = 9;
                                         } else {
                                             // regular invader
@@ -404,6 +407,7 @@ bool invaders_face_loop(movement_event_t event, movement_settings_t *settings, v
                         break;
                 }
             }
+            movement_game_end_frame(&_game);
             break;
         case EVENT_TIMEOUT:
             movement_move_to_face(0);
@@ -76,6 +76,9 @@ void invaders_face_resign(movement_settings_t *settings, void *context);
     invaders_face_loop, \
     invaders_face_resign, \
     NULL, \
+    sizeof(invaders_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // INVADERS_FACE_H_
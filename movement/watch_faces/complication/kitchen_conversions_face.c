@@ -25,13 +25,13 @@
 #include <stdlib.h>
 #include <string.h>
 #include "kitchen_conversions_face.h"
+#include "units.h"
 
 typedef struct
 {
     char name[6];          // Name to display on selection
-    double conv_factor_uk; // Unit as represented in base units (UK)
-    double conv_factor_us; // Unit as represented in base units (US)
-    int16_t linear_factor; // Addition of constant (For temperatures)
+    uint8_t unit_uk;       // Unit in the units library (UK)
+    uint8_t unit_us;       // Unit in the units library (US)
 } unit;
 
 #define TICK_FREQ 4
@@ -42,37 +42,37 @@ typedef struct
 #define VOL 2
 
 // Names of measurements
-static char measures[MEASURES_COUNT][6] = {"WeIght", " Temp", " VOL"};
+static const char measures[MEASURES_COUNT][6] = {"WeIght", " Temp", " VOL"};
 
 // Number of items in each category
 #define WEIGHT_COUNT 4
 #define TEMP_COUNT 3
 #define VOL_COUNT 9
-const uint8_t units_count[4] = {WEIGHT_COUNT, TEMP_COUNT, VOL_COUNT};
+static const uint8_t units_count[4] = {WEIGHT_COUNT, TEMP_COUNT, VOL_COUNT};
 
 static const unit weights[WEIGHT_COUNT] = {
-    {" g", 1., 1., 0}, // BASE
-    {" kg", 1000., 1000, 0},
-    {"Ounce", 28.34952, 28.34952, 0},
-    {" Pound", 453.5924, 453.5924, 0},
+    {" g", UNITS_GRAM, UNITS_GRAM},
+    {" kg", UNITS_KILOGRAM, UNITS_KILOGRAM},
+    {"Ounce", UNITS_OUNCE, UNITS_OUNCE},
+    {" Pound", UNITS_POUND, UNITS_POUND},
 };
 
 static const unit temps[TEMP_COUNT] = {
-    {" # C", 1.8, 1.8, 32},
-    {" # F", 1., 1., 0}, // BASE
-    {"Gas Mk", 25., 25., 250},
+    {" # C", UNITS_CELSIUS, UNITS_CELSIUS},
+    {" # F", UNITS_FAHRENHEIT, UNITS_FAHRENHEIT},
+    {"Gas Mk", UNITS_GAS_MARK, UNITS_GAS_MARK},
 };
 
 static const unit vols[VOL_COUNT] = {
-    {"  n&L", 1., 1., 0}, // BASE (ml)
-    {"   L", 1000., 1000., 0},
-    {" Fl Oz", 28.41306, 29.57353, 0},
-    {" Tbsp", 17.75816, 14.78677, 0},
-    {" Tsp", 5.919388, 4.928922, 0},
-    {"  Cup", 284.1306, 236.5882, 0},
-    {" Pint", 568.2612, 473.1765, 0},
-    {" Quart", 1136.522, 946.353, 0},
-    {"Gallon", 4546.09, 3785.412, 0},
+    {"  n&L", UNITS_MILLILITRE, UNITS_MILLILITRE},
+    {"   L", UNITS_LITRE, UNITS_LITRE},
+    {" Fl Oz", UNITS_UK_FLUID_OUNCE, UNITS_US_FLUID_OUNCE},
+    {" Tbsp", UNITS_UK_TABLESPOON, UNITS_US_TABLESPOON},
+    {" Tsp", UNITS_UK_TEASPOON, UNITS_US_TEASPOON},
+    {"  Cup", UNITS_UK_CUP, UNITS_US_CUP},
+    {" Pint", UNITS_UK_PINT, UNITS_US_PINT},
+    {" Quart", UNITS_UK_QUART, UNITS_US_QUART},
+    {"Gallon", UNITS_UK_GALLON, UNITS_US_GALLON},
 };
 
 static int8_t calc_success_seq[5] = {BUZZER_NOTE_G6, 10, BUZZER_NOTE_C7, 10, 0};
@@ -98,7 +98,7 @@ void kitchen_conversions_face_setup(movement_settings_t *settings, uint8_t watch
     (void)watch_face_index;
     if (*context_ptr == NULL)
     {
-        *context_ptr = malloc(sizeof(kitchen_conversions_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(kitchen_conversions_state_t));
         memset(*context_ptr, 0, sizeof(kitchen_conversions_state_t));
         // Do any one-time tasks in here; the inside of this conditional happens only at boot.
     }
@@ -177,7 +177,7 @@ static void display(kitchen_conversions_state_t *state, movement_settings_t *set
     case measurement:
     {
         watch_display_string("Un", 0);
-        watch_display_string(measures[state->measurement_i], 4);
+        watch_display_string((char *)measures[state->measurement_i], 4);
     }
     break;
 
@@ -243,16 +243,16 @@ static void display(kitchen_conversions_state_t *state, movement_settings_t *set
     {
         unit froms = get_unit_list(state->measurement_i)[state->from_i];
         unit tos = get_unit_list(state->measurement_i)[state->to_i];
-        // Chooses correct factor for locale
-        double f_conv_factor = state->from_is_us ? froms.conv_factor_us : froms.conv_factor_uk;
-        double t_conv_factor = state->to_is_us ? tos.conv_factor_us : tos.conv_factor_uk;
-        // Converts
-        double to_base = (state->selection_value * f_conv_factor) + 100 * froms.linear_factor;
-        double conversion = ((to_base - 100 * tos.linear_factor) / t_conv_factor);
+        // Chooses correct unit for locale, and converts (the input and the result are both in hundredths)
+        units_unit_t from_unit = state->from_is_us ? froms.unit_us : froms.unit_uk;
+        units_unit_t to_unit = state->to_is_us ? tos.unit_us : tos.unit_uk;
+        int32_t conversion;
+        bool converted = units_convert(state->selection_value, 2, from_unit, to_unit, 2, &conversion);
 
         // If number too large or too small
-        uint8_t lower_bound = (state->measurement_i == TEMP && state->to_i == 2) ? 100 : 0;
-        if (conversion >= 1000000 || conversion < lower_bound)
+        int32_t lower_bound = (state->measurement_i == TEMP && state->to_i == 2) ? 100 : 0;
+        char buf[7];
+        if (!converted || conversion < lower_bound || !units_format(buf, DISPLAY_DIGITS, conversion, 2, 0))
         {
             watch_set_indicator(WATCH_INDICATOR_BELL);
             watch_display_string("Err", 5);
@@ -262,21 +262,8 @@ static void display(kitchen_conversions_state_t *state, movement_settings_t *set
         }
         else
         {
-            uint32_t rounded = conversion + .5;
-            char buf[7];
-            sprintf(buf, "%6lu", rounded);
             watch_display_string(buf, 4);
 
-            // Make sure LSDs always filled
-            if (rounded < 10)
-            {
-                watch_display_string("00", 7);
-            }
-            else if (rounded < 100)
-            {
-                watch_display_string("0", 7);
-            }
-
             if (settings->bit.button_should_sound)
                 watch_buzzer_play_sequence(calc_success_seq, NULL);
         }
@@ -82,6 +82,9 @@ void kitchen_conversions_face_resign(movement_settings_t *settings, void *contex
     kitchen_conversions_face_loop,                      \
     kitchen_conversions_face_resign,                    \
     NULL,                                               \
+    sizeof(kitchen_conversions_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // KITCHEN_CONVERSIONS_FACE_H_
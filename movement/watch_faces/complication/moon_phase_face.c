@@ -30,22 +30,15 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
-#include <math.h>
 #include "moon_phase_face.h"
+#include "movement_moon.h"
 #include "watch_utility.h"
 
-#define LUNAR_DAYS 29.53058770576
-#define LUNAR_SECONDS (LUNAR_DAYS * (24 * 60 * 60))
-#define FIRST_MOON 947182440 // Saturday, 6 January 2000 18:14:00 in unix epoch time
-#define NUM_PHASES 8
-
-static const float phase_changes[] = {0, 1, 6.38264692644, 8.38264692644, 13.76529385288, 15.76529385288, 21.14794077932, 23.14794077932, 28.53058770576, 29.53058770576};
-
 void moon_phase_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
     (void) settings;
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(moon_phase_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(moon_phase_state_t));
         memset(*context_ptr, 0, sizeof(moon_phase_state_t));
     }
 }
@@ -55,40 +48,42 @@ void moon_phase_face_activate(movement_settings_t *settings, void *context) {
     (void) context;
 }
 
+static void _request_tick_at_top_of_hour(void) {
+    // the display only changes once an hour, so there's no need to wake up every second.
+    watch_date_time date_time = movement_get_local_date_time();
+    uint32_t timestamp = watch_utility_date_time_to_unix_time(date_time, 0);
+    timestamp += 3600 - (date_time.unit.minute * 60 + date_time.unit.second);
+    movement_request_next_tick(watch_utility_date_time_from_unix_time(timestamp, 0));
+}
+
 static void _update(movement_settings_t *settings, moon_phase_state_t *state, uint32_t offset) {
+    (void) settings;
     (void)state;
     char buf[11];
-    watch_date_time date_time = watch_rtc_get_date_time();
-    uint32_t now = watch_utility_date_time_to_unix_time(date_time, movement_timezone_offsets[settings->bit.time_zone] * 60) + offset;
-    date_time = watch_utility_date_time_from_unix_time(now, movement_timezone_offsets[settings->bit.time_zone] * 60);
-    double currentfrac = fmod(now - FIRST_MOON, LUNAR_SECONDS) / LUNAR_SECONDS;
-    double currentday = currentfrac * LUNAR_DAYS;
-    uint8_t phase_index = 0;
-
-    for(phase_index = 0; phase_index <= NUM_PHASES; phase_index++) {
-        if (currentday > phase_changes[phase_index] && currentday <= phase_changes[phase_index + 1]) break;
-    }
+    watch_date_time date_time = movement_get_local_date_time();
+    uint32_t now = watch_utility_date_time_to_unix_time(date_time, movement_get_current_timezone_offset() * 60) + offset;
+    date_time = watch_utility_date_time_from_unix_time(now, movement_get_current_timezone_offset() * 60);
+    movement_moon_phase_t moon = movement_moon_get_phase(now);
 
     watch_display_string(" ", 0);
-    switch (phase_index) {
-        case 0:
-        case 8:
+    switch (moon.phase) {
+        case MOVEMENT_MOON_NEW:
             sprintf(buf, "%2d Neu  ", date_time.unit.day);
             break;
-        case 1:
+        case MOVEMENT_MOON_WAXING_CRESCENT:
             sprintf(buf, "%2dCresnt", date_time.unit.day);
             watch_set_pixel(2, 13);
             watch_set_pixel(2, 15);
-            if (currentfrac > 0.125) watch_set_pixel(1, 13);
+            if (moon.fraction > 65536 / 8) watch_set_pixel(1, 13);
             break;
-        case 2:
+        case MOVEMENT_MOON_FIRST_QUARTER:
             sprintf(buf, "%2d 1st q", date_time.unit.day);
             watch_set_pixel(2, 13);
             watch_set_pixel(2, 15);
             watch_set_pixel(1, 13);
             watch_set_pixel(1, 14);
             break;
-        case 3:
+        case MOVEMENT_MOON_WAXING_GIBBOUS:
             sprintf(buf, "%2d Gibb ", date_time.unit.day);
             watch_set_pixel(2, 13);
             watch_set_pixel(2, 15);
@@ -96,7 +91,7 @@ static void _update(movement_settings_t *settings, moon_phase_state_t *state, ui
             watch_set_pixel(1, 13);
             watch_set_pixel(1, 15);
             break;
-        case 4:
+        case MOVEMENT_MOON_FULL:
             sprintf(buf, "%2d FULL ", date_time.unit.day);
             watch_set_pixel(2, 13);
             watch_set_pixel(2, 15);
@@ -107,7 +102,7 @@ static void _update(movement_settings_t *settings, moon_phase_state_t *state, ui
             watch_set_pixel(0, 13);
             watch_set_pixel(1, 13);
             break;
-        case 5:
+        case MOVEMENT_MOON_WANING_GIBBOUS:
             sprintf(buf, "%2d Gibb ", date_time.unit.day);
             watch_set_pixel(1, 14);
             watch_set_pixel(2, 14);
@@ -115,18 +110,18 @@ static void _update(movement_settings_t *settings, moon_phase_state_t *state, ui
             watch_set_pixel(0, 14);
             watch_set_pixel(0, 13);
             break;
-        case 6:
+        case MOVEMENT_MOON_THIRD_QUARTER:
             sprintf(buf, "%2d 3rd q", date_time.unit.day);
             watch_set_pixel(1, 14);
             watch_set_pixel(2, 14);
             watch_set_pixel(0, 14);
             watch_set_pixel(0, 13);
             break;
-        case 7:
+        case MOVEMENT_MOON_WANING_CRESCENT:
             sprintf(buf, "%2dCresnt", date_time.unit.day);
             watch_set_pixel(0, 14);
             watch_set_pixel(0, 13);
-            if (currentfrac < 0.875) watch_set_pixel(2, 14);
+            if (moon.fraction < 65536 * 7 / 8) watch_set_pixel(2, 14);
             break;
     }
     watch_display_string(buf, 2);
@@ -134,21 +129,21 @@ static void _update(movement_settings_t *settings, moon_phase_state_t *state, ui
 
 bool moon_phase_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
     moon_phase_state_t *state = (moon_phase_state_t *)context;
-    watch_date_time date_time;
 
     switch (event.event_type) {
         case EVENT_ACTIVATE:
             _update(settings, state, state->offset);
+            _request_tick_at_top_of_hour();
             break;
         case EVENT_TICK:
-            // only update once an hour
-            date_time = watch_rtc_get_date_time();
-            if ((date_time.unit.minute == 0) && (date_time.unit.second == 0)) _update(settings, state, state->offset);
+            // we only get a tick at the top of the hour
+            _update(settings, state, state->offset);
+            _request_tick_at_top_of_hour();
             break;
         case EVENT_LOW_ENERGY_UPDATE:
             // update at the top of the hour OR if we're entering sleep mode with an offset.
             // also, in sleep mode, always show the current moon phase (offset = 0).
-            if (state->offset || (watch_rtc_get_date_time().unit.minute == 0)) _update(settings, state, 0);
+            if (state->offset || (movement_get_local_date_time().unit.minute == 0)) _update(settings, state, 0);
             // and kill the offset so when the wearer wakes up, it matches what's on screen.
             state->offset = 0;
             // finally: clear out the last two digits and replace them with the sleep mode indicator
@@ -66,6 +66,9 @@ void moon_phase_face_resign(movement_settings_t *settings, void *context);
     moon_phase_face_loop, \
     moon_phase_face_resign, \
     NULL, \
+    sizeof(moon_phase_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // MOON_PHASE_FACE_H_
@@ -24,7 +24,6 @@
 
 #include <stdlib.h>
 #include <string.h>
-#include <math.h>
 
 #include "watch.h"
 #include "watch_utility.h"
@@ -66,6 +65,8 @@ void morsecalc_input(morsecalc_state_t * mcs) {
         case ' ': // Submit token to calculator
             if(mcs->idxt > 0) {
                 mcs->token[mcs->idxt] = '\0';
+                // parsing and evaluating the token is soft-float math.
+                movement_request_performance(MOVEMENT_PERFORMANCE_HIGH);
                 status = calc_input(mcs->cs, mcs->token);
                 morsecalc_reset_token(mcs); 
             } 
@@ -110,7 +111,7 @@ void morsecalc_face_setup(movement_settings_t *settings, uint8_t watch_face_inde
     (void) settings;
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(morsecalc_state_t)); 
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(morsecalc_state_t)); 
         morsecalc_state_t *mcs = (morsecalc_state_t *)*context_ptr;
         morsecalc_reset_token(mcs); 
         
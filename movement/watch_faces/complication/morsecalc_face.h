@@ -31,11 +31,12 @@
  *
  * The calculator is operated by first composing a **token** in Morse code,
  * then submitting it to the calculator. A token specifies either a calculator
- * operation or a float value.
+ * operation or a number.
  *
  * These two parts of the codebase are totally independent:
  *  1. The Morse-code reader (`mc.h`, `mc.c`)
- *  2. The RPN calculator (`calc.h`, `calc.c`, `calc_fn.h`, `calc_fn.c`, `small_strtod.c`)
+ *  2. The RPN calculator (`calc.h`, `calc.c`, `calc_fns.h`), which works out its operations and
+ *     reads numbers with the decimal number core the other calculator faces share (`movement/lib/calc`)
  *
  * The user interface (`morsecalc_face.h`, `morsecalc_face.c`) lets you talk
  * to the RPN calculator through Morse code.
@@ -71,7 +72,7 @@
  * If the command doesn't appear in the dictionary, the calculator tries to interpret the token as a number.
  *
  * ## Writing numbers
- * Numbers are written like floating point strings.
+ * Numbers are written like floating point strings. The calculator keeps nine significant digits.
  * Entering a number pushes it to the top of the stack if there's room.
  * This can get long, so for convenience numerals can also be written in binary with .- = 01.
  *
@@ -158,6 +159,9 @@ void morsecalc_input(morsecalc_state_t *mcs);
     morsecalc_face_loop, \
     morsecalc_face_resign, \
     NULL, \
+    sizeof(morsecalc_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // MORSECALC_FACE_H_
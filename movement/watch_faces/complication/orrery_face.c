@@ -28,8 +28,6 @@
 #include "orrery_face.h"
 #include "watch.h"
 #include "watch_utility.h"
-#include "vsop87a_micro.h" // smaller size, less accurate
-#include "vsop87a_milli.h"
 #include "astrolib.h"
 
 #define NUM_AVAILABLE_BODIES 9
@@ -46,55 +44,42 @@ static const char orrery_celestial_body_names[NUM_AVAILABLE_BODIES][3] = {
     "NE"    // Neptune
 };
 
-static void _orrery_face_recalculate(movement_settings_t *settings, orrery_state_t *state) {
-    watch_date_time date_time = watch_rtc_get_date_time();
-    uint32_t timestamp = watch_utility_date_time_to_unix_time(date_time, movement_timezone_offsets[settings->bit.time_zone] * 60);
-    date_time = watch_utility_date_time_from_unix_time(timestamp, 0);
-    double jd = astro_convert_date_to_julian_date(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR, date_time.unit.month, date_time.unit.day, date_time.unit.hour, date_time.unit.minute, date_time.unit.second);
-    double et = astro_convert_jd_to_julian_millenia_since_j2000(jd);
-    double r[3] = {0};
+static const astro_body_t orrery_celestial_bodies[NUM_AVAILABLE_BODIES] = {
+    ASTRO_BODY_MERCURY,
+    ASTRO_BODY_VENUS,
+    ASTRO_BODY_EARTH,
+    ASTRO_BODY_MOON,
+    ASTRO_BODY_MARS,
+    ASTRO_BODY_JUPITER,
+    ASTRO_BODY_SATURN,
+    ASTRO_BODY_URANUS,
+    ASTRO_BODY_NEPTUNE
+};
 
-    switch(state->active_body_index) {
-        case 0:
-            vsop87a_milli_getMercury(et, r);
-            break;
-        case 1:
-            vsop87a_milli_getVenus(et, r);
-            break;
-        case 2:
-            vsop87a_milli_getEarth(et, r);
-            break;
-        case 3:
-            {
-                 double earth[3];
-                 double emb[3];
-                 vsop87a_milli_getEarth(et, earth);
-                 vsop87a_milli_getEmb(et, emb);
-                 vsop87a_milli_getMoon(earth, emb, r);
-             }
-            break;
-        case 4:
-            vsop87a_milli_getMars(et, r);
-            break;
-        case 5:
-            vsop87a_milli_getJupiter(et, r);
-            break;
-        case 6:
-            vsop87a_milli_getSaturn(et, r);
-            break;
-        case 7:
-            vsop87a_milli_getUranus(et, r);
-            break;
-        case 8:
-            vsop87a_milli_getNeptune(et, r);
-            break;
+static void _orrery_face_update(movement_event_t event, orrery_state_t *state);
+
+// runs as a Movement job, once the face has put up the "calculating" screen. where the VSOP87 series have to be summed,
+// each axis is a step of its own, and the buttons get a look in between.
+static bool _orrery_face_recalculate(void *context) {
+    orrery_state_t *state = (orrery_state_t *)context;
+    if (state->calculation_step == 0) {
+        watch_date_time date_time = movement_get_utc_date_time();
+        double jd = astro_convert_date_to_julian_date(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR, date_time.unit.month, date_time.unit.day, date_time.unit.hour, date_time.unit.minute, date_time.unit.second);
+        state->et = astro_convert_jd_to_julian_millenia_since_j2000(jd);
     }
-    state->coords[0] = r[0];
-    state->coords[1] = r[1];
-    state->coords[2] = r[2];
+    movement_request_performance(MOVEMENT_PERFORMANCE_HIGH);
+    // positions come from the Chebyshev ephemeris where it covers the date, and from VSOP87 otherwise.
+    if (!astro_get_body_coordinates_step(orrery_celestial_bodies[state->active_body_index], state->et, state->calculation_step++, state->coords)) return false;
+
+    // we cancel the job on resign, so we're still on screen.
+    watch_stop_blink();
+    state->mode = ORRERY_MODE_DISPLAYING_X;
+    movement_event_t event = { EVENT_NONE, 0 };
+    _orrery_face_update(event, state);
+    return true;
 }
 
-static void _orrery_face_update(movement_event_t event, movement_settings_t *settings, orrery_state_t *state) {
+static void _orrery_face_update(movement_event_t event, orrery_state_t *state) {
     char buf[11];
     switch (state->mode) {
         case ORRERY_MODE_SELECTING_BODY:
@@ -124,13 +109,14 @@ static void _orrery_face_update(movement_event_t event, movement_settings_t *set
             }
             break;
         case ORRERY_MODE_CALCULATING:
-            watch_clear_display();
-             // this takes a moment and locks the UI, flash C for "Calculating"
-            watch_start_character_blink('C', 100);
-            _orrery_face_recalculate(settings, state);
-            watch_stop_blink();
-            state->mode = ORRERY_MODE_DISPLAYING_X;
-            // fall through
+            // this takes a moment, so flash C for "Calculating" while Movement gets on with it.
+            if (event.event_type == EVENT_ALARM_LONG_PRESS) {
+                watch_clear_display();
+                watch_start_character_blink('C', 100);
+                state->calculation_step = 0;
+                movement_post_job(state->watch_face_index, _orrery_face_recalculate, state);
+            }
+            break;
         case ORRERY_MODE_DISPLAYING_X:
             sprintf(buf, "%s X%6d", orrery_celestial_body_names[state->active_body_index], (int16_t)round(state->coords[0] * 100));
             watch_display_string(buf, 0);
@@ -151,10 +137,10 @@ static void _orrery_face_update(movement_event_t event, movement_settings_t *set
 
 void orrery_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
     (void) settings;
-    (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(orrery_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(orrery_state_t));
         memset(*context_ptr, 0, sizeof(orrery_state_t));
+        ((orrery_state_t *)*context_ptr)->watch_face_index = watch_face_index;
     }
 }
 
@@ -171,7 +157,7 @@ bool orrery_face_loop(movement_event_t event, movement_settings_t *settings, voi
     switch (event.event_type) {
         case EVENT_ACTIVATE:
         case EVENT_TICK:
-            _orrery_face_update(event, settings, state);
+            _orrery_face_update(event, state);
             break;
         case EVENT_ALARM_BUTTON_UP:
             switch (state->mode) {
@@ -191,19 +177,19 @@ bool orrery_face_loop(movement_event_t event, movement_settings_t *settings, voi
                     state->mode++;
                     break;
             }
-            _orrery_face_update(event, settings, state);
+            _orrery_face_update(event, state);
             break;
         case EVENT_ALARM_LONG_PRESS:
             if (state->mode == ORRERY_MODE_SELECTING_BODY) {
                 // celestial body selected! this triggers a calculation in the update method.
                 state->mode = ORRERY_MODE_CALCULATING;
                 movement_request_tick_frequency(1);
-                _orrery_face_update(event, settings, state);
+                _orrery_face_update(event, state);
             } else if (state->mode != ORRERY_MODE_CALCULATING) {
                 // in all modes except "doing a calculation", return to the selection screen.
                 state->mode = ORRERY_MODE_SELECTING_BODY;
                 movement_request_tick_frequency(4);
-                _orrery_face_update(event, settings, state);
+                _orrery_face_update(event, state);
             }
             break;
         case EVENT_TIMEOUT:
@@ -220,5 +206,8 @@ bool orrery_face_loop(movement_event_t event, movement_settings_t *settings, voi
 void orrery_face_resign(movement_settings_t *settings, void *context) {
     (void) settings;
     orrery_state_t *state = (orrery_state_t *)context;
+    // a calculation still going is for nothing now.
+    movement_cancel_jobs_for_face(state->watch_face_index);
+    watch_stop_blink();
     state->mode = ORRERY_MODE_SELECTING_BODY;
 }
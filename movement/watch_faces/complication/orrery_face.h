@@ -82,7 +82,10 @@ typedef struct {
     orrery_mode_t mode;
     uint8_t active_body_index;
     double coords[3];
+    double et;                  // the moment being calculated for, in Julian millenia since J2000
+    uint8_t calculation_step;   // @see astro_get_body_coordinates_step
     uint8_t animation_state;
+    uint8_t watch_face_index;
 } orrery_state_t;
 
 void orrery_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
@@ -96,6 +99,9 @@ void orrery_face_resign(movement_settings_t *settings, void *context);
     orrery_face_loop, \
     orrery_face_resign, \
     NULL, \
+    sizeof(orrery_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // ORRERY_FACE_H_
@@ -25,7 +25,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
-#include "sunriset.h"
+#include "movement_solar.h"
 #include "watch.h"
 #include "watch_utility.h"
 #include "planetary_hours_face.h"
@@ -114,6 +114,7 @@ static void _planetary_icon(uint8_t planet) {
  *  It also calculates the start of the next following phase.
  */
 static void _planetary_solar_phases(movement_settings_t *settings, planetary_hours_state_t *state) {
+    (void) settings;
     uint8_t phase, h;
     double sunrise, sunset;
     double hour_duration, next_hour_duration;
@@ -134,23 +135,17 @@ static void _planetary_solar_phases(movement_settings_t *settings, planetary_hou
     state->no_location = false;
 
     watch_date_time date_time = watch_rtc_get_date_time(); // the current local date / time
-    watch_date_time utc_now = watch_utility_date_time_convert_zone(date_time, movement_timezone_offsets[settings->bit.time_zone] * 60, 0); // the current date / time in UTC
+    watch_date_time utc_now = watch_utility_date_time_convert_zone(date_time, movement_get_current_timezone_offset() * 60, 0); // the current date / time in UTC
     watch_date_time scratch_time; // scratchpad, contains different values at different times
     watch_date_time midnight;
     scratch_time.reg = midnight.reg = utc_now.reg;
     midnight.unit.hour = midnight.unit.minute = midnight.unit.second = 0; // start of the day at midnight
 
-    // get location coordinate
-    int16_t lat_centi = (int16_t)movement_location.bit.latitude;
-    int16_t lon_centi = (int16_t)movement_location.bit.longitude;
-    double lat = (double)lat_centi / 100.0;
-    double lon = (double)lon_centi / 100.0;
-
     // save UTC offset
-    state->utc_offset = ((double)movement_timezone_offsets[settings->bit.time_zone]) / 60.0;
+    state->utc_offset = ((double)movement_get_current_timezone_offset()) / 60.0;
 
     // calculate sunrise and sunset of current day in decimal hours after midnight
-    sun_rise_set(scratch_time.unit.year + WATCH_RTC_REFERENCE_YEAR, scratch_time.unit.month, scratch_time.unit.day, lon, lat, &sunrise, &sunset);
+    movement_solar_get_rise_set(scratch_time, &sunrise, &sunset);
     
     // calculate sunrise and sunset UNIX timestamps
     midnight_epoch_today = watch_utility_date_time_to_unix_time(midnight, 0);
@@ -160,13 +155,13 @@ static void _planetary_solar_phases(movement_settings_t *settings, planetary_hou
     // go back to yesterday and calculate sunset
     midnight_epoch_yesterday = midnight_epoch_today - 86400;
     scratch_time = watch_utility_date_time_from_unix_time(midnight_epoch_yesterday, 0);
-    sun_rise_set(scratch_time.unit.year + WATCH_RTC_REFERENCE_YEAR, scratch_time.unit.month, scratch_time.unit.day, lon, lat, &sunrise, &sunset);
+    movement_solar_get_rise_set(scratch_time, &sunrise, &sunset);
     sunset_epoch_yesterday = midnight_epoch_yesterday + sunset * 3600;
 
     // go to tomorrow and calculate sunrise and sunset
     midnight_epoch_tomorrow = midnight_epoch_today + 86400;
     scratch_time = watch_utility_date_time_from_unix_time(midnight_epoch_tomorrow, 0);
-    sun_rise_set(scratch_time.unit.year + WATCH_RTC_REFERENCE_YEAR, scratch_time.unit.month, scratch_time.unit.day, lon, lat, &sunrise, &sunset);
+    movement_solar_get_rise_set(scratch_time, &sunrise, &sunset);
     sunrise_epoch_tomorrow = midnight_epoch_tomorrow + sunrise * 3600;
     sunset_epoch_tomorrow = midnight_epoch_tomorrow + sunset * 3600;
 
@@ -237,7 +232,7 @@ static void _planetary_hours(movement_settings_t *settings, planetary_hours_stat
 
     // get current time
     watch_date_time date_time = watch_rtc_get_date_time(); // the current local date / time
-    watch_date_time utc_now = watch_utility_date_time_convert_zone(date_time, movement_timezone_offsets[settings->bit.time_zone] * 60, 0); // the current date / time in UTC
+    watch_date_time utc_now = watch_utility_date_time_convert_zone(date_time, movement_get_current_timezone_offset() * 60, 0); // the current date / time in UTC
     current_hour_epoch = watch_utility_date_time_to_unix_time(utc_now, 0);
     
     // set the current planetary hour as default screen
@@ -338,7 +333,7 @@ void planetary_hours_face_setup(movement_settings_t *settings, uint8_t watch_fac
     (void) watch_face_index;
     (void) settings;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(planetary_hours_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(planetary_hours_state_t));
         memset(*context_ptr, 0, sizeof(planetary_hours_state_t));
     }
 }
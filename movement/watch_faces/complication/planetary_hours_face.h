@@ -103,6 +103,9 @@ void planetary_hours_face_resign(movement_settings_t *settings, void *context);
     planetary_hours_face_loop, \
     planetary_hours_face_resign, \
     NULL, \
+    sizeof(planetary_hours_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // planetary_hours_face_H_
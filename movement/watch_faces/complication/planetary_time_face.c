@@ -25,7 +25,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
-#include "sunriset.h"
+#include "movement_solar.h"
 #include "watch.h"
 #include "watch_utility.h"
 #include "planetary_time_face.h"
@@ -113,6 +113,7 @@ static void _planetary_icon(uint8_t planet) {
  *  This function calculates the start and end of the current phase based on a given geographic location.
  */
 static void _planetary_solar_phase(movement_settings_t *settings, planetary_time_state_t *state) {
+    (void) settings;
     uint8_t phase;
     double sunrise, sunset;
     uint32_t now_epoch, sunrise_epoch, sunset_epoch, midnight_epoch;
@@ -129,27 +130,21 @@ static void _planetary_solar_phase(movement_settings_t *settings, planetary_time
     state->no_location = false;
 
     watch_date_time date_time = watch_rtc_get_date_time(); // the current local date / time
-    watch_date_time utc_now = watch_utility_date_time_convert_zone(date_time, movement_timezone_offsets[settings->bit.time_zone] * 60, 0); // the current date / time in UTC
+    watch_date_time utc_now = watch_utility_date_time_convert_zone(date_time, movement_get_current_timezone_offset() * 60, 0); // the current date / time in UTC
     watch_date_time scratch_time; // scratchpad, contains different values at different times
     watch_date_time midnight;
     scratch_time.reg = midnight.reg = utc_now.reg;
     midnight.unit.hour = midnight.unit.minute = midnight.unit.second = 0; // start of the day at midnight
 
-    // get location coordinate
-    int16_t lat_centi = (int16_t)movement_location.bit.latitude;
-    int16_t lon_centi = (int16_t)movement_location.bit.longitude;
-    double lat = (double)lat_centi / 100.0;
-    double lon = (double)lon_centi / 100.0;
-
     // save UTC offset
-    state->utc_offset = ((double)movement_timezone_offsets[settings->bit.time_zone]) / 60.0;
+    state->utc_offset = ((double)movement_get_current_timezone_offset()) / 60.0;
 
     // get UNIX epoch time
     now_epoch = watch_utility_date_time_to_unix_time(utc_now, 0);
     midnight_epoch = watch_utility_date_time_to_unix_time(midnight, 0);
 
     // calculate sunrise and sunset of current day in decimal hours after midnight
-    sun_rise_set(scratch_time.unit.year + WATCH_RTC_REFERENCE_YEAR, scratch_time.unit.month, scratch_time.unit.day, lon, lat, &sunrise, &sunset);
+    movement_solar_get_rise_set(scratch_time, &sunrise, &sunset);
     
     // calculate sunrise and sunset UNIX timestamps
     sunrise_epoch = midnight_epoch + sunrise * 3600;
@@ -170,7 +165,7 @@ static void _planetary_solar_phase(movement_settings_t *settings, planetary_time
         // go back to yesterday and calculate sunset
         midnight_epoch -= 86400;
         scratch_time = watch_utility_date_time_from_unix_time(midnight_epoch, 0);
-        sun_rise_set(scratch_time.unit.year + WATCH_RTC_REFERENCE_YEAR, scratch_time.unit.month, scratch_time.unit.day, lon, lat, &sunrise, &sunset);
+        movement_solar_get_rise_set(scratch_time, &sunrise, &sunset);
         sunset_epoch = midnight_epoch + sunset * 3600;
         // we are still in yesterday's night hours
         state->night = true;
@@ -183,7 +178,7 @@ static void _planetary_solar_phase(movement_settings_t *settings, planetary_time
         // skip to tomorrow and calculate sunrise
         midnight_epoch += 86400;
         scratch_time = watch_utility_date_time_from_unix_time(midnight_epoch, 0);
-        sun_rise_set(scratch_time.unit.year + WATCH_RTC_REFERENCE_YEAR, scratch_time.unit.month, scratch_time.unit.day, lon, lat, &sunrise, &sunset);
+        movement_solar_get_rise_set(scratch_time, &sunrise, &sunset);
         sunrise_epoch = midnight_epoch + sunrise * 3600;
         // we are still in yesterday's night hours
         state->night = true;
@@ -210,7 +205,7 @@ static void _planetary_time(movement_event_t event, movement_settings_t *setting
         watch_set_colon();
 
     // get current time and convert to UTC
-    state->scratch = watch_utility_date_time_convert_zone(watch_rtc_get_date_time(), movement_timezone_offsets[settings->bit.time_zone] * 60, 0); 
+    state->scratch = watch_utility_date_time_convert_zone(watch_rtc_get_date_time(), movement_get_current_timezone_offset() * 60, 0); 
 
     // when current phase ends calculate the next phase
     if ( watch_utility_date_time_to_unix_time(state->scratch, 0) >= state->phase_end ) {
@@ -274,7 +269,7 @@ void planetary_time_face_setup(movement_settings_t *settings, uint8_t watch_face
     (void) watch_face_index;
     (void) settings;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(planetary_time_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(planetary_time_state_t));
         memset(*context_ptr, 0, sizeof(planetary_time_state_t));
     }
 }
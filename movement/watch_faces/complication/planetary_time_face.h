@@ -104,6 +104,9 @@ void planetary_time_face_resign(movement_settings_t *settings, void *context);
     planetary_time_face_loop, \
     planetary_time_face_resign, \
     NULL, \
+    sizeof(planetary_time_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // planetary_time_face_H_
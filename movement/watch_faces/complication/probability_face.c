@@ -22,17 +22,11 @@
  * SOFTWARE.
  */
 
-// Emulator only: need time() to seed the random number generator.
-#if __EMSCRIPTEN__
-#include <time.h>
-#endif
-
 #include <stdlib.h>
 #include <string.h>
 #include "probability_face.h"
 
 #define DEFAULT_DICE_SIDES 2
-#define PROBABILITY_ANIMATION_TICK_FREQUENCY 8
 const uint16_t NUM_DICE_TYPES = 8; // Keep this consistent with # of dice types below
 const uint16_t DICE_TYPES[] = {2, 4, 6, 8, 10, 12, 20, 100};
 
@@ -64,40 +58,23 @@ static void display_dice_roll(probability_state_t *state) {
 }
 
 static void generate_random_number(probability_state_t *state) {
-    // Emulator: use rand. Hardware: use arc4random.
-    #if __EMSCRIPTEN__
-    state->rolled_value = rand() % state->dice_sides + 1;
-    #else
-    state->rolled_value = arc4random_uniform(state->dice_sides) + 1;
-    #endif
+    state->rolled_value = watch_random_uniform(state->dice_sides) + 1;
 }
 
-static void display_dice_roll_animation(probability_state_t *state) {
-    if (state->is_rolling) {
-        if (state->animation_frame == 0) {
-            watch_display_string("   ", 7);
-            watch_set_pixel(1, 4);
-            watch_set_pixel(1, 6);
-            state->animation_frame = 1;
-        } else if (state->animation_frame == 1) {
-            watch_clear_pixel(1, 4);
-            watch_clear_pixel(1, 6);
-            watch_set_pixel(2, 4);
-            watch_set_pixel(0, 6);
-            state->animation_frame = 2;
-        } else if (state->animation_frame == 2) {
-            watch_clear_pixel(2, 4);
-            watch_clear_pixel(0, 6);
-            watch_set_pixel(2, 5);
-            watch_set_pixel(0, 5);
-            state->animation_frame = 3;
-        } else if (state->animation_frame == 3) {
-            state->animation_frame = 0;
-            state->is_rolling = false;
-            movement_request_tick_frequency(1);
-            display_dice_roll(state);
-        }
-    }
+// the die tumbles through position 9: middle, then the diagonals, then the verticals, an eighth of a second each.
+#define PROBABILITY_ANIMATION_FRAME_DURATION 125
+static const uint32_t dice_roll_animation_mask[3] = {(1 << 5) | (1 << 6), (1 << 4) | (1 << 6), (1 << 4) | (1 << 5)};
+static const watch_display_frame_t dice_roll_animation[] = {
+    {{0, (1 << 4) | (1 << 6), 0}},
+    {{1 << 6, 0, 1 << 4}},
+    {{1 << 5, 0, 1 << 5}},
+};
+
+static void start_dice_roll_animation(probability_state_t *state) {
+    state->is_rolling = true;
+    watch_display_string("   ", 7);
+    movement_play_animation(dice_roll_animation, sizeof(dice_roll_animation) / sizeof(dice_roll_animation[0]),
+                            dice_roll_animation_mask, PROBABILITY_ANIMATION_FRAME_DURATION, 1);
 }
 
 
@@ -108,13 +85,9 @@ void probability_face_setup(movement_settings_t *settings, uint8_t watch_face_in
     (void) settings;
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(probability_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(probability_state_t));
         memset(*context_ptr, 0, sizeof(probability_state_t));
     }
-    // Emulator only: Seed random number generator
-    #if __EMSCRIPTEN__
-    srand(time(NULL));
-    #endif
 }
 
 void probability_face_activate(movement_settings_t *settings, void *context) {
@@ -123,6 +96,8 @@ void probability_face_activate(movement_settings_t *settings, void *context) {
 
     state->dice_sides = DEFAULT_DICE_SIDES;
     state->rolled_value = 0;
+    // Movement stops a roll that was cut short by another face taking over.
+    state->is_rolling = false;
     watch_display_string("PR", 0);
 }
 
@@ -130,7 +105,7 @@ bool probability_face_loop(movement_event_t event, movement_settings_t *settings
     (void) settings;
     probability_state_t *state = (probability_state_t *)context;
 
-    if (state->is_rolling && event.event_type != EVENT_TICK) {
+    if (state->is_rolling && event.event_type != EVENT_ANIMATION_DONE) {
         return true;
     }
 
@@ -138,8 +113,9 @@ bool probability_face_loop(movement_event_t event, movement_settings_t *settings
         case EVENT_ACTIVATE:
             display_dice_roll(state);
             break;
-        case EVENT_TICK:
-            display_dice_roll_animation(state);
+        case EVENT_ANIMATION_DONE:
+            state->is_rolling = false;
+            display_dice_roll(state);
             break;
         case EVENT_LIGHT_BUTTON_DOWN:
             // Change how many sides the die has
@@ -159,9 +135,8 @@ bool probability_face_loop(movement_event_t event, movement_settings_t *settings
         case EVENT_ALARM_BUTTON_UP:
             // Roll the die
             generate_random_number(state);
-            state->is_rolling = true;
-            // Dice rolling animation begins on next tick and new roll will be displayed on completion
-            movement_request_tick_frequency(PROBABILITY_ANIMATION_TICK_FREQUENCY);
+            // the new roll is displayed when the animation finishes
+            start_dice_roll_animation(state);
             break;
         case EVENT_LOW_ENERGY_UPDATE:
             watch_display_string("SLEEP ", 4);
@@ -42,7 +42,6 @@
 typedef struct {
     uint8_t dice_sides;
     uint8_t rolled_value;
-    uint8_t animation_frame;
     bool is_rolling;
 } probability_state_t;
 
@@ -57,6 +56,9 @@ void probability_face_resign(movement_settings_t *settings, void *context);
     probability_face_loop, \
     probability_face_resign, \
     NULL, \
+    sizeof(probability_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // PROBABILITY_FACE_H_
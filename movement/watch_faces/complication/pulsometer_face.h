@@ -82,6 +82,9 @@ void pulsometer_face_resign(movement_settings_t *settings, void *context);
     pulsometer_face_loop, \
     pulsometer_face_resign, \
     NULL, \
+    0, \
+    0, \
+    NULL, \
 })
 
 #endif // PULSOMETER_FACE_H_
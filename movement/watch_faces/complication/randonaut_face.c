@@ -22,13 +22,6 @@
  * SOFTWARE.
  */
 
-// Emulator only: need time() to seed the random number generator.
-#if __EMSCRIPTEN__
-#include <time.h>
-#else
-#include "saml22j18a.h"
-#endif
-
 #include <stdlib.h>
 #include <string.h>
 #include <math.h>
@@ -54,7 +47,7 @@ void randonaut_face_setup(movement_settings_t *settings, uint8_t watch_face_inde
     (void) settings;
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(randonaut_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(randonaut_state_t));
         memset(*context_ptr, 0, sizeof(randonaut_state_t));
         // Do any one-time tasks in here; the inside of this conditional happens only at boot.
     }
@@ -339,28 +332,13 @@ static void _generate_blindspot(randonaut_state_t *state) {
 /** @brief pseudo random number generator
  */
 static uint32_t _get_pseudo_entropy(uint32_t max) {
-    #if __EMSCRIPTEN__
-    return rand() % max;
-    #else
-    return arc4random_uniform(max);
-    #endif
+    return watch_random_uniform(max);
 }
 
 /** @brief true random number generator
  */
 static uint32_t _get_true_entropy(void) {
-    #if __EMSCRIPTEN__
-    return rand() % INT32_MAX;
-    #else
-    hri_mclk_set_APBCMASK_TRNG_bit(MCLK);
-    hri_trng_set_CTRLA_ENABLE_bit(TRNG);
-
-    while (!hri_trng_get_INTFLAG_reg(TRNG, TRNG_INTFLAG_DATARDY)); // Wait for TRNG data to be ready
-
-    watch_disable_TRNG();
-    hri_mclk_clear_APBCMASK_TRNG_bit(MCLK);
-    return hri_trng_read_DATA_reg(TRNG); // Read a single 32-bit word from TRNG and return it
-    #endif
+    return watch_random_true(); // a 32-bit word from the TRNG, by way of the entropy pool
 }
 
 /** @brief get location from place.loc
@@ -368,9 +346,8 @@ static uint32_t _get_true_entropy(void) {
 static void _get_location_from_file(randonaut_state_t *state) {
     movement_location_t movement_location = (movement_location_t) watch_get_backup_data(1);
     coordinate_t place;
-    if (filesystem_file_exists("place.loc")) {
-        if (filesystem_read_file("place.loc", (char*)&place, sizeof(place)))
-            state->location = place;
+    if (filesystem_read_file_if_size("place.loc", (char*)&place, sizeof(place))) {
+        state->location = place;
     } else {
         watch_set_indicator(WATCH_INDICATOR_BELL);
         state->location.latitude = movement_location.bit.latitude * 1000;
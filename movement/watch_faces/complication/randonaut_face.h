@@ -58,7 +58,7 @@
  * - The radius can be set in 500 meter steps between 1000 and 10,000 meters
  * 
  * - The RNG can be set to "true" which utilizes the SAML22J's internal True Random Number Generator
- * - Setting it to "psudo" will use the pseudorandom number generation algorithm arc4random
+ * - Setting it to "psudo" will use the watch library's ChaCha20 pseudorandom number generator
  * - Setting it to "chance" will randomly chose either of the RNGs for each generation (default)
  *
  * LONG PRESSING ALARM toggles DATA mode in which the currently generated Blind Spot coordinate can
@@ -107,6 +107,9 @@ void randonaut_face_resign(movement_settings_t *settings, void *context);
     randonaut_face_loop, \
     randonaut_face_resign, \
     NULL, \
+    sizeof(randonaut_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // RANDONAUT_FACE_H_
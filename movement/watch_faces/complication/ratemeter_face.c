@@ -33,7 +33,7 @@
 void ratemeter_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
     (void) settings;
     (void) watch_face_index;
-    if (*context_ptr == NULL) *context_ptr = malloc(sizeof(ratemeter_state_t));
+    if (*context_ptr == NULL) *context_ptr = movement_claim_face_context(watch_face_index, sizeof(ratemeter_state_t));
 }
 
 void ratemeter_face_activate(movement_settings_t *settings, void *context) {
@@ -53,6 +53,9 @@ void ratemeter_face_resign(movement_settings_t *settings, void *context);
     ratemeter_face_loop, \
     ratemeter_face_resign, \
     NULL, \
+    sizeof(ratemeter_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // RATEMETER_FACE_H_
@@ -24,9 +24,9 @@
 
 #include <stdlib.h>
 #include <string.h>
-#include <math.h>
 
 #include "rpn_calculator_alt_face.h"
+#include "calc_ops.h"
 
 static void show_fn(calculator_state_t *state, uint8_t subsecond);
 
@@ -35,38 +35,35 @@ void rpn_calculator_alt_face_setup(movement_settings_t *settings, uint8_t watch_
     (void) watch_face_index;
 
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(calculator_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(calculator_state_t));
         memset(*context_ptr, 0, sizeof(calculator_state_t));
         // Do any one-time tasks in here; the inside of this conditional happens only at boot.
     }
     // Do any pin or peripheral setup here; this will be called whenever the watch wakes from deep sleep.
 }
 
-static void show_number(double num) {
+static void show_number(calc_number_t num) {
     char buf[9] = {0};
-    bool negative = num < 0;
+    bool negative = calc_number_is_negative(num);
     int max_digits = negative ? 5 : 6;
 
-    // Add back in for debugging...
-    // printf("%f\n", num);
-
-    if (isnan(num)) {
+    if (calc_number_is_nan(num)) {
         watch_clear_colon();
         watch_display_string("  nan   ", 2);
         return;
     }
 
-    if (negative) {
-        num = -num;
-    }
+    num = calc_number_abs(num);
 
     // Can we reasonably represent this number without a decimal point?
-    if (num == 0 || (num >= 0.5 && fabs(num - (int)num) < 0.0001)) {
-        if (floor(log10(num)) + 1 <= max_digits) {
+    int32_t whole;
+    if (calc_number_to_int(num, 0, &whole) && (whole > 0 || calc_number_is_zero(num))) {
+        calc_number_t fraction = calc_number_abs(calc_number_subtract(num, calc_number_from_int(whole, 0)));
+        if (calc_number_compare(fraction, calc_number_from_int(1, -4)) < 0 && whole < (max_digits == 5 ? 100000 : 1000000)) {
             if (negative) {
-                sprintf(buf, "  -%-5d", (int)round(num));
+                sprintf(buf, "  -%-5d", (int)whole);
             } else {
-                sprintf(buf, "  %-6d", (int)round(num));
+                sprintf(buf, "  %-6d", (int)whole);
             }
             watch_clear_colon();
             watch_display_string(buf, 2);
@@ -76,10 +73,10 @@ static void show_number(double num) {
 
     // Is this a floating point number where scientific
     // notation won't get us much? (i.e. between 0.1 and 1)
-    if (num < 1 && num >= 0.0999) {
+    int32_t digits;
+    if (calc_number_to_int(num, 4, &digits) && digits >= 999 && digits < 10000) {
         // Display as boring floating point number... (e.g. 0.25)
-        int digits = (int)round(num * 10000);
-        sprintf(buf, "   0%04d", digits);
+        sprintf(buf, "   0%04d", (int)digits);
         if (negative) {
             buf[2 ] = '-';
         }
@@ -89,18 +86,8 @@ static void show_number(double num) {
     }
 
     // Fall back to scientific notation
-
-    // Calculate exponent
-    int exponent = 0;
-    while (num < 1) {
-        num *= 10;
-        --exponent;
-    }
-
-    while (num >= 10) {
-        num /= 10;
-        ++exponent;
-    }
+    int16_t exponent;
+    digits = calc_number_digits(num, 5, &exponent);
 
     if (exponent < -9) {
         sprintf(buf, "  small ");
@@ -109,26 +96,25 @@ static void show_number(double num) {
         return;
     }
 
-    if (exponent > 39) {
+    if (exponent > 39 || calc_number_is_infinite(num)) {
         sprintf(buf, "   big  ");
         watch_clear_colon();
         watch_display_string(buf, 2);
         return;
     }
 
-    sprintf(buf, "%2d%c%05d", exponent, negative ? '-' : ' ', (int)round(num * 10000));
+    sprintf(buf, "%2d%c%05d", exponent, negative ? '-' : ' ', (int)digits);
     watch_set_colon();
     watch_display_string(buf, 2);
 }
 
 #define C (s->stack[s->stack_size - 1])
 #define PUSH(x) (s->stack[++s->stack_size - 1] = x)
-#define POP() (s->stack[s->stack_size-- - 1])
 
 void rpn_calculator_alt_face_activate(movement_settings_t *settings, void *context) {
     (void) settings;
     calculator_state_t *s = (calculator_state_t *)context;
-    s->min = s->max = NAN;
+    s->min = s->max = CALC_NUMBER_NAN;
 }
 
 static void change_mode(calculator_state_t *s, enum calculator_mode mode) {
@@ -150,157 +136,69 @@ static void adjust_number(calculator_state_t *s, int direction) {
     // If the direction we want to go has no bound (i.e. isnan),
     // then first get the sign right (moving to 0, then +-10), and
     // after than go up by *10.
-    if (isnan(direction > 0 ? s->max : s->min)) {
-        if (direction * C < 0) {
-            C = 0;
-        } else if (C == 0) {
-            C = direction * 10;
+    if (calc_number_is_nan(direction > 0 ? s->max : s->min)) {
+        if (!calc_number_is_zero(C) && calc_number_is_negative(C) == (direction > 0)) {
+            C = CALC_NUMBER_ZERO;
+        } else if (calc_number_is_zero(C)) {
+            C = calc_number_from_int(direction * 10, 0);
         } else {
-            C *= 10;
+            C = calc_number_multiply(C, calc_number_from_int(10, 0));
         }
     } else {
         // We have a higher and lower bound. Split them.
-        C = (s->max + s->min) / 2;
-        // Subtract 0.1 so we don't apply most significant rounding to things that are _exactly_ 1/10/100 apart.
-        double mag = log10(fabs(s->max - s->min)) - 0.1;
-        if (mag > 0.0) {
+        C = calc_number_divide(calc_number_add(s->max, s->min), calc_number_from_int(2, 0));
+        // Round to the power of ten below the gap between them, less a tenth of a decade (10^0.1 is 1.25892541) so we
+        // don't apply most significant rounding to things that are _exactly_ 1/10/100 apart.
+        int16_t magnitude;
+        uint32_t gap = calc_number_digits(calc_number_abs(calc_number_subtract(s->max, s->min)), 9, &magnitude);
+        if (gap < 125892541) {
+            magnitude--;
+        }
+        if (gap && magnitude >= 0) {
             // i.e. the different is >= 2, which means we want to round aggressively
             // to not show people complicated looking numbers.
             // e.g. this takes a number like 3.2 to 3, or a number like 464 to 500
-            // (depending on how fine-grained 'mag' tells us to be).
-            float div = pow(10, floor(mag));
-            int sign = C < 0 ? -1 : 1;
-            C = sign * floor(fabs(C) / div) * div;
+            // (depending on how fine-grained 'magnitude' tells us to be).
+            calc_number_t div = calc_number_from_int(1, magnitude);
+            calc_number_t rounded = calc_number_multiply(calc_number_floor(calc_number_divide(calc_number_abs(C), div)), div);
+            C = calc_number_is_negative(C) ? calc_number_negate(rounded) : rounded;
         }
     }
 }
 
 static void fn_number(calculator_state_t *s) {
-    PUSH(10);
-    s->min = s->max = NAN;
+    PUSH(calc_number_from_int(10, 0));
+    s->min = s->max = CALC_NUMBER_NAN;
     change_mode(s, CALC_NUMBER);
 }
 
-static void fn_add(calculator_state_t *s) {
-    double a = POP();
-    double b = POP();
-    PUSH(a + b);
-}
-
-static void fn_sub(calculator_state_t *s) {
-    double a = POP();
-    double b = POP();
-    PUSH(b - a);
-}
-
-static void fn_mul(calculator_state_t *s) {
-    double a = POP();
-    double b = POP();
-    PUSH(a * b);
-}
-
-static void fn_div(calculator_state_t *s) {
-    double a = POP();
-    double b = POP();
-    PUSH(b / a);
-}
-
-static void fn_pow(calculator_state_t *s) {
-    double a = POP();
-    double b = POP();
-    PUSH(pow(b, a));
-}
-
-static void fn_sqrt(calculator_state_t *s) {
-    double x = POP();
-    PUSH(sqrt(x));
-}
-
-static void fn_log(calculator_state_t *s) {
-    double x = POP();
-    PUSH(log(x));
-}
-
-static void fn_log10(calculator_state_t *s) {
-    double x = POP();
-    PUSH(log10(x));
-}
-
-static void fn_e(calculator_state_t *s) {
-    PUSH(M_E);
-}
-
-static void fn_sin(calculator_state_t *s) {
-    double x = POP();
-    PUSH(sin(x));
-}
-
-static void fn_cos(calculator_state_t *s) {
-    double x = POP();
-    PUSH(cos(x));
-}
-
-static void fn_tan(calculator_state_t *s) {
-    double x = POP();
-    PUSH(tan(x));
-}
-
-static void fn_pi(calculator_state_t *s) {
-    PUSH(M_PI);
-}
-
-static void fn_pop(calculator_state_t *s) {
-    --s->stack_size;
-}
-
-static void fn_swap(calculator_state_t *s) {
-    double a = POP();
-    double b = POP();
-    PUSH(a);
-    PUSH(b);
-}
-
-static void fn_duplicate(calculator_state_t *s) {
-    double a = POP();
-    PUSH(a);
-    PUSH(a);
-}
-
-static void fn_clear(calculator_state_t *s) {
-    s->stack_size = 0;
-}
-
-static void fn_size(calculator_state_t *s) {
-    double a = s->stack_size;
-    PUSH(a);
-}
+// Number entry, which isn't one of the calculator operations.
+#define FN_NUMBER CALC_OP_COUNT
 
 struct {
     char name[2];
-    uint8_t input;
-    uint8_t output;
-    void (*func)(calculator_state_t *);
+    uint8_t op;  // a calc_op_t, or FN_NUMBER
 } functions[] = {
-    {{'n', 'o'}, 0, 1, fn_number},
-    {{'*', ' '}, 2, 1, fn_add},  // First position * actually looks like a '+'.
-    {{'-', ' '}, 2, 1, fn_sub},
-    {{'H', ' '}, 2, 1, fn_mul},  // For actual *, we throw in the middle vertical segment onto the H.
-    {{'/', ' '}, 2, 1, fn_div},  // There's also some minor hackery on '/'.
-    {{'P', 'o'}, 2, 1, fn_pow},
-    {{'S', 'r'}, 1, 1, fn_sqrt},
-    {{'L', 'n'}, 1, 1, fn_log},
-    {{'L', 'o'}, 1, 1, fn_log10},
-    {{'e', ' '}, 0, 1, fn_e},
-    {{'P', 'i'}, 0, 1, fn_pi},
-    {{'C', 'o'}, 1, 1, fn_cos},
-    {{'S', 'i'}, 1, 1, fn_sin},
-    {{'T', 'a'}, 1, 1, fn_tan},
+    {{'n', 'o'}, FN_NUMBER},
+    {{'*', ' '}, CALC_OP_ADD},  // First position * actually looks like a '+'.
+    {{'-', ' '}, CALC_OP_SUBTRACT},
+    {{'H', ' '}, CALC_OP_MULTIPLY},  // For actual *, we throw in the middle vertical segment onto the H.
+    {{'/', ' '}, CALC_OP_DIVIDE},  // There's also some minor hackery on '/'.
+    {{'P', 'o'}, CALC_OP_POW},
+    {{'S', 'r'}, CALC_OP_SQRT},
+    {{'L', 'n'}, CALC_OP_LN},
+    {{'L', 'o'}, CALC_OP_LOG10},
+    {{'e', ' '}, CALC_OP_E},
+    {{'P', 'i'}, CALC_OP_PI},
+    {{'C', 'o'}, CALC_OP_COS},
+    {{'S', 'i'}, CALC_OP_SIN},
+    {{'T', 'a'}, CALC_OP_TAN},
     // Stack operations. Accessible via secondary_fn_index (i.e. alarm long press).
-    {{'P', 'O'}, 1, 0, fn_pop},  // This ends up displaying the same as 'POW'. But at least it's in a different place.
-    {{'S', 'W'}, 2, 2, fn_swap},
-    {{'d', 'u'}, 1, 1, fn_duplicate},  // Uppercase 'D' is a bit too 'O' for me.
-    {{'C', 'L'}, 1, 0, fn_clear},  // Operation lie - takes _everything_ off the stack, but a check of 1 is sufficient.
-    {{'L', 'E'}, 1, 0, fn_size},
+    {{'P', 'O'}, CALC_OP_DROP},  // This ends up displaying the same as 'POW'. But at least it's in a different place.
+    {{'S', 'W'}, CALC_OP_SWAP},
+    {{'d', 'u'}, CALC_OP_DUPLICATE},  // Uppercase 'D' is a bit too 'O' for me.
+    {{'C', 'L'}, CALC_OP_CLEAR},
+    {{'L', 'E'}, CALC_OP_SIZE},
 };
 
 #define FUNCTIONS_LEN (sizeof(functions) / sizeof(functions[0]))
@@ -348,8 +246,6 @@ bool rpn_calculator_alt_face_loop(movement_event_t event, movement_settings_t *s
     calculator_state_t *s = (calculator_state_t *)context;
     (void) settings;
 
-    int proposed_stack_size;
-
     switch (event.event_type) {
         case EVENT_ACTIVATE:
             change_mode(s, CALC_OPERATION);
@@ -370,15 +266,16 @@ bool rpn_calculator_alt_face_loop(movement_event_t event, movement_settings_t *s
             }
             break;
         case EVENT_LIGHT_BUTTON_DOWN:
-            proposed_stack_size = s->stack_size - functions[s->fn_index].input;
-
             if (s->mode == CALC_NUMBER) {
                 change_mode(s, CALC_OPERATION);
-            } else if (proposed_stack_size < 0 || proposed_stack_size + functions[s->fn_index].output > CALC_MAX_STACK_SIZE) {
+            } else if (functions[s->fn_index].op == FN_NUMBER ? s->stack_size >= CALC_MAX_STACK_SIZE
+                       : calc_op_run(functions[s->fn_index].op, s->stack, &s->stack_size, CALC_MAX_STACK_SIZE) != 0) {
                 movement_play_signal();
                 break;
             } else {
-                functions[s->fn_index].func(s);
+                if (functions[s->fn_index].op == FN_NUMBER) {
+                    fn_number(s);
+                }
                 show_stack_top(s);
                 s->fn_index = 0;
                 show_fn(s, 0);
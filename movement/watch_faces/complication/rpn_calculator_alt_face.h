@@ -60,6 +60,7 @@
  */
 
 #include "movement.h"
+#include "calc_number.h"
 
 #define CALC_MAX_STACK_SIZE 20
 
@@ -69,12 +70,12 @@ enum calculator_mode {
 };
 
 typedef struct {
-    double stack[CALC_MAX_STACK_SIZE];
+    calc_number_t stack[CALC_MAX_STACK_SIZE];
     uint8_t stack_size;  // this is the current stack top + 1 (so that '0' means nothing on the stack)
     uint8_t fn_index;
 
-    double min;
-    double max;
+    calc_number_t min;
+    calc_number_t max;
 
     enum calculator_mode mode;
 } calculator_state_t;
@@ -90,6 +91,9 @@ void rpn_calculator_alt_face_resign(movement_settings_t *settings, void *context
     rpn_calculator_alt_face_loop, \
     rpn_calculator_alt_face_resign, \
     NULL, \
+    sizeof(calculator_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // CALCULATOR_FACE_H_
@@ -24,12 +24,19 @@
 
 #include <stdlib.h>
 #include <string.h>
-#include <math.h>
 #include "rpn_calculator_face.h"
 
-static void draw_number(char *buf, float num) {
-    float f = fmodf(num, 1.0) * 100;
-    sprintf(buf, "CA  %4d%02d", ((int)num) % 10000, (int) f);
+static void draw_number(char *buf, calc_number_t num) {
+    // four digits before the point and two after; the point itself can't be shown.
+    int32_t hundredths;
+    if (!calc_number_to_int(num, 2, &hundredths)) {
+        sprintf(buf, "CA   err  ");
+        return;
+    }
+    char whole[6];
+    if (hundredths < 0) sprintf(whole, "-%d", (int)((-hundredths / 100) % 1000));
+    else sprintf(whole, "%d", (int)((hundredths / 100) % 10000));
+    sprintf(buf, "CA  %4s%02d", whole, (int)abs(hundredths % 100));
 }
 
 static void draw_op(char *buf, rpn_calculator_op_t op) {
@@ -60,80 +67,65 @@ static void draw_op(char *buf, rpn_calculator_op_t op) {
     }
 }
 
-static void printf_stack(rpn_calculator_state_t *state) {
-    printf("Stack: [%f, %f, %f, %f], top: %d\n",
-        state->stack[0],
-        state->stack[1],
-        state->stack[2],
-        state->stack[3],
-        state->top
-    );
-}
-
 static void next_op(rpn_calculator_state_t *state) {
     state->op += 1;
     state->op = state->op % RPN_CALCULATOR_MAX_OPS;
 }
 
-// increase a digit of a floating point number
-// FIXME: this converts the number to string and back, there might
-// be better ways to do this
-static float inc_digit(float num, uint8_t position) {
-    char buf[8];
-    if (position > 5) {
-        return 0.0;
+// increase a digit of a number, counting from the hundredths
+static calc_number_t inc_digit(calc_number_t num, uint8_t position) {
+    static const int32_t place_values[] = {1, 10, 100, 1000, 10000, 100000};
+    int32_t hundredths;
+    if (position > 5 || !calc_number_to_int(num, 2, &hundredths)) {
+        return CALC_NUMBER_ZERO;
+    }
+    bool negative = hundredths < 0;
+    hundredths = abs(hundredths) % 1000000;
+    int32_t place_value = place_values[position];
+    if ((hundredths / place_value) % 10 == 9) {
+        hundredths -= 9 * place_value;
+    } else {
+        hundredths += place_value;
     }
-    // inverse position (rtl)
-    position = 5 - position;
-    float f = fmodf(num, 1.0) * 100;
-    sprintf(buf, "%04d%02d", ((int)num) % 10000, (int) f);
-    uint8_t digit = buf[position] - '0';
-    digit = (digit + 1) % 10;
-    buf[position] = digit + '0';
-    printf("buf: %s\n", buf);
-    return strtof(buf, NULL) / 100.0;
+    return calc_number_from_int(negative ? -hundredths : hundredths, -2);
 }
 
-static void stack_push(rpn_calculator_state_t *state, float f) {
-    printf_stack(state);
-    printf("push: %f\n", f);
+static void stack_push(rpn_calculator_state_t *state, calc_number_t num) {
     state->top++;
     if (state->top >= RPN_CALCULATOR_STACK_SIZE) {
         // FIXME: implement this using a circular buffer?
         for (int i=0; i<RPN_CALCULATOR_STACK_SIZE-1; i++) {
             state->stack[i] = state->stack[i+1];
         }
+        state->top = RPN_CALCULATOR_STACK_SIZE - 1;
     }
-    state->stack[state->top] = f;
+    state->stack[state->top] = num;
 }
 
-static float stack_peek(rpn_calculator_state_t *state) {
+static calc_number_t stack_peek(rpn_calculator_state_t *state) {
     if (state->top > -1) {
         return state->stack[state->top];
     }
-    return 0;
+    return CALC_NUMBER_ZERO;
 }
 
-static float stack_pop(rpn_calculator_state_t *state) {
-    printf_stack(state);
-    float f = stack_peek(state);
-    state->stack[state->top] = 0;
-    printf("pop: %f\n", f);
+static calc_number_t stack_pop(rpn_calculator_state_t *state) {
+    calc_number_t num = stack_peek(state);
     if (state->top > -1) {
+        state->stack[state->top] = CALC_NUMBER_ZERO;
         state->top--;
     } else {
         state->top = -1; // empty
     }
-    return f;
+    return num;
 }
 
 static void run_op(rpn_calculator_state_t *state) {
-    printf_stack(state);
     bool op_found = false;
     // ops without parameters
     switch (state->op)  {
         case rpn_calculator_op_pi:
-            stack_push(state, M_PI);
+            stack_push(state, CALC_NUMBER_PI);
             op_found = true;
             break;
         default:
@@ -149,11 +141,10 @@ static void run_op(rpn_calculator_state_t *state) {
         state->mode = rpn_calculator_err;
         return;
     }
-    float right = stack_pop(state);
-    printf("right: %f\n", right);
+    calc_number_t right = stack_pop(state);
     switch (state->op)  {
         case rpn_calculator_op_sqrt:
-            stack_push(state, sqrt(right));
+            stack_push(state, calc_number_sqrt(right));
             op_found = true;
             break;
         default:
@@ -170,27 +161,26 @@ static void run_op(rpn_calculator_state_t *state) {
         state->mode = rpn_calculator_err;
         return;
     }
-    float left = stack_pop(state);
-    printf("left: %f\n", left);
+    calc_number_t left = stack_pop(state);
     switch (state->op)  {
         case rpn_calculator_op_add:
-            stack_push(state, left + right);
+            stack_push(state, calc_number_add(left, right));
             op_found = true;
             break;
         case rpn_calculator_op_sub:
-            stack_push(state, left - right);
+            stack_push(state, calc_number_subtract(left, right));
             op_found = true;
             break;
         case rpn_calculator_op_mul:
-            stack_push(state, left * right);
+            stack_push(state, calc_number_multiply(left, right));
             op_found = true;
             break;
         case rpn_calculator_op_div:
-            stack_push(state, left / right);
+            stack_push(state, calc_number_divide(left, right));
             op_found = true;
             break;
         case rpn_calculator_op_pow:
-            stack_push(state, powf(left, right));
+            stack_push(state, calc_number_pow(left, right));
             op_found = true;
             break;
         default:
@@ -220,7 +210,6 @@ static void draw(rpn_calculator_state_t *state, uint8_t subsecond) {
             }
             break;
         case rpn_calculator_waiting:
-            printf_stack(state);
             draw_number(buf, stack_peek(state));
             break;
         case rpn_calculator_op:
@@ -236,7 +225,7 @@ void rpn_calculator_face_setup(movement_settings_t *settings, uint8_t watch_face
     (void) settings;
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(rpn_calculator_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(rpn_calculator_state_t));
         memset(*context_ptr, 0, sizeof(rpn_calculator_state_t));
         // Do any one-time tasks in here; the inside of this conditional happens only at boot.
         rpn_calculator_state_t *state = *context_ptr;
@@ -304,13 +293,12 @@ bool rpn_calculator_face_loop(movement_event_t event, movement_settings_t *setti
                 case rpn_calculator_waiting:
                     state->mode = rpn_calculator_number;
                     state->selection = 2;
-                    stack_push(state, 0);
+                    stack_push(state, CALC_NUMBER_ZERO);
                     draw(state, event.subsecond);
                     movement_request_tick_frequency(4);
                     break;
                 case rpn_calculator_number:
                     state->stack[state->top] = inc_digit(state->stack[state->top], state->selection);
-                    printf_stack(state);
                     draw(state, event.subsecond);
                     break;
                 case rpn_calculator_err:
@@ -35,6 +35,7 @@
  */
 
 #include "movement.h"
+#include "calc_number.h"
 
 #define RPN_CALCULATOR_STACK_SIZE 4
 #define RPN_CALCULATOR_MAX_OPS 7;
@@ -59,7 +60,7 @@ typedef enum {
 typedef struct {
     rpn_calculator_mode_t mode;
     rpn_calculator_op_t op;
-    float stack[RPN_CALCULATOR_STACK_SIZE];
+    calc_number_t stack[RPN_CALCULATOR_STACK_SIZE];
     int8_t top;
     uint8_t selection;
 } rpn_calculator_state_t;
@@ -75,6 +76,9 @@ void rpn_calculator_face_resign(movement_settings_t *settings, void *context);
     rpn_calculator_face_loop, \
     rpn_calculator_face_resign, \
     NULL, \
+    sizeof(rpn_calculator_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // RPN_CALCULATOR_FACE_H_
@@ -34,7 +34,8 @@
 #define DEFAULT_MINUTES { 5,4,1,0,0,0 }
 
 static inline int32_t get_tz_offset(movement_settings_t *settings) {
-    return movement_timezone_offsets[settings->bit.time_zone] * 60;
+    (void) settings;
+    return movement_get_current_timezone_offset() * 60;
 }
 
 static int lap = 0;
@@ -239,7 +240,7 @@ void sailing_face_setup(movement_settings_t *settings, uint8_t watch_face_index,
     (void) watch_face_index;
 
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(sailing_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(sailing_state_t));
         sailing_state_t *state = (sailing_state_t *)*context_ptr;
         memset(*context_ptr, 0, sizeof(sailing_state_t));
         static const uint8_t default_minutes[6] = DEFAULT_MINUTES;
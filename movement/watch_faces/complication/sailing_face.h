@@ -92,6 +92,9 @@ void sailing_face_resign(movement_settings_t *settings, void *context);
     sailing_face_loop, \
     sailing_face_resign, \
     NULL, \
+    sizeof(sailing_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // sailing_FACE_H_
@@ -33,16 +33,32 @@ static void ships_bell_ring() {
     date_time.unit.hour %= 4;
     date_time.unit.hour = date_time.unit.hour == 0 && date_time.unit.minute < 30 ? 4 : date_time.unit.hour;
 
-    for (uint8_t i = 0; i < date_time.unit.hour; i++) {
-        watch_buzzer_play_note(BUZZER_NOTE_C8, 75);
-        watch_buzzer_play_note(BUZZER_NOTE_REST, 75);
-        watch_buzzer_play_note(BUZZER_NOTE_C8, 100);
-        watch_buzzer_play_note(BUZZER_NOTE_REST, 250);
+    // one pair of strikes per hour of the watch, plus a single strike on the half hour. durations are in 64 Hz
+    // sequencer ticks (@see watch_buzzer_play_sequence); the tune has to outlive this function, hence static.
+    static int8_t tune[13];
+    uint8_t i = 0;
+    // half an hour into a watch, there's only the single strike.
+    if (date_time.unit.hour > 0) {
+        tune[i++] = BUZZER_NOTE_C8;
+        tune[i++] = 4;
+        tune[i++] = BUZZER_NOTE_REST;
+        tune[i++] = 4;
+        tune[i++] = BUZZER_NOTE_C8;
+        tune[i++] = 5;
+        tune[i++] = BUZZER_NOTE_REST;
+        tune[i++] = 15;
+        if (date_time.unit.hour > 1) {
+            tune[i++] = -4;
+            tune[i++] = date_time.unit.hour - 1;
+        }
     }
-
-    if (date_time.unit.minute >= 30 ? 1 : 0) {
-        watch_buzzer_play_note(BUZZER_NOTE_C8, 100);
+    if (date_time.unit.minute >= 30) {
+        tune[i++] = BUZZER_NOTE_C8;
+        tune[i++] = 5;
     }
+    tune[i] = 0;
+
+    movement_play_tune(tune);
 }
 
 static void ships_bell_draw(ships_bell_state_t *state) {
@@ -66,7 +82,7 @@ void ships_bell_face_setup(movement_settings_t *settings, uint8_t watch_face_ind
     (void) watch_face_index;
 
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(ships_bell_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(ships_bell_state_t));
         memset(*context_ptr, 0, sizeof(ships_bell_state_t));
     }
 }
@@ -107,13 +123,7 @@ bool ships_bell_face_loop(movement_event_t event, movement_settings_t *settings,
         case EVENT_LOW_ENERGY_UPDATE:
             break;
         case EVENT_BACKGROUND_TASK:
-            if (watch_is_buzzer_or_led_enabled()) {
-                ships_bell_ring();
-            } else {
-                watch_enable_buzzer();
-                ships_bell_ring();
-                watch_disable_buzzer();
-            }
+            ships_bell_ring();
             break;
         default:
             movement_default_loop_handler(event, settings);
@@ -134,7 +144,7 @@ bool ships_bell_face_wants_background_task(movement_settings_t *settings, void *
     ships_bell_state_t *state = (ships_bell_state_t *) context;
     if (!state->bell_enabled) return false;
 
-    watch_date_time date_time = watch_rtc_get_date_time();
+    watch_date_time date_time = movement_get_local_date_time();
     if (!(date_time.unit.minute == 0 || date_time.unit.minute == 30)) return false;
 
     date_time.unit.hour %= 12;
@@ -63,6 +63,9 @@ bool ships_bell_face_wants_background_task(movement_settings_t *settings, void *
     ships_bell_face_loop, \
     ships_bell_face_resign, \
     ships_bell_face_wants_background_task, \
+    sizeof(ships_bell_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // SHIPS_BELL_FACE_H_
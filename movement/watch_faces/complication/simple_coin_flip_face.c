@@ -22,12 +22,6 @@
  * SOFTWARE.
  */
 
-#if __EMSCRIPTEN__
-#include <time.h>
-#else
-#include "saml22j18a.h"
-#endif
-
 #include <stdlib.h>
 #include <string.h>
 #include "simple_coin_flip_face.h"
@@ -38,7 +32,7 @@ void simple_coin_flip_face_setup(movement_settings_t *settings, uint8_t watch_fa
     (void) settings;
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(simple_coin_flip_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(simple_coin_flip_state_t));
         memset(*context_ptr, 0, sizeof(simple_coin_flip_state_t));
     }
 }
@@ -49,11 +43,7 @@ void simple_coin_flip_face_activate(movement_settings_t *settings, void *context
 }
 
 static uint32_t get_random(uint32_t max) {
-    #if __EMSCRIPTEN__
-    return rand() % max;
-    #else
-    return arc4random_uniform(max);
-    #endif
+    return watch_random_uniform(max);
 }
 
 static void animation_0() {
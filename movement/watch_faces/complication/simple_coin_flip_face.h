@@ -56,6 +56,9 @@ void simple_coin_flip_face_resign(movement_settings_t *settings, void *context);
     simple_coin_flip_face_loop, \
     simple_coin_flip_face_resign, \
     NULL, \
+    sizeof(simple_coin_flip_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // SIMPLE_COIN_FLIP_FACE_H_
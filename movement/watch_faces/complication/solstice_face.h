@@ -58,6 +58,9 @@ void solstice_face_resign(movement_settings_t *settings, void *context);
     solstice_face_loop, \
     solstice_face_resign, \
     NULL, \
+    sizeof(solstice_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // SOLSTICE_FACE_H_
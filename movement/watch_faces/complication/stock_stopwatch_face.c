@@ -39,15 +39,6 @@
        turns on on each button press or it doesn't.
 */
 
-#if __EMSCRIPTEN__
-#include <emscripten.h>
-#include <emscripten/html5.h>
-#else
-#include "../../../watch-library/hardware/include/saml22j18a.h"
-#include "../../../watch-library/hardware/include/component/tc.h"
-#include "../../../watch-library/hardware/hri/hri_tc_l22.h"
-#endif
-
 // distant future for background task: January 1, 2083
 static const watch_date_time distant_future = {
     .unit = {0, 0, 0, 1, 1, 63}
@@ -62,67 +53,26 @@ static uint8_t _hours;
 static bool _colon;
 static bool _is_running;
 
-#if __EMSCRIPTEN__
-
-static long _em_interval_id = 0;
-
-void em_cb_handler(void *userData) {
-    // interrupt handler for emscripten 128 Hz callbacks
-    (void) userData;
-    _ticks++;
-}
-
-static void _cb_initialize() { }
-
-static inline void _cb_stop() {
-    emscripten_clear_interval(_em_interval_id);
-    _em_interval_id = 0;
-    _is_running = false;
-}
+// the monotonic count at which _ticks was zero; the count runs at 512 Hz, four counts to each of our 128 Hz ticks.
+static uint32_t _started_at;
 
-static inline void _cb_start() {
-    // initiate 128 hz callback
-    _em_interval_id = emscripten_set_interval(em_cb_handler, (double)(1000/128), (void *)NULL);
+static inline void _update_ticks() {
+    if (_is_running) _ticks = (watch_get_monotonic_ticks() - _started_at) >> 2;
 }
 
-#else
-
 static inline void _cb_start() {
-    // start the TC2 timer
-    hri_tc_set_CTRLA_ENABLE_bit(TC2);
+    // pick up the count where it stopped
+    watch_monotonic_start();
+    _started_at = watch_get_monotonic_ticks() - (_ticks << 2);
     _is_running = true;
 }
 
 static inline void _cb_stop() {
-    // stop the TC2 timer
-    hri_tc_clear_CTRLA_ENABLE_bit(TC2);
+    _update_ticks();
+    watch_monotonic_stop();
     _is_running = false;
 }
 
-static void _cb_initialize() {
-    // setup and initialize TC2 for a 64 Hz interrupt
-    hri_mclk_set_APBCMASK_TC2_bit(MCLK);
-    hri_gclk_write_PCHCTRL_reg(GCLK, TC2_GCLK_ID, GCLK_PCHCTRL_GEN_GCLK3 | GCLK_PCHCTRL_CHEN);
-    _cb_stop();
-    hri_tc_write_CTRLA_reg(TC2, TC_CTRLA_SWRST);
-    hri_tc_wait_for_sync(TC2, TC_SYNCBUSY_SWRST);
-    hri_tc_write_CTRLA_reg(TC2, TC_CTRLA_PRESCALER_DIV64 | // 32 Khz divided by 64 divided by 4 results in a 128 Hz interrupt
-                           TC_CTRLA_MODE_COUNT8 | 
-                           TC_CTRLA_RUNSTDBY);
-    hri_tccount8_write_PER_reg(TC2, 3);
-    hri_tc_set_INTEN_OVF_bit(TC2);
-    NVIC_ClearPendingIRQ(TC2_IRQn);
-    NVIC_EnableIRQ (TC2_IRQn);
-}
-
-void TC2_Handler(void) {
-    // interrupt handler for TC2 (globally!)
-    _ticks++;
-    TC2->COUNT8.INTFLAG.reg |= TC_INTFLAG_OVF;
-}
-
-#endif
-
 static inline void _button_beep(movement_settings_t *settings) {
     // play a beep as confirmation for a button press (if applicable)
     if (settings->bit.button_should_sound) watch_buzzer_play_note(BUZZER_NOTE_C7, 50);
@@ -159,22 +109,25 @@ static void _draw() {
                     // minutes have changed, draw everything
                     _old_minutes = minutes;
                     minutes %= 60;
+                    char *p = buf;
                     if (_hours)
                         // with hour indicator
-                        sprintf(buf, "%2u%02u%02lu%02u", _hours, minutes, seconds, sec_100);
+                        p = watch_fmt_2d(p, _hours, ' ');
                     else
                         // no hour indicator
-                        sprintf(buf, "  %02u%02lu%02u", minutes, seconds, sec_100);
+                        p = watch_fmt_str(p, "  ");
+                    p = watch_fmt_2d(p, minutes, '0');
+                    p = watch_fmt_2d(p, seconds, '0');
+                    watch_fmt_2d(p, sec_100, '0');
                     watch_display_string(buf, 2);
                 } else {
                     // just draw seconds
-                    sprintf(buf, "%02lu%02u", seconds, sec_100);
+                    watch_fmt_2d(watch_fmt_2d(buf, seconds, '0'), sec_100, '0');
                     watch_display_string(buf, 6);
                 }
             } else {
                 // only draw 100ths of seconds
-                sprintf(buf, "%02u", sec_100);
-                watch_display_string(buf, 8);
+                watch_display_2d(sec_100, 8, '0');
             }
         } else {
             _display_ticks(_ticks);
@@ -206,17 +159,13 @@ void stock_stopwatch_face_setup(movement_settings_t *settings, uint8_t watch_fac
     (void) settings;
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(stock_stopwatch_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(stock_stopwatch_state_t));
         memset(*context_ptr, 0, sizeof(stock_stopwatch_state_t));
         stock_stopwatch_state_t *state = (stock_stopwatch_state_t *)*context_ptr;
         _ticks = _lap_ticks = _blink_ticks = _old_minutes = _old_seconds = _hours = 0;
     _is_running = _colon = false;
         state->light_on_button = true;
     }
-    if (!_is_running) {
-        // prepare the 128 Hz callback source
-        _cb_initialize();
-    }
 }
 
 void stock_stopwatch_face_activate(movement_settings_t *settings, void *context) {
@@ -231,9 +180,13 @@ void stock_stopwatch_face_activate(movement_settings_t *settings, void *context)
 bool stock_stopwatch_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
     stock_stopwatch_state_t *state = (stock_stopwatch_state_t *)context;
 
+    // time has passed since we last looked
+    _update_ticks();
+
     // handle overflow of fast ticks
     while (_ticks >= (128 * 60 * 60)) {
         _ticks -= (128 * 60 * 60);
+        _started_at += (128 * 60 * 60) << 2;
         _hours++;
         if (_hours >= 24) _hours -= 24;
         // initiate a re-draw
@@ -262,7 +215,7 @@ bool stock_stopwatch_face_loop(movement_event_t event, movement_settings_t *sett
             if (_is_running) {
                 // start or continue stopwatch
                 movement_request_tick_frequency(16);
-                // register 128 hz callback for time measuring
+                // start counting time
                 _cb_start();
                 // schedule the keepalive task when running
                 movement_schedule_background_task(distant_future);
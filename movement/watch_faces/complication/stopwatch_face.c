@@ -39,7 +39,7 @@ void stopwatch_face_setup(movement_settings_t *settings, uint8_t watch_face_inde
     (void) settings;
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(stopwatch_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(stopwatch_state_t));
         memset(*context_ptr, 0, sizeof(stopwatch_state_t));
     }
 }
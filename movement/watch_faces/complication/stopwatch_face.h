@@ -56,6 +56,9 @@ void stopwatch_face_resign(movement_settings_t *settings, void *context);
     stopwatch_face_loop, \
     stopwatch_face_resign, \
     NULL, \
+    sizeof(stopwatch_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // STOPWATCH_FACE_H_
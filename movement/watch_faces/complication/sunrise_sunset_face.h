@@ -68,6 +68,9 @@ void sunrise_sunset_face_resign(movement_settings_t *settings, void *context);
     sunrise_sunset_face_loop, \
     sunrise_sunset_face_resign, \
     NULL, \
+    sizeof(sunrise_sunset_state_t), \
+    MOVEMENT_FACE_HIBERNATE, \
+    NULL, \
 })
 
 #endif // SUNRISE_SUNSET_FACE_H_
@@ -103,6 +103,9 @@ void tachymeter_face_resign(movement_settings_t *settings, void *context);
     tachymeter_face_loop, \
     tachymeter_face_resign, \
     NULL, \
+    sizeof(tachymeter_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // TACHYMETER_FACE_H_
@@ -26,13 +26,25 @@
 #include <string.h>
 #include "tally_face.h"
 #include "watch.h"
+#include "movement_kv.h"
+
+#define TALLY_FACE_KV_KEY "tally"
+
+// saved on every press; Movement keeps the writes in RAM until the session's over.
+static void _tally_face_save(tally_state_t *state) {
+    movement_kv_set(TALLY_FACE_KV_KEY, &state->tally_idx, sizeof(state->tally_idx));
+}
 
 void tally_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
     (void) settings;
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(tally_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(tally_state_t));
         memset(*context_ptr, 0, sizeof(tally_state_t));
+        tally_state_t *state = (tally_state_t *)*context_ptr;
+        if (movement_kv_get(TALLY_FACE_KV_KEY, &state->tally_idx, sizeof(state->tally_idx)) != sizeof(state->tally_idx)) {
+            state->tally_idx = 0;
+        }
     }
 }
 
@@ -56,6 +68,7 @@ bool tally_face_loop(movement_event_t event, movement_settings_t *settings, void
                 watch_buzzer_play_note(BUZZER_NOTE_REST, 30);
             }
             print_tally(state);
+            _tally_face_save(state);
             watch_buzzer_play_note(BUZZER_NOTE_E6, 30);
             break;
         case EVENT_ALARM_LONG_PRESS:
@@ -65,6 +78,7 @@ bool tally_face_loop(movement_event_t event, movement_settings_t *settings, void
             watch_buzzer_play_note(BUZZER_NOTE_REST, 30);
             watch_buzzer_play_note(BUZZER_NOTE_E6, 30);
             print_tally(state);
+            _tally_face_save(state);
             break;
         case EVENT_ACTIVATE:
             print_tally(state);
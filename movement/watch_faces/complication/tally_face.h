@@ -33,6 +33,7 @@
  *
  * To advance the counter, press the ALARM button.
  * To reset, long press the ALARM button.
+ * The tally is kept on flash, so it survives a reset or a battery change.
  */
 
 #include "movement.h"
@@ -55,6 +56,9 @@ void print_tally(tally_state_t *state);
     tally_face_loop, \
     tally_face_resign, \
     NULL, \
+    sizeof(tally_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // TALLY_FACE_H_
@@ -23,11 +23,6 @@
  * SOFTWARE.
  */
 
-// Emulator only: need time() to seed the random number generator.
-#if __EMSCRIPTEN__
-#include <time.h>
-#endif
-
 #include <stdlib.h>
 #include <string.h>
 #include "tarot_face.h"
@@ -41,7 +36,7 @@
 // Custom methods
 // --------------
 
-static char major_arcana[][7] = {
+static const char major_arcana[][7] = {
     " FOOL ",
     "Mgcian",
     "HPrsts",
@@ -67,7 +62,7 @@ static char major_arcana[][7] = {
 };
 #define NUM_MAJOR_ARCANA (sizeof(major_arcana) / sizeof(*major_arcana))
 
-static char suits[][7] = {
+static const char suits[][7] = {
     " wands",
     "  cups",
     "swords",
@@ -139,12 +134,7 @@ static void tarot_display(tarot_state_t *state) {
 }
 
 static uint8_t get_rand_num(uint8_t num_values) {
-    // Emulator: use rand. Hardware: use arc4random.
-#if __EMSCRIPTEN__
-    return rand() % num_values;
-#else
-    return arc4random_uniform(num_values);
-#endif
+    return watch_random_uniform(num_values);
 }
 
 static uint8_t draw_one_card(tarot_state_t *state) {
@@ -212,13 +202,9 @@ void tarot_face_setup(movement_settings_t *settings, uint8_t watch_face_index, v
     (void) settings;
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(tarot_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(tarot_state_t));
         memset(*context_ptr, 0, sizeof(tarot_state_t));
     }
-    // Emulator only: Seed random number generator
-    #if __EMSCRIPTEN__
-    srand(time(NULL));
-    #endif
 }
 
 void tarot_face_activate(movement_settings_t *settings, void *context) {
@@ -84,6 +84,9 @@ void tarot_face_resign(movement_settings_t *settings, void *context);
     tarot_face_loop, \
     tarot_face_resign, \
     NULL, \
+    sizeof(tarot_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // TAROT_FACE_H_
@@ -22,105 +22,114 @@
  * SOFTWARE.
  */
 
+
 #include <stdlib.h>
 #include <string.h>
-#include <math.h>
 #include "tempchart_face.h"
+#include "movement_temperature.h"
+#include "units.h"
 #include "watch.h"
-#include "watch_private_display.h"
-#include "filesystem.h"
-#include "thermistor_driver.h"
 
-struct {
-    uint8_t stat[24 * 70];
-    uint16_t num_div;
-} tempchart_state;
+static const char _tempchart_titles[MOVEMENT_TEMPERATURE_NUM_RESOLUTIONS][3] = {"TM", "TH", "TD"};
+
+// one bar for each of the six positions on the bottom line, from its bottom, middle or top segment.
+static const char _tempchart_bars[3] = {'_', '-', '~'};
 
-static void tempchart_save(void) {
-    filesystem_write_file("tempchart.ini", (char*)&tempchart_state, sizeof(tempchart_state));
+static uint32_t _tempchart_num_periods(tempchart_state_t *state) {
+    uint32_t count = movement_temperature_count(state->resolution);
+    if (count == 0) return 1;
+    return count > TEMPCHART_MAX_INDEX + 1 ? TEMPCHART_MAX_INDEX + 1 : count;
 }
 
-void tempchart_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
-    // These next two lines just silence the compiler warnings associated with unused parameters.
-    // We have no use for the settings or the watch_face_index, so we make that explicit here.
-    (void) settings;
-    (void) context_ptr;
-    (void) watch_face_index;
-    // At boot, context_ptr will be NULL indicating that we don't have anyplace to store our context.
-    if (filesystem_get_file_size("tempchart.ini") != sizeof(tempchart_state)) {
-        // No previous ini or old version of ini file - create new config file
-        tempchart_state.num_div = 0;
-        for (int i = 0; i < 24 * 70; i++)
-            tempchart_state.stat[i] = 0;
-        tempchart_save();
-    } else
-        filesystem_read_file("tempchart.ini", (char*)&tempchart_state, sizeof(tempchart_state));
+static void _tempchart_draw_chart(tempchart_state_t *state, char *buf) {
+    movement_temperature_point_t points[TEMPCHART_NUM_BARS];
+    bool have[TEMPCHART_NUM_BARS];
+    int16_t low = INT16_MAX;
+    int16_t high = INT16_MIN;
+
+    // the newest period is on the right, so the chart scrolls the way time runs.
+    for (uint8_t i = 0; i < TEMPCHART_NUM_BARS; i++) {
+        have[i] = movement_temperature_read(state->resolution, state->index + TEMPCHART_NUM_BARS - 1 - i, &points[i]);
+        if (!have[i]) continue;
+        if (points[i].avg < low) low = points[i].avg;
+        if (points[i].avg > high) high = points[i].avg;
+    }
+    for (uint8_t i = 0; i < TEMPCHART_NUM_BARS; i++) {
+        if (!have[i]) buf[i] = ' ';
+        else buf[i] = _tempchart_bars[(points[i].avg - low) * 3 / (high - low + 1)];
+    }
+    buf[TEMPCHART_NUM_BARS] = 0;
+}
 
+static void _tempchart_update_display(tempchart_state_t *state, bool in_fahrenheit) {
+    char buf[14];
+    movement_temperature_point_t point;
+
+    sprintf(buf, "%s%2d", _tempchart_titles[state->resolution], state->index);
+    if (state->view == TEMPCHART_VIEW_CHART) {
+        _tempchart_draw_chart(state, buf + 4);
+    } else if (!movement_temperature_read(state->resolution, state->index, &point)) {
+        sprintf(buf + 4, "no dat");
+    } else {
+        static const char labels[] = {'A', 'L', 'H'};
+        int16_t centidegrees = state->view == TEMPCHART_VIEW_MIN ? point.min : state->view == TEMPCHART_VIEW_MAX ? point.max : point.avg;
+        int32_t tenths;
+        units_convert(centidegrees, 2, UNITS_CELSIUS, in_fahrenheit ? UNITS_FAHRENHEIT : UNITS_CELSIUS, 1, &tenths);
+        buf[4] = labels[state->view - TEMPCHART_VIEW_AVG];
+        if (!units_format(buf + 5, 5, tenths, 1, '.')) sprintf(buf + 5, "  ---");
+    }
+    watch_display_string(buf, 0);
 }
 
-void tempchart_face_activate(movement_settings_t *settings, void *context) {
-    // same as above: silence the warning, we don't need to check the settings.
+void tempchart_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
     (void) settings;
-    (void) context;
+    if (*context_ptr == NULL) {
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(tempchart_state_t));
+        memset(*context_ptr, 0, sizeof(tempchart_state_t));
+        ((tempchart_state_t *)*context_ptr)->resolution = MOVEMENT_TEMPERATURE_HOURS;
+        movement_temperature_enable();
+    }
 }
 
-static void display(void) {
-    int sum = 0;
-    for (int i = 0; i < 24 * 70; i++)
-        sum += tempchart_state.stat[i];
-
-    char buf[24];
-    sprintf(buf, "TS%2d%6d", tempchart_state.num_div, sum);
-    watch_display_string(buf, 0);
+void tempchart_face_activate(movement_settings_t *settings, void *context) {
+    (void) settings;
+    tempchart_state_t *state = (tempchart_state_t *)context;
+    state->index = 0;
 }
 
 bool tempchart_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
-    (void) settings;
-    (void) context;
+    tempchart_state_t *state = (tempchart_state_t *)context;
 
     switch (event.event_type) {
         case EVENT_ACTIVATE:
-             display();
+            _tempchart_update_display(state, settings->bit.use_imperial_units);
+            break;
         case EVENT_TICK:
-            // on activate and tick, if we are animating,
+            // a new minute can start a new period, which moves the chart along.
+            if (movement_get_local_date_time().unit.second == 0) _tempchart_update_display(state, settings->bit.use_imperial_units);
+            break;
+        case EVENT_LIGHT_BUTTON_DOWN:
+            // the light button picks the resolution; long press it for the light.
+            break;
+        case EVENT_LIGHT_BUTTON_UP:
+            state->resolution = (state->resolution + 1) % MOVEMENT_TEMPERATURE_NUM_RESOLUTIONS;
+            state->index = 0;
+            _tempchart_update_display(state, settings->bit.use_imperial_units);
+            break;
+        case EVENT_LIGHT_LONG_PRESS:
+            movement_illuminate_led();
             break;
-        case EVENT_LOW_ENERGY_UPDATE:
-            // This low energy mode update occurs once a minute, if the watch face is in the
-            // foreground when Movement enters low energy mode. We have the option of supporting
-            // this mode, but since our watch face animates once a second, the "Hello there" face
-            // isn't very useful in this mode. So we choose not to support it. (continued below)
+        case EVENT_ALARM_BUTTON_UP:
+            state->index = (state->index + 1) % _tempchart_num_periods(state);
+            _tempchart_update_display(state, settings->bit.use_imperial_units);
+            break;
+        case EVENT_ALARM_LONG_PRESS:
+            state->view = (state->view + 1) % TEMPCHART_NUM_VIEWS;
+            _tempchart_update_display(state, settings->bit.use_imperial_units);
             break;
         case EVENT_TIMEOUT:
-            // ... Instead, we respond to the timeout event. This event happens after a configurable
-            // interval on screen (1-30 minutes). The watch will give us this event as a chance to
-            // resign control if we want to, and in this case, we do.
-            // This function will return the watch to the first screen (usually a simple clock),
-            // and it will do it long before the watch enters low energy mode. This ensures we
-            // won't be on screen, and thus opts us out of getting the EVENT_LOW_ENERGY_UPDATE above.
             movement_move_to_face(0);
             break;
-        case EVENT_BACKGROUND_TASK:
-            // Here we measure temperature and do main frequency correction
-            thermistor_driver_enable();
-            float temperature_c = thermistor_driver_get_temperature();
-            thermistor_driver_disable();
-            watch_date_time date_time = watch_rtc_get_date_time();
-
-            int temp = round(temperature_c * 2);
-            if ((temp < 0) || (temp >= 70)) break;
-
-            if (tempchart_state.stat[date_time.unit.hour + temp * 24] == 255) { // We've reached the limit
-              tempchart_state.num_div++;
-              for (int i = 0; i < 24 * 70; i++)
-                tempchart_state.stat[i] = (tempchart_state.stat[i] + 1) >> 1; // So that we don't lose 1
-            }
-            tempchart_state.stat[date_time.unit.hour+temp*24]++;
-
-            if (date_time.unit.hour == 0 && date_time.unit.minute == 10)
-                tempchart_save();
-
-            break;
-
         default:
             movement_default_loop_handler(event, settings);
             break;
@@ -130,18 +139,6 @@ bool tempchart_face_loop(movement_event_t event, movement_settings_t *settings,
 }
 
 void tempchart_face_resign(movement_settings_t *settings, void *context) {
-    // our watch face, like most watch faces, has nothing special to do when resigning.
-    // watch faces that enable a peripheral or interact with a sensor may want to turn it off here.
-    (void) settings;
-    (void) context;
-}
-
-//background freq correction
-bool tempchart_face_wants_background_task(movement_settings_t *settings, void *context) {
     (void) settings;
     (void) context;
-    watch_date_time date_time = watch_rtc_get_date_time();
-
-    //Updating data every 5 minutes
-    return date_time.unit.minute % 5 == 0;
 }
@@ -28,23 +28,48 @@
 /*
  * TEMPERATURE CHART face
  *
- * Gathers temperature statistics in a chart form.
- * Statistics bins are per hour / per 0.5°C.
+ * Charts Movement's temperature history (movement_temperature.h) by the
+ * minute, the hour or the day. The top left shows TM, TH or TD for the
+ * resolution, and the top right how many periods back the newest one shown
+ * is. The bottom line is a chart of the average temperature over six
+ * periods, the newest on the right: a bar at the bottom, middle or top of
+ * each position, scaled to the coldest and warmest of the six.
  *
- * Saved to file every day at 00:00.
- * Can help improve watch precision in the future. 
+ * A short press of the Light button changes the resolution, and a long press
+ * turns on the light. A short press of the Alarm button scrolls one period
+ * back; a long press switches between the chart and the newest period's
+ * average (A), minimum (L) and maximum (H) temperature.
  *
- * If you can gather statistics over few months, and then send "tempchart.ini"
- * to "3@14.by", it will help future generations of precision quartz watches.
+ * The history reaches back 7 hours by the minute, 6 days by the hour and 96
+ * days by the day, or more. Earlier versions of this face kept their own
+ * statistics in tempchart.ini; once you have no more use for it, you can
+ * free the space with the shell's rm command.
  */
 
 #include "movement.h"
 
+#define TEMPCHART_NUM_BARS (6)
+// the oldest period the face shows, as far as two digits count.
+#define TEMPCHART_MAX_INDEX (99)
+
+typedef enum {
+    TEMPCHART_VIEW_CHART = 0,
+    TEMPCHART_VIEW_AVG,
+    TEMPCHART_VIEW_MIN,
+    TEMPCHART_VIEW_MAX,
+    TEMPCHART_NUM_VIEWS
+} tempchart_view_t;
+
+typedef struct {
+    uint8_t resolution;     // a movement_temperature_resolution_t
+    uint8_t view;           // a tempchart_view_t
+    uint8_t index;          // periods back from the current one, of the newest period shown
+} tempchart_state_t;
+
 void tempchart_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
 void tempchart_face_activate(movement_settings_t *settings, void *context);
 bool tempchart_face_loop(movement_event_t event, movement_settings_t *settings, void *context);
 void tempchart_face_resign(movement_settings_t *settings, void *context);
-bool tempchart_face_wants_background_task(movement_settings_t *settings, void *context);
 
 
 #define tempchart_face ((const watch_face_t){ \
@@ -52,7 +77,10 @@ bool tempchart_face_wants_background_task(movement_settings_t *settings, void *c
     tempchart_face_activate, \
     tempchart_face_loop, \
     tempchart_face_resign, \
-    tempchart_face_wants_background_task, \
+    NULL, \
+    sizeof(tempchart_state_t), \
+    MOVEMENT_FACE_EAGER_SETUP, \
+    NULL, \
 })
 
 #endif // TEMPCHART_FACE_H_
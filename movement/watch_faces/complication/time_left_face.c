@@ -90,8 +90,7 @@ static void _draw(time_left_state_t *state, uint8_t subsecond) {
     watch_display_character(_state_titles[state->current_page][2], 3);
     if (state->current_page < TIME_LEFT_FACE_SETTINGS_STATE) {
         // we are displaying days left or days from birth
-        watch_date_time date_time = watch_rtc_get_date_time();
-        uint32_t julian_current_day = _juliandaynum(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR, date_time.unit.month, date_time.unit.day);
+        uint32_t julian_current_day = movement_get_calendar()->julian_day;
         uint32_t julian_target_day = _juliandaynum(state->target_date.bit.year, state->target_date.bit.month, state->target_date.bit.day);
         int32_t days_left = julian_target_day - julian_current_day;
         if (state->current_page == 0) {
@@ -220,7 +219,7 @@ void time_left_face_setup(movement_settings_t *settings, uint8_t watch_face_inde
     (void) settings;
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(time_left_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(time_left_state_t));
         memset(*context_ptr, 0, sizeof(time_left_state_t));
         time_left_state_t *state = (time_left_state_t *)*context_ptr;
         state->birth_date.reg = watch_get_backup_data(2);
@@ -86,6 +86,9 @@ void time_left_face_resign(movement_settings_t *settings, void *context);
     time_left_face_loop, \
     time_left_face_resign, \
     NULL, \
+    sizeof(time_left_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // TIME_LEFT_FACE_H_
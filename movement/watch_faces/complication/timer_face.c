@@ -27,6 +27,7 @@
 #include "timer_face.h"
 #include "watch.h"
 #include "watch_utility.h"
+#include "movement_timer.h"
 
 static const uint32_t _default_timer_values[] = {0x000200, 0x000500, 0x000A00, 0x001400, 0x002D02}; // default timers: 2 min, 5 min, 10 min, 20 min, 2 h 45 min
 
@@ -36,10 +37,6 @@ static const int8_t _sound_seq_start[] = {BUZZER_NOTE_C8, 2, 0};
 
 static uint8_t _beeps_to_play;    // temporary counter for ring signals playing
 
-static inline int32_t _get_tz_offset(movement_settings_t *settings) {
-    return movement_timezone_offsets[settings->bit.time_zone] * 60;
-}
-
 static void _signal_callback() {
     if (_beeps_to_play) {
         _beeps_to_play--;
@@ -47,20 +44,18 @@ static void _signal_callback() {
     }
 }
 
-static void _start(timer_state_t *state, movement_settings_t *settings, bool with_beep) {
+static inline uint32_t _timer_seconds(timer_state_t *state) {
+    timer_setting_t *timer = &state->timers[state->current_timer];
+    return timer->unit.hours * 3600 + timer->unit.minutes * 60 + timer->unit.seconds;
+}
+
+static void _start(timer_state_t *state, bool with_beep) {
     if (state->timers[state->current_timer].value == 0) return;
-    watch_date_time now = watch_rtc_get_date_time();
-    state->now_ts = watch_utility_date_time_to_unix_time(now, _get_tz_offset(settings));
     if (state->mode == pausing)
-        state->target_ts = state->now_ts + state->paused_left;
+        movement_timer_resume(state->watch_face_index, 0);
     else
-        state->target_ts = watch_utility_offset_timestamp(state->now_ts, 
-                                                          state->timers[state->current_timer].unit.hours, 
-                                                          state->timers[state->current_timer].unit.minutes, 
-                                                          state->timers[state->current_timer].unit.seconds);
-    watch_date_time target_dt = watch_utility_date_time_from_unix_time(state->target_ts, _get_tz_offset(settings));
+        movement_timer_start(state->watch_face_index, 0, _timer_seconds(state), MOVEMENT_TIMER_SOUND_NONE);
     state->mode = running;
-    movement_schedule_background_task_for_face(state->watch_face_index, target_dt);
     watch_set_indicator(WATCH_INDICATOR_BELL);
     if (with_beep) watch_buzzer_play_sequence((int8_t *)_sound_seq_start, NULL);
 }
@@ -82,7 +77,7 @@ static void _draw(timer_state_t *state, uint8_t subsecond) {
                 return;
             // fall through
         case running:
-            delta = state->target_ts - state->now_ts;
+            delta = movement_timer_get_remaining(state->watch_face_index, 0);
             result = div(delta, 60);
             sec = result.rem;
             result = div(result.quot, 60);
@@ -126,7 +121,7 @@ static void _draw(timer_state_t *state, uint8_t subsecond) {
 
 static void _reset(timer_state_t *state) {
     state->mode = waiting;
-    movement_cancel_background_task_for_face(state->watch_face_index);
+    movement_timer_cancel(state->watch_face_index, 0);
     watch_clear_indicator(WATCH_INDICATOR_BELL);
 }
 
@@ -193,7 +188,7 @@ void timer_face_setup(movement_settings_t *settings, uint8_t watch_face_index, v
     (void) settings;
 
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(timer_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(timer_state_t));
         timer_state_t *state = (timer_state_t *)*context_ptr;
         memset(*context_ptr, 0, sizeof(timer_state_t));
         state->watch_face_index = watch_face_index;
@@ -209,8 +204,6 @@ void timer_face_activate(movement_settings_t *settings, void *context) {
     watch_display_string("TR", 0);
     watch_set_colon();
     if(state->mode == running) {
-        watch_date_time now = watch_rtc_get_date_time();
-        state->now_ts = watch_utility_date_time_to_unix_time(now, _get_tz_offset(settings));
         watch_set_indicator(WATCH_INDICATOR_BELL);
     } else {
         state->pausing_seconds = 1;
@@ -228,8 +221,7 @@ bool timer_face_loop(movement_event_t event, movement_settings_t *settings, void
             _draw(state, event.subsecond);
             break;
         case EVENT_TICK:
-            if (state->mode == running) state->now_ts++;
-            else if (state->mode == pausing) state->pausing_seconds++;
+            if (state->mode == pausing) state->pausing_seconds++;
             else if (state->quick_cycle) {
                 if (watch_get_pin_level(BTN_ALARM)) {
                     _settings_increment(state);
@@ -268,18 +260,17 @@ bool timer_face_loop(movement_event_t event, movement_settings_t *settings, void
                 case running:
                     state->mode = pausing;
                     state->pausing_seconds = 0;
-                    state->paused_left = state->target_ts - state->now_ts;
-                    movement_cancel_background_task();
+                    movement_timer_pause(state->watch_face_index, 0);
                     break;
                 case pausing:
-                    _start(state, settings, false);
+                    _start(state, false);
                     break;
                 case waiting: {
                     uint8_t last_timer = state->current_timer;
                     state->current_timer = (state->current_timer + 1) % TIMER_SLOTS;
                     _set_next_valid_timer(state);
                     // start the time immediately if there is only one valid timer slot
-                    if (last_timer == state->current_timer) _start(state, settings, true);
+                    if (last_timer == state->current_timer) _start(state, true);
                     break;
                 }
                 case setting:
@@ -302,11 +293,15 @@ bool timer_face_loop(movement_event_t event, movement_settings_t *settings, void
             _draw(state, event.subsecond);
             break;
         case EVENT_BACKGROUND_TASK:
+            if (!movement_timer_take_expired(state->watch_face_index)) break;
             // play the alarm
             _beeps_to_play = 4;
             watch_buzzer_play_sequence((int8_t *)_sound_seq_beep, _signal_callback);
-            _reset(state);
-            if (state->timers[state->current_timer].unit.repeat) _start(state, settings, false);
+            // a looping timer starts again from the moment it ran out, so it doesn't drift.
+            if (state->timers[state->current_timer].unit.repeat)
+                movement_timer_chain(state->watch_face_index, 0, _timer_seconds(state), MOVEMENT_TIMER_SOUND_NONE);
+            else
+                _reset(state);
             break;
         case EVENT_ALARM_LONG_PRESS:
             switch(state->mode) {
@@ -326,7 +321,7 @@ bool timer_face_loop(movement_event_t event, movement_settings_t *settings, void
                     }
                     break;
                 case waiting:
-                    _start(state, settings, true);
+                    _start(state, true);
                     break;
                 case pausing:
                 case running:
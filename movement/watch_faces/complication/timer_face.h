@@ -47,7 +47,9 @@
  *     timer slot in the following order: hours - minutes - seconds - timer repeat
  *   - Short-pressing the alarm button alters the current settings value.
  *   - Long-pressing the light button resumes to normal mode.
- * 
+ *
+ * The countdown runs on Movement's timer service (see movement_timer.h), so
+ * the watch doesn't wake for it until it's done.
  */
 
 #include "movement.h"
@@ -72,9 +74,6 @@ typedef union {
 } timer_setting_t;
 
 typedef struct {
-    uint32_t target_ts;
-    uint32_t now_ts;
-    uint16_t paused_left;
     uint8_t pausing_seconds;
     uint8_t watch_face_index;
     timer_setting_t timers[TIMER_SLOTS]; 
@@ -97,6 +96,9 @@ void timer_face_resign(movement_settings_t *settings, void *context);
     timer_face_loop, \
     timer_face_resign, \
     NULL, \
+    sizeof(timer_state_t), \
+    0, \
+    NULL, \
 })
 
 
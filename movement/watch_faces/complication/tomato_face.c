@@ -26,14 +26,11 @@
 #include <string.h>
 #include "tomato_face.h"
 #include "watch_utility.h"
+#include "movement_timer.h"
 
 static uint8_t focus_min = 25;
 static uint8_t break_min = 5;
 
-static inline int32_t get_tz_offset(movement_settings_t *settings) {
-    return movement_timezone_offsets[settings->bit.time_zone] * 60;
-}
-
 static uint8_t get_length(tomato_state_t *state) {
     uint8_t length;
     if (state->kind == tomato_focus) {
@@ -45,15 +42,9 @@ static uint8_t get_length(tomato_state_t *state) {
     return length;
 }
 
-static void tomato_start(tomato_state_t *state, movement_settings_t *settings) {
-    watch_date_time now = watch_rtc_get_date_time();
-    int8_t length = (int8_t) get_length(state);
-
+static void tomato_start(tomato_state_t *state) {
     state->mode = tomato_run;
-    state->now_ts = watch_utility_date_time_to_unix_time(now, get_tz_offset(settings));
-    state->target_ts = watch_utility_offset_timestamp(state->now_ts, 0, length, 0);
-    watch_date_time target_dt = watch_utility_date_time_from_unix_time(state->target_ts, get_tz_offset(settings));
-    movement_schedule_background_task(target_dt);
+    movement_timer_start(state->watch_face_index, 0, get_length(state) * 60, MOVEMENT_TIMER_SOUND_SIGNAL);
     watch_set_indicator(WATCH_INDICATOR_BELL);
 }
 
@@ -74,7 +65,7 @@ static void tomato_draw(tomato_state_t *state) {
 
     switch (state->mode) {
         case tomato_run:
-            delta = state->target_ts - state->now_ts;
+            delta = movement_timer_get_remaining(state->watch_face_index, 0);
             result = div(delta, 60);
             min = result.quot;
             sec = result.rem;
@@ -92,12 +83,13 @@ static void tomato_draw(tomato_state_t *state) {
 
 static void tomato_reset(tomato_state_t *state) {
     state->mode = tomato_ready;
-    movement_cancel_background_task();
+    movement_timer_cancel(state->watch_face_index, 0);
     watch_clear_indicator(WATCH_INDICATOR_BELL);
 }
 
 static void tomato_ring(tomato_state_t *state) {
-    movement_play_signal();
+    // the timer plays the signal as it hands the expiry over.
+    if (!movement_timer_take_expired(state->watch_face_index)) return;
     tomato_reset(state);
     if (state->kind == tomato_focus) {
         state->kind = tomato_break;
@@ -109,12 +101,12 @@ static void tomato_ring(tomato_state_t *state) {
 
 void tomato_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
     (void) settings;
-    (void) watch_face_index;
 
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(tomato_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(tomato_state_t));
         tomato_state_t *state = (tomato_state_t*)*context_ptr;
         memset(*context_ptr, 0, sizeof(tomato_state_t));
+        state->watch_face_index = watch_face_index;
         state->mode=tomato_ready;
         state->kind= tomato_focus;
         state->done_count = 0;
@@ -123,10 +115,9 @@ void tomato_face_setup(movement_settings_t *settings, uint8_t watch_face_index,
 }
 
 void tomato_face_activate(movement_settings_t *settings, void *context) {
+    (void) settings;
     tomato_state_t *state = (tomato_state_t *)context;
     if (state->mode == tomato_run) {
-        watch_date_time now = watch_rtc_get_date_time();
-        state->now_ts = watch_utility_date_time_to_unix_time(now, get_tz_offset(settings));
         watch_set_indicator(WATCH_INDICATOR_BELL);
     }
     watch_set_colon();
@@ -141,9 +132,6 @@ bool tomato_face_loop(movement_event_t event, movement_settings_t *settings, voi
             tomato_draw(state);
             break;
         case EVENT_TICK:
-            if (state->mode == tomato_run) {
-                state->now_ts++;
-            }
             tomato_draw(state);
             break;
         case EVENT_LIGHT_BUTTON_DOWN:
@@ -163,7 +151,7 @@ bool tomato_face_loop(movement_event_t event, movement_settings_t *settings, voi
                     tomato_reset(state);
                     break;
                 case tomato_ready:
-                    tomato_start(state, settings);
+                    tomato_start(state);
                     break;
             }
             tomato_draw(state);
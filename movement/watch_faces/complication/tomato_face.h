@@ -59,8 +59,7 @@ typedef enum {
 } tomato_kind;
 
 typedef struct {
-    uint32_t target_ts;
-    uint32_t now_ts;
+    uint8_t watch_face_index;
     tomato_mode mode;
     tomato_kind kind;
     uint8_t done_count;
@@ -78,6 +77,9 @@ void tomato_face_resign(movement_settings_t *settings, void *context);
     tomato_face_loop, \
     tomato_face_resign, \
     NULL, \
+    sizeof(tomato_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // TOMATO_FACE_H_
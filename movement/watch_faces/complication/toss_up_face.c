@@ -25,12 +25,6 @@
 #include <stdlib.h>
 #include <string.h>
 #include "toss_up_face.h"
-#if __EMSCRIPTEN__
-#include <time.h>
-#else
-#include "saml22j18a.h"
-#endif
-
 static const char heads[] = { '8', 'h', '4', 'E', '(' };
 static const char tails[] = { '0', '+', 'N', '3', ')' };
 static const uint8_t dd[] = {2, 4, 6, 8, 10,12,20,24,30,32,36,48,99}; 
@@ -48,7 +42,7 @@ void toss_up_face_setup(movement_settings_t *settings, uint8_t watch_face_index,
     (void) watch_face_index;
     (void) settings;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(toss_up_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(toss_up_state_t));
         memset(*context_ptr, 0, sizeof(toss_up_state_t));
         toss_up_state_t *state = (toss_up_state_t *)*context_ptr;
 
@@ -247,19 +241,7 @@ uint8_t divine_bit(void) {
 /** @brief get 32 True Random Number bits
  */
 uint32_t get_true_entropy(void) {
-    #if __EMSCRIPTEN__
-    return rand() % INT32_MAX;
-    #else
-    hri_mclk_set_APBCMASK_TRNG_bit(MCLK);
-    hri_trng_set_CTRLA_ENABLE_bit(TRNG);
-
-    while (!hri_trng_get_INTFLAG_reg(TRNG, TRNG_INTFLAG_DATARDY)); // Wait for TRNG data to be ready
-
-    watch_disable_TRNG();
-
-    hri_mclk_clear_APBCMASK_TRNG_bit(MCLK);
-    return hri_trng_read_DATA_reg(TRNG); // Read a single 32-bit word from TRNG and return it
-    #endif
+    return watch_random_true(); // a 32-bit word from the TRNG, by way of the entropy pool
 }
 
 // COIN FUNCTIONS /////////////////////////////////////////////////////////////
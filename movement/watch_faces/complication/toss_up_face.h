@@ -106,6 +106,9 @@ void toss_up_face_resign(movement_settings_t *settings, void *context);
     toss_up_face_loop, \
     toss_up_face_resign, \
     NULL, \
+    sizeof(toss_up_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // TOSS_UP_FACE_H_
@@ -97,6 +97,10 @@ static void totp_validate_key_lengths(void) {
 static void totp_generate(totp_state_t *totp_state) {
     totp_t *totp = totp_current(totp_state);
 
+    // force the code for the new key to be computed on the next display
+    totp_state->steps = 0;
+    totp_state->next_code_ready = false;
+
     if (totp->encoded_key_length <= 0) {
         // Key exceeded static limits and was turned off
         totp_state->current_decoded_key_length = 0;
@@ -111,6 +115,7 @@ static void totp_generate(totp_state_t *totp_state) {
         return;
     }
 
+    movement_request_performance(MOVEMENT_PERFORMANCE_HIGH);
     TOTP(
         totp_state->current_decoded_key,
         totp_state->current_decoded_key_length,
@@ -129,19 +134,34 @@ static void totp_display_error(totp_state_t *totp_state) {
 
 static void totp_display_code(totp_state_t *totp_state) {
     char buf[14];
-    div_t result;
+    uint32_t steps;
     uint8_t valid_for;
     totp_t *totp = totp_current(totp_state);
 
-    result = div(totp_state->timestamp, totp->period);
-    if (result.quot != totp_state->steps) {
-        totp_state->current_code = getCodeFromTimestamp(totp_state->timestamp);
-        totp_state->steps = result.quot;
+    steps = totp_state->timestamp / totp->period;
+    if (steps != totp_state->steps) {
+        movement_request_performance(MOVEMENT_PERFORMANCE_HIGH);
+        if (totp_state->next_code_ready && steps == totp_state->steps + 1) {
+            totp_state->current_code = totp_state->next_code;
+        } else {
+            totp_state->current_code = getCodeFromSteps(steps);
+        }
+        totp_state->steps = steps;
+        totp_state->next_code_ready = false;
     }
-    valid_for = totp->period - result.rem;
-    sprintf(buf, "%c%c%2d%06lu", totp->labels[0], totp->labels[1], valid_for, totp_state->current_code);
+    valid_for = totp->period - (totp_state->timestamp - steps * totp->period);
+    buf[0] = totp->labels[0];
+    buf[1] = totp->labels[1];
+    watch_fmt_u32(watch_fmt_2d(buf + 2, valid_for, ' '), totp_state->current_code, 6, '0');
 
     watch_display_string(buf, 0);
+
+    // with the display already updated, work out the next code so that the rollover is just a swap.
+    if (!totp_state->next_code_ready) {
+        movement_request_performance(MOVEMENT_PERFORMANCE_HIGH);
+        totp_state->next_code = getCodeFromSteps(totp_state->steps + 1);
+        totp_state->next_code_ready = true;
+    }
 }
 
 static void totp_display(totp_state_t *totp_state) {
@@ -158,7 +178,8 @@ static void totp_generate_and_display(totp_state_t *totp_state) {
 }
 
 static inline uint32_t totp_compute_base_timestamp(movement_settings_t *settings) {
-    return watch_utility_date_time_to_unix_time(watch_rtc_get_date_time(), movement_timezone_offsets[settings->bit.time_zone] * 60);
+    (void) settings;
+    return watch_utility_date_time_to_unix_time(watch_rtc_get_date_time(), movement_get_current_timezone_offset() * 60);
 }
 
 void totp_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
@@ -67,8 +67,10 @@
 
 typedef struct {
     uint32_t timestamp;
-    uint8_t steps;
+    uint32_t steps;
     uint32_t current_code;
+    uint32_t next_code;     // code for steps + 1, computed ahead of the rollover
+    bool next_code_ready;
     uint8_t current_index;
     uint8_t *current_decoded_key;
     size_t current_decoded_key_length;
@@ -85,6 +87,9 @@ void totp_face_resign(movement_settings_t *settings, void *context);
     totp_face_loop, \
     totp_face_resign, \
     NULL, \
+    0, \
+    0, \
+    NULL, \
 })
 
 #endif // TOTP_FACE_H_
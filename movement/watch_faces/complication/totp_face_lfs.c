@@ -32,12 +32,24 @@
 #include "watch.h"
 #include "watch_utility.h"
 #include "filesystem.h"
+#include "movement_scratch.h"
 
 #include "totp_face_lfs.h"
 
-#define MAX_TOTP_RECORDS 20
+#define MAX_TOTP_RECORDS UINT16_MAX
 #define MAX_TOTP_SECRET_SIZE 48
 #define TOTP_FILE "totp_uris.txt"
+#define TOTP_STORE_FILE "totp.bin"
+#define TOTP_LINE_MAX 255
+
+// The URIs are compiled into TOTP_STORE_FILE the first time they are read, so that later boots can load the decoded
+// secrets in one read instead of parsing and base32-decoding every line. The store is sealed (@see
+// filesystem_write_sealed), so the secrets in it can't be read off the filesystem; inside, it's little-endian and packed:
+//   header: "TOTP", version (1 byte), unused (1 byte), record count (2 bytes), size of the URI file it came from (4)
+//   record: label (2 bytes), algorithm (1), secret size (1), period (4), then the secret itself
+#define TOTP_STORE_VERSION 1
+#define TOTP_STORE_HEADER_SIZE 12
+#define TOTP_STORE_RECORD_SIZE 8
 
 const char* TOTP_URI_START = "otpauth://totp/";
 
@@ -49,8 +61,23 @@ struct totp_record {
     hmac_alg algorithm;
 };
 
-static struct totp_record totp_records[MAX_TOTP_RECORDS];
+static struct totp_record *totp_records = NULL;
 static int num_totp_records = 0;
+static int totp_records_capacity = 0;
+
+static bool totp_face_lfs_reserve_records(int count) {
+    if (count <= totp_records_capacity) return true;
+    int capacity = totp_records_capacity ? totp_records_capacity * 2 : 4;
+    if (capacity < count) capacity = count;
+    struct totp_record *records = realloc(totp_records, capacity * sizeof(struct totp_record));
+    if (records == NULL) {
+        printf("TOTP out of memory for %d records\n", count);
+        return false;
+    }
+    totp_records = records;
+    totp_records_capacity = capacity;
+    return true;
+}
 
 static void init_totp_record(struct totp_record *totp_record) {
     totp_record->secret_size = 0;
@@ -125,11 +152,12 @@ static void totp_face_lfs_read_file(char *filename) {
         return;
     }
 
-    char line[256];
+    char *line = movement_scratch_borrow(TOTP_LINE_MAX + 1);
+    if (line == NULL) return;
     int32_t offset = 0;
-    while (filesystem_read_line(filename, line, &offset, 255) && strlen(line)) {
-        if (num_totp_records == MAX_TOTP_RECORDS) {
-            printf("TOTP max records: %d\n", MAX_TOTP_RECORDS);
+    while (filesystem_read_line(filename, line, &offset, TOTP_LINE_MAX) && strlen(line)) {
+        if (num_totp_records == MAX_TOTP_RECORDS || !totp_face_lfs_reserve_records(num_totp_records + 1)) {
+            printf("TOTP max records: %d\n", num_totp_records);
             break;
         }
 
@@ -170,18 +198,127 @@ static void totp_face_lfs_read_file(char *filename) {
             printf("TOTP missing secret: %s\n", line);
         }
     }
+    movement_scratch_release(line);
+}
+
+static uint32_t totp_face_lfs_get_le32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void totp_face_lfs_put_le32(uint8_t *p, uint32_t value) {
+    p[0] = value & 0xFF;
+    p[1] = (value >> 8) & 0xFF;
+    p[2] = (value >> 16) & 0xFF;
+    p[3] = (value >> 24) & 0xFF;
+}
+
+static bool totp_face_lfs_read_store(int32_t source_size) {
+    int32_t size = filesystem_get_file_size(TOTP_STORE_FILE);
+    if (size < TOTP_STORE_HEADER_SIZE) return false;
+
+    // the secrets are used in place, so the buffer is kept for as long as the records are.
+    uint8_t *store = malloc(size);
+    if (store == NULL) return false;
+    int32_t sealed_size = filesystem_read_sealed(TOTP_STORE_FILE, store, size);
+    // a store from before they were sealed is read as it is, and sealed once it's loaded.
+    if (sealed_size >= 0) size = sealed_size;
+    else if (!filesystem_read_file(TOTP_STORE_FILE, (char *)store, size)) size = 0;
+    if (size < TOTP_STORE_HEADER_SIZE || memcmp(store, "TOTP", 4) || store[4] != TOTP_STORE_VERSION) {
+        free(store);
+        return false;
+    }
+
+    // a store built from another version of the URI file is stale; with no URI file at all, it is all there is.
+    uint16_t count = store[6] | (store[7] << 8);
+    if (source_size >= 0 && totp_face_lfs_get_le32(store + 8) != (uint32_t)source_size) {
+        free(store);
+        return false;
+    }
+    if (!totp_face_lfs_reserve_records(count)) {
+        free(store);
+        return false;
+    }
+
+    int32_t offset = TOTP_STORE_HEADER_SIZE;
+    for (uint16_t i = 0; i < count; i++) {
+        if (offset + TOTP_STORE_RECORD_SIZE > size ||
+            offset + TOTP_STORE_RECORD_SIZE + store[offset + 3] > size ||
+            store[offset + 2] > SHA512) {
+            printf("TOTP store corrupt\n");
+            num_totp_records = 0;
+            free(store);
+            return false;
+        }
+        struct totp_record *record = &totp_records[i];
+        record->label[0] = store[offset];
+        record->label[1] = store[offset + 1];
+        record->algorithm = (hmac_alg)store[offset + 2];
+        record->secret_size = store[offset + 3];
+        record->period = totp_face_lfs_get_le32(store + offset + 4);
+        record->secret = store + offset + TOTP_STORE_RECORD_SIZE;
+        offset += TOTP_STORE_RECORD_SIZE + record->secret_size;
+    }
+    num_totp_records = count;
+    if (sealed_size < 0) filesystem_write_sealed(TOTP_STORE_FILE, store, size);
+
+    return true;
+}
+
+static void totp_face_lfs_write_store(int32_t source_size) {
+    int32_t size = TOTP_STORE_HEADER_SIZE;
+    for (int i = 0; i < num_totp_records; i++) size += TOTP_STORE_RECORD_SIZE + totp_records[i].secret_size;
+
+    uint8_t *store = malloc(size);
+    if (store == NULL) return;
+    memcpy(store, "TOTP", 4);
+    store[4] = TOTP_STORE_VERSION;
+    store[5] = 0;
+    store[6] = num_totp_records & 0xFF;
+    store[7] = num_totp_records >> 8;
+    totp_face_lfs_put_le32(store + 8, source_size);
+
+    int32_t offset = TOTP_STORE_HEADER_SIZE;
+    for (int i = 0; i < num_totp_records; i++) {
+        struct totp_record *record = &totp_records[i];
+        store[offset] = record->label[0];
+        store[offset + 1] = record->label[1];
+        store[offset + 2] = record->algorithm;
+        store[offset + 3] = record->secret_size;
+        totp_face_lfs_put_le32(store + offset + 4, record->period);
+        memcpy(store + offset + TOTP_STORE_RECORD_SIZE, record->secret, record->secret_size);
+        offset += TOTP_STORE_RECORD_SIZE + record->secret_size;
+    }
+
+    if (!filesystem_write_sealed(TOTP_STORE_FILE, store, size)) {
+        printf("TOTP can't write %s\n", TOTP_STORE_FILE);
+    }
+    memset(store, 0, size);
+    free(store);
+}
+
+static void totp_face_lfs_load(void) {
+    int32_t source_size = filesystem_get_file_size(TOTP_FILE);
+
+    if (totp_face_lfs_read_store(source_size)) return;
+    if (source_size < 0) {
+        printf("TOTP file error: %s\n", TOTP_FILE);
+        return;
+    }
+
+    totp_face_lfs_read_file(TOTP_FILE);
+    totp_face_lfs_write_store(source_size);
 }
 
 void totp_face_lfs_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
     (void) settings;
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(totp_lfs_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(totp_lfs_state_t));
     }
 
 #if !(__EMSCRIPTEN__)
     if (num_totp_records == 0) {
-        totp_face_lfs_read_file(TOTP_FILE);
+        totp_face_lfs_load();
     }
 #endif
 }
@@ -195,6 +332,7 @@ static void totp_face_set_record(totp_lfs_state_t *totp_state, int i) {
     TOTP(totp_records[i].secret, totp_records[i].secret_size, totp_records[i].period, totp_records[i].algorithm);
     totp_state->current_code = getCodeFromTimestamp(totp_state->timestamp);
     totp_state->steps = totp_state->timestamp / totp_records[i].period;
+    totp_state->next_code_ready = false;
 }
 
 void totp_face_lfs_activate(movement_settings_t *settings, void *context) {
@@ -206,16 +344,16 @@ void totp_face_lfs_activate(movement_settings_t *settings, void *context) {
     if (num_totp_records == 0) {
         // Doing this here rather than in setup makes things a bit more pleasant in the simulator, since there's no easy way to trigger
         // setup again after uploading the data.
-        totp_face_lfs_read_file(TOTP_FILE);
+        totp_face_lfs_load();
     }
 #endif
 
-    totp_state->timestamp = watch_utility_date_time_to_unix_time(watch_rtc_get_date_time(), movement_timezone_offsets[settings->bit.time_zone] * 60);
+    totp_state->timestamp = watch_utility_date_time_to_unix_time(watch_rtc_get_date_time(), movement_get_current_timezone_offset() * 60);
     totp_face_set_record(totp_state, 0);
 }
 
 static void totp_face_display(totp_lfs_state_t *totp_state) {
-    uint8_t index = totp_state->current_index;
+    uint16_t index = totp_state->current_index;
     char buf[14];
 
     if (num_totp_records == 0) {
@@ -223,16 +361,27 @@ static void totp_face_display(totp_lfs_state_t *totp_state) {
         return;
     }
 
-    div_t result = div(totp_state->timestamp, totp_records[index].period);
-    if (result.quot != totp_state->steps) {
-        totp_state->current_code = getCodeFromTimestamp(totp_state->timestamp);
-        totp_state->steps = result.quot;
+    uint32_t steps = totp_state->timestamp / totp_records[index].period;
+    if (steps != totp_state->steps) {
+        if (totp_state->next_code_ready && steps == totp_state->steps + 1) {
+            totp_state->current_code = totp_state->next_code;
+        } else {
+            totp_state->current_code = getCodeFromSteps(steps);
+        }
+        totp_state->steps = steps;
+        totp_state->next_code_ready = false;
     }
-    uint8_t valid_for = totp_records[index].period - result.rem;
+    uint8_t valid_for = totp_records[index].period - (totp_state->timestamp - steps * totp_records[index].period);
 
     sprintf(buf, "%c%c%2d%06lu", totp_records[index].label[0], totp_records[index].label[1], valid_for, totp_state->current_code);
 
     watch_display_string(buf, 0);
+
+    // with the display already updated, work out the next code so that the rollover is just a swap.
+    if (!totp_state->next_code_ready) {
+        totp_state->next_code = getCodeFromSteps(totp_state->steps + 1);
+        totp_state->next_code_ready = true;
+    }
 }
 
 bool totp_face_lfs_loop(movement_event_t event, movement_settings_t *settings, void *context) {
@@ -42,6 +42,18 @@
  *   echo otpauth://totp/ACME%20Co:john.doe@email.com?secret=HXDMVJECJJWSRB3HWIZR4IFUGFTMXBOZ&issuer=ACME%20Co&algorithm=SHA1&digits=6&period=30 >> totp_uris.txt
  * (note the double >> in the second one)
  *
+ * The first time the face reads totp_uris.txt, it decodes the secrets into a
+ * packed record file, totp.bin, and loads that on later boots instead. The
+ * record file is rebuilt whenever the size of totp_uris.txt changes; if you
+ * edit the file without changing its length, rm totp.bin as well. Once
+ * totp.bin exists you may delete totp_uris.txt, and the face will keep using
+ * the compiled records.
+ *
+ * totp.bin is encrypted with a key only this watch has, so once
+ * totp_uris.txt is gone, the secrets can't be read off the filesystem (by
+ * the shell's cat, say, or a backup). It won't open on another watch; copy
+ * totp_uris.txt over instead.
+ *
  * You may want to customise the characters that appear to identify the 2FA
  * code. These are just the first two characters of the issuer, and it's fine
  * to modify the URI.
@@ -55,9 +67,11 @@
 
 typedef struct {
     uint32_t timestamp;
-    uint8_t steps;
+    uint32_t steps;
     uint32_t current_code;
-    uint8_t current_index;
+    uint32_t next_code;     // code for steps + 1, computed ahead of the rollover
+    bool next_code_ready;
+    uint16_t current_index;
 } totp_lfs_state_t;
 
 void totp_face_lfs_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
@@ -71,6 +85,9 @@ void totp_face_lfs_resign(movement_settings_t *settings, void *context);
     totp_face_lfs_loop, \
     totp_face_lfs_resign, \
     NULL, \
+    sizeof(totp_lfs_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // TOTP_FACE_LFS_H_
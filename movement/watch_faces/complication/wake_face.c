@@ -27,6 +27,7 @@
 #include "wake_face.h"
 #include "watch.h"
 #include "watch_utility.h"
+#include "movement_timer.h"
 
 //
 // Private
@@ -56,18 +57,34 @@ void _wake_face_update_display(movement_settings_t *settings, wake_face_state_t
     watch_display_string(lcdbuf, 0);
 }
 
+static
+void _wake_face_arm(wake_face_state_t *state) {
+    if ( !state->mode ) {
+        movement_timer_cancel(state->watch_face_index, 0);
+        return;
+    }
+
+    // Seconds from now until the next time the clock reads the wake time
+    watch_date_time now = movement_get_local_date_time();
+    int32_t delta = (state->hour * 60 + state->minute) * 60
+        - (now.unit.hour * 60 + now.unit.minute) * 60 - now.unit.second;
+    if ( delta <= 0 )
+        delta += 24 * 60 * 60;
+    movement_timer_start(state->watch_face_index, 0, delta, MOVEMENT_TIMER_SOUND_ALARM);
+}
+
 //
 // Exported
 //
 
 void wake_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void **context_ptr) {
     (void) settings;
-    (void) watch_face_index;
 
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(wake_face_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(wake_face_state_t));
         wake_face_state_t *state = (wake_face_state_t *)*context_ptr;
         memset(*context_ptr, 0, sizeof(wake_face_state_t));
+        state->watch_face_index = watch_face_index;
 
         state->hour = 5;
         state->minute = 0;
@@ -84,25 +101,6 @@ void wake_face_resign(movement_settings_t *settings, void *context) {
     (void) context;
 }
 
-bool wake_face_wants_background_task(movement_settings_t *settings, void *context) {
-    (void) settings;
-    wake_face_state_t *state = (wake_face_state_t *)context;
-
-    bool rc = false;
-    if ( state->mode ) {
-        watch_date_time now = watch_rtc_get_date_time();
-        rc = state->hour==now.unit.hour && state->minute==now.unit.minute;
-        // We’re at the mercy of the wants_background_task handler
-        // In Safari, the emulator triggers at the ›end‹ of the minute
-        // Converting to Unix timestamps and taking a difference between now and wake
-        // is not an easy win — because the timestamp for wake has to rely on now
-        // for its date. So first we’d have to see if the TOD of wake is after that
-        // of now. If it is, take tomorrow’s date, calculating month and year rollover
-        // if need be.
-    }
-    return rc;
-}
-
 bool wake_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
     (void) settings;
     wake_face_state_t *state = (wake_face_state_t *)context;
@@ -114,23 +112,31 @@ bool wake_face_loop(movement_event_t event, movement_settings_t *settings, void
         break;
     case EVENT_LIGHT_BUTTON_UP:
         state->hour = (state->hour + 1) % 24;
+        _wake_face_arm(state);
         _wake_face_update_display(settings, state);
         break;
     case EVENT_LIGHT_LONG_PRESS:
         state->hour = (state->hour + 6) % 24;
+        _wake_face_arm(state);
         _wake_face_update_display(settings, state);
         break;
     case EVENT_ALARM_BUTTON_UP:
         state->minute = (state->minute + 10) % 60;
+        _wake_face_arm(state);
         _wake_face_update_display(settings, state);
         break;
     case EVENT_ALARM_LONG_PRESS:
         state->mode ^= 1;
+        _wake_face_arm(state);
         _wake_face_update_display(settings, state);
         break;
     case EVENT_BACKGROUND_TASK:
-        movement_play_alarm();
-            // 2022-07-23: Thx @joeycastillo for the dedicated “alarm” signal
+        // The timer plays the alarm as it hands the expiry over
+        // 2022-07-23: Thx @joeycastillo for the dedicated “alarm” signal
+        // The next one is worked out afresh, so it follows the clock across
+        // daylight saving changes
+        if ( movement_timer_take_expired(state->watch_face_index) )
+            _wake_face_arm(state);
         break;
     case EVENT_TIMEOUT:
         movement_move_to_face(0);
@@ -0,0 +1,89 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include "battery_life_face.h"
+#include "movement_battery_life.h"
+#include "watch.h"
+
+static void _battery_life_face_update_display(battery_life_state_t *state) {
+    static const char *const titles[MOVEMENT_BATTERY_NUM_USES] = { "St", "FA", "LE", "bZ", "SE", "US" };
+    const movement_battery_life_t *estimate = movement_battery_life_get();
+    char buf[14];
+
+    if (estimate->days == 0) {
+        sprintf(buf, "%s  ----  ", state->page ? titles[state->page - 1] : "BL");
+    } else if (state->page == 0) {
+        sprintf(buf, "BL  %4u  ", estimate->days_left > 9999 ? 9999 : estimate->days_left);
+    } else {
+        uint32_t total = 0;
+        for (uint8_t i = 0; i < MOVEMENT_BATTERY_NUM_USES; i++) total += estimate->daily_use[i];
+        uint32_t share = total ? (uint64_t)estimate->daily_use[state->page - 1] * 100 / total : 0;
+        sprintf(buf, "%s   %3lu  ", titles[state->page - 1], (unsigned long)share);
+    }
+    watch_display_string(buf, 0);
+}
+
+void battery_life_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
+    (void) settings;
+    if (*context_ptr == NULL) {
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(battery_life_state_t));
+        memset(*context_ptr, 0, sizeof(battery_life_state_t));
+    }
+}
+
+void battery_life_face_activate(movement_settings_t *settings, void *context) {
+    (void) settings;
+    battery_life_state_t *state = (battery_life_state_t *)context;
+    state->page = 0;
+}
+
+bool battery_life_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
+    battery_life_state_t *state = (battery_life_state_t *)context;
+
+    switch (event.event_type) {
+        case EVENT_ALARM_BUTTON_UP:
+            state->page = (state->page + 1) % (MOVEMENT_BATTERY_NUM_USES + 1);
+            // fall through
+        case EVENT_ACTIVATE:
+        case EVENT_LOW_ENERGY_UPDATE:
+            _battery_life_face_update_display(state);
+            break;
+        case EVENT_TICK:
+            // the estimate only changes once a day, at the top of a minute.
+            if (watch_rtc_get_date_time().unit.second == 0) _battery_life_face_update_display(state);
+            break;
+        default:
+            return movement_default_loop_handler(event, settings);
+    }
+
+    return true;
+}
+
+void battery_life_face_resign(movement_settings_t *settings, void *context) {
+    (void) settings;
+    (void) context;
+}
@@ -0,0 +1,66 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef BATTERY_LIFE_FACE_H_
+#define BATTERY_LIFE_FACE_H_
+
+/*
+ * BATTERY LIFE
+ *
+ * How long the battery should last with the faces and features you use,
+ * from Movement's energy accounting (see movement_battery_life.h). The
+ * estimate is brought up to date once a day, so there's nothing to show
+ * (just dashes) until the watch has been running through a midnight.
+ *
+ * The face opens on the days the battery has left ("BL"). Press ALARM to
+ * step through what share of a day's use goes to each thing: standby
+ * ("St", the LCD and clock), the faces ("FA"), the LED ("LE"), the buzzer
+ * ("bZ"), the accelerometer ("SE") and USB ("US"), then back to the days.
+ * The shell's battery command prints all of this, along with each face's
+ * part.
+ */
+
+#include "movement.h"
+
+typedef struct {
+    uint8_t page;           // 0 for the days left, and one more than a movement_battery_use_t for its share
+} battery_life_state_t;
+
+void battery_life_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
+void battery_life_face_activate(movement_settings_t *settings, void *context);
+bool battery_life_face_loop(movement_event_t event, movement_settings_t *settings, void *context);
+void battery_life_face_resign(movement_settings_t *settings, void *context);
+
+#define battery_life_face ((const watch_face_t){ \
+    battery_life_face_setup, \
+    battery_life_face_activate, \
+    battery_life_face_loop, \
+    battery_life_face_resign, \
+    NULL, \
+    sizeof(battery_life_state_t), \
+    0, \
+    NULL, \
+})
+
+#endif // BATTERY_LIFE_FACE_H_
@@ -26,7 +26,8 @@
 #include <string.h>
 #include "chirpy_demo_face.h"
 #include "chirpy_tx.h"
-#include "filesystem.h"
+#include "movement_chirpy.h"
+#include "movement_kv.h"
 
 typedef enum {
     CDM_CHOOSE = 0,
@@ -47,12 +48,9 @@ typedef struct {
     // Selected program
     chirpy_demo_program_t program;
 
-    // Helps us handle 1/64 ticks during transmission; including countdown timer
+    // Helps us handle 1/64 ticks during the countdown and the scale; tick_fun is NULL while Movement sends data
     chirpy_tick_state_t tick_state;
 
-    // Used by chirpy encoder during transmission
-    chirpy_encoder_state_t encoder_state;
-
 } chirpy_demo_state_t;
 
 static uint8_t long_data_str[] =
@@ -91,7 +89,7 @@ static uint8_t short_data[] = {
     0x00,
 };
 
-#define NANOSEC_INI_FILE_NAME "nanosec.ini"
+#define NANOSEC_KV_KEY "nanosec"
 
 static uint8_t *nanosec_buffer = 0;
 static uint16_t nanosec_buffer_size = 0;
@@ -116,7 +114,7 @@ void chirpy_demo_face_activate(movement_settings_t *settings, void *context) {
     state->program = CDP_SCALE;
 
     // Do we have nanosec data? Load it.
-    int32_t sz = filesystem_get_file_size(NANOSEC_INI_FILE_NAME);
+    int32_t sz = movement_kv_get(NANOSEC_KV_KEY, NULL, 0);
     if (sz > 0) {
         // We will free this in resign.
         // I don't like any kind of dynamic allocation in long-running embedded software...
@@ -127,14 +125,12 @@ void chirpy_demo_face_activate(movement_settings_t *settings, void *context) {
         // First two bytes of prefix, so Chirpy RX can recognize this data type
         nanosec_buffer[0] = 0xc0;
         nanosec_buffer[1] = 0x00;
-        // Read file
-        filesystem_read_file(NANOSEC_INI_FILE_NAME, (char*)&nanosec_buffer[2], sz);
+        // Read settings
+        movement_kv_get(NANOSEC_KV_KEY, &nanosec_buffer[2], sz);
     }
 }
 
-// To create / check test file in emulator:
-// echo TestData > nanosec.ini
-// cat nanosec.ini
+// Nanosec data is whatever the nanosec face last saved in the movement key/value store.
 
 static void _cdf_update_lcd(chirpy_demo_state_t *state) {
     watch_display_string("CH", 0);
@@ -153,6 +149,7 @@ static void _cdf_update_lcd(chirpy_demo_state_t *state) {
 static void _cdf_quit_chirping(chirpy_demo_state_t *state) {
     state->mode = CDM_CHOOSE;
     watch_set_buzzer_off();
+    movement_chirpy_stop();
     watch_clear_indicator(WATCH_INDICATOR_BELL);
     movement_request_tick_frequency(1);
 }
@@ -173,20 +170,6 @@ static void _cdf_scale_tick(void *context) {
     ++tick_state->seq_pos;
 }
 
-static void _cdf_data_tick(void *context) {
-    chirpy_demo_state_t *state = (chirpy_demo_state_t *)context;
-
-    uint8_t tone = chirpy_get_next_tone(&state->encoder_state);
-    // Transmission over?
-    if (tone == 255) {
-        _cdf_quit_chirping(state);
-        return;
-    }
-    uint16_t period = chirpy_get_tone_period(tone);
-    watch_set_buzzer_period(period);
-    watch_set_buzzer_on();
-}
-
 static uint8_t *curr_data_ptr;
 static uint16_t curr_data_ix;
 static uint16_t curr_data_len;
@@ -212,11 +195,10 @@ static void _cdf_countdown_tick(void *context) {
         if (state->program == CDP_SCALE) {
             tick_state->tick_fun = _cdf_scale_tick;
         }
-        // We'll be chirping out data
+        // We'll be chirping out data; Movement times the tones, so we only need to look in once a second
         else {
-            // Set up the encoder
-            chirpy_init_encoder(&state->encoder_state, _cdf_get_next_byte);
-            tick_state->tick_fun = _cdf_data_tick;
+            tick_state->tick_fun = NULL;
+            movement_request_tick_frequency(1);
             // Set up the data
             curr_data_ix = 0;
             if (state->program == CDP_INFO_SHORT) {
@@ -229,6 +211,8 @@ static void _cdf_countdown_tick(void *context) {
                 curr_data_ptr = nanosec_buffer;
                 curr_data_len = nanosec_buffer_size;
             }
+            if (!movement_chirpy_start(_cdf_get_next_byte, MOVEMENT_CHIRPY_RATE_NORMAL, NULL))
+                _cdf_quit_chirping(state);
         }
         return;
     }
@@ -299,7 +283,10 @@ bool chirpy_demo_face_loop(movement_event_t event, movement_settings_t *settings
             }
             break;
         case EVENT_TICK:
-            if (state->mode == CDM_CHIRPING) {
+            if (state->mode == CDM_CHIRPING && state->tick_state.tick_fun == NULL) {
+                if (!movement_chirpy_is_sending())
+                    _cdf_quit_chirping(state);
+            } else if (state->mode == CDM_CHIRPING) {
                 ++state->tick_state.tick_count;
                 if (state->tick_state.tick_count == state->tick_state.tick_compare) {
                     state->tick_state.tick_count = 0;
@@ -316,8 +303,8 @@ bool chirpy_demo_face_loop(movement_event_t event, movement_settings_t *settings
             break;
     }
 
-    // Return true if the watch can enter standby mode. False needed when chirping.
-    if (state->mode == CDM_CHIRPING)
+    // Return true if the watch can enter standby mode. False needed when we're driving the buzzer ourselves.
+    if (state->mode == CDM_CHIRPING && state->tick_state.tick_fun != NULL)
         return false;
     else
         return true;
@@ -325,7 +312,10 @@ bool chirpy_demo_face_loop(movement_event_t event, movement_settings_t *settings
 
 void chirpy_demo_face_resign(movement_settings_t *settings, void *context) {
     (void)settings;
-    (void)context;
+    chirpy_demo_state_t *state = (chirpy_demo_state_t *)context;
+
+    if (state->mode == CDM_CHIRPING)
+        _cdf_quit_chirping(state);
 
     if (nanosec_buffer != 0) {
         free(nanosec_buffer);
@@ -63,6 +63,9 @@ void chirpy_demo_face_resign(movement_settings_t *settings, void *context);
     chirpy_demo_face_loop, \
     chirpy_demo_face_resign, \
     NULL, \
+    0, \
+    0, \
+    NULL, \
 })
 
 #endif // CHIRPY_DEMO_FACE_H_
@@ -54,6 +54,9 @@ void frequency_correction_face_resign(movement_settings_t *settings, void *conte
     frequency_correction_face_loop, \
     frequency_correction_face_resign, \
     NULL, \
+    sizeof(frequency_correction_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // FREQUENCY_CORRECTION_FACE_H_
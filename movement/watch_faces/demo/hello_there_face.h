@@ -50,6 +50,9 @@ void hello_there_face_resign(movement_settings_t *settings, void *context);
     hello_there_face_loop, \
     hello_there_face_resign, \
     NULL, \
+    sizeof(hello_there_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // HELLO_THERE_FACE_H_
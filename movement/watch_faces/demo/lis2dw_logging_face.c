@@ -26,6 +26,7 @@
 #include <string.h>
 #include "lis2dw_logging_face.h"
 #include "lis2dw.h"
+#include "movement_sensors.h"
 #include "watch.h"
 
 // This watch face is just for testing; if we want to build accelerometer support, it will likely have to be part of Movement itself.
@@ -115,9 +116,11 @@ void lis2dw_logging_face_setup(movement_settings_t *settings, uint8_t watch_face
     (void) settings;
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(lis2dw_logger_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(lis2dw_logger_state_t));
         memset(*context_ptr, 0, sizeof(lis2dw_logger_state_t));
-        watch_enable_i2c();
+        // the wakeup interrupt set up here has to stay as it is, so the sensor registry mustn't touch the sensor.
+        movement_sensors_hold_device(MOVEMENT_SENSOR_DEVICE_LIS2DW, true);
+        watch_claim_peripheral(WATCH_PERIPHERAL_I2C);
         lis2dw_begin();
         lis2dw_set_low_power_mode(LIS2DW_LP_MODE_2); // lowest power 14-bit mode, 25 Hz is 3.5 µA @ 1.8V w/ low noise, 3µA without
         lis2dw_set_low_noise_mode(true); // consumes a little more power
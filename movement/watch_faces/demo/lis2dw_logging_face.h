@@ -69,6 +69,9 @@ bool lis2dw_logging_face_wants_background_task(movement_settings_t *settings, vo
     lis2dw_logging_face_loop, \
     lis2dw_logging_face_resign, \
     lis2dw_logging_face_wants_background_task, \
+    sizeof(lis2dw_logger_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // LIS2DW_LOGGING_FACE_H_
@@ -30,9 +30,9 @@
 static void _voltage_face_update_display(void) {
     char buf[14];
 
-    watch_enable_adc();
+    watch_claim_peripheral(WATCH_PERIPHERAL_ADC);
     float voltage = (float)watch_get_vcc_voltage() / 1000.0;
-    watch_disable_adc();
+    watch_release_peripheral(WATCH_PERIPHERAL_ADC);
 
     sprintf(buf, "BA  %4.2f V", voltage);
     // printf("%s\n", buf);
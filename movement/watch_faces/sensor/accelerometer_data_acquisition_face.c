@@ -28,12 +28,35 @@
 #include "watch_utility.h"
 #include "lis2dw.h"
 #include "spiflash.h"
+#include "movement_accelerometer.h"
+#include "movement_scratch.h"
 
 #define ACCELEROMETER_RANGE LIS2DW_RANGE_4_G
 #define ACCELEROMETER_LPMODE LIS2DW_LP_MODE_2
 #define ACCELEROMETER_FILTER LIS2DW_BANDWIDTH_FILTER_DIV2
 #define ACCELEROMETER_LOW_NOISE true
 #define SECONDS_TO_RECORD 15
+#define SAMPLES_PER_SECOND 25
+#define SAMPLES_TO_RECORD (SECONDS_TO_RECORD * SAMPLES_PER_SECOND)
+// the flash has 8192 pages; the first four hold the used-page bitmap, one bit per page, cleared once it's written.
+#define NUM_PAGES 8192
+#define PAGE_SIZE 256
+// read back every page after writing it and report mismatches. costs a 256-byte read per page.
+#ifndef ACCELEROMETER_DATA_ACQUISITION_VERIFY_WRITES
+#define ACCELEROMETER_DATA_ACQUISITION_VERIFY_WRITES 0
+#endif
+// resample to exactly SAMPLES_PER_SECOND by the RTC before storing, rather than storing what the sensor's clock gave us
+// and leaving the decoder to scale the counters by the measured rate.
+#ifndef ACCELEROMETER_DATA_ACQUISITION_RESAMPLE
+#define ACCELEROMETER_DATA_ACQUISITION_RESAMPLE 0
+#endif
+// samples per 1000 seconds that we'd get if the sensor's clock were perfect.
+#define NOMINAL_RATE (SAMPLES_PER_SECOND * 1000UL)
+// how much RTC time a rate measurement has to span: the watermark interrupt's timing wobbles by a tick or two.
+#define RATE_WINDOW_TICKS (2 * WATCH_MONOTONIC_TICKS_PER_SECOND)
+// tags the free-page cursor in its backup register, so that a value left by other firmware isn't mistaken for one.
+#define CURSOR_TAG 0xAD000000
+#define CURSOR_TAG_MASK 0xFFFF0000
 
 static const char activity_types[][3] = {
     "TE",   // Testing
@@ -56,46 +79,53 @@ static const char activity_types[][3] = {
 static void update(accelerometer_data_acquisition_state_t *state);
 static void update_settings(accelerometer_data_acquisition_state_t *state);
 static void advance_current_setting(accelerometer_data_acquisition_state_t *state);
-static void start_reading(accelerometer_data_acquisition_state_t *state, movement_settings_t *settings);
-static void continue_reading(accelerometer_data_acquisition_state_t *state);
+static bool start_reading(accelerometer_data_acquisition_state_t *state, movement_settings_t *settings);
+static void consume_batch(const movement_accelerometer_batch_t *batch, void *context);
 static void finish_reading(accelerometer_data_acquisition_state_t *state);
-static bool wait_for_flash_ready(void);
 static int16_t get_next_available_page(void);
+static int16_t load_cursor(accelerometer_data_acquisition_state_t *state);
+static void save_cursor(accelerometer_data_acquisition_state_t *state);
 static void write_buffer_to_page(uint8_t *buf, uint16_t page);
 static void write_page(accelerometer_data_acquisition_state_t *state);
-static void log_data_point(accelerometer_data_acquisition_state_t *state, lis2dw_reading_t reading, uint8_t centiseconds);
+static void log_data_point(accelerometer_data_acquisition_state_t *state, lis2dw_reading_t reading, uint16_t centiseconds);
+static void measure_rate(accelerometer_data_acquisition_state_t *state, const movement_accelerometer_batch_t *batch);
+#if ACCELEROMETER_DATA_ACQUISITION_RESAMPLE
+static void resample(accelerometer_data_acquisition_state_t *state, lis2dw_reading_t reading, uint32_t index);
+#endif
 
 void accelerometer_data_acquisition_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
     (void) settings;
     (void) watch_face_index;
     accelerometer_data_acquisition_state_t *state = (accelerometer_data_acquisition_state_t *)*context_ptr;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(accelerometer_data_acquisition_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(accelerometer_data_acquisition_state_t));
         memset(*context_ptr, 0, sizeof(accelerometer_data_acquisition_state_t));
         state = (accelerometer_data_acquisition_state_t *)*context_ptr;
         state->beep_with_countdown = true;
         state->countdown_length = 3;
+        state->next_available_page = -1;
+        state->backup_register = movement_claim_backup_register();
+        state->measured_rate = NOMINAL_RATE;
     }
     spi_flash_init();
-    wait_for_flash_ready();
-    uint8_t buf[256] = {0xFF};
-    spi_flash_read_data(0, buf, 256);
-    if (buf[0] & 0xF0) {
-        // mark first four pages as used
-        buf[0] = 0x0F;
-        wait_for_flash_ready();
-        watch_set_pin_level(A3, false);
-        spi_flash_command(CMD_ENABLE_WRITE);
-        wait_for_flash_ready();
-        spi_flash_write_data(0, buf, 256);
+    spi_flash_wait_until_ready();
+    uint8_t used_byte = 0xFF;
+    spi_flash_read_data(0, &used_byte, 1);
+    if (used_byte & 0xF0) {
+        // mark first four pages as used. programming can only clear bits, so writing the one byte is enough.
+        used_byte = 0x0F;
+        spi_flash_program(0, &used_byte, 1);
     }
-
 }
 
 void accelerometer_data_acquisition_face_activate(movement_settings_t *settings, void *context) {
     (void) settings;
     accelerometer_data_acquisition_state_t *state = (accelerometer_data_acquisition_state_t *)context;
-    state->next_available_page = get_next_available_page();
+    // the cursor lives in RAM from here on, and only this face writes to the chip.
+    if (!state->cursor_valid) {
+        state->next_available_page = load_cursor(state);
+        state->cursor_valid = true;
+    }
 }
 
 bool accelerometer_data_acquisition_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
@@ -124,14 +154,18 @@ bool accelerometer_data_acquisition_face_loop(movement_event_t event, movement_s
                     }
                     if (state->countdown_ticks > 0) {
                         state->countdown_ticks--;
-                        printf("countdown: %d\n", state->countdown_ticks);
+                        WATCH_LOG_DEBUG("countdown: %d", state->countdown_ticks);
                         if (state->countdown_ticks == 0) {
                             // at zero, begin reading
                             state->mode = ACCELEROMETER_DATA_ACQUISITION_MODE_SENSING;
-                            state->reading_ticks = SECONDS_TO_RECORD + 1;
+                            // samples arrive on the accelerometer's clock; this is just a deadline in case they stop.
+                            state->reading_ticks = SECONDS_TO_RECORD + 2;
                             // also beep if the user asked for it
                             if (state->beep_with_countdown) watch_buzzer_play_note(BUZZER_NOTE_C6, 75);
-                            start_reading(state, settings);
+                            if (!start_reading(state, settings)) {
+                                state->reading_ticks = 0;
+                                state->mode = ACCELEROMETER_DATA_ACQUISITION_MODE_IDLE;
+                            }
                         } else if (state->countdown_ticks < 3) {
                             // beep for last two ticks before reading
                             if (state->beep_with_countdown) watch_buzzer_play_note(BUZZER_NOTE_C5, 75);
@@ -142,9 +176,8 @@ bool accelerometer_data_acquisition_face_loop(movement_event_t event, movement_s
                 case ACCELEROMETER_DATA_ACQUISITION_MODE_SENSING:
                     if (state->reading_ticks > 0) {
                         state->reading_ticks--;
-                        if (state->reading_ticks > 0) {
-                            continue_reading(state);
-                        } else {
+                        if (state->samples_logged >= SAMPLES_TO_RECORD || state->reading_ticks == 0) {
+                            state->reading_ticks = 0;
                             finish_reading(state);
                             state->mode = ACCELEROMETER_DATA_ACQUISITION_MODE_IDLE;
                             watch_buzzer_play_note(BUZZER_NOTE_C4, 125);
@@ -183,13 +216,13 @@ bool accelerometer_data_acquisition_face_loop(movement_event_t event, movement_s
             movement_illuminate_led();
             break;
         case EVENT_ALARM_BUTTON_UP:
-            printf("Alarm up! Mode is %d\n", state->mode);
+            WATCH_LOG_DEBUG("Alarm up! Mode is %d", state->mode);
             switch (state->mode) {
                 case ACCELEROMETER_DATA_ACQUISITION_MODE_IDLE:
                     state->countdown_ticks = state->countdown_length;
-                    printf("Setting countdown ticks to %d\n", state->countdown_ticks);
+                    WATCH_LOG_DEBUG("Setting countdown ticks to %d", state->countdown_ticks);
                     state->mode = ACCELEROMETER_DATA_ACQUISITION_MODE_COUNTDOWN;
-                    printf("and mode to %d\n", state->mode);
+                    WATCH_LOG_DEBUG("and mode to %d", state->mode);
                     update(state);
                     break;
                 case ACCELEROMETER_DATA_ACQUISITION_MODE_COUNTDOWN:
@@ -207,7 +240,7 @@ bool accelerometer_data_acquisition_face_loop(movement_event_t event, movement_s
             }
             break;
         case EVENT_ALARM_LONG_PRESS:
-            printf("Alarm long\n");
+            WATCH_LOG_DEBUG("Alarm long");
             if (state->mode == ACCELEROMETER_DATA_ACQUISITION_MODE_IDLE) {
                 state->repeat_ticks = 0;
                 state->mode = ACCELEROMETER_DATA_ACQUISITION_MODE_SETTINGS;
@@ -330,13 +363,14 @@ static void advance_current_setting(accelerometer_data_acquisition_state_t *stat
 }
 
 static int16_t get_next_available_page(void) {
-    uint8_t buf[256] = {0};
+    uint8_t *buf = movement_scratch_borrow(PAGE_SIZE);
+    if (buf == NULL) return -1;
 
     uint16_t page = 0;
     for(int16_t i = 0; i < 4; i++) {
-        wait_for_flash_ready();
-        spi_flash_read_data(i * 256, buf, 256);
-        for(int16_t j = 0; j < 256; j++) {
+        spi_flash_wait_until_ready();
+        spi_flash_read_data(i * PAGE_SIZE, buf, PAGE_SIZE);
+        for(int16_t j = 0; j < PAGE_SIZE; j++) {
             if(buf[j] == 0) {
                 page += 8;
             } else {
@@ -345,137 +379,277 @@ static int16_t get_next_available_page(void) {
             }
         }
     }
+    movement_scratch_release(buf);
 
-    if (page >= 8192) return -1;
+    if (page >= NUM_PAGES) return -1;
 
     return page;
 }
 
-static void write_buffer_to_page(uint8_t *buf, uint16_t page) {
-    uint32_t address = 256 * page;
-
-    wait_for_flash_ready();
-    watch_set_pin_level(A3, false);
-    spi_flash_command(CMD_ENABLE_WRITE);
-    wait_for_flash_ready();
-    watch_set_pin_level(A3, false);
-    spi_flash_write_data(address, buf, 256);
-    wait_for_flash_ready();
-
-    uint8_t buf2[256];
-    watch_set_pin_level(A3, false);
-    spi_flash_read_data(address, buf2, 256);
-    wait_for_flash_ready();
-
-    uint8_t used_pages[256] = {0xFF};
-    uint16_t address_to_mark_used = page / 8;
-    uint8_t header_page = address_to_mark_used / 256;
-    uint8_t used_byte = 0x7F >> (page % 8);
-    uint8_t offset_in_buf = address_to_mark_used % 256;
+static bool page_is_used(uint16_t page) {
+    uint8_t used_byte = 0xFF;
+    spi_flash_wait_until_ready();
+    spi_flash_read_data(page / 8, &used_byte, 1);
+    return !(used_byte & (0x80 >> (page % 8)));
+}
 
-    printf("\twrite 256 bytes to address %ld, page %d.\n", address, page);
-    for(int i = 0; i < 256; i++) {
-        if (buf[i] != buf2[i]) {
-            printf("\tData mismatch detected at offset  %d: %d != %d.\n", i, buf[i], buf2[i]);
+static int16_t load_cursor(accelerometer_data_acquisition_state_t *state) {
+    if (state->backup_register) {
+        uint32_t data = watch_get_backup_data(state->backup_register);
+        if ((data & CURSOR_TAG_MASK) == CURSOR_TAG) {
+            int16_t page = (int16_t)(data & ~CURSOR_TAG_MASK);
+            // the backup register outlives a firmware update, and the chip may have been erased or written since,
+            // so check the two bitmap bits around the cursor: two one-byte reads instead of a kilobyte.
+            if (page < 0 && page_is_used(NUM_PAGES - 1)) return -1;
+            if (page > 0 && page < NUM_PAGES && page_is_used(page - 1) && !page_is_used(page)) return page;
         }
     }
 
-    watch_set_pin_level(A3, false);
-    spi_flash_read_data(header_page * 256, used_pages, 256);
-    used_pages[offset_in_buf] = used_byte;
-    watch_set_pin_level(A3, false);
-    spi_flash_command(CMD_ENABLE_WRITE);
-    wait_for_flash_ready();
-    watch_set_pin_level(A3, false);
-    spi_flash_write_data(header_page * 256, used_pages, 256);
-    wait_for_flash_ready();
+    int16_t page = get_next_available_page();
+    state->next_available_page = page;
+    save_cursor(state);
+
+    return page;
 }
 
-static bool wait_for_flash_ready(void) {
-    watch_set_pin_level(A3, false);
-    bool ok = true;
-    uint8_t read_status_response[1] = {0x00};
-    do {
-        ok = spi_flash_read_command(CMD_READ_STATUS, read_status_response, 1);
-    } while ((read_status_response[0] & 0x3) != 0);
-    delay_ms(1); // why do i need this?
-    watch_set_pin_level(A3, true);
-    return ok;
+static void save_cursor(accelerometer_data_acquisition_state_t *state) {
+    if (state->backup_register) watch_store_backup_data(CURSOR_TAG | (uint16_t)state->next_available_page, state->backup_register);
+}
+
+static void write_buffer_to_page(uint8_t *buf, uint16_t page) {
+    uint32_t address = PAGE_SIZE * page;
+
+    spi_flash_program(address, buf, PAGE_SIZE);
+
+    WATCH_LOG_DEBUG("write 256 bytes to address %lu, page %u.", address, page);
+#if ACCELEROMETER_DATA_ACQUISITION_VERIFY_WRITES
+    uint8_t *buf2 = movement_scratch_borrow(PAGE_SIZE);
+    if (buf2 != NULL) {
+        spi_flash_read_data(address, buf2, PAGE_SIZE);
+        for(int i = 0; i < PAGE_SIZE; i++) {
+            if (buf[i] != buf2[i]) {
+                WATCH_LOG_ERROR("Data mismatch detected at offset %d: %d != %d.", i, buf[i], buf2[i]);
+            }
+        }
+        movement_scratch_release(buf2);
+    }
+#endif
+
+    // mark the page used in the bitmap. pages fill in order, so this clears its bit and the ones before it in the
+    // same byte (which are already clear); since programming only clears bits, we can write just that byte.
+    uint8_t used_byte = 0x7F >> (page % 8);
+    spi_flash_program(page / 8, &used_byte, 1);
+}
+
+static accelerometer_data_acquisition_page_header_t *page_header(accelerometer_data_acquisition_state_t *state) {
+    return (accelerometer_data_acquisition_page_header_t *)state->page;
+}
+
+static void begin_page(accelerometer_data_acquisition_state_t *state, bool session_start) {
+    memset(state->page, 0xFF, PAGE_SIZE);
+
+    accelerometer_data_acquisition_page_header_t *header = page_header(state);
+    header->magic[0] = ACCELEROMETER_DATA_ACQUISITION_V2_MAGIC_0;
+    header->magic[1] = ACCELEROMETER_DATA_ACQUISITION_V2_MAGIC_1;
+    header->magic[2] = ACCELEROMETER_DATA_ACQUISITION_V2_MAGIC_2;
+    header->flags = ACCELEROMETER_RANGE | (ACCELEROMETER_LPMODE << 2) | (ACCELEROMETER_FILTER << 4);
+    header->count = 0;
+    header->period = 100 / SAMPLES_PER_SECOND;
+    uint16_t pos = sizeof(accelerometer_data_acquisition_page_header_t);
+
+    if (session_start) {
+        header->flags |= ACCELEROMETER_DATA_ACQUISITION_V2_FLAG_SESSION_START;
+        accelerometer_data_acquisition_session_header_t session;
+        session.timestamp = state->starting_timestamp;
+        session.activity[0] = activity_types[state->activity_type_index][0];
+        session.activity[1] = activity_types[state->activity_type_index][1];
+        session.temperature = state->temperature;
+        memcpy(state->page + pos, &session, sizeof(session));
+        pos += sizeof(session);
+        // filled in when the page is written, by which time the rate has been measured over a few seconds.
+        header->flags |= ACCELEROMETER_DATA_ACQUISITION_V2_FLAG_RATE;
+        pos += sizeof(accelerometer_data_acquisition_rate_header_t);
+    }
+
+    state->nibble_pos = pos * 2;
 }
 
 static void write_page(accelerometer_data_acquisition_state_t *state) {
+    accelerometer_data_acquisition_page_header_t *header = page_header(state);
+    if (header->flags & ACCELEROMETER_DATA_ACQUISITION_V2_FLAG_RATE) {
+        accelerometer_data_acquisition_rate_header_t rate;
+        rate.measured_rate = state->measured_rate;
+        rate.resampled = ACCELEROMETER_DATA_ACQUISITION_RESAMPLE;
+        memcpy(state->page + sizeof(accelerometer_data_acquisition_page_header_t) + sizeof(accelerometer_data_acquisition_session_header_t),
+               &rate, sizeof(rate));
+    }
     if (state->next_available_page > 0) {
-        write_buffer_to_page((uint8_t *)(state->records), state->next_available_page);
-        wait_for_flash_ready();
+        write_buffer_to_page(state->page, state->next_available_page);
         state->next_available_page++;
+        if (state->next_available_page >= NUM_PAGES) state->next_available_page = -1;
+        save_cursor(state);
     }
-    state->pos = 0;
-    memset(state->records, 0xFF, sizeof(state->records));
+    begin_page(state, false);
 }
 
-static void log_data_point(accelerometer_data_acquisition_state_t *state, lis2dw_reading_t reading, uint8_t centiseconds) {
-    accelerometer_data_acquisition_record_t record;
-    record.data.x.record_type = ACCELEROMETER_DATA_ACQUISITION_DATA;
-    record.data.y.lpmode = ACCELEROMETER_LPMODE;
-    record.data.z.filter = ACCELEROMETER_FILTER;
-    record.data.x.accel = (reading.x >> 2) + 8192;
-    record.data.y.accel = (reading.y >> 2) + 8192;
-    record.data.z.accel = (reading.z >> 2) + 8192;
-    record.data.counter = 100 * (SECONDS_TO_RECORD - state->reading_ticks + 1) + centiseconds;
-    printf("logged data point for %d\n", record.data.counter);
-    state->records[state->pos++] = record;
-    if (state->pos >= 32) {
+static void put_nibble(accelerometer_data_acquisition_state_t *state, uint8_t nibble) {
+    uint8_t *byte = &state->page[state->nibble_pos / 2];
+    if (state->nibble_pos % 2) *byte = (*byte & 0xF0) | nibble;
+    else *byte = (*byte & 0x0F) | (nibble << 4);
+    state->nibble_pos++;
+}
+
+static uint16_t zigzag(int16_t delta) {
+    return ((uint16_t)delta << 1) ^ (uint16_t)(delta >> 15);
+}
+
+static uint8_t varint_nibbles(uint16_t value) {
+    uint8_t nibbles = 1;
+    while (value >>= 3) nibbles++;
+    return nibbles;
+}
+
+static void put_varint(accelerometer_data_acquisition_state_t *state, uint16_t value) {
+    while (value > 7) {
+        put_nibble(state, 0x8 | (value & 0x7));
+        value >>= 3;
+    }
+    put_nibble(state, value);
+}
+
+static void log_data_point(accelerometer_data_acquisition_state_t *state, lis2dw_reading_t reading, uint16_t centiseconds) {
+    accelerometer_data_acquisition_page_header_t *header = page_header(state);
+    int16_t sample[3] = { reading.x >> 2, reading.y >> 2, reading.z >> 2 };
+
+    if (header->count) {
+        uint16_t deltas[3];
+        uint16_t nibbles = 0;
+        for (uint8_t i = 0; i < 3; i++) {
+            // 14-bit values, so the difference always fits in 15 bits.
+            deltas[i] = zigzag(sample[i] - state->last_sample[i]);
+            nibbles += varint_nibbles(deltas[i]);
+        }
+        if (centiseconds == state->next_counter && state->nibble_pos + nibbles <= PAGE_SIZE * 2 && header->count < 255) {
+            for (uint8_t i = 0; i < 3; i++) put_varint(state, deltas[i]);
+            header->count++;
+            state->next_counter += header->period;
+            memcpy(state->last_sample, sample, sizeof(sample));
+            return;
+        }
+        // out of room, or there's a gap: this sample starts the next page.
         write_page(state);
     }
+
+    // the first sample on a page is stored whole. the byte position is always even here.
+    header->counter = centiseconds;
+    memcpy(state->page + state->nibble_pos / 2, sample, sizeof(sample));
+    state->nibble_pos += sizeof(sample) * 2;
+    header->count = 1;
+    state->next_counter = centiseconds + header->period;
+    memcpy(state->last_sample, sample, sizeof(sample));
 }
 
-static void start_reading(accelerometer_data_acquisition_state_t *state, movement_settings_t *settings) {
-    printf("Start reading\n");
-    watch_enable_i2c();
-    lis2dw_begin();
-    lis2dw_set_data_rate(LIS2DW_DATA_RATE_25_HZ);
+static bool start_reading(accelerometer_data_acquisition_state_t *state, movement_settings_t *settings) {
+    (void) settings;
+    WATCH_LOG_INFO("Start reading");
+    // the page only exists while there's a recording to fill it.
+    state->page = malloc(PAGE_SIZE);
+    if (state->page == NULL) {
+        WATCH_LOG_ERROR("No room for a page");
+        return false;
+    }
+    state->samples_logged = 0;
+    state->reference_ticks = 0;
+    state->resample_step = ((uint64_t)state->measured_rate << 16) / NOMINAL_RATE;
+    state->resample_next = 0;
+    state->last_input = UINT32_MAX;
+    movement_accelerometer_subscribe(LIS2DW_DATA_RATE_25_HZ, consume_batch, state);
     lis2dw_set_range(ACCELEROMETER_RANGE);
     lis2dw_set_low_power_mode(ACCELEROMETER_LPMODE);
     lis2dw_set_bandwidth_filtering(ACCELEROMETER_FILTER);
     if (ACCELEROMETER_LOW_NOISE) lis2dw_set_low_noise_mode(true);
-    lis2dw_enable_fifo();
 
-    accelerometer_data_acquisition_record_t record;
     watch_date_time date_time = watch_rtc_get_date_time();
-    state->starting_timestamp = watch_utility_date_time_to_unix_time(date_time, movement_timezone_offsets[settings->bit.time_zone] * 60);
-    record.header.info.record_type = ACCELEROMETER_DATA_ACQUISITION_HEADER;
-    record.header.info.range = ACCELEROMETER_RANGE;
-    record.header.info.temperature = lis2dw_get_temperature();
-    record.header.char1 = activity_types[state->activity_type_index][0];
-    record.header.char2 = activity_types[state->activity_type_index][1];
-    record.header.timestamp = state->starting_timestamp;
-
-    state->records[state->pos++] = record;
-    lis2dw_fifo_t fifo;
-    lis2dw_read_fifo(&fifo); // dump the fifo, this starts a fresh round of data in continue_reading
+    state->starting_timestamp = watch_utility_date_time_to_unix_time(date_time, movement_get_current_timezone_offset() * 60);
+    state->temperature = lis2dw_get_temperature() & 0xFFF;
+    begin_page(state, true);
+
+    return true;
 }
 
-static void continue_reading(accelerometer_data_acquisition_state_t *state) {
-    printf("Continue reading\n");
-    lis2dw_fifo_t fifo;
-    lis2dw_read_fifo(&fifo);
+static void consume_batch(const movement_accelerometer_batch_t *batch, void *context) {
+    accelerometer_data_acquisition_state_t *state = (accelerometer_data_acquisition_state_t *)context;
+    WATCH_LOG_INFO("Continue reading");
+
+    // batches come once per watermark, straight off the sensor's clock, so each sample's time is its index divided
+    // by the sensor's rate. that's SAMPLES_PER_SECOND give or take its clock's error, which measure_rate finds.
+    if (state->samples_logged == 0) state->first_sample = batch->first_sample;
+    measure_rate(state, batch);
+    for(uint8_t i = 0; i < batch->count && state->samples_logged < SAMPLES_TO_RECORD; i++) {
+        uint32_t index = batch->first_sample + i - state->first_sample;
+#if ACCELEROMETER_DATA_ACQUISITION_RESAMPLE
+        resample(state, batch->readings[i], index);
+#else
+        log_data_point(state, batch->readings[i], index * (100 / SAMPLES_PER_SECOND));
+        state->samples_logged++;
+#endif
+    }
+}
 
-    fifo.count = min(fifo.count, 25); // hacky, but we need a consistent data rate; if we got a 26th data point, chuck it.
-    uint8_t offset = 4 * (25 - fifo.count); // also hacky: we're sometimes short at the start. align to beginning of next second.
-    // TODO: use the threshold interrupt for this, will mean we get consistent 25 Hz data as the accelerometer sees it.
+static void measure_rate(accelerometer_data_acquisition_state_t *state, const movement_accelerometer_batch_t *batch) {
+    // samples lost to an overrun aren't counted, so start measuring again from after it.
+    if (batch->overrun) state->reference_ticks = 0;
+    // a batch with a monotonic count is one whose last sample we know the RTC time of.
+    if (batch->ticks == 0) return;
+    uint32_t sample = batch->first_sample + batch->count - 1 - state->first_sample;
+    if (state->reference_ticks == 0) {
+        state->reference_ticks = batch->ticks;
+        state->reference_sample = sample;
+        return;
+    }
+    uint32_t elapsed = batch->ticks - state->reference_ticks;
+    if (elapsed < RATE_WINDOW_TICKS) return;
+    // the reference stays put, so the estimate sharpens as the recording goes on.
+    state->measured_rate = (uint64_t)(sample - state->reference_sample) * WATCH_MONOTONIC_TICKS_PER_SECOND * 1000 / elapsed;
+    state->resample_step = ((uint64_t)state->measured_rate << 16) / NOMINAL_RATE;
+}
 
-    for(int i = 0; i < fifo.count; i++) {
-        log_data_point(state, fifo.readings[i], i * 4 + offset);
+#if ACCELEROMETER_DATA_ACQUISITION_RESAMPLE
+static void resample(accelerometer_data_acquisition_state_t *state, lis2dw_reading_t reading, uint32_t index) {
+    uint32_t position = index << 16;
+    if (state->last_input == UINT32_MAX || index != state->last_input + 1) {
+        // the first sample, or the first after the FIFO overran: there's nothing to interpolate from, so drop the
+        // outputs that fell in the gap, and start again from this sample.
+        while (state->resample_next < position) {
+            state->resample_next += state->resample_step;
+            state->samples_logged++;
+        }
+        state->last_reading = reading;
+    }
+    // each output falls between the last input and this one; weight them by how far back from this one it falls.
+    while (state->resample_next <= position && state->samples_logged < SAMPLES_TO_RECORD) {
+        int32_t back = position - state->resample_next;
+        lis2dw_reading_t output;
+        output.x = reading.x - (((int64_t)(reading.x - state->last_reading.x) * back) >> 16);
+        output.y = reading.y - (((int64_t)(reading.y - state->last_reading.y) * back) >> 16);
+        output.z = reading.z - (((int64_t)(reading.z - state->last_reading.z) * back) >> 16);
+        log_data_point(state, output, state->samples_logged * (100 / SAMPLES_PER_SECOND));
+        state->samples_logged++;
+        state->resample_next += state->resample_step;
     }
+    state->last_reading = reading;
+    state->last_input = index;
 }
+#endif
 
 static void finish_reading(accelerometer_data_acquisition_state_t *state) {
-    printf("Finish reading\n");
-    if (state->pos != 0) {
+    WATCH_LOG_INFO("Finish reading");
+    if (page_header(state)->count != 0) {
         write_page(state);
     }
-    lis2dw_set_data_rate(LIS2DW_DATA_RATE_POWERDOWN);
-    watch_disable_i2c();
+    movement_accelerometer_unsubscribe(consume_batch, state);
+    free(state->page);
+    state->page = NULL;
 
     state->repeat_ticks = state->repeat_interval;
 }
@@ -32,6 +32,7 @@
  */
 
 #include "movement.h"
+#include "lis2dw.h"
 
 #define ACCELEROMETER_DATA_ACQUISITION_INVALID ((uint64_t)(0b11))   // all bits are 1 when the flash is erased
 #define ACCELEROMETER_DATA_ACQUISITION_HEADER ((uint64_t)(0b10))
@@ -67,6 +68,56 @@ typedef union {
     uint64_t value;
 } accelerometer_data_acquisition_record_t;
 
+/*
+ * Version 2 page format. Version 1 (above) spends 64 bits on every sample.
+ * Version 2 pages instead start with a page header, then a session header
+ * if the page begins a recording, and then the first sample's three axes as
+ * 14-bit values in int16_t. Every later sample is stored as the difference
+ * from the one before it. Each axis delta is zig-zag encoded
+ * (0, -1, 1, -2... become 0, 1, 2, 3...) and then written as a varint of
+ * 4-bit nibbles, high nibble of each byte first. Each nibble holds three
+ * bits of value, least significant first, plus a continuation bit (0x8).
+ * A wrist at rest moves a few counts per sample, so most samples take 1.5
+ * bytes instead of 8.
+ *
+ * Samples on a page are evenly spaced, so a gap in the data (i.e. a FIFO
+ * overrun) starts a new page. Unused bytes stay erased (0xFF). The first
+ * byte's low bits read as a deleted record to a version 1 reader.
+ *
+ * The sensor's clock isn't the RTC's, and can be a percent or so off, so a
+ * session header may be followed by a rate header, flagged in bit 7: the
+ * rate the samples really came at, measured against the RTC. If the samples
+ * were resampled to the nominal rate before they were stored, the counters
+ * are already right; if not, scale them by nominal rate / measured rate.
+ * utils/motion_express_utilities/motion_v2.py decodes these pages, and
+ * motion_decode.py there decodes a whole log at once with NumPy.
+ */
+#define ACCELEROMETER_DATA_ACQUISITION_V2_MAGIC_0 0xFC
+#define ACCELEROMETER_DATA_ACQUISITION_V2_MAGIC_1 'V'
+#define ACCELEROMETER_DATA_ACQUISITION_V2_MAGIC_2 '2'
+
+#define ACCELEROMETER_DATA_ACQUISITION_V2_FLAG_SESSION_START (1 << 6)
+#define ACCELEROMETER_DATA_ACQUISITION_V2_FLAG_RATE (1 << 7)
+
+typedef struct __attribute__((packed)) {
+    uint8_t magic[3];               // ACCELEROMETER_DATA_ACQUISITION_V2_MAGIC_*
+    uint8_t flags;                  // range (bits 0-1), low power mode (2-3), filter (4-5), session start (6), rate (7)
+    uint8_t count;                  // number of samples on this page
+    uint8_t period;                 // centiseconds between samples
+    uint16_t counter;               // centiseconds from the session's timestamp to the first sample on this page
+} accelerometer_data_acquisition_page_header_t;
+
+typedef struct __attribute__((packed)) {
+    uint32_t timestamp;             // UNIX timestamp for the start of the recording
+    char activity[2];               // activity type, as in the version 1 header
+    uint16_t temperature;           // raw value from the temperature sensor
+} accelerometer_data_acquisition_session_header_t;
+
+typedef struct __attribute__((packed)) {
+    uint32_t measured_rate;         // samples per 1000 seconds of RTC time, as the sensor delivered them
+    uint8_t resampled;              // 1 if the samples were resampled to exactly 100 / period per second
+} accelerometer_data_acquisition_rate_header_t;
+
 typedef enum {
     ACCELEROMETER_DATA_ACQUISITION_MODE_IDLE,
     ACCELEROMETER_DATA_ACQUISITION_MODE_COUNTDOWN,
@@ -92,13 +143,30 @@ typedef struct {
     uint16_t repeat_interval;   // how many seconds to wait for a repeat
     // info about the flash chip
     int16_t next_available_page;
+    bool cursor_valid;              // next_available_page is up to date, and there's no need to scan for it
+    uint8_t backup_register;        // where the cursor is kept across a reset, or 0 if none was free
     // transient properties
     uint8_t countdown_ticks;
     uint8_t repeat_ticks;
     uint8_t reading_ticks;
+    uint16_t samples_logged;
+    uint32_t first_sample;          // the accelerometer engine's index for this recording's first sample
     uint32_t starting_timestamp;
-    accelerometer_data_acquisition_record_t records[32];
-    uint16_t pos;
+    uint16_t temperature;
+    // the page being filled, on the heap for the length of a recording
+    uint8_t *page;
+    uint16_t nibble_pos;            // next free nibble, counted from the start of the page
+    int16_t last_sample[3];         // the previous sample's axes, as 14-bit values
+    uint16_t next_counter;          // counter the next sample on this page would have
+    // the sensor's rate against the RTC's
+    uint32_t measured_rate;         // samples per 1000 seconds; kept from one recording to the next
+    uint32_t reference_ticks;       // monotonic count at this recording's first timed sample, or 0 if none yet
+    uint32_t reference_sample;      // that sample's index, counted from first_sample
+    // resampling, with positions in samples counted from first_sample, in 16.16 fixed point
+    uint32_t resample_step;         // input samples per output sample
+    uint32_t resample_next;         // where the next output sample falls
+    uint32_t last_input;            // index of the last input sample, or UINT32_MAX before the first
+    lis2dw_reading_t last_reading;
 } accelerometer_data_acquisition_state_t;
 
 void accelerometer_data_acquisition_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
@@ -112,6 +180,9 @@ void accelerometer_data_acquisition_face_resign(movement_settings_t *settings, v
     accelerometer_data_acquisition_face_loop, \
     accelerometer_data_acquisition_face_resign, \
     NULL, \
+    sizeof(accelerometer_data_acquisition_state_t), \
+    MOVEMENT_FACE_EAGER_SETUP, \
+    NULL, \
 })
 
 #endif // ACCELEROMETER_DATA_ACQUISITION_FACE_H_
@@ -0,0 +1,164 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include "light_uplink_face.h"
+#include "movement_optical_rx.h"
+#include "filesystem.h"
+#include "watch.h"
+
+// the file is written here as it comes in, and only takes its real name once all of it has.
+#define LIGHT_UPLINK_TEMP_FILE "uplink.tmp"
+
+static void _light_uplink_face_update_display(light_uplink_state_t *state) {
+    char buf[11];
+    switch (state->status) {
+        case LIGHT_UPLINK_IDLE:
+            watch_display_string("LU        ", 0);
+            break;
+        case LIGHT_UPLINK_WAITING:
+            watch_display_string("LU  rEAdY ", 0);
+            break;
+        case LIGHT_UPLINK_RECEIVING:
+            sprintf(buf, "LU  %6lu", (unsigned long)(state->bytes % 1000000));
+            watch_display_string(buf, 0);
+            break;
+        case LIGHT_UPLINK_DONE:
+            watch_display_string("LU  donE  ", 0);
+            break;
+        case LIGHT_UPLINK_LOST:
+            watch_display_string("LU  LoSt  ", 0);
+            break;
+        case LIGHT_UPLINK_ERROR:
+            watch_display_string("LU  Err   ", 0);
+            break;
+    }
+    if (movement_optical_rx_is_receiving()) watch_set_indicator(WATCH_INDICATOR_SIGNAL);
+    else watch_clear_indicator(WATCH_INDICATOR_SIGNAL);
+}
+
+static uint32_t _light_uplink_face_get_le32(const uint8_t *p) {
+    return p[0] | ((uint32_t) p[1] << 8) | ((uint32_t) p[2] << 16) | ((uint32_t) p[3] << 24);
+}
+
+static void _light_uplink_face_on_frame(const optical_rx_frame_t *frame, void *context) {
+    light_uplink_state_t *state = (light_uplink_state_t *)context;
+    switch (frame->type) {
+        case LIGHT_UPLINK_FRAME_BEGIN:
+            // a file starts, or starts again; whatever came in of it before goes.
+            if (frame->length == 0 || frame->length > LIGHT_UPLINK_NAME_MAX) return;
+            memcpy(state->filename, frame->payload, frame->length);
+            state->filename[frame->length] = 0;
+            state->sequence = 0;
+            state->bytes = 0;
+            state->status = filesystem_write_file(LIGHT_UPLINK_TEMP_FILE, "", 0) ? LIGHT_UPLINK_RECEIVING : LIGHT_UPLINK_ERROR;
+            break;
+        case LIGHT_UPLINK_FRAME_DATA:
+            if (state->status != LIGHT_UPLINK_RECEIVING || frame->length == 0) return;
+            if (frame->payload[0] != state->sequence) {
+                state->status = LIGHT_UPLINK_LOST;
+                break;
+            }
+            if (!filesystem_append_file(LIGHT_UPLINK_TEMP_FILE, (char *)frame->payload + 1, frame->length - 1)) {
+                state->status = LIGHT_UPLINK_ERROR;
+                break;
+            }
+            state->sequence++;
+            state->bytes += frame->length - 1;
+            break;
+        case LIGHT_UPLINK_FRAME_END:
+            if (state->status != LIGHT_UPLINK_RECEIVING || frame->length != 4) return;
+            if (_light_uplink_face_get_le32(frame->payload) != state->bytes) {
+                state->status = LIGHT_UPLINK_LOST;
+                break;
+            }
+            if (filesystem_file_exists(state->filename)) filesystem_rm(state->filename);
+            if (!filesystem_rename(LIGHT_UPLINK_TEMP_FILE, state->filename)) {
+                state->status = LIGHT_UPLINK_ERROR;
+                break;
+            }
+            // that's the file; no need to keep listening.
+            state->status = LIGHT_UPLINK_DONE;
+            movement_optical_rx_stop();
+            break;
+        default:
+            return;
+    }
+    _light_uplink_face_update_display(state);
+}
+
+static void _light_uplink_face_stop(light_uplink_state_t *state) {
+    movement_optical_rx_stop();
+    if (state->status == LIGHT_UPLINK_RECEIVING) filesystem_rm(LIGHT_UPLINK_TEMP_FILE);
+    if (state->status == LIGHT_UPLINK_WAITING || state->status == LIGHT_UPLINK_RECEIVING || state->status == LIGHT_UPLINK_LOST) {
+        state->status = LIGHT_UPLINK_IDLE;
+    }
+}
+
+void light_uplink_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
+    (void) settings;
+    if (*context_ptr == NULL) {
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(light_uplink_state_t));
+        memset(*context_ptr, 0, sizeof(light_uplink_state_t));
+    }
+}
+
+void light_uplink_face_activate(movement_settings_t *settings, void *context) {
+    (void) settings;
+    light_uplink_state_t *state = (light_uplink_state_t *)context;
+    state->status = LIGHT_UPLINK_IDLE;
+}
+
+bool light_uplink_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
+    light_uplink_state_t *state = (light_uplink_state_t *)context;
+    switch (event.event_type) {
+        case EVENT_ACTIVATE:
+            _light_uplink_face_update_display(state);
+            break;
+        case EVENT_ALARM_BUTTON_UP:
+            if (movement_optical_rx_is_receiving()) {
+                _light_uplink_face_stop(state);
+            } else if (movement_optical_rx_start(LIGHT_UPLINK_SENSE_PIN, LIGHT_UPLINK_SAMPLES_PER_BIT, _light_uplink_face_on_frame, state)) {
+                state->status = LIGHT_UPLINK_WAITING;
+            } else {
+                state->status = LIGHT_UPLINK_ERROR;
+            }
+            _light_uplink_face_update_display(state);
+            break;
+        case EVENT_TIMEOUT:
+            // stay put while a file is coming in.
+            if (!movement_optical_rx_is_receiving()) movement_move_to_face(0);
+            break;
+        default:
+            return movement_default_loop_handler(event, settings);
+    }
+
+    return true;
+}
+
+void light_uplink_face_resign(movement_settings_t *settings, void *context) {
+    (void) settings;
+    _light_uplink_face_stop((light_uplink_state_t *)context);
+}
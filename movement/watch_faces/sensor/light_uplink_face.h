@@ -0,0 +1,100 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef LIGHT_UPLINK_FACE_H_
+#define LIGHT_UPLINK_FACE_H_
+
+/*
+ * LIGHT UPLINK
+ *
+ * Loads a file onto the watch from flashes of light, without USB: TOTP
+ * secrets for the lfs TOTP face (totp_uris.txt), or anything else that lives
+ * on the filesystem. It needs a light sensor on one of the analog pins, like a
+ * phototransistor from VCC to LIGHT_UPLINK_SENSE_PIN with a resistor to ground,
+ * so that brighter reads higher.
+ *
+ * The face shows “LU” at the top left. A press of the Alarm button starts
+ * listening, with the signal indicator on, and another stops it. While it
+ * listens, the main line shows how many bytes of the file have come in; once
+ * the whole file is in, it shows “donE”, and the file has replaced any file of
+ * the same name. If a frame goes missing, it shows “LoSt” and waits for the
+ * file to start again, so the sender should send it over and over until the
+ * watch has it.
+ *
+ * The file comes in frames (@see optical_rx.h): a LIGHT_UPLINK_FRAME_BEGIN
+ * with the file's name, then LIGHT_UPLINK_FRAME_DATA frames, each starting with
+ * a sequence number that counts up from 0, then a LIGHT_UPLINK_FRAME_END with
+ * the file's length as four bytes, least significant first. Each bit is held
+ * for LIGHT_UPLINK_SAMPLES_PER_BIT 512ths of a second.
+ */
+
+#include "movement.h"
+
+#ifndef LIGHT_UPLINK_SENSE_PIN
+#define LIGHT_UPLINK_SENSE_PIN (A1)
+#endif
+
+#ifndef LIGHT_UPLINK_SAMPLES_PER_BIT
+#define LIGHT_UPLINK_SAMPLES_PER_BIT 4
+#endif
+
+#define LIGHT_UPLINK_FRAME_BEGIN 0x01
+#define LIGHT_UPLINK_FRAME_DATA 0x02
+#define LIGHT_UPLINK_FRAME_END 0x03
+
+#define LIGHT_UPLINK_NAME_MAX 31
+
+typedef enum {
+    LIGHT_UPLINK_IDLE = 0,
+    LIGHT_UPLINK_WAITING,       // listening for the start of a file
+    LIGHT_UPLINK_RECEIVING,     // a file has started, and is being written to LIGHT_UPLINK_TEMP_FILE
+    LIGHT_UPLINK_DONE,
+    LIGHT_UPLINK_LOST,          // a frame went missing; listening for the file to start again
+    LIGHT_UPLINK_ERROR,         // the file couldn't be written
+} light_uplink_status_t;
+
+typedef struct {
+    light_uplink_status_t status;
+    uint8_t sequence;
+    uint32_t bytes;
+    char filename[LIGHT_UPLINK_NAME_MAX + 1];
+} light_uplink_state_t;
+
+void light_uplink_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
+void light_uplink_face_activate(movement_settings_t *settings, void *context);
+bool light_uplink_face_loop(movement_event_t event, movement_settings_t *settings, void *context);
+void light_uplink_face_resign(movement_settings_t *settings, void *context);
+
+#define light_uplink_face ((const watch_face_t){ \
+    light_uplink_face_setup, \
+    light_uplink_face_activate, \
+    light_uplink_face_loop, \
+    light_uplink_face_resign, \
+    NULL, \
+    sizeof(light_uplink_state_t), \
+    0, \
+    NULL, \
+})
+
+#endif // LIGHT_UPLINK_FACE_H_
@@ -28,16 +28,32 @@
 #include "lightmeter_face.h"
 #include "watch_utility.h"
 #include "watch_slcd.h"
+#include "movement_sensors.h"
 
 uint16_t lightmeter_mod(uint16_t m, uint16_t n) { return (m%n + n)%n; }  
 
+static void _lightmeter_interrupt_callback(void) {
+    movement_queue_tick();
+}
+
+static void _lightmeter_read(lightmeter_state_t *state) {
+    opt3001_t result = opt3001_readResult(lightmeter_addr);
+    state->lux = result.lux;
+    lightmeter_show_ev(state);
+
+    // watch for the light to move half a stop either way; the +1 keeps the window open in the dark.
+    opt3001_startWindow(lightmeter_addr, state->lux / LIGHTMETER_WINDOW, state->lux * LIGHTMETER_WINDOW + 1, 1, true);
+    state->tracking = true;
+}
+
 void lightmeter_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
     (void) settings;
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(lightmeter_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(lightmeter_state_t));
         lightmeter_state_t *state = (lightmeter_state_t*) *context_ptr;
         state->waiting_for_conversion = 0;
+        state->tracking = false;
         state->lux = 0.0;
         state->mode = 0;
         state->iso = LIGHTMETER_ISO_100;
@@ -49,8 +65,14 @@ void lightmeter_face_activate(movement_settings_t *settings, void *context) {
     (void) settings;
     lightmeter_state_t *state = (lightmeter_state_t*) context;
     state->waiting_for_conversion = 0;
+    state->tracking = false;
     lightmeter_show_ev(state); // Print most current reading
-    watch_enable_i2c();
+    // this face runs the sensor its own way, so keep the sensor registry's single shots off it.
+    movement_sensors_hold_device(MOVEMENT_SENSOR_DEVICE_OPT3001, true);
+    watch_claim_peripheral(WATCH_PERIPHERAL_I2C);
+    // INT is open drain and active low.
+    watch_enable_pull_up(LIGHTMETER_INT_PIN);
+    watch_register_interrupt_callback(LIGHTMETER_INT_PIN, _lightmeter_interrupt_callback, INTERRUPT_TRIGGER_FALLING);
     return;
 }
 
@@ -105,17 +127,20 @@ bool lightmeter_face_loop(movement_event_t event, movement_settings_t *settings,
     (void) settings;
     lightmeter_state_t *state = (lightmeter_state_t*) context;
     
-    opt3001_Config_t c;
     switch (event.event_type) {
         case EVENT_TICK:
-            if(state->waiting_for_conversion) { // Check if measurement is ready...
-                c = opt3001_readConfig(lightmeter_addr);
-                if(c.ConversionReady) {
+            if(state->waiting_for_conversion) { // INT falls when the measurement is ready...
+                bool ready = !watch_get_pin_level(LIGHTMETER_INT_PIN);
+                if(!ready && ++state->ticks_waiting > LIGHTMETER_POLL_TICKS) { // ...or ask, if it hasn't.
+                    ready = opt3001_readConfig(lightmeter_addr).ConversionReady;
+                }
+                if(ready) {
                     state->waiting_for_conversion = 0;
-                    opt3001_t result = opt3001_readResult(lightmeter_addr);
-                    state->lux = result.lux;
-                    lightmeter_show_ev(state); 
-                } 
+                    _lightmeter_read(state);
+                }
+            } else if(state->tracking && !watch_get_pin_level(LIGHTMETER_INT_PIN)) { // The light has changed.
+                opt3001_readConfig(lightmeter_addr); // Reading the config lets INT go.
+                _lightmeter_read(state);
             }
             break;
 
@@ -141,8 +166,10 @@ bool lightmeter_face_loop(movement_event_t event, movement_settings_t *settings,
             break;
 
         case EVENT_ALARM_LONG_PRESS: // Take measurement
-            opt3001_writeConfig(lightmeter_addr, lightmeter_takeNewReading);
+            opt3001_startSingleShot(lightmeter_addr, true);
             state->waiting_for_conversion = 1;
+            state->tracking = false;
+            state->ticks_waiting = 0;
 
             watch_clear_all_indicators();
             watch_display_string("EV  ", 0); 
@@ -168,8 +195,13 @@ bool lightmeter_face_loop(movement_event_t event, movement_settings_t *settings,
 
 void lightmeter_face_resign(movement_settings_t *settings, void *context) {
     (void) settings;
-    (void) context;
+    lightmeter_state_t *state = (lightmeter_state_t*) context;
+    state->waiting_for_conversion = 0;
+    state->tracking = false;
     opt3001_writeConfig(lightmeter_addr, lightmeter_off);
-    watch_disable_i2c();
+    watch_register_interrupt_callback(LIGHTMETER_INT_PIN, NULL, INTERRUPT_TRIGGER_NONE);
+    watch_disable_digital_input(LIGHTMETER_INT_PIN);
+    watch_release_peripheral(WATCH_PERIPHERAL_I2C);
+    movement_sensors_hold_device(MOVEMENT_SENSOR_DEVICE_OPT3001, false);
     return;
 }
@@ -39,6 +39,12 @@
  *
  *  - Trigger a measurement by long-pressing Alarm.
  *    Sensor integration is happening when the Signal indicator is on.
+ *    The sensor's INT pin, on LIGHTMETER_INT_PIN, says when it's done; without it the
+ *    face asks the sensor after a couple of seconds instead.
+ *
+ *  - After a measurement the sensor keeps watching, and the face updates whenever the
+ *    light moves more than half a stop from the last reading. In between, neither the
+ *    sensor nor the watch does any measuring work.
  *
  *  - ISO setting can be cycled by long-pressing Light.
  *    During integration the current ISO setting will be displayed. 
@@ -60,6 +66,15 @@
 #include "opt3001.h"
 
 #define LIGHTMETER_CALIBRATION 2.58
+
+// the pin the OPT3001's INT line is wired to; it has to be one with an external interrupt (A0, A1, A3 or A4).
+#ifndef LIGHTMETER_INT_PIN
+#define LIGHTMETER_INT_PIN A1
+#endif
+// ticks to wait for INT before asking the sensor whether the conversion is done.
+#define LIGHTMETER_POLL_TICKS 2
+// how far the light has to move from the last reading, as a ratio, to show a new one: half a stop.
+#define LIGHTMETER_WINDOW 1.41421
 typedef struct { 
     char * str;
     float ev;
@@ -155,17 +170,12 @@ typedef struct {
     lightmeter_iso_t iso;
     lightmeter_ap_t ap;
     bool waiting_for_conversion;
+    bool tracking;
+    uint8_t ticks_waiting;
     float lux;
     int mode; 
 } lightmeter_state_t;
 
-static const opt3001_Config_t lightmeter_takeNewReading = { 
-    .RangeNumber = 0B1100,
-    .ConversionTime = 0B1,
-    .Latch = 0B1,
-    .ModeOfConversionOperation = 0B01
-};
-
 static const opt3001_Config_t lightmeter_off = { 
     .ModeOfConversionOperation = 0B00
 };
@@ -186,6 +196,9 @@ static const uint8_t lightmeter_addr = 0x44;
     lightmeter_face_loop, \
     lightmeter_face_resign, \
     NULL, \
+    sizeof(lightmeter_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // LIGHTMETER_FACE_H_
@@ -0,0 +1,102 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include "sleep_tracker_face.h"
+#include "movement_sleep.h"
+#include "watch.h"
+
+static void _sleep_tracker_face_update_display(sleep_tracker_state_t *state) {
+    static const char *const titles[SLEEP_TRACKER_NUM_PAGES] = { "SL", "rE", "AW" };
+    char buf[14];
+    movement_sleep_summary_t summary;
+
+    watch_clear_colon();
+    if (!movement_sleep_get_last_night(&summary) || summary.onset == UINT16_MAX) {
+        sprintf(buf, "%s  ----  ", titles[state->page]);
+    } else {
+        switch (state->page) {
+            case SLEEP_TRACKER_PAGE_ASLEEP:
+                sprintf(buf, "%s  %2d%02d  ", titles[state->page], summary.asleep / 60, summary.asleep % 60);
+                watch_set_colon();
+                break;
+            case SLEEP_TRACKER_PAGE_RESTLESS:
+                sprintf(buf, "%s   %3d  ", titles[state->page], summary.asleep ? summary.restless * 100 / summary.asleep : 0);
+                break;
+            default:
+                sprintf(buf, "%s   %3d  ", titles[state->page], summary.awakenings);
+                break;
+        }
+    }
+    watch_display_string(buf, 0);
+
+    if (movement_sleep_is_tracking()) watch_set_indicator(WATCH_INDICATOR_SIGNAL);
+    else watch_clear_indicator(WATCH_INDICATOR_SIGNAL);
+}
+
+void sleep_tracker_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
+    (void) settings;
+    (void) watch_face_index;
+    if (*context_ptr == NULL) {
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(sleep_tracker_state_t));
+        memset(*context_ptr, 0, sizeof(sleep_tracker_state_t));
+    }
+    // setup runs again after every wake from low energy mode; this does nothing if the tracker is already going.
+    movement_sleep_enable();
+}
+
+void sleep_tracker_face_activate(movement_settings_t *settings, void *context) {
+    (void) settings;
+    sleep_tracker_state_t *state = (sleep_tracker_state_t *)context;
+    state->page = SLEEP_TRACKER_PAGE_ASLEEP;
+}
+
+bool sleep_tracker_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
+    sleep_tracker_state_t *state = (sleep_tracker_state_t *)context;
+
+    switch (event.event_type) {
+        case EVENT_ALARM_BUTTON_UP:
+            state->page = (state->page + 1) % SLEEP_TRACKER_NUM_PAGES;
+            // fall through
+        case EVENT_ACTIVATE:
+        case EVENT_LOW_ENERGY_UPDATE:
+            _sleep_tracker_face_update_display(state);
+            break;
+        case EVENT_TICK:
+            // the summary only changes at the end of the night, at the top of a minute.
+            if (watch_rtc_get_date_time().unit.second == 0) _sleep_tracker_face_update_display(state);
+            break;
+        default:
+            return movement_default_loop_handler(event, settings);
+    }
+
+    return true;
+}
+
+void sleep_tracker_face_resign(movement_settings_t *settings, void *context) {
+    (void) settings;
+    (void) context;
+}
@@ -0,0 +1,72 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef SLEEP_TRACKER_FACE_H_
+#define SLEEP_TRACKER_FACE_H_
+
+/*
+ * SLEEP TRACKER
+ *
+ * Shows how you slept last night. This face needs an accelerometer board
+ * with its INT2 wired to an extwake pin (see movement_accelerometer.h);
+ * including it in your build turns on Movement's sleep tracker, which
+ * watches from 9 PM to 9 AM every night (see movement_sleep.h).
+ *
+ * The face opens on the time you spent asleep ("SL", hours and minutes).
+ * Press ALARM for how restless you were ("rE", the percentage of that time
+ * with some movement in it), again for the times you woke up ("AW"), and
+ * again to go back. Dashes mean there's no night to show yet. The signal
+ * indicator is on while tonight is being tracked.
+ */
+
+#include "movement.h"
+
+typedef enum {
+    SLEEP_TRACKER_PAGE_ASLEEP = 0,
+    SLEEP_TRACKER_PAGE_RESTLESS,
+    SLEEP_TRACKER_PAGE_AWAKENINGS,
+    SLEEP_TRACKER_NUM_PAGES
+} sleep_tracker_page_t;
+
+typedef struct {
+    sleep_tracker_page_t page;
+} sleep_tracker_state_t;
+
+void sleep_tracker_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
+void sleep_tracker_face_activate(movement_settings_t *settings, void *context);
+bool sleep_tracker_face_loop(movement_event_t event, movement_settings_t *settings, void *context);
+void sleep_tracker_face_resign(movement_settings_t *settings, void *context);
+
+#define sleep_tracker_face ((const watch_face_t){ \
+    sleep_tracker_face_setup, \
+    sleep_tracker_face_activate, \
+    sleep_tracker_face_loop, \
+    sleep_tracker_face_resign, \
+    NULL, \
+    sizeof(sleep_tracker_state_t), \
+    MOVEMENT_FACE_EAGER_SETUP, \
+    NULL, \
+})
+
+#endif // SLEEP_TRACKER_FACE_H_
@@ -0,0 +1,79 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include "step_counter_face.h"
+#include "movement_steps.h"
+#include "watch.h"
+
+static void _step_counter_face_update_display(step_counter_state_t *state) {
+    char buf[14];
+    uint32_t steps = state->show_yesterday ? movement_steps_get_yesterday() : movement_steps_get_today();
+    if (steps > 999999) steps = 999999;
+    sprintf(buf, "%s  %6lu", state->show_yesterday ? "YE" : "ST", (unsigned long)steps);
+    watch_display_string(buf, 0);
+}
+
+void step_counter_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
+    (void) settings;
+    (void) watch_face_index;
+    if (*context_ptr == NULL) {
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(step_counter_state_t));
+        memset(*context_ptr, 0, sizeof(step_counter_state_t));
+    }
+    // setup runs again after every wake from low energy mode; this does nothing if the counter is already going.
+    movement_steps_enable();
+}
+
+void step_counter_face_activate(movement_settings_t *settings, void *context) {
+    (void) settings;
+    step_counter_state_t *state = (step_counter_state_t *)context;
+    state->show_yesterday = false;
+}
+
+bool step_counter_face_loop(movement_event_t event, movement_settings_t *settings, void *context) {
+    step_counter_state_t *state = (step_counter_state_t *)context;
+
+    switch (event.event_type) {
+        case EVENT_ALARM_BUTTON_UP:
+            state->show_yesterday = !state->show_yesterday;
+            // fall through
+        case EVENT_ACTIVATE:
+        case EVENT_TICK:
+        case EVENT_LOW_ENERGY_UPDATE:
+            _step_counter_face_update_display(state);
+            break;
+        default:
+            return movement_default_loop_handler(event, settings);
+    }
+
+    return true;
+}
+
+void step_counter_face_resign(movement_settings_t *settings, void *context) {
+    (void) settings;
+    (void) context;
+}
@@ -0,0 +1,63 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef STEP_COUNTER_FACE_H_
+#define STEP_COUNTER_FACE_H_
+
+/*
+ * STEP COUNTER
+ *
+ * Shows how many steps you've taken today. This face needs an accelerometer
+ * board with its interrupt wired to an extwake pin (see
+ * movement_accelerometer.h); including it in your build turns on Movement's
+ * background step counter, which keeps counting whichever face is showing
+ * and while the watch is in low energy mode.
+ *
+ * The count starts over at midnight. Press ALARM to see yesterday's total
+ * (the top left reads "YE"), and again to go back to today ("ST").
+ */
+
+#include "movement.h"
+
+typedef struct {
+    bool show_yesterday;
+} step_counter_state_t;
+
+void step_counter_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
+void step_counter_face_activate(movement_settings_t *settings, void *context);
+bool step_counter_face_loop(movement_event_t event, movement_settings_t *settings, void *context);
+void step_counter_face_resign(movement_settings_t *settings, void *context);
+
+#define step_counter_face ((const watch_face_t){ \
+    step_counter_face_setup, \
+    step_counter_face_activate, \
+    step_counter_face_loop, \
+    step_counter_face_resign, \
+    NULL, \
+    sizeof(step_counter_state_t), \
+    MOVEMENT_FACE_EAGER_SETUP, \
+    NULL, \
+})
+
+#endif // STEP_COUNTER_FACE_H_
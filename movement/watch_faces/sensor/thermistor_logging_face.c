@@ -25,33 +25,31 @@
 #include <stdlib.h>
 #include <string.h>
 #include "thermistor_logging_face.h"
-#include "thermistor_driver.h"
+#include "movement_temperature.h"
+#include "movement_chirpy.h"
 #include "watch.h"
+#include "watch_utility.h"
 
-static void _thermistor_logging_face_log_data(thermistor_logger_state_t *logger_state) {
-    thermistor_driver_enable();
-    watch_date_time date_time = watch_rtc_get_date_time();
-    size_t pos = logger_state->data_points % THERMISTOR_LOGGING_NUM_DATA_POINTS;
-
-    logger_state->data[pos].timestamp.reg = date_time.reg;
-    logger_state->data[pos].temperature_c = thermistor_driver_get_temperature();
-    logger_state->data_points++;
-
-    thermistor_driver_disable();
+// the hours the history reaches back, as many as two digits can count.
+static uint8_t _thermistor_logging_face_num_hours(void) {
+    uint32_t count = movement_temperature_count(MOVEMENT_TEMPERATURE_HOURS);
+    if (count == 0) return 1;
+    return count > THERMISTOR_LOGGING_MAX_INDEX + 1 ? THERMISTOR_LOGGING_MAX_INDEX + 1 : count;
 }
 
 static void _thermistor_logging_face_update_display(thermistor_logger_state_t *logger_state, bool in_fahrenheit, bool clock_mode_24h) {
-    int8_t pos = (logger_state->data_points - 1 - logger_state->display_index) % THERMISTOR_LOGGING_NUM_DATA_POINTS;
+    movement_temperature_point_t data_point;
+    bool have_data = movement_temperature_read(MOVEMENT_TEMPERATURE_HOURS, logger_state->display_index, &data_point);
     char buf[14];
 
     watch_clear_indicator(WATCH_INDICATOR_24H);
     watch_clear_indicator(WATCH_INDICATOR_PM);
     watch_clear_colon();
 
-    if (pos < 0) {
+    if (!have_data) {
         sprintf(buf, "TL%2dno dat", logger_state->display_index);
     } else if (logger_state->ts_ticks) {
-        watch_date_time date_time = logger_state->data[pos].timestamp;
+        watch_date_time date_time = watch_utility_date_time_from_unix_time(data_point.timestamp, 0);
         watch_set_colon();
         if (clock_mode_24h) {
             watch_set_indicator(WATCH_INDICATOR_24H);
@@ -63,9 +61,9 @@ static void _thermistor_logging_face_update_display(thermistor_logger_state_t *l
         sprintf(buf, "AT%2d%2d%02d%02d", date_time.unit.day, date_time.unit.hour, date_time.unit.minute, date_time.unit.second);
     } else {
         if (in_fahrenheit) {
-            sprintf(buf, "TL%2d%4.1f#F", logger_state->display_index, logger_state->data[pos].temperature_c * 1.8 + 32.0);
+            sprintf(buf, "TL%2d%4.1f#F", logger_state->display_index, data_point.avg / 100.0 * 1.8 + 32.0);
         } else {
-            sprintf(buf, "TL%2d%4.1f#C", logger_state->display_index, logger_state->data[pos].temperature_c);
+            sprintf(buf, "TL%2d%4.1f#C", logger_state->display_index, data_point.avg / 100.0);
         }
     }
 
@@ -76,8 +74,9 @@ void thermistor_logging_face_setup(movement_settings_t *settings, uint8_t watch_
     (void) settings;
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(thermistor_logger_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(thermistor_logger_state_t));
         memset(*context_ptr, 0, sizeof(thermistor_logger_state_t));
+        movement_temperature_enable();
     }
 }
 
@@ -103,20 +102,24 @@ bool thermistor_logging_face_loop(movement_event_t event, movement_settings_t *s
             _thermistor_logging_face_update_display(logger_state, settings->bit.use_imperial_units, settings->bit.clock_mode_24h);
             break;
         case EVENT_ALARM_BUTTON_DOWN:
-            logger_state->display_index = (logger_state->display_index + 1) % THERMISTOR_LOGGING_NUM_DATA_POINTS;
+            logger_state->display_index = (logger_state->display_index + 1) % _thermistor_logging_face_num_hours();
             logger_state->ts_ticks = 0;
             // fall through
         case EVENT_ACTIVATE:
             _thermistor_logging_face_update_display(logger_state, settings->bit.use_imperial_units, settings->bit.clock_mode_24h);
             break;
+        case EVENT_ALARM_LONG_PRESS:
+            // sends the whole log over the buzzer for the Chirpy app; the bell stays on until it's done.
+            if (movement_chirpy_send_log(movement_temperature_get_log(MOVEMENT_TEMPERATURE_HOURS), true, MOVEMENT_CHIRPY_RATE_NORMAL, NULL)) {
+                watch_set_indicator(WATCH_INDICATOR_BELL);
+            }
+            break;
         case EVENT_TICK:
+            if (!movement_chirpy_is_sending()) watch_clear_indicator(WATCH_INDICATOR_BELL);
             if (logger_state->ts_ticks && --logger_state->ts_ticks == 0) {
                 _thermistor_logging_face_update_display(logger_state, settings->bit.use_imperial_units, settings->bit.clock_mode_24h);
             }
             break;
-        case EVENT_BACKGROUND_TASK:
-            _thermistor_logging_face_log_data(logger_state);
-            break;
         default:
             movement_default_loop_handler(event, settings);
             break;
@@ -128,12 +131,6 @@ bool thermistor_logging_face_loop(movement_event_t event, movement_settings_t *s
 void thermistor_logging_face_resign(movement_settings_t *settings, void *context) {
     (void) settings;
     (void) context;
-}
-
-bool thermistor_logging_face_wants_background_task(movement_settings_t *settings, void *context) {
-    (void) settings;
-    (void) context;
-    // this will get called at the top of each minute, so all we check is if we're at the top of the hour as well.
-    // if we are, we ask for a background task.
-    return watch_rtc_get_date_time().unit.minute == 0;
+    movement_chirpy_stop();
+    watch_clear_indicator(WATCH_INDICATOR_BELL);
 }
@@ -28,19 +28,19 @@
 /*
  * THERMISTOR LOGGING (aka Temperature Log)
  *
- * This watch face automatically logs the temperature once an hour, and
- * maintains a 36-hour log of readings. This watch face is admittedly rather
- * complex, and bears some explanation.
+ * This watch face shows the hourly temperature from Movement's temperature
+ * history (movement_temperature.h), which reaches back six days or more. This
+ * watch face is admittedly rather complex, and bears some explanation.
  *
  * The main display shows the letters “TL” in the top left, indicating the
  * name of the watch face. At the top right, it displays the index of the
- * reading; 0 represents the most recent reading taken, 1 represents one
- * hour earlier, etc. The bottom line in this mode displays the logged
+ * reading; 0 represents the current hour so far, 1 represents one hour
+ * earlier, etc. The bottom line in this mode displays the hour's average
  * temperature.
  *
  * A short press of the “Alarm” button advances to the next oldest reading;
  * you will see the number at the top right advance from 0 to 1 to 2, all
- * the way to 35, the oldest reading available.
+ * the way to 99, or the oldest reading available.
  *
  * A short press of the “Light” button will briefly display the timestamp
  * of the reading. The letters at the top left will display the word “At”,
@@ -51,37 +51,42 @@
  *
  * If you need to illuminate the LED to read the data point, long press the
  * Light button and release it.
+ *
+ * A long press of the Alarm button sends the history's hourly log over the
+ * buzzer, to be picked up by the Chirpy app; the bell indicator stays on
+ * while it plays.
+ *
+ * The history is kept on the filesystem, so it survives a reset; only the
+ * last half day or so, which is batched in RAM, is lost. Earlier versions of
+ * this face kept their own log in therm.0 and therm.1; once you have no more
+ * use for it, you can free the space with the shell's rm command.
  */
 
 #include "movement.h"
 #include "watch.h"
 
-#define THERMISTOR_LOGGING_NUM_DATA_POINTS (36)
-
-typedef struct {
-    watch_date_time timestamp;
-    float temperature_c;
-} thermistor_logger_data_point_t;
+// the oldest hour the face shows, as far as two digits count.
+#define THERMISTOR_LOGGING_MAX_INDEX (99)
 
 typedef struct {
     uint8_t display_index;  // the index we are displaying on screen
     uint8_t ts_ticks;       // when the user taps the LIGHT button, we show the timestamp for a few ticks.
-    int32_t data_points;    // the absolute number of data points logged
-    thermistor_logger_data_point_t data[THERMISTOR_LOGGING_NUM_DATA_POINTS];
 } thermistor_logger_state_t;
 
 void thermistor_logging_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
 void thermistor_logging_face_activate(movement_settings_t *settings, void *context);
 bool thermistor_logging_face_loop(movement_event_t event, movement_settings_t *settings, void *context);
 void thermistor_logging_face_resign(movement_settings_t *settings, void *context);
-bool thermistor_logging_face_wants_background_task(movement_settings_t *settings, void *context);
 
 #define thermistor_logging_face ((const watch_face_t){ \
     thermistor_logging_face_setup, \
     thermistor_logging_face_activate, \
     thermistor_logging_face_loop, \
     thermistor_logging_face_resign, \
-    thermistor_logging_face_wants_background_task, \
+    NULL, \
+    sizeof(thermistor_logger_state_t), \
+    MOVEMENT_FACE_EAGER_SETUP, \
+    NULL, \
 })
 
 #endif // THERMISTOR_LOGGING_FACE_H_
@@ -61,6 +61,9 @@ void thermistor_readout_face_resign(movement_settings_t *settings, void *context
     thermistor_readout_face_loop, \
     thermistor_readout_face_resign, \
     NULL, \
+    0, \
+    0, \
+    NULL, \
 })
 
 #endif // THERMISTOR_READOUT_FACE_H_
@@ -49,6 +49,9 @@ void thermistor_testing_face_resign(movement_settings_t *settings, void *context
     thermistor_testing_face_loop, \
     thermistor_testing_face_resign, \
     NULL, \
+    0, \
+    0, \
+    NULL, \
 })
 
 #endif // THERMISTOR_TESTING_FACE_H_
@@ -26,11 +26,9 @@
 #include <string.h>
 #include <math.h>
 #include "finetune_face.h"
-#include "nanosec_face.h"
+#include "movement_freqcorr.h"
 #include "watch_utility.h"
 
-extern nanosec_state_t nanosec_state;
-
 int total_adjustment;
 int8_t finetune_page;
 
@@ -53,7 +51,7 @@ void finetune_face_activate(movement_settings_t *settings, void *context) {
 
 static float finetune_get_hours_passed(void) {
     uint32_t current_time = watch_utility_date_time_to_unix_time(watch_rtc_get_date_time(), 0);
-    return (current_time - nanosec_state.last_correction_time) / 3600.0f;
+    return (current_time - movement_freqcorr_get_settings()->last_correction_time) / 3600.0f;
 }
 
 static float finetune_get_correction(void) {
@@ -116,18 +114,19 @@ static void finetune_adjust_subseconds(int delta) {
                     date_time.unit.day++;
             }
         }
-        watch_rtc_set_date_time(date_time);
+        movement_set_local_date_time(date_time);
     }
     watch_rtc_enable(true);
 }
 
 static void finetune_update_correction_time(void) {
     // Update aging, as we update correciton time - we must bake accrued aging into static offset
-    nanosec_state.freq_correction += roundf(nanosec_get_aging() * 100);
+    int32_t aging_ppb = movement_freqcorr_get_aging_ppb();
+    movement_freqcorr_get_settings()->freq_correction += (aging_ppb + (aging_ppb < 0 ? -5 : 5)) / 10;
 
     // Remember when we last corrected time
-    nanosec_state.last_correction_time = watch_utility_date_time_to_unix_time(watch_rtc_get_date_time(), 0);
-    nanosec_save();
+    movement_freqcorr_get_settings()->last_correction_time = watch_utility_date_time_to_unix_time(watch_rtc_get_date_time(), 0);
+    movement_freqcorr_save();
     movement_move_to_face(0); // Go to main face after saving settings
 }
 
@@ -182,7 +181,7 @@ bool finetune_face_loop(movement_event_t event, movement_settings_t *settings, v
                 finetune_adjust_subseconds(250);
             } else if (finetune_page == 2 && finetune_get_hours_passed() >= 6) {
                 // Applying ppm correction, only if >6 hours passed
-                nanosec_state.freq_correction += (int)round(finetune_get_correction() * 100);
+                movement_freqcorr_get_settings()->freq_correction += (int)round(finetune_get_correction() * 100);
                 finetune_update_correction_time();
             }
             break;
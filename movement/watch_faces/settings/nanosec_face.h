@@ -55,9 +55,14 @@
  * Default funing fork tempco: -0.034 ppm/°C², centered around 25°C
  * We add optional cubic coefficient, which was measured in practice on my sample.
  *
- * Cadence (CD) - how many minutes between corrections. Default 10 minutes.
- * Every minute might be too much. Every hour - slightly less power
- * consumption but also less precision.
+ * Cadence (CD) - the most minutes between corrections. Default 10 minutes.
+ * Corrections come as often as once a minute while the temperature is
+ * changing, and back off to the cadence once it settles. Every hour -
+ * slightly less power consumption but also less precision.
+ *
+ * The correction itself is done by Movement's frequency correction service
+ * (movement_freqcorr.h), which keeps running whichever face is on screen;
+ * this face edits its settings.
  *
  * Can compensate crystal aging (ppm/year) - but you really should be worrying
  * about it on second/third years of watch calibration.
@@ -68,32 +73,17 @@
 
 #include "movement.h"
 
-#define nanosec_profile_count 5
-typedef struct {
-    // Correction profiles:
-    // 0 - static hardware correction.
-    // 1 - static correction with dithering.
-    // 2 - datasheet quadratic correction (universal).
-    // 3 - cubic correction conservative (likely universal).
-    // 4 - cubic correction finetuned (sample-specific).
-    int8_t correction_profile;
-    int16_t freq_correction; // Static correction - multiplied by 100
-    int16_t center_temperature; // Multiplied by 100, +25.0 -> +2500
-    int16_t quadratic_tempco; // 0.034 -> 3400, multiplied by 100000. Stored positive, used as negative.
-    int16_t cubic_tempco; // default 0, 0.000136 -> 1360, multiplied by 10000000. Stored positive, used positive.
-    int8_t correction_cadence;
-    uint32_t last_correction_time; // Not used at the moment - but will in the future
-    int16_t aging_ppm_pa; // multiplied by 100. Aging per year. 
-} nanosec_state_t;
+#include "movement_freqcorr.h"
+
+#define nanosec_profile_count MOVEMENT_FREQCORR_NUM_PROFILES
+
+// Key the settings are kept under in the movement key/value store.
+#define NANOSEC_KV_KEY MOVEMENT_FREQCORR_KV_KEY
 
 void nanosec_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr);
 void nanosec_face_activate(movement_settings_t *settings, void *context);
 bool nanosec_face_loop(movement_event_t event, movement_settings_t *settings, void *context);
 void nanosec_face_resign(movement_settings_t *settings, void *context);
-bool nanosec_face_wants_background_task(movement_settings_t *settings, void *context);
-void nanosec_ui_save(void);
-void nanosec_save(void);
-float nanosec_get_aging(void);
 
 
 #define nanosec_face ((const watch_face_t) { \
@@ -101,7 +91,10 @@ float nanosec_get_aging(void);
     nanosec_face_activate, \
     nanosec_face_loop, \
     nanosec_face_resign, \
-    nanosec_face_wants_background_task, \
+    NULL, \
+    0, \
+    MOVEMENT_FACE_EAGER_SETUP, \
+    NULL, \
 })
 
 #endif // NANOSEC_FACE_H_
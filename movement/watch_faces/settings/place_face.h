@@ -225,6 +225,9 @@ void place_latlon_to_geohash(char *geohash, double latitude, double longitude);
     place_face_loop, \
     place_face_resign, \
     NULL, \
+    0, \
+    0, \
+    NULL, \
 })
 
 #endif // place_FACE_H_
@@ -26,12 +26,14 @@
 #include "preferences_face.h"
 #include "watch.h"
 
-#define PREFERENCES_FACE_NUM_PREFEFENCES (7)
+#define PREFERENCES_FACE_NUM_PREFEFENCES (9)
 const char preferences_face_titles[PREFERENCES_FACE_NUM_PREFEFENCES][11] = {
     "CL        ",   // Clock: 12 or 24 hour
     "BT  Beep  ",   // Buttons: should they beep?
     "TO        ",   // Timeout: how long before we snap back to the clock face?
     "LE        ",   // Low Energy mode: how long before it engages?
+    "LE  n&otn ",   // Low Energy mode: should it follow motion?
+    "NI        ",   // Night: when to turn the display off in low energy mode
     "LT        ",   // Light: duration
 #ifdef WATCH_IS_BLUE_BOARD
     "LT   blu  ",   // Light: blue component (for watches with blue LED)
@@ -44,7 +46,7 @@ const char preferences_face_titles[PREFERENCES_FACE_NUM_PREFEFENCES][11] = {
 void preferences_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
     (void) settings;
     (void) watch_face_index;
-    if (*context_ptr == NULL) *context_ptr = malloc(sizeof(uint8_t));
+    if (*context_ptr == NULL) *context_ptr = movement_claim_face_context(watch_face_index, sizeof(uint8_t));
 }
 
 void preferences_face_activate(movement_settings_t *settings, void *context) {
@@ -83,12 +85,18 @@ bool preferences_face_loop(movement_event_t event, movement_settings_t *settings
                     settings->bit.le_interval = settings->bit.le_interval + 1;
                     break;
                 case 4:
-                    settings->bit.led_duration = settings->bit.led_duration + 1;
+                    settings->bit.le_motion = !(settings->bit.le_motion);
                     break;
                 case 5:
-                    settings->bit.led_green_color = settings->bit.led_green_color + 1;
+                    settings->bit.night_mode = settings->bit.night_mode + 1;
                     break;
                 case 6:
+                    settings->bit.led_duration = settings->bit.led_duration + 1;
+                    break;
+                case 7:
+                    settings->bit.led_green_color = settings->bit.led_green_color + 1;
+                    break;
+                case 8:
                     settings->bit.led_red_color = settings->bit.led_red_color + 1;
                     break;
             }
@@ -159,6 +167,22 @@ bool preferences_face_loop(movement_event_t event, movement_settings_t *settings
                 }
                 break;
             case 4:
+                if (settings->bit.le_motion) watch_display_string("y", 9);
+                else watch_display_string("n", 9);
+                break;
+            case 5:
+                if (settings->bit.night_mode == 0) {
+                    watch_display_string(" Never", 4);
+                } else if (settings->bit.night_mode == 1) {
+                    // no hours; only when the activity classifier says nobody's looking.
+                    watch_display_string(" Still", 4);
+                } else {
+                    sprintf(buf, "%2d -%2d", movement_night_hours[settings->bit.night_mode][0],
+                            movement_night_hours[settings->bit.night_mode][1]);
+                    watch_display_string(buf, 4);
+                }
+                break;
+            case 6:
                 if (settings->bit.led_duration) {
                     sprintf(buf, " %1d SeC", settings->bit.led_duration * 2 - 1);
                     watch_display_string(buf, 4);
@@ -166,11 +190,11 @@ bool preferences_face_loop(movement_event_t event, movement_settings_t *settings
                     watch_display_string("no LEd", 4);
                 }
                 break;
-            case 5:
+            case 7:
                 sprintf(buf, "%2d", settings->bit.led_green_color);
                 watch_display_string(buf, 8);
                 break;
-            case 6:
+            case 8:
                 sprintf(buf, "%2d", settings->bit.led_red_color);
                 watch_display_string(buf, 8);
                 break;
@@ -178,7 +202,7 @@ bool preferences_face_loop(movement_event_t event, movement_settings_t *settings
     }
 
     // on LED color select screns, preview the color.
-    if (current_page >= 5) {
+    if (current_page >= 7) {
         watch_set_led_color(settings->bit.led_red_color ? (0xF | settings->bit.led_red_color << 4) : 0,
                             settings->bit.led_green_color ? (0xF | settings->bit.led_green_color << 4) : 0);
         // return false so the watch stays awake (needed for the PWM driver to function).
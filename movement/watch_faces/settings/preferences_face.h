@@ -60,6 +60,16 @@
  *      you to make a tradeoff between the device’s responsiveness and its
  *      longevity.
  *
+ *  NI - Night.
+ *      Quiet hours for turning the display off altogether while the watch
+ *      is in low energy mode, like 22 - 6 for 10 PM to 6 AM; the display
+ *      takes a good share of what the watch draws asleep. Press ALARM (or
+ *      pick the watch up, if LE follows motion) to see the time. “Still”
+ *      has no hours, and goes dark only when a face running the activity
+ *      classifier finds the watch off the wrist or its wearer asleep; the
+ *      hours do that too. Needs Low Energy mode, so does nothing with LE
+ *      set to Never.
+ *
  *  LT - Light.
  *      This setting has three screens.
  *      The first lets you choose how long the LED should stay lit when the
@@ -89,6 +99,9 @@ void preferences_face_resign(movement_settings_t *settings, void *context);
     preferences_face_loop, \
     preferences_face_resign, \
     NULL, \
+    sizeof(uint8_t), \
+    0, \
+    NULL, \
 })
 
 #endif // PREFERENCES_FACE_H_
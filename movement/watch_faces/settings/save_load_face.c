@@ -25,7 +25,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include "save_load_face.h"
-#include "filesystem.h"
+#include "movement_kv.h"
 
 static void save(save_load_state_t *state) {
     savefile_t savefile = {
@@ -41,9 +41,9 @@ static void save(save_load_state_t *state) {
         watch_rtc_get_date_time(),
     };
     state->slot[state->index] = savefile;
-    char filename[23];
-    sprintf(filename, "save_load_face_%d.bin", state->index);
-    filesystem_write_file(filename, (char*)&savefile, sizeof(savefile_t));
+    char key[12];
+    sprintf(key, "save_load.%d", state->index);
+    movement_kv_set(key, &savefile, sizeof(savefile_t));
 }
 
 static void load(save_load_state_t *state, movement_settings_t *settings) {
@@ -60,13 +60,15 @@ static void load(save_load_state_t *state, movement_settings_t *settings) {
 
 static void load_saves_to_state(save_load_state_t *state) {
     for (uint8_t i = 0; i < SAVE_LOAD_SLOTS; i++) {
+        char key[12];
         char filename[23];
+        sprintf(key, "save_load.%d", i);
         sprintf(filename, "save_load_face_%d.bin", i);
-        if (filesystem_get_file_size(filename) != sizeof(savefile_t)) {
+        movement_kv_import_file(key, filename, sizeof(savefile_t));
+        if (movement_kv_get(key, &state->slot[i], sizeof(savefile_t)) != sizeof(savefile_t)) {
             state->slot[i].version = 0;
             continue;
         }
-        filesystem_read_file(filename, (char*)&state->slot[i], sizeof(savefile_t));
         if (state->slot[i].version != 1) {
             state->slot[i].version = 0;
         }
@@ -77,7 +79,7 @@ void save_load_face_setup(movement_settings_t *settings, uint8_t watch_face_inde
     (void) settings;
     (void) watch_face_index;
     if (*context_ptr == NULL) {
-        *context_ptr = malloc(sizeof(save_load_state_t));
+        *context_ptr = movement_claim_face_context(watch_face_index, sizeof(save_load_state_t));
         memset(*context_ptr, 0, sizeof(save_load_state_t));
     }
 }
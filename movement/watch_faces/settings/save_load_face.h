@@ -76,6 +76,9 @@ void save_load_face_resign(movement_settings_t *settings, void *context);
     save_load_face_loop, \
     save_load_face_resign, \
     NULL, \
+    sizeof(save_load_state_t), \
+    0, \
+    NULL, \
 })
 
 #endif // SAVE_LOAD_FACE_H_
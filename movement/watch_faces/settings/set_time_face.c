@@ -26,8 +26,8 @@
 #include "set_time_face.h"
 #include "watch.h"
 
-#define SET_TIME_FACE_NUM_SETTINGS (7)
-const char set_time_face_titles[SET_TIME_FACE_NUM_SETTINGS][3] = {"HR", "M1", "SE", "YR", "MO", "DA", "ZO"};
+#define SET_TIME_FACE_NUM_SETTINGS (8)
+const char set_time_face_titles[SET_TIME_FACE_NUM_SETTINGS][3] = {"HR", "M1", "SE", "YR", "MO", "DA", "ZO", "DS"};
 
 static bool _quick_ticks_running;
 
@@ -66,27 +66,31 @@ static void _handle_alarm_button(movement_settings_t *settings, watch_date_time
             settings->bit.time_zone++;
             if (settings->bit.time_zone > 40) settings->bit.time_zone = 0;
             break;
+        case 7: // daylight saving time
+            settings->bit.daylight_saving = !settings->bit.daylight_saving;
+            break;
     }
-    watch_rtc_set_date_time(date_time);
+    movement_set_local_date_time(date_time);
 }
 
 static void _abort_quick_ticks() {
     if (_quick_ticks_running) {
         _quick_ticks_running = false;
-        movement_request_tick_frequency(4);
+        movement_request_tick_frequency(1);
     }
 }
 
 void set_time_face_setup(movement_settings_t *settings, uint8_t watch_face_index, void ** context_ptr) {
     (void) settings;
     (void) watch_face_index;
-    if (*context_ptr == NULL) *context_ptr = malloc(sizeof(uint8_t));
+    if (*context_ptr == NULL) *context_ptr = movement_claim_face_context(watch_face_index, sizeof(uint8_t));
 }
 
 void set_time_face_activate(movement_settings_t *settings, void *context) {
     (void) settings;
     *((uint8_t *)context) = 0;
-    movement_request_tick_frequency(4);
+    // the display blinks the field being set by itself, so a tick a second keeps the seconds up to date.
+    movement_request_tick_frequency(1);
     _quick_ticks_running = false;
 }
 
@@ -102,7 +106,7 @@ bool set_time_face_loop(movement_event_t event, movement_settings_t *settings, v
             }
             break;
         case EVENT_ALARM_LONG_PRESS:
-            if (current_page != 2) {
+            if (current_page != 2 && current_page != 7) {
                 _quick_ticks_running = true;
                 movement_request_tick_frequency(8);
             }
@@ -146,36 +150,28 @@ bool set_time_face_loop(movement_event_t event, movement_settings_t *settings, v
         watch_clear_indicator(WATCH_INDICATOR_24H);
         watch_clear_indicator(WATCH_INDICATOR_PM);
         sprintf(buf, "%s  %2d%02d%02d", set_time_face_titles[current_page], date_time.unit.year + 20, date_time.unit.month, date_time.unit.day);
+    } else if (current_page == 6) {
+        watch_set_colon();
+        sprintf(buf, "%s %3d%02d  ", set_time_face_titles[current_page], (int8_t) (movement_timezone_offsets[settings->bit.time_zone] / 60), (int8_t) (movement_timezone_offsets[settings->bit.time_zone] % 60) * (movement_timezone_offsets[settings->bit.time_zone] < 0 ? -1 : 1));
     } else {
-        if (event.subsecond % 2) {
-            watch_clear_colon();
-            sprintf(buf, "%s        ", set_time_face_titles[current_page]);
-        } else {
-            watch_set_colon();
-            sprintf(buf, "%s %3d%02d  ", set_time_face_titles[current_page], (int8_t) (movement_timezone_offsets[settings->bit.time_zone] / 60), (int8_t) (movement_timezone_offsets[settings->bit.time_zone] % 60) * (movement_timezone_offsets[settings->bit.time_zone] < 0 ? -1 : 1));
-        }
-    }
-
-    // blink up the parameter we're setting
-    if (event.subsecond % 2 && !_quick_ticks_running) {
-        switch (current_page) {
-            case 0:
-            case 3:
-                buf[4] = buf[5] = ' ';
-                break;
-            case 1:
-            case 4:
-                buf[6] = buf[7] = ' ';
-                break;
-            case 2:
-            case 5:
-                buf[8] = buf[9] = ' ';
-                break;
-        }
+        watch_clear_colon();
+        sprintf(buf, "%s       %c", set_time_face_titles[current_page], settings->bit.daylight_saving ? 'y' : 'n');
     }
 
     watch_display_string(buf, 0);
 
+    // blink up the parameter we're setting; starting the blink over on each redraw keeps it in step with the tick.
+    if (_quick_ticks_running) {
+        watch_stop_segment_blink();
+    } else {
+        // hours, minutes and seconds (or year, month and day) are positions 4-5, 6-7 and 8-9; the time zone is all six,
+        // and daylight saving time's y or n is 9.
+        static const uint16_t blink_positions[SET_TIME_FACE_NUM_SETTINGS] = {
+            0x030, 0x0C0, 0x300, 0x030, 0x0C0, 0x300, 0x3F0, 0x200
+        };
+        watch_start_position_blink(blink_positions[current_page], 500);
+    }
+
     return true;
 }
 
@@ -33,13 +33,17 @@
  * The Time Set watch face allows you to set the time on Sensor Watch. Use
  * the LIGHT button to advance through the field you are setting, and the
  * ALARM button to change the value in that field. The fields are, in order:
- * Hour, Minute, Second, Year, Month, Day and Time Zone.
+ * Hour, Minute, Second, Year, Month, Day, Time Zone and Daylight Saving.
  *
  * For features like World Clock and Sunrise/Sunset to work correctly, you
  * must set the time to your local time, and the time zone to your local time
- * zone. This allows Sensor Watch to correctly offset the time. This also
- * means that when daylight savings time starts or ends, you must update
- * both the time and the time zone on this screen.
+ * zone. This allows Sensor Watch to correctly offset the time. Time zones
+ * are listed by their standard time; with Daylight Saving (DS) set to y,
+ * Sensor Watch puts the clock forward and back by itself when daylight
+ * saving time starts and ends in the places that keep your zone's offset
+ * (Europe, North America, south-eastern Australia and New Zealand). Set to
+ * n, you must update both the time and the time zone on this screen when
+ * it does.
  */
 
 #include "movement.h"
@@ -55,6 +59,9 @@ void set_time_face_resign(movement_settings_t *settings, void *context);
     set_time_face_loop, \
     set_time_face_resign, \
     NULL, \
+    sizeof(uint8_t), \
+    0, \
+    NULL, \
 })
 
 #endif // SET_TIME_FACE_H_
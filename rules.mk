@@ -8,7 +8,9 @@ SUBMODULES = tinyusb
 
 COBRA = cobra -f
 
-ifndef EMSCRIPTEN
+ifdef HEADLESS
+all: $(BUILD)/$(BIN)
+else ifndef EMSCRIPTEN
 all: $(BUILD)/$(BIN).elf $(BUILD)/$(BIN).hex $(BUILD)/$(BIN).bin $(BUILD)/$(BIN).uf2 size
 else
 all: $(BUILD)/$(BIN).html
@@ -17,10 +19,18 @@ endif
 $(BUILD)/$(BIN).html: $(OBJS)
 	@echo HTML $@
 	@$(CC) $(LDFLAGS) $(OBJS) $(LIBS) -o $@ \
-		-s ASYNCIFY=1 \
-		-s EXPORTED_RUNTIME_METHODS=lengthBytesUTF8,printErr \
-		-s EXPORTED_FUNCTIONS=_main \
+		-s EXPORTED_RUNTIME_METHODS=lengthBytesUTF8,printErr,addRunDependency,removeRunDependency \
+		-s EXPORTED_FUNCTIONS=_main,_sim_clock_set_rate,_sim_clock_skip_to_next_event,_sim_storage_set_timing,_sim_storage_print_wear,_sim_storage_reset,_sim_energy_print,_sim_energy_reset,_sim_press_button \
+		-s ENVIRONMENT=web,worker --pre-js $(TOP)/watch-library/simulator/sim_pre.js \
 		--shell-file=$(TOP)/watch-library/simulator/shell.html
+ifdef SIM_RELEASE
+	@echo GZIP $(BUILD)/$(BIN).wasm.gz
+	@gzip -9 -k -f $(BUILD)/$(BIN).wasm
+endif
+
+$(BUILD)/$(BIN): $(OBJS)
+	@echo LD $@
+	@$(CC) $(LDFLAGS) $(OBJS) $(LIBS) -o $@
 
 $(BUILD)/$(BIN).elf: $(OBJS)
 	@echo LD $@
@@ -45,7 +55,25 @@ $(SUBMODULES):
 install:
 	@$(UF2) -D $(BUILD)/$(BIN).uf2
 
-$(BUILD)/%.o: | $(SUBMODULES) directory
+# make delta BASE=path/to/old.bin makes an update for watches running that firmware (@see utils/firmware_delta.py).
+delta: $(BUILD)/$(BIN).bin
+	@test -n "$(BASE)" || (echo "usage: make delta BASE=path/to/old.bin" && false)
+	@echo DELTA $(BUILD)/$(BIN).delta
+	@python3 $(TOP)/utils/firmware_delta.py make $(BASE) $< $(BUILD)/$(BIN).delta
+
+$(BUILD)/watch_display_glyphs.h: $(TOP)/watch-library/shared/watch/watch_private_display.h $(TOP)/utils/gen_display_glyphs.py | directory
+	@echo GEN $@
+	@python3 $(TOP)/utils/gen_display_glyphs.py $< $@
+
+$(BUILD)/movement_signal_tunes.h: $(TOP)/movement/movement_custom_signal_tunes.h $(TOP)/watch-library/shared/watch/watch_buzzer.h $(TOP)/watch-library/shared/watch/watch_private_buzzer.c $(TOP)/utils/gen_signal_tunes.py | directory
+	@echo GEN $@
+	@python3 $(TOP)/utils/gen_signal_tunes.py $(wordlist 1,3,$^) $@
+
+ifneq ($(HOT_CFLAGS),)
+$(addprefix $(BUILD)/, $(notdir $(subst .c,.o, $(HOT_SRCS)))): CFLAGS += $(HOT_CFLAGS)
+endif
+
+$(BUILD)/%.o: | $(SUBMODULES) directory $(GENERATED_HEADERS)
 	@echo CC $@
 	@$(CC) $(CFLAGS) $(filter %/$(subst .o,.c,$(notdir $@)), $(SRCS)) -c -o $@
 
@@ -55,6 +83,63 @@ directory:
 size: $(BUILD)/$(BIN).elf
 	@echo size:
 	@$(SIZE) -t $^
+	@python3 $(TOP)/utils/face_size_report.py --brief $(BUILD)/$(BIN).map $^
+
+PROFILES = size balanced speed
+
+profile-report:
+	@for profile in $(PROFILES); do \
+		$(MAKE) --no-print-directory PROFILE=$$profile BUILD=$(BUILD)-$$profile $(BUILD)-$$profile/$(BIN).elf > /dev/null || exit 1; \
+	done
+	@$(SIZE) $(foreach profile, $(PROFILES), $(BUILD)-$(profile)/$(BIN).elf)
+
+face-report: $(BUILD)/$(BIN).elf
+	@python3 $(TOP)/utils/face_size_report.py $(BUILD)/$(BIN).map $^
+
+# Builds with STACK_USAGE=1 and reports how deep each face can take the stack (@see utils/stack_report.py).
+stack-report:
+	@$(MAKE) --no-print-directory STACK_USAGE=1 BUILD=$(BUILD)-stack all > /dev/null
+	@python3 $(TOP)/utils/stack_report.py $(BUILD)-stack
+
+# Set MAX_STANDBY_UA and/or MAX_ACTIVE_UA to have the build fail when the faces are estimated to draw more.
+POWER_BUDGET_FLAGS = --board $(BOARD) $(if $(MAX_STANDBY_UA),--max-standby-ua $(MAX_STANDBY_UA)) \
+	$(if $(MAX_ACTIVE_UA),--max-active-ua $(MAX_ACTIVE_UA))
+
+power-budget:
+	@python3 $(TOP)/utils/face_power_budget.py $(POWER_BUDGET_FLAGS) \
+		$(if $(MOVEMENT_CONFIG),$(abspath $(MOVEMENT_CONFIG)),$(or $(FIRMWARE),STANDARD))
+
+ifneq ($(MAX_STANDBY_UA)$(MAX_ACTIVE_UA),)
+$(OBJS): | power-budget
+endif
+
+# Runs each of movement/alt_fw's profiles through a simulated day, and fails if one spends more than its baseline
+# (@see utils/power_regression.py). It builds for the green board, whatever COLOR is, as the baseline was.
+power-regression:
+	@python3 $(TOP)/utils/power_regression.py
+
+# Builds the headless simulator with the faces in utils/headless_tests/movement_config.h, and runs each script there;
+# a script fails when one of its expects isn't met (@see headless_main.c). They all start from the same moment, unless
+# one names its own in a "# start: YYYY-MM-DD HH:MM:SS" line.
+HEADLESS_TESTS = $(TOP)/utils/headless_tests
+
+headless-test:
+	@$(MAKE) --no-print-directory HEADLESS=1 MOVEMENT_CONFIG=$(HEADLESS_TESTS)/movement_config.h \
+		BUILD=$(BUILD)-headless-test all > /dev/null
+	@for script in $(HEADLESS_TESTS)/*.txt; do \
+		echo $$(basename $$script); \
+		start=$$(sed -n 's/^# start: //p' $$script); \
+		$(BUILD)-headless-test/$(BIN) -t "$${start:-2024-06-03 09:41:00}" $$script > /dev/null || exit 1; \
+	done
+
+# Builds movement/lib/calc's tests for this machine and runs them.
+HOST_CC ?= cc
+
+calc-test:
+	@mkdir -p $(BUILD)-calc-test
+	@$(HOST_CC) -Wall -Wextra -I$(TOP)/movement/lib/calc $(TOP)/movement/lib/calc/calc_number_test.c \
+		$(TOP)/movement/lib/calc/calc_number.c -o $(BUILD)-calc-test/calc_number_test
+	@$(BUILD)-calc-test/calc_number_test
 
 clean:
 	@echo clean
@@ -0,0 +1,211 @@
+#!/usr/bin/env python3
+# Estimates what a set of watch faces costs the battery, in µA, from what each face's source asks for: the tick rates
+# it requests, the sensors it reads and whether it runs in the background. It charges those at the rates in the
+# board's energy_costs.h, the same ones the simulator's energy model uses (watch_sim_energy.h), and prints the faces
+# that cost the most. make power-budget runs it on the configuration being built; give it MAX_STANDBY_UA or
+# MAX_ACTIVE_UA and the build fails when the estimate goes over.
+#
+# usage: face_power_budget.py [--board BOARD] [--max-standby-ua UA] [--max-active-ua UA] [--top N] CONFIG
+#
+# CONFIG is one of the alternate firmwares in movement/alt_fw, as make's FIRMWARE takes it (STANDARD, BACKER,
+# FOCUS...), or the path to a header laid out like movement_config.h.
+#
+# Faces don't declare what they use, so this reads it out of their source, and it can only see what's written out:
+# a tick rate given as a number or a #define, a sensor driver called by name. Standby is the first face on screen at
+# the rate it asks for when it's activated, with every background task running; active is the same with the face that
+# costs the most on screen at the fastest rate it ever asks for. Faces listed under an #if in the config all count.
+# Like the simulator's figures, these are for comparing configurations, not for promising a battery life.
+
+import argparse
+import os
+import re
+import sys
+
+ROOT = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..")
+MOVEMENT_DIR = os.path.join(ROOT, "movement")
+FACES_DIR = os.path.join(MOVEMENT_DIR, "watch_faces")
+
+# what a face is assumed to spend each time it handles a tick, on top of waking up.
+PIXELS_PER_TICK = 10
+I2C_BYTES_PER_READ = 8
+SPI_BYTES_PER_READ = 16
+ADC_CONVERSIONS_PER_READ = 1
+# calls that mean a face uses each resource.
+RESOURCES = {
+    "i2c": re.compile(r"\b(watch_i2c_\w+|lis2dw_\w+|opt3001_\w+|bmp280_\w+|bme280_\w+)\s*\("),
+    "spi": re.compile(r"\b(watch_spi_\w+|spi_flash_\w+)\s*\("),
+    "adc": re.compile(r"\b(watch_get_analog_pin_level|watch_get_vcc_voltage|thermistor_driver_get_temperature)\s*\("),
+    "buzzer": re.compile(r"\b(watch_buzzer_play\w*|movement_play_\w+)\s*\("),
+    "monotonic": re.compile(r"\bwatch_monotonic_start\s*\("),
+}
+TICK_REQUEST = re.compile(r"\bmovement_request_tick_frequency\s*\(")
+TICK_SUBSCRIPTION = re.compile(r"\bmovement_subscribe_ticks\s*\(")
+ENERGY_COST = re.compile(r"^\s*#define\s+(WATCH_ENERGY_\w+)\s+([0-9.]+)", re.MULTILINE)
+DEFINE = re.compile(r"^\s*#define\s+(\w+)\s+\(?\s*(\d+)\s*\)?\s*$", re.MULTILINE)
+COMMENT = re.compile(r"//[^\n]*|/\*.*?\*/", re.DOTALL)
+
+
+def read_source(path):
+    with open(path, errors="replace") as source:
+        return COMMENT.sub(" ", source.read())
+
+
+def config_path(config):
+    if config.endswith(".h"):
+        return config
+    if config == "STANDARD":
+        return os.path.join(MOVEMENT_DIR, "movement_config.h")
+    return os.path.join(MOVEMENT_DIR, "alt_fw", config.lower() + ".h")
+
+
+def read_config(path):
+    """Returns the names of the faces in a config's watch_faces[], in order."""
+    if not os.path.exists(path):
+        sys.exit("face_power_budget: no config at %s" % path)
+    match = re.search(r"watch_faces\s*\[\s*\]\s*=\s*\{(.*?)\}\s*;", read_source(path), re.DOTALL)
+    if match is None:
+        sys.exit("face_power_budget: %s has no watch_faces[]" % path)
+    return re.findall(r"^\s*(\w+)\s*,?\s*$", match.group(1), re.MULTILINE)
+
+
+def read_energy_costs(board):
+    path = os.path.join(ROOT, "boards", board, "energy_costs.h")
+    if not os.path.exists(path):
+        sys.exit("face_power_budget: board %s has no energy_costs.h" % board)
+    # where the header has a figure for the blue board too, the first one is the one to take.
+    costs = {}
+    for name, value in ENERGY_COST.findall(read_source(path)):
+        costs.setdefault(name, float(value))
+    return costs
+
+
+def find_face_headers():
+    """Maps each face's name to the header that defines its watch_face_t."""
+    headers = {}
+    for directory, _, files in os.walk(FACES_DIR):
+        for name in files:
+            if name.endswith(".h"):
+                path = os.path.join(directory, name)
+                for face in re.findall(r"#define\s+(\w+)\s+\(\(const watch_face_t\)", read_source(path)):
+                    headers[face] = path
+    return headers
+
+
+def call_arguments(source, pattern):
+    """Returns the argument text of each call that pattern finds, up to its closing parenthesis."""
+    arguments = []
+    for match in pattern.finditer(source):
+        depth, start = 1, match.end()
+        for end in range(start, len(source)):
+            depth += {"(": 1, ")": -1}.get(source[end], 0)
+            if depth == 0:
+                arguments.append(source[start:end])
+                break
+    return arguments
+
+
+def function_body(source, name):
+    match = re.search(r"\b%s\s*\([^)]*\)\s*\{" % re.escape(name), source)
+    if match is None:
+        return ""
+    depth = 1
+    for end in range(match.end(), len(source)):
+        depth += {"{": 1, "}": -1}.get(source[end], 0)
+        if depth == 0:
+            return source[match.end():end]
+    return ""
+
+
+def rates(arguments, defines):
+    """Returns every tick rate written out in the arguments, reading #defines and both sides of a ?:."""
+    found = []
+    for argument in arguments:
+        argument = argument.split(",")[-1]
+        for word in re.findall(r"\w+", argument):
+            if word.isdigit():
+                found.append(int(word))
+            elif word in defines:
+                found.append(defines[word])
+    return found
+
+
+class Face:
+    def __init__(self, name, header, costs):
+        self.name = name
+        source_path = os.path.splitext(header)[0] + ".c"
+        header_source = read_source(header)
+        source = header_source + (read_source(source_path) if os.path.exists(source_path) else "")
+        defines = {name: int(value) for name, value in DEFINE.findall(source)}
+
+        descriptor = re.search(r"#define\s+%s\s+\(\(const watch_face_t\)\{(.*?)\}\)" % re.escape(name), header_source,
+                               re.DOTALL)
+        entries = [entry.strip(" \\\n\t") for entry in descriptor.group(1).split(",")] if descriptor else []
+        self.background = len(entries) > 4 and entries[4] not in ("NULL", "0")
+        self.resources = [resource for resource, pattern in RESOURCES.items() if pattern.search(source)]
+
+        all_rates = rates(call_arguments(source, TICK_REQUEST), defines)
+        activate_rates = rates(call_arguments(function_body(source, name + "_activate"), TICK_REQUEST), defines)
+        # Movement ticks once a second unless a face asks otherwise, and a tickless face still wakes once a minute.
+        self.resting_hz = max(activate_rates) if activate_rates else 1
+        self.peak_hz = max(all_rates + [self.resting_hz])
+        subscriptions = rates(call_arguments(source, TICK_SUBSCRIPTION), defines)
+        self.subscribed_hz = max(subscriptions) if subscriptions else 0
+        if self.subscribed_hz:
+            self.resources.append("ticks")
+
+        read = (costs["WATCH_ENERGY_I2C_BYTE_UAS"] * I2C_BYTES_PER_READ if "i2c" in self.resources else 0) + \
+               (costs["WATCH_ENERGY_SPI_BYTE_UAS"] * SPI_BYTES_PER_READ if "spi" in self.resources else 0) + \
+               (costs["WATCH_ENERGY_ADC_CONVERSION_UAS"] * ADC_CONVERSIONS_PER_READ if "adc" in self.resources else 0)
+        tick = costs["WATCH_ENERGY_WAKE_UAS"] + costs["WATCH_ENERGY_PIXEL_UAS"] * PIXELS_PER_TICK + read
+        # µA·s each second is µA.
+        self.resting_ua = tick * (self.resting_hz or 1 / 60)
+        self.peak_ua = tick * (self.peak_hz or 1 / 60)
+        # a background task runs once a minute, while the watch is awake for the minute's tick anyway.
+        self.background_ua = (read / 60 if self.background else 0) + tick * self.subscribed_hz
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Estimate the current a set of watch faces draws.")
+    parser.add_argument("--board", default="OSO-SWAT-A1-05", help="the board, as make's BOARD takes it")
+    parser.add_argument("--max-standby-ua", type=float, help="fail if standby is estimated to draw more than this")
+    parser.add_argument("--max-active-ua", type=float, help="fail if active use is estimated to draw more than this")
+    parser.add_argument("--top", type=int, default=5, help="how many faces to list")
+    parser.add_argument("config", metavar="CONFIG")
+    args = parser.parse_args()
+
+    costs = read_energy_costs(args.board)
+    headers = find_face_headers()
+    faces = []
+    for name in read_config(config_path(args.config)):
+        if name not in headers:
+            sys.exit("face_power_budget: can't find where %s is defined" % name)
+        faces.append(Face(name, headers[name], costs))
+    if not faces:
+        sys.exit("face_power_budget: %s has no faces" % args.config)
+
+    background = sum(face.background_ua for face in faces)
+    standby = costs["WATCH_ENERGY_STANDBY_UA"] + background + faces[0].resting_ua
+    worst = max(faces, key=lambda face: face.peak_ua)
+    active = costs["WATCH_ENERGY_STANDBY_UA"] + background + worst.peak_ua
+
+    width = max([len(face.name) for face in faces] + [4])
+    print("%-*s  %5s  %10s  %10s  %s" % (width, "face", "Hz", "screen µA", "bg µA", "uses"))
+    # a face that's in the list more than once costs the same on screen each time, so it's only listed once.
+    listed = list({face.name: face for face in faces}.values())
+    for face in sorted(listed, key=lambda face: -(face.peak_ua + face.background_ua))[:args.top]:
+        print("%-*s  %5s  %10.3f  %10.3f  %s" % (width, face.name, face.peak_hz, face.peak_ua, face.background_ua,
+                                               " ".join(face.resources + (["background"] if face.background else []))))
+    print("standby: %.2f µA, with %s on screen" % (standby, faces[0].name))
+    print("active: %.2f µA, with %s on screen" % (active, worst.name))
+
+    over = []
+    if args.max_standby_ua is not None and standby > args.max_standby_ua:
+        over.append("standby is over its budget of %.2f µA" % args.max_standby_ua)
+    if args.max_active_ua is not None and active > args.max_active_ua:
+        over.append("active use is over its budget of %.2f µA" % args.max_active_ua)
+    if over:
+        sys.exit("face_power_budget: " + "; ".join(over))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,259 @@
+#!/usr/bin/env python3
+# Reports the flash and RAM each watch face takes up in a build, from the map file the linker writes alongside it
+# (make face-report does this for the firmware, and every firmware build prints the brief form). It counts what the
+# linker kept, after --gc-sections, so it shows the cost of the faces a configuration actually uses, with everything
+# else summed underneath.
+#
+# usage: face_size_report.py [--brief] MAP_FILE [ELF_FILE]
+#
+# Each face gets its text (code), rodata (constants), data (initialized variables, which take flash for their initial
+# values and RAM for themselves) and bss (zeroed variables). Given the ELF file as well, it reads each face's
+# context_size out of watch_faces[]: the context Movement sets aside for the face at boot, which is counted in
+# Movement's arena rather than the face's bss, or comes from the heap in setup if the arena is full. The memory the
+# linker had to work with comes from the map, so the totals show how much flash is left, and how much RAM is left for
+# the heap and the stack.
+#
+# The libraries under movement/lib get a line each, apart from Movement, since one that a face pulls in can cost more
+# than several faces; any that takes up more than HEAVY_SHARE of the flash is flagged. The report is saved next to the
+# map (as .sizes.json), and the next one shows what changed against it. --brief prints only what changed, the heavy
+# libraries and the totals.
+
+import json
+import os
+import re
+import struct
+import sys
+
+# input sections, by what they hold; initialized data (and code run from RAM) is copied from flash at boot.
+TEXT_SECTIONS = (".text", ".vectors")
+RODATA_SECTIONS = (".rodata",)
+DATA_SECTIONS = (".data", ".relocate")
+BSS_SECTIONS = (".bss", "COMMON")
+COLUMNS = ("text", "rodata", "data", "bss")
+# an input section's line: its name (unless it was too long and went on the line above), address, size and file.
+INPUT_SECTION = re.compile(r"^ (\S+)?\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)\s+(\S+)$")
+# a global symbol's line, under the input section it's in: its address and name.
+SYMBOL = re.compile(r"^\s+0x([0-9a-f]+)\s+(\S+)$")
+# a region in the map's memory configuration: name, origin and length.
+MEMORY_REGION = re.compile(r"^(\S+)\s+0x([0-9a-f]+)\s+0x([0-9a-f]+)")
+MOVEMENT = "Movement and watch library"
+C_LIBRARY = "C library"
+HEAVY_SHARE = 0.05
+LIBRARY_DIRECTORY = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "movement", "lib")
+
+
+def find_libraries():
+    """Returns {object file name: library}, for each source file under movement/lib."""
+    libraries = {}
+    for directory, _, files in os.walk(LIBRARY_DIRECTORY):
+        library = os.path.relpath(directory, LIBRARY_DIRECTORY).split(os.sep)[0]
+        for name in files:
+            if name.endswith(".c"):
+                libraries[name[:-2] + ".o"] = "lib/" + library
+    return libraries
+
+
+LIBRARIES = find_libraries()
+
+
+def classify(section):
+    """Returns the column an input section is counted in, or None if it takes up no memory on the watch."""
+    # code that runs from RAM takes flash for its copy and RAM for itself, like initialized data.
+    if section == ".ramfunc" or section.startswith(".ramfunc."):
+        return "data"
+    for names, column in ((TEXT_SECTIONS, "text"), (RODATA_SECTIONS, "rodata"), (DATA_SECTIONS, "data"),
+                          (BSS_SECTIONS, "bss")):
+        for name in names:
+            if section == name or section.startswith(name + "."):
+                return column
+    return None
+
+
+def is_face(name):
+    return name.endswith("_face") or "_face_" in name
+
+
+def owner(path):
+    """Groups an object file with a face, a library, Movement and the watch library, or the C library."""
+    if "(" in path or path.endswith(".a"):
+        return C_LIBRARY
+    if os.path.basename(path) in LIBRARIES:
+        return LIBRARIES[os.path.basename(path)]
+    name = os.path.splitext(os.path.basename(path))[0]
+    return name if is_face(name) else MOVEMENT
+
+
+def read_map(path):
+    """Returns ({owner: {column: bytes}}, [(address, size, owner, section)], {region: (origin, length)}, and the address
+    and size of watch_faces[] or None)."""
+    owners = {}
+    sections = []
+    regions = {}
+    table = None
+    with open(path) as map_file:
+        lines = iter(map_file)
+        for line in lines:
+            if line.startswith("Memory Configuration"):
+                break
+        for line in lines:
+            if line.startswith("Linker script and memory map"):
+                break
+            match = MEMORY_REGION.match(line)
+            if match and match.group(1) not in ("Name", "*default*"):
+                regions[match.group(1)] = (int(match.group(2), 16), int(match.group(3), 16))
+        pending_section = None
+        for line in lines:
+            line = line.rstrip("\n")
+            match = INPUT_SECTION.match(line)
+            symbol = SYMBOL.match(line) if match is None else None
+            if symbol and symbol.group(2) == "watch_faces" and sections:
+                # the table runs to the end of its input section, which -fdata-sections gives it to itself.
+                address = int(symbol.group(1), 16)
+                table = (address, sections[-1][0] + sections[-1][1] - address)
+            if match is None:
+                # a long section name gets a line to itself, with the rest on the next line.
+                stripped = line.strip()
+                pending_section = stripped if line.startswith(" ") and stripped and " " not in stripped else None
+                continue
+            section = match.group(1) or pending_section
+            pending_section = None
+            address, size, path = int(match.group(2), 16), int(match.group(3), 16), match.group(4)
+            if section is None or size == 0:
+                continue
+            sections.append((address, size, owner(path), section))
+            column = classify(section)
+            if column is None:
+                continue
+            entry = owners.setdefault(owner(path), dict.fromkeys(COLUMNS, 0))
+            entry[column] += size
+    return owners, sections, regions, table
+
+
+def read_elf(path, address, size):
+    """Returns the bytes a loadable section of an ELF file holds at an address, the size of a pointer, and the byte
+    order, for struct."""
+    with open(path, "rb") as elf:
+        data = elf.read()
+    if data[:4] != b"\x7fELF":
+        raise ValueError("%s isn't an ELF file" % path)
+    wide = data[4] == 2
+    order = "<" if data[5] == 1 else ">"
+    if wide:
+        shoff, = struct.unpack_from(order + "Q", data, 0x28)
+        shentsize, shnum = struct.unpack_from(order + "HH", data, 0x3A)
+        header = order + "IIQQQQ"
+    else:
+        shoff, = struct.unpack_from(order + "I", data, 0x20)
+        shentsize, shnum = struct.unpack_from(order + "HH", data, 0x2E)
+        header = order + "IIIIII"
+    for i in range(shnum):
+        _, kind, _, section_address, offset, section_size = struct.unpack_from(header, data, shoff + i * shentsize)
+        # SHT_PROGBITS: a section with contents in the file.
+        if kind == 1 and section_address <= address and address + size <= section_address + section_size:
+            start = offset + address - section_address
+            return data[start:start + size], (8 if wide else 4), order
+    raise ValueError("nothing in %s at 0x%x" % (path, address))
+
+
+def read_context_sizes(elf_path, sections, table):
+    """Returns {face: context_size}, from watch_faces[] and the face each entry's setup function belongs to."""
+    if table is None:
+        return {}
+    data, pointer, order = read_elf(elf_path, *table)
+    # watch_face_t: five function pointers, then size_t context_size and uint8_t flags, padded to a pointer, then the
+    # draw_low_energy pointer.
+    stride = 8 * pointer
+    code = [entry for entry in sections if classify(entry[3]) == "text"]
+    sizes = {}
+    for start in range(0, len(data) - stride + 1, stride):
+        setup, = struct.unpack_from(order + ("Q" if pointer == 8 else "I"), data, start)
+        context_size, = struct.unpack_from(order + ("Q" if pointer == 8 else "I"), data, start + 5 * pointer)
+        # a Thumb function's address has its low bit set, which still lands within its code.
+        for section_address, section_size, name, _ in code:
+            if section_address <= setup < section_address + section_size:
+                sizes[name] = sizes.get(name, 0) + context_size
+                break
+    return sizes
+
+
+def signed(value):
+    return "%+d" % value if value else ""
+
+
+def main():
+    arguments = sys.argv[1:]
+    brief = "--brief" in arguments
+    arguments = [argument for argument in arguments if argument != "--brief"]
+    if len(arguments) not in (1, 2):
+        sys.exit("usage: %s [--brief] MAP_FILE [ELF_FILE]" % sys.argv[0])
+    map_path = arguments[0]
+    saved_path = os.path.splitext(map_path)[0] + ".sizes.json"
+
+    owners, sections, regions, table = read_map(map_path)
+    contexts = read_context_sizes(arguments[1], sections, table) if len(arguments) == 2 else {}
+    report = {name: dict(entry, context=contexts.get(name, 0)) for name, entry in owners.items()}
+    previous = {}
+    if os.path.exists(saved_path):
+        with open(saved_path) as saved:
+            previous = json.load(saved).get("owners", {})
+    with open(saved_path, "w") as saved:
+        json.dump({"owners": report}, saved, indent=1, sort_keys=True)
+
+    def flash(entry):
+        return entry["text"] + entry["rodata"] + entry["data"]
+
+    def ram(entry):
+        return entry["data"] + entry["bss"]
+
+    faces = sorted((name for name in report if is_face(name) and flash(report[name]) + ram(report[name])),
+                   key=lambda name: -flash(report[name]))
+    libraries = sorted((name for name in report if name.startswith("lib/")), key=lambda name: -flash(report[name]))
+    others = [name for name in (MOVEMENT, C_LIBRARY) if name in report]
+    gone = sorted(name for name in previous if name not in report)
+    columns = COLUMNS + (("context",) if contexts else ())
+    width = max([len(name) for name in faces + libraries + others + gone] + [24])
+    used = sum(flash(entry) for entry in report.values())
+
+    def total(names, source):
+        return {column: sum(source[name].get(column, 0) for name in names) for column in columns}
+
+    lines = []
+
+    def row(name, entry, before, flag=""):
+        cells = "".join("  %8d" % entry[column] for column in columns)
+        change = flag
+        if before is not None:
+            change += signed(flash(entry) - flash(before)) + " flash " if flash(entry) != flash(before) else ""
+            change += signed(ram(entry) - ram(before)) + " RAM" if ram(entry) != ram(before) else ""
+        elif previous:
+            change += "new"
+        if not brief or change:
+            lines.append("%-*s%s  %8d  %8d  %s" % (width, name, cells, flash(entry), ram(entry), change.strip()))
+
+    for name in faces:
+        row(name, report[name], previous.get(name))
+    for name in gone:
+        lines.append("%-*s  gone, %+d flash %+d RAM" % (width, name, -flash(previous[name]), -ram(previous[name])))
+    row("all faces", total(faces, report), total([name for name in previous if is_face(name)], previous) if previous else None)
+    for name in libraries:
+        share = flash(report[name]) / used if used else 0
+        row(name, report[name], previous.get(name), "heavy, %.0f%% of flash " % (100 * share) if share > HEAVY_SHARE else "")
+    for name in others:
+        row(name, report[name], previous.get(name))
+    everything = total(list(report), report)
+    if not brief:
+        lines.append("%-*s%s  %8d  %8d" % (width, "total", "".join("  %8d" % everything[column] for column in columns),
+                                           flash(everything), ram(everything)))
+
+    if lines:
+        print("%-*s%s  %8s  %8s" % (width, "face", "".join("  %8s" % column for column in columns), "flash", "RAM"))
+        print("\n".join(line.rstrip() for line in lines))
+    if "rom" in regions and "ram" in regions:
+        rom_size, ram_size = regions["rom"][1], regions["ram"][1]
+        print("flash: %d of %d bytes, %d left; RAM: %d of %d bytes, %d left for the heap and stack" %
+              (flash(everything), rom_size, rom_size - flash(everything), ram(everything), ram_size,
+               ram_size - ram(everything)))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,221 @@
+#!/usr/bin/env python3
+# Makes firmware updates that only carry what changed, for watches already running a known release (see
+# movement/movement_update.h for the other end, and sensorwatch_rpc.py's update command to send one).
+#
+# usage: firmware_delta.py make OLD.bin NEW.bin OUT.delta
+#        firmware_delta.py info FILE.delta
+#
+# The .bin files are the ones the build leaves next to the .uf2; "make delta BASE=OLD.bin" in a firmware directory
+# runs the first form on the firmware it just built. A delta is a header (the magic "SWD1", then the old image's size
+# and CRC-32, then the new image's, all u32 little-endian) and a run of ops that build the new image front to back:
+#
+#   op byte: top two bits 0 for literal bytes, 1 to copy from the old image, 2 to copy from earlier in the new one;
+#            low six bits the length less one, or 63 for a varint (7 bits a byte, low first) of the length less 64.
+#   literal: the bytes follow.
+#   copy from the old image: a varint of the zigzagged distance from the current position to the source.
+#   copy from the new image: a varint of how far back the source is.
+
+import binascii
+import struct
+import sys
+
+MAGIC = b"SWD1"
+HEADER = struct.Struct("<4sIIII")
+LITERAL, COPY_BASE, COPY_IMAGE = 0, 1, 2
+LENGTH_FOLLOWS = 63
+KEY = 4              # bytes hashed to find matches
+CANDIDATES = 24      # matches tried at each position
+MAX_COPY = 4096      # the watch writes each copy out before taking the next byte; keep that short
+# how much new image one request may build: the watch writes about 30 rows of flash a second, and answers in two.
+MAX_OUTPUT_PER_CHUNK = 8192
+
+
+def varint(value):
+    out = bytearray()
+    while True:
+        byte = value & 0x7F
+        value >>= 7
+        if value:
+            out.append(byte | 0x80)
+        else:
+            out.append(byte)
+            return bytes(out)
+
+
+def zigzag(value):
+    return value * 2 if value >= 0 else -value * 2 - 1
+
+
+def op(kind, length):
+    if length <= LENGTH_FOLLOWS:
+        return bytes([kind << 6 | (length - 1)])
+    return bytes([kind << 6 | LENGTH_FOLLOWS]) + varint(length - LENGTH_FOLLOWS - 1)
+
+
+def match_length(source, start, target, position, limit):
+    length = 0
+    while length < limit:
+        step = min(32, limit - length)
+        if source[start + length:start + length + step] == target[position + length:position + length + step]:
+            length += step
+            continue
+        while length < limit and source[start + length] == target[position + length]:
+            length += 1
+        break
+    return length
+
+
+def encode(old, new):
+    old_index = {}
+    for i in range(len(old) - KEY + 1):
+        old_index.setdefault(old[i:i + KEY], []).append(i)
+    new_index = {}
+    out = bytearray()
+    literal = bytearray()
+    shift = 0  # where the last copy from the old image came from, relative to where it went
+    position = 0
+
+    def flush_literal():
+        for start in range(0, len(literal), MAX_COPY):
+            piece = literal[start:start + MAX_COPY]
+            out.extend(op(LITERAL, len(piece)) + piece)
+        literal.clear()
+
+    while position < len(new):
+        limit = min(MAX_COPY, len(new) - position)
+        best = (0, None, 0)  # length, kind, source
+        key = new[position:position + KEY]
+        # code that's only moved is most likely where the last copy left off.
+        candidates = [(COPY_BASE, position + shift)]
+        candidates += [(COPY_BASE, i) for i in old_index.get(key, [])[-CANDIDATES:]]
+        candidates += [(COPY_IMAGE, i) for i in new_index.get(key, [])[-CANDIDATES:]]
+        for kind, source in candidates:
+            if kind == COPY_BASE and not 0 <= source < len(old):
+                continue
+            length = match_length(old if kind == COPY_BASE else new, source, new, position,
+                                  min(limit, len(old) - source) if kind == COPY_BASE else limit)
+            if length > best[0]:
+                best = (length, kind, source)
+        length, kind, source = best
+        if kind is not None:
+            argument = zigzag(source - position) if kind == COPY_BASE else position - source
+            cost = len(op(kind, length)) + len(varint(argument))
+        if kind is None or length <= cost:
+            literal.append(new[position])
+            if len(new) - position >= KEY:
+                new_index.setdefault(new[position:position + KEY], []).append(position)
+            position += 1
+            continue
+        flush_literal()
+        out.extend(op(kind, length) + varint(argument))
+        if kind == COPY_BASE:
+            shift = source - position
+        for i in range(position, min(position + length, len(new) - KEY + 1)):
+            new_index.setdefault(new[i:i + KEY], []).append(i)
+        position += length
+    flush_literal()
+
+    header = HEADER.pack(MAGIC, len(old), binascii.crc32(old), len(new), binascii.crc32(new))
+    return header + bytes(out)
+
+
+def parse_header(delta):
+    magic, base_size, base_crc, size, crc = HEADER.unpack(delta[:HEADER.size])
+    if magic != MAGIC:
+        raise ValueError("not a firmware delta")
+    return base_size, base_crc, size, crc
+
+
+def ops(delta):
+    """Yields (kind, length, argument or literal bytes, end of the op in the delta) for each op."""
+    i = HEADER.size
+
+    def read_varint():
+        nonlocal i
+        value, shift = 0, 0
+        while True:
+            byte = delta[i]
+            i += 1
+            value |= (byte & 0x7F) << shift
+            shift += 7
+            if not byte & 0x80:
+                return value
+
+    while i < len(delta):
+        byte = delta[i]
+        i += 1
+        kind, length = byte >> 6, (byte & 0x3F) + 1
+        if length == LENGTH_FOLLOWS + 1:
+            length = read_varint() + LENGTH_FOLLOWS + 1
+        if kind == LITERAL:
+            argument = delta[i:i + length]
+            i += length
+        elif kind in (COPY_BASE, COPY_IMAGE):
+            argument = read_varint()
+        else:
+            raise ValueError("bad op at %d" % (i - 1))
+        yield kind, length, argument, i
+
+
+def apply(old, delta):
+    base_size, base_crc, size, crc = parse_header(delta)
+    if len(old) != base_size or binascii.crc32(old) != base_crc:
+        raise ValueError("the delta wasn't made against this image")
+    new = bytearray()
+    for kind, length, argument, _ in ops(delta):
+        if kind == LITERAL:
+            new += argument
+        elif kind == COPY_BASE:
+            source = len(new) + (argument >> 1 if not argument & 1 else -((argument + 1) >> 1))
+            new += old[source:source + length]
+        else:
+            for _ in range(length):
+                new.append(new[len(new) - argument])
+    if len(new) != size or binascii.crc32(new) != crc:
+        raise ValueError("the delta doesn't make the image it should")
+    return bytes(new)
+
+
+def chunks(delta, max_data):
+    """Splits the ops into pieces of at most max_data bytes, each building at most about MAX_OUTPUT_PER_CHUNK bytes of
+    the new image; yields (offset in the op stream, piece)."""
+    start = HEADER.size
+    output = 0
+    end = start
+    for kind, length, _, op_end in ops(delta):
+        # a long literal can be split anywhere, so only whole copies need to stay together.
+        while op_end - start > max_data or (output + length > MAX_OUTPUT_PER_CHUNK and end > start):
+            cut = end if end > start else start + max_data
+            yield start - HEADER.size, delta[start:cut]
+            output = 0
+            start = cut
+        end = op_end
+        output += length
+    if end > start:
+        yield start - HEADER.size, delta[start:end]
+
+
+def main():
+    if len(sys.argv) == 5 and sys.argv[1] == "make":
+        with open(sys.argv[2], "rb") as f:
+            old = f.read()
+        with open(sys.argv[3], "rb") as f:
+            new = f.read()
+        delta = encode(old, new)
+        apply(old, delta)
+        with open(sys.argv[4], "wb") as f:
+            f.write(delta)
+        print("%s: %d bytes for a %d byte image (%.1f%%)" % (sys.argv[4], len(delta), len(new),
+                                                             100 * len(delta) / len(new)))
+    elif len(sys.argv) == 3 and sys.argv[1] == "info":
+        with open(sys.argv[2], "rb") as f:
+            delta = f.read()
+        base_size, base_crc, size, crc = parse_header(delta)
+        print("from a %d byte image (CRC %08x) to a %d byte image (CRC %08x), in %d bytes" %
+              (base_size, base_crc, size, crc, len(delta)))
+    else:
+        sys.exit("usage: %s make OLD.bin NEW.bin OUT.delta\n       %s info FILE.delta" % (sys.argv[0], sys.argv[0]))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,158 @@
+#!/usr/bin/env python3
+# Generates watch_display_glyphs.h: for every display position and every printable character, the final segment
+# bits that watch_display_character should leave on each COM line. The tables are derived from Segment_Map and
+# Character_Set in watch_private_display.h, so rendering a character on the watch is a lookup and a mask merge
+# rather than a chain of position-specific substitutions followed by a segment-by-segment loop.
+#
+# usage: gen_display_glyphs.py path/to/watch_private_display.h path/to/watch_display_glyphs.h
+
+import re
+import sys
+
+NUM_COMS = 3
+FIRST_CHAR = 0x20
+LAST_CHAR = 0x7E
+
+
+def parse_array(source, name):
+    match = re.search(r"\b" + name + r"\[\]\s*=\s*\{(.*?)\};", source, re.S)
+    if match is None:
+        sys.exit("gen_display_glyphs: could not find %s" % name)
+    body = re.sub(r"//[^\n]*", "", match.group(1))
+    return [int(token.replace("0b", ""), 2) if token.startswith("0b") else int(token, 16)
+            for token in (t.strip() for t in body.split(",")) if token]
+
+
+def remap(character, position):
+    # Not every glyph can be drawn in every position, so some characters are swapped for a close substitute
+    # (i.e. lowercase 'n' for 'M' in the hours and minutes). These are the rules watch_display_character used
+    # to apply at runtime.
+    c = chr(character)
+    if position == 4 or position == 6:
+        c = {'7': '&', 'A': 'a', 'o': 'O', 'L': '!', 'M': 'n', 'm': 'n', 'N': 'n', 'c': 'C', 'J': 'j',
+             'v': 'u', 'V': 'u', 'U': 'u', 'W': 'u', 'w': 'u'}.get(c, c)
+    else:
+        c = {'u': 'v', 'j': 'J'}.get(c, c)
+    if position > 1 and c == 'T':
+        c = 't'
+    if position == 1:
+        c = {'a': 'A', 'o': 'O', 'i': 'l', 'n': 'N', 'r': 'R', 'd': 'D', 'v': 'U', 'V': 'U', 'u': 'U',
+             'b': 'B', 'c': 'C'}.get(c, c)
+    elif c == 'R':
+        c = 'r'
+    if position != 0 and c == 'I':
+        c = 'l'
+    return ord(c)
+
+
+def render(segment_map, character_set, character, position):
+    """Returns the per-COM segment bits for a character, and the per-COM mask of segments the position owns."""
+    bits = [0] * NUM_COMS
+    mask = [0] * NUM_COMS
+
+    def write(com, seg, on):
+        mask[com] |= 1 << seg
+        if on:
+            bits[com] |= 1 << seg
+        else:
+            bits[com] &= ~(1 << seg)
+
+    character = remap(character, position)
+    if position == 0:
+        write(0, 15, False)  # funky ninth segment
+
+    segmap = segment_map[position]
+    segdata = character_set[character - FIRST_CHAR]
+    for _ in range(8):
+        com = (segmap & 0xFF) >> 6
+        if com < NUM_COMS:
+            write(com, segmap & 0x3F, segdata & 1)
+        segmap >>= 8
+        segdata >>= 1
+
+    if chr(character) == 'T' and position == 1:
+        write(1, 12, True)  # descender
+    elif position == 0 and chr(character) in "BD@":
+        write(0, 15, True)
+    elif position == 1 and chr(character) in "BD@":
+        write(0, 12, True)
+
+    return bits, mask
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit("usage: %s watch_private_display.h watch_display_glyphs.h" % sys.argv[0])
+
+    with open(sys.argv[1]) as f:
+        source = f.read()
+    segment_map = parse_array(source, "Segment_Map")
+    character_set = parse_array(source, "Character_Set")
+    if len(character_set) != LAST_CHAR - FIRST_CHAR + 1:
+        sys.exit("gen_display_glyphs: expected %d entries in Character_Set, found %d" %
+                 (LAST_CHAR - FIRST_CHAR + 1, len(character_set)))
+
+    masks = []
+    shifts = []
+    glyphs = []
+    for position in range(len(segment_map)):
+        position_mask = [0] * NUM_COMS
+        position_glyphs = []
+        for character in range(FIRST_CHAR, LAST_CHAR + 1):
+            bits, mask = render(segment_map, character_set, character, position)
+            position_mask = [a | b for a, b in zip(position_mask, mask)]
+            position_glyphs.append(bits)
+        # store each position's bits relative to its lowest segment so that every COM line fits in 16 bits.
+        lowest = min((m & -m).bit_length() - 1 for m in position_mask if m)
+        if any((m >> lowest) > 0xFFFF for m in position_mask):
+            sys.exit("gen_display_glyphs: position %d spans more than 16 segments" % position)
+        shifts.append(lowest)
+        masks.append([m >> lowest for m in position_mask])
+        glyphs.append([[b >> lowest for b in bits] for bits in position_glyphs])
+
+    num_chars = len(segment_map)
+    out = []
+    out.append("// This file is generated by utils/gen_display_glyphs.py from watch_private_display.h. Do not edit.")
+    out.append("#ifndef _WATCH_DISPLAY_GLYPHS_H_INCLUDED")
+    out.append("#define _WATCH_DISPLAY_GLYPHS_H_INCLUDED")
+    out.append("")
+    out.append("#include <stdint.h>")
+    out.append("")
+    out.append("#define WATCH_DISPLAY_GLYPH_FIRST_CHAR 0x%02X" % FIRST_CHAR)
+    out.append("#define WATCH_DISPLAY_GLYPH_LAST_CHAR 0x%02X" % LAST_CHAR)
+    out.append("#define WATCH_DISPLAY_GLYPH_NUM_CHARS %d" % (LAST_CHAR - FIRST_CHAR + 1))
+    out.append("")
+    out.append("// Lowest segment number used by each position; glyph and mask bits are stored relative to it.")
+    out.append("static const uint8_t Glyph_Position_Shift[%d] = { %s };" %
+               (num_chars, ", ".join(str(s) for s in shifts)))
+    out.append("")
+    out.append("// Segments owned by each position, per COM line.")
+    out.append("static const uint16_t Glyph_Position_Masks[%d][%d] = {" % (num_chars, NUM_COMS))
+    for position, mask in enumerate(masks):
+        out.append("    { %s }, // Position %d" % (", ".join("0x%04x" % m for m in mask), position))
+    out.append("};")
+    out.append("")
+    out.append("// Number of segments owned by each position.")
+    out.append("static const uint8_t Glyph_Position_Segment_Counts[%d] = { %s };" %
+               (num_chars, ", ".join(str(sum(bin(m).count("1") for m in mask)) for mask in masks)))
+    out.append("")
+    out.append("// Final segment bits for each [position][character - 0x%02X], per COM line." % FIRST_CHAR)
+    out.append("static const uint16_t Glyph_Table[%d][%d][%d] = {" % (num_chars, LAST_CHAR - FIRST_CHAR + 1, NUM_COMS))
+    for position in range(num_chars):
+        out.append("    { // Position %d" % position)
+        for index, bits in enumerate(glyphs[position]):
+            character = chr(FIRST_CHAR + index)
+            label = "backslash" if character == "\\" else character
+            out.append("        { %s }, // %s" % (", ".join("0x%04x" % b for b in bits), label))
+        out.append("    },")
+    out.append("};")
+    out.append("")
+    out.append("#endif")
+    out.append("")
+
+    with open(sys.argv[2], "w") as f:
+        f.write("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
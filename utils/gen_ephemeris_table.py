@@ -0,0 +1,229 @@
+#!/usr/bin/env python3
+# Generates ephemeris_table.h: Chebyshev fits of the VSOP87A (milli) positions of the planets and the Moon over a
+# fixed span of years. Looking a position up in the table costs a couple of dozen multiply-adds per axis, where the
+# series in vsop87a_milli.c cost hundreds of soft-float cosines, and a firmware that only needs dates inside the span
+# can leave the series out altogether. The terms are read straight from vsop87a_milli.c, so the fit reproduces
+# exactly what the watch would otherwise compute.
+#
+# Each body is split into equal segments and each axis of each segment gets its own polynomial. The segment length
+# is the longest that keeps the fit within the body's tolerance, which is about one arcsecond as seen from Earth at
+# the body's closest approach (about two kilometres for the Moon).
+#
+# The coefficients are stored as whole multiples of a quantum, an eighth of the tolerance split over the coefficients,
+# and bit-packed: each coefficient of each axis is stored as its distance from the smallest value it takes in any
+# segment, in just as many bits as the largest distance needs. The higher coefficients are tiny, so most of them fit in
+# a few bits, and the table comes out well under half the size it would be as floats. Every segment takes the same
+# number of bits, so ephemeris.c can still go straight to the one it wants.
+#
+# usage: gen_ephemeris_table.py path/to/vsop87a_milli.c path/to/ephemeris_table.h [FIRST_YEAR LAST_YEAR]
+
+import math
+import re
+import sys
+
+J2000 = 2451545.0
+DAYS_PER_MILLENNIUM = 365250.0
+EARTH_MOON_MASS_RATIO = 0.01230073677  # as in vsop87a_milli_getMoon
+MOON_SCALE = 1 + 1 / EARTH_MOON_MASS_RATIO
+
+# name in the table, VSOP87 series name, number of coefficients per axis, tolerance in AU. The Earth is not fitted
+# on its own: it wobbles around the Earth-Moon barycenter once a month, so it is rebuilt from the barycenter (a slow,
+# smooth orbit) and the Moon's geocentric position, which the Moon needs anyway.
+BODIES = [
+    ("MERCURY", "mercury", 18, 2.5e-6),
+    ("VENUS", "venus", 12, 8.0e-7),
+    ("EMB", "emb", 12, 1.0e-6),
+    ("MARS", "mars", 12, 1.5e-6),
+    ("JUPITER", "jupiter", 10, 1.9e-5),
+    ("SATURN", "saturn", 10, 4.0e-5),
+    ("URANUS", "uranus", 10, 8.0e-5),
+    ("NEPTUNE", "neptune", 10, 1.4e-4),
+    ("MOON", "moon", 18, 1.2e-8),
+]
+
+
+def julian_date(year):
+    """Julian date of 0h UTC on January 1 of a Gregorian year."""
+    y = year - 1
+    return math.floor(365.25 * (y + 4716)) + math.floor(30.6001 * 14) + 1 + 2 - y // 100 + y // 400 - 1524.5
+
+
+def parse_series(path):
+    with open(path) as f:
+        source = f.read()
+    series = {}
+    pattern = r"(\w+)_([xyz])_(\d)\+=\s*([-\d.]+) \* cos\(\s*([-\d.]+) \+\s*([-\d.]+)\*t\);"
+    for name, axis, power, a, b, c in re.findall(pattern, source):
+        series.setdefault(name, {}).setdefault(axis, []).append((int(power), float(a), float(b), float(c)))
+    if "earth" not in series or "emb" not in series:
+        sys.exit("gen_ephemeris_table: could not find the VSOP87 series in %s" % path)
+    return series
+
+
+def vsop(series, name, t):
+    terms = series[name]
+    return [sum(a * math.cos(b + c * t) * t ** power for power, a, b, c in terms.get(axis, [])) for axis in "xyz"]
+
+
+def position(series, name, jd):
+    t = (jd - J2000) / DAYS_PER_MILLENNIUM
+    if name == "moon":
+        # geocentric, i.e. vsop87a_milli_getMoon minus the Earth.
+        earth = vsop(series, "earth", t)
+        emb = vsop(series, "emb", t)
+        return [(m - e) * MOON_SCALE for m, e in zip(emb, earth)]
+    return vsop(series, name, t)
+
+
+def chebyshev_fit(values):
+    """Coefficients of the polynomial through values sampled at the Chebyshev nodes."""
+    n = len(values)
+    coefficients = [2.0 / n * sum(v * math.cos(math.pi * j * (k + 0.5) / n) for k, v in enumerate(values))
+                    for j in range(n)]
+    coefficients[0] /= 2
+    return coefficients
+
+
+def chebyshev_evaluate(coefficients, x):
+    # Clenshaw's recurrence, the same as ephemeris_get_body.
+    b1 = b2 = 0.0
+    for c in reversed(coefficients[1:]):
+        b1, b2 = 2 * x * b1 - b2 + c, b1
+    return x * b1 - b2 + coefficients[0]
+
+
+def fit_segment(series, name, start, days, n, quantum):
+    nodes = [math.cos(math.pi * (k + 0.5) / n) for k in range(n)]
+    samples = [position(series, name, start + days * (x + 1) / 2) for x in nodes]
+    coefficients = [chebyshev_fit([s[axis] for s in samples]) for axis in range(3)]
+    # the error peaks between the nodes, so check there, with the coefficients quantized as they're stored.
+    stored = [[round(c / quantum) for c in axis] for axis in coefficients]
+    error = 0
+    for k in range(2 * n + 1):
+        x = -1 + 2 * k / (2 * n)
+        truth = position(series, name, start + days * (x + 1) / 2)
+        fitted = [chebyshev_evaluate([c * quantum for c in axis], x) for axis in stored]
+        error = max(error, math.sqrt(sum((a - b) ** 2 for a, b in zip(truth, fitted))))
+    return stored, error
+
+
+def float_round(value):
+    if value == 0:
+        return 0.0
+    exponent = math.floor(math.log2(abs(value)))
+    quantum = 2.0 ** (exponent - 23)
+    return round(value / quantum) * quantum
+
+
+def quantum_for(n, tolerance):
+    # with |T_i(x)| <= 1, rounding each coefficient moves the sum by at most n * quantum / 2: an eighth of the tolerance.
+    return float_round(tolerance / (4 * n))
+
+
+def fit_body(series, name, n, tolerance, first_jd, last_jd):
+    """Returns (segment_days, segments) for the longest whole-day segment that stays within tolerance, with each
+    segment's coefficients as multiples of quantum_for(n, tolerance)."""
+    quantum = quantum_for(n, tolerance)
+    span = last_jd - first_jd
+    best = None
+    low, high = 1, int(span)
+    while low <= high:
+        days = (low + high) // 2
+        count = math.ceil(span / days)
+        segments = []
+        for i in range(count):
+            stored, error = fit_segment(series, name, first_jd + i * days, days, n, quantum)
+            if error > tolerance:
+                break
+            segments.append(stored)
+        else:
+            best = (days, segments)
+            low = days + 1
+            continue
+        high = days - 1
+    if best is None:
+        sys.exit("gen_ephemeris_table: could not fit %s within %g AU" % (name, tolerance))
+    return best
+
+
+def pack(segments, n):
+    """Returns the base and bit width of each axis' coefficients, and the segments packed into 32-bit words."""
+    bases = [[min(segment[axis][i] for segment in segments) for i in range(n)] for axis in range(3)]
+    widths = [[(max(segment[axis][i] for segment in segments) - bases[axis][i]).bit_length() for i in range(n)]
+              for axis in range(3)]
+    # least significant bit first, as ephemeris.c reads them.
+    stream = 0
+    length = 0
+    for segment in segments:
+        for axis in range(3):
+            for i in range(n):
+                stream |= (segment[axis][i] - bases[axis][i]) << length
+                length += widths[axis][i]
+    words = [(stream >> (32 * k)) & 0xFFFFFFFF for k in range((length + 31) // 32)]
+    return bases, widths, words
+
+
+def main():
+    if len(sys.argv) not in (3, 5):
+        sys.exit("usage: %s vsop87a_milli.c ephemeris_table.h [FIRST_YEAR LAST_YEAR]" % sys.argv[0])
+    first_year, last_year = (int(sys.argv[3]), int(sys.argv[4])) if len(sys.argv) == 5 else (2024, 2043)
+    first_jd = julian_date(first_year)
+    last_jd = julian_date(last_year + 1)
+    series = parse_series(sys.argv[1])
+
+    out = []
+    out.append("// This file is generated by utils/gen_ephemeris_table.py from vsop87a_milli.c. Do not edit.")
+    out.append("#ifndef EPHEMERIS_TABLE_H_")
+    out.append("#define EPHEMERIS_TABLE_H_")
+    out.append("")
+    out.append("#include <stdint.h>")
+    out.append("")
+    out.append("// Valid from 0h TT on January 1, %d until 0h TT on January 1, %d." % (first_year, last_year + 1))
+    out.append("#define EPHEMERIS_FIRST_YEAR %d" % first_year)
+    out.append("#define EPHEMERIS_LAST_YEAR %d" % last_year)
+    out.append("#define EPHEMERIS_FIRST_JD %.1f" % first_jd)
+    out.append("#define EPHEMERIS_LAST_JD %.1f" % last_jd)
+    out.append("#define EPHEMERIS_EARTH_MOON_MASS_RATIO %.11f" % EARTH_MOON_MASS_RATIO)
+    out.append("#define EPHEMERIS_MAX_COEFFICIENTS %d" % max(n for _, _, n, _ in BODIES))
+    out.append("")
+
+    total = 0
+    unpacked = 0
+    for label, name, n, tolerance in BODIES:
+        days, segments = fit_body(series, name, n, tolerance, first_jd, last_jd)
+        bases, widths, words = pack(segments, n)
+        size = len(words) * 4 + 3 * n * 5
+        total += size
+        unpacked += len(segments) * 3 * n * 4
+        array = "Ephemeris_%s" % label.capitalize()
+        out.append("// %d segments of %d days, %d coefficients per axis, within %g AU of VSOP87; %d bytes packed." %
+                   (len(segments), days, n, tolerance, size))
+        out.append("#define EPHEMERIS_%s_SEGMENT_DAYS %d" % (label, days))
+        out.append("#define EPHEMERIS_%s_NUM_SEGMENTS %d" % (label, len(segments)))
+        out.append("#define EPHEMERIS_%s_NUM_COEFFICIENTS %d" % (label, n))
+        out.append("#define EPHEMERIS_%s_SEGMENT_BITS %d" % (label, sum(map(sum, widths))))
+        out.append("#define EPHEMERIS_%s_QUANTUM %.9gf" % (label, quantum_for(n, tolerance)))
+        out.append("static const int32_t %s_Base[3][%d] = {" % (array, n))
+        for axis in bases:
+            out.append("    { %s }," % ", ".join("%d" % b for b in axis))
+        out.append("};")
+        out.append("static const uint8_t %s_Bits[3][%d] = {" % (array, n))
+        for axis in widths:
+            out.append("    { %s }," % ", ".join("%d" % w for w in axis))
+        out.append("};")
+        out.append("static const uint32_t %s[%d] = {" % (array, len(words)))
+        for k in range(0, len(words), 8):
+            out.append("    %s," % ", ".join("0x%08x" % w for w in words[k:k + 8]))
+        out.append("};")
+        out.append("")
+        print("gen_ephemeris_table: %s: %d segments of %d days" % (name, len(segments), days))
+    out.append("#endif // EPHEMERIS_TABLE_H_")
+    out.append("")
+    print("gen_ephemeris_table: %d bytes of coefficients, %d as floats" % (total, unpacked))
+
+    with open(sys.argv[2], "w") as f:
+        f.write("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+# Generates movement_moon_table.h: the UTC times of every new moon over a span of years, and the fraction of the
+# Moon's disc that is lit over the course of a lunation. With these, movement_moon can find the phase and illumination
+# for any moment with a table lookup and integer math, where the faces used to run a mean-lunation model through
+# soft-float fmod and trigonometry. The new moons come from the algorithm in chapter 49 of Meeus' Astronomical
+# Algorithms (good to well under a minute), so the table follows the real, uneven length of each lunation.
+#
+# usage: gen_moon_table.py path/to/movement_moon_table.h [FIRST_YEAR LAST_YEAR]
+
+import math
+import sys
+
+UNIX_EPOCH_JD = 2440587.5
+ILLUMINATION_STEPS = 64  # entries over half a lunation; the other half mirrors it
+
+
+def sin_deg(x):
+    return math.sin(math.radians(x))
+
+
+def new_moon_jde(k):
+    """Julian Ephemeris Day of the new moon k lunations after the one of 2000 January 6."""
+    t = k / 1236.85
+    jde = (2451550.09766 + 29.530588861 * k + 0.00015437 * t ** 2 - 0.000000150 * t ** 3
+           + 0.00000000073 * t ** 4)
+    e = 1 - 0.002516 * t - 0.0000074 * t ** 2
+    m = 2.5534 + 29.10535670 * k - 0.0000014 * t ** 2 - 0.00000011 * t ** 3
+    mp = 201.5643 + 385.81693528 * k + 0.0107582 * t ** 2 + 0.00001238 * t ** 3 - 0.000000058 * t ** 4
+    f = 160.7108 + 390.67050284 * k - 0.0016118 * t ** 2 - 0.00000227 * t ** 3 + 0.000000011 * t ** 4
+    omega = 124.7746 - 1.56375588 * k + 0.0020672 * t ** 2 + 0.00000215 * t ** 3
+
+    jde += (-0.40720 * sin_deg(mp)
+            + 0.17241 * e * sin_deg(m)
+            + 0.01608 * sin_deg(2 * mp)
+            + 0.01039 * sin_deg(2 * f)
+            + 0.00739 * e * sin_deg(mp - m)
+            - 0.00514 * e * sin_deg(mp + m)
+            + 0.00208 * e * e * sin_deg(2 * m)
+            - 0.00111 * sin_deg(mp - 2 * f)
+            - 0.00057 * sin_deg(mp + 2 * f)
+            + 0.00056 * e * sin_deg(2 * mp + m)
+            - 0.00042 * sin_deg(3 * mp)
+            + 0.00042 * e * sin_deg(m + 2 * f)
+            + 0.00038 * e * sin_deg(m - 2 * f)
+            - 0.00024 * e * sin_deg(2 * mp - m)
+            - 0.00017 * sin_deg(omega)
+            - 0.00007 * sin_deg(mp + 2 * m)
+            + 0.00004 * sin_deg(2 * mp - 2 * f)
+            + 0.00004 * sin_deg(3 * m)
+            + 0.00003 * sin_deg(mp + m - 2 * f)
+            + 0.00003 * sin_deg(2 * mp + 2 * f)
+            - 0.00003 * sin_deg(mp + m + 2 * f)
+            + 0.00003 * sin_deg(mp - m + 2 * f)
+            - 0.00002 * sin_deg(mp - m - 2 * f)
+            - 0.00002 * sin_deg(3 * mp + m)
+            + 0.00002 * sin_deg(4 * mp))
+
+    planetary = [
+        (0.000325, 299.77 + 0.107408 * k - 0.009173 * t ** 2),
+        (0.000165, 251.88 + 0.016321 * k),
+        (0.000164, 251.83 + 26.651886 * k),
+        (0.000126, 349.42 + 36.412478 * k),
+        (0.000110, 84.66 + 18.206239 * k),
+        (0.000062, 141.74 + 53.303771 * k),
+        (0.000060, 207.14 + 2.453732 * k),
+        (0.000056, 154.84 + 7.306860 * k),
+        (0.000047, 34.52 + 27.261239 * k),
+        (0.000042, 207.19 + 0.121824 * k),
+        (0.000040, 291.34 + 1.844379 * k),
+        (0.000037, 161.72 + 24.198154 * k),
+        (0.000035, 239.56 + 25.513099 * k),
+        (0.000023, 331.55 + 3.592518 * k),
+    ]
+    return jde + sum(a * sin_deg(angle) for a, angle in planetary)
+
+
+def delta_t(year):
+    """TT - UT in seconds; the NASA polynomial for 2005-2050, which is as good a guess as any further out."""
+    y = year - 2000
+    return 62.92 + 0.32217 * y + 0.005589 * y * y
+
+
+def new_moon_timestamp(k):
+    jde = new_moon_jde(k)
+    year = 2000 + (jde - 2451545.0) / 365.25
+    return round((jde - UNIX_EPOCH_JD) * 86400 - delta_t(year))
+
+
+def unix_time(year):
+    return (julian_day(year) - UNIX_EPOCH_JD) * 86400
+
+
+def julian_day(year):
+    y = year - 1
+    return math.floor(365.25 * (y + 4716)) + math.floor(30.6001 * 14) + 1 + 2 - y // 100 + y // 400 - 1524.5
+
+
+def main():
+    if len(sys.argv) not in (2, 4):
+        sys.exit("usage: %s movement_moon_table.h [FIRST_YEAR LAST_YEAR]" % sys.argv[0])
+    first_year, last_year = (int(sys.argv[2]), int(sys.argv[3])) if len(sys.argv) == 4 else (2020, 2060)
+
+    # the last new moon before the span starts, so that every moment in it falls between two entries.
+    k = math.floor((first_year - 2000) * 12.3685) - 2
+    while new_moon_timestamp(k + 1) <= unix_time(first_year):
+        k += 1
+    new_moons = []
+    while True:
+        timestamp = new_moon_timestamp(k)
+        new_moons.append(timestamp)
+        if timestamp >= unix_time(last_year + 1):
+            break
+        k += 1
+
+    # illuminated fraction of the disc, in thousandths, taking the phase angle as proportional to the Moon's age.
+    # that's within a couple of percent of the true value, which depends on the Moon's distance and orbit.
+    illumination = [round(1000 * (1 - math.cos(math.pi * i / ILLUMINATION_STEPS)) / 2)
+                    for i in range(ILLUMINATION_STEPS + 1)]
+
+    out = []
+    out.append("// This file is generated by utils/gen_moon_table.py. Do not edit.")
+    out.append("#ifndef MOVEMENT_MOON_TABLE_H_")
+    out.append("#define MOVEMENT_MOON_TABLE_H_")
+    out.append("")
+    out.append("#include <stdint.h>")
+    out.append("")
+    out.append("// UTC timestamps of every new moon from the last one of %d to the first one of %d." %
+               (first_year - 1, last_year + 1))
+    out.append("#define MOON_TABLE_NUM_NEW_MOONS %d" % len(new_moons))
+    out.append("static const uint32_t Moon_New_Moons[MOON_TABLE_NUM_NEW_MOONS] = {")
+    for i in range(0, len(new_moons), 6):
+        out.append("    %s," % ", ".join("%d" % t for t in new_moons[i:i + 6]))
+    out.append("};")
+    out.append("")
+    out.append("// Illuminated fraction of the disc, in thousandths, at each 1/%d of the way from new moon to full moon."
+               % ILLUMINATION_STEPS)
+    out.append("#define MOON_TABLE_ILLUMINATION_STEPS %d" % ILLUMINATION_STEPS)
+    out.append("#define MOON_TABLE_ILLUMINATION_SHIFT %d // entries are (1 << SHIFT) apart, of the 65536 steps in a lunation" %
+               (15 - int(math.log2(ILLUMINATION_STEPS))))
+    out.append("static const uint16_t Moon_Illumination[MOON_TABLE_ILLUMINATION_STEPS + 1] = {")
+    for i in range(0, len(illumination), 13):
+        out.append("    %s," % ", ".join("%d" % v for v in illumination[i:i + 13]))
+    out.append("};")
+    out.append("")
+    out.append("#endif // MOVEMENT_MOON_TABLE_H_")
+    out.append("")
+
+    with open(sys.argv[1], "w") as f:
+        f.write("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,124 @@
+#!/usr/bin/env python3
+# Generates movement_signal_tunes.h: each signal tune in movement_custom_signal_tunes.h, compiled into the form the
+# buzzer plays without decoding anything (watch_buzzer_play_notes). A note becomes its TCC period, looked up in
+# NotePeriods, and the number of 64 Hz ticks it sounds for, which is one more than its duration in the tune; repeats are
+# unrolled, and back-to-back notes of the same pitch are joined. The tunes keep the #ifdef they were chosen by, so the
+# one the configuration picks is the one that's compiled in, as signal_tune_notes.
+#
+# usage: gen_signal_tunes.py movement_custom_signal_tunes.h watch_buzzer.h watch_private_buzzer.c movement_signal_tunes.h
+
+import re
+import sys
+
+# a tune that takes more steps than this to unroll is taken to be one that loops forever.
+MAX_NOTES = 1024
+COMMENT = re.compile(r"//[^\n]*|/\*.*?\*/", re.DOTALL)
+
+
+def read(path):
+    with open(path) as source:
+        return COMMENT.sub(" ", source.read())
+
+
+def read_notes(buzzer_header, buzzer_source):
+    """Maps each BuzzerNote name to its enum value, and returns the periods in NotePeriods."""
+    match = re.search(r"typedef\s+enum\s+BuzzerNote\s*\{(.*?)\}", read(buzzer_header), re.DOTALL)
+    if match is None:
+        sys.exit("gen_signal_tunes: could not find BuzzerNote in %s" % buzzer_header)
+    names = {name: value for value, name in enumerate(re.findall(r"\b(BUZZER_NOTE_\w+)", match.group(1)))}
+    match = re.search(r"\bNotePeriods\s*\[\s*\d*\s*\]\s*=\s*\{(.*?)\}", read(buzzer_source), re.DOTALL)
+    if match is None:
+        sys.exit("gen_signal_tunes: could not find NotePeriods in %s" % buzzer_source)
+    periods = [int(period) for period in re.findall(r"\d+", match.group(1))]
+    return names, periods
+
+
+def read_tunes(path, names):
+    """Returns (condition, values) for each signal_tune array, in the order they're written."""
+    tunes = []
+    pattern = r"#ifdef\s+(\w+)\s+(?:const\s+)?int8_t\s+signal_tune\s*\[\s*\]\s*=\s*\{(.*?)\}\s*;"
+    for condition, body in re.findall(pattern, read(path), re.DOTALL):
+        values = []
+        for token in (token.strip() for token in body.split(",")):
+            if not token:
+                continue
+            if token in names:
+                values.append(names[token])
+            elif re.fullmatch(r"-?\d+", token):
+                values.append(int(token))
+            else:
+                sys.exit("gen_signal_tunes: %s in %s isn't a note or a number" % (token, condition))
+        tunes.append((condition, values))
+    if not tunes:
+        sys.exit("gen_signal_tunes: no signal tunes in %s" % path)
+    return tunes
+
+
+def compile_tune(condition, sequence, names, periods):
+    """Plays a tune the way watch_buzzer_play_sequence does, and returns the (period, ticks) of each note it plays."""
+    sequence = sequence + [0, 0]
+    rest = names["BUZZER_NOTE_REST"]
+    notes = []
+    position = 0
+    repeat_counter = -1
+    while position + 1 < len(sequence):
+        note, duration = sequence[position], sequence[position + 1]
+        if note < 0 and duration:
+            # a repeat marker: rewind, as many times as it says, by as many notes as it says.
+            repeat_counter = duration if repeat_counter == -1 else repeat_counter - 1
+            if repeat_counter > 0:
+                position = max(position + note * 2, 0)
+            else:
+                position += 2
+                repeat_counter = -1
+            continue
+        if not (note and duration):
+            break
+        if note != rest and not 0 <= note < len(periods):
+            sys.exit("gen_signal_tunes: %s plays note %d, which isn't in NotePeriods" % (condition, note))
+        period = 0 if note == rest else periods[note]
+        if notes and notes[-1][0] == period:
+            notes[-1][1] += duration + 1
+        else:
+            notes.append([period, duration + 1])
+        if len(notes) > MAX_NOTES:
+            sys.exit("gen_signal_tunes: %s never ends; is a repeat marker repeating another?" % condition)
+        position += 2
+    if any(ticks > 0xFFFF for _, ticks in notes):
+        sys.exit("gen_signal_tunes: %s holds a note for longer than 65535 ticks" % condition)
+    return notes
+
+
+def main():
+    if len(sys.argv) != 5:
+        sys.exit("usage: %s movement_custom_signal_tunes.h watch_buzzer.h watch_private_buzzer.c "
+                 "movement_signal_tunes.h" % sys.argv[0])
+
+    names, periods = read_notes(sys.argv[2], sys.argv[3])
+    out = []
+    out.append("// This file is generated by utils/gen_signal_tunes.py from movement_custom_signal_tunes.h. Do not edit.")
+    out.append("#ifndef MOVEMENT_SIGNAL_TUNES_H_")
+    out.append("#define MOVEMENT_SIGNAL_TUNES_H_")
+    out.append("")
+    out.append("#include \"watch_buzzer.h\"")
+    for condition, sequence in read_tunes(sys.argv[1], names):
+        notes = compile_tune(condition, sequence, names, periods)
+        out.append("")
+        out.append("#ifdef %s" % condition)
+        out.append("// %d ticks at 64 Hz." % sum(ticks for _, ticks in notes))
+        out.append("static const watch_buzzer_note_t signal_tune_notes[] = {")
+        for period, ticks in notes:
+            out.append("    { %d, %d }," % (period, ticks))
+        out.append("    { 0, 0 }")
+        out.append("};")
+        out.append("#endif // %s" % condition)
+    out.append("")
+    out.append("#endif")
+    out.append("")
+
+    with open(sys.argv[4], "w") as f:
+        f.write("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,82 @@
+#!/usr/bin/env python3
+# Generates thermistor_table.h: the thermistor's temperature, in hundredths of a degree Celsius, at evenly spaced
+# ADC readings. The THERMISTOR_ constants are read from thermistor_driver.h, so thermistor_driver_get_temperature
+# can turn a reading into a temperature with a lookup and a linear interpolation instead of a soft-float logf.
+# Regenerate the table whenever those constants change.
+#
+# usage: gen_thermistor_table.py path/to/thermistor_driver.h path/to/thermistor_table.h
+
+import math
+import re
+import sys
+
+# one entry every 512 counts, plus one at the end so that every reading has a neighbour to interpolate towards.
+# between -40 and 85 °C the interpolated value stays within 0.07 °C of the Steinhart-Hart B equation.
+SHIFT = 9
+NUM_ENTRIES = (65536 >> SHIFT) + 1
+INT16_MIN = -32768
+INT16_MAX = 32767
+
+
+def parse_define(source, name):
+    match = re.search(r"#define\s+" + name + r"\s+\(?([^)\s]+)\)?", source)
+    if match is None:
+        sys.exit("gen_thermistor_table: could not find %s" % name)
+    return match.group(1)
+
+
+def temperature(value, high_side, b_coefficient, nominal_temperature, nominal_resistance, series_resistance):
+    """The same conversion as watch_utility_thermistor_temperature, in hundredths of a degree."""
+    if high_side:
+        if value == 0:
+            return INT16_MIN
+        resistance = (1023.0 * series_resistance) / (value / 64.0) - series_resistance
+    else:
+        if value >= 65535:
+            return INT16_MIN
+        resistance = series_resistance / (65535.0 / value - 1.0) if value else 0.0
+    if resistance <= 0:
+        return INT16_MAX
+    kelvin = 1.0 / (math.log(resistance / nominal_resistance) / b_coefficient + 1.0 / (nominal_temperature + 273.15))
+    return max(INT16_MIN, min(INT16_MAX, round((kelvin - 273.15) * 100)))
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit("usage: %s thermistor_driver.h thermistor_table.h" % sys.argv[0])
+
+    with open(sys.argv[1]) as f:
+        source = f.read()
+    high_side = parse_define(source, "THERMISTOR_HIGH_SIDE") == "true"
+    parameters = [float(parse_define(source, name)) for name in ("THERMISTOR_B_COEFFICIENT",
+                                                                   "THERMISTOR_NOMINAL_TEMPERATURE",
+                                                                   "THERMISTOR_NOMINAL_RESISTANCE",
+                                                                   "THERMISTOR_SERIES_RESISTANCE")]
+    table = [temperature(min(i << SHIFT, 65535), high_side, *parameters) for i in range(NUM_ENTRIES)]
+
+    out = []
+    out.append("// This file is generated by utils/gen_thermistor_table.py from thermistor_driver.h. Do not edit.")
+    out.append("#ifndef THERMISTOR_TABLE_H_")
+    out.append("#define THERMISTOR_TABLE_H_")
+    out.append("")
+    out.append("#include <stdint.h>")
+    out.append("")
+    out.append("// %s-side thermistor, B = %g, %g ohms at %g C, %g ohm series resistor." %
+               ("High" if high_side else "Low", parameters[0], parameters[2], parameters[1], parameters[3]))
+    out.append("#define THERMISTOR_TABLE_SHIFT %d" % SHIFT)
+    out.append("")
+    out.append("// Temperature in hundredths of a degree Celsius for an ADC reading of (index << THERMISTOR_TABLE_SHIFT).")
+    out.append("static const int16_t Thermistor_Table[%d] = {" % NUM_ENTRIES)
+    for i in range(0, NUM_ENTRIES, 8):
+        out.append("    " + " ".join("%d," % t for t in table[i:i + 8]))
+    out.append("};")
+    out.append("")
+    out.append("#endif // THERMISTOR_TABLE_H_")
+    out.append("")
+
+    with open(sys.argv[2], "w") as f:
+        f.write("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
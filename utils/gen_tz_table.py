@@ -0,0 +1,129 @@
+#!/usr/bin/env python3
+# Generates movement_tz_table.h: when daylight saving time starts and ends in each of Movement's time zones, for a span
+# of years. A zone in movement_timezone_offsets is a standard offset; with the daylight saving preference on, it follows
+# the rule of the places that keep that offset and change their clocks, which this script knows a handful of (the
+# current ones, from the tz database). Each rule's seasons are compiled to the days they start and end on, so
+# movement_tz finds the offset at any moment with a binary search and no calendar math.
+#
+# usage: gen_tz_table.py path/to/movement_tz_table.h [FIRST_YEAR LAST_YEAR]
+
+import datetime
+import sys
+
+SUNDAY = 6
+LAST = -1
+
+# name, minutes saved, whether the times below are UTC (or else the zone's standard time), and the start and end of the
+# season: (month, which Sunday of it, minute of the day).
+RULES = [
+    ("EU", 60, True, (3, LAST, 60), (10, LAST, 60)),
+    ("US", 60, False, (3, 2, 120), (11, 1, 60)),
+    ("AU", 60, False, (10, 1, 120), (4, 1, 120)),
+    ("Lord Howe", 30, False, (10, 1, 120), (4, 1, 90)),
+    ("NZ", 60, False, (9, LAST, 120), (4, 1, 120)),
+    ("Chatham", 60, False, (9, LAST, 165), (4, 1, 165)),
+]
+
+# the rule each zone follows, by its index in movement_timezone_offsets; the rest have none. a zone only follows a rule
+# that the place it's named for keeps, so UTC, South Africa, the Solomon Islands, Hawaii, Brasilia and Fernando de
+# Noronha stay put.
+ZONE_RULES = {
+    1: "EU",            # Central European Time
+    16: "AU",           # Australian Central Standard Time: South Australia
+    17: "AU",           # Australian Eastern Standard Time: New South Wales, Victoria, Tasmania
+    18: "Lord Howe",
+    20: "NZ",
+    21: "Chatham",
+    29: "US",
+    30: "US",
+    31: "US",
+    32: "US",
+    33: "US",
+    35: "US",           # Atlantic Standard Time: the Maritimes
+    36: "US",
+    40: "EU",
+}
+NUM_ZONES = 41
+NO_RULE = 0xFF
+UNIX_EPOCH = datetime.date(1970, 1, 1)
+
+
+def sunday(year, month, which):
+    """Days since 1970 of the nth Sunday of a month, or the last one."""
+    if which == LAST:
+        end = datetime.date(year + month // 12, month % 12 + 1, 1) - datetime.timedelta(days=1)
+        day = end - datetime.timedelta(days=(end.weekday() - SUNDAY) % 7)
+    else:
+        first = datetime.date(year, month, 1)
+        day = first + datetime.timedelta(days=(SUNDAY - first.weekday()) % 7 + 7 * (which - 1))
+    return (day - UNIX_EPOCH).days
+
+
+def main():
+    if len(sys.argv) not in (2, 4):
+        sys.exit("usage: %s movement_tz_table.h [FIRST_YEAR LAST_YEAR]" % sys.argv[0])
+    first_year, last_year = (int(sys.argv[2]), int(sys.argv[3])) if len(sys.argv) == 4 else (2025, 2054)
+    names = [rule[0] for rule in RULES]
+
+    # each season starts one year and ends the same one in the north, or the next in the south; counting seasons
+    # from the one under way when the span begins keeps every row the same length.
+    transitions = []
+    for _, _, _, start, end in RULES:
+        southern = end[0] < start[0]
+        days = []
+        for year in range(first_year - 1 if southern else first_year, last_year if southern else last_year + 1):
+            days.append(sunday(year, start[0], start[1]))
+            days.append(sunday(year + 1 if southern else year, end[0], end[1]))
+        transitions.append(days)
+
+    out = []
+    out.append("// This file is generated by utils/gen_tz_table.py. Do not edit.")
+    out.append("#ifndef MOVEMENT_TZ_TABLE_H_")
+    out.append("#define MOVEMENT_TZ_TABLE_H_")
+    out.append("")
+    out.append("#include <stdbool.h>")
+    out.append("#include <stdint.h>")
+    out.append("")
+    out.append("typedef struct {")
+    out.append("    uint8_t save;           // minutes the clocks go forward")
+    out.append("    bool utc;               // whether start_minute and end_minute are UTC, or the zone's standard time")
+    out.append("    uint16_t start_minute;  // minute of the day the season starts")
+    out.append("    uint16_t end_minute;    // and ends")
+    out.append("} tz_table_rule_t;")
+    out.append("")
+    out.append("#define TZ_TABLE_NUM_RULES %d" % len(RULES))
+    out.append("static const tz_table_rule_t Tz_Rules[TZ_TABLE_NUM_RULES] = {")
+    for name, save, utc, start, end in RULES:
+        out.append("    { %d, %s, %d, %d }, // %s" % (save, "true" if utc else "false", start[2], end[2], name))
+    out.append("};")
+    out.append("")
+    out.append("// the rule each zone in movement_timezone_offsets follows, if any.")
+    out.append("#define TZ_TABLE_NO_RULE 0x%X" % NO_RULE)
+    out.append("#define TZ_TABLE_NUM_ZONES %d" % NUM_ZONES)
+    out.append("static const uint8_t Tz_Zone_Rules[TZ_TABLE_NUM_ZONES] = {")
+    zones = [names.index(ZONE_RULES[i]) if i in ZONE_RULES else NO_RULE for i in range(NUM_ZONES)]
+    for i in range(0, NUM_ZONES, 12):
+        out.append("    %s," % ", ".join("0x%02X" % r if r == NO_RULE else "%d" % r for r in zones[i:i + 12]))
+    out.append("};")
+    out.append("")
+    out.append("// days since 1970 on which each rule's seasons start and end, in turn, from the one under way at the start")
+    out.append("// of %d to the last to start by the end of %d (in the south, by the end of %d)." %
+               (first_year, last_year, last_year - 1))
+    out.append("#define TZ_TABLE_NUM_TRANSITIONS %d" % len(transitions[0]))
+    out.append("static const uint16_t Tz_Transition_Days[TZ_TABLE_NUM_RULES][TZ_TABLE_NUM_TRANSITIONS] = {")
+    for name, days in zip(names, transitions):
+        out.append("    { // %s" % name)
+        for i in range(0, len(days), 10):
+            out.append("        %s," % ", ".join("%d" % d for d in days[i:i + 10]))
+        out.append("    },")
+    out.append("};")
+    out.append("")
+    out.append("#endif // MOVEMENT_TZ_TABLE_H_")
+    out.append("")
+
+    with open(sys.argv[1], "w") as f:
+        f.write("\n".join(out))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,65 @@
+#!/usr/bin/env python3
+# Records a trace of a Sensor Watch's button presses, I2C reads and ADC readings over its USB serial shell, for playing
+# back in the simulator (see watch-library/shared/watch/watch_input_trace.h). The watch needs firmware built with
+# make INPUT_TRACE=1. Recording runs until you press Ctrl-C.
+#
+# usage: input_trace_record.py PORT TRACE_FILE
+#
+# Requires pyserial (pip install pyserial). PORT is something like /dev/ttyACM0 or /dev/cu.usbmodem1101.
+
+import re
+import sys
+import time
+
+import serial
+
+POLL_INTERVAL = 0.25
+# a trace line, as opposed to the shell's prompt and echo.
+TRACE_LINE = re.compile(r"^(\d+ (start|btn|i2c|adc) .*|# dropped .*)$")
+
+
+def send_command(port, command):
+    port.write((command + "\n").encode("ascii"))
+
+
+def collect(port, out):
+    """Asks the watch for what it has recorded and writes the trace lines to out. Returns how many there were."""
+    send_command(port, "trace dump")
+    count = 0
+    deadline = time.monotonic() + POLL_INTERVAL
+    while time.monotonic() < deadline:
+        line = port.readline()
+        if not line:
+            continue
+        line = line.decode("ascii", errors="replace").strip()
+        if TRACE_LINE.match(line):
+            if line.startswith("#"):
+                print("input_trace_record: watch %s; the host wasn't reading fast enough" % line[2:], file=sys.stderr)
+            out.write(line + "\n")
+            count += 1
+            # there may be more where that came from.
+            deadline = time.monotonic() + POLL_INTERVAL
+    return count
+
+
+def main():
+    if len(sys.argv) != 3:
+        sys.exit("usage: %s PORT TRACE_FILE" % sys.argv[0])
+
+    events = 0
+    with serial.Serial(sys.argv[1], timeout=POLL_INTERVAL) as port, open(sys.argv[2], "w") as out:
+        port.reset_input_buffer()
+        send_command(port, "trace start")
+        print("recording; press Ctrl-C to stop")
+        try:
+            while True:
+                events += collect(port, out)
+        except KeyboardInterrupt:
+            pass
+        send_command(port, "trace stop")
+        events += collect(port, out)
+    print("recorded %d events" % events)
+
+
+if __name__ == "__main__":
+    main()
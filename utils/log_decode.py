@@ -0,0 +1,98 @@
+#!/usr/bin/env python3
+# Turns the log records a Sensor Watch sends over USB serial back into text (see watch_log.h). The watch sends each
+# WATCH_LOG_ message as a line of "@L", the offset of its format string in the firmware's .watch_log section and its
+# arguments, all in hex; this reads the format strings out of the ELF the firmware was built from and prints each
+# record as the message it stands for, with its level. Other lines, like the shell's output, go through as they are.
+#
+# usage: log_decode.py ELF_FILE [INPUT]
+#
+# INPUT is a saved capture of the serial output, or on Linux the serial port itself (/dev/ttyACM0, say); without it,
+# standard input. The ELF has to be from the same build as the firmware on the watch, or the offsets will point at
+# the wrong strings.
+
+import re
+import struct
+import sys
+
+LEVELS = {"E": "error", "W": "warn", "I": "info", "D": "debug"}
+RECORD = re.compile(r"^@L((?: [0-9a-f]+)+| ! [0-9a-f]+)\s*$")
+# a printf conversion: flags, width, precision, length and the conversion itself.
+CONVERSION = re.compile(r"%([-+ #0]*)(\d*)(?:\.(\d+))?(hh|h|ll|l|z|j|t)?([diuxXoc%])")
+
+
+def read_section(path, name):
+    """Returns the contents of the named section of an ELF file."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:4] != b"\x7fELF":
+        sys.exit("%s isn't an ELF file" % path)
+    order = "<" if data[5] == 1 else ">"
+    if data[4] == 2:
+        shoff, = struct.unpack_from(order + "Q", data, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from(order + "HHH", data, 0x3A)
+        header = order + "IIQQQQ"
+    else:
+        shoff, = struct.unpack_from(order + "I", data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from(order + "HHH", data, 0x2E)
+        header = order + "IIIIII"
+
+    def section(i):
+        name_offset, _, _, _, offset, size = struct.unpack_from(header, data, shoff + i * shentsize)
+        return name_offset, offset, size
+
+    _, names_offset, _ = section(shstrndx)
+    for i in range(shnum):
+        name_offset, offset, size = section(i)
+        start = names_offset + name_offset
+        if data[start:data.index(b"\0", start)].decode("ascii") == name:
+            return data[offset:offset + size]
+    sys.exit("%s has no %s section; was it built without any WATCH_LOG_ messages?" % (path, name))
+
+
+def format_record(strings, offset, args):
+    if offset >= len(strings):
+        return "(no format string at 0x%x; is the ELF from this build?) %s" % (offset, " ".join("%x" % a for a in args))
+    text = strings[offset:strings.index(b"\0", offset)].decode("utf-8", errors="replace")
+    level, text = LEVELS.get(text[:1], "?"), text[1:]
+    remaining = list(args)
+
+    def convert(match):
+        flags, width, precision, _, conversion = match.groups()
+        if conversion == "%":
+            return "%"
+        if not remaining:
+            return "<missing>"
+        value = remaining.pop(0)
+        if conversion in "di" and value & 0x80000000:
+            value -= 1 << 32
+        if conversion == "c":
+            value = chr(value & 0xFF)
+        spec = "%" + flags + width + ("." + precision if precision else "") + ("d" if conversion == "i" else conversion)
+        return spec % value
+
+    return "[%s] %s" % (level, CONVERSION.sub(convert, text))
+
+
+def main():
+    if len(sys.argv) not in (2, 3):
+        sys.exit("usage: %s ELF_FILE [INPUT]" % sys.argv[0])
+
+    strings = read_section(sys.argv[1], ".watch_log")
+    source = open(sys.argv[2], "r", errors="replace") if len(sys.argv) == 3 else sys.stdin
+    with source:
+        for line in source:
+            match = RECORD.match(line.strip())
+            if not match:
+                sys.stdout.write(line)
+            else:
+                fields = match.group(1).split()
+                if fields[0] == "!":
+                    print("[log] %d messages dropped: the watch logged faster than USB took them" % int(fields[1], 16))
+                else:
+                    values = [int(field, 16) for field in fields]
+                    print(format_record(strings, values[0], values[1:]))
+            sys.stdout.flush()
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,36 @@
+#!/usr/bin/env python3
+# Finishes a face module (see movement/movement_modules.h) after it's linked: fills in the size and CRC-32 fields of
+# its header, which the watch checks before it runs the module. The CRC is zlib's, over the whole module with the CRC
+# field itself zeroed, the same as the firmware's watch_crc32. movement/modules/Makefile runs this on each module.
+#
+# usage: module_pack.py MODULE_BIN
+
+import struct
+import sys
+import zlib
+
+MAGIC = 0x444D564D  # "MVMD"
+SIZE_OFFSET = 8
+CRC_OFFSET = 12
+HEADER_SIZE = 16
+
+
+def main():
+    if len(sys.argv) != 2:
+        sys.exit("usage: %s MODULE_BIN" % sys.argv[0])
+
+    with open(sys.argv[1], "rb") as f:
+        module = bytearray(f.read())
+    if len(module) < HEADER_SIZE or struct.unpack_from("<I", module, 0)[0] != MAGIC:
+        sys.exit("%s doesn't start with a module header" % sys.argv[1])
+
+    struct.pack_into("<II", module, SIZE_OFFSET, len(module), 0)
+    struct.pack_into("<I", module, CRC_OFFSET, zlib.crc32(module) & 0xFFFFFFFF)
+    with open(sys.argv[1], "wb") as f:
+        f.write(module)
+    abi_version, context_size = struct.unpack_from("<HH", module, 4)
+    print("%s: %d bytes, ABI version %d, %d bytes of context" % (sys.argv[1], len(module), abi_version, context_size))
+
+
+if __name__ == "__main__":
+    main()
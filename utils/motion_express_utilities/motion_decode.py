@@ -0,0 +1,277 @@
+#!/usr/bin/env python3
+# Decodes a whole accelerometer log at once with NumPy, for hour-long sessions that process_motion_dump.py would take
+# minutes over. It reads the raw image of the SPI flash, as the watch shows it as ACCEL.BIN over USB (make USB_MSC=1;
+# see movement_usb_msc.h) or as "sensorwatch_transfer.py PORT accel all" saves it, which it memory-maps and picks
+# the written pages out of with the used-page bitmap. It also reads one session's pages, as "sensorwatch_transfer.py
+# PORT accel SESSION" saves them (any .bin file that isn't a whole image), or a dump of "V1 <hex>" and "V2 <hex>"
+# page lines from the spi-test app. Both page formats are decoded a whole array at a time, the version 2 varints
+# included, rather than a sample at a time; the layouts are in accelerometer_data_acquisition_face.h.
+#
+# usage: motion_decode.py INPUT OUTPUT [--summary]
+#
+# OUTPUT ending in .parquet writes one row a sample (needs pandas and pyarrow): session, activity, time_ms, and
+# acc_x, acc_y and acc_z in m/s^2. Anything else writes an .npz of the same samples as arrays, plus one entry a
+# session in the session_ arrays, which needs nothing past NumPy:
+#
+#     samples = np.load("log.npz")
+#     walking = samples["session"] == 3        # the fourth session's samples
+#     samples["acc"][walking]                  # (n, 3) float32, m/s^2
+#
+# Timestamps are milliseconds since 1970, as in the CSV files, with the same correction for a sensor clock that ran
+# fast or slow that motion_v2.py applies.
+
+import argparse
+import os
+import sys
+
+import numpy as np
+
+PAGE_SIZE = 256
+BITMAP_PAGES = 4
+# how big ACCEL.BIN is; anything else is taken to be a session's pages if it ends in .bin, or else a text dump.
+IMAGE_SIZE = 8192 * PAGE_SIZE
+V2_MAGIC = np.frombuffer(b"\xfcV2", dtype=np.uint8)
+FLAG_SESSION_START = 1 << 6
+FLAG_RATE = 1 << 7
+V1_HEADER = 2
+V1_DATA = 1
+STANDARD_GRAVITY = 9.80665
+
+RANGES = np.array([2, 4, 8, 16])
+FILTERS = np.array([2, 4, 10, 20])
+# mg per count of a 14-bit sample at each range.
+LSB_14_BIT = np.array([0.244, 0.488, 0.976, 1.952])
+ACTIVITIES = {
+    "TE": "testing", "ID": "idle", "OF": "off_wrist", "SL": "sleeping", "WH": "washing_hands", "WA": "walking",
+    "WB": "walking_with_beverage", "JO": "jogging", "RU": "running", "BI": "biking", "HI": "hiking",
+    "EL": "elliptical", "SU": "stairs_up", "SD": "stairs_down", "WL": "weight_lifting",
+}
+
+
+def load_pages(path):
+    """Returns the written pages, in the order they were written, as an (n, 256) array of bytes."""
+    if os.path.getsize(path) == IMAGE_SIZE:
+        image = np.memmap(path, dtype=np.uint8, mode="r").reshape(-1, PAGE_SIZE)
+        # a page's bit is cleared once it's written; the bitmap's own pages are marked written too.
+        written = np.unpackbits(image[:BITMAP_PAGES].reshape(-1)) == 0
+        written[:BITMAP_PAGES] = False
+        return np.ascontiguousarray(image[np.flatnonzero(written)])
+    if path.lower().endswith(".bin"):
+        return np.fromfile(path, dtype=np.uint8).reshape(-1, PAGE_SIZE)
+
+    with open(path, "r", errors="replace") as f:
+        hex_pages = [line[3:3 + 2 * PAGE_SIZE] for line in f if line.startswith(("V1 ", "V2 "))]
+    return np.frombuffer(bytes.fromhex("".join(hex_pages)), dtype=np.uint8).reshape(-1, PAGE_SIZE)
+
+
+def _le(pages, column, width):
+    """The little-endian integer of the given width at the given byte of each page."""
+    value = np.zeros(len(pages), dtype=np.int64)
+    for i in range(width):
+        value |= pages[:, column + i].astype(np.int64) << (8 * i)
+    return value
+
+
+def decode_v1(pages):
+    """Returns (sessions, samples) for version 1 pages: 32 records of 64 bits each."""
+    records = np.ascontiguousarray(pages).view("<u8").reshape(-1)
+    kind = (records & 3).astype(np.int8)
+    positions = np.arange(len(records))
+    # each data record belongs to the last header before it.
+    owner = np.maximum.accumulate(np.where(kind == V1_HEADER, positions, -1))
+    data = (kind == V1_DATA) & (owner >= 0)
+    header_positions = np.flatnonzero(kind == V1_HEADER)
+    headers = records[header_positions]
+
+    values = records[data]
+    session = np.searchsorted(header_positions, owner[data])
+    lpmode = ((values >> 16) & 3).astype(np.int64)
+    axes = np.stack([(values >> 2) & 0x3FFF, (values >> 18) & 0x3FFF, (values >> 34) & 0x3FFF], axis=1)
+    raw = axes.astype(np.int32) - 8192
+    timestamp = (headers >> 32).astype(np.int64)
+    range_index = ((headers >> 2) & 3).astype(np.int64)
+    # in low power mode 1 the samples are 12 bits, so each count is four times as much.
+    lsb = LSB_14_BIT[range_index[session]] * np.where(lpmode == 0, 4, 1)
+    time_ms = (timestamp[session] * 100 + (values >> 48).astype(np.int64)) * 10
+
+    # the first data record of each session says how the sensor was set up.
+    first = np.searchsorted(session, np.arange(len(headers)))
+    first = np.minimum(first, max(len(session) - 1, 0))
+    sessions = {
+        "timestamp": timestamp,
+        "activity": np.array([chr(h >> 16 & 0xFF) + chr(h >> 24 & 0xFF) for h in headers.tolist()], dtype="U2"),
+        "temperature": ((headers >> 4) & 0xFFF).astype(np.int64),
+        "range": RANGES[range_index],
+        "lpmode": (lpmode[first] + 1) if len(session) else np.zeros(len(headers), dtype=np.int64),
+        "filter": FILTERS[((values[first] >> 32) & 3).astype(np.int64)] if len(session) else
+                  np.zeros(len(headers), dtype=np.int64),
+    }
+    return sessions, (session, time_ms, raw, lsb)
+
+
+def decode_v2(pages):
+    """Returns (sessions, samples) for version 2 pages, delta-compressed."""
+    n = len(pages)
+    flags = pages[:, 3].astype(np.int64)
+    count = pages[:, 4].astype(np.int64)
+    period = pages[:, 5].astype(np.int64)
+    counter = _le(pages, 6, 2)
+    session_start = (flags & FLAG_SESSION_START) != 0
+    has_rate = session_start & ((flags & FLAG_RATE) != 0)
+    offset = 8 + 8 * session_start + 5 * has_rate
+
+    # the first sample's three int16 axes, wherever they are on each page.
+    rows = np.arange(n)[:, None]
+    first_bytes = pages[rows, offset[:, None] + np.arange(6)].astype(np.int64)
+    first = first_bytes[:, 0::2] | (first_bytes[:, 1::2] << 8)
+    first = np.where(first >= 0x8000, first - 0x10000, first)
+
+    # the rest are varints of nibbles, high nibble of each byte first; lay every page's nibbles end to end.
+    nibbles = np.empty((n, 2 * PAGE_SIZE), dtype=np.uint8)
+    nibbles[:, 0::2] = pages >> 4
+    nibbles[:, 1::2] = pages & 0xF
+    start = 2 * (offset + 6)
+    nibbles = nibbles[np.arange(2 * PAGE_SIZE)[None, :] >= start[:, None]]
+    lengths = 2 * PAGE_SIZE - start
+    page_begin = np.cumsum(lengths) - lengths
+    page_of = np.repeat(np.arange(n), lengths)
+
+    # a varint starts after one that ended (its last nibble has the continuation bit clear), or at a page's start.
+    ends = (nibbles & 0x8) == 0
+    starts = np.zeros(len(nibbles), dtype=bool)
+    starts[1:] = ends[:-1]
+    starts[page_begin[lengths > 0]] = True
+    group = np.cumsum(starts) - 1
+    group_begin = np.flatnonzero(starts)
+    # three bits a nibble, least significant first. the erased tail of a page reads as one long varint that nothing
+    # uses; capping the shift keeps it from overflowing.
+    shift = 3 * np.minimum(np.arange(len(nibbles)) - group_begin[group], 20)
+    values = np.add.reduceat((nibbles & 0x7).astype(np.int64) << shift, group_begin) if len(group_begin) else \
+        np.zeros(0, dtype=np.int64)
+    complete = ends[np.r_[group_begin[1:] - 1, len(nibbles) - 1]] if len(group_begin) else np.zeros(0, dtype=bool)
+
+    # each page with samples on it uses its first 3 * (count - 1) varints.
+    needed = 3 * np.maximum(count - 1, 0)
+    owner = np.repeat(np.arange(n), needed)
+    take = np.repeat(group[np.minimum(page_begin, max(len(group) - 1, 0))], needed) + \
+        np.arange(needed.sum()) - np.repeat(np.cumsum(needed) - needed, needed)
+    if len(take) and (take.max() >= len(values) or np.any(page_of[group_begin[take]] != owner) or
+                      not np.all(complete[take])):
+        raise ValueError("a version 2 page has fewer samples on it than its header says")
+    deltas = values[take]
+    deltas = ((deltas >> 1) ^ -(deltas & 1)).reshape(-1, 3)
+
+    # each page's samples are its first sample and then the deltas, added up a page at a time.
+    sample_begin = np.cumsum(count) - count
+    steps = np.empty((count.sum(), 3), dtype=np.int64)
+    is_first = np.zeros(len(steps), dtype=bool)
+    is_first[sample_begin[count > 0]] = True
+    steps[is_first] = first[count > 0]
+    steps[~is_first] = deltas
+    totals = np.cumsum(steps, axis=0)
+    before = (totals - steps)[sample_begin[count > 0]]
+    raw = totals - np.repeat(before, count[count > 0], axis=0)
+    page = np.repeat(np.arange(n), count)
+    index = np.arange(len(steps)) - np.repeat(sample_begin, count)
+
+    # sessions: each starts on a page with a session header, and runs until the next.
+    session_of_page = np.cumsum(session_start) - 1
+    session_pages = np.flatnonzero(session_start)
+    measured = _le(pages[session_pages], 16, 4)
+    resampled = pages[session_pages, 20] != 0
+    correct = has_rate[session_pages] & ~resampled & (measured > 0)
+    # measured is in samples per 1000 seconds; the counters assumed 100 / period samples per second.
+    rate = np.where(correct, 100000 / np.maximum(period[session_pages], 1) / np.maximum(measured, 1), 1.0)
+    timestamp = _le(pages[session_pages], 8, 4)
+
+    session = session_of_page[page]
+    keep = session >= 0
+    session, page, index, raw = session[keep], page[keep], index[keep], raw[keep]
+    sample_counter = counter[page] + index * period[page]
+    time_ms = np.round((timestamp[session] * 100 + sample_counter * rate[session]) * 10).astype(np.int64)
+    lsb = LSB_14_BIT[flags[page] & 3]
+
+    session_flags = flags[session_pages]
+    sessions = {
+        "timestamp": timestamp,
+        "activity": np.array([bytes(p[12:14]).decode("ascii", errors="replace") for p in pages[session_pages]],
+                             dtype="U2"),
+        "temperature": _le(pages[session_pages], 14, 2),
+        "range": RANGES[session_flags & 3],
+        "lpmode": ((session_flags >> 2) & 3) + 1,
+        "filter": FILTERS[(session_flags >> 4) & 3],
+    }
+    return sessions, (session, time_ms, raw, lsb)
+
+
+def decode(pages):
+    """Returns (sessions, samples) for a log: sessions maps each session field to an array with one entry a session,
+    and samples maps session, time_ms, raw and acc to arrays with one entry (or row) a sample."""
+    is_v2 = np.all(pages[:, :3] == V2_MAGIC, axis=1)
+    parts = [decode_v1(pages[~is_v2]), decode_v2(pages[is_v2])]
+
+    sessions = {key: np.concatenate([part[0][key] for part in parts]) for key in parts[0][0]}
+    first_session = 0
+    session, time_ms, raw, lsb = [], [], [], []
+    for part_sessions, (part_session, part_time, part_raw, part_lsb) in parts:
+        session.append(part_session + first_session)
+        time_ms.append(part_time)
+        raw.append(part_raw)
+        lsb.append(part_lsb)
+        first_session += len(part_sessions["timestamp"])
+    session = np.concatenate(session)
+    lsb = np.concatenate(lsb)
+    raw = np.concatenate(raw).astype(np.int16)
+
+    # number the sessions in the order they were recorded, and keep each one's samples together.
+    order = np.argsort(sessions["timestamp"], kind="stable")
+    sessions = {key: value[order] for key, value in sessions.items()}
+    renumber = np.empty(len(order), dtype=np.int64)
+    renumber[order] = np.arange(len(order))
+    session = renumber[session]
+    sample_order = np.argsort(session, kind="stable")
+    samples = {
+        "session": session[sample_order].astype(np.int32),
+        "time_ms": np.concatenate(time_ms)[sample_order],
+        "raw": raw[sample_order],
+        "acc": (raw[sample_order] * (lsb[sample_order] * STANDARD_GRAVITY / 1000)[:, None]).astype(np.float32),
+    }
+    return sessions, samples
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Decode an accelerometer log to NPZ or Parquet.")
+    parser.add_argument("input", help="ACCEL.BIN from the watch's USB drive, or a dump from the spi-test app")
+    parser.add_argument("output", help="where to write the samples: a .npz, or a .parquet")
+    parser.add_argument("--summary", action="store_true", help="list the sessions")
+    args = parser.parse_args()
+
+    sessions, samples = decode(load_pages(args.input))
+    names = np.array([ACTIVITIES.get(code, code) for code in sessions["activity"].tolist()])
+
+    if args.output.endswith(".parquet"):
+        import pandas as pd
+        frame = pd.DataFrame({
+            "session": samples["session"],
+            "activity": pd.Categorical(names[samples["session"]]) if len(names) else [],
+            "time_ms": samples["time_ms"],
+            "acc_x": samples["acc"][:, 0],
+            "acc_y": samples["acc"][:, 1],
+            "acc_z": samples["acc"][:, 2],
+        })
+        frame.to_parquet(args.output, index=False)
+    else:
+        np.savez(args.output, **samples, **{"session_" + key: value for key, value in sessions.items()},
+                 session_name=names)
+
+    if args.summary:
+        counts = np.bincount(samples["session"], minlength=len(names))
+        for i, name in enumerate(names):
+            print("%3d %-22s %d  %dg LP%d filter %d  %d samples" % (
+                i, name, sessions["timestamp"][i], sessions["range"][i], sessions["lpmode"][i],
+                sessions["filter"][i], counts[i]))
+    print("Decoded %d samples in %d sessions." % (len(samples["session"]), len(names)), file=sys.stderr)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,149 @@
+#!/usr/bin/env python3
+# Decodes accelerometer pages, as written by accelerometer_data_acquisition_face and dumped by the spi-test app as
+# "V1 <512 hex digits>" and "V2 <512 hex digits>" lines. The layouts are described in
+# accelerometer_data_acquisition_face.h.
+#
+# expand() turns those lines into the event and CSV lines process_motion_dump.py reads. Run on its own, this reads a
+# dump and writes the expanded dump to stdout. For long sessions, motion_decode.py does the same decoding with NumPy,
+# much faster.
+
+import struct
+import sys
+
+MAGIC = b"\xfcV2"
+FLAG_SESSION_START = 1 << 6
+FLAG_RATE = 1 << 7
+PAGE_HEADER = struct.Struct("<3sBBBH")
+SESSION_HEADER = struct.Struct("<I2sH")
+RATE_HEADER = struct.Struct("<IB")
+FIRST_SAMPLE = struct.Struct("<hhh")
+
+RANGES = [2, 4, 8, 16]
+FILTERS = [2, 4, 10, 20]
+# mg per count of a 14-bit sample at each range. samples are always stored as 14-bit values (in LP mode 1 the
+# bottom two bits are just zero), so the low power mode doesn't change this.
+LSB_14_BIT = [0.244, 0.488, 0.976, 1.952]
+
+V1_HEADER = 2
+V1_DATA = 1
+
+
+def _nibbles(data, start):
+    for byte in data[start:]:
+        yield byte >> 4
+        yield byte & 0xF
+
+
+def _varints(nibbles):
+    value = 0
+    shift = 0
+    for nibble in nibbles:
+        value |= (nibble & 0x7) << shift
+        shift += 3
+        if not nibble & 0x8:
+            yield value
+            value = 0
+            shift = 0
+
+
+def _unzigzag(value):
+    return (value >> 1) ^ -(value & 1)
+
+
+def decode_page(data):
+    """Returns (flags, session, samples); session is (timestamp, activity, temperature, rate) or None, and samples is
+    a list of (counter, x, y, z) with the axes as signed 14-bit values. rate is the factor that turns counters into
+    centiseconds of RTC time: 1 unless the page says the sensor's clock ran fast or slow and nothing corrected it."""
+    magic, flags, count, period, counter = PAGE_HEADER.unpack_from(data, 0)
+    if magic != MAGIC:
+        raise ValueError("not a version 2 page")
+    pos = PAGE_HEADER.size
+    session = None
+    if flags & FLAG_SESSION_START:
+        timestamp, activity, temperature = SESSION_HEADER.unpack_from(data, pos)
+        pos += SESSION_HEADER.size
+        rate = 1
+        if flags & FLAG_RATE:
+            measured_rate, resampled = RATE_HEADER.unpack_from(data, pos)
+            pos += RATE_HEADER.size
+            # measured_rate is in samples per 1000 seconds; the counters assumed 100 / period samples per second.
+            if not resampled and measured_rate:
+                rate = 100000 / period / measured_rate
+        session = (timestamp, activity.decode("ascii", errors="replace"), temperature, rate)
+    if count == 0:
+        return flags, session, []
+
+    sample = list(FIRST_SAMPLE.unpack_from(data, pos))
+    pos += FIRST_SAMPLE.size
+    samples = [(counter, *sample)]
+    deltas = _varints(_nibbles(data, pos))
+    for i in range(1, count):
+        for axis in range(3):
+            sample[axis] += _unzigzag(next(deltas))
+        samples.append((counter + i * period, *sample))
+    return flags, session, samples
+
+
+def _csv_line(time_ms, x, y, z, lsb):
+    return "%d,%f,%f,%f\n" % (time_ms, 9.80665 * x * lsb / 1000, 9.80665 * y * lsb / 1000, 9.80665 * z * lsb / 1000)
+
+
+class _V1State:
+    """What a version 1 dump has said so far: sessions can span pages, and the header is on the first."""
+    timestamp = 0
+    range_index = 0
+    lsb = 1
+    pending_name = None
+
+
+def _expand_v1(data, state):
+    for (value,) in struct.iter_unpack("<Q", data):
+        kind = value & 0x3
+        if kind == V1_HEADER:
+            state.timestamp = value >> 32
+            state.range_index = (value >> 2) & 0x3
+            state.pending_name = "%s%s.%d." % (chr(value >> 16 & 0xFF), chr(value >> 24 & 0xFF), state.timestamp)
+        elif kind == V1_DATA:
+            lpmode = (value >> 16) & 0x3
+            if state.pending_name is not None:
+                # the sensor's settings come with the first sample, so that's when the event's name is complete.
+                # in low power mode 1 the samples are 12 bits, so each count is four times as much.
+                state.lsb = LSB_14_BIT[state.range_index] * (4 if lpmode == 0 else 1)
+                yield "%sRANGE%d_LP%d_FILT%d.CSV\n" % (state.pending_name, RANGES[state.range_index], lpmode + 1,
+                                                     FILTERS[(value >> 32) & 0x3])
+                yield "timestamp,accX,accY,accZ\n"
+                state.pending_name = None
+            yield _csv_line((state.timestamp * 100 + (value >> 48)) * 10, ((value >> 2) & 0x3FFF) - 8192,
+                            ((value >> 18) & 0x3FFF) - 8192, ((value >> 34) & 0x3FFF) - 8192, state.lsb)
+
+
+def expand(lines):
+    """Yields the input lines, with each page replaced by event and CSV lines."""
+    timestamp = 0
+    rate = 1
+    v1 = _V1State()
+    for line in lines:
+        if line.startswith("V1 "):
+            yield from _expand_v1(bytes.fromhex(line[3:].strip()), v1)
+            continue
+        if not line.startswith("V2 "):
+            yield line
+            continue
+        flags, session, samples = decode_page(bytes.fromhex(line[3:].strip()))
+        range_index = flags & 0x3
+        lpmode = (flags >> 2) & 0x3
+        filter_index = (flags >> 4) & 0x3
+        lsb = LSB_14_BIT[range_index]
+        if session is not None:
+            timestamp = session[0]
+            rate = session[3]
+            yield "%s.%d.RANGE%d_LP%d_FILT%d.CSV\n" % (session[1], timestamp, RANGES[range_index], lpmode + 1,
+                                                     FILTERS[filter_index])
+            yield "timestamp,accX,accY,accZ\n"
+        for counter, x, y, z in samples:
+            yield _csv_line(round((timestamp * 100 + counter * rate) * 10), x, y, z, lsb)
+
+
+if __name__ == "__main__":
+    source = open(sys.argv[1]) if len(sys.argv) > 1 else sys.stdin
+    sys.stdout.writelines(expand(source))
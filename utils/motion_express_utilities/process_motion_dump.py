@@ -2,6 +2,8 @@
 import sys
 from pathlib import Path
 
+from motion_v2 import expand
+
 if not sys.stdin.isatty():
     input_stream = sys.stdin
 
@@ -21,7 +23,7 @@ f = None
 num_events = 0
 num_records = 0
 
-for line in input_stream:
+for line in expand(input_stream):
     if not len(line):
         continue
     if line.strip() == '=== END ===':
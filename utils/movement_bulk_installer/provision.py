@@ -0,0 +1,225 @@
+#!/usr/bin/env python3
+# Flashes and sets up a batch of watches at once. Every WATCHBOOT drive that's plugged in gets the firmware at the same
+# time; then every watch running Movement gets its settings over the binary protocol (see movement/shell_rpc.h), again
+# all at once. Ends with a report of what worked, what didn't, and how long it took.
+#
+# usage: provision.py [--firmware FILE.uf2 | --update FILE.delta] [--config FILE.json] [--wait SECONDS]
+#
+# With only --firmware, it just flashes; with only --config, it just sets up the watches already running Movement.
+# --update updates watches already running Movement with a delta from utils/firmware_delta.py, over USB serial rather
+# than the bootloader; each watch checks the delta was made against the firmware it's running.
+# The config gives the settings each watch should get; watches are matched to its entries in the order their serial
+# ports sort, and the report says which got which:
+#
+#     {
+#         "defaults": {"faces": [0, 1, 2, 5], "time_zone": 16, "sync_time": true},
+#         "watches": [
+#             {"name": "alice", "totp": ["otpauth://totp/Example:alice?secret=JBSWY3DPEHPK3PXP&issuer=Example"]},
+#             {"name": "bob", "faces": [0, 1], "time_zone": 4}
+#         ]
+#     }
+#
+# faces is the order MODE steps through, by index in the firmware's watch_faces; time_zone is an index into Movement's
+# time zone table; totp is written to totp_uris.txt for totp_face_lfs; files copies local files onto the watch, as
+# {"WATCH_PATH": "LOCAL_PATH"}; sync_time sets the clock from this computer's. Each watch's entry adds to, and
+# overrides, the defaults. With no watches list, every watch gets the defaults.
+#
+# Requires pyserial (pip install pyserial).
+
+import argparse
+import concurrent.futures
+import glob
+import json
+import os
+import shutil
+import string
+import struct
+import sys
+import time
+
+import serial
+import serial.tools.list_ports
+
+sys.path.insert(0, os.path.join(os.path.dirname(os.path.abspath(__file__)), ".."))
+import sensorwatch_rpc as rpc  # noqa: E402
+
+USB_VID = 0x1209
+USB_PID = 0x2151
+BOOT_VOLUME = "WATCHBOOT"
+TOTP_FILE = "totp_uris.txt"
+# where GCC packs movement_settings_t's 6-bit time_zone: it starts a new byte rather than straddle one.
+TIME_ZONE_SHIFT = 24
+TIME_ZONE_MASK = 0x3F << TIME_ZONE_SHIFT
+
+
+def find_boot_drives():
+    """Mounted UF2 bootloader drives; a second one shows up as WATCHBOOT 1, WATCHBOOT1 and so on."""
+    roots = ["/Volumes/*", "/media/*/*", "/run/media/*/*"]
+    if os.name == "nt":
+        roots = ["%s:\\" % letter for letter in string.ascii_uppercase]
+    drives = []
+    for root in roots:
+        for path in glob.glob(root):
+            label = os.path.basename(path.rstrip("\\/")) if os.name != "nt" else path
+            if (os.name == "nt" or label.startswith(BOOT_VOLUME)) and os.path.exists(os.path.join(path, "INFO_UF2.TXT")):
+                drives.append(path)
+    return sorted(drives)
+
+
+def find_watch_ports():
+    return sorted(port.device for port in serial.tools.list_ports.comports()
+                  if port.vid == USB_VID and port.pid == USB_PID)
+
+
+def flash(drive, firmware, timeout):
+    """Copies the firmware and waits for the bootloader to restart the watch, which takes the drive away."""
+    start = time.monotonic()
+    try:
+        shutil.copyfile(firmware, os.path.join(drive, os.path.basename(firmware)))
+    except OSError:
+        # some systems complain when the drive vanishes mid-close; whether it's gone is what tells.
+        pass
+    while os.path.exists(os.path.join(drive, "INFO_UF2.TXT")):
+        if time.monotonic() - start > timeout:
+            raise RuntimeError("the drive didn't go away; the copy may not have finished")
+        time.sleep(0.2)
+    return time.monotonic() - start
+
+
+def provision(port_name, config):
+    """Applies one watch's config; returns a list of what was done."""
+    done = []
+    with serial.Serial(port_name, timeout=0.05) as port:
+        watch = rpc.Watch(port)
+        version = watch.ping()
+        done.append("protocol %d" % version)
+        if "faces" in config:
+            watch.call(rpc.FACES_SET, bytes(config["faces"]))
+            done.append("faces")
+        if "time_zone" in config:
+            settings = struct.unpack("<I", watch.call(rpc.SETTINGS_GET))[0]
+            settings = (settings & ~TIME_ZONE_MASK) | (config["time_zone"] << TIME_ZONE_SHIFT & TIME_ZONE_MASK)
+            watch.call(rpc.SETTINGS_SET, struct.pack("<I", settings))
+            done.append("time zone")
+        files = dict(config.get("files", {}))
+        for watch_path, local_path in files.items():
+            with open(local_path, "rb") as f:
+                watch.put(watch_path, f.read())
+        if "totp" in config:
+            watch.put(TOTP_FILE, "".join(uri + "\n" for uri in config["totp"]).encode("ascii"))
+            files[TOTP_FILE] = None
+        if files:
+            done.append("%d files" % len(files))
+        if config.get("sync_time"):
+            done.append("time, %+.1f ms" % (rpc.rtc_sync(watch) * 1000))
+    return done
+
+
+def update(port_name, delta):
+    with serial.Serial(port_name, timeout=0.05) as port:
+        watch = rpc.Watch(port)
+        watch.ping()
+        rpc.update(watch, delta)
+    return ["%d bytes" % len(delta)]
+
+
+def run_all(jobs, function):
+    """Runs function(*arguments) for each (name, arguments) in jobs at once; returns {name: (ok, result, seconds)}."""
+    results = {}
+    with concurrent.futures.ThreadPoolExecutor(max_workers=max(1, len(jobs))) as pool:
+        futures = {}
+        for name, arguments in jobs:
+            futures[pool.submit(lambda a=arguments: (time.monotonic(), function(*a), time.monotonic()))] = name
+        for future in concurrent.futures.as_completed(futures):
+            name = futures[future]
+            try:
+                start, result, end = future.result()
+                results[name] = (True, result, end - start)
+            except BaseException as e:  # sensorwatch_rpc gives up with sys.exit
+                results[name] = (False, str(e) or type(e).__name__, 0)
+    return results
+
+
+def report(title, results):
+    print("\n%s:" % title)
+    for name in sorted(results):
+        ok, result, seconds = results[name]
+        if ok:
+            detail = ", ".join(result) if isinstance(result, list) else ""
+            print("  ok      %-28s %5.1f s  %s" % (name, seconds, detail))
+        else:
+            print("  FAILED  %-28s %s" % (name, result))
+    return sum(1 for ok, _, _ in results.values() if not ok)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Flash and set up every connected Sensor Watch at once.")
+    parser.add_argument("--firmware", help="UF2 file to flash onto every WATCHBOOT drive")
+    parser.add_argument("--update", help="firmware delta to send to every watch running Movement")
+    parser.add_argument("--config", help="JSON file of settings to give the watches")
+    parser.add_argument("--wait", type=float, default=30, help="seconds to wait for each step (default 30)")
+    args = parser.parse_args()
+    if not args.firmware and not args.update and not args.config:
+        parser.error("give --firmware or --update, --config, or both")
+    if args.firmware and args.update:
+        parser.error("give --firmware or --update, not both")
+
+    start = time.monotonic()
+    failures = 0
+    flashed = 0
+
+    if args.firmware:
+        drives = find_boot_drives()
+        if not drives:
+            sys.exit("provision: no %s drives found; double-tap the watch's reset button" % BOOT_VOLUME)
+        print("flashing %d watches with %s" % (len(drives), os.path.basename(args.firmware)))
+        results = run_all([(drive, (drive, args.firmware, args.wait)) for drive in drives], flash)
+        failures += report("flashing", results)
+        flashed = sum(1 for ok, _, _ in results.values() if ok)
+
+    if args.update:
+        with open(args.update, "rb") as f:
+            delta = f.read()
+        ports = find_watch_ports()
+        if not ports:
+            sys.exit("provision: no watches running Movement found")
+        print("updating %d watches with %s" % (len(ports), os.path.basename(args.update)))
+        results = run_all([(port_name, (port_name, delta)) for port_name in ports], update)
+        failures += report("updating", results)
+        flashed = sum(1 for ok, _, _ in results.values() if ok)
+        # let the updated watches drop off USB before looking for them to come back.
+        time.sleep(2)
+
+    if args.config:
+        with open(args.config) as f:
+            config = json.load(f)
+        # the watches just flashed take a moment to start and show up as serial ports.
+        deadline = time.monotonic() + (args.wait if flashed else 0)
+        ports = find_watch_ports()
+        while len(ports) < flashed and time.monotonic() < deadline:
+            time.sleep(0.5)
+            ports = find_watch_ports()
+        if not ports:
+            sys.exit("provision: no watches running Movement found")
+        entries = config.get("watches") or [{} for _ in ports]
+        if len(entries) < len(ports):
+            print("provision: %d watches but only %d config entries; the rest are left alone" %
+                  (len(ports), len(entries)))
+        jobs = []
+        for port_name, entry in zip(ports, entries):
+            watch_config = dict(config.get("defaults", {}))
+            watch_config.update(entry)
+            name = "%s (%s)" % (port_name, entry["name"]) if "name" in entry else port_name
+            jobs.append((name, (port_name, watch_config)))
+        print("setting up %d watches" % len(jobs))
+        failures += report("setting up", run_all(jobs, provision))
+
+    elapsed = time.monotonic() - start
+    watches = max(flashed, len(jobs) if args.config else 0)
+    print("\n%d watches in %.1f s (%.1f a minute), %d failures" %
+          (watches, elapsed, watches * 60 / elapsed if elapsed else 0, failures))
+    sys.exit(1 if failures else 0)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+# Builds each alternate firmware in movement/alt_fw for the headless simulator, runs it through the same simulated day
+# (power_regression/day.txt: a night in low energy mode, the hourly chime, and a few sessions on the buttons), and
+# compares the charge each one spends, and the number of times it wakes, against power_regression/baseline.json. A
+# profile whose faces spend more than --tolerance over its baseline, or that wakes more than --wake-tolerance more
+# often, fails the run; so does one with no baseline at all. Run with --update to record what this tree does as the
+# new baseline, once a change that costs more is one that's meant to.
+#
+# usage: power_regression.py [--update] [--no-build] [--color GREEN] [--tolerance 0.1] [--wake-tolerance 0.25]
+#                            [PROFILE...]
+#
+# Each PROFILE is the name of a header in movement/alt_fw, like the_athlete; without any, it runs them all. The charge
+# comes from the simulator's energy model (see watch_sim_energy.h), with the rates in the board's energy_costs.h, so
+# it's for catching a change that makes a profile cost more, not for promising a battery life. The tolerance applies
+# to what the faces spend, on top of the standby current every profile pays, which would otherwise swamp it. The
+# builds share movement/make/build-matrix with utils/sim_matrix.py.
+
+import argparse
+import glob
+import json
+import os
+import re
+import sys
+
+from sim_matrix import Build
+
+UTILS_DIR = os.path.dirname(os.path.abspath(__file__))
+ALT_FW_DIR = os.path.join(UTILS_DIR, "..", "movement", "alt_fw")
+DAY_SCRIPT = os.path.join(UTILS_DIR, "power_regression", "day.txt")
+BASELINE = os.path.join(UTILS_DIR, "power_regression", "baseline.json")
+# the day starts at midnight, on a Monday, so that anything that cares about the date sees the same one every time.
+START_TIME = "2024-06-03 00:00:00"
+HOURS = re.compile(r"^([0-9.]+) simulated hours")
+STANDBY = re.compile(r"standby costs ([0-9.]+) uA\*s/h")
+TOTAL = re.compile(r"^total ([0-9.]+) uA\*s/h")
+
+
+def read_energy(build):
+    """Returns (µAh a day, the part of it the faces spent, wakes a day) from what the energy command printed at the end
+    of the day."""
+    for command, lines in reversed(build.sections):
+        if command == "energy":
+            break
+    else:
+        sys.exit("power_regression: %s printed no energy report" % build.name)
+    hours = total = standby = None
+    wakes = 0
+    for line in lines:
+        if HOURS.match(line):
+            hours = float(HOURS.match(line).group(1))
+            standby = float(STANDBY.search(line).group(1))
+        elif TOTAL.match(line):
+            total = float(TOTAL.match(line).group(1))
+        elif line[:1].isdigit():
+            # one line per face: its index, then the count of each thing it was charged for, wakes first.
+            wakes += int(line.split("\t")[1])
+    if not hours or total is None:
+        sys.exit("power_regression: can't read %s's energy report:\n%s" % (build.name, "\n".join(lines)))
+    return total * 24 / 3600, (total - standby) * 24 / 3600, wakes * 24 / hours
+
+
+def change(value, before):
+    return (value - before) / before if before else (float("inf") if value else 0)
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Check what each alternate firmware spends in a simulated day.")
+    parser.add_argument("--update", action="store_true", help="record these results as the new baseline")
+    parser.add_argument("--no-build", action="store_true", help="run what was built last time")
+    parser.add_argument("--color", default="GREEN", help="the board's LED color, as make's COLOR takes it")
+    parser.add_argument("--tolerance", type=float, default=0.10,
+                        help="how much more the faces may spend a day than the baseline, as a fraction (default 0.1)")
+    parser.add_argument("--wake-tolerance", type=float, default=0.25,
+                        help="how many more wakes a day than the baseline are allowed, as a fraction (default 0.25)")
+    parser.add_argument("profiles", metavar="PROFILE", nargs="*")
+    args = parser.parse_args()
+
+    available = sorted(os.path.splitext(os.path.basename(path))[0] for path in glob.glob(os.path.join(ALT_FW_DIR, "*.h")))
+    names = args.profiles or available
+    for name in names:
+        if name not in available:
+            sys.exit("power_regression: no profile %s in movement/alt_fw (there's %s)" % (name, ", ".join(available)))
+    builds = [Build("%s=%s" % (name, os.path.join(ALT_FW_DIR, name + ".h"))) for name in names]
+
+    baseline = {}
+    if os.path.exists(BASELINE):
+        with open(BASELINE) as f:
+            baseline = json.load(f)["profiles"]
+
+    # each build already keeps every core busy, so they take turns; a day's run takes well under a second.
+    if not args.no_build:
+        for build in builds:
+            build.make(args.color)
+    results = {}
+    for build in builds:
+        build.run(DAY_SCRIPT, ["-t", START_TIME])
+        results[build.name] = read_energy(build)
+
+    width = max(len(name) for name in names + ["profile"])
+    print("%-*s  %10s  %10s  %8s  %10s  %8s" % (width, "profile", "uAh/day", "faces", "change", "wakes/day", "change"))
+    failures = []
+    for name in names:
+        charge, faces, wakes = results[name]
+        before = baseline.get(name)
+        if before is None:
+            print("%-*s  %10.1f  %10.1f  %8s  %10.0f  %8s" % (width, name, charge, faces, "new", wakes, "new"))
+            failures.append("%s has no baseline" % name)
+            continue
+        faces_change = change(faces, before["faces_uah_per_day"])
+        wake_change = change(wakes, before["wakes_per_day"])
+        print("%-*s  %10.1f  %10.1f  %+7.1f%%  %10.0f  %+7.1f%%" % (width, name, charge, faces, 100 * faces_change,
+                                                                  wakes, 100 * wake_change))
+        if faces_change > args.tolerance:
+            failures.append("%s's faces spend %.1f uAh a day, %.0f%% more than their baseline of %.1f" %
+                            (name, faces, 100 * faces_change, before["faces_uah_per_day"]))
+        if wake_change > args.wake_tolerance:
+            failures.append("%s wakes %.0f times a day, %.0f%% more than its baseline of %.0f" %
+                            (name, wakes, 100 * wake_change, before["wakes_per_day"]))
+
+    if args.update:
+        for name in names:
+            charge, faces, wakes = results[name]
+            baseline[name] = {"uah_per_day": round(charge, 2), "faces_uah_per_day": round(faces, 2),
+                              "wakes_per_day": round(wakes)}
+        with open(BASELINE, "w") as f:
+            json.dump({"profiles": baseline}, f, indent=4, sort_keys=True)
+            f.write("\n")
+        print("recorded %d profiles in %s" % (len(names), os.path.relpath(BASELINE)))
+        return
+
+    for failure in failures:
+        print("power_regression: " + failure)
+    if failures:
+        print("if that's what the change should cost, record it with: utils/power_regression.py --update")
+        sys.exit(1)
+
+
+if __name__ == "__main__":
+    main()
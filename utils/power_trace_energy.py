@@ -0,0 +1,114 @@
+#!/usr/bin/env python3
+# Adds up the time, charge and energy a Sensor Watch spends in each code region, from a power analyzer recording of a
+# watch built with POWER_TRACE=1. The watch puts the number of the region it's in on three sensor board pins (see
+# watch-library/shared/watch/watch_power_trace.h); wire them to the analyzer's digital inputs and export the
+# recording as CSV, with the current and all three pins sampled together.
+#
+# usage: power_trace_energy.py [options] RECORDING.csv
+#
+# Exports from the Nordic Power Profiler Kit II work with --ppk2. For anything else (i.e. a Joulescope), name the
+# columns: --time and --current, plus either --bits (one 0/1 column per pin, bit 0 first) or --bitstring (one column
+# of 0s and 1s, bit 0 first). The pins change one at a time, so a region change can show an in-between region for a
+# few CPU cycles; that's a fraction of a sample at any rate these analyzers record.
+#
+# With --benchmark, it reads a recording of apps/power-benchmark instead: four pins, with the number of the state the
+# watch is in, and 0 meaning it's still in the last one (the sleep modes turn the pins off). Dividing each state's
+# charge by its time gives the mean current that the board's energy_costs.h estimates.
+
+import argparse
+import csv
+import sys
+
+REGIONS = ["none", "sleep", "app loop", "face", "background", "display", "user 1", "user 2"]
+# the states apps/power-benchmark steps through, in the order it numbers them.
+BENCHMARK_STATES = ["none", "standby LCD on", "standby LCD off", "1 Hz tick", "128 Hz tick", "LED", "buzzer", "I2C",
+                    "ADC", "flash erase", "backup", "state 11", "state 12", "state 13", "state 14", "done"]
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(description="Per-region energy from a POWER_TRACE recording.")
+    parser.add_argument("recording", help="CSV export from the power analyzer")
+    parser.add_argument("--ppk2", action="store_true", help="the CSV is a Power Profiler Kit II export, with D0-D2 wired to the trace pins")
+    parser.add_argument("--benchmark", action="store_true", help="the recording is of apps/power-benchmark, with D0-D3 wired to A0-A3")
+    parser.add_argument("--time", help="name of the time column")
+    parser.add_argument("--time-scale", type=float, default=1.0, help="seconds per unit of the time column (default 1)")
+    parser.add_argument("--current", help="name of the current column")
+    parser.add_argument("--current-scale", type=float, default=1.0, help="amps per unit of the current column (default 1)")
+    parser.add_argument("--bits", help="names of the columns with bits 0, 1 and 2 of the region (and 3, with --benchmark), separated by commas")
+    parser.add_argument("--bitstring", help="name of a column of 0s and 1s with bit 0 of the region first")
+    parser.add_argument("--voltage", type=float, default=3.0, help="supply voltage, for energy (default 3.0)")
+    args = parser.parse_args()
+
+    if args.ppk2:
+        args.time = args.time or "Timestamp(ms)"
+        args.time_scale = 1e-3
+        args.current = args.current or "Current(uA)"
+        args.current_scale = 1e-6
+        args.bitstring = args.bitstring or "D0-D7"
+    if not args.time or not args.current or not (args.bits or args.bitstring):
+        parser.error("name the --time, --current and --bits or --bitstring columns, or pass --ppk2")
+    args.width = 4 if args.benchmark else 3
+    args.names = BENCHMARK_STATES if args.benchmark else REGIONS
+    return args
+
+
+def read_samples(args):
+    with open(args.recording, newline="") as f:
+        reader = csv.DictReader(f)
+        bit_columns = args.bits.split(",") if args.bits else []
+        for column in [args.time, args.current] + bit_columns + ([args.bitstring] if args.bitstring else []):
+            if column not in reader.fieldnames:
+                sys.exit("power_trace_energy: no column named %r; the columns are %s" % (column, ", ".join(reader.fieldnames)))
+        last = 0
+        for row in reader:
+            if args.bitstring:
+                bits = row[args.bitstring].strip()
+                region = sum(1 << i for i, bit in enumerate(bits[:args.width]) if bit == "1")
+            else:
+                region = sum(1 << i for i, column in enumerate(bit_columns[:args.width]) if float(row[column]) >= 0.5)
+            if args.benchmark:
+                # the pins go low while the watch sleeps, and it's still in the state it last showed.
+                region = last = region or last
+            yield float(row[args.time]) * args.time_scale, float(row[args.current]) * args.current_scale, region
+
+
+def main():
+    args = parse_args()
+    seconds = [0.0] * len(args.names)
+    charge = [0.0] * len(args.names)
+    entries = [0] * len(args.names)
+
+    # each sample's current and region hold until the next sample.
+    previous = None
+    for sample in read_samples(args):
+        if previous is not None:
+            time, current, region = previous
+            dt = sample[0] - time
+            seconds[region] += dt
+            charge[region] += current * dt
+            if sample[2] != region:
+                entries[sample[2]] += 1
+        else:
+            entries[sample[2]] += 1
+        previous = sample
+    total_seconds = sum(seconds)
+    if total_seconds <= 0:
+        sys.exit("power_trace_energy: the recording needs at least two samples")
+    total_charge = sum(charge)
+
+    print("%-15s %10s %7s %8s %12s %12s %9s %8s" %
+          ("state" if args.benchmark else "region", "time (s)", "time %", "entries", "mean (uA)", "energy (uJ)", "energy %", "per (uJ)"))
+    for region, name in enumerate(args.names):
+        if seconds[region] <= 0:
+            continue
+        energy = charge[region] * args.voltage
+        print("%-15s %10.4f %6.2f%% %8d %12.2f %12.2f %8.2f%% %8.3f" % (
+            name, seconds[region], 100 * seconds[region] / total_seconds, entries[region],
+            1e6 * charge[region] / seconds[region], 1e6 * energy,
+            100 * charge[region] / total_charge if total_charge else 0, 1e6 * energy / max(entries[region], 1)))
+    print("%-15s %10.4f %7s %8s %12.2f %12.2f" %
+          ("total", total_seconds, "", "", 1e6 * total_charge / total_seconds, 1e6 * total_charge * args.voltage))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,130 @@
+#!/usr/bin/env python3
+# Turns what a Sensor Watch's profiler printed into a list of the functions the CPU spent its time in. Build the
+# firmware with make PROFILER=1, then in its USB serial shell run "prof start", use the watch for a while, run
+# "prof stop", then "prof" to print the samples (and "prof trace" for a branch trace, if some code was wrapped in
+# watch_profiler_trace_begin and watch_profiler_trace_end). Save what it printed to a file and give it to this along
+# with the ELF from the same build (see watch_profiler.h).
+#
+# usage: profile_report.py [--top N] [--lines] ELF_FILE DUMP_FILE
+#
+# Each function gets its share of the samples, hottest first; --lines adds the source lines within each of them that
+# drew the most, from addr2line. A branch trace is printed with each address as function+offset. Needs the ARM
+# toolchain's nm and addr2line on the PATH, or --nm and --addr2line saying where they are.
+
+import argparse
+import bisect
+import re
+import subprocess
+import sys
+
+HEADER = re.compile(r"^# samples (\d+) dropped (\d+) period (\d+)")
+SAMPLE = re.compile(r"^0x([0-9a-f]{8}) (\d+)$")
+BRANCH = re.compile(r"^0x([0-9a-f]{8}) 0x([0-9a-f]{8})( x)?$")
+LINES_PER_FUNCTION = 3
+
+
+class Symbols:
+    """The ELF's functions, for looking up which one an address is in."""
+
+    def __init__(self, nm, elf):
+        output = subprocess.run([nm, "-n", "-S", "--defined-only", elf], stdout=subprocess.PIPE, text=True, check=True)
+        self.starts = []
+        self.functions = []
+        for line in output.stdout.splitlines():
+            fields = line.split()
+            # address, size, type and name; symbols without a size are labels, not functions.
+            if len(fields) != 4 or fields[2] not in "tTwW":
+                continue
+            # Thumb functions' addresses have bit 0 set, which the PC never does.
+            self.starts.append(int(fields[0], 16) & ~1)
+            self.functions.append((fields[3], int(fields[1], 16)))
+
+    def lookup(self, address):
+        """Returns the function address is in and how far into it, or None and the address itself."""
+        i = bisect.bisect_right(self.starts, address) - 1
+        if i >= 0:
+            name, size = self.functions[i]
+            if address < self.starts[i] + size:
+                return name, address - self.starts[i]
+        return None, address
+
+    def describe(self, address):
+        name, offset = self.lookup(address)
+        return "%s+0x%x" % (name, offset) if name else "0x%08x" % address
+
+
+def source_lines(addr2line, elf, addresses):
+    """Returns file:line for each address."""
+    output = subprocess.run([addr2line, "-e", elf] + ["0x%x" % a for a in addresses], stdout=subprocess.PIPE,
+                            text=True, check=True)
+    return output.stdout.splitlines()
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Where the CPU's time went, from a PROFILER=1 build's prof output.")
+    parser.add_argument("elf", help="the firmware's ELF file, from the same build")
+    parser.add_argument("dump", help="what prof and prof trace printed, saved from the serial shell")
+    parser.add_argument("--top", type=int, default=30, help="how many functions to list (default 30)")
+    parser.add_argument("--lines", action="store_true", help="show the hottest source lines in each function")
+    parser.add_argument("--nm", default="arm-none-eabi-nm")
+    parser.add_argument("--addr2line", default="arm-none-eabi-addr2line")
+    args = parser.parse_args()
+
+    symbols = Symbols(args.nm, args.elf)
+    samples = {}
+    branches = []
+    header = None
+    with open(args.dump) as dump:
+        for line in dump:
+            line = line.strip()
+            match = HEADER.match(line)
+            if match:
+                header = tuple(int(g) for g in match.groups())
+                continue
+            match = SAMPLE.match(line)
+            if match:
+                address = int(match.group(1), 16)
+                samples[address] = samples.get(address, 0) + int(match.group(2))
+                continue
+            match = BRANCH.match(line)
+            if match:
+                branches.append((int(match.group(1), 16), int(match.group(2), 16), bool(match.group(3))))
+
+    if samples:
+        total = sum(samples.values())
+        if header:
+            print("%d samples, one every %d cycles" % (header[0], header[2]))
+            if header[1]:
+                print("%d more were dropped: the table was full. Shorter runs, or a bigger WATCH_PROFILER_SLOTS, "
+                      "would catch them." % header[1])
+        functions = {}
+        for address, count in samples.items():
+            name, _ = symbols.lookup(address)
+            name = name or "(unknown)"
+            entry = functions.setdefault(name, [0, {}])
+            entry[0] += count
+            entry[1][address] = count
+
+        print("%8s %6s  %s" % ("samples", "share", "function"))
+        hottest = sorted(functions.items(), key=lambda item: item[1][0], reverse=True)[:args.top]
+        for name, (count, addresses) in hottest:
+            print("%8d %5.1f%%  %s" % (count, 100.0 * count / total, name))
+            if args.lines:
+                top = sorted(addresses.items(), key=lambda item: item[1], reverse=True)[:LINES_PER_FUNCTION]
+                for (address, hits), where in zip(top, source_lines(args.addr2line, args.elf, [a for a, _ in top])):
+                    print("%8d         %s (0x%08x)" % (hits, where, address))
+
+    if branches:
+        if samples:
+            print()
+        print("%d branches, oldest first" % len(branches))
+        for source, destination, exception in branches:
+            print("%-40s -> %s%s" % (symbols.describe(source), symbols.describe(destination),
+                                     "  (exception)" if exception else ""))
+
+    if not samples and not branches:
+        sys.exit("%s has no profiler output in it" % args.dump)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,332 @@
+#!/usr/bin/env python3
+# Talks to a Sensor Watch over the binary protocol that shares its USB serial port with the shell (see
+# movement/shell_rpc.h). Requests are COBS frames with a CRC-16, sent several at a time and matched to their responses
+# by sequence number, so copying a file doesn't wait on a round trip per chunk the way sensorwatch_transfer.py does.
+#
+# usage: sensorwatch_rpc.py PORT ping
+#        sensorwatch_rpc.py PORT ls
+#        sensorwatch_rpc.py PORT get WATCH_PATH [LOCAL_PATH]
+#        sensorwatch_rpc.py PORT put LOCAL_PATH [WATCH_PATH]
+#        sensorwatch_rpc.py PORT rm WATCH_PATH
+#        sensorwatch_rpc.py PORT kv KEY [VALUE]           (an empty VALUE deletes the key)
+#        sensorwatch_rpc.py PORT settings [HEX]
+#        sensorwatch_rpc.py PORT rtc [sync]                (sync sets the watch to this computer's local time)
+#        sensorwatch_rpc.py PORT rtc measure [MINUTES]     (times the watch's seconds against this computer's clock)
+#        sensorwatch_rpc.py PORT faces [INDEX ...]         (no indexes with "reset" goes back to the built-in order)
+#        sensorwatch_rpc.py PORT stats [reset]
+#        sensorwatch_rpc.py PORT update FILE.delta            (from firmware_delta.py; the watch restarts into it)
+#
+# Requires pyserial (pip install pyserial). PORT is something like /dev/ttyACM0 or /dev/cu.usbmodem1101.
+
+import binascii
+import datetime
+import os
+import struct
+import sys
+import time
+
+import serial
+
+import firmware_delta
+
+TIMEOUT = 2
+RETRIES = 3
+WINDOW = 4  # requests in flight at once; the watch handles them in order as they arrive
+
+PING, FILE_LIST, FILE_STAT, FILE_READ, FILE_WRITE, FILE_REMOVE = 0x00, 0x01, 0x02, 0x03, 0x04, 0x05
+KV_GET, KV_SET, SETTINGS_GET, SETTINGS_SET = 0x10, 0x11, 0x12, 0x13
+RTC_GET, RTC_SET, RTC_EDGE = 0x20, 0x21, 0x22
+FACES_GET, FACES_SET = 0x30, 0x31
+STATS_GET, STATS_RESET = 0x40, 0x41
+UPDATE_BEGIN, UPDATE_DATA, UPDATE_FINISH = 0x50, 0x51, 0x52
+
+STATUS = ["OK", "unknown opcode", "bad request", "not found", "failed"]
+OK = 0
+
+
+class WatchError(Exception):
+    def __init__(self, status):
+        super().__init__(STATUS[status] if status < len(STATUS) else "status %d" % status)
+        self.status = status
+
+
+def cobs_encode(data):
+    out = bytearray()
+    block = bytearray()
+    for byte in data:
+        if byte == 0:
+            out += bytes([len(block) + 1]) + block
+            block = bytearray()
+        else:
+            block.append(byte)
+            if len(block) == 254:
+                out += b"\xff" + block
+                block = bytearray()
+    return bytes(out + bytes([len(block) + 1]) + block)
+
+
+def cobs_decode(data):
+    out = bytearray()
+    i = 0
+    while i < len(data):
+        code = data[i]
+        if code == 0 or i + code > len(data):
+            return None
+        out += data[i + 1:i + code]
+        i += code
+        if code < 0xFF and i < len(data):
+            out.append(0)
+    return bytes(out)
+
+
+class Watch:
+    def __init__(self, port):
+        self.port = port
+        self.seq = 0
+        self.received = bytearray()
+        self.max_data = 256
+
+    def _send(self, seq, opcode, args):
+        payload = bytes([seq, opcode]) + args
+        payload += struct.pack("<H", binascii.crc_hqx(payload, 0xFFFF))
+        self.port.write(b"\x00" + cobs_encode(payload) + b"\x00")
+
+    def _receive(self):
+        """Returns the next intact response as (seq, opcode, status, data), or None on a timeout. Text from the shell
+        (which never contains a 0 byte) just fails to decode and is skipped."""
+        deadline = time.monotonic() + TIMEOUT
+        while time.monotonic() < deadline:
+            while b"\x00" in self.received:
+                frame, _, rest = self.received.partition(b"\x00")
+                self.received = bytearray(rest)
+                payload = cobs_decode(frame) if frame else None
+                if not payload or len(payload) < 5:
+                    continue
+                if binascii.crc_hqx(payload[:-2], 0xFFFF) != struct.unpack("<H", payload[-2:])[0]:
+                    continue
+                return payload[0], payload[1] & 0x7F, payload[2], payload[3:-2]
+            self.received += self.port.read(max(1, self.port.in_waiting))
+        return None
+
+    def batch(self, requests):
+        """Sends (opcode, args) requests, up to WINDOW at a time, and returns their data in the same order. Any that
+        go unanswered are sent again."""
+        results = [None] * len(requests)
+        pending = {}  # seq -> index into requests
+        next_index = 0
+        retries = 0
+        while next_index < len(requests) or pending:
+            while next_index < len(requests) and len(pending) < WINDOW:
+                self.seq = (self.seq + 1) & 0xFF
+                pending[self.seq] = next_index
+                self._send(self.seq, *requests[next_index])
+                next_index += 1
+            response = self._receive()
+            if response is None:
+                retries += 1
+                if retries > RETRIES:
+                    sys.exit("sensorwatch_rpc: the watch isn't answering")
+                # resend everything outstanding, in order, under new sequence numbers so late answers are ignored.
+                indexes = sorted(pending.values())
+                pending.clear()
+                for index in indexes:
+                    self.seq = (self.seq + 1) & 0xFF
+                    pending[self.seq] = index
+                    self._send(self.seq, *requests[index])
+                continue
+            seq, opcode, status, data = response
+            if seq not in pending or requests[pending[seq]][0] != opcode:
+                continue
+            index = pending.pop(seq)
+            if status != OK:
+                raise WatchError(status)
+            results[index] = data
+        return results
+
+    def call(self, opcode, args=b""):
+        return self.batch([(opcode, args)])[0]
+
+    def ping(self):
+        version, self.max_data = struct.unpack("<BH", self.call(PING))
+        return version
+
+    def list_files(self):
+        files = []
+        while True:
+            data = self.call(FILE_LIST, struct.pack("<H", len(files)))
+            if not data:
+                return files
+            while data:
+                size, length = struct.unpack("<IB", data[:5])
+                files.append((data[5:5 + length].decode("ascii", errors="replace"), size))
+                data = data[5 + length:]
+
+    def get(self, path):
+        size = struct.unpack("<I", self.call(FILE_STAT, path.encode()))[0]
+        requests = [(FILE_READ, struct.pack("<IH", offset, self.max_data) + path.encode())
+                    for offset in range(0, size, self.max_data)]
+        return b"".join(self.batch(requests))
+
+    def put(self, path, data):
+        # later chunks append, so they have to land in order; the watch handles requests in the order they arrive.
+        chunk = self.max_data
+        requests = [(FILE_WRITE, struct.pack("<IB", offset, len(path)) + path.encode() + data[offset:offset + chunk])
+                    for offset in range(0, max(len(data), 1), chunk)]
+        self.batch(requests)
+
+
+def pack_date_time(t):
+    # watch_date_time: seconds, minute, hour, day, month, year since 2020, low bits first.
+    return t.second | t.minute << 6 | t.hour << 12 | t.day << 17 | t.month << 22 | (t.year - 2020) << 26
+
+
+def unpack_date_time(reg):
+    return datetime.datetime((reg >> 26) + 2020, reg >> 22 & 0xF, reg >> 17 & 0x1F, reg >> 12 & 0x1F,
+                             reg >> 6 & 0x3F, reg & 0x3F)
+
+
+def round_trip(watch):
+    """The quickest of a few pings, in seconds; half of it is about how long a byte takes to reach the watch."""
+    best = None
+    for _ in range(8):
+        start = time.time()
+        watch.call(PING)
+        elapsed = time.time() - start
+        best = elapsed if best is None else min(best, elapsed)
+    return best
+
+
+def edge_offset(watch):
+    """How far the watch's clock is ahead of this computer's, in seconds, at the start of a second on the watch."""
+    data = watch.call(RTC_EDGE)
+    received = time.time()
+    return unpack_date_time(struct.unpack("<I", data)[0]).timestamp() - received
+
+
+def rtc_sync(watch):
+    """Sets the watch's clock so its seconds start with this computer's; returns how far off it ended up."""
+    latency = round_trip(watch) / 2
+    # ask well ahead of a second boundary, so the request is answered before it comes.
+    now = time.time()
+    boundary = int(now) + (2 if now % 1 > 0.5 else 1)
+    watch.call(RTC_SET, struct.pack("<IB", pack_date_time(datetime.datetime.fromtimestamp(boundary)), 1))
+    while time.time() < boundary - latency:
+        pass
+    watch.port.write(b"\x00")
+    watch.port.flush()
+    time.sleep(0.1)
+    return edge_offset(watch)
+
+
+def rtc_measure(watch, minutes):
+    # each sample is late by the time the answer takes to get here, which barely changes; fit a line to the offsets
+    # and its slope is how far the watch gains or loses.
+    samples = []
+    end = time.time() + minutes * 60
+    while time.time() < end:
+        samples.append((time.time(), edge_offset(watch)))
+        time.sleep(4)
+    if len(samples) < 3:
+        sys.exit("sensorwatch_rpc: measure for longer")
+    n = len(samples)
+    mean_t = sum(t for t, _ in samples) / n
+    mean_o = sum(o for _, o in samples) / n
+    slope = (sum((t - mean_t) * (o - mean_o) for t, o in samples) /
+             sum((t - mean_t) ** 2 for t, _ in samples))
+    ppm = slope * 1e6
+    print("%d samples over %.1f minutes: the watch is %+.1f ms off, and %s %.2f ppm (%.2f s a day)" %
+          (n, (samples[-1][0] - samples[0][0]) / 60, samples[-1][1] * 1000, "gains" if ppm > 0 else "loses",
+           abs(ppm), abs(slope) * 86400))
+    # a positive FREQCORR slows the RTC down.
+    print("to correct it, add %+.2f ppm to the frequency correction in nanosec_face" % ppm)
+
+
+def update(watch, delta):
+    """Sends a firmware delta; once the watch has checked the image it builds, it installs it and restarts."""
+    watch.call(UPDATE_BEGIN, struct.pack("<IIII", *firmware_delta.parse_header(delta)))
+    watch.batch([(UPDATE_DATA, struct.pack("<I", offset) + piece)
+                 for offset, piece in firmware_delta.chunks(delta, watch.max_data)])
+    watch.call(UPDATE_FINISH)
+
+
+def main():
+    if len(sys.argv) < 3:
+        sys.exit("usage: %s PORT COMMAND [ARGUMENTS]; see the top of this file" % sys.argv[0])
+    command, args = sys.argv[2], sys.argv[3:]
+
+    with serial.Serial(sys.argv[1], timeout=0.05) as port:
+        watch = Watch(port)
+        try:
+            version = watch.ping()
+            if command == "ping":
+                print("protocol version %d, %d bytes per request" % (version, watch.max_data))
+            elif command == "ls":
+                for name, size in watch.list_files():
+                    print("%8d  %s" % (size, name))
+            elif command == "get":
+                start = time.monotonic()
+                data = watch.get(args[0])
+                with open(args[1] if len(args) > 1 else os.path.basename(args[0]), "wb") as f:
+                    f.write(data)
+                print("received %d bytes in %.1f s" % (len(data), time.monotonic() - start))
+            elif command == "put":
+                start = time.monotonic()
+                with open(args[0], "rb") as f:
+                    data = f.read()
+                watch.put(args[1] if len(args) > 1 else os.path.basename(args[0]), data)
+                print("sent %d bytes in %.1f s" % (len(data), time.monotonic() - start))
+            elif command == "rm":
+                watch.call(FILE_REMOVE, args[0].encode())
+            elif command == "kv":
+                key = args[0].encode()
+                if len(args) > 1:
+                    watch.call(KV_SET, bytes([len(key)]) + key + args[1].encode())
+                else:
+                    print(watch.call(KV_GET, key))
+            elif command == "settings":
+                if args:
+                    watch.call(SETTINGS_SET, struct.pack("<I", int(args[0], 16)))
+                else:
+                    print("%08x" % struct.unpack("<I", watch.call(SETTINGS_GET))[0])
+            elif command == "rtc":
+                if args and args[0] == "sync":
+                    print("set; the watch is %+.1f ms off" % (rtc_sync(watch) * 1000))
+                elif args and args[0] == "measure":
+                    rtc_measure(watch, float(args[1]) if len(args) > 1 else 5)
+                else:
+                    print(unpack_date_time(struct.unpack("<I", watch.call(RTC_GET))[0]))
+            elif command == "faces":
+                if args:
+                    watch.call(FACES_SET, bytes(int(a) for a in args if a != "reset"))
+                data = watch.call(FACES_GET)
+                print("%d faces; order: %s" % (data[0], " ".join(str(i) for i in data[1:])))
+            elif command == "stats":
+                if args and args[0] == "reset":
+                    watch.call(STATS_RESET)
+                    return
+                records = []
+                overflows = None
+                while True:
+                    data = watch.call(STATS_GET, bytes([len(records)]))
+                    overflows = struct.unpack("<I", data[:4])[0]
+                    if len(data) == 4:
+                        break
+                    records += struct.iter_unpack("<5I", data[4:])
+                print("event queue overflows: %d" % overflows)
+                print("face       loops      active  background  led ticks  buzzer ticks")
+                for index, record in enumerate(records):
+                    print("%4d %10d %11d %11d %10d %13d" % ((index,) + record))
+            elif command == "update":
+                start = time.monotonic()
+                with open(args[0], "rb") as f:
+                    delta = f.read()
+                update(watch, delta)
+                print("sent %d bytes in %.1f s; the watch is restarting" % (len(delta), time.monotonic() - start))
+            else:
+                sys.exit("sensorwatch_rpc: unknown command %s" % command)
+        except WatchError as e:
+            sys.exit("sensorwatch_rpc: watch reported %s" % e)
+
+
+if __name__ == "__main__":
+    main()
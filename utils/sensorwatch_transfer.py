@@ -0,0 +1,126 @@
+#!/usr/bin/env python3
+# Copies files to and from a Sensor Watch over its USB serial shell, using the shell's get and put commands. Files
+# travel as lines of base64 with a CRC-32 over the whole file, so a copy either arrives intact or fails loudly. accel
+# saves a session of the accelerometer log, or with "all" the whole log, using the shell's accel command, which sends
+# the pages raw with the same CRC; motion_express_utilities/motion_decode.py reads what it saves.
+#
+# usage: sensorwatch_transfer.py PORT get WATCH_PATH [LOCAL_PATH]
+#        sensorwatch_transfer.py PORT put LOCAL_PATH [WATCH_PATH]
+#        sensorwatch_transfer.py PORT accel {SESSION,all} [LOCAL_PATH]
+#
+# Requires pyserial (pip install pyserial). PORT is something like /dev/ttyACM0 or /dev/cu.usbmodem1101.
+
+import base64
+import binascii
+import os
+import sys
+import time
+
+import serial
+
+CHUNK_SIZE = 48  # must match TRANSFER_CHUNK_SIZE in movement/shell_cmd_list.c
+TIMEOUT = 5
+
+
+def read_line(port):
+    line = port.readline()
+    if not line:
+        sys.exit("sensorwatch_transfer: timed out waiting for the watch")
+    return line.decode("ascii", errors="replace").strip()
+
+
+def is_reply(line, keyword):
+    # base64 never contains a space, so a data line can't be mistaken for a reply with arguments.
+    return line == keyword or line.startswith(keyword + " ")
+
+
+def wait_for(port, keywords):
+    """Skips the prompt and command echo until a reply starting with one of keywords, or an ERROR."""
+    while True:
+        line = read_line(port)
+        if is_reply(line, "ERROR"):
+            sys.exit("sensorwatch_transfer: watch reported %s" % line)
+        for keyword in keywords:
+            if is_reply(line, keyword):
+                return line
+
+
+def send_command(port, command):
+    port.reset_input_buffer()
+    port.write((command + "\n").encode("ascii"))
+
+
+def get(port, watch_path, local_path):
+    send_command(port, "get %s" % watch_path)
+    size = int(wait_for(port, ["BEGIN"]).split()[1])
+    data = bytearray()
+    while True:
+        line = read_line(port)
+        if is_reply(line, "END"):
+            expected_crc = int(line.split()[1], 16)
+            break
+        if is_reply(line, "ERROR"):
+            sys.exit("sensorwatch_transfer: watch reported %s" % line)
+        data += base64.b64decode(line)
+    if len(data) != size:
+        sys.exit("sensorwatch_transfer: expected %d bytes, received %d" % (size, len(data)))
+    if binascii.crc32(data) != expected_crc:
+        sys.exit("sensorwatch_transfer: CRC mismatch; the file was corrupted in transit")
+    with open(local_path, "wb") as f:
+        f.write(data)
+    return len(data)
+
+
+def accel(port, session, local_path):
+    send_command(port, "accel %s" % session)
+    size = int(wait_for(port, ["BEGIN"]).split()[1])
+    data = port.read(size)
+    if len(data) != size:
+        sys.exit("sensorwatch_transfer: expected %d bytes, received %d" % (size, len(data)))
+    line = wait_for(port, ["END"])
+    if binascii.crc32(data) != int(line.split()[1], 16):
+        sys.exit("sensorwatch_transfer: CRC mismatch; the log was corrupted in transit")
+    with open(local_path, "wb") as f:
+        f.write(data)
+    return len(data)
+
+
+def put(port, local_path, watch_path):
+    with open(local_path, "rb") as f:
+        data = f.read()
+    send_command(port, "put %s %d %08x" % (watch_path, len(data), binascii.crc32(data)))
+    if not data:
+        wait_for(port, ["DONE"])
+        return 0
+    wait_for(port, ["READY"])
+    for offset in range(0, len(data), CHUNK_SIZE):
+        port.write(base64.b64encode(data[offset:offset + CHUNK_SIZE]) + b"\n")
+        wait_for(port, ["OK", "DONE"])
+    return len(data)
+
+
+def main():
+    if len(sys.argv) < 4 or sys.argv[2] not in ("get", "put", "accel"):
+        sys.exit("usage: %s PORT get WATCH_PATH [LOCAL_PATH]\n       %s PORT put LOCAL_PATH [WATCH_PATH]\n"
+                 "       %s PORT accel {SESSION,all} [LOCAL_PATH]" % (sys.argv[0], sys.argv[0], sys.argv[0]))
+    source = sys.argv[3]
+    if sys.argv[2] == "accel":
+        default = "ACCEL.BIN" if source == "all" else "session%s.bin" % source
+    else:
+        default = os.path.basename(source)
+    destination = sys.argv[4] if len(sys.argv) > 4 else default
+
+    with serial.Serial(sys.argv[1], timeout=TIMEOUT) as port:
+        start = time.monotonic()
+        if sys.argv[2] == "get":
+            length = get(port, source, destination)
+        elif sys.argv[2] == "accel":
+            length = accel(port, source, destination)
+        else:
+            length = put(port, source, destination)
+        elapsed = time.monotonic() - start
+    print("%s %d bytes in %.1f s" % ("sent" if sys.argv[2] == "put" else "received", length, elapsed))
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,118 @@
+#!/usr/bin/env python3
+# Runs one headless simulator script (see watch-library/simulator/headless/headless_main.c) against several builds of
+# Movement at once, and prints what each one printed side by side, command by command. A line that differs from the
+# first build's is marked with a *, so one run shows how a whole set of face configurations behaves.
+#
+# usage: sim_matrix.py [-t "YYYY-MM-DD HH:MM:SS"] [-w] [--color GREEN] [--no-build] SCRIPT CONFIG [CONFIG...]
+#
+# Each CONFIG is one of the alternate firmwares in movement/alt_fw, as make's FIRMWARE takes it (STANDARD, BACKER,
+# FOCUS...), or the path to a header laid out like movement_config.h. Either can be given a name to print it as, like
+# hikers=configs/hikers.h. Every build gets its own directory under movement/make/build-matrix, so later runs only
+# rebuild what changed. Each build is its own process: the watch library keeps the watch in globals, so two sets of
+# faces can't share one.
+
+import argparse
+import os
+import subprocess
+import sys
+import time
+from concurrent.futures import ThreadPoolExecutor
+
+MAKE_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "movement", "make")
+BUILD_ROOT = "build-matrix"
+
+
+class Build:
+    def __init__(self, spec):
+        name, _, config = spec.rpartition("=")
+        self.config = config
+        self.is_header = config.endswith(".h")
+        if self.is_header:
+            self.config = os.path.abspath(config)
+        self.name = name or (os.path.splitext(os.path.basename(config))[0] if self.is_header else config)
+        self.build_dir = os.path.join(BUILD_ROOT, self.name)
+        self.binary = os.path.join(MAKE_DIR, self.build_dir, "watch")
+        self.sections = []
+        self.seconds = 0
+
+    def make(self, color):
+        command = ["make", "-C", MAKE_DIR, "-j%d" % (os.cpu_count() or 1), "HEADLESS=1", "COLOR=" + color,
+                   "BUILD=./" + self.build_dir]
+        command.append(("MOVEMENT_CONFIG=" if self.is_header else "FIRMWARE=") + self.config)
+        result = subprocess.run(command, stdout=subprocess.DEVNULL, stderr=subprocess.PIPE, text=True)
+        if result.returncode != 0:
+            sys.exit("sim_matrix: building %s failed:\n%s" % (self.name, result.stderr))
+
+    def run(self, script, options):
+        start = time.monotonic()
+        result = subprocess.run([self.binary, "-e"] + options + [script], stdout=subprocess.PIPE,
+                                stderr=subprocess.PIPE, text=True)
+        self.seconds = time.monotonic() - start
+        if result.returncode != 0:
+            sys.exit("sim_matrix: %s stopped with an error:\n%s" % (self.name, result.stderr))
+        self.sections = split_sections(result.stdout)
+
+
+def split_sections(output):
+    """Splits a run's output into (command, lines) pairs, one for each command the simulator echoed. Whatever the watch
+    printed before the first command goes with a command of None."""
+    sections = [(None, [])]
+    for line in output.splitlines():
+        if line.startswith("> "):
+            sections.append((line[2:], []))
+        else:
+            sections[-1][1].append(line)
+    return sections
+
+
+def print_matrix(builds):
+    width = max(len(build.name) for build in builds)
+    reference = builds[0]
+    differing = 0
+    for index, (command, _) in enumerate(reference.sections):
+        outputs = [build.sections[index][1] for build in builds]
+        if not any(outputs):
+            continue
+        print("> " + (command or "(start)"))
+        same = all(output == outputs[0] for output in outputs)
+        if not same:
+            differing += 1
+        for build, output in zip(builds, outputs):
+            for number, line in enumerate(output):
+                mark = " " if number < len(outputs[0]) and line == outputs[0][number] else "*"
+                print("%s %-*s  %s" % (mark, width, build.name, line))
+        print()
+    return differing
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Run one simulator script against several Movement builds.")
+    parser.add_argument("-t", metavar="TIME", help="start the clock at this local time (YYYY-MM-DD HH:MM:SS)")
+    parser.add_argument("-w", action="store_true", help="have flash writes and erases take as long as on the watch")
+    parser.add_argument("--color", default="GREEN", help="the board's LED color, as make's COLOR takes it")
+    parser.add_argument("--no-build", action="store_true", help="run what was built last time")
+    parser.add_argument("script")
+    parser.add_argument("configs", metavar="CONFIG", nargs="+")
+    args = parser.parse_args()
+
+    builds = [Build(spec) for spec in args.configs]
+    if len(set(build.name for build in builds)) != len(builds):
+        sys.exit("sim_matrix: two builds have the same name; name them with NAME=CONFIG")
+    options = (["-t", args.t] if args.t else []) + (["-w"] if args.w else [])
+
+    # each build already keeps every core busy, so they take turns; the runs can all go at once.
+    if not args.no_build:
+        for build in builds:
+            build.make(args.color)
+    with ThreadPoolExecutor() as pool:
+        list(pool.map(lambda build: build.run(args.script, options), builds))
+
+    differing = print_matrix(builds)
+    for build in builds:
+        print("%s: %.2f s" % (build.name, build.seconds))
+    print("%d command%s printed something different from %s" % (differing, "" if differing == 1 else "s",
+                                                              builds[0].name))
+
+
+if __name__ == "__main__":
+    main()
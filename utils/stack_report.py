@@ -0,0 +1,175 @@
+#!/usr/bin/env python3
+# Reports how deep each watch face can take the stack, from the call graph the compiler writes for a build made with
+# STACK_USAGE=1 (make stack-report does both). For each function GCC writes the size of its frame and the functions
+# it calls into a .ci file next to its object; this walks that graph from each face's functions and from Movement's
+# main loop and interrupt handlers, and adds up the deepest path from each.
+#
+# usage: stack_report.py [--stack-size BYTES] [--paths] BUILD_DIRECTORY
+#
+# Faces are called from Movement through function pointers, which the compiler can't follow, so a face's worst case
+# is Movement's depth where it calls through a pointer, plus the face's own deepest path, plus the deepest interrupt
+# handler, which can fire at any point. That's a little pessimistic, and it's what the stack has to hold. A function
+# the build has no frame size for, like one from the C library, counts as nothing and the path through it gets a
+# "+": the real figure is higher. A path that calls back into itself gets a "~": recursion's depth depends on the
+# data, and only one round of it is counted. --paths prints the deepest chain of calls under each line.
+
+import argparse
+import os
+import re
+import sys
+
+NODE = re.compile(r'^node: \{ title: "([^"]+)" label: "([^"]*)"')
+EDGE = re.compile(r'^edge: \{ sourcename: "([^"]+)" targetname: "([^"]+)"')
+FRAME = re.compile(r"(\d+) bytes \(")
+INDIRECT = "__indirect_call"
+DEFAULT_STACK_SIZE = 0x2000
+
+
+def is_face(name):
+    return name.endswith("_face") or "_face_" in name
+
+
+class CallGraph:
+    """Every function in the build: its frame, where it's defined and what it calls."""
+
+    def __init__(self, directory):
+        self.frames = {}
+        self.files = {}
+        self.calls = {}
+        for name in sorted(os.listdir(directory)):
+            if name.endswith(".ci"):
+                self.read(os.path.join(directory, name))
+        self.depths = {}
+
+    def read(self, path):
+        with open(path) as graph:
+            for line in graph:
+                match = NODE.match(line)
+                if match:
+                    title, label = match.groups()
+                    fields = label.split("\\n")
+                    frame = FRAME.match(fields[2]) if len(fields) > 2 else None
+                    # a function only declared in this file is listed too, without a frame; its definition has one.
+                    if frame:
+                        self.frames[title] = int(frame.group(1))
+                        self.files[title] = fields[1].split(":")[0]
+                    continue
+                match = EDGE.match(line)
+                if match:
+                    self.calls.setdefault(match.group(1), []).append(match.group(2))
+
+    def depth(self, function, stack=()):
+        """Returns (bytes, whether a frame was missing, whether it recursed, the deepest path) for function's deepest
+        call chain, not counting anything called through a pointer."""
+        if function in self.depths:
+            return self.depths[function]
+        if function in stack:
+            return 0, False, True, []
+        if function not in self.frames:
+            return 0, True, False, [function]
+        deepest, unknown, recursive, path = 0, False, False, []
+        for callee in self.calls.get(function, []):
+            if callee == INDIRECT:
+                continue
+            bytes_, callee_unknown, callee_recursive, callee_path = self.depth(callee, stack + (function,))
+            unknown = unknown or callee_unknown
+            recursive = recursive or callee_recursive
+            if bytes_ > deepest or not path:
+                deepest, path = bytes_, callee_path
+        result = (self.frames[function] + deepest, unknown, recursive, [function] + path)
+        # a result reached through a cycle was cut short by where the walk came in, so it isn't kept.
+        if not recursive:
+            self.depths[function] = result
+        return result
+
+    def indirect_depth(self, function, stack=()):
+        """Returns the deepest the stack is, frame and all, where a call chain from function calls through a pointer,
+        and that chain; or None if none does."""
+        if function in stack or function not in self.frames:
+            return None
+        best = None
+        for callee in self.calls.get(function, []):
+            if callee == INDIRECT:
+                found = (0, [])
+            else:
+                found = self.indirect_depth(callee, stack + (function,))
+            if found and (best is None or found[0] > best[0]):
+                best = found
+        if best is None:
+            return None
+        return self.frames[function] + best[0], [function] + best[1]
+
+
+def display_name(function):
+    # a static function's title has its file in front of it.
+    return function.split(":")[-1]
+
+
+def flags(unknown, recursive):
+    return ("+" if unknown else "") + ("~" if recursive else "")
+
+
+def print_path(path):
+    print("%10s %s" % ("", " > ".join(display_name(function) for function in path)))
+
+
+def main():
+    parser = argparse.ArgumentParser(description="How deep each face takes the stack, from a STACK_USAGE=1 build.")
+    parser.add_argument("build", help="the build directory, with the .ci files the compiler wrote")
+    parser.add_argument("--stack-size", type=int, default=DEFAULT_STACK_SIZE,
+                        help="the stack the linker script sets aside (default %d)" % DEFAULT_STACK_SIZE)
+    parser.add_argument("--paths", action="store_true", help="show the deepest chain of calls for each line")
+    args = parser.parse_args()
+
+    graph = CallGraph(args.build)
+    if not graph.frames:
+        sys.exit("%s has no .ci files in it; was it built with STACK_USAGE=1?" % args.build)
+
+    handlers = [function for function in graph.frames if function.endswith("_Handler") and graph.calls.get(function)]
+    handler = max(handlers, key=lambda function: graph.depth(function)[0], default=None)
+    handler_bytes, handler_unknown, handler_recursive, handler_path = graph.depth(handler) if handler else (0, 0, 0, [])
+    movement = graph.indirect_depth("main") if "main" in graph.frames else None
+    movement_bytes, movement_path = movement if movement else (0, [])
+    main_bytes, main_unknown, main_recursive, main_path = graph.depth("main") if "main" in graph.frames else (0, 0, 0, [])
+
+    print("%8s  %s" % ("bytes", "Movement"))
+    print("%8d%-2s main loop, on its own" % (main_bytes, flags(main_unknown, main_recursive)))
+    if args.paths:
+        print_path(main_path)
+    print("%8d  main loop, where it calls a face" % movement_bytes)
+    if args.paths:
+        print_path(movement_path)
+    if handler:
+        print("%8d%-2s deepest interrupt, %s" % (handler_bytes, flags(handler_unknown, handler_recursive), handler))
+        if args.paths:
+            print_path(handler_path)
+
+    faces = {}
+    for function, path in graph.files.items():
+        face = os.path.splitext(os.path.basename(path))[0]
+        # a face's entry points are the functions it lets Movement call; its static helpers are reached from them.
+        if is_face(face) and ":" not in function:
+            faces.setdefault(face, []).append(function)
+
+    rows = []
+    for face, functions in faces.items():
+        deepest = max((graph.depth(function) for function in functions), key=lambda result: result[0])
+        worst = movement_bytes + deepest[0] + handler_bytes
+        rows.append((worst, face, deepest))
+
+    print()
+    print("%8s %8s  %s" % ("face", "worst", "face (worst is with Movement and an interrupt)"))
+    for worst, face, (bytes_, unknown, recursive, path) in sorted(rows, reverse=True):
+        over = "  over the stack" if worst > args.stack_size else ""
+        print("%8d %8d%-2s %s%s" % (bytes_, worst, flags(unknown, recursive), face, over))
+        if args.paths:
+            print_path(path)
+
+    if rows:
+        worst = max(rows)[0]
+        print()
+        print("deepest: %d of %d bytes of stack, %d to spare" % (worst, args.stack_size, args.stack_size - worst))
+
+
+if __name__ == "__main__":
+    main()
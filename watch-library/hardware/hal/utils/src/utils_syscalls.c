@@ -42,9 +42,7 @@ extern "C" {
 
 #undef errno
 extern int errno;
-extern int _end;
 
-extern caddr_t _sbrk(int incr);
 extern int     link(char *old, char *_new);
 extern int     _close(int file);
 extern int     _fstat(int file, struct stat *st);
@@ -54,24 +52,6 @@ extern void    _exit(int status);
 extern void    _kill(int pid, int sig);
 extern int     _getpid(void);
 
-/**
- * \brief Replacement of C library of _sbrk
- */
-extern caddr_t _sbrk(int incr)
-{
-	static unsigned char *heap = NULL;
-	unsigned char *       prev_heap;
-
-	if (heap == NULL) {
-		heap = (unsigned char *)&_end;
-	}
-	prev_heap = heap;
-
-	heap += incr;
-
-	return (caddr_t)prev_heap;
-}
-
 /**
  * \brief Replacement of C library of link
  */
@@ -41,8 +41,6 @@ extern struct adc_sync_descriptor ADC_0;
 
 extern struct i2c_m_sync_desc I2C_0;
 
-extern struct usart_sync_descriptor USART_0;
-
 extern struct spi_m_sync_descriptor SPI_0;
 
 extern struct slcd_sync_descriptor SEGMENT_LCD_0;
@@ -36,15 +36,18 @@
 int main(void) {
     // ASF code. Initialize the MCU with configuration options from Atmel Studio.
     init_mcu();
+    // time the rest of the boot, for the shell's boot command.
+    _watch_boot_clock_start();
 
     // check if we are plugged into USB power.
     watch_enable_digital_input(VBUS_DET);
     watch_enable_pull_down(VBUS_DET);
     if (watch_get_pin_level(VBUS_DET)) {
-        // if so, enable USB functionality.
+        // if so, enable USB functionality, and keep an eye on the pin to know when we're unplugged.
         _watch_enable_usb();
+    } else {
+        watch_disable_digital_input(VBUS_DET);
     }
-    watch_disable_digital_input(VBUS_DET);
 
     // initialize the delay driver before any user code is called.
     delay_driver_init();
@@ -65,6 +68,7 @@ int main(void) {
 
     // Watch library code. Set initial parameters for the device and enable the RTC.
     _watch_init();
+    watch_power_trace_init();
 
     // if date/time register is 0 (power on reset state), default year to 2023.
     watch_date_time date_time = watch_rtc_get_date_time();
@@ -79,10 +83,25 @@ int main(void) {
     while (1) {
         bool usb_enabled = hri_usbdevice_get_CTRLA_ENABLE_bit(USB);
         bool can_sleep = app_loop();
+        // once the cable is gone, so is everything USB needed, and the watch can go back to standby.
+        if (usb_enabled && !watch_get_pin_level(VBUS_DET) && _watch_disable_usb()) {
+            watch_disable_digital_input(VBUS_DET);
+            usb_enabled = false;
+        }
         if (can_sleep && !usb_enabled) {
             app_prepare_for_standby();
+            _watch_update_power_policy(true);
+            watch_power_trace_region_t trace = watch_power_trace_set(WATCH_POWER_TRACE_SLEEP);
             sleep(4);
+            watch_power_trace_set(trace);
+            _watch_update_power_policy(false);
             app_wake_from_standby();
+        } else if (can_sleep) {
+            // USB needs its clocks, so no standby; but with the USB task running off interrupts there's nothing to
+            // spin for, and idle stops the CPU until the next one.
+            watch_power_trace_region_t trace = watch_power_trace_set(WATCH_POWER_TRACE_SLEEP);
+            sleep(2);
+            watch_power_trace_set(trace);
         }
     }
 
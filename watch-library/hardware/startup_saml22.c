@@ -45,6 +45,7 @@ int main(void);
 /** \endcond */
 
 void __libc_init_array(void);
+void _watch_memory_paint_stack(void);
 
 /* Default empty handler */
 void Dummy_Handler(void);
@@ -201,6 +202,9 @@ void Reset_Handler(void)
             *pDest++ = 0;
     }
 
+    /* Fill the free stack, so that watch_get_stack_high_water can see how much of it is ever used */
+    _watch_memory_paint_stack();
+
     /* Set the vector table base address */
     pSrc = (uint32_t *) & _sfixed;
     SCB->VTOR = ((uint32_t) pSrc & SCB_VTOR_TBLOFF_Msk);
@@ -72,7 +72,11 @@
 
 //------------- CLASS -------------//
 #define CFG_TUD_CDC               1
+#ifdef MOVEMENT_USB_MSC
+#define CFG_TUD_MSC               1
+#else
 #define CFG_TUD_MSC               0
+#endif
 #define CFG_TUD_HID               0
 #define CFG_TUD_MIDI              0
 #define CFG_TUD_VENDOR            0
@@ -84,6 +88,9 @@
 // CDC Endpoint transfer buffer size, more is faster
 #define CFG_TUD_CDC_EP_BUFSIZE   (64)
 
+// MSC buffer size: one sector, so that each read callback produces a whole sector of the FAT view.
+#define CFG_TUD_MSC_EP_BUFSIZE   (512)
+
 #ifdef __cplusplus
  }
 #endif
@@ -23,18 +23,15 @@
  */
 
 #include "watch.h"
+#include "hpl_init.h"
+#include <string.h>
 
 // receives interrupts from MCLK, OSC32KCTRL, OSCCTRL, PAC, PM, SUPC and TAL, whatever that is.
 void SYSTEM_Handler(void) {
     if (SUPC->INTFLAG.bit.BOD33DET) {
-        // Our system voltage has dipped below 2.6V!
-        // Set the voltage regulator to work at low system voltage before we hit 2.5 V
-        // This voltage regulator can carry us down to 1.62 volts as the battery drains.
-        SUPC->VREG.bit.LPEFF = 0;
-        // clear the interrupt condition
-        SUPC->INTENCLR.bit.BOD33DET = 1;
-        // and disable the brownout detector (TODO: add a second, "power critical" brownout condition?)
-        SUPC->INTFLAG.reg &= ~SUPC_INTFLAG_BOD33DET;
+        SUPC->INTFLAG.reg = SUPC_INTFLAG_BOD33DET;
+        // the battery has fallen past the level the battery monitor set; it moves on to the next one.
+        _watch_battery_detected();
     }
 }
 
@@ -42,12 +39,200 @@ bool watch_is_buzzer_or_led_enabled(void){
     return hri_mclk_get_APBCMASK_TCC0_bit(MCLK);
 }
 
+uint32_t watch_get_cycle_counter(void) {
+#ifdef MOVEMENT_PROFILER
+    return _watch_profiler_cycle_counter();
+#else
+    // SysTick counts down from its reload value; flip it so that later readings are larger.
+    return ~SysTick->VAL & WATCH_CYCLE_COUNTER_MASK;
+#endif
+}
+
+static bool boot_clock_running;
+// the count's upper bits, carried in by hand each time it's read: the boot clock has no interrupt.
+static uint32_t boot_clock_high;
+
+void _watch_boot_clock_start(void) {
+    // TC3 belongs to the buzzer's sequencer, but nothing plays this early; clock it with the crystal on GCLK3.
+    hri_gclk_write_PCHCTRL_reg(GCLK, TC3_GCLK_ID, GCLK_PCHCTRL_GEN_GCLK3_Val | GCLK_PCHCTRL_CHEN);
+    hri_mclk_set_APBCMASK_TC3_bit(MCLK);
+    hri_tc_write_CTRLA_reg(TC3, TC_CTRLA_SWRST);
+    hri_tc_wait_for_sync(TC3, TC_SYNCBUSY_SWRST);
+    hri_tc_write_CTRLA_reg(TC3, TC_CTRLA_PRESCALER_DIV1 |   // 32768 counts a second
+                                TC_CTRLA_MODE_COUNT16);     // wrapping every 2 seconds
+    boot_clock_high = 0;
+    boot_clock_running = true;
+    hri_tc_set_CTRLA_ENABLE_bit(TC3);
+    hri_tc_wait_for_sync(TC3, TC_SYNCBUSY_ENABLE);
+}
+
+uint32_t watch_get_boot_ticks(void) {
+    if (!boot_clock_running) return 0;
+
+    TC3->COUNT16.CTRLBSET.reg = TC_CTRLBSET_CMD_READSYNC;
+    while (TC3->COUNT16.CTRLBSET.bit.CMD);
+    while (TC3->COUNT16.SYNCBUSY.reg);
+    uint32_t count = TC3->COUNT16.COUNT.reg;
+    // a wrap just after the count was read shows up with a count near the top; that one is carried next time.
+    if (TC3->COUNT16.INTFLAG.bit.OVF && count < 0x8000) {
+        TC3->COUNT16.INTFLAG.reg = TC_INTFLAG_OVF;
+        boot_clock_high += 0x10000;
+    }
+
+    return boot_clock_high | count;
+}
+
+void watch_boot_clock_stop(void) {
+    if (!boot_clock_running) return;
+    boot_clock_running = false;
+
+    hri_tc_clear_CTRLA_ENABLE_bit(TC3);
+    hri_tc_wait_for_sync(TC3, TC_SYNCBUSY_ENABLE);
+    hri_mclk_clear_APBCMASK_TC3_bit(MCLK);
+}
+
+static uint8_t monotonic_users;
+// the count's upper 16 bits, carried in by the overflow interrupt.
+static volatile uint32_t monotonic_high;
+static ext_irq_cb_t monotonic_compare_callback;
+// set when a compare was asked for at a count already passed, and the interrupt was made pending by hand.
+static volatile bool monotonic_compare_due;
+
+void watch_monotonic_start(void) {
+    if (monotonic_users++) return;
+
+    // clock TC2 with the 32.768 kHz crystal on GCLK3, which keeps running in standby.
+    hri_gclk_write_PCHCTRL_reg(GCLK, TC2_GCLK_ID, GCLK_PCHCTRL_GEN_GCLK3_Val | GCLK_PCHCTRL_CHEN);
+    hri_mclk_set_APBCMASK_TC2_bit(MCLK);
+    hri_tc_clear_CTRLA_ENABLE_bit(TC2);
+    hri_tc_wait_for_sync(TC2, TC_SYNCBUSY_ENABLE);
+    hri_tc_write_CTRLA_reg(TC2, TC_CTRLA_SWRST);
+    hri_tc_wait_for_sync(TC2, TC_SYNCBUSY_SWRST);
+    hri_tc_write_CTRLA_reg(TC2, TC_CTRLA_PRESCALER_DIV64 |   // 32768 Hz / 64 = 512 counts a second
+                                TC_CTRLA_MODE_COUNT16 |      // wrapping every 128 seconds
+                                TC_CTRLA_RUNSTDBY);
+    monotonic_high = 0;
+    hri_tc_set_INTEN_OVF_bit(TC2);
+
+    NVIC_ClearPendingIRQ(TC2_IRQn);
+    NVIC_EnableIRQ(TC2_IRQn);
+    hri_tc_set_CTRLA_ENABLE_bit(TC2);
+    hri_tc_wait_for_sync(TC2, TC_SYNCBUSY_ENABLE);
+}
+
+void watch_monotonic_stop(void) {
+    if (monotonic_users == 0 || --monotonic_users) return;
+
+    monotonic_compare_callback = NULL;
+    monotonic_compare_due = false;
+    NVIC_DisableIRQ(TC2_IRQn);
+    NVIC_ClearPendingIRQ(TC2_IRQn);
+    hri_tc_clear_CTRLA_ENABLE_bit(TC2);
+    hri_tc_wait_for_sync(TC2, TC_SYNCBUSY_ENABLE);
+    hri_mclk_clear_APBCMASK_TC2_bit(MCLK);
+}
+
+uint32_t watch_get_monotonic_ticks(void) {
+    if (monotonic_users == 0) return 0;
+
+    // with interrupts off, an overflow that hasn't been carried yet shows up as a pending flag instead.
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    // COUNT can only be read after asking for it to be synchronized.
+    TC2->COUNT16.CTRLBSET.reg = TC_CTRLBSET_CMD_READSYNC;
+    while (TC2->COUNT16.CTRLBSET.bit.CMD);
+    while (TC2->COUNT16.SYNCBUSY.reg);
+    uint32_t count = TC2->COUNT16.COUNT.reg;
+    uint32_t high = monotonic_high;
+    if (TC2->COUNT16.INTFLAG.bit.OVF && count < 0x8000) high += 0x10000;
+    __set_PRIMASK(primask);
+
+    return high | count;
+}
+
+void watch_monotonic_set_compare(uint16_t count, ext_irq_cb_t callback) {
+    if (monotonic_users == 0) return;
+
+    TC2->COUNT16.INTENCLR.reg = TC_INTENCLR_MC0;
+    monotonic_compare_due = false;
+    monotonic_compare_callback = callback;
+    if (callback == NULL) return;
+
+    TC2->COUNT16.CC[0].reg = count;
+    while (TC2->COUNT16.SYNCBUSY.reg);
+    TC2->COUNT16.INTFLAG.reg = TC_INTFLAG_MC0;
+    TC2->COUNT16.INTENSET.reg = TC_INTENSET_MC0;
+    // the match won't come around for another 128 seconds if the count is already past it, so take the interrupt now.
+    if ((uint16_t)(count - watch_get_monotonic_ticks()) > 0x7FFF) {
+        monotonic_compare_due = true;
+        NVIC_SetPendingIRQ(TC2_IRQn);
+    }
+}
+
+void TC2_Handler(void) {
+    uint8_t flags = TC2->COUNT16.INTFLAG.reg;
+    if (flags & TC_INTFLAG_OVF) {
+        TC2->COUNT16.INTFLAG.reg = TC_INTFLAG_OVF;
+        monotonic_high += 0x10000;
+    }
+    if (((flags & TC_INTFLAG_MC0) && TC2->COUNT16.INTENSET.bit.MC0) || monotonic_compare_due) {
+        TC2->COUNT16.INTENCLR.reg = TC_INTENCLR_MC0;
+        TC2->COUNT16.INTFLAG.reg = TC_INTFLAG_MC0;
+        monotonic_compare_due = false;
+        // each request calls back once; the callback may well make another.
+        ext_irq_cb_t callback = monotonic_compare_callback;
+        monotonic_compare_callback = NULL;
+        if (callback != NULL) callback();
+    }
+}
+
 bool watch_is_usb_enabled(void) {
     return USB->DEVICE.CTRLA.bit.ENABLE;
 }
 
+static bool _high_performance;
+
+uint32_t watch_get_cycle_counter_frequency(void) {
+    if (_high_performance) return 16000000;
+    return watch_is_usb_enabled() ? 8000000 : 4000000;
+}
+
+bool watch_set_performance_level(watch_performance_level_t level) {
+    bool high = level == WATCH_PERFORMANCE_HIGH;
+    if (high == _high_performance) return true;
+
+    if (high) {
+        if (watch_is_buzzer_or_led_enabled()) return false;
+        // 16 MHz is out of reach at PL0, so raise the level first.
+        _set_performance_level(2);
+        // at PL2, the flash needs a wait state above 14 MHz. add it before the clock speeds up...
+        hri_nvmctrl_write_CTRLB_RWS_bf(NVMCTRL, 1);
+        hri_oscctrl_write_OSC16MCTRL_FSEL_bf(OSCCTRL, OSCCTRL_OSC16MCTRL_FSEL_16_Val);
+        while (!hri_oscctrl_get_STATUS_OSC16MRDY_bit(OSCCTRL));
+    } else {
+        hri_oscctrl_write_OSC16MCTRL_FSEL_bf(OSCCTRL, watch_is_usb_enabled() ? OSCCTRL_OSC16MCTRL_FSEL_8_Val : OSCCTRL_OSC16MCTRL_FSEL_4_Val);
+        while (!hri_oscctrl_get_STATUS_OSC16MRDY_bit(OSCCTRL));
+        // ...and take it away after it slows down.
+        hri_nvmctrl_write_CTRLB_RWS_bf(NVMCTRL, 0);
+    }
+    _high_performance = high;
+    // with the clock back to normal, the policy can drop back to PL0.
+    watch_update_power_policy();
+
+    return true;
+}
+
 void watch_reset_to_bootloader(void) {
     volatile uint32_t *dbl_tap_ptr = ((volatile uint32_t *)(HSRAM_ADDR + HSRAM_SIZE - 4));
     *dbl_tap_ptr = 0xf01669ef; // from the UF2 bootloaer: uf2.h line 255
     NVIC_SystemReset();
 }
+
+void watch_get_serial_number(uint8_t *serial) {
+    // the four words aren't together; the datasheet's Serial Number section has where each one is.
+    static const uint32_t addresses[4] = { 0x0080A00C, 0x0080A040, 0x0080A044, 0x0080A048 };
+    for (uint8_t i = 0; i < 4; i++) {
+        uint32_t word = *(volatile const uint32_t *)addresses[i];
+        memcpy(serial + i * 4, &word, 4);
+    }
+}
@@ -25,6 +25,26 @@
 #include "watch_adc.h"
 #include "driver_init.h"
 
+#define WATCH_ADC_NO_CHANNEL (0xFF)
+
+// the event channels the analog monitor uses: one from the RTC to the start of each conversion (and the sensor's power
+// coming on), one from the result being ready to the power going off.
+#define WATCH_ADC_MONITOR_START_CHANNEL 0
+#define WATCH_ADC_MONITOR_DONE_CHANNEL 1
+
+// what a PORT event input does to its pin.
+#define WATCH_PORT_EVACT_SET 1
+#define WATCH_PORT_EVACT_CLR 2
+
+static watch_adc_monitor_config_t _monitor;
+static uint8_t _monitor_per_n;
+static volatile bool _monitor_running;
+// set between watch_enable_adc and watch_disable_adc, while the monitor has to wait.
+static bool _adc_in_foreground;
+
+static void _watch_adc_monitor_arm(void);
+static void _watch_adc_monitor_disarm(void);
+
 static void _watch_sync_adc(void) {
     while (ADC->SYNCBUSY.reg);
 }
@@ -41,9 +61,10 @@ static uint16_t _watch_get_analog_value(uint16_t channel) {
     return ADC->RESULT.reg;
 }
 
-void watch_enable_adc(void) {
+// resets the ADC to the settings watch_enable_adc promises, clocked from the given generator, which runs from OSC16M.
+static void _watch_adc_reset(uint32_t generator) {
     MCLK->APBCMASK.reg |= MCLK_APBCMASK_ADC;
-    GCLK->PCHCTRL[ADC_GCLK_ID].reg = GCLK_PCHCTRL_GEN_GCLK0 | GCLK_PCHCTRL_CHEN;
+    GCLK->PCHCTRL[ADC_GCLK_ID].reg = generator | GCLK_PCHCTRL_CHEN;
 
     uint16_t calib_reg = 0;
     calib_reg = ADC_CALIB_BIASREFBUF((*(uint32_t *)ADC_FUSES_BIASREFBUF_ADDR >> ADC_FUSES_BIASREFBUF_Pos)) |
@@ -72,6 +93,13 @@ void watch_enable_adc(void) {
     ADC->CTRLC.bit.RESSEL = ADC_CTRLC_RESSEL_16BIT_Val;
     ADC->AVGCTRL.bit.SAMPLENUM = ADC_AVGCTRL_SAMPLENUM_16_Val;
     ADC->SAMPCTRL.bit.SAMPLEN = 0;
+}
+
+void watch_enable_adc(void) {
+    if (_monitor_running && !_adc_in_foreground) _watch_adc_monitor_disarm();
+    _adc_in_foreground = true;
+
+    _watch_adc_reset(GCLK_PCHCTRL_GEN_GCLK0);
     ADC->INTENSET.reg = ADC_INTENSET_RESRDY;
     ADC->CTRLA.bit.ENABLE = 1;
     _watch_sync_adc();
@@ -102,23 +130,34 @@ void watch_enable_analog_input(const uint8_t pin) {
     }
 }
 
-uint16_t watch_get_analog_pin_level(const uint8_t pin) {
+// the ADC channel for one of the analog pins, or WATCH_ADC_NO_CHANNEL.
+static uint8_t _watch_adc_channel(const uint8_t pin) {
     switch (pin) {
         case A0:
-            return _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_AIN12_Val);
+            return ADC_INPUTCTRL_MUXPOS_AIN12_Val;
         case A1:
-            return _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_AIN9_Val);
+            return ADC_INPUTCTRL_MUXPOS_AIN9_Val;
         case A2:
-            return _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_AIN10_Val);
+            return ADC_INPUTCTRL_MUXPOS_AIN10_Val;
         case A3:
-            return _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_AIN11_Val);
+            return ADC_INPUTCTRL_MUXPOS_AIN11_Val;
         case A4:
-            return _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_AIN8_Val);
+            return ADC_INPUTCTRL_MUXPOS_AIN8_Val;
         default:
-            return 0;
+            return WATCH_ADC_NO_CHANNEL;
     }
 }
 
+uint16_t watch_get_analog_pin_level(const uint8_t pin) {
+    uint8_t channel = _watch_adc_channel(pin);
+    if (channel == WATCH_ADC_NO_CHANNEL) return 0;
+
+    uint16_t value = _watch_get_analog_value(channel);
+    watch_input_trace_adc(pin, value);
+
+    return value;
+}
+
 void watch_set_analog_num_samples(uint16_t samples) {
     // ignore any input that's not a power of 2 (i.e. only one bit set)
     if (__builtin_popcount(samples) != 1) return;
@@ -171,29 +210,197 @@ void watch_set_analog_reference_voltage(watch_adc_reference_voltage reference) {
     _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_SCALEDCOREVCC);
 }
 
+static uint16_t _watch_get_vcc_millivolts(void) {
+    // with INTREF selected, the scaled I/O supply (VCC / 4) reads out against 1.024 V.
+    uint32_t raw_val = _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_SCALEDIOVCC_Val);
+
+    return (uint16_t)((raw_val * 1000) / (1024 * 1 << ADC->AVGCTRL.bit.SAMPLENUM));
+}
+
 uint16_t watch_get_vcc_voltage(void) {
-    // stash the previous reference so we can restore it when we're done.
-    uint8_t oldref = ADC->REFCTRL.bit.REFSEL;
+    uint16_t value;
+    uint8_t pin = WATCH_ADC_VCC;
 
-    // if we weren't already using the internal reference voltage, select it now.
-    if (oldref != ADC_REFERENCE_INTREF) watch_set_analog_reference_voltage(ADC_REFERENCE_INTREF);
+    watch_get_analog_levels(&pin, &value, 1);
 
-    // get the data
-    uint32_t raw_val = _watch_get_analog_value(ADC_INPUTCTRL_MUXPOS_SCALEDIOVCC_Val);
+    return value;
+}
 
-    // restore the old reference, if needed.
-    if (oldref != ADC_REFERENCE_INTREF) watch_set_analog_reference_voltage(oldref);
+void watch_get_analog_levels(const uint8_t *pins, uint16_t *values, uint8_t count) {
+    bool needs_vcc = false;
 
-    return (uint16_t)((raw_val * 1000) / (1024 * 1 << ADC->AVGCTRL.bit.SAMPLENUM));
+    // pins first, against whatever reference the caller selected...
+    for (uint8_t i = 0; i < count; i++) {
+        if (pins[i] == WATCH_ADC_VCC) needs_vcc = true;
+        else values[i] = watch_get_analog_pin_level(pins[i]);
+    }
+    if (!needs_vcc) return;
+
+    // ...then every supply reading, sharing one trip to the internal reference and back. each switch costs a
+    // throwaway conversion, so this is where batching saves the most.
+    uint8_t oldref = ADC->REFCTRL.bit.REFSEL;
+    if (oldref != ADC_REFERENCE_INTREF) watch_set_analog_reference_voltage(ADC_REFERENCE_INTREF);
+    for (uint8_t i = 0; i < count; i++) {
+        if (pins[i] == WATCH_ADC_VCC) {
+            values[i] = _watch_get_vcc_millivolts();
+            _watch_regulator_note_vcc(values[i]);
+            _watch_battery_note_vcc(values[i]);
+            watch_input_trace_adc(WATCH_ADC_VCC, values[i]);
+        }
+    }
+    if (oldref != ADC_REFERENCE_INTREF) watch_set_analog_reference_voltage(oldref);
 }
 
 inline void watch_disable_analog_input(const uint8_t pin) {
     gpio_set_pin_function(pin, GPIO_PIN_FUNCTION_OFF);
 }
 
-inline void watch_disable_adc(void) {
+void watch_disable_adc(void) {
+    // sleep mode calls this whether or not the ADC is on; if it's the monitor's, leave it be.
+    if (_monitor_running && !_adc_in_foreground) return;
+    _adc_in_foreground = false;
+
     ADC->CTRLA.bit.ENABLE = 0;
     _watch_sync_adc();
 
     MCLK->APBCMASK.reg &= ~MCLK_APBCMASK_ADC;
+
+    if (_monitor_running) _watch_adc_monitor_arm();
+}
+
+static void _watch_adc_monitor_arm(void) {
+    // GCLK2 gives the ADC OSC16M in standby. both ask for their clock on demand, so the oscillator only starts up
+    // for the length of a conversion.
+    GCLK->GENCTRL[2].reg = GCLK_GENCTRL_SRC_OSC16M | GCLK_GENCTRL_DIV(1) | GCLK_GENCTRL_RUNSTDBY | GCLK_GENCTRL_GENEN;
+    while (GCLK->SYNCBUSY.bit.GENCTRL2);
+
+    _watch_adc_reset(GCLK_PCHCTRL_GEN_GCLK2);
+    ADC->CTRLA.reg |= ADC_CTRLA_RUNSTDBY | ADC_CTRLA_ONDEMAND;
+    ADC->INPUTCTRL.bit.MUXPOS = _watch_adc_channel(_monitor.pin);
+    ADC->CTRLA.bit.ENABLE = 1;
+    _watch_sync_adc();
+    // throw away one measurement after reference change, so that it can't set off the window.
+    _watch_get_analog_value(_watch_adc_channel(_monitor.pin));
+
+    // WINMODE 4 flags a result outside WINLT..WINUT, limits included.
+    ADC->WINLT.reg = _monitor.low;
+    ADC->WINUT.reg = _monitor.high;
+    ADC->CTRLC.bit.WINMODE = ADC_CTRLC_WINMODE_MODE4_Val;
+    _watch_sync_adc();
+    ADC->INTFLAG.reg = ADC_INTFLAG_WINMON | ADC_INTFLAG_RESRDY;
+    ADC->INTENSET.reg = ADC_INTENSET_WINMON;
+    NVIC_ClearPendingIRQ(ADC_IRQn);
+    NVIC_EnableIRQ(ADC_IRQn);
+
+    // the RTC's periodic event starts each conversion. all of the paths are asynchronous, so none of this needs the
+    // event system's clock, or the CPU's.
+    MCLK->APBCMASK.reg |= MCLK_APBCMASK_EVSYS;
+    EVSYS->CHANNEL[WATCH_ADC_MONITOR_START_CHANNEL].reg = EVSYS_CHANNEL_EVGEN(EVSYS_ID_GEN_RTC_PER_0 + _monitor_per_n) |
+                                                          EVSYS_CHANNEL_PATH_ASYNCHRONOUS;
+    EVSYS->USER[EVSYS_ID_USER_ADC_START].reg = EVSYS_USER_CHANNEL(WATCH_ADC_MONITOR_START_CHANNEL + 1);
+    ADC->EVCTRL.reg = ADC_EVCTRL_STARTEI;
+
+    if (_monitor.power_pin != WATCH_ADC_MONITOR_NO_POWER_PIN) {
+        // the same event powers the sensor, and the result being ready turns it off again. the divider settles in well
+        // under a microsecond, long before the first sample.
+        uint32_t on = _monitor.power_level ? WATCH_PORT_EVACT_SET : WATCH_PORT_EVACT_CLR;
+        uint32_t off = _monitor.power_level ? WATCH_PORT_EVACT_CLR : WATCH_PORT_EVACT_SET;
+        EVSYS->CHANNEL[WATCH_ADC_MONITOR_DONE_CHANNEL].reg = EVSYS_CHANNEL_EVGEN(EVSYS_ID_GEN_ADC_RESRDY) |
+                                                             EVSYS_CHANNEL_PATH_ASYNCHRONOUS;
+        EVSYS->USER[EVSYS_ID_USER_PORT_EV_0].reg = EVSYS_USER_CHANNEL(WATCH_ADC_MONITOR_START_CHANNEL + 1);
+        EVSYS->USER[EVSYS_ID_USER_PORT_EV_1].reg = EVSYS_USER_CHANNEL(WATCH_ADC_MONITOR_DONE_CHANNEL + 1);
+        PORT->Group[GPIO_PORT(_monitor.power_pin)].EVCTRL.reg =
+            PORT_EVCTRL_PID0(GPIO_PIN(_monitor.power_pin)) | PORT_EVCTRL_EVACT0(on) | PORT_EVCTRL_PORTEI0 |
+            PORT_EVCTRL_PID1(GPIO_PIN(_monitor.power_pin)) | PORT_EVCTRL_EVACT1(off) | PORT_EVCTRL_PORTEI1;
+        ADC->EVCTRL.reg |= ADC_EVCTRL_RESRDYEO;
+    }
+}
+
+static void _watch_adc_monitor_disarm(void) {
+    NVIC_DisableIRQ(ADC_IRQn);
+    EVSYS->USER[EVSYS_ID_USER_ADC_START].reg = 0;
+    EVSYS->CHANNEL[WATCH_ADC_MONITOR_START_CHANNEL].reg = 0;
+
+    if (_monitor.power_pin != WATCH_ADC_MONITOR_NO_POWER_PIN) {
+        EVSYS->USER[EVSYS_ID_USER_PORT_EV_0].reg = 0;
+        EVSYS->USER[EVSYS_ID_USER_PORT_EV_1].reg = 0;
+        EVSYS->CHANNEL[WATCH_ADC_MONITOR_DONE_CHANNEL].reg = 0;
+        PORT->Group[GPIO_PORT(_monitor.power_pin)].EVCTRL.reg = 0;
+        // a conversion might have been under way, with the sensor on.
+        gpio_set_pin_level(_monitor.power_pin, !_monitor.power_level);
+    }
+
+    ADC->CTRLA.bit.ENABLE = 0;
+    _watch_sync_adc();
+    ADC->EVCTRL.reg = 0;
+    ADC->INTENCLR.reg = ADC_INTENCLR_WINMON;
+    ADC->INTFLAG.reg = ADC_INTFLAG_WINMON;
+    NVIC_ClearPendingIRQ(ADC_IRQn);
+}
+
+bool watch_adc_monitor_start(const watch_adc_monitor_config_t *config) {
+    if (_watch_adc_channel(config->pin) == WATCH_ADC_NO_CHANNEL) return false;
+    if (__builtin_popcount(config->frequency) != 1 || config->low >= config->high) return false;
+
+    watch_adc_monitor_stop();
+    _monitor = *config;
+    // PER7 is the 1 Hz event, PER0 the 128 Hz one, as for the periodic callbacks.
+    _monitor_per_n = __builtin_clz((config->frequency & 0xFF) << 24);
+
+    if (!(RTC->MODE2.EVCTRL.reg & (RTC_MODE2_EVCTRL_PEREO0 << _monitor_per_n))) {
+        uint32_t evctrl = RTC->MODE2.EVCTRL.reg | (RTC_MODE2_EVCTRL_PEREO0 << _monitor_per_n);
+        // EVCTRL only takes a write with the RTC disabled; the clock holds its time while it is.
+        RTC->MODE2.CTRLA.bit.ENABLE = 0;
+        while (RTC->MODE2.SYNCBUSY.bit.ENABLE);
+        RTC->MODE2.EVCTRL.reg = evctrl;
+        RTC->MODE2.CTRLA.bit.ENABLE = 1;
+        while (RTC->MODE2.SYNCBUSY.bit.ENABLE);
+    }
+    // in standby, the oscillator still only runs when the ADC asks for it.
+    OSCCTRL->OSC16MCTRL.reg |= OSCCTRL_OSC16MCTRL_RUNSTDBY;
+
+    _monitor_running = true;
+    if (!_adc_in_foreground) _watch_adc_monitor_arm();
+
+    return true;
+}
+
+void watch_adc_monitor_stop(void) {
+    if (!_monitor_running) return;
+    _monitor_running = false;
+
+    if (!_adc_in_foreground) {
+        _watch_adc_monitor_disarm();
+        MCLK->APBCMASK.reg &= ~MCLK_APBCMASK_ADC;
+    }
+    GCLK->GENCTRL[2].reg = 0;
+    while (GCLK->SYNCBUSY.bit.GENCTRL2);
+    OSCCTRL->OSC16MCTRL.reg &= ~OSCCTRL_OSC16MCTRL_RUNSTDBY;
+    MCLK->APBCMASK.reg &= ~MCLK_APBCMASK_EVSYS;
+    // the RTC's event output stays on: with nothing listening it costs nothing, and turning it off means stopping the
+    // RTC again.
+}
+
+bool watch_adc_monitor_is_running(void) {
+    return _monitor_running;
+}
+
+uint8_t _watch_adc_monitor_get_pins(uint8_t *pins) {
+    if (!_monitor_running) return 0;
+    pins[0] = _monitor.pin;
+    if (_monitor.power_pin == WATCH_ADC_MONITOR_NO_POWER_PIN) return 1;
+    pins[1] = _monitor.power_pin;
+
+    return 2;
+}
+
+void ADC_Handler(void) {
+    if (!(ADC->INTFLAG.reg & ADC_INTFLAG_WINMON)) return;
+
+    uint16_t value = ADC->RESULT.reg;
+    ADC->INTFLAG.reg = ADC_INTFLAG_WINMON;
+    watch_adc_monitor_cb_t callback = _monitor.callback;
+    // stop first, so that the callback is free to start a new window.
+    watch_adc_monitor_stop();
+    if (callback != NULL) callback(value);
 }
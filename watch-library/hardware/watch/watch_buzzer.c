@@ -28,22 +28,19 @@
 #include "../../../watch-library/hardware/include/component/tc.h"
 #include "../../../watch-library/hardware/hri/hri_tc_l22.h"
 
+#if WATCH_BOARD_HAS_BUZZER
+
 void cb_watch_buzzer_seq(void);
 
-static uint16_t _seq_position;
-static int8_t _tone_ticks, _repeat_counter;
+// TC3 counts at 512 Hz, so a 64 Hz sequencer tick is 8 counts, and its 16-bit count can time 8192 ticks at once.
+#define WATCH_BUZZER_COUNTS_PER_TICK 8
+#define WATCH_BUZZER_MAX_TICKS_PER_PERIOD 8192
+
+static watch_buzzer_player_t _player;
+static uint16_t _ticks_left;
 static bool _callback_running = false;
-static int8_t *_sequence;
 static void (*_cb_finished)(void);
 
-static void _tcc_write_RUNSTDBY(bool value) {
-    // enables or disables RUNSTDBY of the tcc
-    hri_tcc_clear_CTRLA_ENABLE_bit(TCC0);
-    hri_tcc_write_CTRLA_RUNSTDBY_bit(TCC0, value);
-    hri_tcc_set_CTRLA_ENABLE_bit(TCC0);
-    hri_tcc_wait_for_sync(TCC0, TCC_SYNCBUSY_ENABLE);
-}
-
 static inline void _tc3_start() {
     // start the TC3 timer
     hri_tc_set_CTRLA_ENABLE_bit(TC3);
@@ -58,76 +55,81 @@ static inline void _tc3_stop() {
 }
 
 static void _tc3_initialize() {
-    // setup and initialize TC3 for a 64 Hz interrupt
+    // setup TC3 to interrupt when a note is over; the period is set for each note as it starts.
+    watch_boot_clock_stop();
     hri_mclk_set_APBCMASK_TC3_bit(MCLK);
     hri_gclk_write_PCHCTRL_reg(GCLK, TC3_GCLK_ID, GCLK_PCHCTRL_GEN_GCLK3 | GCLK_PCHCTRL_CHEN);
     _tc3_stop();
     hri_tc_write_CTRLA_reg(TC3, TC_CTRLA_SWRST);
     hri_tc_wait_for_sync(TC3, TC_SYNCBUSY_SWRST);
-    hri_tc_write_CTRLA_reg(TC3, TC_CTRLA_PRESCALER_DIV64 |
-                           TC_CTRLA_MODE_COUNT8 | 
+    hri_tc_write_CTRLA_reg(TC3, TC_CTRLA_PRESCALER_DIV64 |   // 32 Khz divided by 64 equals 512 Hz
+                           TC_CTRLA_MODE_COUNT16 |
                            TC_CTRLA_RUNSTDBY);
-    hri_tccount8_write_PER_reg(TC3, 7);   // 32 Khz divided by 64 divided by 8 equals 64 Hz
+    hri_tc_write_WAVE_reg(TC3, TC_WAVE_WAVEGEN_MFRQ);       // count up to CC0, then wrap and interrupt
     hri_tc_set_INTEN_OVF_bit(TC3);
     NVIC_ClearPendingIRQ(TC3_IRQn);
     NVIC_EnableIRQ (TC3_IRQn);
 }
 
-void watch_buzzer_play_sequence(int8_t *note_sequence, void (*callback_on_end)(void)) {
+static void _schedule_ticks(void) {
+    // a note longer than the counter can time takes more than one period; the buzzer just keeps going through them.
+    uint16_t ticks = _ticks_left > WATCH_BUZZER_MAX_TICKS_PER_PERIOD ? WATCH_BUZZER_MAX_TICKS_PER_PERIOD : _ticks_left;
+    _ticks_left -= ticks;
+    // the counter has just wrapped (or hasn't started), so the new top applies to the period that's beginning.
+    hri_tccount16_write_CC_reg(TC3, 0, (uint32_t)ticks * WATCH_BUZZER_COUNTS_PER_TICK - 1);
+}
+
+static bool _start_next_note(void) {
+    watch_buzzer_note_t note = _watch_buzzer_player_next(&_player);
+    if (note.ticks == 0) return false;
+    if (note.period) {
+        watch_set_buzzer_period(note.period);
+        watch_set_buzzer_on();
+    } else watch_set_buzzer_off();
+    _ticks_left = note.ticks;
+    _schedule_ticks();
+    return true;
+}
+
+static void _play(const int8_t *note_sequence, const watch_buzzer_note_t *notes, watch_buzzer_next_notes_t next_notes, void (*callback_on_end)(void)) {
     if (_callback_running) _tc3_stop();
     watch_set_buzzer_off();
-    _sequence = note_sequence;
+    _watch_buzzer_player_start(&_player, note_sequence, notes, next_notes);
     _cb_finished = callback_on_end;
-    _seq_position = 0;
-    _tone_ticks = 0;
-    _repeat_counter = -1;
     // prepare buzzer
     watch_enable_buzzer();
     // setup TC3 timer
     _tc3_initialize();
+    // the first note starts on the first tick, like every note after it.
+    _ticks_left = 1;
+    _schedule_ticks();
     // TCC should run in standby mode
-    _tcc_write_RUNSTDBY(true);
-    // start the timer (for the 64 hz callback)
+    _watch_set_tcc_standby(WATCH_TCC_STANDBY_BUZZER, true);
+    // start the timer (for the end of each note)
     _tc3_start();
 }
 
+void watch_buzzer_play_sequence(int8_t *note_sequence, void (*callback_on_end)(void)) {
+    _play(note_sequence, NULL, NULL, callback_on_end);
+}
+
+void watch_buzzer_play_notes(const watch_buzzer_note_t *notes, void (*callback_on_end)(void)) {
+    _play(NULL, notes, NULL, callback_on_end);
+}
+
+void watch_buzzer_stream_notes(const watch_buzzer_note_t *notes, watch_buzzer_next_notes_t next_notes, void (*callback_on_end)(void)) {
+    _play(NULL, notes, next_notes, callback_on_end);
+}
+
 void cb_watch_buzzer_seq(void) {
-    // callback for reading the note sequence
-    if (_tone_ticks == 0) {
-        if (_sequence[_seq_position] < 0 && _sequence[_seq_position + 1]) {
-            // repeat indicator found
-            if (_repeat_counter == -1) {
-                // first encounter: load repeat counter
-                _repeat_counter = _sequence[_seq_position + 1];
-            } else _repeat_counter--;
-            if (_repeat_counter > 0)
-                // rewind
-                if (_seq_position > _sequence[_seq_position] * -2)
-                    _seq_position += _sequence[_seq_position] * 2;
-                else
-                    _seq_position = 0;
-            else {
-                // continue
-                _seq_position += 2;
-                _repeat_counter = -1;
-            }
-        }
-        if (_sequence[_seq_position] && _sequence[_seq_position + 1]) {
-            // read note
-            BuzzerNote note = _sequence[_seq_position];
-            if (note != BUZZER_NOTE_REST) {
-                watch_set_buzzer_period(NotePeriods[note]);
-                watch_set_buzzer_on();
-            } else watch_set_buzzer_off();
-            // set duration ticks and move to next tone
-            _tone_ticks = _sequence[_seq_position + 1];
-            _seq_position += 2;
-        } else {
-            // end the sequence
-            watch_buzzer_abort_sequence();
-            if (_cb_finished) _cb_finished();
-        }
-    } else _tone_ticks--;
+    // callback for the end of a timer period: the note goes on, the next one starts, or the tune is over.
+    if (_ticks_left) {
+        _schedule_ticks();
+    } else if (!_start_next_note()) {
+        // end the sequence
+        watch_buzzer_abort_sequence();
+        if (_cb_finished) _cb_finished();
+    }
 }
 
 void watch_buzzer_abort_sequence(void) {
@@ -135,13 +137,13 @@ void watch_buzzer_abort_sequence(void) {
     if (_callback_running) _tc3_stop();
     watch_set_buzzer_off();
     // disable standby mode for TCC
-    _tcc_write_RUNSTDBY(false);
+    _watch_set_tcc_standby(WATCH_TCC_STANDBY_BUZZER, false);
 }
 
 void TC3_Handler(void) {
     // interrupt handler vor TC3 (globally!)
     cb_watch_buzzer_seq();
-    TC3->COUNT8.INTFLAG.reg |= TC_INTFLAG_OVF;
+    TC3->COUNT16.INTFLAG.reg |= TC_INTFLAG_OVF;
 }
 
 inline void watch_enable_buzzer(void) {
@@ -179,3 +181,33 @@ void watch_buzzer_play_note(BuzzerNote note, uint16_t duration_ms) {
     delay_ms(duration_ms);
     watch_set_buzzer_off();
 }
+
+#else
+
+// a board without a buzzer plays every tune in silence, and no time at all: the callback comes straight back.
+void watch_enable_buzzer(void) {}
+void watch_set_buzzer_period(uint32_t period) { (void) period; }
+void watch_disable_buzzer(void) {}
+void watch_set_buzzer_on(void) {}
+void watch_set_buzzer_off(void) {}
+void watch_buzzer_play_note(BuzzerNote note, uint16_t duration_ms) { (void) note; delay_ms(duration_ms); }
+
+void watch_buzzer_play_sequence(int8_t *note_sequence, void (*callback_on_end)(void)) {
+    (void) note_sequence;
+    if (callback_on_end) callback_on_end();
+}
+
+void watch_buzzer_play_notes(const watch_buzzer_note_t *notes, void (*callback_on_end)(void)) {
+    (void) notes;
+    if (callback_on_end) callback_on_end();
+}
+
+void watch_buzzer_stream_notes(const watch_buzzer_note_t *notes, watch_buzzer_next_notes_t next_notes, void (*callback_on_end)(void)) {
+    (void) notes;
+    (void) next_notes;
+    if (callback_on_end) callback_on_end();
+}
+
+void watch_buzzer_abort_sequence(void) {}
+
+#endif
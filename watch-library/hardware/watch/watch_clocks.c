@@ -0,0 +1,127 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "watch_clocks.h"
+
+static bool _standby;
+
+void _watch_clocks_set_standby(bool standby) {
+    _standby = standby;
+    // OSC16M has to stop when nothing asks for it; it starts out that way, but whoever changed it won't have known.
+    if (standby && !hri_oscctrl_get_OSC16MCTRL_ONDEMAND_bit(OSCCTRL)) hri_oscctrl_set_OSC16MCTRL_ONDEMAND_bit(OSCCTRL);
+}
+
+watch_clock_profile_t watch_get_clock_profile(void) {
+    if (_standby) return WATCH_CLOCK_PROFILE_STANDBY;
+    if (hri_oscctrl_read_OSC16MCTRL_FSEL_bf(OSCCTRL) == OSCCTRL_OSC16MCTRL_FSEL_16_Val) return WATCH_CLOCK_PROFILE_BURST;
+    if (watch_is_usb_enabled()) return WATCH_CLOCK_PROFILE_USB;
+    return WATCH_CLOCK_PROFILE_INTERACTIVE;
+}
+
+const char *watch_get_clock_profile_name(watch_clock_profile_t profile) {
+    static const char *names[] = {"standby", "interactive", "usb", "burst"};
+    if (profile > WATCH_CLOCK_PROFILE_BURST) return "?";
+    return names[profile];
+}
+
+const char *watch_get_clock_source_name(watch_clock_source_t source) {
+    static const char *names[] = {"xosc", "gclkin", "gclk1", "osculp32k", "xosc32k", "osc16m", "dfll48m", "dpll96m"};
+    if (source > WATCH_CLOCK_SOURCE_DPLL96M) return "?";
+    return names[source];
+}
+
+const char *watch_get_clock_channel_name(uint8_t channel) {
+    // some peripherals share a channel: the SERCOMs' slow clock, TC0 with TC1, and TC2 with TC3.
+    static const char *names[WATCH_CLOCK_NUM_CHANNELS] = {
+        [OSCCTRL_GCLK_ID_DFLL48] = "dfll48m",
+        [OSCCTRL_GCLK_ID_FDPLL] = "fdpll",
+        [OSCCTRL_GCLK_ID_FDPLL32K] = "fdpll32k",
+        [EIC_GCLK_ID] = "eic",
+        [FREQM_GCLK_ID_MSR] = "freqm msr",
+        [FREQM_GCLK_ID_REF] = "freqm ref",
+        [USB_GCLK_ID] = "usb",
+        [EVSYS_GCLK_ID_0] = "evsys0",
+        [EVSYS_GCLK_ID_1] = "evsys1",
+        [EVSYS_GCLK_ID_2] = "evsys2",
+        [EVSYS_GCLK_ID_3] = "evsys3",
+        [EVSYS_GCLK_ID_4] = "evsys4",
+        [EVSYS_GCLK_ID_5] = "evsys5",
+        [EVSYS_GCLK_ID_6] = "evsys6",
+        [EVSYS_GCLK_ID_7] = "evsys7",
+        [SERCOM0_GCLK_ID_SLOW] = "sercom slow",
+        [SERCOM0_GCLK_ID_CORE] = "sercom0",
+        [SERCOM1_GCLK_ID_CORE] = "sercom1",
+        [SERCOM2_GCLK_ID_CORE] = "sercom2",
+        [SERCOM3_GCLK_ID_CORE] = "sercom3",
+        [TCC0_GCLK_ID] = "tcc0",
+        [TC0_GCLK_ID] = "tc0/1",
+        [TC2_GCLK_ID] = "tc2/3",
+        [ADC_GCLK_ID] = "adc",
+        [AC_GCLK_ID] = "ac",
+        [PTC_GCLK_ID] = "ptc",
+        [CCL_GCLK_ID] = "ccl",
+        [NVMCTRL_GCLK_ID] = "nvmctrl",
+    };
+    if (channel >= WATCH_CLOCK_NUM_CHANNELS) return NULL;
+    return names[channel];
+}
+
+static uint32_t _watch_clock_source_frequency(watch_clock_source_t source) {
+    switch (source) {
+        case WATCH_CLOCK_SOURCE_OSCULP32K:
+        case WATCH_CLOCK_SOURCE_XOSC32K:
+            return 32768;
+        case WATCH_CLOCK_SOURCE_OSC16M:
+            return (hri_oscctrl_read_OSC16MCTRL_FSEL_bf(OSCCTRL) + 1) * 4000000;
+        case WATCH_CLOCK_SOURCE_DFLL48M:
+            return 48000000;
+        default:
+            return 0;
+    }
+}
+
+void watch_get_clock_tree(watch_clock_tree_t *tree) {
+    for (uint8_t i = 0; i < WATCH_CLOCK_NUM_GENERATORS; i++) {
+        uint32_t genctrl = GCLK->GENCTRL[i].reg;
+        watch_clock_source_t source = (watch_clock_source_t)((genctrl & GCLK_GENCTRL_SRC_Msk) >> GCLK_GENCTRL_SRC_Pos);
+        uint32_t div = (genctrl & GCLK_GENCTRL_DIV_Msk) >> GCLK_GENCTRL_DIV_Pos;
+        // DIVSEL divides by two to the power of DIV + 1; otherwise it's DIV itself, where 0 means 1 too.
+        if (genctrl & GCLK_GENCTRL_DIVSEL) div = 1UL << (div + 1);
+        else if (div == 0) div = 1;
+        tree->generators[i].enabled = genctrl & GCLK_GENCTRL_GENEN;
+        tree->generators[i].run_in_standby = genctrl & GCLK_GENCTRL_RUNSTDBY;
+        tree->generators[i].source = source;
+        tree->generators[i].frequency = _watch_clock_source_frequency(source) / div;
+    }
+    for (uint8_t i = 0; i < WATCH_CLOCK_NUM_CHANNELS; i++) {
+        uint32_t pchctrl = GCLK->PCHCTRL[i].reg;
+        tree->channels[i] = (pchctrl & GCLK_PCHCTRL_CHEN) ? (pchctrl & GCLK_PCHCTRL_GEN_Msk) >> GCLK_PCHCTRL_GEN_Pos
+                                                          : WATCH_CLOCK_CHANNEL_OFF;
+    }
+    tree->osc16m_mhz = hri_oscctrl_get_OSC16MCTRL_ENABLE_bit(OSCCTRL) ? _watch_clock_source_frequency(WATCH_CLOCK_SOURCE_OSC16M) / 1000000 : 0;
+    tree->osc16m_on_demand = hri_oscctrl_get_OSC16MCTRL_ONDEMAND_bit(OSCCTRL);
+    tree->osc16m_run_in_standby = hri_oscctrl_get_OSC16MCTRL_RUNSTDBY_bit(OSCCTRL);
+    tree->dfll_enabled = hri_oscctrl_get_DFLLCTRL_ENABLE_bit(OSCCTRL);
+    tree->xosc32k_enabled = hri_osc32kctrl_get_XOSC32K_ENABLE_bit(OSC32KCTRL);
+}
@@ -29,7 +29,7 @@
 // this warning only appears when you `make BOARD=OSO-SWAT-A1-02`. it's annoying,
 // but i'd rather have it warn us at build-time than fail silently at run-time.
 // besides, no one but me really has any of these boards anyway.
-#if BTN_ALARM != GPIO(GPIO_PORTA, 2)
+#if !(WATCH_BOARD_EXTWAKE_PINS & WATCH_EXTWAKE_BTN_ALARM)
 #warning This board revision does not support external wake on BTN_ALARM, so watch_register_extwake_callback will not work with it. Use watch_register_interrupt_callback instead.
 #endif
 
@@ -54,15 +54,17 @@ void watch_register_extwake_callback(uint8_t pin, ext_irq_cb_t callback, bool le
             config |= 1 << RTC_TAMPCTRL_IN1ACT_Pos;
             if (level) config |= 1 << RTC_TAMPCTRL_TAMLVL1_Pos;
             break;
+#if WATCH_BOARD_EXTWAKE_PINS & WATCH_EXTWAKE_BTN_ALARM
         case BTN_ALARM:
             gpio_set_pin_pull_mode(pin, GPIO_PULL_DOWN);
             btn_alarm_callback = callback;
-            pinmux = PINMUX_PA02G_RTC_IN2;
-            config &= ~(3 << RTC_TAMPCTRL_IN2ACT_Pos);
-            config &= ~(1 << RTC_TAMPCTRL_TAMLVL2_Pos);
-            config |= 1 << RTC_TAMPCTRL_IN2ACT_Pos;
-            if (level) config |= 1 << RTC_TAMPCTRL_TAMLVL2_Pos;
+            pinmux = WATCH_BTN_ALARM_RTC_PINMUX;
+            config &= ~(3 << (RTC_TAMPCTRL_IN0ACT_Pos + 2 * WATCH_BTN_ALARM_RTC_IN));
+            config &= ~(1 << (RTC_TAMPCTRL_TAMLVL0_Pos + WATCH_BTN_ALARM_RTC_IN));
+            config |= 1 << (RTC_TAMPCTRL_IN0ACT_Pos + 2 * WATCH_BTN_ALARM_RTC_IN);
+            if (level) config |= 1 << (RTC_TAMPCTRL_TAMLVL0_Pos + WATCH_BTN_ALARM_RTC_IN);
             break;
+#endif
         default:
             return;
     }
@@ -95,10 +97,12 @@ void watch_disable_extwake_interrupt(uint8_t pin) {
             a2_callback = NULL;
             config &= ~(3 << RTC_TAMPCTRL_IN1ACT_Pos);
             break;
+#if WATCH_BOARD_EXTWAKE_PINS & WATCH_EXTWAKE_BTN_ALARM
         case BTN_ALARM:
             btn_alarm_callback = NULL;
-            config &= ~(3 << RTC_TAMPCTRL_IN2ACT_Pos);
+            config &= ~(3 << (RTC_TAMPCTRL_IN0ACT_Pos + 2 * WATCH_BTN_ALARM_RTC_IN));
             break;
+#endif
         default:
             return;
     }
@@ -125,34 +129,76 @@ uint32_t watch_get_backup_data(uint8_t reg) {
     return 0;
 }
 
+// set by watch_register_button_wake_callback.
+static bool button_wake_enabled;
+static bool button_wake_filter;
+static ext_irq_cb_t button_wake_callback;
+
+static inline void _watch_keep_pin(uint32_t pins_to_disable[2], uint8_t pin) {
+    pins_to_disable[GPIO_PORT(pin)] &= ~(1ul << GPIO_PIN(pin));
+}
+
 static void _watch_disable_all_pins_except_rtc(void) {
     uint32_t config = RTC->MODE0.TAMPCTRL.reg;
-    uint32_t portb_pins_to_disable = 0xFFFFFFFF;
+    uint32_t pins_to_disable[2] = { 0xFFFFFFFF, 0xFFFFFFFF };
 
-    // if there's an action set on RTC/IN[0], leave PB00 configured
-    if (config & RTC_TAMPCTRL_IN0ACT_Msk) portb_pins_to_disable &= 0xFFFFFFFE;
-    // same with RTC/IN[1] and PB02
-    if (config & RTC_TAMPCTRL_IN1ACT_Msk) portb_pins_to_disable &= 0xFFFFFFFB;
+    // if there's an action set on RTC/IN[n], leave its pin configured
+    if (config & (RTC_TAMPCTRL_IN0ACT_Msk << (2 * WATCH_A4_RTC_IN))) _watch_keep_pin(pins_to_disable, A4);
+    if (config & (RTC_TAMPCTRL_IN0ACT_Msk << (2 * WATCH_A2_RTC_IN))) _watch_keep_pin(pins_to_disable, A2);
+    // always keep the ALARM button configured as-is, and the other two if they're set to wake us.
+    _watch_keep_pin(pins_to_disable, BTN_ALARM);
+    if (button_wake_enabled) {
+        _watch_keep_pin(pins_to_disable, BTN_LIGHT);
+        _watch_keep_pin(pins_to_disable, BTN_MODE);
+    }
+    // the analog monitor's input, and the pin that powers its sensor, work on while we sleep.
+    uint8_t monitor_pins[2];
+    uint8_t monitor_pin_count = _watch_adc_monitor_get_pins(monitor_pins);
+    for (uint8_t i = 0; i < monitor_pin_count; i++) _watch_keep_pin(pins_to_disable, monitor_pins[i]);
+#ifdef MOVEMENT_POWER_TRACE
+    // and the trace pins, so they can say that we're asleep.
+    _watch_keep_pin(pins_to_disable, WATCH_POWER_TRACE_PIN_0);
+    _watch_keep_pin(pins_to_disable, WATCH_POWER_TRACE_PIN_1);
+    _watch_keep_pin(pins_to_disable, WATCH_POWER_TRACE_PIN_2);
+#endif
+
+    gpio_set_port_direction(0, pins_to_disable[0], GPIO_DIRECTION_OFF);
+    gpio_set_port_direction(1, pins_to_disable[1], GPIO_DIRECTION_OFF);
+}
+
+void watch_register_button_wake_callback(ext_irq_cb_t callback, bool filter) {
+    button_wake_callback = callback;
+    button_wake_filter = filter;
+    button_wake_enabled = true;
+}
 
-    // port A: always keep PA02 configured as-is; that's our ALARM button.
-    gpio_set_port_direction(0, 0xFFFFFFFB, GPIO_DIRECTION_OFF);
-    // port B: disable all pins we didn't save above.
-    gpio_set_port_direction(1, portb_pins_to_disable, GPIO_DIRECTION_OFF);
+void watch_disable_button_wake(void) {
+    button_wake_enabled = false;
+}
+
+static void _watch_enable_button_wake(void) {
+    // the EIC runs from the 32.768 kHz clock, which keeps going in standby, so it can watch the buttons for us.
+    const uint8_t buttons[] = { BTN_ALARM, BTN_LIGHT, BTN_MODE };
+    watch_enable_external_interrupts();
+    for(uint8_t i = 0; i < sizeof(buttons); i++) {
+        watch_register_interrupt_callback(buttons[i], button_wake_callback, INTERRUPT_TRIGGER_RISING);
+        watch_set_interrupt_filter(buttons[i], button_wake_filter);
+    }
 }
 
 static void _watch_disable_all_peripherals_except_slcd(void) {
     _watch_disable_tcc();
-    watch_disable_adc();
+    _watch_power_suspend();
     watch_disable_external_interrupts();
-    watch_disable_i2c();
     // TODO: replace this with a proper function when we remove the debug UART
     SERCOM3->USART.CTRLA.reg &= ~SERCOM_USART_CTRLA_ENABLE;
     MCLK->APBCMASK.reg &= ~MCLK_APBCMASK_SERCOM3;
 }
 
-void watch_enter_sleep_mode(void) {
-    // disable all other peripherals
+static void _watch_sleep_until_woken(void) {
+    // disable all other peripherals, bringing back the EIC if the buttons should wake us.
     _watch_disable_all_peripherals_except_slcd();
+    if (button_wake_enabled) _watch_enable_button_wake();
 
     // disable tick interrupt
     watch_rtc_disable_all_periodic_callbacks();
@@ -168,12 +214,24 @@ void watch_enter_sleep_mode(void) {
     // disable all pins
     _watch_disable_all_pins_except_rtc();
 
+    // with nothing left running, the LDO is the better regulator.
+    _watch_update_power_policy(true);
+
     // enter standby (4); we basically hang out here until an interrupt wakes us.
+    watch_power_trace_region_t trace = watch_power_trace_set(WATCH_POWER_TRACE_SLEEP);
     sleep(4);
+    watch_power_trace_set(trace);
 
     // and we awake! re-enable the brownout detector and SysTick interrupt
     SUPC->INTENSET.bit.BOD33DET = 1;
     SysTick->CTRL = SysTick->CTRL | (CONF_SYSTICK_TICKINT << SysTick_CTRL_TICKINT_Pos);
+    // and go back to the buck for the work ahead.
+    _watch_update_power_policy(false);
+}
+
+void watch_enter_sleep_mode(void) {
+    _watch_sleep_until_woken();
+    _watch_power_resume();
 
     // call app_setup so the app can re-enable everything we disabled.
     app_setup();
@@ -182,6 +240,11 @@ void watch_enter_sleep_mode(void) {
     app_wake_from_standby();
 }
 
+void watch_enter_sleep_mode_minimal_resume(void) {
+    // only the RTC and SLCD are running; the app re-enables anything else when it decides to fully wake.
+    _watch_sleep_until_woken();
+}
+
 void watch_enter_deep_sleep_mode(void) {
     // identical to sleep mode except we disable the LCD first.
     slcd_sync_deinit(&SEGMENT_LCD_0);
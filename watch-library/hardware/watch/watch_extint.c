@@ -38,56 +38,80 @@ void watch_disable_external_interrupts(void) {
     hri_mclk_clear_APBAMASK_EIC_bit(MCLK);
 }
 
-void watch_register_interrupt_callback(const uint8_t pin, ext_irq_cb_t callback, watch_interrupt_trigger trigger) {
-    uint8_t config_index;
-    uint8_t sense_pos;
+static bool _watch_eic_config_position(const uint8_t pin, uint8_t *config_index, uint8_t *sense_pos) {
     switch (pin) {
         case A0:
             // for EIC channels 8-15, we need to set the SENSE value in CONFIG[1]
-            config_index = (WATCH_A0_EIC_CHANNEL > 7) ? 1 : 0;
+            *config_index = (WATCH_A0_EIC_CHANNEL > 7) ? 1 : 0;
             // either way the index in CONFIG[n] must be 0-7
-            sense_pos = 4 * (WATCH_A0_EIC_CHANNEL % 8);
-            break;
+            *sense_pos = 4 * (WATCH_A0_EIC_CHANNEL % 8);
+            return true;
         case A1:
-            config_index = (WATCH_A1_EIC_CHANNEL > 7) ? 1 : 0;
-            sense_pos = 4 * (WATCH_A1_EIC_CHANNEL % 8);
-            break;
+            *config_index = (WATCH_A1_EIC_CHANNEL > 7) ? 1 : 0;
+            *sense_pos = 4 * (WATCH_A1_EIC_CHANNEL % 8);
+            return true;
         case A2:
-            config_index = (WATCH_A2_EIC_CHANNEL > 7) ? 1 : 0;
-            sense_pos = 4 * (WATCH_A2_EIC_CHANNEL % 8);
-            break;
+            *config_index = (WATCH_A2_EIC_CHANNEL > 7) ? 1 : 0;
+            *sense_pos = 4 * (WATCH_A2_EIC_CHANNEL % 8);
+            return true;
         case A3:
-            config_index = (WATCH_A3_EIC_CHANNEL > 7) ? 1 : 0;
-            sense_pos = 4 * (WATCH_A3_EIC_CHANNEL % 8);
-            break;
+            *config_index = (WATCH_A3_EIC_CHANNEL > 7) ? 1 : 0;
+            *sense_pos = 4 * (WATCH_A3_EIC_CHANNEL % 8);
+            return true;
         case A4:
-            config_index = (WATCH_A4_EIC_CHANNEL > 7) ? 1 : 0;
-            sense_pos = 4 * (WATCH_A4_EIC_CHANNEL % 8);
-            break;
+            *config_index = (WATCH_A4_EIC_CHANNEL > 7) ? 1 : 0;
+            *sense_pos = 4 * (WATCH_A4_EIC_CHANNEL % 8);
+            return true;
         case BTN_ALARM:
-            config_index = (WATCH_BTN_ALARM_EIC_CHANNEL > 7) ? 1 : 0;
-            sense_pos = 4 * (WATCH_BTN_ALARM_EIC_CHANNEL % 8);
-            break;
+            *config_index = (WATCH_BTN_ALARM_EIC_CHANNEL > 7) ? 1 : 0;
+            *sense_pos = 4 * (WATCH_BTN_ALARM_EIC_CHANNEL % 8);
+            return true;
         case BTN_LIGHT:
-            config_index = (WATCH_BTN_LIGHT_EIC_CHANNEL > 7) ? 1 : 0;
-            sense_pos = 4 * (WATCH_BTN_LIGHT_EIC_CHANNEL % 8);
-            break;
+            *config_index = (WATCH_BTN_LIGHT_EIC_CHANNEL > 7) ? 1 : 0;
+            *sense_pos = 4 * (WATCH_BTN_LIGHT_EIC_CHANNEL % 8);
+            return true;
         case BTN_MODE:
-            config_index = (WATCH_BTN_MODE_EIC_CHANNEL > 7) ? 1 : 0;
-            sense_pos = 4 * (WATCH_BTN_MODE_EIC_CHANNEL % 8);
-            break;
+            *config_index = (WATCH_BTN_MODE_EIC_CHANNEL > 7) ? 1 : 0;
+            *sense_pos = 4 * (WATCH_BTN_MODE_EIC_CHANNEL % 8);
+            return true;
         default:
-            return;
+            return false;
     }
+}
 
-    gpio_set_pin_direction(pin, GPIO_DIRECTION_IN);
-
+static void _watch_eic_disable_for_config(void) {
     // EIC configuration register is enable-protected, so we have to disable it first...
     if (hri_eic_get_CTRLA_reg(EIC, EIC_CTRLA_ENABLE)) {
         hri_eic_clear_CTRLA_ENABLE_bit(EIC);
         // ...and wait for it to synchronize.
         hri_eic_wait_for_sync(EIC, EIC_SYNCBUSY_ENABLE);
     }
+}
+
+#ifdef MOVEMENT_INPUT_TRACE
+// the HAL's callbacks don't say which pin fired, so each button gets a function that records it and passes it on.
+static ext_irq_cb_t _light_callback;
+static ext_irq_cb_t _mode_callback;
+static ext_irq_cb_t _alarm_callback;
+
+static void _watch_extint_trace(uint8_t pin, ext_irq_cb_t callback) {
+    watch_input_trace_button(pin, watch_get_pin_level(pin));
+    if (callback != NULL) callback();
+}
+
+static void _watch_extint_trace_light(void) { _watch_extint_trace(BTN_LIGHT, _light_callback); }
+static void _watch_extint_trace_mode(void) { _watch_extint_trace(BTN_MODE, _mode_callback); }
+static void _watch_extint_trace_alarm(void) { _watch_extint_trace(BTN_ALARM, _alarm_callback); }
+#endif
+
+void watch_register_interrupt_callback(const uint8_t pin, ext_irq_cb_t callback, watch_interrupt_trigger trigger) {
+    uint8_t config_index;
+    uint8_t sense_pos;
+    if (!_watch_eic_config_position(pin, &config_index, &sense_pos)) return;
+
+    gpio_set_pin_direction(pin, GPIO_DIRECTION_IN);
+
+    _watch_eic_disable_for_config();
     // now update the configuration...
     hri_eic_config_reg_t config = EIC->CONFIG[config_index].reg;
     config &= ~(7 << sense_pos);
@@ -99,5 +123,108 @@ void watch_register_interrupt_callback(const uint8_t pin, ext_irq_cb_t callback,
     // ...and re-enable the EIC
     hri_eic_set_CTRLA_ENABLE_bit(EIC);
 
+#ifdef MOVEMENT_INPUT_TRACE
+    if (pin == BTN_LIGHT) {
+        _light_callback = callback;
+        callback = _watch_extint_trace_light;
+    } else if (pin == BTN_MODE) {
+        _mode_callback = callback;
+        callback = _watch_extint_trace_mode;
+    } else if (pin == BTN_ALARM) {
+        _alarm_callback = callback;
+        callback = _watch_extint_trace_alarm;
+    }
+#endif
+
     ext_irq_register(pin, callback);
 }
+
+void watch_set_interrupt_filter(const uint8_t pin, bool enabled) {
+    uint8_t config_index;
+    uint8_t sense_pos;
+    if (!_watch_eic_config_position(pin, &config_index, &sense_pos)) return;
+
+    _watch_eic_disable_for_config();
+    // FILTENn sits just above SENSEn.
+    hri_eic_config_reg_t config = EIC->CONFIG[config_index].reg;
+    if (enabled) config |= 1 << (sense_pos + EIC_CONFIG_FILTEN0_Pos);
+    else config &= ~(1 << (sense_pos + EIC_CONFIG_FILTEN0_Pos));
+    hri_eic_write_CONFIG_reg(EIC, config_index, config);
+    hri_eic_set_CTRLA_ENABLE_bit(EIC);
+}
+
+// the button timer borrows TC0, which is otherwise only used for the USB task.
+static bool button_timer_running;
+static ext_irq_cb_t button_timer_callback;
+
+static void _watch_button_timer_sync(void) {
+    while (TC0->COUNT16.SYNCBUSY.reg);
+}
+
+bool watch_button_timer_start(void) {
+    if (watch_is_usb_enabled()) return false;
+    if (button_timer_running) return true;
+
+    // clock TC0 with the 32.768 kHz crystal on GCLK3, which keeps running in standby.
+    hri_gclk_write_PCHCTRL_reg(GCLK, TC0_GCLK_ID, GCLK_PCHCTRL_GEN_GCLK3_Val | GCLK_PCHCTRL_CHEN);
+    hri_mclk_set_APBCMASK_TC0_bit(MCLK);
+    hri_tc_clear_CTRLA_ENABLE_bit(TC0);
+    hri_tc_wait_for_sync(TC0, TC_SYNCBUSY_ENABLE);
+    hri_tc_write_CTRLA_reg(TC0, TC_CTRLA_SWRST);
+    hri_tc_wait_for_sync(TC0, TC_SYNCBUSY_SWRST);
+    hri_tc_write_CTRLA_reg(TC0, TC_CTRLA_PRESCALER_DIV64 |   // 32768 Hz / 64 = 512 counts a second
+                                TC_CTRLA_MODE_COUNT16 |      // up to 128 seconds
+                                TC_CTRLA_RUNSTDBY);
+    // count up once and stop at the top, so that a button held for minutes can't wrap around and look short.
+    TC0->COUNT16.CTRLBSET.reg = TC_CTRLBSET_ONESHOT;
+    _watch_button_timer_sync();
+
+    NVIC_SetPriority(TC0_IRQn, 0);
+    NVIC_ClearPendingIRQ(TC0_IRQn);
+    NVIC_EnableIRQ(TC0_IRQn);
+    hri_tc_set_CTRLA_ENABLE_bit(TC0);
+    hri_tc_wait_for_sync(TC0, TC_SYNCBUSY_ENABLE);
+    button_timer_running = true;
+
+    return true;
+}
+
+uint16_t watch_button_timer_get_count(void) {
+    if (!button_timer_running) return 0;
+    // COUNT can only be read after asking for it to be synchronized.
+    TC0->COUNT16.CTRLBSET.reg = TC_CTRLBSET_CMD_READSYNC;
+    while (TC0->COUNT16.CTRLBSET.bit.CMD);
+    _watch_button_timer_sync();
+    return TC0->COUNT16.COUNT.reg;
+}
+
+void watch_button_timer_set_compare(uint16_t count, ext_irq_cb_t callback) {
+    if (!button_timer_running) return;
+    button_timer_callback = callback;
+    TC0->COUNT16.CC[0].reg = count;
+    _watch_button_timer_sync();
+    TC0->COUNT16.INTFLAG.reg = TC_INTFLAG_MC0;
+    TC0->COUNT16.INTENSET.reg = TC_INTENSET_MC0;
+    // the count never comes back around to a value it has passed, so take the interrupt now.
+    if (watch_button_timer_get_count() >= count) NVIC_SetPendingIRQ(TC0_IRQn);
+}
+
+void watch_button_timer_stop(void) {
+    if (!button_timer_running) return;
+    NVIC_DisableIRQ(TC0_IRQn);
+    NVIC_ClearPendingIRQ(TC0_IRQn);
+    hri_tc_clear_CTRLA_ENABLE_bit(TC0);
+    hri_tc_wait_for_sync(TC0, TC_SYNCBUSY_ENABLE);
+    hri_mclk_clear_APBCMASK_TC0_bit(MCLK);
+    button_timer_callback = NULL;
+    button_timer_running = false;
+}
+
+void _watch_button_timer_interrupt(void) {
+    TC0->COUNT16.INTENCLR.reg = TC_INTENCLR_MC0;
+    TC0->COUNT16.INTFLAG.reg = TC_INTFLAG_MC0 | TC_INTFLAG_OVF;
+    // each request calls back once; the callback may well make another.
+    ext_irq_cb_t callback = button_timer_callback;
+    button_timer_callback = NULL;
+    if (callback != NULL) callback();
+}
@@ -0,0 +1,127 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "watch_firmware.h"
+
+// the linker script leaves the top 8 kilobytes of the array for EEPROM emulation.
+#define FIRMWARE_END (FLASH_SIZE - 0x2000)
+
+extern uint32_t _sfixed;
+extern uint32_t _etext;
+extern uint32_t _srelocate;
+extern uint32_t _erelocate;
+
+static uint32_t _watch_firmware_get_start(void) {
+    return (uint32_t)&_sfixed;
+}
+
+static uint32_t _watch_firmware_get_size(void) {
+    // the code and constant data, then the initial values of .data and the RAM functions, which follow it in flash.
+    return ((uint32_t)&_etext - _watch_firmware_get_start()) + ((uint32_t)&_erelocate - (uint32_t)&_srelocate);
+}
+
+static bool _watch_firmware_is_free(uint32_t offset, uint32_t size) {
+    uint32_t running = (_watch_firmware_get_size() + NVMCTRL_ROW_SIZE - 1) / NVMCTRL_ROW_SIZE * NVMCTRL_ROW_SIZE;
+    return offset >= running && offset + size <= watch_firmware_get_capacity() && offset + size >= offset;
+}
+
+static void _watch_firmware_command(uint32_t address, uint32_t command) {
+    watch_storage_sync();
+    NVMCTRL->ADDR.reg = address / 2;
+    NVMCTRL->CTRLA.reg = command | NVMCTRL_CTRLA_CMDEX_KEY;
+    watch_storage_sync();
+}
+
+const uint8_t *watch_firmware_get_image(uint32_t *size) {
+    *size = _watch_firmware_get_size();
+    return (const uint8_t *)_watch_firmware_get_start();
+}
+
+uint32_t watch_firmware_get_capacity(void) {
+    return FIRMWARE_END - _watch_firmware_get_start();
+}
+
+bool watch_firmware_erase(uint32_t offset) {
+    if (offset % NVMCTRL_ROW_SIZE || !_watch_firmware_is_free(offset, NVMCTRL_ROW_SIZE)) return false;
+    _watch_firmware_command(_watch_firmware_get_start() + offset, NVMCTRL_CTRLA_CMD_ER);
+    // the NVM cache may still hold what was there.
+    _watch_firmware_command(0, NVMCTRL_CTRLA_CMD_INVALL);
+    return true;
+}
+
+bool watch_firmware_write(uint32_t offset, const uint8_t *buffer, uint32_t size) {
+    if (offset % NVMCTRL_PAGE_SIZE || !_watch_firmware_is_free(offset, size)) return false;
+
+    for (uint32_t page = 0; page < size; page += NVMCTRL_PAGE_SIZE) {
+        uint32_t address = _watch_firmware_get_start() + offset + page;
+        volatile uint16_t *destination = (volatile uint16_t *)address;
+        _watch_firmware_command(0, NVMCTRL_CTRLA_CMD_PBC);
+        // the page buffer only takes 16 or 32 bit writes.
+        for (uint32_t i = 0; i < NVMCTRL_PAGE_SIZE; i += 2) {
+            uint8_t low = page + i < size ? buffer[page + i] : 0xFF;
+            uint8_t high = page + i + 1 < size ? buffer[page + i + 1] : 0xFF;
+            destination[i / 2] = low | (high << 8);
+        }
+        _watch_firmware_command(address, NVMCTRL_CTRLA_CMD_WP);
+    }
+    _watch_firmware_command(0, NVMCTRL_CTRLA_CMD_INVALL);
+
+    return true;
+}
+
+// this overwrites the code it would otherwise run from, so it runs from RAM and calls nothing in flash: no library
+// functions, and nothing that might not be inlined.
+static RAMFUNC __attribute__((noinline, noreturn)) void _watch_firmware_copy(uint32_t start, uint32_t from, uint32_t size) {
+    for (uint32_t offset = 0; offset < size; offset += NVMCTRL_ROW_SIZE) {
+        while (!(NVMCTRL->INTFLAG.reg & NVMCTRL_INTFLAG_READY));
+        NVMCTRL->ADDR.reg = (start + offset) / 2;
+        NVMCTRL->CTRLA.reg = NVMCTRL_CTRLA_CMD_ER | NVMCTRL_CTRLA_CMDEX_KEY;
+        for (uint32_t page = 0; page < NVMCTRL_ROW_SIZE; page += NVMCTRL_PAGE_SIZE) {
+            volatile uint16_t *source = (volatile uint16_t *)(from + offset + page);
+            volatile uint16_t *destination = (volatile uint16_t *)(start + offset + page);
+            while (!(NVMCTRL->INTFLAG.reg & NVMCTRL_INTFLAG_READY));
+            NVMCTRL->CTRLA.reg = NVMCTRL_CTRLA_CMD_PBC | NVMCTRL_CTRLA_CMDEX_KEY;
+            while (!(NVMCTRL->INTFLAG.reg & NVMCTRL_INTFLAG_READY));
+            for (uint32_t i = 0; i < NVMCTRL_PAGE_SIZE / 2; i++) destination[i] = source[i];
+            NVMCTRL->ADDR.reg = (start + offset + page) / 2;
+            NVMCTRL->CTRLA.reg = NVMCTRL_CTRLA_CMD_WP | NVMCTRL_CTRLA_CMDEX_KEY;
+        }
+    }
+    while (!(NVMCTRL->INTFLAG.reg & NVMCTRL_INTFLAG_READY));
+
+    __DSB();
+    SCB->AIRCR = (0x5FA << SCB_AIRCR_VECTKEY_Pos) | SCB_AIRCR_SYSRESETREQ_Msk;
+    __DSB();
+    while (true);
+}
+
+void watch_firmware_install(uint32_t offset, uint32_t size) {
+    if (offset % NVMCTRL_ROW_SIZE || !_watch_firmware_is_free(offset, size)) return;
+
+    watch_storage_sync();
+    __disable_irq();
+    // rows are copied in ascending order, and the new image is above its destination, so even where the two overlap,
+    // each row is copied before it's overwritten. RAM is 512 MB away, out of reach of a direct branch.
+    void (*volatile copy)(uint32_t, uint32_t, uint32_t) = _watch_firmware_copy;
+    copy(_watch_firmware_get_start(), _watch_firmware_get_start() + offset, size);
+}
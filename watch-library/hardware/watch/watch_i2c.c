@@ -26,6 +26,29 @@
 
 struct io_descriptor *I2C_0_io;
 
+// state for the one interrupt-driven transfer that can be in flight. _async_busy is the only field the main loop
+// reads while a transfer is running; the rest belong to SERCOM1_Handler until it clears the flag.
+static volatile bool _async_busy;
+static volatile bool _async_success;
+static uint8_t _async_addr;
+static uint8_t *_async_tx_buf;
+static uint16_t _async_tx_length;
+static uint8_t *_async_rx_buf;
+static uint16_t _async_rx_length;
+static void (*_async_callback)(bool success);
+
+#ifdef MOVEMENT_INPUT_TRACE
+// the register of the last blocking write, which is what a following blocking read is most likely reading.
+static uint8_t _last_reg;
+// the async transfer moves its buffer pointers along as it goes, so keep what the trace needs at the end.
+static uint8_t _trace_reg;
+static uint8_t *_trace_rx_buf;
+static uint16_t _trace_rx_length;
+#endif
+
+// CTRLB.CMD value that issues a stop condition.
+#define WATCH_I2C_CMD_STOP 0x3
+
 void watch_enable_i2c(void) {
     I2C_0_init();
     i2c_m_sync_get_io_descriptor(&I2C_0, &I2C_0_io);
@@ -33,18 +56,29 @@ void watch_enable_i2c(void) {
 }
 
 void watch_disable_i2c(void) {
+    watch_i2c_wait();
+    NVIC_DisableIRQ(SERCOM1_IRQn);
     i2c_m_sync_disable(&I2C_0);
 	hri_mclk_clear_APBCMASK_SERCOM1_bit(MCLK);
 }
 
 void watch_i2c_send(int16_t addr, uint8_t *buf, uint16_t length) {
+    // the blocking driver polls the same flags the interrupt handler consumes, so let any async transfer finish.
+    watch_i2c_wait();
     i2c_m_sync_set_periphaddr(&I2C_0, addr, I2C_M_SEVEN);
     io_write(I2C_0_io, buf, length);
+#ifdef MOVEMENT_INPUT_TRACE
+    if (length) _last_reg = buf[0];
+#endif
 }
 
 void watch_i2c_receive(int16_t addr, uint8_t *buf, uint16_t length) {
+    watch_i2c_wait();
     i2c_m_sync_set_periphaddr(&I2C_0, addr, I2C_M_SEVEN);
     io_read(I2C_0_io, buf, length);
+#ifdef MOVEMENT_INPUT_TRACE
+    watch_input_trace_i2c(addr, _last_reg, buf, length);
+#endif
 }
 
 void watch_i2c_write8(int16_t addr, uint8_t reg, uint8_t data) {
@@ -56,7 +90,8 @@ void watch_i2c_write8(int16_t addr, uint8_t reg, uint8_t data) {
 }
 
 uint8_t watch_i2c_read8(int16_t addr, uint8_t reg) {
-    uint8_t data;
+    // a device that isn't there doesn't answer, and the read leaves this as it was; make that a zero.
+    uint8_t data = 0;
 
     watch_i2c_send(addr, (uint8_t *)&reg, 1);
     watch_i2c_receive(addr, (uint8_t *)&data, 1);
@@ -91,3 +126,111 @@ uint32_t watch_i2c_read32(int16_t addr, uint8_t reg) {
 
     return data;
 }
+
+static void _watch_i2c_send_address(bool read) {
+    hri_sercomi2cm_write_ADDR_ADDR_bf(SERCOM1, (_async_addr << 1) | (read ? 1 : 0));
+}
+
+static void _watch_i2c_finish(bool success) {
+    hri_sercomi2cm_clear_INTEN_reg(SERCOM1, SERCOM_I2CM_INTENSET_MB | SERCOM_I2CM_INTENSET_SB | SERCOM_I2CM_INTENSET_ERROR);
+    _async_success = success;
+    _async_busy = false;
+#ifdef MOVEMENT_INPUT_TRACE
+    if (success && _trace_rx_length) watch_input_trace_i2c(_async_addr, _trace_reg, _trace_rx_buf, _trace_rx_length);
+#endif
+    void (*callback)(bool success) = _async_callback;
+    _async_callback = NULL;
+    if (callback != NULL) callback(success);
+}
+
+bool watch_i2c_transfer_async(int16_t addr, uint8_t *tx_buf, uint16_t tx_length, uint8_t *rx_buf, uint16_t rx_length, void (*callback)(bool success)) {
+    if (_async_busy || (tx_length == 0 && rx_length == 0)) return false;
+
+    _async_addr = addr;
+    _async_tx_buf = tx_buf;
+    _async_tx_length = tx_length;
+    _async_rx_buf = rx_buf;
+    _async_rx_length = rx_length;
+    _async_callback = callback;
+#ifdef MOVEMENT_INPUT_TRACE
+    _trace_reg = tx_length ? tx_buf[0] : _last_reg;
+    _trace_rx_buf = rx_buf;
+    _trace_rx_length = rx_length;
+#endif
+    _async_busy = true;
+
+    // smart mode acknowledges each received byte as soon as DATA is read, so the handler only touches one register
+    // per byte. ACKACT stays clear (ACK) until the last byte.
+    hri_sercomi2cm_clear_CTRLB_ACKACT_bit(SERCOM1);
+    hri_sercomi2cm_set_CTRLB_SMEN_bit(SERCOM1);
+    hri_sercomi2cm_clear_INTFLAG_reg(SERCOM1, SERCOM_I2CM_INTFLAG_MB | SERCOM_I2CM_INTFLAG_SB | SERCOM_I2CM_INTFLAG_ERROR);
+    hri_sercomi2cm_set_INTEN_reg(SERCOM1, SERCOM_I2CM_INTENSET_MB | SERCOM_I2CM_INTENSET_SB | SERCOM_I2CM_INTENSET_ERROR);
+    NVIC_ClearPendingIRQ(SERCOM1_IRQn);
+    NVIC_EnableIRQ(SERCOM1_IRQn);
+
+    _watch_i2c_send_address(tx_length == 0);
+
+    return true;
+}
+
+bool watch_i2c_is_busy(void) {
+    return _async_busy;
+}
+
+bool watch_i2c_wait(void) {
+    while (_async_busy) {
+        // same dance as watch_storage_sync: mask interrupts so the last byte can't complete between the check and the
+        // sleep, and sleep in IDLE so that the SERCOM keeps its clock.
+        __disable_irq();
+        if (_async_busy) sleep(2);
+        __enable_irq();
+    }
+
+    return _async_success;
+}
+
+void SERCOM1_Handler(void) {
+    uint8_t flags = hri_sercomi2cm_read_INTFLAG_reg(SERCOM1);
+    uint16_t status = hri_sercomi2cm_read_STATUS_reg(SERCOM1);
+
+    if (flags & SERCOM_I2CM_INTFLAG_ERROR) {
+        hri_sercomi2cm_clear_INTFLAG_reg(SERCOM1, SERCOM_I2CM_INTFLAG_ERROR | SERCOM_I2CM_INTFLAG_MB | SERCOM_I2CM_INTFLAG_SB);
+        hri_sercomi2cm_set_CTRLB_CMD_bf(SERCOM1, WATCH_I2C_CMD_STOP);
+        _watch_i2c_finish(false);
+        return;
+    }
+
+    if (flags & SERCOM_I2CM_INTFLAG_MB) {
+        // master on bus: the address or a data byte went out, or we lost the bus.
+        if (status & (SERCOM_I2CM_STATUS_ARBLOST | SERCOM_I2CM_STATUS_BUSERR)) {
+            hri_sercomi2cm_clear_INTFLAG_reg(SERCOM1, SERCOM_I2CM_INTFLAG_MB);
+            _watch_i2c_finish(false);
+        } else if (status & SERCOM_I2CM_STATUS_RXNACK) {
+            hri_sercomi2cm_set_CTRLB_CMD_bf(SERCOM1, WATCH_I2C_CMD_STOP);
+            _watch_i2c_finish(false);
+        } else if (_async_tx_length) {
+            // writing DATA clears the flag.
+            _async_tx_length--;
+            hri_sercomi2cm_write_DATA_reg(SERCOM1, *_async_tx_buf++);
+        } else if (_async_rx_length) {
+            // writing ADDR again issues a repeated start, and clears the flag.
+            _watch_i2c_send_address(true);
+        } else {
+            hri_sercomi2cm_set_CTRLB_CMD_bf(SERCOM1, WATCH_I2C_CMD_STOP);
+            _watch_i2c_finish(true);
+        }
+    } else if (flags & SERCOM_I2CM_INTFLAG_SB) {
+        // slave on bus: a byte has arrived. reading DATA clears the flag and, in smart mode, sends the ACK or NACK.
+        _async_rx_length--;
+        if (_async_rx_length == 0) {
+            // NACK the last byte and stop; smart mode is turned off first so the read below doesn't clock out another.
+            hri_sercomi2cm_set_CTRLB_ACKACT_bit(SERCOM1);
+            hri_sercomi2cm_clear_CTRLB_SMEN_bit(SERCOM1);
+            hri_sercomi2cm_set_CTRLB_CMD_bf(SERCOM1, WATCH_I2C_CMD_STOP);
+            *_async_rx_buf++ = hri_sercomi2cm_read_DATA_reg(SERCOM1);
+            _watch_i2c_finish(true);
+        } else {
+            *_async_rx_buf++ = hri_sercomi2cm_read_DATA_reg(SERCOM1);
+        }
+    }
+}
@@ -0,0 +1,227 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "watch_input_trace.h"
+
+#ifdef MOVEMENT_INPUT_TRACE
+
+typedef enum {
+    TRACE_EVENT_START = 0,  // payload: watch_date_time
+    TRACE_EVENT_BUTTON,     // payload: pin, level
+    TRACE_EVENT_I2C,        // payload: addr, reg, length, data
+    TRACE_EVENT_ADC,        // payload: pin, value (little endian)
+} trace_event_type_t;
+
+// every event starts with its type and a 32-bit timestamp in ticks.
+#define TRACE_HEADER_SIZE (5)
+#define TRACE_MAX_EVENT_SIZE (TRACE_HEADER_SIZE + 3 + 255)
+// longest line: timestamp, "i2c", address, register and two hex digits a byte.
+#define TRACE_LINE_SIZE (32 + 255 * 2)
+#define TRACE_PRINT_TIMEOUT_MS (2000)
+
+// the USB task's timer counts 8 MHz / 1024 and overflows every 256 counts. a timestamp is the overflows so far and
+// the count within the current one, so each tick is 128 µs.
+#define TRACE_TICKS_TO_MS(ticks) ((uint32_t)(((uint64_t)(ticks) * 16) / 125))
+
+static volatile uint32_t _overflows;
+static uint32_t _start_ticks;
+static volatile bool _recording;
+
+// a byte queue of whole events. The buttons and async I2C record from interrupts, so it's only touched with them masked.
+static uint8_t _buffer[WATCH_INPUT_TRACE_BUFFER_SIZE];
+static uint16_t _buffer_pos;
+static uint16_t _buffer_len;
+static uint32_t _dropped;
+
+void _watch_input_trace_tick(void) {
+    _overflows++;
+}
+
+// called with interrupts masked, so an overflow the interrupt hasn't counted yet shows up as its pending flag.
+static uint32_t _watch_input_trace_now(void) {
+    TC0->COUNT8.CTRLBSET.reg = TC_CTRLBSET_CMD_READSYNC;
+    while (TC0->COUNT8.CTRLBSET.bit.CMD);
+    while (TC0->COUNT8.SYNCBUSY.reg);
+    uint8_t count = TC0->COUNT8.COUNT.reg;
+    uint32_t overflows = _overflows;
+    if (TC0->COUNT8.INTFLAG.bit.OVF && count < 128) overflows++;
+    return overflows * 256 + count;
+}
+
+static void _watch_input_trace_append(trace_event_type_t type, const uint8_t *payload, uint16_t payload_length, const uint8_t *data, uint16_t data_length) {
+    if (!_recording) return;
+
+    __disable_irq();
+    uint16_t length = TRACE_HEADER_SIZE + payload_length + data_length;
+    if (_buffer_len + length > WATCH_INPUT_TRACE_BUFFER_SIZE) {
+        _dropped++;
+        __enable_irq();
+        return;
+    }
+
+    uint32_t ticks = _watch_input_trace_now() - _start_ticks;
+    uint8_t header[TRACE_HEADER_SIZE] = { type, ticks, ticks >> 8, ticks >> 16, ticks >> 24 };
+    const uint8_t *parts[] = { header, payload, data };
+    const uint16_t lengths[] = { TRACE_HEADER_SIZE, payload_length, data_length };
+    for (uint8_t part = 0; part < 3; part++) {
+        for (uint16_t i = 0; i < lengths[part]; i++) {
+            _buffer[(_buffer_pos + _buffer_len++) % WATCH_INPUT_TRACE_BUFFER_SIZE] = parts[part][i];
+        }
+    }
+    __enable_irq();
+}
+
+void watch_input_trace_start(void) {
+    __disable_irq();
+    _buffer_pos = 0;
+    _buffer_len = 0;
+    _dropped = 0;
+    _start_ticks = _watch_input_trace_now();
+    _recording = true;
+    __enable_irq();
+
+    watch_date_time now = watch_rtc_get_date_time();
+    _watch_input_trace_append(TRACE_EVENT_START, (uint8_t *)&now.reg, sizeof(now.reg), NULL, 0);
+}
+
+void watch_input_trace_stop(void) {
+    _recording = false;
+}
+
+bool watch_input_trace_is_recording(void) {
+    return _recording;
+}
+
+void watch_input_trace_button(uint8_t pin, bool level) {
+    uint8_t payload[] = { pin, level };
+    _watch_input_trace_append(TRACE_EVENT_BUTTON, payload, sizeof(payload), NULL, 0);
+}
+
+void watch_input_trace_i2c(int16_t addr, uint8_t reg, const uint8_t *data, uint16_t length) {
+    if (length > 255) length = 255;
+    uint8_t payload[] = { addr, reg, length };
+    _watch_input_trace_append(TRACE_EVENT_I2C, payload, sizeof(payload), data, length);
+}
+
+void watch_input_trace_adc(uint8_t pin, uint16_t value) {
+    uint8_t payload[] = { pin, value, value >> 8 };
+    _watch_input_trace_append(TRACE_EVENT_ADC, payload, sizeof(payload), NULL, 0);
+}
+
+static const char *_watch_input_trace_pin_name(uint8_t pin) {
+    switch (pin) {
+        case BTN_LIGHT: return "light";
+        case BTN_MODE: return "mode";
+        case BTN_ALARM: return "alarm";
+        case A0: return "a0";
+        case A1: return "a1";
+        case A2: return "a2";
+        case A3: return "a3";
+        case A4: return "a4";
+        case WATCH_ADC_VCC: return "vcc";
+        default: return "?";
+    }
+}
+
+// takes the oldest event off the queue. An event is only ever appended whole, so if there's a header there's the rest.
+static bool _watch_input_trace_pop(uint8_t *event) {
+    __disable_irq();
+    if (_buffer_len == 0) {
+        __enable_irq();
+        return false;
+    }
+    uint16_t length = TRACE_HEADER_SIZE;
+    for (uint16_t i = 0; i < length; i++) {
+        event[i] = _buffer[(_buffer_pos + i) % WATCH_INPUT_TRACE_BUFFER_SIZE];
+        // the I2C event's data length is the last byte of its payload.
+        if (i == TRACE_HEADER_SIZE - 1) {
+            switch (event[0]) {
+                case TRACE_EVENT_START: length += sizeof(uint32_t); break;
+                case TRACE_EVENT_BUTTON: length += 2; break;
+                case TRACE_EVENT_I2C: length += 3; break;
+                case TRACE_EVENT_ADC: length += 3; break;
+            }
+        } else if (event[0] == TRACE_EVENT_I2C && i == TRACE_HEADER_SIZE + 2) {
+            length += event[i];
+        }
+    }
+    _buffer_pos = (_buffer_pos + length) % WATCH_INPUT_TRACE_BUFFER_SIZE;
+    _buffer_len -= length;
+    __enable_irq();
+
+    return true;
+}
+
+static void _watch_input_trace_format(const uint8_t *event, char *line) {
+    uint32_t ms = TRACE_TICKS_TO_MS(event[1] | (event[2] << 8) | (event[3] << 16) | ((uint32_t)event[4] << 24));
+    const uint8_t *payload = event + TRACE_HEADER_SIZE;
+    int pos = sprintf(line, "%lu ", (unsigned long)ms);
+
+    switch (event[0]) {
+        case TRACE_EVENT_START: {
+            watch_date_time date_time;
+            memcpy(&date_time.reg, payload, sizeof(date_time.reg));
+            sprintf(line + pos, "start %04d-%02d-%02d %02d:%02d:%02d", date_time.unit.year + WATCH_RTC_REFERENCE_YEAR,
+                    date_time.unit.month, date_time.unit.day, date_time.unit.hour, date_time.unit.minute, date_time.unit.second);
+            break;
+        }
+        case TRACE_EVENT_BUTTON:
+            sprintf(line + pos, "btn %s %u", _watch_input_trace_pin_name(payload[0]), payload[1]);
+            break;
+        case TRACE_EVENT_I2C:
+            pos += sprintf(line + pos, "i2c %02x %02x ", payload[0], payload[1]);
+            for (uint16_t i = 0; i < payload[2]; i++) pos += sprintf(line + pos, "%02x", payload[3 + i]);
+            break;
+        case TRACE_EVENT_ADC:
+            sprintf(line + pos, "adc %s %u", _watch_input_trace_pin_name(payload[0]), payload[1] | (payload[2] << 8));
+            break;
+    }
+}
+
+void watch_input_trace_print(void) {
+    uint8_t event[TRACE_MAX_EVENT_SIZE];
+    char line[TRACE_LINE_SIZE + 3];
+
+    while (_watch_input_trace_pop(event)) {
+        _watch_input_trace_format(event, line);
+        strcat(line, "\r\n");
+        // there can be more here than the USB serial buffer holds, so go at the pace the host reads.
+        size_t length = strlen(line);
+        for (uint16_t waited = 0; cdc_get_write_buffer_space() < length && waited < TRACE_PRINT_TIMEOUT_MS; waited++) {
+            delay_ms(1);
+        }
+        printf("%s", line);
+    }
+
+    __disable_irq();
+    uint32_t dropped = _dropped;
+    _dropped = 0;
+    __enable_irq();
+    if (dropped) printf("# dropped %lu events\r\n", (unsigned long)dropped);
+}
+
+#endif
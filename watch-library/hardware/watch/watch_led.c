@@ -23,6 +23,33 @@
  */
 
 #include "watch_led.h"
+#include "watch_private_dma.h"
+
+#if WATCH_BOARD_HAS_LED
+
+// TC1 counts at 512 Hz from the crystal, and each overflow moves the pattern's DMAC channels on by one step.
+#define WATCH_LED_PATTERN_COUNTS_PER_SECOND 512
+
+static const uint8_t _pattern_dma_channels[WATCH_BOARD_LED_CHANNELS] = {
+    WATCH_DMA_LED_RED_CHANNEL,
+#if WATCH_BOARD_LED_CHANNELS > 1
+    WATCH_DMA_LED_GREEN_CHANNEL,
+#endif
+};
+static const uint8_t _pattern_tcc_channels[WATCH_BOARD_LED_CHANNELS] = {
+    WATCH_RED_TCC_CHANNEL,
+#if WATCH_BOARD_LED_CHANNELS > 1
+    WATCH_GREEN_TCC_CHANNEL,
+#endif
+};
+// each color's duty cycles, in the TCC's counts, for the DMAC to copy into its CCBUF.
+static uint32_t _pattern_duty[WATCH_BOARD_LED_CHANNELS][WATCH_LED_PATTERN_MAX_STEPS];
+static struct {
+    ext_irq_cb_t callback;
+    // loops still to finish, counting the one the DMAC is on; 0 for a pattern that loops forever.
+    uint8_t loops_left;
+    volatile bool playing;
+} pattern;
 
 void watch_enable_leds(void) {
     if (!hri_tcc_get_CTRLA_reg(TCC0, TCC_CTRLA_ENABLE)) {
@@ -35,10 +62,15 @@ void watch_disable_leds(void) {
 }
 
 void watch_set_led_color(uint8_t red, uint8_t green) {
+    watch_led_stop_pattern();
     if (hri_tcc_get_CTRLA_reg(TCC0, TCC_CTRLA_ENABLE)) {
         uint32_t period = hri_tcc_get_PER_reg(TCC0, TCC_PER_MASK);
         hri_tcc_write_CCBUF_reg(TCC0, WATCH_RED_TCC_CHANNEL, ((period * red * 1000ull) / 255000ull));
+#if WATCH_BOARD_LED_CHANNELS > 1
         hri_tcc_write_CCBUF_reg(TCC0, WATCH_GREEN_TCC_CHANNEL, ((period * green * 1000ull) / 255000ull));
+#endif
+        // keep the PWM going while we sleep, so that any color shows correctly without holding the app awake.
+        _watch_set_tcc_standby(WATCH_TCC_STANDBY_LED, red || green);
     }
 }
 
@@ -57,3 +89,132 @@ void watch_set_led_yellow(void) {
 void watch_set_led_off(void) {
     watch_set_led_color(0, 0);
 }
+
+bool watch_led_play_pattern(const watch_led_step_t *steps, uint8_t num_steps, uint16_t step_ms, uint8_t loops,
+                            ext_irq_cb_t callback) {
+    if (num_steps == 0 || num_steps > WATCH_LED_PATTERN_MAX_STEPS) return false;
+    if (!hri_tcc_get_CTRLA_reg(TCC0, TCC_CTRLA_ENABLE)) return false;
+    watch_led_stop_pattern();
+
+    uint32_t period = hri_tcc_get_PER_reg(TCC0, TCC_PER_MASK);
+    for (uint8_t i = 0; i < num_steps; i++) {
+        _pattern_duty[0][i] = (period * steps[i].red) / 255;
+#if WATCH_BOARD_LED_CHANNELS > 1
+        _pattern_duty[1][i] = (period * steps[i].green) / 255;
+#endif
+    }
+    uint32_t counts = ((uint32_t)step_ms * WATCH_LED_PATTERN_COUNTS_PER_SECOND) / 1000;
+    if (counts == 0) counts = 1;
+
+    // clock TC1 with the 32.768 kHz crystal on GCLK3, which keeps running in standby.
+    hri_gclk_write_PCHCTRL_reg(GCLK, TC1_GCLK_ID, GCLK_PCHCTRL_GEN_GCLK3_Val | GCLK_PCHCTRL_CHEN);
+    hri_mclk_set_APBCMASK_TC1_bit(MCLK);
+    hri_tc_write_CTRLA_reg(TC1, TC_CTRLA_SWRST);
+    hri_tc_wait_for_sync(TC1, TC_SYNCBUSY_SWRST);
+    hri_tc_write_CTRLA_reg(TC1, TC_CTRLA_PRESCALER_DIV64 |   // 32768 Hz / 64 = 512 counts a second
+                                TC_CTRLA_MODE_COUNT16 |
+                                TC_CTRLA_RUNSTDBY);
+    hri_tc_write_WAVE_reg(TC1, TC_WAVE_WAVEGEN_MFRQ);       // count up to CC0, then wrap: one step
+    hri_tccount16_write_CC_reg(TC1, 0, counts - 1);
+
+    pattern.callback = callback;
+    pattern.loops_left = loops;
+    pattern.playing = true;
+
+    // each channel goes through its colors a beat at a time, and starts over from its own descriptor at the end. the
+    // red channel interrupts at the end of each loop, so that we can count them; a pattern that loops forever never
+    // needs to.
+    _watch_dma_enable();
+    uint32_t swtrig = 0;
+    for (uint8_t i = 0; i < WATCH_BOARD_LED_CHANNELS; i++) {
+        uint8_t channel = _pattern_dma_channels[i];
+        DmacDescriptor *descriptor = &_watch_dma_descriptors[channel];
+        bool counts_loops = i == 0 && loops != 0;
+        descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_WORD | DMAC_BTCTRL_SRCINC |
+                                 (counts_loops ? DMAC_BTCTRL_BLOCKACT_INT : DMAC_BTCTRL_BLOCKACT_NOACT);
+        descriptor->BTCNT.reg = num_steps;
+        // with address increment on, the DMAC wants the address just past the end.
+        descriptor->SRCADDR.reg = (uint32_t)&_pattern_duty[i][num_steps];
+        descriptor->DSTADDR.reg = (uint32_t)&TCC0->CCBUF[_pattern_tcc_channels[i]].reg;
+        descriptor->DESCADDR.reg = loops == 1 ? 0 : (uint32_t)descriptor;
+        _watch_dma_start(channel, TC1_DMAC_ID_OVF, DMAC_CHCTRLB_TRIGACT_BEAT, 0,
+                         counts_loops ? (DMAC_CHINTENSET_TCMPL | DMAC_CHINTENSET_TERR) : 0, true);
+        swtrig |= 1 << channel;
+    }
+    _watch_set_tcc_standby(WATCH_TCC_STANDBY_LED, true);
+    // the first step goes up now, and the timer brings on each of the rest.
+    DMAC->SWTRIGCTRL.reg = swtrig;
+    hri_tc_set_CTRLA_ENABLE_bit(TC1);
+    hri_tc_wait_for_sync(TC1, TC_SYNCBUSY_ENABLE);
+
+    return true;
+}
+
+void watch_led_stop_pattern(void) {
+    if (!pattern.playing) return;
+    pattern.playing = false;
+
+    NVIC_DisableIRQ(TC1_IRQn);
+    NVIC_ClearPendingIRQ(TC1_IRQn);
+    hri_tc_clear_CTRLA_ENABLE_bit(TC1);
+    hri_tc_wait_for_sync(TC1, TC_SYNCBUSY_ENABLE);
+    hri_mclk_clear_APBCMASK_TC1_bit(MCLK);
+    for (uint8_t i = 0; i < WATCH_BOARD_LED_CHANNELS; i++) _watch_dma_stop(_pattern_dma_channels[i]);
+    _watch_dma_disable();
+    watch_set_led_off();
+}
+
+bool watch_led_pattern_is_playing(void) {
+    return pattern.playing;
+}
+
+void _watch_led_dma_handler(uint8_t channel, uint8_t flags) {
+    (void) channel;
+    if (!pattern.playing) return;
+    if (flags & DMAC_CHINTFLAG_TERR) {
+        watch_led_stop_pattern();
+        return;
+    }
+    if (!(flags & DMAC_CHINTFLAG_TCMPL) || pattern.loops_left == 0) return;
+
+    // by now the DMAC has already fetched the descriptor for the next loop; unlinking it makes that loop the last.
+    if (--pattern.loops_left == 1) {
+        for (uint8_t i = 0; i < WATCH_BOARD_LED_CHANNELS; i++) {
+            _watch_dma_descriptors[_pattern_dma_channels[i]].DESCADDR.reg = 0;
+        }
+    } else if (pattern.loops_left == 0) {
+        // the last step has only just gone up; the timer's next overflow is the end of it.
+        hri_tc_clear_INTFLAG_reg(TC1, TC_INTFLAG_OVF);
+        hri_tc_set_INTEN_OVF_bit(TC1);
+        NVIC_ClearPendingIRQ(TC1_IRQn);
+        NVIC_EnableIRQ(TC1_IRQn);
+    }
+}
+
+void TC1_Handler(void) {
+    hri_tc_clear_INTFLAG_reg(TC1, TC_INTFLAG_OVF);
+    ext_irq_cb_t callback = pattern.callback;
+    watch_led_stop_pattern();
+    if (callback != NULL) callback();
+}
+
+#else
+
+// a board without an LED has nothing to light.
+void watch_enable_leds(void) {}
+void watch_disable_leds(void) {}
+void watch_set_led_color(uint8_t red, uint8_t green) { (void) red; (void) green; }
+void watch_set_led_red(void) {}
+void watch_set_led_green(void) {}
+void watch_set_led_yellow(void) {}
+void watch_set_led_off(void) {}
+bool watch_led_play_pattern(const watch_led_step_t *steps, uint8_t num_steps, uint16_t step_ms, uint8_t loops,
+                            ext_irq_cb_t callback) {
+    (void) steps; (void) num_steps; (void) step_ms; (void) loops; (void) callback;
+    return false;
+}
+void watch_led_stop_pattern(void) {}
+bool watch_led_pattern_is_playing(void) { return false; }
+void _watch_led_dma_handler(uint8_t channel, uint8_t flags) { (void) channel; (void) flags; }
+
+#endif
@@ -0,0 +1,111 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+
+#include "watch_log.h"
+#include "watch.h"
+
+// a record is a header word, with the format string's offset in .watch_log in its low 24 bits and the number of
+// arguments above them, followed by the arguments.
+#define LOG_OFFSET_MASK (0xFFFFFF)
+#define LOG_ARGS_SHIFT (24)
+// "@L", the offset and each argument in hex, each after a space, and the line break.
+#define LOG_LINE_SIZE (2 + 9 * (1 + WATCH_LOG_MAX_ARGS) + 2)
+
+static uint32_t _buffer[WATCH_LOG_BUFFER_WORDS];
+static uint16_t _buffer_pos;
+static uint16_t _buffer_len;
+static uint32_t _dropped;
+
+void _watch_log_write(const char *format, const uint32_t *args, uint8_t num_args) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    if (_buffer_len + 1 + num_args > WATCH_LOG_BUFFER_WORDS) {
+        _dropped++;
+    } else {
+        uint16_t pos = (_buffer_pos + _buffer_len) % WATCH_LOG_BUFFER_WORDS;
+        _buffer[pos] = ((uint32_t)format & LOG_OFFSET_MASK) | ((uint32_t)num_args << LOG_ARGS_SHIFT);
+        for (uint8_t i = 0; i < num_args; i++) {
+            pos = (pos + 1) % WATCH_LOG_BUFFER_WORDS;
+            _buffer[pos] = args[i];
+        }
+        _buffer_len += 1 + num_args;
+    }
+    __set_PRIMASK(primask);
+}
+
+// appends a space and value in hex, without leading zeros.
+static uint8_t _watch_log_hex(char *line, uint32_t value) {
+    static const char digits[] = "0123456789abcdef";
+    char reversed[8];
+    uint8_t count = 0;
+    do {
+        reversed[count++] = digits[value & 0xF];
+        value >>= 4;
+    } while (value);
+    line[0] = ' ';
+    for (uint8_t i = 0; i < count; i++) line[1 + i] = reversed[count - 1 - i];
+    return 1 + count;
+}
+
+void watch_log_drain(void) {
+    char line[LOG_LINE_SIZE];
+    bool wrote = false;
+
+    while (cdc_get_write_buffer_space() >= LOG_LINE_SIZE) {
+        uint8_t length = 2;
+        line[0] = '@';
+        line[1] = 'L';
+
+        __disable_irq();
+        // the records that were dropped came after those still in the ring.
+        if (_buffer_len) {
+            uint32_t header = _buffer[_buffer_pos];
+            uint8_t words = 1 + (header >> LOG_ARGS_SHIFT);
+            length += _watch_log_hex(line + length, header & LOG_OFFSET_MASK);
+            for (uint8_t i = 1; i < words; i++) {
+                length += _watch_log_hex(line + length, _buffer[(_buffer_pos + i) % WATCH_LOG_BUFFER_WORDS]);
+            }
+            _buffer_pos = (_buffer_pos + words) % WATCH_LOG_BUFFER_WORDS;
+            _buffer_len -= words;
+        } else if (_dropped) {
+            line[length++] = ' ';
+            line[length++] = '!';
+            length += _watch_log_hex(line + length, _dropped);
+            _dropped = 0;
+        } else {
+            __enable_irq();
+            break;
+        }
+        __enable_irq();
+
+        line[length++] = '\r';
+        line[length++] = '\n';
+        fwrite(line, 1, length, stdout);
+        wrote = true;
+    }
+
+    if (wrote) fflush(stdout);
+}
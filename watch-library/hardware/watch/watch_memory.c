@@ -0,0 +1,84 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <errno.h>
+#include <sys/types.h>
+
+#include "watch_memory.h"
+#include "watch.h"
+
+// from the linker script: the stack's bounds, the end of everything placed in RAM, and the end of RAM.
+extern uint32_t _sstack;
+extern uint32_t _estack;
+extern uint8_t _end;
+extern uint8_t _eram;
+
+// what's left of the stack's words at boot, as far as anything has left them alone.
+#define STACK_PAINT (0xC5C5C5C5)
+
+static uint8_t *_heap_top = &_end;
+static uint8_t *_heap_high_water = &_end;
+
+void _watch_memory_paint_stack(void) {
+    // everything below the stack pointer is free this early, interrupts being off; the loop itself runs in registers.
+    uint32_t *top = (uint32_t *)__get_MSP();
+    for (uint32_t *word = &_sstack; word < top; word++) *word = STACK_PAINT;
+}
+
+// newlib's malloc asks for memory through this. It replaces the one in utils_syscalls.c, which let the heap run off
+// the end of RAM.
+caddr_t _sbrk(int incr);
+caddr_t _sbrk(int incr) {
+    uint8_t *previous = _heap_top;
+
+    if (incr > &_eram - _heap_top || incr < &_end - _heap_top) {
+        errno = ENOMEM;
+        return (caddr_t)-1;
+    }
+    _heap_top += incr;
+    if (_heap_top > _heap_high_water) _heap_high_water = _heap_top;
+
+    return (caddr_t)previous;
+}
+
+size_t watch_get_stack_size(void) {
+    return (uint8_t *)&_estack - (uint8_t *)&_sstack;
+}
+
+size_t watch_get_stack_high_water(void) {
+    const uint32_t *word = &_sstack;
+
+    // the stack grows down from _estack, so the words that still have the pattern are all at the bottom.
+    while (word < &_estack && *word == STACK_PAINT) word++;
+
+    return (uint8_t *)&_estack - (uint8_t *)word;
+}
+
+size_t watch_get_heap_size(void) {
+    return &_eram - &_end;
+}
+
+size_t watch_get_heap_high_water(void) {
+    return _heap_high_water - &_end;
+}
@@ -22,11 +22,19 @@
  * SOFTWARE.
  */
 
+#include <string.h>
 #include "watch_private.h"
 #include "watch_private_cdc.h"
 #include "watch_utility.h"
 #include "tusb.h"
 
+static void _watch_battery_low_for_lpeff(void) {
+    // Our system voltage has dipped below 2.6V!
+    // Set the voltage regulator to work at low system voltage before we hit 2.5 V
+    // This voltage regulator can carry us down to 1.62 volts as the battery drains.
+    SUPC->VREG.bit.LPEFF = 0;
+}
+
 void _watch_init(void) {
     // disable the LED pin (it may have been enabled by the bootloader)
     watch_disable_digital_output(GPIO(GPIO_PORTA, 20));
@@ -45,9 +53,9 @@ void _watch_init(void) {
     while(!SUPC->STATUS.bit.VREGRDY); // wait for voltage regulator to become ready
 
     // check the battery voltage...
-    watch_enable_adc();
+    watch_claim_peripheral(WATCH_PERIPHERAL_ADC);
     uint16_t battery_voltage = watch_get_vcc_voltage();
-    watch_disable_adc();
+    watch_release_peripheral(WATCH_PERIPHERAL_ADC);
     // ...because we can enable the more efficient low power regulator if the system voltage is > 2.5V
     // still, enable LPEFF only if the battery voltage is comfortably above this threshold.
     if (battery_voltage >= 2700) {
@@ -56,7 +64,7 @@ void _watch_init(void) {
         SUPC->VREG.bit.LPEFF = 0;
     }
 
-    // set up the brownout detector (low battery warning)
+    // set up the brownout detector (low battery warning); the battery monitor sets its level, and turns it on.
     NVIC_DisableIRQ(SYSTEM_IRQn);
     NVIC_ClearPendingIRQ(SYSTEM_IRQn);
     NVIC_EnableIRQ(SYSTEM_IRQn);
@@ -67,54 +75,85 @@ void _watch_init(void) {
     SUPC->BOD33.bit.STDBYCFG = 1;   // Run in standby
     SUPC->BOD33.bit.RUNBKUP = 0;    // Don't run in backup mode
     SUPC->BOD33.bit.PSEL = 0x9;     // Check battery level every second (we'll change this before entering sleep)
-    SUPC->BOD33.bit.LEVEL = 34;     // Detect brownout at 2.6V (1.445V + level * 34mV)
     SUPC->BOD33.bit.ACTION = 0x2;   // Generate an interrupt when BOD33 is triggered
     SUPC->BOD33.bit.HYST = 0;       // Disable hysteresis
     while(!SUPC->STATUS.bit.B33SRDY); // wait for BOD33 to sync
-
-    // Enable interrupt on BOD33 detect
-    SUPC->INTENSET.bit.BOD33DET = 1;
-    SUPC->BOD33.bit.ENABLE = 1;
+    watch_register_battery_threshold(2600, _watch_battery_low_for_lpeff);
 
     // External wake depends on RTC; calendar is a required module.
     _watch_rtc_init();
 
+    // now that we know the battery voltage, settle on a regulator and performance level.
+    watch_update_power_policy();
+
     // set up state
     btn_alarm_callback = NULL;
     a2_callback = NULL;
     a4_callback = NULL;
 }
 
+void _watch_battery_set_detector(uint16_t millivolts) {
+    SUPC->INTENCLR.reg = SUPC_INTENCLR_BOD33DET;
+    SUPC->BOD33.bit.ENABLE = 0;
+    while(!SUPC->STATUS.bit.B33SRDY);
+    SUPC->INTFLAG.reg = SUPC_INTFLAG_BOD33DET;
+    if (millivolts == 0) return;
+
+    // VDD below 1.445 V + LEVEL * 34 mV sets off the detector.
+    SUPC->BOD33.bit.LEVEL = (millivolts - WATCH_BATTERY_DETECTOR_MIN) / WATCH_BATTERY_DETECTOR_STEP;
+    SUPC->BOD33.bit.ENABLE = 1;
+    while(!SUPC->STATUS.bit.B33SRDY);
+    SUPC->INTENSET.reg = SUPC_INTENSET_BOD33DET;
+}
+
 static inline void _watch_wait_for_entropy() {
     while (!hri_trng_get_INTFLAG_reg(TRNG, TRNG_INTFLAG_DATARDY));
 }
 
-// this function is called by arc4random to get entropy for random number generation.
-int getentropy(void *buf, size_t buflen);
-
-// let's use the SAM L22's true random number generator to seed the PRNG!
-int getentropy(void *buf, size_t buflen) {
+// let's use the SAM L22's true random number generator to fill the entropy pool! powering it up is the slow part, so
+// take all the words we need in one go.
+void _watch_random_collect(uint32_t *words, uint8_t count) {
     hri_mclk_set_APBCMASK_TRNG_bit(MCLK);
     hri_trng_set_CTRLA_ENABLE_bit(TRNG);
 
-    size_t i = 0;
-    while(i < buflen / 4) {
+    for (uint8_t i = 0; i < count; i++) {
         _watch_wait_for_entropy();
-        ((uint32_t *)buf)[i++] = hri_trng_read_DATA_reg(TRNG);
-    }
-
-    // but what if they asked for an awkward number of bytes?
-    if (buflen % 4) {
-        // all good: let's fill in one, two or three bytes at the end of the buffer.
-        _watch_wait_for_entropy();
-        uint32_t last_little_bit = hri_trng_read_DATA_reg(TRNG);
-        for(size_t j = 0; j <= (buflen % 4); j++) {
-            ((uint8_t *)buf)[i * 4 + j] = (last_little_bit >> (j * 8)) & 0xFF;
-        }
+        words[i] = hri_trng_read_DATA_reg(TRNG);
     }
 
     watch_disable_TRNG();
     hri_mclk_clear_APBCMASK_TRNG_bit(MCLK);
+}
+
+// the DSU reads the range itself, as a bus master, so the CPU only has to wait for it. it's write-protected out of
+// reset, and it refuses (with a bus error) any range outside flash and RAM.
+bool _watch_crc32_words(uint32_t *crc, const uint32_t *words, size_t count) {
+    if (PAC->STATUSB.reg & PAC_STATUSB_DSU) PAC->WRCTRL.reg = PAC_WRCTRL_PERID(ID_DSU) | PAC_WRCTRL_KEY_CLR;
+
+    DSU->STATUSA.reg = DSU_STATUSA_DONE | DSU_STATUSA_BERR;
+    DSU->ADDR.reg = (uint32_t)words;
+    DSU->LENGTH.reg = DSU_LENGTH_LENGTH(count);
+    DSU->DATA.reg = *crc;
+    DSU->CTRL.reg = DSU_CTRL_CRC;
+    while (!(DSU->STATUSA.reg & DSU_STATUSA_DONE));
+
+    if (DSU->STATUSA.reg & DSU_STATUSA_BERR) return false;
+    *crc = DSU->DATA.reg;
+    return true;
+}
+
+// this function is called by arc4random to get entropy for random number generation. it draws on the pool, so it
+// only waits on the TRNG if the pool has run dry.
+int getentropy(void *buf, size_t buflen);
+int getentropy(void *buf, size_t buflen) {
+    uint8_t *bytes = (uint8_t *)buf;
+    while (buflen) {
+        uint32_t word = watch_random_true();
+        size_t n = buflen < 4 ? buflen : 4;
+        memcpy(bytes, &word, n);
+        bytes += n;
+        buflen -= n;
+    }
 
     return 0;
 }
@@ -128,6 +167,26 @@ void watch_disable_TRNG() {
 }
 
 
+// users that need TCC0 to keep running in standby. it's one peripheral, so the first to ask turns RUNSTDBY on and
+// the last to let go turns it off.
+static uint8_t _tcc_standby_users;
+
+void _watch_set_tcc_standby(uint8_t user, bool run_in_standby) {
+    uint8_t users = run_in_standby ? (_tcc_standby_users | user) : (_tcc_standby_users & ~user);
+    bool changed = (users != 0) != (_tcc_standby_users != 0);
+    _tcc_standby_users = users;
+
+    // if the TCC is off, _watch_enable_tcc will pick up the setting when it resets it.
+    if (!changed || !hri_tcc_get_CTRLA_reg(TCC0, TCC_CTRLA_ENABLE)) return;
+
+    // RUNSTDBY is enable-protected, so the TCC has to stop for a moment while we change it.
+    hri_tcc_clear_CTRLA_ENABLE_bit(TCC0);
+    hri_tcc_wait_for_sync(TCC0, TCC_SYNCBUSY_ENABLE);
+    hri_tcc_write_CTRLA_RUNSTDBY_bit(TCC0, users != 0);
+    hri_tcc_set_CTRLA_ENABLE_bit(TCC0);
+    hri_tcc_wait_for_sync(TCC0, TCC_SYNCBUSY_ENABLE);
+}
+
 void _watch_enable_tcc(void) {
     // clock TCC0 with the main clock (8 MHz) and enable the peripheral clock.
     hri_gclk_write_PCHCTRL_reg(GCLK, TCC0_GCLK_ID, GCLK_PCHCTRL_GEN_GCLK0_Val | GCLK_PCHCTRL_CHEN);
@@ -137,13 +196,15 @@ void _watch_enable_tcc(void) {
     hri_tcc_wait_for_sync(TCC0, TCC_SYNCBUSY_ENABLE);
     hri_tcc_write_CTRLA_reg(TCC0, TCC_CTRLA_SWRST);
     hri_tcc_wait_for_sync(TCC0, TCC_SYNCBUSY_SWRST);
-    // divide the clock down to 1 MHz
+    // divide the clock down to 1 MHz. the buzzer's note periods count at this rate, so the TCC stays on the main
+    // clock even in standby, where its request keeps the oscillator running on demand.
+    uint32_t ctrla = _tcc_standby_users ? TCC_CTRLA_RUNSTDBY : 0;
     if (hri_usbdevice_get_CTRLA_ENABLE_bit(USB)) {
         // if USB is enabled, we are running an 8 MHz clock.
-        hri_tcc_write_CTRLA_reg(TCC0, TCC_CTRLA_PRESCALER_DIV8);
+        hri_tcc_write_CTRLA_reg(TCC0, ctrla | TCC_CTRLA_PRESCALER_DIV8);
     } else {
         // otherwise it's 4 Mhz.
-        hri_tcc_write_CTRLA_reg(TCC0, TCC_CTRLA_PRESCALER_DIV4);
+        hri_tcc_write_CTRLA_reg(TCC0, ctrla | TCC_CTRLA_PRESCALER_DIV4);
     }
     // We're going to use normal PWM mode, which means period is controlled by PER, and duty cycle is controlled by
     // each compare channel's value:
@@ -151,45 +212,70 @@ void _watch_enable_tcc(void) {
     //    period (i.e. a square wave with a 50% duty cycle).
     //  * LEDs on CC[2] and CC[3] can be set to any value from 0 (off) to PER (fully on).
     hri_tcc_write_WAVE_reg(TCC0, TCC_WAVE_WAVEGEN_NPWM);
-    #ifdef WATCH_INVERT_LED_POLARITY
+    #if defined(WATCH_INVERT_LED_POLARITY) && WATCH_BOARD_LED_CHANNELS > 1
     // This is here for the dev board, which uses a common anode LED (instead of common cathode like the actual watch).
     hri_tcc_set_WAVE_reg(TCC0, (1 << (TCC_WAVE_POL0_Pos + WATCH_RED_TCC_CHANNEL)) |
                                (1 << (TCC_WAVE_POL0_Pos + WATCH_GREEN_TCC_CHANNEL)));
+    #elif defined(WATCH_INVERT_LED_POLARITY) && WATCH_BOARD_HAS_LED
+    hri_tcc_set_WAVE_reg(TCC0, 1 << (TCC_WAVE_POL0_Pos + WATCH_RED_TCC_CHANNEL));
     #endif
     // The buzzer will set the period depending on the tone it wants to play, but we have to set some period here to
     // get the LED working. Almost any period will do, tho it should be below 20000 (i.e. 50 Hz) to avoid flickering.
     hri_tcc_write_PER_reg(TCC0, 1024);
     // Set the duty cycle of all pins to 0: LED's off, buzzer not buzzing.
+#if WATCH_BOARD_HAS_BUZZER
     hri_tcc_write_CC_reg(TCC0, WATCH_BUZZER_TCC_CHANNEL, 0);
+#endif
+#if WATCH_BOARD_HAS_LED
     hri_tcc_write_CC_reg(TCC0, WATCH_RED_TCC_CHANNEL, 0);
+#endif
+#if WATCH_BOARD_LED_CHANNELS > 1
     hri_tcc_write_CC_reg(TCC0, WATCH_GREEN_TCC_CHANNEL, 0);
+#endif
     // Enable the TCC
     hri_tcc_set_CTRLA_ENABLE_bit(TCC0);
     hri_tcc_wait_for_sync(TCC0, TCC_SYNCBUSY_ENABLE);
 
     // enable LED PWM pins (the LED driver assumes if the TCC is on, the pins are enabled)
+#if WATCH_BOARD_HAS_LED
     gpio_set_pin_direction(RED, GPIO_DIRECTION_OUT);
     gpio_set_pin_function(RED, WATCH_RED_TCC_PINMUX);
+#endif
+#if WATCH_BOARD_LED_CHANNELS > 1
     gpio_set_pin_direction(GREEN, GPIO_DIRECTION_OUT);
     gpio_set_pin_function(GREEN, WATCH_GREEN_TCC_PINMUX);
+#endif
 }
 
 void _watch_disable_tcc(void) {
+    // a pattern would carry on copying into a TCC that's gone.
+    watch_led_stop_pattern();
+
     // disable all PWM pins
+#if WATCH_BOARD_HAS_BUZZER
     gpio_set_pin_direction(BUZZER, GPIO_DIRECTION_OFF);
     gpio_set_pin_function(BUZZER, GPIO_PIN_FUNCTION_OFF);
+#endif
+#if WATCH_BOARD_HAS_LED
     gpio_set_pin_direction(RED, GPIO_DIRECTION_OFF);
     gpio_set_pin_function(RED, GPIO_PIN_FUNCTION_OFF);
+#endif
+#if WATCH_BOARD_LED_CHANNELS > 1
     gpio_set_pin_direction(GREEN, GPIO_DIRECTION_OFF);
     gpio_set_pin_function(GREEN, GPIO_PIN_FUNCTION_OFF);
+#endif
 
-    // disable the TCC
+    // disable the TCC; whoever enables it next starts from silence and darkness, so has nothing to keep running.
     hri_tcc_clear_CTRLA_ENABLE_bit(TCC0);
     hri_mclk_clear_APBCMASK_TCC0_bit(MCLK);
+    hri_gclk_write_PCHCTRL_reg(GCLK, TCC0_GCLK_ID, 0);
+    _tcc_standby_users = 0;
 }    
 
 void _watch_enable_tc0(void) {
-    // before we init TinyUSB, we are going to need a periodic callback to handle TinyUSB tasks.
+    // TinyUSB's task runs in TC0's interrupt: USB_Handler pends it right after each USB interrupt, and the timer is
+    // a slow fallback for anything the task left for later. the interrupt runs at a lower priority than USB, so the
+    // task never interrupts the stack it's working on.
     // TC2 and TC3 are reserved for devices on the 9-pin connector, so let's use TC0.
     // clock TC0 with the 8 MHz clock on GCLK0.
     hri_gclk_write_PCHCTRL_reg(GCLK, TC0_GCLK_ID, GCLK_PCHCTRL_GEN_GCLK0_Val | GCLK_PCHCTRL_CHEN);
@@ -203,7 +289,7 @@ void _watch_enable_tc0(void) {
     hri_tc_write_CTRLA_reg(TC0, TC_CTRLA_PRESCALER_DIV1024 | // divide the 8 MHz clock by 1024 to count at 7812.5 Hz
                                 TC_CTRLA_MODE_COUNT8 |       // count in 8-bit mode
                                 TC_CTRLA_RUNSTDBY);          // run in standby, just in case we figure that out
-    hri_tccount8_write_PER_reg(TC0, 10);                     // 7812.5 Hz / 10 = 781.125 Hz
+    hri_tccount8_write_PER_reg(TC0, 255);                    // 7812.5 Hz / 256 = 30.5 Hz
     // set an interrupt on overflow; this will call TC0_Handler below.
     hri_tc_set_INTEN_OVF_bit(TC0);
 
@@ -237,7 +323,7 @@ void _watch_enable_tc1(void) {
     hri_tc_write_CTRLA_reg(TC1, TC_CTRLA_PRESCALER_DIV1024 | // divide the 8 MHz clock by 1024 to count at 7812.5 Hz
                                 TC_CTRLA_MODE_COUNT8 |       // count in 8-bit mode
                                 TC_CTRLA_RUNSTDBY);          // run in standby, just in case we figure that out
-    hri_tccount8_write_PER_reg(TC1, 20);                     // 7812.5 Hz / 50 = 156.25 Hz
+    hri_tccount8_write_PER_reg(TC1, 255);                    // 7812.5 Hz / 256 = 30.5 Hz; writes and reads pend it sooner
     // set an interrupt on overflow; this will call TC1_Handler below.
     hri_tc_set_INTEN_OVF_bit(TC1);
 
@@ -260,8 +346,17 @@ void _watch_disable_tc1(void) {
 }
 
 void TC0_Handler(void) {
+    // TC0 only times the buttons when the watch isn't on USB (@see watch_button_timer_start).
+    if (!watch_is_usb_enabled()) {
+        _watch_button_timer_interrupt();
+        return;
+    }
+    // we also get here when USB_Handler pends the interrupt, and only an overflow is a tick of the timer.
+    if (TC0->COUNT8.INTFLAG.bit.OVF) {
+        TC0->COUNT8.INTFLAG.reg = TC_INTFLAG_OVF;
+        _watch_input_trace_tick();
+    }
     tud_task();
-    TC0->COUNT8.INTFLAG.reg |= TC_INTFLAG_OVF;
 }
 
 void TC1_Handler(void) {
@@ -320,8 +415,51 @@ void _watch_enable_usb(void) {
     _watch_enable_tc1();
 }
 
+bool _watch_disable_usb(void) {
+    if (!watch_is_usb_enabled()) return true;
+    // the TCC divides the main clock down for the buzzer's notes and the LED's PWM; changing the clock under it would
+    // put them out of tune, so wait for them to finish.
+    if (watch_is_buzzer_or_led_enabled()) return false;
+
+    // the host is gone, so there's no one to tell. stop the task timers, then USB itself...
+    _watch_disable_tc1();
+    _watch_disable_tc0();
+    hri_mclk_clear_APBCMASK_TC0_bit(MCLK);
+    hri_mclk_clear_APBCMASK_TC1_bit(MCLK);
+    hri_gclk_write_PCHCTRL_reg(GCLK, TC0_GCLK_ID, 0);
+    NVIC_DisableIRQ(USB_IRQn);
+    NVIC_ClearPendingIRQ(USB_IRQn);
+    hri_usb_clear_CTRLA_ENABLE_bit(USB);
+    hri_mclk_clear_AHBMASK_USB_bit(MCLK);
+    hri_mclk_clear_APBBMASK_USB_bit(MCLK);
+    gpio_set_pin_function(PIN_PA24, GPIO_PIN_FUNCTION_OFF);
+    gpio_set_pin_function(PIN_PA25, GPIO_PIN_FUNCTION_OFF);
+    gpio_set_pin_direction(PIN_PA24, GPIO_DIRECTION_OFF);
+    gpio_set_pin_direction(PIN_PA25, GPIO_DIRECTION_OFF);
+
+    // ...then the 48 MHz clock it ran on: its channel, GCLK1, and the DFLL behind it.
+    hri_gclk_write_PCHCTRL_reg(GCLK, USB_GCLK_ID, 0);
+    GCLK->GENCTRL[1].reg = 0;
+    while (GCLK->SYNCBUSY.bit.GENCTRL1);
+    OSCCTRL->DFLLCTRL.reg = 0;
+    while (!(OSCCTRL->STATUS.reg & OSCCTRL_STATUS_DFLLRDY));
+
+    // the main clock goes back to 4 MHz, unless a burst has it at 16, in which case it comes back to 4 at the end.
+    if (hri_oscctrl_read_OSC16MCTRL_FSEL_bf(OSCCTRL) == OSCCTRL_OSC16MCTRL_FSEL_8_Val) {
+        hri_oscctrl_write_OSC16MCTRL_FSEL_bf(OSCCTRL, OSCCTRL_OSC16MCTRL_FSEL_4_Val);
+        while (!hri_oscctrl_get_STATUS_OSC16MRDY_bit(OSCCTRL));
+    }
+
+    // without USB, the core can drop to PL0 and use the buck.
+    watch_update_power_policy();
+
+    return true;
+}
+
 void USB_Handler(void) {
     tud_int_handler(0);
+    // the stack has queued whatever happened; run its task as soon as we return, rather than at the next tick.
+    NVIC_SetPendingIRQ(TC0_IRQn);
 }
 
 // USB Descriptors and tinyUSB callbacks follow.
@@ -392,15 +530,25 @@ uint8_t const * tud_descriptor_device_cb(void) {
 enum {
   ITF_NUM_CDC = 0,
   ITF_NUM_CDC_DATA,
+#ifdef MOVEMENT_USB_MSC
+  ITF_NUM_MSC,
+#endif
   ITF_NUM_TOTAL
 };
 
+#ifdef MOVEMENT_USB_MSC
+#define CONFIG_TOTAL_LEN    (TUD_CONFIG_DESC_LEN + TUD_CDC_DESC_LEN + TUD_MSC_DESC_LEN)
+#else
 #define CONFIG_TOTAL_LEN    (TUD_CONFIG_DESC_LEN + TUD_CDC_DESC_LEN)
+#endif
 
 #define EPNUM_CDC_NOTIF   0x81
 #define EPNUM_CDC_OUT     0x02
 #define EPNUM_CDC_IN      0x82
 
+#define EPNUM_MSC_OUT     0x03
+#define EPNUM_MSC_IN      0x83
+
 
 uint8_t const desc_fs_configuration[] = {
   // Config number, interface count, string index, total length, attribute, power in mA
@@ -408,6 +556,11 @@ uint8_t const desc_fs_configuration[] = {
 
   // Interface number, string index, EP notification address and size, EP data address (out, in) and size.
   TUD_CDC_DESCRIPTOR(ITF_NUM_CDC, 4, EPNUM_CDC_NOTIF, 8, EPNUM_CDC_OUT, EPNUM_CDC_IN, 64),
+
+#ifdef MOVEMENT_USB_MSC
+  // Interface number, string index, EP Out & EP In address, EP size
+  TUD_MSC_DESCRIPTOR(ITF_NUM_MSC, 5, EPNUM_MSC_OUT, EPNUM_MSC_IN, 64),
+#endif
 };
 
 // Invoked when received GET CONFIGURATION DESCRIPTOR
@@ -430,6 +583,7 @@ char const* string_desc_arr [] =
   "TinyUSB Device",              // 2: Product
   "123456",                      // 3: Serials, should use chip ID
   "TinyUSB CDC",                 // 4: CDC Interface
+  "TinyUSB MSC",                 // 5: MSC Interface
 };
 
 static uint16_t _desc_str[32];
@@ -0,0 +1,63 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <string.h>
+#include "watch_private.h"
+
+// the engine takes its key and data as little-endian words, which is the byte order of the arrays in memory. blocks go
+// in and come out through INDATA, four words at a time. a block is four writes and four reads, which is no more than
+// setting up a DMA descriptor would cost, so the CPU feeds it. the engine only runs off the APB clock.
+
+void _watch_aes_begin(const uint8_t *key, bool encrypt) {
+    uint32_t words[4];
+    hri_mclk_set_APBCMASK_AES_bit(MCLK);
+    AES->CTRLA.reg = AES_CTRLA_SWRST;
+    while (AES->CTRLA.reg & AES_CTRLA_SWRST);
+    // ECB, a 128 bit key, and a manual start for each block.
+    AES->CTRLA.reg = AES_CTRLA_AESMODE(0) | AES_CTRLA_KEYSIZE(0) | (encrypt ? AES_CTRLA_CIPHER : 0);
+    AES->CTRLA.reg |= AES_CTRLA_ENABLE;
+    memcpy(words, key, sizeof(words));
+    for (uint8_t i = 0; i < 4; i++) AES->KEYWORD[i].reg = words[i];
+    memset(words, 0, sizeof(words));
+}
+
+void _watch_aes_block(const uint8_t *in, uint8_t *out) {
+    uint32_t words[4];
+    memcpy(words, in, sizeof(words));
+    AES->INTFLAG.reg = AES_INTFLAG_ENCCMP;
+    AES->DATABUFPTR.reg = 0;
+    for (uint8_t i = 0; i < 4; i++) AES->INDATA.reg = words[i];
+    AES->CTRLB.reg = AES_CTRLB_START;
+    while (!(AES->INTFLAG.reg & AES_INTFLAG_ENCCMP));
+    AES->DATABUFPTR.reg = 0;
+    for (uint8_t i = 0; i < 4; i++) words[i] = AES->INDATA.reg;
+    memcpy(out, words, sizeof(words));
+}
+
+void _watch_aes_end(void) {
+    // a reset clears the key, and leaves the engine off.
+    AES->CTRLA.reg = AES_CTRLA_SWRST;
+    while (AES->CTRLA.reg & AES_CTRLA_SWRST);
+    hri_mclk_clear_APBCMASK_AES_bit(MCLK);
+}
@@ -44,6 +44,9 @@
 static char s_write_buf[CDC_WRITE_BUF_SZ] = {0};
 static size_t s_write_buf_pos = 0;
 static size_t s_write_buf_len = 0;
+// Most bytes ever waiting in the write buffer, and bytes thrown away because it was full.
+static size_t s_write_buf_high_water = 0;
+static uint32_t s_write_bytes_dropped = 0;
 
 #define CDC_READ_BUF_SZ  (256)
 #define CDC_READ_BUF_IDX(x)  ((x) & (CDC_READ_BUF_SZ - 1))
@@ -68,22 +71,31 @@ int _write(int file, char *ptr, int len) {
         return -1;
     }
 
-    int bytes_written = 0;
-
     prv_critical_section_enter();
 
     for (int i = 0; i < len; i++) {
+        if (s_write_buf_len >= CDC_WRITE_BUF_SZ) {
+            // Never wait for the host here; printf has to return promptly
+            // whether or not anyone is listening. Drop what doesn't fit
+            // (keeping what's already queued intact) and count it.
+            s_write_bytes_dropped += len - i;
+            break;
+        }
         s_write_buf[s_write_buf_pos] = ptr[i];
         s_write_buf_pos = CDC_WRITE_BUF_IDX(s_write_buf_pos + 1);
-        if (s_write_buf_len < CDC_WRITE_BUF_SZ) {
-            s_write_buf_len++;
-        }
-        bytes_written++;
+        s_write_buf_len++;
+    }
+    if (s_write_buf_len > s_write_buf_high_water) {
+        s_write_buf_high_water = s_write_buf_len;
     }
 
     prv_critical_section_exit();
 
-    return bytes_written;
+    // Send it now; TC1's own period is only a fallback.
+    NVIC_SetPendingIRQ(TC1_IRQn);
+
+    // Report the whole write as done, so that callers don't retry in a loop.
+    return len;
 }
 
 int _read(int file, char *ptr, int len) {
@@ -134,19 +146,21 @@ static void prv_handle_reads(void) {
 
 static void prv_handle_writes(void) {
     if (s_write_buf_len > 0) {
-        const size_t start_pos =
-            CDC_WRITE_BUF_IDX(s_write_buf_pos - s_write_buf_len);
-        for (size_t i = 0; i < (size_t) s_write_buf_len; i++) {
-            const size_t idx = CDC_WRITE_BUF_IDX(start_pos + i);
+        while (s_write_buf_len > 0) {
+            const size_t idx =
+                CDC_WRITE_BUF_IDX(s_write_buf_pos - s_write_buf_len);
             if (tud_cdc_available() > 0) {
                 // If we receive data while doing a large write, we need to
                 // fully service it before continuing to write, or the
                 // stack will crash.
                 prv_handle_reads();
             }
-            if (tud_cdc_write_available()) {
-                tud_cdc_write(&s_write_buf[idx], 1);
+            if (!tud_cdc_write_available()) {
+                // The USB FIFO is full; leave the rest for next time rather
+                // than dropping it, or long transfers arrive with holes.
+                break;
             }
+            tud_cdc_write(&s_write_buf[idx], 1);
             s_write_buf[idx] = 0;
             s_write_buf_len--;
         }
@@ -154,6 +168,53 @@ static void prv_handle_writes(void) {
     }
 }
 
+size_t cdc_get_write_buffer_space(void) {
+    prv_critical_section_enter();
+    size_t space = CDC_WRITE_BUF_SZ - s_write_buf_len;
+    prv_critical_section_exit();
+    return space;
+}
+
+size_t cdc_get_write_buffer_high_water_mark(void) {
+    return s_write_buf_high_water;
+}
+
+uint32_t cdc_get_dropped_byte_count(void) {
+    return s_write_bytes_dropped;
+}
+
+void cdc_reset_write_stats(void) {
+    prv_critical_section_enter();
+    s_write_buf_high_water = s_write_buf_len;
+    s_write_bytes_dropped = 0;
+    prv_critical_section_exit();
+}
+
+bool cdc_flush(uint32_t timeout_ms) {
+    // cdc_task runs from the TC1 interrupt, so all we do here is wait for it.
+    for (uint32_t waited = 0; s_write_buf_len > 0; waited++) {
+        if (waited >= timeout_ms) return false;
+        delay_ms(1);
+    }
+    return true;
+}
+
+// TinyUSB calls this (from tud_task, in the TC0 interrupt) when a packet has gone out. Rather than wait up to a
+// TC1 period to refill the FIFO, pend TC1 so that cdc_task runs the moment TC0 returns; it keeps cdc_task in one
+// interrupt context, so the buffer still only needs protecting from TC1.
+void tud_cdc_tx_complete_cb(uint8_t itf) {
+    (void) itf;
+    if (s_write_buf_len > 0) {
+        NVIC_SetPendingIRQ(TC1_IRQn);
+    }
+}
+
+// Likewise when a packet has come in, so that the shell's read buffer fills right away.
+void tud_cdc_rx_cb(uint8_t itf) {
+    (void) itf;
+    NVIC_SetPendingIRQ(TC1_IRQn);
+}
+
 void cdc_task(void) {
     prv_handle_reads();
     prv_handle_writes();
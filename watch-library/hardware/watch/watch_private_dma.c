@@ -0,0 +1,84 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Joey Castillo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "watch_private_dma.h"
+
+// the DMAC reads each channel's descriptor from the first table, and writes its progress back to the second. both
+// must be 128-bit aligned, with one entry per channel up to the highest one in use.
+DmacDescriptor _watch_dma_descriptors[WATCH_DMA_NUM_CHANNELS] __attribute__((aligned(16)));
+static DmacDescriptor _watch_dma_writeback[WATCH_DMA_NUM_CHANNELS] __attribute__((aligned(16)));
+static uint8_t _watch_dma_users;
+
+void _watch_dma_enable(void) {
+    if (_watch_dma_users++) return;
+
+    // the DMAC only accepts a reset (and a new base address) while it's disabled.
+    hri_mclk_set_AHBMASK_DMAC_bit(MCLK);
+    DMAC->CTRL.reg = 0;
+    DMAC->CTRL.reg = DMAC_CTRL_SWRST;
+    while (DMAC->CTRL.reg & DMAC_CTRL_SWRST);
+    DMAC->BASEADDR.reg = (uint32_t)_watch_dma_descriptors;
+    DMAC->WRBADDR.reg = (uint32_t)_watch_dma_writeback;
+    DMAC->CTRL.reg = DMAC_CTRL_DMAENABLE | DMAC_CTRL_LVLEN(0xF);
+    NVIC_ClearPendingIRQ(DMAC_IRQn);
+    NVIC_EnableIRQ(DMAC_IRQn);
+}
+
+void _watch_dma_disable(void) {
+    if (_watch_dma_users == 0 || --_watch_dma_users) return;
+
+    NVIC_DisableIRQ(DMAC_IRQn);
+    DMAC->CTRL.reg = 0;
+    hri_mclk_clear_AHBMASK_DMAC_bit(MCLK);
+}
+
+void _watch_dma_start(uint8_t channel, uint8_t trigger, uint32_t trigger_action, uint8_t level, uint8_t interrupts,
+                      bool standby) {
+    DMAC->CHID.reg = channel;
+    DMAC->CHCTRLA.reg = 0;
+    DMAC->CHCTRLB.reg = DMAC_CHCTRLB_TRIGSRC(trigger) | trigger_action | DMAC_CHCTRLB_LVL(level);
+    DMAC->CHINTFLAG.reg = DMAC_CHINTFLAG_TCMPL | DMAC_CHINTFLAG_TERR | DMAC_CHINTFLAG_SUSP;
+    DMAC->CHINTENCLR.reg = DMAC_CHINTENCLR_TCMPL | DMAC_CHINTENCLR_TERR | DMAC_CHINTENCLR_SUSP;
+    DMAC->CHINTENSET.reg = interrupts;
+    DMAC->CHCTRLA.reg = DMAC_CHCTRLA_ENABLE | (standby ? DMAC_CHCTRLA_RUNSTDBY : 0);
+}
+
+void _watch_dma_stop(uint8_t channel) {
+    DMAC->CHID.reg = channel;
+    DMAC->CHCTRLA.reg = 0;
+    DMAC->CHINTENCLR.reg = DMAC_CHINTENCLR_TCMPL | DMAC_CHINTENCLR_TERR | DMAC_CHINTENCLR_SUSP;
+}
+
+void DMAC_Handler(void) {
+    uint8_t pending = DMAC->INTPEND.reg & DMAC_INTPEND_ID_Msk;
+    DMAC->CHID.reg = pending;
+    uint8_t flags = DMAC->CHINTFLAG.reg;
+    DMAC->CHINTFLAG.reg = flags;
+
+    if (pending == WATCH_DMA_DISPLAY_CHANNEL) _watch_slcd_dma_handler(pending, flags);
+    else if (pending == WATCH_DMA_UART_TX_CHANNEL) _watch_uart_dma_handler(pending, flags);
+    else if (pending == WATCH_DMA_LED_RED_CHANNEL || pending == WATCH_DMA_LED_GREEN_CHANNEL) _watch_led_dma_handler(pending, flags);
+    else _watch_spi_dma_handler(pending, flags);
+}
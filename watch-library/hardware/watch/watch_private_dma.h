@@ -0,0 +1,67 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2022 Joey Castillo
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef _WATCH_PRIVATE_DMA_H_INCLUDED
+#define _WATCH_PRIVATE_DMA_H_INCLUDED
+
+#include "watch.h"
+
+// The DMAC's channels, and who uses them. SPI's receive channel gets the higher priority so that it always drains
+// DATA before the transmit channel refills it; the display's comes last, since a frame late is no great loss. SPI and
+// the UART share SERCOM3, so their channels are never busy at once. An LED pattern takes one channel for each color.
+#define WATCH_DMA_SPI_RX_CHANNEL 0
+#define WATCH_DMA_SPI_TX_CHANNEL 1
+#define WATCH_DMA_DISPLAY_CHANNEL 2
+#define WATCH_DMA_UART_TX_CHANNEL 3
+#define WATCH_DMA_LED_RED_CHANNEL 4
+#define WATCH_DMA_LED_GREEN_CHANNEL 5
+#define WATCH_DMA_NUM_CHANNELS 6
+
+/// Each channel's first descriptor. The DMAC reads them from here, so fill one in before starting its channel.
+extern DmacDescriptor _watch_dma_descriptors[WATCH_DMA_NUM_CHANNELS];
+
+/// Turns the DMAC on for one more user; it stays on until each of them has called _watch_dma_disable.
+void _watch_dma_enable(void);
+void _watch_dma_disable(void);
+
+/** @brief Starts a channel on the descriptor in _watch_dma_descriptors.
+  * @param channel One of the channels above.
+  * @param trigger The peripheral's DMAC_ID that moves the transfer along.
+  * @param trigger_action DMAC_CHCTRLB_TRIGACT_BEAT or DMAC_CHCTRLB_TRIGACT_BLOCK: how much each trigger moves.
+  * @param level The channel's priority, from 0 to 3.
+  * @param interrupts The DMAC_CHINTENSET bits the channel's handler wants.
+  * @param standby true to keep the channel going in STANDBY mode.
+  */
+void _watch_dma_start(uint8_t channel, uint8_t trigger, uint32_t trigger_action, uint8_t level, uint8_t interrupts,
+                      bool standby);
+void _watch_dma_stop(uint8_t channel);
+
+// called from the DMAC interrupt with the channel's interrupt flags, which have already been cleared.
+void _watch_spi_dma_handler(uint8_t channel, uint8_t flags);
+void _watch_slcd_dma_handler(uint8_t channel, uint8_t flags);
+void _watch_uart_dma_handler(uint8_t channel, uint8_t flags);
+void _watch_led_dma_handler(uint8_t channel, uint8_t flags);
+
+#endif
@@ -0,0 +1,197 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+
+#include "watch_profiler.h"
+
+#ifdef MOVEMENT_PROFILER
+
+// how far along the table a sample looks for its address, or a free slot, before giving up on it.
+#define PROFILER_PROBES (8)
+#define PROFILER_LINE_SIZE (24)
+#define PROFILER_PRINT_TIMEOUT_MS (2000)
+
+typedef struct {
+    uint32_t pc;        // 0 for a free slot; the vector table is at 0, so no code is
+    uint32_t count;
+} profiler_slot_t;
+
+static profiler_slot_t _slots[WATCH_PROFILER_SLOTS];
+static volatile uint32_t _samples;
+static volatile uint32_t _dropped;
+static uint32_t _period = WATCH_PROFILER_DEFAULT_PERIOD;
+static volatile bool _running;
+
+// cycles counted in whole SysTick periods, which watch_get_cycle_counter adds the current period's count to. Outside
+// of sampling SysTick counts down from 2^24 - 1, so this only needs to change when sampling starts or stops.
+static volatile uint32_t _cycles;
+
+// the MTB needs its buffer aligned to its size, so that it can wrap by masking the write pointer.
+static uint32_t _trace_buffer[WATCH_PROFILER_TRACE_SIZE / 4] __attribute__((aligned(WATCH_PROFILER_TRACE_SIZE)));
+
+static void __attribute__((used)) _watch_profiler_sample(uint32_t pc) {
+    // the period that just ended, which might have been a delay's rather than ours.
+    _cycles += SysTick->LOAD + 1;
+    SysTick->LOAD = _period;
+    _samples++;
+
+    uint32_t slot = ((pc >> 1) * 2654435761u) >> 16;
+    for (uint8_t i = 0; i < PROFILER_PROBES; i++, slot++) {
+        profiler_slot_t *entry = &_slots[slot & (WATCH_PROFILER_SLOTS - 1)];
+        if (entry->pc == pc) {
+            entry->count++;
+            return;
+        }
+        if (entry->pc == 0) {
+            entry->pc = pc;
+            entry->count = 1;
+            return;
+        }
+    }
+    _dropped++;
+}
+
+// naked, so that the stack pointer still points at the exception frame, whose seventh word is the interrupted PC.
+// Movement only ever runs on the main stack.
+void SysTick_Handler(void) __attribute__((naked));
+void SysTick_Handler(void) {
+    __asm volatile (
+        "mrs r0, msp\n"
+        "ldr r0, [r0, #24]\n"
+        "ldr r1, =_watch_profiler_sample\n"
+        "bx r1\n"
+        ".ltorg\n"
+    );
+}
+
+// folds the current period's count into _cycles and restarts SysTick from the top of the given reload value.
+static void _watch_profiler_set_reload(uint32_t reload) {
+    _cycles += SysTick->LOAD - SysTick->VAL;
+    SysTick->LOAD = reload;
+    SysTick->VAL = 0;
+}
+
+void watch_profiler_start(uint32_t period) {
+    if (period < 256) period = 256;
+    if (period > SysTick_LOAD_RELOAD_Msk) period = SysTick_LOAD_RELOAD_Msk;
+
+    __disable_irq();
+    _period = period - 1;
+    _watch_profiler_set_reload(_period);
+    _running = true;
+    SysTick->CTRL |= SysTick_CTRL_TICKINT_Msk;
+    __enable_irq();
+}
+
+void watch_profiler_stop(void) {
+    __disable_irq();
+    SysTick->CTRL &= ~SysTick_CTRL_TICKINT_Msk;
+    SCB->ICSR = SCB_ICSR_PENDSTCLR_Msk;
+    _running = false;
+    _watch_profiler_set_reload(SysTick_LOAD_RELOAD_Msk);
+    __enable_irq();
+}
+
+void watch_profiler_clear(void) {
+    __disable_irq();
+    for (uint16_t i = 0; i < WATCH_PROFILER_SLOTS; i++) _slots[i].pc = 0;
+    _samples = 0;
+    _dropped = 0;
+    __enable_irq();
+}
+
+bool watch_profiler_is_running(void) {
+    return _running;
+}
+
+uint32_t _watch_profiler_cycle_counter(void) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    uint32_t count = _cycles + SysTick->LOAD - SysTick->VAL;
+    // a wrap the interrupt hasn't got to yet, because interrupts were already masked; read the count again, since
+    // it may have wrapped after we read it, and add the period that ended as the interrupt will.
+    if (_running && (SCB->ICSR & SCB_ICSR_PENDSTSET_Msk)) count = _cycles + 2 * SysTick->LOAD + 1 - SysTick->VAL;
+    __set_PRIMASK(primask);
+    return count & WATCH_CYCLE_COUNTER_MASK;
+}
+
+// there can be more here than the USB serial buffer holds, so go at the pace the host reads.
+static void _watch_profiler_print_line(const char *line) {
+    for (uint16_t waited = 0; cdc_get_write_buffer_space() < PROFILER_LINE_SIZE && waited < PROFILER_PRINT_TIMEOUT_MS; waited++) {
+        delay_ms(1);
+    }
+    printf("%s", line);
+}
+
+void watch_profiler_print(void) {
+    char line[PROFILER_LINE_SIZE + 24];
+
+    sprintf(line, "# samples %lu dropped %lu period %lu\r\n", (unsigned long)_samples, (unsigned long)_dropped, (unsigned long)_period + 1);
+    _watch_profiler_print_line(line);
+    for (uint16_t i = 0; i < WATCH_PROFILER_SLOTS; i++) {
+        __disable_irq();
+        profiler_slot_t slot = _slots[i];
+        __enable_irq();
+        if (slot.pc == 0) continue;
+        sprintf(line, "0x%08lx %lu\r\n", (unsigned long)slot.pc, (unsigned long)slot.count);
+        _watch_profiler_print_line(line);
+    }
+}
+
+void watch_profiler_trace_begin(void) {
+    uint32_t offset = (uint32_t)_trace_buffer - MTB->BASE.reg;
+    MTB->MASTER.reg = 0;
+    MTB->FLOW.reg = 0;
+    MTB->POSITION.reg = offset & MTB_POSITION_POINTER_Msk;
+    MTB->MASTER.reg = MTB_MASTER_EN | MTB_MASTER_MASK(__builtin_ctz(WATCH_PROFILER_TRACE_SIZE) - 4);
+}
+
+void watch_profiler_trace_end(void) {
+    MTB->MASTER.reg &= ~MTB_MASTER_EN;
+}
+
+void watch_profiler_trace_print(void) {
+    char line[PROFILER_LINE_SIZE + 24];
+    uint32_t position = MTB->POSITION.reg;
+    uint32_t offset = (uint32_t)_trace_buffer - MTB->BASE.reg;
+    // the packet the MTB would write next, which is the oldest one once the buffer has wrapped.
+    uint16_t next = (((position & MTB_POSITION_POINTER_Msk) - offset) & (WATCH_PROFILER_TRACE_SIZE - 1)) / 4;
+    uint16_t first = (position & MTB_POSITION_WRAP) ? next : 0;
+    uint16_t count = (position & MTB_POSITION_WRAP) ? WATCH_PROFILER_TRACE_SIZE / 8 : next / 2;
+
+    sprintf(line, "# branches %u\r\n", count);
+    _watch_profiler_print_line(line);
+    for (uint16_t i = 0; i < count; i++) {
+        uint16_t index = (first + i * 2) % (WATCH_PROFILER_TRACE_SIZE / 4);
+        uint32_t source = _trace_buffer[index];
+        uint32_t destination = _trace_buffer[index + 1];
+        // bit 0 of the source is the MTB's A bit, set for exception entries and returns.
+        sprintf(line, "0x%08lx 0x%08lx%s\r\n", (unsigned long)(source & ~1ul), (unsigned long)(destination & ~1ul),
+                (source & 1) ? " x" : "");
+        _watch_profiler_print_line(line);
+    }
+}
+
+#endif
@@ -0,0 +1,72 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "watch_regulator.h"
+#include "hpl_init.h"
+
+static uint16_t _vcc;
+
+static void _watch_set_regulator(watch_regulator_t regulator) {
+    if (SUPC->VREG.bit.SEL == regulator) return;
+    SUPC->VREG.bit.SEL = regulator;
+    while (!SUPC->STATUS.bit.VREGRDY);
+}
+
+watch_regulator_t watch_get_regulator(void) {
+    return SUPC->VREG.bit.SEL ? WATCH_REGULATOR_BUCK : WATCH_REGULATOR_LDO;
+}
+
+uint8_t watch_get_performance_level_number(void) {
+    return PM->PLCFG.bit.PLSEL;
+}
+
+uint16_t watch_get_regulator_vcc(void) {
+    return _vcc;
+}
+
+void _watch_regulator_note_vcc(uint16_t millivolts) {
+    bool was_low = _vcc < WATCH_REGULATOR_BUCK_MIN_VCC;
+    _vcc = millivolts;
+    // only the buck cares about the battery, and only when the reading crosses its threshold.
+    if (was_low != (millivolts < WATCH_REGULATOR_BUCK_MIN_VCC)) watch_update_power_policy();
+}
+
+void _watch_update_power_policy(bool standby) {
+    _watch_clocks_set_standby(standby);
+
+    // USB clocks the DFLL at 48 MHz and the fast clock runs OSC16M at 16, and both of those need PL2. anything else
+    // fits in PL0. raise the level before anything speeds up; drop it only once everything has slowed back down.
+    bool needs_pl2 = hri_usbdevice_get_CTRLA_ENABLE_bit(USB) ||
+                     hri_oscctrl_read_OSC16MCTRL_FSEL_bf(OSCCTRL) != OSCCTRL_OSC16MCTRL_FSEL_4_Val;
+    _set_performance_level(needs_pl2 ? 2 : 0);
+
+    // the buck pays off when there's a real load on it: the CPU, or the TCC driving the LED or buzzer in standby.
+    bool loaded = !standby || watch_is_buzzer_or_led_enabled();
+    bool buck = loaded && _vcc >= WATCH_REGULATOR_BUCK_MIN_VCC && !hri_usbdevice_get_CTRLA_ENABLE_bit(USB);
+    _watch_set_regulator(buck ? WATCH_REGULATOR_BUCK : WATCH_REGULATOR_LDO);
+}
+
+void watch_update_power_policy(void) {
+    _watch_update_power_policy(false);
+}
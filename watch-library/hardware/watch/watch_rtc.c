@@ -23,6 +23,9 @@
  */
 
 #include "watch_rtc.h"
+#include "watch.h"
+#include "watch_utility.h"
+#include "tusb.h"
 
 ext_irq_cb_t tick_callbacks[8];
 ext_irq_cb_t alarm_callback;
@@ -30,6 +33,15 @@ ext_irq_cb_t btn_alarm_callback;
 ext_irq_cb_t a2_callback;
 ext_irq_cb_t a4_callback;
 
+// interrupt sources that were serviced alongside another in the same RTC_Handler call, i.e. wakes we didn't take.
+static volatile uint32_t coalesced_interrupt_count;
+
+// software timers, soonest deadline first. ALARM0 is always set for the earliest of their latest moments, which is the
+// head's unless a timer behind it has less slack.
+static watch_rtc_timer_t *timers;
+static watch_date_time armed_deadline;
+static volatile bool timers_overdue;
+
 bool _watch_rtc_is_enabled(void) {
     return RTC->MODE2.CTRLA.bit.ENABLE;
 }
@@ -56,10 +68,20 @@ void _watch_rtc_init(void) {
     _sync_rtc();
 }
 
+static void _watch_rtc_arm_timers(void);
+
 void watch_rtc_set_date_time(watch_date_time date_time) {
     _sync_rtc(); // Double sync as without it at high Hz faces setting time is unrealiable (specifically, set_time_hackwatch)
     RTC->MODE2.CLOCK.reg = date_time.reg;
     _sync_rtc();
+
+    // moving the clock forward can leave timers overdue; they should fire now, not when the alarm next matches.
+    if (timers != NULL) {
+        uint32_t primask = __get_PRIMASK();
+        __disable_irq();
+        _watch_rtc_arm_timers();
+        __set_PRIMASK(primask);
+    }
 }
 
 watch_date_time watch_rtc_get_date_time(void) {
@@ -103,6 +125,26 @@ void watch_rtc_disable_periodic_callback(uint8_t frequency) {
     RTC->MODE2.INTENCLR.reg = 1 << per_n;
 }
 
+void watch_rtc_idle_until_periodic_tick(uint8_t frequency) {
+    if (__builtin_popcount(frequency) != 1) return;
+    uint8_t per_n = __builtin_clz((frequency & 0xFF) << 24);
+    bool was_enabled = RTC->MODE2.INTENSET.reg & (1 << per_n);
+
+    // mask interrupts so that the tick can't land between enabling it and going to sleep; a pending interrupt still
+    // wakes the core, and RTC_Handler runs (and clears the flag) as soon as we unmask.
+    __disable_irq();
+    if (!was_enabled) {
+        // the flag sets whether or not its interrupt is enabled, so clear it to wait for the next tick, not the last.
+        RTC->MODE2.INTFLAG.reg = 1 << per_n;
+        RTC->MODE2.INTENSET.reg = 1 << per_n;
+        NVIC_EnableIRQ(RTC_IRQn);
+    }
+    // IDLE keeps peripheral clocks running, so an SPI or I2C transfer in progress is unaffected.
+    sleep(2);
+    if (!was_enabled) RTC->MODE2.INTENCLR.reg = 1 << per_n;
+    __enable_irq();
+}
+
 void watch_rtc_disable_matching_periodic_callbacks(uint8_t mask) {
     RTC->MODE2.INTENCLR.reg = mask;
 }
@@ -125,41 +167,166 @@ void watch_rtc_disable_alarm_callback(void) {
     RTC->MODE2.INTENCLR.reg = RTC_MODE2_INTENCLR_ALARM0;
 }
 
-void RTC_Handler(void) {
-    uint16_t interrupt_status = RTC->MODE2.INTFLAG.reg;
-    uint16_t interrupt_enabled = RTC->MODE2.INTENSET.reg;
+// must be called with interrupts masked.
+static void _watch_rtc_arm_timers(void) {
+    if (timers == NULL) {
+        RTC->MODE2.INTENCLR.reg = RTC_MODE2_INTENCLR_ALARM0;
+        return;
+    }
 
-    if ((interrupt_status & interrupt_enabled) & RTC_MODE2_INTFLAG_PER_Msk) {
-        // handle the tick callback first, it's what we do the most.
-        // start from PER7, the 1 Hz tick.
-        for(int8_t i = 7; i >= 0; i--) {
-            if ((interrupt_status & interrupt_enabled) & (1 << i)) {
-                if (tick_callbacks[i] != NULL) {
-                    tick_callbacks[i]();
-                }
-                RTC->MODE2.INTFLAG.reg = 1 << i;
-//                break; Uncertain if this fix is requried. We were discussing in discord. Might slightly increase power consumption. 
-            }
+    watch_rtc_timer_t *soonest = timers;
+    for (watch_rtc_timer_t *timer = timers->next; timer != NULL; timer = timer->next) {
+        if (timer->latest.reg < soonest->latest.reg) soonest = timer;
+    }
+
+    // the alarm fires on the tick after the match, so match one second before the deadline. only the time of day is
+    // matched; a deadline more than a day out gets an early alarm that finds nothing due and arms the next one.
+    watch_date_time match = soonest->latest;
+    if (match.unit.second) {
+        match.unit.second--;
+    } else {
+        match.unit.second = 59;
+        if (match.unit.minute) {
+            match.unit.minute--;
+        } else {
+            match.unit.minute = 59;
+            match.unit.hour = match.unit.hour ? match.unit.hour - 1 : 23;
         }
-    } else if ((interrupt_status & interrupt_enabled) & RTC_MODE2_INTFLAG_TAMPER) {
-        // handle the extwake interrupts next.
-        uint8_t reason = RTC->MODE2.TAMPID.reg;
-        if (reason & RTC_TAMPID_TAMPID2) {
-            if (btn_alarm_callback != NULL) btn_alarm_callback();
-        } else if (reason & RTC_TAMPID_TAMPID1) {
-            if (a2_callback != NULL) a2_callback();
-        } else if (reason & RTC_TAMPID_TAMPID0) {
-            if (a4_callback != NULL) a4_callback();
+    }
+
+    armed_deadline = soonest->latest;
+    alarm_callback = NULL;
+    RTC->MODE2.Mode2Alarm[0].ALARM.reg = match.reg;
+    RTC->MODE2.Mode2Alarm[0].MASK.reg = ALARM_MATCH_HHMMSS;
+    RTC->MODE2.INTFLAG.reg = RTC_MODE2_INTFLAG_ALARM0;
+    RTC->MODE2.INTENSET.reg = RTC_MODE2_INTENSET_ALARM0;
+    NVIC_EnableIRQ(RTC_IRQn);
+
+    // a deadline that's already here won't see its match come around until tomorrow, so take the interrupt now.
+    if (watch_rtc_get_date_time().reg >= armed_deadline.reg) {
+        timers_overdue = true;
+        NVIC_SetPendingIRQ(RTC_IRQn);
+    }
+}
+
+static void _watch_rtc_unlink_timer(watch_rtc_timer_t *timer) {
+    for (watch_rtc_timer_t **link = &timers; *link != NULL; link = &(*link)->next) {
+        if (*link == timer) {
+            *link = timer->next;
+            timer->next = NULL;
+            return;
         }
+    }
+}
+
+void watch_rtc_schedule_timer(watch_rtc_timer_t *timer, watch_date_time deadline, ext_irq_cb_t callback) {
+    watch_rtc_schedule_timer_with_slack(timer, deadline, 0, callback);
+}
+
+void watch_rtc_schedule_timer_with_slack(watch_rtc_timer_t *timer, watch_date_time deadline, uint16_t slack, ext_irq_cb_t callback) {
+    watch_date_time latest = deadline;
+    if (slack) latest = watch_utility_date_time_from_unix_time(watch_utility_date_time_to_unix_time(deadline, 0) + slack, 0);
+
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    _watch_rtc_unlink_timer(timer);
+    timer->deadline = deadline;
+    timer->latest = latest;
+    timer->callback = callback;
+
+    // the packed fields run from year down to second, so the registers sort the same way the dates do.
+    watch_rtc_timer_t **link = &timers;
+    while (*link != NULL && (*link)->deadline.reg <= deadline.reg) link = &(*link)->next;
+    timer->next = *link;
+    *link = timer;
+
+    // the alarm might be for this timer's latest moment, or for one it has just come in front of.
+    _watch_rtc_arm_timers();
+    __set_PRIMASK(primask);
+}
+
+void watch_rtc_cancel_timer(watch_rtc_timer_t *timer) {
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+
+    _watch_rtc_unlink_timer(timer);
+    _watch_rtc_arm_timers();
+    __set_PRIMASK(primask);
+}
+
+static void _watch_rtc_fire_timers(bool alarm_fired) {
+    watch_date_time now = watch_rtc_get_date_time();
+    // the alarm only fires once its deadline has come, even if the clock reads a shade behind it. but it only matches
+    // the time of day, so a deadline still days away gets its match early; then nothing is due, and we just re-arm.
+    if (alarm_fired && armed_deadline.reg > now.reg) {
+        uint32_t now_timestamp = watch_utility_date_time_to_unix_time(now, 0);
+        if (watch_utility_date_time_to_unix_time(armed_deadline, 0) - now_timestamp <= 2) now = armed_deadline;
+    }
+
+    // each timer leaves the list before its callback, which is then free to schedule it again. the ones that could
+    // still have waited are wakes saved.
+    while (timers != NULL && timers->deadline.reg <= now.reg) {
+        watch_rtc_timer_t *timer = timers;
+        timers = timer->next;
+        timer->next = NULL;
+        if (timer->latest.reg > now.reg) coalesced_interrupt_count++;
+        if (timer->callback != NULL) timer->callback();
+    }
+    _watch_rtc_arm_timers();
+}
+
+uint32_t watch_rtc_get_coalesced_interrupt_count(void) {
+    return coalesced_interrupt_count;
+}
+
+WATCH_RAMFUNC void RTC_Handler(void) {
+    uint16_t pending = RTC->MODE2.INTFLAG.reg & RTC->MODE2.INTENSET.reg;
+    uint8_t sources = 0;
+
+    // every source that is pending gets serviced in this pass, most urgent first: the buttons and extwake pins, then
+    // the alarm that drives background tasks, then the periodic ticks. each flag is cleared before its callback, so
+    // that a source that fires again while we're busy gets its own interrupt rather than being lost.
+    if (pending & RTC_MODE2_INTFLAG_TAMPER) {
+        uint8_t reason = RTC->MODE2.TAMPID.reg;
         RTC->MODE2.TAMPID.reg = reason;
         RTC->MODE2.INTFLAG.reg = RTC_MODE2_INTFLAG_TAMPER;
-    } else if ((interrupt_status & interrupt_enabled) & RTC_MODE2_INTFLAG_ALARM0) {
-        // finally handle the alarm.
+        if ((reason & RTC_TAMPID_TAMPID2) && btn_alarm_callback != NULL) btn_alarm_callback();
+        if ((reason & RTC_TAMPID_TAMPID1) && a2_callback != NULL) a2_callback();
+        if ((reason & RTC_TAMPID_TAMPID0) && a4_callback != NULL) a4_callback();
+        sources++;
+    }
+
+    if (pending & RTC_MODE2_INTFLAG_ALARM0) {
+        RTC->MODE2.INTFLAG.reg = RTC_MODE2_INTFLAG_ALARM0;
         if (alarm_callback != NULL) {
             alarm_callback();
+        } else {
+            timers_overdue = false;
+            _watch_rtc_fire_timers(true);
+        }
+        sources++;
+    } else if (timers_overdue) {
+        timers_overdue = false;
+        _watch_rtc_fire_timers(false);
+    } else if (timers != NULL && (pending & (RTC_MODE2_INTFLAG_TAMPER | RTC_MODE2_INTFLAG_PER7)) &&
+               timers->deadline.reg <= watch_rtc_get_date_time().reg) {
+        // a timer with slack whose deadline has come goes along with a wake that's happening anyway.
+        _watch_rtc_fire_timers(false);
+    }
+
+    if (pending & RTC_MODE2_INTFLAG_PER_Msk) {
+        // start from PER7, the 1 Hz tick.
+        RTC->MODE2.INTFLAG.reg = pending & RTC_MODE2_INTFLAG_PER_Msk;
+        for(int8_t i = 7; i >= 0; i--) {
+            if ((pending & (1 << i)) && tick_callbacks[i] != NULL) {
+                tick_callbacks[i]();
+                sources++;
+            }
         }
-        RTC->MODE2.INTFLAG.reg = RTC_MODE2_INTFLAG_ALARM0;
     }
+
+    if (sources > 1) coalesced_interrupt_count += sources - 1;
 }
 
 void watch_rtc_enable(bool en)
@@ -185,3 +352,62 @@ void watch_rtc_freqcorr_write(int16_t value, int16_t sign)
     // We do not sycnronize. We are not in a hurry
 }
 
+// the crystal is the frequency meter's reference, divided down on a generator of its own so that the 255 cycles it
+// counts over last long enough to resolve a fraction of a ppm; GCLK1 is the 48 MHz clock USB runs on.
+#define WATCH_RTC_MEASUREMENT_GCLK 4
+#define WATCH_RTC_MEASUREMENT_DIV 32
+#define WATCH_RTC_MEASUREMENT_REFNUM 255
+// the 48 MHz cycles in that window when the crystal is exactly 32768 Hz.
+#define WATCH_RTC_MEASUREMENT_NOMINAL (48000000ULL * WATCH_RTC_MEASUREMENT_REFNUM * WATCH_RTC_MEASUREMENT_DIV / 32768)
+
+bool watch_rtc_start_crystal_measurement(void) {
+#ifdef CRYSTALLESS
+    return false;
+#else
+    if (!watch_is_usb_enabled() || !tud_mounted() || tud_suspended()) return false;
+
+    if (!hri_mclk_get_APBAMASK_FREQM_bit(MCLK)) {
+        GCLK->GENCTRL[WATCH_RTC_MEASUREMENT_GCLK].reg = GCLK_GENCTRL_SRC(GCLK_GENCTRL_SRC_XOSC32K) |
+                                                        GCLK_GENCTRL_DIV(WATCH_RTC_MEASUREMENT_DIV) |
+                                                        GCLK_GENCTRL_GENEN;
+        while (GCLK->SYNCBUSY.reg & GCLK_SYNCBUSY_GENCTRL_GCLK4);
+        hri_gclk_write_PCHCTRL_reg(GCLK, FREQM_GCLK_ID_REF, GCLK_PCHCTRL_GEN_GCLK4_Val | GCLK_PCHCTRL_CHEN);
+        hri_gclk_write_PCHCTRL_reg(GCLK, FREQM_GCLK_ID_MSR, GCLK_PCHCTRL_GEN_GCLK1_Val | GCLK_PCHCTRL_CHEN);
+        hri_mclk_set_APBAMASK_FREQM_bit(MCLK);
+        FREQM->CFGA.reg = FREQM_CFGA_REFNUM(WATCH_RTC_MEASUREMENT_REFNUM);
+        FREQM->CTRLA.reg = FREQM_CTRLA_ENABLE;
+        while (FREQM->SYNCBUSY.reg);
+    }
+    if (FREQM->STATUS.reg & FREQM_STATUS_BUSY) return true;
+
+    // the overflow flag is sticky, so clear it along with the last measurement's.
+    FREQM->STATUS.reg = FREQM_STATUS_OVF;
+    FREQM->INTFLAG.reg = FREQM_INTFLAG_DONE;
+    FREQM->CTRLB.reg = FREQM_CTRLB_START;
+    return true;
+#endif
+}
+
+bool watch_rtc_read_crystal_measurement(int32_t *ppb) {
+    if (!hri_mclk_get_APBAMASK_FREQM_bit(MCLK)) return false;
+    if (!(FREQM->INTFLAG.reg & FREQM_INTFLAG_DONE)) return false;
+    FREQM->INTFLAG.reg = FREQM_INTFLAG_DONE;
+    uint32_t value = FREQM->VALUE.reg & FREQM_VALUE_VALUE_Msk;
+    if ((FREQM->STATUS.reg & FREQM_STATUS_OVF) || value == 0) return false;
+
+    // a fast crystal makes the window short, so the meter counts fewer cycles in it.
+    *ppb = (int32_t)(((int64_t)WATCH_RTC_MEASUREMENT_NOMINAL - (int64_t)value) * 1000000000LL / value);
+    return true;
+}
+
+void watch_rtc_stop_crystal_measurements(void) {
+    if (!hri_mclk_get_APBAMASK_FREQM_bit(MCLK)) return;
+    FREQM->CTRLA.reg = 0;
+    while (FREQM->SYNCBUSY.reg);
+    hri_mclk_clear_APBAMASK_FREQM_bit(MCLK);
+    hri_gclk_write_PCHCTRL_reg(GCLK, FREQM_GCLK_ID_REF, 0);
+    hri_gclk_write_PCHCTRL_reg(GCLK, FREQM_GCLK_ID_MSR, 0);
+    GCLK->GENCTRL[WATCH_RTC_MEASUREMENT_GCLK].reg = 0;
+    while (GCLK->SYNCBUSY.reg & GCLK_SYNCBUSY_GENCTRL_GCLK4);
+}
+
@@ -22,45 +22,192 @@
  * SOFTWARE.
  */
 
+#include <string.h>
 #include "watch_slcd.h"
 #include "watch_private_display.h"
 #include "hpl_slcd_config.h"
+#include "watch_private_dma.h"
 
  //////////////////////////////////////////////////////////////////////////////////////////
 // Segmented Display
 
+uint32_t watch_display_framebuffer[WATCH_DISPLAY_NUM_COMS];
+// the segments watch_start_segment_blink is blinking, and whether they're in the hidden half of the blink.
+static uint32_t blink_segments[WATCH_DISPLAY_NUM_COMS];
+static volatile bool blink_hidden;
+// the animation watch_start_display_animation is playing, if frames isn't NULL. the interrupt only touches this, never
+// the framebuffer, so that it can't undo a change the app is halfway through making.
+static struct {
+    const watch_display_frame_t *frames;
+    uint32_t mask[WATCH_DISPLAY_NUM_COMS];
+    uint32_t shown[WATCH_DISPLAY_NUM_COMS];
+    uint8_t num_frames;
+    uint8_t frame;
+    uint8_t loops_left;
+    ext_irq_cb_t callback;
+} animation;
+// frames watch_start_display_playback is playing: the DMAC has the display to itself while running is set, and the
+// first frame's descriptor lives in _watch_dma_descriptors with the rest chained on from here.
+static DmacDescriptor playback_descriptors[WATCH_DISPLAY_PLAYBACK_MAX_FRAMES - 1] __attribute__((aligned(16)));
+static struct {
+    ext_irq_cb_t callback;
+    volatile bool running;
+} playback;
+// set while watch_display_set_held keeps drawing from reaching the glass.
+static bool display_held;
+// how the SLCD drives the glass (@see watch_display_set_drive), and how long a frame lasts at its frame rate.
+static watch_display_drive_t drive = { CONF_SLCD_CONTRAST_ADJUST, CONF_SLCD_BBEN ? CONF_SLCD_BBD : 0, CONF_SLCD_CKDIV + 1 };
+static uint32_t frame_ms = 1000 / SLCD_FRAME_FREQUENCY;
+// the periods the frame counters were last set to. they count frames, so a new frame rate needs new values.
+static uint32_t frame_counter_durations[3];
+
 static void _sync_slcd(void) {
     while (SLCD->SYNCBUSY.reg);
 }
 
+// what a line of the display should show: the framebuffer, with the animation's frame over it and blinking segments
+// hidden in their off half.
+static inline uint32_t _watch_display_line(uint8_t com, uint32_t hide) {
+    uint32_t line = (watch_display_framebuffer[com] & ~animation.mask[com]) | animation.shown[com];
+    return line & ~(blink_segments[com] & hide);
+}
+
+static WATCH_RAMFUNC void _watch_display_write(void) {
+    if (playback.running || display_held) return;
+    uint32_t hide = blink_hidden ? ~0 : 0;
+    uint32_t line;
+    // only write the lines that actually changed.
+    line = _watch_display_line(0, hide);
+    if (SLCD->SDATAL0.reg != line) SLCD->SDATAL0.reg = line;
+    line = _watch_display_line(1, hide);
+    if (SLCD->SDATAL1.reg != line) SLCD->SDATAL1.reg = line;
+    line = _watch_display_line(2, hide);
+    if (SLCD->SDATAL2.reg != line) SLCD->SDATAL2.reg = line;
+}
+
+static uint8_t _watch_display_frame_counter_value(uint32_t duration) {
+    uint32_t frames = duration / frame_ms;
+    if (frames == 0) frames = 1;
+    // up to 32 frames count one by one; past that, the prescaler counts them in eights.
+    if (frames <= 0x1F + 1) return SLCD_FC0_PB | (frames - 1);
+    if (frames / 8 > 0x1F + 1) return 0x1F;
+    return frames / 8 - 1;
+}
+
+// the caller turns the counter off first, and back on after.
+static void _watch_display_set_frame_counter_period(uint8_t counter, uint32_t duration) {
+    frame_counter_durations[counter] = duration;
+    uint8_t value = _watch_display_frame_counter_value(duration);
+    switch (counter) {
+        case 0: SLCD->FC0.reg = value; break;
+        case 1: SLCD->FC1.reg = value; break;
+        case 2: SLCD->FC2.reg = value; break;
+    }
+}
+
+// CTRLA and CTRLB only take these while the SLCD is off.
+static void _watch_display_write_drive(void) {
+    SLCD->CTRLA.bit.CKDIV = drive.frame_divider - 1;
+    SLCD->CTRLB.reg = drive.bias_buffer ? (SLCD_CTRLB_BBEN | SLCD_CTRLB_BBD(drive.bias_buffer - 1)) : 0;
+    SLCD->CTRLC.bit.CTST = drive.contrast;
+    frame_ms = 1000 / (CONF_GCLK_SLCD_FREQUENCY / ((CONF_SLCD_PRESC + 1) * 16 * drive.frame_divider * (CONF_SLCD_COM_NUM + 1)));
+}
+
 void watch_enable_display(void) {
     SEGMENT_LCD_0_init();
+    // the display memory update trigger, which watch_start_display_playback hangs the DMAC off, follows FC1. CTRLA
+    // only takes this while the SLCD is off.
+    hri_slcd_write_CTRLA_DMFCS_bf(SLCD, SLCD_CTRLA_DMFCS_FC1_Val);
+    // initializing the SLCD put the build's settings back, and reset the frame counters.
+    _watch_display_write_drive();
+    memset(frame_counter_durations, 0, sizeof(frame_counter_durations));
     slcd_sync_enable(&SEGMENT_LCD_0);
+    // initializing the SLCD resets its segment data, so the shadow copy starts out blank too.
+    memset(watch_display_framebuffer, 0, sizeof(watch_display_framebuffer));
+    memset(blink_segments, 0, sizeof(blink_segments));
+    blink_hidden = false;
+    memset(&animation, 0, sizeof(animation));
+    playback.running = false;
 }
 
 inline void watch_set_pixel(uint8_t com, uint8_t seg) {
+    watch_display_framebuffer[com] |= (uint32_t)1 << seg;
+    // a blinking segment that's hidden for now shows up when the blink comes back around, and an animation's
+    // segments show its frame until it stops.
+    if (blink_hidden && (blink_segments[com] & ((uint32_t)1 << seg))) return;
+    if (animation.mask[com] & ((uint32_t)1 << seg)) return;
+    if (playback.running || display_held) return;
     slcd_sync_seg_on(&SEGMENT_LCD_0, SLCD_SEGID(com, seg));
 }
 
 inline void watch_clear_pixel(uint8_t com, uint8_t seg) {
+    watch_display_framebuffer[com] &= ~((uint32_t)1 << seg);
+    if (animation.mask[com] & ((uint32_t)1 << seg)) return;
+    if (playback.running || display_held) return;
     slcd_sync_seg_off(&SEGMENT_LCD_0, SLCD_SEGID(com, seg));
 }
 
 void watch_clear_display(void) {
-    SLCD->SDATAL0.reg = 0;
-    SLCD->SDATAL1.reg = 0;
-    SLCD->SDATAL2.reg = 0;
+    memset(watch_display_framebuffer, 0, sizeof(watch_display_framebuffer));
+    watch_display_commit();
+}
+
+void watch_display_commit(void) {
+    watch_power_trace_region_t trace = watch_power_trace_set(WATCH_POWER_TRACE_DISPLAY);
+    // the blink interrupt writes the display too, and mustn't land between reading a line and writing it.
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    _watch_display_write();
+    __set_PRIMASK(primask);
+    watch_power_trace_set(trace);
+}
+
+void watch_display_set_held(bool held) {
+    display_held = held;
+}
+
+void watch_display_set_drive(watch_display_drive_t new_drive) {
+    if (new_drive.contrast > 15) new_drive.contrast = 15;
+    if (new_drive.bias_buffer > 16) new_drive.bias_buffer = 16;
+    if (new_drive.frame_divider < 1) new_drive.frame_divider = 1;
+    if (new_drive.frame_divider > 8) new_drive.frame_divider = 8;
+    if (new_drive.contrast == drive.contrast && new_drive.bias_buffer == drive.bias_buffer &&
+        new_drive.frame_divider == drive.frame_divider) return;
+
+    // the SLCD stays off if watch_display_set_off turned it off.
+    bool enabled = SLCD->CTRLA.bit.ENABLE;
+    SLCD->CTRLA.bit.ENABLE = 0;
+    _sync_slcd();
+    bool new_frame_rate = new_drive.frame_divider != drive.frame_divider;
+    drive = new_drive;
+    _watch_display_write_drive();
+    if (new_frame_rate) {
+        for (uint8_t counter = 0; counter < 3; counter++) {
+            if (frame_counter_durations[counter]) _watch_display_set_frame_counter_period(counter, frame_counter_durations[counter]);
+        }
+    }
+    if (enabled) {
+        SLCD->CTRLA.bit.ENABLE = 1;
+        _sync_slcd();
+    }
+}
+
+watch_display_drive_t watch_display_get_drive(void) {
+    return drive;
+}
+
+void watch_display_set_off(bool off) {
+    // the segment data registers keep their contents while the SLCD is disabled, and take writes as usual.
+    if (off) slcd_sync_disable(&SEGMENT_LCD_0);
+    else slcd_sync_enable(&SEGMENT_LCD_0);
+    _sync_slcd();
 }
 
 void watch_start_character_blink(char character, uint32_t duration) {
     SLCD->CTRLD.bit.FC0EN = 0;
     _sync_slcd();
 
-    if (duration <= SLCD_FC_BYPASS_MAX_MS) {
-        SLCD->FC0.reg = SLCD_FC0_PB | ((duration / (1000 / SLCD_FRAME_FREQUENCY)) - 1);
-    } else {
-        SLCD->FC0.reg = (((duration / (1000 / SLCD_FRAME_FREQUENCY)) / 8 - 1));
-    }
+    _watch_display_set_frame_counter_period(0, duration);
     SLCD->CTRLD.bit.FC0EN = 1;
 
     watch_display_character(character, 7);
@@ -84,10 +231,187 @@ void watch_stop_blink(void) {
     SLCD->CTRLD.bit.BLINK = 0;
 }
 
+void watch_start_segment_blink(const uint32_t segments[WATCH_DISPLAY_NUM_COMS], uint32_t duration) {
+    // FC0 belongs to watch_start_character_blink and FC1 to the tick animation, so the group blinks on FC2.
+    SLCD->INTENCLR.reg = SLCD_INTENCLR_FC2O;
+    SLCD->CTRLD.bit.FC2EN = 0;
+    _sync_slcd();
+
+    _watch_display_set_frame_counter_period(2, duration);
+
+    memcpy(blink_segments, segments, sizeof(blink_segments));
+    blink_hidden = false;
+    watch_display_commit();
+
+    SLCD->INTFLAG.reg = SLCD_INTFLAG_FC2O;
+    SLCD->INTENSET.reg = SLCD_INTENSET_FC2O;
+    NVIC_ClearPendingIRQ(SLCD_IRQn);
+    NVIC_EnableIRQ(SLCD_IRQn);
+    SLCD->CTRLD.bit.FC2EN = 1;
+    _sync_slcd();
+}
+
+void watch_stop_segment_blink(void) {
+    SLCD->INTENCLR.reg = SLCD_INTENCLR_FC2O;
+    SLCD->CTRLD.bit.FC2EN = 0;
+    _sync_slcd();
+    memset(blink_segments, 0, sizeof(blink_segments));
+    blink_hidden = false;
+    watch_display_commit();
+}
+
+static void _watch_display_show_frame(void) {
+    const watch_display_frame_t *frame = &animation.frames[animation.frame];
+    for (uint8_t com = 0; com < WATCH_DISPLAY_NUM_COMS; com++) {
+        animation.shown[com] = frame->segments[com] & animation.mask[com];
+    }
+}
+
+static void _watch_display_stop_animation(void) {
+    SLCD->INTENCLR.reg = SLCD_INTENCLR_FC1O;
+    SLCD->CTRLD.bit.FC1EN = 0;
+    _sync_slcd();
+    if (animation.frames == NULL) return;
+    // the frame it stopped on becomes part of the framebuffer, for the app to draw over as it likes.
+    uint32_t primask = __get_PRIMASK();
+    __disable_irq();
+    for (uint8_t com = 0; com < WATCH_DISPLAY_NUM_COMS; com++) {
+        watch_display_framebuffer[com] = (watch_display_framebuffer[com] & ~animation.mask[com]) | animation.shown[com];
+    }
+    __set_PRIMASK(primask);
+    memset(animation.mask, 0, sizeof(animation.mask));
+    memset(animation.shown, 0, sizeof(animation.shown));
+    animation.frames = NULL;
+}
+
+void watch_start_display_animation(const watch_display_frame_t *frames, uint8_t num_frames, const uint32_t mask[WATCH_DISPLAY_NUM_COMS],
+                                   uint32_t frame_duration, uint8_t loops, ext_irq_cb_t callback) {
+    // FC1 drives the tick animation's shift register too, and the two would fight over its period.
+    if (watch_tick_animation_is_running()) watch_stop_tick_animation();
+    _watch_display_stop_animation();
+    if (watch_display_playback_is_running()) watch_stop_display_playback();
+    if (frames == NULL || num_frames == 0) return;
+
+    _watch_display_set_frame_counter_period(1, frame_duration);
+
+    memcpy(animation.mask, mask, sizeof(animation.mask));
+    animation.num_frames = num_frames;
+    animation.frame = 0;
+    animation.loops_left = loops;
+    animation.callback = callback;
+    animation.frames = frames;
+    _watch_display_show_frame();
+    watch_display_commit();
+
+    SLCD->INTFLAG.reg = SLCD_INTFLAG_FC1O;
+    SLCD->INTENSET.reg = SLCD_INTENSET_FC1O;
+    NVIC_ClearPendingIRQ(SLCD_IRQn);
+    NVIC_EnableIRQ(SLCD_IRQn);
+    SLCD->CTRLD.bit.FC1EN = 1;
+    _sync_slcd();
+}
+
+bool watch_display_animation_is_running(void) {
+    return animation.frames != NULL;
+}
+
+void watch_stop_display_animation(void) {
+    _watch_display_stop_animation();
+}
+
+void SLCD_Handler(void) {
+    uint8_t flags = SLCD->INTFLAG.reg & SLCD->INTENSET.reg;
+    SLCD->INTFLAG.reg = flags;
+
+    if ((flags & SLCD_INTFLAG_FC1O) && animation.frames != NULL) {
+        if (++animation.frame < animation.num_frames) {
+            _watch_display_show_frame();
+        } else if (animation.loops_left != 1) {
+            // 0 loops forever; otherwise count this one off and go around again.
+            if (animation.loops_left) animation.loops_left--;
+            animation.frame = 0;
+            _watch_display_show_frame();
+        } else {
+            _watch_display_stop_animation();
+            if (animation.callback != NULL) animation.callback();
+        }
+    }
+    if (flags & SLCD_INTFLAG_FC2O) blink_hidden = !blink_hidden;
+    _watch_display_write();
+}
+
+static void _watch_display_stop_playback(void) {
+    _watch_dma_stop(WATCH_DMA_DISPLAY_CHANNEL);
+    SLCD->CTRLD.bit.FC1EN = 0;
+    _sync_slcd();
+    // whatever the DMAC copied in last is what's showing, so that's what the framebuffer holds from here on.
+    watch_display_framebuffer[0] = SLCD->SDATAL0.reg;
+    watch_display_framebuffer[1] = SLCD->SDATAL1.reg;
+    watch_display_framebuffer[2] = SLCD->SDATAL2.reg;
+    playback.running = false;
+    _watch_dma_disable();
+}
+
+void watch_start_display_playback(const watch_display_frame_t *frames, uint8_t num_frames, uint32_t frame_duration,
+                                  ext_irq_cb_t callback) {
+    if (watch_tick_animation_is_running()) watch_stop_tick_animation();
+    _watch_display_stop_animation();
+    if (watch_display_playback_is_running()) watch_stop_display_playback();
+    if (frames == NULL || num_frames == 0) return;
+    if (num_frames > WATCH_DISPLAY_PLAYBACK_MAX_FRAMES) num_frames = WATCH_DISPLAY_PLAYBACK_MAX_FRAMES;
+
+    // one block per frame, moved by one display memory update: three words, from the frame into SDATAL0, SDATAL1 and
+    // SDATAL2, which sit eight bytes apart. with address increment on, the DMAC wants the addresses just past the end.
+    for (uint8_t i = 0; i < num_frames; i++) {
+        DmacDescriptor *descriptor = i ? &playback_descriptors[i - 1] : &_watch_dma_descriptors[WATCH_DMA_DISPLAY_CHANNEL];
+        bool last = i == num_frames - 1;
+        descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_WORD | DMAC_BTCTRL_SRCINC | DMAC_BTCTRL_DSTINC |
+                                 DMAC_BTCTRL_STEPSEL_DST | DMAC_BTCTRL_STEPSIZE_X2 |
+                                 (last ? DMAC_BTCTRL_BLOCKACT_INT : DMAC_BTCTRL_BLOCKACT_NOACT);
+        descriptor->BTCNT.reg = WATCH_DISPLAY_NUM_COMS;
+        descriptor->SRCADDR.reg = (uint32_t)(frames[i].segments + WATCH_DISPLAY_NUM_COMS);
+        descriptor->DSTADDR.reg = (uint32_t)&SLCD->SDATAL0.reg + WATCH_DISPLAY_NUM_COMS * 8;
+        descriptor->DESCADDR.reg = last ? 0 : (uint32_t)&playback_descriptors[i];
+    }
+
+    _watch_display_set_frame_counter_period(1, frame_duration);
+    playback.callback = callback;
+    playback.running = true;
+    _watch_dma_enable();
+    _watch_dma_start(WATCH_DMA_DISPLAY_CHANNEL, SLCD_DMAC_ID_DMU, DMAC_CHCTRLB_TRIGACT_BLOCK, 0,
+                     DMAC_CHINTENSET_TCMPL | DMAC_CHINTENSET_TERR, true);
+    SLCD->CTRLD.bit.FC1EN = 1;
+    _sync_slcd();
+}
+
+bool watch_display_playback_is_running(void) {
+    return playback.running;
+}
+
+void watch_stop_display_playback(void) {
+    if (!playback.running) return;
+    _watch_display_stop_playback();
+}
+
+void _watch_slcd_dma_handler(uint8_t channel, uint8_t flags) {
+    (void) channel;
+    if (!playback.running) return;
+    _watch_display_stop_playback();
+    if ((flags & DMAC_CHINTFLAG_TCMPL) && playback.callback != NULL) playback.callback();
+}
+
 void watch_start_tick_animation(uint32_t duration) {
+    if (watch_display_animation_is_running()) watch_stop_display_animation();
+    if (watch_display_playback_is_running()) watch_stop_display_playback();
     watch_display_character(' ', 8);
     const uint32_t segs[] = { SLCD_SEGID(0, 2)};
     slcd_sync_start_animation(&SEGMENT_LCD_0, segs, 1, duration);
+    // the HAL counts the period in frames at the build's frame rate, which may not be the one we're at.
+    SLCD->CTRLD.bit.FC1EN = 0;
+    _sync_slcd();
+    _watch_display_set_frame_counter_period(1, duration);
+    SLCD->CTRLD.bit.FC1EN = 1;
+    _sync_slcd();
 }
 
 bool watch_tick_animation_is_running(void) {
@@ -23,32 +23,97 @@
  */
 
 #include "watch_spi.h"
+#include "watch_private_dma.h"
 
 struct io_descriptor *spi_io;
 
+// when a transfer only goes one way, the other channel moves bytes to or from one of these instead.
+static uint8_t _dma_dummy_tx = 0xFF;
+static uint8_t _dma_dummy_rx;
+
+static volatile bool _dma_busy;
+static volatile bool _dma_success;
+
 void watch_enable_spi(void) {
     SPI_0_init();
     spi_m_sync_get_io_descriptor(&SPI_0, &spi_io);
+    // BAUD 0 gives the fastest SPI clock the SERCOM can make: half of its 4-16 MHz core clock, well within what the
+    // flash chip supports.
+    hri_sercomspi_write_BAUD_reg(SERCOM3, 0);
     spi_m_sync_enable(&SPI_0);
+
+    _watch_dma_enable();
 }
 
 void watch_disable_spi(void) {
+    _watch_dma_disable();
     spi_m_sync_disable(&SPI_0);
     spi_io = NULL;
 }
 
+static void _watch_spi_dma_set_descriptor(uint8_t channel, uint32_t src, uint32_t dst, uint16_t btctrl, uint16_t length) {
+    DmacDescriptor *descriptor = &_watch_dma_descriptors[channel];
+    descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_BLOCKACT_NOACT | btctrl;
+    descriptor->BTCNT.reg = length;
+    descriptor->SRCADDR.reg = src;
+    descriptor->DSTADDR.reg = dst;
+    descriptor->DESCADDR.reg = 0;
+}
+
+bool watch_spi_transfer(const uint8_t *data_out, uint8_t *data_in, uint16_t length) {
+    if (spi_io == NULL || _dma_busy) return false;
+    if (length == 0) return true;
+
+    // anything left in the receive buffer would be the first byte the RX channel picks up.
+    while (hri_sercomspi_get_INTFLAG_reg(SERCOM3, SERCOM_SPI_INTFLAG_RXC)) (void)hri_sercomspi_read_DATA_reg(SERCOM3);
+    hri_sercomspi_clear_STATUS_reg(SERCOM3, SERCOM_SPI_STATUS_BUFOVF);
+
+    // with address increment on, the DMAC wants the address just past the end of the block.
+    uint32_t data = (uint32_t)&SERCOM3->SPI.DATA.reg;
+    if (data_in != NULL) {
+        _watch_spi_dma_set_descriptor(WATCH_DMA_SPI_RX_CHANNEL, data, (uint32_t)(data_in + length), DMAC_BTCTRL_DSTINC, length);
+    } else {
+        _watch_spi_dma_set_descriptor(WATCH_DMA_SPI_RX_CHANNEL, data, (uint32_t)&_dma_dummy_rx, 0, length);
+    }
+    if (data_out != NULL) {
+        _watch_spi_dma_set_descriptor(WATCH_DMA_SPI_TX_CHANNEL, (uint32_t)(data_out + length), data, DMAC_BTCTRL_SRCINC, length);
+    } else {
+        _watch_spi_dma_set_descriptor(WATCH_DMA_SPI_TX_CHANNEL, (uint32_t)&_dma_dummy_tx, data, 0, length);
+    }
+
+    // the receive channel finishes last, once the final byte has been clocked both ways, so it alone signals the end.
+    _dma_busy = true;
+    _watch_dma_start(WATCH_DMA_SPI_RX_CHANNEL, SERCOM3_DMAC_ID_RX, DMAC_CHCTRLB_TRIGACT_BEAT, 1,
+                     DMAC_CHINTENSET_TCMPL | DMAC_CHINTENSET_TERR, false);
+    _watch_dma_start(WATCH_DMA_SPI_TX_CHANNEL, SERCOM3_DMAC_ID_TX, DMAC_CHCTRLB_TRIGACT_BEAT, 0, DMAC_CHINTENSET_TERR, false);
+
+    while (_dma_busy) {
+        // same dance as watch_i2c_wait: mask interrupts so the transfer can't complete between the check and the sleep,
+        // and sleep in IDLE so that the DMAC and the SERCOM keep their clocks.
+        __disable_irq();
+        if (_dma_busy) sleep(2);
+        __enable_irq();
+    }
+
+    return _dma_success;
+}
+
 bool watch_spi_write(const uint8_t *buf, uint16_t length) {
-	return !!io_write(spi_io, buf, length);
+    return watch_spi_transfer(buf, NULL, length);
 }
 
 bool watch_spi_read(uint8_t *buf, uint16_t length) {
-	return !!io_read(spi_io, buf, length);
+    return watch_spi_transfer(NULL, buf, length);
 }
 
-bool watch_spi_transfer(const uint8_t *data_out, uint8_t *data_in, uint16_t length) {
-    struct spi_xfer xfer;
-    xfer.txbuf = (uint8_t *)data_out;
-    xfer.rxbuf = data_in;
-    xfer.size = length;
-    return !!spi_m_sync_transfer(&SPI_0, &xfer);
+void _watch_spi_dma_handler(uint8_t channel, uint8_t flags) {
+    if (flags & DMAC_CHINTFLAG_TERR) {
+        _watch_dma_stop(WATCH_DMA_SPI_RX_CHANNEL);
+        _watch_dma_stop(WATCH_DMA_SPI_TX_CHANNEL);
+        _dma_success = false;
+        _dma_busy = false;
+    } else if ((flags & DMAC_CHINTFLAG_TCMPL) && channel == WATCH_DMA_SPI_RX_CHANNEL) {
+        _dma_success = true;
+        _dma_busy = false;
+    }
 }
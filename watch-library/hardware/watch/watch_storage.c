@@ -6,27 +6,60 @@
 #define RWWEE_ADDR_START NVMCTRL_RWW_EEPROM_ADDR
 #define RWWEE_ADDR_END (NVMCTRL_RWW_EEPROM_ADDR + NVMCTRL_PAGE_SIZE * NVMCTRL_RWWEE_PAGES)
 #define NVM_MEMORY ((volatile uint16_t *)FLASH_ADDR)
+// the EEPROM size setting that gives 8 KB, as the user row encodes it.
+#define WATCH_STORAGE_EEPROM_SIZE_8K 1
 
-static bool _is_valid_address(uint32_t addr, uint32_t size) {
-    if ((addr < NVMCTRL_RWW_EEPROM_ADDR) || (addr > (NVMCTRL_RWW_EEPROM_ADDR + NVMCTRL_PAGE_SIZE * NVMCTRL_RWWEE_PAGES))) {
-        return false;
-    }
-    if ((addr + size > (NVMCTRL_RWW_EEPROM_ADDR + NVMCTRL_PAGE_SIZE * NVMCTRL_RWWEE_PAGES))) {
-        return false;
-    }
+// where the linker script put the main flash rows, if there are any; @see saml22j18.ld.
+extern uint8_t _smain_storage;
+#define MAIN_ADDR_START ((uint32_t)&_smain_storage)
+#define MAIN_ADDR_END (MAIN_ADDR_START + WATCH_STORAGE_MAIN_ROWS * NVMCTRL_ROW_SIZE)
 
-    return true;
+static void (*_ready_callback)(void);
+// set by a write or erase of a main flash row, whose old contents may still be in the NVM cache.
+static bool _main_cache_stale;
+
+static bool _is_main_row(uint32_t row) {
+    return row >= WATCH_STORAGE_RWWEE_ROWS;
+}
+
+static uint32_t _row_address(uint32_t row) {
+    if (_is_main_row(row)) return MAIN_ADDR_START + (row - WATCH_STORAGE_RWWEE_ROWS) * NVMCTRL_ROW_SIZE;
+    return RWWEE_ADDR_START + row * NVMCTRL_ROW_SIZE;
+}
+
+// a range is good if it lies within the same array as the row it starts in.
+static bool _is_valid_range(uint32_t row, uint32_t offset, uint32_t size) {
+    if (row >= WATCH_STORAGE_NUM_ROWS) return false;
+    uint32_t addr = _row_address(row) + offset;
+    uint32_t end = _is_main_row(row) ? MAIN_ADDR_END : RWWEE_ADDR_END;
+    return addr <= end && size <= end - addr;
 }
 
 bool watch_storage_read(uint32_t row, uint32_t offset, uint8_t *buffer, uint32_t size) {
-    uint32_t address = RWWEE_ADDR_START + row * NVMCTRL_ROW_SIZE + offset;
-    if (!_is_valid_address(address, size)) return false;
+    if (!_is_valid_range(row, offset, size)) return false;
+    uint32_t address = _row_address(row) + offset;
 
     uint32_t nvm_address = address / 2;
     uint32_t i;
     uint16_t data;
 
-    watch_storage_sync();
+    // the RWWEE array can't be read while it's being programmed, but don't touch NVMCTRL if it's already idle.
+    if (!hri_nvmctrl_get_interrupt_READY_bit(NVMCTRL) || _main_cache_stale) watch_storage_sync();
+
+    if (((address | (uint32_t)buffer) & 3) == 0) {
+        // fast path for word-aligned reads (i.e. all of LittleFS's): both arrays are memory mapped, so copy a
+        // word at a time, and take the last partial word in one load too. it can't run past the end of the array,
+        // which is itself word aligned.
+        const volatile uint32_t *src = (const volatile uint32_t *)address;
+        uint32_t *dst = (uint32_t *)buffer;
+        uint32_t words = size / 4;
+        for (i = 0; i < words; i++) dst[i] = src[i];
+        if (size % 4) {
+            uint32_t last = src[words];
+            memcpy(buffer + words * 4, &last, size % 4);
+        }
+        return true;
+    }
 
     if (address % 2) {
         data      = NVM_MEMORY[nvm_address++];
@@ -47,9 +80,18 @@ bool watch_storage_read(uint32_t row, uint32_t offset, uint8_t *buffer, uint32_t
     return true;
 }
 
+const uint8_t *watch_storage_get_address(uint32_t row, uint32_t offset) {
+    if (!_is_valid_range(row, offset, 0)) return NULL;
+
+    // the array can't be read while it's being programmed, so finish off anything in progress first.
+    if (!hri_nvmctrl_get_interrupt_READY_bit(NVMCTRL) || _main_cache_stale) watch_storage_sync();
+
+    return (const uint8_t *)(_row_address(row) + offset);
+}
+
 bool watch_storage_write(uint32_t row, uint32_t offset, const uint8_t *buffer, uint32_t size) {
-    uint32_t address = RWWEE_ADDR_START + row * NVMCTRL_ROW_SIZE + offset;
-    if (!_is_valid_address(address, size)) return false;
+    if (!_is_valid_range(row, offset, size)) return false;
+    uint32_t address = _row_address(row) + offset;
 
     watch_storage_sync();
 
@@ -67,28 +109,107 @@ bool watch_storage_write(uint32_t row, uint32_t offset, const uint8_t *buffer, u
         NVM_MEMORY[nvm_address++] = data;
     }
     hri_nvmctrl_write_ADDR_reg(NVMCTRL, address / 2);
-    hri_nvmctrl_write_CTRLA_reg(NVMCTRL, NVMCTRL_CTRLA_CMD_RWWEEWP | NVMCTRL_CTRLA_CMDEX_KEY);
+    if (_is_main_row(row)) {
+        // the CPU stalls until this is done anyway, since it runs from the main array.
+        _main_cache_stale = true;
+        hri_nvmctrl_write_CTRLA_reg(NVMCTRL, NVMCTRL_CTRLA_CMD_WP | NVMCTRL_CTRLA_CMDEX_KEY);
+        watch_storage_sync();
+    } else {
+        hri_nvmctrl_write_CTRLA_reg(NVMCTRL, NVMCTRL_CTRLA_CMD_RWWEEWP | NVMCTRL_CTRLA_CMDEX_KEY);
+    }
 
     return true;
 }
 
 bool watch_storage_erase(uint32_t row) {
-    uint32_t address = RWWEE_ADDR_START + row * NVMCTRL_ROW_SIZE;
-    if (!_is_valid_address(address, NVMCTRL_ROW_SIZE)) return false;
+    if (!_is_valid_range(row, 0, NVMCTRL_ROW_SIZE)) return false;
 
     watch_storage_sync();
-    hri_nvmctrl_write_ADDR_reg(NVMCTRL, address / 2);
-    hri_nvmctrl_write_CTRLA_reg(NVMCTRL, NVMCTRL_CTRLA_CMD_RWWEEER | NVMCTRL_CTRLA_CMDEX_KEY);
+    hri_nvmctrl_write_ADDR_reg(NVMCTRL, _row_address(row) / 2);
+    if (_is_main_row(row)) {
+        _main_cache_stale = true;
+        hri_nvmctrl_write_CTRLA_reg(NVMCTRL, NVMCTRL_CTRLA_CMD_ER | NVMCTRL_CTRLA_CMDEX_KEY);
+        watch_storage_sync();
+    } else {
+        hri_nvmctrl_write_CTRLA_reg(NVMCTRL, NVMCTRL_CTRLA_CMD_RWWEEER | NVMCTRL_CTRLA_CMDEX_KEY);
+    }
 
     return true;
 }
 
+bool watch_storage_is_busy(void) {
+    return !hri_nvmctrl_get_interrupt_READY_bit(NVMCTRL);
+}
+
+void watch_storage_register_ready_callback(void (*callback)(void)) {
+    _ready_callback = callback;
+    // READY is a level, not an event, so if the controller is already idle this fires right away.
+    hri_nvmctrl_set_INTEN_READY_bit(NVMCTRL);
+    NVIC_EnableIRQ(NVMCTRL_IRQn);
+}
+
+void NVMCTRL_Handler(void) {
+    // READY stays set as long as the controller is idle, so turn the interrupt off until someone asks again.
+    hri_nvmctrl_clear_INTEN_READY_bit(NVMCTRL);
+    void (*callback)(void) = _ready_callback;
+    _ready_callback = NULL;
+    if (callback != NULL) callback();
+}
+
 bool watch_storage_sync(void) {
     while (!hri_nvmctrl_get_interrupt_READY_bit(NVMCTRL)) {
-        // wait for flash to become ready
+        // sleep until the READY interrupt instead of spinning at full power; erasing a row takes milliseconds.
+        // interrupts are masked until we're asleep so that READY can't slip in between the check and the sleep,
+        // and a pending interrupt still wakes us. IDLE rather than STANDBY, since the NVM controller has to keep
+        // its clock to finish the command.
+        __disable_irq();
+        if (!hri_nvmctrl_get_interrupt_READY_bit(NVMCTRL)) {
+            hri_nvmctrl_set_INTEN_READY_bit(NVMCTRL);
+            NVIC_EnableIRQ(NVMCTRL_IRQn);
+            sleep(2);
+        }
+        __enable_irq();
     }
 
     hri_nvmctrl_clear_STATUS_reg(NVMCTRL, NVMCTRL_STATUS_MASK);
 
+    if (_main_cache_stale) {
+        // so that reads of a main flash row see what's there now.
+        _main_cache_stale = false;
+        hri_nvmctrl_write_CTRLA_reg(NVMCTRL, NVMCTRL_CTRLA_CMD_INVALL | NVMCTRL_CTRLA_CMDEX_KEY);
+        while (!hri_nvmctrl_get_interrupt_READY_bit(NVMCTRL));
+    }
+
     return true;
 }
+
+bool watch_storage_provision(void) {
+    while (!hri_nvmctrl_get_interrupt_READY_bit(NVMCTRL));
+    uint32_t user_row = *((uint32_t *)NVMCTRL_AUX0_ADDRESS);
+    if (((user_row & NVMCTRL_FUSES_EEPROM_SIZE_Msk) >> NVMCTRL_FUSES_EEPROM_SIZE_Pos) == WATCH_STORAGE_EEPROM_SIZE_8K) return true;
+    if (NVMCTRL->STATUS.reg & NVMCTRL_STATUS_SB) return false;
+
+    // the user row holds other settings too, so only the EEPROM size changes. it's erased and written back with the
+    // cache off, as in apps/eeprom-emulation-upgrade.
+    user_row &= ~NVMCTRL_FUSES_EEPROM_SIZE_Msk;
+    user_row |= NVMCTRL_FUSES_EEPROM_SIZE(WATCH_STORAGE_EEPROM_SIZE_8K);
+    uint32_t ctrlb = NVMCTRL->CTRLB.reg;
+    NVMCTRL->CTRLB.reg = ctrlb | NVMCTRL_CTRLB_CACHEDIS;
+    NVMCTRL->STATUS.reg |= NVMCTRL_STATUS_MASK;
+    NVMCTRL->ADDR.reg = NVMCTRL_AUX0_ADDRESS / 2;
+    NVMCTRL->CTRLA.reg = NVMCTRL_CTRLA_CMD_EAR | NVMCTRL_CTRLA_CMDEX_KEY;
+    while (!hri_nvmctrl_get_interrupt_READY_bit(NVMCTRL));
+    NVMCTRL->STATUS.reg |= NVMCTRL_STATUS_MASK;
+    NVMCTRL->CTRLA.reg = NVMCTRL_CTRLA_CMD_PBC | NVMCTRL_CTRLA_CMDEX_KEY;
+    while (!hri_nvmctrl_get_interrupt_READY_bit(NVMCTRL));
+    NVMCTRL->STATUS.reg |= NVMCTRL_STATUS_MASK;
+    NVMCTRL->ADDR.reg = NVMCTRL_AUX0_ADDRESS / 2;
+    *((uint32_t *)NVMCTRL_AUX0_ADDRESS) = user_row;
+    NVMCTRL->CTRLA.reg = NVMCTRL_CTRLA_CMD_WAP | NVMCTRL_CTRLA_CMDEX_KEY;
+    while (!hri_nvmctrl_get_interrupt_READY_bit(NVMCTRL));
+    NVMCTRL->CTRLB.reg = ctrlb;
+
+    // the new setting only takes effect after a reset.
+    NVIC_SystemReset();
+    return false;
+}
@@ -23,16 +23,74 @@
  */
 
 #include "watch_uart.h"
+#include "watch_private_dma.h"
 #include <string.h>
 
-struct usart_sync_descriptor USART_0;
-struct io_descriptor *uart_io;
+#define TX_MASK (WATCH_UART_TX_BUFFER_SIZE - 1)
+#define RX_MASK (WATCH_UART_RX_BUFFER_SIZE - 1)
+
+_Static_assert((WATCH_UART_TX_BUFFER_SIZE & TX_MASK) == 0 && WATCH_UART_TX_BUFFER_SIZE <= 32768,
+               "WATCH_UART_TX_BUFFER_SIZE must be a power of two");
+_Static_assert((WATCH_UART_RX_BUFFER_SIZE & RX_MASK) == 0 && WATCH_UART_RX_BUFFER_SIZE <= 32768,
+               "WATCH_UART_RX_BUFFER_SIZE must be a power of two");
+
+// the ring buffers count their heads and tails up without wrapping them, and mask them to index; the difference is
+// how many bytes are waiting, even once they roll over. each index has one writer: the main loop adds to the transmit
+// buffer and the DMAC handler takes from it, SERCOM3_Handler adds to the receive buffer and the main loop takes from it.
+static uint8_t _tx_buffer[WATCH_UART_TX_BUFFER_SIZE];
+static volatile uint16_t _tx_head;
+static volatile uint16_t _tx_tail;
+// bytes the DMAC is moving from the tail right now, or 0 when it's idle.
+static volatile uint16_t _tx_run;
+// set when a byte goes out, so watch_uart_flush knows to wait for the last one to leave the shift register.
+static bool _tx_sent;
+
+static uint8_t _rx_buffer[WATCH_UART_RX_BUFFER_SIZE];
+static volatile uint16_t _rx_head;
+static volatile uint16_t _rx_tail;
+static volatile uint16_t _rx_errors;
+static ext_irq_cb_t _rx_callback;
+
+static uint8_t _tx_pin;
+static uint8_t _rx_pin;
+static bool _enabled;
+
+static void _watch_uart_sync(uint32_t mask) {
+    while (SERCOM3->USART.SYNCBUSY.reg & mask);
+}
+
+// starts the DMAC on the longest run of waiting bytes that doesn't wrap around the end of the buffer. call it with
+// interrupts masked, or from the DMAC handler, so it can't race the handler starting the next run itself.
+static void _watch_uart_start_tx(void) {
+    uint16_t waiting = _tx_head - _tx_tail;
+    if (_tx_run || waiting == 0) return;
+
+    uint16_t start = _tx_tail & TX_MASK;
+    uint16_t run = WATCH_UART_TX_BUFFER_SIZE - start;
+    if (run > waiting) run = waiting;
+
+    // with address increment on, the DMAC wants the address just past the end of the block.
+    DmacDescriptor *descriptor = &_watch_dma_descriptors[WATCH_DMA_UART_TX_CHANNEL];
+    descriptor->BTCTRL.reg = DMAC_BTCTRL_VALID | DMAC_BTCTRL_BEATSIZE_BYTE | DMAC_BTCTRL_BLOCKACT_NOACT | DMAC_BTCTRL_SRCINC;
+    descriptor->BTCNT.reg = run;
+    descriptor->SRCADDR.reg = (uint32_t)(_tx_buffer + start + run);
+    descriptor->DSTADDR.reg = (uint32_t)&SERCOM3->USART.DATA.reg;
+    descriptor->DESCADDR.reg = 0;
+
+    _tx_run = run;
+    _tx_sent = true;
+    // each DRE moves one byte; the channel keeps running in STANDBY, so a long write needn't keep the CPU awake.
+    _watch_dma_start(WATCH_DMA_UART_TX_CHANNEL, SERCOM3_DMAC_ID_TX, DMAC_CHCTRLB_TRIGACT_BEAT, 0,
+                     DMAC_CHINTENSET_TCMPL | DMAC_CHINTENSET_TERR, true);
+}
 
 void watch_enable_uart(const uint8_t tx_pin, const uint8_t rx_pin, uint32_t baud) {
-    SERCOM_USART_CTRLA_Type ctrla;
-    SERCOM_USART_CTRLB_Type ctrlb;
-    ctrla.reg = SERCOM_USART_CTRLA_DORD | SERCOM_USART_CTRLA_MODE(1);
-    ctrlb.reg = SERCOM_USART_CTRLB_CHSIZE(0);
+    if (_enabled) watch_disable_uart();
+
+    // RUNSTDBY keeps the SERCOM going in STANDBY, and SFDE has it wake its clock at the start of an incoming byte,
+    // so the watch can sleep with the UART listening.
+    uint32_t ctrla = SERCOM_USART_CTRLA_DORD | SERCOM_USART_CTRLA_MODE(1) | SERCOM_USART_CTRLA_RUNSTDBY;
+    uint32_t ctrlb = SERCOM_USART_CTRLB_CHSIZE(0);
 
     MCLK->APBCMASK.reg |= MCLK_APBCMASK_SERCOM3;
     GCLK->PCHCTRL[SERCOM3_GCLK_ID_CORE].reg = GCLK_PCHCTRL_GEN(0) | GCLK_PCHCTRL_CHEN;
@@ -41,22 +99,21 @@ void watch_enable_uart(const uint8_t tx_pin, const uint8_t rx_pin, uint32_t baud
         // wait
     }
 
-	usart_sync_init(&USART_0, SERCOM3, (void *)NULL);
-
-    SERCOM3->USART.CTRLA.reg &= ~SERCOM_USART_CTRLA_ENABLE;
+    SERCOM3->USART.CTRLA.reg = SERCOM_USART_CTRLA_SWRST;
+    _watch_uart_sync(SERCOM_USART_SYNCBUSY_SWRST);
 
     switch (tx_pin) {
         case A2:
             gpio_set_pin_direction(tx_pin, GPIO_DIRECTION_OUT);
             gpio_set_pin_function(tx_pin, PINMUX_PB02C_SERCOM3_PAD0);
-            ctrla.reg |= SERCOM_USART_CTRLA_TXPO(0);
-            ctrlb.reg |= SERCOM_USART_CTRLB_TXEN;
+            ctrla |= SERCOM_USART_CTRLA_TXPO(0);
+            ctrlb |= SERCOM_USART_CTRLB_TXEN;
             break;
         case A4:
             gpio_set_pin_direction(tx_pin, GPIO_DIRECTION_OUT);
             gpio_set_pin_function(tx_pin, PINMUX_PB00C_SERCOM3_PAD2);
-            ctrla.reg |= SERCOM_USART_CTRLA_TXPO(1);
-            ctrlb.reg |= SERCOM_USART_CTRLB_TXEN;
+            ctrla |= SERCOM_USART_CTRLA_TXPO(1);
+            ctrlb |= SERCOM_USART_CTRLB_TXEN;
             break;
         default:
             break;
@@ -66,53 +123,213 @@ void watch_enable_uart(const uint8_t tx_pin, const uint8_t rx_pin, uint32_t baud
         case A1:
             gpio_set_pin_direction(rx_pin, GPIO_DIRECTION_IN);
             gpio_set_pin_function(rx_pin, PINMUX_PB01C_SERCOM3_PAD3);
-            ctrla.reg |= SERCOM_USART_CTRLA_RXPO(3);
-            ctrlb.reg |= SERCOM_USART_CTRLB_RXEN;
+            ctrla |= SERCOM_USART_CTRLA_RXPO(3);
+            ctrlb |= SERCOM_USART_CTRLB_RXEN | SERCOM_USART_CTRLB_SFDE;
             break;
         case A2:
             gpio_set_pin_direction(rx_pin, GPIO_DIRECTION_IN);
             gpio_set_pin_function(rx_pin, PINMUX_PB02C_SERCOM3_PAD0);
-            ctrla.reg |= SERCOM_USART_CTRLA_RXPO(0);
-            ctrlb.reg |= SERCOM_USART_CTRLB_RXEN;
+            ctrla |= SERCOM_USART_CTRLA_RXPO(0);
+            ctrlb |= SERCOM_USART_CTRLB_RXEN | SERCOM_USART_CTRLB_SFDE;
             break;
         case A3:
             gpio_set_pin_direction(rx_pin, GPIO_DIRECTION_IN);
             gpio_set_pin_function(rx_pin, PINMUX_PB03C_SERCOM3_PAD1);
-            ctrla.reg |= SERCOM_USART_CTRLA_RXPO(1);
-            ctrlb.reg |= SERCOM_USART_CTRLB_RXEN;
+            ctrla |= SERCOM_USART_CTRLA_RXPO(1);
+            ctrlb |= SERCOM_USART_CTRLB_RXEN | SERCOM_USART_CTRLB_SFDE;
             break;
         case A4:
             gpio_set_pin_direction(rx_pin, GPIO_DIRECTION_IN);
             gpio_set_pin_function(rx_pin, PINMUX_PB00C_SERCOM3_PAD2);
-            ctrla.reg |= SERCOM_USART_CTRLA_RXPO(2);
-            ctrlb.reg |= SERCOM_USART_CTRLB_RXEN;
+            ctrla |= SERCOM_USART_CTRLA_RXPO(2);
+            ctrlb |= SERCOM_USART_CTRLB_RXEN | SERCOM_USART_CTRLB_SFDE;
             break;
         default:
             break;
     }
-    SERCOM3->USART.CTRLA.reg = ctrla.reg;
-    SERCOM3->USART.CTRLB.reg = ctrlb.reg;
-
-    if (hri_usbdevice_get_CTRLA_ENABLE_bit(USB)) {
-        uint64_t br = 65536 - ((65536 * 16.0f * baud) / 8000000);
-        SERCOM3->USART.BAUD.reg = (uint16_t)br;
-    } else {
-        uint64_t br = 65536 - ((65536 * 16.0f * baud) / 4000000);
-        SERCOM3->USART.BAUD.reg = (uint16_t)br;
+    SERCOM3->USART.CTRLA.reg = ctrla;
+    SERCOM3->USART.CTRLB.reg = ctrlb;
+    _watch_uart_sync(SERCOM_USART_SYNCBUSY_CTRLB);
+
+    // 16x oversampling with arithmetic baud generation: BAUD = 65536 × (1 - 16 × baud / f_ref). the core clock is
+    // 8 MHz while USB is up, and 4 MHz otherwise.
+    uint32_t reference = hri_usbdevice_get_CTRLA_ENABLE_bit(USB) ? 8000000 : 4000000;
+    SERCOM3->USART.BAUD.reg = (uint16_t)(65536 - (((uint64_t)baud << 20) / reference));
+
+    _tx_head = _tx_tail = _tx_run = 0;
+    _tx_sent = false;
+    _rx_head = _rx_tail = _rx_errors = 0;
+    _tx_pin = (ctrlb & SERCOM_USART_CTRLB_TXEN) ? tx_pin : 0;
+    _rx_pin = (ctrlb & SERCOM_USART_CTRLB_RXEN) ? rx_pin : 0;
+
+    if (_rx_pin) {
+        SERCOM3->USART.INTENSET.reg = SERCOM_USART_INTENSET_RXC | SERCOM_USART_INTENSET_ERROR;
+        NVIC_ClearPendingIRQ(SERCOM3_IRQn);
+        NVIC_EnableIRQ(SERCOM3_IRQn);
     }
+    if (_tx_pin) _watch_dma_enable();
 
     SERCOM3->USART.CTRLA.reg |= SERCOM_USART_CTRLA_ENABLE;
+    _watch_uart_sync(SERCOM_USART_SYNCBUSY_ENABLE);
+    _enabled = true;
+}
+
+void watch_disable_uart(void) {
+    if (!_enabled) return;
+    watch_uart_flush();
+
+    NVIC_DisableIRQ(SERCOM3_IRQn);
+    if (_tx_pin) {
+        _watch_dma_stop(WATCH_DMA_UART_TX_CHANNEL);
+        _watch_dma_disable();
+        gpio_set_pin_function(_tx_pin, GPIO_PIN_FUNCTION_OFF);
+        gpio_set_pin_direction(_tx_pin, GPIO_DIRECTION_OFF);
+    }
+    if (_rx_pin) {
+        gpio_set_pin_function(_rx_pin, GPIO_PIN_FUNCTION_OFF);
+        gpio_set_pin_direction(_rx_pin, GPIO_DIRECTION_OFF);
+    }
+
+    SERCOM3->USART.CTRLA.reg &= ~SERCOM_USART_CTRLA_ENABLE;
+    _watch_uart_sync(SERCOM_USART_SYNCBUSY_ENABLE);
+    hri_mclk_clear_APBCMASK_SERCOM3_bit(MCLK);
+    _tx_pin = _rx_pin = 0;
+    _enabled = false;
+}
+
+size_t watch_uart_write(const void *data, size_t length) {
+    if (!_tx_pin) return 0;
+
+    uint16_t head = _tx_head;
+    size_t room = WATCH_UART_TX_BUFFER_SIZE - (uint16_t)(head - _tx_tail);
+    if (length > room) length = room;
+
+    // copy in up to two pieces, around the end of the buffer, before publishing the new head.
+    size_t start = head & TX_MASK;
+    size_t first = WATCH_UART_TX_BUFFER_SIZE - start;
+    if (first > length) first = length;
+    memcpy(_tx_buffer + start, data, first);
+    memcpy(_tx_buffer, (const uint8_t *)data + first, length - first);
+    _tx_head = head + length;
+
+    __disable_irq();
+    _watch_uart_start_tx();
+    __enable_irq();
 
-	usart_sync_enable(&USART_0);
-    usart_sync_get_io_descriptor(&USART_0, &uart_io);
+    return length;
 }
 
 void watch_uart_puts(char *s) {
-	io_write(uart_io, (uint8_t *)s, strlen(s));
+    size_t length = strlen(s);
+    while (_tx_pin) {
+        size_t written = watch_uart_write(s, length);
+        s += written;
+        length -= written;
+        if (length == 0) break;
+        // the buffer's full; sleep in IDLE, where the DMAC keeps draining it, until it's made some room.
+        __disable_irq();
+        if ((uint16_t)(_tx_head - _tx_tail) == WATCH_UART_TX_BUFFER_SIZE) sleep(2);
+        __enable_irq();
+    }
+}
+
+void watch_uart_flush(void) {
+    if (!_tx_pin) return;
+
+    while (_tx_run) {
+        // mask interrupts so the last run can't finish between the check and the sleep.
+        __disable_irq();
+        if (_tx_run) sleep(2);
+        __enable_irq();
+    }
+
+    // the DMAC is done once the last byte is in DATA; TXC says it's left the shift register too. that's a byte time
+    // at most, so this just waits on it.
+    if (_tx_sent) {
+        while (!(SERCOM3->USART.INTFLAG.reg & SERCOM_USART_INTFLAG_TXC));
+        SERCOM3->USART.INTFLAG.reg = SERCOM_USART_INTFLAG_TXC;
+        _tx_sent = false;
+    }
+}
+
+size_t watch_uart_available(void) {
+    return (uint16_t)(_rx_head - _rx_tail);
+}
+
+size_t watch_uart_read(void *buf, size_t length) {
+    uint16_t tail = _rx_tail;
+    size_t waiting = (uint16_t)(_rx_head - tail);
+    if (length > waiting) length = waiting;
+
+    size_t start = tail & RX_MASK;
+    size_t first = WATCH_UART_RX_BUFFER_SIZE - start;
+    if (first > length) first = length;
+    memcpy(buf, _rx_buffer + start, first);
+    memcpy((uint8_t *)buf + first, _rx_buffer, length - first);
+    _rx_tail = tail + length;
+
+    return length;
 }
 
 char watch_uart_getc(void) {
-    uint8_t retval;
-    io_read(uart_io, &retval, 1);
-    return retval;
+    char c = 0;
+    while (_rx_pin && watch_uart_read(&c, 1) == 0) {
+        __disable_irq();
+        if (_rx_head == _rx_tail) sleep(2);
+        __enable_irq();
+    }
+    return c;
+}
+
+void watch_uart_set_rx_callback(ext_irq_cb_t callback) {
+    _rx_callback = callback;
+}
+
+uint16_t watch_uart_get_rx_errors(void) {
+    __disable_irq();
+    uint16_t errors = _rx_errors;
+    _rx_errors = 0;
+    __enable_irq();
+    return errors;
+}
+
+void _watch_uart_dma_handler(uint8_t channel, uint8_t flags) {
+    (void)channel;
+    if (flags & DMAC_CHINTFLAG_TERR) _watch_dma_stop(WATCH_DMA_UART_TX_CHANNEL);
+    if (flags & (DMAC_CHINTFLAG_TCMPL | DMAC_CHINTFLAG_TERR)) {
+        // a run that failed is dropped rather than retried, so one bad transfer can't wedge the buffer.
+        _tx_tail += _tx_run;
+        _tx_run = 0;
+        _watch_uart_start_tx();
+    }
+}
+
+void SERCOM3_Handler(void) {
+    bool received = false;
+
+    if (SERCOM3->USART.INTFLAG.reg & SERCOM_USART_INTFLAG_ERROR) {
+        SERCOM3->USART.INTFLAG.reg = SERCOM_USART_INTFLAG_ERROR;
+    }
+
+    while (SERCOM3->USART.INTFLAG.reg & SERCOM_USART_INTFLAG_RXC) {
+        // the status goes with the byte at the front of the receive FIFO, so read it first.
+        uint16_t status = SERCOM3->USART.STATUS.reg;
+        uint8_t data = SERCOM3->USART.DATA.reg;
+        if (status & (SERCOM_USART_STATUS_FERR | SERCOM_USART_STATUS_PERR | SERCOM_USART_STATUS_BUFOVF)) {
+            SERCOM3->USART.STATUS.reg = status;
+            _rx_errors++;
+            // an overflow means an earlier byte was lost, but this one's good; a framing error means it's garbage.
+            if (status & (SERCOM_USART_STATUS_FERR | SERCOM_USART_STATUS_PERR)) continue;
+        }
+        uint16_t head = _rx_head;
+        if ((uint16_t)(head - _rx_tail) == WATCH_UART_RX_BUFFER_SIZE) {
+            _rx_errors++;
+            continue;
+        }
+        _rx_buffer[head & RX_MASK] = data;
+        _rx_head = head + 1;
+        received = true;
+    }
+
+    if (received && _rx_callback) _rx_callback();
 }
@@ -22,17 +22,83 @@
  * SOFTWARE.
  */
 
+#include <stddef.h>
+#include <string.h>
+
 #include "lis2dw.h"
 #include "watch.h"
 
+// the configuration registers as the sensor has them (_written), and as the driver wants them (_config). the setters
+// change _config and then write out whatever differs, so they never read the sensor, and a batch of them between
+// lis2dw_begin_config and lis2dw_end_config goes out in as few bursts as the register map allows. both start at the
+// sensor's reset values, which are all zero.
+static lis2dw_config_t _written;
+static lis2dw_config_t _config;
+static bool _batching;
+
+// the runs of configuration registers with consecutive addresses, which can each go out in one burst.
+static const struct {
+    uint8_t first_field;
+    uint8_t first_reg;
+    uint8_t count;
+} _config_runs[] = {
+    { offsetof(lis2dw_config_t, ctrl1), LIS2DW_REG_CTRL1, 6 },
+    { offsetof(lis2dw_config_t, fifo_ctrl), LIS2DW_REG_FIFO_CTRL, 1 },
+    { offsetof(lis2dw_config_t, tap_ths_x), LIS2DW_REG_TAP_THS_X, 7 },
+    { offsetof(lis2dw_config_t, ctrl7), LIS2DW_REG_CTRL7, 1 },
+};
+
+_Static_assert(offsetof(lis2dw_config_t, ctrl6) == offsetof(lis2dw_config_t, ctrl1) + 5, "CTRL1-CTRL6 go out as one run");
+_Static_assert(offsetof(lis2dw_config_t, free_fall) == offsetof(lis2dw_config_t, tap_ths_x) + 6, "TAP_THS_X-FREE_FALL go out as one run");
+
+// CTRL6's full scale bits, which converting readings needs.
+#define LIS2DW_CONFIG_RANGE() ((lis2dw_range_t)((_config.ctrl6 >> 4) & LIS2DW_RANGE_16_G))
+
+// sensitivity at ±2g is 0.061 mg per count of the left-justified 16-bit output; that's 250 / 4096. each step up in
+// range doubles it, so converting is one multiply and a shift of (12 - range).
+#define LIS2DW_MG_MULTIPLIER 250
+#define LIS2DW_MG_SHIFT 12
+
+// writes out every configuration register that differs from what the sensor has, a burst per run of them.
+static void _lis2dw_write_config(void) {
+    const uint8_t *written = (const uint8_t *)&_written;
+    const uint8_t *config = (const uint8_t *)&_config;
+    uint8_t buf[8];
+
+    for (uint8_t i = 0; i < sizeof(_config_runs) / sizeof(_config_runs[0]); i++) {
+        uint8_t field = _config_runs[i].first_field;
+        int8_t first = -1, last = -1;
+        for (uint8_t j = 0; j < _config_runs[i].count; j++) {
+            if (written[field + j] == config[field + j]) continue;
+            if (first < 0) first = j;
+            last = j;
+        }
+        if (first < 0) continue;
+        // the registers in between that haven't changed go out again as they are; that's cheaper than another start.
+        buf[0] = _config_runs[i].first_reg + first;
+        memcpy(buf + 1, config + field + first, last - first + 1);
+        watch_i2c_send(LIS2DW_ADDRESS, buf, last - first + 2);
+    }
+    _written = _config;
+}
+
+static void _lis2dw_config_changed(void) {
+    if (!_batching) _lis2dw_write_config();
+}
+
 bool lis2dw_begin(void) {
     if (lis2dw_get_device_id() != LIS2DW_WHO_AM_I_VAL) {
         return false;
     }
     watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL2, LIS2DW_CTRL2_VAL_BOOT);
     watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL2, LIS2DW_CTRL2_VAL_SOFT_RESET);
-    // Enable block data update (output registers not updated until MSB and LSB have been read) and address autoincrement
-    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL2, LIS2DW_CTRL2_VAL_BDU | LIS2DW_CTRL2_VAL_IF_ADD_INC);
+    memset(&_written, 0, sizeof(_written));
+    memset(&_config, 0, sizeof(_config));
+    _batching = false;
+    // Enable block data update (output registers not updated until MSB and LSB have been read) and address autoincrement,
+    // which the configuration bursts rely on.
+    _config.ctrl2 = LIS2DW_CTRL2_VAL_BDU | LIS2DW_CTRL2_VAL_IF_ADD_INC;
+    _lis2dw_write_config();
 
     // Parameters at startup: 
     //  * Data rate 0 (powered down)
@@ -47,6 +113,26 @@ bool lis2dw_begin(void) {
     return true;
 }
 
+void lis2dw_get_config(lis2dw_config_t *config) {
+    *config = _config;
+}
+
+void lis2dw_apply_config(const lis2dw_config_t *config) {
+    _config = *config;
+    // the boot and reset bits clear themselves; they're lis2dw_begin's business.
+    _config.ctrl2 &= ~(LIS2DW_CTRL2_VAL_BOOT | LIS2DW_CTRL2_VAL_SOFT_RESET);
+    _lis2dw_config_changed();
+}
+
+void lis2dw_begin_config(void) {
+    _batching = true;
+}
+
+void lis2dw_end_config(void) {
+    _batching = false;
+    _lis2dw_write_config();
+}
+
 uint8_t lis2dw_get_device_id(void) {
     return watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_WHO_AM_I);
 }
@@ -74,159 +160,302 @@ lis2dw_reading_t lis2dw_get_raw_reading(void) {
     return retval;
 }
 
- lis2dw_acceleration_measurement_t lis2dw_get_acceleration_measurement(lis2dw_reading_t *out_reading) {
-    lis2dw_reading_t reading = lis2dw_get_raw_reading();
-    uint8_t range = lis2dw_get_range();
-    if (out_reading != NULL) *out_reading = reading;
+lis2dw_acceleration_measurement_t lis2dw_get_acceleration_measurement(lis2dw_reading_t *out_reading) {
+    lis2dw_acceleration_mg_t mg = lis2dw_get_acceleration_mg(out_reading);
+    lis2dw_acceleration_measurement_t retval;
 
-    // this bit is cribbed from Adafruit's LIS3DH driver; from their notes, the magic number below
-    // converts from 16-bit lsb to 10-bit and divides by 1k to convert from milli-gs.
-    // final value is raw_lsb => 10-bit lsb -> milli-gs -> gs
-    uint8_t lsb_value = 1;
-    if (range == LIS2DW_RANGE_2_G) lsb_value = 4;
-    if (range == LIS2DW_RANGE_4_G) lsb_value = 8;
-    if (range == LIS2DW_RANGE_8_G) lsb_value = 16;
-    if (range == LIS2DW_RANGE_16_G) lsb_value = 48;
+    retval.x = mg.x / 1000.0f;
+    retval.y = mg.y / 1000.0f;
+    retval.z = mg.z / 1000.0f;
 
-    lis2dw_acceleration_measurement_t retval;
+    return retval;
+}
+
+static inline int16_t _lis2dw_raw_to_mg(int16_t raw, uint8_t shift) {
+    // arithmetic shift of a negative product rounds toward minus infinity, which is within a count either way.
+    return (int16_t)(((int32_t)raw * LIS2DW_MG_MULTIPLIER) >> shift);
+}
+
+lis2dw_acceleration_mg_t lis2dw_reading_to_mg(lis2dw_reading_t reading) {
+    uint8_t shift = LIS2DW_MG_SHIFT - LIS2DW_CONFIG_RANGE();
+    lis2dw_acceleration_mg_t retval;
 
-    retval.x = lsb_value * ((float)reading.x / 64000.0);
-    retval.y = lsb_value * ((float)reading.y / 64000.0);
-    retval.z = lsb_value * ((float)reading.z / 64000.0);
+    retval.x = _lis2dw_raw_to_mg(reading.x, shift);
+    retval.y = _lis2dw_raw_to_mg(reading.y, shift);
+    retval.z = _lis2dw_raw_to_mg(reading.z, shift);
 
     return retval;
 }
 
+lis2dw_acceleration_mg_t lis2dw_get_acceleration_mg(lis2dw_reading_t *out_reading) {
+    lis2dw_reading_t reading = lis2dw_get_raw_reading();
+    if (out_reading != NULL) *out_reading = reading;
+
+    return lis2dw_reading_to_mg(reading);
+}
+
+void lis2dw_fifo_to_mg(const lis2dw_fifo_t *fifo_data, lis2dw_acceleration_mg_t *out) {
+    uint8_t shift = LIS2DW_MG_SHIFT - LIS2DW_CONFIG_RANGE();
+
+    for (int8_t i = 0; i < fifo_data->count; i++) {
+        out[i].x = _lis2dw_raw_to_mg(fifo_data->readings[i].x, shift);
+        out[i].y = _lis2dw_raw_to_mg(fifo_data->readings[i].y, shift);
+        out[i].z = _lis2dw_raw_to_mg(fifo_data->readings[i].z, shift);
+    }
+}
+
 uint16_t lis2dw_get_temperature(void) {
     return watch_i2c_read16(LIS2DW_ADDRESS, LIS2DW_REG_OUT_TEMP_L);
 }
 
-void lis2dw_set_range(lis2dw_range_t range) {
-    uint8_t val = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL6) & ~(LIS2DW_RANGE_16_G << 4);
-    uint8_t bits = range << 4;
+// the setters all come down to this: replace the bits in mask with bits, and write the register if that changed it.
+static void _lis2dw_set_bits(uint8_t *reg, uint8_t mask, uint8_t bits) {
+    *reg = (*reg & ~mask) | (bits & mask);
+    _lis2dw_config_changed();
+}
 
-    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL6, val | bits);
+void lis2dw_set_range(lis2dw_range_t range) {
+    _lis2dw_set_bits(&_config.ctrl6, LIS2DW_RANGE_16_G << 4, range << 4);
 }
 
 lis2dw_range_t lis2dw_get_range(void) {
-    uint8_t retval = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL6) & (LIS2DW_RANGE_16_G << 4);
-    retval >>= 4;
-    return (lis2dw_range_t)retval;
+    return LIS2DW_CONFIG_RANGE();
 }
 
 void lis2dw_set_data_rate(lis2dw_data_rate_t dataRate) {
-    uint8_t val = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL1) & ~(0b1111 << 4);
-    uint8_t bits = dataRate << 4;
-
-    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL1, val | bits);
+    _lis2dw_set_bits(&_config.ctrl1, 0b1111 << 4, dataRate << 4);
 }
 
 lis2dw_data_rate_t lis2dw_get_data_rate(void) {
-    return watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL1) >> 4;
+    return _config.ctrl1 >> 4;
 }
 
 void lis2dw_set_filter_type(lis2dw_filter_t bwfilter) {
-    uint8_t val = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL6) & ~(LIS2DW_CTRL6_VAL_FDS_HIGH);
-    uint8_t bits = bwfilter << 3;
-    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL6, val | bits);
+    _lis2dw_set_bits(&_config.ctrl6, LIS2DW_CTRL6_VAL_FDS_HIGH, bwfilter << 3);
 }
 
 lis2dw_filter_t lis2dw_get_filter_type(void) {
-    uint8_t retval = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL6) & (LIS2DW_CTRL6_VAL_FDS_HIGH);
-    retval >>= 3;
-    return (lis2dw_filter_t)retval;
+    return (lis2dw_filter_t)((_config.ctrl6 & LIS2DW_CTRL6_VAL_FDS_HIGH) >> 3);
 }
 
 void lis2dw_set_bandwidth_filtering(lis2dw_bandwidth_filtering_mode_t bwfilter) {
-    uint8_t val = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL6) & ~(LIS2DW_CTRL6_VAL_BANDWIDTH_DIV20);
-    uint8_t bits = bwfilter << 6;
-    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL6, val | bits);
+    _lis2dw_set_bits(&_config.ctrl6, LIS2DW_CTRL6_VAL_BANDWIDTH_DIV20, bwfilter << 6);
 }
 
 lis2dw_bandwidth_filtering_mode_t lis2dw_get_bandwidth_filtering(void) {
-    uint8_t retval = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL6) & (LIS2DW_CTRL6_VAL_BANDWIDTH_DIV20);
-    retval >>= 6;
-    return (lis2dw_bandwidth_filtering_mode_t)retval;
+    return (lis2dw_bandwidth_filtering_mode_t)((_config.ctrl6 & LIS2DW_CTRL6_VAL_BANDWIDTH_DIV20) >> 6);
 }
 
 void lis2dw_set_mode(lis2dw_mode_t mode) {
-    uint8_t val = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL1) & ~(0b1100);
-    uint8_t bits = (mode << 2) & 0b1100;
-
-    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL1, val | bits);
+    _lis2dw_set_bits(&_config.ctrl1, 0b1100, mode << 2);
 }
 
 lis2dw_mode_t lis2dw_get_mode(void) {
-    return (lis2dw_mode_t)(watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL1) & 0b1100) >> 2;
+    return (lis2dw_mode_t)((_config.ctrl1 & 0b1100) >> 2);
 }
 
-void lis2dw_set_low_power_mode(lis2dw_low_power_mode_t mode) {
-    uint8_t val = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL1) & ~(0b11);
-    uint8_t bits = mode & 0b11;
+void lis2dw_start_single_conversion(void) {
+    // SLP_MODE_1 clears itself once the sample is in the output registers, so it's written without being kept.
+    _config.ctrl3 |= LIS2DW_CTRL3_VAL_SLP_MODE_SEL;
+    _lis2dw_write_config();
+    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL3, _config.ctrl3 | LIS2DW_CTRL3_VAL_SLP_MODE_1);
+}
 
-    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL1, val | bits);
+void lis2dw_set_low_power_mode(lis2dw_low_power_mode_t mode) {
+    _lis2dw_set_bits(&_config.ctrl1, 0b11, mode);
 }
 
 lis2dw_low_power_mode_t lis2dw_get_low_power_mode(void) {
-    return watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL1) & 0b11;
+    return _config.ctrl1 & 0b11;
 }
 
 void lis2dw_set_low_noise_mode(bool on) {
-    uint8_t val = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL1) & ~(LIS2DW_CTRL6_VAL_LOW_NOISE);
-    uint8_t bits = on ? LIS2DW_CTRL6_VAL_LOW_NOISE : 0;
-
-    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL1, val | bits);
+    _lis2dw_set_bits(&_config.ctrl6, LIS2DW_CTRL6_VAL_LOW_NOISE, on ? LIS2DW_CTRL6_VAL_LOW_NOISE : 0);
 }
 
 bool lis2dw_get_low_noise_mode(void) {
-    return (watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL1) & LIS2DW_CTRL6_VAL_LOW_NOISE) != 0;
+    return (_config.ctrl6 & LIS2DW_CTRL6_VAL_LOW_NOISE) != 0;
 }
 
-inline void lis2dw_disable_fifo(void) {
-    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_FIFO_CTRL, LIS2DW_FIFO_CTRL_MODE_OFF);
+void lis2dw_disable_fifo(void) {
+    lis2dw_set_fifo_mode(LIS2DW_FIFO_MODE_OFF, 0);
 }
 
-inline void lis2dw_enable_fifo(void) {
-    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_FIFO_CTRL, LIS2DW_FIFO_CTRL_MODE_COLLECT_AND_STOP | LIS2DW_FIFO_CTRL_FTH);
+void lis2dw_enable_fifo(void) {
+    lis2dw_set_fifo_mode(LIS2DW_FIFO_MODE_COLLECT_AND_STOP, LIS2DW_FIFO_CTRL_FTH);
 }
 
+_Static_assert(sizeof(lis2dw_reading_t) == 6, "FIFO reads assume readings are packed x, y, z");
+
 bool lis2dw_read_fifo(lis2dw_fifo_t *fifo_data) {
     uint8_t temp = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_FIFO_SAMPLE);
     bool overrun = !!(temp & LIS2DW_FIFO_SAMPLE_OVERRUN);
 
     fifo_data->count = temp & LIS2DW_FIFO_SAMPLE_COUNT;
+    if (fifo_data->count == 0) return overrun;
+
+    // drain the whole FIFO in one transaction: with the FIFO on, the register address wraps from OUT_Z_H back to
+    // OUT_X_L, so consecutive reads walk through the samples. they arrive as little-endian x, y, z pairs, which is
+    // exactly how lis2dw_reading_t is laid out on this part, so they can land in the array as-is.
+    lis2dw_read_fifo_samples(fifo_data->readings, fifo_data->count);
+
+    return overrun;
+}
+
+void lis2dw_set_fifo_mode(lis2dw_fifo_mode_t mode, uint8_t threshold) {
+    _config.fifo_ctrl = (mode << 5) | (threshold & LIS2DW_FIFO_CTRL_FTH);
+    // passing through bypass mode is how the FIFO gets emptied, so that has to reach the sensor even in a batch.
+    if (mode == LIS2DW_FIFO_MODE_OFF && _written.fifo_ctrl >> 5 != LIS2DW_FIFO_MODE_OFF) _lis2dw_write_config();
+    else _lis2dw_config_changed();
+}
+
+uint8_t lis2dw_get_fifo_status(void) {
+    return watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_FIFO_SAMPLE);
+}
+
+void lis2dw_read_fifo_samples(lis2dw_reading_t *readings, uint8_t count) {
+    if (count == 0) return;
+    uint8_t reg = LIS2DW_REG_OUT_X_L | 0x80; // set high bit for consecutive reads
+    watch_i2c_send(LIS2DW_ADDRESS, &reg, 1);
+    watch_i2c_receive(LIS2DW_ADDRESS, (uint8_t *)readings, count * sizeof(lis2dw_reading_t));
+}
+
+bool lis2dw_read_fifo_async(lis2dw_fifo_t *fifo_data, void (*callback)(bool success)) {
+    // the sample count is one byte, and we need it to size the burst, so that part stays blocking.
+    uint8_t temp = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_FIFO_SAMPLE);
+    bool overrun = !!(temp & LIS2DW_FIFO_SAMPLE_OVERRUN);
 
-    for(int i = 0; i < fifo_data->count; i++) {
-        fifo_data->readings[i] = lis2dw_get_raw_reading();
+    fifo_data->count = temp & LIS2DW_FIFO_SAMPLE_COUNT;
+    if (fifo_data->count == 0) {
+        if (callback != NULL) callback(true);
+        return overrun;
     }
 
+    // static, since the register address has to outlive this call.
+    static uint8_t reg = LIS2DW_REG_OUT_X_L | 0x80;
+    watch_i2c_transfer_async(LIS2DW_ADDRESS, &reg, 1, (uint8_t *)fifo_data->readings, fifo_data->count * sizeof(lis2dw_reading_t), callback);
+
     return overrun;
 }
 
 void lis2dw_clear_fifo(void) {
-    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_FIFO_CTRL, LIS2DW_FIFO_CTRL_MODE_OFF);
-    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_FIFO_CTRL, LIS2DW_FIFO_CTRL_MODE_COLLECT_AND_STOP | LIS2DW_FIFO_CTRL_FTH);
+    lis2dw_set_fifo_mode(LIS2DW_FIFO_MODE_OFF, 0);
+    lis2dw_set_fifo_mode(LIS2DW_FIFO_MODE_COLLECT_AND_STOP, LIS2DW_FIFO_CTRL_FTH);
 }
 
 void lis2dw_configure_wakeup_int1(uint8_t threshold, bool latch, bool active_state) {
-    uint8_t configuration;
+    bool batching = _batching;
+    _batching = true;
 
     // enable wakeup interrupt on INT1 pin
-    configuration = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL4_INT1);
-    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL4_INT1, configuration | LIS2DW_CTRL4_INT1_WU);
+    _config.ctrl4_int1 |= LIS2DW_CTRL4_INT1_WU;
 
     // set threshold
-    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_WAKE_UP_THS, threshold | LIS2DW_WAKE_UP_THS_VAL_SLEEP_ON);
-    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_INT1_DUR, 0b01111111);
+    _config.wake_up_ths = (_config.wake_up_ths & LIS2DW_WAKE_UP_THS_VAL_TAP_EVENT_ENABLED) | threshold | LIS2DW_WAKE_UP_THS_VAL_SLEEP_ON;
+    _config.int1_dur = 0b01111111;
 
-    configuration = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL3) & ~(LIS2DW_CTRL3_VAL_LIR);
-    if (!active_state) configuration |= LIS2DW_CTRL3_VAL_H_L_ACTIVE;
-    if (latch) configuration |= LIS2DW_CTRL3_VAL_LIR;
-    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL3, configuration);
+    _config.ctrl3 &= ~(LIS2DW_CTRL3_VAL_LIR);
+    if (!active_state) _config.ctrl3 |= LIS2DW_CTRL3_VAL_H_L_ACTIVE;
+    if (latch) _config.ctrl3 |= LIS2DW_CTRL3_VAL_LIR;
 
     // enable interrupts
-    configuration = watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL7);
-    watch_i2c_write8(LIS2DW_ADDRESS, LIS2DW_REG_CTRL7, configuration | LIS2DW_CTRL7_VAL_INTERRUPTS_ENABLE);
+    _config.ctrl7 |= LIS2DW_CTRL7_VAL_INTERRUPTS_ENABLE;
+
+    _batching = batching;
+    _lis2dw_config_changed();
+}
+
+void lis2dw_configure_stationary_detection(uint8_t threshold, uint8_t sleep_duration, bool latch) {
+    // SLEEP_ON with STATIONARY reports inactivity without dropping the data rate to 12.5 Hz. the top bits of both
+    // registers belong to tap and free-fall detection.
+    _config.wake_up_ths = (_config.wake_up_ths & LIS2DW_WAKE_UP_THS_VAL_TAP_EVENT_ENABLED) |
+                          (threshold & 0b00111111) | LIS2DW_WAKE_UP_THS_VAL_SLEEP_ON;
+    _config.wake_up_dur = (_config.wake_up_dur & LIS2DW_WAKE_UP_DUR_VAL_FF_DUR5) |
+                          LIS2DW_WAKE_UP_DUR_VAL_STATIONARY | (sleep_duration & LIS2DW_WAKE_UP_DUR_VAL_SLEEP_DUR);
+
+    _config.ctrl3 &= ~(LIS2DW_CTRL3_VAL_LIR);
+    if (latch) _config.ctrl3 |= LIS2DW_CTRL3_VAL_LIR;
+    _lis2dw_config_changed();
+}
+
+void lis2dw_disable_stationary_detection(void) {
+    _config.wake_up_ths &= LIS2DW_WAKE_UP_THS_VAL_TAP_EVENT_ENABLED;
+    _config.wake_up_dur &= LIS2DW_WAKE_UP_DUR_VAL_FF_DUR5;
+    _lis2dw_config_changed();
+}
+
+void lis2dw_configure_tap(uint8_t threshold, uint8_t durations, bool double_tap) {
+    threshold &= LIS2DW_TAP_THS_VAL_THRESHOLD;
+    // TAP_THS_X's top bits are orientation detection's; TAP_THS_Y's are the axis priority, left at X, Y, Z.
+    _config.tap_ths_x = (_config.tap_ths_x & ~LIS2DW_TAP_THS_VAL_THRESHOLD) | threshold;
+    _config.tap_ths_y = threshold;
+    _config.tap_ths_z = LIS2DW_TAP_THS_Z_VAL_X_EN | LIS2DW_TAP_THS_Z_VAL_Y_EN | LIS2DW_TAP_THS_Z_VAL_Z_EN | threshold;
+    _config.int1_dur = durations;
+    _config.wake_up_ths &= ~LIS2DW_WAKE_UP_THS_VAL_TAP_EVENT_ENABLED;
+    if (double_tap) _config.wake_up_ths |= LIS2DW_WAKE_UP_THS_VAL_TAP_EVENT_ENABLED;
+    _lis2dw_config_changed();
+}
+
+void lis2dw_disable_tap(void) {
+    _config.tap_ths_x &= ~LIS2DW_TAP_THS_VAL_THRESHOLD;
+    _config.tap_ths_y = 0;
+    _config.tap_ths_z = 0;
+    _config.wake_up_ths &= ~LIS2DW_WAKE_UP_THS_VAL_TAP_EVENT_ENABLED;
+    _lis2dw_config_changed();
+}
+
+void lis2dw_configure_6d(lis2dw_6d_threshold_t threshold, bool four_d) {
+    _lis2dw_set_bits(&_config.tap_ths_x, LIS2DW_TAP_THS_X_VAL_4D_EN | LIS2DW_TAP_THS_X_VAL_6D_THS,
+                     (four_d ? LIS2DW_TAP_THS_X_VAL_4D_EN : 0) | (threshold << 5));
+}
+
+void lis2dw_disable_6d(void) {
+    // the interrupt is what turns it on or off; this only puts the threshold back to where it started.
+    _lis2dw_set_bits(&_config.tap_ths_x, LIS2DW_TAP_THS_X_VAL_4D_EN | LIS2DW_TAP_THS_X_VAL_6D_THS, 0);
+}
+
+uint8_t lis2dw_get_orientation(void) {
+    return watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_SIXD_SRC) & 0b00111111;
+}
+
+void lis2dw_configure_free_fall(lis2dw_free_fall_threshold_t threshold, uint8_t duration) {
+    // the duration's sixth bit lives in WAKE_UP_DUR.
+    _config.free_fall = ((duration << 3) & LIS2DW_FREE_FALL_VAL_DUR) | (threshold & LIS2DW_FREE_FALL_VAL_THS);
+    _config.wake_up_dur &= ~LIS2DW_WAKE_UP_DUR_VAL_FF_DUR5;
+    if (duration & 0b100000) _config.wake_up_dur |= LIS2DW_WAKE_UP_DUR_VAL_FF_DUR5;
+    _lis2dw_config_changed();
+}
+
+void lis2dw_disable_free_fall(void) {
+    _config.free_fall = 0;
+    _config.wake_up_dur &= ~LIS2DW_WAKE_UP_DUR_VAL_FF_DUR5;
+    _lis2dw_config_changed();
+}
+
+void lis2dw_set_interrupt_latch(bool latch) {
+    _lis2dw_set_bits(&_config.ctrl3, LIS2DW_CTRL3_VAL_LIR, latch ? LIS2DW_CTRL3_VAL_LIR : 0);
+}
+
+bool lis2dw_is_stationary(void) {
+    return watch_i2c_read8(LIS2DW_ADDRESS, LIS2DW_REG_STATUS) & LIS2DW_STATUS_VAL_SLEEP_STATE;
+}
+
+void lis2dw_configure_int1(uint8_t sources) {
+    _config.ctrl4_int1 = sources;
+    _lis2dw_config_changed();
+}
+
+void lis2dw_configure_int2(uint8_t sources) {
+    _config.ctrl5_int2 = sources;
+    _lis2dw_config_changed();
+}
+
+void lis2dw_enable_interrupts(void) {
+    _lis2dw_set_bits(&_config.ctrl7, LIS2DW_CTRL7_VAL_INTERRUPTS_ENABLE, LIS2DW_CTRL7_VAL_INTERRUPTS_ENABLE);
+}
+
+void lis2dw_disable_interrupts(void) {
+    _lis2dw_set_bits(&_config.ctrl7, LIS2DW_CTRL7_VAL_INTERRUPTS_ENABLE, 0);
 }
 
 lis2dw_wakeup_source lis2dw_get_wakeup_source() {
@@ -40,6 +40,12 @@ typedef struct {
     float z;
 } lis2dw_acceleration_measurement_t;
 
+typedef struct {
+    int16_t x;  // milli-g
+    int16_t y;
+    int16_t z;
+} lis2dw_acceleration_mg_t;
+
 typedef struct {
     int8_t count;
     lis2dw_reading_t readings[32];
@@ -99,6 +105,24 @@ typedef enum {
   LIS2DW_RANGE_2_G = 0b00   // +/- 2g (default value)
 } lis2dw_range_t;
 
+typedef enum {
+  LIS2DW_6D_THRESHOLD_80_DEG = 0b00,
+  LIS2DW_6D_THRESHOLD_70_DEG = 0b01,
+  LIS2DW_6D_THRESHOLD_60_DEG = 0b10,
+  LIS2DW_6D_THRESHOLD_50_DEG = 0b11,
+} lis2dw_6d_threshold_t;
+
+typedef enum {
+  LIS2DW_FREE_FALL_THRESHOLD_156_MG = 0b000,
+  LIS2DW_FREE_FALL_THRESHOLD_219_MG = 0b001,
+  LIS2DW_FREE_FALL_THRESHOLD_250_MG = 0b010,
+  LIS2DW_FREE_FALL_THRESHOLD_312_MG = 0b011,
+  LIS2DW_FREE_FALL_THRESHOLD_344_MG = 0b100,
+  LIS2DW_FREE_FALL_THRESHOLD_406_MG = 0b101,
+  LIS2DW_FREE_FALL_THRESHOLD_469_MG = 0b110,
+  LIS2DW_FREE_FALL_THRESHOLD_500_MG = 0b111,
+} lis2dw_free_fall_threshold_t;
+
 typedef enum {
   LIS2DW_INTERRUPT_SRC_SLEEP_CHANGE = 0b00100000,
   LIS2DW_INTERRUPT_SRC_6D           = 0b00010000,
@@ -117,6 +141,26 @@ typedef enum {
   LIS2DW_WAKEUP_SRC_WAKEUP_Z    = 0b00000001
 } lis2dw_wakeup_source;
 
+// the sensor's configuration registers, as the driver keeps them. lis2dw_get_config returns a copy, and
+// lis2dw_apply_config writes back whichever ones the copy changed; the LIS2DW_*_VAL_ bits below go in them.
+typedef struct {
+    uint8_t ctrl1;          // LIS2DW_REG_CTRL1 to LIS2DW_REG_CTRL6, which have consecutive addresses
+    uint8_t ctrl2;
+    uint8_t ctrl3;
+    uint8_t ctrl4_int1;
+    uint8_t ctrl5_int2;
+    uint8_t ctrl6;
+    uint8_t fifo_ctrl;      // LIS2DW_REG_FIFO_CTRL
+    uint8_t tap_ths_x;      // LIS2DW_REG_TAP_THS_X to LIS2DW_REG_FREE_FALL, likewise
+    uint8_t tap_ths_y;
+    uint8_t tap_ths_z;
+    uint8_t int1_dur;
+    uint8_t wake_up_ths;
+    uint8_t wake_up_dur;
+    uint8_t free_fall;
+    uint8_t ctrl7;          // LIS2DW_REG_CTRL7
+} lis2dw_config_t;
+
 // Assumes SA0 is high; if low, its 0x18
 #define LIS2DW_ADDRESS (0x19)
 
@@ -227,16 +271,29 @@ typedef enum {
 #define LIS2DW_FIFO_SAMPLE_COUNT (0b00111111)
 
 #define LIS2DW_REG_TAP_THS_X 0x30
+#define LIS2DW_TAP_THS_X_VAL_4D_EN      0b10000000
+#define LIS2DW_TAP_THS_X_VAL_6D_THS     0b01100000
+#define LIS2DW_TAP_THS_VAL_THRESHOLD    0b00011111
 #define LIS2DW_REG_TAP_THS_Y 0x31
 #define LIS2DW_REG_TAP_THS_Z 0x32
-#define LIS2DW_REG_INT1_DUR 0x33
+#define LIS2DW_TAP_THS_Z_VAL_X_EN       0b10000000
+#define LIS2DW_TAP_THS_Z_VAL_Y_EN       0b01000000
+#define LIS2DW_TAP_THS_Z_VAL_Z_EN       0b00100000
+#define LIS2DW_REG_INT1_DUR 0x33            ///< Tap timing: latency in bits 7-4, quiet in 3-2 and shock in 1-0.
 
 #define LIS2DW_REG_WAKE_UP_THS 0x34
 #define LIS2DW_WAKE_UP_THS_VAL_TAP_EVENT_ENABLED 0b10000000
 #define LIS2DW_WAKE_UP_THS_VAL_SLEEP_ON          0b01000000
 
 #define LIS2DW_REG_WAKE_UP_DUR 0x35
+#define LIS2DW_WAKE_UP_DUR_VAL_FF_DUR5    0b10000000
+#define LIS2DW_WAKE_UP_DUR_VAL_WAKE_DUR   0b01100000
+#define LIS2DW_WAKE_UP_DUR_VAL_STATIONARY 0b00010000
+#define LIS2DW_WAKE_UP_DUR_VAL_SLEEP_DUR  0b00001111
+
 #define LIS2DW_REG_FREE_FALL 0x36
+#define LIS2DW_FREE_FALL_VAL_DUR        0b11111000
+#define LIS2DW_FREE_FALL_VAL_THS        0b00000111
 #define LIS2DW_REG_STATUS_DUP 0x37
 
 #define LIS2DW_REG_WAKE_UP_SRC 0x38
@@ -289,6 +346,17 @@ typedef enum {
 
 bool lis2dw_begin(void);
 
+// the setters and getters below work from a copy of the configuration registers kept in RAM, which lis2dw_begin resets
+// along with the sensor: the getters don't touch the bus, and a setter writes its register only if that changes it,
+// without reading it first. so configure the sensor only through this driver, and only after lis2dw_begin.
+void lis2dw_get_config(lis2dw_config_t *config);
+// writes every register that config changes, in one burst per run of consecutive registers.
+void lis2dw_apply_config(const lis2dw_config_t *config);
+// between these two, the setters only change the copy; lis2dw_end_config then writes out everything that changed the
+// way lis2dw_apply_config does. emptying the FIFO, and starting a single conversion, still happen right away.
+void lis2dw_begin_config(void);
+void lis2dw_end_config(void);
+
 uint8_t lis2dw_get_device_id(void);
 
 bool lis2dw_have_new_data(void);
@@ -297,6 +365,14 @@ lis2dw_reading_t lis2dw_get_raw_reading(void);
 
 lis2dw_acceleration_measurement_t lis2dw_get_acceleration_measurement(lis2dw_reading_t *out_reading);
 
+// integer versions of the above, in milli-g. they use the range last set with lis2dw_set_range, so they don't touch
+// the bus beyond reading the sample itself.
+lis2dw_acceleration_mg_t lis2dw_get_acceleration_mg(lis2dw_reading_t *out_reading);
+lis2dw_acceleration_mg_t lis2dw_reading_to_mg(lis2dw_reading_t reading);
+
+// converts every sample in fifo_data; out must have room for fifo_data->count entries.
+void lis2dw_fifo_to_mg(const lis2dw_fifo_t *fifo_data, lis2dw_acceleration_mg_t *out);
+
 uint16_t lis2dw_get_temperature(void);
 
 void lis2dw_set_range(lis2dw_range_t range);
@@ -319,6 +395,9 @@ void lis2dw_set_mode(lis2dw_mode_t mode);
 
 lis2dw_mode_t lis2dw_get_mode(void);
 
+// in LIS2DW_MODE_ON_DEMAND (with a data rate other than POWERDOWN), takes one sample; it's ready a conversion time later.
+void lis2dw_start_single_conversion(void);
+
 void lis2dw_set_low_power_mode(lis2dw_low_power_mode_t mode);
 
 lis2dw_low_power_mode_t lis2dw_get_low_power_mode(void);
@@ -333,10 +412,66 @@ void lis2dw_enable_fifo(void);
 
 bool lis2dw_read_fifo(lis2dw_fifo_t *fifo_data);
 
+// like lis2dw_read_fifo, but the samples arrive in the background; callback runs from the I2C interrupt once they
+// are in fifo_data (or right away if the FIFO was empty). returns the overrun flag.
+bool lis2dw_read_fifo_async(lis2dw_fifo_t *fifo_data, void (*callback)(bool success));
+
 void lis2dw_clear_fifo(void);
 
+// sets the FIFO mode and its watermark (0-31 samples); FIFO_SAMPLE's threshold flag and the FTH interrupt go high
+// once the FIFO holds at least that many.
+void lis2dw_set_fifo_mode(lis2dw_fifo_mode_t mode, uint8_t threshold);
+
+// returns the raw FIFO_SAMPLE register: the sample count, plus the threshold and overrun flags.
+uint8_t lis2dw_get_fifo_status(void);
+
+// pops count samples off the FIFO in one burst. count must not be more than the FIFO holds.
+void lis2dw_read_fifo_samples(lis2dw_reading_t *readings, uint8_t count);
+
 void lis2dw_configure_wakeup_int1(uint8_t threshold, bool latch, bool active_state);
 
+// turns on stationary detection: the sensor goes into its sleep state once it has seen nothing over the wake-up
+// threshold (in 1/64ths of full scale, up to 63) for the sleep duration (0 for 16 samples, or n * 512 samples, up to
+// 15), and comes out of it on the first sample over the threshold, without changing its data rate. the sleep change
+// interrupt (LIS2DW_CTRL5_INT2_SLEEP_CHG) fires both ways; with latch set, it stays up until the interrupt source is
+// read. the wake-up threshold and latch are shared with lis2dw_configure_wakeup_int1.
+void lis2dw_configure_stationary_detection(uint8_t threshold, uint8_t sleep_duration, bool latch);
+void lis2dw_disable_stationary_detection(void);
+
+// true while stationary detection has the sensor in its sleep state.
+bool lis2dw_is_stationary(void);
+
+// the sensor's own gesture engines, which look at every sample without the MCU. their interrupts only go to INT1
+// (LIS2DW_CTRL4_INT1_SINGLE_TAP, _TAP for double taps, _6D and _FF), and show in lis2dw_get_interrupt_source.
+//
+// tap detection on all three axes. threshold is in 1/32nds of full scale (1-31); durations is INT1_DUR's shock, quiet
+// and latency windows, in samples (0x7F suits 400 Hz). with double_tap set, two taps within the latency window make
+// a double tap, and single taps are reported too.
+void lis2dw_configure_tap(uint8_t threshold, uint8_t durations, bool double_tap);
+void lis2dw_disable_tap(void);
+
+// orientation detection: an interrupt each time a different face of the sensor (or, with four_d, a different side,
+// ignoring Z) points up, tilted within the threshold of it. lis2dw_get_orientation says which.
+void lis2dw_configure_6d(lis2dw_6d_threshold_t threshold, bool four_d);
+void lis2dw_disable_6d(void);
+// returns SIXD_SRC's XL-ZH bits (LIS2DW_WAKE_UP_SRC_VAL_XL and so on): the axis pointing up or down, as of the last
+// orientation interrupt.
+uint8_t lis2dw_get_orientation(void);
+
+// free-fall detection: an interrupt once every axis has read under the threshold for duration samples (1-63).
+void lis2dw_configure_free_fall(lis2dw_free_fall_threshold_t threshold, uint8_t duration);
+void lis2dw_disable_free_fall(void);
+
+// with latch set, interrupts stay up until lis2dw_get_interrupt_source (or the wake-up source) is read.
+void lis2dw_set_interrupt_latch(bool latch);
+
+// route interrupt sources to the INT1 and INT2 pins (LIS2DW_CTRL4_INT1_* and LIS2DW_CTRL5_INT2_* bits).
+void lis2dw_configure_int1(uint8_t sources);
+void lis2dw_configure_int2(uint8_t sources);
+
+void lis2dw_enable_interrupts(void);
+void lis2dw_disable_interrupts(void);
+
 lis2dw_interrupt_source lis2dw_get_interrupt_source(void);
 
 lis2dw_wakeup_source lis2dw_get_wakeup_source(void);
@@ -80,12 +80,58 @@ opt3001_t opt3001_readLowLimit(uint8_t devaddr) {
 opt3001_t opt3001_readRegister(uint8_t devaddr, opt3001_Command_t command) {
     opt3001_t result;
     opt3001_ER_t er;
-    uint8_t buf[2]; 
-	buf[0] = (uint8_t) command; 
-	watch_i2c_send(devaddr, buf, 1);
-	watch_i2c_receive(devaddr, buf, 2);
+    uint8_t reg = (uint8_t) command;
+    uint8_t buf[2] = {0, 0};
+	// the register address and the read go in one transfer, with a repeated start between them, once any
+	// transfer that's already on the bus is done.
+	watch_i2c_wait();
+	if (watch_i2c_transfer_async(devaddr, &reg, 1, buf, 2, NULL)) watch_i2c_wait();
     er.rawData = ((uint16_t) buf[0] << 8) | ((uint16_t) buf[1]);
     result.raw = er;
     result.lux = 0.01*pow(2, er.Exponent)*er.Result;
     return result;
 }
+
+void opt3001_writeRegister(uint8_t devaddr, opt3001_Command_t command, uint16_t value) {
+    uint8_t buf[3] = {(uint8_t) command, (uint8_t)(value >> 8), (uint8_t)(value & 0x00FF)};
+    watch_i2c_send(devaddr, buf, 3);
+}
+
+opt3001_ER_t opt3001_luxToLimit(float lux) {
+    opt3001_ER_t limit;
+    float counts = lux < 0 ? 0 : lux * 100;
+    uint8_t exponent = 0;
+    // each step of the exponent doubles the size of a count; take the finest one the light still fits in.
+    while (exponent < 11 && counts > 4095) {
+        counts /= 2;
+        exponent++;
+    }
+    limit.Exponent = exponent;
+    limit.Result = counts > 4095 ? 4095 : (uint16_t)(counts + 0.5f);
+    return limit;
+}
+
+void opt3001_startSingleShot(uint8_t devaddr, bool long_conversion) {
+    // an exponent of 1100b in the low limit turns the INT pin into an end-of-conversion signal.
+    opt3001_writeRegister(devaddr, OPT3001_LOW_LIMIT, 0xC000);
+    opt3001_Config_t config = {
+        .RangeNumber = 0B1100,
+        .ConversionTime = long_conversion,
+        .Latch = 0B1,
+        .ModeOfConversionOperation = 0B01
+    };
+    opt3001_writeConfig(devaddr, config);
+}
+
+void opt3001_startWindow(uint8_t devaddr, float low_lux, float high_lux, uint8_t fault_count, bool long_conversion) {
+    opt3001_writeRegister(devaddr, OPT3001_LOW_LIMIT, opt3001_luxToLimit(low_lux).rawData);
+    opt3001_writeRegister(devaddr, OPT3001_HIGH_LIMIT, opt3001_luxToLimit(high_lux).rawData);
+    opt3001_Config_t config = {
+        .RangeNumber = 0B1100,
+        .ConversionTime = long_conversion,
+        .Latch = 0B1,
+        .FaultCount = fault_count & 0B11,
+        .ModeOfConversionOperation = 0B11
+    };
+    opt3001_writeConfig(devaddr, config);
+}
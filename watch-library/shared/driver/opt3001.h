@@ -31,6 +31,7 @@ THE SOFTWARE.
 #ifndef OPT3001_
 #define OPT3001_
 #include <stdint.h>
+#include <stdbool.h>
 
 typedef enum {
 	OPT3001_RESULT		= 0x00,
@@ -73,6 +74,9 @@ typedef struct {
 	opt3001_ER_t raw;
 } opt3001_t;
 
+// what the device ID register reads on an OPT3001.
+#define OPT3001_DEVICE_ID_VALUE 0x3001
+
 uint16_t opt3001_readManufacturerID(uint8_t devaddr);
 uint16_t opt3001_readDeviceID(uint8_t devaddr);
 
@@ -83,5 +87,31 @@ opt3001_t opt3001_readLowLimit(uint8_t devaddr);
 opt3001_Config_t opt3001_readConfig(uint8_t devaddr);
 void opt3001_writeConfig(uint8_t devaddr, opt3001_Config_t config);
 opt3001_t opt3001_readRegister(uint8_t devaddr, opt3001_Command_t command);
+void opt3001_writeRegister(uint8_t devaddr, opt3001_Command_t command, uint16_t value);
+
+/** @brief Converts a light level to the exponent and mantissa the limit registers take, rounding to the nearest.
+  */
+opt3001_ER_t opt3001_luxToLimit(float lux);
+
+/** @brief Starts one conversion, and has the INT pin go low when it's done.
+  * @details This puts the low limit register into end-of-conversion mode, so the open-drain INT pin (which
+  *          needs a pull-up) reports the end of each conversion instead of a limit; wait for its falling edge,
+  *          then read the result. Starting the next conversion lets the pin go again.
+  * @param long_conversion true for an 800 ms conversion, false for 100 ms, which is noisier but costs an
+  *                        eighth of the current.
+  */
+void opt3001_startSingleShot(uint8_t devaddr, bool long_conversion);
+
+/** @brief Converts continuously, and has the INT pin go low only when the light leaves a window.
+  * @details In latched window mode the pin stays low until the configuration register is read, so read it
+  *          (opt3001_readConfig will do) along with the result when the pin falls, then move the window
+  *          around the new reading. Between changes the sensor draws under 2 µA and the watch can sleep.
+  * @param low_lux The pin falls when the light goes below this...
+  * @param high_lux ...or above this.
+  * @param fault_count How many conversions in a row have to be outside the window: 0 for one, 1 for two,
+  *                    2 for four or 3 for eight. More rides out a shadow passing over.
+  * @param long_conversion true for 800 ms conversions, false for 100 ms.
+  */
+void opt3001_startWindow(uint8_t devaddr, float low_lux, float high_lux, uint8_t fault_count, bool long_conversion);
 
 #endif // OPT3001_
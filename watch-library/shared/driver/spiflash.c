@@ -26,19 +26,33 @@
  * SOFTWARE.
  */
 
+#include <string.h>
+
 #include "spiflash.h"
 
 #define SPI_FLASH_FAST_READ false
 
+// true while the chip is selected, i.e. in the middle of a command; @see spi_flash_read_data_if_idle.
+static volatile bool _selected;
+
+// the read-ahead block, SPI_FLASH_READ_AHEAD_SIZE bytes from _cache_address, if _cache_valid. the block itself is
+// only linked in, and only takes its RAM, in firmware that calls spi_flash_read_cached.
+static uint8_t _cache[SPI_FLASH_READ_AHEAD_SIZE];
+static uint32_t _cache_address;
+static bool _cache_valid;
+
 static void flash_enable(void) {
+    _selected = true;
     watch_set_pin_level(A3, false);
 }
 
 static void flash_disable(void) {
     watch_set_pin_level(A3, true);
+    _selected = false;
 }
 
 static bool transfer(uint8_t *command, uint32_t command_length, uint8_t *data_in, uint8_t *data_out, uint32_t data_length) {
+    flash_enable();
     bool status = watch_spi_write(command, command_length);
     if (status) {
         if (data_in != NULL && data_out != NULL) {
@@ -58,6 +72,8 @@ static bool transfer_command(uint8_t command, uint8_t *data_in, uint8_t *data_ou
 }
 
 bool spi_flash_command(uint8_t command) {
+    // a chip erase, say. status and ID reads go through spi_flash_read_command, and leave the cache alone.
+    spi_flash_invalidate_cache();
     return transfer_command(command, NULL, NULL, 0);
 }
 
@@ -66,6 +82,7 @@ bool spi_flash_read_command(uint8_t command, uint8_t *data, uint32_t data_length
 }
 
 bool spi_flash_write_command(uint8_t command, uint8_t *data, uint32_t data_length) {
+    spi_flash_invalidate_cache();
     return transfer_command(command, data, NULL, data_length);
 }
 
@@ -79,6 +96,7 @@ static void address_to_bytes(uint32_t address, uint8_t *bytes) {
 bool spi_flash_sector_command(uint8_t command, uint32_t address) {
     uint8_t request[4] = {command, 0x00, 0x00, 0x00};
     address_to_bytes(address, request + 1);
+    spi_flash_invalidate_cache();
     return transfer(request, 4, NULL, NULL, 0);
 }
 
@@ -86,6 +104,7 @@ bool spi_flash_write_data(uint32_t address, uint8_t *data, uint32_t data_length)
     uint8_t request[4] = {CMD_PAGE_PROGRAM, 0x00, 0x00, 0x00};
     // Write the SPI flash write address into the bytes following the command byte.
     address_to_bytes(address, request + 1);
+    spi_flash_invalidate_cache();
     flash_enable();
     bool status = watch_spi_write(request, 4);
     if (status) {
@@ -95,17 +114,13 @@ bool spi_flash_write_data(uint32_t address, uint8_t *data, uint32_t data_length)
     return status;
 }
 
-bool spi_flash_read_data(uint32_t address, uint8_t *data, uint32_t data_length) {
-    uint8_t request[5] = {CMD_READ_DATA, 0x00, 0x00, 0x00};
-    uint8_t command_length = 4;
-    if (SPI_FLASH_FAST_READ) {
-        request[0] = CMD_FAST_READ_DATA;
-        command_length = 5;
-    }
+static bool read_data(bool fast, uint32_t address, uint8_t *data, uint32_t data_length) {
+    // a fast read has a dummy byte after the address, which gives the chip time to fetch the first byte at any clock.
+    uint8_t request[5] = {fast ? CMD_FAST_READ_DATA : CMD_READ_DATA, 0x00, 0x00, 0x00, 0x00};
     // Write the SPI flash read address into the bytes following the command byte.
     address_to_bytes(address, request + 1);
     flash_enable();
-    bool status = watch_spi_write(request, command_length);
+    bool status = watch_spi_write(request, fast ? 5 : 4);
     if (status) {
         status = watch_spi_read(data, data_length);
     }
@@ -113,8 +128,80 @@ bool spi_flash_read_data(uint32_t address, uint8_t *data, uint32_t data_length)
     return status;
 }
 
+bool spi_flash_read_data(uint32_t address, uint8_t *data, uint32_t data_length) {
+    return read_data(SPI_FLASH_FAST_READ, address, data, data_length);
+}
+
+bool spi_flash_read_cached(uint32_t address, uint8_t *data, uint32_t data_length) {
+    while (data_length) {
+        if (!_cache_valid || address < _cache_address || address >= _cache_address + SPI_FLASH_READ_AHEAD_SIZE) {
+            // the chip carries on to the next address for as long as it's clocked, so a whole block costs one
+            // command; blocks are aligned, so a reader going through in order never reads a byte twice.
+            _cache_address = address - (address % SPI_FLASH_READ_AHEAD_SIZE);
+            _cache_valid = read_data(true, _cache_address, _cache, SPI_FLASH_READ_AHEAD_SIZE);
+            if (!_cache_valid) return false;
+        }
+        uint32_t offset = address - _cache_address;
+        uint32_t length = SPI_FLASH_READ_AHEAD_SIZE - offset;
+        if (length > data_length) length = data_length;
+        memcpy(data, _cache + offset, length);
+        address += length;
+        data += length;
+        data_length -= length;
+    }
+    return true;
+}
+
+void spi_flash_invalidate_cache(void) {
+    _cache_valid = false;
+}
+
+bool spi_flash_read_data_if_idle(uint32_t address, uint8_t *data, uint32_t data_length) {
+    if (_selected) return false;
+    // a claim of our own, in case nobody else has powered the SPI bus up.
+    spi_flash_init();
+    uint8_t status = SPI_FLASH_STATUS_BUSY;
+    bool success = spi_flash_read_command(CMD_READ_STATUS, &status, 1) && !(status & SPI_FLASH_STATUS_BUSY);
+    if (success) success = spi_flash_read_data(address, data, data_length);
+    watch_release_peripheral(WATCH_PERIPHERAL_SPI);
+    return success;
+}
+
+bool spi_flash_wait_until_ready(void) {
+    uint8_t status = 0;
+    while (true) {
+        if (!spi_flash_read_command(CMD_READ_STATUS, &status, 1)) return false;
+        if (!(status & SPI_FLASH_STATUS_BUSY)) return true;
+        // a page program takes a millisecond or so, and an erase tens of them. rather than keep the CPU and the bus
+        // busy polling for that long, doze until the next 128 Hz tick (or any other interrupt) and check again.
+        watch_rtc_idle_until_periodic_tick(128);
+    }
+}
+
+bool spi_flash_erase_sector(uint32_t address) {
+    if (!spi_flash_wait_until_ready()) return false;
+    if (!spi_flash_command(CMD_ENABLE_WRITE)) return false;
+    if (!spi_flash_sector_command(CMD_SECTOR_ERASE, address)) return false;
+    return spi_flash_wait_until_ready();
+}
+
+bool spi_flash_program(uint32_t address, const uint8_t *data, uint32_t data_length) {
+    while (data_length) {
+        // a page program wraps around within its page, so never let one cross a page boundary.
+        uint32_t length = SPI_FLASH_PAGE_SIZE - (address % SPI_FLASH_PAGE_SIZE);
+        if (length > data_length) length = data_length;
+        if (!spi_flash_wait_until_ready()) return false;
+        if (!spi_flash_command(CMD_ENABLE_WRITE)) return false;
+        if (!spi_flash_write_data(address, (uint8_t *)data, length)) return false;
+        address += length;
+        data += length;
+        data_length -= length;
+    }
+    return spi_flash_wait_until_ready();
+}
+
 void spi_flash_init(void) {
 	gpio_set_pin_level(A3, true);
 	gpio_set_pin_direction(A3, GPIO_DIRECTION_OUT);
-    watch_enable_spi();
+    watch_claim_peripheral(WATCH_PERIPHERAL_SPI);
 }
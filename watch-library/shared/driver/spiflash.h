@@ -49,10 +49,36 @@
 #define CMD_RESET 0x99
 #define CMD_WAKE 0xab
 
+#define SPI_FLASH_PAGE_SIZE 256
+#define SPI_FLASH_SECTOR_SIZE 4096
+#define SPI_FLASH_STATUS_BUSY 0x01
+
+#ifndef SPI_FLASH_READ_AHEAD_SIZE
+#define SPI_FLASH_READ_AHEAD_SIZE 1024  ///< Bytes spi_flash_read_cached fetches at a time.
+#endif
+
 bool spi_flash_command(uint8_t command);
 bool spi_flash_read_command(uint8_t command, uint8_t *response, uint32_t length);
 bool spi_flash_write_command(uint8_t command, uint8_t *data, uint32_t length);
 bool spi_flash_sector_command(uint8_t command, uint32_t address);
 bool spi_flash_write_data(uint32_t address, uint8_t *data, uint32_t data_length);
 bool spi_flash_read_data(uint32_t address, uint8_t *data, uint32_t data_length);
+/// Reads data like spi_flash_read_data, but through a read-ahead block: a miss fetches the aligned
+/// SPI_FLASH_READ_AHEAD_SIZE bytes around the address in one fast-read burst, and reads after it that fall in the
+/// same block come from RAM. For code going through the chip in order, a page or less at a time. Writes and erases
+/// through this driver drop the block; like spi_flash_read_data, this doesn't wait for the chip to be ready.
+bool spi_flash_read_cached(uint32_t address, uint8_t *data, uint32_t data_length);
+/// Drops the read-ahead block, for code that changes the chip's contents without going through this driver.
+void spi_flash_invalidate_cache(void);
+/// Reads data like spi_flash_read_data, but only if no command is in progress and the chip isn't busy programming or
+/// erasing; for code that interrupts the chip's other users (like the USB task) and mustn't wait on them. It claims
+/// the SPI bus for itself for the length of the read.
+bool spi_flash_read_data_if_idle(uint32_t address, uint8_t *data, uint32_t data_length);
+/// Waits for the flash chip to finish any erase or program in progress, idling the CPU between status polls.
+bool spi_flash_wait_until_ready(void);
+/// Erases the 4 KB sector containing address, and waits for the erase to finish.
+bool spi_flash_erase_sector(uint32_t address);
+/// Programs data_length bytes at address, splitting the write at page boundaries, and waits for it to finish.
+/// The target range must already be erased.
+bool spi_flash_program(uint32_t address, const uint8_t *data, uint32_t data_length);
 void spi_flash_init(void);
@@ -23,12 +23,14 @@
  */
 
 #include "thermistor_driver.h"
+#include "thermistor_table.h"
 #include "watch.h"
-#include "watch_utility.h"
+
+static void (*_thermistor_monitor_callback)(int16_t temperature_centidegrees);
 
 void thermistor_driver_enable(void) {
     // Enable the ADC peripheral, which we'll use to read the thermistor value.
-    watch_enable_adc();
+    watch_claim_peripheral(WATCH_PERIPHERAL_ADC);
     // Enable analog circuitry on the sense pin, which is tied to the thermistor resistor divider.
     watch_enable_analog_input(THERMISTOR_SENSE_PIN);
     // Enable digital output on the enable pin, which is the power to the thermistor circuit.
@@ -39,20 +41,112 @@ void thermistor_driver_enable(void) {
 
 void thermistor_driver_disable(void) {
     // Disable the ADC peripheral.
-    watch_disable_adc();
+    watch_release_peripheral(WATCH_PERIPHERAL_ADC);
+    // the monitor still needs the pins.
+    if (_thermistor_monitor_callback != NULL) return;
     // Disable analog circuitry on the sense pin to save power.
     watch_disable_analog_input(THERMISTOR_SENSE_PIN);
     // Disable the enable pin's output circuitry.
     watch_disable_digital_output(THERMISTOR_ENABLE_PIN);
 }
 
-float thermistor_driver_get_temperature(void) {
+static int16_t _thermistor_driver_value_to_centidegrees(uint16_t value) {
+    uint16_t index = value >> THERMISTOR_TABLE_SHIFT;
+    int32_t fraction = value & ((1 << THERMISTOR_TABLE_SHIFT) - 1);
+    int32_t low = Thermistor_Table[index];
+    int32_t high = Thermistor_Table[index + 1];
+
+    return (int16_t)(low + ((high - low) * fraction) / (1 << THERMISTOR_TABLE_SHIFT));
+}
+
+void thermistor_driver_get_temperature_and_vcc(int16_t *temperature_centidegrees, uint16_t *vcc_millivolts) {
+    const uint8_t pins[2] = {THERMISTOR_SENSE_PIN, WATCH_ADC_VCC};
+    uint16_t values[2];
     // set the enable pin to the level that powers the thermistor circuit.
     watch_set_pin_level(THERMISTOR_ENABLE_PIN, THERMISTOR_ENABLE_VALUE);
-    // get the sense pin level
-    uint16_t value = watch_get_analog_pin_level(THERMISTOR_SENSE_PIN);
+    // take both readings in one batch; the sense pin goes first, so the divider is only needed for that one.
+    watch_get_analog_levels(pins, values, vcc_millivolts == NULL ? 1 : 2);
     // and then set the enable pin to the opposite value to power down the thermistor circuit.
     watch_set_pin_level(THERMISTOR_ENABLE_PIN, !THERMISTOR_ENABLE_VALUE);
 
-    return watch_utility_thermistor_temperature(value, THERMISTOR_HIGH_SIDE, THERMISTOR_B_COEFFICIENT, THERMISTOR_NOMINAL_TEMPERATURE, THERMISTOR_NOMINAL_RESISTANCE, THERMISTOR_SERIES_RESISTANCE);
+    if (temperature_centidegrees != NULL) *temperature_centidegrees = _thermistor_driver_value_to_centidegrees(values[0]);
+    if (vcc_millivolts != NULL) *vcc_millivolts = values[1];
+}
+
+bool thermistor_driver_is_connected(void) {
+    const uint8_t pin = THERMISTOR_SENSE_PIN;
+    uint16_t value;
+    watch_set_pin_level(THERMISTOR_ENABLE_PIN, THERMISTOR_ENABLE_VALUE);
+    watch_get_analog_levels(&pin, &value, 1);
+    watch_set_pin_level(THERMISTOR_ENABLE_PIN, !THERMISTOR_ENABLE_VALUE);
+
+    // the table's ends are far past any temperature the watch will see; a reading out there is a pin tied to a rail.
+    return value > (1 << THERMISTOR_TABLE_SHIFT) && value < UINT16_MAX - (1 << THERMISTOR_TABLE_SHIFT);
+}
+
+int16_t thermistor_driver_get_temperature_centidegrees(void) {
+    int16_t temperature;
+    thermistor_driver_get_temperature_and_vcc(&temperature, NULL);
+
+    return temperature;
+}
+
+float thermistor_driver_get_temperature(void) {
+    return thermistor_driver_get_temperature_centidegrees() / 100.0f;
+}
+
+// the reading at which the table crosses a temperature. the table runs either way, depending on THERMISTOR_HIGH_SIDE.
+static uint16_t _thermistor_driver_centidegrees_to_value(int16_t centidegrees) {
+    bool rising = Thermistor_Table[0] < Thermistor_Table[sizeof(Thermistor_Table) / sizeof(Thermistor_Table[0]) - 1];
+    uint16_t low = 0;
+    uint16_t high = UINT16_MAX;
+
+    while (low < high) {
+        uint16_t middle = low + (high - low) / 2;
+        if ((_thermistor_driver_value_to_centidegrees(middle) >= centidegrees) == rising) high = middle;
+        else low = middle + 1;
+    }
+
+    return low;
+}
+
+static void _thermistor_driver_monitor_fired(uint16_t value) {
+    void (*callback)(int16_t) = _thermistor_monitor_callback;
+    thermistor_driver_stop_monitor();
+    if (callback != NULL) callback(_thermistor_driver_value_to_centidegrees(value));
+}
+
+bool thermistor_driver_start_monitor(int16_t low_centidegrees, int16_t high_centidegrees, uint8_t frequency,
+                                     void (*callback)(int16_t temperature_centidegrees)) {
+    if (low_centidegrees >= high_centidegrees || callback == NULL) return false;
+
+    uint16_t low = _thermistor_driver_centidegrees_to_value(low_centidegrees);
+    uint16_t high = _thermistor_driver_centidegrees_to_value(high_centidegrees);
+    watch_adc_monitor_config_t config = {
+        .pin = THERMISTOR_SENSE_PIN,
+        .low = low < high ? low : high,
+        .high = low < high ? high : low,
+        .frequency = frequency,
+        .power_pin = THERMISTOR_ENABLE_PIN,
+        .power_level = THERMISTOR_ENABLE_VALUE,
+        .callback = _thermistor_driver_monitor_fired,
+    };
+
+    watch_enable_analog_input(THERMISTOR_SENSE_PIN);
+    watch_enable_digital_output(THERMISTOR_ENABLE_PIN);
+    watch_set_pin_level(THERMISTOR_ENABLE_PIN, !THERMISTOR_ENABLE_VALUE);
+    if (!watch_adc_monitor_start(&config)) return false;
+    _thermistor_monitor_callback = callback;
+
+    return true;
+}
+
+void thermistor_driver_stop_monitor(void) {
+    if (_thermistor_monitor_callback == NULL) return;
+    _thermistor_monitor_callback = NULL;
+    watch_adc_monitor_stop();
+    // leave the pins to anyone still between thermistor_driver_enable and thermistor_driver_disable.
+    if (watch_get_peripheral_claims(WATCH_PERIPHERAL_ADC)) return;
+    watch_disable_analog_input(THERMISTOR_SENSE_PIN);
+    watch_disable_digital_output(THERMISTOR_ENABLE_PIN);
 }
@@ -25,6 +25,9 @@
 #ifndef THERMISTOR_DRIVER_H_
 #define THERMISTOR_DRIVER_H_
 
+#include <stdint.h>
+#include <stdbool.h>
+
 // TODO: Do these belong in movement_config.h? In settings we can set on the watch? In an EEPROM configuration area?
 // Think on this. [joey 11/22]
 #define THERMISTOR_SENSE_PIN (A2)
@@ -36,8 +39,26 @@
 #define THERMISTOR_NOMINAL_RESISTANCE (10000.0)
 #define THERMISTOR_SERIES_RESISTANCE (10000.0)
 
+// thermistor_table.h is generated from the constants above; run utils/gen_thermistor_table.py if you change them.
+
 void thermistor_driver_enable(void);
 void thermistor_driver_disable(void);
+// Returns false if the sense pin reads at either rail with the divider powered, as it does with no thermistor there.
+// A floating pin can read anywhere, so true only means there might be one. Call thermistor_driver_enable first.
+bool thermistor_driver_is_connected(void);
+// Returns the temperature in degrees Celsius.
 float thermistor_driver_get_temperature(void);
+// Returns the temperature in hundredths of a degree Celsius, using only integer math.
+int16_t thermistor_driver_get_temperature_centidegrees(void);
+// Measures the temperature (in hundredths of a degree) and the supply voltage (in millivolts) in a single ADC batch.
+// Either pointer may be NULL. Call thermistor_driver_enable first, as with the other functions.
+void thermistor_driver_get_temperature_and_vcc(int16_t *temperature_centidegrees, uint16_t *vcc_millivolts);
+// Has the ADC take the temperature frequency times a second (a power of 2 up to 128) while the watch sleeps, and wake
+// it only once it reads low_centidegrees or below, or high_centidegrees or above; callback then gets that temperature.
+// The monitor stops before calling back, so start it again, maybe with a new window, to keep watching. On the watch
+// the callback runs in an interrupt. Needs no call to thermistor_driver_enable. Returns false if the window is empty.
+bool thermistor_driver_start_monitor(int16_t low_centidegrees, int16_t high_centidegrees, uint8_t frequency,
+                                     void (*callback)(int16_t temperature_centidegrees));
+void thermistor_driver_stop_monitor(void);
 
 #endif // THERMISTOR_DRIVER_H_
@@ -0,0 +1,31 @@
+// This file is generated by utils/gen_thermistor_table.py from thermistor_driver.h. Do not edit.
+#ifndef THERMISTOR_TABLE_H_
+#define THERMISTOR_TABLE_H_
+
+#include <stdint.h>
+
+// High-side thermistor, B = 3380, 10000 ohms at 25 C, 10000 ohm series resistor.
+#define THERMISTOR_TABLE_SHIFT 9
+
+// Temperature in hundredths of a degree Celsius for an ADC reading of (index << THERMISTOR_TABLE_SHIFT).
+static const int16_t Thermistor_Table[129] = {
+    -32768, -6425, -5479, -4879, -4430, -4066, -3757, -3488,
+    -3247, -3029, -2829, -2643, -2470, -2307, -2152, -2006,
+    -1866, -1732, -1603, -1479, -1359, -1242, -1129, -1019,
+    -912, -808, -705, -605, -507, -411, -316, -223,
+    -131, -41, 49, 137, 224, 310, 396, 480,
+    564, 648, 731, 813, 895, 976, 1057, 1138,
+    1218, 1298, 1379, 1458, 1538, 1618, 1698, 1778,
+    1858, 1938, 2018, 2098, 2179, 2260, 2341, 2423,
+    2505, 2588, 2671, 2754, 2838, 2923, 3009, 3095,
+    3182, 3270, 3359, 3449, 3539, 3631, 3724, 3819,
+    3914, 4011, 4110, 4210, 4312, 4415, 4521, 4628,
+    4738, 4850, 4964, 5081, 5201, 5324, 5450, 5579,
+    5712, 5849, 5990, 6136, 6286, 6442, 6604, 6772,
+    6947, 7130, 7322, 7522, 7733, 7956, 8191, 8441,
+    8708, 8994, 9303, 9637, 10002, 10405, 10852, 11355,
+    11929, 12597, 13392, 14370, 15628, 17368, 20098, 25839,
+    32767,
+};
+
+#endif // THERMISTOR_TABLE_H_
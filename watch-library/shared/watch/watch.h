@@ -27,8 +27,10 @@
 #define WATCH_H_
 #include <stdint.h>
 #include <stdbool.h>
+#include <stddef.h>
 #include "driver_init.h"
 #include "pins.h"
+#include "watch_board.h"
 
 #ifdef __EMSCRIPTEN__
 #include "watch_main_loop.h"
@@ -39,6 +41,7 @@
            hardware. It is divided into the following sections:
             - @ref app - This section covers the functions that you will implement in your app.c file when designing a
                          Sensor Watch app.
+            - @ref board - This section covers what the board being built for can do, i.e. whether it has a buzzer.
             - @ref rtc - This section covers functions related to the SAM L22's real-time clock peripheral, including
                          date, time and alarm functions.
             - @ref slcd - This section covers functions related to the Segment LCD display driver, which is responsible
@@ -57,6 +60,21 @@
                                deepest sleep mode available on the SAM L22.
  */
 
+/** @brief Puts a function in RAM, for the few short ones that every wake runs through.
+  * @details Code in RAM runs without fetching from flash, which draws more current than SRAM on every instruction;
+  *          between the first fetch after a wake and the next sleep, the NVM controller is powered up and reading.
+  *          The function goes in the .ramfunc section, which the linker script keeps with the initialized data, and
+  *          the startup code copies it into RAM before main. It takes its size in RAM as well as in flash, and calls
+  *          between it and code in flash go through a veneer, so it suits small functions that call little else:
+  *          interrupt handlers, the callbacks they call, and inner loops. It's never inlined into a caller in flash.
+  *          In the simulator it does nothing.
+  */
+#if __EMSCRIPTEN__
+#define WATCH_RAMFUNC
+#else
+#define WATCH_RAMFUNC __attribute__((section(".ramfunc"), noinline))
+#endif
+
 #include "watch_app.h"
 #include "watch_rtc.h"
 #include "watch_slcd.h"
@@ -69,7 +87,22 @@
 #include "watch_spi.h"
 #include "watch_uart.h"
 #include "watch_storage.h"
+#include "watch_firmware.h"
 #include "watch_deepsleep.h"
+#include "watch_power.h"
+#include "watch_regulator.h"
+#include "watch_clocks.h"
+#include "watch_memory.h"
+#include "watch_battery.h"
+#include "watch_power_trace.h"
+#include "watch_input_trace.h"
+#include "watch_profiler.h"
+#include "watch_log.h"
+#include "watch_random.h"
+#include "watch_crc.h"
+#include "watch_aes.h"
+#include "watch_fmt.h"
+#include "watch_math.h"
 
 #include "watch_private.h"
 
@@ -80,18 +113,130 @@
   */
 bool watch_is_buzzer_or_led_enabled(void);
 
+/// Mask to apply to the difference of two watch_get_cycle_counter readings.
+#define WATCH_CYCLE_COUNTER_MASK 0xFFFFFF
+
+/** @brief Returns a free-running count of CPU cycles, for measuring how long short stretches of code take.
+  * @details On hardware this is the SysTick counter, inverted so that it counts up. It runs at the CPU clock, wraps
+  *          every 2^24 cycles and stops in standby, so it only counts time spent awake. delay_ms reprograms SysTick,
+  *          so a measurement that spans a delay will undercount it. Profiling builds (see watch_profiler.h) keep the
+  *          same count while SysTick wraps at the sampling period. In the simulator this counts microseconds.
+  * @return The current count; subtract an earlier reading and mask with WATCH_CYCLE_COUNTER_MASK for elapsed cycles.
+  */
+uint32_t watch_get_cycle_counter(void);
+
+/// @brief Returns how many times a second watch_get_cycle_counter counts right now: the CPU clock on hardware, which
+///        is faster with USB connected or at WATCH_PERFORMANCE_HIGH, and 1000000 in the simulator.
+uint32_t watch_get_cycle_counter_frequency(void);
+
+/// The rate of the boot clock, in counts per second.
+#define WATCH_BOOT_TICKS_PER_SECOND 32768
+
+/** @brief Returns how long the watch has been starting up, in 1/32768 second since main began; 0 once the boot clock
+  *        has been stopped.
+  * @details This is for timing the steps between a reset and the first screen, which delay_ms would throw the cycle
+  *          counter off for. On hardware it is TC3 counting the 32.768 kHz crystal, from just after init_mcu starts
+  *          the clocks; what came before that isn't counted. Its count is 16 bits wide and carried each time it's
+  *          read, so read it at least once a second. In the simulator it counts from when main began.
+  */
+uint32_t watch_get_boot_ticks(void);
+
+/** @brief Stops the boot clock, for good, and gives TC3 back to the buzzer. If the buzzer plays a sequence first,
+  *        that stops the boot clock too.
+  */
+void watch_boot_clock_stop(void);
+
+/// The rate of the monotonic counter, in counts per second.
+#define WATCH_MONOTONIC_TICKS_PER_SECOND 512
+
+/** @brief Starts the monotonic counter, a count of 1/512 second for timing things to better than a second.
+  * @details The count runs from the 32.768 kHz crystal, in STANDBY as well as in active mode, so it keeps time while
+  *          the CPU sleeps and no fast tick is needed to count: read it when something happens, and again when you next
+  *          look. Starts nest, so several faces can share the counter; it runs until each start has had its stop,
+  *          and only interrupts once every 128 seconds to carry its 16-bit hardware count into 32 bits.
+  * @note On the watch the counter takes TC2, which is otherwise free for a sensor board's PWM.
+  */
+void watch_monotonic_start(void);
+
+/** @brief Gives back one start of the monotonic counter, and stops it once nobody else has it started.
+  */
+void watch_monotonic_stop(void);
+
+/** @brief Returns the monotonic counter's count, in 1/512 second since it was started; 0 if it isn't running.
+  * @details The count wraps after 97 days; subtract an earlier reading for the time in between, wrap or no wrap.
+  */
+uint32_t watch_get_monotonic_ticks(void);
+
+/** @brief Calls back once, from the counter's interrupt, when the low 16 bits of the monotonic count reach a value.
+  * @details This is the way to do something at a steady rate faster than the RTC's 128 Hz, like sampling a sensor:
+  *          take the count, ask for a callback a few counts on, and from the callback ask for the next one. It wakes
+  *          the watch from STANDBY. A count the counter has just passed is taken to be due at once, so a callback
+  *          that runs late catches up instead of waiting for the count to come around again.
+  * @param count The low 16 bits of the count to call back at; it may be up to 32767 counts (64 seconds) ahead.
+  * @param callback The function to call, or NULL to cancel a callback that hasn't happened yet.
+  * @note The counter has to be running (@see watch_monotonic_start); stopping it cancels the callback.
+  */
+void watch_monotonic_set_compare(uint16_t count, ext_irq_cb_t callback);
+
 /** @brief Returns true if USB is enabled.
   */
 bool watch_is_usb_enabled(void);
 
+typedef enum {
+    WATCH_PERFORMANCE_NORMAL = 0,   ///< The main clock runs at 4 MHz (8 MHz on USB).
+    WATCH_PERFORMANCE_HIGH,         ///< The main clock runs at 16 MHz.
+} watch_performance_level_t;
+
+/** @brief Sets the speed of the main clock, which drives the CPU.
+  * @details A burst of computation finishes in a quarter of the time at WATCH_PERFORMANCE_HIGH, so the watch gets
+  *          back to sleep sooner. The chip moves to performance level PL2 for the fast clock and back to PL0 after
+  *          (@see watch_regulator.h). Everything else clocked from the main clock speeds up too: the SERCOMs behind I2C, SPI and
+  *          UART, and the ADC. delay_ms also runs short. Raise the level around computation, not I/O, and drop back
+  *          to WATCH_PERFORMANCE_NORMAL before sleeping.
+  * @param level The level to switch to.
+  * @return true if the clock is now at the requested level. Raising it fails while the buzzer or LED is on, since the
+  *         TCC divides the main clock down for their note periods and PWM.
+  */
+bool watch_set_performance_level(watch_performance_level_t level);
+
 /** @brief Resets in the UF2 bootloader mode
   */
 void watch_reset_to_bootloader(void);
 
+/** @brief Reads the microcontroller's 128 bit serial number, which no two SAM L22s share. In the simulator it's a
+  *        made-up one, the same every time.
+  * @param serial Where to put its 16 bytes.
+  */
+void watch_get_serial_number(uint8_t *serial);
+
 /** @brief Call periodically from app main loop to service CDC RX/TX.
   */
 void cdc_task(void);
 
+/** @brief Returns how many more bytes can be written to the USB serial before older output starts getting
+  *        overwritten. Use this to pace long transfers to the rate the host is reading them.
+  */
+size_t cdc_get_write_buffer_space(void);
+
+/** @brief Returns the most bytes that have ever been waiting to go out over USB serial (since the last
+  *        cdc_reset_write_stats). If this gets near 1024, output is coming faster than the host takes it.
+  */
+size_t cdc_get_write_buffer_high_water_mark(void);
+
+/** @brief Returns the number of bytes of output thrown away because the USB serial write buffer was full.
+  * @details Writes never wait for the host; when the buffer is full, new output is dropped and counted here.
+  */
+uint32_t cdc_get_dropped_byte_count(void);
+
+/** @brief Resets the high water mark and dropped byte count. */
+void cdc_reset_write_stats(void);
+
+/** @brief Waits for queued USB serial output to go out, i.e. before resetting.
+  * @param timeout_ms The longest to wait, in milliseconds.
+  * @return true if everything was sent, or false if the host stopped reading before it was.
+  */
+bool cdc_flush(uint32_t timeout_ms);
+
 /** @brief Reads up to len bytes from the USB serial.
   * @param file ignored, you can pass in 0
   * @param ptr pointer to a buffer of at least len bytes
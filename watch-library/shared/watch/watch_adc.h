@@ -35,6 +35,7 @@
 /// @{
 /** @brief Enables the ADC peripheral. You must call this before attempting to read a value
   *        from an analog pin.
+  * @note If other code may be using the ADC, call watch_claim_peripheral(WATCH_PERIPHERAL_ADC) instead.
   */
 void watch_enable_adc(void);
 
@@ -141,6 +142,21 @@ void watch_set_analog_reference_voltage(watch_adc_reference_voltage reference);
   */
 uint16_t watch_get_vcc_voltage(void);
 
+/// Pass this to watch_get_analog_levels in place of a pin to measure the VCC supply.
+#define WATCH_ADC_VCC (0xFF)
+
+/** @brief Takes several analog readings back to back, while the ADC is enabled.
+  * @param pins The inputs to measure: any of pins A0-A4, or WATCH_ADC_VCC for the supply voltage. Each
+  *             reading accumulates as many samples as configured with watch_set_analog_num_samples.
+  * @param values On return, the reading for each of pins: the same value watch_get_analog_pin_level
+  *               would return for a pin, or millivolts (as watch_get_vcc_voltage) for WATCH_ADC_VCC.
+  * @param count The number of entries in pins and values.
+  * @details The pins are read first, against the current reference voltage. After that all
+  *          WATCH_ADC_VCC readings share a single switch to the internal reference and back.
+  *          Calling watch_get_vcc_voltage once per reading would switch twice for each one.
+  */
+void watch_get_analog_levels(const uint8_t *pins, uint16_t *values, uint8_t count);
+
 /** @brief Disables the analog circuitry on the selected pin.
   * @param pin One of pins A0-A4.
   */
@@ -153,5 +169,49 @@ void watch_disable_analog_input(const uint8_t pin);
   **/
 void watch_disable_adc(void);
 
+/// Called with the reading that took an analog monitor out of its window.
+typedef void (*watch_adc_monitor_cb_t)(uint16_t value);
+
+/// Pass this as an analog monitor's power_pin if the sensor needs no switching.
+#define WATCH_ADC_MONITOR_NO_POWER_PIN (0xFF)
+
+typedef struct {
+    uint8_t pin;                        ///< The input to watch: one of pins A0-A4, set up for analog input.
+    uint16_t low;                       ///< A reading of this or less wakes the watch...
+    uint16_t high;                      ///< ...and so does one of this or more.
+    uint8_t frequency;                  ///< Readings a second: a power of 2 from 1 to 128.
+    uint8_t power_pin;                  ///< An output to drive during each reading, or WATCH_ADC_MONITOR_NO_POWER_PIN.
+    bool power_level;                   ///< The level that powers the sensor; the pin sits at the other one in between.
+    watch_adc_monitor_cb_t callback;    ///< Called with the reading that fell outside the window.
+} watch_adc_monitor_config_t;
+
+/** @brief Has the ADC watch a pin by itself, taking readings on the RTC's periodic event and waking the
+  *        watch only when one falls outside a window. Suits alerts that rarely fire, like frost or
+  *        overheating, where waking up for every reading would cost more than the reading.
+  * @param config The pin, window, rate and callback. The monitor keeps its own copy.
+  * @return false if the pin, frequency or window are out of range, in which case nothing changes.
+  * @details Each reading accumulates 16 samples, the default for watch_get_analog_pin_level, against VCC,
+  *          so the window is on the same scale as that function's readings. The RTC's event starts each
+  *          conversion through the event system; if there's a power pin, the same event switches it on,
+  *          and the end of the conversion switches it off again, so the sensor draws current for a few
+  *          hundred microseconds of each period. The ADC keeps running in standby, clocked on demand.
+  *
+  *          The monitor stops before it calls back: start it again, with a new window if need be, to keep
+  *          watching. On the watch, the callback runs in the ADC's interrupt, so keep it short.
+  *
+  *          Foreground readings still work while the monitor runs: watch_enable_adc (or claiming the ADC)
+  *          sets it aside, and watch_disable_adc (which sleep mode calls) sets it up again. Starting a
+  *          second monitor replaces the first.
+  */
+bool watch_adc_monitor_start(const watch_adc_monitor_config_t *config);
+
+/** @brief Stops the analog monitor, if it's running, and leaves its power pin at the level that
+  *        turns the sensor off.
+  */
+void watch_adc_monitor_stop(void);
+
+/// Returns true if the analog monitor is running, or set aside while the ADC is in use.
+bool watch_adc_monitor_is_running(void);
+
 /// @}
 #endif
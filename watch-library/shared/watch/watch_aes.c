@@ -0,0 +1,149 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <string.h>
+#include "watch_aes.h"
+
+static void _watch_aes_xor(uint8_t *block, const uint8_t *with) {
+    for (uint8_t i = 0; i < WATCH_AES_BLOCK_SIZE; i++) block[i] ^= with[i];
+}
+
+static void _watch_aes_ecb(const uint8_t *key, const uint8_t *in, uint8_t *out, size_t blocks, bool encrypt) {
+    _watch_aes_begin(key, encrypt);
+    for (size_t i = 0; i < blocks; i++) _watch_aes_block(in + i * WATCH_AES_BLOCK_SIZE, out + i * WATCH_AES_BLOCK_SIZE);
+    _watch_aes_end();
+}
+
+void watch_aes_ecb_encrypt(const uint8_t *key, const uint8_t *in, uint8_t *out, size_t blocks) {
+    _watch_aes_ecb(key, in, out, blocks, true);
+}
+
+void watch_aes_ecb_decrypt(const uint8_t *key, const uint8_t *in, uint8_t *out, size_t blocks) {
+    _watch_aes_ecb(key, in, out, blocks, false);
+}
+
+void watch_aes_cbc_encrypt(const uint8_t *key, uint8_t *iv, const uint8_t *in, uint8_t *out, size_t blocks) {
+    uint8_t block[WATCH_AES_BLOCK_SIZE];
+    _watch_aes_begin(key, true);
+    for (size_t i = 0; i < blocks; i++) {
+        memcpy(block, in + i * WATCH_AES_BLOCK_SIZE, WATCH_AES_BLOCK_SIZE);
+        _watch_aes_xor(block, iv);
+        _watch_aes_block(block, iv);
+        memcpy(out + i * WATCH_AES_BLOCK_SIZE, iv, WATCH_AES_BLOCK_SIZE);
+    }
+    _watch_aes_end();
+}
+
+void watch_aes_cbc_decrypt(const uint8_t *key, uint8_t *iv, const uint8_t *in, uint8_t *out, size_t blocks) {
+    uint8_t block[WATCH_AES_BLOCK_SIZE];
+    uint8_t ciphertext[WATCH_AES_BLOCK_SIZE];
+    _watch_aes_begin(key, false);
+    for (size_t i = 0; i < blocks; i++) {
+        // in and out may be the same, so keep the ciphertext for the next block's sake.
+        memcpy(ciphertext, in + i * WATCH_AES_BLOCK_SIZE, WATCH_AES_BLOCK_SIZE);
+        _watch_aes_block(ciphertext, block);
+        _watch_aes_xor(block, iv);
+        memcpy(out + i * WATCH_AES_BLOCK_SIZE, block, WATCH_AES_BLOCK_SIZE);
+        memcpy(iv, ciphertext, WATCH_AES_BLOCK_SIZE);
+    }
+    _watch_aes_end();
+}
+
+void watch_aes_ctr(const uint8_t *key, uint8_t *counter, const uint8_t *in, uint8_t *out, size_t length) {
+    uint8_t keystream[WATCH_AES_BLOCK_SIZE];
+    _watch_aes_begin(key, true);
+    for (size_t offset = 0; offset < length; offset += WATCH_AES_BLOCK_SIZE) {
+        _watch_aes_block(counter, keystream);
+        size_t n = length - offset < WATCH_AES_BLOCK_SIZE ? length - offset : WATCH_AES_BLOCK_SIZE;
+        for (size_t i = 0; i < n; i++) out[offset + i] = in[offset + i] ^ keystream[i];
+        for (int8_t i = WATCH_AES_BLOCK_SIZE - 1; i >= 0 && ++counter[i] == 0; i--);
+    }
+    _watch_aes_end();
+    memset(keystream, 0, sizeof(keystream));
+}
+
+// doubling in GF(2^128), which is how CMAC derives its subkeys from the key.
+static void _watch_aes_cmac_double(uint8_t *block) {
+    uint8_t carry = block[0] >> 7;
+    for (uint8_t i = 0; i < WATCH_AES_BLOCK_SIZE - 1; i++) block[i] = (block[i] << 1) | (block[i + 1] >> 7);
+    block[WATCH_AES_BLOCK_SIZE - 1] = (block[WATCH_AES_BLOCK_SIZE - 1] << 1) ^ (carry ? 0x87 : 0);
+}
+
+void watch_aes_cmac_start(watch_aes_cmac_t *cmac, const uint8_t *key) {
+    memcpy(cmac->key, key, WATCH_AES_KEY_SIZE);
+    memset(cmac->state, 0, WATCH_AES_BLOCK_SIZE);
+    cmac->buffered = 0;
+}
+
+void watch_aes_cmac_update(watch_aes_cmac_t *cmac, const void *data, size_t length) {
+    const uint8_t *bytes = (const uint8_t *)data;
+    bool started = false;
+    while (length) {
+        // the last block is treated differently, so a full buffer waits until there's more to come.
+        if (cmac->buffered == WATCH_AES_BLOCK_SIZE) {
+            if (!started) {
+                _watch_aes_begin(cmac->key, true);
+                started = true;
+            }
+            _watch_aes_xor(cmac->state, cmac->buffer);
+            _watch_aes_block(cmac->state, cmac->state);
+            cmac->buffered = 0;
+        }
+        size_t n = WATCH_AES_BLOCK_SIZE - cmac->buffered;
+        if (n > length) n = length;
+        memcpy(cmac->buffer + cmac->buffered, bytes, n);
+        cmac->buffered += n;
+        bytes += n;
+        length -= n;
+    }
+    if (started) _watch_aes_end();
+}
+
+void watch_aes_cmac_finish(watch_aes_cmac_t *cmac, uint8_t *mac) {
+    uint8_t subkey[WATCH_AES_BLOCK_SIZE] = {0};
+    _watch_aes_begin(cmac->key, true);
+    _watch_aes_block(subkey, subkey);
+    _watch_aes_cmac_double(subkey);
+    if (cmac->buffered < WATCH_AES_BLOCK_SIZE) {
+        // a partial (or empty) last block is padded with a 1 bit and then 0s, and takes the second subkey.
+        cmac->buffer[cmac->buffered] = 0x80;
+        memset(cmac->buffer + cmac->buffered + 1, 0, WATCH_AES_BLOCK_SIZE - cmac->buffered - 1);
+        _watch_aes_cmac_double(subkey);
+    }
+    _watch_aes_xor(cmac->state, cmac->buffer);
+    _watch_aes_xor(cmac->state, subkey);
+    _watch_aes_block(cmac->state, mac);
+    _watch_aes_end();
+
+    memset(subkey, 0, sizeof(subkey));
+    memset(cmac, 0, sizeof(watch_aes_cmac_t));
+}
+
+void watch_aes_cmac(const uint8_t *key, const void *data, size_t length, uint8_t *mac) {
+    watch_aes_cmac_t cmac;
+    watch_aes_cmac_start(&cmac, key);
+    watch_aes_cmac_update(&cmac, data, length);
+    watch_aes_cmac_finish(&cmac, mac);
+}
@@ -0,0 +1,112 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef _WATCH_AES_H_INCLUDED
+#define _WATCH_AES_H_INCLUDED
+////< @file watch_aes.h
+
+#include "watch.h"
+
+/** @addtogroup aes AES
+  * @brief This section covers encrypting and authenticating data with AES-128.
+  * @details The SAM L22 has an AES engine, which does a block in a few dozen cycles; these functions feed it, and
+  *          build the usual modes on top. Each call loads its key into the engine, runs, and resets the engine, so
+  *          the key doesn't stay behind in it, and nothing needs turning on or off around them. The simulator does
+  *          the same sums in software.
+  *
+  *          Keys, blocks and counters are byte arrays, in the order FIPS 197 and the RFCs print them, so results
+  *          can be checked against any other implementation. These are for the main loop, not interrupt handlers.
+  */
+/// @{
+
+#define WATCH_AES_BLOCK_SIZE 16
+#define WATCH_AES_KEY_SIZE 16
+
+/** @brief Encrypts whole blocks on their own (ECB). Only for data that's random already, like another key.
+  * @param key The 16 byte key.
+  * @param in The plaintext.
+  * @param out Where to put the ciphertext; may be the same as in.
+  * @param blocks The number of 16 byte blocks.
+  */
+void watch_aes_ecb_encrypt(const uint8_t *key, const uint8_t *in, uint8_t *out, size_t blocks);
+
+/** @brief Decrypts whole blocks on their own (ECB); @see watch_aes_ecb_encrypt.
+  */
+void watch_aes_ecb_decrypt(const uint8_t *key, const uint8_t *in, uint8_t *out, size_t blocks);
+
+/** @brief Encrypts whole blocks, each chained to the one before (CBC).
+  * @param key The 16 byte key.
+  * @param iv The 16 byte initialization vector, which should be unpredictable; on return, the last block of
+  *           ciphertext, so that a message can be encrypted in pieces.
+  * @param in The plaintext.
+  * @param out Where to put the ciphertext; may be the same as in.
+  * @param blocks The number of 16 byte blocks.
+  */
+void watch_aes_cbc_encrypt(const uint8_t *key, uint8_t *iv, const uint8_t *in, uint8_t *out, size_t blocks);
+
+/** @brief Decrypts whole blocks chained with watch_aes_cbc_encrypt.
+  * @param iv As it was given to watch_aes_cbc_encrypt; on return, the last block of ciphertext.
+  */
+void watch_aes_cbc_decrypt(const uint8_t *key, uint8_t *iv, const uint8_t *in, uint8_t *out, size_t blocks);
+
+/** @brief Encrypts or decrypts (they're the same) any number of bytes with a counter (CTR), as in NIST SP 800-38A.
+  * @param key The 16 byte key.
+  * @param counter The 16 byte counter block for the first block, incremented as a big-endian number for each block
+  *                after; on return, the one for the block after the last. Never use a counter twice with one key.
+  * @param in The data.
+  * @param out Where to put the result; may be the same as in.
+  * @param length The number of bytes. Only the last piece of a message may be a length that isn't a multiple of 16.
+  */
+void watch_aes_ctr(const uint8_t *key, uint8_t *counter, const uint8_t *in, uint8_t *out, size_t length);
+
+/// A CMAC in progress; @see watch_aes_cmac_start.
+typedef struct {
+    uint8_t key[WATCH_AES_KEY_SIZE];
+    uint8_t state[WATCH_AES_BLOCK_SIZE];
+    uint8_t buffer[WATCH_AES_BLOCK_SIZE];
+    uint8_t buffered;
+} watch_aes_cmac_t;
+
+/** @brief Starts a CMAC (RFC 4493), a message authentication code for data that arrives in pieces.
+  * @param cmac The CMAC to start.
+  * @param key The 16 byte key, which is copied.
+  */
+void watch_aes_cmac_start(watch_aes_cmac_t *cmac, const uint8_t *key);
+
+/** @brief Adds some data to a CMAC.
+  */
+void watch_aes_cmac_update(watch_aes_cmac_t *cmac, const void *data, size_t length);
+
+/** @brief Finishes a CMAC and wipes the key from it.
+  * @param mac Where to put the 16 byte code.
+  */
+void watch_aes_cmac_finish(watch_aes_cmac_t *cmac, uint8_t *mac);
+
+/** @brief Works out the CMAC of data in one go.
+  */
+void watch_aes_cmac(const uint8_t *key, const void *data, size_t length, uint8_t *mac);
+
+/// @}
+#endif
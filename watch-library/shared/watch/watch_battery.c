@@ -0,0 +1,112 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "watch_battery.h"
+
+typedef struct {
+    uint16_t millivolts;        // the detector's level, at or above the voltage asked for
+    bool passed;                // set once the battery falls below it
+    ext_irq_cb_t callback;
+} watch_battery_threshold_t;
+
+static watch_battery_threshold_t _thresholds[WATCH_BATTERY_MAX_THRESHOLDS];
+static uint8_t _num_thresholds;
+// the threshold the detector is set for, or WATCH_BATTERY_MAX_THRESHOLDS if they've all been passed.
+static volatile uint8_t _armed = WATCH_BATTERY_MAX_THRESHOLDS;
+static uint16_t _last_reading;
+
+// sets the detector for the highest threshold that the battery is still above.
+static void _watch_battery_arm(void) {
+    uint8_t armed = WATCH_BATTERY_MAX_THRESHOLDS;
+    uint16_t level = 0;
+
+    for (uint8_t i = 0; i < _num_thresholds; i++) {
+        if (!_thresholds[i].passed && _thresholds[i].millivolts > level) {
+            armed = i;
+            level = _thresholds[i].millivolts;
+        }
+    }
+    _armed = armed;
+    _watch_battery_set_detector(level);
+}
+
+void _watch_battery_detected(void) {
+    uint8_t passed = _armed;
+    if (passed >= _num_thresholds) return;
+
+    _thresholds[passed].passed = true;
+    // if the battery is already below the next one too, the detector goes off again as soon as it's set.
+    _watch_battery_arm();
+    if (_thresholds[passed].callback != NULL) _thresholds[passed].callback();
+}
+
+void _watch_battery_note_vcc(uint16_t millivolts) {
+    bool recovered = false;
+
+    _last_reading = millivolts;
+    for (uint8_t i = 0; i < _num_thresholds; i++) {
+        if (_thresholds[i].passed && millivolts >= _thresholds[i].millivolts + WATCH_BATTERY_HYSTERESIS) {
+            _thresholds[i].passed = false;
+            recovered = true;
+        }
+    }
+    if (recovered) _watch_battery_arm();
+
+    // a reading is as good as the detector, and the only thing the simulator has to go on.
+    while (_armed < _num_thresholds && millivolts < _thresholds[_armed].millivolts) _watch_battery_detected();
+}
+
+bool watch_register_battery_threshold(uint16_t millivolts, ext_irq_cb_t callback) {
+    if (millivolts < WATCH_BATTERY_DETECTOR_MIN) return false;
+    // rounding up, so that 2600 mV is level 34 (2.601 V) and not 33 (2.567 V).
+    uint16_t level = (millivolts - WATCH_BATTERY_DETECTOR_MIN + WATCH_BATTERY_DETECTOR_STEP - 1) /
+                     WATCH_BATTERY_DETECTOR_STEP;
+    // the detector's LEVEL field is six bits wide.
+    if (level > 63) return false;
+    millivolts = WATCH_BATTERY_DETECTOR_MIN + level * WATCH_BATTERY_DETECTOR_STEP;
+
+    uint8_t i = 0;
+    while (i < _num_thresholds && _thresholds[i].millivolts != millivolts) i++;
+    if (i == _num_thresholds) {
+        if (_num_thresholds == WATCH_BATTERY_MAX_THRESHOLDS) return false;
+        _thresholds[i].millivolts = millivolts;
+        _thresholds[i].passed = false;
+        _num_thresholds++;
+    }
+    _thresholds[i].callback = callback;
+    _watch_battery_arm();
+
+    return true;
+}
+
+uint16_t watch_get_battery_voltage(void) {
+    uint16_t millivolts = _last_reading;
+
+    for (uint8_t i = 0; i < _num_thresholds; i++) {
+        if (!_thresholds[i].passed) continue;
+        if (millivolts == 0 || _thresholds[i].millivolts < millivolts) millivolts = _thresholds[i].millivolts;
+    }
+
+    return millivolts;
+}
@@ -0,0 +1,72 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _WATCH_BATTERY_H_INCLUDED
+#define _WATCH_BATTERY_H_INCLUDED
+////< @file watch_battery.h
+
+#include "watch.h"
+
+/** @addtogroup battery Battery Monitor
+  * @brief This section covers keeping an eye on the battery without reading it.
+  * @details The supply controller's brownout detector samples the battery by itself, in standby too, and raises an
+  *          interrupt when it falls below a level. The library keeps the detector set for the highest threshold that
+  *          the battery is still above, and steps it down as each one is passed; so rather than waking up to read
+  *          the ADC, register the voltages you care about, and you'll hear when the battery gets there.
+  *
+  *          The detector's levels are 34 mV apart, from 1.445 V to 3.587 V, and each threshold rounds up to one of
+  *          them, so that you hear about the battery by the time it's below the voltage you asked for. A threshold
+  *          that has been passed is set again once an ADC reading finds the battery WATCH_BATTERY_HYSTERESIS above
+  *          it, as a cold battery recovers once it warms up. Any reading also counts as a check: one that's below
+  *          the next threshold passes it straight away. The simulator has no detector, and goes by readings alone.
+  */
+/// @{
+
+/// Most thresholds that can be registered at once, including the library's own.
+#define WATCH_BATTERY_MAX_THRESHOLDS 4
+
+/// How far above a threshold, in millivolts, the battery has to read to set it again.
+#define WATCH_BATTERY_HYSTERESIS 100
+
+/// The brownout detector's lowest level, and the step between levels, in millivolts.
+#define WATCH_BATTERY_DETECTOR_MIN 1445
+#define WATCH_BATTERY_DETECTOR_STEP 34
+
+/** @brief Has the library call you when the battery falls below a voltage.
+  * @param millivolts The threshold, from 1445 to 3587 mV. Registering one that's already there replaces its callback.
+  * @param callback Called when the battery falls below the threshold: from an interrupt on the watch, unless a reading
+  *                 finds it there first, in which case it's called from whatever read the battery.
+  * @return false if the threshold is out of range, or there's no room for another.
+  */
+bool watch_register_battery_threshold(uint16_t millivolts, ext_irq_cb_t callback);
+
+/** @brief Returns the battery voltage in millivolts, as best the library knows it without reading the ADC.
+  * @details That's the last reading anyone took with watch_get_vcc_voltage, unless the battery has fallen past a
+  *          threshold since, in which case it's the level the detector saw it fall below. 0 means that nobody has
+  *          read the battery yet.
+  */
+uint16_t watch_get_battery_voltage(void);
+
+/// @}
+#endif
@@ -0,0 +1,87 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _WATCH_BOARD_H_INCLUDED
+#define _WATCH_BOARD_H_INCLUDED
+////< @file watch_board.h
+
+/** @addtogroup board Board Capabilities
+  * @brief This section covers what the board the watch is built for can do.
+  * @details Each board's pins.h describes its hardware with the WATCH_BOARD_ macros below, and this header fills in
+  *          whatever a board leaves out with what the Sensor Watch has always had. They're all plain constants, so
+  *          code that depends on a feature can test for it with #if, and a board without the feature builds without
+  *          the code: the LED and buzzer drivers, for instance, compile to empty functions on a board that has
+  *          neither, and Movement doesn't try to start an accelerometer on a board with no sensor connector.
+  */
+/// @{
+
+/// Values for WATCH_BOARD_SENSOR_CONNECTOR.
+#define WATCH_SENSOR_CONNECTOR_NONE 0       ///< No sensor board can be fitted.
+#define WATCH_SENSOR_CONNECTOR_FLEX_9PIN 1  ///< The 9-pin flex connector, with A0-A4 and I2C.
+
+/// Bits for WATCH_BOARD_EXTWAKE_PINS, one for each pin watch_register_extwake_callback can take.
+#define WATCH_EXTWAKE_A4 (1 << 0)           ///< A4, on RTC/IN[0].
+#define WATCH_EXTWAKE_A2 (1 << 1)           ///< A2, on RTC/IN[1].
+#define WATCH_EXTWAKE_BTN_ALARM (1 << 2)    ///< The ALARM button, on the tamper input in WATCH_BTN_ALARM_RTC_IN.
+
+#ifndef WATCH_BOARD_LED_CHANNELS
+/// The number of LED colors the board drives: 0 for none, 1 for red only, 2 for red and green (or blue).
+#define WATCH_BOARD_LED_CHANNELS 2
+#endif
+
+#ifndef WATCH_BOARD_HAS_BUZZER
+/// 1 if the board has a piezo buzzer on BUZZER.
+#define WATCH_BOARD_HAS_BUZZER 1
+#endif
+
+#ifndef WATCH_BOARD_EXTWAKE_PINS
+/// The pins that can wake the watch from BACKUP mode, as WATCH_EXTWAKE_ bits.
+#define WATCH_BOARD_EXTWAKE_PINS (WATCH_EXTWAKE_A4 | WATCH_EXTWAKE_A2)
+#endif
+
+#ifndef WATCH_BOARD_SENSOR_CONNECTOR
+/// What kind of sensor board can be fitted, as a WATCH_SENSOR_CONNECTOR_ value.
+#define WATCH_BOARD_SENSOR_CONNECTOR WATCH_SENSOR_CONNECTOR_FLEX_9PIN
+#endif
+
+/// The RTC frequency correction the board starts with, to trim its crystal (@see watch_rtc_freqcorr_write).
+#ifdef NO_FREQCORR
+// a dev board, whose crystal hasn't been characterized.
+#undef WATCH_BOARD_FREQCORR_DEFAULT
+#define WATCH_BOARD_FREQCORR_DEFAULT 0
+#elif !defined(WATCH_BOARD_FREQCORR_DEFAULT)
+#define WATCH_BOARD_FREQCORR_DEFAULT 0
+#endif
+
+/// 1 if the board has an LED at all.
+#define WATCH_BOARD_HAS_LED (WATCH_BOARD_LED_CHANNELS > 0)
+/// 1 if the board can take a sensor board.
+#define WATCH_BOARD_HAS_SENSOR_CONNECTOR (WATCH_BOARD_SENSOR_CONNECTOR != WATCH_SENSOR_CONNECTOR_NONE)
+
+#if (WATCH_BOARD_EXTWAKE_PINS & WATCH_EXTWAKE_BTN_ALARM) && !defined(WATCH_BTN_ALARM_RTC_IN)
+#error This board says BTN_ALARM can wake it from BACKUP mode, but doesn't say which tamper input it's on.
+#endif
+
+/// @}
+#endif
@@ -177,6 +177,40 @@ void watch_buzzer_play_sequence(int8_t *note_sequence, void (*callback_on_end)(v
 
 uint16_t sequence_length(int8_t *sequence);
 
+/// @brief One note of a tune compiled for watch_buzzer_play_notes.
+typedef struct {
+    uint16_t period;    ///< The period to play, as for watch_set_buzzer_period, or 0 for a rest.
+    uint16_t ticks;     ///< How long to play it, in 64 Hz ticks. A note of 0 ticks ends the tune.
+} watch_buzzer_note_t;
+
+/** @brief Plays a tune that's been compiled into periods and durations, in a non-blocking way.
+  * @details This is what watch_buzzer_play_sequence plays once it's looked up each note's period and followed its
+  *          repeat markers, so a tune that's compiled ahead of time (i.e. Movement's signal tunes, by
+  *          utils/gen_signal_tunes.py) has no decoding left to do while it plays. Unlike a sequence, a note can be
+  *          held for longer than 127 ticks.
+  * @param notes The notes, ending with a note of 0 ticks. They are read as they play, so they must outlive the tune.
+  * @param callback_on_end A pointer to a callback function to be invoked when the tune has finished playing.
+  * @note Either way, the watch only wakes when a note changes, not on every tick.
+  */
+void watch_buzzer_play_notes(const watch_buzzer_note_t *notes, void (*callback_on_end)(void));
+
+/** @brief Returns the next notes of a streamed tune (@see watch_buzzer_stream_notes).
+  * @return The notes to play next, ending with a note of 0 ticks, or NULL if the tune is over.
+  */
+typedef const watch_buzzer_note_t *(*watch_buzzer_next_notes_t)(void);
+
+/** @brief Plays a tune that's handed over a block at a time, with no gap between the blocks.
+  * @details When the notes run out, the sequencer calls next_notes for the next block and carries straight on with
+  *          it, so whoever's producing the tune only has to stay a block ahead of it.
+  * @param notes The first block of notes. It may be empty (a single note of 0 ticks), in which case next_notes is
+  *        called as soon as the tune starts.
+  * @param next_notes Called when a block ends, from the interrupt that plays the tune; it should only hand over a
+  *        block that's ready, not work one out. The block that just ended isn't read again.
+  * @param callback_on_end A pointer to a callback function to be invoked once next_notes has returned NULL and the
+  *        tune has finished.
+  */
+void watch_buzzer_stream_notes(const watch_buzzer_note_t *notes, watch_buzzer_next_notes_t next_notes, void (*callback_on_end)(void));
+
 /** @brief Aborts a playing sequence.
   */
 void watch_buzzer_abort_sequence(void);
@@ -0,0 +1,106 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _WATCH_CLOCKS_H_INCLUDED
+#define _WATCH_CLOCKS_H_INCLUDED
+////< @file watch_clocks.h
+
+#include "watch.h"
+
+/** @addtogroup clocks Clock Tree
+  * @brief This section covers which oscillators and clock generators are running, and what for.
+  * @details The watch runs in one of four clock profiles, and the library moves between them as the load changes;
+  *          nothing here changes the clocks, it only says what they are.
+  *
+  *          - Standby: from the moment the library decides to sleep until it wakes. Only the 32.768 kHz crystal runs,
+  *            on GCLK3, for the RTC, the SLCD, the EIC and the timers on TC2 and TC3. OSC16M runs on demand, and
+  *            only for a peripheral that keeps running in standby, like the TCC while the LED or buzzer is on.
+  *          - Interactive: awake, with OSC16M at 4 MHz on GCLK0 for the CPU and the peripherals on the main clock.
+  *          - USB: OSC16M at 8 MHz, and the DFLL locked to USB's start-of-frame at 48 MHz on GCLK1. Unplugging the
+  *            watch tears this down again: USB, its task timers, GCLK1 and the DFLL all stop, and the main clock
+  *            drops back to 4 MHz.
+  *          - Burst: OSC16M at 16 MHz, while watch_set_performance_level has the clock sped up.
+  *
+  *          Every other generator is off unless a driver is using it for a moment: GCLK2 gives the ADC OSC16M while
+  *          it samples in standby, and GCLK4 divides the crystal down while the RTC measures the DFLL against it.
+  */
+/// @{
+
+typedef enum {
+    WATCH_CLOCK_PROFILE_STANDBY = 0,
+    WATCH_CLOCK_PROFILE_INTERACTIVE,
+    WATCH_CLOCK_PROFILE_USB,
+    WATCH_CLOCK_PROFILE_BURST,
+} watch_clock_profile_t;
+
+/// The values of a generator's source, as the SAM L22 numbers them.
+typedef enum {
+    WATCH_CLOCK_SOURCE_XOSC = 0,
+    WATCH_CLOCK_SOURCE_GCLKIN,
+    WATCH_CLOCK_SOURCE_GCLKGEN1,
+    WATCH_CLOCK_SOURCE_OSCULP32K,
+    WATCH_CLOCK_SOURCE_XOSC32K,
+    WATCH_CLOCK_SOURCE_OSC16M,
+    WATCH_CLOCK_SOURCE_DFLL48M,
+    WATCH_CLOCK_SOURCE_DPLL96M,
+} watch_clock_source_t;
+
+#define WATCH_CLOCK_NUM_GENERATORS 5
+#define WATCH_CLOCK_NUM_CHANNELS 30
+#define WATCH_CLOCK_CHANNEL_OFF 0xFF
+
+typedef struct {
+    struct {
+        bool enabled;
+        bool run_in_standby;
+        watch_clock_source_t source;
+        uint32_t frequency;         ///< In Hz, after the divider; 0 if the source's frequency isn't known.
+    } generators[WATCH_CLOCK_NUM_GENERATORS];
+    uint8_t channels[WATCH_CLOCK_NUM_CHANNELS]; ///< The generator each peripheral channel takes, or WATCH_CLOCK_CHANNEL_OFF.
+    uint8_t osc16m_mhz;             ///< OSC16M's frequency, or 0 if it's off.
+    bool osc16m_on_demand;
+    bool osc16m_run_in_standby;
+    bool dfll_enabled;
+    bool xosc32k_enabled;
+} watch_clock_tree_t;
+
+/** @brief Returns the clock profile the watch is in. */
+watch_clock_profile_t watch_get_clock_profile(void);
+
+/** @brief Returns a short name for a clock profile, i.e. "usb", for logging. */
+const char *watch_get_clock_profile_name(watch_clock_profile_t profile);
+
+/** @brief Returns a short name for a generator's source, i.e. "osc16m". */
+const char *watch_get_clock_source_name(watch_clock_source_t source);
+
+/** @brief Returns a short name for the peripheral on a clock channel, i.e. "tc0/1", or NULL if there's none. */
+const char *watch_get_clock_channel_name(uint8_t channel);
+
+/** @brief Reads the clock tree as it is now: the generators, the oscillators behind them, and the channels that take
+  *        them. In the simulator it's the tree the interactive profile would have.
+  */
+void watch_get_clock_tree(watch_clock_tree_t *tree);
+
+/// @}
+#endif
@@ -0,0 +1,67 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "watch_crc.h"
+
+// below this many words, setting up the DSU costs more than it saves.
+#define WATCH_CRC_MIN_WORDS 4
+
+static uint32_t _watch_crc32_bytes(uint32_t crc, const uint8_t *data, size_t length) {
+    // a nibble at a time: a 16 entry table is small enough to keep in flash.
+    static const uint32_t table[16] = {
+        0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC, 0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+        0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C, 0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C,
+    };
+    while (length--) {
+        crc ^= *data++;
+        crc = (crc >> 4) ^ table[crc & 0xF];
+        crc = (crc >> 4) ^ table[crc & 0xF];
+    }
+    return crc;
+}
+
+uint32_t watch_crc32_update(uint32_t crc, const void *data, size_t length) {
+    const uint8_t *bytes = (const uint8_t *)data;
+    // the register runs inverted, as zlib's does, so that leading zeros count.
+    uint32_t state = ~crc;
+
+    size_t head = (4 - ((uintptr_t)bytes & 3)) & 3;
+    if (head > length) head = length;
+    state = _watch_crc32_bytes(state, bytes, head);
+    bytes += head;
+    length -= head;
+
+    size_t words = length / 4;
+    if (words >= WATCH_CRC_MIN_WORDS && _watch_crc32_words(&state, (const uint32_t *)bytes, words)) {
+        bytes += words * 4;
+        length -= words * 4;
+    }
+
+    return ~_watch_crc32_bytes(state, bytes, length);
+}
+
+uint32_t watch_crc32(const void *data, size_t length) {
+    return watch_crc32_update(0, data, length);
+}
@@ -0,0 +1,59 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef _WATCH_CRC_H_INCLUDED
+#define _WATCH_CRC_H_INCLUDED
+////< @file watch_crc.h
+
+#include "watch.h"
+
+/** @addtogroup crc CRC-32
+  * @brief This section covers checking that a stretch of memory holds what it should.
+  * @details The CRC here is the one zlib's crc32 computes (and Python's zlib.crc32, and the one in a PNG or a zip),
+  *          so a host can work out what to expect. On the watch, the SAM L22's Device Service Unit computes it over
+  *          flash or RAM in hardware, a word at a time, which is far quicker than a table small enough to keep
+  *          around; bytes before the first word boundary, and after the last, are done in software, as is all of
+  *          it in the simulator.
+  *
+  *          The DSU does one range at a time, so these are for the main loop, not for interrupt handlers.
+  */
+/// @{
+
+/** @brief Returns the CRC-32 of a range of memory.
+  * @param data The first byte, anywhere in flash (including the storage area) or RAM.
+  * @param length The number of bytes.
+  */
+uint32_t watch_crc32(const void *data, size_t length);
+
+/** @brief Continues a CRC-32 over more data, for something that arrives a piece at a time.
+  * @param crc The CRC-32 of everything before, or 0 to start.
+  * @param data The next piece.
+  * @param length Its length in bytes.
+  * @return The CRC-32 of everything so far: the same as watch_crc32 over all of it at once.
+  */
+uint32_t watch_crc32_update(uint32_t crc, const void *data, size_t length);
+
+/// @}
+#endif
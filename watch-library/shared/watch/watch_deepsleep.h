@@ -53,6 +53,7 @@ extern ext_irq_cb_t a4_callback;
   *             almost all peripherals (including the external interrupt controller), and disables
   *             all pins except for the external wake pins. In this mode the watch can only wake
   *             from the RTC alarm interrupt or an external wake pin (A2, A4 or the alarm button),
+  *             or any button if you ask for it with `watch_register_button_wake_callback`,
   *             but the display remains on and your app's state is retained. You can enter this
   *             mode by calling `watch_enter_sleep_mode`. It consumes an order of magnitude less
   *             power than STANDBY mode.
@@ -93,6 +94,22 @@ void watch_register_extwake_callback(uint8_t pin, ext_irq_cb_t callback, bool le
   */
 void watch_disable_extwake_interrupt(uint8_t pin);
 
+/** @brief Lets any of the three buttons wake the watch from Sleep or Deep Sleep mode.
+  * @details The external wake pins only reach the ALARM button. With this set, those modes also leave the
+  *          external interrupt controller running on its 32.768 kHz clock, with all three buttons configured
+  *          to interrupt on a press, so a press of LIGHT or MODE wakes the watch immediately too. The
+  *          interrupt controller costs a little current of its own, so this is opt-in. The settings apply
+  *          each time the watch goes to sleep; once it's awake, configure the buttons however you like.
+  * @param callback The function to call when a button wakes the watch. It is called for BTN_ALARM too, so you
+  *                 don't need an extwake callback on it as well.
+  * @param filter true to turn on the majority filter for the buttons (@see watch_set_interrupt_filter).
+  */
+void watch_register_button_wake_callback(ext_irq_cb_t callback, bool filter);
+
+/** @brief Goes back to waking from sleep only on the external wake pins.
+  */
+void watch_disable_button_wake(void);
+
 /** @brief Stores data in one of the RTC's backup registers, which retain their data in BACKUP mode.
   * @param data An unsigned 32 bit integer with the data you wish to store.
   * @param reg A register from 0-7.
@@ -119,9 +136,20 @@ uint32_t watch_get_backup_data(uint8_t reg);
   *          Power consumption depends on temperature, but as a rough estimate, this mode will consume:
   *           * 6.0 ~ 7.5µA while at normal room temperatures
   *           * 9.5µA while worn on a wrist (temperature ≈ 31° C)
+  * @note In the simulator, this and watch_enter_sleep_mode_minimal_resume return straight away, and the watch sleeps
+  *       once app_loop returns. Call them as the last thing before returning from app_loop.
   */
 void watch_enter_sleep_mode(void);
 
+/** @brief Enters sleep mode like watch_enter_sleep_mode, but wakes without calling app_setup.
+  * @details Everything watch_enter_sleep_mode disables stays disabled when the watch wakes: only the RTC and
+  *          the SLCD are running, and neither app_setup nor app_wake_from_standby is called. This suits a
+  *          low power mode that wakes once a minute just to update the display, where setting the app up
+  *          again on every wake would be wasted work. When the app wants to wake up fully (say, from the
+  *          extwake callback on the ALARM button), it calls app_setup itself.
+  */
+void watch_enter_sleep_mode_minimal_resume(void);
+
 /** @brief enters Deep Sleep Mode by disabling all pins and peripherals except the RTC.
   * @details Short of BACKUP mode, this is the lowest power mode you can enter while retaining your
   *          application state (and the ability to wake with the alarm button). Just note that the display
@@ -76,5 +76,38 @@ void watch_disable_external_interrupts(void);
   */
 void watch_register_interrupt_callback(const uint8_t pin, ext_irq_cb_t callback, watch_interrupt_trigger trigger);
 
+/** @brief Turns the external interrupt controller's majority filter on or off for one pin.
+  * @details With the filter on, the pin is sampled three times on the EIC's 32.768 kHz clock and the majority
+  *          decides its level, so glitches and contact bounce shorter than a couple of samples don't trigger
+  *          the interrupt. This costs well under a millisecond of latency.
+  * @param pin One of the pins watch_register_interrupt_callback accepts.
+  * @param enabled true to filter the pin, false to pass its level straight through.
+  */
+void watch_set_interrupt_filter(const uint8_t pin, bool enabled);
+
+/** @brief Starts the button timer, a hardware count for timing how long the buttons are held.
+  * @details The count starts from zero and runs at 512 Hz from the 32.768 kHz crystal, in STANDBY as well as
+  *          in active mode, until it stops at 65535 (128 seconds). Together with watch_button_timer_set_compare,
+  *          this lets you time a press and catch a long press without a fast periodic tick waking the CPU.
+  * @note The button timer borrows TC0, which runs the USB task while the watch is plugged in to USB. In that
+  *       case this function returns false, and you'll need to time the press some other way.
+  * @return true if the timer started (or was already running), false if it isn't available.
+  */
+bool watch_button_timer_start(void);
+
+/** @brief Returns the button timer's count, in 1/512 second since it was started; 0 if it isn't running.
+  */
+uint16_t watch_button_timer_get_count(void);
+
+/** @brief Asks the button timer to call back once when its count reaches a value.
+  * @param count The count at which to call back. If the count is already there, the callback happens right away.
+  * @param callback The function to call, from the timer's interrupt. It replaces any earlier request.
+  */
+void watch_button_timer_set_compare(uint16_t count, ext_irq_cb_t callback);
+
+/** @brief Stops the button timer and cancels any pending callback.
+  */
+void watch_button_timer_stop(void);
+
 /// @}
 #endif
@@ -0,0 +1,76 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#ifndef _WATCH_FIRMWARE_H_INCLUDED
+#define _WATCH_FIRMWARE_H_INCLUDED
+////< @file watch_firmware.h
+
+#include "watch.h"
+
+/** @addtogroup firmware Firmware Image
+  * @brief This section covers replacing the running firmware without the bootloader.
+  * @details The application lives in the main Flash array, from the end of the 8 kilobyte bootloader up to the
+  *          8 kilobytes the linker script keeps back at the top. It takes well under half of that, which leaves
+  *          room to build a new image above it (a row at a time; see watch_storage.h for rows and pages) while
+  *          the old one keeps running, and then to copy it down over the old one.
+  *
+  *          The copy runs from RAM with interrupts off, and ends in a reset. If power fails partway through, the
+  *          watch won't start, but the bootloader is never touched: double-tap reset and drag a UF2 onto it.
+  *          Offsets here are from the start of the image, as in the .bin the build makes. In the simulator there's
+  *          no room for another image.
+  */
+/// @{
+/** @brief Returns the running firmware image, in place.
+  * @param size Set to the image's size: its code and constant data, and the initial values of its variables,
+  *             which is what the build's .bin holds.
+  */
+const uint8_t *watch_firmware_get_image(uint32_t *size);
+
+/** @brief Returns how big an image can be, in bytes: the space from the start of the image to the top of the array,
+  *        or 0 in the simulator.
+  */
+uint32_t watch_firmware_get_capacity(void);
+
+/** @brief Erases a row of the space above the running image.
+  * @param offset The offset of the row, which must be a multiple of NVMCTRL_ROW_SIZE, and past the running image.
+  * @return false if the row is outside the free space.
+  */
+bool watch_firmware_erase(uint32_t offset);
+
+/** @brief Writes whole pages in the space above the running image, once their row is erased; waits for them.
+  * @param offset The offset of the first page, which must be a multiple of NVMCTRL_PAGE_SIZE, and past the running
+  *               image.
+  * @param buffer The data; a partial last page is padded with 0xFF.
+  * @param size The number of bytes to write.
+  * @return false if the pages are outside the free space.
+  */
+bool watch_firmware_write(uint32_t offset, const uint8_t *buffer, uint32_t size);
+
+/** @brief Copies an image that's been written above the running one over it, and resets into it. Check the image
+  *        before calling this; there's no going back.
+  * @param offset Where the new image starts, which must be a multiple of NVMCTRL_ROW_SIZE.
+  * @param size The new image's size.
+  */
+void watch_firmware_install(uint32_t offset, uint32_t size);
+/// @}
+#endif
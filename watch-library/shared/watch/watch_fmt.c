@@ -0,0 +1,86 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include "watch_fmt.h"
+
+// value / 10 for value up to 1028, without a call to the division routine.
+#define WATCH_FMT_DIV_10(value) (((uint32_t)(value) * 205) >> 11)
+
+char *watch_fmt_2d(char *buf, uint8_t value, char pad) {
+    uint8_t tens = WATCH_FMT_DIV_10(value);
+    buf[0] = tens ? '0' + tens : pad;
+    buf[1] = '0' + value - tens * 10;
+    buf[2] = 0;
+    return buf + 2;
+}
+
+char *watch_fmt_u32(char *buf, uint32_t value, uint8_t width, char pad) {
+    char digits[10];
+    uint8_t count = 0;
+
+    // the digits come out backwards, two at a time while there are more than two to go.
+    while (value >= 100) {
+        uint32_t rest = value / 100;
+        uint8_t pair = value - rest * 100;
+        uint8_t tens = WATCH_FMT_DIV_10(pair);
+        digits[count++] = '0' + pair - tens * 10;
+        digits[count++] = '0' + tens;
+        value = rest;
+    }
+    uint8_t tens = WATCH_FMT_DIV_10(value);
+    digits[count++] = '0' + value - tens * 10;
+    if (tens) digits[count++] = '0' + tens;
+
+    while (width > count) {
+        *buf++ = pad;
+        width--;
+    }
+    while (count) *buf++ = digits[--count];
+    *buf = 0;
+    return buf;
+}
+
+char *watch_fmt_i32(char *buf, int32_t value, uint8_t width, char pad) {
+    if (value >= 0) return watch_fmt_u32(buf, value, width, pad);
+
+    uint32_t magnitude = -(uint32_t)value;
+    uint8_t count = 1;
+    for (uint32_t rest = magnitude; rest >= 10; rest /= 10) count++;
+    // the sign goes after spaces, but before zeros: "   -5" and "-0005".
+    if (pad == ' ') {
+        while (width > count + 1) {
+            *buf++ = ' ';
+            width--;
+        }
+    }
+    *buf++ = '-';
+    return watch_fmt_u32(buf, magnitude, width ? width - 1 : 0, pad);
+}
+
+char *watch_fmt_str(char *buf, const char *str) {
+    while (*str) *buf++ = *str++;
+    *buf = 0;
+    return buf;
+}
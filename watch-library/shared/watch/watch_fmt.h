@@ -0,0 +1,73 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef _WATCH_FMT_H_INCLUDED
+#define _WATCH_FMT_H_INCLUDED
+////< @file watch_fmt.h
+
+#include "watch.h"
+
+/** @addtogroup fmt Number Formatting
+  * @brief This section covers writing numbers out for the display without printf.
+  * @details sprintf goes through newlib's vfprintf, which is several kilobytes of flash and a few thousand cycles a
+  *          call, most of it parsing the format; a clock face that draws its ten characters that way every tick
+  *          spends more time formatting than doing anything else. These write decimal digits straight into a buffer.
+  *          The SAM L22 has no divide instruction, so two-digit numbers, which is most of what's on a watch, split
+  *          with a multiply and a shift, and longer ones two digits at a time.
+  *
+  *          Each function writes its characters, terminates the string and returns a pointer to the terminator, so
+  *          that a display line can be built up a piece at a time:
+  *
+  *              char buf[11];
+  *              char *p = watch_fmt_str(buf, watch_utility_get_weekday(date_time));
+  *              p = watch_fmt_2d(p, date_time.unit.day, ' ');
+  *              ...
+  *
+  *          To change only a few positions, watch_display_2d and watch_display_u32 (in watch_slcd.h) skip the string
+  *          altogether.
+  */
+/// @{
+
+/** @brief Writes a number in decimal, right-aligned in a field, like printf's "%6lu" or "%06lu".
+  * @param width The least number of characters to write; a number with more digits is written in full.
+  * @param pad The character to fill the field with on the left: '0' or ' '.
+  * @return A pointer to the terminating NUL.
+  */
+char *watch_fmt_u32(char *buf, uint32_t value, uint8_t width, char pad);
+
+/** @brief Writes a signed number, with a minus sign before its digits (and after any spaces), like "%5ld".
+  */
+char *watch_fmt_i32(char *buf, int32_t value, uint8_t width, char pad);
+
+/** @brief Writes a number from 0 to 99 in exactly two characters, like "%2d" with a pad of ' ' or "%02d" with '0'.
+  */
+char *watch_fmt_2d(char *buf, uint8_t value, char pad);
+
+/** @brief Copies a string, without its terminator, and terminates the result.
+  */
+char *watch_fmt_str(char *buf, const char *str);
+
+/// @}
+#endif
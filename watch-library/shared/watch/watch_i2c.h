@@ -34,6 +34,7 @@
   */
 /// @{
 /** @brief Enables the I2C peripheral. Call this before attempting to interface with I2C devices.
+  * @note If other code may be using the bus, call watch_claim_peripheral(WATCH_PERIPHERAL_I2C) instead.
   */
 void watch_enable_i2c(void);
 
@@ -102,5 +103,29 @@ uint32_t watch_i2c_read24(int16_t addr, uint8_t reg);
           bit packing, you may need to shuffle some bits around.
   */
 uint32_t watch_i2c_read32(int16_t addr, uint8_t reg);
+
+/** @brief Starts an interrupt-driven transfer: optionally writes some bytes, then optionally reads some back after
+  *        a repeated start. Returns right away; the bytes move on the bus while the CPU renders or sleeps.
+  * @param addr The address of the device you wish to talk to.
+  * @param tx_buf The bytes to send (often just a register address), or NULL if tx_length is 0.
+  * @param tx_length The number of bytes in tx_buf that you wish to send.
+  * @param rx_buf Storage for the incoming bytes, or NULL if rx_length is 0.
+  * @param rx_length The number of bytes that you wish to receive.
+  * @param callback A function to call from the I2C interrupt when the transfer ends, with true if every byte was
+  *                 acknowledged, or NULL if you'd rather poll watch_i2c_is_busy or call watch_i2c_wait.
+  * @return true if the transfer started, false if another one is still in flight or there was nothing to do.
+  * @note Both buffers must stay valid until the transfer ends. Only one async transfer can be in flight at a time;
+  *       the blocking functions above wait for it to finish before they touch the bus.
+  */
+bool watch_i2c_transfer_async(int16_t addr, uint8_t *tx_buf, uint16_t tx_length, uint8_t *rx_buf, uint16_t rx_length, void (*callback)(bool success));
+
+/** @brief Checks whether an async transfer is still in flight.
+  */
+bool watch_i2c_is_busy(void);
+
+/** @brief Sleeps until the current async transfer (if any) has finished.
+  * @return true if the last async transfer succeeded.
+  */
+bool watch_i2c_wait(void);
 /// @}
 #endif
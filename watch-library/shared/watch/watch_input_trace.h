@@ -0,0 +1,132 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _WATCH_INPUT_TRACE_H_INCLUDED
+#define _WATCH_INPUT_TRACE_H_INCLUDED
+////< @file watch_input_trace.h
+
+#include "watch.h"
+
+/** @addtogroup input_trace Input Trace
+  * @brief This section covers recording what the buttons, I2C sensors and ADC told a real watch, and playing it back
+  *        in the simulator.
+  * @details When built with MOVEMENT_INPUT_TRACE defined (make INPUT_TRACE=1), the watch can keep a trace of every
+  *          button edge, every I2C read with the bytes that came back, and every ADC reading. The shell's "trace"
+  *          command starts and stops recording and prints what has been recorded so far; utils/input_trace_record.py
+  *          keeps asking for it and saves it to a file. Timestamps come from the USB task's timer, so recording only
+  *          works while the watch is plugged in. Without MOVEMENT_INPUT_TRACE, the recording hooks compile to nothing.
+  *
+  *          The simulator can play a trace back: the headless build's "replay" script command loads one, after which
+  *          the button edges happen at their recorded times, I2C reads get the recorded bytes and ADC readings the
+  *          recorded values. It all runs on the simulator's virtual clock, so a replay is exactly the same every time
+  *          and runs as fast as the host can go.
+  *
+  *          A trace is a text file with one event per line. Each line starts with the milliseconds since recording
+  *          started; blank lines and lines starting with # are ignored:
+  *
+  *              0 start 2024-01-01 12:00:00      the RTC's date and time when recording started
+  *              1520 btn alarm 1                 a button went down (1) or up (0): light, mode or alarm
+  *              1600 i2c 19 28 f0ff1000e0fe     a read from I2C address 0x19, register 0x28, and the bytes that came back
+  *              2000 adc a2 31250               an ADC reading from one of a0-a4, or the supply voltage (vcc) in mV
+  *
+  *          On playback, reads of each I2C register get the recorded responses in order, one per read, so a FIFO that
+  *          was drained in one burst is drained the same way; a read that comes before the next response is due gets
+  *          the last one again, or the first if none are due yet. An ADC input holds its last recorded value. Writes
+  *          go nowhere, and registers the trace has nothing for read as they do without one.
+  */
+/// @{
+
+#ifndef WATCH_INPUT_TRACE_BUFFER_SIZE
+#define WATCH_INPUT_TRACE_BUFFER_SIZE 2048  ///< Bytes of RAM for events waiting to be printed.
+#endif
+
+#if defined(MOVEMENT_INPUT_TRACE) && !__EMSCRIPTEN__
+
+/** @brief Clears the buffer and starts recording, with a start event carrying the RTC's date and time. */
+void watch_input_trace_start(void);
+
+/** @brief Stops recording. Anything recorded and not yet printed stays in the buffer. */
+void watch_input_trace_stop(void);
+
+/** @brief Returns true while recording. */
+bool watch_input_trace_is_recording(void);
+
+/** @brief Prints the buffered events as trace lines and empties the buffer.
+  * @details If the buffer filled up since the last call, a comment line says how many events were dropped.
+  */
+void watch_input_trace_print(void);
+
+/** @brief Records a button edge. The watch library calls this from the button interrupts. */
+void watch_input_trace_button(uint8_t pin, bool level);
+
+/** @brief Records an I2C read. The watch library calls this after each transfer that read something.
+  * @param addr The device's 7-bit address.
+  * @param reg The register address sent before the read.
+  * @param data The bytes that came back; at most 255 are recorded.
+  */
+void watch_input_trace_i2c(int16_t addr, uint8_t reg, const uint8_t *data, uint16_t length);
+
+/** @brief Records an ADC reading of one of A0-A4, or of WATCH_ADC_VCC in millivolts. */
+void watch_input_trace_adc(uint8_t pin, uint16_t value);
+
+/// Counts one overflow of the USB task's timer, which is where trace timestamps come from.
+void _watch_input_trace_tick(void);
+
+#else
+
+static inline void watch_input_trace_button(uint8_t pin, bool level) { (void) pin; (void) level; }
+static inline void watch_input_trace_i2c(int16_t addr, uint8_t reg, const uint8_t *data, uint16_t length) { (void) addr; (void) reg; (void) data; (void) length; }
+static inline void watch_input_trace_adc(uint8_t pin, uint16_t value) { (void) pin; (void) value; }
+static inline void _watch_input_trace_tick(void) {}
+
+#endif
+
+#if __EMSCRIPTEN__
+
+/** @brief Starts playing back a trace from now on the simulator's clock.
+  * @param text The whole trace file. It is parsed right away and need not outlive the call.
+  * @return false if a line couldn't be parsed, in which case nothing is played back.
+  */
+bool watch_input_trace_replay(const char *text);
+
+/** @brief Stops any playback; I2C and the ADC go back to their stand-in values. */
+void watch_input_trace_replay_stop(void);
+
+/** @brief Fills in an I2C read from the trace being played back.
+  * @return false if there's no playback, or it has nothing for this register.
+  */
+bool _watch_input_trace_replay_i2c(int16_t addr, uint8_t reg, uint8_t *data, uint16_t length);
+
+/** @brief Fills in an ADC reading from the trace being played back.
+  * @return false if there's no playback, or it has nothing for this input.
+  */
+bool _watch_input_trace_replay_adc(uint8_t pin, uint16_t *value);
+
+/// Presses or releases a button, as if it had happened in the browser. Implemented with the simulator's buttons.
+void _watch_extint_inject(uint8_t pin, bool level);
+
+#endif
+
+/// @}
+#endif
@@ -41,10 +41,9 @@
   */
 /// @{
 /** @brief Enables the bi-color LED.
-  * @note The TCC peripheral that drives the LEDs does not run in STANDBY mode — but the outputs do! This
-  *       means that if you set either red, green or both LEDs to full power, they will shine even when
-  *       your app is asleep. If, however, you set a custom color using watch_set_led_color, the color will
-  *       not display correctly in STANDBY mode. You will need to keep your app running while the LED is on.
+  * @note While either LED is lit, the TCC peripheral that drives them keeps running in STANDBY mode, so any
+  *       color displays correctly while your app is asleep. The TCC still needs the main oscillator, so a
+  *       lit LED costs that as well as its own current; turn it off when you're done.
   */
 void watch_enable_leds(void);
 
@@ -57,9 +56,8 @@ void watch_disable_leds(void);
 /** @brief Sets the LED to a custom color by modulating each output's duty cycle.
   * @param red The red value from 0-255.
   * @param green The green value from 0-255. If your watch has a red/blue LED, this will be the blue value.
-  * @note If you are displaying a custom color, you will need to prevent your app from going to sleep
-  *       while the LED is on; otherwise, the color will not display correctly. You can do this by
-  *       returning false in your app_loop method.
+  * @note You don't need to keep your app awake while the LED is on; the PWM runs in STANDBY mode until
+  *       both values are set back to 0.
   */
 void watch_set_led_color(uint8_t red, uint8_t green);
 
@@ -84,5 +82,38 @@ void watch_set_led_yellow(void);
 /** @brief Turns both the red and the green LEDs off. */
 void watch_set_led_off(void);
 
+/// The most steps a pattern for watch_led_play_pattern can have.
+#define WATCH_LED_PATTERN_MAX_STEPS 32
+
+/// One step of an LED pattern: a color, as for watch_set_led_color.
+typedef struct {
+    uint8_t red;
+    uint8_t green;
+} watch_led_step_t;
+
+/** @brief Plays a blink, fade or any other sequence of colors on the LED, without the CPU.
+  * @details On the watch, a timer clocked by the crystal moves the DMAC along the pattern, and the DMAC copies each
+  *          step's duty cycles into the TCC. The pattern carries on while your app sleeps in STANDBY mode, and costs
+  *          the LED's current and nothing else: the CPU only wakes at the end of each loop through the pattern, and
+  *          not at all if it loops forever. Setting the LED's color, or disabling it (or the buzzer), stops the
+  *          pattern.
+  * @param steps The colors to show, in order. They're copied, so the array can go once this returns.
+  * @param num_steps The number of steps, from 1 to WATCH_LED_PATTERN_MAX_STEPS.
+  * @param step_ms How long each step shows, in milliseconds. The timer counts in 1/512 seconds, so this is rounded
+  *                down to the nearest two milliseconds or so.
+  * @param loops How many times to play the pattern, or 0 to loop until it's stopped.
+  * @param callback Called, from an interrupt, once the last step of the last loop is over and the LED is off again.
+  *                 May be NULL.
+  * @return false if the LEDs aren't enabled, or num_steps is out of range.
+  */
+bool watch_led_play_pattern(const watch_led_step_t *steps, uint8_t num_steps, uint16_t step_ms, uint8_t loops,
+                            ext_irq_cb_t callback);
+
+/// @brief Stops the pattern that watch_led_play_pattern started, if there is one, and turns the LED off.
+void watch_led_stop_pattern(void);
+
+/// @brief Returns true while a pattern that watch_led_play_pattern started is playing.
+bool watch_led_pattern_is_playing(void);
+
 /// @}
 #endif
@@ -0,0 +1,125 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _WATCH_LOG_H_INCLUDED
+#define _WATCH_LOG_H_INCLUDED
+////< @file watch_log.h
+
+#include <stdint.h>
+#include <stdio.h>
+
+/** @addtogroup log Log
+  * @brief This section covers logging from code where printf would cost too much.
+  * @details printf formats on the watch, which takes thousands of cycles for a line, and then waits on USB serial.
+  *          These macros leave the formatting to the host. The format string goes into the firmware's .watch_log
+  *          section, which the linker script keeps in the ELF but out of flash, and at run time only its offset in
+  *          that section and the arguments go into a ring in RAM: a few dozen cycles. Movement's main loop sends
+  *          what's in the ring over USB serial as it has room, one line a record, and utils/log_decode.py, given the
+  *          ELF, turns those lines back into text. Records logged before USB comes up wait in the ring, so messages
+  *          from boot get through too.
+  *
+  *          Arguments are stored as 32-bit words, so only integers up to 32 bits and the conversions that print
+  *          them (%d, %u, %x, %c and the like) are supported; no strings or floats. A line of the format string can
+  *          use at most WATCH_LOG_MAX_ARGS arguments.
+  *
+  *          Each message has a level, and messages above WATCH_LOG_LEVEL (make LOG_LEVEL=debug, for instance) are
+  *          compiled out entirely, arguments and all, so a build without debug logging runs exactly the code it
+  *          would have without the log lines. In the simulator the macros are printf, with a line break added.
+  */
+/// @{
+
+#define WATCH_LOG_LEVEL_NONE 0
+#define WATCH_LOG_LEVEL_ERROR 1
+#define WATCH_LOG_LEVEL_WARN 2
+#define WATCH_LOG_LEVEL_INFO 3
+#define WATCH_LOG_LEVEL_DEBUG 4
+
+#ifndef WATCH_LOG_LEVEL
+#define WATCH_LOG_LEVEL WATCH_LOG_LEVEL_INFO    ///< The most detailed level that gets compiled in.
+#endif
+
+#ifndef WATCH_LOG_BUFFER_WORDS
+#define WATCH_LOG_BUFFER_WORDS 256              ///< 32-bit words of RAM for records waiting to be sent.
+#endif
+
+#define WATCH_LOG_MAX_ARGS 8
+
+#if __EMSCRIPTEN__
+
+#define _WATCH_LOG(level, format, ...) printf(format "\r\n", ##__VA_ARGS__)
+
+static inline void watch_log_drain(void) {}
+
+#else
+
+// the level is the format string's first character, so that the host can tell them apart.
+#define _WATCH_LOG(level, format, ...) do { \
+    static const char _watch_log_format[] __attribute__((section(".watch_log"), used)) = level format; \
+    const uint32_t _watch_log_args[] = { 0, ##__VA_ARGS__ }; \
+    _Static_assert(sizeof(_watch_log_args) / sizeof(uint32_t) <= WATCH_LOG_MAX_ARGS + 1, "too many log arguments"); \
+    _watch_log_write(_watch_log_format, _watch_log_args + 1, sizeof(_watch_log_args) / sizeof(uint32_t) - 1); \
+} while (0)
+
+/** @brief Queues a record. Called by the logging macros; safe to call from interrupts.
+  * @details If the ring is full, the record is dropped and counted, and the next line sent says how many were.
+  */
+void _watch_log_write(const char *format, const uint32_t *args, uint8_t num_args);
+
+/** @brief Sends as many queued records over USB serial as it has room for, without waiting. Movement calls this from
+  *        its main loop while USB is connected.
+  */
+void watch_log_drain(void);
+
+#endif
+
+// a message that's compiled out still gets its format checked and its arguments counted as used, so that turning a
+// level off doesn't bring warnings; the compiler drops it all the same.
+#define _WATCH_LOG_NOTHING(format, ...) do { if (0) printf(format, ##__VA_ARGS__); } while (0)
+
+#if WATCH_LOG_LEVEL >= WATCH_LOG_LEVEL_ERROR
+#define WATCH_LOG_ERROR(format, ...) _WATCH_LOG("E", format, ##__VA_ARGS__)
+#else
+#define WATCH_LOG_ERROR(format, ...) _WATCH_LOG_NOTHING(format, ##__VA_ARGS__)
+#endif
+
+#if WATCH_LOG_LEVEL >= WATCH_LOG_LEVEL_WARN
+#define WATCH_LOG_WARN(format, ...) _WATCH_LOG("W", format, ##__VA_ARGS__)
+#else
+#define WATCH_LOG_WARN(format, ...) _WATCH_LOG_NOTHING(format, ##__VA_ARGS__)
+#endif
+
+#if WATCH_LOG_LEVEL >= WATCH_LOG_LEVEL_INFO
+#define WATCH_LOG_INFO(format, ...) _WATCH_LOG("I", format, ##__VA_ARGS__)
+#else
+#define WATCH_LOG_INFO(format, ...) _WATCH_LOG_NOTHING(format, ##__VA_ARGS__)
+#endif
+
+#if WATCH_LOG_LEVEL >= WATCH_LOG_LEVEL_DEBUG
+#define WATCH_LOG_DEBUG(format, ...) _WATCH_LOG("D", format, ##__VA_ARGS__)
+#else
+#define WATCH_LOG_DEBUG(format, ...) _WATCH_LOG_NOTHING(format, ##__VA_ARGS__)
+#endif
+
+/// @}
+#endif
@@ -0,0 +1,267 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <math.h>
+#include <stdbool.h>
+#include "watch_math.h"
+
+#define WATCH_MATH_PI 3.14159265358979f
+#define WATCH_MATH_PI_2 1.57079632679490f
+#define WATCH_MATH_PI_4 0.78539816339745f
+
+// π/2 in three parts, each with few enough bits that k times it is exact for any quadrant k we reduce by.
+#define WATCH_MATH_PI_2_A 1.5703125f
+#define WATCH_MATH_PI_2_B 4.837512969970703125e-4f
+#define WATCH_MATH_PI_2_C 7.54978995489188216e-8f
+
+// ln 2 in two parts, the same way.
+#define WATCH_MATH_LN2_A 0.693359375f
+#define WATCH_MATH_LN2_B -2.12194440e-4f
+
+// the polynomials are minimax fits from Stephen Moshier's Cephes library, which are good to float precision over
+// the reduced ranges used here.
+
+// sin r for |r| <= π/4.
+static inline float _watch_math_sin_kernel(float r) {
+    float z = r * r;
+    return ((-1.9515295891e-4f * z + 8.3321608736e-3f) * z - 1.6666654611e-1f) * z * r + r;
+}
+
+// cos r for |r| <= π/4.
+static inline float _watch_math_cos_kernel(float r) {
+    float z = r * r;
+    return ((2.443315711809948e-5f * z - 1.388731625493765e-3f) * z + 4.166664568298827e-2f) * z * z - 0.5f * z + 1.0f;
+}
+
+// atan t for 0 <= t <= 1.
+static inline float _watch_math_atan_kernel(float t) {
+    float offset = 0;
+    // past tan(π/8), atan t is π/4 + atan((t - 1) / (t + 1)), which brings the argument back under it.
+    if (t > 0.4142135623730950f) {
+        t = (t - 1.0f) / (t + 1.0f);
+        offset = WATCH_MATH_PI_4;
+    }
+    float z = t * t;
+    float p = ((8.05374449538e-2f * z - 1.38776856032e-1f) * z + 1.99777106478e-1f) * z - 3.33329491539e-1f;
+    return offset + p * z * t + t;
+}
+
+// asin a for 0 <= a <= 0.5.
+static inline float _watch_math_asin_kernel(float a) {
+    float z = a * a;
+    float p = (((4.2163199048e-2f * z + 2.4181311049e-2f) * z + 4.5470025998e-2f) * z + 7.4953002686e-2f) * z
+              + 1.6666752422e-1f;
+    return p * z * a + a;
+}
+
+// x less the nearest multiple of π/2, and which multiple that was.
+static inline float _watch_math_reduce(float x, int32_t *quadrant) {
+    int32_t k = (int32_t)(x * (2.0f / WATCH_MATH_PI) + (x < 0 ? -0.5f : 0.5f));
+    *quadrant = k;
+    float kf = (float)k;
+    return ((x - kf * WATCH_MATH_PI_2_A) - kf * WATCH_MATH_PI_2_B) - kf * WATCH_MATH_PI_2_C;
+}
+
+float watch_sinf(float x) {
+    int32_t quadrant;
+    float r = _watch_math_reduce(x, &quadrant);
+    float value = (quadrant & 1) ? _watch_math_cos_kernel(r) : _watch_math_sin_kernel(r);
+    return (quadrant & 2) ? -value : value;
+}
+
+float watch_cosf(float x) {
+    int32_t quadrant;
+    float r = _watch_math_reduce(x, &quadrant);
+    float value = (quadrant & 1) ? _watch_math_sin_kernel(r) : _watch_math_cos_kernel(r);
+    return ((quadrant + 1) & 2) ? -value : value;
+}
+
+float watch_atan2f(float y, float x) {
+    float ax = fabsf(x);
+    float ay = fabsf(y);
+    if (ax == 0 && ay == 0) return 0;
+
+    // atan of the smaller over the larger, so that the kernel only sees 0 to 1, then back to the right octant.
+    float angle;
+    if (ay > ax) angle = WATCH_MATH_PI_2 - _watch_math_atan_kernel(ax / ay);
+    else angle = _watch_math_atan_kernel(ay / ax);
+    if (x < 0) angle = WATCH_MATH_PI - angle;
+    return y < 0 ? -angle : angle;
+}
+
+float watch_asinf(float x) {
+    float a = fabsf(x);
+    if (a > 1.0f) return NAN;
+    float angle;
+    if (a > 0.5f) {
+        // asin a is π/2 - 2 asin(sqrt((1 - a) / 2)), which keeps the kernel away from 1, where asin is steep.
+        angle = WATCH_MATH_PI_2 - 2.0f * _watch_math_asin_kernel(sqrtf(0.5f * (1.0f - a)));
+    } else {
+        angle = _watch_math_asin_kernel(a);
+    }
+    return x < 0 ? -angle : angle;
+}
+
+float watch_acosf(float x) {
+    if (x < -1.0f || x > 1.0f) return NAN;
+    if (x > 0.5f) return 2.0f * _watch_math_asin_kernel(sqrtf(0.5f * (1.0f - x)));
+    if (x < -0.5f) return WATCH_MATH_PI - 2.0f * _watch_math_asin_kernel(sqrtf(0.5f * (1.0f + x)));
+    return WATCH_MATH_PI_2 - (x < 0 ? -_watch_math_asin_kernel(-x) : _watch_math_asin_kernel(x));
+}
+
+// value * 2^n, for n from -252 to 254, by building the power of two from its bits.
+static inline float _watch_math_scale(float value, int32_t n) {
+    union { float f; uint32_t u; } power;
+    if (n > 127) {
+        value *= 1.7014118e38f; // 2^127
+        n -= 127;
+    } else if (n < -126) {
+        value *= 1.1754944e-38f; // 2^-126
+        n += 126;
+    }
+    power.u = (uint32_t)(n + 127) << 23;
+    return value * power.f;
+}
+
+float watch_expf(float x) {
+    if (x > 88.72283f) return INFINITY;
+    if (x < -87.33654f) return 0;
+    if (x != x) return x;
+
+    // e^x is 2^n e^r, with n the nearest whole number to x / ln 2 and r what's left, no more than ln 2 / 2.
+    int32_t n = (int32_t)(x * 1.44269504088896f + (x < 0 ? -0.5f : 0.5f));
+    float r = x - (float)n * WATCH_MATH_LN2_A - (float)n * WATCH_MATH_LN2_B;
+    float p = ((((1.9875691500e-4f * r + 1.3981999507e-3f) * r + 8.3334519073e-3f) * r + 4.1665795894e-2f) * r
+               + 1.6666665459e-1f) * r + 5.0000001201e-1f;
+    return _watch_math_scale(p * r * r + r + 1.0f, n);
+}
+
+float watch_logf(float x) {
+    union { float f; uint32_t u; } bits = { .f = x };
+    if (x != x || x == INFINITY) return x;
+    if (x < 0) return NAN;
+    int32_t e = (int32_t)((bits.u >> 23) & 0xFF);
+    if (e == 0) return -INFINITY;
+
+    // x is m 2^e, with m from 1/sqrt(2) to sqrt(2), so that ln x is e ln 2 + ln m, and ln m is near 0.
+    e -= 126;
+    bits.u = (bits.u & 0x007FFFFF) | 0x3F000000;
+    float m = bits.f;
+    if (m < 0.70710678118654752f) {
+        e--;
+        m = m + m - 1.0f;
+    } else {
+        m = m - 1.0f;
+    }
+    float z = m * m;
+    float y = ((((((((7.0376836292e-2f * m - 1.1514610310e-1f) * m + 1.1676998740e-1f) * m - 1.2420140846e-1f) * m
+              + 1.4249322787e-1f) * m - 1.6668057665e-1f) * m + 2.0000714765e-1f) * m - 2.4999993993e-1f) * m
+              + 3.3333331174e-1f) * m * z;
+    float ef = (float)e;
+    y += ef * WATCH_MATH_LN2_B;
+    y -= 0.5f * z;
+    return m + y + ef * WATCH_MATH_LN2_A;
+}
+
+float watch_powf(float x, float y) {
+    if (y == 0) return 1.0f;
+    if (x == 0) return y > 0 ? 0 : INFINITY;
+
+    bool negate = false;
+    if (x < 0) {
+        // only whole powers of a negative number are real; the odd ones are negative.
+        float ay = fabsf(y);
+        if (ay < 16777216.0f) {
+            int32_t whole = (int32_t)ay;
+            if ((float)whole != ay) return NAN;
+            negate = whole & 1;
+        }
+        x = -x;
+    }
+    float value = watch_expf(y * watch_logf(x));
+    return negate ? -value : value;
+}
+
+int16_t watch_sin_q15(uint16_t angle) {
+    uint8_t quadrant = angle >> 14;
+    // z is how far into the quarter turn from 0 to 1 we are, in Q15, mirrored in the quadrants where sin falls.
+    int32_t z = (angle & 0x3FFF) << 1;
+    if (quadrant & 1) z = 32768 - z;
+
+    // sin(π/2 z) as an odd polynomial, fitted to within 0.02 LSB.
+    int32_t z2 = (z * z + 16384) >> 15;
+    int32_t p = -142;
+    p = 2603 + ((p * z2 + 16384) >> 15);
+    p = -21165 + ((p * z2 + 16384) >> 15);
+    p = 51472 + ((p * z2 + 16384) >> 15);
+    int32_t value = (p * z + 16384) >> 15;
+    if (value > 32767) value = 32767;
+    return (quadrant & 2) ? -value : value;
+}
+
+int16_t watch_cos_q15(uint16_t angle) {
+    return watch_sin_q15(angle + 16384);
+}
+
+// atan(2^-i) in 2^20ths of a turn: sixteen times finer than the result, so that rounding doesn't pile up.
+static const int32_t _watch_math_cordic_angles[16] = {
+    131072, 77376, 40884, 20753, 10417, 5213, 2607, 1304, 652, 326, 163, 81, 41, 20, 10, 5
+};
+
+uint16_t watch_atan2_q16(int32_t y, int32_t x) {
+    if (x == 0 && y == 0) return 0;
+
+    int32_t angle = 0;
+    // the rotations only reach a quarter turn either way, so start from the right half of the plane.
+    if (x < 0) {
+        x = -x;
+        y = -y;
+        angle = 1 << 19;
+    }
+    // small points would lose their bits to the shifts; scale them up as far as is safe, to just under 2^29.
+    uint32_t magnitude = (uint32_t)x | (uint32_t)(y < 0 ? -y : y);
+    int8_t shift = __builtin_clz(magnitude) - 3;
+    if (shift > 0) {
+        x <<= shift;
+        y <<= shift;
+    }
+
+    // rotate the point onto the x axis, adding up the angles it took to get there.
+    for (uint8_t i = 0; i < 16; i++) {
+        int32_t dx = y >> i;
+        int32_t dy = x >> i;
+        if (y > 0) {
+            x += dx;
+            y -= dy;
+            angle += _watch_math_cordic_angles[i];
+        } else {
+            x -= dx;
+            y += dy;
+            angle -= _watch_math_cordic_angles[i];
+        }
+    }
+
+    return (uint16_t)((angle + 8) >> 4);
+}
@@ -0,0 +1,103 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef _WATCH_MATH_H_INCLUDED
+#define _WATCH_MATH_H_INCLUDED
+////< @file watch_math.h
+
+#include <stdint.h>
+
+/** @addtogroup math Fast Math
+  * @brief This section covers quick approximations of the libm functions that the astronomy code leans on.
+  * @details The SAM L22 has no FPU, so newlib's sinf and friends are emulated a soft-float operation at a time, with
+  *          the argument reduction and special cases a general-purpose libm has to get right for every input. These
+  *          reduce the argument once and evaluate a short minimax polynomial (the float versions), or work in
+  *          fixed point with shifts and adds (the Q-format versions), which is several times faster and a fraction
+  *          of the code. They are not correctly rounded; each function's error bound, measured against double
+  *          precision libm over the whole range given, is in its documentation.
+  *
+  *          sunriset and astrolib use the float versions when built with FAST_MATH=1 (see make.mk), which also
+  *          builds them in single precision. Code that needs double precision, like the VSOP87 series and anything
+  *          handling Julian dates, should keep calling libm.
+  */
+/// @{
+
+/** @brief sin x. Within 8e-8 of the true value for |x| up to 8192, and within 1e-6 up to 65536; much past that, the
+  *        argument reduction falls apart.
+  */
+float watch_sinf(float x);
+
+/** @brief cos x. Within 8e-8 of the true value for |x| up to 8192, and within 1e-6 up to 65536.
+  */
+float watch_cosf(float x);
+
+/** @brief atan2(y, x), from -π to π. Within 3e-7 radians (about 2 ulp of π) of the true value; atan2(0, 0) is 0.
+  */
+float watch_atan2f(float y, float x);
+
+/** @brief asin x, for x from -1 to 1. Within 1.7e-7 radians of the true value. Outside the range, returns NaN.
+  */
+float watch_asinf(float x);
+
+/** @brief acos x, for x from -1 to 1. Within 3.1e-7 radians (about 1 ulp of π) of the true value. Outside the
+  *        range, returns NaN.
+  */
+float watch_acosf(float x);
+
+/** @brief e^x. Within 1 ulp of the true value; overflows to infinity past x = 88.7, and is 0 below x = -87.3
+  *        rather than going subnormal.
+  */
+float watch_expf(float x);
+
+/** @brief ln x. Within 1 ulp of the true value; -infinity for 0 and NaN for negative numbers. Subnormal inputs are
+  *        treated as 0.
+  */
+float watch_logf(float x);
+
+/** @brief x^y, as e^(y ln x). The error grows with |y ln x|, since the rounding in ln x is multiplied by it: within
+  *        (1 + 2 |y ln x|) ulp, which is about 1e-5 relative for a result near float's largest. A negative x is
+  *        allowed if y is a whole number.
+  */
+float watch_powf(float x, float y);
+
+/** @brief sin of a binary angle, in Q1.15 fixed point (32767 is 1).
+  * @param angle The angle in 65536ths of a turn, so that it wraps around as the uint16_t does.
+  * @return The sine, within 2 LSB (6e-5) of the true value.
+  */
+int16_t watch_sin_q15(uint16_t angle);
+
+/** @brief cos of a binary angle, in Q1.15 fixed point. See watch_sin_q15.
+  */
+int16_t watch_cos_q15(uint16_t angle);
+
+/** @brief atan2(y, x) as a binary angle, by CORDIC: sixteen rotations of shifts and adds, no divides or multiplies.
+  * @param y, x The point, in any fixed-point format as long as both are the same; each must be within ±2^29.
+  * @return The angle in 65536ths of a turn, counterclockwise from the positive x axis, within 1.1 of the true value
+  *         (0.006 degrees). atan2(0, 0) is 0.
+  */
+uint16_t watch_atan2_q16(int32_t y, int32_t x);
+
+/// @}
+#endif
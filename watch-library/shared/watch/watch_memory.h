@@ -0,0 +1,62 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _WATCH_MEMORY_H_INCLUDED
+#define _WATCH_MEMORY_H_INCLUDED
+////< @file watch_memory.h
+
+#include <stddef.h>
+
+/** @addtogroup memory Stack and Heap
+  * @brief This section covers how much of the stack and the heap have been used since boot.
+  * @details The linker script sets aside STACK_SIZE bytes for the stack, right after the zeroed variables, and gives
+  *          the heap everything from there to the end of RAM. At boot, before anything else runs, the startup code
+  *          fills the stack's unused words with a pattern; the deepest the stack has gone is where the pattern
+  *          stops. The heap's high water mark is the most it has asked the system for. Between them, they say how
+  *          much RAM the firmware really needs, and so whether STACK_SIZE could come down. A call graph of each
+  *          function's frame, from a build with STACK_USAGE=1, says which paths go deepest (make stack-report).
+  *
+  *          In the simulator all of these are 0.
+  */
+/// @{
+
+/** @brief Returns the size of the stack, in bytes. */
+size_t watch_get_stack_size(void);
+
+/** @brief Returns the most of the stack that has been in use at once since boot, in bytes.
+  * @details This scans the stack for the pattern it was filled with at boot, so it takes a few thousand cycles. A
+  *          function whose frame skipped words it never wrote could hide a little of its depth.
+  */
+size_t watch_get_stack_high_water(void);
+
+/** @brief Returns how much RAM the heap can grow into, in bytes. */
+size_t watch_get_heap_size(void);
+
+/** @brief Returns the most the heap has taken from the system since boot, in bytes. malloc keeps what it frees for
+  *        later, so this doesn't come down.
+  */
+size_t watch_get_heap_high_water(void);
+
+/// @}
+#endif
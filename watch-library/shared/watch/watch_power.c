@@ -0,0 +1,103 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "watch_power.h"
+
+static uint8_t _claims[WATCH_NUM_PERIPHERALS];
+static uint8_t _powered;
+
+static void _watch_power_up(watch_peripheral_t peripheral) {
+    switch (peripheral) {
+        case WATCH_PERIPHERAL_ADC:
+            watch_enable_adc();
+            break;
+        case WATCH_PERIPHERAL_I2C:
+            watch_enable_i2c();
+            break;
+        case WATCH_PERIPHERAL_SPI:
+            watch_enable_spi();
+            break;
+        default:
+            return;
+    }
+    _powered |= 1 << peripheral;
+}
+
+static void _watch_power_down(watch_peripheral_t peripheral) {
+    switch (peripheral) {
+        case WATCH_PERIPHERAL_ADC:
+            watch_disable_adc();
+            break;
+        case WATCH_PERIPHERAL_I2C:
+            watch_disable_i2c();
+            break;
+        case WATCH_PERIPHERAL_SPI:
+            watch_disable_spi();
+            break;
+        default:
+            return;
+    }
+    _powered &= ~(1 << peripheral);
+}
+
+void watch_claim_peripheral(watch_peripheral_t peripheral) {
+    if (peripheral >= WATCH_NUM_PERIPHERALS) return;
+    if (_claims[peripheral] < UINT8_MAX) _claims[peripheral]++;
+    // a peripheral can be off while claimed if sleep mode turned it off, so check the power rather than the count.
+    if (!(_powered & (1 << peripheral))) _watch_power_up(peripheral);
+}
+
+void watch_release_peripheral(watch_peripheral_t peripheral) {
+    if (peripheral >= WATCH_NUM_PERIPHERALS || _claims[peripheral] == 0) return;
+    if (--_claims[peripheral] == 0 && (_powered & (1 << peripheral))) _watch_power_down(peripheral);
+}
+
+uint8_t watch_get_peripheral_claims(watch_peripheral_t peripheral) {
+    if (peripheral >= WATCH_NUM_PERIPHERALS) return 0;
+    return _claims[peripheral];
+}
+
+bool watch_is_peripheral_powered(watch_peripheral_t peripheral) {
+    if (peripheral >= WATCH_NUM_PERIPHERALS) return false;
+    return !!(_powered & (1 << peripheral));
+}
+
+const char *watch_get_peripheral_name(watch_peripheral_t peripheral) {
+    static const char *names[WATCH_NUM_PERIPHERALS] = {"adc", "i2c", "spi"};
+    if (peripheral >= WATCH_NUM_PERIPHERALS) return "?";
+    return names[peripheral];
+}
+
+void _watch_power_suspend(void) {
+    // these go off for sleep whether or not anyone claimed them, which also catches direct calls to the enable functions.
+    watch_disable_adc();
+    watch_disable_i2c();
+    _powered &= ~((1 << WATCH_PERIPHERAL_ADC) | (1 << WATCH_PERIPHERAL_I2C));
+}
+
+void _watch_power_resume(void) {
+    for (uint8_t i = 0; i < WATCH_NUM_PERIPHERALS; i++) {
+        if (_claims[i] && !(_powered & (1 << i))) _watch_power_up((watch_peripheral_t)i);
+    }
+}
@@ -0,0 +1,78 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _WATCH_POWER_H_INCLUDED
+#define _WATCH_POWER_H_INCLUDED
+////< @file watch_power.h
+
+#include "watch.h"
+
+/** @addtogroup power Peripheral Power
+  * @brief This section covers functions for sharing the ADC, I2C and SPI peripherals between drivers and watch faces.
+  * @details Calling watch_enable_i2c and watch_disable_i2c directly works, but if two users share the bus, the first
+  *          one to finish turns it off under the other, and a user that forgets to turn it off leaves it drawing power.
+  *          Instead, each user can claim a peripheral before using it and release it when done. The peripheral is
+  *          powered up by the first claim and its APB clock is gated again when the last claim is released.
+  *
+  *          Sleep mode still turns the ADC and I2C off, whoever holds them. Claims survive the sleep: waking with
+  *          watch_enter_sleep_mode powers claimed peripherals back up before app_setup, and after
+  *          watch_enter_sleep_mode_minimal_resume, a peripheral is powered back up by the next claim on it.
+  */
+/// @{
+
+typedef enum {
+    WATCH_PERIPHERAL_ADC = 0,
+    WATCH_PERIPHERAL_I2C,
+    WATCH_PERIPHERAL_SPI,
+    WATCH_NUM_PERIPHERALS
+} watch_peripheral_t;
+
+/** @brief Claims a peripheral, powering it up if it isn't already on.
+  * @param peripheral The peripheral you intend to use.
+  * @note Every claim must be balanced by a call to watch_release_peripheral.
+  */
+void watch_claim_peripheral(watch_peripheral_t peripheral);
+
+/** @brief Releases a claim on a peripheral, powering it down if no other claims are outstanding.
+  * @param peripheral A peripheral you previously claimed.
+  */
+void watch_release_peripheral(watch_peripheral_t peripheral);
+
+/** @brief Returns the number of outstanding claims on a peripheral.
+  * @param peripheral The peripheral to check.
+  */
+uint8_t watch_get_peripheral_claims(watch_peripheral_t peripheral);
+
+/** @brief Returns true if a peripheral was powered up through watch_claim_peripheral and is still on.
+  * @param peripheral The peripheral to check.
+  */
+bool watch_is_peripheral_powered(watch_peripheral_t peripheral);
+
+/** @brief Returns a short name for a peripheral, i.e. "i2c", for logging.
+  * @param peripheral The peripheral to name.
+  */
+const char *watch_get_peripheral_name(watch_peripheral_t peripheral);
+
+/// @}
+#endif
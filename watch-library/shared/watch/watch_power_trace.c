@@ -0,0 +1,49 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "watch_power_trace.h"
+
+#ifdef MOVEMENT_POWER_TRACE
+
+static watch_power_trace_region_t _region;
+
+void watch_power_trace_init(void) {
+    watch_enable_digital_output(WATCH_POWER_TRACE_PIN_0);
+    watch_enable_digital_output(WATCH_POWER_TRACE_PIN_1);
+    watch_enable_digital_output(WATCH_POWER_TRACE_PIN_2);
+    _region = WATCH_POWER_TRACE_NONE;
+    watch_power_trace_set(WATCH_POWER_TRACE_NONE);
+}
+
+watch_power_trace_region_t watch_power_trace_set(watch_power_trace_region_t region) {
+    watch_power_trace_region_t previous = _region;
+    _region = region;
+    watch_set_pin_level(WATCH_POWER_TRACE_PIN_0, region & 1);
+    watch_set_pin_level(WATCH_POWER_TRACE_PIN_1, region & 2);
+    watch_set_pin_level(WATCH_POWER_TRACE_PIN_2, region & 4);
+
+    return previous;
+}
+
+#endif
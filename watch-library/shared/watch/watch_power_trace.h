@@ -0,0 +1,83 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _WATCH_POWER_TRACE_H_INCLUDED
+#define _WATCH_POWER_TRACE_H_INCLUDED
+////< @file watch_power_trace.h
+
+#include "watch.h"
+
+/** @addtogroup power_trace Power Trace
+  * @brief This section covers markers for lining up a power analyzer's current trace with the code that drew it.
+  * @details When built with MOVEMENT_POWER_TRACE defined (make POWER_TRACE=1), the watch puts the number of the code
+  *          region it's in on three sensor board pins, as a binary number. Connect them to the digital inputs of a
+  *          Joulescope or Power Profiler Kit, record, and utils/power_trace_energy.py will add up the time and energy
+  *          spent in each region. Regions nest: entering one saves the region it interrupted, and leaving it puts
+  *          that one back. The pins change one at a time, so a change can show an in-between code for a few cycles.
+  *
+  *          Without MOVEMENT_POWER_TRACE, these functions compile to nothing.
+  */
+/// @{
+
+#ifndef WATCH_POWER_TRACE_PIN_0
+#define WATCH_POWER_TRACE_PIN_0 A0  ///< The pin with bit 0 of the region number.
+#endif
+#ifndef WATCH_POWER_TRACE_PIN_1
+#define WATCH_POWER_TRACE_PIN_1 A1  ///< The pin with bit 1 of the region number.
+#endif
+#ifndef WATCH_POWER_TRACE_PIN_2
+#define WATCH_POWER_TRACE_PIN_2 A2  ///< The pin with bit 2 of the region number.
+#endif
+
+typedef enum {
+    WATCH_POWER_TRACE_NONE = 0,     ///< Outside of any region: startup, and interrupts before the app runs.
+    WATCH_POWER_TRACE_SLEEP,        ///< In standby, or idle while on USB.
+    WATCH_POWER_TRACE_APP_LOOP,     ///< In the app's loop, outside of anything more specific.
+    WATCH_POWER_TRACE_FACE,         ///< In a watch face's loop, handling a foreground event.
+    WATCH_POWER_TRACE_BACKGROUND,   ///< In a watch face's loop, handling a background task.
+    WATCH_POWER_TRACE_DISPLAY,      ///< Writing the framebuffer out to the LCD.
+    WATCH_POWER_TRACE_USER_1,       ///< Free for a watch face to mark something of its own.
+    WATCH_POWER_TRACE_USER_2,       ///< Free for a watch face to mark something of its own.
+} watch_power_trace_region_t;
+
+#ifdef MOVEMENT_POWER_TRACE
+
+/** @brief Sets up the trace pins as outputs. The watch library does this at startup. */
+void watch_power_trace_init(void);
+
+/** @brief Moves the trace to a region.
+  * @param region The region you're entering.
+  * @return The region you were in, which you should pass back to this function when you leave.
+  */
+watch_power_trace_region_t watch_power_trace_set(watch_power_trace_region_t region);
+
+#else
+
+static inline void watch_power_trace_init(void) {}
+static inline watch_power_trace_region_t watch_power_trace_set(watch_power_trace_region_t region) { (void) region; return WATCH_POWER_TRACE_NONE; }
+
+#endif
+
+/// @}
+#endif
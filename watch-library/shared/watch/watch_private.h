@@ -29,6 +29,25 @@
 /// Called by main.c while setting up the app. You should not call this from your app.
 void _watch_init(void);
 
+/// Called by watch_random_refill to fill words with true entropy, all in one session. You should not call this from your app.
+void _watch_random_collect(uint32_t *words, uint8_t count);
+
+/// Called by watch_crc32_update to run the CRC-32 register (zlib's, before its final inversion) over whole words in
+/// hardware. Returns false if it can't, and the caller does them in software. You should not call this from your app.
+bool _watch_crc32_words(uint32_t *crc, const uint32_t *words, size_t count);
+
+/// Called by the AES functions to load a 16 byte key, for encrypting or decrypting. You should not call this from your app.
+void _watch_aes_begin(const uint8_t *key, bool encrypt);
+
+/// Called by the AES functions to run one 16 byte block through the key loaded; in and out may be the same. You should not call this from your app.
+void _watch_aes_block(const uint8_t *in, uint8_t *out);
+
+/// Called by the AES functions when they're done, to forget the key. You should not call this from your app.
+void _watch_aes_end(void);
+
+/// Called by main.c as soon as the clocks are running, to start the boot clock. You should not call this from your app.
+void _watch_boot_clock_start(void);
+
 /// Initializes the real-time clock peripheral.
 void _watch_rtc_init(void);
 
@@ -38,6 +57,13 @@ void _watch_enable_tcc(void);
 /// Called by buzzer and LED teardown functions. You should not call this from your app.
 void _watch_disable_tcc(void);
 
+#define WATCH_TCC_STANDBY_BUZZER (1 << 0)
+#define WATCH_TCC_STANDBY_LED (1 << 1)
+
+/// Called by the buzzer and LED functions to keep the TCC running in STANDBY while any of them needs it (one of
+/// WATCH_TCC_STANDBY_BUZZER or WATCH_TCC_STANDBY_LED). You should not call this from your app.
+void _watch_set_tcc_standby(uint8_t user, bool run_in_standby);
+
 /// Enable USB task timer. Called by USB enable routine in main(). You should not call this from your app.
 void _watch_enable_tc0(void);
 
@@ -53,4 +79,46 @@ void _watch_disable_tc1(void);
 /// Called by main.c if plugged in to USB. You should not call this from your app.
 void _watch_enable_usb(void);
 
+/// Called by main.c once the watch is unplugged, to stop USB and the clocks it ran on. Returns false, leaving USB
+/// running, while the LED or buzzer is on, since they play at the main clock's USB speed. You should not call this
+/// from your app.
+bool _watch_disable_usb(void);
+
+/// Called by TC0_Handler when TC0 is the button timer rather than the USB task timer. You should not call this from your app.
+void _watch_button_timer_interrupt(void);
+
+/// Called by the ADC driver with each battery reading, for the regulator policy. You should not call this from your app.
+void _watch_regulator_note_vcc(uint16_t millivolts);
+
+/// Called before sleep to find the pins the analog monitor uses, which have to keep their configuration. Writes up to
+/// two pins to pins, and returns how many; none if the monitor isn't running. You should not call this from your app.
+uint8_t _watch_adc_monitor_get_pins(uint8_t *pins);
+
+/// Called by the battery monitor to set the brownout detector's level in millivolts, or to turn it off with 0. You
+/// should not call this from your app.
+void _watch_battery_set_detector(uint16_t millivolts);
+
+/// Called when the brownout detector sees the battery fall below its level. You should not call this from your app.
+void _watch_battery_detected(void);
+
+/// Called by the ADC driver with each battery reading, for the battery monitor. You should not call this from your app.
+void _watch_battery_note_vcc(uint16_t millivolts);
+
+/// Called around standby to pick the regulator and performance level. You should not call this from your app.
+void _watch_update_power_policy(bool standby);
+
+/// Called by the power policy on its way into and out of standby, for the clock profile. You should not call this
+/// from your app.
+void _watch_clocks_set_standby(bool standby);
+
+/// Called by the startup code before the C library starts, to fill the free stack with the pattern that
+/// watch_get_stack_high_water looks for. You should not call this from your app.
+void _watch_memory_paint_stack(void);
+
+/// Called before sleep to turn off the ADC and I2C, keeping their claims. You should not call this from your app.
+void _watch_power_suspend(void);
+
+/// Called on waking from sleep to power up whatever is still claimed. You should not call this from your app.
+void _watch_power_resume(void);
+
 #endif
@@ -22,6 +22,11 @@
  * SOFTWARE.
  */
 #include "driver_init.h"
+#include "watch_private_buzzer.h"
+
+// note: the buzzer uses a 1 MHz clock. these values were determined by dividing 1,000,000 by the target frequency.
+// i.e. for a 440 Hz tone (A4 on the piano), 1MHz/440Hz = 2273
+const uint16_t NotePeriods[108] = {18182,17161,16197,15288,14430,13620,12857,12134,11453,10811,10204,9631,9091,8581,8099,7645,7216,6811,6428,6068,5727,5405,5102,4816,4545,4290,4050,3822,3608,3405,3214,3034,2863,2703,2551,2408,2273,2145,2025,1911,1804,1703,1607,1517,1432,1351,1276,1204,1136,1073,1012,956,902,851,804,758,716,676,638,602,568,536,506,478,451,426,402,379,358,338,319,301,284,268,253,239,225,213,201,190,179,169,159,150,142,134,127};
 
 uint16_t sequence_length(int8_t *sequence) {
     uint16_t result = 0;
@@ -33,3 +38,65 @@ uint16_t sequence_length(int8_t *sequence) {
 
     return result;
 }
+
+static const watch_buzzer_note_t _watch_buzzer_end_of_notes = {0, 0};
+
+void _watch_buzzer_player_start(watch_buzzer_player_t *player, const int8_t *sequence, const watch_buzzer_note_t *notes, watch_buzzer_next_notes_t next_notes) {
+    player->sequence = sequence;
+    player->notes = notes;
+    player->next_notes = next_notes;
+    player->position = 0;
+    player->repeat_counter = -1;
+}
+
+watch_buzzer_note_t _watch_buzzer_player_next(watch_buzzer_player_t *player) {
+    watch_buzzer_note_t note = {0, 0};
+
+    if (player->notes) {
+        // a compiled tune is already periods and ticks; stay on its end marker once we get there.
+        note = player->notes[player->position];
+        while (note.ticks == 0 && player->next_notes) {
+            // unless it's streamed, in which case the next block carries on from here.
+            player->notes = player->next_notes();
+            player->position = 0;
+            if (player->notes == NULL) {
+                player->notes = &_watch_buzzer_end_of_notes;
+                player->next_notes = NULL;
+            }
+            note = player->notes[0];
+        }
+        if (note.ticks) player->position++;
+        return note;
+    }
+
+    const int8_t *sequence = player->sequence;
+    uint8_t markers = 0;
+    while (sequence[player->position] < 0 && sequence[player->position + 1]) {
+        // repeat indicator found. a run of them with no notes in between would loop forever, so give up on it.
+        if (++markers == 0) return note;
+        if (player->repeat_counter == -1) {
+            // first encounter: load repeat counter
+            player->repeat_counter = sequence[player->position + 1];
+        } else player->repeat_counter--;
+        if (player->repeat_counter > 0) {
+            // rewind
+            if (player->position > sequence[player->position] * -2)
+                player->position += sequence[player->position] * 2;
+            else
+                player->position = 0;
+        } else {
+            // continue
+            player->position += 2;
+            player->repeat_counter = -1;
+        }
+    }
+    if (sequence[player->position] && sequence[player->position + 1]) {
+        BuzzerNote buzzer_note = sequence[player->position];
+        if (buzzer_note != BUZZER_NOTE_REST) note.period = NotePeriods[buzzer_note];
+        // the sequencer moves on in the tick after a note's duration has counted down, so it sounds one tick longer.
+        note.ticks = sequence[player->position + 1] + 1;
+        player->position += 2;
+    }
+
+    return note;
+}
@@ -24,9 +24,26 @@
 #ifndef _WATCH_PRIVATE_BUZZER_H_INCLUDED
 #define _WATCH_PRIVATE_BUZZER_H_INCLUDED
 
-// note: the buzzer uses a 1 MHz clock. these values were determined by dividing 1,000,000 by the target frequency.
-// i.e. for a 440 Hz tone (A4 on the piano), 1MHz/440Hz = 2273
-const uint16_t NotePeriods[108] = {18182,17161,16197,15288,14430,13620,12857,12134,11453,10811,10204,9631,9091,8581,8099,7645,7216,6811,6428,6068,5727,5405,5102,4816,4545,4290,4050,3822,3608,3405,3214,3034,2863,2703,2551,2408,2273,2145,2025,1911,1804,1703,1607,1517,1432,1351,1276,1204,1136,1073,1012,956,902,851,804,758,716,676,638,602,568,536,506,478,451,426,402,379,358,338,319,301,284,268,253,239,225,213,201,190,179,169,159,150,142,134,127};
+#include "watch_buzzer.h"
+
+/// @brief Where a tune has got to, for the sequencer that plays it (@see watch_buzzer_play_sequence).
+typedef struct {
+    const int8_t *sequence;             ///< The tune, if it's a note & duration sequence...
+    const watch_buzzer_note_t *notes;   ///< ...or if it's been compiled.
+    watch_buzzer_next_notes_t next_notes;   ///< Where the compiled notes' next block comes from, if it's streamed.
+    uint16_t position;
+    int8_t repeat_counter;
+} watch_buzzer_player_t;
+
+/** @brief Starts a player at the beginning of a note & duration sequence, or of a compiled tune.
+  * @details Exactly one of sequence and notes should be given; next_notes goes with notes, or is NULL.
+  */
+void _watch_buzzer_player_start(watch_buzzer_player_t *player, const int8_t *sequence, const watch_buzzer_note_t *notes, watch_buzzer_next_notes_t next_notes);
+
+/** @brief Returns the next note to play, with its period looked up and any repeat markers followed.
+  * @return The note, or one of 0 ticks when the tune has ended.
+  */
+watch_buzzer_note_t _watch_buzzer_player_next(watch_buzzer_player_t *player);
 
 uint16_t sequence_length(int8_t *sequence);
 
@@ -23,7 +23,9 @@
  */
 
 #include "watch_slcd.h"
+#include "watch_fmt.h"
 #include "watch_private_display.h"
+#include "watch_display_glyphs.h"
 
 static const uint32_t IndicatorSegments[] = {
     SLCD_SEGID(0, 17), // WATCH_INDICATOR_SIGNAL
@@ -33,103 +35,88 @@ static const uint32_t IndicatorSegments[] = {
     SLCD_SEGID(1, 10), // WATCH_INDICATOR_LAP
 };
 
-void watch_display_character(uint8_t character, uint8_t position) {
-    // special cases for positions 4 and 6
-    if (position == 4 || position == 6) {
-        if (character == '7') character = '&'; // "lowercase" 7
-        else if (character == 'A') character = 'a'; // A needs to be lowercase
-        else if (character == 'o') character = 'O'; // O needs to be uppercase
-        else if (character == 'L') character = '!'; // L needs to be in top half
-        else if (character == 'M' || character == 'm' || character == 'N') character = 'n'; // M and uppercase N need to be lowercase n
-        else if (character == 'c') character = 'C'; // C needs to be uppercase
-        else if (character == 'J') character = 'j'; // same
-        else if (character == 'v' || character == 'V' || character == 'U' || character == 'W' || character == 'w') character = 'u'; // bottom segment duplicated, so show in top half
-    } else {
-        if (character == 'u') character = 'v'; // we can use the bottom segment; move to lower half
-        else if (character == 'j') character = 'J'; // same but just display a normal J
-    }
-    if (position > 1) {
-        if (character == 'T') character = 't'; // uppercase T only works in positions 0 and 1
-    }
-    if (position == 1) {
-        if (character == 'a') character = 'A'; // A needs to be uppercase
-        else if (character == 'o') character = 'O'; // O needs to be uppercase
-        else if (character == 'i') character = 'l'; // I needs to be uppercase (use an l, it looks the same)
-        else if (character == 'n') character = 'N'; // N needs to be uppercase
-        else if (character == 'r') character = 'R'; // R needs to be uppercase
-        else if (character == 'd') character = 'D'; // D needs to be uppercase
-        else if (character == 'v' || character == 'V' || character == 'u') character = 'U'; // side segments shared, make uppercase
-        else if (character == 'b') character = 'B'; // B needs to be uppercase
-        else if (character == 'c') character = 'C'; // C needs to be uppercase
-    } else {
-        if (character == 'R') character = 'r'; // R needs to be lowercase almost everywhere
-    }
-    if (position == 0) {
-        watch_clear_pixel(0, 15); // clear funky ninth segment
-    } else {
-        if (character == 'I') character = 'l'; // uppercase I only works in position 0
-    }
+// The last glyph drawn at each position, along with the segment bits it left in the framebuffer. A position is only
+// re-rendered if the requested character differs, or if something else (watch_set_pixel, watch_clear_display) has
+// touched its segments since.
+typedef struct {
+    uint8_t character;
+    uint16_t segments[WATCH_DISPLAY_NUM_COMS];
+} watch_display_glyph_cache_t;
 
-    uint64_t segmap = Segment_Map[position];
-    uint64_t segdata = Character_Set[character - 0x20];
+static watch_display_glyph_cache_t glyph_cache[10];
+static uint16_t skipped_segment_writes = 0;
 
-    for (int i = 0; i < 8; i++) {
-        uint8_t com = (segmap & 0xFF) >> 6;
-        if (com > 2) {
-            // COM3 means no segment exists; skip it.
-            segmap = segmap >> 8;
-            segdata = segdata >> 1;
-            continue;
-        }
-        uint8_t seg = segmap & 0x3F;
+static inline uint16_t _watch_display_position_segments(uint8_t position, uint8_t com) {
+    return (watch_display_framebuffer[com] >> Glyph_Position_Shift[position]) & Glyph_Position_Masks[position][com];
+}
 
-        if (segdata & 1)
-          watch_set_pixel(com, seg);
-        else
-          watch_clear_pixel(com, seg);
+uint16_t watch_display_get_skipped_segment_writes(void) {
+    uint16_t retval = skipped_segment_writes;
+    skipped_segment_writes = 0;
 
-        segmap = segmap >> 8;
-        segdata = segdata >> 1;
+    return retval;
+}
+
+// renders a character into the framebuffer without committing it to the display.
+static WATCH_RAMFUNC void _watch_display_render_character(uint8_t character, uint8_t position) {
+    watch_display_glyph_cache_t *cached = &glyph_cache[position];
+
+    if (cached->character == character &&
+        _watch_display_position_segments(position, 0) == cached->segments[0] &&
+        _watch_display_position_segments(position, 1) == cached->segments[1] &&
+        _watch_display_position_segments(position, 2) == cached->segments[2]) {
+        skipped_segment_writes += Glyph_Position_Segment_Counts[position];
+        return;
     }
 
-    if (character == 'T' && position == 1) watch_set_pixel(1, 12); // add descender
-    else if (position == 0 && (character == 'B' || character == 'D' || character == '@')) watch_set_pixel(0, 15); // add funky ninth segment
-    else if (position == 1 && (character == 'B' || character == 'D' || character == '@')) watch_set_pixel(0, 12); // add funky ninth segment
+    // the glyph table was generated from Segment_Map and Character_Set, with all of the per-position character
+    // substitutions already applied (see utils/gen_display_glyphs.py). characters outside of it display as a space.
+    if (character < WATCH_DISPLAY_GLYPH_FIRST_CHAR || character > WATCH_DISPLAY_GLYPH_LAST_CHAR) character = ' ';
+    const uint16_t *glyph = Glyph_Table[position][character - WATCH_DISPLAY_GLYPH_FIRST_CHAR];
+    uint8_t shift = Glyph_Position_Shift[position];
+
+    for (uint8_t com = 0; com < WATCH_DISPLAY_NUM_COMS; com++) {
+        watch_display_framebuffer[com] = (watch_display_framebuffer[com] & ~((uint32_t)Glyph_Position_Masks[position][com] << shift)) |
+                                         ((uint32_t)glyph[com] << shift);
+        cached->segments[com] = glyph[com];
+    }
+    cached->character = character;
 }
 
-void watch_display_character_lp_seconds(uint8_t character, uint8_t position) {
-    // Will only work for digits and for positions  8 and 9 - but less code & checks to reduce power consumption
-
-    uint64_t segmap = Segment_Map[position];
-    uint64_t segdata = Character_Set[character - 0x20];
-
-    for (int i = 0; i < 8; i++) {
-        uint8_t com = (segmap & 0xFF) >> 6;
-        if (com > 2) {
-            // COM3 means no segment exists; skip it.
-            segmap = segmap >> 8;
-            segdata = segdata >> 1;
-            continue;
-        }
-        uint8_t seg = segmap & 0x3F;
+void watch_display_character(uint8_t character, uint8_t position) {
+    _watch_display_render_character(character, position);
+    watch_display_commit();
+}
 
-        if (segdata & 1)
-          watch_set_pixel(com, seg);
-        else
-          watch_clear_pixel(com, seg);
+void watch_display_2d(uint8_t value, uint8_t position, char pad) {
+    char digits[3];
+    watch_fmt_2d(digits, value, pad);
+    _watch_display_render_character(digits[0], position);
+    _watch_display_render_character(digits[1], position + 1);
+    watch_display_commit();
+}
 
-        segmap = segmap >> 8;
-        segdata = segdata >> 1;
-    }
+void watch_display_u32(uint32_t value, uint8_t position, uint8_t width, char pad) {
+    char digits[11];
+    char *end = watch_fmt_u32(digits, value, width, pad);
+    for (char *c = digits; c < end && position < Num_Chars; c++) _watch_display_render_character(*c, position++);
+    watch_display_commit();
+}
+
+void watch_display_character_lp_seconds(uint8_t character, uint8_t position) {
+    // now that rendering a character is a table lookup, this is the same as watch_display_character.
+    watch_display_character(character, position);
 }
 
 void watch_display_string(char *string, uint8_t position) {
     size_t i = 0;
     while(string[i] != 0) {
-        watch_display_character(string[i], position + i);
+        _watch_display_render_character(string[i], position + i);
         i++;
         if (position + i >= Num_Chars) break;
     }
+    // the whole string has been rendered into the framebuffer; push it out in one go.
+    watch_display_commit();
     // uncomment this line to see screen output on terminal, i.e.
     //   FR  29
     // 11 50 23
@@ -137,6 +124,17 @@ void watch_display_string(char *string, uint8_t position) {
     // printf("________\n  %c%c  %c%c\n%c%c %c%c %c%c\n--------\n", (position > 0) ? ' ' : string[0], (position > 1) ? ' ' : string[1 - position], (position > 2) ? ' ' : string[2 - position], (position > 3) ? ' ' : string[3 - position], (position > 4) ? ' ' : string[4 - position], (position > 5) ? ' ' : string[5 - position], (position > 6) ? ' ' : string[6 - position], (position > 7) ? ' ' : string[7 - position], (position > 8) ? ' ' : string[8 - position], (position > 9) ? ' ' : string[9 - position]);
 }
 
+void watch_start_position_blink(uint16_t positions, uint32_t duration) {
+    uint32_t segments[WATCH_DISPLAY_NUM_COMS] = {0};
+    for (uint8_t position = 0; position < Num_Chars; position++) {
+        if (!(positions & (1 << position))) continue;
+        for (uint8_t com = 0; com < WATCH_DISPLAY_NUM_COMS; com++) {
+            segments[com] |= (uint32_t)Glyph_Position_Masks[position][com] << Glyph_Position_Shift[position];
+        }
+    }
+    watch_start_segment_blink(segments, duration);
+}
+
 void watch_set_colon(void) {
     watch_set_pixel(1, 16);
 }
@@ -160,9 +158,8 @@ void watch_clear_indicator(WatchIndicatorSegment indicator) {
 }
 
 void watch_clear_all_indicators(void) {
-    watch_clear_pixel(2, 17);
-    watch_clear_pixel(2, 16);
-    watch_clear_pixel(0, 17);
-    watch_clear_pixel(0, 16);
-    watch_clear_pixel(1, 10);
+    watch_display_framebuffer[0] &= ~((1 << 17) | (1 << 16));
+    watch_display_framebuffer[1] &= ~(1 << 10);
+    watch_display_framebuffer[2] &= ~((1 << 17) | (1 << 16));
+    watch_display_commit();
 }
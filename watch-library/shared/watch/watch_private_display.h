@@ -141,6 +141,30 @@ static const uint64_t Segment_Map[] = {
 
 static const uint8_t Num_Chars = 10;
 
+/// Number of COM lines driven on the Sensor Watch LCD.
+#define WATCH_DISPLAY_NUM_COMS 3
+
+/** @brief RAM shadow of the segment data registers for COM0-COM2.
+  * @details The display functions render into this buffer instead of touching the SLCD segment by segment;
+  *          watch_display_commit then writes all three lines out in one pass. watch_set_pixel and
+  *          watch_clear_pixel keep this buffer in sync, so it always mirrors what is on the glass.
+  *          CONF_SLCD_SEG_NUM is 24, so one 32-bit word per COM (SDATALx) covers every segment and the
+  *          SDATAHx registers are never used.
+  */
+extern uint32_t watch_display_framebuffer[WATCH_DISPLAY_NUM_COMS];
+
+/** @brief Writes the contents of watch_display_framebuffer out to the display.
+  * @details Implemented by the hardware and simulator SLCD drivers.
+  */
+void watch_display_commit(void);
+
+/** @brief Holds the display as it is, so that drawing only changes watch_display_framebuffer.
+  * @details For drawing frames ahead of time with the usual functions: hold the display, draw, copy the framebuffer
+  *          out, and put it back as it was before letting go. Letting go doesn't write anything out; the next
+  *          watch_display_commit does. Implemented by the hardware and simulator SLCD drivers.
+  */
+void watch_display_set_held(bool held);
+
 void watch_display_character(uint8_t character, uint8_t position);
 void watch_display_character_lp_seconds(uint8_t character, uint8_t position);
 
@@ -0,0 +1,109 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _WATCH_PROFILER_H_INCLUDED
+#define _WATCH_PROFILER_H_INCLUDED
+////< @file watch_profiler.h
+
+#include "watch.h"
+
+/** @addtogroup profiler Profiler
+  * @brief This section covers finding out where the CPU's time goes on a real watch.
+  * @details When built with MOVEMENT_PROFILER defined (make PROFILER=1), SysTick interrupts every so many CPU cycles
+  *          while the profiler runs, and each interrupt counts the address the CPU was about to execute in a table
+  *          in RAM. SysTick only counts while the CPU is awake, so the samples cover active time: standby and idle
+  *          sleep don't show up at all, and a face that does twice the work gets twice the samples. The shell's
+  *          "prof" command starts and stops sampling and prints the table; utils/profile_report.py turns it into
+  *          a list of the hottest functions, using the ELF the firmware was built from.
+  *
+  *          Some blind spots: interrupt handlers at priority 0 (the same as SysTick's) hold the sample off until they
+  *          return, so their time is credited to whatever they interrupted; and delay_ms reprograms SysTick, so a
+  *          delay counts as a single sample however long it is.
+  *
+  *          For a closer look at a stretch of code, the Cortex-M0+'s Micro Trace Buffer can record every branch the
+  *          CPU takes into a ring in RAM. Wrap the code in watch_profiler_trace_begin and watch_profiler_trace_end,
+  *          and "prof trace" prints the last WATCH_PROFILER_TRACE_SIZE / 8 branches as source and destination
+  *          addresses, oldest first, for the same script to symbolize.
+  *
+  *          Without MOVEMENT_PROFILER, or in the simulator, the trace hooks compile to nothing.
+  */
+/// @{
+
+#ifndef WATCH_PROFILER_SLOTS
+#define WATCH_PROFILER_SLOTS 512            ///< Distinct addresses the histogram can count; a power of two.
+#endif
+
+#ifndef WATCH_PROFILER_TRACE_SIZE
+#define WATCH_PROFILER_TRACE_SIZE 1024      ///< Bytes of RAM for the branch trace, 8 per branch; a power of two.
+#endif
+
+/// CPU cycles between samples unless prof start says otherwise: about 1 kHz at 8 MHz, and prime, so that the
+/// sampling doesn't fall into step with a loop.
+#define WATCH_PROFILER_DEFAULT_PERIOD 7919
+
+#if defined(MOVEMENT_PROFILER) && !__EMSCRIPTEN__
+
+/** @brief Starts sampling, adding to whatever is already in the histogram.
+  * @param period CPU cycles between samples, from 256 to 2^24 - 1.
+  */
+void watch_profiler_start(uint32_t period);
+
+/** @brief Stops sampling. The histogram keeps what it has. */
+void watch_profiler_stop(void);
+
+/** @brief Empties the histogram. */
+void watch_profiler_clear(void);
+
+/** @brief Returns true while sampling. */
+bool watch_profiler_is_running(void);
+
+/** @brief Prints the histogram: a header line of totals, then one line for each address sampled, with its count.
+  * @details The header reads "# samples N dropped D period P"; dropped counts samples at new addresses that found
+  *          the table full. The other lines are "0xADDRESS COUNT", in no particular order.
+  */
+void watch_profiler_print(void);
+
+/** @brief Starts recording branches into the trace buffer, replacing any earlier trace. */
+void watch_profiler_trace_begin(void);
+
+/** @brief Stops recording branches, leaving the trace for prof trace to print. */
+void watch_profiler_trace_end(void);
+
+/** @brief Prints the branch trace, oldest first, as lines of "0xSOURCE 0xDESTINATION".
+  * @details A line that ends in " x" was an exception entry or return rather than a branch in the code.
+  */
+void watch_profiler_trace_print(void);
+
+/// The cycle counter for profiling builds, where SysTick wraps at the sampling period rather than at 2^24.
+uint32_t _watch_profiler_cycle_counter(void);
+
+#else
+
+static inline void watch_profiler_trace_begin(void) {}
+static inline void watch_profiler_trace_end(void) {}
+
+#endif
+
+/// @}
+#endif
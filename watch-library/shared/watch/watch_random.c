@@ -0,0 +1,124 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#include <string.h>
+#include "watch_random.h"
+
+// the generator folds fresh words from the pool into its key after this many blocks (64 bytes each).
+#define WATCH_RANDOM_RESEED_BLOCKS 256
+
+static uint32_t _pool[WATCH_RANDOM_POOL_WORDS];
+static uint8_t _pool_count;
+
+// ChaCha20's key and block counter, and the block of output being handed out.
+static uint32_t _key[8];
+static uint32_t _counter;
+static uint32_t _block[16];
+static uint8_t _block_index = 16;
+static uint16_t _blocks_left;
+
+#define ROTL(x, n) (((x) << (n)) | ((x) >> (32 - (n))))
+#define QUARTER_ROUND(a, b, c, d) \
+    a += b; d ^= a; d = ROTL(d, 16); \
+    c += d; b ^= c; b = ROTL(b, 12); \
+    a += b; d ^= a; d = ROTL(d, 8); \
+    c += d; b ^= c; b = ROTL(b, 7);
+
+static void _watch_random_chacha20_block(void) {
+    // "expand 32-byte k", the key, the counter and a zero nonce, as in RFC 8439.
+    uint32_t input[16] = { 0x61707865, 0x3320646e, 0x79622d32, 0x6b206574 };
+    memcpy(&input[4], _key, sizeof(_key));
+    input[12] = _counter++;
+    input[13] = input[14] = input[15] = 0;
+    memcpy(_block, input, sizeof(input));
+    for (uint8_t i = 0; i < 10; i++) {
+        QUARTER_ROUND(_block[0], _block[4], _block[8], _block[12]);
+        QUARTER_ROUND(_block[1], _block[5], _block[9], _block[13]);
+        QUARTER_ROUND(_block[2], _block[6], _block[10], _block[14]);
+        QUARTER_ROUND(_block[3], _block[7], _block[11], _block[15]);
+        QUARTER_ROUND(_block[0], _block[5], _block[10], _block[15]);
+        QUARTER_ROUND(_block[1], _block[6], _block[11], _block[12]);
+        QUARTER_ROUND(_block[2], _block[7], _block[8], _block[13]);
+        QUARTER_ROUND(_block[3], _block[4], _block[9], _block[14]);
+    }
+    for (uint8_t i = 0; i < 16; i++) _block[i] += input[i];
+    _block_index = 0;
+}
+
+void watch_random_refill(void) {
+    if (_pool_count == WATCH_RANDOM_POOL_WORDS) return;
+    _watch_random_collect(&_pool[_pool_count], WATCH_RANDOM_POOL_WORDS - _pool_count);
+    _pool_count = WATCH_RANDOM_POOL_WORDS;
+}
+
+bool watch_random_needs_refill(void) {
+    return _pool_count <= WATCH_RANDOM_POOL_WORDS / 2;
+}
+
+uint32_t watch_random_true(void) {
+    if (_pool_count == 0) watch_random_refill();
+    uint32_t word = _pool[--_pool_count];
+    // a word is only ever handed out once.
+    _pool[_pool_count] = 0;
+    return word;
+}
+
+uint32_t watch_random(void) {
+    if (_block_index == 16) {
+        if (_blocks_left == 0) {
+            // mixing into the old key rather than replacing it means a weak refill can't make things worse.
+            for (uint8_t i = 0; i < 8; i++) _key[i] ^= watch_random_true();
+            _blocks_left = WATCH_RANDOM_RESEED_BLOCKS;
+        }
+        _blocks_left--;
+        _watch_random_chacha20_block();
+    }
+    uint32_t word = _block[_block_index];
+    // don't leave output lying around once it's been used.
+    _block[_block_index++] = 0;
+    return word;
+}
+
+uint32_t watch_random_uniform(uint32_t upper_bound) {
+    if (upper_bound < 2) return 0;
+    // 2**32 % upper_bound: the numbers below this would make the low results a little more likely, so draw again.
+    uint32_t min = -upper_bound % upper_bound;
+    uint32_t r;
+    do {
+        r = watch_random();
+    } while (r < min);
+    return r % upper_bound;
+}
+
+void watch_random_bytes(void *buf, size_t len) {
+    uint8_t *bytes = (uint8_t *)buf;
+    while (len) {
+        uint32_t word = watch_random();
+        size_t n = len < 4 ? len : 4;
+        memcpy(bytes, &word, n);
+        bytes += n;
+        len -= n;
+    }
+}
@@ -0,0 +1,78 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+
+#ifndef _WATCH_RANDOM_H_INCLUDED
+#define _WATCH_RANDOM_H_INCLUDED
+////< @file watch_random.h
+
+#include "watch.h"
+
+/** @addtogroup random Random Numbers
+  * @brief This section covers random numbers that are quick to draw.
+  * @details The SAM L22's true random number generator takes a while to power up, and then makes one word at a time,
+  *          so reading it whenever a face wants a number means a busy wait each time. Instead, the watch keeps a small
+  *          pool of its words, topped up in one go while nothing else is happening (Movement does this before it
+  *          sleeps), and seeds a ChaCha20 generator from it. Numbers come from the generator, which folds in fresh
+  *          words from the pool every so often; they're unpredictable, and only the first draw after boot, or one
+  *          that finds the pool empty, waits on the hardware.
+  *
+  *          The simulator fills the pool from the browser's crypto.getRandomValues, and the headless build from a
+  *          fixed sequence, so that its scripts play out the same way every time.
+  */
+/// @{
+
+/// How many words of true entropy the pool holds.
+#define WATCH_RANDOM_POOL_WORDS 16
+
+/** @brief Returns 32 random bits from the generator.
+  */
+uint32_t watch_random(void);
+
+/** @brief Returns a random number below a bound, with every number equally likely.
+  * @param upper_bound One more than the largest number to return. 0 and 1 both return 0.
+  */
+uint32_t watch_random_uniform(uint32_t upper_bound);
+
+/** @brief Fills a buffer with random bytes from the generator.
+  */
+void watch_random_bytes(void *buf, size_t len);
+
+/** @brief Returns 32 bits straight from the true random number generator, by way of the pool.
+  * @details For the few uses that want the hardware's own bits rather than the generator's. Each word is only
+  *          handed out once, so drawing many of these empties the pool, and the next one waits for a refill.
+  */
+uint32_t watch_random_true(void);
+
+/** @brief Checks whether the pool has run low enough to be worth topping up.
+  * @return true if watch_random_refill has something to do.
+  */
+bool watch_random_needs_refill(void);
+
+/** @brief Tops the pool up with words from the true random number generator, powering it up once for all of them.
+  */
+void watch_random_refill(void);
+
+/// @}
+#endif
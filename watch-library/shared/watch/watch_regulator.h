@@ -0,0 +1,71 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _WATCH_REGULATOR_H_INCLUDED
+#define _WATCH_REGULATOR_H_INCLUDED
+////< @file watch_regulator.h
+
+#include "watch.h"
+
+/** @addtogroup regulator Voltage Regulator
+  * @brief This section covers how the watch powers its core: which main voltage regulator it uses, and which
+  *        performance level (core voltage) it runs at.
+  * @details The SAM L22 can make its core voltage with a linear regulator (LDO) or a switching one (buck). The buck
+  *          wastes much less of the coin cell's voltage when the core is busy, but costs more than it saves when
+  *          the load is tiny, and needs some headroom above the core voltage to regulate. The performance level sets
+  *          the core voltage itself; PL0 is lower, and covers everything but USB and the fast clock, which need PL2.
+  *
+  *          The library keeps both up to date on its own: the buck while awake or while the LED or buzzer runs in
+  *          standby, the LDO for idle standby and whenever the last battery reading is too low for the buck, and PL0
+  *          unless USB is on or watch_set_performance_level has sped the clock up.
+  */
+/// @{
+
+typedef enum {
+    WATCH_REGULATOR_LDO = 0,
+    WATCH_REGULATOR_BUCK,
+} watch_regulator_t;
+
+/// The lowest battery voltage, in millivolts, at which the watch uses the buck regulator.
+#define WATCH_REGULATOR_BUCK_MIN_VCC 2500
+
+/** @brief Returns the main voltage regulator currently in use. */
+watch_regulator_t watch_get_regulator(void);
+
+/** @brief Returns the current performance level: 0 for PL0, or 2 for PL2. */
+uint8_t watch_get_performance_level_number(void);
+
+/** @brief Returns the battery voltage the regulator policy last heard about, in millivolts.
+  * @details This is the last value watch_get_vcc_voltage returned; the policy never reads the ADC on its own.
+  */
+uint16_t watch_get_regulator_vcc(void);
+
+/** @brief Chooses the regulator and performance level for the watch's current load.
+  * @details The library calls this when the load changes; you only need to if you change the clock or the TCC
+  *          without going through the library.
+  */
+void watch_update_power_policy(void);
+
+/// @}
+#endif
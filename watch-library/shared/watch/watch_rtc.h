@@ -60,6 +60,14 @@ typedef enum watch_rtc_alarm_match {
     ALARM_MATCH_HHMMSS,
 } watch_rtc_alarm_match;
 
+/// A software timer for watch_rtc_schedule_timer. The RTC owns its contents while it is scheduled.
+typedef struct watch_rtc_timer {
+    watch_date_time deadline;       // the moment the timer fires, to the second.
+    watch_date_time latest;         // the last moment it may fire, if it has some slack; otherwise the deadline.
+    ext_irq_cb_t callback;          // called from the RTC interrupt once the deadline has passed.
+    struct watch_rtc_timer *next;   // the next timer due, or NULL if this is the last.
+} watch_rtc_timer_t;
+
 /** @brief Called by main.c to check if the RTC is enabled.
   * You may call this function, but outside of app_init, it should always return true.
   */
@@ -102,6 +110,38 @@ void watch_rtc_register_alarm_callback(ext_irq_cb_t callback, watch_date_time al
   */
 void watch_rtc_disable_alarm_callback(void);
 
+/** @brief Schedules a timer to fire at an absolute date and time, to the second.
+  * @param timer The timer to schedule. It must stay valid until it fires or is cancelled; if it is already
+  *              scheduled, it is moved to the new deadline.
+  * @param deadline The date and time at which to call the callback.
+  * @param callback The function to call from the RTC interrupt once the deadline has passed. The timer is no
+  *                 longer scheduled when it is called, so the callback may schedule it again.
+  * @details Any number of timers can be scheduled at once. They are kept sorted by deadline, and the RTC's alarm
+  *          is always set for the earliest, so the watch can sleep until the next one is due however far away
+  *          it is. A deadline that has already passed (including one left behind by watch_rtc_set_date_time
+  *          moving the clock forward) fires as soon as possible rather than being missed.
+  * @note The timers share the RTC's one alarm with watch_rtc_register_alarm_callback. If you use the timers,
+  *       don't register an alarm callback as well.
+  */
+void watch_rtc_schedule_timer(watch_rtc_timer_t *timer, watch_date_time deadline, ext_irq_cb_t callback);
+
+/** @brief Schedules a timer that may fire any time from its deadline to slack seconds after it.
+  * @details For work that can wait a little, so that it shares a wake with something else: the RTC's alarm is set
+  *          for the earliest moment a timer must fire, its deadline plus its slack, and every timer whose deadline
+  *          has come fires along with it. A timer that's due also fires with the buttons' interrupts and the 1 Hz
+  *          tick, if they come first. A timer never fires before its deadline.
+  * @param timer The timer to schedule, as with watch_rtc_schedule_timer.
+  * @param deadline The earliest date and time at which to call the callback.
+  * @param slack How many seconds after the deadline the callback may be put off to.
+  * @param callback The function to call, as with watch_rtc_schedule_timer.
+  */
+void watch_rtc_schedule_timer_with_slack(watch_rtc_timer_t *timer, watch_date_time deadline, uint16_t slack, ext_irq_cb_t callback);
+
+/** @brief Cancels a timer scheduled with watch_rtc_schedule_timer. Does nothing if it isn't scheduled.
+  * @param timer The timer to cancel.
+  */
+void watch_rtc_cancel_timer(watch_rtc_timer_t *timer);
+
 /** @brief Registers a "tick" callback that will be called once per second.
   * @param callback The function you wish to have called when the clock ticks. If you pass in NULL, the tick
   *                 interrupt will still be enabled, but no callback function will be called.
@@ -137,6 +177,14 @@ void watch_rtc_register_periodic_callback(ext_irq_cb_t callback, uint8_t frequen
   */
 void watch_rtc_disable_periodic_callback(uint8_t frequency);
 
+/** @brief Idles the CPU until the next tick at the given frequency, or until some other interrupt arrives first.
+  * @param frequency The frequency of the tick to wait for, in Hz. **Must be a power of 2**, from 1 to 128 inclusive.
+  * @details Use this instead of a busy loop when polling something that will take a few milliseconds, like a flash
+  *          chip's busy bit. Any callback already registered for this frequency still fires as usual; if none was
+  *          registered, the tick's interrupt is only enabled for the duration of the wait.
+  */
+void watch_rtc_idle_until_periodic_tick(uint8_t frequency);
+
 /** @brief Disables tick callbacks for the given periods (as a bitmask).
   * @param mask The frequencies of tick callbacks you wish to disable, in Hz.
   * The 128 Hz callback is 0b1, the 64 Hz callback is 0b10, the 32 Hz callback is 0b100, etc.
@@ -157,5 +205,34 @@ void watch_rtc_enable(bool en);
   */
 void watch_rtc_freqcorr_write(int16_t value, int16_t sign);
 
+/** @brief Starts measuring how fast the 32.768 kHz crystal runs, against the 48 MHz clock that USB keeps locked to
+  *        the host's start-of-frame packets.
+  * @details The frequency meter counts 48 MHz cycles over 255 cycles of the crystal divided by 32, which takes about
+  *          a quarter of a second and resolves 0.084 ppm. The result is only as good as the host's clock, which the
+  *          USB spec allows to be off by 500 ppm, but which in a computer is usually within a few tens; and since the
+  *          48 MHz clock hunts around the host's, a single measurement is noisy, so average a few hundred. The
+  *          measurement runs on its own; poll watch_rtc_read_crystal_measurement for the result.
+  * @return false if there's nothing to measure against: USB isn't enabled, or no host has configured it, or it's
+  *         suspended. Always false on a board without a crystal, and in the simulator.
+  */
+bool watch_rtc_start_crystal_measurement(void);
+
+/** @brief Returns the result of the measurement watch_rtc_start_crystal_measurement started, once it's done.
+  * @param ppb Set to how fast the crystal ran, in parts per billion; negative if it ran slow.
+  * @return false if the measurement hasn't finished, or none was started.
+  */
+bool watch_rtc_read_crystal_measurement(int32_t *ppb);
+
+/** @brief Turns the frequency meter, and the clocks it was using, back off. */
+void watch_rtc_stop_crystal_measurements(void);
+
+/** @brief Returns how many RTC interrupt sources have been serviced in the same interrupt as another source.
+  * @details The RTC interrupt handler services every pending source (extwake, alarm and each periodic tick) in one
+  *          go. Each source beyond the first is counted here, as an interrupt entry (and possibly a wake from
+  *          standby) that didn't have to happen; so is each timer that fired early, within its slack, on another
+  *          source's wake (@see watch_rtc_schedule_timer_with_slack).
+  */
+uint32_t watch_rtc_get_coalesced_interrupt_count(void);
+
 /// @}
 #endif
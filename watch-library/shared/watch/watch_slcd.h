@@ -50,11 +50,46 @@ typedef enum WatchIndicatorSegment {
     WATCH_INDICATOR_LAP         ///< The LAP indicator; the F-91W uses this in its stopwatch UI.
 } WatchIndicatorSegment;
 
+/// One frame of a display animation: for each COM line, the segments to turn on (bit n is segment n).
+typedef struct {
+    uint32_t segments[3];
+} watch_display_frame_t;
+
 /** @brief Enables the Segment LCD display.
   * Call this before attempting to set pixels or display strings.
   */
 void watch_enable_display(void);
 
+/** @brief Turns the display's drive off, or back on, without losing what's on it.
+  * @details With the SLCD disabled, its charge pump and bias generator stop, and the glass goes blank; they are a good
+  *          share of what the watch draws in standby. Drawing goes on as usual while the display is off, and shows
+  *          up when it comes back on. Unlike watch_enter_deep_sleep_mode, this doesn't need watch_enable_display (and
+  *          a redraw) afterwards, so the watch can keep sleeping with the display off and wake for the RTC.
+  * @param off true to turn the display off, false to turn it back on.
+  */
+void watch_display_set_off(bool off);
+
+/// How hard the SLCD drives the glass; each setting trades current against how crisp the segments look.
+typedef struct {
+    uint8_t contrast;       ///< VLCD, from 0 (2.51 V) to 15 (3.51 V) in steps of about 67 mV.
+    uint8_t bias_buffer;    ///< SLCD clock cycles the bias buffer runs for after each change of level, 1 to 16; 0 for none.
+    uint8_t frame_divider;  ///< The SLCD clock divider, 1 to 8; the frame rate is 32768 / (144 × frame_divider) Hz.
+} watch_display_drive_t;
+
+/** @brief Changes how the SLCD drives the display, while it runs.
+  * @details The settings in hpl_slcd_config.h are where the display starts; after that, watch_enable_display keeps
+  *          the last ones set. A higher VLCD, a longer bias buffer and a faster frame rate each draw more current, and each
+  *          keeps the segments crisp in a colder watch, where the liquid crystal is slower and needs more voltage to
+  *          turn. The display already uses the low power waveform, which inverts each frame rather than each bit.
+  *          Blinks and animations keep their periods in milliseconds across a change of frame rate. The SLCD goes
+  *          off for a moment while the settings change, which nobody can see.
+  * @param drive The new settings; out of range values are clamped.
+  */
+void watch_display_set_drive(watch_display_drive_t drive);
+
+/** @brief Returns how the SLCD is driving the display. */
+watch_display_drive_t watch_display_get_drive(void);
+
 /** @brief Sets a pixel. Use this to manually set a pixel with a given common and segment number.
   *        See <a href="segmap.html">segmap.html</a>.
   * @param com the common pin, numbered from 0-2.
@@ -84,6 +119,26 @@ void watch_clear_display(void);
   */
 void watch_display_string(char *string, uint8_t position);
 
+/** @brief Displays a number from 0 to 99 in two positions, like watch_display_string with "%2d" or "%02d", but
+  *        without building a string first.
+  * @param pad What to show in the first position for a number under ten: '0' or ' '.
+  */
+void watch_display_2d(uint8_t value, uint8_t position, char pad);
+
+/** @brief Displays a number right-aligned in width positions, padded with pad ('0' or ' '); a number with more
+  *        digits than that takes the positions after, as far as the display goes.
+  */
+void watch_display_u32(uint32_t value, uint8_t position, uint8_t width, char pad);
+
+/** @brief Returns the number of segment writes that were skipped since the last call to this function.
+  * @details watch_display_string and watch_display_character remember the glyph at each position, and leave
+  *          a position alone if it already shows the requested character. A clock face that redraws all ten
+  *          positions every second typically only changes one or two of them; call this once per tick to see
+  *          how many segment updates that redraw avoided.
+  * @return The number of segments that did not need to be rewritten; the counter is reset to zero.
+  */
+uint16_t watch_display_get_skipped_segment_writes(void);
+
 /** @brief Turns the colon segment on.
   */
 void watch_set_colon(void);
@@ -126,6 +181,89 @@ void watch_start_character_blink(char character, uint32_t duration);
   */
 void watch_stop_blink(void);
 
+/** @brief Blinks any group of segments, without the app having to redraw them.
+  * @details The selective blinking that watch_start_character_blink uses only reaches the segments in position
+  *          7, so this uses the SLCD's third frame counter instead: each time it overflows, an interrupt hides or
+  *          shows the segments in the group, and the CPU goes straight back to sleep. This carries on in STANDBY
+  *          mode, so a settings screen can blink the field being edited while ticking at 1 Hz, or not at all.
+  *          The rest of the display can be redrawn as usual while the group blinks; segments in the group that
+  *          are off stay off. Calling this again replaces the group, and starts it from the visible half.
+  * @param segments For each COM line, a bit mask of the segments to blink (bit n is segment n). See
+  *                 <a href="segmap.html">segmap.html</a>.
+  * @param duration How long the segments stay visible, and then hidden, in milliseconds, from 50 to ~4250 ms.
+  */
+void watch_start_segment_blink(const uint32_t segments[3], uint32_t duration);
+
+/** @brief Blinks whole character positions, like the field on a settings screen.
+  * @param positions A bit mask of the positions to blink: bit 0 for position 0, and so on up to bit 9.
+  * @param duration How long the positions stay visible, and then hidden, in milliseconds.
+  * @see watch_start_segment_blink
+  */
+void watch_start_position_blink(uint16_t positions, uint32_t duration);
+
+/** @brief Stops blinking the group set by watch_start_segment_blink or watch_start_position_blink, and leaves
+  *        its segments showing whatever was last drawn there.
+  */
+void watch_stop_segment_blink(void);
+
+/** @brief Plays a sequence of frames on a group of segments, without the app having to draw each one.
+  * @details The SLCD steps through the frames on the frame counter the tick animation uses, so starting one
+  *          stops the other. Each time the counter overflows, an interrupt copies the next frame into the
+  *          segments under the mask and the CPU goes straight back to sleep; this carries on in STANDBY mode.
+  *          Segments outside the mask are left alone, and can be drawn as usual while the animation plays.
+  *          The first frame goes up right away. After the last frame of the last loop has had its turn, the
+  *          animation stops, leaving that frame showing, and the callback is called from the interrupt.
+  * @param frames The frames to play. They aren't copied, so they must stay put until the animation stops;
+  *               a const array in flash is best.
+  * @param num_frames How many frames there are.
+  * @param mask For each COM line, the segments the animation owns.
+  * @param frame_duration How long each frame shows, in milliseconds, from 50 to ~4250 ms.
+  * @param loops How many times to play the frames, or 0 to loop until watch_stop_display_animation.
+  * @param callback A function to call when the animation finishes, or NULL.
+  */
+void watch_start_display_animation(const watch_display_frame_t *frames, uint8_t num_frames, const uint32_t mask[3],
+                                   uint32_t frame_duration, uint8_t loops, ext_irq_cb_t callback);
+
+/** @brief Checks if an animation started with watch_start_display_animation is still playing.
+  * @return true if the animation is playing; false otherwise.
+  */
+bool watch_display_animation_is_running(void);
+
+/** @brief Stops the display animation, leaving whatever frame it was on, without calling its callback.
+  */
+void watch_stop_display_animation(void);
+
+/// The most frames watch_start_display_playback can take at once.
+#define WATCH_DISPLAY_PLAYBACK_MAX_FRAMES 16
+
+/** @brief Plays a run of whole-display frames without waking the CPU between them.
+  * @details Meant for faces that redraw many times a second: rather than waking up for each frame, the face works
+  *          out a batch of them ahead of time and wakes once per batch. The DMA controller copies each frame
+  *          straight into the SLCD's segment memory when the frame counter the tick animation uses overflows (the
+  *          SLCD's display memory update trigger), so starting playback stops both the tick animation and any
+  *          display animation. This carries on in STANDBY mode.
+  *          Each frame is the whole display, and goes up one frame_duration after the one before it; the first
+  *          goes up one frame_duration after this is called. While the frames play, drawing only changes the
+  *          framebuffer, and blinking segments stay put. The callback is called from an interrupt as the last
+  *          frame goes up, which is the moment to start the next batch if it's to follow on evenly; once the
+  *          playback ends, the framebuffer holds the last frame.
+  * @param frames The frames to play. They aren't copied, so they must stay put until the playback ends.
+  * @param num_frames How many frames there are, up to WATCH_DISPLAY_PLAYBACK_MAX_FRAMES.
+  * @param frame_duration How long each frame shows, in milliseconds, from 16 to ~4250 ms.
+  * @param callback A function to call as the last frame goes up, or NULL.
+  */
+void watch_start_display_playback(const watch_display_frame_t *frames, uint8_t num_frames, uint32_t frame_duration,
+                                  ext_irq_cb_t callback);
+
+/** @brief Checks if frames started with watch_start_display_playback are still playing.
+  * @return true if they are; false otherwise.
+  */
+bool watch_display_playback_is_running(void);
+
+/** @brief Stops the playback, leaving whatever frame was last copied in showing, without calling its callback.
+  */
+void watch_stop_display_playback(void);
+
 /** @brief Begins a two-segment "tick-tock" animation in position 8.
   * @details Six of the seven segments in position 8 (and only position 8) are capable of autonomous
   *          animation. This animation is very basic, and consists of moving a bit pattern forward
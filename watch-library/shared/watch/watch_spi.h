@@ -34,6 +34,8 @@
   */
 /// @{
 /** @brief Enables the SPI peripheral. Call this before attempting to interface with SPI devices.
+  * @note The bus runs at the fastest clock the SERCOM can generate, half of the main clock.
+  * @note If other code may be using the bus, call watch_claim_peripheral(WATCH_PERIPHERAL_SPI) instead.
   */
 void watch_enable_spi(void);
 
@@ -55,10 +57,12 @@ bool watch_spi_write(const uint8_t *buf, uint16_t length);
   */
 bool watch_spi_read(uint8_t *buf, uint16_t length);
 
-/** @brief Reads a series of values from a device on the SPI bus.
-  * @param data_out Storage for outgoing bytes.
-  * @param data_in Storage for incoming bytes.
+/** @brief Writes and reads a series of values on the SPI bus at the same time.
+  * @param data_out Storage for outgoing bytes, or NULL to send 0xFF for each byte.
+  * @param data_in Storage for incoming bytes, or NULL to discard them.
   * @param length The number of bytes to transfer.
+  * @details The DMA controller moves the bytes while the CPU sleeps; watch_spi_write and watch_spi_read are built
+  *          on this function too.
   * @note This function does not manage the chip select pin (usually A3).
   */
 bool watch_spi_transfer(const uint8_t *data_out, uint8_t *data_in, uint16_t length);
@@ -37,6 +37,16 @@
 #define NVMCTRL_RWWEE_PAGES 128
 #endif
 
+/// The rows of the RWWEE array: rows 0 to 31.
+#define WATCH_STORAGE_RWWEE_ROWS (NVMCTRL_RWWEE_PAGES * NVMCTRL_PAGE_SIZE / NVMCTRL_ROW_SIZE)
+/// Kilobytes of main flash that follow the RWWEE rows; make.mk sets this from FILESYSTEM_MAIN_FLASH_KB.
+#ifndef WATCH_STORAGE_MAIN_FLASH_KB
+#define WATCH_STORAGE_MAIN_FLASH_KB 0
+#endif
+#define WATCH_STORAGE_MAIN_ROWS (WATCH_STORAGE_MAIN_FLASH_KB * 1024 / NVMCTRL_ROW_SIZE)
+/// All the rows there are, RWWEE and main flash together.
+#define WATCH_STORAGE_NUM_ROWS (WATCH_STORAGE_RWWEE_ROWS + WATCH_STORAGE_MAIN_ROWS)
+
 /** @addtogroup storage Flash Storage
   * @brief This section covers functions related to the SAM L22's 8 kilobyte EEPROM emulation area.
   * @details The SAM L22 inside Sensor Watch has a 256 kilobyte Flash memory array that can be
@@ -62,6 +72,12 @@
   *                 ├──────────────┼──────────────┼──────────────┼──────────────┤
   *          Row 31 │   64 bytes   │   64 bytes   │   64 bytes   │   64 bytes   │
   *                 └──────────────┴──────────────┴──────────────┴──────────────┘
+
+  *          A build can also give the storage area some of the main Flash array, for more room than 8 kilobytes
+  *          (build with FILESYSTEM_MAIN_FLASH_KB=...). The linker script takes it from the top of the space the
+  *          firmware would otherwise have, and those rows follow on from row 31, so they read and write the same
+  *          way. The difference is that the CPU runs from the main array, so it stalls until a write or erase of
+  *          one of those rows has finished, and the functions below only return once they have.
   */
 /// @{
 /** @brief Reads a range of bytes from the storage area.
@@ -72,6 +88,15 @@
   */
 bool watch_storage_read(uint32_t row, uint32_t offset, uint8_t *buffer, uint32_t size);
 
+/** @brief Returns a pointer to a location in the storage area, which is memory mapped and can be read in place.
+  * @details This finishes any write or erase in progress first, but the pointer is only good until the next one:
+  *          the array can't be read while it's being programmed, and the data may of course change underneath you.
+  * @param row The row you want to read.
+  * @param offset The offset from the beginning of the row.
+  * @return A pointer to the data, or NULL if the location is outside the storage area.
+  */
+const uint8_t *watch_storage_get_address(uint32_t row, uint32_t offset);
+
 /** @brief Writes bytes to a page in the storage area. Note that the row should already be erased before writing.
   * @param row The row containing the page you want to write.
   * @param offset The offset from the beginning of the row. Must be a multiple of 64.
@@ -86,7 +111,30 @@ bool watch_storage_write(uint32_t row, uint32_t offset, const uint8_t *buffer, u
 bool watch_storage_erase(uint32_t row);
 
 /** @brief Waits for any pending writes to complete.
+  * @details Writes and erases return as soon as the flash controller has started on them; this is where you wait
+  *          for them to finish. The CPU sleeps until the controller's READY interrupt rather than spinning.
   */
 bool watch_storage_sync(void);
+
+/** @brief Returns true while a write or erase is still in progress.
+  */
+bool watch_storage_is_busy(void);
+
+/** @brief Asks for a callback once the current write or erase has finished.
+  * @details The callback is called from the flash controller's interrupt, once; if nothing is in progress, it is
+  *          called right away. Use this to do other work (or go to sleep) instead of calling watch_storage_sync.
+  * @param callback The function to call, or NULL to cancel a callback that hasn't fired yet.
+  */
+void watch_storage_register_ready_callback(void (*callback)(void));
+
+/** @brief Makes sure the user row's EEPROM size setting is 8 kilobytes, as the storage area expects.
+  * @details This is what apps/eeprom-emulation-upgrade does, for watches that left the factory with another
+  *          setting. If it needs changing, this rewrites the user row and resets the watch, so it doesn't return;
+  *          call it early, before anything has been written to the storage area. Once the setting is right, it's a
+  *          single read.
+  * @return true if the setting is right; false if it's wrong but the chip is secured, so the user row can't be
+  *         written.
+  */
+bool watch_storage_provision(void);
 /// @}
 #endif
@@ -29,28 +29,77 @@
 
 /** @addtogroup uart UART
   * @brief This section covers functions related to the UART peripheral.
+  * @details The UART runs from interrupts, with a ring buffer each way, so neither sending nor receiving holds up
+  *          the rest of the watch. Bytes written go into the transmit buffer and out from there by DMA, a run at a
+  *          time; bytes that arrive go into the receive buffer from the SERCOM's interrupt, where they wait to be
+  *          read. The SERCOM keeps running in STANDBY, and the start of an incoming byte wakes its clock, so the
+  *          watch can sleep between bytes without missing any.
   **/
 /// @{
 
+/// Bytes the transmit buffer holds; a power of two. Define it in your build to change it.
+#ifndef WATCH_UART_TX_BUFFER_SIZE
+#define WATCH_UART_TX_BUFFER_SIZE 128
+#endif
+
+/// Bytes the receive buffer holds; a power of two. Bytes that arrive while it's full are dropped.
+#ifndef WATCH_UART_RX_BUFFER_SIZE
+#define WATCH_UART_RX_BUFFER_SIZE 64
+#endif
+
 /** @brief Initializes the debug UART.
   * @param tx_pin The pin the watch will use to transmit, or 0 for a receive-only UART.
   *               If specified, must be either A2 or A4.
   * @param rx_pin The pin the watch will use to receive, or 0 for a transmit-only UART.
   *               If specified, must be A1, A2, A3 or A4 (pin A0 cannot receive UART data).
   * @param baud The baud rate for the UART. A typical value is 19200.
+  * @note The UART shares its SERCOM with SPI, so only one of them can be enabled at a time.
   */
 void watch_enable_uart(const uint8_t tx_pin, const uint8_t rx_pin, uint32_t baud);
 
+/** @brief Turns the UART off, once anything still in the transmit buffer has gone out, and lets go of its pins.
+  *        Anything left in the receive buffer is thrown away.
+  */
+void watch_disable_uart(void);
+
+/** @brief Queues bytes to transmit, as many as there's room for in the transmit buffer, and returns at once.
+  * @return The number of bytes queued.
+  */
+size_t watch_uart_write(const void *data, size_t length);
+
 /** @brief Transmits a string of bytes on the UART's TX pin.
   * @param s A null-terminated string containing the bytes you wish to transmit.
+  * @note This returns once the string is in the transmit buffer; it only waits (asleep) if the buffer fills up.
   */
 void watch_uart_puts(char *s);
 
+/** @brief Waits, asleep, until every byte in the transmit buffer has gone out on the wire. */
+void watch_uart_flush(void);
+
+/** @brief Returns the number of received bytes waiting to be read. */
+size_t watch_uart_available(void);
+
+/** @brief Reads received bytes, as many as are waiting, up to length, and returns at once.
+  * @return The number of bytes read.
+  */
+size_t watch_uart_read(void *buf, size_t length);
+
 /** @brief Receives a single byte from the UART's RX pin.
   * @return the received byte.
-  * @note This method will block until a byte is received!
+  * @note This method will block until a byte is received! It sleeps while it waits, but the rest of your app
+  *       doesn't run; use watch_uart_available or watch_uart_read to check for bytes without waiting.
   */
 char watch_uart_getc(void);
 
+/** @brief Sets a function to call from the UART's interrupt each time bytes arrive, or NULL for none. Keep it short:
+  *        set a flag, or queue an event, and read the bytes from your main loop.
+  */
+void watch_uart_set_rx_callback(ext_irq_cb_t callback);
+
+/** @brief Returns the number of received bytes that were lost since the last call, because the receive buffer was
+  *        full or a byte came in garbled (a framing error, or one arriving before the last was taken).
+  */
+uint16_t watch_uart_get_rx_errors(void);
+
 /// @}
 #endif
@@ -102,172 +102,93 @@ uint16_t watch_utility_days_since_new_year(uint16_t year, uint8_t month, uint8_t
     return (is_leap(year) && (month > 2) ? 1 : 0) + DAYS_SO_FAR[month - 1] + day;
 }
 
-// Function taken from `src/time/__year_to_secs.c` of musl libc
-// https://musl.libc.org
-static uint32_t __year_to_secs(uint32_t year, int *is_leap)
-{
-	if (year-2ULL <= 136) {
-		int y = year;
-		int leaps = (y-68)>>2;
-		if (!((y-68)&3)) {
-			leaps--;
-			if (is_leap) *is_leap = 1;
-		} else if (is_leap) *is_leap = 0;
-		return 31536000*(y-70) + 86400*leaps;
-	}
-
-	int cycles, centuries, leaps, rem;
-
-	if (!is_leap) is_leap = &(int){0};
-	cycles = (year-100) / 400;
-	rem = (year-100) % 400;
-	if (rem < 0) {
-		cycles--;
-		rem += 400;
-	}
-	if (!rem) {
-		*is_leap = 1;
-		centuries = 0;
-		leaps = 0;
-	} else {
-		if (rem >= 200) {
-			if (rem >= 300) centuries = 3, rem -= 300;
-			else centuries = 2, rem -= 200;
-		} else {
-			if (rem >= 100) centuries = 1, rem -= 100;
-			else centuries = 0;
-		}
-		if (!rem) {
-			*is_leap = 0;
-			leaps = 0;
-		} else {
-			leaps = rem / 4U;
-			rem %= 4U;
-			*is_leap = !rem;
-		}
-	}
-
-	leaps += 97*cycles + 24*centuries - *is_leap;
-
-	return (year-100) * 31536000LL + leaps * 86400LL + 946684800 + 86400;
+// Days from 1970-01-01 to a date in the proleptic Gregorian calendar, for any year from 1970 on. This is Howard
+// Hinnant's days_from_civil (http://howardhinnant.github.io/date_algorithms.html), which counts years from March so
+// that the leap day falls at the end; in unsigned 32-bit math, since nothing here predates 1970.
+static uint32_t _watch_utility_days_from_civil(uint32_t year, uint32_t month, uint32_t day) {
+    year -= month <= 2;
+    uint32_t era = year / 400;
+    uint32_t year_of_era = year - era * 400;                                    // [0, 399]
+    uint32_t day_of_year = (153 * (month > 2 ? month - 3 : month + 9) + 2) / 5 + day - 1;  // [0, 365]
+    uint32_t day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100 + day_of_year;  // [0, 146096]
+
+    return era * 146097 + day_of_era - 719468;
 }
 
-// Function taken from `src/time/__month_to_secs.c` of musl libc
-// https://musl.libc.org
-static int __month_to_secs(int month, int is_leap)
-{
-	static const int secs_through_month[] = {
-		0, 31*86400, 59*86400, 90*86400,
-		120*86400, 151*86400, 181*86400, 212*86400,
-		243*86400, 273*86400, 304*86400, 334*86400 };
-	int t = secs_through_month[month];
-	if (is_leap && month >= 2) t+=86400;
-	return t;
+// And the reverse: the date that falls a number of days after 1970-01-01.
+static void _watch_utility_civil_from_days(uint32_t days, uint32_t *year, uint32_t *month, uint32_t *day) {
+    days += 719468;
+    uint32_t era = days / 146097;
+    uint32_t day_of_era = days - era * 146097;                                  // [0, 146096]
+    uint32_t year_of_era = (day_of_era - day_of_era / 1460 + day_of_era / 36524 - day_of_era / 146096) / 365;  // [0, 399]
+    uint32_t day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 - year_of_era / 100);  // [0, 365]
+    uint32_t month_from_march = (5 * day_of_year + 2) / 153;                    // [0, 11]
+
+    *day = day_of_year - (153 * month_from_march + 2) / 5 + 1;
+    *month = month_from_march < 10 ? month_from_march + 3 : month_from_march - 9;
+    *year = year_of_era + era * 400 + (*month <= 2);
 }
 
-// Function adapted from `src/time/__tm_to_secs.c` of musl libc
-// https://musl.libc.org
 uint32_t watch_utility_convert_to_unix_time(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute, uint8_t second, uint32_t utc_offset) {
-    int is_leap;
-
-    // POSIX tm struct starts year at 1900 and month at 0
-    // https://pubs.opengroup.org/onlinepubs/9699919799/basedefs/time.h.html 
-    uint32_t timestamp = __year_to_secs(year - 1900, &is_leap);
-    timestamp += __month_to_secs(month - 1, is_leap);
+    uint32_t days = _watch_utility_days_from_civil(year, month, day);
 
-    // Regular conversion from musl libc
-    timestamp += (day - 1) * 86400;
-    timestamp += hour * 3600;
-    timestamp += minute * 60;
-    timestamp += second;
-    timestamp -= utc_offset;
-
-    return timestamp;
+    return days * 86400 + hour * 3600 + minute * 60 + second - utc_offset;
 }
 
 uint32_t watch_utility_date_time_to_unix_time(watch_date_time date_time, uint32_t utc_offset) {
     return watch_utility_convert_to_unix_time(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR, date_time.unit.month, date_time.unit.day, date_time.unit.hour, date_time.unit.minute, date_time.unit.second, utc_offset);
 }
 
-#define LEAPOCH (946684800LL + 86400*(31+29))
-
-#define DAYS_PER_400Y (365*400 + 97)
-#define DAYS_PER_100Y (365*100 + 24)
-#define DAYS_PER_4Y   (365*4   + 1)
-
-watch_date_time watch_utility_date_time_from_unix_time(uint32_t timestamp, uint32_t utc_offset) {
+static watch_date_time _watch_utility_date_time_from_days(uint32_t days, uint32_t seconds_of_day) {
     watch_date_time retval;
+    uint32_t year, month, day;
     retval.reg = 0;
-    int32_t days, secs;
-    int32_t remdays, remsecs, remyears;
-    int32_t qc_cycles, c_cycles, q_cycles;
-    int32_t years, months;
-    int32_t wday, yday, leap;
-    static const int8_t days_in_month[] = {31,30,31,30,31,31,30,31,30,31,31,29};
-    timestamp += utc_offset;
 
-    secs = timestamp - LEAPOCH;
-    days = secs / 86400;
-    remsecs = secs % 86400;
-    if (remsecs < 0) {
-        remsecs += 86400;
-        days--;
-    }
+    _watch_utility_civil_from_days(days, &year, &month, &day);
+    if (year < WATCH_RTC_REFERENCE_YEAR || year > WATCH_RTC_REFERENCE_YEAR + 63) return retval;
+    retval.unit.year = year - WATCH_RTC_REFERENCE_YEAR;
+    retval.unit.month = month;
+    retval.unit.day = day;
 
-    wday = (3+days)%7;
-    if (wday < 0) wday += 7;
-
-    qc_cycles = (int)(days / DAYS_PER_400Y);
-    remdays = days % DAYS_PER_400Y;
-    if (remdays < 0) {
-        remdays += DAYS_PER_400Y;
-        qc_cycles--;
-    }
+    uint32_t minutes = seconds_of_day / 60;
+    retval.unit.hour = minutes / 60;
+    retval.unit.minute = minutes - retval.unit.hour * 60;
+    retval.unit.second = seconds_of_day - minutes * 60;
 
-    c_cycles = remdays / DAYS_PER_100Y;
-    if (c_cycles == 4) c_cycles--;
-    remdays -= c_cycles * DAYS_PER_100Y;
-
-    q_cycles = remdays / DAYS_PER_4Y;
-    if (q_cycles == 25) q_cycles--;
-    remdays -= q_cycles * DAYS_PER_4Y;
-
-    remyears = remdays / 365;
-    if (remyears == 4) remyears--;
-    remdays -= remyears * 365;
-
-    leap = !remyears && (q_cycles || !c_cycles);
-    yday = remdays + 31 + 28 + leap;
-    if (yday >= 365+leap) yday -= 365+leap;
-
-    years = remyears + 4*q_cycles + 100*c_cycles + 400*qc_cycles;
+    return retval;
+}
 
-    for (months=0; days_in_month[months] <= remdays; months++)
-        remdays -= days_in_month[months];
+watch_date_time watch_utility_date_time_from_unix_time(uint32_t timestamp, uint32_t utc_offset) {
+    timestamp += utc_offset;
+    uint32_t days = timestamp / 86400;
 
-    years += 2000;
+    return _watch_utility_date_time_from_days(days, timestamp - days * 86400);
+}
 
-    months += 2;
-    if (months >= 12) {
-        months -=12;
-        years++;
+watch_date_time watch_utility_date_time_convert_zone(watch_date_time date_time, uint32_t origin_utc_offset, uint32_t destination_utc_offset) {
+    // offsets are at most a day either way, so the time of day moves by less than two days; most of the time it stays
+    // on the same date, and only the time fields change.
+    int32_t seconds_of_day = date_time.unit.hour * 3600 + date_time.unit.minute * 60 + date_time.unit.second;
+    seconds_of_day += (int32_t)(destination_utc_offset - origin_utc_offset);
+    if (seconds_of_day >= 0 && seconds_of_day < 86400) {
+        uint32_t minutes = seconds_of_day / 60;
+        date_time.unit.hour = minutes / 60;
+        date_time.unit.minute = minutes - date_time.unit.hour * 60;
+        date_time.unit.second = seconds_of_day - minutes * 60;
+        return date_time;
     }
 
-    if (years < 2020 || years > 2083) return retval;
-    retval.unit.year = years - WATCH_RTC_REFERENCE_YEAR;
-    retval.unit.month = months + 1;
-    retval.unit.day = remdays + 1;
-
-    retval.unit.hour = remsecs / 3600;
-    retval.unit.minute = remsecs / 60 % 60;
-    retval.unit.second = remsecs % 60;
-
-    return retval;
-}
+    int32_t days = _watch_utility_days_from_civil(date_time.unit.year + WATCH_RTC_REFERENCE_YEAR, date_time.unit.month, date_time.unit.day);
+    while (seconds_of_day < 0) {
+        seconds_of_day += 86400;
+        days--;
+    }
+    while (seconds_of_day >= 86400) {
+        seconds_of_day -= 86400;
+        days++;
+    }
 
-watch_date_time watch_utility_date_time_convert_zone(watch_date_time date_time, uint32_t origin_utc_offset, uint32_t destination_utc_offset) {
-    uint32_t timestamp = watch_utility_date_time_to_unix_time(date_time, origin_utc_offset);
-    return watch_utility_date_time_from_unix_time(timestamp, destination_utc_offset);
+    return _watch_utility_date_time_from_days(days, seconds_of_day);
 }
 
 watch_duration_t watch_utility_seconds_to_duration(uint32_t seconds) {
@@ -88,8 +88,8 @@ uint8_t is_leap(uint16_t year);
   * @param second The second of the date you wish to convert.
   * @param utc_offset The number of seconds that date_time is offset from UTC, or 0 if the time is UTC.
   * @return A UNIX timestamp for the given date/time and UTC offset.
-  * @note Implemented by Wesley Ellis (tahnok) and based on BSD-licensed code by Josh Haberman:
-  *       https://blog.reverberate.org/2020/05/12/optimizing-date-algorithms.html
+  * @note Uses Howard Hinnant's public domain days_from_civil algorithm, in 32-bit unsigned arithmetic:
+  *       http://howardhinnant.github.io/date_algorithms.html
   */
 uint32_t watch_utility_convert_to_unix_time(uint16_t year, uint8_t month, uint8_t day, uint8_t hour, uint8_t minute, uint8_t second, uint32_t utc_offset);
 
@@ -111,8 +111,8 @@ watch_duration_t watch_utility_seconds_to_duration(uint32_t seconds);
   * @param utc_offset The number of seconds that you wish date_time to be offset from UTC.
   * @return A watch_date_time for the given UNIX timestamp and UTC offset, or if outside the range that
   *         watch_date_time can represent, a watch_date_time with all fields set to 0.
-  * @note Adapted from MIT-licensed code from musl, Copyright © 2005-2014 Rich Felker, et al.:
-  *       https://github.com/esmil/musl/blob/1cc81f5cb0df2b66a795ff0c26d7bbc4d16e13c6/src/time/__secs_to_tm.c
+  * @note Uses Howard Hinnant's public domain civil_from_days algorithm, in 32-bit unsigned arithmetic:
+  *       http://howardhinnant.github.io/date_algorithms.html
   */
 watch_date_time watch_utility_date_time_from_unix_time(uint32_t timestamp, uint32_t utc_offset);
 
@@ -135,8 +135,8 @@ bool watch_utility_convert_to_12_hour(watch_date_time *date_time);
   * @param destination_utc_offset The number of seconds from UTC in the destination time zone
   * @return A watch_date_time for the given UNIX timestamp and UTC offset, or if outside the range that
   *         watch_date_time can represent, a watch_date_time with all fields set to 0.
-  * @note Adapted from MIT-licensed code from musl, Copyright © 2005-2014 Rich Felker, et al.:
-  *       https://github.com/esmil/musl/blob/1cc81f5cb0df2b66a795ff0c26d7bbc4d16e13c6/src/time/__secs_to_tm.c
+  * @note Faster than a round trip through a UNIX timestamp: when the converted time falls on the same date, only
+  *       the time fields change, and otherwise the date moves by whole days.
   */
 watch_date_time watch_utility_date_time_convert_zone(watch_date_time date_time, uint32_t origin_utc_offset, uint32_t destination_utc_offset);
 
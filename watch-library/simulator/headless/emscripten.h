@@ -0,0 +1,61 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _HEADLESS_EMSCRIPTEN_H_INCLUDED
+#define _HEADLESS_EMSCRIPTEN_H_INCLUDED
+
+// The headless simulator builds the browser simulator's sources with the host compiler. It defines __EMSCRIPTEN__ so
+// that everything takes its simulator paths, and these headers stand in for the parts of the Emscripten API that the
+// simulator uses. Timers and animation frames run on a virtual clock (see headless_runtime.c), and EM_ASM blocks,
+// which only ever touch the page, compile to nothing.
+
+#include <stdbool.h>
+
+typedef int EM_BOOL;
+#define EM_TRUE 1
+#define EM_FALSE 0
+
+#define EMSCRIPTEN_KEEPALIVE
+
+#define EM_ASM(...) ((void)0)
+#define EM_ASM_INT(...) (0)
+#define EM_ASM_DOUBLE(...) (0.0)
+
+typedef void (*em_callback_func)(void *userData);
+typedef EM_BOOL (*em_request_animation_frame_callback)(double time, void *userData);
+
+/// Milliseconds since the Unix epoch on the virtual clock, like Date.now().
+double emscripten_date_now(void);
+/// Milliseconds on the virtual clock, like performance.now().
+double emscripten_get_now(void);
+/// Runs every timer that comes due in the next ms milliseconds, then returns with the clock that much later.
+
+long emscripten_set_timeout(em_callback_func cb, double msecs, void *userData);
+void emscripten_clear_timeout(long id);
+long emscripten_set_interval(em_callback_func cb, double msecs, void *userData);
+void emscripten_clear_interval(long id);
+long emscripten_request_animation_frame(em_request_animation_frame_callback cb, void *userData);
+void emscripten_cancel_animation_frame(long id);
+
+#endif
@@ -0,0 +1,80 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _HEADLESS_EMSCRIPTEN_HTML5_H_INCLUDED
+#define _HEADLESS_EMSCRIPTEN_HTML5_H_INCLUDED
+
+// Stand-in for the Emscripten HTML5 API (see ../emscripten.h). Only the keyboard callbacks do anything: the headless
+// runner presses the watch's buttons by sending the same key events the browser would (see headless_runtime.h).
+
+#include <emscripten.h>
+
+typedef int EMSCRIPTEN_RESULT;
+#define EMSCRIPTEN_RESULT_SUCCESS 0
+
+#define EMSCRIPTEN_EVENT_TARGET_DOCUMENT ((const char *)1)
+
+#define EMSCRIPTEN_EVENT_KEYDOWN 2
+#define EMSCRIPTEN_EVENT_KEYUP 3
+#define EMSCRIPTEN_EVENT_MOUSEDOWN 5
+#define EMSCRIPTEN_EVENT_MOUSEUP 6
+#define EMSCRIPTEN_EVENT_MOUSEOUT 36
+#define EMSCRIPTEN_EVENT_FOCUS 13
+#define EMSCRIPTEN_EVENT_BLUR 12
+#define EMSCRIPTEN_EVENT_TOUCHSTART 22
+#define EMSCRIPTEN_EVENT_TOUCHEND 23
+
+typedef struct {
+    char key[32];
+    EM_BOOL repeat;
+} EmscriptenKeyboardEvent;
+
+typedef struct {
+    unsigned short buttons;
+} EmscriptenMouseEvent;
+
+typedef struct {
+    int numTouches;
+} EmscriptenTouchEvent;
+
+typedef struct {
+    char id[128];
+} EmscriptenFocusEvent;
+
+typedef EM_BOOL (*em_key_callback_func)(int eventType, const EmscriptenKeyboardEvent *keyEvent, void *userData);
+typedef EM_BOOL (*em_mouse_callback_func)(int eventType, const EmscriptenMouseEvent *mouseEvent, void *userData);
+typedef EM_BOOL (*em_touch_callback_func)(int eventType, const EmscriptenTouchEvent *touchEvent, void *userData);
+typedef EM_BOOL (*em_focus_callback_func)(int eventType, const EmscriptenFocusEvent *focusEvent, void *userData);
+
+EMSCRIPTEN_RESULT emscripten_set_keydown_callback(const char *target, void *userData, EM_BOOL useCapture, em_key_callback_func callback);
+EMSCRIPTEN_RESULT emscripten_set_keyup_callback(const char *target, void *userData, EM_BOOL useCapture, em_key_callback_func callback);
+EMSCRIPTEN_RESULT emscripten_set_mousedown_callback(const char *target, void *userData, EM_BOOL useCapture, em_mouse_callback_func callback);
+EMSCRIPTEN_RESULT emscripten_set_mouseup_callback(const char *target, void *userData, EM_BOOL useCapture, em_mouse_callback_func callback);
+EMSCRIPTEN_RESULT emscripten_set_mouseout_callback(const char *target, void *userData, EM_BOOL useCapture, em_mouse_callback_func callback);
+EMSCRIPTEN_RESULT emscripten_set_touchstart_callback(const char *target, void *userData, EM_BOOL useCapture, em_touch_callback_func callback);
+EMSCRIPTEN_RESULT emscripten_set_touchend_callback(const char *target, void *userData, EM_BOOL useCapture, em_touch_callback_func callback);
+EMSCRIPTEN_RESULT emscripten_set_focus_callback(const char *target, void *userData, EM_BOOL useCapture, em_focus_callback_func callback);
+EMSCRIPTEN_RESULT emscripten_set_blur_callback(const char *target, void *userData, EM_BOOL useCapture, em_focus_callback_func callback);
+
+#endif
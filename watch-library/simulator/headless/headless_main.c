@@ -0,0 +1,401 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "watch.h"
+#include "watch_private_display.h"
+#include "watch_display_glyphs.h"
+#include "headless_runtime.h"
+#include "watch_sim_storage.h"
+#include "watch_sim_energy.h"
+
+#include <emscripten.h>
+
+/*
+ * The headless simulator runs Movement against a script instead of a web page, as fast as the host can go:
+ *
+ *     watch [-t "YYYY-MM-DD HH:MM:SS"] [-f storage_image] [-w] [-e] [script]
+ *
+ * -t starts the clock at the given local time instead of the host's. -f keeps the flash storage area in a file, so
+ * that the filesystem and its wear carry over from one run to the next, and -w has writes and erases take as long as
+ * they do on the watch (see watch_sim_storage.h). -e echoes each command, as "> " and the line, before whatever it
+ * prints, so that runs of the same script against different builds can be lined up (see utils/sim_matrix.py). The
+ * script is read from the named file, or from standard input
+ * without one. Each line holds one command; blank lines and anything after a # are ignored.
+ *
+ *     wait <duration>              let the watch run for this long
+ *     press <button>               press a button (light, mode or alarm) and keep holding it
+ *     release <button>             let go of a button
+ *     tap <button> [<duration>]    press a button, hold it this long (100ms if not given), and let go
+ *     dump                         print the time and what's on the display
+ *     expect [<display>] [<indicator>...]
+ *                                  check what's on the display, as dump prints it, and report it if it's different
+ *     replay <file>                play back a trace recorded on a watch (see watch_input_trace.h), starting now
+ *     wear                         print flash storage activity, and how many times each row has been erased
+ *     energy [reset]               print the estimated energy each face has cost per simulated hour, or start over
+ *                                  (see watch_sim_energy.h)
+ *
+ * A duration is a number followed by ms, s, m, h or d; a plain number is in seconds. The watch only sees a button
+ * change on its next pass through the loop, so follow a press with a wait before expecting the display to change.
+ * Likewise the display is only redrawn a frame (1/60 s) after each tick, so a dump taken right on a tick shows what the
+ * watch drew for the one before.
+ *
+ * Each dump prints one line: the watch's date and time, the ten digit positions as text in brackets, any indicators
+ * that are lit, and the raw segment data for COM0-COM2. Positions showing something that isn't a known character
+ * print as '?'.
+ *
+ * An expect gives the ten positions in brackets, like a dump's, with a * for any position that can show anything; a
+ * position passes if it shows the same segments as the character given, so an O passes for a 0. Each indicator named
+ * after it must be lit, and one named with a ! in front (!bell) must not be. A script made of taps, waits and expects
+ * is a test: each expectation that isn't met is reported on standard error, with its line, and the run goes on to the
+ * end of the script and exits with status 1. The ones in utils/headless_tests run with make headless-test.
+ */
+
+#define HEADLESS_DEFAULT_TAP_MS 100
+
+typedef struct {
+    const char *name;
+    const char *key;    // the key the browser simulator maps to this button (see watch_extint.c).
+} headless_button_t;
+
+static const headless_button_t buttons[] = {
+    { "light", "l" },
+    { "mode", "m" },
+    { "alarm", "a" },
+};
+
+typedef struct {
+    const char *name;
+    uint8_t com;
+    uint8_t seg;
+} headless_indicator_t;
+
+static const headless_indicator_t indicators[] = {
+    { "signal", 0, 17 },
+    { "bell", 0, 16 },
+    { "pm", 2, 17 },
+    { "24h", 2, 16 },
+    { "lap", 1, 10 },
+    { "colon", 1, 16 },
+};
+
+static void _headless_read_position(uint8_t position, uint16_t segments[WATCH_DISPLAY_NUM_COMS]) {
+    for (uint8_t com = 0; com < WATCH_DISPLAY_NUM_COMS; com++) {
+        segments[com] = (watch_display_framebuffer[com] >> Glyph_Position_Shift[position]) & Glyph_Position_Masks[position][com];
+    }
+}
+
+static char _headless_decode_position(uint8_t position) {
+    uint16_t segments[WATCH_DISPLAY_NUM_COMS];
+    _headless_read_position(position, segments);
+
+    // several characters can share a glyph (0, D and O, say), so try the likeliest ones first: digits, then letters,
+    // then everything else in ASCII order.
+    static const char preferred[] = " 0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz";
+    for (const char *c = preferred; *c; c++) {
+        if (memcmp(Glyph_Table[position][*c - WATCH_DISPLAY_GLYPH_FIRST_CHAR], segments, sizeof(segments)) == 0) return *c;
+    }
+    for (int character = WATCH_DISPLAY_GLYPH_FIRST_CHAR; character <= WATCH_DISPLAY_GLYPH_LAST_CHAR; character++) {
+        if (memcmp(Glyph_Table[position][character - WATCH_DISPLAY_GLYPH_FIRST_CHAR], segments, sizeof(segments)) == 0) return character;
+    }
+
+    return '?';
+}
+
+static bool _headless_indicator_lit(const headless_indicator_t *indicator) {
+    return (watch_display_framebuffer[indicator->com] & ((uint32_t)1 << indicator->seg)) != 0;
+}
+
+static void _headless_dump(void) {
+    watch_date_time now = watch_rtc_get_date_time();
+    printf("%04d-%02d-%02d %02d:%02d:%02d [",
+           now.unit.year + WATCH_RTC_REFERENCE_YEAR, now.unit.month, now.unit.day,
+           now.unit.hour, now.unit.minute, now.unit.second);
+    for (uint8_t position = 0; position < sizeof(Glyph_Position_Shift); position++) putchar(_headless_decode_position(position));
+    putchar(']');
+
+    for (size_t i = 0; i < sizeof(indicators) / sizeof(indicators[0]); i++) {
+        if (_headless_indicator_lit(&indicators[i])) printf(" %s", indicators[i].name);
+    }
+
+    printf(" {");
+    for (uint8_t com = 0; com < WATCH_DISPLAY_NUM_COMS; com++) printf(com ? " %06x" : "%06x", (unsigned)watch_display_framebuffer[com]);
+    printf("}\n");
+    fflush(stdout);
+}
+
+static bool _headless_parse_duration(const char *text, double *ms) {
+    char *unit;
+    double value = strtod(text, &unit);
+    if (unit == text || value < 0) return false;
+
+    if (*unit == 0 || strcmp(unit, "s") == 0) *ms = value * 1000;
+    else if (strcmp(unit, "ms") == 0) *ms = value;
+    else if (strcmp(unit, "m") == 0) *ms = value * 60 * 1000;
+    else if (strcmp(unit, "h") == 0) *ms = value * 60 * 60 * 1000;
+    else if (strcmp(unit, "d") == 0) *ms = value * 24 * 60 * 60 * 1000;
+    else return false;
+
+    return true;
+}
+
+static const headless_button_t *_headless_find_button(const char *name) {
+    if (name == NULL) return NULL;
+    for (size_t i = 0; i < sizeof(buttons) / sizeof(buttons[0]); i++) {
+        if (strcmp(buttons[i].name, name) == 0) return &buttons[i];
+    }
+
+    return NULL;
+}
+
+static bool _headless_replay(const char *path) {
+    FILE *file = fopen(path, "r");
+    if (file == NULL) {
+        perror(path);
+        return false;
+    }
+    fseek(file, 0, SEEK_END);
+    long length = ftell(file);
+    fseek(file, 0, SEEK_SET);
+    char *text = malloc(length + 1);
+    text[fread(text, 1, length, file)] = 0;
+    fclose(file);
+
+    bool ok = watch_input_trace_replay(text);
+    free(text);
+    if (!ok) fprintf(stderr, "%s: not a trace, or its events are out of order\n", path);
+
+    return ok;
+}
+
+static FILE *script;
+static const char *script_name;
+static unsigned int script_line_number;
+static unsigned int failed_expectations;
+static bool echo_commands;
+// the button a tap is holding down, to let go of when its time is up.
+static const headless_button_t *tapped_button;
+
+static void _headless_run_script(void *userData);
+
+static void _headless_expectation_failed(const char *what, const char *expected) {
+    fprintf(stderr, "%s:%u: expected %s %s, but the watch shows [", script_name, script_line_number, what, expected);
+    for (uint8_t position = 0; position < sizeof(Glyph_Position_Shift); position++) fputc(_headless_decode_position(position), stderr);
+    fputc(']', stderr);
+    for (size_t i = 0; i < sizeof(indicators) / sizeof(indicators[0]); i++) {
+        if (_headless_indicator_lit(&indicators[i])) fprintf(stderr, " %s", indicators[i].name);
+    }
+    fputc('\n', stderr);
+    failed_expectations++;
+}
+
+// checks the display against the rest of an expect line. returns false if the line isn't an expectation at all.
+static bool _headless_expect(char *text) {
+    text += strspn(text, " \t");
+    if (*text == '[') {
+        char *end = strchr(text, ']');
+        size_t positions = sizeof(Glyph_Position_Shift);
+        if (end == NULL || (size_t)(end - text - 1) != positions) return false;
+        *end = 0;
+        for (uint8_t position = 0; position < positions; position++) {
+            char expected = text[position + 1];
+            if (expected == '*') continue;
+            if (expected < WATCH_DISPLAY_GLYPH_FIRST_CHAR || expected > WATCH_DISPLAY_GLYPH_LAST_CHAR) return false;
+            uint16_t segments[WATCH_DISPLAY_NUM_COMS];
+            _headless_read_position(position, segments);
+            if (memcmp(Glyph_Table[position][expected - WATCH_DISPLAY_GLYPH_FIRST_CHAR], segments, sizeof(segments)) != 0) {
+                *end = ']';
+                end[1] = 0;
+                _headless_expectation_failed("the display to show", text);
+                return true;
+            }
+        }
+        text = end + 1;
+    }
+
+    for (char *name = strtok(text, " \t\r\n"); name != NULL; name = strtok(NULL, " \t\r\n")) {
+        bool lit = name[0] != '!';
+        const char *indicator_name = lit ? name : name + 1;
+        const headless_indicator_t *indicator = NULL;
+        for (size_t i = 0; i < sizeof(indicators) / sizeof(indicators[0]); i++) {
+            if (strcmp(indicators[i].name, indicator_name) == 0) indicator = &indicators[i];
+        }
+        if (indicator == NULL) return false;
+        if (_headless_indicator_lit(indicator) != lit) {
+            _headless_expectation_failed(lit ? "this to be lit:" : "this to be off:", indicator_name);
+            return true;
+        }
+    }
+
+    return true;
+}
+
+// runs one line of the script, and sets *wait_ms if the script should only go on after that long. returns false if it
+// couldn't make sense of the line.
+static bool _headless_run_command(char *line, double *wait_ms) {
+    char *comment = strchr(line, '#');
+    if (comment) *comment = 0;
+
+    if (echo_commands && line[strspn(line, " \t\r\n")] != 0) printf("> %.*s\n", (int)strcspn(line, "\r\n"), line);
+
+    char *line_end = line + strlen(line);
+    char *command = strtok(line, " \t\r\n");
+    if (command == NULL) return true;
+    if (strcmp(command, "expect") == 0) {
+        // the display can have spaces in it, so this one reads the rest of the line itself.
+        char *rest = command + strlen(command);
+        return _headless_expect(rest < line_end ? rest + 1 : rest);
+    }
+    char *argument = strtok(NULL, " \t\r\n");
+    char *extra = strtok(NULL, " \t\r\n");
+
+    if (strcmp(command, "wait") == 0) {
+        if (argument == NULL || extra != NULL || !_headless_parse_duration(argument, wait_ms)) return false;
+    } else if (strcmp(command, "press") == 0 || strcmp(command, "release") == 0) {
+        const headless_button_t *button = _headless_find_button(argument);
+        if (button == NULL || extra != NULL) return false;
+        headless_runtime_send_key(command[0] == 'p', button->key);
+    } else if (strcmp(command, "tap") == 0) {
+        const headless_button_t *button = _headless_find_button(argument);
+        *wait_ms = HEADLESS_DEFAULT_TAP_MS;
+        if (button == NULL || (extra != NULL && !_headless_parse_duration(extra, wait_ms))) return false;
+        headless_runtime_send_key(true, button->key);
+        tapped_button = button;
+    } else if (strcmp(command, "dump") == 0) {
+        if (argument != NULL) return false;
+        _headless_dump();
+    } else if (strcmp(command, "wear") == 0) {
+        if (argument != NULL) return false;
+        sim_storage_print_wear();
+    } else if (strcmp(command, "energy") == 0) {
+        if (argument == NULL && extra == NULL) sim_energy_print();
+        else if (strcmp(argument, "reset") == 0 && extra == NULL) sim_energy_reset();
+        else return false;
+    } else if (strcmp(command, "replay") == 0) {
+        if (argument == NULL || extra != NULL) return false;
+        return _headless_replay(argument);
+    } else {
+        return false;
+    }
+
+    return true;
+}
+
+// the script runs on the same clock as everything else, picking up again from a timer after every wait. that way, its
+// button presses land wherever the watch happens to be, even in the middle of a delay_ms or waiting in sleep mode.
+static void _headless_run_script(void *userData) {
+    (void) userData;
+
+    if (tapped_button != NULL) {
+        headless_runtime_send_key(false, tapped_button->key);
+        tapped_button = NULL;
+    }
+
+    char line[256];
+    while (fgets(line, sizeof(line), script) != NULL) {
+        double wait_ms = 0;
+        script_line_number++;
+        if (!_headless_run_command(line, &wait_ms)) {
+            fprintf(stderr, "%s:%u: can't understand this line\n", script_name, script_line_number);
+            exit(1);
+        }
+        if (wait_ms > 0 || tapped_button != NULL) {
+            emscripten_set_timeout(_headless_run_script, wait_ms, NULL);
+            return;
+        }
+    }
+
+    // the watch would run forever, so stop here, wherever it is.
+    fflush(stdout);
+    if (failed_expectations) fprintf(stderr, "%s: expectations not met: %u\n", script_name, failed_expectations);
+    exit(failed_expectations ? 1 : 0);
+}
+
+static bool _headless_parse_start_time(const char *text, double *ms) {
+    struct tm tm = { 0 };
+    if (sscanf(text, "%d-%d-%d %d:%d:%d", &tm.tm_year, &tm.tm_mon, &tm.tm_mday, &tm.tm_hour, &tm.tm_min, &tm.tm_sec) != 6) return false;
+    tm.tm_year -= 1900;
+    tm.tm_mon -= 1;
+    tm.tm_isdst = -1;
+    time_t t = mktime(&tm);
+    if (t == (time_t)-1) return false;
+    *ms = (double)t * 1000;
+
+    return true;
+}
+
+int main(int argc, char **argv) {
+    // no getopt here: unistd.h declares a sleep and a read that clash with the watch library's.
+    for (int i = 1; i < argc; i++) {
+        double start_ms;
+        if (strcmp(argv[i], "-t") == 0 && i + 1 < argc) {
+            if (!_headless_parse_start_time(argv[++i], &start_ms)) {
+                fprintf(stderr, "%s: can't read start time '%s', expected YYYY-MM-DD HH:MM:SS\n", argv[0], argv[i]);
+                return 1;
+            }
+            headless_runtime_set_date_now(start_ms);
+        } else if (strcmp(argv[i], "-f") == 0 && i + 1 < argc) {
+            if (!sim_storage_set_file(argv[++i])) {
+                perror(argv[i]);
+                return 1;
+            }
+        } else if (strcmp(argv[i], "-w") == 0) {
+            sim_storage_set_timing(true);
+        } else if (strcmp(argv[i], "-e") == 0) {
+            echo_commands = true;
+        } else if (argv[i][0] != '-' && script_name == NULL) {
+            script_name = argv[i];
+        } else {
+            fprintf(stderr, "usage: %s [-t \"YYYY-MM-DD HH:MM:SS\"] [-f storage_image] [-w] [-e] [script]\n", argv[0]);
+            return 1;
+        }
+    }
+
+    script = stdin;
+    if (script_name == NULL) {
+        script_name = "<stdin>";
+    } else {
+        script = fopen(script_name, "r");
+        if (script == NULL) {
+            perror(script_name);
+            return 1;
+        }
+    }
+
+    _watch_boot_clock_start();
+    app_init();
+    _watch_init();
+    app_setup();
+
+    resume_main_loop();
+    emscripten_set_timeout(_headless_run_script, 0, NULL);
+    headless_runtime_run();
+
+    return 0;
+}
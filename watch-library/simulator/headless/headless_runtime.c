@@ -0,0 +1,240 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <math.h>
+#include <stddef.h>
+#include <string.h>
+#include <sys/time.h>
+
+#include <emscripten.h>
+#include <emscripten/html5.h>
+#include "headless_runtime.h"
+
+// The simulator never has more than a handful of these going at once: the RTC's ticks, alarm and timers, the display
+// blink and tick animations, the buzzer, a face's fast timer and the next animation frame.
+#define HEADLESS_MAX_TIMERS 32
+
+// the browser repaints at 60 Hz, so that's how often a watch that's awake runs its loop.
+#define HEADLESS_FRAME_INTERVAL (1000.0 / 60.0)
+
+// browsers won't run an interval more often than this, and we'd never get anywhere if we did.
+#define HEADLESS_MIN_INTERVAL 1.0
+
+typedef enum {
+    HEADLESS_TIMER_FREE = 0,
+    HEADLESS_TIMER_TIMEOUT,
+    HEADLESS_TIMER_INTERVAL,
+    HEADLESS_TIMER_ANIMATION_FRAME,
+} headless_timer_type_t;
+
+typedef struct {
+    headless_timer_type_t type;
+    long id;
+    double deadline;
+    double interval;
+    // timers due at the same moment run in the order they were scheduled.
+    unsigned long sequence;
+    union {
+        em_callback_func callback;
+        em_request_animation_frame_callback frame_callback;
+    };
+    void *userData;
+} headless_timer_t;
+
+static headless_timer_t timers[HEADLESS_MAX_TIMERS];
+static long next_id = 1;
+static unsigned long next_sequence;
+static double start_ms = -1;
+static double now_ms = -1;
+static em_key_callback_func keydown_callback;
+static em_key_callback_func keyup_callback;
+
+static void _headless_runtime_start_clock(void) {
+    if (now_ms >= 0) return;
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    now_ms = (double)tv.tv_sec * 1000 + tv.tv_usec / 1000;
+    start_ms = now_ms;
+}
+
+static long _headless_runtime_add(headless_timer_type_t type, double delay, void *callback, void *userData) {
+    _headless_runtime_start_clock();
+    for (int i = 0; i < HEADLESS_MAX_TIMERS; i++) {
+        headless_timer_t *timer = &timers[i];
+        if (timer->type != HEADLESS_TIMER_FREE) continue;
+        timer->type = type;
+        timer->id = next_id++;
+        timer->deadline = now_ms + delay;
+        timer->interval = delay;
+        timer->sequence = next_sequence++;
+        if (type == HEADLESS_TIMER_ANIMATION_FRAME) timer->frame_callback = (em_request_animation_frame_callback)callback;
+        else timer->callback = (em_callback_func)callback;
+        timer->userData = userData;
+        return timer->id;
+    }
+
+    return 0;
+}
+
+static void _headless_runtime_remove(long id) {
+    if (id <= 0) return;
+    for (int i = 0; i < HEADLESS_MAX_TIMERS; i++) {
+        if (timers[i].type != HEADLESS_TIMER_FREE && timers[i].id == id) {
+            timers[i].type = HEADLESS_TIMER_FREE;
+            return;
+        }
+    }
+}
+
+static headless_timer_t *_headless_runtime_next_due(double until) {
+    headless_timer_t *next = NULL;
+    for (int i = 0; i < HEADLESS_MAX_TIMERS; i++) {
+        headless_timer_t *timer = &timers[i];
+        if (timer->type == HEADLESS_TIMER_FREE || timer->deadline > until) continue;
+        if (next == NULL || timer->deadline < next->deadline ||
+            (timer->deadline == next->deadline && timer->sequence < next->sequence)) next = timer;
+    }
+
+    return next;
+}
+
+void headless_runtime_set_date_now(double ms) {
+    _headless_runtime_start_clock();
+    double delta = ms - now_ms;
+    // anything already scheduled stays the same time away, just like when a computer's clock is changed.
+    for (int i = 0; i < HEADLESS_MAX_TIMERS; i++) timers[i].deadline += delta;
+    start_ms += delta;
+    now_ms = ms;
+}
+
+static void _headless_runtime_run_until(double until) {
+    headless_timer_t *timer;
+
+    while ((timer = _headless_runtime_next_due(until)) != NULL) {
+        if (timer->deadline > now_ms) now_ms = timer->deadline;
+
+        // take the timer out of the queue (or move it along) before calling it, since the callback may well
+        // schedule or clear timers of its own.
+        headless_timer_t fired = *timer;
+        if (timer->type == HEADLESS_TIMER_INTERVAL) {
+            timer->deadline += timer->interval;
+            timer->sequence = next_sequence++;
+        } else {
+            timer->type = HEADLESS_TIMER_FREE;
+        }
+
+        if (fired.type == HEADLESS_TIMER_ANIMATION_FRAME) fired.frame_callback(now_ms - start_ms, fired.userData);
+        else fired.callback(fired.userData);
+    }
+
+    if (until > now_ms && isfinite(until)) now_ms = until;
+}
+
+void headless_runtime_run(void) {
+    _headless_runtime_start_clock();
+    _headless_runtime_run_until(INFINITY);
+}
+
+bool headless_runtime_send_key(bool down, const char *key) {
+    em_key_callback_func callback = down ? keydown_callback : keyup_callback;
+    if (callback == NULL) return false;
+
+    EmscriptenKeyboardEvent event = { 0 };
+    strncpy(event.key, key, sizeof(event.key) - 1);
+    return callback(down ? EMSCRIPTEN_EVENT_KEYDOWN : EMSCRIPTEN_EVENT_KEYUP, &event, NULL);
+}
+
+double emscripten_date_now(void) {
+    _headless_runtime_start_clock();
+    return now_ms;
+}
+
+double emscripten_get_now(void) {
+    _headless_runtime_start_clock();
+    return now_ms - start_ms;
+}
+
+long emscripten_set_timeout(em_callback_func cb, double msecs, void *userData) {
+    return _headless_runtime_add(HEADLESS_TIMER_TIMEOUT, msecs > 0 ? msecs : 0, (void *)cb, userData);
+}
+
+void emscripten_clear_timeout(long id) {
+    _headless_runtime_remove(id);
+}
+
+long emscripten_set_interval(em_callback_func cb, double msecs, void *userData) {
+    return _headless_runtime_add(HEADLESS_TIMER_INTERVAL, msecs > HEADLESS_MIN_INTERVAL ? msecs : HEADLESS_MIN_INTERVAL, (void *)cb, userData);
+}
+
+void emscripten_clear_interval(long id) {
+    _headless_runtime_remove(id);
+}
+
+long emscripten_request_animation_frame(em_request_animation_frame_callback cb, void *userData) {
+    return _headless_runtime_add(HEADLESS_TIMER_ANIMATION_FRAME, HEADLESS_FRAME_INTERVAL, (void *)cb, userData);
+}
+
+void emscripten_cancel_animation_frame(long id) {
+    _headless_runtime_remove(id);
+}
+
+EMSCRIPTEN_RESULT emscripten_set_keydown_callback(const char *target, void *userData, EM_BOOL useCapture, em_key_callback_func callback) {
+    keydown_callback = callback;
+    return EMSCRIPTEN_RESULT_SUCCESS;
+}
+
+EMSCRIPTEN_RESULT emscripten_set_keyup_callback(const char *target, void *userData, EM_BOOL useCapture, em_key_callback_func callback) {
+    keyup_callback = callback;
+    return EMSCRIPTEN_RESULT_SUCCESS;
+}
+
+// there's no page to click on, so the rest of the HTML5 events never happen.
+
+EMSCRIPTEN_RESULT emscripten_set_mousedown_callback(const char *target, void *userData, EM_BOOL useCapture, em_mouse_callback_func callback) {
+    return EMSCRIPTEN_RESULT_SUCCESS;
+}
+
+EMSCRIPTEN_RESULT emscripten_set_mouseup_callback(const char *target, void *userData, EM_BOOL useCapture, em_mouse_callback_func callback) {
+    return EMSCRIPTEN_RESULT_SUCCESS;
+}
+
+EMSCRIPTEN_RESULT emscripten_set_mouseout_callback(const char *target, void *userData, EM_BOOL useCapture, em_mouse_callback_func callback) {
+    return EMSCRIPTEN_RESULT_SUCCESS;
+}
+
+EMSCRIPTEN_RESULT emscripten_set_touchstart_callback(const char *target, void *userData, EM_BOOL useCapture, em_touch_callback_func callback) {
+    return EMSCRIPTEN_RESULT_SUCCESS;
+}
+
+EMSCRIPTEN_RESULT emscripten_set_touchend_callback(const char *target, void *userData, EM_BOOL useCapture, em_touch_callback_func callback) {
+    return EMSCRIPTEN_RESULT_SUCCESS;
+}
+
+EMSCRIPTEN_RESULT emscripten_set_focus_callback(const char *target, void *userData, EM_BOOL useCapture, em_focus_callback_func callback) {
+    return EMSCRIPTEN_RESULT_SUCCESS;
+}
+
+EMSCRIPTEN_RESULT emscripten_set_blur_callback(const char *target, void *userData, EM_BOOL useCapture, em_focus_callback_func callback) {
+    return EMSCRIPTEN_RESULT_SUCCESS;
+}
@@ -0,0 +1,47 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _HEADLESS_RUNTIME_H_INCLUDED
+#define _HEADLESS_RUNTIME_H_INCLUDED
+
+#include <stdbool.h>
+
+/** @brief The event loop behind the headless simulator's Emscripten stand-ins.
+  * @details Nothing here ever waits for real time to pass. Timeouts, intervals and animation frames are all kept in
+  *          one queue ordered by their deadline on a virtual clock, and time only moves when the runner asks it to,
+  *          by jumping straight to each deadline in turn. A simulated day of a watch that ticks once a second takes
+  *          well under a second to run.
+  */
+
+/// Sets the virtual clock, in milliseconds since the Unix epoch. It starts out at the host's time.
+void headless_runtime_set_date_now(double ms);
+
+/// Runs timers and animation frames in order for as long as there are any left.
+void headless_runtime_run(void);
+
+/// Sends a key event to whatever the simulator registered with emscripten_set_keydown_callback or
+/// emscripten_set_keyup_callback. Returns false if nothing handled it.
+bool headless_runtime_send_key(bool down, const char *key);
+
+#endif
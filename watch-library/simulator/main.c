@@ -25,6 +25,8 @@
 #include <stdio.h>
 #include "watch.h"
 #include "watch_main_loop.h"
+#include "watch_sim_clock.h"
+#include "watch_sim_energy.h"
 
 #include <emscripten.h>
 #include <emscripten/html5.h>
@@ -34,6 +36,12 @@
 #define ANIMATION_FRAME_ID_SUSPENDED (-2)
 
 static bool sleeping = true;
+// set while delay_ms is waiting, so that an animation frame doesn't run the app's loop from inside itself.
+static bool suspended = false;
+// set while the app waits in sleep mode, and cleared by the next interrupt.
+static bool waiting_for_interrupt = false;
+// set if the app should be set up again when it wakes, as it is after watch_enter_sleep_mode.
+static bool setup_on_wake = false;
 static volatile long animation_frame_id = ANIMATION_FRAME_ID_INVALID;
 
 // make compiler happy
@@ -47,17 +55,27 @@ static inline void request_next_frame(void) {
 }
 
 static EM_BOOL main_loop(double time, void *userData) {
+    animation_frame_id = ANIMATION_FRAME_ID_INVALID;
+
     if (main_loop_is_sleeping()) {
         request_next_frame();
         return EM_FALSE;
     }
 
+    // the interrupt that ends the wait will call resume_main_loop, which asks for a frame again.
+    if (waiting_for_interrupt) return EM_FALSE;
+
+    if (setup_on_wake) {
+        setup_on_wake = false;
+        app_setup();
+        sleeping = true;
+    }
+
     if (sleeping) {
         sleeping = false;
         app_wake_from_standby();
     }
 
-    animation_frame_id = ANIMATION_FRAME_ID_INVALID;
     bool can_sleep = app_loop();
 
     if (can_sleep) {
@@ -72,6 +90,9 @@ static EM_BOOL main_loop(double time, void *userData) {
 }
 
 void resume_main_loop(void) {
+    // every callback that would wake the watch from standby comes through here.
+    waiting_for_interrupt = false;
+    sim_energy_count(SIM_ENERGY_WAKE, 1);
     if (!ANIMATION_FRAME_ID_IS_VALID(animation_frame_id)) {
         animation_frame_id = emscripten_request_animation_frame(main_loop, NULL);
     }
@@ -85,27 +106,40 @@ void suspend_main_loop(void) {
     animation_frame_id = ANIMATION_FRAME_ID_SUSPENDED;
 }
 
+void main_loop_run_pending_frame(void) {
+    if (!ANIMATION_FRAME_ID_IS_VALID(animation_frame_id)) return;
+    emscripten_cancel_animation_frame(animation_frame_id);
+    main_loop(emscripten_get_now(), NULL);
+}
+
 void main_loop_sleep(uint32_t ms) {
     main_loop_set_sleeping(true);
-    emscripten_sleep(ms);
+    sim_clock_sleep(ms);
     main_loop_set_sleeping(false);
 }
 
+void main_loop_wait_for_interrupt(bool setup) {
+    // the wait itself happens once the app's loop returns: main_loop does nothing until resume_main_loop.
+    waiting_for_interrupt = true;
+    setup_on_wake = setup;
+}
+
 bool main_loop_is_sleeping(void) {
-    return EM_ASM_INT({ return Module['suspended']; }) != 0;
+    return suspended;
 }
 
 static void main_loop_set_sleeping(bool sleeping) {
-    EM_ASM({
-        Module['suspended'] = $0;
-    }, sleeping);
+    suspended = sleeping;
 }
 
 void delay_ms(const uint16_t ms) {
     main_loop_sleep(ms);
 }
 
+// the headless build brings its own main (headless/headless_main.c), which runs a script against the watch.
+#ifndef WATCH_SIMULATOR_HEADLESS
 int main(void) {
+    _watch_boot_clock_start();
     app_init();
     _watch_init();
     app_setup();
@@ -114,3 +148,4 @@ int main(void) {
 
     return 0;
 }
+#endif
@@ -0,0 +1,43 @@
+// Names the Closure Compiler must leave alone when SIM_RELEASE=1 builds the simulator with --closure 1 (see make.mk).
+// Everything here is shared between the compiled program (its EM_ASM blocks and sim_pre.js) and code Closure never
+// sees: shell.html, which sets these Module properties and implements simHost, and the messages the page and worker
+// pass each other. Closure would otherwise rename them on one side only.
+
+/** @externs */
+
+// the location and shell input the page leaves in the global scope (see shell.c and the location-aware faces).
+var lat;
+var lon;
+var tx;
+
+// the properties of Module that the page sets or calls. Closure keeps any property named in externs, on whatever
+// object, so these don't need Module itself declared here.
+var simModule = {};
+simModule.simHost;
+simModule.storageImage;
+simModule.storageTiming;
+simModule.saveStorageImage;
+simModule.eraseStorageImage;
+simModule._sim_press_button;
+simModule._sim_storage_reset;
+
+// see watch_sim_host.h.
+var simHost = {};
+simHost.display = function(state, changed) {};
+simHost.led = function(red, green) {};
+simHost.enableBuzzer = function(enabled) {};
+simHost.buzzer = function(frequency, leadMs) {};
+simHost.buzzerSchedule = function(notes, leadMs, append) {};
+simHost.button = function(id, pressed) {};
+
+// the fields of the messages between the page and the worker (see sim_pre.js).
+var simMessage = {};
+simMessage.type;
+simMessage.name;
+simMessage.args;
+simMessage.value;
+simMessage.id;
+simMessage.down;
+simMessage.text;
+simMessage.lat;
+simMessage.lon;
@@ -0,0 +1,118 @@
+// Runs ahead of the simulator (see rules.mk), whether it's running on the page or in a Web Worker. It looks after the
+// things that have to work the same in both places: keeping flash storage between visits and, in a worker, passing
+// everything the watch shows to the page and taking the page's input in return (see watch_sim_host.h).
+
+Module.preRun = Module.preRun || [];
+
+// the watch's flash storage survives a reload in IndexedDB (see watch_storage.c). It's loaded before the program
+// starts, and saved whenever the program has changed it.
+(function() {
+  const storageDBName = "sensorwatch_storage";
+  const storageKey = "rwwee";
+
+  function openStorageDB() {
+    return new Promise(function(resolve, reject) {
+      const request = indexedDB.open(storageDBName, 1);
+      request.onupgradeneeded = function() { request.result.createObjectStore("images"); };
+      request.onsuccess = function() { resolve(request.result); };
+      request.onerror = function() { reject(request.error); };
+    });
+  }
+
+  Module.preRun.push(function() {
+    Module.addRunDependency("storage");
+    openStorageDB().then(function(db) {
+      const request = db.transaction("images").objectStore("images").get(storageKey);
+      request.onsuccess = function() {
+        if (request.result) Module.storageImage = new Uint8Array(request.result);
+        Module.removeRunDependency("storage");
+      };
+      request.onerror = function() { Module.removeRunDependency("storage"); };
+    }).catch(function(error) {
+      console.log("couldn't load storage, starting erased: " + error);
+      Module.removeRunDependency("storage");
+    });
+  });
+
+  Module.saveStorageImage = function(image) {
+    openStorageDB().then(function(db) {
+      db.transaction("images", "readwrite").objectStore("images").put(image.buffer, storageKey);
+    });
+  };
+
+  // forgets the saved image, and stops saving, so that the page can reload with storage erased.
+  Module.eraseStorageImage = function(callback) {
+    Module._sim_storage_reset();
+    Module.saveStorageImage = function() {};
+    openStorageDB().then(function(db) {
+      const transaction = db.transaction("images", "readwrite");
+      transaction.objectStore("images").delete(storageKey);
+      transaction.oncomplete = callback;
+    });
+  };
+})();
+
+if (typeof importScripts == "function") {
+  // we're in a worker, where nothing can reach the page directly: post it everything the watch shows, plays or prints.
+  (function() {
+    function post(name) {
+      return function() {
+        postMessage({ type: "host", name: name, args: Array.prototype.slice.call(arguments) });
+      };
+    }
+    Module.simHost = {
+      display: post("display"),
+      led: post("led"),
+      enableBuzzer: post("enableBuzzer"),
+      buzzer: post("buzzer"),
+      buzzerSchedule: post("buzzerSchedule"),
+      button: post("button"),
+    };
+    Module.print = function(text) { postMessage({ type: "print", text: text }); };
+    Module.printErr = function(text) { postMessage({ type: "printErr", text: text }); };
+
+    // the shell and the location-aware faces read these from the global scope (see shell.c).
+    self.tx = "";
+    self.lat = 0;
+    self.lon = 0;
+
+    // calls into the program have to wait until it's ready.
+    let ready = false;
+    const pending = [];
+    function whenReady(callback) {
+      if (ready) callback();
+      else pending.push(callback);
+    }
+    Module.onRuntimeInitialized = function() {
+      ready = true;
+      pending.splice(0).forEach(function(callback) { callback(); });
+    };
+
+    onmessage = function(event) {
+      const message = event.data;
+      switch (message.type) {
+        case "button":
+          whenReady(function() { Module._sim_press_button(message.id, message.down); });
+          break;
+        case "shell":
+          self.tx = message.text;
+          break;
+        case "location":
+          self.lat = message.lat;
+          self.lon = message.lon;
+          break;
+        case "set":
+          Module[message.name] = message.value;
+          break;
+        case "call":
+          whenReady(function() { Module[message.name].apply(null, message.args); });
+          break;
+        case "eraseStorage":
+          whenReady(function() {
+            Module.eraseStorageImage(function() { postMessage({ type: "reload" }); });
+          });
+          break;
+      }
+    };
+  })();
+}
@@ -1,13 +1,100 @@
+#include <string.h>
 #include "watch.h"
+#include "watch_sim_clock.h"
+
+#include <emscripten.h>
 
 bool watch_is_buzzer_or_led_enabled(void) {
     return false;
 }
 
+uint32_t watch_get_cycle_counter(void) {
+    return (uint32_t)(emscripten_get_now() * 1000) & WATCH_CYCLE_COUNTER_MASK;
+}
+
+uint32_t watch_get_cycle_counter_frequency(void) {
+    return 1000000;
+}
+
+// the boot is timed on the host's clock, like the cycle counter: it's how long the code takes that's being measured.
+static double boot_started_at = -1;
+
+void _watch_boot_clock_start(void) {
+    boot_started_at = emscripten_get_now();
+}
+
+uint32_t watch_get_boot_ticks(void) {
+    if (boot_started_at < 0) return 0;
+    return (uint32_t)((emscripten_get_now() - boot_started_at) * WATCH_BOOT_TICKS_PER_SECOND / 1000);
+}
+
+void watch_boot_clock_stop(void) {
+    boot_started_at = -1;
+}
+
+static uint8_t monotonic_users;
+static double monotonic_started_at;
+static long monotonic_compare_timeout_id;
+static ext_irq_cb_t monotonic_compare_callback;
+
+// the count runs on the virtual clock, so it keeps pace with the RTC however fast the simulation goes.
+void watch_monotonic_start(void) {
+    if (monotonic_users++) return;
+    monotonic_started_at = sim_clock_now();
+}
+
+void watch_monotonic_stop(void) {
+    if (monotonic_users) monotonic_users--;
+    if (monotonic_users == 0) watch_monotonic_set_compare(0, NULL);
+}
+
+uint32_t watch_get_monotonic_ticks(void) {
+    if (monotonic_users == 0) return 0;
+    return (uint32_t)(uint64_t)((sim_clock_now() - monotonic_started_at) * WATCH_MONOTONIC_TICKS_PER_SECOND / 1000);
+}
+
+static void cb_monotonic_compare(void *userData) {
+    (void) userData;
+    monotonic_compare_timeout_id = 0;
+    monotonic_compare_callback();
+    // on the watch, the interrupt wakes the main loop.
+    resume_main_loop();
+}
+
+void watch_monotonic_set_compare(uint16_t count, ext_irq_cb_t callback) {
+    if (monotonic_compare_timeout_id) {
+        sim_clock_clear(monotonic_compare_timeout_id);
+        monotonic_compare_timeout_id = 0;
+    }
+    if (callback == NULL || monotonic_users == 0) return;
+
+    double now = (sim_clock_now() - monotonic_started_at) * WATCH_MONOTONIC_TICKS_PER_SECOND / 1000;
+    uint16_t ahead = count - (uint16_t)(uint64_t)now;
+    // a count already passed is due at once, as on the watch.
+    double delay = ahead > 0x7FFF ? 0 : ((uint64_t)now + ahead - now) * 1000 / WATCH_MONOTONIC_TICKS_PER_SECOND;
+    monotonic_compare_callback = callback;
+    monotonic_compare_timeout_id = sim_clock_set_timeout(cb_monotonic_compare, delay, NULL);
+}
+
 bool watch_is_usb_enabled(void) {
+#ifdef WATCH_SIMULATOR_HEADLESS
+    // there's no console to run the shell in; the headless runner's script drives the watch instead.
+    return false;
+#else
+    return true;
+#endif
+}
+
+bool watch_set_performance_level(watch_performance_level_t level) {
+    (void) level;
     return true;
 }
 
 void watch_reset_to_bootloader(void) {
     // No bootloader in the simulator; nothing to do here
 }
+
+void watch_get_serial_number(uint8_t *serial) {
+    static const uint8_t simulated[16] = "SIMULATED WATCH!";
+    memcpy(serial, simulated, 16);
+}
@@ -23,16 +23,31 @@
  */
 
 #include "watch_adc.h"
+#include "watch_sim_energy.h"
+#include "watch_sim_clock.h"
+#include "watch_main_loop.h"
+
+// each reading is the average of this many conversions, as on the watch.
+static uint16_t _num_samples = 16;
+
+static watch_adc_monitor_config_t _monitor;
+static long _monitor_interval_id;
 
 void watch_enable_adc(void) {}
 
 void watch_enable_analog_input(const uint8_t pin) {}
 
 uint16_t watch_get_analog_pin_level(const uint8_t pin) {
+    uint16_t value;
+    sim_energy_count(SIM_ENERGY_ADC_CONVERSION, _num_samples);
+    if (_watch_input_trace_replay_adc(pin, &value)) return value;
     return 32767; // pretend it's half of VCC
 }
 
-void watch_set_analog_num_samples(uint16_t samples) {}
+void watch_set_analog_num_samples(uint16_t samples) {
+    // the hardware takes powers of 2 up to 1024, and ignores anything else.
+    if (__builtin_popcount(samples) == 1 && samples <= 1024) _num_samples = samples;
+}
 
 void watch_set_analog_sampling_length(uint8_t cycles) {}
 
@@ -40,9 +55,54 @@ void watch_set_analog_reference_voltage(watch_adc_reference_voltage reference) {
 
 uint16_t watch_get_vcc_voltage(void) {
     // TODO: (a2) hook to UI
-    return 3000;
+    uint16_t value;
+    sim_energy_count(SIM_ENERGY_ADC_CONVERSION, _num_samples);
+    if (!_watch_input_trace_replay_adc(WATCH_ADC_VCC, &value)) value = 3000;
+    _watch_regulator_note_vcc(value);
+    _watch_battery_note_vcc(value);
+    return value;
+}
+
+void watch_get_analog_levels(const uint8_t *pins, uint16_t *values, uint8_t count) {
+    for (uint8_t i = 0; i < count; i++) {
+        values[i] = pins[i] == WATCH_ADC_VCC ? watch_get_vcc_voltage() : watch_get_analog_pin_level(pins[i]);
+    }
 }
 
 inline void watch_disable_analog_input(const uint8_t pin) {}
 
 inline void watch_disable_adc(void) {}
+
+// one of the monitor's readings, which the watch takes without waking: it costs the conversions, and nothing else.
+static void _watch_adc_monitor_check(void *userData) {
+    uint16_t value;
+    sim_energy_count(SIM_ENERGY_ADC_CONVERSION, 16);
+    if (!_watch_input_trace_replay_adc(_monitor.pin, &value)) value = 32767;
+    if (value > _monitor.low && value < _monitor.high) return;
+
+    watch_adc_monitor_cb_t callback = _monitor.callback;
+    watch_adc_monitor_stop();
+    if (callback != NULL) callback(value);
+    resume_main_loop();
+}
+
+bool watch_adc_monitor_start(const watch_adc_monitor_config_t *config) {
+    bool analog = config->pin == A0 || config->pin == A1 || config->pin == A2 || config->pin == A3 || config->pin == A4;
+    if (!analog) return false;
+    if (__builtin_popcount(config->frequency) != 1 || config->low >= config->high) return false;
+
+    watch_adc_monitor_stop();
+    _monitor = *config;
+    _monitor_interval_id = sim_clock_set_interval(_watch_adc_monitor_check, 1000.0 / config->frequency, NULL);
+
+    return true;
+}
+
+void watch_adc_monitor_stop(void) {
+    sim_clock_clear(_monitor_interval_id);
+    _monitor_interval_id = 0;
+}
+
+bool watch_adc_monitor_is_running(void) {
+    return _monitor_interval_id != 0;
+}
@@ -25,6 +25,8 @@
 #include "watch_buzzer.h"
 #include "watch_private_buzzer.h"
 #include "watch_main_loop.h"
+#include "watch_sim_clock.h"
+#include "watch_sim_energy.h"
 
 #include <emscripten.h>
 #include <emscripten/html5.h>
@@ -34,76 +36,115 @@ static uint32_t buzzer_period;
 
 void cb_watch_buzzer_seq(void *userData);
 
-static uint16_t _seq_position;
-static int8_t _tone_ticks, _repeat_counter;
-static long _em_interval_id = 0;
-static int8_t *_sequence;
+static watch_buzzer_player_t _player;
+static long _em_timeout_id = 0;
 static void (*_cb_finished)(void);
 
-static inline void _em_interval_stop() {
-    emscripten_clear_interval(_em_interval_id);
-    _em_interval_id = 0;
+// the page plays a tune from a schedule of frequencies and durations, a block of notes at a time, so that each note
+// starts exactly when the last one ends however late the browser runs our callbacks. The callbacks below still run at
+// the end of each note, to keep the virtual clock and the energy model in step, but they leave the sound alone.
+#define SIM_BUZZER_SCHEDULE_NOTES 128
+// how far ahead of the sound a schedule starts, so that a streamed tune's next block can join on without a gap.
+#define SIM_BUZZER_SCHEDULE_LATENCY_MS 100
+static double _schedule[SIM_BUZZER_SCHEDULE_NOTES * 2];
+// the notes the page has been sent that haven't started yet.
+static uint16_t _scheduled_notes;
+static bool _schedule_running;
+
+static inline double _note_frequency(uint16_t period) {
+    return period ? 1e6 / period : 0;
 }
 
-void watch_buzzer_play_sequence(int8_t *note_sequence, void (*callback_on_end)(void)) {
-    if (_em_interval_id) _em_interval_stop();
+// sends the page note and the ones after it, up to the end of the tune or of the streamed block it's in.
+static void _schedule_from(watch_buzzer_note_t note) {
+    // a copy of the player with no next_notes stops at the end of the block, rather than asking for the next one early.
+    watch_buzzer_player_t lookahead = _player;
+    lookahead.next_notes = NULL;
+    double ms_per_tick = 1000.0 / 64 / sim_clock_get_rate();
+    uint16_t count = 0;
+    while (note.ticks && count < SIM_BUZZER_SCHEDULE_NOTES) {
+        _schedule[count * 2] = _note_frequency(note.period);
+        _schedule[count * 2 + 1] = note.ticks * ms_per_tick;
+        count++;
+        if (count < SIM_BUZZER_SCHEDULE_NOTES) note = _watch_buzzer_player_next(&lookahead);
+    }
+    EM_ASM({
+        Module.simHost.buzzerSchedule(Array.from(HEAPF64.subarray($0 >> 3, ($0 >> 3) + $1)), $2, $3);
+    }, _schedule, count * 2, sim_clock_get_lead() + SIM_BUZZER_SCHEDULE_LATENCY_MS, _schedule_running);
+    // the first of them is starting now.
+    _scheduled_notes = count - 1;
+    _schedule_running = true;
+}
+
+// tells the energy model what the buzzer's doing, without telling the page.
+static void _model_buzzer(bool on) {
+    if (buzzer_enabled) sim_energy_set_buzzer(on);
+}
+
+static inline void _em_timeout_stop() {
+    sim_clock_clear(_em_timeout_id);
+    _em_timeout_id = 0;
+}
+
+static inline void _em_timeout_start(uint16_t ticks) {
+    // like the watch's TC3, wake once at the end of each note rather than on every 64 Hz tick.
+    _em_timeout_id = sim_clock_set_timeout(cb_watch_buzzer_seq, ticks * 1000.0 / 64, (void *)NULL);
+}
+
+static void _play(const int8_t *note_sequence, const watch_buzzer_note_t *notes, watch_buzzer_next_notes_t next_notes, void (*callback_on_end)(void)) {
+    if (_em_timeout_id) _em_timeout_stop();
     watch_set_buzzer_off();
-    _sequence = note_sequence;
+    _scheduled_notes = 0;
+    _schedule_running = false;
+    _watch_buzzer_player_start(&_player, note_sequence, notes, next_notes);
     _cb_finished = callback_on_end;
-    _seq_position = 0;
-    _tone_ticks = 0;
-    _repeat_counter = -1;
     // prepare buzzer
     watch_enable_buzzer();
-    // initiate 64 hz callback
-    _em_interval_id = emscripten_set_interval(cb_watch_buzzer_seq, (double)(1000/64), (void *)NULL);
+    // the first note starts on the first tick
+    _em_timeout_start(1);
+}
+
+void watch_buzzer_play_sequence(int8_t *note_sequence, void (*callback_on_end)(void)) {
+    _play(note_sequence, NULL, NULL, callback_on_end);
+}
+
+void watch_buzzer_play_notes(const watch_buzzer_note_t *notes, void (*callback_on_end)(void)) {
+    _play(NULL, notes, NULL, callback_on_end);
+}
+
+void watch_buzzer_stream_notes(const watch_buzzer_note_t *notes, watch_buzzer_next_notes_t next_notes, void (*callback_on_end)(void)) {
+    _play(NULL, notes, next_notes, callback_on_end);
 }
 
 void cb_watch_buzzer_seq(void *userData) {
-    // callback for reading the note sequence
+    // callback for the end of a note: start the next one, or end the sequence.
     (void) userData;
-    if (_tone_ticks == 0) {
-        if (_sequence[_seq_position] < 0 && _sequence[_seq_position + 1]) {
-            // repeat indicator found
-            if (_repeat_counter == -1) {
-                // first encounter: load repeat counter
-                _repeat_counter = _sequence[_seq_position + 1];
-            } else _repeat_counter--;
-            if (_repeat_counter > 0)
-                // rewind
-                if (_seq_position > _sequence[_seq_position] * -2)
-                    _seq_position += _sequence[_seq_position] * 2;
-                else
-                    _seq_position = 0;
-            else {
-                // continue
-                _seq_position += 2;
-                _repeat_counter = -1;
-            }
-        }
-        if (_sequence[_seq_position] && _sequence[_seq_position + 1]) {
-            // read note
-            BuzzerNote note = _sequence[_seq_position];
-            if (note == BUZZER_NOTE_REST) {
-                watch_set_buzzer_off();
-            } else {
-                watch_set_buzzer_period(NotePeriods[note]);
-                watch_set_buzzer_on();
-            }
-            // set duration ticks and move to next tone
-            _tone_ticks = _sequence[_seq_position + 1];
-            _seq_position += 2;
-        } else {
-            // end the sequence
-            watch_buzzer_abort_sequence();
-            if (_cb_finished) _cb_finished();
-        }
-    } else _tone_ticks--;
+    _em_timeout_id = 0;
+    const watch_buzzer_note_t *block = _player.notes;
+    watch_buzzer_note_t note = _watch_buzzer_player_next(&_player);
+    // on the watch, every TC3 interrupt runs the main loop; a streamed tune needs it to, to fill the block that ended.
+    if (_player.notes != block) resume_main_loop();
+    if (note.ticks) {
+        if (_scheduled_notes) _scheduled_notes--;
+        else _schedule_from(note);
+        if (note.period) watch_set_buzzer_period(note.period);
+        _model_buzzer(note.period != 0);
+        _em_timeout_start(note.ticks);
+    } else {
+        // the schedule already ends in silence, so there's nothing to tell the page.
+        _scheduled_notes = 0;
+        _schedule_running = false;
+        _model_buzzer(false);
+        if (_cb_finished) _cb_finished();
+    }
 }
 
 void watch_buzzer_abort_sequence(void) {
     // ends/aborts the sequence
-    if (_em_interval_id) _em_interval_stop();
+    if (_em_timeout_id) _em_timeout_stop();
+    _scheduled_notes = 0;
+    _schedule_running = false;
+    // turning it off also cancels whatever's left of the schedule.
     watch_set_buzzer_off();
 }
 
@@ -112,7 +153,7 @@ void watch_enable_buzzer(void) {
     buzzer_period = NotePeriods[BUZZER_NOTE_A4];
 
     EM_ASM({
-        Module['audioContext'] = new (window.AudioContext || window.webkitAudioContext)();
+        Module.simHost.enableBuzzer(true);
     });
 }
 
@@ -123,49 +164,31 @@ void watch_set_buzzer_period(uint32_t period) {
 
 void watch_disable_buzzer(void) {
     buzzer_enabled = false;
+    sim_energy_set_buzzer(false);
     buzzer_period = NotePeriods[BUZZER_NOTE_A4];
 
     EM_ASM({
-        if (Module['audioContext']) {
-            Module['audioContext'].close();
-            Module['audioContext'] = null;
-        }
+        Module.simHost.enableBuzzer(false);
     });
 }
 
 void watch_set_buzzer_on(void) {
     if (!buzzer_enabled) return;
+    sim_energy_set_buzzer(true);
 
+    // a note played in a delay_ms has to wait for real time to catch up with the watch (see sim_clock_sleep).
     EM_ASM({
-        const audioContext = Module['audioContext'];
-        if (!audioContext) return;
-
-        if (!(audioContext._oscillator && audioContext._gain)) {
-            const oscillator = audioContext.createOscillator();
-            const gain = audioContext.createGain();
-            oscillator.type = 'triangle';
-            oscillator.connect(gain);
-            gain.connect(audioContext.destination);
-            oscillator.start(0);
-
-            audioContext._oscillator = oscillator;
-            audioContext._gain = gain;
-        }
-
-        audioContext._oscillator.frequency.value = 1e6/$0;
-        audioContext._gain.gain.value = volumeGain;
-    }, buzzer_period);
+        Module.simHost.buzzer(1e6 / $0, $1);
+    }, buzzer_period, sim_clock_get_lead());
 }
 
 void watch_set_buzzer_off(void) {
     if (!buzzer_enabled) return;
+    sim_energy_set_buzzer(false);
 
     EM_ASM({
-        const audioContext = Module['audioContext'];
-        if (audioContext && audioContext._gain) {
-            audioContext._gain.gain.value = 0;
-        }
-    });
+        Module.simHost.buzzer(0, $0);
+    }, sim_clock_get_lead());
 }
 
 void watch_buzzer_play_note(BuzzerNote note, uint16_t duration_ms) {
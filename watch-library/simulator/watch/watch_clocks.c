@@ -0,0 +1,76 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include "watch_clocks.h"
+
+static bool _standby;
+
+void _watch_clocks_set_standby(bool standby) {
+    _standby = standby;
+}
+
+watch_clock_profile_t watch_get_clock_profile(void) {
+    return _standby ? WATCH_CLOCK_PROFILE_STANDBY : WATCH_CLOCK_PROFILE_INTERACTIVE;
+}
+
+const char *watch_get_clock_profile_name(watch_clock_profile_t profile) {
+    static const char *names[] = {"standby", "interactive", "usb", "burst"};
+    if (profile > WATCH_CLOCK_PROFILE_BURST) return "?";
+    return names[profile];
+}
+
+const char *watch_get_clock_source_name(watch_clock_source_t source) {
+    static const char *names[] = {"xosc", "gclkin", "gclk1", "osculp32k", "xosc32k", "osc16m", "dfll48m", "dpll96m"};
+    if (source > WATCH_CLOCK_SOURCE_DPLL96M) return "?";
+    return names[source];
+}
+
+const char *watch_get_clock_channel_name(uint8_t channel) {
+    (void) channel;
+    return NULL;
+}
+
+void watch_get_clock_tree(watch_clock_tree_t *tree) {
+    // the simulator has no clocks of its own, so this is what the hardware has awake with nothing but the crystal's
+    // peripherals running.
+    for (uint8_t i = 0; i < WATCH_CLOCK_NUM_GENERATORS; i++) {
+        tree->generators[i].enabled = false;
+        tree->generators[i].run_in_standby = false;
+        tree->generators[i].source = WATCH_CLOCK_SOURCE_XOSC;
+        tree->generators[i].frequency = 0;
+    }
+    for (uint8_t i = 0; i < WATCH_CLOCK_NUM_CHANNELS; i++) tree->channels[i] = WATCH_CLOCK_CHANNEL_OFF;
+    tree->osc16m_mhz = 4;
+    tree->generators[0].enabled = true;
+    tree->generators[0].source = WATCH_CLOCK_SOURCE_OSC16M;
+    tree->generators[0].frequency = 4000000;
+    tree->generators[3].enabled = true;
+    tree->generators[3].run_in_standby = true;
+    tree->generators[3].source = WATCH_CLOCK_SOURCE_XOSC32K;
+    tree->generators[3].frequency = 32768;
+    tree->osc16m_on_demand = true;
+    tree->osc16m_run_in_standby = false;
+    tree->dfll_enabled = false;
+    tree->xosc32k_enabled = true;
+}
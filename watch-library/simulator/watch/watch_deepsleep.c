@@ -23,11 +23,12 @@
  */
 
 #include "watch_extint.h"
+#include "watch_main_loop.h"
 
 // this warning only appears when you `make BOARD=OSO-SWAT-A1-02`. it's annoying,
 // but i'd rather have it warn us at build-time than fail silently at run-time.
 // besides, no one but me really has any of these boards anyway.
-#if BTN_ALARM != GPIO(GPIO_PORTA, 2)
+#if !(WATCH_BOARD_EXTWAKE_PINS & WATCH_EXTWAKE_BTN_ALARM)
 #warning This board revision does not support external wake on BTN_ALARM, so watch_register_extwake_callback will not work with it. Use watch_register_interrupt_callback instead.
 #endif
 
@@ -46,6 +47,16 @@ void watch_disable_extwake_interrupt(uint8_t pin) {
     }
 }
 
+void watch_register_button_wake_callback(ext_irq_cb_t callback, bool filter) {
+    watch_enable_external_interrupts();
+    watch_register_interrupt_callback(BTN_ALARM, callback, INTERRUPT_TRIGGER_RISING);
+    watch_register_interrupt_callback(BTN_LIGHT, callback, INTERRUPT_TRIGGER_RISING);
+    watch_register_interrupt_callback(BTN_MODE, callback, INTERRUPT_TRIGGER_RISING);
+}
+
+void watch_disable_button_wake(void) {
+}
+
 void watch_store_backup_data(uint32_t data, uint8_t reg) {
     if (reg < 8) {
         watch_backup_data[reg] = data;
@@ -63,14 +74,15 @@ uint32_t watch_get_backup_data(uint8_t reg) {
 void watch_enter_sleep_mode(void) {
     // TODO: (a2) hook to UI
 
-    // enter standby (4); we basically hang out here until an interrupt wakes us.
-    // sleep(4);
-
-    // call app_setup so the app can re-enable everything we disabled.
-    app_setup();
+    // enter standby (4). the simulator can't wait here, so this returns; once the app's loop does too, the main loop
+    // waits for an interrupt, then calls app_setup so the app can re-enable everything we disabled, and
+    // app_wake_from_standby.
+    main_loop_wait_for_interrupt(true);
+}
 
-    // and call app_wake_from_standby (since main won't have a chance to do it)
-    app_wake_from_standby();
+void watch_enter_sleep_mode_minimal_resume(void) {
+    // TODO: (a2) hook to UI
+    main_loop_wait_for_interrupt(false);
 }
 
 void watch_enter_deep_sleep_mode(void) {
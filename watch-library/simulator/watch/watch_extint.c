@@ -26,6 +26,7 @@
 
 #include "watch_extint.h"
 #include "watch_main_loop.h"
+#include "watch_sim_host.h"
 
 #include <emscripten.h>
 #include <emscripten/html5.h>
@@ -113,6 +114,9 @@ static EM_BOOL watch_invoke_focus_callback(int eventType, const EmscriptenFocusE
 }
 
 static void watch_install_button_callbacks(void) {
+    // in a worker there's no page to listen to; the page sends button presses to sim_press_button instead.
+    if (EM_ASM_INT({ return typeof document == 'undefined'; })) return;
+
     emscripten_set_keydown_callback(EMSCRIPTEN_EVENT_TARGET_DOCUMENT, NULL, EM_FALSE, watch_invoke_key_callback);
     emscripten_set_keyup_callback(EMSCRIPTEN_EVENT_TARGET_DOCUMENT, NULL, EM_FALSE, watch_invoke_key_callback);
 
@@ -176,9 +180,7 @@ static EM_BOOL watch_invoke_interrupt_callback(const uint8_t button_id, watch_in
 
     const bool level = (event & INTERRUPT_TRIGGER_RISING) != 0;
     EM_ASM({
-        const classList = document.querySelector('#btn' + $0).classList;
-        const highlight = 'highlight';
-        $1 ? classList.add(highlight) : classList.remove(highlight);
+        Module.simHost.button($0, $1);
     }, button_id, level);
 
     if (!external_interrupt_enabled || main_loop_is_sleeping()) {
@@ -195,6 +197,21 @@ static EM_BOOL watch_invoke_interrupt_callback(const uint8_t button_id, watch_in
     return EM_TRUE;
 }
 
+EMSCRIPTEN_KEEPALIVE
+void sim_press_button(uint8_t button_id, bool down) {
+    watch_invoke_interrupt_callback(button_id, down ? INTERRUPT_TRIGGER_RISING : INTERRUPT_TRIGGER_FALLING);
+}
+
+void _watch_extint_inject(uint8_t pin, bool level) {
+    uint8_t button_id;
+    if (pin == BTN_MODE) button_id = BTN_ID_MODE;
+    else if (pin == BTN_LIGHT) button_id = BTN_ID_LIGHT;
+    else if (pin == BTN_ALARM) button_id = BTN_ID_ALARM;
+    else return;
+
+    watch_invoke_interrupt_callback(button_id, level ? INTERRUPT_TRIGGER_RISING : INTERRUPT_TRIGGER_FALLING);
+}
+
 void watch_register_interrupt_callback(const uint8_t pin, ext_irq_cb_t callback, watch_interrupt_trigger trigger) {
     if (pin == BTN_MODE) {
         external_interrupt_mode_callback = callback;
@@ -207,3 +224,22 @@ void watch_register_interrupt_callback(const uint8_t pin, ext_irq_cb_t callback,
         external_interrupt_alarm_trigger = trigger;
     }
 }
+
+void watch_set_interrupt_filter(const uint8_t pin, bool enabled) {
+    // browser buttons don't bounce.
+}
+
+// the simulator has no TC to borrow, so Movement times the buttons with its fast tick.
+bool watch_button_timer_start(void) {
+    return false;
+}
+
+uint16_t watch_button_timer_get_count(void) {
+    return 0;
+}
+
+void watch_button_timer_set_compare(uint16_t count, ext_irq_cb_t callback) {
+}
+
+void watch_button_timer_stop(void) {
+}
@@ -0,0 +1,52 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+#include "watch_firmware.h"
+
+// there's only the one image, compiled into the page; the simulator has no room to build another.
+
+const uint8_t *watch_firmware_get_image(uint32_t *size) {
+    *size = 0;
+    return NULL;
+}
+
+uint32_t watch_firmware_get_capacity(void) {
+    return 0;
+}
+
+bool watch_firmware_erase(uint32_t offset) {
+    (void) offset;
+    return false;
+}
+
+bool watch_firmware_write(uint32_t offset, const uint8_t *buffer, uint32_t size) {
+    (void) offset;
+    (void) buffer;
+    (void) size;
+    return false;
+}
+
+void watch_firmware_install(uint32_t offset, uint32_t size) {
+    (void) offset;
+    (void) size;
+}
@@ -22,30 +22,81 @@
  * SOFTWARE.
  */
 
+#include <string.h>
+
 #include "watch_i2c.h"
+#include "watch_sim_energy.h"
+
+// a plain receive reads from whatever register the last send pointed at.
+static uint8_t _last_reg;
 
 void watch_enable_i2c(void) {}
 
 void watch_disable_i2c(void) {}
 
-void watch_i2c_send(int16_t addr, uint8_t *buf, uint16_t length) {}
+void watch_i2c_send(int16_t addr, uint8_t *buf, uint16_t length) {
+    if (length) _last_reg = buf[0];
+    sim_energy_count(SIM_ENERGY_I2C_BYTE, length);
+}
 
-void watch_i2c_receive(int16_t addr, uint8_t *buf, uint16_t length) {}
+void watch_i2c_receive(int16_t addr, uint8_t *buf, uint16_t length) {
+    sim_energy_count(SIM_ENERGY_I2C_BYTE, length);
+    if (!_watch_input_trace_replay_i2c(addr, _last_reg, buf, length)) memset(buf, 0, length);
+}
 
-void watch_i2c_write8(int16_t addr, uint8_t reg, uint8_t data) {}
+void watch_i2c_write8(int16_t addr, uint8_t reg, uint8_t data) {
+    sim_energy_count(SIM_ENERGY_I2C_BYTE, 2);
+}
 
 uint8_t watch_i2c_read8(int16_t addr, uint8_t reg) {
-    return 0;
+    uint8_t data;
+
+    watch_i2c_send(addr, (uint8_t *)&reg, 1);
+    watch_i2c_receive(addr, (uint8_t *)&data, 1);
+
+    return data;
 }
 
 uint16_t watch_i2c_read16(int16_t addr, uint8_t reg) {
-    return 0;
+    uint16_t data;
+
+    watch_i2c_send(addr, (uint8_t *)&reg, 1);
+    watch_i2c_receive(addr, (uint8_t *)&data, 2);
+
+    return data;
 }
 
 uint32_t watch_i2c_read24(int16_t addr, uint8_t reg) {
-    return 0;
+    uint32_t data;
+    data = 0;
+
+    watch_i2c_send(addr, (uint8_t *)&reg, 1);
+    watch_i2c_receive(addr, (uint8_t *)&data, 3);
+
+    return data << 8;
 }
 
 uint32_t watch_i2c_read32(int16_t addr, uint8_t reg) {
-    return 0;
+    uint32_t data;
+
+    watch_i2c_send(addr, (uint8_t *)&reg, 1);
+    watch_i2c_receive(addr, (uint8_t *)&data, 4);
+
+    return data;
+}
+
+bool watch_i2c_transfer_async(int16_t addr, uint8_t *tx_buf, uint16_t tx_length, uint8_t *rx_buf, uint16_t rx_length, void (*callback)(bool success)) {
+    if (tx_length == 0 && rx_length == 0) return false;
+    if (tx_length) watch_i2c_send(addr, tx_buf, tx_length);
+    if (rx_length) watch_i2c_receive(addr, rx_buf, rx_length);
+    if (callback != NULL) callback(true);
+    return true;
+}
+
+bool watch_i2c_is_busy(void) {
+    return false;
+}
+
+bool watch_i2c_wait(void) {
+    return true;
 }
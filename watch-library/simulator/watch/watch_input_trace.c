@@ -0,0 +1,287 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "watch_input_trace.h"
+#include "watch_sim_clock.h"
+
+typedef enum {
+    TRACE_EVENT_BUTTON,
+    TRACE_EVENT_I2C,
+    TRACE_EVENT_ADC,
+} trace_event_type_t;
+
+typedef struct {
+    double ms;
+    trace_event_type_t type;
+    uint8_t pin;            // button or ADC input; I2C address
+    uint8_t reg;            // I2C register
+    uint16_t value;         // button level or ADC reading; I2C data length
+    size_t data;            // offset of I2C data in _replay.data
+} trace_event_t;
+
+// the I2C and ADC events for one register or input, in the order they were recorded.
+typedef struct {
+    trace_event_type_t type;
+    uint8_t pin;
+    uint8_t reg;
+    size_t *events;
+    size_t count;
+    size_t next;            // the first event not yet handed out
+} trace_stream_t;
+
+static struct {
+    bool playing;
+    double start;           // sim_clock_now when playback started
+    trace_event_t *events;
+    size_t num_events;
+    uint8_t *data;
+    size_t data_length;
+    trace_stream_t *streams;
+    size_t num_streams;
+    size_t next_button;     // the first button event not yet injected
+    long timeout_id;
+} _replay;
+
+static bool _watch_input_trace_parse_pin(const char *name, uint8_t *pin) {
+    static const struct {
+        const char *name;
+        uint8_t pin;
+    } pins[] = {
+        { "light", BTN_LIGHT }, { "mode", BTN_MODE }, { "alarm", BTN_ALARM },
+        { "a0", A0 }, { "a1", A1 }, { "a2", A2 }, { "a3", A3 }, { "a4", A4 },
+        { "vcc", WATCH_ADC_VCC },
+    };
+    for (size_t i = 0; i < sizeof(pins) / sizeof(pins[0]); i++) {
+        if (strcmp(pins[i].name, name) == 0) {
+            *pin = pins[i].pin;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool _watch_input_trace_parse_hex(const char *text, size_t *length) {
+    size_t digits = strlen(text);
+    if (digits % 2) return false;
+    _replay.data = realloc(_replay.data, _replay.data_length + digits / 2);
+    for (size_t i = 0; i < digits; i += 2) {
+        unsigned int byte;
+        if (sscanf(text + i, "%2x", &byte) != 1) return false;
+        _replay.data[_replay.data_length + i / 2] = byte;
+    }
+    *length = digits / 2;
+    return true;
+}
+
+static trace_stream_t *_watch_input_trace_find_stream(trace_event_type_t type, uint8_t pin, uint8_t reg) {
+    for (size_t i = 0; i < _replay.num_streams; i++) {
+        trace_stream_t *stream = &_replay.streams[i];
+        if (stream->type == type && stream->pin == pin && (type != TRACE_EVENT_I2C || stream->reg == reg)) return stream;
+    }
+    return NULL;
+}
+
+static void _watch_input_trace_add_to_stream(size_t index) {
+    trace_event_t *event = &_replay.events[index];
+    trace_stream_t *stream = _watch_input_trace_find_stream(event->type, event->pin, event->reg);
+    if (stream == NULL) {
+        _replay.streams = realloc(_replay.streams, (_replay.num_streams + 1) * sizeof(trace_stream_t));
+        stream = &_replay.streams[_replay.num_streams++];
+        *stream = (trace_stream_t){ .type = event->type, .pin = event->pin, .reg = event->reg };
+    }
+    stream->events = realloc(stream->events, (stream->count + 1) * sizeof(size_t));
+    stream->events[stream->count++] = index;
+}
+
+// parses one line into a new event, or into *start for the start line. returns false if the line makes no sense.
+static bool _watch_input_trace_parse_line(char *line, watch_date_time *start, bool *has_start) {
+    char *comment = strchr(line, '#');
+    if (comment) *comment = 0;
+
+    char *time = strtok(line, " \t\r\n");
+    if (time == NULL) return true;
+    char *kind = strtok(NULL, " \t\r\n");
+    char *arg1 = strtok(NULL, " \t\r\n");
+    char *arg2 = strtok(NULL, " \t\r\n");
+    char *arg3 = strtok(NULL, " \t\r\n");
+    if (kind == NULL || arg1 == NULL || arg2 == NULL) return false;
+
+    char *end;
+    trace_event_t event = { .ms = strtod(time, &end) };
+    if (*end != 0 || event.ms < 0) return false;
+
+    unsigned int a, b;
+    if (strcmp(kind, "start") == 0) {
+        int year, month, day, hour, minute, second;
+        if (sscanf(arg1, "%d-%d-%d", &year, &month, &day) != 3 || sscanf(arg2, "%d:%d:%d", &hour, &minute, &second) != 3) return false;
+        start->unit.year = year - WATCH_RTC_REFERENCE_YEAR;
+        start->unit.month = month;
+        start->unit.day = day;
+        start->unit.hour = hour;
+        start->unit.minute = minute;
+        start->unit.second = second;
+        *has_start = true;
+        return true;
+    } else if (strcmp(kind, "btn") == 0) {
+        event.type = TRACE_EVENT_BUTTON;
+        if (!_watch_input_trace_parse_pin(arg1, &event.pin) || sscanf(arg2, "%u", &a) != 1) return false;
+        event.value = a != 0;
+    } else if (strcmp(kind, "i2c") == 0) {
+        event.type = TRACE_EVENT_I2C;
+        size_t length;
+        event.data = _replay.data_length;
+        if (arg3 == NULL || sscanf(arg1, "%x", &a) != 1 || sscanf(arg2, "%x", &b) != 1 || !_watch_input_trace_parse_hex(arg3, &length)) return false;
+        event.pin = a;
+        event.reg = b;
+        event.value = length;
+        _replay.data_length += length;
+    } else if (strcmp(kind, "adc") == 0) {
+        event.type = TRACE_EVENT_ADC;
+        if (!_watch_input_trace_parse_pin(arg1, &event.pin) || sscanf(arg2, "%u", &a) != 1) return false;
+        event.value = a;
+    } else {
+        return false;
+    }
+
+    _replay.events = realloc(_replay.events, (_replay.num_events + 1) * sizeof(trace_event_t));
+    _replay.events[_replay.num_events++] = event;
+    if (event.type != TRACE_EVENT_BUTTON) _watch_input_trace_add_to_stream(_replay.num_events - 1);
+
+    return true;
+}
+
+static void _watch_input_trace_arm(void);
+
+static void _watch_input_trace_inject_buttons(void *userData) {
+    (void) userData;
+    _replay.timeout_id = 0;
+
+    double elapsed = sim_clock_now() - _replay.start;
+    while (_replay.next_button < _replay.num_events) {
+        trace_event_t *event = &_replay.events[_replay.next_button];
+        if (event->type == TRACE_EVENT_BUTTON) {
+            if (event->ms > elapsed) break;
+            _watch_extint_inject(event->pin, event->value);
+        }
+        _replay.next_button++;
+    }
+    _watch_input_trace_arm();
+}
+
+static void _watch_input_trace_arm(void) {
+    while (_replay.next_button < _replay.num_events && _replay.events[_replay.next_button].type != TRACE_EVENT_BUTTON) {
+        _replay.next_button++;
+    }
+    if (_replay.next_button == _replay.num_events) return;
+
+    double delay = _replay.events[_replay.next_button].ms - (sim_clock_now() - _replay.start);
+    _replay.timeout_id = sim_clock_set_timeout(_watch_input_trace_inject_buttons, delay > 0 ? delay : 0, NULL);
+}
+
+void watch_input_trace_replay_stop(void) {
+    sim_clock_clear(_replay.timeout_id);
+    for (size_t i = 0; i < _replay.num_streams; i++) free(_replay.streams[i].events);
+    free(_replay.streams);
+    free(_replay.events);
+    free(_replay.data);
+    memset(&_replay, 0, sizeof(_replay));
+}
+
+bool watch_input_trace_replay(const char *text) {
+    watch_input_trace_replay_stop();
+
+    watch_date_time start;
+    bool has_start = false;
+    double last_ms = 0;
+    for (const char *line = text; *line; ) {
+        size_t length = strcspn(line, "\n");
+        char *copy = strndup(line, length);
+        bool ok = _watch_input_trace_parse_line(copy, &start, &has_start);
+        free(copy);
+        // events have to be in order for the streams and the button cursor to make sense.
+        if (ok && _replay.num_events) {
+            ok = _replay.events[_replay.num_events - 1].ms >= last_ms;
+            last_ms = _replay.events[_replay.num_events - 1].ms;
+        }
+        if (!ok) {
+            watch_input_trace_replay_stop();
+            return false;
+        }
+        line += length;
+        if (*line) line++;
+    }
+
+    if (has_start) watch_rtc_set_date_time(start);
+    _replay.playing = true;
+    _replay.start = sim_clock_now();
+    _watch_input_trace_arm();
+
+    return true;
+}
+
+// hands out the next response that's due, or repeats the last one; before the first is due, that's what you get.
+static trace_event_t *_watch_input_trace_next(trace_stream_t *stream) {
+    double elapsed = sim_clock_now() - _replay.start;
+    size_t index = stream->next;
+    if (index < stream->count && _replay.events[stream->events[index]].ms <= elapsed) {
+        stream->next++;
+    } else if (index > 0) {
+        index--;
+    }
+    return &_replay.events[stream->events[index]];
+}
+
+// returns the last reading that's due, or the first one if none are yet.
+static trace_event_t *_watch_input_trace_latest(trace_stream_t *stream) {
+    double elapsed = sim_clock_now() - _replay.start;
+    while (stream->next < stream->count && _replay.events[stream->events[stream->next]].ms <= elapsed) stream->next++;
+    return &_replay.events[stream->events[stream->next ? stream->next - 1 : 0]];
+}
+
+bool _watch_input_trace_replay_i2c(int16_t addr, uint8_t reg, uint8_t *data, uint16_t length) {
+    if (!_replay.playing) return false;
+    trace_stream_t *stream = _watch_input_trace_find_stream(TRACE_EVENT_I2C, addr, reg);
+    if (stream == NULL) return false;
+
+    trace_event_t *event = _watch_input_trace_next(stream);
+    uint16_t recorded = event->value < length ? event->value : length;
+    memcpy(data, _replay.data + event->data, recorded);
+    memset(data + recorded, 0, length - recorded);
+
+    return true;
+}
+
+bool _watch_input_trace_replay_adc(uint8_t pin, uint16_t *value) {
+    if (!_replay.playing) return false;
+    trace_stream_t *stream = _watch_input_trace_find_stream(TRACE_EVENT_ADC, pin, 0);
+    if (stream == NULL) return false;
+
+    *value = _watch_input_trace_latest(stream)->value;
+
+    return true;
+}
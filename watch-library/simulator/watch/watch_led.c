@@ -22,26 +22,39 @@
  * SOFTWARE.
  */
 
+#include <string.h>
 #include "watch_led.h"
+#include "watch_sim_energy.h"
+#include "watch_sim_clock.h"
+#include "watch_main_loop.h"
 
 #include <emscripten.h>
 
+static struct {
+    watch_led_step_t steps[WATCH_LED_PATTERN_MAX_STEPS];
+    uint8_t num_steps;
+    uint8_t step;
+    uint8_t loops_left;
+    ext_irq_cb_t callback;
+    long interval_id;
+} pattern;
+
+static void _watch_led_show(uint8_t red, uint8_t green) {
+    sim_energy_set_led(red, green);
+    EM_ASM({
+        Module.simHost.led($0, $1);
+    }, red, green);
+}
+
 void watch_enable_leds(void) {}
 
-void watch_disable_leds(void) {}
+void watch_disable_leds(void) {
+    watch_led_stop_pattern();
+}
 
 void watch_set_led_color(uint8_t red, uint8_t green) {
-    EM_ASM({
-        // the watch svg contains an feColorMatrix filter with id ledcolor
-        // and a green svg gradient that mimics the led being on
-        // https://developer.mozilla.org/en-US/docs/Web/SVG/Element/feColorMatrix
-        // this changes the color of the gradient to match the red+green combination
-        let filter = document.getElementById("ledcolor");
-        let color_matrix = filter.children[0].values.baseVal;
-        color_matrix[1].value = $0  / 255; // red value
-        color_matrix[6].value = $1 / 255; // green value
-        document.getElementById('light').style.opacity = Math.min(255, $0 + $1) / 255;
-    }, red, green);
+    watch_led_stop_pattern();
+    _watch_led_show(red, green);
 }
 
 void watch_set_led_red(void) {
@@ -59,3 +72,49 @@ void watch_set_led_yellow(void) {
 void watch_set_led_off(void) {
     watch_set_led_color(0, 0);
 }
+
+// one of the pattern's steps, which the DMAC puts up on the watch without waking the CPU.
+static void _watch_led_pattern_step(void *userData) {
+    (void) userData;
+    if (++pattern.step == pattern.num_steps) {
+        pattern.step = 0;
+        if (pattern.loops_left && --pattern.loops_left == 0) {
+            ext_irq_cb_t callback = pattern.callback;
+            watch_led_stop_pattern();
+            if (callback != NULL) callback();
+            resume_main_loop();
+            return;
+        }
+    }
+    _watch_led_show(pattern.steps[pattern.step].red, pattern.steps[pattern.step].green);
+}
+
+bool watch_led_play_pattern(const watch_led_step_t *steps, uint8_t num_steps, uint16_t step_ms, uint8_t loops,
+                            ext_irq_cb_t callback) {
+    if (num_steps == 0 || num_steps > WATCH_LED_PATTERN_MAX_STEPS) return false;
+    watch_led_stop_pattern();
+
+    memcpy(pattern.steps, steps, num_steps * sizeof(watch_led_step_t));
+    pattern.num_steps = num_steps;
+    pattern.step = 0;
+    pattern.loops_left = loops;
+    pattern.callback = callback;
+    // the watch's timer counts in 1/512 seconds.
+    uint32_t counts = ((uint32_t)step_ms * 512) / 1000;
+    if (counts == 0) counts = 1;
+    _watch_led_show(steps[0].red, steps[0].green);
+    pattern.interval_id = sim_clock_set_interval(_watch_led_pattern_step, counts * 1000.0 / 512, NULL);
+
+    return true;
+}
+
+void watch_led_stop_pattern(void) {
+    if (pattern.interval_id == 0) return;
+    sim_clock_clear(pattern.interval_id);
+    pattern.interval_id = 0;
+    _watch_led_show(0, 0);
+}
+
+bool watch_led_pattern_is_playing(void) {
+    return pattern.interval_id != 0;
+}
@@ -30,6 +30,16 @@ void resume_main_loop(void);
 
 void main_loop_sleep(uint32_t ms);
 
+/// If the app's loop is waiting for the next animation frame, runs it right away instead.
+void main_loop_run_pending_frame(void);
+
+/** @brief Stands in for standby, until a tick, alarm or button calls resume_main_loop.
+  * @details Nothing in the simulator can block, so this returns at once, and the main loop holds off running the
+  *          app's loop until the wake. If setup is true, it calls app_setup before going on, as waking from sleep
+  *          mode does on the watch.
+  */
+void main_loop_wait_for_interrupt(bool setup);
+
 bool main_loop_is_sleeping(void);
 
 void delay_ms(const uint16_t ms);
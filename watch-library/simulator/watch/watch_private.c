@@ -24,18 +24,60 @@
 
 #include "watch_private.h"
 #include "watch_utility.h"
+#include <string.h>
 #include <sys/time.h>
+#include <emscripten.h>
 
 void _watch_init(void) {
     // External wake depends on RTC; calendar is a required module.
     _watch_rtc_init();
 }
 
+// the browser's crypto stands in for the TRNG. the headless build has no crypto, and gets the same xorshift sequence
+// on every run, so that a script rolls the same dice each time.
+void _watch_random_collect(uint32_t *words, uint8_t count) {
+#ifdef WATCH_SIMULATOR_HEADLESS
+    static uint32_t x = 2463534242;
+    for (uint8_t i = 0; i < count; i++) {
+        x ^= x << 13;
+        x ^= x >> 17;
+        x ^= x << 5;
+        words[i] = x;
+    }
+#else
+    for (uint8_t i = 0; i < count; i++) {
+        words[i] = (uint32_t)EM_ASM_INT({
+            return crypto.getRandomValues(new Uint32Array(1))[0];
+        });
+    }
+#endif
+}
+
+// there's no brownout detector; the battery monitor goes by the ADC's readings.
+void _watch_battery_set_detector(uint16_t millivolts) {
+    (void) millivolts;
+}
+
+// there's no DSU, so it's all software.
+bool _watch_crc32_words(uint32_t *crc, const uint32_t *words, size_t count) {
+    (void) crc;
+    (void) words;
+    (void) count;
+    return false;
+}
+
 // this function is called by arc4random to get entropy for random number generation.
-// let's use the SAM L22's true random number generator to seed the PRNG!
 int getentropy(void *buf, size_t buflen);
 int getentropy(void *buf, size_t buflen) {
-    // TODO: (a2) hook to RNG
+    uint8_t *bytes = (uint8_t *)buf;
+    while (buflen) {
+        uint32_t word = watch_random_true();
+        size_t n = buflen < 4 ? buflen : 4;
+        memcpy(bytes, &word, n);
+        bytes += n;
+        buflen -= n;
+    }
+
     return 0;
 }
 
@@ -55,8 +97,14 @@ void _watch_enable_tcc(void) {}
 
 void _watch_disable_tcc(void) {}
 
+void _watch_set_tcc_standby(uint8_t user, bool run_in_standby) {}
+
 void _watch_enable_usb(void) {}
 
+bool _watch_disable_usb(void) {
+    return true;
+}
+
 void watch_disable_TRNG() {}
 
 // this function ends up getting called by printf to log stuff to the USB console.
@@ -65,6 +113,25 @@ int _write(int file, char *ptr, int len) {
     return 0;
 }
 
+size_t cdc_get_write_buffer_space(void) {
+    // output goes straight to the console, so there's always room.
+    return 1024;
+}
+
+size_t cdc_get_write_buffer_high_water_mark(void) {
+    return 0;
+}
+
+uint32_t cdc_get_dropped_byte_count(void) {
+    return 0;
+}
+
+void cdc_reset_write_stats(void) {}
+
+bool cdc_flush(uint32_t timeout_ms) {
+    return true;
+}
+
 int _read(int file, char *ptr, int len) {
     // TODO: hook to UI
     return 0;
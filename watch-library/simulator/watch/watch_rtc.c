@@ -22,18 +22,22 @@
  * SOFTWARE.
  */
 
+#include <math.h>
+#include <time.h>
+
 #include "watch_rtc.h"
+#include "watch_utility.h"
 #include "watch_main_loop.h"
-
-#include <emscripten.h>
-#include <emscripten/html5.h>
+#include "watch_sim_clock.h"
 
 static double time_offset = 0;
-static long tick_callbacks[8] = { -1, -1, -1, -1, -1, -1, -1, -1 };
+static long tick_callbacks[8];
 
-static long alarm_interval_id = -1;
-static long alarm_timeout_id = -1;
-static double alarm_interval;
+static long alarm_timeout_id;
+static watch_date_time alarm_time;
+static watch_rtc_alarm_match alarm_mask;
+static watch_rtc_timer_t *timers;
+static long timer_timeout_id;
 ext_irq_cb_t alarm_callback;
 ext_irq_cb_t btn_alarm_callback;
 ext_irq_cb_t a2_callback;
@@ -46,30 +50,50 @@ bool _watch_rtc_is_enabled(void) {
 void _watch_rtc_init(void) {
 }
 
+static void _watch_rtc_arm_timers(void);
+static void _watch_rtc_arm_alarm(void);
+
+// the browser's local time zone stands in for the watch's; the RTC itself has no idea of time zones.
+static struct tm _watch_rtc_tm_from_date_time(watch_date_time date_time) {
+    struct tm tm = {
+        .tm_year = date_time.unit.year + WATCH_RTC_REFERENCE_YEAR - 1900,
+        .tm_mon = date_time.unit.month - 1,
+        .tm_mday = date_time.unit.day,
+        .tm_hour = date_time.unit.hour,
+        .tm_min = date_time.unit.minute,
+        .tm_sec = date_time.unit.second,
+        .tm_isdst = -1,
+    };
+    return tm;
+}
+
+// milliseconds since the epoch on the watch's clock.
+static double _watch_rtc_now(void) {
+    return sim_clock_now() + time_offset;
+}
+
 void watch_rtc_set_date_time(watch_date_time date_time) {
-    time_offset = EM_ASM_DOUBLE({
-        const year = 2020 + (($0 >> 26) & 0x3f);
-        const month = ($0 >> 22) & 0xf;
-        const day = ($0 >> 17) & 0x1f;
-        const hour = ($0 >> 12) & 0x1f;
-        const minute = ($0 >> 6) & 0x3f;
-        const second = $0 & 0x3f;
-        const date = new Date(year, month - 1, day, hour, minute, second);
-        return date - Date.now();
-    }, date_time.reg);
+    struct tm tm = _watch_rtc_tm_from_date_time(date_time);
+    time_offset = (double)mktime(&tm) * 1000 - sim_clock_now();
+    _watch_rtc_arm_timers();
+    if (alarm_mask != ALARM_MATCH_DISABLED) {
+        sim_clock_clear(alarm_timeout_id);
+        _watch_rtc_arm_alarm();
+    }
 }
 
 watch_date_time watch_rtc_get_date_time(void) {
+    time_t now = (time_t)(_watch_rtc_now() / 1000);
+    struct tm tm;
+    localtime_r(&now, &tm);
+
     watch_date_time retval;
-    retval.reg = EM_ASM_INT({
-        const date = new Date(Date.now() + $0);
-        return date.getSeconds() |
-            (date.getMinutes() << 6) |
-            (date.getHours() << 12) |
-            (date.getDate() << 17) |
-            ((date.getMonth() + 1) << 22) |
-            ((date.getFullYear() - 2020) << 26);
-    }, time_offset);
+    retval.unit.second = tm.tm_sec;
+    retval.unit.minute = tm.tm_min;
+    retval.unit.hour = tm.tm_hour;
+    retval.unit.day = tm.tm_mday;
+    retval.unit.month = tm.tm_mon + 1;
+    retval.unit.year = tm.tm_year + 1900 - WATCH_RTC_REFERENCE_YEAR;
     return retval;
 }
 
@@ -81,9 +105,13 @@ void watch_rtc_disable_tick_callback(void) {
     watch_rtc_disable_periodic_callback(1);
 }
 
+static void watch_invoke_timers(void *userData);
+
 static void watch_invoke_periodic_callback(void *userData) {
     ext_irq_cb_t callback = userData;
     callback();
+    // as on the watch, a timer with slack whose deadline has come goes along with a tick.
+    if (timers != NULL && timers->deadline.reg <= watch_rtc_get_date_time().reg) watch_invoke_timers(NULL);
     resume_main_loop();
 }
 
@@ -98,25 +126,30 @@ void watch_rtc_register_periodic_callback(ext_irq_cb_t callback, uint8_t frequen
     uint8_t per_n = __builtin_clz(tmp);
 
     double interval = 1000.0 / frequency; // in msec
+    // like the RTC's prescaler, ticks line up with the second: a 1 Hz tick comes just as the seconds roll over.
+    double delay = interval - fmod(_watch_rtc_now(), interval);
 
-    if (tick_callbacks[per_n] != -1) emscripten_clear_interval(tick_callbacks[per_n]);
-    tick_callbacks[per_n] = emscripten_set_interval(watch_invoke_periodic_callback, interval, (void *)callback);
+    sim_clock_clear(tick_callbacks[per_n]);
+    tick_callbacks[per_n] = sim_clock_set_periodic(watch_invoke_periodic_callback, delay, interval, (void *)callback);
 }
 
 void watch_rtc_disable_periodic_callback(uint8_t frequency) {
     if (__builtin_popcount(frequency) != 1) return;
     uint8_t per_n = __builtin_clz((frequency & 0xFF) << 24);
-    if (tick_callbacks[per_n] != -1) {
-        emscripten_clear_interval(tick_callbacks[per_n]);
-        tick_callbacks[per_n] = -1;
-    }
+    sim_clock_clear(tick_callbacks[per_n]);
+    tick_callbacks[per_n] = 0;
+}
+
+void watch_rtc_idle_until_periodic_tick(uint8_t frequency) {
+    // there's no sleeping in a browser tab; the caller's next poll will just come sooner.
+    (void) frequency;
 }
 
 void watch_rtc_disable_matching_periodic_callbacks(uint8_t mask) {
     for (int i = 0; i < 8; i++) {
-        if (tick_callbacks[i] != -1 && (mask & (1 << i)) != 0) {
-            emscripten_clear_interval(tick_callbacks[i]);
-            tick_callbacks[i] = -1;
+        if ((mask & (1 << i)) != 0) {
+            sim_clock_clear(tick_callbacks[i]);
+            tick_callbacks[i] = 0;
         }
     }
 }
@@ -125,76 +158,126 @@ void watch_rtc_disable_all_periodic_callbacks(void) {
     watch_rtc_disable_matching_periodic_callbacks(0xFF);
 }
 
-static void watch_invoke_alarm_interval_callback(void *userData) {
-    if (alarm_callback) alarm_callback();
-}
-
 static void watch_invoke_alarm_callback(void *userData) {
+    alarm_timeout_id = 0;
+    _watch_rtc_arm_alarm();
     if (alarm_callback) alarm_callback();
-    alarm_interval_id = emscripten_set_interval(watch_invoke_alarm_interval_callback, alarm_interval, NULL);
+    resume_main_loop();
 }
 
-void watch_rtc_register_alarm_callback(ext_irq_cb_t callback, watch_date_time alarm_time, watch_rtc_alarm_match mask) {
-    watch_rtc_disable_alarm_callback();
-
-    switch (mask) {
-        case ALARM_MATCH_DISABLED:
-            return;
-        case ALARM_MATCH_SS:
-            alarm_interval = 60 * 1000;
-            break;
-        case ALARM_MATCH_MMSS:
-            alarm_interval = 60 * 60 * 1000;
-            break;
-        case ALARM_MATCH_HHMMSS:
-            alarm_interval = 60 * 60 * 60 * 1000;
-            break;
+// sets a timeout for the next moment, strictly after now, that matches the alarm.
+static void _watch_rtc_arm_alarm(void) {
+    double now = _watch_rtc_now();
+    time_t now_seconds = (time_t)(now / 1000);
+    struct tm date;
+    localtime_r(&now_seconds, &date);
+
+    // mktime carries anything that overflows into the next minute, hour or day, just like the RTC does.
+    date.tm_sec = alarm_time.unit.second;
+    if (alarm_mask >= ALARM_MATCH_MMSS) date.tm_min = alarm_time.unit.minute;
+    if (alarm_mask >= ALARM_MATCH_HHMMSS) date.tm_hour = alarm_time.unit.hour;
+    date.tm_isdst = -1;
+
+    double deadline = (double)mktime(&date) * 1000;
+    while (deadline <= now) {
+        switch (alarm_mask) {
+            case ALARM_MATCH_SS:
+                date.tm_min++;
+                break;
+            case ALARM_MATCH_MMSS:
+                date.tm_hour++;
+                break;
+            default:
+                date.tm_mday++;
+                break;
+        }
+        date.tm_isdst = -1;
+        deadline = (double)mktime(&date) * 1000;
     }
 
-    double timeout = EM_ASM_DOUBLE({
-        const now = Date.now();
-        const date = new Date(now + $0);
-
-        const hour = ($1 >> 12) & 0x1f;
-        const minute = ($1 >> 6) & 0x3f;
-        const second = $1 & 0x3f;
-
-        if ($2 == 1) { // SS
-            if (second < date.getSeconds()) date.setMinutes(date.getMinutes() + 1);
-            date.setSeconds(second);
-        } else if ($2 == 2) { // MMSS
-            if (second < date.getSeconds()) date.setMinutes(date.getMinutes() + 1);
-            if (minute < date.getMinutes()) date.setHours(date.getHours() + 1);
-            date.setMinutes(minute, second);
-        } else if ($2 == 3) { // HHMMSS
-            if (second < date.getSeconds()) date.setMinutes(date.getMinutes() + 1);
-            if (minute < date.getMinutes()) date.setHours(date.getHours() + 1);
-            if (hour < date.getHours()) date.setDate(date.getDate() + 1);
-            date.setHours(hour, minute, second);
-        } else {
-            throw 'Invalid alarm match mask';
-        }
+    alarm_timeout_id = sim_clock_set_timeout(watch_invoke_alarm_callback, deadline - now, NULL);
+}
 
-        return date - now;
-    }, time_offset, alarm_time.reg, mask);
+void watch_rtc_register_alarm_callback(ext_irq_cb_t callback, watch_date_time time, watch_rtc_alarm_match mask) {
+    watch_rtc_disable_alarm_callback();
+    if (mask == ALARM_MATCH_DISABLED) return;
 
     alarm_callback = callback;
-    alarm_timeout_id = emscripten_set_timeout(watch_invoke_alarm_callback, timeout, NULL);
+    alarm_time = time;
+    alarm_mask = mask;
+    _watch_rtc_arm_alarm();
 }
 
 void watch_rtc_disable_alarm_callback(void) {
     alarm_callback = NULL;
-    alarm_interval = 0;
+    alarm_mask = ALARM_MATCH_DISABLED;
+
+    sim_clock_clear(alarm_timeout_id);
+    alarm_timeout_id = 0;
+}
 
-    if (alarm_timeout_id != -1) {
-        emscripten_clear_timeout(alarm_timeout_id);
-        alarm_timeout_id = -1;
+static void watch_invoke_timers(void *userData) {
+    timer_timeout_id = 0;
+    watch_date_time now = watch_rtc_get_date_time();
+    while (timers != NULL && timers->deadline.reg <= now.reg) {
+        watch_rtc_timer_t *timer = timers;
+        timers = timer->next;
+        timer->next = NULL;
+        if (timer->callback != NULL) timer->callback();
     }
+    _watch_rtc_arm_timers();
+    resume_main_loop();
+}
 
-    if (alarm_interval_id != -1) {
-        emscripten_clear_interval(alarm_interval_id);
-        alarm_interval_id = -1;
+static void _watch_rtc_arm_timers(void) {
+    sim_clock_clear(timer_timeout_id);
+    timer_timeout_id = 0;
+    if (timers == NULL) return;
+
+    // the timeout is for the earliest moment a timer has to fire; the rest that are due by then go with it.
+    watch_rtc_timer_t *soonest = timers;
+    for (watch_rtc_timer_t *timer = timers->next; timer != NULL; timer = timer->next) {
+        if (timer->latest.reg < soonest->latest.reg) soonest = timer;
     }
+    struct tm deadline = _watch_rtc_tm_from_date_time(soonest->latest);
+    double timeout = (double)mktime(&deadline) * 1000 - _watch_rtc_now();
+    if (timeout < 0) timeout = 0;
+
+    timer_timeout_id = sim_clock_set_timeout(watch_invoke_timers, timeout, NULL);
+}
+
+static void _watch_rtc_unlink_timer(watch_rtc_timer_t *timer) {
+    for (watch_rtc_timer_t **link = &timers; *link != NULL; link = &(*link)->next) {
+        if (*link == timer) {
+            *link = timer->next;
+            timer->next = NULL;
+            return;
+        }
+    }
+}
+
+void watch_rtc_schedule_timer(watch_rtc_timer_t *timer, watch_date_time deadline, ext_irq_cb_t callback) {
+    watch_rtc_schedule_timer_with_slack(timer, deadline, 0, callback);
+}
+
+void watch_rtc_schedule_timer_with_slack(watch_rtc_timer_t *timer, watch_date_time deadline, uint16_t slack, ext_irq_cb_t callback) {
+    _watch_rtc_unlink_timer(timer);
+    timer->deadline = deadline;
+    timer->latest = deadline;
+    if (slack) timer->latest = watch_utility_date_time_from_unix_time(watch_utility_date_time_to_unix_time(deadline, 0) + slack, 0);
+    timer->callback = callback;
+
+    watch_rtc_timer_t **link = &timers;
+    while (*link != NULL && (*link)->deadline.reg <= deadline.reg) link = &(*link)->next;
+    timer->next = *link;
+    *link = timer;
+
+    _watch_rtc_arm_timers();
+}
+
+void watch_rtc_cancel_timer(watch_rtc_timer_t *timer) {
+    _watch_rtc_unlink_timer(timer);
+    _watch_rtc_arm_timers();
 }
 
 void watch_rtc_enable(bool en)
@@ -206,3 +289,21 @@ void watch_rtc_freqcorr_write(int16_t value, int16_t sign)
 {
     //Not simulated
 }
+
+bool watch_rtc_start_crystal_measurement(void) {
+    // the simulated crystal is the computer's clock, and there's no USB host to measure it against.
+    return false;
+}
+
+bool watch_rtc_read_crystal_measurement(int32_t *ppb) {
+    (void) ppb;
+    return false;
+}
+
+void watch_rtc_stop_crystal_measurements(void) {
+}
+
+uint32_t watch_rtc_get_coalesced_interrupt_count(void) {
+    // every callback runs on its own here, even when the clock is running fast, so nothing is ever coalesced.
+    return 0;
+}
@@ -0,0 +1,272 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <math.h>
+#include <stddef.h>
+
+#include "watch_sim_clock.h"
+#include "watch_main_loop.h"
+
+#include <emscripten.h>
+#include <emscripten/html5.h>
+
+// one each for the RTC's eight periodic ticks, alarm and timers, the display's blink and tick, and the buzzer, with
+// room to spare.
+#define SIM_CLOCK_MAX_TIMERS 16
+
+// when running fast, spend at most this much real time catching up before giving the page a turn. if there's more to
+// do than that, the virtual clock falls back a little rather than freezing the page.
+#define SIM_CLOCK_MAX_BATCH_MS 25
+
+typedef struct {
+    sim_clock_callback_t callback;  // NULL if this slot is free.
+    void *userData;
+    long id;
+    double deadline;
+    double interval;                // 0 for a timeout.
+    unsigned long sequence;         // timers due at the same moment run in the order they were scheduled.
+} sim_clock_timer_t;
+
+static sim_clock_timer_t timers[SIM_CLOCK_MAX_TIMERS];
+static long next_id = 1;
+static unsigned long next_sequence;
+
+static double rate = 1;
+static bool started = false;
+// the virtual time at the real moment base_real; from there it moves at rate times real time.
+static double base_virtual;
+static double base_real;
+
+// while callbacks are running, the clock stands still at pinned_now.
+static bool pumping = false;
+static double pinned_now;
+// a sleep moves the clock straight to its end instead of waiting, which can leave it ahead of where real time says it
+// should be. it then stands still at floor_now until real time catches up, so it's never put forward for good.
+static double floor_now;
+static long pump_timeout_id = 0;
+
+static void _sim_clock_pump(void *userData);
+
+static void _sim_clock_start(void) {
+    if (started) return;
+    started = true;
+    base_real = emscripten_date_now();
+    base_virtual = base_real;
+}
+
+static void _sim_clock_rebase(double virtual_now) {
+    base_virtual = virtual_now;
+    base_real = emscripten_date_now();
+}
+
+// where real time says the clock should be.
+static double _sim_clock_line(void) {
+    return base_virtual + (emscripten_date_now() - base_real) * rate;
+}
+
+double sim_clock_now(void) {
+    _sim_clock_start();
+    if (pumping) return pinned_now;
+    double now = _sim_clock_line();
+    return now > floor_now ? now : floor_now;
+}
+
+double sim_clock_get_lead(void) {
+    double lead = (sim_clock_now() - _sim_clock_line()) / rate;
+    return lead > 0 ? lead : 0;
+}
+
+static sim_clock_timer_t *_sim_clock_next(bool timeouts_only) {
+    sim_clock_timer_t *next = NULL;
+    for (int i = 0; i < SIM_CLOCK_MAX_TIMERS; i++) {
+        sim_clock_timer_t *timer = &timers[i];
+        if (timer->callback == NULL || (timeouts_only && timer->interval != 0)) continue;
+        if (next == NULL || timer->deadline < next->deadline ||
+            (timer->deadline == next->deadline && timer->sequence < next->sequence)) next = timer;
+    }
+
+    return next;
+}
+
+// sets one browser timeout for whenever the next deadline comes around.
+static void _sim_clock_arm(void) {
+    // the pump arms the clock again once it's done.
+    if (pumping) return;
+
+    if (pump_timeout_id) {
+        emscripten_clear_timeout(pump_timeout_id);
+        pump_timeout_id = 0;
+    }
+
+    sim_clock_timer_t *next = _sim_clock_next(false);
+    if (next == NULL) return;
+
+    // a timer that's due while the clock stands still runs now; the rest wait for real time to reach them.
+    double delay = next->deadline <= sim_clock_now() ? 0 : (next->deadline - _sim_clock_line()) / rate;
+    pump_timeout_id = emscripten_set_timeout(_sim_clock_pump, delay > 0 ? delay : 0, NULL);
+}
+
+// runs one timer, with the clock standing at its deadline (or where it already is, if that's later).
+static void _sim_clock_fire(sim_clock_timer_t *timer) {
+    if (timer->deadline > pinned_now) pinned_now = timer->deadline;
+
+    // move the timer along (or free it) before calling it, since the callback may well schedule or clear timers.
+    sim_clock_callback_t callback = timer->callback;
+    void *callback_data = timer->userData;
+    if (timer->interval) {
+        timer->deadline += timer->interval;
+        timer->sequence = next_sequence++;
+    } else {
+        timer->callback = NULL;
+    }
+
+    callback(callback_data);
+}
+
+static void _sim_clock_pump(void *userData) {
+    pump_timeout_id = 0;
+    if (pumping) return;
+
+    double line = _sim_clock_line();
+    double target = line > floor_now ? line : floor_now;
+    double batch_start = emscripten_date_now();
+    sim_clock_timer_t *timer;
+    bool fired = false;
+
+    pumping = true;
+    pinned_now = base_virtual > floor_now ? base_virtual : floor_now;
+    while ((timer = _sim_clock_next(false)) != NULL && timer->deadline <= target) {
+        if (fired && rate > 1) {
+            if (emscripten_date_now() - batch_start > SIM_CLOCK_MAX_BATCH_MS) {
+                line = target = pinned_now;
+                break;
+            }
+            // let the app see the last callback before the next one comes in.
+            main_loop_run_pending_frame();
+        }
+
+        _sim_clock_fire(timer);
+        fired = true;
+    }
+    pumping = false;
+
+    // if a callback slept past the target, the clock waits there for real time to catch up.
+    if (pinned_now > floor_now) floor_now = pinned_now;
+    _sim_clock_rebase(line);
+    _sim_clock_arm();
+}
+
+long sim_clock_set_periodic(sim_clock_callback_t callback, double delay, double interval, void *userData) {
+    for (int i = 0; i < SIM_CLOCK_MAX_TIMERS; i++) {
+        sim_clock_timer_t *timer = &timers[i];
+        if (timer->callback != NULL) continue;
+
+        timer->callback = callback;
+        timer->userData = userData;
+        timer->id = next_id++;
+        timer->deadline = sim_clock_now() + (delay > 0 ? delay : 0);
+        timer->interval = interval;
+        timer->sequence = next_sequence++;
+        _sim_clock_arm();
+
+        return timer->id;
+    }
+
+    return 0;
+}
+
+long sim_clock_set_timeout(sim_clock_callback_t callback, double delay, void *userData) {
+    return sim_clock_set_periodic(callback, delay, 0, userData);
+}
+
+long sim_clock_set_interval(sim_clock_callback_t callback, double interval, void *userData) {
+    return sim_clock_set_periodic(callback, interval, interval, userData);
+}
+
+void sim_clock_clear(long id) {
+    if (id == 0) return;
+    for (int i = 0; i < SIM_CLOCK_MAX_TIMERS; i++) {
+        if (timers[i].callback != NULL && timers[i].id == id) {
+            timers[i].callback = NULL;
+            _sim_clock_arm();
+            return;
+        }
+    }
+}
+
+void sim_clock_sleep(uint32_t ms) {
+    // nothing here waits for real time. the clock goes straight to the end of the sleep, running whatever comes due
+    // on the way just as the watch's interrupts would, and then stands still until real time catches up.
+    bool was_pumping = pumping;
+    if (!pumping) {
+        pinned_now = sim_clock_now();
+        pumping = true;
+    }
+
+    double until = pinned_now + ms;
+    sim_clock_timer_t *timer;
+    while ((timer = _sim_clock_next(false)) != NULL && timer->deadline <= until) _sim_clock_fire(timer);
+    pinned_now = until;
+
+    if (!was_pumping) {
+        pumping = false;
+        if (pinned_now > floor_now) floor_now = pinned_now;
+        _sim_clock_arm();
+    }
+}
+
+EMSCRIPTEN_KEEPALIVE
+void sim_clock_set_rate(double new_rate) {
+    if (new_rate < SIM_CLOCK_MIN_RATE) new_rate = SIM_CLOCK_MIN_RATE;
+    if (new_rate > SIM_CLOCK_MAX_RATE) new_rate = SIM_CLOCK_MAX_RATE;
+
+    _sim_clock_start();
+    _sim_clock_rebase(sim_clock_now());
+    rate = new_rate;
+    _sim_clock_arm();
+}
+
+double sim_clock_get_rate(void) {
+    return rate;
+}
+
+EMSCRIPTEN_KEEPALIVE
+bool sim_clock_skip_to_next_event(void) {
+    sim_clock_timer_t *next = _sim_clock_next(true);
+    if (next == NULL || pumping) return false;
+
+    double target = next->deadline;
+    if (target > sim_clock_now()) {
+        for (int i = 0; i < SIM_CLOCK_MAX_TIMERS; i++) {
+            sim_clock_timer_t *timer = &timers[i];
+            if (timer->callback == NULL || timer->interval == 0 || timer->deadline >= target) continue;
+            timer->deadline += ceil((target - timer->deadline) / timer->interval) * timer->interval;
+        }
+        _sim_clock_rebase(target);
+        floor_now = 0;
+    }
+    _sim_clock_arm();
+
+    return true;
+}
@@ -0,0 +1,87 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _WATCH_SIM_CLOCK_H_INCLUDED
+#define _WATCH_SIM_CLOCK_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @brief The simulator's virtual timeline.
+  * @details The RTC, its periodic ticks, alarm and timers, the display's blink and tick animations, the buzzer's note
+  *          sequences and delay_ms all run on this one clock instead of on browser timers directly. It normally keeps
+  *          pace with real time, but can be sped up to 10000 times faster, or skipped straight to the next alarm or
+  *          RTC timer, so a daily chime or a 24-hour countdown can be checked in a few seconds.
+  *
+  *          Callbacks run at the moment they were due: while one runs, sim_clock_now returns its deadline, however
+  *          late the browser got around to it. When the clock runs faster than real time, the app's loop runs between
+  *          callbacks that came due together, so it sees every tick just as it would on the watch.
+  */
+
+typedef void (*sim_clock_callback_t)(void *userData);
+
+/// The slowest and fastest rates that sim_clock_set_rate accepts.
+#define SIM_CLOCK_MIN_RATE 1
+#define SIM_CLOCK_MAX_RATE 10000
+
+/// Milliseconds since the Unix epoch on the virtual clock.
+double sim_clock_now(void);
+
+/// Calls callback once, delay milliseconds from now. Returns an id for sim_clock_clear, which is never 0.
+long sim_clock_set_timeout(sim_clock_callback_t callback, double delay, void *userData);
+
+/// Calls callback every interval milliseconds, the first time delay milliseconds from now.
+long sim_clock_set_periodic(sim_clock_callback_t callback, double delay, double interval, void *userData);
+
+/// Calls callback every interval milliseconds, starting one interval from now.
+long sim_clock_set_interval(sim_clock_callback_t callback, double interval, void *userData);
+
+/// Cancels a timeout or interval. Does nothing if id is 0, or if it has already fired.
+void sim_clock_clear(long id);
+
+/** @brief Lets ms milliseconds of virtual time pass before returning.
+  * @details This never waits for real time, so the simulator needs no ASYNCIFY: the clock moves straight to the end
+  *          of the sleep, running any callbacks that come due on the way, as the watch's interrupts would run during a
+  *          delay. It then stands still until real time catches up, so sleeping never puts the clock forward for good.
+  *          The page doesn't get a turn until the sleep is over, so a sound that starts or stops in the middle of
+  *          one has to be scheduled ahead by sim_clock_get_lead.
+  */
+void sim_clock_sleep(uint32_t ms);
+
+/// Returns how many real milliseconds the clock is ahead of real time after a sleep. A sound made now belongs that far
+/// in the future.
+double sim_clock_get_lead(void);
+
+/// Sets how many times faster than real time the clock runs, between SIM_CLOCK_MIN_RATE and SIM_CLOCK_MAX_RATE.
+void sim_clock_set_rate(double rate);
+
+double sim_clock_get_rate(void);
+
+/** @brief Moves the clock straight to the next alarm or RTC timer, and runs it.
+  * @details Periodic ticks and animations before it are moved along rather than run, so the app does not see them.
+  * @return false if there was nothing scheduled to skip to.
+  */
+bool sim_clock_skip_to_next_event(void);
+
+#endif
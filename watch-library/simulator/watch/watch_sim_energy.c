@@ -0,0 +1,148 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#include <stdio.h>
+#include <string.h>
+#include "watch_sim_energy.h"
+#include "watch_sim_clock.h"
+#include "energy_costs.h"
+
+#include <emscripten.h>
+
+#define SIM_ENERGY_NUM_ACCOUNTS 256
+#define SIM_ENERGY_MS_PER_HOUR (60.0 * 60 * 1000)
+
+typedef struct {
+    uint32_t counts[SIM_ENERGY_NUM_EVENTS];
+    double buzzer_ms;
+    double led_ms;
+    double charge;              // µA·s
+} sim_energy_account_t;
+
+static const double event_costs[SIM_ENERGY_NUM_EVENTS] = {
+    [SIM_ENERGY_WAKE] = WATCH_ENERGY_WAKE_UAS,
+    [SIM_ENERGY_PIXEL] = WATCH_ENERGY_PIXEL_UAS,
+    [SIM_ENERGY_I2C_BYTE] = WATCH_ENERGY_I2C_BYTE_UAS,
+    [SIM_ENERGY_SPI_BYTE] = WATCH_ENERGY_SPI_BYTE_UAS,
+    [SIM_ENERGY_ADC_CONVERSION] = WATCH_ENERGY_ADC_CONVERSION_UAS,
+    [SIM_ENERGY_PAGE_WRITE] = WATCH_ENERGY_PAGE_WRITE_UAS,
+    [SIM_ENERGY_ROW_ERASE] = WATCH_ENERGY_ROW_ERASE_UAS,
+};
+
+static sim_energy_account_t accounts[SIM_ENERGY_NUM_ACCOUNTS];
+static uint8_t current_account;
+static double start_time = -1;
+
+// the buzzer and LED are charged for by the millisecond, to the account that turned them on.
+static bool buzzer_on;
+static uint8_t buzzer_account;
+static double buzzer_since;
+static double led_ua;
+static uint8_t led_account;
+static double led_since;
+
+static inline void _sim_energy_start(void) {
+    if (start_time < 0) start_time = sim_clock_now();
+}
+
+// charges for the time the buzzer and LED have been on up to now, as if they'd just been turned on again.
+static void _sim_energy_settle(void) {
+    double now = sim_clock_now();
+    if (buzzer_on) {
+        accounts[buzzer_account].buzzer_ms += now - buzzer_since;
+        accounts[buzzer_account].charge += (now - buzzer_since) / 1000 * WATCH_ENERGY_BUZZER_UA;
+    }
+    if (led_ua > 0) {
+        accounts[led_account].led_ms += now - led_since;
+        accounts[led_account].charge += (now - led_since) / 1000 * led_ua;
+    }
+    buzzer_since = led_since = now;
+}
+
+uint8_t sim_energy_set_account(uint8_t account) {
+    uint8_t previous = current_account;
+    current_account = account;
+    return previous;
+}
+
+void sim_energy_count(sim_energy_event_t event, uint32_t count) {
+    _sim_energy_start();
+    accounts[current_account].counts[event] += count;
+    accounts[current_account].charge += event_costs[event] * count;
+}
+
+void sim_energy_set_buzzer(bool on) {
+    _sim_energy_start();
+    _sim_energy_settle();
+    if (on && !buzzer_on) buzzer_account = current_account;
+    buzzer_on = on;
+}
+
+void sim_energy_set_led(uint8_t red, uint8_t green) {
+    _sim_energy_start();
+    _sim_energy_settle();
+    double ua = (red * WATCH_ENERGY_LED_RED_UA + green * WATCH_ENERGY_LED_GREEN_UA) / 255.0;
+    if (ua > 0 && led_ua == 0) led_account = current_account;
+    led_ua = ua;
+}
+
+double sim_energy_get_charge(uint8_t account) {
+    _sim_energy_settle();
+    return accounts[account].charge;
+}
+
+EMSCRIPTEN_KEEPALIVE
+void sim_energy_print(void) {
+    _sim_energy_start();
+    _sim_energy_settle();
+    double hours = (sim_clock_now() - start_time) / SIM_ENERGY_MS_PER_HOUR;
+    if (hours <= 0) {
+        printf("no simulated time has passed yet\n");
+        return;
+    }
+
+    double total = 0;
+    printf("%.2f simulated hours; standby costs %.0f uA*s/h (%.1f uA) on top of the faces\n", hours,
+           WATCH_ENERGY_STANDBY_UA * 3600, (double)WATCH_ENERGY_STANDBY_UA);
+    printf("face\twakes\tpixels\ti2c B\tspi B\tadc\tpg wr\terases\tbuzz ms\tled ms\tuA*s/h\n");
+    for (int i = 0; i < SIM_ENERGY_NUM_ACCOUNTS; i++) {
+        const sim_energy_account_t *account = &accounts[i];
+        if (account->charge == 0) continue;
+        printf("%d", i);
+        for (int event = 0; event < SIM_ENERGY_NUM_EVENTS; event++) printf("\t%lu", (unsigned long)account->counts[event]);
+        printf("\t%.0f\t%.0f\t%.1f\n", account->buzzer_ms, account->led_ms, account->charge / hours);
+        total += account->charge;
+    }
+    total = total / hours + WATCH_ENERGY_STANDBY_UA * 3600;
+    printf("total %.1f uA*s/h, an average of %.2f uA\n", total, total / 3600);
+}
+
+EMSCRIPTEN_KEEPALIVE
+void sim_energy_reset(void) {
+    memset(accounts, 0, sizeof(accounts));
+    start_time = sim_clock_now();
+    buzzer_since = led_since = start_time;
+    if (buzzer_on) buzzer_account = current_account;
+    if (led_ua > 0) led_account = current_account;
+}
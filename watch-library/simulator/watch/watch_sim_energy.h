@@ -0,0 +1,77 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _WATCH_SIM_ENERGY_H_INCLUDED
+#define _WATCH_SIM_ENERGY_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @brief An estimate of what the simulated watch would spend from its battery, and on what.
+  * @details The simulator counts the things that cost the watch energy: waking from standby, setting and clearing
+  *          segments, I2C and SPI bytes, ADC samples, flash page writes and row erases, and the time the buzzer and
+  *          LED spend on. Each is charged at the rate in the board's energy_costs.h, to whichever account is current
+  *          at the time. Movement makes each face its own account, numbered by its index in movement_config.h: a
+  *          face is charged for its own loop and background tasks, and for anything else that happens while it's the
+  *          face on screen.
+  *
+  *          Those rates are estimates, so the totals are too; they're meant for seeing which faces cost the most and
+  *          whether a change helped, over hours or days of simulated time.
+  */
+
+typedef enum {
+    SIM_ENERGY_WAKE = 0,
+    SIM_ENERGY_PIXEL,
+    SIM_ENERGY_I2C_BYTE,
+    SIM_ENERGY_SPI_BYTE,
+    SIM_ENERGY_ADC_CONVERSION,
+    SIM_ENERGY_PAGE_WRITE,
+    SIM_ENERGY_ROW_ERASE,
+    SIM_ENERGY_NUM_EVENTS
+} sim_energy_event_t;
+
+/// Makes account the one that's charged from now on, and returns the one that was.
+uint8_t sim_energy_set_account(uint8_t account);
+
+/// Charges the current account for count of event.
+void sim_energy_count(sim_energy_event_t event, uint32_t count);
+
+/// Tells the model the buzzer went on or off; the account that turned it on pays for the time it was on.
+void sim_energy_set_buzzer(bool on);
+
+/// Tells the model the LED's brightness changed, from 0 (off) to 255 for each color.
+void sim_energy_set_led(uint8_t red, uint8_t green);
+
+/// Returns what account has been charged so far, in µA·s.
+double sim_energy_get_charge(uint8_t account);
+
+/** @brief Prints, for each account that has been charged for anything, what it was charged for and its cost in µA·s
+  *        per simulated hour, along with the standby current that's spent regardless.
+  */
+void sim_energy_print(void);
+
+/// Forgets everything charged so far, and starts the hour over from now.
+void sim_energy_reset(void);
+
+#endif
@@ -0,0 +1,55 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _WATCH_SIM_HOST_H_INCLUDED
+#define _WATCH_SIM_HOST_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @brief How the simulator talks to the page that shows it.
+  * @details The simulator never touches the page itself. Everything it shows or plays goes through Module.simHost,
+  *          which shell.html provides:
+  *
+  *              display(state, changed)     draw the segments set in changed (one word per COM) as state says
+  *              led(red, green)             set the LED's brightness, 0-255 each
+  *              enableBuzzer(enabled)       get sound ready, or put it away
+  *              buzzer(frequency, lead_ms)  start a tone at frequency Hz, or stop it if 0, lead_ms from now
+  *              buzzerSchedule(notes, lead_ms, append)
+  *                                          play a block of a tune: notes is frequency (0 for a rest) and duration
+  *                                          in ms for each note, one after another, starting lead_ms from now, or
+  *                                          where the last block ends if append is set and it hasn't ended yet.
+  *                                          buzzer() cancels whatever's left of it
+  *              button(id, pressed)         show a button as pressed or not
+  *
+  *          When the simulator runs on the page, these are plain calls. When it runs in a Web Worker (see sim_pre.js),
+  *          each one is posted to the page as a message instead, so the watch's loop never waits for layout, and the
+  *          page sends button presses, shell input and other controls back the same way.
+  */
+
+/// Presses (down) or releases the button with the given id: 1 for LIGHT, 2 for MODE and 3 for ALARM, as in the page's
+/// btn1-btn3. The page calls this when the simulator runs in a worker, where it can't listen for input itself.
+void sim_press_button(uint8_t button_id, bool down);
+
+#endif
@@ -0,0 +1,73 @@
+/*
+ * MIT License
+ *
+ * Copyright (c) 2024 Sensor Watch contributors
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ */
+
+#ifndef _WATCH_SIM_STORAGE_H_INCLUDED
+#define _WATCH_SIM_STORAGE_H_INCLUDED
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/** @brief The simulator's flash storage area, and keeping it between runs.
+  * @details The storage area is kept in an image that survives a reload: in the browser it lives in IndexedDB, and
+  *          the headless build can keep it in a file. Along with the data, the image counts how many times each row
+  *          has been erased, so wear builds up across runs just as it would on the watch.
+  *
+  *          Writes behave like the real flash: programming can only clear bits, so writing a page that wasn't erased
+  *          leaves the AND of old and new data. With timing turned on, each write and erase also keeps the storage
+  *          busy for as long as the SAM L22's NVM controller can take, on the simulator's clock, so watch_storage_sync,
+  *          watch_storage_is_busy and the ready callback behave as they do on hardware.
+  */
+
+/// The longest a page write and a row erase take, from the SAM L22 datasheet's NVM characteristics.
+#define SIM_STORAGE_PAGE_WRITE_MS 2.5
+#define SIM_STORAGE_ROW_ERASE_MS 6
+
+typedef struct {
+    uint32_t reads;             // calls to watch_storage_read and watch_storage_get_address
+    uint32_t bytes_read;
+    uint32_t page_writes;
+    uint32_t row_erases;
+    double busy_ms;             // time spent writing and erasing, with timing on
+} sim_storage_stats_t;
+
+/** @brief Keeps the storage area in a file (headless build only). Call this before anything touches storage.
+  * @details If the file exists, storage starts out with its contents; if not, it's created, fully erased. Every write
+  *          and erase goes straight through to the file.
+  * @return false if the file couldn't be opened or created.
+  */
+bool sim_storage_set_file(const char *path);
+
+/// Turns emulation of the flash controller's write and erase times on or off. It starts out off.
+void sim_storage_set_timing(bool enabled);
+
+/// Returns counts of the reads, writes and erases since the simulator started.
+const sim_storage_stats_t *sim_storage_get_stats(void);
+
+/// Prints the counts, and each row's erase count over the life of the image.
+void sim_storage_print_wear(void);
+
+/// Forgets everything in storage, and all its wear, as if the watch had never been used.
+void sim_storage_reset(void);
+
+#endif
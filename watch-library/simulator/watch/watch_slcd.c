@@ -22,9 +22,12 @@
  * SOFTWARE.
  */
 
+#include <string.h>
 #include "watch_slcd.h"
 #include "watch_private_display.h"
 #include "hpl_slcd_config.h"
+#include "watch_sim_clock.h"
+#include "watch_sim_energy.h"
 
 #include <emscripten.h>
 #include <emscripten/html5.h>
@@ -34,33 +37,125 @@
 
 static char blink_character;
 static bool blink_state;
-static long blink_interval_id = - 1;
+static long blink_interval_id = 0;
 static bool tick_state;
-static long tick_interval_id = -1;
+static long tick_interval_id = 0;
+
+uint32_t watch_display_framebuffer[WATCH_DISPLAY_NUM_COMS];
+// what the page is currently showing, so that a flush only sends the segments that changed.
+static uint32_t displayed_framebuffer[WATCH_DISPLAY_NUM_COMS];
+static long display_frame_id = -1;
+// set while watch_display_set_held keeps drawing from reaching the page.
+static bool display_held;
+// set while watch_display_set_off has the display blank.
+static bool display_off;
+// the simulated display looks the same however it's driven, but faces and Movement can still ask.
+static watch_display_drive_t drive = { CONF_SLCD_CONTRAST_ADJUST, CONF_SLCD_BBEN ? CONF_SLCD_BBD : 0, CONF_SLCD_CKDIV + 1 };
+// the segments watch_start_segment_blink is blinking, and whether they're in the hidden half of the blink.
+static uint32_t blink_segments[WATCH_DISPLAY_NUM_COMS];
+static bool blink_hidden;
+static long blink_group_interval_id = 0;
+// the animation watch_start_display_animation is playing, if frames isn't NULL.
+static struct {
+    const watch_display_frame_t *frames;
+    uint32_t mask[WATCH_DISPLAY_NUM_COMS];
+    uint32_t shown[WATCH_DISPLAY_NUM_COMS];
+    uint8_t num_frames;
+    uint8_t frame;
+    uint8_t loops_left;
+    ext_irq_cb_t callback;
+    long interval_id;
+} animation;
+// frames watch_start_display_playback is playing, if frames isn't NULL; shown is the one that's up.
+static struct {
+    const watch_display_frame_t *frames;
+    uint32_t shown[WATCH_DISPLAY_NUM_COMS];
+    uint8_t num_frames;
+    uint8_t frame;
+    ext_irq_cb_t callback;
+    long interval_id;
+} playback;
+
+static EM_BOOL _watch_display_flush(double time, void *userData) {
+    (void) time;
+    (void) userData;
+    display_frame_id = -1;
+    uint32_t shown[WATCH_DISPLAY_NUM_COMS];
+    uint32_t changed[WATCH_DISPLAY_NUM_COMS];
+    bool any_changed = false;
+    for (uint8_t com = 0; com < WATCH_DISPLAY_NUM_COMS; com++) {
+        shown[com] = (watch_display_framebuffer[com] & ~animation.mask[com]) | animation.shown[com];
+        shown[com] &= ~(blink_hidden ? blink_segments[com] : 0);
+        if (playback.frames != NULL) shown[com] = playback.shown[com];
+        if (display_off) shown[com] = 0;
+        changed[com] = shown[com] ^ displayed_framebuffer[com];
+        any_changed |= changed[com] != 0;
+        displayed_framebuffer[com] = shown[com];
+    }
+    if (!any_changed) return EM_FALSE;
+
+    // the page draws it (see watch_sim_host.h), whether we're running on it or in a worker.
+    EM_ASM({
+        Module.simHost.display(HEAPU32.slice($0 >> 2, ($0 >> 2) + $2), HEAPU32.slice($1 >> 2, ($1 >> 2) + $2));
+    }, shown, changed, WATCH_DISPLAY_NUM_COMS);
+    return EM_FALSE;
+}
+
+static inline void _watch_display_request_flush(void) {
+    if (display_held) return;
+    if (display_frame_id == -1) {
+        display_frame_id = emscripten_request_animation_frame(_watch_display_flush, NULL);
+    }
+}
 
 void watch_enable_display(void) {
+    display_off = false;
     watch_clear_display();
 }
 
 void watch_set_pixel(uint8_t com, uint8_t seg) {
-    EM_ASM({
-        document.querySelectorAll("[data-com='" + $0 + "'][data-seg='" + $1 + "']")
-            .forEach((e) => e.style.opacity = 1);
-    }, com, seg);
+    watch_display_framebuffer[com] |= (uint32_t)1 << seg;
+    sim_energy_count(SIM_ENERGY_PIXEL, 1);
+    _watch_display_request_flush();
 }
 
 void watch_clear_pixel(uint8_t com, uint8_t seg) {
-    EM_ASM({
-        document.querySelectorAll("[data-com='" + $0 + "'][data-seg='" + $1 + "']")
-            .forEach((e) => e.style.opacity = 0);
-    }, com, seg);
+    watch_display_framebuffer[com] &= ~((uint32_t)1 << seg);
+    sim_energy_count(SIM_ENERGY_PIXEL, 1);
+    _watch_display_request_flush();
 }
 
 void watch_clear_display(void) {
-    EM_ASM({
-        document.querySelectorAll("[data-com][data-seg]")
-            .forEach((e) => e.style.opacity = 0);
-    });
+    memset(watch_display_framebuffer, 0, sizeof(watch_display_framebuffer));
+    // force every segment to be written on the next flush, whatever the DOM started out showing.
+    memset(displayed_framebuffer, 0xFF, sizeof(displayed_framebuffer));
+    _watch_display_request_flush();
+}
+
+void watch_display_set_held(bool held) {
+    display_held = held;
+}
+
+void watch_display_set_drive(watch_display_drive_t new_drive) {
+    if (new_drive.contrast > 15) new_drive.contrast = 15;
+    if (new_drive.bias_buffer > 16) new_drive.bias_buffer = 16;
+    if (new_drive.frame_divider < 1) new_drive.frame_divider = 1;
+    if (new_drive.frame_divider > 8) new_drive.frame_divider = 8;
+    drive = new_drive;
+}
+
+watch_display_drive_t watch_display_get_drive(void) {
+    return drive;
+}
+
+void watch_display_set_off(bool off) {
+    display_off = off;
+    _watch_display_request_flush();
+}
+
+void watch_display_commit(void) {
+    // the DOM is only repainted once per animation frame, so collect every change made until then.
+    _watch_display_request_flush();
 }
 
 static void watch_invoke_blink_callback(void *userData) {
@@ -70,21 +165,142 @@ static void watch_invoke_blink_callback(void *userData) {
 }
 
 void watch_start_character_blink(char character, uint32_t duration) {
-    if (blink_interval_id != -1) return;
+    if (blink_interval_id) return;
     watch_display_character(character, 7);
     watch_clear_pixel(2, 10); // clear segment B of position 7 since it can't blink
 
     blink_state = true;
     blink_character = character;
-    blink_interval_id = emscripten_set_interval(watch_invoke_blink_callback, (double)duration, NULL);
+    blink_interval_id = sim_clock_set_interval(watch_invoke_blink_callback, (double)duration, NULL);
 }
 
 void watch_stop_blink(void) {
-    emscripten_clear_timeout(blink_interval_id);
-    blink_interval_id = -1;
+    sim_clock_clear(blink_interval_id);
+    blink_interval_id = 0;
     blink_state = false;
 }
 
+static void watch_invoke_segment_blink_callback(void *userData) {
+    (void) userData;
+    blink_hidden = !blink_hidden;
+    _watch_display_request_flush();
+}
+
+void watch_start_segment_blink(const uint32_t segments[WATCH_DISPLAY_NUM_COMS], uint32_t duration) {
+    sim_clock_clear(blink_group_interval_id);
+    memcpy(blink_segments, segments, sizeof(blink_segments));
+    blink_hidden = false;
+    _watch_display_request_flush();
+    blink_group_interval_id = sim_clock_set_interval(watch_invoke_segment_blink_callback, (double)duration, NULL);
+}
+
+void watch_stop_segment_blink(void) {
+    sim_clock_clear(blink_group_interval_id);
+    blink_group_interval_id = 0;
+    memset(blink_segments, 0, sizeof(blink_segments));
+    blink_hidden = false;
+    _watch_display_request_flush();
+}
+
+static void _watch_display_show_frame(void) {
+    const watch_display_frame_t *frame = &animation.frames[animation.frame];
+    for (uint8_t com = 0; com < WATCH_DISPLAY_NUM_COMS; com++) {
+        animation.shown[com] = frame->segments[com] & animation.mask[com];
+    }
+    _watch_display_request_flush();
+}
+
+static void _watch_display_stop_animation(void) {
+    sim_clock_clear(animation.interval_id);
+    if (animation.frames != NULL) {
+        for (uint8_t com = 0; com < WATCH_DISPLAY_NUM_COMS; com++) {
+            watch_display_framebuffer[com] = (watch_display_framebuffer[com] & ~animation.mask[com]) | animation.shown[com];
+        }
+    }
+    memset(&animation, 0, sizeof(animation));
+}
+
+static void watch_invoke_animation_callback(void *userData) {
+    (void) userData;
+    if (++animation.frame < animation.num_frames) {
+        _watch_display_show_frame();
+    } else if (animation.loops_left != 1) {
+        if (animation.loops_left) animation.loops_left--;
+        animation.frame = 0;
+        _watch_display_show_frame();
+    } else {
+        ext_irq_cb_t callback = animation.callback;
+        _watch_display_stop_animation();
+        if (callback != NULL) callback();
+    }
+}
+
+void watch_start_display_animation(const watch_display_frame_t *frames, uint8_t num_frames, const uint32_t mask[WATCH_DISPLAY_NUM_COMS],
+                                   uint32_t frame_duration, uint8_t loops, ext_irq_cb_t callback) {
+    if (tick_interval_id) watch_stop_tick_animation();
+    _watch_display_stop_animation();
+    if (playback.frames != NULL) watch_stop_display_playback();
+    if (frames == NULL || num_frames == 0) return;
+
+    memcpy(animation.mask, mask, sizeof(animation.mask));
+    animation.num_frames = num_frames;
+    animation.loops_left = loops;
+    animation.callback = callback;
+    animation.frames = frames;
+    _watch_display_show_frame();
+    animation.interval_id = sim_clock_set_interval(watch_invoke_animation_callback, (double)frame_duration, NULL);
+}
+
+bool watch_display_animation_is_running(void) {
+    return animation.frames != NULL;
+}
+
+void watch_stop_display_animation(void) {
+    _watch_display_stop_animation();
+}
+
+static void _watch_display_stop_playback(void) {
+    sim_clock_clear(playback.interval_id);
+    if (playback.frames != NULL) memcpy(watch_display_framebuffer, playback.shown, sizeof(playback.shown));
+    memset(&playback, 0, sizeof(playback));
+    _watch_display_request_flush();
+}
+
+static void watch_invoke_playback_callback(void *userData) {
+    (void) userData;
+    memcpy(playback.shown, playback.frames[playback.frame].segments, sizeof(playback.shown));
+    _watch_display_request_flush();
+    if (++playback.frame < playback.num_frames) return;
+
+    ext_irq_cb_t callback = playback.callback;
+    _watch_display_stop_playback();
+    if (callback != NULL) callback();
+}
+
+void watch_start_display_playback(const watch_display_frame_t *frames, uint8_t num_frames, uint32_t frame_duration,
+                                  ext_irq_cb_t callback) {
+    if (tick_interval_id) watch_stop_tick_animation();
+    _watch_display_stop_animation();
+    _watch_display_stop_playback();
+    if (frames == NULL || num_frames == 0) return;
+    if (num_frames > WATCH_DISPLAY_PLAYBACK_MAX_FRAMES) num_frames = WATCH_DISPLAY_PLAYBACK_MAX_FRAMES;
+
+    // like the SLCD's display memory update, the first frame waits for the first period to go by.
+    memcpy(playback.shown, watch_display_framebuffer, sizeof(playback.shown));
+    playback.num_frames = num_frames;
+    playback.callback = callback;
+    playback.frames = frames;
+    playback.interval_id = sim_clock_set_interval(watch_invoke_playback_callback, (double)frame_duration, NULL);
+}
+
+bool watch_display_playback_is_running(void) {
+    return playback.frames != NULL;
+}
+
+void watch_stop_display_playback(void) {
+    _watch_display_stop_playback();
+}
+
 static void watch_invoke_tick_callback(void *userData) {
     tick_state = !tick_state;
     if (tick_state) {
@@ -97,20 +313,22 @@ static void watch_invoke_tick_callback(void *userData) {
 }
 
 void watch_start_tick_animation(uint32_t duration) {
-    if (tick_interval_id != -1) return;
+    if (tick_interval_id) return;
+    if (animation.frames != NULL) watch_stop_display_animation();
+    if (playback.frames != NULL) watch_stop_display_playback();
     watch_display_character(' ', 8);
 
     tick_state = true;
-    tick_interval_id = emscripten_set_interval(watch_invoke_tick_callback, (double)duration, NULL);
+    tick_interval_id = sim_clock_set_interval(watch_invoke_tick_callback, (double)duration, NULL);
 }
 
 bool watch_tick_animation_is_running(void) {
-    return tick_interval_id != -1;
+    return tick_interval_id != 0;
 }
 
 void watch_stop_tick_animation(void) {
-    emscripten_clear_timeout(tick_interval_id);
-    tick_interval_id = -1;
+    sim_clock_clear(tick_interval_id);
+    tick_interval_id = 0;
     tick_state = false;
 
     watch_display_character(' ', 8);
@@ -23,13 +23,23 @@
  */
 
 #include "watch_spi.h"
+#include "watch_sim_energy.h"
 
 void watch_enable_spi(void) {}
 
 void watch_disable_spi(void) {}
 
-bool watch_spi_write(const uint8_t *buf, uint16_t length) { return false; }
+bool watch_spi_write(const uint8_t *buf, uint16_t length) {
+    sim_energy_count(SIM_ENERGY_SPI_BYTE, length);
+    return false;
+}
 
-bool watch_spi_read(uint8_t *buf, uint16_t length) { return false; }
+bool watch_spi_read(uint8_t *buf, uint16_t length) {
+    sim_energy_count(SIM_ENERGY_SPI_BYTE, length);
+    return false;
+}
 
-bool watch_spi_transfer(const uint8_t *data_out, uint8_t *data_in, uint16_t length) { return false; }
+bool watch_spi_transfer(const uint8_t *data_out, uint8_t *data_in, uint16_t length) {
+    sim_energy_count(SIM_ENERGY_SPI_BYTE, length);
+    return false;
+}
@@ -1,32 +1,229 @@
+#include <stddef.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <string.h>
 #include "watch_storage.h"
+#include "watch_sim_storage.h"
+#include "watch_sim_clock.h"
+#include "watch_sim_energy.h"
 
-uint8_t storage[NVMCTRL_ROW_SIZE * NVMCTRL_RWWEE_PAGES];
+#include <emscripten.h>
+
+// the image has always had room for 128 rows, so saved images keep loading; it only grows for a build that gives the
+// filesystem more than that in main flash.
+#define SIM_STORAGE_ROWS (WATCH_STORAGE_NUM_ROWS > NVMCTRL_RWWEE_PAGES ? WATCH_STORAGE_NUM_ROWS : NVMCTRL_RWWEE_PAGES)
+#define SIM_STORAGE_SIZE (NVMCTRL_ROW_SIZE * SIM_STORAGE_ROWS)
+// in the browser, wait this long after the last change before saving the image, so a burst of writes saves once.
+#define SIM_STORAGE_SAVE_DELAY_MS 500
+
+// this is what gets saved: the data, then each row's erase count.
+typedef struct {
+    uint8_t data[SIM_STORAGE_SIZE];
+    uint32_t erase_counts[SIM_STORAGE_ROWS];
+} sim_storage_image_t;
+
+static sim_storage_image_t image;
+
+static bool loaded = false;
+static sim_storage_stats_t stats;
+static bool timing_enabled = false;
+static double busy_until;
+static void (*ready_callback)(void);
+static long ready_timeout_id;
+
+#ifdef WATCH_SIMULATOR_HEADLESS
+static FILE *image_file;
+#else
+static long save_timeout_id;
+#endif
+
+static void _watch_storage_erase_image(void) {
+    memset(image.data, 0xff, sizeof(image.data));
+    memset(image.erase_counts, 0, sizeof(image.erase_counts));
+}
+
+// the first touch of storage picks up the saved image, if there is one; the page loads it before the program starts.
+static void _watch_storage_load(void) {
+    if (loaded) return;
+    loaded = true;
+    _watch_storage_erase_image();
+
+#ifndef WATCH_SIMULATOR_HEADLESS
+    EM_ASM({
+        const saved = Module.storageImage;
+        if (saved && saved.length == $1) HEAPU8.set(saved, $0);
+    }, &image, sizeof(image));
+    timing_enabled = EM_ASM_INT({ return Module.storageTiming ? 1 : 0; });
+#endif
+}
+
+#ifndef WATCH_SIMULATOR_HEADLESS
+static void _watch_storage_save(void *userData) {
+    (void) userData;
+    save_timeout_id = 0;
+    EM_ASM({
+        if (Module.saveStorageImage) Module.saveStorageImage(HEAPU8.slice($0, $0 + $1));
+    }, &image, sizeof(image));
+}
+#endif
+
+// passes a change to a row on to wherever the image is kept.
+static void _watch_storage_persist(uint32_t row) {
+#ifdef WATCH_SIMULATOR_HEADLESS
+    if (image_file == NULL) return;
+    fseek(image_file, row * NVMCTRL_ROW_SIZE, SEEK_SET);
+    fwrite(image.data + row * NVMCTRL_ROW_SIZE, NVMCTRL_ROW_SIZE, 1, image_file);
+    fseek(image_file, offsetof(sim_storage_image_t, erase_counts) + row * sizeof(uint32_t), SEEK_SET);
+    fwrite(&image.erase_counts[row], sizeof(uint32_t), 1, image_file);
+    fflush(image_file);
+#else
+    (void) row;
+    if (save_timeout_id == 0) save_timeout_id = emscripten_set_timeout(_watch_storage_save, SIM_STORAGE_SAVE_DELAY_MS, NULL);
+#endif
+}
+
+static bool _is_valid_range(uint32_t row, uint32_t offset, uint32_t size) {
+    return row < SIM_STORAGE_ROWS && row * NVMCTRL_ROW_SIZE + offset + size <= SIM_STORAGE_SIZE;
+}
+
+static void _watch_storage_start_busy(double ms) {
+    if (!timing_enabled) return;
+    busy_until = sim_clock_now() + ms;
+    stats.busy_ms += ms;
+}
+
+bool sim_storage_set_file(const char *path) {
+#ifdef WATCH_SIMULATOR_HEADLESS
+    loaded = true;
+    _watch_storage_erase_image();
+    image_file = fopen(path, "r+b");
+    if (image_file != NULL) {
+        // a short or foreign file just leaves the rest erased.
+        if (fread(&image, 1, sizeof(image), image_file) == sizeof(image)) return true;
+        fclose(image_file);
+        _watch_storage_erase_image();
+    }
+    image_file = fopen(path, "w+b");
+    if (image_file == NULL) return false;
+    fwrite(&image, sizeof(image), 1, image_file);
+    fflush(image_file);
+    return true;
+#else
+    (void) path;
+    return false;
+#endif
+}
+
+EMSCRIPTEN_KEEPALIVE
+void sim_storage_set_timing(bool enabled) {
+    timing_enabled = enabled;
+    if (!enabled) busy_until = 0;
+}
+
+const sim_storage_stats_t *sim_storage_get_stats(void) {
+    return &stats;
+}
+
+EMSCRIPTEN_KEEPALIVE
+void sim_storage_print_wear(void) {
+    _watch_storage_load();
+    printf("%lu reads (%lu bytes), %lu page writes, %lu row erases, %.1f ms busy\n",
+           (unsigned long)stats.reads, (unsigned long)stats.bytes_read, (unsigned long)stats.page_writes,
+           (unsigned long)stats.row_erases, stats.busy_ms);
+    printf("erases per row:");
+    for (uint32_t row = 0; row < SIM_STORAGE_ROWS; row++) {
+        printf("%s%lu", row % 16 ? " " : "\n", (unsigned long)image.erase_counts[row]);
+    }
+    printf("\n");
+}
+
+EMSCRIPTEN_KEEPALIVE
+void sim_storage_reset(void) {
+    loaded = true;
+    _watch_storage_erase_image();
+    for (uint32_t row = 0; row < SIM_STORAGE_ROWS; row++) _watch_storage_persist(row);
+}
 
 bool watch_storage_read(uint32_t row, uint32_t offset, uint8_t *buffer, uint32_t size) {
-    // printf("read row %ld offset %ld size %ld\n", row, offset, size);
-    memcpy(buffer, storage + row * NVMCTRL_ROW_SIZE + offset, size);
+    if (!_is_valid_range(row, offset, size)) return false;
+    // the array can't be read while it's being programmed.
+    watch_storage_sync();
+    stats.reads++;
+    stats.bytes_read += size;
+    memcpy(buffer, image.data + row * NVMCTRL_ROW_SIZE + offset, size);
 
     return true;
 }
 
+const uint8_t *watch_storage_get_address(uint32_t row, uint32_t offset) {
+    if (!_is_valid_range(row, offset, 0)) return NULL;
+    watch_storage_sync();
+    stats.reads++;
+
+    return image.data + row * NVMCTRL_ROW_SIZE + offset;
+}
+
 bool watch_storage_write(uint32_t row, uint32_t offset, const uint8_t *buffer, uint32_t size) {
-    // printf("write row %ld offset %ld size %ld\n", row, offset, size);
-    memcpy(storage + row * NVMCTRL_ROW_SIZE + offset, buffer, size);
+    if (!_is_valid_range(row, offset, size)) return false;
+    watch_storage_sync();
+
+    // programming can only clear bits; it takes an erase to set them again.
+    uint8_t *page = image.data + row * NVMCTRL_ROW_SIZE + offset;
+    for (uint32_t i = 0; i < size; i++) page[i] &= buffer[i];
+    uint32_t pages = (size + NVMCTRL_PAGE_SIZE - 1) / NVMCTRL_PAGE_SIZE;
+    stats.page_writes += pages;
+    sim_energy_count(SIM_ENERGY_PAGE_WRITE, pages);
+    _watch_storage_start_busy(pages * SIM_STORAGE_PAGE_WRITE_MS);
+    _watch_storage_persist(row);
 
     return true;
 }
 
 bool watch_storage_erase(uint32_t row) {
-    // printf("erase row %ld\n", row);
-    memset(storage + row * NVMCTRL_ROW_SIZE, 0xff, NVMCTRL_ROW_SIZE);
+    if (!_is_valid_range(row, 0, NVMCTRL_ROW_SIZE)) return false;
+    watch_storage_sync();
+
+    memset(image.data + row * NVMCTRL_ROW_SIZE, 0xff, NVMCTRL_ROW_SIZE);
+    image.erase_counts[row]++;
+    stats.row_erases++;
+    sim_energy_count(SIM_ENERGY_ROW_ERASE, 1);
+    _watch_storage_start_busy(SIM_STORAGE_ROW_ERASE_MS);
+    _watch_storage_persist(row);
 
     return true;
 }
 
 bool watch_storage_sync(void) {
-    // nothing to do here!
+    _watch_storage_load();
+    if (watch_storage_is_busy()) sim_clock_sleep((uint32_t)(busy_until - sim_clock_now()) + 1);
+    busy_until = 0;
+
+    return true;
+}
+
+bool watch_storage_is_busy(void) {
+    return busy_until > sim_clock_now();
+}
+
+static void _watch_storage_ready(void *userData) {
+    (void) userData;
+    ready_timeout_id = 0;
+    void (*callback)(void) = ready_callback;
+    ready_callback = NULL;
+    if (callback != NULL) callback();
+}
+
+void watch_storage_register_ready_callback(void (*callback)(void)) {
+    sim_clock_clear(ready_timeout_id);
+    ready_timeout_id = 0;
+    ready_callback = callback;
+    if (callback == NULL) return;
+
+    if (watch_storage_is_busy()) ready_timeout_id = sim_clock_set_timeout(_watch_storage_ready, busy_until - sim_clock_now(), NULL);
+    else _watch_storage_ready(NULL);
+}
+
+bool watch_storage_provision(void) {
+    // the simulator's storage is always the full size.
     return true;
 }
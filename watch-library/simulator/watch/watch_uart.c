@@ -33,15 +33,47 @@ void watch_enable_uart(const uint8_t tx_pin, const uint8_t rx_pin, uint32_t baud
     rx_enable = !!rx_pin;
 }
 
+void watch_disable_uart(void) {
+    tx_enable = false;
+    rx_enable = false;
+}
+
+size_t watch_uart_write(const void *data, size_t length) {
+    (void)data;
+    // TODO: hook up to UI
+    return tx_enable ? length : 0;
+}
+
 void watch_uart_puts(char *s) {
 	if (tx_enable) {
         // TODO: hook up to UI
     }
 }
 
+void watch_uart_flush(void) {
+}
+
+size_t watch_uart_available(void) {
+    return 0;
+}
+
+size_t watch_uart_read(void *buf, size_t length) {
+    (void)buf;
+    (void)length;
+    return 0;
+}
+
 char watch_uart_getc(void) {
 	if (rx_enable) {
         // TODO: hook up to UI
     }
     return 0;
 }
+
+void watch_uart_set_rx_callback(ext_irq_cb_t callback) {
+    (void)callback;
+}
+
+uint16_t watch_uart_get_rx_errors(void) {
+    return 0;
+}